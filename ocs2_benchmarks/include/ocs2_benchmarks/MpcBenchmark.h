@@ -0,0 +1,148 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/initialization/Initializer.h>
+#include <ocs2_core/reference/TargetTrajectories.h>
+#include <ocs2_ddp/DDP_Settings.h>
+#include <ocs2_mpc/MPC_BASE.h>
+#include <ocs2_mpc/MPC_Settings.h>
+#include <ocs2_mpc/SystemObservation.h>
+#include <ocs2_oc/oc_problem/OptimalControlProblem.h>
+#include <ocs2_oc/rollout/RolloutBase.h>
+#include <ocs2_oc/synchronized_module/ReferenceManagerInterface.h>
+
+namespace ocs2 {
+namespace mpc_benchmark {
+
+/** The solver of the benchmarked MPC */
+enum class SolverType { DDP, SQP };
+
+std::string toString(SolverType solverType);
+
+/**
+ * The sequence of observations at which the MPC is run, e.g. recorded in a closed-loop simulation. The input is not part of the trace since
+ * the MPC does not use it.
+ */
+struct ObservationTrace {
+  scalar_array_t timeTrajectory;
+  vector_array_t stateTrajectory;
+};
+
+/**
+ * Loads an observation trace from a text file with one observation per line: the time followed by the state, separated by commas or
+ * whitespace. Empty lines and lines starting with '#' are skipped.
+ *
+ * @param [in] fileName: The name of the trace file.
+ * @param [in] stateDim: The dimension of the state.
+ * @return The observation trace.
+ */
+ObservationTrace loadObservationTrace(const std::string& fileName, size_t stateDim);
+
+/** Saves an observation trace in the format read by loadObservationTrace. */
+void saveObservationTrace(const std::string& fileName, const ObservationTrace& trace);
+
+/**
+ * An MPC problem of the benchmark suite. The MPC refers to the optimal control problem of the robot interface, therefore the problem keeps
+ * the interface alive.
+ */
+struct MpcProblem {
+  std::string taskFile;
+  std::shared_ptr<void> interfacePtr;
+  std::unique_ptr<MPC_BASE> mpcPtr;
+  SystemObservation initObservation;
+  TargetTrajectories targetTrajectories;
+};
+
+/** Creates the MPC problem of a robot for the given solver. */
+using MpcProblemFactory = std::function<MpcProblem(SolverType)>;
+
+/**
+ * Creates the MPC of the given solver type. The DDP uses the given settings and the SQP loads its settings from the "multiple_shooting"
+ * field of the task file, where the missing entries take their default values. All printouts of the solvers are disabled.
+ */
+std::unique_ptr<MPC_BASE> createMpc(SolverType solverType, const std::string& taskFile, const mpc::Settings& mpcSettings,
+                                    ddp::Settings ddpSettings, const RolloutBase& rollout,
+                                    const OptimalControlProblem& optimalControlProblem, const Initializer& initializer,
+                                    std::shared_ptr<ReferenceManagerInterface> referenceManagerPtr = nullptr);
+
+/** The settings of the benchmark suite */
+struct Settings {
+  /** The number of MPC cycles of a benchmark iteration. It is limited by the length of the observation trace. */
+  size_t numCycles = 100;
+  /** The fixed number of benchmark iterations, such that the results of two runs are comparable. */
+  size_t numIterations = 3;
+  /** The folder of the observation traces "<robotName>.trace". If a trace is missing, the MPC runs in closed loop. */
+  std::string traceFolder;
+  /** If true, the observations of the closed-loop runs are saved as traces into the trace folder. */
+  bool recordTraces = false;
+};
+
+/**
+ * Runs settings.numCycles MPC cycles in each benchmark iteration, starting from a reset MPC. The observations are taken from the trace if
+ * it is given. Otherwise, the MPC runs in closed loop with a system which tracks the optimized state trajectory perfectly until the next
+ * cycle, which is 1 / mpcDesiredFrequency_ later (or 10 ms if the frequency is not limited).
+ *
+ * The following counters are reported per MPC cycle: the iterations of the solver, the heap allocations of all threads (if the allocation
+ * hooks are linked, see benchmark::AllocationCounter), the time of the cycle (average, p50, p99, and max), and the time and the
+ * allocations of each stage of the solver profiler (see SolverBase::getProfiler). If the hardware performance counters are enabled (see
+ * benchmark::perf_counters), the instructions per cycle and the last level cache and branch misses of each stage are reported as well.
+ *
+ * @param [in, out] state: The state of the benchmark.
+ * @param [in, out] problem: The MPC problem.
+ * @param [in] settings: The benchmark settings.
+ * @param [in] tracePtr: The observation trace, or null to run in closed loop.
+ * @param [out] recordedTracePtr: If not null, the observations of the first closed-loop iteration are recorded.
+ */
+void runMpcCycles(::benchmark::State& state, MpcProblem& problem, const Settings& settings, const ObservationTrace* tracePtr,
+                  ObservationTrace* recordedTracePtr = nullptr);
+
+/**
+ * Registers the benchmark "<robotName>/<solver>". The problem is created once on the first run of the benchmark.
+ *
+ * @param [in] robotName: The name of the robot. It is also the name of its trace file.
+ * @param [in] solverType: The solver type.
+ * @param [in] factory: The factory of the MPC problem.
+ * @param [in] settings: The benchmark settings.
+ */
+void registerMpcBenchmark(const std::string& robotName, SolverType solverType, MpcProblemFactory factory, const Settings& settings);
+
+/** Reads the value of a command line argument "--<name>=<value>". Returns false if the argument has another name. */
+bool readArgument(const std::string& argument, const std::string& name, std::string& value);
+
+}  // namespace mpc_benchmark
+}  // namespace ocs2
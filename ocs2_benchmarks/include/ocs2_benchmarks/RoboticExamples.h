@@ -0,0 +1,55 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "ocs2_benchmarks/MpcBenchmark.h"
+
+namespace ocs2 {
+namespace mpc_benchmark {
+
+/** The names of the robotic examples: cartpole, double_integrator, ballbot, quadrotor, legged_robot, and mobile_manipulator. */
+const std::vector<std::string>& getRoboticExampleNames();
+
+/**
+ * Gets the factory of the MPC problem of a robotic example. The robot starts at rest at its initial state and moves to a fixed target.
+ * Besides the robotic examples, "mobile_manipulator_box" is the mobile manipulator with hard box constraints as joint limits instead of
+ * the soft ones, and "legged_robot_hard" is the legged robot with hard inequality constraints as friction cones instead of the soft ones.
+ * Both are only supported by the SQP solver. Throws if the robot is unknown.
+ *
+ * @param [in] robotName: The name of the robotic example (see getRoboticExampleNames).
+ * @return The factory of the MPC problem.
+ */
+MpcProblemFactory getRoboticExampleFactory(const std::string& robotName);
+
+}  // namespace mpc_benchmark
+}  // namespace ocs2
@@ -0,0 +1,90 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <memory>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/initialization/Initializer.h>
+#include <ocs2_core/reference/TargetTrajectories.h>
+#include <ocs2_oc/oc_problem/OptimalControlProblem.h>
+#include <ocs2_oc/oc_solver/SolverBase.h>
+#include <ocs2_oc/rollout/RolloutBase.h>
+
+#include "ocs2_benchmarks/MpcBenchmark.h"
+
+namespace ocs2 {
+namespace mpc_benchmark {
+
+/** The dimensions and the structure of a synthetic optimal control problem */
+struct SyntheticProblemSettings {
+  size_t stateDim = 12;
+  size_t inputDim = 4;
+  /** The number of time steps over the horizon. */
+  size_t numTimeSteps = 50;
+  scalar_t timeHorizon = 1.0;
+  /** The number of linear state-input equality constraints, at most inputDim. */
+  size_t numEqualityConstraints = 0;
+  /** The number of linear state-input inequality constraints, imposed as soft constraints with a relaxed barrier penalty. */
+  size_t numInequalityConstraints = 0;
+  /** The fraction of off-diagonal entries of the dynamics and constraint matrices which are zero. */
+  scalar_t sparsity = 0.0;
+  /** The scale of the nonlinear term of the dynamics, the problem is linear-quadratic for zero. */
+  scalar_t nonlinearity = 0.1;
+  /** The seed of the random problem data. The same settings give the same problem. */
+  unsigned int seed = 0;
+};
+
+/**
+ * A synthetic optimal control problem of arbitrary size, for the scaling benchmarks of the solvers. The dynamics are
+ * dx/dt = A x + B u + nonlinearity * tanh(x) with random A and B, the cost is quadratic, and the constraints are linear in the state and
+ * the input. The target is the origin.
+ */
+struct SyntheticProblem {
+  SyntheticProblemSettings settings;
+  OptimalControlProblem optimalControlProblem;
+  std::unique_ptr<RolloutBase> rolloutPtr;
+  std::unique_ptr<Initializer> initializerPtr;
+  vector_t initState;
+  TargetTrajectories targetTrajectories;
+};
+
+/** Creates the synthetic optimal control problem. Throws if the settings are inconsistent. */
+std::unique_ptr<SyntheticProblem> createSyntheticProblem(const SyntheticProblemSettings& settings);
+
+/**
+ * Creates a solver of the synthetic problem with a single thread. The time step of the solver is timeHorizon / numTimeSteps. The
+ * convergence criteria are disabled such that the solver runs numIterations iterations and the run times of different problem sizes are
+ * comparable. All printouts of the solvers are disabled.
+ */
+std::unique_ptr<SolverBase> createSyntheticProblemSolver(SolverType solverType, const SyntheticProblem& problem, size_t numIterations);
+
+}  // namespace mpc_benchmark
+}  // namespace ocs2
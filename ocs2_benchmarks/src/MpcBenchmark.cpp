@@ -0,0 +1,315 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_benchmarks/MpcBenchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+
+#include <boost/filesystem.hpp>
+
+#include <ocs2_core/misc/AllocationCounter.h>
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_core/misc/LinearInterpolation.h>
+#include <ocs2_core/misc/PerfCounters.h>
+#include <ocs2_ddp/GaussNewtonDDP_MPC.h>
+#include <ocs2_sqp/MultipleShootingMpc.h>
+#include <ocs2_sqp/MultipleShootingSettings.h>
+
+namespace ocs2 {
+namespace mpc_benchmark {
+
+namespace {
+
+scalar_t getPercentile(std::vector<scalar_t> samples, scalar_t percentile) {
+  if (samples.empty()) {
+    return 0.0;
+  }
+  const auto index = std::min(static_cast<size_t>(percentile * samples.size()), samples.size() - 1);
+  std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+  return samples[index];
+}
+
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::string toString(SolverType solverType) {
+  switch (solverType) {
+    case SolverType::DDP:
+      return "DDP";
+    case SolverType::SQP:
+      return "SQP";
+    default:
+      throw std::runtime_error("[mpc_benchmark::toString] Undefined SolverType!");
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ObservationTrace loadObservationTrace(const std::string& fileName, size_t stateDim) {
+  std::ifstream file(fileName);
+  if (!file.is_open()) {
+    throw std::runtime_error("[mpc_benchmark::loadObservationTrace] Could not open " + fileName);
+  }
+
+  ObservationTrace trace;
+  std::string line;
+  size_t lineNumber = 0;
+  while (std::getline(file, line)) {
+    ++lineNumber;
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+    std::replace(line.begin(), line.end(), ',', ' ');
+    std::istringstream lineStream(line);
+    std::vector<scalar_t> values;
+    scalar_t value;
+    while (lineStream >> value) {
+      values.push_back(value);
+    }
+    if (values.size() != stateDim + 1) {
+      throw std::runtime_error("[mpc_benchmark::loadObservationTrace] Line " + std::to_string(lineNumber) + " of " + fileName + " has " +
+                               std::to_string(values.size()) + " entries instead of " + std::to_string(stateDim + 1) + "!");
+    }
+    trace.timeTrajectory.push_back(values.front());
+    trace.stateTrajectory.push_back(Eigen::Map<const vector_t>(values.data() + 1, stateDim));
+  }
+
+  return trace;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void saveObservationTrace(const std::string& fileName, const ObservationTrace& trace) {
+  std::ofstream file(fileName);
+  if (!file.is_open()) {
+    throw std::runtime_error("[mpc_benchmark::saveObservationTrace] Could not open " + fileName);
+  }
+
+  file << "# time, state\n" << std::setprecision(17);
+  for (size_t i = 0; i < trace.timeTrajectory.size(); i++) {
+    file << trace.timeTrajectory[i];
+    for (int j = 0; j < trace.stateTrajectory[i].size(); j++) {
+      file << ", " << trace.stateTrajectory[i](j);
+    }
+    file << "\n";
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::unique_ptr<MPC_BASE> createMpc(SolverType solverType, const std::string& taskFile, const mpc::Settings& mpcSettings,
+                                    ddp::Settings ddpSettings, const RolloutBase& rollout,
+                                    const OptimalControlProblem& optimalControlProblem, const Initializer& initializer,
+                                    std::shared_ptr<ReferenceManagerInterface> referenceManagerPtr) {
+  std::unique_ptr<MPC_BASE> mpcPtr;
+  switch (solverType) {
+    case SolverType::DDP: {
+      ddpSettings.displayInfo_ = false;
+      ddpSettings.displayShortSummary_ = false;
+      mpcPtr.reset(new GaussNewtonDDP_MPC(mpcSettings, std::move(ddpSettings), rollout, optimalControlProblem, initializer));
+      break;
+    }
+    case SolverType::SQP: {
+      auto sqpSettings = multiple_shooting::loadSettings(taskFile, "multiple_shooting", false);
+      sqpSettings.printSolverStatus = false;
+      sqpSettings.printSolverStatistics = false;
+      sqpSettings.printLinesearch = false;
+      mpcPtr.reset(new MultipleShootingMpc(mpcSettings, std::move(sqpSettings), optimalControlProblem, initializer));
+      break;
+    }
+    default:
+      throw std::runtime_error("[mpc_benchmark::createMpc] Undefined SolverType!");
+  }
+
+  if (referenceManagerPtr != nullptr) {
+    mpcPtr->getSolverPtr()->setReferenceManager(std::move(referenceManagerPtr));
+  }
+  return mpcPtr;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void runMpcCycles(::benchmark::State& state, MpcProblem& problem, const Settings& settings, const ObservationTrace* tracePtr,
+                  ObservationTrace* recordedTracePtr) {
+  auto& mpc = *problem.mpcPtr;
+  auto& solver = *mpc.getSolverPtr();
+  const scalar_t timeStep = mpc.settings().mpcDesiredFrequency_ > 0.0 ? 1.0 / mpc.settings().mpcDesiredFrequency_ : 0.01;
+  const size_t numCycles = (tracePtr != nullptr) ? std::min(settings.numCycles, tracePtr->timeTrajectory.size()) : settings.numCycles;
+  if (numCycles == 0) {
+    state.SkipWithError("The observation trace is empty!");
+    return;
+  }
+
+  size_t numRuns = 0;
+  size_t numSolverIterations = 0;
+  size_t numAllocations = 0;
+  std::vector<scalar_t> cycleTimes;
+  std::map<std::string, scalar_t> stageTimes;
+  std::map<std::string, size_t> stageAllocations;
+  std::map<std::string, benchmark::PerfCounterValues> stagePerfCounters;
+  for (auto _ : state) {
+    state.PauseTiming();
+    mpc.reset();
+    solver.getReferenceManager().setTargetTrajectories(problem.targetTrajectories);
+    SystemObservation observation = problem.initObservation;
+    const bool isRecording = recordedTracePtr != nullptr && tracePtr == nullptr && numRuns == 0;
+    state.ResumeTiming();
+
+    for (size_t i = 0; i < numCycles; i++) {
+      if (tracePtr != nullptr) {
+        observation.time = tracePtr->timeTrajectory[i];
+        observation.state = tracePtr->stateTrajectory[i];
+      }
+
+      const size_t numAllocationsBefore = benchmark::allocation_counter::getNumAllocations();
+      const auto startTime = std::chrono::steady_clock::now();
+      mpc.run(observation.time, observation.state);
+      const auto endTime = std::chrono::steady_clock::now();
+      numAllocations += benchmark::allocation_counter::getNumAllocations() - numAllocationsBefore;
+      cycleTimes.push_back(std::chrono::duration<scalar_t, std::milli>(endTime - startTime).count());
+
+      // closed loop: the system tracks the optimized state trajectory perfectly
+      if (tracePtr == nullptr) {
+        state.PauseTiming();
+        if (isRecording) {
+          recordedTracePtr->timeTrajectory.push_back(observation.time);
+          recordedTracePtr->stateTrajectory.push_back(observation.state);
+        }
+        const auto primalSolution = solver.primalSolution(solver.getFinalTime());
+        observation.time += timeStep;
+        observation.state =
+            LinearInterpolation::interpolate(observation.time, primalSolution.timeTrajectory_, primalSolution.stateTrajectory_);
+        state.ResumeTiming();
+      }
+    }
+
+    // the statistics are cleared by the reset of the next iteration
+    state.PauseTiming();
+    numRuns += numCycles;
+    numSolverIterations += solver.getNumIterations();
+    if (const auto* profilerPtr = solver.getProfiler()) {
+      for (const auto& statistics : profilerPtr->getStatistics()) {
+        stageTimes[statistics.path] += statistics.totalInMilliseconds;
+        stageAllocations[statistics.path] += statistics.numAllocations;
+        stagePerfCounters[statistics.path] += statistics.perfCounters;
+      }
+    }
+    state.ResumeTiming();
+  }
+
+  const auto perCycle = [numRuns](scalar_t value) { return value / static_cast<scalar_t>(numRuns); };
+  state.SetItemsProcessed(numRuns);
+  state.counters["cycles"] = numRuns;
+  state.counters["iterations_per_cycle"] = perCycle(numSolverIterations);
+  state.counters["allocations_per_cycle"] = perCycle(numAllocations);
+  state.counters["cycle_avg_ms"] = perCycle(std::accumulate(cycleTimes.begin(), cycleTimes.end(), 0.0));
+  state.counters["cycle_p50_ms"] = getPercentile(cycleTimes, 0.5);
+  state.counters["cycle_p99_ms"] = getPercentile(cycleTimes, 0.99);
+  state.counters["cycle_max_ms"] = *std::max_element(cycleTimes.begin(), cycleTimes.end());
+  for (const auto& stage : stageTimes) {
+    state.counters["stage/" + stage.first + "_ms"] = perCycle(stage.second);
+  }
+  if (benchmark::allocation_counter::isEnabled()) {
+    for (const auto& stage : stageAllocations) {
+      state.counters["stage/" + stage.first + "_allocations"] = perCycle(stage.second);
+    }
+  }
+  if (benchmark::perf_counters::isEnabled()) {
+    for (const auto& stage : stagePerfCounters) {
+      const auto& counters = stage.second;
+      state.counters["stage/" + stage.first + "_ipc"] =
+          counters.cycles > 0 ? static_cast<scalar_t>(counters.instructions) / static_cast<scalar_t>(counters.cycles) : 0.0;
+      state.counters["stage/" + stage.first + "_llc_misses"] = perCycle(counters.llcMisses);
+      state.counters["stage/" + stage.first + "_branch_misses"] = perCycle(counters.branchMisses);
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void registerMpcBenchmark(const std::string& robotName, SolverType solverType, MpcProblemFactory factory, const Settings& settings) {
+  // the problem is shared by the copies of the benchmark function and created on its first run
+  auto problemPtr = std::make_shared<std::unique_ptr<MpcProblem>>();
+
+  auto benchmarkFunction = [=](::benchmark::State& state) {
+    if (*problemPtr == nullptr) {
+      problemPtr->reset(new MpcProblem(factory(solverType)));
+    }
+    auto& problem = **problemPtr;
+
+    const std::string traceFile = settings.traceFolder.empty() ? "" : settings.traceFolder + "/" + robotName + ".trace";
+    std::unique_ptr<ObservationTrace> tracePtr;
+    if (!traceFile.empty() && std::ifstream(traceFile).good()) {
+      tracePtr.reset(new ObservationTrace(loadObservationTrace(traceFile, problem.initObservation.state.size())));
+    }
+
+    if (tracePtr == nullptr && settings.recordTraces && !traceFile.empty()) {
+      ObservationTrace recordedTrace;
+      runMpcCycles(state, problem, settings, nullptr, &recordedTrace);
+      boost::filesystem::create_directories(settings.traceFolder);
+      saveObservationTrace(traceFile, recordedTrace);
+    } else {
+      runMpcCycles(state, problem, settings, tracePtr.get());
+    }
+  };
+
+  ::benchmark::RegisterBenchmark((robotName + "/" + toString(solverType)).c_str(), benchmarkFunction)
+      ->Iterations(settings.numIterations)
+      ->Unit(::benchmark::kMillisecond)
+      ->UseRealTime();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool readArgument(const std::string& argument, const std::string& name, std::string& value) {
+  const std::string prefix = "--" + name + "=";
+  if (argument.compare(0, prefix.size(), prefix) != 0) {
+    return false;
+  }
+  value = argument.substr(prefix.size());
+  return true;
+}
+
+}  // namespace mpc_benchmark
+}  // namespace ocs2
@@ -0,0 +1,142 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <string>
+
+#include <ocs2_mpc/MpcRecording.h>
+
+#include "ocs2_benchmarks/MpcBenchmark.h"
+#include "ocs2_benchmarks/RoboticExamples.h"
+
+using namespace ocs2;
+using namespace mpc_benchmark;
+
+/**
+ * Replays the MPC cycles of a log written by mpc_recording::Recorder with the solver of a robotic example, see mpc_recording::replayCycle.
+ * Each cycle is rerun deterministically from its recorded inputs, which reproduces the slow cycles observed on the robot for profiling.
+ * For an A/B comparison, the results of two replays (e.g. of two builds or of the two solvers) are written to CSV files and compared.
+ *
+ * Usage: mpc_replay --robot=<name> --log=<file> [options], where the options are:
+ *   --solver=<DDP|SQP>: the solver of the replay (default SQP).
+ *   --first=<index>, --last=<index>: the range of the replayed records (default all).
+ *   --repeat=<n>: the number of runs of each cycle, of which the minimum time is reported (default 1).
+ *   --profile: prints the report of the solver profiler after the last run of each cycle.
+ *   --output=<file>: writes the results as CSV.
+ */
+int main(int argc, char** argv) {
+  std::string robotName;
+  std::string logFile;
+  std::string outputFile;
+  SolverType solverType = SolverType::SQP;
+  size_t first = 0;
+  size_t last = std::numeric_limits<size_t>::max();
+  size_t numRepeats = 1;
+  bool printProfile = false;
+  for (int i = 1; i < argc; i++) {
+    const std::string argument(argv[i]);
+    std::string value;
+    if (readArgument(argument, "robot", value)) {
+      robotName = value;
+    } else if (readArgument(argument, "log", value)) {
+      logFile = value;
+    } else if (readArgument(argument, "solver", value)) {
+      if (value == toString(SolverType::DDP)) {
+        solverType = SolverType::DDP;
+      } else if (value == toString(SolverType::SQP)) {
+        solverType = SolverType::SQP;
+      } else {
+        std::cerr << "Unknown solver: " << value << "\n";
+        return 1;
+      }
+    } else if (readArgument(argument, "first", value)) {
+      first = std::stoul(value);
+    } else if (readArgument(argument, "last", value)) {
+      last = std::stoul(value);
+    } else if (readArgument(argument, "repeat", value)) {
+      numRepeats = std::max<size_t>(std::stoul(value), 1);
+    } else if (argument == "--profile") {
+      printProfile = true;
+    } else if (readArgument(argument, "output", value)) {
+      outputFile = value;
+    } else {
+      std::cerr << "Unknown argument: " << argument << "\n";
+      return 1;
+    }
+  }
+  if (robotName.empty() || logFile.empty()) {
+    std::cerr << "Usage: mpc_replay --robot=<name> --log=<file> [--solver=<DDP|SQP>] [--first=<index>] [--last=<index>] [--repeat=<n>] "
+                 "[--profile] [--output=<file>]\n";
+    return 1;
+  }
+
+  const mpc_recording::LogReader reader(logFile);
+  auto problem = getRoboticExampleFactory(robotName)(solverType);
+  auto& solver = *problem.mpcPtr->getSolverPtr();
+  const uint64_t settingsHash = mpc_recording::hashFile(problem.taskFile);
+
+  std::ofstream output;
+  if (!outputFile.empty()) {
+    output.open(outputFile);
+    output << "cycle,recorded_ms,replay_ms,iterations,merit\n";
+  }
+
+  std::cout << std::fixed << std::setprecision(3);
+  std::cout << std::setw(8) << "Cycle" << std::setw(16) << "Recorded [ms]" << std::setw(16) << "Replay [ms]" << std::setw(12)
+            << "Iterations" << std::setw(16) << "Merit" << '\n';
+  last = std::min(last, reader.size() - 1);
+  for (size_t i = first; i <= last && i < reader.size(); i++) {
+    const auto record = reader.read(i);
+    if (record.settingsHash != settingsHash) {
+      std::cerr << "WARNING: The cycle " << record.cycleIndex << " is recorded with other settings than " << problem.taskFile << ".\n";
+    }
+
+    scalar_t replayTime = std::numeric_limits<scalar_t>::max();
+    for (size_t j = 0; j < numRepeats; j++) {
+      replayTime = std::min(replayTime, mpc_recording::replayCycle(*problem.mpcPtr, record));
+    }
+
+    const size_t numIterations = solver.getNumIterations();
+    const scalar_t merit = solver.getPerformanceIndeces().merit;
+    std::cout << std::setw(8) << record.cycleIndex << std::setw(16) << record.solveTime << std::setw(16) << replayTime << std::setw(12)
+              << numIterations << std::setw(16) << merit << '\n';
+    if (output.is_open()) {
+      output << record.cycleIndex << ',' << record.solveTime << ',' << replayTime << ',' << numIterations << ',' << merit << '\n';
+    }
+    if (printProfile && solver.getProfiler() != nullptr) {
+      std::cout << solver.getProfiler()->getReport() << '\n';
+    }
+  }
+
+  return 0;
+}
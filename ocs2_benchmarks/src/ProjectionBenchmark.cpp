@@ -0,0 +1,145 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include <ocs2_sqp/ConstraintProjection.h>
+#include <ocs2_sqp/FixedSizeProjection.h>
+
+using namespace ocs2;
+
+namespace {
+
+/**
+ * Random constraints on a node, where the first numSelectionRows rows each act on a single input, like the zero contact forces of the
+ * swing legs of the legged robot.
+ */
+VectorFunctionLinearApproximation getStructuredConstraints(int stateDim, int inputDim, int numConstraints, int numSelectionRows) {
+  VectorFunctionLinearApproximation constraints;
+  constraints.dfdx = matrix_t::Random(numConstraints, stateDim);
+  constraints.dfdu = matrix_t::Random(numConstraints, inputDim);
+  constraints.f = vector_t::Random(numConstraints);
+  for (int i = 0; i < numSelectionRows; ++i) {
+    constraints.dfdu.row(i).setZero();
+    constraints.dfdu(i, i) = 1.0;
+  }
+  return constraints;
+}
+
+ScalarFunctionQuadraticApproximation getRandomCost(int stateDim, int inputDim) {
+  ScalarFunctionQuadraticApproximation cost;
+  matrix_t QPPR = matrix_t::Random(stateDim + inputDim, stateDim + inputDim);
+  QPPR = QPPR.transpose() * QPPR;
+  cost.dfdxx = QPPR.topLeftCorner(stateDim, stateDim);
+  cost.dfdux = QPPR.bottomLeftCorner(inputDim, stateDim);
+  cost.dfduu = QPPR.bottomRightCorner(inputDim, inputDim);
+  cost.dfdx = vector_t::Random(stateDim);
+  cost.dfdu = vector_t::Random(inputDim);
+  cost.f = 0.0;
+  return cost;
+}
+
+VectorFunctionLinearApproximation getRandomDynamics(int stateDim, int inputDim) {
+  VectorFunctionLinearApproximation dynamics;
+  dynamics.dfdx = matrix_t::Random(stateDim, stateDim);
+  dynamics.dfdu = matrix_t::Random(stateDim, inputDim);
+  dynamics.f = vector_t::Random(stateDim);
+  return dynamics;
+}
+
+/** Arguments: state dimension, input dimension, number of constraints, number of constraints which act on a single input */
+void projectionArguments(::benchmark::internal::Benchmark* benchmark) {
+  benchmark->ArgNames({"nx", "nu", "nc", "ns"});
+  benchmark->Args({12, 4, 2, 0});     // quadrotor-like
+  benchmark->Args({24, 24, 12, 0});   // legged robot, four stance legs
+  benchmark->Args({24, 24, 18, 6});   // legged robot, trotting
+  benchmark->Args({24, 24, 24, 12});  // legged robot, flight phase
+}
+
+template <typename Projection>
+void benchmarkConstraintProjection(::benchmark::State& state, Projection projection) {
+  const auto constraints = getStructuredConstraints(state.range(0), state.range(1), state.range(2), state.range(3));
+  VectorFunctionLinearApproximation projectionTerms;
+  for (auto _ : state) {
+    projection(constraints, projectionTerms);
+    ::benchmark::DoNotOptimize(projectionTerms.dfdu.data());
+  }
+}
+
+void qrProjection(::benchmark::State& state) {
+  benchmarkConstraintProjection(state, [](const VectorFunctionLinearApproximation& constraints,
+                                          VectorFunctionLinearApproximation& projectionTerms) {
+    projectionTerms = qrConstraintProjection(constraints);
+  });
+}
+
+void luProjection(::benchmark::State& state) {
+  benchmarkConstraintProjection(state, [](const VectorFunctionLinearApproximation& constraints,
+                                          VectorFunctionLinearApproximation& projectionTerms) {
+    luConstraintProjection(constraints, projectionTerms);
+  });
+}
+
+void structuredProjection(::benchmark::State& state) {
+  benchmarkConstraintProjection(state, [](const VectorFunctionLinearApproximation& constraints,
+                                          VectorFunctionLinearApproximation& projectionTerms) {
+    structuredConstraintProjection(constraints, projectionTerms);
+  });
+}
+
+/** The projection of a whole node, including the change of input variables of the dynamics and the cost */
+void nodeProjection(::benchmark::State& state) {
+  const int stateDim = state.range(0);
+  const int inputDim = state.range(1);
+  const auto constraints = getStructuredConstraints(stateDim, inputDim, state.range(2), state.range(3));
+  const auto dynamics = getRandomDynamics(stateDim, inputDim);
+  const auto cost = getRandomCost(stateDim, inputDim);
+  const auto projectionFunction = multiple_shooting::selectProjectionFunction(stateDim, inputDim);
+
+  auto projectedDynamics = dynamics;
+  auto projectedCost = cost;
+  VectorFunctionLinearApproximation projection;
+  for (auto _ : state) {
+    state.PauseTiming();
+    projectedDynamics = dynamics;
+    projectedCost = cost;
+    state.ResumeTiming();
+    projectionFunction(constraints, projectedDynamics, projectedCost, projection);
+    ::benchmark::DoNotOptimize(projectedCost.dfduu.data());
+  }
+}
+
+}  // namespace
+
+BENCHMARK(qrProjection)->Apply(projectionArguments);
+BENCHMARK(luProjection)->Apply(projectionArguments);
+BENCHMARK(structuredProjection)->Apply(projectionArguments);
+BENCHMARK(nodeProjection)->Apply(projectionArguments);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,250 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_benchmarks/RoboticExamples.h"
+
+#include <memory>
+#include <stdexcept>
+
+#include <ocs2_core/constraint/BoxConstraint.h>
+#include <ocs2_core/misc/LoadData.h>
+#include <ocs2_core/soft_constraint/StateInputSoftBoxConstraint.h>
+
+#include <ocs2_ballbot/BallbotInterface.h>
+#include <ocs2_ballbot/package_path.h>
+#include <ocs2_cartpole/CartPoleInterface.h>
+#include <ocs2_cartpole/package_path.h>
+#include <ocs2_double_integrator/DoubleIntegratorInterface.h>
+#include <ocs2_double_integrator/package_path.h>
+#include <ocs2_legged_robot/LeggedRobotInterface.h>
+#include <ocs2_legged_robot/constraint/FrictionConeConstraint.h>
+#include <ocs2_legged_robot/package_path.h>
+#include <ocs2_mobile_manipulator/MobileManipulatorInterface.h>
+#include <ocs2_mobile_manipulator/package_path.h>
+#include <ocs2_quadrotor/QuadrotorInterface.h>
+#include <ocs2_quadrotor/package_path.h>
+#include <ocs2_robotic_assets/package_path.h>
+
+namespace ocs2 {
+namespace mpc_benchmark {
+
+namespace {
+
+/**
+ * Creates the MPC problem of a robot interface. The robot starts at rest at its initial state and the target input is the one of the
+ * initializer at the target state, e.g. the hovering thrust of the quadrotor. The optimal control problem of the interface is replaced
+ * by optimalControlProblemPtr if it is given.
+ */
+template <typename Interface>
+MpcProblem createMpcProblem(std::shared_ptr<Interface> interfacePtr, SolverType solverType, const std::string& taskFile,
+                            const vector_t& targetState, const OptimalControlProblem* optimalControlProblemPtr = nullptr) {
+  auto& interface = *interfacePtr;
+  const auto& optimalControlProblem =
+      (optimalControlProblemPtr != nullptr) ? *optimalControlProblemPtr : interface.getOptimalControlProblem();
+
+  MpcProblem problem;
+  problem.taskFile = taskFile;
+  problem.mpcPtr = createMpc(solverType, taskFile, interface.mpcSettings(), interface.ddpSettings(), interface.getRollout(),
+                             optimalControlProblem, interface.getInitializer(), interface.getReferenceManagerPtr());
+
+  std::unique_ptr<Initializer> initializerPtr(interface.getInitializer().clone());
+  vector_t targetInput, nextState;
+  initializerPtr->compute(0.0, targetState, 0.0, targetInput, nextState);
+
+  problem.initObservation.time = 0.0;
+  problem.initObservation.state = interface.getInitialState();
+  problem.initObservation.input = targetInput;
+  problem.targetTrajectories = TargetTrajectories({0.0}, {targetState}, {targetInput});
+  problem.interfacePtr = std::move(interfacePtr);
+  return problem;
+}
+
+MpcProblem createCartpoleProblem(SolverType solverType) {
+  const std::string taskFile = cartpole::getPath() + "/config/mpc/task.info";
+  const std::string libraryFolder = cartpole::getPath() + "/auto_generated";
+  auto interfacePtr = std::make_shared<cartpole::CartPoleInterface>(taskFile, libraryFolder, false /*verbose*/);
+  const vector_t targetState = interfacePtr->getInitialTarget();
+  return createMpcProblem(std::move(interfacePtr), solverType, taskFile, targetState);
+}
+
+/**
+ * Creates the MPC problem of the double integrator. Its dynamics are linear and its costs quadratic such that the solvers take their
+ * linear-quadratic fast path.
+ */
+MpcProblem createDoubleIntegratorProblem(SolverType solverType) {
+  const std::string taskFile = double_integrator::getPath() + "/config/mpc/task.info";
+  const std::string libraryFolder = double_integrator::getPath() + "/auto_generated";
+  auto interfacePtr = std::make_shared<double_integrator::DoubleIntegratorInterface>(taskFile, libraryFolder, false /*verbose*/);
+  const vector_t targetState = interfacePtr->getInitialTarget();
+  return createMpcProblem(std::move(interfacePtr), solverType, taskFile, targetState);
+}
+
+MpcProblem createBallbotProblem(SolverType solverType) {
+  const std::string taskFile = ballbot::getPath() + "/config/mpc/task.info";
+  const std::string libraryFolder = ballbot::getPath() + "/auto_generated";
+  auto interfacePtr = std::make_shared<ballbot::BallbotInterface>(taskFile, libraryFolder);
+  // move by one meter in x
+  vector_t targetState = interfacePtr->getInitialState();
+  targetState(0) += 1.0;
+  return createMpcProblem(std::move(interfacePtr), solverType, taskFile, targetState);
+}
+
+MpcProblem createQuadrotorProblem(SolverType solverType) {
+  const std::string taskFile = quadrotor::getPath() + "/config/mpc/task.info";
+  const std::string libraryFolder = quadrotor::getPath() + "/auto_generated";
+  auto interfacePtr = std::make_shared<quadrotor::QuadrotorInterface>(taskFile, libraryFolder);
+  // fly by one meter in x, y, and z
+  vector_t targetState = interfacePtr->getInitialState();
+  targetState.head<3>().array() += 1.0;
+  return createMpcProblem(std::move(interfacePtr), solverType, taskFile, targetState);
+}
+
+/**
+ * Creates the MPC problem of the legged robot. If hardFrictionCone is true, the soft friction cone constraints are replaced by hard
+ * inequality constraints, which only the SQP solver supports.
+ */
+MpcProblem createLeggedRobotProblem(SolverType solverType, bool hardFrictionCone) {
+  const std::string taskFile = legged_robot::getPath() + "/config/mpc/task.info";
+  const std::string referenceFile = legged_robot::getPath() + "/config/command/reference.info";
+  const std::string urdfFile = robotic_assets::getPath() + "/resources/anymal_c/urdf/anymal.urdf";
+  auto interfacePtr = std::make_shared<legged_robot::LeggedRobotInterface>(taskFile, urdfFile, referenceFile);
+
+  std::unique_ptr<OptimalControlProblem> optimalControlProblemPtr;
+  if (hardFrictionCone) {
+    optimalControlProblemPtr.reset(new OptimalControlProblem(interfacePtr->getOptimalControlProblem()));
+    optimalControlProblemPtr->softConstraintPtr->erase("frictionCone");
+
+    scalar_t frictionCoefficient = 1.0;
+    loadData::loadCppDataType(taskFile, "frictionConeSoftConstraint.frictionCoefficient", frictionCoefficient);
+    const legged_robot::FrictionConeConstraint::Config config(frictionCoefficient);
+    const auto& info = interfacePtr->getCentroidalModelInfo();
+    for (size_t i = 0; i < info.numThreeDofContacts; i++) {
+      std::unique_ptr<StateInputConstraint> frictionConePtr(
+          new legged_robot::FrictionConeConstraint(*interfacePtr->getSwitchedModelReferenceManagerPtr(), config, i, info));
+      optimalControlProblemPtr->inequalityConstraintPtr->add("frictionCone_" + std::to_string(i), std::move(frictionConePtr));
+    }
+  }
+
+  // stand still with the default gait of the reference file
+  const vector_t targetState = interfacePtr->getInitialState();
+  return createMpcProblem(interfacePtr, solverType, taskFile, targetState, optimalControlProblemPtr.get());
+}
+
+MpcProblem createLeggedRobotSoftFrictionConeProblem(SolverType solverType) {
+  return createLeggedRobotProblem(solverType, false);
+}
+
+MpcProblem createLeggedRobotHardFrictionConeProblem(SolverType solverType) {
+  return createLeggedRobotProblem(solverType, true);
+}
+
+std::vector<BoxConstraint::Bound> toHardBounds(const std::vector<StateInputSoftBoxConstraint::BoxConstraint>& softBoxConstraints) {
+  std::vector<BoxConstraint::Bound> bounds;
+  bounds.reserve(softBoxConstraints.size());
+  for (const auto& softBoxConstraint : softBoxConstraints) {
+    bounds.push_back({softBoxConstraint.index, softBoxConstraint.lowerBound, softBoxConstraint.upperBound});
+  }
+  return bounds;
+}
+
+/**
+ * Creates the MPC problem of the mobile manipulator. If hardJointLimits is true, the soft joint limits are replaced by hard box
+ * constraints, which only the SQP solver supports.
+ */
+MpcProblem createMobileManipulatorProblem(SolverType solverType, bool hardJointLimits) {
+  const std::string taskFile = mobile_manipulator::getPath() + "/config/mabi_mobile/task.info";
+  const std::string libraryFolder = mobile_manipulator::getPath() + "/auto_generated/mabi_mobile";
+  const std::string urdfFile = robotic_assets::getPath() + "/resources/mobile_manipulator/mabi_mobile/urdf/mabi_mobile.urdf";
+  auto interfacePtr = std::make_shared<mobile_manipulator::MobileManipulatorInterface>(taskFile, libraryFolder, urdfFile);
+
+  std::unique_ptr<OptimalControlProblem> optimalControlProblemPtr;
+  if (hardJointLimits) {
+    optimalControlProblemPtr.reset(new OptimalControlProblem(interfacePtr->getOptimalControlProblem()));
+    const auto jointLimitsPtr = optimalControlProblemPtr->softConstraintPtr->extract("jointLimits");
+    const auto* softJointLimitsPtr = dynamic_cast<const StateInputSoftBoxConstraint*>(jointLimitsPtr.get());
+    if (softJointLimitsPtr == nullptr) {
+      throw std::runtime_error("[createMobileManipulatorProblem] The joint limits are not a soft box constraint!");
+    }
+    optimalControlProblemPtr->boxConstraintPtr.reset(new BoxConstraint(toHardBounds(softJointLimitsPtr->getStateBoxConstraints()),
+                                                                       toHardBounds(softJointLimitsPtr->getInputBoxConstraints())));
+  }
+
+  // the target of the mobile manipulator is the end-effector pose: position and quaternion coefficients (x, y, z, w)
+  const vector_t targetPose = (vector_t(7) << -0.5, -0.8, 0.6, 0.33, 0.0, 0.0, 0.95).finished();
+  auto problem = createMpcProblem(interfacePtr, solverType, taskFile, interfacePtr->getInitialState(), optimalControlProblemPtr.get());
+  problem.targetTrajectories = TargetTrajectories({0.0}, {targetPose}, {problem.targetTrajectories.inputTrajectory.front()});
+  return problem;
+}
+
+MpcProblem createMobileManipulatorSoftLimitsProblem(SolverType solverType) {
+  return createMobileManipulatorProblem(solverType, false);
+}
+
+MpcProblem createMobileManipulatorHardLimitsProblem(SolverType solverType) {
+  return createMobileManipulatorProblem(solverType, true);
+}
+
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+const std::vector<std::string>& getRoboticExampleNames() {
+  static const std::vector<std::string> names{"cartpole", "double_integrator", "ballbot", "quadrotor",
+                                              "legged_robot", "mobile_manipulator"};
+  return names;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+MpcProblemFactory getRoboticExampleFactory(const std::string& robotName) {
+  if (robotName == "cartpole") {
+    return &createCartpoleProblem;
+  } else if (robotName == "double_integrator") {
+    return &createDoubleIntegratorProblem;
+  } else if (robotName == "ballbot") {
+    return &createBallbotProblem;
+  } else if (robotName == "quadrotor") {
+    return &createQuadrotorProblem;
+  } else if (robotName == "legged_robot") {
+    return &createLeggedRobotSoftFrictionConeProblem;
+  } else if (robotName == "legged_robot_hard") {
+    return &createLeggedRobotHardFrictionConeProblem;
+  } else if (robotName == "mobile_manipulator") {
+    return &createMobileManipulatorSoftLimitsProblem;
+  } else if (robotName == "mobile_manipulator_box") {
+    return &createMobileManipulatorHardLimitsProblem;
+  } else {
+    throw std::runtime_error("[getRoboticExampleFactory] Unknown robot: " + robotName);
+  }
+}
+
+}  // namespace mpc_benchmark
+}  // namespace ocs2
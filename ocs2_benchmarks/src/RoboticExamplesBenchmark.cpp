@@ -0,0 +1,89 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <iostream>
+#include <string>
+
+#include <ocs2_core/misc/PerfCounters.h>
+
+#include "ocs2_benchmarks/MpcBenchmark.h"
+#include "ocs2_benchmarks/RoboticExamples.h"
+#include "ocs2_benchmarks/package_path.h"
+
+using namespace ocs2;
+using namespace mpc_benchmark;
+
+/**
+ * Runs the MPC benchmarks of the robotic examples. Besides the arguments of Google Benchmark (e.g. --benchmark_filter=legged_robot and
+ * --benchmark_out=results.json --benchmark_out_format=json), it accepts:
+ *   --num_cycles=<n>: the number of MPC cycles of a benchmark iteration (default 100).
+ *   --num_iterations=<n>: the number of benchmark iterations (default 3).
+ *   --trace_folder=<folder>: the folder of the observation traces (default: the traces folder of this package).
+ *   --record_traces: saves the observations of the closed-loop runs as the traces which are missing in the trace folder.
+ *   --perf_counters: reports the hardware performance counters of the solver stages, if the kernel allows the access.
+ */
+int main(int argc, char** argv) {
+  ::benchmark::Initialize(&argc, argv);
+
+  Settings settings;
+  settings.traceFolder = mpc_benchmark::getPath() + "/traces";
+  for (int i = 1; i < argc; i++) {
+    const std::string argument(argv[i]);
+    std::string value;
+    if (readArgument(argument, "num_cycles", value)) {
+      settings.numCycles = std::stoul(value);
+    } else if (readArgument(argument, "num_iterations", value)) {
+      settings.numIterations = std::stoul(value);
+    } else if (readArgument(argument, "trace_folder", value)) {
+      settings.traceFolder = value;
+    } else if (argument == "--record_traces") {
+      settings.recordTraces = true;
+    } else if (argument == "--perf_counters") {
+      if (!ocs2::benchmark::perf_counters::enable()) {
+        std::cerr << "The hardware performance counters are not accessible (see /proc/sys/kernel/perf_event_paranoid).\n";
+      }
+    } else {
+      std::cerr << "Unknown argument: " << argument << "\n";
+      return 1;
+    }
+  }
+
+  for (const auto solverType : {SolverType::DDP, SolverType::SQP}) {
+    for (const auto& robotName : getRoboticExampleNames()) {
+      registerMpcBenchmark(robotName, solverType, getRoboticExampleFactory(robotName), settings);
+    }
+  }
+  // the hard joint limits are handled natively by the QP solver, compare its "Solve QP" stage with the one of mobile_manipulator/SQP
+  registerMpcBenchmark("mobile_manipulator_box", SolverType::SQP, getRoboticExampleFactory("mobile_manipulator_box"), settings);
+  // the hard friction cones are inequality constraints of the QP, compare its iterations per cycle with the ones of legged_robot/SQP
+  registerMpcBenchmark("legged_robot_hard", SolverType::SQP, getRoboticExampleFactory("legged_robot_hard"), settings);
+
+  ::benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}
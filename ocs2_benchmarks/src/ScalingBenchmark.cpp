@@ -0,0 +1,186 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "ocs2_benchmarks/MpcBenchmark.h"
+#include "ocs2_benchmarks/SyntheticProblem.h"
+
+using namespace ocs2;
+using namespace mpc_benchmark;
+
+namespace {
+
+/** The settings of the scaling benchmarks which are common to all sweeps */
+struct ScalingSettings {
+  size_t numIterations = 3;
+  size_t numSolverIterations = 5;
+  scalar_t sparsity = 0.0;
+  scalar_t nonlinearity = 0.1;
+};
+
+/** Sets the swept dimension of the synthetic problem */
+using SweepFunction = void (*)(SyntheticProblemSettings&, size_t);
+
+/**
+ * Solves the synthetic problem from scratch with a fixed number of solver iterations in each benchmark iteration. Besides the time of a
+ * solver run, the following counters are reported per solver iteration: the time of the iteration and the time of each stage of the
+ * solver profiler. The complexity is fitted against the swept dimension.
+ */
+void runSolver(::benchmark::State& state, SolverType solverType, SyntheticProblemSettings problemSettings, SweepFunction sweep,
+               size_t numSolverIterations) {
+  sweep(problemSettings, static_cast<size_t>(state.range(0)));
+  const auto problemPtr = createSyntheticProblem(problemSettings);
+  auto solverPtr = createSyntheticProblemSolver(solverType, *problemPtr, numSolverIterations);
+  const scalar_t initTime = 0.0;
+  const scalar_t finalTime = problemSettings.timeHorizon;
+
+  size_t totalSolverIterations = 0;
+  scalar_t totalTime = 0.0;
+  std::map<std::string, scalar_t> stageTimes;
+  for (auto _ : state) {
+    state.PauseTiming();
+    solverPtr->reset();
+    solverPtr->getReferenceManager().setTargetTrajectories(problemPtr->targetTrajectories);
+    state.ResumeTiming();
+
+    const auto startTime = std::chrono::steady_clock::now();
+    solverPtr->run(initTime, problemPtr->initState, finalTime);
+    totalTime += std::chrono::duration<scalar_t, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+
+    // the statistics are cleared by the reset of the next iteration
+    state.PauseTiming();
+    totalSolverIterations += solverPtr->getNumIterations();
+    if (const auto* profilerPtr = solverPtr->getProfiler()) {
+      for (const auto& statistics : profilerPtr->getStatistics()) {
+        stageTimes[statistics.path] += statistics.totalInMilliseconds;
+      }
+    }
+    state.ResumeTiming();
+  }
+
+  const auto perIteration = [totalSolverIterations](scalar_t value) {
+    return totalSolverIterations > 0 ? value / static_cast<scalar_t>(totalSolverIterations) : 0.0;
+  };
+  state.SetComplexityN(state.range(0));
+  state.counters["iterations_per_run"] = static_cast<scalar_t>(totalSolverIterations) / static_cast<scalar_t>(state.iterations());
+  state.counters["iteration_ms"] = perIteration(totalTime);
+  for (const auto& stage : stageTimes) {
+    state.counters["stage/" + stage.first + "_ms"] = perIteration(stage.second);
+  }
+}
+
+/** Registers the benchmark "scaling/<sweepName>/<solver>" over the given values of the swept dimension. */
+void registerSweep(const std::string& sweepName, SolverType solverType, const SyntheticProblemSettings& problemSettings,
+                   SweepFunction sweep, const std::vector<int64_t>& values, const ScalingSettings& settings) {
+  auto benchmarkFunction = [=](::benchmark::State& state) {
+    runSolver(state, solverType, problemSettings, sweep, settings.numSolverIterations);
+  };
+  auto* benchmarkPtr = ::benchmark::RegisterBenchmark(("scaling/" + sweepName + "/" + toString(solverType)).c_str(), benchmarkFunction);
+  for (const auto value : values) {
+    benchmarkPtr->Arg(value);
+  }
+  benchmarkPtr->ArgName(sweepName)
+      ->Iterations(settings.numIterations)
+      ->Unit(::benchmark::kMillisecond)
+      ->UseRealTime()
+      ->Complexity(::benchmark::oAuto);
+}
+
+}  // unnamed namespace
+
+/**
+ * Runs the scaling benchmarks of the solvers on synthetic problems. Each sweep varies one dimension of the problem and fits the
+ * complexity of a solver run against it, such that a super-linear growth in the horizon or an unexpected growth in the state dimension
+ * shows up in the reported big-O. Besides the arguments of Google Benchmark (e.g. --benchmark_filter=horizon/SQP and
+ * --benchmark_out=results.json --benchmark_out_format=json), it accepts:
+ *   --num_iterations=<n>: the number of benchmark iterations (default 3).
+ *   --num_solver_iterations=<n>: the number of iterations of a solver run (default 5).
+ *   --sparsity=<s>: the fraction of zero off-diagonal entries of the dynamics and constraint matrices (default 0).
+ *   --nonlinearity=<s>: the scale of the nonlinear term of the dynamics (default 0.1).
+ */
+int main(int argc, char** argv) {
+  ::benchmark::Initialize(&argc, argv);
+
+  ScalingSettings settings;
+  for (int i = 1; i < argc; i++) {
+    const std::string argument(argv[i]);
+    std::string value;
+    if (readArgument(argument, "num_iterations", value)) {
+      settings.numIterations = std::stoul(value);
+    } else if (readArgument(argument, "num_solver_iterations", value)) {
+      settings.numSolverIterations = std::stoul(value);
+    } else if (readArgument(argument, "sparsity", value)) {
+      settings.sparsity = std::stod(value);
+    } else if (readArgument(argument, "nonlinearity", value)) {
+      settings.nonlinearity = std::stod(value);
+    } else {
+      std::cerr << "Unknown argument: " << argument << "\n";
+      return 1;
+    }
+  }
+
+  SyntheticProblemSettings problemSettings;
+  problemSettings.sparsity = settings.sparsity;
+  problemSettings.nonlinearity = settings.nonlinearity;
+
+  for (const auto solverType : {SolverType::DDP, SolverType::SQP}) {
+    // linear in the number of time steps
+    registerSweep(
+        "horizon", solverType, problemSettings, [](SyntheticProblemSettings& s, size_t n) { s.numTimeSteps = n; }, {25, 50, 100, 200, 400},
+        settings);
+    // cubic in the state dimension, with half as many inputs as states
+    registerSweep(
+        "state_dim", solverType, problemSettings,
+        [](SyntheticProblemSettings& s, size_t n) {
+          s.stateDim = n;
+          s.inputDim = n / 2;
+        },
+        {4, 8, 16, 32, 64}, settings);
+    // equality constraints of a problem with 8 inputs
+    registerSweep(
+        "equality_constraints", solverType, problemSettings,
+        [](SyntheticProblemSettings& s, size_t n) {
+          s.stateDim = 16;
+          s.inputDim = 8;
+          s.numEqualityConstraints = n;
+        },
+        {1, 2, 4, 8}, settings);
+    registerSweep(
+        "inequality_constraints", solverType, problemSettings,
+        [](SyntheticProblemSettings& s, size_t n) { s.numInequalityConstraints = n; }, {4, 16, 64, 256}, settings);
+  }
+
+  ::benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}
@@ -0,0 +1,219 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_benchmarks/SyntheticProblem.h"
+
+#include <random>
+#include <stdexcept>
+
+#include <ocs2_core/constraint/LinearStateInputConstraint.h>
+#include <ocs2_core/cost/QuadraticStateCost.h>
+#include <ocs2_core/cost/QuadraticStateInputCost.h>
+#include <ocs2_core/dynamics/LinearSystemDynamics.h>
+#include <ocs2_core/initialization/DefaultInitializer.h>
+#include <ocs2_core/penalties/penalties/RelaxedBarrierPenalty.h>
+#include <ocs2_core/soft_constraint/StateInputSoftConstraint.h>
+#include <ocs2_ddp/SLQ.h>
+#include <ocs2_oc/rollout/TimeTriggeredRollout.h>
+#include <ocs2_sqp/MultipleShootingSolver.h>
+
+namespace ocs2 {
+namespace mpc_benchmark {
+
+namespace {
+
+/** The linear dynamics with the additional elementwise nonlinearity: dx/dt = A x + B u + nonlinearity * tanh(x). */
+class SyntheticDynamics final : public LinearSystemDynamics {
+ public:
+  SyntheticDynamics(matrix_t A, matrix_t B, scalar_t nonlinearity)
+      : LinearSystemDynamics(std::move(A), std::move(B)), nonlinearity_(nonlinearity) {}
+
+  ~SyntheticDynamics() override = default;
+
+  SyntheticDynamics* clone() const override { return new SyntheticDynamics(*this); }
+
+  bool isLinear() const override { return nonlinearity_ == 0.0; }
+
+  vector_t computeFlowMap(scalar_t t, const vector_t& x, const vector_t& u, const PreComputation&) override {
+    vector_t dxdt = A_ * x + B_ * u;
+    dxdt.array() += nonlinearity_ * x.array().tanh();
+    return dxdt;
+  }
+
+  VectorFunctionLinearApproximation linearApproximation(scalar_t t, const vector_t& x, const vector_t& u,
+                                                        const PreComputation& preComp) override {
+    VectorFunctionLinearApproximation approximation;
+    approximation.f = computeFlowMap(t, x, u, preComp);
+    approximation.dfdx = A_;
+    approximation.dfdx.diagonal().array() += nonlinearity_ * (1.0 - x.array().tanh().square());
+    approximation.dfdu = B_;
+    return approximation;
+  }
+
+  ScalarFunctionQuadraticApproximation flowMapWeightedHessian(scalar_t t, const vector_t& x, const vector_t& u, const vector_t& weights,
+                                                              const PreComputation&) override {
+    auto hessian = ScalarFunctionQuadraticApproximation::Zero(x.rows(), u.rows());
+    const vector_t tanh = x.array().tanh();
+    hessian.dfdxx.diagonal().array() = -2.0 * nonlinearity_ * weights.array() * tanh.array() * (1.0 - tanh.array().square());
+    return hessian;
+  }
+
+ private:
+  SyntheticDynamics(const SyntheticDynamics& other) = default;
+
+  scalar_t nonlinearity_;
+};
+
+/**
+ * Generates a random matrix with entries uniformly distributed in [-scale, scale]. The off-diagonal entries are zero with the probability
+ * sparsity.
+ */
+matrix_t generateMatrix(std::mt19937& generator, size_t rows, size_t cols, scalar_t scale, scalar_t sparsity) {
+  std::uniform_real_distribution<scalar_t> valueDistribution(-scale, scale);
+  std::bernoulli_distribution isZeroDistribution(sparsity);
+  matrix_t matrix(rows, cols);
+  for (size_t j = 0; j < cols; j++) {
+    for (size_t i = 0; i < rows; i++) {
+      const bool isZero = (i != j) && isZeroDistribution(generator);
+      matrix(i, j) = isZero ? 0.0 : valueDistribution(generator);
+    }
+  }
+  return matrix;
+}
+
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::unique_ptr<SyntheticProblem> createSyntheticProblem(const SyntheticProblemSettings& settings) {
+  if (settings.stateDim == 0 || settings.inputDim == 0 || settings.numTimeSteps == 0 || settings.timeHorizon <= 0.0) {
+    throw std::runtime_error("[createSyntheticProblem] The dimensions, the number of time steps, and the horizon must be positive!");
+  }
+  if (settings.numEqualityConstraints > settings.inputDim) {
+    throw std::runtime_error("[createSyntheticProblem] The number of equality constraints must not exceed the input dimension!");
+  }
+  if (settings.sparsity < 0.0 || settings.sparsity > 1.0) {
+    throw std::runtime_error("[createSyntheticProblem] The sparsity must be in [0, 1]!");
+  }
+
+  const size_t nx = settings.stateDim;
+  const size_t nu = settings.inputDim;
+  std::mt19937 generator(settings.seed);
+  std::unique_ptr<SyntheticProblem> problemPtr(new SyntheticProblem);
+  problemPtr->settings = settings;
+  auto& ocp = problemPtr->optimalControlProblem;
+
+  // the scaling keeps the eigenvalues of A in the same range for all state dimensions
+  matrix_t A = generateMatrix(generator, nx, nx, 1.0 / std::sqrt(static_cast<scalar_t>(nx)), settings.sparsity);
+  matrix_t B = generateMatrix(generator, nx, nu, 1.0, settings.sparsity);
+  ocp.dynamicsPtr.reset(new SyntheticDynamics(std::move(A), std::move(B), settings.nonlinearity));
+
+  ocp.costPtr->add("quadraticCost", std::unique_ptr<StateInputCost>(new QuadraticStateInputCost(matrix_t::Identity(nx, nx),
+                                                                                                0.1 * matrix_t::Identity(nu, nu))));
+  ocp.finalCostPtr->add("finalCost", std::unique_ptr<StateCost>(new QuadraticStateCost(10.0 * matrix_t::Identity(nx, nx))));
+
+  // C x + D u = 0, where the leading identity block of D makes the constraints independent
+  if (settings.numEqualityConstraints > 0) {
+    const size_t nc = settings.numEqualityConstraints;
+    matrix_t C = generateMatrix(generator, nc, nx, 1.0, settings.sparsity);
+    matrix_t D = generateMatrix(generator, nc, nu, 1.0, settings.sparsity);
+    D.leftCols(nc).setIdentity();
+    ocp.equalityConstraintPtr->add("equalityConstraint", std::unique_ptr<StateInputConstraint>(new LinearStateInputConstraint(
+                                                              vector_t::Zero(nc), std::move(C), std::move(D))));
+  }
+
+  // 1 + C x + D u >= 0, which holds at the origin
+  if (settings.numInequalityConstraints > 0) {
+    const size_t nh = settings.numInequalityConstraints;
+    matrix_t C = generateMatrix(generator, nh, nx, 1.0, settings.sparsity);
+    matrix_t D = generateMatrix(generator, nh, nu, 1.0, settings.sparsity);
+    std::unique_ptr<StateInputConstraint> constraintPtr(new LinearStateInputConstraint(vector_t::Ones(nh), std::move(C), std::move(D)));
+    std::unique_ptr<PenaltyBase> penaltyPtr(new RelaxedBarrierPenalty(RelaxedBarrierPenalty::Config(0.1, 1e-3)));
+    ocp.softConstraintPtr->add("inequalityConstraint", std::unique_ptr<StateInputCost>(new StateInputSoftConstraint(
+                                                            std::move(constraintPtr), std::move(penaltyPtr))));
+  }
+
+  rollout::Settings rolloutSettings;
+  rolloutSettings.integratorType = IntegratorType::RK4;
+  rolloutSettings.timeStep = settings.timeHorizon / static_cast<scalar_t>(settings.numTimeSteps);
+  problemPtr->rolloutPtr.reset(new TimeTriggeredRollout(*ocp.dynamicsPtr, rolloutSettings));
+  problemPtr->initializerPtr.reset(new DefaultInitializer(nu));
+
+  std::uniform_real_distribution<scalar_t> stateDistribution(-1.0, 1.0);
+  problemPtr->initState = vector_t::NullaryExpr(nx, [&]() { return stateDistribution(generator); });
+  problemPtr->targetTrajectories = TargetTrajectories({0.0}, {vector_t::Zero(nx)}, {vector_t::Zero(nu)});
+
+  return problemPtr;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::unique_ptr<SolverBase> createSyntheticProblemSolver(SolverType solverType, const SyntheticProblem& problem, size_t numIterations) {
+  const scalar_t timeStep = problem.settings.timeHorizon / static_cast<scalar_t>(problem.settings.numTimeSteps);
+
+  std::unique_ptr<SolverBase> solverPtr;
+  switch (solverType) {
+    case SolverType::DDP: {
+      ddp::Settings ddpSettings;
+      ddpSettings.algorithm_ = ddp::Algorithm::SLQ;
+      ddpSettings.nThreads_ = 1;
+      ddpSettings.timeStep_ = timeStep;
+      ddpSettings.maxNumIterations_ = numIterations;
+      ddpSettings.minRelCost_ = 0.0;
+      ddpSettings.checkNumericalStability_ = false;
+      ddpSettings.displayInfo_ = false;
+      ddpSettings.displayShortSummary_ = false;
+      solverPtr.reset(new SLQ(std::move(ddpSettings), *problem.rolloutPtr, problem.optimalControlProblem, *problem.initializerPtr));
+      break;
+    }
+    case SolverType::SQP: {
+      multiple_shooting::Settings sqpSettings;
+      sqpSettings.dt = timeStep;
+      sqpSettings.sqpIteration = numIterations;
+      sqpSettings.deltaTol = 0.0;
+      sqpSettings.costTol = 0.0;
+      sqpSettings.nThreads = 1;
+      sqpSettings.printSolverStatus = false;
+      sqpSettings.printSolverStatistics = false;
+      sqpSettings.printLinesearch = false;
+      solverPtr.reset(new MultipleShootingSolver(std::move(sqpSettings), problem.optimalControlProblem, *problem.initializerPtr));
+      break;
+    }
+    default:
+      throw std::runtime_error("[createSyntheticProblemSolver] Undefined SolverType!");
+  }
+
+  solverPtr->getReferenceManager().setTargetTrajectories(problem.targetTrajectories);
+  return solverPtr;
+}
+
+}  // namespace mpc_benchmark
+}  // namespace ocs2
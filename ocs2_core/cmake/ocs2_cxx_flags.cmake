@@ -13,6 +13,15 @@ list(APPEND OCS2_CXX_FLAGS
   "-DBOOST_ALL_DYN_LINK"
   )
 
+# Single precision scalar type, see ocs2_core/Types.h. The HPIPM interface of ocs2_sqp only supports double precision.
+#   catkin config --cmake-args -DOCS2_SINGLE_PRECISION=ON
+option(OCS2_SINGLE_PRECISION "Use float instead of double as the scalar type" OFF)
+if (OCS2_SINGLE_PRECISION)
+  list(APPEND OCS2_CXX_FLAGS
+    "-DOCS2_SINGLE_PRECISION"
+    )
+endif (OCS2_SINGLE_PRECISION)
+
 # Add OpenMP flags
 if (NOT DEFINED OpenMP_CXX_FOUND)
   find_package(OpenMP REQUIRED)
@@ -52,5 +52,16 @@ constexpr T weakEpsilon() {
   return T(1e-9);
 }
 
+/** Single precision variants, which are scaled to the machine epsilon of float (~1.2e-7). */
+template <>
+constexpr float limitEpsilon<float>() {
+  return 1e-4f;
+}
+
+template <>
+constexpr float weakEpsilon<float>() {
+  return 1e-6f;
+}
+
 }  // namespace numeric_traits
 }  // namespace ocs2
@@ -41,8 +41,12 @@ using size_array_t = std::vector<size_t>;
 /** Array of size_t trajectory type. */
 using size_array2_t = std::vector<size_array_t>;
 
-/** Scalar type. */
+/** Scalar type. The OCS2_SINGLE_PRECISION build option switches it to float. */
+#ifdef OCS2_SINGLE_PRECISION
+using scalar_t = float;
+#else
 using scalar_t = double;
+#endif
 /** Scalar trajectory type. */
 using scalar_array_t = std::vector<scalar_t>;
 /** Array of scalar trajectory type. */
@@ -71,6 +75,11 @@ using matrix_array2_t = std::vector<matrix_array_t>;
 /** Array of arrays of dynamic matrix trajectory type. */
 using matrix_array3_t = std::vector<matrix_array2_t>;
 
+/** Dynamic-size vector on memory which it does not own, e.g. a scratch vector of a ScratchArena (see misc/ScratchArena.h). */
+using vector_map_t = Eigen::Map<vector_t, Eigen::AlignedMax>;
+/** Dynamic-size matrix on memory which it does not own, e.g. a scratch matrix of a ScratchArena (see misc/ScratchArena.h). */
+using matrix_map_t = Eigen::Map<matrix_t, Eigen::AlignedMax>;
+
 /**
  * Defines the linear approximation of a scalar function
  * f(x,u) = dfdx' dx + dfdu' du + f
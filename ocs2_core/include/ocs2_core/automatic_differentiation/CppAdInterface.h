@@ -31,9 +31,14 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 // Eigen
 #include <Eigen/Core>
+#include <Eigen/SparseCore>
 
 // STL
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 // CppAD
 #include <cppad/cg.hpp>
@@ -55,6 +60,7 @@ class CppAdInterface {
   using ad_function_t = std::function<void(const ad_vector_t&, ad_vector_t&)>;
   using ad_parameterized_function_t = std::function<void(const ad_vector_t&, const ad_vector_t&, ad_vector_t&)>;
   using ad_fun_t = CppAD::ADFun<ad_base_t>;
+  using sparse_matrix_t = Eigen::SparseMatrix<scalar_t, Eigen::RowMajor>;
 
   /**
    * Constructor for parameterized functions
@@ -82,10 +88,11 @@ class CppAdInterface {
   CppAdInterface(ad_function_t adFunction, size_t variableDim, std::string modelName, std::string folderName = "/tmp/ocs2",
                  std::vector<std::string> compileFlags = {"-O3", "-g", "-march=native", "-mtune=native", "-ffast-math"});
 
-  ~CppAdInterface() = default;
+  ~CppAdInterface();
 
   /**
-   * Copy constructor. Models are reloaded if available.
+   * Copy constructor. The copy shares the library of rhs, which is only opened once for all copies, and creates its own model on its
+   * first evaluation.
    */
   CppAdInterface(const CppAdInterface& rhs);
 
@@ -95,12 +102,22 @@ class CppAdInterface {
   CppAdInterface& operator=(CppAdInterface&& rhs) = delete;
 
   /**
-   * Loads earlier created model from disk
+   * Loads earlier created model from disk. The library is the one that was last created or loaded by this interface (or the interface
+   * it was copied from), see loadModelsIfAvailable() to look it up for the current tape.
+   *
+   * The library is not opened right away, but on the first evaluation of this interface or any of its copies. Hence, interfaces of
+   * terms which are never evaluated do not load their library, and errors of loading are thrown by the first evaluation.
    */
   void loadModels(bool verbose = true);
 
   /**
-   * Creates models, compiles them, and saves them to disk
+   * Creates models, compiles them, and saves them to disk. The generated source files are compiled in parallel.
+   * This method can be called for different interfaces from several threads.
+   *
+   * The library is named after a hash of the recorded tape, the dimensions, the approximation order, and the compile flags. Libraries
+   * of earlier versions of the model stay in the library folder. Only the library is kept per hash: the generated sources are saved to
+   * the library folder, where they are overwritten by the next version of the model, and the library folder holds one lock file per
+   * model.
    *
    * @param approximationOrder : Order of derivatives to generate
    * @param verbose : Print out extra information
@@ -110,11 +127,67 @@ class CppAdInterface {
   /**
    * Load models if they are available on disk. Creates a new library otherwise.
    *
+   * The function is taped to look up the library by the hash of the tape, see createModels(). Hence, a library is reused as long as
+   * the model is unchanged, and regenerated when e.g. the URDF or the task file changed the taped function. The library folder can be
+   * shared by several processes: the libraries of a model are only created by one of them at a time, the others wait and load the
+   * library if it became available.
+   *
    * @param approximationOrder : Order of derivatives to generate
    * @param verbose : Print out extra information
    */
   void loadModelsIfAvailable(ApproximationOrder approximationOrder = ApproximationOrder::Second, bool verbose = true);
 
+  /**
+   * Creates the models of several interfaces concurrently. Taping and code generation run for one interface at a time, while the
+   * compilation of the generated sources of all interfaces shares one build queue of parallel compiler jobs.
+   *
+   * @param interfaces : The interfaces to create the models for
+   * @param approximationOrder : Order of derivatives to generate
+   * @param verbose : Print out extra information
+   */
+  static void createModelsConcurrently(const std::vector<CppAdInterface*>& interfaces,
+                                       ApproximationOrder approximationOrder = ApproximationOrder::Second, bool verbose = true);
+
+  /**
+   * Loads the models of several interfaces if they are available on disk. The missing libraries are created concurrently, see
+   * createModelsConcurrently().
+   *
+   * @param interfaces : The interfaces to load or create the models for
+   * @param approximationOrder : Order of derivatives to generate
+   * @param verbose : Print out extra information
+   */
+  static void loadModelsIfAvailableConcurrently(const std::vector<CppAdInterface*>& interfaces,
+                                                ApproximationOrder approximationOrder = ApproximationOrder::Second, bool verbose = true);
+
+  /**
+   * Sets the maximum number of compiler processes that run at the same time for all interfaces of this process.
+   * The default is the number of hardware threads.
+   */
+  static void setMaxNumCompilerJobs(size_t maxNumCompilerJobs);
+
+  /**
+   * Sets whether model libraries may be compiled by this process. Production systems that ship prebuilt libraries can disable the
+   * compilation, such that loadModelsIfAvailable() throws instead of invoking the compiler when a library is missing or out of date.
+   * Default is true.
+   *
+   * Since the libraries are named after the hash of their tape, a bundle of prebuilt libraries is a copy of the library folder, see
+   * loadModelsIfAvailable(). Available libraries are loaded without writing to the folder, hence the bundle can be read-only.
+   */
+  static void setCompilationAllowed(bool allowed);
+
+  /**
+   * Sets whether new model libraries are kept in memory instead of the library folder. The library is compiled in a private temporary
+   * folder, copied into an anonymous in-memory file, and loaded from there. The temporary files are removed right away and nothing is
+   * written to the library folder. Copies of the interface load the library from the same in-memory file. Default is false.
+   */
+  static void setInMemoryCompilation(bool inMemory);
+
+  /** Number of outputs of the function, known once the models are created or loaded. */
+  size_t getRangeDim() const { return rangeDim_; }
+
+  /** Whether the library of the models has been opened, either by an evaluation of this interface or of one of its copies. */
+  bool isLoaded() const;
+
   /**
    * @param x : input vector of size variableDim
    * @param p : parameter vector of size parameterDim
@@ -122,6 +195,39 @@ class CppAdInterface {
    */
   vector_t getFunctionValue(const vector_t& x, const vector_t& p = vector_t(0)) const;
 
+  /**
+   * Evaluates the function into a preallocated output. The inputs are concatenated in a per-thread workspace, hence no memory is
+   * allocated after the first call on a thread. The values are computed by the zero order kernel of the library, which is called
+   * directly and does not evaluate any derivative related code, e.g. for cheap line search trials.
+   *
+   * @param x : input vector of size variableDim
+   * @param p : parameter vector of size parameterDim
+   * @param [out] value : y = f(x,p), must have size rangeDim
+   */
+  void getFunctionValue(const Eigen::Ref<const vector_t>& x, const Eigen::Ref<const vector_t>& p, Eigen::Ref<vector_t> value) const;
+
+  /**
+   * Evaluates the function for a batch of inputs in one call, e.g. for all nodes of a worker. Column k of the arguments belongs to the
+   * k-th evaluation. The workspace and the model are looked up once for the whole batch and no memory is allocated.
+   *
+   * @param xBatch : inputs of size variableDim x batchSize
+   * @param pBatch : parameters of size parameterDim x batchSize
+   * @param [out] valueBatch : y = f(x,p) for each input, must have size rangeDim x batchSize
+   */
+  void getFunctionValueBatch(const Eigen::Ref<const matrix_t>& xBatch, const Eigen::Ref<const matrix_t>& pBatch,
+                             Eigen::Ref<matrix_t> valueBatch) const;
+
+  /**
+   * Evaluates the Jacobian for a batch of inputs in one call, see getFunctionValueBatch().
+   *
+   * @param xBatch : inputs of size variableDim x batchSize
+   * @param pBatch : parameters of size parameterDim x batchSize
+   * @param [out] jacobianBatch : the Jacobians d/dx( f(x,p) ) placed side by side, i.e. the k-th Jacobian is the block of columns
+   *                              [k * variableDim, (k + 1) * variableDim). Must have size rangeDim x (variableDim * batchSize).
+   */
+  void getJacobianBatch(const Eigen::Ref<const matrix_t>& xBatch, const Eigen::Ref<const matrix_t>& pBatch,
+                        Eigen::Ref<matrix_t> jacobianBatch) const;
+
   /**
    * Jacobian with gradient of each output w.r.t the variables x in the rows.
    *
@@ -131,6 +237,26 @@ class CppAdInterface {
    */
   matrix_t getJacobian(const vector_t& x, const vector_t& p = vector_t(0)) const;
 
+  /**
+   * Jacobian evaluated into a preallocated output, without allocating memory. See getFunctionValue(x, p, value).
+   *
+   * @param x : input vector of size variableDim
+   * @param p : parameter vector of size parameterDim
+   * @param [out] jacobian : d/dx( f(x,p) ), must have size rangeDim x variableDim
+   */
+  void getJacobian(const Eigen::Ref<const vector_t>& x, const Eigen::Ref<const vector_t>& p, Eigen::Ref<matrix_t> jacobian) const;
+
+  /**
+   * Sparse Jacobian with gradient of each output w.r.t the variables x in the rows, in compressed row storage.
+   * The sparsity pattern of the generated code is set on the first call. Afterwards, only the nonzero values are written and no memory
+   * is allocated for the output, as long as the same matrix is passed.
+   *
+   * @param x : input vector of size variableDim
+   * @param p : parameter vector of size parameterDim
+   * @param [out] jacobian : d/dx( f(x,p) )
+   */
+  void getSparseJacobian(const vector_t& x, const vector_t& p, sparse_matrix_t& jacobian) const;
+
   /**
    * Returns the full Gauss-Newton approximation of the function.
    * With auto differentiated function y = f(x,p), the following approximation is made:
@@ -165,12 +291,71 @@ class CppAdInterface {
    */
   matrix_t getHessian(const vector_t& w, const vector_t& x, const vector_t& p = vector_t(0)) const;
 
+  /**
+   * Weighted hessian evaluated into a preallocated output, without allocating memory. See getFunctionValue(x, p, value).
+   *
+   * @param w: vector of weights of size rangeDim
+   * @param x : input vector of size variableDim
+   * @param p : parameter vector of size parameterDim
+   * @param [out] hessian : dd/dxdx(sum_i  w_i*f_i(x,p) ), must have size variableDim x variableDim
+   */
+  void getHessian(const Eigen::Ref<const vector_t>& w, const Eigen::Ref<const vector_t>& x, const Eigen::Ref<const vector_t>& p,
+                  Eigen::Ref<matrix_t> hessian) const;
+
+  /**
+   * Sparse weighted hessian in compressed row storage. Only the upper triangular part is stored. As for getSparseJacobian(), no
+   * memory is allocated for the output once it has the sparsity pattern of the generated code.
+   *
+   * @param w: vector of weights of size rangeDim
+   * @param x : input vector of size variableDim
+   * @param p : parameter vector of size parameterDim
+   * @param [out] hessian : upper triangular part of dd/dxdx(sum_i  w_i*f_i(x,p) )
+   */
+  void getSparseHessian(const vector_t& w, const vector_t& x, const vector_t& p, sparse_matrix_t& hessian) const;
+
  private:
+  struct SharedLibrary;
+
+  // Zero order function of the library, which evaluates the values only. Not available for models with atomic functions.
+  using forward_zero_kernel_t = void (*)(const scalar_t* const*, scalar_t* const*, LangCAtomicFun);
+
   /**
    * Defines library folder names
    */
   void setFolderNames();
 
+  /**
+   * Creates and compiles the models, or loads them if loadIfAvailable is set and the library for the current tape exists.
+   */
+  void createOrLoadModels(ApproximationOrder approximationOrder, bool loadIfAvailable, bool verbose);
+
+  /**
+   * Generates the sources of the models and compiles them into a shared library
+   * @param approximationOrder : Order of derivatives to generate
+   * @param fun : taped ad function
+   * @param codeGenerationLock : lock of the code generation, which is released while compiling
+   * @param libraryFile : library path without extension
+   * @param tmpFolder : folder for the object files
+   * @param sourcesFolder : folder where the sources are saved
+   * @param verbose : Print out extra information
+   */
+  void compileLibrary(ApproximationOrder approximationOrder, ad_fun_t& fun, std::unique_lock<std::mutex>& codeGenerationLock,
+                      const std::string& libraryFile, const std::string& tmpFolder, const std::string& sourcesFolder, bool verbose) const;
+
+  /**
+   * Records the tape of the function and sets the range dimension.
+   * @param fun : taped ad function
+   */
+  void recordTape(ad_fun_t& fun);
+
+  /**
+   * Hash which identifies the library of a tape
+   * @param approximationOrder : Order of derivatives to generate
+   * @param fun : taped ad function
+   * @return hash as hexadecimal string
+   */
+  std::string getModelHash(ApproximationOrder approximationOrder, ad_fun_t& fun) const;
+
   /**
    * Creates folders on disk
    */
@@ -191,8 +376,10 @@ class CppAdInterface {
   /**
    * Configures the compiler that compiles the model library
    * @param compiler : compiler to be configured
+   * @param tmpFolder : folder for the object files
+   * @param sourcesFolder : folder where the sources are saved
    */
-  void setCompilerOptions(CppAD::cg::GccCompiler<scalar_t>& compiler) const;
+  void setCompilerOptions(CppAD::cg::GccCompiler<scalar_t>& compiler, const std::string& tmpFolder, const std::string& sourcesFolder) const;
 
   /**
    * Configure the approximation order for the source generator
@@ -203,9 +390,25 @@ class CppAdInterface {
   void setApproximationOrder(ApproximationOrder approximationOrder, CppAD::cg::ModelCSourceGen<scalar_t>& sourceGen, ad_fun_t& fun) const;
 
   /**
-   * Stores the sparisty nonzeros
+   * Evaluates the values with the zero order kernel, or through the model if the kernel is not available
+   * @param library : the loaded library
+   * @param xp : concatenated input [x; p]
+   * @param [out] value : array of size rangeDim
    */
-  void setSparsityNonzeros();
+  void forwardZero(const SharedLibrary& library, CppAD::cg::ArrayView<const scalar_t> xp, scalar_t* value) const;
+
+  /**
+   * Opens the library on the first call of this interface or any of its copies.
+   * @return the loaded library
+   */
+  const SharedLibrary& getLibrary() const;
+
+  /**
+   * Creates the model of this interface on its first call. The model holds the argument arrays of the generated functions, hence it
+   * is not shared with the copies.
+   * @return the model
+   */
+  CppAD::cg::GenericModel<scalar_t>& getModel() const;
 
   /**
    * Creates sparsity pattern for the Jacobian that will be generated
@@ -221,8 +424,14 @@ class CppAdInterface {
    */
   cppad_sparsity::SparsityPattern createHessianSparsity(ad_fun_t& fun) const;
 
-  std::unique_ptr<CppAD::cg::DynamicLib<scalar_t>> dynamicLib_;
-  std::unique_ptr<CppAD::cg::GenericModel<scalar_t>> model_;
+  // The library is shared with the copies of the interface and opened on the first evaluation of any of them. Each copy only owns its
+  // model, which is created on its first evaluation.
+  std::shared_ptr<SharedLibrary> library_;
+  mutable std::mutex modelMutex_;
+  mutable std::unique_ptr<CppAD::cg::GenericModel<scalar_t>> model_;
+  mutable std::atomic<CppAD::cg::GenericModel<scalar_t>*> modelPtr_{nullptr};
+  std::shared_ptr<const int> inMemoryLibraryPtr_;  // file descriptor of the in-memory library, if any
+
   ad_parameterized_function_t adFunction_;
   std::vector<std::string> compileFlags_;
 
@@ -230,8 +439,6 @@ class CppAdInterface {
   size_t variableDim_;
   size_t parameterDim_;
   size_t rangeDim_ = 0;
-  size_t nnzJacobian_ = 0;
-  size_t nnzHessian_ = 0;
 
   // Names
   std::string modelName_;
@@ -98,5 +98,24 @@ SparsityPattern getHessianVariableSparsity(int variableDim, int parameterDim);
  */
 size_t getNumberOfNonZeros(const SparsityPattern& sparsityPattern);
 
+/**
+ * Get the number of colors of a greedy coloring of the rows, where rows with a nonzero in the same column get different colors. The rows
+ * of a color are computed together, such that this is the number of reverse sweeps of the compressed Jacobian.
+ *
+ * @param sparsityPattern : Jacobian sparsity pattern
+ * @return number of row colors
+ */
+size_t getNumberOfRowColors(const SparsityPattern& sparsityPattern);
+
+/**
+ * Get the number of colors of a greedy coloring of the columns, where columns with a nonzero in the same row get different colors. The
+ * columns of a color are computed together, such that this is the number of forward sweeps of the compressed Jacobian.
+ *
+ * @param sparsityPattern : Jacobian sparsity pattern
+ * @param numCols : number of columns of the Jacobian
+ * @return number of column colors
+ */
+size_t getNumberOfColumnColors(const SparsityPattern& sparsityPattern, size_t numCols);
+
 }  // namespace cppad_sparsity
 }  // namespace ocs2
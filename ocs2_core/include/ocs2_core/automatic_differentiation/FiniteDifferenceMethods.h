@@ -29,11 +29,56 @@
 
 #pragma once
 
+#include <vector>
+
 #include <ocs2_core/Types.h>
 #include <ocs2_core/dynamics/ControlledSystemBase.h>
 
 namespace ocs2 {
 
+/** The sparsity pattern of a Jacobian, true for the structurally nonzero entries. */
+using sparsity_pattern_t = Eigen::Matrix<bool, Eigen::Dynamic, Eigen::Dynamic>;
+
+/**
+ * A column coloring of a Jacobian for the finite differences. The columns of a color have no structurally nonzero rows in common, such
+ * that they are perturbed at the same time and their entries are recovered from the same function evaluation(s).
+ */
+class FiniteDifferenceColoring {
+ public:
+  /** Default constructor, an empty coloring. */
+  FiniteDifferenceColoring() = default;
+
+  /**
+   * Constructor of the coloring of a dense Jacobian, every column has its own color.
+   *
+   * @param [in] numRows: The number of rows of the Jacobian.
+   * @param [in] numCols: The number of columns of the Jacobian.
+   */
+  FiniteDifferenceColoring(size_t numRows, size_t numCols);
+
+  /**
+   * Constructor of the coloring of a sparse Jacobian, the colors are assigned greedily column by column.
+   *
+   * @param [in] sparsity: The sparsity pattern of the Jacobian. The entries outside of the pattern are set to zero.
+   */
+  explicit FiniteDifferenceColoring(const sparsity_pattern_t& sparsity);
+
+  size_t getNumRows() const { return numRows_; }
+  size_t getNumCols() const { return columnRows_.size(); }
+  size_t getNumColors() const { return colorColumns_.size(); }
+
+  /** The columns of a color. */
+  const std::vector<size_t>& getColorColumns(size_t color) const { return colorColumns_[color]; }
+
+  /** The structurally nonzero rows of a column. */
+  const std::vector<size_t>& getColumnRows(size_t col) const { return columnRows_[col]; }
+
+ private:
+  size_t numRows_ = 0;
+  std::vector<std::vector<size_t>> colorColumns_;
+  std::vector<std::vector<size_t>> columnRows_;
+};
+
 matrix_t finiteDifferenceDerivative(std::function<vector_t(const vector_t&)> f, const vector_t& x0,
                                     scalar_t eps = Eigen::NumTraits<scalar_t>::epsilon(), bool doubleSidedDerivative = true);
 
@@ -44,4 +89,23 @@ matrix_t finiteDifferenceDerivativeState(ControlledSystemBase& system, scalar_t
 matrix_t finiteDifferenceDerivativeInput(ControlledSystemBase& system, scalar_t t, const vector_t& x, const vector_t& u,
                                          scalar_t eps = Eigen::NumTraits<scalar_t>::epsilon(), bool doubleSidedDerivative = true,
                                          bool isSecondOrderSystem = false);
+
+/**
+ * Computes the Jacobian of the flow map w.r.t. the state and the input with finite differences. All perturbations are evaluated in a
+ * single call of ControlledSystemBase::computeFlowMapBatch(), one (or two for the double sided derivative) per color of the coloring.
+ *
+ * @param [in] system: The system dynamics.
+ * @param [in] t: The time.
+ * @param [in] x: The state.
+ * @param [in] u: The input.
+ * @param [in] coloring: The column coloring of the Jacobian [dfdx, dfdu] of size stateDim x (stateDim + inputDim).
+ * @param [in] eps: The relative perturbation.
+ * @param [in] doubleSidedDerivative: Whether to use the central difference.
+ * @param [out] dfdx: The Jacobian w.r.t. the state.
+ * @param [out] dfdu: The Jacobian w.r.t. the input.
+ */
+void finiteDifferenceDerivativeBatch(ControlledSystemBase& system, scalar_t t, const vector_t& x, const vector_t& u,
+                                     const FiniteDifferenceColoring& coloring, scalar_t eps, bool doubleSidedDerivative, matrix_t& dfdx,
+                                     matrix_t& dfdu);
+
 }  // namespace ocs2
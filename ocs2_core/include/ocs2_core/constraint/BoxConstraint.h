@@ -0,0 +1,100 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include <ocs2_core/Types.h>
+
+namespace ocs2 {
+
+/**
+ * Hard box constraints on the state and the input: lowerBound <= x(index) <= upperBound, and likewise for u. In contrast to the general
+ * inequality constraints, the bounds are neither linearized nor penalized, they are handed as they are to the solvers which support
+ * simple bounds natively (see the multiple shooting solver). The bounds are time-invariant and apply to all intermediate nodes and, for
+ * the state, to the event and final nodes.
+ */
+class BoxConstraint final {
+ public:
+  struct Bound {
+    //! Index of the constrained entry in the state or input vector
+    size_t index;
+
+    //! Lower bound of the entry
+    scalar_t lowerBound;
+
+    //! Upper bound of the entry
+    scalar_t upperBound;
+  };
+
+  /** Constructor, no bounds */
+  BoxConstraint() = default;
+
+  /**
+   * Constructor. Throws if an index is bounded twice or if a lower bound exceeds its upper bound.
+   * @param stateBounds : The bounds of the state entries.
+   * @param inputBounds : The bounds of the input entries.
+   */
+  BoxConstraint(std::vector<Bound> stateBounds, std::vector<Bound> inputBounds);
+
+  BoxConstraint* clone() const { return new BoxConstraint(*this); }
+
+  /** Returns true if there are neither state nor input bounds. */
+  bool empty() const { return stateBounds_.empty() && inputBounds_.empty(); }
+
+  /** The state bounds, sorted by index. */
+  const std::vector<Bound>& getStateBounds() const { return stateBounds_; }
+
+  /** The input bounds, sorted by index. */
+  const std::vector<Bound>& getInputBounds() const { return inputBounds_; }
+
+  /**
+   * Gets the bounds of a deviation from the given state: lowerBound - x(index) <= dx(index) <= upperBound - x(index).
+   * @param [in] state : The state around which the deviation is taken.
+   * @param [out] lowerBound : The lower bounds of the deviation, ordered as getStateBounds().
+   * @param [out] upperBound : The upper bounds of the deviation, ordered as getStateBounds().
+   */
+  void getStateDeviationBounds(const vector_t& state, vector_t& lowerBound, vector_t& upperBound) const;
+
+  /** Gets the bounds of a deviation from the given input, see getStateDeviationBounds(). */
+  void getInputDeviationBounds(const vector_t& input, vector_t& lowerBound, vector_t& upperBound) const;
+
+  /** The squared norm of the bound violation of the state. */
+  scalar_t getStateViolationSquaredNorm(const vector_t& state) const;
+
+  /** The squared norm of the bound violation of the input. */
+  scalar_t getInputViolationSquaredNorm(const vector_t& input) const;
+
+ private:
+  std::vector<Bound> stateBounds_;
+  std::vector<Bound> inputBounds_;
+};
+
+}  // namespace ocs2
@@ -34,6 +34,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/PreComputation.h>
 #include <ocs2_core/Types.h>
 #include <ocs2_core/constraint/ConstraintOrder.h>
+#include <ocs2_core/misc/Footprint.h>
 
 namespace ocs2 {
 
@@ -50,6 +51,13 @@ class StateInputConstraint {
   /** Check constraint activity */
   virtual bool isActive(scalar_t time) const { return true; }
 
+  /**
+   * Get the footprint of the constraint, i.e., the state and input blocks on which it depends. The approximations of a constraint with
+   * a footprint are still full sized, but only the columns inside the footprint are copied by the collection.
+   * Returns nullptr if the constraint may depend on the whole state and input (default).
+   */
+  virtual const Footprint* getFootprint() const { return nullptr; }
+
   /** Get the size of the constraint vector at given time */
   virtual size_t getNumConstraints(scalar_t time) const = 0;
 
@@ -66,6 +74,25 @@ class StateInputConstraint {
     }
   }
 
+  /**
+   * Writes the constraint linear approximation into the rows [startRow, startRow + getNumConstraints(time)) of a stacked approximation
+   * which is already sized to the total number of constraints. The default implementation copies the result of getLinearApproximation().
+   * Terms should override it to write directly into their row block without allocating a temporary approximation.
+   */
+  virtual void writeLinearApproximation(scalar_t time, const vector_t& state, const vector_t& input, const PreComputation& preComp,
+                                        size_t startRow, VectorFunctionLinearApproximation& stackedApproximation) const {
+    const auto approximation = getLinearApproximation(time, state, input, preComp);
+    const auto* footprintPtr = getFootprint();
+    if (footprintPtr != nullptr) {
+      writeFootprintBlocks(*footprintPtr, approximation, startRow, stackedApproximation);
+    } else {
+      const size_t nc = approximation.f.rows();
+      stackedApproximation.f.segment(startRow, nc) = approximation.f;
+      stackedApproximation.dfdx.middleRows(startRow, nc) = approximation.dfdx;
+      stackedApproximation.dfdu.middleRows(startRow, nc) = approximation.dfdu;
+    }
+  }
+
   /** Get the constraint quadratic approximation */
   virtual VectorFunctionQuadraticApproximation getQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
                                                                          const PreComputation& preComp) const {
@@ -63,9 +63,31 @@ class StateInputConstraintCppAd : public StateInputConstraint {
   vector_t getValue(scalar_t time, const vector_t& state, const vector_t& input, const PreComputation& /* preComputation */) const override;
   VectorFunctionLinearApproximation getLinearApproximation(scalar_t time, const vector_t& state, const vector_t& input,
                                                            const PreComputation& /* preComputation */) const override;
+  void writeLinearApproximation(scalar_t time, const vector_t& state, const vector_t& input, const PreComputation& preComputation,
+                                size_t startRow, VectorFunctionLinearApproximation& stackedApproximation) const override;
   VectorFunctionQuadraticApproximation getQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
                                                                  const PreComputation& /* preComputation */) const override;
 
+  /**
+   * Sparse constraint linearization. The Jacobian is taken w.r.t. the taped variables [time; state; input], i.e. dfdx and dfdu are the
+   * columns [1, 1 + stateDim) and [1 + stateDim, 1 + stateDim + inputDim). See CppAdInterface::getSparseJacobian().
+   *
+   * @param [out] value : constraint value
+   * @param [out] jacobian : constraint Jacobian w.r.t. [time; state; input] in compressed row storage
+   */
+  void getSparseLinearApproximation(scalar_t time, const vector_t& state, const vector_t& input, const PreComputation& preComputation,
+                                    vector_t& value, CppAdInterface::sparse_matrix_t& jacobian) const;
+
+  /**
+   * Sparse Hessian of the weighted sum of the constraints, e.g. for the Hessian of the Lagrangian. The Hessian is taken w.r.t. the taped
+   * variables [time; state; input] and only its upper triangular part is stored. See CppAdInterface::getSparseHessian().
+   *
+   * @param [in] multipliers : weights of the constraints
+   * @param [out] hessian : dd/dzdz( multipliers' * constraint ) with z = [time; state; input] in compressed row storage
+   */
+  void getSparseWeightedHessian(scalar_t time, const vector_t& state, const vector_t& input, const PreComputation& preComputation,
+                                const vector_t& multipliers, CppAdInterface::sparse_matrix_t& hessian) const;
+
  protected:
   StateInputConstraintCppAd(const StateInputConstraintCppAd& rhs);
 
@@ -47,6 +47,8 @@ class ControllerBase {
 
   /**
    * @brief Computes the control command at a given time and state.
+   * @note The time-varying controllers keep the state of the time lookup, therefore a controller instance should not be evaluated
+   * concurrently by multiple threads.
    *
    * @param [in] t: Current time.
    * @param [in] x: Current state.
@@ -130,6 +132,18 @@ class ControllerBase {
     throw std::runtime_error("ControllerBase::flatten: not implemented.");
   }
 
+  /**
+   * Saves the controller at given times into one contiguous buffer. The data of each query time has the same layout as in
+   * flatten(timeArray, flatArray2), and the data of consecutive query times follow each other without padding, hence the stride of
+   * a query time is given by the dimensions of the controller at that time.
+   *
+   * @param[in] timeArray array of query times
+   * @param[out] flatData The buffer that is to be filled, i.e., the compressed controller. Its memory is reused.
+   */
+  virtual void flatten(const scalar_array_t& timeArray, std::vector<float>& flatData) const {
+    throw std::runtime_error("ControllerBase::flatten: not implemented.");
+  }
+
  protected:
   /** Copy constructor */
   ControllerBase(const ControllerBase& rhs) = default;
@@ -101,10 +101,21 @@ class FeedforwardController final : public ControllerBase {
 
   void flatten(const scalar_array_t& timeArray, const std::vector<std::vector<float>*>& flatArray2) const override;
 
+  void flatten(const scalar_array_t& timeArray, std::vector<float>& flatData) const override;
+
   static FeedforwardController unFlatten(const scalar_array_t& timeArray, const std::vector<std::vector<float> const*>& flatArray2);
 
+  /**
+   * Reconstructs the controller from the contiguous buffer of flatten(timeArray, flatData). The data of the k-th time consists of
+   * inputDim[k] values.
+   */
+  static FeedforwardController unFlatten(const size_array_t& inputDim, const scalar_array_t& timeArray, const std::vector<float>& flatData);
+
  private:
-  void flattenSingle(scalar_t time, std::vector<float>& flatArray) const;
+  /** Appends the feedforward input at the given time segment to flatData. */
+  void flattenSingle(LinearInterpolation::index_alpha_t indexAlpha, std::vector<float>& flatData) const;
+
+  int timeSegmentCursor_ = 0;  // the lookup hint of the time segment in computeInput
 
  public:
   scalar_array_t timeStamp_;
@@ -79,6 +79,16 @@ class LinearController final : public ControllerBase {
 
   vector_t computeInput(scalar_t t, const vector_t& x) override;
 
+  /**
+   * Same as computeInput(t, x), but the lookup of the time segment starts at the given cursor instead of the internal one.
+   *
+   * @param [in] t: The current time.
+   * @param [in] x: The current state.
+   * @param [in, out] cursor: The state of the lookup, see LinearInterpolation::timeSegment.
+   * @return The control input.
+   */
+  vector_t computeInput(scalar_t t, const vector_t& x, int& cursor) const;
+
   void concatenate(const ControllerBase* nextController, int index, int length) override;
 
   int size() const override;
@@ -99,11 +109,34 @@ class LinearController final : public ControllerBase {
 
   void flatten(const scalar_array_t& timeArray, const std::vector<std::vector<float>*>& flatArray2) const override;
 
+  void flatten(const scalar_array_t& timeArray, std::vector<float>& flatData) const override;
+
   static LinearController unFlatten(const size_array_t& stateDim, const size_array_t& inputDim, const scalar_array_t& timeArray,
                                     const std::vector<std::vector<float> const*>& flatArray2);
 
+  /**
+   * Reconstructs the controller from the contiguous buffer of flatten(timeArray, flatData). The data of the k-th time consists of
+   * inputDim[k] * (stateDim[k] + 1) values.
+   */
+  static LinearController unFlatten(const size_array_t& stateDim, const size_array_t& inputDim, const scalar_array_t& timeArray,
+                                    const std::vector<float>& flatData);
+
  private:
-  void flattenSingle(scalar_t time, std::vector<float>& flatArray) const;
+  /** The nodes and the interpolation coefficient of the controller at a given time, where lhs == rhs if no interpolation is needed. */
+  struct InterpolationNodes {
+    size_t lhs;
+    size_t rhs;
+    scalar_t alpha;
+  };
+  InterpolationNodes getInterpolationNodes(LinearInterpolation::index_alpha_t indexAlpha) const;
+
+  /** Writes the data of the controller at the given nodes into flatData, which should be of size inputDim * (stateDim + 1) */
+  void flattenSingle(const InterpolationNodes& nodes, float* flatData) const;
+
+  /** Reads the data of one time from flatData and appends it to the bias and the gain arrays */
+  static void unFlattenSingle(size_t stateDim, size_t inputDim, const float* flatData, vector_array_t& bias, matrix_array_t& gain);
+
+  int timeSegmentCursor_ = 0;  // the lookup hint of the time segment in computeInput
 
  public:
   scalar_array_t timeStamp_;
@@ -45,6 +45,8 @@ class StateBasedLinearController final : public ControllerBase {
   /**
    * Sets the provided controller pointer which provides the input signal
    * At the same time the eventtimes of the designed controller are computed
+   * If the provided controller is a LinearController, the range of its time stamps in each mode is also precomputed. Therefore, the
+   * controller should only be modified through this class afterwards.
    *
    * @param[in] ctrlPtr: pointer to the provided controller
    */
@@ -79,8 +81,21 @@ class StateBasedLinearController final : public ControllerBase {
   StateBasedLinearController* clone() const override;
 
  private:
+  /** The lookup cursors of the LinearController at the beginning and the end of a mode, i.e. at tauMinus + 2 eps and tau - eps */
+  struct ModeCursors {
+    int begin;
+    int end;
+  };
+
+  /** Precomputes modeCursors_ if the controller is a LinearController */
+  void updateModeCursors();
+
   ControllerBase* ctrlPtr_ = nullptr;
   scalar_array_t ctrlEventTimes_{0};
+
+  const LinearController* linearCtrlPtr_ = nullptr;
+  std::vector<ModeCursors> modeCursors_;
+  int cursor_ = 0;  // the lookup cursor of the inputs within the modes
 };
 
 }  // namespace ocs2
@@ -53,6 +53,16 @@ class QuadraticStateCost : public StateCost {
                                                                  const TargetTrajectories& targetTrajectories,
                                                                  const PreComputation&) const final;
 
+  /** Add cost term quadratic approximation to the accumulator */
+  void accumulateQuadraticApproximation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
+                                        const PreComputation&, ScalarFunctionQuadraticApproximation& accumulator) const final;
+
+  /** The Hessian is given by Q. Derived classes which change it have to override isHessianConstant(). */
+  bool isHessianConstant() const override { return true; }
+  void accumulateConstantHessian(ScalarFunctionQuadraticApproximation& accumulator) const override;
+  void accumulateValueAndGradient(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories, const PreComputation&,
+                                  ScalarFunctionQuadraticApproximation& accumulator) const final;
+
  protected:
   QuadraticStateCost(const QuadraticStateCost& rhs) = default;
 
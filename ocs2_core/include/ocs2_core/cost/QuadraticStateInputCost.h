@@ -58,6 +58,17 @@ class QuadraticStateInputCost : public StateInputCost {
                                                                  const TargetTrajectories& targetTrajectories,
                                                                  const PreComputation&) const final;
 
+  /** Add cost term quadratic approximation to the accumulator */
+  void accumulateQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                        const TargetTrajectories& targetTrajectories, const PreComputation&,
+                                        ScalarFunctionQuadraticApproximation& accumulator) const final;
+
+  /** The Hessian is given by Q, R and P. Derived classes which change it have to override isHessianConstant(). */
+  bool isHessianConstant() const override { return true; }
+  void accumulateConstantHessian(ScalarFunctionQuadraticApproximation& accumulator) const override;
+  void accumulateValueAndGradient(scalar_t time, const vector_t& state, const vector_t& input, const TargetTrajectories& targetTrajectories,
+                                  const PreComputation&, ScalarFunctionQuadraticApproximation& accumulator) const final;
+
  protected:
   QuadraticStateInputCost(const QuadraticStateInputCost& rhs) = default;
 
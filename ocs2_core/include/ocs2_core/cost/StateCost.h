@@ -29,6 +29,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <stdexcept>
 #include <type_traits>
 
 #include <ocs2_core/PreComputation.h>
@@ -56,6 +57,42 @@ class StateCost {
                                                                          const TargetTrajectories& targetTrajectories,
                                                                          const PreComputation& preComp) const = 0;
 
+  /**
+   * Adds the cost term quadratic approximation to the given accumulator, of which only f, dfdx and dfdxx are used. They are already
+   * sized to the state dimension. The default implementation adds the result of getQuadraticApproximation(). Terms should override it
+   * to write directly into the accumulator without allocating a temporary approximation.
+   */
+  virtual void accumulateQuadraticApproximation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
+                                                const PreComputation& preComp, ScalarFunctionQuadraticApproximation& accumulator) const {
+    const auto approximation = getQuadraticApproximation(time, state, targetTrajectories, preComp);
+    accumulator.f += approximation.f;
+    accumulator.dfdx += approximation.dfdx;
+    accumulator.dfdxx += approximation.dfdxx;
+  }
+
+  /**
+   * Whether the Hessian of the cost term (dfdxx) is the same at every time and state. The collection then adds the constant Hessians of
+   * such terms once per activity pattern and only evaluates their values and gradients at every node.
+   */
+  virtual bool isHessianConstant() const { return false; }
+
+  /** Adds the constant Hessian of the cost term to dfdxx of the accumulator. It is only called if isHessianConstant() returns true. */
+  virtual void accumulateConstantHessian(ScalarFunctionQuadraticApproximation& accumulator) const {
+    throw std::runtime_error("[StateCost::accumulateConstantHessian] The cost term does not have a constant Hessian!");
+  }
+
+  /**
+   * Adds the value and gradient (f and dfdx) of the cost term to the accumulator. It is used in place of
+   * accumulateQuadraticApproximation() for the terms with a constant Hessian. The default implementation adds the corresponding parts of
+   * getQuadraticApproximation().
+   */
+  virtual void accumulateValueAndGradient(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
+                                          const PreComputation& preComp, ScalarFunctionQuadraticApproximation& accumulator) const {
+    const auto approximation = getQuadraticApproximation(time, state, targetTrajectories, preComp);
+    accumulator.f += approximation.f;
+    accumulator.dfdx += approximation.dfdx;
+  }
+
  protected:
   StateCost(const StateCost& rhs) = default;
 };
@@ -29,6 +29,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <atomic>
+#include <vector>
+
 #include <ocs2_core/Types.h>
 #include <ocs2_core/misc/Collection.h>
 #include <ocs2_core/reference/TargetTrajectories.h>
@@ -43,13 +46,19 @@ namespace ocs2 {
  * This class collects a variable number of cost terms and provides methods to get the
  * summed cost values and quadratic approximations. Each cost term can be accessed through its
  * string name and can be activated or deactivated.
+ *
+ * The constant Hessians of the cost terms (see StateCost::isHessianConstant()) are summed once for each pattern of active terms and
+ * reused at every node, such that only the values and gradients of these terms are evaluated per node.
  */
 class StateCostCollection : public Collection<StateCost> {
  public:
   StateCostCollection() = default;
-  virtual ~StateCostCollection() = default;
+  virtual ~StateCostCollection();
   virtual StateCostCollection* clone() const;
 
+  /** Whether all the terms, including the inactive ones, have a constant Hessian, see StateCost::isHessianConstant() */
+  virtual bool isHessianConstant() const;
+
   /** Get state-only cost value */
   virtual scalar_t getValue(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
                             const PreComputation& preComp) const;
@@ -59,9 +68,40 @@ class StateCostCollection : public Collection<StateCost> {
                                                                          const TargetTrajectories& targetTrajectories,
                                                                          const PreComputation& preComp) const;
 
+  /**
+   * Adds the state-only cost quadratic approximation to f, dfdx and dfdxx of the given accumulator, which are already sized to the state
+   * dimension. The accumulator may also be a state-input approximation. The terms of this class are accumulated in place, while the
+   * approximation of a derived class is taken from getQuadraticApproximation(). Derived classes may override this method to avoid the
+   * temporary approximation.
+   */
+  virtual void accumulateQuadraticApproximation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
+                                                const PreComputation& preComp, ScalarFunctionQuadraticApproximation& accumulator) const;
+
  protected:
   /** Copy constructor */
   StateCostCollection(const StateCostCollection& other);
+
+ private:
+  /** Adds the quadratic approximation of the active terms to f, dfdx and dfdxx of the accumulator in place */
+  void accumulateTermsQuadraticApproximation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
+                                             const PreComputation& preComp, ScalarFunctionQuadraticApproximation& accumulator) const;
+
+  /** Sum of the constant Hessians of the active terms, an element of a singly linked list */
+  struct ConstantHessian {
+    size_t revision;
+    std::vector<bool> activeTerms;
+    ScalarFunctionQuadraticApproximation hessian;
+    ConstantHessian* next;
+  };
+
+  /**
+   * Gets the sum of the constant Hessians of the given terms. It is computed on the first request and cached afterwards. The cache is
+   * read without locking, since its entries are only prepended. The entries of an earlier revision of the terms are skipped and only
+   * freed with the collection.
+   */
+  const ScalarFunctionQuadraticApproximation& getConstantHessian(const std::vector<bool>& activeTerms, size_t stateDim) const;
+
+  mutable std::atomic<ConstantHessian*> constantHessians_{nullptr};
 };
 
 }  // namespace ocs2
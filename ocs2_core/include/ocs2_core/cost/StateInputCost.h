@@ -29,10 +29,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <stdexcept>
 #include <type_traits>
 
 #include <ocs2_core/PreComputation.h>
 #include <ocs2_core/Types.h>
+#include <ocs2_core/misc/Footprint.h>
 #include <ocs2_core/reference/TargetTrajectories.h>
 
 namespace ocs2 {
@@ -47,6 +49,13 @@ class StateInputCost {
   /** Check if cost term is active */
   virtual bool isActive(scalar_t time) const { return true; }
 
+  /**
+   * Get the footprint of the cost term, i.e., the state and input blocks on which it depends. The approximations of a term with a
+   * footprint are still full sized, but only the entries inside the footprint are added by the collection.
+   * Returns nullptr if the term may depend on the whole state and input (default).
+   */
+  virtual const Footprint* getFootprint() const { return nullptr; }
+
   /** Get cost term value */
   virtual scalar_t getValue(scalar_t time, const vector_t& state, const vector_t& input, const TargetTrajectories& targetTrajectories,
                             const PreComputation& preComp) const = 0;
@@ -56,6 +65,51 @@ class StateInputCost {
                                                                          const TargetTrajectories& targetTrajectories,
                                                                          const PreComputation& preComp) const = 0;
 
+  /**
+   * Adds the cost term quadratic approximation to the given accumulator, which is already sized to the state and input dimensions.
+   * The default implementation adds the result of getQuadraticApproximation(). Terms should override it to write directly into the
+   * accumulator without allocating a temporary approximation.
+   */
+  virtual void accumulateQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                const TargetTrajectories& targetTrajectories, const PreComputation& preComp,
+                                                ScalarFunctionQuadraticApproximation& accumulator) const {
+    const auto approximation = getQuadraticApproximation(time, state, input, targetTrajectories, preComp);
+    const auto* footprintPtr = getFootprint();
+    if (footprintPtr != nullptr) {
+      addFootprintBlocks(*footprintPtr, approximation, accumulator);
+    } else {
+      accumulator += approximation;
+    }
+  }
+
+  /**
+   * Whether the Hessian of the cost term (dfdxx, dfdux and dfduu) is the same at every time, state and input. The collection then adds
+   * the constant Hessians of such terms once per activity pattern and only evaluates their values and gradients at every node.
+   */
+  virtual bool isHessianConstant() const { return false; }
+
+  /**
+   * Adds the constant Hessian of the cost term to dfdxx, dfdux and dfduu of the accumulator. It is only called if isHessianConstant()
+   * returns true.
+   */
+  virtual void accumulateConstantHessian(ScalarFunctionQuadraticApproximation& accumulator) const {
+    throw std::runtime_error("[StateInputCost::accumulateConstantHessian] The cost term does not have a constant Hessian!");
+  }
+
+  /**
+   * Adds the value and gradients (f, dfdx and dfdu) of the cost term to the accumulator. It is used in place of
+   * accumulateQuadraticApproximation() for the terms with a constant Hessian. The default implementation adds the corresponding parts of
+   * getQuadraticApproximation().
+   */
+  virtual void accumulateValueAndGradient(scalar_t time, const vector_t& state, const vector_t& input,
+                                          const TargetTrajectories& targetTrajectories, const PreComputation& preComp,
+                                          ScalarFunctionQuadraticApproximation& accumulator) const {
+    const auto approximation = getQuadraticApproximation(time, state, input, targetTrajectories, preComp);
+    accumulator.f += approximation.f;
+    accumulator.dfdx += approximation.dfdx;
+    accumulator.dfdu += approximation.dfdu;
+  }
+
  protected:
   StateInputCost(const StateInputCost& rhs) = default;
 };
@@ -68,6 +68,21 @@ class StateInputCostCppAd : public StateInputCost {
   ScalarFunctionQuadraticApproximation getQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
                                                                  const TargetTrajectories& targetTrajectories,
                                                                  const PreComputation& preComputation) const override;
+  void accumulateQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                        const TargetTrajectories& targetTrajectories, const PreComputation& preComputation,
+                                        ScalarFunctionQuadraticApproximation& accumulator) const override;
+
+  /**
+   * Sparse quadratic cost approximation. The derivatives are taken w.r.t. the taped variables [time; state; input], i.e. the state and
+   * the input are the entries [1, 1 + stateDim) and [1 + stateDim, 1 + stateDim + inputDim). See CppAdInterface::getSparseJacobian().
+   *
+   * @param [out] value : cost value
+   * @param [out] gradient : cost gradient as a row vector in compressed row storage
+   * @param [out] hessian : upper triangular part of the cost Hessian in compressed row storage
+   */
+  void getSparseQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                       const TargetTrajectories& targetTrajectories, const PreComputation& preComputation, scalar_t& value,
+                                       CppAdInterface::sparse_matrix_t& gradient, CppAdInterface::sparse_matrix_t& hessian) const;
 
  protected:
   StateInputCostCppAd(const StateInputCostCppAd& rhs);
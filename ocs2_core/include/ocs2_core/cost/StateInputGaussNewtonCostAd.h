@@ -77,6 +77,14 @@ class StateInputCostGaussNewtonAd : public StateInputCost {
                                                                  const TargetTrajectories& targetTrajectories,
                                                                  const PreComputation& preComputation) const override;
 
+  /**
+   * Linear approximation of the cost vector f(x,u,p), i.e. the least-squares form of the cost. Consumers that can use the residual
+   * Jacobians directly do not need to form the Gauss-Newton Hessian.
+   */
+  VectorFunctionLinearApproximation getResidualLinearApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                                   const TargetTrajectories& targetTrajectories,
+                                                                   const PreComputation& preComputation) const;
+
  protected:
   StateInputCostGaussNewtonAd(const StateInputCostGaussNewtonAd& rhs);
 
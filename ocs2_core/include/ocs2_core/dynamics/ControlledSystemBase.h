@@ -92,6 +92,19 @@ class ControlledSystemBase : public OdeBase {
    */
   virtual vector_t computeFlowMap(scalar_t t, const vector_t& x, const vector_t& u, const PreComputation& preComp) = 0;
 
+  /**
+   * Computes the flow map for a batch of states and inputs. Column k of the arguments belongs to the k-th evaluation.
+   *
+   * @note The default implementation calls computeFlowMap(t, x, u) column by column. Derived classes can override it with a
+   *       vectorized evaluation.
+   *
+   * @param [in] t: The current time.
+   * @param [in] xBatch: The states of size stateDim x batchSize.
+   * @param [in] uBatch: The inputs of size inputDim x batchSize.
+   * @param [out] dxdtBatch: The state time derivatives of size stateDim x batchSize.
+   */
+  virtual void computeFlowMapBatch(scalar_t t, const matrix_t& xBatch, const matrix_t& uBatch, matrix_t& dxdtBatch);
+
   /**
    * State map at the transition time
    *
@@ -50,6 +50,9 @@ class LinearSystemDynamics : public SystemDynamicsBase {
 
   LinearSystemDynamics* clone() const override;
 
+  /** Derived classes which override the flow or jump map with a nonlinear one have to return false */
+  bool isLinear() const override { return true; }
+
   vector_t computeFlowMap(scalar_t t, const vector_t& x, const vector_t& u, const PreComputation&) override;
 
   vector_t computeJumpMap(scalar_t t, const vector_t& x, const PreComputation&) override;
@@ -58,6 +61,9 @@ class LinearSystemDynamics : public SystemDynamicsBase {
 
   VectorFunctionLinearApproximation jumpMapLinearApproximation(scalar_t t, const vector_t& x, const PreComputation&) override;
 
+  ScalarFunctionQuadraticApproximation flowMapWeightedHessian(scalar_t t, const vector_t& x, const vector_t& u, const vector_t& weights,
+                                                              const PreComputation&) override;
+
  protected:
   LinearSystemDynamics(const LinearSystemDynamics& other) = default;
 
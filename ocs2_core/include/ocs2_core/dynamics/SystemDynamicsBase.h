@@ -57,6 +57,12 @@ class SystemDynamicsBase : public ControlledSystemBase {
   /** Clone */
   SystemDynamicsBase* clone() const override = 0;
 
+  /**
+   * Whether the flow and jump maps are linear in the state and input, such that their linear approximations are exact. Solvers use it to
+   * detect linear-quadratic problems, which are solved by a single QP.
+   */
+  virtual bool isLinear() const { return false; }
+
   /**
    * Computes the linear approximation.
    *
@@ -70,6 +76,24 @@ class SystemDynamicsBase : public ControlledSystemBase {
   virtual VectorFunctionLinearApproximation linearApproximation(scalar_t t, const vector_t& x, const vector_t& u,
                                                                 const PreComputation& preComp) = 0;
 
+  /**
+   * Computes the linear approximation for a batch of states and inputs. Column k of the arguments belongs to the k-th evaluation.
+   *
+   * @note The default implementation calls linearApproximation(t, x, u) column by column. Derived classes can override it with a
+   *       vectorized evaluation.
+   *
+   * @param [in] t: The current time.
+   * @param [in] xBatch: The states of size stateDim x batchSize.
+   * @param [in] uBatch: The inputs of size inputDim x batchSize.
+   * @param [out] fBatch: The state time derivatives of size stateDim x batchSize.
+   * @param [out] dfdxBatch: The state Jacobians placed side by side, i.e. the k-th Jacobian is the block of columns
+   *                         [k * stateDim, (k + 1) * stateDim). Size stateDim x (stateDim * batchSize).
+   * @param [out] dfduBatch: The input Jacobians placed side by side, i.e. the k-th Jacobian is the block of columns
+   *                         [k * inputDim, (k + 1) * inputDim). Size stateDim x (inputDim * batchSize).
+   */
+  virtual void linearApproximationBatch(scalar_t t, const matrix_t& xBatch, const matrix_t& uBatch, matrix_t& fBatch, matrix_t& dfdxBatch,
+                                        matrix_t& dfduBatch);
+
   /** Computes the jump map linear approximation.
    *
    * @param [in] t: The current time.
@@ -106,6 +130,21 @@ class SystemDynamicsBase : public ControlledSystemBase {
    */
   virtual vector_t guardSurfacesDerivativeTime(scalar_t t, const vector_t& x, const vector_t& u);
 
+  /**
+   * Computes the Hessian of the flow map weighted with the given weights, i.e. the second order terms of w' * f(t, x, u). This is the
+   * contribution of the dynamics to the Hessian of the Lagrangian, where the weights are the costates.
+   *
+   * @param [in] t: The current time.
+   * @param [in] x: The current state.
+   * @param [in] u: The current input.
+   * @param [in] weights: The weights of the flow map entries, size \f$ n_x \f$.
+   * @param [in] preComp: pre-computation module, safely ignore this parameter if not used.
+   *                      @see PreComputation class documentation.
+   * @return The second order derivatives dfdxx, dfdux and dfduu of w' * f(t, x, u), the lower order terms are set to zero.
+   */
+  virtual ScalarFunctionQuadraticApproximation flowMapWeightedHessian(scalar_t t, const vector_t& x, const vector_t& u,
+                                                                      const vector_t& weights, const PreComputation& preComp);
+
   /**
    * Get at a given operating point the covariance of the dynamics.
    *
@@ -122,6 +161,14 @@ class SystemDynamicsBase : public ControlledSystemBase {
    */
   VectorFunctionLinearApproximation linearApproximation(scalar_t t, const vector_t& x, const vector_t& u);
 
+  /**
+   * Computes the Jacobian of the closed-loop flow map w.r.t. the state from the linear approximation. The feedback of a linear
+   * controller is included, other controllers are treated as feedforward.
+   *
+   * @note This interface is used by the linearly implicit integrators.
+   */
+  matrix_t computeFlowMapJacobian(scalar_t t, const vector_t& x) override;
+
   /** Computes the jump map linear approximation.
    *
    * @note This method updates the internal preComputation with the requestPreJump() callback and
@@ -129,6 +176,13 @@ class SystemDynamicsBase : public ControlledSystemBase {
    */
   VectorFunctionLinearApproximation jumpMapLinearApproximation(scalar_t t, const vector_t& x);
 
+  /** Computes the weighted Hessian of the flow map.
+   *
+   * @note This method updates the internal preComputation with the request() callback and passes it
+   *       to the virtual flowMapWeightedHessian() with the preComputation parameter.
+   */
+  ScalarFunctionQuadraticApproximation flowMapWeightedHessian(scalar_t t, const vector_t& x, const vector_t& u, const vector_t& weights);
+
  protected:
   /** Copy constructor */
   SystemDynamicsBase(const SystemDynamicsBase& other);
@@ -59,12 +59,16 @@ class SystemDynamicsBaseAD : public SystemDynamicsBase {
    * @param modelFolder : folder to save the model library files to
    * @param recompileLibraries : If true, always compile the model library, else try to load existing library if available.
    * @param verbose : print information.
+   * @param createFlowMapHessian : If true, the second order models are generated such that flowMapWeightedHessian() is available.
    */
   void initialize(size_t stateDim, size_t inputDim, const std::string& modelName, const std::string& modelFolder = "/tmp/ocs2",
-                  bool recompileLibraries = true, bool verbose = true);
+                  bool recompileLibraries = true, bool verbose = true, bool createFlowMapHessian = false);
 
   vector_t computeFlowMap(scalar_t t, const vector_t& x, const vector_t& u, const PreComputation& preComputation) final;
 
+  /** @note: Evaluates the whole batch in one call of the generated library if the flow map has no parameters. */
+  void computeFlowMapBatch(scalar_t t, const matrix_t& xBatch, const matrix_t& uBatch, matrix_t& dxdtBatch) override;
+
   vector_t computeJumpMap(scalar_t t, const vector_t& x, const PreComputation& preComputation) final;
 
   vector_t computeGuardSurfaces(scalar_t t, const vector_t& x) final;
@@ -72,10 +76,18 @@ class SystemDynamicsBaseAD : public SystemDynamicsBase {
   VectorFunctionLinearApproximation linearApproximation(scalar_t t, const vector_t& x, const vector_t& u,
                                                         const PreComputation& preComputation) final;
 
+  /** @note: Evaluates the whole batch in one call of the generated library if the flow map has no parameters. */
+  void linearApproximationBatch(scalar_t t, const matrix_t& xBatch, const matrix_t& uBatch, matrix_t& fBatch, matrix_t& dfdxBatch,
+                                matrix_t& dfduBatch) override;
+
   VectorFunctionLinearApproximation jumpMapLinearApproximation(scalar_t t, const vector_t& x, const PreComputation& preComputation) final;
 
   VectorFunctionLinearApproximation guardSurfacesLinearApproximation(scalar_t t, const vector_t& x, const vector_t& u) final;
 
+  /** @note: Requires the dynamics to be initialized with createFlowMapHessian = true */
+  ScalarFunctionQuadraticApproximation flowMapWeightedHessian(scalar_t t, const vector_t& x, const vector_t& u, const vector_t& weights,
+                                                              const PreComputation& preComputation) final;
+
   /** @note: Requires linear approximation to be called before */
   vector_t flowMapDerivativeTime(scalar_t t, const vector_t& x, const vector_t& u) final;
 
@@ -172,7 +184,11 @@ class SystemDynamicsBaseAD : public SystemDynamicsBase {
   std::unique_ptr<CppAdInterface> jumpMapADInterfacePtr_;
   std::unique_ptr<CppAdInterface> guardSurfacesADInterfacePtr_;
 
+  bool hasFlowMapHessian_ = false;
+
   vector_t tapedTimeStateInput_;
+  matrix_t tapedTimeStateInputBatch_;
+  matrix_t flowJacobianBatch_;
   vector_t tapedTimeState_;
 
   /** Cached jacobians for time derivative */
@@ -42,6 +42,10 @@ namespace ocs2 {
  * A class for linearizing system dynamics. The linearized system dynamics is defined as: \n
  *
  * - Linearized system:   \f$ dx/dt = A(t) \delta x + B(t) \delta u \f$ \n
+ *
+ * The Jacobians are computed with finite differences, where all perturbations are evaluated in one call of the batched flow map
+ * (see ControlledSystemBase::computeFlowMapBatch()). If the sparsity pattern of the Jacobian is given, the columns without common
+ * nonzero rows are perturbed at the same time (see FiniteDifferenceColoring).
  */
 class SystemDynamicsLinearizer final : public SystemDynamicsBase {
  public:
@@ -49,6 +53,19 @@ class SystemDynamicsLinearizer final : public SystemDynamicsBase {
   explicit SystemDynamicsLinearizer(std::unique_ptr<ControlledSystemBase> nonlinearSystemPtr, bool doubleSidedDerivative = true,
                                     bool isSecondOrderSystem = false, scalar_t eps = Eigen::NumTraits<scalar_t>::epsilon());
 
+  /**
+   * Constructor with the sparsity pattern of the Jacobian.
+   *
+   * @param [in] nonlinearSystemPtr: The system dynamics.
+   * @param [in] jacobianSparsity: The sparsity pattern of [dfdx, dfdu] of size stateDim x (stateDim + inputDim).
+   * @param [in] doubleSidedDerivative: Whether to use the central difference.
+   * @param [in] isSecondOrderSystem: Whether the state is [x, x_dot] such that the upper half of the Jacobian is known.
+   * @param [in] eps: The relative perturbation.
+   */
+  SystemDynamicsLinearizer(std::unique_ptr<ControlledSystemBase> nonlinearSystemPtr, const sparsity_pattern_t& jacobianSparsity,
+                           bool doubleSidedDerivative = true, bool isSecondOrderSystem = false,
+                           scalar_t eps = Eigen::NumTraits<scalar_t>::epsilon());
+
   /** Default destructor */
   ~SystemDynamicsLinearizer() override = default;
 
@@ -68,6 +85,8 @@ class SystemDynamicsLinearizer final : public SystemDynamicsBase {
   bool doubleSidedDerivative_;
   bool isSecondOrderSystem_;
   scalar_t eps_;
+  bool isSparse_;
+  FiniteDifferenceColoring coloring_;
 };
 
 }  // namespace ocs2
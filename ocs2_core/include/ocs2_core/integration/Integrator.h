@@ -49,7 +49,8 @@ enum class IntegratorType {
   MODIFIED_MIDPOINT,
   RK4,
   RK5_VARIABLE,
-  ADAMS_BASHFORTH_MOULTON
+  ADAMS_BASHFORTH_MOULTON,
+  ROS2
 };
 
 namespace integrator_type {
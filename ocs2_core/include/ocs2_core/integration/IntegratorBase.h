@@ -47,6 +47,7 @@ class IntegratorBase {
  public:
   using system_func_t = std::function<void(const vector_t& x, vector_t& dxdt, scalar_t t)>;
   using observer_func_t = std::function<void(const vector_t& x, scalar_t t)>;
+  using jacobian_func_t = std::function<void(const vector_t& x, matrix_t& dfdx, scalar_t t)>;
 
   /**
    * Default constructor
@@ -111,6 +112,9 @@ class IntegratorBase {
 
   system_func_t systemFunction(OdeBase& system, int maxNumSteps) const;
 
+  /** The Jacobian of the system which is integrated. Only valid during the runIntegrate calls. */
+  jacobian_func_t systemJacobian_;
+
   virtual void runIntegrateConst(system_func_t system, observer_func_t observer, const vector_t& initialState, scalar_t startTime,
                                  scalar_t finalTime, scalar_t dt) = 0;
 
@@ -61,6 +61,16 @@ class OdeBase {
    */
   virtual vector_t computeFlowMap(scalar_t t, const vector_t& x) = 0;
 
+  /**
+   * Computes the Jacobian of the autonomous system dynamics w.r.t. the state. It is used by the linearly implicit integrators. The
+   * default implementation uses forward finite differences of computeFlowMap().
+   *
+   * @param [in] t: Current time.
+   * @param [in] x: Current state.
+   * @return The Jacobian of the state time derivative w.r.t. the state.
+   */
+  virtual matrix_t computeFlowMapJacobian(scalar_t t, const vector_t& x);
+
   /**
    * State map at the transition time
    *
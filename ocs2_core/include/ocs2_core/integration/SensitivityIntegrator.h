@@ -34,7 +34,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace ocs2 {
 
-enum class SensitivityIntegratorType { EULER, RK2, RK4 };
+enum class SensitivityIntegratorType { EULER, RK2, RK3, RK4, IMPLICIT_MIDPOINT };
 
 namespace sensitivity_integrator {
 
@@ -87,4 +87,58 @@ using DynamicsSensitivityDiscretizer =
  */
 DynamicsSensitivityDiscretizer selectDynamicsSensitivityDiscretization(SensitivityIntegratorType integratorType);
 
+/**
+ * Wraps a discretization such that an interval longer than maxStep is integrated with several steps of equal duration of at most
+ * maxStep, while the input is held constant over the entire interval, e.g. for shooting intervals over which the input is blocked.
+ * Intervals up to maxStep are discretized with a single step.
+ *
+ * @param discretizer : discretization of a single step
+ * @param maxStep : the maximum duration of a step
+ */
+DynamicsDiscretizer multiStepDynamicsDiscretization(DynamicsDiscretizer discretizer, scalar_t maxStep);
+
+/**
+ * Wraps a sensitivity discretization such that an interval longer than maxStep is integrated with several steps of at most maxStep, see
+ * multiStepDynamicsDiscretization(). The sensitivities of the steps are chained to the sensitivities of the interval.
+ *
+ * @param sensitivityDiscretizer : sensitivity discretization of a single step
+ * @param maxStep : the maximum duration of a step
+ */
+DynamicsSensitivityDiscretizer multiStepDynamicsSensitivityDiscretization(DynamicsSensitivityDiscretizer sensitivityDiscretizer,
+                                                                          scalar_t maxStep);
+
+/**
+ * A function handle to compute the discrete approximation of the system's flowmap for a batch of states and inputs.
+ * @param system : system to be discretized
+ * @param t : starting time of the discretization interval
+ * @param xBatch : starting states, column k belongs to the k-th trajectory
+ * @param uBatch : inputs, assumed constant over the entire interval
+ * @param dt : interval duration
+ * Returns the states at the end of the interval
+ */
+using DynamicsEnsembleDiscretizer = std::function<matrix_t(SystemDynamicsBase&, scalar_t, const matrix_t&, const matrix_t&, scalar_t)>;
+
+/**
+ * Select available integrator based on enum
+ */
+DynamicsEnsembleDiscretizer selectDynamicsEnsembleDiscretization(SensitivityIntegratorType integratorType);
+
+/**
+ * Integrates the system from an ensemble of initial states with a fixed time step. The states are stacked column-wise such that the
+ * flow map is evaluated for the whole ensemble at once (see ControlledSystemBase::computeFlowMapBatch()). The input of each trajectory
+ * is given by the controller of the system and kept constant over a time step.
+ *
+ * @param system : system to be integrated. Its controller should be set.
+ * @param integratorType : the discretization scheme
+ * @param initTime : initial time
+ * @param initStateBatch : initial states of size stateDim x ensembleSize
+ * @param finalTime : final time
+ * @param timeStep : the time step. The last step is shortened to end at the final time.
+ * @param [out] timeTrajectory : time stamps of the ensemble
+ * @param [out] stateBatchTrajectory : states of the ensemble at each time stamp
+ */
+void integrateEnsemble(SystemDynamicsBase& system, SensitivityIntegratorType integratorType, scalar_t initTime,
+                       const matrix_t& initStateBatch, scalar_t finalTime, scalar_t timeStep, scalar_array_t& timeTrajectory,
+                       matrix_array_t& stateBatchTrajectory);
+
 }  // namespace ocs2
\ No newline at end of file
@@ -62,6 +62,20 @@ vector_t rk2Discretization(SystemDynamicsBase& system, scalar_t t, const vector_
 VectorFunctionLinearApproximation rk2SensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u,
                                                                scalar_t dt);
 
+/**
+ * Computes the discretized dynamics. Uses the Runge-Kutta 3rd order discretization of Kutta.
+ * Returns x_{k+1}
+ */
+vector_t rk3Discretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt);
+
+/**
+ * Creates a linear approximation of the discretized dynamics. Uses the Runge-Kutta 3rd order discretization of Kutta.
+ * Returns an approximation of the form:
+ *      x_{k+1} = A_{k} * dx_{k} + B_{k} * du_{k} + b_{k}
+ */
+VectorFunctionLinearApproximation rk3SensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u,
+                                                               scalar_t dt);
+
 /**
  * Computes the discretized dynamics. Uses an Runge-Kutta 4th order discretization.
  * Returns x_{k+1}
@@ -76,4 +90,45 @@ vector_t rk4Discretization(SystemDynamicsBase& system, scalar_t t, const vector_
 VectorFunctionLinearApproximation rk4SensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u,
                                                                scalar_t dt);
 
+/**
+ * Computes the discretized dynamics. Uses the implicit midpoint rule x_{k+1} = x_{k} + dt * f(t + dt/2, (x_{k} + x_{k+1})/2, u_{k}),
+ * which is A-stable and symplectic. The implicit equation is solved with Newton's method starting from a forward euler step.
+ * Returns x_{k+1}
+ */
+vector_t implicitMidpointDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt);
+
+/**
+ * Creates a linear approximation of the discretized dynamics. Uses the implicit midpoint rule, where the sensitivities follow from
+ * the implicit function theorem at the solution.
+ * Returns an approximation of the form:
+ *      x_{k+1} = A_{k} * dx_{k} + B_{k} * du_{k} + b_{k}
+ */
+VectorFunctionLinearApproximation implicitMidpointSensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x,
+                                                                            const vector_t& u, scalar_t dt);
+
+/**
+ * Computes the discretized dynamics for a batch of states and inputs (column k belongs to the k-th trajectory). Uses an Forward euler
+ * discretization. The flow map is evaluated with ControlledSystemBase::computeFlowMapBatch().
+ * Returns X_{k+1}
+ */
+matrix_t eulerEnsembleDiscretization(SystemDynamicsBase& system, scalar_t t, const matrix_t& xBatch, const matrix_t& uBatch, scalar_t dt);
+
+/**
+ * Computes the discretized dynamics for a batch of states and inputs. Uses an Runge-Kutta 2nd order discretization.
+ * Returns X_{k+1}
+ */
+matrix_t rk2EnsembleDiscretization(SystemDynamicsBase& system, scalar_t t, const matrix_t& xBatch, const matrix_t& uBatch, scalar_t dt);
+
+/**
+ * Computes the discretized dynamics for a batch of states and inputs. Uses the Runge-Kutta 3rd order discretization of Kutta.
+ * Returns X_{k+1}
+ */
+matrix_t rk3EnsembleDiscretization(SystemDynamicsBase& system, scalar_t t, const matrix_t& xBatch, const matrix_t& uBatch, scalar_t dt);
+
+/**
+ * Computes the discretized dynamics for a batch of states and inputs. Uses an Runge-Kutta 4th order discretization.
+ * Returns X_{k+1}
+ */
+matrix_t rk4EnsembleDiscretization(SystemDynamicsBase& system, scalar_t t, const matrix_t& xBatch, const matrix_t& uBatch, scalar_t dt);
+
 }  // namespace ocs2
\ No newline at end of file
@@ -98,12 +98,12 @@ namespace odeint {
 #if (BOOST_VERSION / 100000 == 1 && BOOST_VERSION / 100 % 1000 > 55)
 
 // new boost
-template <int S1, int S2, int O, int M1, int M2>
-struct vector_space_norm_inf<Eigen::Matrix<double, S1, S2, O, M1, M2>> {
+template <typename Scalar, int S1, int S2, int O, int M1, int M2>
+struct vector_space_norm_inf<Eigen::Matrix<Scalar, S1, S2, O, M1, M2>> {
   EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 
-  using result_type = double;
-  result_type operator()(const Eigen::Matrix<double, S1, S2, O, M1, M2>& m) const { return m.template lpNorm<Eigen::Infinity>(); }
+  using result_type = Scalar;
+  result_type operator()(const Eigen::Matrix<Scalar, S1, S2, O, M1, M2>& m) const { return m.template lpNorm<Eigen::Infinity>(); }
 };
 
 #else
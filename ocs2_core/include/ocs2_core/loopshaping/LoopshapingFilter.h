@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <vector>
+
 #include <ocs2_core/Types.h>
 #include <ocs2_core/dynamics/TransferFunctionBase.h>
 #include <Eigen/Dense>
@@ -39,6 +41,20 @@ class Filter {
  public:
   using diag_matrix_t = Eigen::DiagonalMatrix<ocs2::scalar_t, Eigen::Dynamic>;
 
+  /**
+   * An independent section of the filter, e.g. the SISO filter of one input channel. The states, inputs, and outputs of a section are
+   * contiguous and the filter matrices are zero outside the diagonal blocks of the sections.
+   */
+  struct Section {
+    size_t stateOffset = 0;
+    size_t numStates = 0;
+    size_t inputOffset = 0;
+    size_t numInputs = 0;
+    size_t outputOffset = 0;
+    size_t numOutputs = 0;
+    matrix_t A, B, C, D;
+  };
+
   Filter();
 
   Filter(matrix_t A, matrix_t B, matrix_t C, matrix_t D);
@@ -63,6 +79,46 @@ class Filter {
   const matrix_t& getScalingDdiagCdiag() const { return diagDC_; }
   const matrix_t& getScalingDdiagDdiag() const { return diagDD_; }
 
+  /// Get the independent sections of the filter. A filter without block-diagonal structure has a single section.
+  const std::vector<Section>& getSections() const { return sections_; }
+
+  /// True if the filter consists of more than one independent section.
+  bool isBlockDiagonal() const { return sections_.size() > 1; }
+
+  /**
+   * Computes the time derivative of the filter state, A * x + B * u, section by section.
+   *
+   * @param [in] x : filter state
+   * @param [in] u : filter input
+   * @param [out] dxdt : time derivative of the filter state
+   */
+  void computeStateDerivative(const Eigen::Ref<const vector_t>& x, const Eigen::Ref<const vector_t>& u, vector_t& dxdt) const;
+
+  /**
+   * Computes the filter output, C * x + D * u, section by section.
+   *
+   * @param [in] x : filter state
+   * @param [in] u : filter input
+   * @param [out] y : filter output
+   */
+  void computeOutput(const Eigen::Ref<const vector_t>& x, const Eigen::Ref<const vector_t>& u, vector_t& y) const;
+
+  /**
+   * Computes M * C section by section.
+   *
+   * @param [in] M : matrix with getNumOutputs() columns
+   * @param [out] MC : matrix with getNumStates() columns
+   */
+  void rightMultiplyC(const Eigen::Ref<const matrix_t>& M, Eigen::Ref<matrix_t> MC) const;
+
+  /**
+   * Computes M * D section by section.
+   *
+   * @param [in] M : matrix with getNumOutputs() columns
+   * @param [out] MD : matrix with getNumInputs() columns
+   */
+  void rightMultiplyD(const Eigen::Ref<const matrix_t>& M, Eigen::Ref<matrix_t> MD) const;
+
   void print() const;
 
   void findEquilibriumForOutput(const vector_t& y, vector_t& x, vector_t& u) const;
@@ -71,10 +127,12 @@ class Filter {
 
  private:
   void checkSize() const;
+  void findSections();
 
   matrix_t A_, B_, C_, D_;
   diag_matrix_t a_, b_, c_, d_;
   matrix_t diagCC_, diagDC_, diagDD_;
+  std::vector<Section> sections_;
   size_t numStates_ = 0;
   size_t numInputs_ = 0;
   size_t numOutputs_ = 0;
@@ -38,7 +38,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 namespace ocs2 {
 
 /**
- * Loopshaping Pre-Computation decorator class.
+ * Loopshaping Pre-Computation decorator class. The augmented state and input are split into the system and filter parts once per
+ * request, and the loopshaping dynamics, cost, and constraint wrappers read the split parts and the system Pre-Computation from here.
  */
 class LoopshapingPreComputation final : public PreComputation {
  public:
@@ -56,6 +56,9 @@ class LoopshapingStateCost final : public StateCostCollection {
                                                                  const TargetTrajectories& targetTrajectories,
                                                                  const PreComputation& preComp) const override;
 
+  void accumulateQuadraticApproximation(scalar_t t, const vector_t& x, const TargetTrajectories& targetTrajectories,
+                                        const PreComputation& preComp, ScalarFunctionQuadraticApproximation& accumulator) const override;
+
  private:
   LoopshapingStateCost(const LoopshapingStateCost& other) = default;
 
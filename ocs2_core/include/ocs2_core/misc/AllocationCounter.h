@@ -0,0 +1,98 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+
+namespace ocs2 {
+namespace benchmark {
+
+/**
+ * Counts the heap allocations through operator new. The counting is opt-in: an executable enables it by including
+ * "ocs2_core/misc/AllocationHooks.h" in exactly one of its source files, which replaces the global operator new. Without the hooks, all
+ * counts are zero.
+ *
+ * The allocations are counted per thread, such that a scope on one thread is not affected by the allocations of the other threads, and
+ * for the whole process. The allocations of Eigen's aligned allocator (fixed-size vectorizable types) and of malloc do not go through
+ * operator new and are not counted.
+ */
+namespace allocation_counter {
+
+/** Whether the allocation hooks are linked into the executable. */
+bool isEnabled() noexcept;
+
+/** The number of allocations by the calling thread since it started. */
+size_t getThreadNumAllocations() noexcept;
+
+/** The number of bytes allocated by the calling thread since it started. */
+size_t getThreadNumAllocatedBytes() noexcept;
+
+/** The number of allocations by all threads since the process started. */
+size_t getNumAllocations() noexcept;
+
+/** Records an allocation of the calling thread. This is called by the hooks. */
+void recordAllocation(size_t numBytes) noexcept;
+
+/** Marks the counting as enabled. This is called by the hooks. */
+void enable() noexcept;
+
+}  // namespace allocation_counter
+
+/**
+ * Counts the allocations of the calling thread since its construction or the last reset.
+ *
+ * Usage, e.g. to enforce that a hot path does not allocate once it has warmed up:
+ *    benchmark::AllocationCounter allocationCounter;
+ *    solver.run(...);
+ *    EXPECT_EQ(allocationCounter.getNumAllocations(), 0);
+ */
+class AllocationCounter {
+ public:
+  AllocationCounter() { reset(); }
+
+  /** Restarts the counting. */
+  void reset() {
+    startNumAllocations_ = allocation_counter::getThreadNumAllocations();
+    startNumAllocatedBytes_ = allocation_counter::getThreadNumAllocatedBytes();
+  }
+
+  /** The number of allocations of the calling thread since the construction or the last reset. */
+  size_t getNumAllocations() const { return allocation_counter::getThreadNumAllocations() - startNumAllocations_; }
+
+  /** The number of bytes allocated by the calling thread since the construction or the last reset. */
+  size_t getNumAllocatedBytes() const { return allocation_counter::getThreadNumAllocatedBytes() - startNumAllocatedBytes_; }
+
+ private:
+  size_t startNumAllocations_;
+  size_t startNumAllocatedBytes_;
+};
+
+}  // namespace benchmark
+}  // namespace ocs2
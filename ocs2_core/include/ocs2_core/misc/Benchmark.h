@@ -30,8 +30,16 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #pragma once
 
 #include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
 
 #include "ocs2_core/Types.h"
+#include "ocs2_core/misc/AllocationCounter.h"
+#include "ocs2_core/misc/PerfCounters.h"
+#include "ocs2_core/misc/Tracer.h"
 
 namespace ocs2 {
 namespace benchmark {
@@ -107,5 +115,119 @@ class RepeatedTimer {
   std::chrono::steady_clock::time_point startTime_;
 };
 
+/**
+ * A profiler of named, nested scopes. Each thread records into its own tree of scopes, such that opening and closing a scope neither
+ * locks nor allocates once the scope has been visited (only the first use of the profiler on a thread registers it under a mutex).
+ * For each scope the number of calls, the total and the maximum duration are kept exactly, while the percentiles are computed over the
+ * latest maxNumSamples durations. The statistics are reported per worker thread, which reveals the load imbalance in parallel regions.
+ *
+ * Usage:
+ *    benchmark::Profiler profiler;
+ *    {
+ *      benchmark::Profiler::Scope lqScope(profiler, "LQ Approximation");
+ *      // in each task of a parallel region, on whichever thread it runs
+ *      benchmark::Profiler::Scope taskScope(profiler, "partition", "LQ Approximation");
+ *    }
+ *    std::cerr << profiler.getReport();
+ *
+ * If the allocation counting is enabled (see benchmark::AllocationCounter), the allocations of each scope on its own thread are reported
+ * as well, which shows the stages of a hot path that allocate. The first visit of a scope on a thread allocates its statistics, which is
+ * counted in the enclosing scope.
+ *
+ * If the hardware performance counters are enabled (see benchmark::perf_counters), the cycles, instructions, last level cache misses, and
+ * branch misses of each scope on its own thread are reported as well.
+ *
+ * The statistics must not be read or reset while a scope is open on any thread. If a tracer is set, each scope is also recorded as an event
+ * of the tracer, in which case the names of the scopes must have static storage duration (e.g. string literals).
+ */
+class Profiler {
+ public:
+  /** The statistics of a scope */
+  struct Statistics {
+    std::string path;  // the names of the nested scopes separated by '/'
+    size_t workerIndex = 0;
+    size_t numCalls = 0;
+    scalar_t totalInMilliseconds = 0.0;
+    scalar_t averageInMilliseconds = 0.0;
+    scalar_t p50InMilliseconds = 0.0;
+    scalar_t p99InMilliseconds = 0.0;
+    scalar_t maxInMilliseconds = 0.0;
+    size_t numAllocations = 0;  // the allocations of the scope on its thread over all calls, zero if the counting is disabled
+    PerfCounterValues perfCounters;  // the counters of the scope on its thread over all calls, zero if the counting is disabled
+  };
+
+  struct Node;
+  struct ThreadBuffer;
+
+  /** Measures the time between its construction and destruction. */
+  class Scope {
+   public:
+    /** Opens the scope nested in the innermost open scope of the calling thread. */
+    Scope(Profiler& profiler, const char* name);
+
+    /**
+     * Opens the scope nested in the scope with the given path, independent of the open scopes of the calling thread. This is used for
+     * the tasks of a parallel region which is profiled by a scope on a different thread.
+     */
+    Scope(Profiler& profiler, const char* name, const char* parentPath);
+
+    ~Scope();
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+   private:
+    ThreadBuffer* bufferPtr_;
+    Node* nodePtr_;
+    Node* previousNodePtr_;
+    Tracer* tracerPtr_;
+    const char* name_;
+    size_t startNumAllocations_;
+    PerfCounterValues startPerfCounters_;
+    std::chrono::steady_clock::time_point startTime_;
+  };
+
+  /**
+   * Constructor
+   * @param [in] maxNumSamples: The number of the latest durations per scope and worker which are kept for the percentiles.
+   */
+  explicit Profiler(size_t maxNumSamples = 1000);
+  ~Profiler();
+
+  Profiler(const Profiler&) = delete;
+  Profiler& operator=(const Profiler&) = delete;
+
+  /** Sets the tracer which records the scopes as events. A null pointer disables the tracing. It must not be set while a scope is open. */
+  void setTracer(std::shared_ptr<Tracer> tracerPtr) { tracerPtr_ = std::move(tracerPtr); }
+
+  /** Gets the tracer, or null if the tracing is disabled. */
+  Tracer* getTracer() const { return tracerPtr_.get(); }
+
+  /** Resets the statistics of all scopes. */
+  void reset();
+
+  /** Gets the statistics of all scopes for each worker thread. */
+  std::vector<Statistics> getWorkerStatistics() const;
+
+  /** Gets the statistics of a scope merged over all worker threads. The statistics are empty if the scope is not visited. */
+  Statistics getStatistics(const std::string& path) const;
+
+  /** Gets the statistics of all scopes merged over all worker threads. */
+  std::vector<Statistics> getStatistics() const;
+
+  /** Gets a table of the merged statistics, followed by the per-worker breakdown of the scopes visited by more than one thread. */
+  std::string getReport() const;
+
+ private:
+  static uint64_t getUniqueId();
+  ThreadBuffer& getThreadBuffer();
+
+  const uint64_t id_;
+  const size_t maxNumSamples_;
+  mutable std::mutex threadBuffersMutex_;
+  std::vector<std::unique_ptr<ThreadBuffer>> threadBuffers_;
+  std::shared_ptr<Tracer> tracerPtr_;
+};
+
 }  // namespace benchmark
 }  // namespace ocs2
@@ -35,6 +35,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <unordered_map>
 #include <vector>
 
+#include "ocs2_core/Types.h"
+#include "ocs2_core/misc/Lookup.h"
+#include "ocs2_core/reference/ModeSchedule.h"
+
 namespace ocs2 {
 
 /**
@@ -97,7 +101,51 @@ class Collection {
    */
   bool getTermIndex(const std::string& name, size_t& index) const;
 
+  /**
+   * Caches the activity of the terms for each mode interval of the mode schedule. Afterwards, the activity of the terms at a given
+   * time is looked up from the interval that contains it, instead of calling isActive(time) on every term. The activity is evaluated
+   * once in every interval, hence this requires that the activity of the terms only changes at the event times, e.g. if it depends
+   * on the active mode only. The cache has to be updated whenever the mode schedule changes, and it is cleared by adding or removing
+   * terms.
+   *
+   * @param [in] modeSchedule: The mode schedule of the horizon.
+   */
+  void cacheTermActivity(const ModeSchedule& modeSchedule);
+
+  /** Clears the cached activity, such that isActive(time) is called on the terms again. */
+  void clearTermActivityCache() {
+    cachedEventTimes_.clear();
+    cachedActivity_.clear();
+  }
+
  protected:
+  /** Activity of the terms at a time point. It is either looked up from the cache or evaluated by the terms. */
+  class ActiveTerms {
+   public:
+    ActiveTerms(const Collection& collection, scalar_t time)
+        : collection_(collection),
+          time_(time),
+          cachedActivityPtr_(collection.cachedActivity_.empty()
+                                 ? nullptr
+                                 : &collection.cachedActivity_[lookup::findIndexInTimeArray(collection.cachedEventTimes_, time)]) {}
+
+    /** Whether the i-th term is active. */
+    bool operator[](size_t i) const {
+      return cachedActivityPtr_ != nullptr ? (*cachedActivityPtr_)[i] : collection_.terms_[i]->isActive(time_);
+    }
+
+   private:
+    const Collection& collection_;
+    const scalar_t time_;
+    const std::vector<bool>* cachedActivityPtr_;
+  };
+
+  /** Gets the activity of the terms at the given time. */
+  ActiveTerms getActiveTerms(scalar_t time) const { return ActiveTerms(*this, time); }
+
+  /** Gets the number of times terms have been added or removed. It is used by derived collections to invalidate their caches. */
+  size_t getRevision() const { return revision_; }
+
   /** Copy constructor */
   Collection(const Collection& other);
 
@@ -107,6 +155,12 @@ class Collection {
  private:
   //! Lookup from cost term name to index in the cost term vector
   std::unordered_map<std::string, size_t> termNameMap_;
+
+  //! Event times of the cached activity and the activity of the terms in each interval between them
+  std::vector<scalar_t> cachedEventTimes_;
+  std::vector<std::vector<bool>> cachedActivity_;
+
+  size_t revision_ = 0;
 };
 
 /******************************************************************************************************/
@@ -116,6 +170,8 @@ template <typename T>
 void Collection<T>::clear() {
   terms_.clear();
   termNameMap_.clear();
+  clearTermActivityCache();
+  ++revision_;
 }
 
 /******************************************************************************************************/
@@ -127,6 +183,8 @@ void Collection<T>::add(std::string name, std::unique_ptr<T> term) {
   auto info = termNameMap_.emplace(std::move(name), nextIndex);
   if (info.second) {
     terms_.push_back(std::move(term));
+    clearTermActivityCache();
+    ++revision_;
   } else {
     throw std::runtime_error(std::string("[Collection::add] Term with name \"") + info.first->first + "\" already exists");
   }
@@ -160,6 +218,8 @@ std::unique_ptr<T> Collection<T>::extract(const std::string& name) {
   auto term = (std::move(terms_[termInd]));
   // remove the term
   terms_.erase(terms_.begin() + termInd);
+  clearTermActivityCache();
+  ++revision_;
 
   return term;
 }
@@ -180,7 +240,11 @@ Derived& Collection<T>::get(const std::string& name) {
 /******************************************************************************************************/
 /******************************************************************************************************/
 template <typename T>
-Collection<T>::Collection(const Collection& other) : termNameMap_(other.termNameMap_) {
+Collection<T>::Collection(const Collection& other)
+    : termNameMap_(other.termNameMap_),
+      cachedEventTimes_(other.cachedEventTimes_),
+      cachedActivity_(other.cachedActivity_),
+      revision_(other.revision_) {
   // Loop through all terms and clone. The name map can be copied directly because the order stays the same.
   terms_.reserve(other.terms_.size());
   for (const auto& term : other.terms_) {
@@ -203,6 +267,37 @@ bool Collection<T>::getTermIndex(const std::string& name, size_t& index) const {
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <typename T>
+void Collection<T>::cacheTermActivity(const ModeSchedule& modeSchedule) {
+  const auto& eventTimes = modeSchedule.eventTimes;
+  const size_t numIntervals = eventTimes.size() + 1;
+
+  cachedEventTimes_ = eventTimes;
+  cachedActivity_.resize(numIntervals);
+  for (size_t k = 0; k < numIntervals; k++) {
+    // a time inside the k-th interval (eventTimes[k-1], eventTimes[k]]
+    scalar_t time;
+    if (eventTimes.empty()) {
+      time = 0.0;
+    } else if (k == 0) {
+      time = eventTimes.front() - 1.0;
+    } else if (k == eventTimes.size()) {
+      time = eventTimes.back() + 1.0;
+    } else {
+      time = 0.5 * (eventTimes[k - 1] + eventTimes[k]);
+    }
+
+    auto& activity = cachedActivity_[k];
+    activity.resize(terms_.size());
+    for (size_t i = 0; i < terms_.size(); i++) {
+      activity[i] = terms_[i]->isActive(time);
+    }
+  }
+}
+
 /**
  * Helper function for merging two vectors by moving objects.
  * @param v1 : vector to move objects to
@@ -0,0 +1,82 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include <ocs2_core/Types.h>
+
+namespace ocs2 {
+
+/** A block of consecutive indices [start, start + size) of a vector. */
+struct IndexBlock {
+  IndexBlock() = default;
+  IndexBlock(size_t startArg, size_t sizeArg) : start(startArg), size(sizeArg) {}
+
+  size_t start = 0;
+  size_t size = 0;
+};
+
+/**
+ * The footprint of a cost or constraint term, i.e., the blocks of the state and the input on which the term depends. The derivatives of
+ * the term w.r.t. all entries outside of these blocks are zero, hence only the blocks inside the footprint have to be assembled. The
+ * blocks are sorted and neither overlap nor touch each other.
+ */
+struct Footprint {
+  std::vector<IndexBlock> stateBlocks;
+  std::vector<IndexBlock> inputBlocks;
+
+  /** Creates the footprint of the given state and input indices. Consecutive indices are merged into one block. */
+  static Footprint fromIndices(std::vector<size_t> stateIndices, std::vector<size_t> inputIndices);
+};
+
+/**
+ * Adds the quadratic approximation of a term to the accumulator, only touching the entries inside the footprint of the term.
+ *
+ * @param [in] footprint: The footprint of the term.
+ * @param [in] approximation: The full sized quadratic approximation of the term.
+ * @param [in, out] accumulator: The accumulated quadratic approximation.
+ */
+void addFootprintBlocks(const Footprint& footprint, const ScalarFunctionQuadraticApproximation& approximation,
+                        ScalarFunctionQuadraticApproximation& accumulator);
+
+/**
+ * Writes the linear approximation of a term into the rows [startRow, startRow + approximation.f.rows()) of a stacked approximation. Only
+ * the columns inside the footprint of the term are copied, the other columns of these rows are set to zero.
+ *
+ * @param [in] footprint: The footprint of the term.
+ * @param [in] approximation: The full sized linear approximation of the term.
+ * @param [in] startRow: The first row of the term in the stacked approximation.
+ * @param [in, out] stackedApproximation: The stacked linear approximation.
+ */
+void writeFootprintBlocks(const Footprint& footprint, const VectorFunctionLinearApproximation& approximation, size_t startRow,
+                          VectorFunctionLinearApproximation& stackedApproximation);
+
+}  // namespace ocs2
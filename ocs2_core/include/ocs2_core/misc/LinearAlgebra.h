@@ -43,6 +43,8 @@ void makePsdEigenvalue(matrix_t& squareMatrix, scalar_t minEigenvalue);
 
 void makePsdCholesky(matrix_t& A, scalar_t minEigenvalue);
 
+void makePsdCholeskyShift(matrix_t& A, scalar_t minEigenvalue);
+
 void computeConstraintProjection(const matrix_t& Dm, const matrix_t& RmInvUmUmT, matrix_t& DmDagger, matrix_t& DmDaggerTRmDmDaggerUUT,
                                  matrix_t& RmInvConstrainedUUT);
 
@@ -127,6 +129,25 @@ void makePsdCholesky(Eigen::MatrixBase<Derived>& A, scalar_t minEigenvalue = num
   A = mat;
 }
 
+/**
+ * Makes the input matrix PSD by adding a multiple of the identity. The smallest shift is searched with repeated dense Cholesky
+ * factorizations of A + (shift - minEigenvalue) I, starting from zero and doubling the shift on failure (Algorithm 3.3 of
+ * J. Nocedal and S. J. Wright, Numerical Optimization). If A - minEigenvalue I is already positive definite, a single factorization
+ * is performed and A is only symmetrized. The factorization workspace is kept per thread, so repeated calls with the same
+ * dimension do not allocate memory. If the shift does not succeed after a bounded number of doublings, the eigenvalue correction is used.
+ * Throws std::runtime_error if A contains NaN or Inf.
+ *
+ * @tparam Derived type.
+ * @param A: The matrix to become PSD.
+ * @param [in] minEigenvalue: minimum eigenvalue.
+ */
+template <typename Derived>
+void makePsdCholeskyShift(Eigen::MatrixBase<Derived>& A, scalar_t minEigenvalue = numeric_traits::limitEpsilon<scalar_t>()) {
+  matrix_t mat = A;
+  makePsdCholeskyShift(mat, minEigenvalue);
+  A = mat;
+}
+
 /**
  * Computes the U*U^T decomposition associated to the inverse of the input matrix, where U is an upper triangular
  * matrix. Note that the U*U^T decomposition is different from the Cholesky decomposition (U^T*U).
@@ -168,7 +189,7 @@ int rank(const Derived& A) {
 
 /** Computes the complex eigenvalues of A */
 template <typename Derived>
-Eigen::VectorXcd eigenvalues(const Derived& A) {
+Eigen::Matrix<std::complex<scalar_t>, Eigen::Dynamic, 1> eigenvalues(const Derived& A) {
   return A.eigenvalues();
 }
 
@@ -180,7 +201,7 @@ vector_t symmetricEigenvalues(const Derived& A) {
 
 // Declaring explicit instantiations for dynamic sized matrices
 extern template int rank(const matrix_t& A);
-extern template Eigen::VectorXcd eigenvalues(const matrix_t& A);
+extern template Eigen::Matrix<std::complex<scalar_t>, Eigen::Dynamic, 1> eigenvalues(const matrix_t& A);
 extern template vector_t symmetricEigenvalues(const matrix_t& A);
 
 }  // namespace LinearAlgebra
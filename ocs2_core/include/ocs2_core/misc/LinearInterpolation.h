@@ -53,6 +53,17 @@ using remove_cvref_t = typename std::remove_cv<typename std::remove_reference<T>
  */
 index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray);
 
+/**
+ * Same as timeSegment(enquiryTime, timeArray), but the lookup starts at a cursor which is updated to the lookup result. The cursor
+ * makes the lookup O(1) for monotonically increasing enquiry times, e.g. the evaluation of a policy in a control loop.
+ *
+ * @param [in] enquiryTime: The enquiry time for interpolation.
+ * @param [in] timeArray: interpolation time array.
+ * @param [in, out] cursor: The state of the lookup, which should be initialized to zero for a new timeArray.
+ * @return {index, alpha}
+ */
+index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray, int& cursor);
+
 /**
  * Directly uses the index and interpolation coefficient provided by the user
  * @note If sizes in data array are not equal, the interpolation will snap to the data
@@ -31,6 +31,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <Eigen/Dense>
 #include <iostream>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -92,6 +93,40 @@ inline void loadPtreeValue(const boost::property_tree::ptree& pt, T& value, cons
   }
 }
 
+/**
+ * Reads a file with INFO format into a property tree (refer to https://www.boost.org/doc/libs/1_65_1/doc/html/property_tree.html).
+ *
+ * The parsed trees are cached by the file path and its modification time, such that the settings loaders which read the same file
+ * only parse it once. A modified file is parsed again. If the file is part of a loaded settings bundle (see loadSettingsBundle), the
+ * bundled tree is returned without accessing the file. This function is thread-safe.
+ *
+ * @param [in] filename: File name which contains the configuration data.
+ * @return A pointer to the parsed property tree.
+ */
+std::shared_ptr<const boost::property_tree::ptree> readInfoFile(const std::string& filename);
+
+/**
+ * Clears the cache of the parsed INFO files including the loaded settings bundles.
+ */
+void clearInfoFileCache();
+
+/**
+ * Parses the given INFO files and writes them into a binary settings bundle. The bundle is meant for the deployment on the same
+ * platform, e.g. to avoid parsing the task files on the start-up of a robot.
+ *
+ * @param [in] bundleFile: The file name of the settings bundle.
+ * @param [in] filenames: The INFO files to be bundled. Their paths are stored as given.
+ */
+void saveSettingsBundle(const std::string& bundleFile, const std::vector<std::string>& filenames);
+
+/**
+ * Loads a binary settings bundle written by saveSettingsBundle. Afterwards, readInfoFile returns the bundled trees for the bundled
+ * file paths, even if the INFO files are modified or not available.
+ *
+ * @param [in] bundleFile: The file name of the settings bundle.
+ */
+void loadSettingsBundle(const std::string& bundleFile);
+
 /**
  * An auxiliary function which loads value of the c++ data types from a file. The file uses property tree data structure with INFO format
  * (refer to https://www.boost.org/doc/libs/1_65_1/doc/html/property_tree.html).
@@ -102,10 +137,8 @@ inline void loadPtreeValue(const boost::property_tree::ptree& pt, T& value, cons
  */
 template <typename cpp_data_t>
 inline void loadCppDataType(const std::string& filename, const std::string& dataName, cpp_data_t& value) {
-  boost::property_tree::ptree pt;
-  boost::property_tree::read_info(filename, pt);
-
-  value = pt.get<cpp_data_t>(dataName);
+  const auto ptPtr = readInfoFile(filename);
+  value = ptPtr->get<cpp_data_t>(dataName);
 }
 
 /**
@@ -139,8 +172,8 @@ inline void loadEigenMatrix(const std::string& filename, const std::string& matr
     throw std::runtime_error("[loadEigenMatrix] Loading empty matrix \"" + matrixName + "\" is not allowed.");
   }
 
-  boost::property_tree::ptree pt;
-  boost::property_tree::read_info(filename, pt);
+  const auto ptPtr = readInfoFile(filename);
+  const boost::property_tree::ptree& pt = *ptPtr;
 
   const scalar_t scaling = pt.get<scalar_t>(matrixName + ".scaling", 1.0);
   const scalar_t defaultValue = pt.get<scalar_t>(matrixName + ".default", 0.0);
@@ -168,8 +201,8 @@ inline void loadEigenMatrix(const std::string& filename, const std::string& matr
 
 template <typename T>
 inline void loadStdVector(const std::string& filename, const std::string& topicName, std::vector<T>& loadVector, bool verbose = true) {
-  boost::property_tree::ptree pt;
-  boost::property_tree::read_info(filename, pt);
+  const auto ptPtr = readInfoFile(filename);
+  const boost::property_tree::ptree& pt = *ptPtr;
 
   std::vector<T> backup;
   backup.swap(loadVector);
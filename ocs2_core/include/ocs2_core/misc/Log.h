@@ -77,6 +77,13 @@ struct Settings {
   SeverityLevel logFileSeverity = SeverityLevel::INFO;
   /** File name, supports boost log file name pattern including date and time. */
   std::string logFileName = "ocs2_%Y%m%d_%H%M%S.log";
+  /**
+   * Enable asynchronous logging. The logging threads then only push the records into a lock-free bounded ring buffer and a background
+   * thread formats and writes them, such that logging does not block the real-time threads. Records are dropped when the buffer is full.
+   */
+  bool asynchronous = false;
+  /** The capacity of the asynchronous logging ring buffer in records, rounded up to a power of two. */
+  size_t asynchronousBufferSize = 1024;
 };
 
 /**
@@ -96,6 +103,12 @@ void init(const Settings& settings, std::ostream* console_stream = &std::clog);
 /** Reset OCS2 logger sinks */
 void reset();
 
+/** Wait until the background thread of the asynchronous logging has written all the buffered records and flush the sinks. */
+void flush();
+
+/** Get the number of records dropped by the asynchronous logging since the last init() because its ring buffer was full. */
+size_t getNumDroppedRecords();
+
 /**
  * Get global OCS2 logger
  * @return global logger reference
@@ -91,6 +91,44 @@ int findIndexInTimeArray(const std::vector<SCALAR>& timeArray, SCALAR time) {
   return static_cast<int>(firstLargerValueIterator - timeArray.begin());
 }
 
+/**
+ * Same as findIndexInTimeArray, but the search starts at a hint, typically the result of the previous lookup. The search gallops
+ * forward or backward from the hint, hence it is O(1) for monotonically increasing or decreasing enquiry times that advance by a few
+ * entries per lookup, e.g. the forward rollout or the backward Riccati integration.
+ *
+ * @tparam SCALAR : numerical type of time
+ * @param timeArray : sorted time array to perform the lookup in
+ * @param time : enquiry time
+ * @param hint : the index where the search starts, which is set to the result.
+ * @return index between [0, size(timeArray)]
+ */
+template <typename SCALAR = double>
+int findIndexInTimeArray(const std::vector<SCALAR>& timeArray, SCALAR time, int& hint) {
+  const auto size = static_cast<int>(timeArray.size());
+  if (hint < 0 || hint > size) {
+    hint = findIndexInTimeArray(timeArray, time);
+  } else if (hint > 0 && !(timeArray[hint - 1] < time)) {
+    // the hint is past the result: gallop backward while the result is at most last
+    int last = hint - 1;
+    int step = 1;
+    while (last - step >= 0 && !(timeArray[last - step] < time)) {
+      last -= step;
+      step *= 2;
+    }
+    const auto firstIterator = timeArray.begin() + std::max(last - step + 1, 0);
+    hint = static_cast<int>(std::lower_bound(firstIterator, timeArray.begin() + last, time) - timeArray.begin());
+  } else {
+    int step = 1;
+    while (hint + step < size && timeArray[hint + step] < time) {
+      hint += step;
+      step *= 2;
+    }
+    const auto lastIterator = timeArray.begin() + std::min(hint + step, size);
+    hint = static_cast<int>(std::lower_bound(timeArray.begin() + hint, lastIterator, time) - timeArray.begin());
+  }
+  return hint;
+}
+
 /**
  *  Find interval into a sorted time Array
  *
@@ -0,0 +1,86 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "ocs2_core/Types.h"
+
+namespace ocs2 {
+
+/**
+ * A small fully connected feed-forward network for the inference of networks which are trained offline, e.g. a warm start policy. The
+ * hidden layers use a tanh activation and the output layer is linear:
+ *    y_{k+1} = tanh(W_k y_k + b_k),  for the hidden layers
+ *    output = W_n y_n + b_n
+ * The layers are evaluated with Eigen's vectorized matrix-vector products into preallocated buffers, such that the evaluation does not
+ * allocate. Each copy owns its buffers, therefore a copy should be used per thread.
+ *
+ * The network is exported as a plain text file which is easy to write from the training code (e.g. numpy.savetxt):
+ *    numLayers
+ *    rows cols        (of the first layer)
+ *    W_0              (rows x cols, row-major)
+ *    b_0              (rows)
+ *    ...
+ */
+class MultiLayerPerceptron {
+ public:
+  /**
+   * Constructor
+   * @param [in] weights: The weight matrices of the layers, from the input to the output layer.
+   * @param [in] biases: The bias vectors of the layers.
+   */
+  MultiLayerPerceptron(std::vector<matrix_t> weights, std::vector<vector_t> biases);
+
+  /** Loads the network from a file in the format described above. */
+  static MultiLayerPerceptron load(const std::string& fileName);
+
+  /** Saves the network to a file in the format described above. */
+  void save(const std::string& fileName) const;
+
+  size_t getInputDim() const { return weights_.front().cols(); }
+  size_t getOutputDim() const { return weights_.back().rows(); }
+  size_t getNumLayers() const { return weights_.size(); }
+
+  /**
+   * Evaluates the network.
+   * @param [in] input: The input of the network.
+   * @return The output of the network which is valid until the next evaluation.
+   */
+  const vector_t& evaluate(const vector_t& input);
+
+ private:
+  std::vector<matrix_t> weights_;
+  std::vector<vector_t> biases_;
+  std::vector<vector_t> layerOutputs_;
+};
+
+}  // namespace ocs2
@@ -0,0 +1,90 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+namespace ocs2 {
+namespace benchmark {
+
+/** The hardware performance counters of a thread */
+struct PerfCounterValues {
+  uint64_t cycles = 0;
+  uint64_t instructions = 0;
+  uint64_t llcMisses = 0;  // last level cache misses
+  uint64_t branchMisses = 0;
+
+  PerfCounterValues& operator+=(const PerfCounterValues& rhs) {
+    cycles += rhs.cycles;
+    instructions += rhs.instructions;
+    llcMisses += rhs.llcMisses;
+    branchMisses += rhs.branchMisses;
+    return *this;
+  }
+
+  PerfCounterValues operator-(const PerfCounterValues& rhs) const {
+    PerfCounterValues difference;
+    difference.cycles = cycles - rhs.cycles;
+    difference.instructions = instructions - rhs.instructions;
+    difference.llcMisses = llcMisses - rhs.llcMisses;
+    difference.branchMisses = branchMisses - rhs.branchMisses;
+    return difference;
+  }
+};
+
+/**
+ * Reads the hardware performance counters (cycles, instructions, last level cache misses, and branch misses) of the calling thread through
+ * the Linux perf_event_open interface. The counting is opt-in and process-wide: once enabled, each thread opens its counter group on its
+ * first read. The counters only count in user space, such that they are accessible with the default perf_event_paranoid level of 2.
+ *
+ * If the kernel disallows the access (e.g. perf_event_paranoid is 3 or the process runs in a container without CAP_PERFMON), enable()
+ * fails and all reads return zeros. A counter which is not supported by the CPU (e.g. the cache misses in a virtual machine) reads zero
+ * while the others are still counted.
+ */
+namespace perf_counters {
+
+/**
+ * Enables the counting for all threads.
+ * @return false if the counters are not accessible, in which case the counting stays disabled.
+ */
+bool enable();
+
+/** Disables the counting. The counter groups of the threads are kept open. */
+void disable();
+
+/** Whether the counting is enabled. */
+bool isEnabled();
+
+/** The counters of the calling thread since it opened its counter group. All zero if the counting is disabled. */
+PerfCounterValues readThreadCounters();
+
+}  // namespace perf_counters
+}  // namespace benchmark
+}  // namespace ocs2
@@ -0,0 +1,134 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "ocs2_core/Types.h"
+
+namespace ocs2 {
+
+/**
+ * A monotonic arena for the scratch vectors and matrices of hot-path code, such as the temporaries of a term evaluation at a node. The
+ * memory is handed out as vector_map_t and matrix_map_t by bumping an offset and it is released by rewinding the arena, e.g. at the end
+ * of a Scope. Once the arena is rewound completely, the blocks which it has grown into are merged into one, such that the next solver
+ * phase of the same size does not allocate at all.
+ *
+ * Each thread has its own arena, see getThreadScratchArena(). Code opts in by opening a scope and taking its temporaries from the arena:
+ *    ScratchArena::Scope scope(getThreadScratchArena());
+ *    auto tmp = scope.getMatrix(rows, cols);
+ *    tmp.noalias() = A * B;
+ * The maps are only valid until the scope is closed. They should therefore not be returned or stored, and a function which is called
+ * within a scope opens its own scope. The arena applies where the allocation counts of the benchmarks (see benchmark::AllocationCounter)
+ * show many small temporaries with a lifetime of a single function call. Results that outlive the call keep using vector_t and
+ * matrix_t.
+ */
+class ScratchArena {
+ public:
+  /** The position of the arena, to which it is rewound */
+  struct Marker {
+    size_t blockIndex;
+    size_t offset;
+  };
+
+  /** Rewinds the arena at the end of the scope to its position at the start of the scope */
+  class Scope {
+   public:
+    explicit Scope(ScratchArena& arena) : arena_(arena), marker_(arena.getMarker()) {}
+    ~Scope() { arena_.rewind(marker_); }
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+    /** Uninitialized vector of the given size */
+    vector_map_t getVector(Eigen::Index rows) { return arena_.getVector(rows); }
+
+    /** Uninitialized matrix of the given size */
+    matrix_map_t getMatrix(Eigen::Index rows, Eigen::Index cols) { return arena_.getMatrix(rows, cols); }
+
+   private:
+    ScratchArena& arena_;
+    const Marker marker_;
+  };
+
+  /**
+   * Constructor
+   * @param [in] initialCapacity : The size of the first block in bytes, it is allocated with the first request.
+   */
+  explicit ScratchArena(size_t initialCapacity = 16 * 1024);
+
+  ScratchArena(const ScratchArena&) = delete;
+  ScratchArena& operator=(const ScratchArena&) = delete;
+
+  /** Returns numBytes of uninitialized memory which is aligned for vectorized Eigen operations */
+  void* allocate(size_t numBytes);
+
+  /** Uninitialized vector of the given size */
+  vector_map_t getVector(Eigen::Index rows) { return vector_map_t(static_cast<scalar_t*>(allocate(rows * sizeof(scalar_t))), rows); }
+
+  /** Uninitialized matrix of the given size */
+  matrix_map_t getMatrix(Eigen::Index rows, Eigen::Index cols) {
+    return matrix_map_t(static_cast<scalar_t*>(allocate(rows * cols * sizeof(scalar_t))), rows, cols);
+  }
+
+  /** The current position of the arena */
+  Marker getMarker() const { return {blockIndex_, offset_}; }
+
+  /** Releases the memory handed out since the marker was taken. The maps on this memory become invalid. */
+  void rewind(const Marker& marker);
+
+  /** Releases all memory of the arena for reuse */
+  void reset() { rewind({0, 0}); }
+
+  /** The total size of the blocks in bytes */
+  size_t getCapacity() const;
+
+  /** The number of blocks, which is one for an arena which has not grown since it was last reset */
+  size_t getNumBlocks() const { return blocks_.size(); }
+
+ private:
+  struct Block {
+    explicit Block(size_t size);
+    std::unique_ptr<char[]> memory;
+    char* data;
+    size_t size;
+  };
+
+  std::vector<Block> blocks_;
+  size_t blockIndex_ = 0;
+  size_t offset_ = 0;
+  size_t initialCapacity_;
+};
+
+/** The scratch arena of the calling thread */
+ScratchArena& getThreadScratchArena();
+
+}  // namespace ocs2
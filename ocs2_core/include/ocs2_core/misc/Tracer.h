@@ -0,0 +1,121 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+
+namespace ocs2 {
+namespace benchmark {
+
+/**
+ * Records a timeline of named events with their thread and timestamps into a fixed size ring buffer, such that the latest events can be
+ * dumped on demand, e.g. after an MPC cycle has missed its deadline. The dump is in the Chrome trace event format (JSON) which is read by
+ * chrome://tracing and the Perfetto UI.
+ *
+ * Recording an event neither locks nor allocates. A slot which is overwritten while it is dumped is detected by its sequence number and
+ * skipped. The names of the events are not copied, hence they must have static storage duration (e.g. string literals).
+ */
+class Tracer {
+ public:
+  using clock = std::chrono::steady_clock;
+
+  /**
+   * Constructor
+   * @param [in] capacity: The number of the latest events which are kept.
+   */
+  explicit Tracer(size_t capacity = 65536);
+  ~Tracer();
+
+  Tracer(const Tracer&) = delete;
+  Tracer& operator=(const Tracer&) = delete;
+
+  /** Records an event of the calling thread which lasted from startTime to endTime. */
+  void addEvent(const char* name, clock::time_point startTime, clock::time_point endTime);
+
+  /** Records an instantaneous event of the calling thread at the current time. */
+  void addInstantEvent(const char* name);
+
+  /** Removes all the events. This method must not be called while events are recorded. */
+  void clear();
+
+  /** The number of events which are currently kept. */
+  size_t getNumEvents() const;
+
+  /** Writes the kept events in the Chrome trace event format. */
+  void writeChromeTrace(std::ostream& stream) const;
+
+  /**
+   * Writes the kept events in the Chrome trace event format to the given file.
+   * @return false if the file could not be written.
+   */
+  bool dumpChromeTrace(const std::string& fileName) const;
+
+ private:
+  struct Slot;
+
+  void addEvent(const char* name, clock::time_point startTime, int64_t durationInNanoseconds);
+
+  const clock::time_point originTime_;
+  const size_t capacity_;
+  std::unique_ptr<Slot[]> slots_;
+  std::atomic<uint64_t> numRecordedEvents_{0};
+};
+
+/** Measures the time between its construction and destruction as an event of the tracer. Does nothing if the tracer is null. */
+class TraceScope {
+ public:
+  TraceScope(Tracer* tracerPtr, const char* name) : tracerPtr_(tracerPtr), name_(name) {
+    if (tracerPtr_ != nullptr) {
+      startTime_ = Tracer::clock::now();
+    }
+  }
+
+  ~TraceScope() {
+    if (tracerPtr_ != nullptr) {
+      tracerPtr_->addEvent(name_, startTime_, Tracer::clock::now());
+    }
+  }
+
+  TraceScope(const TraceScope&) = delete;
+  TraceScope& operator=(const TraceScope&) = delete;
+
+ private:
+  Tracer* tracerPtr_;
+  const char* name_;
+  Tracer::clock::time_point startTime_;
+};
+
+}  // namespace benchmark
+}  // namespace ocs2
@@ -66,13 +66,9 @@ const Data& stdAccessFun(const std::vector<Data, Alloc>& vec, size_t ind) {
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-inline index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray) {
-  // corner cases (no time set OR single time element)
-  if (timeArray.size() <= 1) {
-    return {0, scalar_t(1.0)};
-  }
-
-  const int index = lookup::findIntervalInTimeArray(timeArray, enquiryTime);
+namespace detail {
+/** Gets the interpolation coefficient of the given interval as returned by lookup::findIntervalInTimeArray */
+inline index_alpha_t intervalSegment(int index, scalar_t enquiryTime, const std::vector<scalar_t>& timeArray) {
   const auto lastInterval = static_cast<int>(timeArray.size() - 1);
   if (index >= 0) {
     if (index < lastInterval) {
@@ -103,6 +99,33 @@ inline index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_
     return {0, scalar_t(1.0)};
   }
 }
+}  // namespace detail
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+inline index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray) {
+  // corner cases (no time set OR single time element)
+  if (timeArray.size() <= 1) {
+    return {0, scalar_t(1.0)};
+  }
+
+  const int index = lookup::findIntervalInTimeArray(timeArray, enquiryTime);
+  return detail::intervalSegment(index, enquiryTime, timeArray);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+inline index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray, int& cursor) {
+  // corner cases (no time set OR single time element)
+  if (timeArray.size() <= 1) {
+    return {0, scalar_t(1.0)};
+  }
+
+  const int index = lookup::findIndexInTimeArray(timeArray, enquiryTime, cursor) - 1;
+  return detail::intervalSegment(index, enquiryTime, timeArray);
+}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -0,0 +1,176 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "ocs2_core/Types.h"
+#include "ocs2_core/misc/LinearInterpolation.h"
+#include "ocs2_core/model_data/ModelData.h"
+
+namespace ocs2 {
+
+/**
+ * A trajectory of matrices (or vectors) stored in one contiguous buffer, node after node in column-major order. The sizes of the
+ * matrices may differ between the nodes. Clearing and refilling the trajectory keeps the memory of the buffer.
+ */
+class MatrixTrajectory {
+ public:
+  /** Removes all nodes, the memory is kept for refilling */
+  void clear();
+
+  /** Reserves memory for numNodes nodes with numScalars entries in total */
+  void reserve(size_t numNodes, size_t numScalars);
+
+  /** Appends a matrix (or vector) at the end of the trajectory */
+  template <typename Derived>
+  void push_back(const Eigen::MatrixBase<Derived>& matrix) {
+    offsets_.push_back(buffer_.size());
+    rows_.push_back(matrix.rows());
+    cols_.push_back(matrix.cols());
+    buffer_.resize(buffer_.size() + matrix.size());
+    Eigen::Map<matrix_t>(buffer_.data() + offsets_.back(), matrix.rows(), matrix.cols()) = matrix;
+  }
+
+  /** Number of nodes */
+  size_t size() const { return rows_.size(); }
+
+  /** Read access to the matrix of the node */
+  Eigen::Map<const matrix_t> operator[](size_t ind) const { return {buffer_.data() + offsets_[ind], rows_[ind], cols_[ind]}; }
+
+  /** Whether the matrices of two nodes have the same size */
+  bool areSameSize(size_t lhs, size_t rhs) const { return rows_[lhs] == rows_[rhs] && cols_[lhs] == cols_[rhs]; }
+
+ private:
+  std::vector<scalar_t> buffer_;
+  std::vector<size_t> offsets_;
+  std::vector<Eigen::Index> rows_;
+  std::vector<Eigen::Index> cols_;
+};
+
+/**
+ * Structure-of-arrays layout of a ModelData trajectory: each field is stored in a contiguous buffer across all nodes, such that the
+ * interpolation of a field reads consecutive memory. The fields are named after the access functions in ModelDataLinearInterpolation.h.
+ */
+struct ModelDataTrajectory {
+  // Time
+  scalar_array_t time;
+
+  // Dynamics
+  MatrixTrajectory dynamicsBias;
+  MatrixTrajectory dynamicsCovariance;
+  MatrixTrajectory dynamics_f;
+  MatrixTrajectory dynamics_dfdx;
+  MatrixTrajectory dynamics_dfdu;
+
+  // Cost
+  scalar_array_t cost_f;
+  MatrixTrajectory cost_dfdx;
+  MatrixTrajectory cost_dfdxx;
+  MatrixTrajectory cost_dfdu;
+  MatrixTrajectory cost_dfduu;
+  MatrixTrajectory cost_dfdux;
+
+  // State equality constraints
+  MatrixTrajectory stateEqConstraint_f;
+  MatrixTrajectory stateEqConstraint_dfdx;
+
+  // State-input equality constraints
+  MatrixTrajectory stateInputEqConstraint_f;
+  MatrixTrajectory stateInputEqConstraint_dfdx;
+  MatrixTrajectory stateInputEqConstraint_dfdu;
+
+  /** Number of nodes */
+  size_t size() const { return time.size(); }
+
+  /** Removes all nodes, the memory is kept for refilling */
+  void clear();
+
+  /** Sets the content to the given ModelData trajectory */
+  void assign(const std::vector<ModelData>& modelDataTrajectory);
+};
+
+namespace model_data {
+
+/** The fields of ModelDataTrajectory as bits of a mask, which selects the fields of a fused interpolation. */
+enum Field : uint32_t {
+  TIME = 1u << 0,
+  DYNAMICS_BIAS = 1u << 1,
+  DYNAMICS_COVARIANCE = 1u << 2,
+  DYNAMICS_F = 1u << 3,
+  DYNAMICS_DFDX = 1u << 4,
+  DYNAMICS_DFDU = 1u << 5,
+  COST_F = 1u << 6,
+  COST_DFDX = 1u << 7,
+  COST_DFDXX = 1u << 8,
+  COST_DFDU = 1u << 9,
+  COST_DFDUU = 1u << 10,
+  COST_DFDUX = 1u << 11,
+  STATE_EQ_CONSTRAINT_F = 1u << 12,
+  STATE_EQ_CONSTRAINT_DFDX = 1u << 13,
+  STATE_INPUT_EQ_CONSTRAINT_F = 1u << 14,
+  STATE_INPUT_EQ_CONSTRAINT_DFDX = 1u << 15,
+  STATE_INPUT_EQ_CONSTRAINT_DFDU = 1u << 16,
+  ALL_FIELDS = (1u << 17) - 1
+};
+
+}  // namespace model_data
+
+namespace LinearInterpolation {
+
+/**
+ * Fused interpolation of a ModelDataTrajectory: the fields selected by the mask are interpolated at the given index-alpha pair and
+ * written in place into the corresponding fields of the result. The other fields of the result are left unchanged, therefore a result
+ * which is reused for every query does not allocate once its fields have the final sizes.
+ *
+ * @param [in] indexAlpha : index and interpolation coefficient (alpha) pair
+ * @param [in] trajectory: The ModelData trajectory.
+ * @param [in] fields: The bit mask of the fields to be interpolated, see model_data::Field.
+ * @param [out] result: The interpolated ModelData.
+ */
+void interpolate(index_alpha_t indexAlpha, const ModelDataTrajectory& trajectory, uint32_t fields, ModelData& result);
+
+/**
+ * Interpolates a MatrixTrajectory with the same conventions as LinearInterpolation::interpolate for std::vector: if the sizes of the
+ * two nodes differ, the node closest to the query is taken, and a single node implies a constant function.
+ *
+ * @param [in] indexAlpha : index and interpolation coefficient (alpha) pair
+ * @param [in] trajectory: The trajectory of matrices.
+ * @param [out] result: The interpolation result, written in place.
+ */
+void interpolate(index_alpha_t indexAlpha, const MatrixTrajectory& trajectory, matrix_t& result);
+
+/** Vector version of the MatrixTrajectory interpolation, the nodes are column vectors */
+void interpolate(index_alpha_t indexAlpha, const MatrixTrajectory& trajectory, vector_t& result);
+
+}  // namespace LinearInterpolation
+}  // namespace ocs2
@@ -144,5 +144,16 @@ Multiplier interpolate(const index_alpha_t& indexAlpha, const std::vector<Multip
  */
 MultiplierCollection interpolate(const index_alpha_t& indexAlpha, const std::vector<MultiplierCollection>& dataArray);
 
+/**
+ * Linearly interpolates a trajectory of MultiplierCollections in-place. The memory of the output is reused, such that resampling a
+ * dual solution on a new time grid with the same constraint sizes does not allocate.
+ *
+ * @param [in] indexAlpha : index and interpolation coefficient (alpha) pair.
+ * @param [in] dataArray : A trajectory of MultiplierCollections.
+ * @param [out] multiplierCollection : The interpolated MultiplierCollection at indexAlpha.
+ */
+void interpolate(const index_alpha_t& indexAlpha, const std::vector<MultiplierCollection>& dataArray,
+                 MultiplierCollection& multiplierCollection);
+
 }  // namespace LinearInterpolation
 }  // namespace ocs2
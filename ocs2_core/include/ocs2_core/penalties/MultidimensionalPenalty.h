@@ -103,6 +103,29 @@ class MultidimensionalPenalty final {
   ScalarFunctionQuadraticApproximation getQuadraticApproximation(scalar_t t, const VectorFunctionQuadraticApproximation& h,
                                                                  const vector_t* l = nullptr) const;
 
+  /**
+   * Adds the penalty cost quadratic approximation to an accumulator of the size of the state and input, e.g., the cost approximation of
+   * a stage. The Gauss-Newton part dhdz' * diag(penalty'') * dhdz is added by a symmetric rank update of the accumulator, such that no
+   * temporary of the size of the Hessian is created.
+   *
+   * @param [in] t: The time that the constraint is evaluated.
+   * @param [in] h: The constraint linear approximation.
+   * @param [in, out] accumulator: The quadratic approximation which the penalty is added to.
+   */
+  void accumulateQuadraticApproximation(scalar_t t, const VectorFunctionLinearApproximation& h, const vector_t* l,
+                                        ScalarFunctionQuadraticApproximation& accumulator) const;
+
+  /**
+   * Adds the penalty cost quadratic approximation to an accumulator of the size of the state and input. See the overload for the linear
+   * approximation of the constraint.
+   *
+   * @param [in] t: The time that the constraint is evaluated.
+   * @param [in] h: The constraint quadratic approximation.
+   * @param [in, out] accumulator: The quadratic approximation which the penalty is added to.
+   */
+  void accumulateQuadraticApproximation(scalar_t t, const VectorFunctionQuadraticApproximation& h, const vector_t* l,
+                                        ScalarFunctionQuadraticApproximation& accumulator) const;
+
   /**
    * Updates the Lagrange multipliers.
    *
@@ -91,7 +91,7 @@ class SlacknessSquaredHingePenalty final : public AugmentedPenaltyBase {
   scalar_t getSecondDerivative(scalar_t t, scalar_t l, scalar_t h) const override { return (h < l / config_.scale) ? config_.scale : 0.0; }
 
   scalar_t updateMultiplier(scalar_t t, scalar_t l, scalar_t h) const override {
-    return std::max(0.0, std::max(l - config_.stepSize * config_.scale * h, (1.0 - config_.stepSize) * l));
+    return std::max(scalar_t(0.0), std::max(l - config_.stepSize * config_.scale * h, (scalar_t(1.0) - config_.stepSize) * l));
   }
   scalar_t initializeMultiplier() const override { return 0.0; }
 
@@ -80,6 +80,45 @@ class PenaltyBase {
    */
   virtual scalar_t getSecondDerivative(scalar_t t, scalar_t h) const = 0;
 
+  /**
+   * Compute the sum of the penalty values for a vector of constraint values. The default implementation calls getValue() for each
+   * element. Penalties override it with an Eigen array expression such that the evaluation is vectorized.
+   *
+   * @param [in] t: The time that the constraint is evaluated.
+   * @param [in] h: Vector of constraint values.
+   * @return sum of the penalty costs.
+   */
+  virtual scalar_t getTotalValue(scalar_t t, const vector_t& h) const {
+    scalar_t value = 0.0;
+    for (size_t i = 0; i < h.size(); i++) {
+      value += getValue(t, h(i));
+    }
+    return value;
+  }
+
+  /**
+   * Compute the sum of the penalty values and the element-wise penalty derivatives for a vector of constraint values. The default
+   * implementation calls the scalar methods for each element. Penalties override it with an Eigen array expression such that the
+   * evaluation is vectorized.
+   *
+   * @param [in] t: The time that the constraint is evaluated.
+   * @param [in] h: Vector of constraint values.
+   * @param [out] derivative: The penalty derivatives with respect to the constraint values.
+   * @param [out] secondDerivative: The penalty second derivatives with respect to the constraint values.
+   * @return sum of the penalty costs.
+   */
+  virtual scalar_t getTotalValueAndDerivatives(scalar_t t, const vector_t& h, vector_t& derivative, vector_t& secondDerivative) const {
+    derivative.resize(h.size());
+    secondDerivative.resize(h.size());
+    scalar_t value = 0.0;
+    for (size_t i = 0; i < h.size(); i++) {
+      value += getValue(t, h(i));
+      derivative(i) = getDerivative(t, h(i));
+      secondDerivative(i) = getSecondDerivative(t, h(i));
+    }
+    return value;
+  }
+
  protected:
   PenaltyBase(const PenaltyBase& other) = default;
 };
@@ -29,6 +29,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <cstdint>
 #include <ostream>
 #include <vector>
 
@@ -76,6 +77,44 @@ struct ModeSchedule {
   std::vector<size_t> modeSequence;  // mode sequence of size N
 };
 
+/**
+ * Looks up the mode intervals of a ModeSchedule for the terms which are evaluated at every node. The terms of a node query the same
+ * time and the nodes of a worker are evaluated in the order of time. Hence, each thread keeps the interval of its last query and the
+ * search starts from there, see lookup::findIndexInTimeArray(timeArray, time, hint), such that a query costs O(1) instead of a binary
+ * search over the event times.
+ *
+ * The mode schedule is expected to be updated once per solver run, i.e. not while the terms are evaluated.
+ */
+class ModeScheduleLookup {
+ public:
+  /**
+   * Constructor.
+   * @param [in] modeSchedule : The mode schedule to look up.
+   */
+  explicit ModeScheduleLookup(ModeSchedule modeSchedule = ModeSchedule());
+
+  /** Replaces the mode schedule. The intervals kept by the threads are invalidated. */
+  void setModeSchedule(ModeSchedule modeSchedule);
+
+  const ModeSchedule& getModeSchedule() const { return modeSchedule_; }
+
+  /**
+   * Returns the index of the mode interval of the query time, i.e. the index in ModeSchedule::modeSequence. Same convention as
+   * ModeSchedule::modeAtTime().
+   *
+   * @param [in] time: The inquiry time.
+   * @return the index of the mode interval.
+   */
+  size_t getModeIndex(scalar_t time) const;
+
+  /** Returns the mode of the query time, see ModeSchedule::modeAtTime(). */
+  size_t modeAtTime(scalar_t time) const { return modeSchedule_.modeSequence[getModeIndex(time)]; }
+
+ private:
+  ModeSchedule modeSchedule_;
+  uint64_t id_;  // unique for each instance and mode schedule, identifies the interval kept by a thread
+};
+
 /** Exchanges the given values. */
 void swap(ModeSchedule& lh, ModeSchedule& rh);
 
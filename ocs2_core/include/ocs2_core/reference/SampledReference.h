@@ -0,0 +1,98 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include "ocs2_core/Types.h"
+
+namespace ocs2 {
+
+/**
+ * The desired states and inputs of the target trajectories sampled on the time grid of a solver. The samples are computed once per
+ * solver run, such that the tracking cost terms of the grid nodes read them without interpolation and without memory allocation.
+ */
+class SampledReference {
+ public:
+  SampledReference() = default;
+  SampledReference(SampledReference&&) = default;
+  SampledReference& operator=(SampledReference&&) = default;
+
+  /** The samples are a cache of a solver run, hence the copies of the target trajectories (e.g. for the MRT) do not copy them. */
+  SampledReference(const SampledReference&) {}
+  SampledReference& operator=(const SampledReference&) {
+    clear();
+    return *this;
+  }
+
+  /**
+   * Samples the given trajectories at the times of the grid. The storage is reused, hence no memory is allocated once the grid size
+   * and the dimensions are steady.
+   *
+   * @param [in] timeTrajectory: The time trajectory of the target trajectories.
+   * @param [in] stateTrajectory: The state trajectory of the target trajectories.
+   * @param [in] inputTrajectory: The input trajectory of the target trajectories, which may be empty.
+   * @param [in] timeGrid: The increasing times of the grid.
+   */
+  void update(const scalar_array_t& timeTrajectory, const vector_array_t& stateTrajectory, const vector_array_t& inputTrajectory,
+              const scalar_array_t& timeGrid);
+
+  /** Removes the samples. */
+  void clear() { timeGrid_.clear(); }
+
+  /** Whether there are no samples. */
+  bool empty() const { return timeGrid_.empty(); }
+
+  /** Number of samples. */
+  size_t size() const { return timeGrid_.size(); }
+
+  /**
+   * Finds the sample at the given time.
+   *
+   * @param [in] time: The query time.
+   * @return The index of the sample, or -1 if the time is not a time of the grid.
+   */
+  int find(scalar_t time) const;
+
+  /** Gets the desired state of the sample with the given index. */
+  const vector_t& getState(size_t index) const { return stateSamples_[index]; }
+
+  /** Gets the desired input of the sample with the given index. It is empty if the target trajectories have no input. */
+  const vector_t& getInput(size_t index) const { return inputSamples_[index]; }
+
+  /** Whether the samples have a desired input. */
+  bool hasInput() const { return hasInput_; }
+
+ private:
+  scalar_array_t timeGrid_;
+  vector_array_t stateSamples_;
+  vector_array_t inputSamples_;
+  bool hasInput_ = false;
+};
+
+}  // namespace ocs2
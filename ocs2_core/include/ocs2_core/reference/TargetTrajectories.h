@@ -32,6 +32,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ostream>
 
 #include "ocs2_core/Types.h"
+#include "ocs2_core/reference/SampledReference.h"
 
 namespace ocs2 {
 
@@ -52,9 +53,47 @@ struct TargetTrajectories {
   vector_t getDesiredState(scalar_t time) const;
   vector_t getDesiredInput(scalar_t time) const;
 
+  /**
+   * Samples the desired state and input on the time grid of a solver, such that the tracking costs of the grid nodes do not need to
+   * interpolate. The samples are returned together with a copy of these trajectories in caller-owned target trajectories, whose storage
+   * is reused. Their samples are valid until they are modified; clear(), append(), and trimBefore() discard them, while a direct
+   * modification of the member trajectories requires a new sample.
+   *
+   * @param [in] timeGrid: The increasing times of the grid.
+   * @param [out] sampledTargetTrajectories: A copy of these target trajectories with the samples on the grid.
+   */
+  void sampleOnGrid(const scalar_array_t& timeGrid, TargetTrajectories& sampledTargetTrajectories) const;
+
+  /** Gets the sampled desired state at the given time, or nullptr if the time is not on the sampled grid. */
+  const vector_t* getSampledDesiredState(scalar_t time) const;
+
+  /** Gets the sampled desired input at the given time, or nullptr if the time is not on the sampled grid or there is no input. */
+  const vector_t* getSampledDesiredInput(scalar_t time) const;
+
+  /**
+   * Appends a segment of target trajectories. The points which are at or after the start time of the segment are replaced by the
+   * segment, such that a stream of overlapping segments can be appended.
+   *
+   * @param [in] segment: The appended target trajectories. Either both or none of them should have an input trajectory.
+   */
+  void append(const TargetTrajectories& segment);
+
+  /**
+   * Removes the elapsed points. The last point at or before the given time is kept such that the target trajectories can still be
+   * interpolated at that time. The remaining points are moved to the front, hence the storage of the vectors is retained.
+   *
+   * @param [in] time: The time before which the points are not needed.
+   */
+  void trimBefore(scalar_t time);
+
   scalar_array_t timeTrajectory;
   vector_array_t stateTrajectory;
   vector_array_t inputTrajectory;
+
+ private:
+  friend void swap(TargetTrajectories& lh, TargetTrajectories& rh);
+
+  SampledReference sampledReference_;
 };
 
 void swap(TargetTrajectories& lh, TargetTrajectories& rh);
@@ -93,6 +93,19 @@ class StateInputSoftBoxConstraint final : public StateInputCost {
                                                                  const TargetTrajectories& /* targetTrajectories */,
                                                                  const PreComputation& preComp) const override;
 
+  void accumulateQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                        const TargetTrajectories& /* targetTrajectories */, const PreComputation& preComp,
+                                        ScalarFunctionQuadraticApproximation& accumulator) const override;
+
+  /** The state box constraints, sorted by index. */
+  const std::vector<BoxConstraint>& getStateBoxConstraints() const { return stateBoxConstraints_; }
+
+  /** The input box constraints, sorted by index. */
+  const std::vector<BoxConstraint>& getInputBoxConstraints() const { return inputBoxConstraints_; }
+
+  /** The footprint consists of the constrained state and input entries. */
+  const Footprint* getFootprint() const override { return &footprint_; }
+
  private:
   StateInputSoftBoxConstraint(const StateInputSoftBoxConstraint& other) = default;
 
@@ -106,6 +119,7 @@ class StateInputSoftBoxConstraint final : public StateInputCost {
   std::vector<BoxConstraint> stateBoxConstraints_;
   std::vector<BoxConstraint> inputBoxConstraints_;
   scalar_t offset_;
+  Footprint footprint_;
 };
 
 }  // namespace ocs2
@@ -82,6 +82,9 @@ class StateInputSoftConstraint final : public StateInputCost {
 
   bool isActive(scalar_t time) const override;
 
+  /** The footprint is the one of the wrapped constraint. */
+  const Footprint* getFootprint() const override { return constraintPtr_->getFootprint(); }
+
   scalar_t getValue(scalar_t time, const vector_t& state, const vector_t& input, const TargetTrajectories& /* targetTrajectories */,
                     const PreComputation& preComp) const override;
 
@@ -89,6 +92,11 @@ class StateInputSoftConstraint final : public StateInputCost {
                                                                  const TargetTrajectories& /* targetTrajectories */,
                                                                  const PreComputation& preComp) const override;
 
+  /** Adds the penalty approximation to the accumulator without forming the Gauss-Newton Hessian of this term separately. */
+  void accumulateQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                        const TargetTrajectories& /* targetTrajectories */, const PreComputation& preComp,
+                                        ScalarFunctionQuadraticApproximation& accumulator) const override;
+
  private:
   StateInputSoftConstraint(const StateInputSoftConstraint& other);
 
@@ -89,6 +89,10 @@ class StateSoftConstraint final : public StateCost {
                                                                  const TargetTrajectories& /* targetTrajectories */,
                                                                  const PreComputation& preComp) const override;
 
+  /** Adds the penalty approximation to the accumulator without forming the Gauss-Newton Hessian of this term separately. */
+  void accumulateQuadraticApproximation(scalar_t time, const vector_t& state, const TargetTrajectories& /* targetTrajectories */,
+                                        const PreComputation& preComp, ScalarFunctionQuadraticApproximation& accumulator) const override;
+
  private:
   StateSoftConstraint(const StateSoftConstraint& other);
 
@@ -0,0 +1,99 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+#include <ocs2_core/Types.h>
+
+namespace ocs2 {
+
+/**
+ * A parameter vector of cost and constraint terms (e.g. weights or bounds) which can be changed at runtime without rebuilding the
+ * optimal control problem. A term holds a std::shared_ptr<ParameterBuffer>, which is shared by all of its clones, and reads the active
+ * parameters with get(), e.g. to return them from StateInputCostCppAd::getParameters().
+ *
+ * New parameters can be set from any thread. They become active for all clones at once when updateFromBuffer() is called, which is
+ * done by ParameterSynchronizedModule right before the solver runs. As for BufferedValue, the active parameters are not protected by a
+ * mutex, so get() must not be called while updateFromBuffer() is running.
+ */
+class ParameterBuffer {
+ public:
+  /**
+   * Constructor.
+   * @param [in] parameters: The initial parameters. Their size is fixed.
+   */
+  explicit ParameterBuffer(vector_t parameters) : activeParameters_(std::move(parameters)), bufferedParameters_(activeParameters_) {}
+
+  ParameterBuffer(const ParameterBuffer&) = delete;
+  ParameterBuffer& operator=(const ParameterBuffer&) = delete;
+
+  /** The number of parameters. */
+  size_t size() const { return activeParameters_.size(); }
+
+  /** Read the active parameters. */
+  const vector_t& get() const { return activeParameters_; }
+
+  /** Copies new parameters into the buffer. */
+  void setBuffer(const vector_t& parameters) {
+    if (parameters.size() != activeParameters_.size()) {
+      throw std::runtime_error("[ParameterBuffer::setBuffer] Expected " + std::to_string(activeParameters_.size()) +
+                               " parameters, but got " + std::to_string(parameters.size()) + "!");
+    }
+    std::lock_guard<std::mutex> lock(bufferMutex_);
+    bufferedParameters_ = parameters;
+    isBufferUpdated_ = true;
+  }
+
+  /**
+   * Copies the buffered parameters to the active ones. It does not allocate memory.
+   * @return True: the active parameters were updated, False: no new parameters were set.
+   */
+  bool updateFromBuffer() {
+    std::lock_guard<std::mutex> lock(bufferMutex_);
+    if (isBufferUpdated_) {
+      activeParameters_ = bufferedParameters_;
+      isBufferUpdated_ = false;
+      return true;
+    } else {
+      return false;
+    }
+  }
+
+ private:
+  vector_t activeParameters_;
+  vector_t bufferedParameters_;
+  bool isBufferUpdated_ = false;
+  std::mutex bufferMutex_;
+};
+
+}  // namespace ocs2
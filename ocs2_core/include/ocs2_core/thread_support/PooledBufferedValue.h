@@ -0,0 +1,103 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <mutex>
+#include <utility>
+
+namespace ocs2 {
+
+/**
+ * Wraps a value with a thread-safe buffer, similar to BufferedValue. Instead of allocating a new buffer object for every update,
+ * this class keeps two preallocated slots and recycles their storage: a new value is copy-assigned into the inactive slot and
+ * updateFromBuffer swaps the slots. For types like std::vector or Eigen matrices whose size does not change between updates, this
+ * makes setting and updating allocation-free in steady state.
+ *
+ * Multiple threads can set new values to the buffer. The active value is not protected by a mutex, so only one thread should
+ * access/modify the active value (i.e. not simultaneously calling get() and updateFromBuffer()).
+ *
+ * @tparam T : wrapped type. It has to be default constructible and copy/move assignable.
+ */
+template <typename T>
+class PooledBufferedValue {
+ public:
+  /**
+   * Constructor initializes with a given value and an empty buffer.
+   * @param value
+   */
+  explicit PooledBufferedValue(T value) : activeValue_(std::move(value)), bufferValue_(), isBufferUpdated_(false) {}
+
+  /** Read the currently active value. */
+  const T& get() const { return activeValue_; }
+
+  /** Read/write the currently active value. */
+  T& get() { return activeValue_; }
+
+  /** Copy a new value into the buffer. The memory of the buffer slot is reused by the copy assignment. */
+  void setBuffer(const T& value) {
+    std::lock_guard<std::mutex> lock(bufferMutex_);
+    bufferValue_ = value;
+    isBufferUpdated_ = true;
+  }
+
+  /** Move a new value into the buffer. */
+  void setBuffer(T&& value) {
+    std::lock_guard<std::mutex> lock(bufferMutex_);
+    bufferValue_ = std::move(value);
+    isBufferUpdated_ = true;
+  }
+
+  /**
+   * Replaces the active value with the value in the buffer by swapping the two slots. The previously active value becomes the storage
+   * for the next setBuffer() call.
+   * The active value is not mutex protected so this method is NOT thread-safe w.r.t. get()
+   * The buffer is mutex protected, so this method is thread-safe w.r.t. setBuffer()
+   * @return True: the active value was updated, False: the active value was not updated.
+   */
+  bool updateFromBuffer() {
+    std::lock_guard<std::mutex> lock(bufferMutex_);
+    if (isBufferUpdated_) {
+      using std::swap;
+      swap(activeValue_, bufferValue_);
+      isBufferUpdated_ = false;
+      return true;
+    } else {
+      return false;
+    }
+  }
+
+ private:
+  T activeValue_;
+  T bufferValue_;
+  bool isBufferUpdated_;
+  std::mutex bufferMutex_;
+};
+
+}  // namespace ocs2
@@ -30,8 +30,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #pragma once
 
 #include <pthread.h>
+#include <sched.h>
 #include <iostream>
 #include <thread>
+#include <vector>
 
 namespace ocs2 {
 
@@ -73,4 +75,45 @@ inline void setThisThreadPriority(int priority) {
   setThreadPriority(priority, pthread_self());
 }
 
+/**
+ * Restricts the input thread to run on the given CPUs.
+ *
+ * @param cpus: The indices of the CPUs the thread may run on. If empty, the affinity of the thread is not changed.
+ * @param thread: A reference to the tread.
+ */
+inline void setThreadAffinity(const std::vector<int>& cpus, pthread_t thread) {
+  if (!cpus.empty()) {
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    for (const auto cpu : cpus) {
+      CPU_SET(cpu, &cpuSet);
+    }
+
+    if (pthread_setaffinity_np(thread, sizeof(cpu_set_t), &cpuSet) != 0) {
+      std::cerr << "WARNING: Failed to set threads affinity (one possible reason could be "
+                   "that the requested CPUs are not available to this process.)"
+                << std::endl;
+    }
+  }
+}
+
+/**
+ * Restricts the input thread to run on the given CPUs.
+ *
+ * @param cpus: The indices of the CPUs the thread may run on. If empty, the affinity of the thread is not changed.
+ * @param thread: A reference to the tread.
+ */
+inline void setThreadAffinity(const std::vector<int>& cpus, std::thread& thread) {
+  setThreadAffinity(cpus, thread.native_handle());
+}
+
+/**
+ * Restricts the thread this function is called from to run on the given CPUs.
+ *
+ * @param cpus: The indices of the CPUs the thread may run on. If empty, the affinity of the thread is not changed.
+ */
+inline void setThisThreadAffinity(const std::vector<int>& cpus) {
+  setThreadAffinity(cpus, pthread_self());
+}
+
 }  // namespace ocs2
@@ -103,6 +103,7 @@ class LockedConstPtr {
  *
  * - Wrapping a new object:
  * The wrapped object can be swapped or reset either directly through the Synchronized<T> or through a LockedPtr.
+ * To avoid an allocation per update, a new value can instead be copy-assigned into the existing object with assign().
  *
  * - Locking multiple objects:
  * A helper function "synchronizeLock" is available to lock multiple Synchronized<T>s at the same time, similar to std::lock(.., ..)
@@ -154,6 +155,16 @@ class Synchronized {
     p_.swap(p);
   }
 
+  /// Copy-assigns a value to the wrapped object while holding the lock. The storage of the wrapped object is reused if there is one.
+  void assign(const T& value) {
+    std::lock_guard<std::mutex> lk(m_);
+    if (p_ != nullptr) {
+      *p_ = value;
+    } else {
+      p_.reset(new T(value));
+    }
+  }
+
   /// Returns a pointer that holds the lock to the wrapped object. Lifetime of the LockedPtr<> determines the lifetime of the lock.
   LockedPtr<T> lock() { return {p_, m_}; }
   LockedConstPtr<T> lock() const { return {p_.get(), m_}; }
@@ -0,0 +1,110 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include <ocs2_core/thread_support/ThreadPool.h>
+
+namespace ocs2 {
+
+/**
+ * A lightweight executor for a directed acyclic graph of tasks. Each node of the graph is a loop over an index range. The nodes
+ * whose dependencies are completed are processed concurrently by all participating threads, such that independent phases of
+ * an algorithm overlap instead of being separated by the fork-join barrier of consecutive ThreadPool::parallelFor calls.
+ *
+ * Usage:
+ *   TaskGraph graph;
+ *   const auto a = graph.addParallelFor(0, N, 1, intermediateTask);
+ *   const auto b = graph.addTask(finalTask);
+ *   graph.addTask(reductionTask, {a, b});
+ *   graph.run(threadPool);
+ *
+ * @note The tasks must not use the ThreadPool that runs the graph.
+ */
+class TaskGraph {
+ public:
+  using TaskId = size_t;
+
+  /**
+   * Adds a node that runs a task once.
+   *
+   * @param [in] taskFunction: task function with signature void(int workerIndex).
+   * @param [in] dependencies: The nodes that have to be completed before this node starts.
+   * @return The ID of the node.
+   */
+  TaskId addTask(std::function<void(int)> taskFunction, std::vector<TaskId> dependencies = {});
+
+  /**
+   * Adds a node that runs a loop over the index range [begin, end). The indices are processed by all threads which are not
+   * busy with other nodes, similar to ThreadPool::parallelFor.
+   *
+   * @param [in] begin: first index of the range.
+   * @param [in] end: past-the-end index of the range.
+   * @param [in] grain: number of consecutive indices a thread processes before it checks for more work.
+   * @param [in] taskFunction: task function with signature void(int workerIndex, int index).
+   * @param [in] dependencies: The nodes that have to be completed before this node starts.
+   * @return The ID of the node.
+   */
+  TaskId addParallelFor(int begin, int end, int grain, std::function<void(int, int)> taskFunction, std::vector<TaskId> dependencies = {});
+
+  /**
+   * Runs all nodes of the graph with the help of the pool. The calling thread participates.
+   *
+   * @note This is a blocking operation, returns when all nodes are completed. If a task throws, the nodes that have not started
+   * are skipped and the first exception is rethrown after all threads have stopped.
+   * @note Two concurrent task calls never share the same workerIndex, which is in [0, maxNumThreads - 1].
+   *
+   * @param [in] threadPool: The thread pool.
+   * @param [in] maxNumThreads: maximum number of threads working on the graph, including the calling thread. Zero means
+   *                            threadPool.numThreads() + 1.
+   */
+  void run(ThreadPool& threadPool, size_t maxNumThreads = 0);
+
+  /** Removes all nodes. */
+  void clear() { nodes_.clear(); }
+
+  /** Number of nodes */
+  size_t size() const { return nodes_.size(); }
+
+ private:
+  struct Node {
+    int begin;
+    int end;
+    int grain;
+    std::function<void(int, int)> taskFunction;
+    std::vector<TaskId> dependencies;
+  };
+
+  std::vector<Node> nodes_;
+};
+
+}  // namespace ocs2
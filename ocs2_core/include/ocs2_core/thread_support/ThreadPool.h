@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <future>
 #include <mutex>
@@ -48,8 +50,14 @@ class ThreadPool {
    *
    * @param [in] nThreads: Number of threads to launch in the pool
    * @param [in] priority: The worker thread priority
+   * @param [in] spinDuration: Time an idle worker busy-waits for a new task before it sleeps on the task queue condition variable.
+   *                           Spinning avoids the wake-up latency of a sleeping thread for tasks that arrive in quick succession,
+   *                           e.g., during a solver iteration, at the cost of keeping the core busy. Zero disables spinning.
+   * @param [in] cpuAffinity: The CPUs the workers are pinned to. Worker i runs only on CPU cpuAffinity[i % cpuAffinity.size()].
+   *                          If empty, the workers may run on any CPU.
    */
-  explicit ThreadPool(size_t nThreads = 1, int priority = 0);
+  explicit ThreadPool(size_t nThreads = 1, int priority = 0, std::chrono::microseconds spinDuration = std::chrono::microseconds(0),
+                      const std::vector<int>& cpuAffinity = {});
 
   /**
    * Destructor
@@ -80,6 +88,39 @@ class ThreadPool {
    */
   void runParallel(std::function<void(int)> taskFunction, int N);
 
+  /**
+   * Helper function to run a loop over the index range [begin, end) in parallel with the help of the pool.
+   * The range is split into one contiguous block per participating thread. Each thread processes its own block in chunks of
+   * grain indices and, once its block is exhausted, steals half of the remaining indices of another thread. This balances
+   * the load when the cost of the iterations differs strongly.
+   * - The calling thread participates with ID = maxNumThreads - 1.
+   * - The pool workers participate with ID in [0, maxNumThreads - 2]. A worker uses its own index if it is in this range.
+   *
+   * @note This is a blocking operation, returns when all indices are processed. If taskFunction throws, the remaining indices
+   * are skipped and the first exception is rethrown after all threads have stopped.
+   * @note Two concurrent calls of taskFunction never share the same workerIndex, which can therefore be used to index
+   * designated thread resources. This also holds if the pool is shared between several clients.
+   *
+   * @param [in] begin: first index of the range.
+   * @param [in] end: past-the-end index of the range.
+   * @param [in] grain: number of consecutive indices a thread processes before it checks for more work.
+   * @param [in] taskFunction: task function with signature void(int workerIndex, int index).
+   * @param [in] maxNumThreads: maximum number of threads working on the loop, including the calling thread. This limits the
+   *                            share of the pool a client uses. Zero means nThreads + 1.
+   */
+  void parallelFor(int begin, int end, int grain, std::function<void(int, int)> taskFunction, size_t maxNumThreads = 0);
+
+  /**
+   * Helper function to run a task exactly once on each worker of the pool and once in the calling thread (ID = nThreads).
+   * This can be used to create thread resources on the thread that uses them, such that their memory is allocated close to
+   * the CPU the thread runs on (first-touch policy of NUMA systems).
+   *
+   * @note This is a blocking operation, returns when all tasks are completed. It requires all workers to be idle.
+   *
+   * @param [in] taskFunction: task function which takes the worker index as argument.
+   */
+  void runOnEachThread(std::function<void(int)> taskFunction);
+
   /** Get the number of threads. */
   size_t numThreads() const { return workerThreads_.size(); }
 
@@ -96,6 +137,9 @@ class ThreadPool {
    */
   void worker(int workerIndex);
 
+  /** Busy-waits until a task is queued, the pool is stopped, or spinDuration_ has passed. */
+  void spinWait() const;
+
   /**
    * Run a task asynchronously in another thread
    *
@@ -104,8 +148,11 @@ class ThreadPool {
   void runTask(std::unique_ptr<TaskBase> taskPtr);
 
   bool stop_{false};  //!< flag telling all threads to stop, protected by taskQueueLock_
+  std::atomic_bool stopSpinning_{false};  //!< flag telling spinning threads to stop, readable without taskQueueLock_
+  const std::chrono::microseconds spinDuration_;
 
   std::queue<std::unique_ptr<TaskBase>> taskQueue_;  // protected by taskQueueLock_
+  std::atomic_size_t numQueuedTasks_{0};             // size of taskQueue_, readable without taskQueueLock_
   std::condition_variable taskQueueCondition_;
   std::mutex taskQueueLock_;
 
@@ -0,0 +1,108 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace ocs2 {
+
+/**
+ * Wait-free single-producer/single-consumer triple buffer. The producer writes into the back slot and publishes it, the consumer
+ * swaps the latest published slot to the front. Neither side ever blocks and no allocation takes place on exchange: the three slots
+ * only rotate their role, so whatever the producer finds in the back slot is either a stale front or a value that was overwritten
+ * before the consumer picked it up.
+ *
+ * Only one thread may call back()/publish() and only one thread may call front()/updateFromBuffer() at a time.
+ *
+ * @tparam T : wrapped type. It has to be default constructible and move assignable.
+ */
+template <typename T>
+class TripleBuffer {
+ public:
+  TripleBuffer() = default;
+
+  /** Resets all slots to a default constructed value. NOT thread-safe w.r.t. any other method. */
+  void reset() {
+    for (auto& slot : slots_) {
+      slot = T();
+    }
+    frontIndex_ = 0;
+    backIndex_ = 2;
+    middle_.store(1, std::memory_order_relaxed);
+  }
+
+  /** Producer: read/write the slot that will be published by the next call to publish(). */
+  T& back() { return slots_[backIndex_]; }
+
+  /**
+   * Producer: makes the back slot available to the consumer. The previous middle slot becomes the new back slot.
+   * @return True if the previously published value is overwritten before the consumer picked it up.
+   */
+  bool publish() {
+    const uint8_t previousMiddle = middle_.exchange(backIndex_ | freshBit_, std::memory_order_acq_rel);
+    backIndex_ = previousMiddle & indexMask_;
+    return (previousMiddle & freshBit_) != 0;
+  }
+
+  /** Consumer: read the currently active value. */
+  const T& front() const { return slots_[frontIndex_]; }
+
+  /** Consumer: read/write the currently active value. */
+  T& front() { return slots_[frontIndex_]; }
+
+  /** Consumer: whether the producer has published a value since the last call to updateFromBuffer(). */
+  bool hasNewValue() const { return (middle_.load(std::memory_order_acquire) & freshBit_) != 0; }
+
+  /**
+   * Consumer: replaces the front slot with the latest published one.
+   * @return True: the front value was updated, False: nothing new was published.
+   */
+  bool updateFromBuffer() {
+    if (!hasNewValue()) {
+      return false;
+    }
+    const uint8_t previousMiddle = middle_.exchange(frontIndex_, std::memory_order_acq_rel);
+    frontIndex_ = previousMiddle & indexMask_;
+    return true;
+  }
+
+ private:
+  static constexpr uint8_t indexMask_ = 0x03;
+  static constexpr uint8_t freshBit_ = 0x04;
+
+  std::array<T, 3> slots_{};
+  uint8_t frontIndex_ = 0;            // owned by the consumer
+  alignas(64) uint8_t backIndex_ = 2;  // owned by the producer
+  alignas(64) std::atomic<uint8_t> middle_{1};
+};
+
+}  // namespace ocs2
@@ -221,7 +221,7 @@ std::string checkBeingPSD(const matrix_t& data, const std::string& dataName) {
 
   } else {
     // check for being self-adjoint
-    if (!data.isApprox(data.transpose(), 1e-6)) {
+    if (!data.isApprox(data.transpose(), numeric_traits::limitEpsilon<scalar_t>())) {
       errorDescription << dataName << " is not self-adjoint.\n";
     }
 
@@ -43,8 +43,10 @@ StateAugmentedLagrangianCollection* StateAugmentedLagrangianCollection::clone()
 /******************************************************************************************************/
 size_t StateAugmentedLagrangianCollection::getNumberOfActiveConstraints(scalar_t time) const {
   size_t numConstraints = 0;
-  for (const auto& term : terms_) {
-    if (term->isActive(time)) {
+  const auto activeTerms = this->getActiveTerms(time);
+  for (size_t i = 0; i < terms_.size(); i++) {
+    if (activeTerms[i]) {
+      const auto& term = terms_[i];
       numConstraints += term->getNumConstraints(time);
     }
   }
@@ -59,8 +61,9 @@ std::vector<LagrangianMetrics> StateAugmentedLagrangianCollection::getValue(scal
                                                                             const PreComputation& preComp) const {
   std::vector<LagrangianMetrics> termsConstraintPenalty;
   termsConstraintPenalty.reserve(terms_.size());
+  const auto activeTerms = this->getActiveTerms(time);
   for (size_t i = 0; i < terms_.size(); i++) {
-    if (terms_[i]->isActive(time)) {
+    if (activeTerms[i]) {
       termsConstraintPenalty.emplace_back(terms_[i]->getValue(time, state, termsMultiplier[i], preComp));
     } else {
       termsConstraintPenalty.emplace_back(0.0, vector_t());
@@ -74,22 +77,23 @@ std::vector<LagrangianMetrics> StateAugmentedLagrangianCollection::getValue(scal
 /******************************************************************************************************/
 ScalarFunctionQuadraticApproximation StateAugmentedLagrangianCollection::getQuadraticApproximation(
     scalar_t time, const vector_t& state, const std::vector<Multiplier>& termsMultiplier, const PreComputation& preComp) const {
-  const auto firstActiveItr =
-      std::find_if(terms_.begin(), terms_.end(),
-                   [time](const std::unique_ptr<StateAugmentedLagrangianInterface>& costTerm) { return costTerm->isActive(time); });
+  const auto activeTerms = this->getActiveTerms(time);
+  size_t firstActiveInd = 0;
+  while (firstActiveInd < terms_.size() && !activeTerms[firstActiveInd]) {
+    ++firstActiveInd;
+  }
 
   // no active terms (or terms is empty).
-  if (firstActiveItr == terms_.end()) {
+  if (firstActiveInd == terms_.size()) {
     return ScalarFunctionQuadraticApproximation::Zero(state.size());
   }
 
   // initialize with first active term
-  const size_t firstActiveInd = std::distance(terms_.begin(), firstActiveItr);
-  auto penalty = (*firstActiveItr)->getQuadraticApproximation(time, state, termsMultiplier[firstActiveInd], preComp);
+  auto penalty = terms_[firstActiveInd]->getQuadraticApproximation(time, state, termsMultiplier[firstActiveInd], preComp);
 
   // accumulate terms
   for (size_t i = firstActiveInd + 1; i < terms_.size(); i++) {
-    if (terms_[i]->isActive(time)) {
+    if (activeTerms[i]) {
       const auto termPenalty = terms_[i]->getQuadraticApproximation(time, state, termsMultiplier[i], preComp);
       penalty.f += termPenalty.f;
       penalty.dfdx += termPenalty.dfdx;
@@ -113,8 +117,9 @@ void StateAugmentedLagrangianCollection::updateLagrangian(scalar_t time, const v
                                                           std::vector<Multiplier>& termsMultiplier) const {
   assert(termsMetrics.size() == termsMultiplier.size());
 
+  const auto activeTerms = this->getActiveTerms(time);
   for (size_t i = 0; i < terms_.size(); i++) {
-    if (terms_[i]->isActive(time)) {
+    if (activeTerms[i]) {
       Multiplier updatedLagrangian;
       std::tie(updatedLagrangian, termsMetrics[i].penalty) =
           terms_[i]->updateLagrangian(time, state, termsMetrics[i].constraint, termsMultiplier[i]);
@@ -129,8 +134,10 @@ void StateAugmentedLagrangianCollection::updateLagrangian(scalar_t time, const v
 void StateAugmentedLagrangianCollection::initializeLagrangian(scalar_t time, std::vector<Multiplier>& termsMultiplier) const {
   termsMultiplier.clear();
   termsMultiplier.reserve(terms_.size());
-  for (const auto& term : terms_) {
-    if (term->isActive(time)) {
+  const auto activeTerms = this->getActiveTerms(time);
+  for (size_t i = 0; i < terms_.size(); i++) {
+    if (activeTerms[i]) {
+      const auto& term = terms_[i];
       termsMultiplier.emplace_back(term->initializeLagrangian(time));
     } else {
       termsMultiplier.emplace_back(0.0, vector_t());
@@ -43,8 +43,10 @@ StateInputAugmentedLagrangianCollection* StateInputAugmentedLagrangianCollection
 /******************************************************************************************************/
 size_t StateInputAugmentedLagrangianCollection::getNumberOfActiveConstraints(scalar_t time) const {
   size_t numConstraints = 0;
-  for (const auto& term : terms_) {
-    if (term->isActive(time)) {
+  const auto activeTerms = this->getActiveTerms(time);
+  for (size_t i = 0; i < terms_.size(); i++) {
+    if (activeTerms[i]) {
+      const auto& term = terms_[i];
       numConstraints += term->getNumConstraints(time);
     }
   }
@@ -60,8 +62,9 @@ std::vector<LagrangianMetrics> StateInputAugmentedLagrangianCollection::getValue
                                                                                  const PreComputation& preComp) const {
   std::vector<LagrangianMetrics> termsConstraintPenalty;
   termsConstraintPenalty.reserve(terms_.size());
+  const auto activeTerms = this->getActiveTerms(time);
   for (size_t i = 0; i < terms_.size(); i++) {
-    if (terms_[i]->isActive(time)) {
+    if (activeTerms[i]) {
       termsConstraintPenalty.emplace_back(terms_[i]->getValue(time, state, input, termsMultiplier[i], preComp));
     } else {
       termsConstraintPenalty.emplace_back(0.0, vector_t());
@@ -76,22 +79,23 @@ std::vector<LagrangianMetrics> StateInputAugmentedLagrangianCollection::getValue
 ScalarFunctionQuadraticApproximation StateInputAugmentedLagrangianCollection::getQuadraticApproximation(
     scalar_t time, const vector_t& state, const vector_t& input, const std::vector<Multiplier>& termsMultiplier,
     const PreComputation& preComp) const {
-  const auto firstActiveItr =
-      std::find_if(terms_.begin(), terms_.end(),
-                   [time](const std::unique_ptr<StateInputAugmentedLagrangianInterface>& costTerm) { return costTerm->isActive(time); });
+  const auto activeTerms = this->getActiveTerms(time);
+  size_t firstActiveInd = 0;
+  while (firstActiveInd < terms_.size() && !activeTerms[firstActiveInd]) {
+    ++firstActiveInd;
+  }
 
   // no active terms (or terms is empty).
-  if (firstActiveItr == terms_.end()) {
+  if (firstActiveInd == terms_.size()) {
     return ScalarFunctionQuadraticApproximation::Zero(state.size(), input.size());
   }
 
   // initialize with first active term
-  const size_t firstActiveInd = std::distance(terms_.begin(), firstActiveItr);
-  auto penalty = (*firstActiveItr)->getQuadraticApproximation(time, state, input, termsMultiplier[firstActiveInd], preComp);
+  auto penalty = terms_[firstActiveInd]->getQuadraticApproximation(time, state, input, termsMultiplier[firstActiveInd], preComp);
 
   // accumulate terms
   for (size_t i = firstActiveInd + 1; i < terms_.size(); i++) {
-    if (terms_[i]->isActive(time)) {
+    if (activeTerms[i]) {
       penalty += terms_[i]->getQuadraticApproximation(time, state, input, termsMultiplier[i], preComp);
     }
   }
@@ -107,8 +111,9 @@ void StateInputAugmentedLagrangianCollection::updateLagrangian(scalar_t time, co
                                                                std::vector<Multiplier>& termsMultiplier) const {
   assert(termsMetrics.size() == termsMultiplier.size());
 
+  const auto activeTerms = this->getActiveTerms(time);
   for (size_t i = 0; i < terms_.size(); i++) {
-    if (terms_[i]->isActive(time)) {
+    if (activeTerms[i]) {
       Multiplier updatedLagrangian;
       std::tie(updatedLagrangian, termsMetrics[i].penalty) =
           terms_[i]->updateLagrangian(time, state, input, termsMetrics[i].constraint, termsMultiplier[i]);
@@ -123,8 +128,10 @@ void StateInputAugmentedLagrangianCollection::updateLagrangian(scalar_t time, co
 void StateInputAugmentedLagrangianCollection::initializeLagrangian(scalar_t time, std::vector<Multiplier>& termsMultiplier) const {
   termsMultiplier.clear();
   termsMultiplier.reserve(terms_.size());
-  for (const auto& term : terms_) {
-    if (term->isActive(time)) {
+  const auto activeTerms = this->getActiveTerms(time);
+  for (size_t i = 0; i < terms_.size(); i++) {
+    if (activeTerms[i]) {
+      const auto& term = terms_[i];
       termsMultiplier.emplace_back(term->initializeLagrangian(time));
     } else {
       termsMultiplier.emplace_back(0.0, vector_t());
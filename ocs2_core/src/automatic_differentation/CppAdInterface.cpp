@@ -29,10 +29,379 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/automatic_differentiation/CppAdInterface.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <future>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
 #include <boost/filesystem.hpp>
 
 namespace ocs2 {
 
+namespace {
+
+/** Taping and code generation use the global state of CppAD. This mutex serializes them between threads creating models. */
+std::mutex codeGenerationMutex;
+
+/** The models of a library are registered in the library when they are created and destroyed. This mutex serializes it between copies. */
+std::mutex libraryModelsMutex;
+
+/** Process wide options of the library creation, see CppAdInterface::setCompilationAllowed() and setInMemoryCompilation(). */
+std::atomic<bool> compilationAllowed{true};
+std::atomic<bool> inMemoryCompilation{false};
+
+/** Limits the number of compiler processes of all models that are created at the same time. */
+class CompilerJobLimiter {
+ public:
+  static CompilerJobLimiter& instance() {
+    static CompilerJobLimiter limiter;
+    return limiter;
+  }
+
+  void setMaxNumJobs(size_t maxNumJobs) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    maxNumJobs_ = std::max(maxNumJobs, size_t(1));
+    condition_.notify_all();
+  }
+
+  void acquire() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    condition_.wait(lock, [this] { return numRunningJobs_ < maxNumJobs_; });
+    ++numRunningJobs_;
+  }
+
+  void release() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    --numRunningJobs_;
+    condition_.notify_one();
+  }
+
+ private:
+  CompilerJobLimiter() : maxNumJobs_(std::max(std::thread::hardware_concurrency(), 1U)) {}
+
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  size_t maxNumJobs_;
+  size_t numRunningJobs_ = 0;
+};
+
+/**
+ * GCC compiler which compiles the source files of a model library in parallel processes. The code generation lock is released while
+ * the compiler runs, such that other threads can generate the code of their models in the meantime.
+ */
+class ParallelGccCompiler final : public CppAD::cg::GccCompiler<scalar_t> {
+ public:
+  explicit ParallelGccCompiler(std::unique_lock<std::mutex>& codeGenerationLock) : codeGenerationLock_(codeGenerationLock) {}
+  ~ParallelGccCompiler() override = default;
+
+  using CppAD::cg::GccCompiler<scalar_t>::compileSources;
+
+  void compileSources(const std::map<std::string, std::string>& sources, bool posIndepCode, CppAD::cg::JobTimer* timer,
+                      const std::string& outputExtension, std::set<std::string>& outputFiles) override {
+    if (sources.empty()) {
+      return;  // nothing to do
+    }
+
+    // The source files are saved to disk first: piping sources to concurrent compiler processes through stdin can deadlock,
+    // because each forked process inherits the pipes of the others.
+    CppAD::cg::system::createFolder(this->_tmpFolder);
+    CppAD::cg::system::createFolder(this->_sourcesFolder);
+    std::vector<std::pair<std::string, std::string>> jobs;  // (source file, object file)
+    jobs.reserve(sources.size());
+    for (const auto& source : sources) {
+      this->_sfiles.insert(source.first);
+      const auto sourceFile = CppAD::cg::system::createPath(this->_sourcesFolder, source.first);
+      const auto objectFile = CppAD::cg::system::createPath(this->_tmpFolder, source.first + outputExtension);
+      std::ofstream(sourceFile) << source.second;
+      outputFiles.insert(objectFile);
+      jobs.emplace_back(sourceFile, objectFile);
+    }
+
+    runWithoutCodeGenerationLock([&]() {
+      std::vector<std::future<void>> futures;
+      futures.reserve(jobs.size());
+      for (const auto& job : jobs) {
+        futures.push_back(std::async(std::launch::async, [&, this]() {
+          CompilerJobLimiter::instance().acquire();
+          try {
+            this->compileFile(job.first, job.second, posIndepCode);
+          } catch (...) {
+            CompilerJobLimiter::instance().release();
+            throw;
+          }
+          CompilerJobLimiter::instance().release();
+        }));
+      }
+      waitForAll(futures);
+    });
+  }
+
+  void buildDynamic(const std::string& library, CppAD::cg::JobTimer* timer = nullptr) override {
+    runWithoutCodeGenerationLock([&]() { CppAD::cg::GccCompiler<scalar_t>::buildDynamic(library, timer); });
+  }
+
+ private:
+  template <typename Function>
+  void runWithoutCodeGenerationLock(Function function) {
+    codeGenerationLock_.unlock();
+    try {
+      function();
+    } catch (...) {
+      codeGenerationLock_.lock();
+      throw;
+    }
+    codeGenerationLock_.lock();
+  }
+
+  /** Waits for all futures, then rethrows the first exception. */
+  static void waitForAll(std::vector<std::future<void>>& futures) {
+    std::exception_ptr exceptionPtr = nullptr;
+    for (auto& future : futures) {
+      try {
+        future.get();
+      } catch (...) {
+        if (exceptionPtr == nullptr) {
+          exceptionPtr = std::current_exception();
+        }
+      }
+    }
+    if (exceptionPtr != nullptr) {
+      std::rethrow_exception(exceptionPtr);
+    }
+  }
+
+  std::unique_lock<std::mutex>& codeGenerationLock_;
+};
+
+/**
+ * Exclusive advisory lock on a file. Serializes the creation of the libraries of a model between processes sharing a library folder,
+ * and between threads of the same process.
+ */
+class LibraryFileLock {
+ public:
+  explicit LibraryFileLock(const std::string& lockFileName) : fileDescriptor_(::open(lockFileName.c_str(), O_RDWR | O_CREAT, 0666)) {
+    if (fileDescriptor_ < 0) {
+      throw std::runtime_error("[CppAdInterface] Could not open the lock file " + lockFileName);
+    }
+    while (::flock(fileDescriptor_, LOCK_EX) != 0) {
+      if (errno != EINTR) {
+        ::close(fileDescriptor_);
+        throw std::runtime_error("[CppAdInterface] Could not lock the file " + lockFileName);
+      }
+    }
+  }
+
+  ~LibraryFileLock() {
+    ::flock(fileDescriptor_, LOCK_UN);
+    ::close(fileDescriptor_);
+  }
+
+  LibraryFileLock(const LibraryFileLock&) = delete;
+  LibraryFileLock& operator=(const LibraryFileLock&) = delete;
+
+ private:
+  int fileDescriptor_;
+};
+
+/** Copies a library file into an anonymous in-memory file. The library can be loaded from its /proc/self/fd path while it is open. */
+std::shared_ptr<const int> copyToInMemoryFile(const std::string& libraryFile) {
+  std::ifstream library(libraryFile, std::ios::binary);
+  const std::string content((std::istreambuf_iterator<char>(library)), std::istreambuf_iterator<char>());
+  if (!library.good() && !library.eof()) {
+    throw std::runtime_error("[CppAdInterface] Could not read the library " + libraryFile);
+  }
+
+  const int fileDescriptor = ::memfd_create("ocs2_cppadcg_library", MFD_CLOEXEC);
+  if (fileDescriptor < 0) {
+    throw std::runtime_error("[CppAdInterface] Could not create an in-memory file for the library " + libraryFile);
+  }
+  std::shared_ptr<const int> fileDescriptorPtr(new int(fileDescriptor), [](const int* fd) {
+    ::close(*fd);
+    delete fd;
+  });
+
+  size_t numWritten = 0;
+  while (numWritten < content.size()) {
+    const auto n = ::write(fileDescriptor, content.data() + numWritten, content.size() - numWritten);
+    if (n < 0 && errno != EINTR) {
+      throw std::runtime_error("[CppAdInterface] Could not write the library " + libraryFile + " to memory");
+    }
+    numWritten += std::max<decltype(n)>(n, 0);
+  }
+  return fileDescriptorPtr;
+}
+
+/** 64 bit FNV-1a hash, which is stable between processes and builds. */
+std::string getHashString(const std::string& data) {
+  uint64_t hash = 14695981039346656037ULL;
+  for (const char c : data) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 1099511628211ULL;
+  }
+  std::ostringstream hashString;
+  hashString << std::hex << std::setw(16) << std::setfill('0') << hash;
+  return hashString.str();
+}
+
+/** Checks whether matrix has the dimensions and the number of nonzeros of a sparsity pattern. */
+bool hasSparsityPattern(const CppAdInterface::sparse_matrix_t& matrix, size_t rows, size_t cols, size_t nnz) {
+  return matrix.isCompressed() && matrix.rows() == rows && matrix.cols() == cols && matrix.nonZeros() == nnz;
+}
+
+/**
+ * Sets up the compressed row storage of matrix from the (row, col) elements of a sparsity pattern, which CppAD orders first by row,
+ * then by column. The values already stored in matrix.valuePtr() are kept.
+ */
+void setSparsityPattern(CppAdInterface::sparse_matrix_t& matrix, size_t const* rows, size_t const* cols, size_t nnz) {
+  auto* outerIndex = matrix.outerIndexPtr();
+  auto* innerIndex = matrix.innerIndexPtr();
+  std::fill(outerIndex, outerIndex + matrix.rows() + 1, 0);
+  for (size_t i = 0; i < nnz; i++) {
+    if (i > 0 && (rows[i] < rows[i - 1] || (rows[i] == rows[i - 1] && cols[i] <= cols[i - 1]))) {
+      throw std::runtime_error("[CppAdInterface] The sparsity pattern is not ordered by row and column.");
+    }
+    ++outerIndex[rows[i] + 1];
+    innerIndex[i] = cols[i];
+  }
+  for (Eigen::Index row = 0; row < matrix.rows(); row++) {
+    outerIndex[row + 1] += outerIndex[row];
+  }
+}
+
+/** Buffers of the model evaluations. There is one workspace per thread, such that repeated evaluations do not allocate memory. */
+struct EvaluationWorkspace {
+  std::vector<scalar_t> input;  // concatenated [x; p]
+  std::vector<scalar_t> sparseValues;
+};
+
+EvaluationWorkspace& getEvaluationWorkspace() {
+  thread_local EvaluationWorkspace workspace;
+  return workspace;
+}
+
+/** Concatenates the variables and the parameters in the workspace. */
+CppAD::cg::ArrayView<const scalar_t> setInput(const Eigen::Ref<const vector_t>& x, const Eigen::Ref<const vector_t>& p,
+                                              EvaluationWorkspace& workspace) {
+  workspace.input.resize(x.size() + p.size());
+  std::copy(x.data(), x.data() + x.size(), workspace.input.begin());
+  std::copy(p.data(), p.data() + p.size(), workspace.input.begin() + x.size());
+  return CppAD::cg::ArrayView<const scalar_t>(workspace.input.data(), workspace.input.size());
+}
+
+/** Runs task for each interface in its own thread, waits for all, then rethrows the first exception. */
+template <typename Task>
+void runForEachInterface(const std::vector<CppAdInterface*>& interfaces, Task task) {
+  std::vector<std::future<void>> futures;
+  futures.reserve(interfaces.size());
+  for (auto* interfacePtr : interfaces) {
+    futures.push_back(std::async(std::launch::async, [interfacePtr, &task]() { task(*interfacePtr); }));
+  }
+
+  std::exception_ptr exceptionPtr = nullptr;
+  for (auto& future : futures) {
+    try {
+      future.get();
+    } catch (...) {
+      if (exceptionPtr == nullptr) {
+        exceptionPtr = std::current_exception();
+      }
+    }
+  }
+  if (exceptionPtr != nullptr) {
+    std::rethrow_exception(exceptionPtr);
+  }
+}
+
+}  // unnamed namespace
+
+/**
+ * The library of the models, which is shared by the copies of an interface. It is opened once, on the first evaluation of any copy.
+ */
+struct CppAdInterface::SharedLibrary {
+  SharedLibrary(std::string modelNameArg, std::string libraryFileArg, std::shared_ptr<const int> inMemoryLibraryPtrArg, bool verboseArg)
+      : modelName(std::move(modelNameArg)),
+        libraryFile(std::move(libraryFileArg)),
+        inMemoryLibraryPtr(std::move(inMemoryLibraryPtrArg)),
+        verbose(verboseArg) {}
+
+  /** Opens the library if it is not loaded yet. A failed attempt is repeated on the next call. */
+  void load() {
+    if (loaded.load(std::memory_order_acquire)) {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(loadMutex);
+    if (loaded.load(std::memory_order_relaxed)) {
+      return;
+    }
+
+    if (verbose) {
+      std::cerr << "[CppAdInterface] Loading Shared Library: " << libraryFile << std::endl;
+    }
+    std::unique_ptr<CppAD::cg::DynamicLib<scalar_t>> newDynamicLib(new CppAD::cg::LinuxDynamicLib<scalar_t>(libraryFile));
+
+    // The sparsity and the atomic functions are read from a temporary model
+    std::unique_ptr<CppAD::cg::GenericModel<scalar_t>> model;
+    {
+      std::lock_guard<std::mutex> modelsLock(libraryModelsMutex);
+      model = newDynamicLib->model(modelName);
+    }
+    if (model == nullptr) {
+      throw std::runtime_error("[CppAdInterface] The library " + libraryFile + " does not contain the model " + modelName);
+    }
+    if (model->isJacobianSparsityAvailable()) {
+      nnzJacobian = cppad_sparsity::getNumberOfNonZeros(model->JacobianSparsitySet());
+    }
+    if (model->isHessianSparsityAvailable()) {
+      nnzHessian = cppad_sparsity::getNumberOfNonZeros(model->HessianSparsitySet());
+    }
+
+    // Values are computed by calling the zero order function of the library directly. It gets no atomic function callbacks, hence
+    // models with atomic functions are evaluated through the model object.
+    if (model->getAtomicFunctionNames().empty()) {
+      forwardZeroKernel = reinterpret_cast<forward_zero_kernel_t>(
+          newDynamicLib->loadFunction(modelName + "_" + CppAD::cg::ModelCSourceGen<scalar_t>::FUNCTION_FORWAD_ZERO, false));
+    }
+
+    {
+      std::lock_guard<std::mutex> modelsLock(libraryModelsMutex);
+      model.reset();
+    }
+    dynamicLib = std::move(newDynamicLib);
+    loaded.store(true, std::memory_order_release);
+  }
+
+  /** Creates a model of the loaded library. */
+  std::unique_ptr<CppAD::cg::GenericModel<scalar_t>> createModel() const {
+    std::lock_guard<std::mutex> modelsLock(libraryModelsMutex);
+    return dynamicLib->model(modelName);
+  }
+
+  const std::string modelName;
+  const std::string libraryFile;
+  const std::shared_ptr<const int> inMemoryLibraryPtr;  // keeps the in-memory library open
+  const bool verbose;
+
+  std::mutex loadMutex;
+  std::atomic<bool> loaded{false};
+  std::unique_ptr<CppAD::cg::DynamicLib<scalar_t>> dynamicLib;
+  forward_zero_kernel_t forwardZeroKernel = nullptr;
+  size_t nnzJacobian = 0;
+  size_t nnzHessian = 0;
+};
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -60,17 +429,154 @@ CppAdInterface::CppAdInterface(ad_function_t adFunction, size_t variableDim, std
 /******************************************************************************************************/
 CppAdInterface::CppAdInterface(const CppAdInterface& rhs)
     : CppAdInterface(rhs.adFunction_, rhs.variableDim_, rhs.parameterDim_, rhs.modelName_, rhs.folderName_, rhs.compileFlags_) {
-  if (isLibraryAvailable()) {
-    loadModels(false);
-  }
+  libraryName_ = rhs.libraryName_;
+  inMemoryLibraryPtr_ = rhs.inMemoryLibraryPtr_;
+  rangeDim_ = rhs.rangeDim_;
+  // the library is neither loaded nor opened again, the copy creates its own model on its first evaluation
+  library_ = rhs.library_;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+CppAdInterface::~CppAdInterface() {
+  std::lock_guard<std::mutex> lock(libraryModelsMutex);
+  model_.reset();
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 void CppAdInterface::createModels(ApproximationOrder approximationOrder, bool verbose) {
+  createOrLoadModels(approximationOrder, false, verbose);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::loadModels(bool verbose) {
+  if (libraryName_.empty()) {
+    throw std::runtime_error("[CppAdInterface::loadModels] The library of " + modelName_ +
+                             " is not known yet. Use loadModelsIfAvailable() to find it from the recorded tape.");
+  }
+  const std::string libraryFile = (inMemoryLibraryPtr_ != nullptr) ? "/proc/self/fd/" + std::to_string(*inMemoryLibraryPtr_)
+                                                                   : libraryName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION;
+
+  // The library is opened by the first evaluation
+  std::lock_guard<std::mutex> lock(modelMutex_);
+  {
+    std::lock_guard<std::mutex> modelsLock(libraryModelsMutex);
+    modelPtr_.store(nullptr, std::memory_order_relaxed);
+    model_.reset();
+  }
+  library_ = std::make_shared<SharedLibrary>(modelName_, libraryFile, inMemoryLibraryPtr_, verbose);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::loadModelsIfAvailable(ApproximationOrder approximationOrder, bool verbose) {
+  createOrLoadModels(approximationOrder, true, verbose);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::createOrLoadModels(ApproximationOrder approximationOrder, bool loadIfAvailable, bool verbose) {
+  // The lock is released by the compiler while the generated sources are compiled.
+  std::unique_lock<std::mutex> codeGenerationLock(codeGenerationMutex);
+
+  ad_fun_t fun;
+  recordTape(fun);
+  libraryName_ = libraryFolder_ + "/" + modelName_ + "_lib_" + getModelHash(approximationOrder, fun);
+  inMemoryLibraryPtr_.reset();
+
+  // An available library is loaded without writing to the library folder, such that it can be a read-only bundle of prebuilt libraries.
+  if (loadIfAvailable && isLibraryAvailable()) {
+    codeGenerationLock.unlock();
+    loadModels(verbose);
+    return;
+  }
+
+  if (!compilationAllowed) {
+    throw std::runtime_error("[CppAdInterface] The library " + libraryName_ + " is not available and compilation is disabled.");
+  }
+
+  if (inMemoryCompilation) {
+    // Compile in a private temporary folder, which is removed once the library is copied to memory.
+    const auto buildFolder = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("ocs2_cppadcg_%%%%-%%%%-%%%%-%%%%");
+    const std::string libraryFile = (buildFolder / (modelName_ + "_lib")).string();
+    boost::filesystem::create_directories(buildFolder);
+    try {
+      compileLibrary(approximationOrder, fun, codeGenerationLock, libraryFile, (buildFolder / "tmp").string(),
+                     (buildFolder / "sources").string(), verbose);
+      inMemoryLibraryPtr_ = copyToInMemoryFile(libraryFile + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION);
+    } catch (...) {
+      boost::filesystem::remove_all(buildFolder);
+      throw;
+    }
+    boost::filesystem::remove_all(buildFolder);
+    loadModels(verbose);
+    return;
+  }
+
   createFolderStructure();
 
+  // Only one process or thread creates a library of the model at a time, since they share the sources in the library folder. The others
+  // wait and load the result. The code generation lock is not held while waiting, since the owner of the file lock may need it to finish.
+  // The lock file is named after the model rather than the library, such that tape changes do not accumulate lock files.
+  codeGenerationLock.unlock();
+  LibraryFileLock libraryFileLock(libraryFolder_ + "/" + modelName_ + "_lib.lock");
+  codeGenerationLock.lock();
+
+  if (loadIfAvailable && isLibraryAvailable()) {
+    codeGenerationLock.unlock();
+    loadModels(verbose);
+    return;
+  }
+
+  // Compile to temporary shared library file to avoid interference between processes
+  compileLibrary(approximationOrder, fun, codeGenerationLock, libraryName_ + tmpName_, tmpFolder_, libraryFolder_, verbose);
+
+  // Rename generated library before loading
+  if (verbose) {
+    std::cerr << "[CppAdInterface] Renaming " << libraryName_ + tmpName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION << " to "
+              << libraryName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION << std::endl;
+  }
+  boost::filesystem::rename(libraryName_ + tmpName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION,
+                            libraryName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION);
+  loadModels(false);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::compileLibrary(ApproximationOrder approximationOrder, ad_fun_t& fun, std::unique_lock<std::mutex>& codeGenerationLock,
+                                    const std::string& libraryFile, const std::string& tmpFolder, const std::string& sourcesFolder,
+                                    bool verbose) const {
+  // generates source code
+  CppAD::cg::ModelCSourceGen<scalar_t> sourceGen(fun, modelName_);
+  setApproximationOrder(approximationOrder, sourceGen, fun);
+
+  // Compiler objects
+  CppAD::cg::ModelLibraryCSourceGen<scalar_t> libraryCSourceGen(sourceGen);
+  ParallelGccCompiler gccCompiler(codeGenerationLock);
+  CppAD::cg::DynamicModelLibraryProcessor<scalar_t> libraryProcessor(libraryCSourceGen, libraryFile);
+  setCompilerOptions(gccCompiler, tmpFolder, sourcesFolder);
+
+  if (verbose) {
+    std::cerr << "[CppAdInterface] Compiling Shared Library: " << libraryFile + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION
+              << std::endl;
+  }
+
+  // Compile and store the library
+  libraryProcessor.createDynamicLibrary(gccCompiler, false);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::recordTape(ad_fun_t& fun) {
   // set and declare independent variables and start tape recording
   ad_vector_t xp(variableDim_ + parameterDim_);
   xp.setOnes();  // Ones are better than zero, to prevent devision by zero in taping
@@ -85,133 +591,283 @@ void CppAdInterface::createModels(ApproximationOrder approximationOrder, bool ve
   adFunction_(x, p, y);
   rangeDim_ = y.rows();
   // create f: xp -> y and stop tape recording
-  ad_fun_t fun(xp, y);
+  fun.Dependent(xp, y);
   // Optimize the operation sequence
   fun.optimize();
+}
 
-  // generates source code
-  CppAD::cg::ModelCSourceGen<scalar_t> sourceGen(fun, modelName_);
-  setApproximationOrder(approximationOrder, sourceGen, fun);
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::string CppAdInterface::getModelHash(ApproximationOrder approximationOrder, ad_fun_t& fun) const {
+  // The source code of the zero order forward sweep describes the operation sequence of the tape. The derivative code is fully
+  // determined by it, the approximation order, and the CppAD version.
+  CppAD::cg::CodeHandler<scalar_t> codeHandler;
+  std::vector<ad_base_t> xp(variableDim_ + parameterDim_);
+  codeHandler.makeVariables(xp);
+  std::vector<ad_base_t> y = fun.Forward(0, xp);
 
-  // Compiler objects, compile to temporary shared library file to avoid interference between processes
-  CppAD::cg::ModelLibraryCSourceGen<scalar_t> libraryCSourceGen(sourceGen);
-  CppAD::cg::GccCompiler<scalar_t> gccCompiler;
-  CppAD::cg::DynamicModelLibraryProcessor<scalar_t> libraryProcessor(libraryCSourceGen, libraryName_ + tmpName_);
-  setCompilerOptions(gccCompiler);
+  std::ostringstream modelDescription;
+  CppAD::cg::LanguageC<scalar_t> languageC("double");
+  CppAD::cg::LangCDefaultVariableNameGenerator<scalar_t> nameGenerator;
+  codeHandler.generateCode(modelDescription, languageC, y, nameGenerator);
 
-  if (verbose) {
-    std::cerr << "[CppAdInterface] Compiling Shared Library: "
-              << libraryName_ + tmpName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION << std::endl;
+  modelDescription << CPPAD_PACKAGE_STRING << '\n' << modelName_ << '\n';
+  modelDescription << variableDim_ << ' ' << parameterDim_ << ' ' << rangeDim_ << ' ' << static_cast<int>(approximationOrder) << '\n';
+  for (const auto& flag : compileFlags_) {
+    modelDescription << flag << ' ';
   }
 
-  // Compile and store the library
-  dynamicLib_ = libraryProcessor.createDynamicLibrary(gccCompiler);
-  model_ = dynamicLib_->model(modelName_);
+  return getHashString(modelDescription.str());
+}
 
-  setSparsityNonzeros();
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::createModelsConcurrently(const std::vector<CppAdInterface*>& interfaces, ApproximationOrder approximationOrder,
+                                              bool verbose) {
+  runForEachInterface(interfaces, [=](CppAdInterface& cppAdInterface) { cppAdInterface.createModels(approximationOrder, verbose); });
+}
 
-  // Rename generated library after loading
-  if (verbose) {
-    std::cerr << "[CppAdInterface] Renaming " << libraryName_ + tmpName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION << " to "
-              << libraryName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION << std::endl;
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::loadModelsIfAvailableConcurrently(const std::vector<CppAdInterface*>& interfaces,
+                                                       ApproximationOrder approximationOrder, bool verbose) {
+  runForEachInterface(interfaces,
+                      [=](CppAdInterface& cppAdInterface) { cppAdInterface.loadModelsIfAvailable(approximationOrder, verbose); });
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::setMaxNumCompilerJobs(size_t maxNumCompilerJobs) {
+  CompilerJobLimiter::instance().setMaxNumJobs(maxNumCompilerJobs);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::setCompilationAllowed(bool allowed) {
+  compilationAllowed = allowed;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::setInMemoryCompilation(bool inMemory) {
+  inMemoryCompilation = inMemory;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool CppAdInterface::isLoaded() const {
+  return library_ != nullptr && library_->loaded.load(std::memory_order_acquire);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+const CppAdInterface::SharedLibrary& CppAdInterface::getLibrary() const {
+  if (library_ == nullptr) {
+    throw std::runtime_error("[CppAdInterface] The models of " + modelName_ + " are neither created nor loaded.");
   }
-  boost::filesystem::rename(libraryName_ + tmpName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION,
-                            libraryName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION);
+  library_->load();
+  return *library_;
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-void CppAdInterface::loadModels(bool verbose) {
-  if (verbose) {
-    std::cerr << "[CppAdInterface] Loading Shared Library: " << libraryName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION
-              << std::endl;
+CppAD::cg::GenericModel<scalar_t>& CppAdInterface::getModel() const {
+  auto* modelPtr = modelPtr_.load(std::memory_order_acquire);
+  if (modelPtr == nullptr) {
+    std::lock_guard<std::mutex> lock(modelMutex_);
+    if (model_ == nullptr) {
+      model_ = getLibrary().createModel();
+      modelPtr_.store(model_.get(), std::memory_order_release);
+    }
+    modelPtr = model_.get();
   }
-  dynamicLib_.reset(new CppAD::cg::LinuxDynamicLib<scalar_t>(libraryName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION));
-  model_ = dynamicLib_->model(modelName_);
-  rangeDim_ = model_->Range();
+  return *modelPtr;
+}
 
-  setSparsityNonzeros();
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t CppAdInterface::getFunctionValue(const vector_t& x, const vector_t& p) const {
+  vector_t functionValue(rangeDim_);
+  getFunctionValue(x, p, functionValue);
+  return functionValue;
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-void CppAdInterface::loadModelsIfAvailable(ApproximationOrder approximationOrder, bool verbose) {
-  if (isLibraryAvailable()) {
-    loadModels(verbose);
+void CppAdInterface::getFunctionValue(const Eigen::Ref<const vector_t>& x, const Eigen::Ref<const vector_t>& p,
+                                      Eigen::Ref<vector_t> value) const {
+  assert(value.size() == rangeDim_);
+  const auto& library = getLibrary();
+  auto& workspace = getEvaluationWorkspace();
+  const auto xpArrayView = setInput(x, p, workspace);
+  forwardZero(library, xpArrayView, value.data());
+  assert(value.allFinite());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::forwardZero(const SharedLibrary& library, CppAD::cg::ArrayView<const scalar_t> xp, scalar_t* value) const {
+  if (library.forwardZeroKernel != nullptr) {
+    // The kernel is called with local argument arrays, unlike the model object, which stores them in members.
+    const scalar_t* inputs[1] = {xp.data()};
+    scalar_t* outputs[1] = {value};
+    (*library.forwardZeroKernel)(inputs, outputs, LangCAtomicFun{nullptr, nullptr, nullptr});
   } else {
-    createModels(approximationOrder, verbose);
+    CppAD::cg::ArrayView<scalar_t> valueArrayView(value, rangeDim_);
+    getModel().ForwardZero(xp, valueArrayView);
   }
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-vector_t CppAdInterface::getFunctionValue(const vector_t& x, const vector_t& p) const {
-  vector_t xp(variableDim_ + parameterDim_);
-  xp << x, p;
+void CppAdInterface::getFunctionValueBatch(const Eigen::Ref<const matrix_t>& xBatch, const Eigen::Ref<const matrix_t>& pBatch,
+                                           Eigen::Ref<matrix_t> valueBatch) const {
+  const Eigen::Index batchSize = xBatch.cols();
+  assert(xBatch.rows() == variableDim_ && pBatch.rows() == parameterDim_ && pBatch.cols() == batchSize);
+  assert(valueBatch.rows() == rangeDim_ && valueBatch.cols() == batchSize);
+  const auto& library = getLibrary();
+  auto& workspace = getEvaluationWorkspace();
 
-  vector_t functionValue(model_->Range());
+  for (Eigen::Index k = 0; k < batchSize; k++) {
+    const auto xpArrayView = setInput(xBatch.col(k), pBatch.col(k), workspace);
+    forwardZero(library, xpArrayView, valueBatch.col(k).data());
+  }
+  assert(valueBatch.allFinite());
+}
 
-  model_->ForwardZero(xp, functionValue);
-  assert(functionValue.allFinite());
-  return functionValue;
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::getJacobianBatch(const Eigen::Ref<const matrix_t>& xBatch, const Eigen::Ref<const matrix_t>& pBatch,
+                                      Eigen::Ref<matrix_t> jacobianBatch) const {
+  const Eigen::Index batchSize = xBatch.cols();
+  assert(xBatch.rows() == variableDim_ && pBatch.rows() == parameterDim_ && pBatch.cols() == batchSize);
+  assert(jacobianBatch.rows() == rangeDim_ && jacobianBatch.cols() == variableDim_ * batchSize);
+  const size_t nnzJacobian = getLibrary().nnzJacobian;
+  auto& model = getModel();
+  auto& workspace = getEvaluationWorkspace();
+  workspace.sparseValues.resize(nnzJacobian);
+  CppAD::cg::ArrayView<scalar_t> sparseJacobianArrayView(workspace.sparseValues);
+  size_t const* rows;
+  size_t const* cols;
+
+  jacobianBatch.setZero();
+  for (Eigen::Index k = 0; k < batchSize; k++) {
+    const auto xpArrayView = setInput(xBatch.col(k), pBatch.col(k), workspace);
+    model.SparseJacobian(xpArrayView, sparseJacobianArrayView, &rows, &cols);
+
+    const size_t colOffset = k * variableDim_;
+    for (size_t i = 0; i < nnzJacobian; i++) {
+      jacobianBatch(rows[i], colOffset + cols[i]) = workspace.sparseValues[i];
+    }
+  }
+  assert(jacobianBatch.allFinite());
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 matrix_t CppAdInterface::getJacobian(const vector_t& x, const vector_t& p) const {
-  // Concatenate input
-  vector_t xp(variableDim_ + parameterDim_);
-  xp << x, p;
-  CppAD::cg::ArrayView<scalar_t> xpArrayView(xp.data(), xp.size());
+  matrix_t jacobian(rangeDim_, variableDim_);
+  getJacobian(x, p, jacobian);
+  return jacobian;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::getJacobian(const Eigen::Ref<const vector_t>& x, const Eigen::Ref<const vector_t>& p,
+                                 Eigen::Ref<matrix_t> jacobian) const {
+  assert(jacobian.rows() == rangeDim_ && jacobian.cols() == variableDim_);
+  const size_t nnzJacobian = getLibrary().nnzJacobian;
+  auto& model = getModel();
+  auto& workspace = getEvaluationWorkspace();
+  const auto xpArrayView = setInput(x, p, workspace);
 
-  std::vector<scalar_t> sparseJacobian(nnzJacobian_);
-  CppAD::cg::ArrayView<scalar_t> sparseJacobianArrayView(sparseJacobian);
+  workspace.sparseValues.resize(nnzJacobian);
+  CppAD::cg::ArrayView<scalar_t> sparseJacobianArrayView(workspace.sparseValues);
   size_t const* rows;
   size_t const* cols;
   // Call this particular SparseJacobian. Other CppAd functions allocate internal vectors that are incompatible with multithreading.
-  model_->SparseJacobian(xpArrayView, sparseJacobianArrayView, &rows, &cols);
+  model.SparseJacobian(xpArrayView, sparseJacobianArrayView, &rows, &cols);
 
   // Write sparse elements into Eigen type. Only jacobian w.r.t. variables was requested, so cols should not contain elements corresponding
   // to parameters.
-  matrix_t jacobian = matrix_t::Zero(model_->Range(), variableDim_);
-  for (size_t i = 0; i < nnzJacobian_; i++) {
-    jacobian(rows[i], cols[i]) = sparseJacobian[i];
+  jacobian.setZero();
+  for (size_t i = 0; i < nnzJacobian; i++) {
+    jacobian(rows[i], cols[i]) = workspace.sparseValues[i];
   }
 
   assert(jacobian.allFinite());
-  return jacobian;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::getSparseJacobian(const vector_t& x, const vector_t& p, sparse_matrix_t& jacobian) const {
+  const size_t nnzJacobian = getLibrary().nnzJacobian;
+  auto& model = getModel();
+  auto& workspace = getEvaluationWorkspace();
+  const auto xpArrayView = setInput(x, p, workspace);
+
+  const bool hasPattern = hasSparsityPattern(jacobian, rangeDim_, variableDim_, nnzJacobian);
+  if (!hasPattern) {
+    jacobian.resize(rangeDim_, variableDim_);
+    jacobian.resizeNonZeros(nnzJacobian);
+  }
+
+  // The nonzeros are written directly into the storage of the compressed row matrix.
+  CppAD::cg::ArrayView<scalar_t> sparseJacobianArrayView(jacobian.valuePtr(), nnzJacobian);
+  size_t const* rows;
+  size_t const* cols;
+  model.SparseJacobian(xpArrayView, sparseJacobianArrayView, &rows, &cols);
+
+  if (!hasPattern) {
+    setSparsityPattern(jacobian, rows, cols, nnzJacobian);
+  }
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 ScalarFunctionQuadraticApproximation CppAdInterface::getGaussNewtonApproximation(const vector_t& x, const vector_t& p) const {
-  // Concatenate input
-  vector_t xp(variableDim_ + parameterDim_);
-  xp << x, p;
-  CppAD::cg::ArrayView<scalar_t> xpArrayView(xp.data(), xp.size());
+  const auto& library = getLibrary();
+  const size_t nnzJacobian = library.nnzJacobian;
+  auto& model = getModel();
+  auto& workspace = getEvaluationWorkspace();
+  const auto xpArrayView = setInput(x, p, workspace);
 
   ScalarFunctionQuadraticApproximation gnApprox;
 
   // Zero order
-  vector_t valueVector(model_->Range());
-  model_->ForwardZero(xp, valueVector);
+  vector_t valueVector(rangeDim_);
+  forwardZero(library, xpArrayView, valueVector.data());
   gnApprox.f = 0.5 * valueVector.squaredNorm();
 
   // Jacobian
-  std::vector<scalar_t> sparseJacobian(nnzJacobian_);
-  CppAD::cg::ArrayView<scalar_t> sparseJacobianArrayView(sparseJacobian);
+  workspace.sparseValues.resize(nnzJacobian);
+  const auto& sparseJacobian = workspace.sparseValues;
+  CppAD::cg::ArrayView<scalar_t> sparseJacobianArrayView(workspace.sparseValues);
   size_t const* rows;
   size_t const* cols;
-  model_->SparseJacobian(xpArrayView, sparseJacobianArrayView, &rows, &cols);
+  model.SparseJacobian(xpArrayView, sparseJacobianArrayView, &rows, &cols);
 
   // Sparse evaluation of J' * f
   gnApprox.dfdx.setZero(variableDim_);
-  for (size_t i = 0; i < nnzJacobian_; i++) {
+  for (size_t i = 0; i < nnzJacobian; i++) {
     gnApprox.dfdx(cols[i]) += sparseJacobian[i] * valueVector(rows[i]);
   }
 
@@ -222,7 +878,7 @@ ScalarFunctionQuadraticApproximation CppAdInterface::getGaussNewtonApproximation
    * For each row of J, we add the non-zero pairs (i, j) to H(i, j).
    */
   gnApprox.dfdxx.setZero(variableDim_, variableDim_);
-  for (size_t i = 0; i < nnzJacobian_; ++i) {
+  for (size_t i = 0; i < nnzJacobian; ++i) {
     const size_t row_i = rows[i];
     const size_t col_i = cols[i];
     const scalar_t v_i = sparseJacobian[i];
@@ -230,7 +886,7 @@ ScalarFunctionQuadraticApproximation CppAdInterface::getGaussNewtonApproximation
     gnApprox.dfdxx(col_i, col_i) += v_i * v_i;
     // Process off-diagonals
     size_t j = i + 1;
-    while (rows[j] == row_i) {
+    while (j < nnzJacobian && rows[j] == row_i) {
       const size_t col_j = cols[j];
       gnApprox.dfdxx(col_j, col_i) += v_i * sparseJacobian[j];
       gnApprox.dfdxx(col_i, col_j) = gnApprox.dfdxx(col_j, col_i);  // Maintain symmetry as we go.
@@ -257,32 +913,68 @@ matrix_t CppAdInterface::getHessian(size_t outputIndex, const vector_t& x, const
 /******************************************************************************************************/
 /******************************************************************************************************/
 matrix_t CppAdInterface::getHessian(const vector_t& w, const vector_t& x, const vector_t& p) const {
-  // Concatenate input
-  vector_t xp(variableDim_ + parameterDim_);
-  xp << x, p;
-  CppAD::cg::ArrayView<const scalar_t> xpArrayView(xp.data(), xp.size());
+  matrix_t hessian(variableDim_, variableDim_);
+  getHessian(w, x, p, hessian);
+  return hessian;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::getHessian(const Eigen::Ref<const vector_t>& w, const Eigen::Ref<const vector_t>& x,
+                                const Eigen::Ref<const vector_t>& p, Eigen::Ref<matrix_t> hessian) const {
+  assert(hessian.rows() == variableDim_ && hessian.cols() == variableDim_);
+  const size_t nnzHessian = getLibrary().nnzHessian;
+  auto& model = getModel();
+  auto& workspace = getEvaluationWorkspace();
+  const auto xpArrayView = setInput(x, p, workspace);
+  CppAD::cg::ArrayView<const scalar_t> wArrayView(w.data(), w.size());
 
-  std::vector<scalar_t> sparseHessian(nnzHessian_);
-  CppAD::cg::ArrayView<scalar_t> sparseHessianArrayView(sparseHessian);
+  workspace.sparseValues.resize(nnzHessian);
+  CppAD::cg::ArrayView<scalar_t> sparseHessianArrayView(workspace.sparseValues);
   size_t const* rows;
   size_t const* cols;
 
-  CppAD::cg::ArrayView<const scalar_t> wArrayView(w.data(), w.size());
-
   // Call this particular SparseHessian. Other CppAd functions allocate internal vectors that are incompatible with multithreading.
-  model_->SparseHessian(xpArrayView, wArrayView, sparseHessianArrayView, &rows, &cols);
+  model.SparseHessian(xpArrayView, wArrayView, sparseHessianArrayView, &rows, &cols);
 
   // Fills upper triangular sparsity of hessian w.r.t variables.
-  matrix_t hessian = matrix_t::Zero(variableDim_, variableDim_);
-  for (size_t i = 0; i < nnzHessian_; i++) {
-    hessian(rows[i], cols[i]) = sparseHessian[i];
+  hessian.setZero();
+  for (size_t i = 0; i < nnzHessian; i++) {
+    hessian(rows[i], cols[i]) = workspace.sparseValues[i];
   }
 
   // Copy upper triangular to lower triangular part
   hessian.template triangularView<Eigen::StrictlyLower>() = hessian.template triangularView<Eigen::StrictlyUpper>().transpose();
 
   assert(hessian.allFinite());
-  return hessian;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::getSparseHessian(const vector_t& w, const vector_t& x, const vector_t& p, sparse_matrix_t& hessian) const {
+  const size_t nnzHessian = getLibrary().nnzHessian;
+  auto& model = getModel();
+  auto& workspace = getEvaluationWorkspace();
+  const auto xpArrayView = setInput(x, p, workspace);
+  CppAD::cg::ArrayView<const scalar_t> wArrayView(w.data(), w.size());
+
+  const bool hasPattern = hasSparsityPattern(hessian, variableDim_, variableDim_, nnzHessian);
+  if (!hasPattern) {
+    hessian.resize(variableDim_, variableDim_);
+    hessian.resizeNonZeros(nnzHessian);
+  }
+
+  // The nonzeros of the upper triangular part are written directly into the storage of the compressed row matrix.
+  CppAD::cg::ArrayView<scalar_t> sparseHessianArrayView(hessian.valuePtr(), nnzHessian);
+  size_t const* rows;
+  size_t const* cols;
+  model.SparseHessian(xpArrayView, wArrayView, sparseHessianArrayView, &rows, &cols);
+
+  if (!hasPattern) {
+    setSparsityPattern(hessian, rows, cols, nnzHessian);
+  }
 }
 
 /******************************************************************************************************/
@@ -296,14 +988,13 @@ void CppAdInterface::setFolderNames() {
   }
   tmpName_ = getUniqueTemporaryName();
   tmpFolder_ = libraryFolder_ + "/" + tmpName_;
-  libraryName_ = libraryFolder_ + "/" + modelName_ + "_lib";
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 bool CppAdInterface::isLibraryAvailable() const {
-  return boost::filesystem::exists(libraryName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION);
+  return !libraryName_.empty() && boost::filesystem::exists(libraryName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION);
 }
 
 /******************************************************************************************************/
@@ -319,14 +1010,17 @@ void CppAdInterface::createFolderStructure() const {
 /******************************************************************************************************/
 std::string CppAdInterface::getUniqueTemporaryName() const {
   // Random string should be unique for each process and time of calling.
+  // The counter distinguishes interfaces of the same process that are constructed at the same time.
+  static std::atomic<size_t> counter{0};
   int randomFromClock = std::chrono::high_resolution_clock::now().time_since_epoch().count() % 1000;
-  return std::string("cppadcg_tmp") + std::to_string(randomFromClock) + std::to_string(getpid());
+  return std::string("cppadcg_tmp") + std::to_string(randomFromClock) + std::to_string(getpid()) + "_" + std::to_string(counter++);
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-void CppAdInterface::setCompilerOptions(CppAD::cg::GccCompiler<scalar_t>& compiler) const {
+void CppAdInterface::setCompilerOptions(CppAD::cg::GccCompiler<scalar_t>& compiler, const std::string& tmpFolder,
+                                        const std::string& sourcesFolder) const {
   if (!compileFlags_.empty()) {
     // Set compile flags and add required flags for dynamic compilation
     auto compileFlags = compileFlags_;
@@ -335,10 +1029,10 @@ void CppAdInterface::setCompilerOptions(CppAD::cg::GccCompiler<scalar_t>& compil
     compiler.addCompileLibFlag("-rdynamic");
   }
 
-  compiler.setTemporaryFolder(tmpFolder_);
+  compiler.setTemporaryFolder(tmpFolder);
 
   // Save sources
-  compiler.setSourcesFolder(libraryFolder_);
+  compiler.setSourcesFolder(sourcesFolder);
   compiler.setSaveToDiskFirst(true);
 }
 
@@ -352,9 +1046,15 @@ void CppAdInterface::setApproximationOrder(ApproximationOrder approximationOrder
       sourceGen.setCreateSparseHessian(true);
       sourceGen.setCustomSparseHessianElements(createHessianSparsity(fun));
       // Intentional fall through
-    case ApproximationOrder::First:
+    case ApproximationOrder::First: {
+      // The compressed Jacobian is computed with one sweep per color, use the direction with the fewer colors
+      const auto jacobianSparsity = createJacobianSparsity(fun);
+      const bool isForwardCheaper = cppad_sparsity::getNumberOfColumnColors(jacobianSparsity, variableDim_ + parameterDim_) <=
+                                    cppad_sparsity::getNumberOfRowColors(jacobianSparsity);
       sourceGen.setCreateSparseJacobian(true);
-      sourceGen.setCustomSparseJacobianElements(createJacobianSparsity(fun));
+      sourceGen.setJacobianADMode(isForwardCheaper ? CppAD::cg::JacobianADMode::Forward : CppAD::cg::JacobianADMode::Reverse);
+      sourceGen.setCustomSparseJacobianElements(jacobianSparsity);
+    }
       // Intentional fall through
     case ApproximationOrder::Zero:
       break;
@@ -363,18 +1063,6 @@ void CppAdInterface::setApproximationOrder(ApproximationOrder approximationOrder
   }
 }
 
-/******************************************************************************************************/
-/******************************************************************************************************/
-/******************************************************************************************************/
-void CppAdInterface::setSparsityNonzeros() {
-  if (model_->isJacobianSparsityAvailable()) {
-    nnzJacobian_ = cppad_sparsity::getNumberOfNonZeros(model_->JacobianSparsitySet());
-  }
-  if (model_->isHessianSparsityAvailable()) {
-    nnzHessian_ = cppad_sparsity::getNumberOfNonZeros(model_->HessianSparsitySet());
-  }
-}
-
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -33,6 +33,33 @@ namespace ocs2 {
 
 namespace cppad_sparsity {
 
+namespace {
+/** Greedy coloring of the rows, where rows with a nonzero in the same column get different colors */
+size_t getNumberOfGreedyRowColors(const SparsityPattern& sparsityPattern, size_t numCols) {
+  // colors of the rows which are already colored, per column
+  std::vector<std::vector<bool>> columnColors(numCols);
+  std::vector<bool> isForbidden;
+  size_t numColors = 0;
+  for (const auto& row : sparsityPattern) {
+    isForbidden.assign(numColors, false);
+    for (const auto col : row) {
+      for (size_t c = 0; c < columnColors[col].size(); c++) {
+        if (columnColors[col][c]) {
+          isForbidden[c] = true;
+        }
+      }
+    }
+    const size_t color = std::find(isForbidden.begin(), isForbidden.end(), false) - isForbidden.begin();
+    numColors = std::max(numColors, color + 1);
+    for (const auto col : row) {
+      columnColors[col].resize(numColors, false);
+      columnColors[col][color] = true;
+    }
+  }
+  return numColors;
+}
+}  // namespace
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -86,5 +113,31 @@ size_t getNumberOfNonZeros(const SparsityPattern& sparsityPattern) {
   return nnz;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t getNumberOfRowColors(const SparsityPattern& sparsityPattern) {
+  size_t numCols = 0;
+  for (const auto& row : sparsityPattern) {
+    if (!row.empty()) {
+      numCols = std::max(numCols, *row.rbegin() + 1);
+    }
+  }
+  return getNumberOfGreedyRowColors(sparsityPattern, numCols);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t getNumberOfColumnColors(const SparsityPattern& sparsityPattern, size_t numCols) {
+  SparsityPattern transposedPattern(numCols);
+  for (size_t i = 0; i < sparsityPattern.size(); i++) {
+    for (const auto j : sparsityPattern[i]) {
+      transposedPattern[j].insert(i);
+    }
+  }
+  return getNumberOfGreedyRowColors(transposedPattern, sparsityPattern.size());
+}
+
 }  // namespace cppad_sparsity
 }  // namespace ocs2
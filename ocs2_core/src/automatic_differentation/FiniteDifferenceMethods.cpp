@@ -28,11 +28,61 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
 #include <algorithm>
+#include <stdexcept>
 
 #include <ocs2_core/automatic_differentiation/FiniteDifferenceMethods.h>
 
 namespace ocs2 {
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+FiniteDifferenceColoring::FiniteDifferenceColoring(size_t numRows, size_t numCols)
+    : numRows_(numRows), colorColumns_(numCols), columnRows_(numCols) {
+  for (size_t j = 0; j < numCols; j++) {
+    colorColumns_[j].push_back(j);
+    columnRows_[j].resize(numRows);
+    for (size_t i = 0; i < numRows; i++) {
+      columnRows_[j][i] = i;
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+FiniteDifferenceColoring::FiniteDifferenceColoring(const sparsity_pattern_t& sparsity)
+    : numRows_(sparsity.rows()), columnRows_(sparsity.cols()) {
+  // rows which are already occupied by the columns of each color
+  std::vector<std::vector<bool>> colorRows;
+
+  for (size_t j = 0; j < sparsity.cols(); j++) {
+    for (size_t i = 0; i < numRows_; i++) {
+      if (sparsity(i, j)) {
+        columnRows_[j].push_back(i);
+      }
+    }
+
+    // the first color which does not share a row with this column
+    size_t color = 0;
+    const auto sharesRow = [&](size_t c) {
+      return std::any_of(columnRows_[j].begin(), columnRows_[j].end(), [&](size_t i) { return colorRows[c][i]; });
+    };
+    while (color < colorColumns_.size() && sharesRow(color)) {
+      color++;
+    }
+    if (color == colorColumns_.size()) {
+      colorColumns_.emplace_back();
+      colorRows.emplace_back(numRows_, false);
+    }
+
+    colorColumns_[color].push_back(j);
+    for (const auto i : columnRows_[j]) {
+      colorRows[color][i] = true;
+    }
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -95,4 +145,61 @@ matrix_t finiteDifferenceDerivativeInput(ControlledSystemBase& system, scalar_t
   return B;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void finiteDifferenceDerivativeBatch(ControlledSystemBase& system, scalar_t t, const vector_t& x, const vector_t& u,
+                                     const FiniteDifferenceColoring& coloring, scalar_t eps, bool doubleSidedDerivative, matrix_t& dfdx,
+                                     matrix_t& dfdu) {
+  const size_t stateDim = x.rows();
+  const size_t inputDim = u.rows();
+  if (coloring.getNumRows() != stateDim || coloring.getNumCols() != stateDim + inputDim) {
+    throw std::runtime_error("[finiteDifferenceDerivativeBatch] The coloring does not match the state and input dimensions!");
+  }
+
+  // The variable of column j is x(j) for j < stateDim and u(j - stateDim) otherwise
+  const auto variable = [&](size_t j) { return (j < stateDim) ? x(j) : u(j - stateDim); };
+  const auto perturbation = [&](size_t j) {
+    // inspired from: http://en.wikipedia.org/wiki/Numerical_differentiation#Practical_considerations_using_floating_point_arithmetic
+    return eps * std::max(std::abs(variable(j)), 1.0);
+  };
+
+  // Batch of the perturbed states and inputs: one column per color, followed by one per color with the negative perturbation or
+  // by the unperturbed point for the one sided derivative.
+  const size_t numColors = coloring.getNumColors();
+  const size_t batchSize = doubleSidedDerivative ? 2 * numColors : numColors + 1;
+  thread_local matrix_t xBatch;
+  thread_local matrix_t uBatch;
+  thread_local matrix_t fBatch;
+  xBatch = x.replicate(1, batchSize);
+  uBatch = u.replicate(1, batchSize);
+  for (size_t c = 0; c < numColors; c++) {
+    for (const auto j : coloring.getColorColumns(c)) {
+      const scalar_t h = perturbation(j);
+      auto& batch = (j < stateDim) ? xBatch : uBatch;
+      const size_t row = (j < stateDim) ? j : j - stateDim;
+      batch(row, c) += h;
+      if (doubleSidedDerivative) {
+        batch(row, numColors + c) -= h;
+      }
+    }
+  }
+
+  system.computeFlowMapBatch(t, xBatch, uBatch, fBatch);
+
+  dfdx.setZero(stateDim, stateDim);
+  dfdu.setZero(stateDim, inputDim);
+  for (size_t c = 0; c < numColors; c++) {
+    const size_t referenceCol = doubleSidedDerivative ? numColors + c : numColors;
+    for (const auto j : coloring.getColorColumns(c)) {
+      const scalar_t h = perturbation(j);
+      const scalar_t scaling = doubleSidedDerivative ? 1.0 / (2.0 * h) : 1.0 / h;
+      auto jacobianCol = (j < stateDim) ? dfdx.col(j) : dfdu.col(j - stateDim);
+      for (const auto i : coloring.getColumnRows(j)) {
+        jacobianCol(i) = (fBatch(i, c) - fBatch(i, referenceCol)) * scaling;
+      }
+    }
+  }
+}
+
 }  // namespace ocs2
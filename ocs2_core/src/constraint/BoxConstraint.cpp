@@ -0,0 +1,113 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <ocs2_core/constraint/BoxConstraint.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace ocs2 {
+
+namespace {
+/** Sorts the bounds by index and verifies that they are consistent */
+void sortAndVerify(std::vector<BoxConstraint::Bound>& bounds, const std::string& name) {
+  std::sort(bounds.begin(), bounds.end(), [](const BoxConstraint::Bound& lhs, const BoxConstraint::Bound& rhs) {
+    return lhs.index < rhs.index;
+  });
+  for (size_t i = 0; i < bounds.size(); i++) {
+    if (i > 0 && bounds[i].index == bounds[i - 1].index) {
+      throw std::runtime_error("[BoxConstraint] The " + name + " entry " + std::to_string(bounds[i].index) + " is bounded twice!");
+    }
+    if (bounds[i].lowerBound > bounds[i].upperBound) {
+      throw std::runtime_error("[BoxConstraint] The lower bound of the " + name + " entry " + std::to_string(bounds[i].index) +
+                               " exceeds its upper bound!");
+    }
+  }
+}
+
+void getDeviationBounds(const std::vector<BoxConstraint::Bound>& bounds, const vector_t& v, vector_t& lowerBound, vector_t& upperBound) {
+  lowerBound.resize(bounds.size());
+  upperBound.resize(bounds.size());
+  for (size_t i = 0; i < bounds.size(); i++) {
+    const auto value = v(bounds[i].index);
+    lowerBound(i) = bounds[i].lowerBound - value;
+    upperBound(i) = bounds[i].upperBound - value;
+  }
+}
+
+scalar_t getViolationSquaredNorm(const std::vector<BoxConstraint::Bound>& bounds, const vector_t& v) {
+  scalar_t violation = 0.0;
+  for (const auto& bound : bounds) {
+    const auto value = v(bound.index);
+    const scalar_t error = std::max(bound.lowerBound - value, scalar_t(0.0)) + std::max(value - bound.upperBound, scalar_t(0.0));
+    violation += error * error;
+  }
+  return violation;
+}
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+BoxConstraint::BoxConstraint(std::vector<Bound> stateBounds, std::vector<Bound> inputBounds)
+    : stateBounds_(std::move(stateBounds)), inputBounds_(std::move(inputBounds)) {
+  sortAndVerify(stateBounds_, "state");
+  sortAndVerify(inputBounds_, "input");
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void BoxConstraint::getStateDeviationBounds(const vector_t& state, vector_t& lowerBound, vector_t& upperBound) const {
+  getDeviationBounds(stateBounds_, state, lowerBound, upperBound);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void BoxConstraint::getInputDeviationBounds(const vector_t& input, vector_t& lowerBound, vector_t& upperBound) const {
+  getDeviationBounds(inputBounds_, input, lowerBound, upperBound);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t BoxConstraint::getStateViolationSquaredNorm(const vector_t& state) const {
+  return getViolationSquaredNorm(stateBounds_, state);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t BoxConstraint::getInputViolationSquaredNorm(const vector_t& input) const {
+  return getViolationSquaredNorm(inputBounds_, input);
+}
+
+}  // namespace ocs2
@@ -75,4 +75,18 @@ VectorFunctionLinearApproximation LinearStateInputConstraint::getLinearApproxima
   return g;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LinearStateInputConstraint::writeLinearApproximation(scalar_t t, const vector_t& x, const vector_t& u, const PreComputation&,
+                                                          size_t startRow, VectorFunctionLinearApproximation& stackedApproximation) const {
+  const size_t nc = e_.rows();
+  auto g = stackedApproximation.f.segment(startRow, nc);
+  g = e_;
+  g.noalias() += C_ * x;
+  g.noalias() += D_ * u;
+  stackedApproximation.dfdx.middleRows(startRow, nc) = C_;
+  stackedApproximation.dfdu.middleRows(startRow, nc) = D_;
+}
+
 }  // namespace ocs2
@@ -50,8 +50,10 @@ size_t StateConstraintCollection::getNumConstraints(scalar_t time) const {
   size_t numConstraints = 0;
 
   // accumulate number of constraints for each constraintTerm
-  for (const auto& constraintTerm : this->terms_) {
-    if (constraintTerm->isActive(time)) {
+  const auto activeTerms = this->getActiveTerms(time);
+  for (size_t i = 0; i < this->terms_.size(); i++) {
+    if (activeTerms[i]) {
+      const auto& constraintTerm = this->terms_[i];
       numConstraints += constraintTerm->getNumConstraints(time);
     }
   }
@@ -68,8 +70,10 @@ vector_t StateConstraintCollection::getValue(scalar_t time, const vector_t& stat
 
   // append vectors of constraint values from each constraintTerm
   size_t i = 0;
-  for (const auto& constraintTerm : this->terms_) {
-    if (constraintTerm->isActive(time)) {
+  const auto activeTerms = this->getActiveTerms(time);
+  for (size_t k = 0; k < this->terms_.size(); k++) {
+    if (activeTerms[k]) {
+      const auto& constraintTerm = this->terms_[k];
       const auto constraintTermValues = constraintTerm->getValue(time, state, preComp);
       constraintValues.segment(i, constraintTermValues.rows()) = constraintTermValues;
       i += constraintTermValues.rows();
@@ -88,8 +92,10 @@ VectorFunctionLinearApproximation StateConstraintCollection::getLinearApproximat
 
   // append linearApproximation of each constraintTerm
   size_t i = 0;
-  for (const auto& constraintTerm : this->terms_) {
-    if (constraintTerm->isActive(time)) {
+  const auto activeTerms = this->getActiveTerms(time);
+  for (size_t k = 0; k < this->terms_.size(); k++) {
+    if (activeTerms[k]) {
+      const auto& constraintTerm = this->terms_[k];
       const auto constraintTermApproximation = constraintTerm->getLinearApproximation(time, state, preComp);
       const size_t nc = constraintTermApproximation.f.rows();
       linearApproximation.f.segment(i, nc) = constraintTermApproximation.f;
@@ -115,8 +121,10 @@ VectorFunctionQuadraticApproximation StateConstraintCollection::getQuadraticAppr
 
   // append quadraticApproximation of each constraintTerm
   size_t i = 0;
-  for (const auto& constraintTerm : this->terms_) {
-    if (constraintTerm->isActive(time)) {
+  const auto activeTerms = this->getActiveTerms(time);
+  for (size_t k = 0; k < this->terms_.size(); k++) {
+    if (activeTerms[k]) {
+      const auto& constraintTerm = this->terms_[k];
       auto constraintTermApproximation = constraintTerm->getQuadraticApproximation(time, state, preComp);
       const size_t nc = constraintTermApproximation.f.rows();
       quadraticApproximation.f.segment(i, nc) = constraintTermApproximation.f;
@@ -51,8 +51,10 @@ size_t StateInputConstraintCollection::getNumConstraints(scalar_t time) const {
   size_t numConstraints = 0;
 
   // accumulate number of constraints for each constraintTerm
-  for (const auto& constraintTerm : this->terms_) {
-    if (constraintTerm->isActive(time)) {
+  const auto activeTerms = this->getActiveTerms(time);
+  for (size_t i = 0; i < this->terms_.size(); i++) {
+    if (activeTerms[i]) {
+      const auto& constraintTerm = this->terms_[i];
       numConstraints += constraintTerm->getNumConstraints(time);
     }
   }
@@ -70,8 +72,10 @@ vector_t StateInputConstraintCollection::getValue(scalar_t time, const vector_t&
 
   // append vectors of constraint values from each constraintTerm
   size_t i = 0;
-  for (const auto& constraintTerm : this->terms_) {
-    if (constraintTerm->isActive(time)) {
+  const auto activeTerms = this->getActiveTerms(time);
+  for (size_t k = 0; k < this->terms_.size(); k++) {
+    if (activeTerms[k]) {
+      const auto& constraintTerm = this->terms_[k];
       const auto constraintTermValues = constraintTerm->getValue(time, state, input, preComp);
       constraintValues.segment(i, constraintTermValues.rows()) = constraintTermValues;
       i += constraintTermValues.rows();
@@ -89,16 +93,14 @@ VectorFunctionLinearApproximation StateInputConstraintCollection::getLinearAppro
                                                                                          const PreComputation& preComp) const {
   VectorFunctionLinearApproximation linearApproximation(getNumConstraints(time), state.rows(), input.rows());
 
-  // append linearApproximation of each constraintTerm
+  // write linearApproximation of each constraintTerm into its row block
   size_t i = 0;
-  for (const auto& constraintTerm : this->terms_) {
-    if (constraintTerm->isActive(time)) {
-      const auto constraintTermApproximation = constraintTerm->getLinearApproximation(time, state, input, preComp);
-      const size_t nc = constraintTermApproximation.f.rows();
-      linearApproximation.f.segment(i, nc) = constraintTermApproximation.f;
-      linearApproximation.dfdx.middleRows(i, nc) = constraintTermApproximation.dfdx;
-      linearApproximation.dfdu.middleRows(i, nc) = constraintTermApproximation.dfdu;
-      i += nc;
+  const auto activeTerms = this->getActiveTerms(time);
+  for (size_t k = 0; k < this->terms_.size(); k++) {
+    if (activeTerms[k]) {
+      const auto& constraintTerm = this->terms_[k];
+      constraintTerm->writeLinearApproximation(time, state, input, preComp, i, linearApproximation);
+      i += constraintTerm->getNumConstraints(time);
     }
   }
 
@@ -123,8 +125,10 @@ VectorFunctionQuadraticApproximation StateInputConstraintCollection::getQuadrati
 
   // append quadraticApproximation of each constraintTerm
   size_t i = 0;
-  for (const auto& constraintTerm : this->terms_) {
-    if (constraintTerm->isActive(time)) {
+  const auto activeTerms = this->getActiveTerms(time);
+  for (size_t k = 0; k < this->terms_.size(); k++) {
+    if (activeTerms[k]) {
+      const auto& constraintTerm = this->terms_[k];
       auto constraintTermApproximation = constraintTerm->getQuadraticApproximation(time, state, input, preComp);
       const size_t nc = constraintTermApproximation.f.rows();
       quadraticApproximation.f.segment(i, nc) = constraintTermApproximation.f;
@@ -31,6 +31,24 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace ocs2 {
 
+namespace {
+
+/** Per thread buffers for the evaluation of the taped constraint, such that repeated evaluations do not allocate memory. */
+struct StateInputConstraintWorkspace {
+  vector_t tapedTimeStateInput;
+  matrix_t jacobian;
+};
+
+StateInputConstraintWorkspace& getWorkspace(size_t stateDim, size_t inputDim, size_t numConstraints) {
+  thread_local StateInputConstraintWorkspace workspace;
+  // resizing is a no-op if the dimensions do not change
+  workspace.tapedTimeStateInput.resize(1 + stateDim + inputDim);
+  workspace.jacobian.resize(numConstraints, 1 + stateDim + inputDim);
+  return workspace;
+}
+
+}  // unnamed namespace
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -97,6 +115,25 @@ VectorFunctionLinearApproximation StateInputConstraintCppAd::getLinearApproximat
   return constraint;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void StateInputConstraintCppAd::writeLinearApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                         const PreComputation& preComputation, size_t startRow,
+                                                         VectorFunctionLinearApproximation& stackedApproximation) const {
+  const size_t stateDim = state.rows();
+  const size_t inputDim = input.rows();
+  const size_t numConstraints = getNumConstraints(time);
+  const vector_t params = getParameters(time, preComputation);
+  auto& workspace = getWorkspace(stateDim, inputDim, numConstraints);
+  workspace.tapedTimeStateInput << time, state, input;
+
+  adInterfacePtr_->getFunctionValue(workspace.tapedTimeStateInput, params, stackedApproximation.f.segment(startRow, numConstraints));
+  adInterfacePtr_->getJacobian(workspace.tapedTimeStateInput, params, workspace.jacobian);
+  stackedApproximation.dfdx.middleRows(startRow, numConstraints) = workspace.jacobian.middleCols(1, stateDim);
+  stackedApproximation.dfdu.middleRows(startRow, numConstraints) = workspace.jacobian.rightCols(inputDim);
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -134,4 +171,33 @@ VectorFunctionQuadraticApproximation StateInputConstraintCppAd::getQuadraticAppr
   return constraint;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void StateInputConstraintCppAd::getSparseLinearApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                             const PreComputation& preComputation, vector_t& value,
+                                                             CppAdInterface::sparse_matrix_t& jacobian) const {
+  const vector_t params = getParameters(time, preComputation);
+  vector_t tapedTimeStateInput(1 + state.rows() + input.rows());
+  tapedTimeStateInput << time, state, input;
+
+  value = adInterfacePtr_->getFunctionValue(tapedTimeStateInput, params);
+  adInterfacePtr_->getSparseJacobian(tapedTimeStateInput, params, jacobian);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void StateInputConstraintCppAd::getSparseWeightedHessian(scalar_t time, const vector_t& state, const vector_t& input,
+                                                         const PreComputation& preComputation, const vector_t& multipliers,
+                                                         CppAdInterface::sparse_matrix_t& hessian) const {
+  if (getOrder() != ConstraintOrder::Quadratic) {
+    throw std::runtime_error("[StateInputConstraintCppAd] Quadratic approximation not supported!");
+  }
+
+  vector_t tapedTimeStateInput(1 + state.rows() + input.rows());
+  tapedTimeStateInput << time, state, input;
+  adInterfacePtr_->getSparseHessian(multipliers, tapedTimeStateInput, getParameters(time, preComputation), hessian);
+}
+
 }  // namespace ocs2
@@ -87,7 +87,9 @@ void FeedforwardController::setController(const scalar_array_t& controllerTime,
 /******************************************************************************************************/
 /******************************************************************************************************/
 vector_t FeedforwardController::computeInput(scalar_t t, const vector_t& x) {
-  return LinearInterpolation::interpolate(t, timeStamp_, uffArray_);
+  // the rollouts query the input at increasing times, therefore the cursor makes the lookup O(1)
+  const auto indexAlpha = LinearInterpolation::timeSegment(t, timeStamp_, timeSegmentCursor_);
+  return LinearInterpolation::interpolate(indexAlpha, uffArray_);
 }
 
 /******************************************************************************************************/
@@ -101,15 +103,28 @@ void FeedforwardController::flatten(const scalar_array_t& timeArray, const std::
     throw std::runtime_error("timeSize and dataSize must be equal in flatten method.");
   }
 
+  int cursor = 0;
   for (size_t i = 0; i < timeSize; i++) {
-    flattenSingle(timeArray[i], *(flatArray2[i]));
+    flatArray2[i]->clear();
+    flattenSingle(LinearInterpolation::timeSegment(timeArray[i], timeStamp_, cursor), *(flatArray2[i]));
   }
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-void FeedforwardController::flattenSingle(scalar_t time, std::vector<float>& flatArray) const {
+void FeedforwardController::flatten(const scalar_array_t& timeArray, std::vector<float>& flatData) const {
+  flatData.clear();
+  int cursor = 0;
+  for (const auto& time : timeArray) {
+    flattenSingle(LinearInterpolation::timeSegment(time, timeStamp_, cursor), flatData);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void FeedforwardController::flattenSingle(LinearInterpolation::index_alpha_t indexAlpha, std::vector<float>& flatData) const {
   /* Serialized feedforward controller:
    * data = [
    *   [ uff(t0)[:] ],
@@ -119,9 +134,11 @@ void FeedforwardController::flattenSingle(scalar_t time, std::vector<float>& fla
    * ]
    */
 
-  const vector_t uff = LinearInterpolation::interpolate(time, timeStamp_, uffArray_);
+  const vector_t uff = LinearInterpolation::interpolate(indexAlpha, uffArray_);
 
-  flatArray = std::vector<float>(uff.data(), uff.data() + uff.rows());
+  const size_t offset = flatData.size();
+  flatData.resize(offset + uff.size());
+  Eigen::Map<Eigen::VectorXf>(flatData.data() + offset, uff.size()) = uff.cast<float>();
 }
 
 /******************************************************************************************************/
@@ -138,6 +155,28 @@ FeedforwardController FeedforwardController::unFlatten(const scalar_array_t& tim
   return FeedforwardController(timeArray, std::move(uffArray));
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+FeedforwardController FeedforwardController::unFlatten(const size_array_t& inputDim, const scalar_array_t& timeArray,
+                                                       const std::vector<float>& flatData) {
+  vector_array_t uffArray;
+  uffArray.reserve(timeArray.size());
+
+  size_t offset = 0;
+  for (int k = 0; k < timeArray.size(); k++) {  // loop through time
+    if (offset + inputDim[k] > flatData.size()) {
+      throw std::runtime_error("FeedforwardController::unFlatten received array of wrong length.");
+    }
+    uffArray.emplace_back(Eigen::Map<const Eigen::VectorXf>(flatData.data() + offset, inputDim[k]).cast<scalar_t>());
+    offset += inputDim[k];
+  }
+  if (offset != flatData.size()) {
+    throw std::runtime_error("FeedforwardController::unFlatten received array of wrong length.");
+  }
+  return FeedforwardController(timeArray, std::move(uffArray));
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
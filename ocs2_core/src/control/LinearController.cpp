@@ -77,13 +77,49 @@ void LinearController::setController(const scalar_array_t& controllerTime, const
 /******************************************************************************************************/
 /******************************************************************************************************/
 vector_t LinearController::computeInput(scalar_t t, const vector_t& x) {
-  const auto indexAlpha = LinearInterpolation::timeSegment(t, timeStamp_);
+  // the rollouts query the input at increasing times, therefore the cursor makes the lookup O(1)
+  return computeInput(t, x, timeSegmentCursor_);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t LinearController::computeInput(scalar_t t, const vector_t& x, int& cursor) const {
+  const auto nodes = getInterpolationNodes(LinearInterpolation::timeSegment(t, timeStamp_, cursor));
 
-  vector_t uff = LinearInterpolation::interpolate(indexAlpha, biasArray_);
-  const matrix_t k = LinearInterpolation::interpolate(indexAlpha, gainArray_);
+  // u = alpha * (uff_lhs + k_lhs * x) + (1 - alpha) * (uff_rhs + k_rhs * x) avoids building the interpolated gain matrix
+  vector_t u = biasArray_[nodes.lhs];
+  u.noalias() += gainArray_[nodes.lhs] * x;
+  if (nodes.lhs != nodes.rhs) {
+    u *= nodes.alpha;
+    u.noalias() += (scalar_t(1.0) - nodes.alpha) * biasArray_[nodes.rhs];
+    u.noalias() += ((scalar_t(1.0) - nodes.alpha) * gainArray_[nodes.rhs]) * x;
+  }
+  return u;
+}
 
-  uff.noalias() += k * x;
-  return uff;
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+auto LinearController::getInterpolationNodes(LinearInterpolation::index_alpha_t indexAlpha) const -> InterpolationNodes {
+  // same conventions as LinearInterpolation::interpolate
+  if (gainArray_.size() < 2) {
+    return {0, 0, scalar_t(1.0)};
+  }
+  const size_t lhs = indexAlpha.first;
+  const size_t rhs = lhs + 1;
+  const scalar_t alpha = indexAlpha.second;
+  const auto& lhsGain = gainArray_[lhs];
+  const auto& rhsGain = gainArray_[rhs];
+  if (lhsGain.rows() != rhsGain.rows() || lhsGain.cols() != rhsGain.cols()) {
+    return (alpha > 0.5) ? InterpolationNodes{lhs, lhs, scalar_t(1.0)} : InterpolationNodes{rhs, rhs, scalar_t(1.0)};
+  } else if (alpha == scalar_t(1.0)) {
+    return {lhs, lhs, scalar_t(1.0)};
+  } else if (alpha == scalar_t(0.0)) {
+    return {rhs, rhs, scalar_t(1.0)};
+  } else {
+    return {lhs, rhs, alpha};
+  }
 }
 
 /******************************************************************************************************/
@@ -97,15 +133,33 @@ void LinearController::flatten(const scalar_array_t& timeArray, const std::vecto
     throw std::runtime_error("timeSize and dataSize must be equal in flatten method.");
   }
 
+  int cursor = 0;
   for (size_t i = 0; i < timeSize; i++) {
-    flattenSingle(timeArray[i], *(flatArray2[i]));
+    const auto nodes = getInterpolationNodes(LinearInterpolation::timeSegment(timeArray[i], timeStamp_, cursor));
+    auto& flatArray = *(flatArray2[i]);
+    flatArray.resize(gainArray_[nodes.lhs].rows() * (gainArray_[nodes.lhs].cols() + 1));
+    flattenSingle(nodes, flatArray.data());
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LinearController::flatten(const scalar_array_t& timeArray, std::vector<float>& flatData) const {
+  flatData.clear();
+  int cursor = 0;
+  for (const auto& time : timeArray) {
+    const auto nodes = getInterpolationNodes(LinearInterpolation::timeSegment(time, timeStamp_, cursor));
+    const size_t offset = flatData.size();
+    flatData.resize(offset + gainArray_[nodes.lhs].rows() * (gainArray_[nodes.lhs].cols() + 1));
+    flattenSingle(nodes, flatData.data() + offset);
   }
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-void LinearController::flattenSingle(scalar_t time, std::vector<float>& flatArray) const {
+void LinearController::flattenSingle(const InterpolationNodes& nodes, float* flatData) const {
   /* Serialized linear controller:
    * data = [
    *   // t0
@@ -128,24 +182,37 @@ void LinearController::flattenSingle(scalar_t time, std::vector<float>& flatArra
    * ]
    */
 
-  const auto indexAlpha = LinearInterpolation::timeSegment(time, timeStamp_);
-  const vector_t uff = LinearInterpolation::interpolate(indexAlpha, biasArray_);
-  const matrix_t k = LinearInterpolation::interpolate(indexAlpha, gainArray_);
-
-  const size_t stateDim = k.cols();
-  const size_t inputDim = k.rows();
+  const auto& lhsBias = biasArray_[nodes.lhs];
+  const auto& lhsGain = gainArray_[nodes.lhs];
+  const size_t stateDim = lhsGain.cols();
+  const size_t inputDim = lhsGain.rows();
 
-  flatArray.clear();
-  flatArray.resize(uff.size() + k.size());
+  // each row [uff(i), k(i, :)] is written in place, hence the gains are neither interpolated into nor copied from a temporary
+  using row_map_t = Eigen::Map<Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>, 0, Eigen::OuterStride<>>;
+  Eigen::Map<Eigen::VectorXf, 0, Eigen::InnerStride<>> uff(flatData, inputDim, Eigen::InnerStride<>(stateDim + 1));
+  row_map_t k(flatData + 1, inputDim, stateDim, Eigen::OuterStride<>(stateDim + 1));
 
-  for (int i = 0; i < inputDim; i++) {  // i loops through rows of uff and k
-    flatArray[i * (stateDim + 1) + 0] = static_cast<float>(uff(i));
-    for (int j = 0; j < stateDim; j++) {  // j loops through cols of k
-      flatArray[i * (stateDim + 1) + j + 1] = static_cast<float>(k(i, j));
-    }
+  if (nodes.lhs == nodes.rhs) {
+    uff = lhsBias.cast<float>();
+    k = lhsGain.cast<float>();
+  } else {
+    const scalar_t alpha = nodes.alpha;
+    uff = (alpha * lhsBias + (scalar_t(1.0) - alpha) * biasArray_[nodes.rhs]).cast<float>();
+    k = (alpha * lhsGain + (scalar_t(1.0) - alpha) * gainArray_[nodes.rhs]).cast<float>();
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LinearController::unFlattenSingle(size_t stateDim, size_t inputDim, const float* flatData, vector_array_t& bias,
+                                       matrix_array_t& gain) {
+  using const_row_map_t = Eigen::Map<const Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>, 0, Eigen::OuterStride<>>;
+  bias.emplace_back(Eigen::Map<const Eigen::VectorXf, 0, Eigen::InnerStride<>>(flatData, inputDim, Eigen::InnerStride<>(stateDim + 1))
+                        .cast<scalar_t>());
+  gain.emplace_back(const_row_map_t(flatData + 1, inputDim, stateDim, Eigen::OuterStride<>(stateDim + 1)).cast<scalar_t>());
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -161,15 +228,33 @@ LinearController LinearController::unFlatten(const size_array_t& stateDim, const
     if (flatArray2[k]->size() != inputDim[k] + inputDim[k] * stateDim[k]) {
       throw std::runtime_error("LinearController::unFlatten received array of wrong length.");
     }
+    unFlattenSingle(stateDim[k], inputDim[k], flatArray2[k]->data(), bias, gain);
+  }
+  return LinearController(timeArray, std::move(bias), std::move(gain));
+}
 
-    bias.emplace_back(vector_t(inputDim[k]));
-    gain.emplace_back(matrix_t(inputDim[k], stateDim[k]));
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+LinearController LinearController::unFlatten(const size_array_t& stateDim, const size_array_t& inputDim, const scalar_array_t& timeArray,
+                                             const std::vector<float>& flatData) {
+  vector_array_t bias;
+  matrix_array_t gain;
+
+  bias.reserve(timeArray.size());
+  gain.reserve(timeArray.size());
 
-    const auto& arr = *flatArray2[k];
-    for (int i = 0; i < inputDim[k]; i++) {  // loop through input dim
-      bias.back()(i) = static_cast<scalar_t>(arr[i * (stateDim[k] + 1) + 0]);
-      gain.back().row(i) = Eigen::Map<const Eigen::VectorXf>(&(arr[i * (stateDim[k] + 1) + 1]), stateDim[k]).cast<scalar_t>();
+  size_t offset = 0;
+  for (int k = 0; k < timeArray.size(); k++) {  // loop through time
+    const size_t stride = inputDim[k] + inputDim[k] * stateDim[k];
+    if (offset + stride > flatData.size()) {
+      throw std::runtime_error("LinearController::unFlatten received array of wrong length.");
     }
+    unFlattenSingle(stateDim[k], inputDim[k], flatData.data() + offset, bias, gain);
+    offset += stride;
+  }
+  if (offset != flatData.size()) {
+    throw std::runtime_error("LinearController::unFlatten received array of wrong length.");
   }
   return LinearController(timeArray, std::move(bias), std::move(gain));
 }
@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/control/StateBasedLinearController.h>
 
+#include <algorithm>
+
 namespace ocs2 {
 
 /******************************************************************************************************/
@@ -40,6 +42,32 @@ void StateBasedLinearController::setController(ControllerBase* ctrlPtr) {
   }
   ctrlPtr_ = ctrlPtr;
   ctrlEventTimes_ = ctrlPtr->controllerEventTimes();
+  linearCtrlPtr_ = dynamic_cast<const LinearController*>(ctrlPtr);
+  updateModeCursors();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void StateBasedLinearController::updateModeCursors() {
+  modeCursors_.clear();
+  cursor_ = 0;
+  if (linearCtrlPtr_ == nullptr) {
+    return;
+  }
+
+  // same event times as in computeTrajectorySpreadingInput
+  const scalar_t eps = numeric_traits::weakEpsilon<scalar_t>();
+  const auto& timeStamp = linearCtrlPtr_->timeStamp_;
+  const size_t numEvents = ctrlEventTimes_.size();
+  modeCursors_.reserve(numEvents);
+  for (size_t mode = 0; mode < numEvents; mode++) {
+    const scalar_t tauMinus = ctrlEventTimes_[mode];
+    const scalar_t tau = (numEvents > mode + 1) ? ctrlEventTimes_[mode + 1] : ctrlEventTimes_.back();
+    const auto begin = std::lower_bound(timeStamp.begin(), timeStamp.end(), tauMinus + 2.0 * eps) - timeStamp.begin();
+    const auto end = std::lower_bound(timeStamp.begin(), timeStamp.end(), tau - eps) - timeStamp.begin();
+    modeCursors_.push_back({static_cast<int>(begin), static_cast<int>(std::max(begin, end))});
+  }
 }
 
 /******************************************************************************************************/
@@ -82,7 +110,31 @@ vector_t StateBasedLinearController::computeTrajectorySpreadingInput(scalar_t t,
 /******************************************************************************************************/
 /******************************************************************************************************/
 vector_t StateBasedLinearController::computeInput(scalar_t t, const vector_t& x) {
-  return computeTrajectorySpreadingInput(t, x, ctrlEventTimes_, ctrlPtr_);
+  if (linearCtrlPtr_ == nullptr || modeCursors_.empty()) {
+    return computeTrajectorySpreadingInput(t, x, ctrlEventTimes_, ctrlPtr_);
+  }
+
+  // same logic as computeTrajectorySpreadingInput, where the modes past the last event share the range of the last event
+  const size_t currentMode = static_cast<size_t>(x.tail(1).value());
+  const size_t numEvents = ctrlEventTimes_.size();
+  const auto& cursors = modeCursors_[std::min(currentMode, numEvents - 1)];
+  const scalar_t tauMinus = (numEvents > currentMode) ? ctrlEventTimes_[currentMode] : ctrlEventTimes_.back();
+  const scalar_t tau = (numEvents > currentMode + 1) ? ctrlEventTimes_[currentMode + 1] : ctrlEventTimes_.back();
+  const bool pastAllEvents = (currentMode >= numEvents - 1) && (t > tauMinus);
+  const scalar_t eps = numeric_traits::weakEpsilon<scalar_t>();
+
+  if (pastAllEvents) {
+    return linearCtrlPtr_->computeInput(t, x, cursor_);
+  } else if (t < tauMinus) {
+    int cursor = cursors.begin;
+    return linearCtrlPtr_->computeInput(tauMinus + 2.0 * eps, x, cursor);
+  } else if (t > tau) {
+    int cursor = cursors.end;
+    return linearCtrlPtr_->computeInput(tau - eps, x, cursor);
+  }
+  // normal case: the lookup starts within the range of the current mode
+  cursor_ = std::min(std::max(cursor_, cursors.begin), cursors.end);
+  return linearCtrlPtr_->computeInput(t, x, cursor_);
 }
 
 /******************************************************************************************************/
@@ -90,6 +142,7 @@ vector_t StateBasedLinearController::computeInput(scalar_t t, const vector_t& x)
 /******************************************************************************************************/
 void StateBasedLinearController::concatenate(const ControllerBase* nextController, int index, int length) {
   ctrlPtr_->concatenate(nextController, index, length);
+  updateModeCursors();
 }
 
 /******************************************************************************************************/
@@ -111,6 +164,7 @@ ControllerType StateBasedLinearController::getType() const {
 /******************************************************************************************************/
 void StateBasedLinearController::clear() {
   ctrlPtr_->clear();
+  updateModeCursors();
 }
 
 /******************************************************************************************************/
@@ -67,10 +67,45 @@ ScalarFunctionQuadraticApproximation QuadraticStateCost::getQuadraticApproximati
   return Phi;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void QuadraticStateCost::accumulateQuadraticApproximation(scalar_t time, const vector_t& state,
+                                                          const TargetTrajectories& targetTrajectories, const PreComputation&,
+                                                          ScalarFunctionQuadraticApproximation& accumulator) const {
+  const vector_t xDeviation = getStateDeviation(time, state, targetTrajectories);
+
+  accumulator.dfdxx += Q_;
+  accumulator.dfdx.noalias() += Q_ * xDeviation;
+  accumulator.f += 0.5 * xDeviation.dot(Q_ * xDeviation);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void QuadraticStateCost::accumulateConstantHessian(ScalarFunctionQuadraticApproximation& accumulator) const {
+  accumulator.dfdxx += Q_;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void QuadraticStateCost::accumulateValueAndGradient(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
+                                                    const PreComputation&, ScalarFunctionQuadraticApproximation& accumulator) const {
+  const vector_t xDeviation = getStateDeviation(time, state, targetTrajectories);
+  const vector_t QxDeviation = Q_ * xDeviation;
+
+  accumulator.dfdx += QxDeviation;
+  accumulator.f += 0.5 * xDeviation.dot(QxDeviation);
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 vector_t QuadraticStateCost::getStateDeviation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories) const {
+  if (const auto* sampledStatePtr = targetTrajectories.getSampledDesiredState(time)) {
+    return state - *sampledStatePtr;
+  }
   return state - targetTrajectories.getDesiredState(time);
 }
 
@@ -96,11 +96,73 @@ ScalarFunctionQuadraticApproximation QuadraticStateInputCost::getQuadraticApprox
   return L;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void QuadraticStateInputCost::accumulateQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                               const TargetTrajectories& targetTrajectories, const PreComputation&,
+                                                               ScalarFunctionQuadraticApproximation& accumulator) const {
+  vector_t stateDeviation, inputDeviation;
+  std::tie(stateDeviation, inputDeviation) = getStateInputDeviation(time, state, input, targetTrajectories);
+
+  accumulator.dfdxx += Q_;
+  accumulator.dfduu += R_;
+  accumulator.dfdx.noalias() += Q_ * stateDeviation;
+  accumulator.dfdu.noalias() += R_ * inputDeviation;
+  accumulator.f += 0.5 * stateDeviation.dot(Q_ * stateDeviation) + 0.5 * inputDeviation.dot(R_ * inputDeviation);
+
+  if (P_.size() > 0) {
+    accumulator.f += inputDeviation.dot(P_ * stateDeviation);
+    accumulator.dfdu.noalias() += P_ * stateDeviation;
+    accumulator.dfdx.noalias() += P_.transpose() * inputDeviation;
+    accumulator.dfdux += P_;
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void QuadraticStateInputCost::accumulateConstantHessian(ScalarFunctionQuadraticApproximation& accumulator) const {
+  accumulator.dfdxx += Q_;
+  accumulator.dfduu += R_;
+  if (P_.size() > 0) {
+    accumulator.dfdux += P_;
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void QuadraticStateInputCost::accumulateValueAndGradient(scalar_t time, const vector_t& state, const vector_t& input,
+                                                         const TargetTrajectories& targetTrajectories, const PreComputation&,
+                                                         ScalarFunctionQuadraticApproximation& accumulator) const {
+  vector_t stateDeviation, inputDeviation;
+  std::tie(stateDeviation, inputDeviation) = getStateInputDeviation(time, state, input, targetTrajectories);
+
+  const vector_t QxDeviation = Q_ * stateDeviation;
+  const vector_t RuDeviation = R_ * inputDeviation;
+  accumulator.dfdx += QxDeviation;
+  accumulator.dfdu += RuDeviation;
+  accumulator.f += 0.5 * stateDeviation.dot(QxDeviation) + 0.5 * inputDeviation.dot(RuDeviation);
+
+  if (P_.size() > 0) {
+    const vector_t PxDeviation = P_ * stateDeviation;
+    accumulator.f += inputDeviation.dot(PxDeviation);
+    accumulator.dfdu += PxDeviation;
+    accumulator.dfdx.noalias() += P_.transpose() * inputDeviation;
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 std::pair<vector_t, vector_t> QuadraticStateInputCost::getStateInputDeviation(scalar_t time, const vector_t& state, const vector_t& input,
                                                                               const TargetTrajectories& targetTrajectories) const {
+  const auto* sampledStatePtr = targetTrajectories.getSampledDesiredState(time);
+  const auto* sampledInputPtr = targetTrajectories.getSampledDesiredInput(time);
+  if (sampledStatePtr != nullptr && sampledInputPtr != nullptr) {
+    return {state - *sampledStatePtr, input - *sampledInputPtr};
+  }
   const vector_t stateDeviation = state - targetTrajectories.getDesiredState(time);
   const vector_t inputDeviation = input - targetTrajectories.getDesiredInput(time);
   return {stateDeviation, inputDeviation};
@@ -29,6 +29,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/cost/StateCostCollection.h>
 
+#include <algorithm>
+#include <typeinfo>
+
 namespace ocs2 {
 
 /******************************************************************************************************/
@@ -36,6 +39,18 @@ namespace ocs2 {
 /******************************************************************************************************/
 StateCostCollection::StateCostCollection(const StateCostCollection& other) : Collection<StateCost>(other) {}
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+StateCostCollection::~StateCostCollection() {
+  auto* entry = constantHessians_.load(std::memory_order_relaxed);
+  while (entry != nullptr) {
+    auto* next = entry->next;
+    delete entry;
+    entry = next;
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -43,6 +58,14 @@ StateCostCollection* StateCostCollection::clone() const {
   return new StateCostCollection(*this);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool StateCostCollection::isHessianConstant() const {
+  return std::all_of(this->terms_.begin(), this->terms_.end(),
+                     [](const std::unique_ptr<StateCost>& term) { return term->isHessianConstant(); });
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -51,8 +74,10 @@ scalar_t StateCostCollection::getValue(scalar_t time, const vector_t& state, con
   scalar_t cost = 0.0;
 
   // accumulate cost terms
-  for (const auto& costTerm : this->terms_) {
-    if (costTerm->isActive(time)) {
+  const auto activeTerms = this->getActiveTerms(time);
+  for (size_t i = 0; i < this->terms_.size(); i++) {
+    if (activeTerms[i]) {
+      const auto& costTerm = this->terms_[i];
       cost += costTerm->getValue(time, state, targetTrajectories, preComp);
     }
   }
@@ -66,31 +91,86 @@ scalar_t StateCostCollection::getValue(scalar_t time, const vector_t& state, con
 ScalarFunctionQuadraticApproximation StateCostCollection::getQuadraticApproximation(scalar_t time, const vector_t& state,
                                                                                     const TargetTrajectories& targetTrajectories,
                                                                                     const PreComputation& preComp) const {
-  const auto firstActive =
-      std::find_if(terms_.begin(), terms_.end(), [time](const std::unique_ptr<StateCost>& costTerm) { return costTerm->isActive(time); });
+  auto cost = ScalarFunctionQuadraticApproximation::Zero(state.rows());
+  accumulateTermsQuadraticApproximation(time, state, targetTrajectories, preComp, cost);
+  return cost;
+}
 
-  // No active terms (or terms is empty).
-  if (firstActive == terms_.end()) {
-    return ScalarFunctionQuadraticApproximation::Zero(state.rows());
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void StateCostCollection::accumulateQuadraticApproximation(scalar_t time, const vector_t& state,
+                                                           const TargetTrajectories& targetTrajectories, const PreComputation& preComp,
+                                                           ScalarFunctionQuadraticApproximation& accumulator) const {
+  // a derived class may only override getQuadraticApproximation(), hence only the terms of this class are accumulated in place
+  if (typeid(*this) == typeid(StateCostCollection)) {
+    accumulateTermsQuadraticApproximation(time, state, targetTrajectories, preComp, accumulator);
+  } else {
+    const auto cost = getQuadraticApproximation(time, state, targetTrajectories, preComp);
+    accumulator.f += cost.f;
+    accumulator.dfdx += cost.dfdx;
+    accumulator.dfdxx += cost.dfdxx;
   }
+}
 
-  // Initialize with first active term, accumulate potentially other active terms.
-  auto cost = (*firstActive)->getQuadraticApproximation(time, state, targetTrajectories, preComp);
-  std::for_each(std::next(firstActive), terms_.end(), [&](const std::unique_ptr<StateCost>& costTerm) {
-    if (costTerm->isActive(time)) {
-      const auto costTermApproximation = costTerm->getQuadraticApproximation(time, state, targetTrajectories, preComp);
-      cost.f += costTermApproximation.f;
-      cost.dfdx += costTermApproximation.dfdx;
-      cost.dfdxx += costTermApproximation.dfdxx;
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void StateCostCollection::accumulateTermsQuadraticApproximation(scalar_t time, const vector_t& state,
+                                                                const TargetTrajectories& targetTrajectories, const PreComputation& preComp,
+                                                                ScalarFunctionQuadraticApproximation& cost) const {
+  // accumulate cost terms in place. The terms with a constant Hessian only add their values and gradients.
+  static thread_local std::vector<bool> activeConstantHessianTerms;
+  activeConstantHessianTerms.assign(this->terms_.size(), false);
+  bool hasConstantHessianTerms = false;
+  const auto activeTerms = this->getActiveTerms(time);
+  for (size_t i = 0; i < this->terms_.size(); i++) {
+    if (activeTerms[i]) {
+      const auto& costTerm = this->terms_[i];
+      if (costTerm->isHessianConstant()) {
+        costTerm->accumulateValueAndGradient(time, state, targetTrajectories, preComp, cost);
+        activeConstantHessianTerms[i] = true;
+        hasConstantHessianTerms = true;
+      } else {
+        costTerm->accumulateQuadraticApproximation(time, state, targetTrajectories, preComp, cost);
+      }
     }
-  });
+  }
 
-  // Make sure that input derivatives are empty
-  cost.dfdu = vector_t();
-  cost.dfduu = matrix_t();
-  cost.dfdux = matrix_t();
+  if (hasConstantHessianTerms) {
+    const auto& constantHessian = getConstantHessian(activeConstantHessianTerms, state.rows());
+    cost.dfdxx += constantHessian.dfdxx;
+  }
+}
 
-  return cost;
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+const ScalarFunctionQuadraticApproximation& StateCostCollection::getConstantHessian(const std::vector<bool>& activeTerms,
+                                                                                    size_t stateDim) const {
+  const size_t revision = this->getRevision();
+  for (auto* entry = constantHessians_.load(std::memory_order_acquire); entry != nullptr; entry = entry->next) {
+    if (entry->revision == revision && entry->activeTerms == activeTerms &&
+        entry->hessian.dfdxx.rows() == static_cast<Eigen::Index>(stateDim)) {
+      return entry->hessian;
+    }
+  }
+
+  // concurrent misses may add the same sum twice, which is harmless
+  auto* entry = new ConstantHessian;
+  entry->revision = revision;
+  entry->activeTerms = activeTerms;
+  entry->hessian = ScalarFunctionQuadraticApproximation::Zero(stateDim);
+  for (size_t i = 0; i < this->terms_.size(); i++) {
+    if (activeTerms[i]) {
+      this->terms_[i]->accumulateConstantHessian(entry->hessian);
+    }
+  }
+  entry->next = constantHessians_.load(std::memory_order_relaxed);
+  while (!constantHessians_.compare_exchange_weak(entry->next, entry, std::memory_order_release, std::memory_order_relaxed)) {
+    // entry->next has been updated to the current head, retry
+  }
+  return entry->hessian;
 }
 
 }  // namespace ocs2
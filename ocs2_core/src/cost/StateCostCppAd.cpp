@@ -31,6 +31,28 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace ocs2 {
 
+namespace {
+
+/** Per thread buffers for the evaluation of the taped cost, such that repeated evaluations do not allocate memory. */
+struct StateCostWorkspace {
+  vector_t tapedTimeState;
+  vector_t value;
+  matrix_t jacobian;
+  matrix_t hessian;
+};
+
+StateCostWorkspace& getWorkspace(size_t stateDim) {
+  thread_local StateCostWorkspace workspace;
+  // resizing is a no-op if the dimensions do not change
+  workspace.tapedTimeState.resize(1 + stateDim);
+  workspace.value.resize(1);
+  workspace.jacobian.resize(1, 1 + stateDim);
+  workspace.hessian.resize(1 + stateDim, 1 + stateDim);
+  return workspace;
+}
+
+}  // unnamed namespace
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -63,9 +85,10 @@ StateCostCppAd::StateCostCppAd(const StateCostCppAd& rhs)
 /******************************************************************************************************/
 scalar_t StateCostCppAd::getValue(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
                                   const PreComputation& preComputation) const {
-  vector_t tapedTimeState(1 + state.rows());
-  tapedTimeState << time, state;
-  return adInterfacePtr_->getFunctionValue(tapedTimeState, getParameters(time, targetTrajectories, preComputation))(0);
+  auto& workspace = getWorkspace(state.rows());
+  workspace.tapedTimeState << time, state;
+  adInterfacePtr_->getFunctionValue(workspace.tapedTimeState, getParameters(time, targetTrajectories, preComputation), workspace.value);
+  return workspace.value(0);
 }
 
 /******************************************************************************************************/
@@ -78,18 +101,42 @@ ScalarFunctionQuadraticApproximation StateCostCppAd::getQuadraticApproximation(s
 
   const size_t stateDim = state.rows();
   const vector_t params = getParameters(time, targetTrajectories, preComputation);
-  vector_t tapedTimeState(1 + stateDim);
-  tapedTimeState << time, state;
+  auto& workspace = getWorkspace(stateDim);
+  workspace.tapedTimeState << time, state;
 
-  cost.f = adInterfacePtr_->getFunctionValue(tapedTimeState, params)(0);
+  adInterfacePtr_->getFunctionValue(workspace.tapedTimeState, params, workspace.value);
+  cost.f = workspace.value(0);
 
-  const matrix_t J = adInterfacePtr_->getJacobian(tapedTimeState, params);
-  cost.dfdx = J.rightCols(stateDim).transpose();
+  adInterfacePtr_->getJacobian(workspace.tapedTimeState, params, workspace.jacobian);
+  cost.dfdx = workspace.jacobian.rightCols(stateDim).transpose();
 
-  const matrix_t H = adInterfacePtr_->getHessian(0, tapedTimeState, params);
-  cost.dfdxx = H.bottomRightCorner(stateDim, stateDim);
+  workspace.value(0) = 1.0;  // weight of the cost in the Hessian
+  adInterfacePtr_->getHessian(workspace.value, workspace.tapedTimeState, params, workspace.hessian);
+  cost.dfdxx = workspace.hessian.bottomRightCorner(stateDim, stateDim);
 
   return cost;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void StateCostCppAd::accumulateQuadraticApproximation(scalar_t time, const vector_t& state,
+                                                      const TargetTrajectories& targetTrajectories, const PreComputation& preComputation,
+                                                      ScalarFunctionQuadraticApproximation& accumulator) const {
+  const size_t stateDim = state.rows();
+  const vector_t params = getParameters(time, targetTrajectories, preComputation);
+  auto& workspace = getWorkspace(stateDim);
+  workspace.tapedTimeState << time, state;
+
+  adInterfacePtr_->getFunctionValue(workspace.tapedTimeState, params, workspace.value);
+  accumulator.f += workspace.value(0);
+
+  adInterfacePtr_->getJacobian(workspace.tapedTimeState, params, workspace.jacobian);
+  accumulator.dfdx += workspace.jacobian.rightCols(stateDim).transpose();
+
+  workspace.value(0) = 1.0;  // weight of the cost in the Hessian
+  adInterfacePtr_->getHessian(workspace.value, workspace.tapedTimeState, params, workspace.hessian);
+  accumulator.dfdxx += workspace.hessian.bottomRightCorner(stateDim, stateDim);
+}
+
 }  // namespace ocs2
@@ -29,6 +29,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/cost/StateInputCostCollection.h>
 
+#include <algorithm>
+#include <typeinfo>
+
 namespace ocs2 {
 
 /******************************************************************************************************/
@@ -36,6 +39,18 @@ namespace ocs2 {
 /******************************************************************************************************/
 StateInputCostCollection::StateInputCostCollection(const StateInputCostCollection& other) : Collection<StateInputCost>(other) {}
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+StateInputCostCollection::~StateInputCostCollection() {
+  auto* entry = constantHessians_.load(std::memory_order_relaxed);
+  while (entry != nullptr) {
+    auto* next = entry->next;
+    delete entry;
+    entry = next;
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -43,6 +58,14 @@ StateInputCostCollection* StateInputCostCollection::clone() const {
   return new StateInputCostCollection(*this);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool StateInputCostCollection::isHessianConstant() const {
+  return std::all_of(this->terms_.begin(), this->terms_.end(),
+                     [](const std::unique_ptr<StateInputCost>& term) { return term->isHessianConstant(); });
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -51,8 +74,10 @@ scalar_t StateInputCostCollection::getValue(scalar_t time, const vector_t& state
   scalar_t cost = 0.0;
 
   // accumulate cost terms
-  for (const auto& costTerm : this->terms_) {
-    if (costTerm->isActive(time)) {
+  const auto activeTerms = this->getActiveTerms(time);
+  for (size_t i = 0; i < this->terms_.size(); i++) {
+    if (activeTerms[i]) {
+      const auto& costTerm = this->terms_[i];
       cost += costTerm->getValue(time, state, input, targetTrajectories, preComp);
     }
   }
@@ -67,23 +92,87 @@ ScalarFunctionQuadraticApproximation StateInputCostCollection::getQuadraticAppro
                                                                                          const vector_t& input,
                                                                                          const TargetTrajectories& targetTrajectories,
                                                                                          const PreComputation& preComp) const {
-  const auto firstActive = std::find_if(terms_.begin(), terms_.end(),
-                                        [time](const std::unique_ptr<StateInputCost>& costTerm) { return costTerm->isActive(time); });
+  auto cost = ScalarFunctionQuadraticApproximation::Zero(state.rows(), input.rows());
+  accumulateTermsQuadraticApproximation(time, state, input, targetTrajectories, preComp, cost);
+  return cost;
+}
 
-  // No active terms (or terms is empty).
-  if (firstActive == terms_.end()) {
-    return ScalarFunctionQuadraticApproximation::Zero(state.rows(), input.rows());
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void StateInputCostCollection::accumulateQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                                const TargetTrajectories& targetTrajectories, const PreComputation& preComp,
+                                                                ScalarFunctionQuadraticApproximation& accumulator) const {
+  // a derived class may only override getQuadraticApproximation(), hence only the terms of this class are accumulated in place
+  if (typeid(*this) == typeid(StateInputCostCollection)) {
+    accumulateTermsQuadraticApproximation(time, state, input, targetTrajectories, preComp, accumulator);
+  } else {
+    accumulator += getQuadraticApproximation(time, state, input, targetTrajectories, preComp);
   }
+}
 
-  // Initialize with first active term, accumulate potentially other active terms.
-  auto cost = (*firstActive)->getQuadraticApproximation(time, state, input, targetTrajectories, preComp);
-  std::for_each(std::next(firstActive), terms_.end(), [&](const std::unique_ptr<StateInputCost>& costTerm) {
-    if (costTerm->isActive(time)) {
-      cost += costTerm->getQuadraticApproximation(time, state, input, targetTrajectories, preComp);
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void StateInputCostCollection::accumulateTermsQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                                     const TargetTrajectories& targetTrajectories,
+                                                                     const PreComputation& preComp,
+                                                                     ScalarFunctionQuadraticApproximation& cost) const {
+  // accumulate cost terms in place. The terms with a constant Hessian only add their values and gradients.
+  static thread_local std::vector<bool> activeConstantHessianTerms;
+  activeConstantHessianTerms.assign(this->terms_.size(), false);
+  bool hasConstantHessianTerms = false;
+  const auto activeTerms = this->getActiveTerms(time);
+  for (size_t i = 0; i < this->terms_.size(); i++) {
+    if (activeTerms[i]) {
+      const auto& costTerm = this->terms_[i];
+      if (costTerm->isHessianConstant()) {
+        costTerm->accumulateValueAndGradient(time, state, input, targetTrajectories, preComp, cost);
+        activeConstantHessianTerms[i] = true;
+        hasConstantHessianTerms = true;
+      } else {
+        costTerm->accumulateQuadraticApproximation(time, state, input, targetTrajectories, preComp, cost);
+      }
     }
-  });
+  }
 
-  return cost;
+  if (hasConstantHessianTerms) {
+    const auto& constantHessian = getConstantHessian(activeConstantHessianTerms, state.rows(), input.rows());
+    cost.dfdxx += constantHessian.dfdxx;
+    cost.dfdux += constantHessian.dfdux;
+    cost.dfduu += constantHessian.dfduu;
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+const ScalarFunctionQuadraticApproximation& StateInputCostCollection::getConstantHessian(const std::vector<bool>& activeTerms,
+                                                                                         size_t stateDim, size_t inputDim) const {
+  const size_t revision = this->getRevision();
+  for (auto* entry = constantHessians_.load(std::memory_order_acquire); entry != nullptr; entry = entry->next) {
+    if (entry->revision == revision && entry->activeTerms == activeTerms &&
+        entry->hessian.dfdxx.rows() == static_cast<Eigen::Index>(stateDim) &&
+        entry->hessian.dfduu.rows() == static_cast<Eigen::Index>(inputDim)) {
+      return entry->hessian;
+    }
+  }
+
+  // concurrent misses may add the same sum twice, which is harmless
+  auto* entry = new ConstantHessian;
+  entry->revision = revision;
+  entry->activeTerms = activeTerms;
+  entry->hessian = ScalarFunctionQuadraticApproximation::Zero(stateDim, inputDim);
+  for (size_t i = 0; i < this->terms_.size(); i++) {
+    if (activeTerms[i]) {
+      this->terms_[i]->accumulateConstantHessian(entry->hessian);
+    }
+  }
+  entry->next = constantHessians_.load(std::memory_order_relaxed);
+  while (!constantHessians_.compare_exchange_weak(entry->next, entry, std::memory_order_release, std::memory_order_relaxed)) {
+    // entry->next has been updated to the current head, retry
+  }
+  return entry->hessian;
 }
 
 }  // namespace ocs2
@@ -31,6 +31,29 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace ocs2 {
 
+namespace {
+
+/** Per thread buffers for the evaluation of the taped cost, such that repeated evaluations do not allocate memory. */
+struct StateInputCostWorkspace {
+  vector_t tapedTimeStateInput;
+  vector_t value;
+  matrix_t jacobian;
+  matrix_t hessian;
+};
+
+StateInputCostWorkspace& getWorkspace(size_t stateDim, size_t inputDim) {
+  thread_local StateInputCostWorkspace workspace;
+  // resizing is a no-op if the dimensions do not change
+  const size_t tapedDim = 1 + stateDim + inputDim;
+  workspace.tapedTimeStateInput.resize(tapedDim);
+  workspace.value.resize(1);
+  workspace.jacobian.resize(1, tapedDim);
+  workspace.hessian.resize(tapedDim, tapedDim);
+  return workspace;
+}
+
+}  // unnamed namespace
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -98,4 +121,47 @@ ScalarFunctionQuadraticApproximation StateInputCostCppAd::getQuadraticApproximat
   return cost;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void StateInputCostCppAd::accumulateQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                           const TargetTrajectories& targetTrajectories,
+                                                           const PreComputation& preComputation,
+                                                           ScalarFunctionQuadraticApproximation& accumulator) const {
+  const size_t stateDim = state.rows();
+  const size_t inputDim = input.rows();
+  const vector_t params = getParameters(time, targetTrajectories, preComputation);
+  auto& workspace = getWorkspace(stateDim, inputDim);
+  workspace.tapedTimeStateInput << time, state, input;
+
+  adInterfacePtr_->getFunctionValue(workspace.tapedTimeStateInput, params, workspace.value);
+  accumulator.f += workspace.value(0);
+
+  adInterfacePtr_->getJacobian(workspace.tapedTimeStateInput, params, workspace.jacobian);
+  accumulator.dfdx += workspace.jacobian.middleCols(1, stateDim).transpose();
+  accumulator.dfdu += workspace.jacobian.rightCols(inputDim).transpose();
+
+  workspace.value(0) = 1.0;  // weight of the cost in the Hessian
+  adInterfacePtr_->getHessian(workspace.value, workspace.tapedTimeStateInput, params, workspace.hessian);
+  accumulator.dfdxx += workspace.hessian.block(1, 1, stateDim, stateDim);
+  accumulator.dfdux += workspace.hessian.block(1 + stateDim, 1, inputDim, stateDim);
+  accumulator.dfduu += workspace.hessian.bottomRightCorner(inputDim, inputDim);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void StateInputCostCppAd::getSparseQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                          const TargetTrajectories& targetTrajectories, const PreComputation& preComputation,
+                                                          scalar_t& value, CppAdInterface::sparse_matrix_t& gradient,
+                                                          CppAdInterface::sparse_matrix_t& hessian) const {
+  const vector_t params = getParameters(time, targetTrajectories, preComputation);
+  vector_t tapedTimeStateInput(1 + state.rows() + input.rows());
+  tapedTimeStateInput << time, state, input;
+
+  value = adInterfacePtr_->getFunctionValue(tapedTimeStateInput, params)(0);
+  adInterfacePtr_->getSparseJacobian(tapedTimeStateInput, params, gradient);
+  adInterfacePtr_->getSparseHessian(vector_t::Ones(1), tapedTimeStateInput, params, hessian);
+}
+
 }  // namespace ocs2
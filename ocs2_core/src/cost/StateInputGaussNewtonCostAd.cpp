@@ -31,6 +31,32 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace ocs2 {
 
+namespace {
+
+/** Per thread buffers for the evaluation of the cost vector, such that repeated evaluations do not allocate memory. */
+struct GaussNewtonWorkspace {
+  vector_t timeStateInput;
+  matrix_t jacobian;
+};
+
+GaussNewtonWorkspace& getWorkspace(size_t stateDim, size_t inputDim, size_t numResiduals) {
+  thread_local GaussNewtonWorkspace workspace;
+  // resizing is a no-op if the dimensions do not change
+  workspace.timeStateInput.resize(1 + stateDim + inputDim);
+  workspace.jacobian.resize(numResiduals, 1 + stateDim + inputDim);
+  return workspace;
+}
+
+/** Sets hessian = jacobian' * jacobian with a symmetric rank-k update of the lower triangle, then mirrors it to the upper triangle. */
+template <typename Derived>
+void setGaussNewtonHessian(const Eigen::MatrixBase<Derived>& jacobian, matrix_t& hessian) {
+  hessian.setZero(jacobian.cols(), jacobian.cols());
+  hessian.selfadjointView<Eigen::Lower>().rankUpdate(jacobian.transpose());
+  hessian.triangularView<Eigen::StrictlyUpper>() = hessian.triangularView<Eigen::StrictlyLower>().transpose();
+}
+
+}  // unnamed namespace
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -79,19 +105,39 @@ ScalarFunctionQuadraticApproximation StateInputCostGaussNewtonAd::getQuadraticAp
                                                                                             const PreComputation& preComputation) const {
   const auto stateDim = state.rows();
   const auto inputDim = input.rows();
-  vector_t timeStateInput(1 + stateDim + inputDim);
-  timeStateInput << time, state, input;
-  const auto parameters = getParameters(time, targetTrajectories, preComputation);
-  const auto gnApproximation = adInterfacePtr_->getGaussNewtonApproximation(timeStateInput, parameters);
+  const auto residual = getResidualLinearApproximation(time, state, input, targetTrajectories, preComputation);
 
+  // Only the state and input blocks of the Hessian are formed, the symmetric ones with a rank-k update.
   ScalarFunctionQuadraticApproximation L;
-  L.f = gnApproximation.f;
-  L.dfdx.noalias() = gnApproximation.dfdx.middleRows(1, stateDim);
-  L.dfdu.noalias() = gnApproximation.dfdx.bottomRows(inputDim);
-  L.dfdxx = gnApproximation.dfdxx.block(1, 1, stateDim, stateDim);
-  L.dfdux.noalias() = gnApproximation.dfdxx.block(1 + stateDim, 1, inputDim, stateDim);
-  L.dfduu.noalias() = gnApproximation.dfdxx.block(1 + stateDim, 1 + stateDim, inputDim, inputDim);
+  L.f = 0.5 * residual.f.squaredNorm();
+  L.dfdx.noalias() = residual.dfdx.transpose() * residual.f;
+  L.dfdu.noalias() = residual.dfdu.transpose() * residual.f;
+  setGaussNewtonHessian(residual.dfdx, L.dfdxx);
+  L.dfdux.noalias() = residual.dfdu.transpose() * residual.dfdx;
+  setGaussNewtonHessian(residual.dfdu, L.dfduu);
   return L;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+VectorFunctionLinearApproximation StateInputCostGaussNewtonAd::getResidualLinearApproximation(scalar_t time, const vector_t& state,
+                                                                                              const vector_t& input,
+                                                                                              const TargetTrajectories& targetTrajectories,
+                                                                                              const PreComputation& preComputation) const {
+  const auto stateDim = state.rows();
+  const auto inputDim = input.rows();
+  const auto parameters = getParameters(time, targetTrajectories, preComputation);
+
+  VectorFunctionLinearApproximation residual;
+  residual.f.resize(adInterfacePtr_->getRangeDim());
+  auto& workspace = getWorkspace(stateDim, inputDim, residual.f.rows());
+  workspace.timeStateInput << time, state, input;
+  adInterfacePtr_->getFunctionValue(workspace.timeStateInput, parameters, residual.f);
+  adInterfacePtr_->getJacobian(workspace.timeStateInput, parameters, workspace.jacobian);
+  residual.dfdx = workspace.jacobian.middleCols(1, stateDim);
+  residual.dfdu = workspace.jacobian.rightCols(inputDim);
+  return residual;
+}
+
 }  // namespace ocs2
@@ -63,6 +63,16 @@ vector_t ControlledSystemBase::computeFlowMap(scalar_t t, const vector_t& x, con
   return computeFlowMap(t, x, u, *preCompPtr_);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ControlledSystemBase::computeFlowMapBatch(scalar_t t, const matrix_t& xBatch, const matrix_t& uBatch, matrix_t& dxdtBatch) {
+  dxdtBatch.resize(xBatch.rows(), xBatch.cols());
+  for (int k = 0; k < xBatch.cols(); k++) {
+    dxdtBatch.col(k) = computeFlowMap(t, xBatch.col(k), uBatch.col(k));
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
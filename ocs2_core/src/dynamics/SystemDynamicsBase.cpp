@@ -29,6 +29,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/dynamics/SystemDynamicsBase.h>
 
+#include <stdexcept>
+
+#include <ocs2_core/control/LinearController.h>
+
 namespace ocs2 {
 
 /******************************************************************************************************/
@@ -50,6 +54,40 @@ VectorFunctionLinearApproximation SystemDynamicsBase::linearApproximation(scalar
   return linearApproximation(t, x, u, *preCompPtr_);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SystemDynamicsBase::linearApproximationBatch(scalar_t t, const matrix_t& xBatch, const matrix_t& uBatch, matrix_t& fBatch,
+                                                  matrix_t& dfdxBatch, matrix_t& dfduBatch) {
+  const auto stateDim = xBatch.rows();
+  const auto inputDim = uBatch.rows();
+  const auto batchSize = xBatch.cols();
+  fBatch.resize(stateDim, batchSize);
+  dfdxBatch.resize(stateDim, stateDim * batchSize);
+  dfduBatch.resize(stateDim, inputDim * batchSize);
+  for (int k = 0; k < batchSize; k++) {
+    const auto approximation = linearApproximation(t, xBatch.col(k), uBatch.col(k));
+    fBatch.col(k) = approximation.f;
+    dfdxBatch.middleCols(k * stateDim, stateDim) = approximation.dfdx;
+    dfduBatch.middleCols(k * inputDim, inputDim) = approximation.dfdu;
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+matrix_t SystemDynamicsBase::computeFlowMapJacobian(scalar_t t, const vector_t& x) {
+  assert(controllerPtr() != nullptr);
+  const vector_t u = controllerPtr()->computeInput(t, x);
+  auto approximation = linearApproximation(t, x, u);
+  if (const auto* linearControllerPtr = dynamic_cast<const LinearController*>(controllerPtr())) {
+    matrix_t gain;
+    linearControllerPtr->getFeedbackGain(t, gain);
+    approximation.dfdx.noalias() += approximation.dfdu * gain;
+  }
+  return std::move(approximation.dfdx);
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -59,6 +97,16 @@ VectorFunctionLinearApproximation SystemDynamicsBase::jumpMapLinearApproximation
   return jumpMapLinearApproximation(t, x, *preCompPtr_);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ScalarFunctionQuadraticApproximation SystemDynamicsBase::flowMapWeightedHessian(scalar_t t, const vector_t& x, const vector_t& u,
+                                                                              const vector_t& weights) {
+  assert(preCompPtr_ != nullptr);
+  preCompPtr_->request(Request::Dynamics + Request::Approximation, t, x, u);
+  return flowMapWeightedHessian(t, x, u, weights, *preCompPtr_);
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -104,6 +152,14 @@ vector_t SystemDynamicsBase::guardSurfacesDerivativeTime(scalar_t t, const vecto
   return vector_t::Zero(1);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ScalarFunctionQuadraticApproximation SystemDynamicsBase::flowMapWeightedHessian(scalar_t t, const vector_t& x, const vector_t& u,
+                                                                              const vector_t& weights, const PreComputation& preComp) {
+  throw std::runtime_error("[SystemDynamicsBase] The weighted Hessian of the flow map is not implemented for this system.");
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
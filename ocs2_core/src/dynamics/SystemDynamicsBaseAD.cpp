@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/dynamics/SystemDynamicsBaseAD.h>
 
+#include <stdexcept>
+
 namespace ocs2 {
 
 /******************************************************************************************************/
@@ -44,6 +46,7 @@ SystemDynamicsBaseAD::SystemDynamicsBaseAD(const SystemDynamicsBaseAD& rhs)
       flowMapADInterfacePtr_(new CppAdInterface(*rhs.flowMapADInterfacePtr_)),
       jumpMapADInterfacePtr_(new CppAdInterface(*rhs.jumpMapADInterfacePtr_)),
       guardSurfacesADInterfacePtr_(new CppAdInterface(*rhs.guardSurfacesADInterfacePtr_)),
+      hasFlowMapHessian_(rhs.hasFlowMapHessian_),
       tapedTimeStateInput_(rhs.tapedTimeStateInput_.size()),
       tapedTimeState_(rhs.tapedTimeState_.size()),
       flowJacobian_(rhs.flowJacobian_.rows(), rhs.flowJacobian_.cols()),
@@ -54,7 +57,8 @@ SystemDynamicsBaseAD::SystemDynamicsBaseAD(const SystemDynamicsBaseAD& rhs)
 /******************************************************************************************************/
 /******************************************************************************************************/
 void SystemDynamicsBaseAD::initialize(size_t stateDim, size_t inputDim, const std::string& modelName, const std::string& modelFolder,
-                                      bool recompileLibraries, bool verbose) {
+                                      bool recompileLibraries, bool verbose, bool createFlowMapHessian) {
+  hasFlowMapHessian_ = createFlowMapHessian;
   tapedTimeStateInput_.resize(1 + stateDim + inputDim);
   tapedTimeState_.resize(1 + stateDim);
 
@@ -82,14 +86,13 @@ void SystemDynamicsBaseAD::initialize(size_t stateDim, size_t inputDim, const st
   guardSurfacesADInterfacePtr_.reset(
       new CppAdInterface(guardSurfaces, 1 + stateDim, getNumGuardSurfacesParameters(), modelName + "_guard_surfaces", modelFolder));
 
+  const std::vector<CppAdInterface*> interfaces{flowMapADInterfacePtr_.get(), jumpMapADInterfacePtr_.get(),
+                                                guardSurfacesADInterfacePtr_.get()};
+  const auto order = createFlowMapHessian ? CppAdInterface::ApproximationOrder::Second : CppAdInterface::ApproximationOrder::First;
   if (recompileLibraries) {
-    flowMapADInterfacePtr_->createModels(CppAdInterface::ApproximationOrder::First, verbose);
-    jumpMapADInterfacePtr_->createModels(CppAdInterface::ApproximationOrder::First, verbose);
-    guardSurfacesADInterfacePtr_->createModels(CppAdInterface::ApproximationOrder::First, verbose);
+    CppAdInterface::createModelsConcurrently(interfaces, order, verbose);
   } else {
-    flowMapADInterfacePtr_->loadModelsIfAvailable(CppAdInterface::ApproximationOrder::First, verbose);
-    jumpMapADInterfacePtr_->loadModelsIfAvailable(CppAdInterface::ApproximationOrder::First, verbose);
-    guardSurfacesADInterfacePtr_->loadModelsIfAvailable(CppAdInterface::ApproximationOrder::First, verbose);
+    CppAdInterface::loadModelsIfAvailableConcurrently(interfaces, order, verbose);
   }
 }
 
@@ -99,7 +102,28 @@ void SystemDynamicsBaseAD::initialize(size_t stateDim, size_t inputDim, const st
 vector_t SystemDynamicsBaseAD::computeFlowMap(scalar_t t, const vector_t& x, const vector_t& u, const PreComputation& preComputation) {
   tapedTimeStateInput_ << t, x, u;
   const vector_t parameters = getFlowMapParameters(t, preComputation);
-  return flowMapADInterfacePtr_->getFunctionValue(tapedTimeStateInput_, parameters);
+  vector_t flowMap(x.rows());
+  flowMapADInterfacePtr_->getFunctionValue(tapedTimeStateInput_, parameters, flowMap);
+  return flowMap;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SystemDynamicsBaseAD::computeFlowMapBatch(scalar_t t, const matrix_t& xBatch, const matrix_t& uBatch, matrix_t& dxdtBatch) {
+  // the parameters are requested through the pre-computation for each state, which can only be done one by one
+  if (getNumFlowMapParameters() > 0) {
+    SystemDynamicsBase::computeFlowMapBatch(t, xBatch, uBatch, dxdtBatch);
+    return;
+  }
+
+  const auto batchSize = xBatch.cols();
+  tapedTimeStateInputBatch_.resize(1 + xBatch.rows() + uBatch.rows(), batchSize);
+  tapedTimeStateInputBatch_.row(0).setConstant(t);
+  tapedTimeStateInputBatch_.middleRows(1, xBatch.rows()) = xBatch;
+  tapedTimeStateInputBatch_.bottomRows(uBatch.rows()) = uBatch;
+  dxdtBatch.resize(xBatch.rows(), batchSize);
+  flowMapADInterfacePtr_->getFunctionValueBatch(tapedTimeStateInputBatch_, matrix_t(0, batchSize), dxdtBatch);
 }
 
 /*******************q**********************************************************************************/
@@ -108,7 +132,9 @@ vector_t SystemDynamicsBaseAD::computeFlowMap(scalar_t t, const vector_t& x, con
 vector_t SystemDynamicsBaseAD::computeJumpMap(scalar_t t, const vector_t& x, const PreComputation& preComputation) {
   tapedTimeState_ << t, x;
   const vector_t parameters = getJumpMapParameters(t, preComputation);
-  return jumpMapADInterfacePtr_->getFunctionValue(tapedTimeState_, parameters);
+  vector_t jumpMap(x.rows());
+  jumpMapADInterfacePtr_->getFunctionValue(tapedTimeState_, parameters, jumpMap);
+  return jumpMap;
 }
 
 /******************************************************************************************************/
@@ -127,15 +153,51 @@ VectorFunctionLinearApproximation SystemDynamicsBaseAD::linearApproximation(scal
                                                                             const PreComputation& preComputation) {
   tapedTimeStateInput_ << t, x, u;
   const vector_t parameters = getFlowMapParameters(t, preComputation);
-  flowJacobian_ = flowMapADInterfacePtr_->getJacobian(tapedTimeStateInput_, parameters);
+  flowJacobian_.resize(x.rows(), tapedTimeStateInput_.rows());
+  flowMapADInterfacePtr_->getJacobian(tapedTimeStateInput_, parameters, flowJacobian_);
 
   VectorFunctionLinearApproximation approximation;
   approximation.dfdx = flowJacobian_.middleCols(1, x.rows());
   approximation.dfdu = flowJacobian_.rightCols(u.rows());
-  approximation.f = flowMapADInterfacePtr_->getFunctionValue(tapedTimeStateInput_, parameters);
+  approximation.f.resize(x.rows());
+  flowMapADInterfacePtr_->getFunctionValue(tapedTimeStateInput_, parameters, approximation.f);
   return approximation;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SystemDynamicsBaseAD::linearApproximationBatch(scalar_t t, const matrix_t& xBatch, const matrix_t& uBatch, matrix_t& fBatch,
+                                                    matrix_t& dfdxBatch, matrix_t& dfduBatch) {
+  // the parameters are requested through the pre-computation for each state, which can only be done one by one
+  if (getNumFlowMapParameters() > 0) {
+    SystemDynamicsBase::linearApproximationBatch(t, xBatch, uBatch, fBatch, dfdxBatch, dfduBatch);
+    return;
+  }
+
+  const auto stateDim = xBatch.rows();
+  const auto inputDim = uBatch.rows();
+  const auto variableDim = 1 + stateDim + inputDim;
+  const auto batchSize = xBatch.cols();
+  tapedTimeStateInputBatch_.resize(variableDim, batchSize);
+  tapedTimeStateInputBatch_.row(0).setConstant(t);
+  tapedTimeStateInputBatch_.middleRows(1, stateDim) = xBatch;
+  tapedTimeStateInputBatch_.bottomRows(inputDim) = uBatch;
+  const matrix_t parameterBatch(0, batchSize);
+
+  fBatch.resize(stateDim, batchSize);
+  flowMapADInterfacePtr_->getFunctionValueBatch(tapedTimeStateInputBatch_, parameterBatch, fBatch);
+
+  flowJacobianBatch_.resize(stateDim, variableDim * batchSize);
+  flowMapADInterfacePtr_->getJacobianBatch(tapedTimeStateInputBatch_, parameterBatch, flowJacobianBatch_);
+  dfdxBatch.resize(stateDim, stateDim * batchSize);
+  dfduBatch.resize(stateDim, inputDim * batchSize);
+  for (int k = 0; k < batchSize; k++) {
+    dfdxBatch.middleCols(k * stateDim, stateDim) = flowJacobianBatch_.middleCols(k * variableDim + 1, stateDim);
+    dfduBatch.middleCols(k * inputDim, inputDim) = flowJacobianBatch_.middleCols(k * variableDim + 1 + stateDim, inputDim);
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -143,12 +205,14 @@ VectorFunctionLinearApproximation SystemDynamicsBaseAD::jumpMapLinearApproximati
                                                                                    const PreComputation& preComputation) {
   tapedTimeState_ << t, x;
   const vector_t parameters = getJumpMapParameters(t, preComputation);
-  jumpJacobian_ = jumpMapADInterfacePtr_->getJacobian(tapedTimeState_, parameters);
+  jumpJacobian_.resize(x.rows(), tapedTimeState_.rows());
+  jumpMapADInterfacePtr_->getJacobian(tapedTimeState_, parameters, jumpJacobian_);
 
   VectorFunctionLinearApproximation approximation;
   approximation.dfdx = jumpJacobian_.rightCols(x.rows());
   approximation.dfdu.setZero(jumpJacobian_.rows(), 0);
-  approximation.f = jumpMapADInterfacePtr_->getFunctionValue(tapedTimeState_, parameters);
+  approximation.f.resize(x.rows());
+  jumpMapADInterfacePtr_->getFunctionValue(tapedTimeState_, parameters, approximation.f);
   return approximation;
 }
 
@@ -158,12 +222,34 @@ VectorFunctionLinearApproximation SystemDynamicsBaseAD::jumpMapLinearApproximati
 VectorFunctionLinearApproximation SystemDynamicsBaseAD::guardSurfacesLinearApproximation(scalar_t t, const vector_t& x, const vector_t& u) {
   tapedTimeState_ << t, x;
   const vector_t parameters = getGuardSurfacesParameters(t);
-  guardJacobian_ = guardSurfacesADInterfacePtr_->getJacobian(tapedTimeState_, parameters);
 
   VectorFunctionLinearApproximation approximation;
+  approximation.f = guardSurfacesADInterfacePtr_->getFunctionValue(tapedTimeState_, parameters);
+  guardJacobian_.resize(approximation.f.rows(), tapedTimeState_.rows());
+  guardSurfacesADInterfacePtr_->getJacobian(tapedTimeState_, parameters, guardJacobian_);
   approximation.dfdx = guardJacobian_.rightCols(x.rows());
   approximation.dfdu = matrix_t::Zero(guardJacobian_.rows(), u.rows());  // not provided
-  approximation.f = guardSurfacesADInterfacePtr_->getFunctionValue(tapedTimeState_, parameters);
+  return approximation;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ScalarFunctionQuadraticApproximation SystemDynamicsBaseAD::flowMapWeightedHessian(scalar_t t, const vector_t& x, const vector_t& u,
+                                                                                const vector_t& weights,
+                                                                                const PreComputation& preComputation) {
+  if (!hasFlowMapHessian_) {
+    throw std::runtime_error("[SystemDynamicsBaseAD] The flow map Hessian requires initialize() with createFlowMapHessian = true.");
+  }
+  tapedTimeStateInput_ << t, x, u;
+  const vector_t parameters = getFlowMapParameters(t, preComputation);
+  const matrix_t hessian = flowMapADInterfacePtr_->getHessian(weights, tapedTimeStateInput_, parameters);
+
+  // The first variable is time
+  auto approximation = ScalarFunctionQuadraticApproximation::Zero(x.rows(), u.rows());
+  approximation.dfdxx = hessian.block(1, 1, x.rows(), x.rows());
+  approximation.dfdux = hessian.block(1 + x.rows(), 1, u.rows(), x.rows());
+  approximation.dfduu = hessian.bottomRightCorner(u.rows(), u.rows());
   return approximation;
 }
 
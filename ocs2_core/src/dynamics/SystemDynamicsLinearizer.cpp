@@ -41,7 +41,23 @@ SystemDynamicsLinearizer::SystemDynamicsLinearizer(std::unique_ptr<ControlledSys
       controlledSystemPtr_(std::move(nonlinearSystemPtr)),
       doubleSidedDerivative_(doubleSidedDerivative),
       isSecondOrderSystem_(isSecondOrderSystem),
-      eps_(eps) {}
+      eps_(eps),
+      isSparse_(false) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+SystemDynamicsLinearizer::SystemDynamicsLinearizer(std::unique_ptr<ControlledSystemBase> nonlinearSystemPtr,
+                                                   const sparsity_pattern_t& jacobianSparsity, bool doubleSidedDerivative /*= true*/,
+                                                   bool isSecondOrderSystem /*= false*/,
+                                                   scalar_t eps /*= Eigen::NumTraits<scalar_t>::epsilon()*/)
+    : SystemDynamicsBase(nonlinearSystemPtr->getPreComputation()),
+      controlledSystemPtr_(std::move(nonlinearSystemPtr)),
+      doubleSidedDerivative_(doubleSidedDerivative),
+      isSecondOrderSystem_(isSecondOrderSystem),
+      eps_(eps),
+      isSparse_(true),
+      coloring_(jacobianSparsity) {}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -51,7 +67,9 @@ SystemDynamicsLinearizer::SystemDynamicsLinearizer(const SystemDynamicsLinearize
       controlledSystemPtr_(other.controlledSystemPtr_->clone()),
       doubleSidedDerivative_(other.doubleSidedDerivative_),
       isSecondOrderSystem_(other.isSecondOrderSystem_),
-      eps_(other.eps_) {}
+      eps_(other.eps_),
+      isSparse_(other.isSparse_),
+      coloring_(other.coloring_) {}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -75,8 +93,21 @@ VectorFunctionLinearApproximation SystemDynamicsLinearizer::linearApproximation(
                                                                                 const PreComputation& preComp) {
   VectorFunctionLinearApproximation linearDynamics;
   linearDynamics.f = controlledSystemPtr_->computeFlowMap(t, x, u, preComp);
-  linearDynamics.dfdx = finiteDifferenceDerivativeState(*controlledSystemPtr_, t, x, u, eps_, doubleSidedDerivative_, isSecondOrderSystem_);
-  linearDynamics.dfdu = finiteDifferenceDerivativeInput(*controlledSystemPtr_, t, x, u, eps_, doubleSidedDerivative_, isSecondOrderSystem_);
+
+  // The dense coloring is created for the dimensions of the first call
+  if (!isSparse_ && (coloring_.getNumRows() != x.rows() || coloring_.getNumCols() != x.rows() + u.rows())) {
+    coloring_ = FiniteDifferenceColoring(x.rows(), x.rows() + u.rows());
+  }
+  finiteDifferenceDerivativeBatch(*controlledSystemPtr_, t, x, u, coloring_, eps_, doubleSidedDerivative_, linearDynamics.dfdx,
+                                  linearDynamics.dfdu);
+
+  if (isSecondOrderSystem_) {
+    // Assumes state vector = [x, x_dot]
+    const auto halfStateDim = x.rows() / 2;
+    linearDynamics.dfdx.topLeftCorner(halfStateDim, halfStateDim).setZero();
+    linearDynamics.dfdx.topRightCorner(halfStateDim, halfStateDim).setIdentity();
+    linearDynamics.dfdu.topRows(halfStateDim).setZero();
+  }
   return linearDynamics;
 }
 
@@ -29,6 +29,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <unordered_map>
 
 #include <ocs2_core/integration/Integrator.h>
+#include <ocs2_core/integration/Rosenbrock2.h>
 #include <ocs2_core/integration/RungeKuttaDormandPrince5.h>
 #include <ocs2_core/integration/implementation/Integrator.h>
 
@@ -49,7 +50,8 @@ std::string toString(IntegratorType integratorType) {
       {IntegratorType::MODIFIED_MIDPOINT, "MODIFIED_MIDPOINT"},
       {IntegratorType::RK4, "RK4"},
       {IntegratorType::RK5_VARIABLE, "RK5_VARIABLE"},
-      {IntegratorType::ADAMS_BASHFORTH_MOULTON, "ADAMS_BASHFORTH_MOULTON"}};
+      {IntegratorType::ADAMS_BASHFORTH_MOULTON, "ADAMS_BASHFORTH_MOULTON"},
+      {IntegratorType::ROS2, "ROS2"}};
 
   return integratorMap.at(integratorType);
 }
@@ -67,7 +69,8 @@ IntegratorType fromString(const std::string& name) {
       {"MODIFIED_MIDPOINT", IntegratorType::MODIFIED_MIDPOINT},
       {"RK4", IntegratorType::RK4},
       {"RK5_VARIABLE", IntegratorType::RK5_VARIABLE},
-      {"ADAMS_BASHFORTH_MOULTON", IntegratorType::ADAMS_BASHFORTH_MOULTON}};
+      {"ADAMS_BASHFORTH_MOULTON", IntegratorType::ADAMS_BASHFORTH_MOULTON},
+      {"ROS2", IntegratorType::ROS2}};
 
   return integratorMap.at(name);
 }
@@ -95,6 +98,8 @@ std::unique_ptr<IntegratorBase> newIntegrator(IntegratorType integratorType, con
       return std::unique_ptr<IntegratorBase>(new IntegratorRK4(eventHandlerPtr));
     case (IntegratorType::RK5_VARIABLE):
       return std::unique_ptr<IntegratorBase>(new IntegratorRK5Variable(eventHandlerPtr));
+    case (IntegratorType::ROS2):
+      return std::unique_ptr<IntegratorBase>(new Rosenbrock2(eventHandlerPtr));
 #if (BOOST_VERSION / 100000 == 1 && BOOST_VERSION / 100 % 1000 > 55)
     case (IntegratorType::ADAMS_BASHFORTH_MOULTON):
       return std::unique_ptr<IntegratorBase>(new IntegratorAdamsBashforthMoulton<1>(eventHandlerPtr));
@@ -66,6 +66,7 @@ void IntegratorBase::integrateConst(OdeBase& system, Observer& observer, const v
     observer.observe(x, t);
     eventHandlerPtr_->handleEvent(system, t, x);
   };
+  systemJacobian_ = [&system](const vector_t& x, matrix_t& dfdx, scalar_t t) { dfdx = system.computeFlowMapJacobian(t, x); };
   runIntegrateConst(systemFunction(system, maxNumSteps), callback, initialState, startTime, finalTime, dt);
 }
 
@@ -79,6 +80,7 @@ void IntegratorBase::integrateAdaptive(OdeBase& system, Observer& observer, cons
     observer.observe(x, t);
     eventHandlerPtr_->handleEvent(system, t, x);
   };
+  systemJacobian_ = [&system](const vector_t& x, matrix_t& dfdx, scalar_t t) { dfdx = system.computeFlowMapJacobian(t, x); };
   runIntegrateAdaptive(systemFunction(system, maxNumSteps), callback, initialState, startTime, finalTime, dtInitial, AbsTol, RelTol);
 }
 
@@ -94,6 +96,7 @@ void IntegratorBase::integrateTimes(OdeBase& system, Observer& observer, const v
     observer.observe(x, t);
     eventHandlerPtr_->handleEvent(system, t, x);
   };
+  systemJacobian_ = [&system](const vector_t& x, matrix_t& dfdx, scalar_t t) { dfdx = system.computeFlowMapJacobian(t, x); };
   runIntegrateTimes(systemFunction(system, maxNumSteps), callback, initialState, beginTimeItr, endTimeItr, dtInitial, AbsTol, RelTol);
 }
 
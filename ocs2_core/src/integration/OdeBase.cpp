@@ -29,8 +29,29 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/integration/OdeBase.h>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 namespace ocs2 {
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+matrix_t OdeBase::computeFlowMapJacobian(scalar_t t, const vector_t& x) {
+  const scalar_t sqrtEps = std::sqrt(std::numeric_limits<scalar_t>::epsilon());
+  const vector_t f = computeFlowMap(t, x);
+  matrix_t jacobian(f.size(), x.size());
+  vector_t xPerturbed = x;
+  for (int i = 0; i < x.size(); i++) {
+    const scalar_t h = sqrtEps * std::max(scalar_t(1.0), std::abs(x(i)));
+    xPerturbed(i) = x(i) + h;
+    jacobian.col(i) = (computeFlowMap(t, xPerturbed) - f) / h;
+    xPerturbed(i) = x(i);
+  }
+  return jacobian;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
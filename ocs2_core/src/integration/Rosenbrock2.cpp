@@ -0,0 +1,245 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include <Eigen/LU>
+
+#include <ocs2_core/integration/Rosenbrock2.h>
+
+namespace ocs2 {
+
+namespace {
+
+/** Helper less comparison for both positive and negative dt case. */
+bool lessWithSign(scalar_t t1, scalar_t t2, scalar_t dt) {
+  if (dt > 0) {
+    return t2 - t1 > std::numeric_limits<scalar_t>::epsilon();
+  } else {
+    return t1 - t2 > std::numeric_limits<scalar_t>::epsilon();
+  }
+}
+
+/** Helper to get the min absolute value, t1 and t2 have same sign. */
+scalar_t minAbs(scalar_t t1, scalar_t t2) {
+  if (t1 > 0) {
+    return std::min(t1, t2);
+  } else {
+    return std::max(t1, t2);
+  }
+}
+
+/** Helper to get max absolute value, t1 and t2 have same sign. */
+scalar_t maxAbs(scalar_t t1, scalar_t t2) {
+  if (t1 > 0) {
+    return std::max(t1, t2);
+  } else {
+    return std::min(t1, t2);
+  }
+}
+
+/** Rosenbrock ROS2 stepper. The flow map and its Jacobian at the start of a step are reused when the step is rejected. */
+class Stepper {
+ public:
+  using system_func_t = IntegratorBase::system_func_t;
+  using jacobian_func_t = IntegratorBase::jacobian_func_t;
+
+  Stepper(system_func_t& system, jacobian_func_t& jacobian) : system_(system), jacobian_(jacobian) {}
+
+  /**
+   * Try to perform one step. If the step is accepted, then state (x), time (t) and step size (dt) are updated.
+   * Otherwise only the step size (dt) is updated and false is returned.
+   *
+   * @param [in,out] x: current state, updated if step is taken.
+   * @param [in,out] t: current time, updated if step is taken.
+   * @param [in,out] dt: step size, updated if step is taken.
+   * @param [in] absTol: The absolute tolerance error for ode solver.
+   * @param [in] relTol: The relative tolerance error for ode solver.
+   * @return true if the step is taken, false otherwise.
+   */
+  bool tryStep(vector_t& x, scalar_t& t, scalar_t& dt, scalar_t absTol, scalar_t relTol) {
+    doStep(x, t, dt, xOut_);
+
+    // the difference to the embedded linearly implicit Euler step x + dt * k1
+    auto& xErr = xStage_;
+    xErr = 0.5 * dt * (k1_ + k2_);
+    const scalar_t error = (xErr.array() / (absTol + relTol * x.array().abs().max(xOut_.array().abs()))).abs().maxCoeff();
+
+    if (error > 1.0) {
+      dt *= std::max(0.9 / std::sqrt(error), 0.2);
+      return false;
+    } else {
+      // accept the step
+      t += dt;
+      x.swap(xOut_);
+      isStartEvaluated_ = false;
+      dt *= std::min(0.9 / std::sqrt(std::max(error, 1e-4)), 5.0);
+      return true;
+    }
+  }
+
+  /**
+   * Perform one ROS2 step.
+   *
+   * @param [in] x0: current state.
+   * @param [in] t: current time.
+   * @param [in] dt: step size.
+   * @param [out] x_out: next state (can be same reference as x0).
+   */
+  void doStep(const vector_t& x0, scalar_t t, scalar_t dt, vector_t& x_out) {
+    const scalar_t gamma = 1.0 + 1.0 / std::sqrt(2.0);
+
+    if (!isStartEvaluated_) {
+      system_(x0, f0_, t);
+      jacobian_(x0, jacobian_x0_, t);
+      isStartEvaluated_ = true;
+    }
+    W_ = -gamma * dt * jacobian_x0_;
+    W_.diagonal().array() += 1.0;
+    lu_.compute(W_);
+
+    k1_ = lu_.solve(f0_);
+    xStage_ = x0 + dt * k1_;
+    system_(xStage_, f1_, t + dt);
+    f1_ -= 2.0 * k1_;
+    k2_ = lu_.solve(f1_);
+    x_out = x0 + dt * (1.5 * k1_ + 0.5 * k2_);
+  }
+
+  /** Notifies the stepper that the state was changed externally. */
+  void reset() { isStartEvaluated_ = false; }
+
+ private:
+  system_func_t& system_;
+  jacobian_func_t& jacobian_;
+
+  bool isStartEvaluated_ = false;
+  vector_t f0_, f1_, k1_, k2_, xStage_, xOut_;
+  matrix_t jacobian_x0_, W_;
+  Eigen::PartialPivLU<matrix_t> lu_;
+};
+
+}  // namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void Rosenbrock2::runIntegrateConst(system_func_t system, observer_func_t observer, const vector_t& initialState, scalar_t startTime,
+                                    scalar_t finalTime, scalar_t dt) {
+  // Ensure that finalTime is included by adding a fraction of dt such that: N * dt <= finalTime < (N + 1) * dt.
+  finalTime += 0.1 * dt;
+
+  Stepper stepper(system, systemJacobian_);
+  scalar_t t = startTime;
+  vector_t x = initialState;
+  size_t step = 0;
+  while (lessWithSign(t + dt, finalTime, dt)) {
+    observer(x, t);
+    stepper.doStep(x, t, dt, x);
+    stepper.reset();
+    step++;
+    t = startTime + step * dt;
+  }
+  observer(x, t);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void Rosenbrock2::runIntegrateAdaptive(system_func_t system, observer_func_t observer, const vector_t& initialState,
+                                       scalar_t startTime, scalar_t finalTime, scalar_t dtInitial, scalar_t absTol, scalar_t relTol) {
+  Stepper stepper(system, systemJacobian_);
+  scalar_t t = startTime;
+  scalar_t dt = dtInitial;
+  vector_t x = initialState;
+
+  while (lessWithSign(t, finalTime, dt)) {
+    observer(x, t);
+
+    if (lessWithSign(finalTime, t + dt, dt)) {
+      dt = finalTime - t;
+    }
+
+    size_t tries = 0;
+    while (!stepper.tryStep(x, t, dt, absTol, relTol)) {
+      tries++;
+      if (tries > maxNumStepsRetries_) {
+        throw std::runtime_error("[Rosenbrock2] Max number of iterations exceeded");
+      }
+    }  // end of while loop
+  }    // end of while loop
+  observer(x, t);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void Rosenbrock2::runIntegrateTimes(system_func_t system, observer_func_t observer, const vector_t& initialState,
+                                    typename scalar_array_t::const_iterator beginTimeItr, typename scalar_array_t::const_iterator endTimeItr,
+                                    scalar_t dtInitial, scalar_t absTol, scalar_t relTol) {
+  Stepper stepper(system, systemJacobian_);
+  scalar_t dt = dtInitial;
+  vector_t x = initialState;
+
+  while (true) {
+    scalar_t t = *beginTimeItr++;
+    observer(x, t);
+
+    if (beginTimeItr == endTimeItr) {
+      break;
+    }
+
+    size_t tries = 0;
+    while (lessWithSign(t, *beginTimeItr, dt)) {
+      // adjust stepsize to end up exactly at the observation point
+      scalar_t dtCurrent = minAbs(dt, *beginTimeItr - t);
+      if (stepper.tryStep(x, t, dtCurrent, absTol, relTol)) {
+        tries = 0;
+        // continue with the original step size if dt was reduced due to observation
+        dt = maxAbs(dt, dtCurrent);
+      } else {
+        tries++;
+        dt = dtCurrent;
+        if (tries > maxNumStepsRetries_) {
+          throw std::runtime_error("[Rosenbrock2] Max number of iterations exceeded");
+        }
+      }
+    }  // end of while loop
+  }    // end of while loop
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+constexpr size_t Rosenbrock2::maxNumStepsRetries_;
+
+}  // namespace ocs2
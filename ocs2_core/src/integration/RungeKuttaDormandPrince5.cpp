@@ -28,6 +28,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
 #include <algorithm>
+#include <iterator>
 #include <limits>
 
 #include <ocs2_core/integration/RungeKuttaDormandPrince5.h>
@@ -63,7 +64,7 @@ scalar_t maxAbs(scalar_t t1, scalar_t t2) {
   }
 }
 
-/** Runge Kutta Dormand-Prince stepper */
+/** Runge Kutta Dormand-Prince stepper. The stage buffers are members, such that they are only allocated on the first step. */
 class Stepper {
  public:
   using system_func_t = IntegratorBase::system_func_t;
@@ -96,26 +97,71 @@ class Stepper {
     constexpr scalar_t dc6 = c6 - 187.0 / 2100;
     constexpr scalar_t dc7 = -1.0 / 40;
 
-    vector_t x_out, dxdt_out;
-    doStep(system, x, dxdt, t, dt, x_out, dxdt_out);
+    doStep(system, x, dxdt, t, dt, xOut_, dxdtOut_);
 
-    // error estimate
-    const vector_t x_err = dt * (dc1 * k1_ + dc3 * k3_ + dc4 * k4_ + dc5 * k5_ + dc6 * k6_ + dc7 * dxdt_out);
+    // error estimate, the stage state buffer is not needed anymore
+    auto& xErr = xStage_;
+    xErr = dt * (dc1 * k1_ + dc3 * k3_ + dc4 * k4_ + dc5 * k5_ + dc6 * k6_ + dc7 * dxdtOut_);
 
-    const scalar_t error = maxError(x, dxdt, x_err, dt, absTol, relTol);
+    const scalar_t error = maxError(x, dxdt, xErr, dt, absTol, relTol);
     if (error > 1.0) {
       dt = decreaseStep(dt, error);
       return false;
     } else {
-      // accept the step
+      // accept the step, the previous state is kept in xOut_ for interpolate()
+      lastStartTime_ = t;
+      lastStepSize_ = dt;
       t += dt;
-      x = x_out;
-      dxdt = dxdt_out;
+      x.swap(xOut_);
+      dxdt.swap(dxdtOut_);
       dt = increaseStep(dt, error);
       return true;
     }
   }
 
+  /**
+   * Evaluates the continuous extension of 4th order (dense output) of the last accepted step. It is only valid after tryStep()
+   * returned true.
+   *
+   * @param [in] time: The time within the last accepted step.
+   * @param [in] dxdt: The derivative at the end of the last accepted step.
+   * @param [out] x: The interpolated state.
+   */
+  void interpolate(scalar_t time, const vector_t& dxdt, vector_t& x) const {
+    /* Coefficients of the continuous extension in terms of powers of theta,
+     * E. Hairer, S.P. Norsett, G. Wanner, "Solving Ordinary Differential Equations I", Section II.6. */
+    constexpr scalar_t p12 = -8048581381.0 / 2820520608;
+    constexpr scalar_t p13 = 8663915743.0 / 2820520608;
+    constexpr scalar_t p14 = -12715105075.0 / 11282082432;
+    constexpr scalar_t p32 = 131558114200.0 / 32700410799;
+    constexpr scalar_t p33 = -68118460800.0 / 10900136933;
+    constexpr scalar_t p34 = 87487479700.0 / 32700410799;
+    constexpr scalar_t p42 = -1754552775.0 / 470086768;
+    constexpr scalar_t p43 = 14199869525.0 / 1410260304;
+    constexpr scalar_t p44 = -10690763975.0 / 1880347072;
+    constexpr scalar_t p52 = 127303824393.0 / 49829197408;
+    constexpr scalar_t p53 = -318862633887.0 / 49829197408;
+    constexpr scalar_t p54 = 701980252875.0 / 199316789632;
+    constexpr scalar_t p62 = -282668133.0 / 205662961;
+    constexpr scalar_t p63 = 2019193451.0 / 616988883;
+    constexpr scalar_t p64 = -1453857185.0 / 822651844;
+    constexpr scalar_t p72 = 40617522.0 / 29380423;
+    constexpr scalar_t p73 = -110615467.0 / 29380423;
+    constexpr scalar_t p74 = 69997945.0 / 29380423;
+
+    const scalar_t theta = (time - lastStartTime_) / lastStepSize_;
+    const scalar_t theta2 = theta * theta;
+    const scalar_t theta3 = theta2 * theta;
+    const scalar_t theta4 = theta3 * theta;
+    const scalar_t b1 = theta + p12 * theta2 + p13 * theta3 + p14 * theta4;
+    const scalar_t b3 = p32 * theta2 + p33 * theta3 + p34 * theta4;
+    const scalar_t b4 = p42 * theta2 + p43 * theta3 + p44 * theta4;
+    const scalar_t b5 = p52 * theta2 + p53 * theta3 + p54 * theta4;
+    const scalar_t b6 = p62 * theta2 + p63 * theta3 + p64 * theta4;
+    const scalar_t b7 = p72 * theta2 + p73 * theta3 + p74 * theta4;
+    x = xOut_ + lastStepSize_ * (b1 * k1_ + b3 * k3_ + b4 * k4_ + b5 * k5_ + b6 * k6_ + b7 * dxdt);
+  }
+
   /**
    * Perform one Dormand-Prince step.
    *
@@ -164,16 +210,16 @@ class Stepper {
     constexpr scalar_t c6 = 11.0 / 84;
 
     k1_ = dxdt;  // k1 = system(x, t) from previous iteration
-    vector_t x = x0 + dt * b21 * k1_;
-    system(x, k2_, t + dt * a2);
-    x.noalias() = x0 + dt * b31 * k1_ + dt * b32 * k2_;
-    system(x, k3_, t + dt * a3);
-    x.noalias() = x0 + dt * (b41 * k1_ + b42 * k2_ + b43 * k3_);
-    system(x, k4_, t + dt * a4);
-    x.noalias() = x0 + dt * (b51 * k1_ + b52 * k2_ + b53 * k3_ + b54 * k4_);
-    system(x, k5_, t + dt * a5);
-    x.noalias() = x0 + dt * (b61 * k1_ + b62 * k2_ + b63 * k3_ + b64 * k4_ + b65 * k5_);
-    system(x, k6_, t + dt);
+    xStage_ = x0 + dt * b21 * k1_;
+    system(xStage_, k2_, t + dt * a2);
+    xStage_ = x0 + dt * b31 * k1_ + dt * b32 * k2_;
+    system(xStage_, k3_, t + dt * a3);
+    xStage_ = x0 + dt * (b41 * k1_ + b42 * k2_ + b43 * k3_);
+    system(xStage_, k4_, t + dt * a4);
+    xStage_ = x0 + dt * (b51 * k1_ + b52 * k2_ + b53 * k3_ + b54 * k4_);
+    system(xStage_, k5_, t + dt * a5);
+    xStage_ = x0 + dt * (b61 * k1_ + b62 * k2_ + b63 * k3_ + b64 * k4_ + b65 * k5_);
+    system(xStage_, k6_, t + dt);
     // update x_out and dxdt_out (x_out can be x0 and dxdt_out can be dxdt)
     x_out = x0 + dt * (c1 * k1_ + c3 * k3_ + c4 * k4_ + c5 * k5_ + c6 * k6_);
     system(x_out, dxdt_out, t + dt);
@@ -193,8 +239,7 @@ class Stepper {
    */
   static scalar_t maxError(const vector_t& x_old, const vector_t& dxdt_old, const vector_t& x_err, scalar_t dt, scalar_t absTol,
                            scalar_t relTol) {
-    const vector_t err = x_err.array() / (absTol + relTol * (x_old.array().abs() + std::abs(dt) * dxdt_old.array().abs()));
-    return err.lpNorm<Eigen::Infinity>();
+    return (x_err.array() / (absTol + relTol * (x_old.array().abs() + std::abs(dt) * dxdt_old.array().abs()))).abs().maxCoeff();
   }
 
   /**
@@ -220,14 +265,19 @@ class Stepper {
   static scalar_t increaseStep(scalar_t dt, scalar_t error) {
     constexpr int STEPPER_ORDER = 5;
     if (error < 0.5) {
-      error = std::max(std::pow(scalar_t(5.0), -STEPPER_ORDER), error);
-      dt *= 0.9 * std::pow(error, -1.0 / STEPPER_ORDER);
+      error = std::max(static_cast<scalar_t>(std::pow(scalar_t(5.0), -STEPPER_ORDER)), error);
+      dt *= 0.9 * std::pow(error, scalar_t(-1.0) / STEPPER_ORDER);
     }
     return dt;
   }
 
   /** intermediate derivatives during Runge-Kutta step. */
   vector_t k1_, k2_, k3_, k4_, k5_, k6_;
+  /** intermediate state during Runge-Kutta step, and the candidate state and derivative of tryStep(). */
+  vector_t xStage_, xOut_, dxdtOut_;
+  /** start time and size of the last accepted step. */
+  scalar_t lastStartTime_ = 0.0;
+  scalar_t lastStepSize_ = 0.0;
 };
 
 }  // namespace
@@ -297,35 +347,39 @@ void RungeKuttaDormandPrince5::runIntegrateTimes(system_func_t system, observer_
                                                  scalar_t relTol) {
   Stepper stepper;
   scalar_t dt = dtInitial;
+  scalar_t t = *beginTimeItr;
   vector_t x = initialState;
   vector_t dxdt;
-  system(x, dxdt, *beginTimeItr);
-
-  while (true) {
-    scalar_t t = *beginTimeItr++;
-    observer(x, t);
-
-    if (beginTimeItr == endTimeItr) {
-      break;
-    }
-
-    size_t tries = 0;
-    while (lessWithSign(t, *beginTimeItr, dt)) {
-      // adjust stepsize to end up exactly at the observation point
-      scalar_t dtCurrent = minAbs(dt, *beginTimeItr - t);
-      if (stepper.tryStep(system, x, dxdt, t, dtCurrent, absTol, relTol)) {
-        tries = 0;
-        // continue with the original step size if dt was reduced due to observation
-        dt = maxAbs(dt, dtCurrent);
-      } else {
-        tries++;
-        dt = dtCurrent;
-        if (tries > maxNumStepsRetries_) {
-          throw std::runtime_error("[RungeKuttaDormandPrince5] Max number of iterations exceeded");
+  system(x, dxdt, t);
+  observer(x, *beginTimeItr++);
+
+  // The steps are not shortened to hit the observation times. The observed states are evaluated by the continuous extension instead.
+  const scalar_t finalTime = *std::prev(endTimeItr);
+  vector_t xObserved;
+  size_t tries = 0;
+  while (beginTimeItr != endTimeItr) {
+    // do not step beyond the final time
+    scalar_t dtCurrent = lessWithSign(finalTime, t + dt, dt) ? finalTime - t : dt;
+    if (stepper.tryStep(system, x, dxdt, t, dtCurrent, absTol, relTol)) {
+      tries = 0;
+      // continue with the original step size if dt was reduced due to the final time
+      dt = maxAbs(dt, dtCurrent);
+      while (beginTimeItr != endTimeItr && !lessWithSign(t, *beginTimeItr, dt)) {
+        if (lessWithSign(*beginTimeItr, t, dt)) {
+          stepper.interpolate(*beginTimeItr, dxdt, xObserved);
+          observer(xObserved, *beginTimeItr++);
+        } else {
+          observer(x, *beginTimeItr++);
         }
       }
-    }  // end of while loop
-  }    // end of while loop
+    } else {
+      tries++;
+      dt = dtCurrent;
+      if (tries > maxNumStepsRetries_) {
+        throw std::runtime_error("[RungeKuttaDormandPrince5] Max number of iterations exceeded");
+      }
+    }
+  }  // end of while loop
 }
 
 /******************************************************************************************************/
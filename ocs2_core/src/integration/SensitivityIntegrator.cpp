@@ -29,12 +29,23 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_core/integration/SensitivityIntegrator.h"
 
+#include <algorithm>
+#include <cmath>
 #include <unordered_map>
 
 #include <ocs2_core/integration/SensitivityIntegratorImpl.h>
 
 namespace ocs2 {
 
+namespace {
+
+/** The number of steps of at most maxStep, intervals which are longer only by round-off, e.g. merged nodes, take a single step */
+int getNumSteps(scalar_t dt, scalar_t maxStep) {
+  return std::max(1, static_cast<int>(std::ceil(dt / maxStep - 1e-6)));
+}
+
+}  // unnamed namespace
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -44,8 +55,12 @@ DynamicsDiscretizer selectDynamicsDiscretization(SensitivityIntegratorType integ
       return eulerDiscretization;
     case SensitivityIntegratorType::RK2:
       return rk2Discretization;
+    case SensitivityIntegratorType::RK3:
+      return rk3Discretization;
     case SensitivityIntegratorType::RK4:
       return rk4Discretization;
+    case SensitivityIntegratorType::IMPLICIT_MIDPOINT:
+      return implicitMidpointDiscretization;
     default:
       throw std::runtime_error("Integrator of type " + sensitivity_integrator::toString(integratorType) + " not supported.");
   }
@@ -60,13 +75,128 @@ DynamicsSensitivityDiscretizer selectDynamicsSensitivityDiscretization(Sensitivi
       return eulerSensitivityDiscretization;
     case SensitivityIntegratorType::RK2:
       return rk2SensitivityDiscretization;
+    case SensitivityIntegratorType::RK3:
+      return rk3SensitivityDiscretization;
     case SensitivityIntegratorType::RK4:
       return rk4SensitivityDiscretization;
+    case SensitivityIntegratorType::IMPLICIT_MIDPOINT:
+      return implicitMidpointSensitivityDiscretization;
     default:
       throw std::runtime_error("Integrator of type " + sensitivity_integrator::toString(integratorType) + " not supported.");
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+DynamicsDiscretizer multiStepDynamicsDiscretization(DynamicsDiscretizer discretizer, scalar_t maxStep) {
+  if (maxStep <= 0.0) {
+    throw std::runtime_error("[multiStepDynamicsDiscretization] maxStep must be positive!");
+  }
+  return [discretizer, maxStep](SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt) -> vector_t {
+    const int numSteps = getNumSteps(dt, maxStep);
+    if (numSteps == 1) {
+      return discretizer(system, t, x, u, dt);
+    }
+    const scalar_t step = dt / numSteps;
+    vector_t x_next = x;
+    for (int i = 0; i < numSteps; i++) {
+      x_next = discretizer(system, t + i * step, x_next, u, step);
+    }
+    return x_next;
+  };
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+DynamicsSensitivityDiscretizer multiStepDynamicsSensitivityDiscretization(DynamicsSensitivityDiscretizer sensitivityDiscretizer,
+                                                                          scalar_t maxStep) {
+  if (maxStep <= 0.0) {
+    throw std::runtime_error("[multiStepDynamicsSensitivityDiscretization] maxStep must be positive!");
+  }
+  return [sensitivityDiscretizer, maxStep](SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u,
+                                           scalar_t dt) -> VectorFunctionLinearApproximation {
+    const int numSteps = getNumSteps(dt, maxStep);
+    if (numSteps == 1) {
+      return sensitivityDiscretizer(system, t, x, u, dt);
+    }
+    // Chain the steps x_{i+1} = A_i * dx_i + B_i * du + b_i, such that A = A_{n-1} * ... * A_0 and B = sum_i A_{n-1} * ... * A_{i+1} * B_i
+    const scalar_t step = dt / numSteps;
+    auto approximation = sensitivityDiscretizer(system, t, x, u, step);
+    for (int i = 1; i < numSteps; i++) {
+      const auto stepApproximation = sensitivityDiscretizer(system, t + i * step, approximation.f, u, step);
+      approximation.f = stepApproximation.f;
+      approximation.dfdx = stepApproximation.dfdx * approximation.dfdx;
+      approximation.dfdu = stepApproximation.dfdx * approximation.dfdu;
+      approximation.dfdu += stepApproximation.dfdu;
+    }
+    return approximation;
+  };
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+DynamicsEnsembleDiscretizer selectDynamicsEnsembleDiscretization(SensitivityIntegratorType integratorType) {
+  switch (integratorType) {
+    case SensitivityIntegratorType::EULER:
+      return eulerEnsembleDiscretization;
+    case SensitivityIntegratorType::RK2:
+      return rk2EnsembleDiscretization;
+    case SensitivityIntegratorType::RK3:
+      return rk3EnsembleDiscretization;
+    case SensitivityIntegratorType::RK4:
+      return rk4EnsembleDiscretization;
+    default:
+      throw std::runtime_error("Integrator of type " + sensitivity_integrator::toString(integratorType) + " not supported.");
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void integrateEnsemble(SystemDynamicsBase& system, SensitivityIntegratorType integratorType, scalar_t initTime,
+                       const matrix_t& initStateBatch, scalar_t finalTime, scalar_t timeStep, scalar_array_t& timeTrajectory,
+                       matrix_array_t& stateBatchTrajectory) {
+  auto* controllerPtr = system.controllerPtr();
+  if (controllerPtr == nullptr) {
+    throw std::runtime_error("[integrateEnsemble] The controller of the system is not set!");
+  }
+  if (timeStep <= 0.0) {
+    throw std::runtime_error("[integrateEnsemble] The time step should be positive!");
+  }
+
+  const auto discretizer = selectDynamicsEnsembleDiscretization(integratorType);
+  const auto numSteps = static_cast<size_t>(std::max(1.0, std::ceil((finalTime - initTime) / timeStep - 1e-9)));
+
+  timeTrajectory.clear();
+  timeTrajectory.reserve(numSteps + 1);
+  stateBatchTrajectory.clear();
+  stateBatchTrajectory.reserve(numSteps + 1);
+  timeTrajectory.push_back(initTime);
+  stateBatchTrajectory.push_back(initStateBatch);
+
+  matrix_t inputBatch;
+  for (size_t i = 0; i < numSteps; i++) {
+    const scalar_t t = timeTrajectory.back();
+    const scalar_t dt = (i + 1 < numSteps) ? timeStep : finalTime - t;
+    const matrix_t& xBatch = stateBatchTrajectory.back();
+
+    // the controller is evaluated state by state
+    for (int k = 0; k < xBatch.cols(); k++) {
+      const vector_t u = controllerPtr->computeInput(t, xBatch.col(k));
+      if (k == 0) {
+        inputBatch.resize(u.rows(), xBatch.cols());
+      }
+      inputBatch.col(k) = u;
+    }
+
+    stateBatchTrajectory.push_back(discretizer(system, t, xBatch, inputBatch, dt));
+    timeTrajectory.push_back(t + dt);
+  }
+}
+
 namespace sensitivity_integrator {
 
 /******************************************************************************************************/
@@ -74,7 +204,11 @@ namespace sensitivity_integrator {
 /******************************************************************************************************/
 std::string toString(SensitivityIntegratorType integratorType) {
   static const std::unordered_map<SensitivityIntegratorType, std::string> integratorMap = {
-      {SensitivityIntegratorType::EULER, "EULER"}, {SensitivityIntegratorType::RK2, "RK2"}, {SensitivityIntegratorType::RK4, "RK4"}};
+      {SensitivityIntegratorType::EULER, "EULER"},
+      {SensitivityIntegratorType::RK2, "RK2"},
+      {SensitivityIntegratorType::RK3, "RK3"},
+      {SensitivityIntegratorType::RK4, "RK4"},
+      {SensitivityIntegratorType::IMPLICIT_MIDPOINT, "IMPLICIT_MIDPOINT"}};
 
   return integratorMap.at(integratorType);
 }
@@ -84,7 +218,11 @@ std::string toString(SensitivityIntegratorType integratorType) {
 /******************************************************************************************************/
 SensitivityIntegratorType fromString(const std::string& name) {
   static const std::unordered_map<std::string, SensitivityIntegratorType> integratorMap = {
-      {"EULER", SensitivityIntegratorType::EULER}, {"RK2", SensitivityIntegratorType::RK2}, {"RK4", SensitivityIntegratorType::RK4}};
+      {"EULER", SensitivityIntegratorType::EULER},
+      {"RK2", SensitivityIntegratorType::RK2},
+      {"RK3", SensitivityIntegratorType::RK3},
+      {"RK4", SensitivityIntegratorType::RK4},
+      {"IMPLICIT_MIDPOINT", SensitivityIntegratorType::IMPLICIT_MIDPOINT}};
 
   return integratorMap.at(name);
 }
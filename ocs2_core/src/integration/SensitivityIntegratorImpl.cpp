@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_core/integration/SensitivityIntegratorImpl.h"
 
+#include <Eigen/LU>
+
 namespace ocs2 {
 
 /******************************************************************************************************/
@@ -103,6 +105,64 @@ VectorFunctionLinearApproximation rk2SensitivityDiscretization(SystemDynamicsBas
   return k1;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t rk3Discretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt) {
+  const scalar_t dt_halve = dt / 2.0;
+  const scalar_t dt_sixth = dt / 6.0;
+
+  // System evaluations
+  const vector_t k1 = system.computeFlowMap(t, x, u);
+  vector_t tmp = x + dt_halve * k1;
+  const vector_t k2 = system.computeFlowMap(t + dt_halve, tmp, u);
+  tmp = x - dt * k1 + (2.0 * dt) * k2;
+  const vector_t k3 = system.computeFlowMap(t + dt, tmp, u);
+
+  tmp = x + dt_sixth * k1 + (4.0 * dt_sixth) * k2 + dt_sixth * k3;
+  return tmp;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+VectorFunctionLinearApproximation rk3SensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u,
+                                                               scalar_t dt) {
+  const scalar_t dt_halve = dt / 2.0;
+  const scalar_t dt_sixth = dt / 6.0;
+
+  // System evaluations
+  VectorFunctionLinearApproximation k1 = system.linearApproximation(t, x, u);
+  vector_t tmpV = x + dt_halve * k1.f;
+  VectorFunctionLinearApproximation k2 = system.linearApproximation(t + dt_halve, tmpV, u);
+  tmpV = x - dt * k1.f + (2.0 * dt) * k2.f;
+  VectorFunctionLinearApproximation k3 = system.linearApproximation(t + dt, tmpV, u);
+
+  // Input sensitivity \dot{Su} = dfdx(t) Su + dfdu(t), with Su(0) = Zero()
+  // Re-use memory from k.dfdu as dkduk
+  // dk1duk = k1.dfdu
+  k2.dfdu.noalias() += dt_halve * k2.dfdx * k1.dfdu;
+  matrix_t tmp = (2.0 * dt) * k2.dfdu - dt * k1.dfdu;
+  k3.dfdu.noalias() += k3.dfdx * tmp;
+
+  // State sensitivity \dot{Sx} = dfdx(t) Sx, with Sx(0) = Identity()
+  // Re-use memory from k.dfdx as dkdxk
+  // dk1dxk = k1.dfdx;
+  tmp.noalias() = dt_halve * k2.dfdx * k1.dfdx;  // need one temporary to avoid alias
+  k2.dfdx += tmp;
+  tmp = (2.0 * dt) * k2.dfdx - dt * k1.dfdx;
+  tmp.diagonal().array() += 1.0;  // plus Identity()
+  k3.dfdx = k3.dfdx * tmp;
+
+  // Assemble discrete approximation
+  // Re-use k1 to collect the result
+  k1.dfdx = dt_sixth * k1.dfdx + (4.0 * dt_sixth) * k2.dfdx + dt_sixth * k3.dfdx;
+  k1.dfdx.diagonal().array() += 1.0;  // plus Identity()
+  k1.dfdu = dt_sixth * k1.dfdu + (4.0 * dt_sixth) * k2.dfdu + dt_sixth * k3.dfdu;
+  k1.f = x + dt_sixth * k1.f + (4.0 * dt_sixth) * k2.f + dt_sixth * k3.f;
+  return k1;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -168,4 +228,127 @@ VectorFunctionLinearApproximation rk4SensitivityDiscretization(SystemDynamicsBas
   return k1;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t implicitMidpointDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt) {
+  // Newton's method needs the linearization, such that the value comes at the cost of the sensitivity
+  return implicitMidpointSensitivityDiscretization(system, t, x, u, dt).f;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+VectorFunctionLinearApproximation implicitMidpointSensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x,
+                                                                            const vector_t& u, scalar_t dt) {
+  constexpr int maxNumIterations = 10;
+  constexpr scalar_t tolerance = 1e-10;
+  const scalar_t dt_halve = dt / 2.0;
+  const scalar_t tMid = t + dt_halve;
+
+  // Newton iterations on the residual r(y) = y - x - dt * f(t + dt/2, (x + y)/2, u), starting from a forward euler step
+  vector_t y = x + dt * system.computeFlowMap(t, x, u);
+  vector_t tmpV = x + y;
+  tmpV *= 0.5;
+  VectorFunctionLinearApproximation k = system.linearApproximation(tMid, tmpV, u);
+  matrix_t jacobian;
+  for (int iter = 0; iter < maxNumIterations; iter++) {
+    // residual
+    tmpV = y - x - dt * k.f;
+    if (tmpV.lpNorm<Eigen::Infinity>() < tolerance) {
+      break;
+    }
+    // dr/dy = I - dt/2 * dfdx
+    jacobian = -dt_halve * k.dfdx;
+    jacobian.diagonal().array() += 1.0;  // plus Identity()
+    y -= jacobian.partialPivLu().solve(tmpV);
+
+    tmpV = x + y;
+    tmpV *= 0.5;
+    k = system.linearApproximation(tMid, tmpV, u);
+  }
+
+  // Implicit function theorem at the solution:
+  // (I - dt/2 * dfdx) A_{k} = I + dt/2 * dfdx
+  // (I - dt/2 * dfdx) B_{k} = dt * dfdu
+  jacobian = -dt_halve * k.dfdx;
+  jacobian.diagonal().array() += 1.0;  // plus Identity()
+  const Eigen::PartialPivLU<matrix_t> jacobianLu(jacobian);
+
+  k.dfdx *= dt_halve;
+  k.dfdx.diagonal().array() += 1.0;  // plus Identity()
+  k.dfdx = jacobianLu.solve(k.dfdx);
+  k.dfdu = jacobianLu.solve(dt * k.dfdu);
+  k.f = std::move(y);
+  return k;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+matrix_t eulerEnsembleDiscretization(SystemDynamicsBase& system, scalar_t t, const matrix_t& xBatch, const matrix_t& uBatch, scalar_t dt) {
+  matrix_t tmp;
+  system.computeFlowMapBatch(t, xBatch, uBatch, tmp);
+  tmp = xBatch + dt * tmp;
+  return tmp;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+matrix_t rk2EnsembleDiscretization(SystemDynamicsBase& system, scalar_t t, const matrix_t& xBatch, const matrix_t& uBatch, scalar_t dt) {
+  const scalar_t dt_halve = dt / 2.0;
+
+  // System evaluations
+  matrix_t k1, k2;
+  system.computeFlowMapBatch(t, xBatch, uBatch, k1);
+
+  matrix_t tmp = xBatch + dt * k1;
+  system.computeFlowMapBatch(t + dt, tmp, uBatch, k2);
+
+  tmp = xBatch + dt_halve * k1 + dt_halve * k2;
+  return tmp;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+matrix_t rk3EnsembleDiscretization(SystemDynamicsBase& system, scalar_t t, const matrix_t& xBatch, const matrix_t& uBatch, scalar_t dt) {
+  const scalar_t dt_halve = dt / 2.0;
+  const scalar_t dt_sixth = dt / 6.0;
+
+  // System evaluations
+  matrix_t k1, k2, k3;
+  system.computeFlowMapBatch(t, xBatch, uBatch, k1);
+  matrix_t tmp = xBatch + dt_halve * k1;
+  system.computeFlowMapBatch(t + dt_halve, tmp, uBatch, k2);
+  tmp = xBatch - dt * k1 + (2.0 * dt) * k2;
+  system.computeFlowMapBatch(t + dt, tmp, uBatch, k3);
+
+  tmp = xBatch + dt_sixth * k1 + (4.0 * dt_sixth) * k2 + dt_sixth * k3;
+  return tmp;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+matrix_t rk4EnsembleDiscretization(SystemDynamicsBase& system, scalar_t t, const matrix_t& xBatch, const matrix_t& uBatch, scalar_t dt) {
+  const scalar_t dt_halve = dt / 2.0;
+  const scalar_t dt_sixth = dt / 6.0;
+  const scalar_t dt_third = dt / 3.0;
+
+  // System evaluations
+  matrix_t k1, k2, k3, k4;
+  system.computeFlowMapBatch(t, xBatch, uBatch, k1);
+  matrix_t tmp = xBatch + dt_halve * k1;
+  system.computeFlowMapBatch(t + dt_halve, tmp, uBatch, k2);
+  tmp = xBatch + dt_halve * k2;
+  system.computeFlowMapBatch(t + dt_halve, tmp, uBatch, k3);
+  tmp = xBatch + dt * k3;
+  system.computeFlowMapBatch(t + dt, tmp, uBatch, k4);
+
+  tmp = xBatch + dt_sixth * k1 + dt_third * k2 + dt_third * k3 + dt_sixth * k4;
+  return tmp;
+}
+
 }  // namespace ocs2
\ No newline at end of file
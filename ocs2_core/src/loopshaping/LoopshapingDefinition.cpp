@@ -72,9 +72,8 @@ void LoopshapingDefinition::getSystemInput(const vector_t& state, const vector_t
         systemInput = filter_.getCdiag().diagonal().cwiseProduct(state.tail(filter_.getNumStates())) +
                       filter_.getDdiag().diagonal().cwiseProduct(input);
       } else {
-        // u = C*x + D*v. Use noalias to prevent temporaries.
-        systemInput.noalias() = filter_.getC() * state.tail(filter_.getNumStates());
-        systemInput.noalias() += filter_.getD() * input;
+        // u = C*x + D*v
+        filter_.computeOutput(state.tail(filter_.getNumStates()), input, systemInput);
       }
       break;
     }
@@ -96,8 +95,7 @@ void LoopshapingDefinition::getFilteredInput(const vector_t& state, const vector
         filteredInput = filter_.getCdiag().diagonal().cwiseProduct(state.tail(filter_.getNumStates())) +
                         filter_.getDdiag().diagonal().cwiseProduct(input);
       } else {
-        filteredInput.noalias() = filter_.getC() * state.tail(filter_.getNumStates());
-        filteredInput.noalias() += filter_.getD() * input;
+        filter_.computeOutput(state.tail(filter_.getNumStates()), input, filteredInput);
       }
       break;
     }
@@ -115,8 +113,8 @@ vector_t LoopshapingDefinition::filterFlowMap(const vector_t& filterState, const
   if (diagonal_) {
     return filter_.getAdiag().diagonal().cwiseProduct(filterState) + filter_.getBdiag().diagonal().cwiseProduct(input);
   } else {
-    vector_t filterStateDerivative = filter_.getA() * filterState;
-    filterStateDerivative.noalias() += filter_.getB() * input;
+    vector_t filterStateDerivative;
+    filter_.computeStateDerivative(filterState, input, filterStateDerivative);
     return filterStateDerivative;
   }
 }
@@ -30,9 +30,45 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ocs2_core/loopshaping/LoopshapingFilter.h"
 
 #include <iostream>
+#include <numeric>
 
 namespace ocs2 {
 
+namespace {
+/** Finds the representative of a node and compresses the path. */
+size_t findRoot(std::vector<size_t>& parent, size_t i) {
+  while (parent[i] != i) {
+    parent[i] = parent[parent[i]];
+    i = parent[i];
+  }
+  return i;
+}
+
+/** Connects all pairs (rowOffset + i, colOffset + j) with a non-zero m(i, j). */
+void connectNonZeros(const matrix_t& m, size_t rowOffset, size_t colOffset, std::vector<size_t>& parent) {
+  for (size_t j = 0; j < m.cols(); j++) {
+    for (size_t i = 0; i < m.rows(); i++) {
+      if (m(i, j) != 0.0) {
+        parent[findRoot(parent, rowOffset + i)] = findRoot(parent, colOffset + j);
+      }
+    }
+  }
+}
+
+/** Fixed-size kernel of the common SISO section of first or second order. */
+template <int N>
+void sisoStateDerivative(const Filter::Section& s, const Eigen::Ref<const vector_t>& x, const Eigen::Ref<const vector_t>& u,
+                         vector_t& dxdt) {
+  dxdt.segment<N>(s.stateOffset).noalias() = s.A.topLeftCorner<N, N>() * x.segment<N>(s.stateOffset);
+  dxdt.segment<N>(s.stateOffset) += u(s.inputOffset) * s.B.topLeftCorner<N, 1>();
+}
+
+template <int N>
+scalar_t sisoOutput(const Filter::Section& s, const Eigen::Ref<const vector_t>& x, const Eigen::Ref<const vector_t>& u) {
+  return s.C.topLeftCorner<1, N>().dot(x.segment<N>(s.stateOffset).transpose()) + s.D(0, 0) * u(s.inputOffset);
+}
+}  // unnamed namespace
+
 Filter::Filter() {
   A_.resize(0, 0);
   B_.resize(0, 0);
@@ -53,6 +89,7 @@ Filter::Filter(matrix_t A, matrix_t B, matrix_t C, matrix_t D)
       numInputs_(B_.cols()),
       numOutputs_(C_.rows()) {
   checkSize();
+  findSections();
 
   // precompute row + column scaling
   diagCC_ = c_ * matrix_t::Ones(c_.cols(), c_.rows()) * c_;
@@ -122,6 +159,136 @@ void Filter::findEquilibriumForInput(const vector_t& u, vector_t& x, vector_t& y
   }
 }
 
+void Filter::computeStateDerivative(const Eigen::Ref<const vector_t>& x, const Eigen::Ref<const vector_t>& u, vector_t& dxdt) const {
+  dxdt.resize(numStates_);
+  for (const auto& s : sections_) {
+    const bool isSiso = s.numInputs == 1 && s.numOutputs == 1;
+    if (isSiso && s.numStates == 1) {
+      dxdt(s.stateOffset) = s.A(0, 0) * x(s.stateOffset) + s.B(0, 0) * u(s.inputOffset);
+    } else if (isSiso && s.numStates == 2) {
+      sisoStateDerivative<2>(s, x, u, dxdt);
+    } else if (s.numStates > 0) {
+      dxdt.segment(s.stateOffset, s.numStates).noalias() = s.A * x.segment(s.stateOffset, s.numStates);
+      dxdt.segment(s.stateOffset, s.numStates).noalias() += s.B * u.segment(s.inputOffset, s.numInputs);
+    }
+  }
+}
+
+void Filter::computeOutput(const Eigen::Ref<const vector_t>& x, const Eigen::Ref<const vector_t>& u, vector_t& y) const {
+  y.resize(numOutputs_);
+  for (const auto& s : sections_) {
+    const bool isSiso = s.numInputs == 1 && s.numOutputs == 1;
+    if (isSiso && s.numStates == 0) {
+      y(s.outputOffset) = s.D(0, 0) * u(s.inputOffset);
+    } else if (isSiso && s.numStates == 1) {
+      y(s.outputOffset) = s.C(0, 0) * x(s.stateOffset) + s.D(0, 0) * u(s.inputOffset);
+    } else if (isSiso && s.numStates == 2) {
+      y(s.outputOffset) = sisoOutput<2>(s, x, u);
+    } else if (s.numOutputs > 0) {
+      y.segment(s.outputOffset, s.numOutputs).noalias() = s.C * x.segment(s.stateOffset, s.numStates);
+      y.segment(s.outputOffset, s.numOutputs).noalias() += s.D * u.segment(s.inputOffset, s.numInputs);
+    }
+  }
+}
+
+void Filter::rightMultiplyC(const Eigen::Ref<const matrix_t>& M, Eigen::Ref<matrix_t> MC) const {
+  assert(M.cols() == numOutputs_ && MC.cols() == numStates_ && MC.rows() == M.rows());
+  for (const auto& s : sections_) {
+    if (s.numStates == 0) {
+      continue;
+    } else if (s.numOutputs == 1) {
+      MC.middleCols(s.stateOffset, s.numStates).noalias() = M.col(s.outputOffset) * s.C;
+    } else if (s.numOutputs > 0) {
+      MC.middleCols(s.stateOffset, s.numStates).noalias() = M.middleCols(s.outputOffset, s.numOutputs) * s.C;
+    } else {
+      MC.middleCols(s.stateOffset, s.numStates).setZero();
+    }
+  }
+}
+
+void Filter::rightMultiplyD(const Eigen::Ref<const matrix_t>& M, Eigen::Ref<matrix_t> MD) const {
+  assert(M.cols() == numOutputs_ && MD.cols() == numInputs_ && MD.rows() == M.rows());
+  for (const auto& s : sections_) {
+    if (s.numInputs == 0) {
+      continue;
+    } else if (s.numOutputs == 1 && s.numInputs == 1) {
+      MD.col(s.inputOffset) = s.D(0, 0) * M.col(s.outputOffset);
+    } else if (s.numOutputs > 0) {
+      MD.middleCols(s.inputOffset, s.numInputs).noalias() = M.middleCols(s.outputOffset, s.numOutputs) * s.D;
+    } else {
+      MD.middleCols(s.inputOffset, s.numInputs).setZero();
+    }
+  }
+}
+
+void Filter::findSections() {
+  const auto dense = [this]() {
+    Section s;
+    s.numStates = numStates_;
+    s.numInputs = numInputs_;
+    s.numOutputs = numOutputs_;
+    s.A = A_;
+    s.B = B_;
+    s.C = C_;
+    s.D = D_;
+    return std::vector<Section>{s};
+  };
+
+  // connected components of the states, inputs, and outputs which are coupled by a non-zero entry of the filter matrices
+  const size_t inputNode = numStates_;
+  const size_t outputNode = numStates_ + numInputs_;
+  std::vector<size_t> parent(numStates_ + numInputs_ + numOutputs_);
+  std::iota(parent.begin(), parent.end(), 0);
+  connectNonZeros(A_, 0, 0, parent);
+  connectNonZeros(B_, 0, inputNode, parent);
+  connectNonZeros(C_, outputNode, 0, parent);
+  connectNonZeros(D_, outputNode, inputNode, parent);
+
+  // the nodes of each component, in the order of their first node
+  std::vector<size_t> componentIndex(parent.size(), parent.size());
+  std::vector<std::vector<size_t>> states, inputs, outputs;
+  for (size_t i = 0; i < parent.size(); i++) {
+    auto& index = componentIndex[findRoot(parent, i)];
+    if (index == parent.size()) {
+      index = states.size();
+      states.emplace_back();
+      inputs.emplace_back();
+      outputs.emplace_back();
+    }
+    if (i < inputNode) {
+      states[index].push_back(i);
+    } else if (i < outputNode) {
+      inputs[index].push_back(i - inputNode);
+    } else {
+      outputs[index].push_back(i - outputNode);
+    }
+  }
+
+  // the sections require contiguous indices
+  const auto isContiguous = [](const std::vector<size_t>& indices) {
+    return indices.empty() || indices.back() - indices.front() + 1 == indices.size();
+  };
+  sections_.clear();
+  for (size_t k = 0; k < states.size(); k++) {
+    if (!isContiguous(states[k]) || !isContiguous(inputs[k]) || !isContiguous(outputs[k])) {
+      sections_ = dense();
+      return;
+    }
+    Section s;
+    s.stateOffset = states[k].empty() ? 0 : states[k].front();
+    s.numStates = states[k].size();
+    s.inputOffset = inputs[k].empty() ? 0 : inputs[k].front();
+    s.numInputs = inputs[k].size();
+    s.outputOffset = outputs[k].empty() ? 0 : outputs[k].front();
+    s.numOutputs = outputs[k].size();
+    s.A = A_.block(s.stateOffset, s.stateOffset, s.numStates, s.numStates);
+    s.B = B_.block(s.stateOffset, s.inputOffset, s.numStates, s.numInputs);
+    s.C = C_.block(s.outputOffset, s.stateOffset, s.numOutputs, s.numStates);
+    s.D = D_.block(s.outputOffset, s.inputOffset, s.numOutputs, s.numInputs);
+    sections_.push_back(std::move(s));
+  }
+}
+
 void Filter::checkSize() const {
   bool correct = true;
   // check number of state
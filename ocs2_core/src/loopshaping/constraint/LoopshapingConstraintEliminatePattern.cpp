@@ -65,14 +65,15 @@ VectorFunctionLinearApproximation LoopshapingConstraintEliminatePattern::getLine
   if (isDiagonal) {
     g.dfdx.rightCols(filtStateDim).noalias() = g_system.dfdu * s_filter.getCdiag();
   } else {
-    g.dfdx.rightCols(filtStateDim).noalias() = g_system.dfdu * s_filter.getC();
+    s_filter.rightMultiplyC(g_system.dfdu, g.dfdx.rightCols(filtStateDim));
   }
 
   // dfdu
   if (isDiagonal) {
     g.dfdu.noalias() = g_system.dfdu * s_filter.getDdiag();
   } else {
-    g.dfdu.noalias() = g_system.dfdu * s_filter.getD();
+    g.dfdu.resize(numConstraints, s_filter.getNumInputs());
+    s_filter.rightMultiplyD(g_system.dfdu, g.dfdu);
   }
 
   return g;
@@ -113,8 +114,9 @@ VectorFunctionQuadraticApproximation LoopshapingConstraintEliminatePattern::getQ
     h.dfdx.rightCols(filtStateDim).noalias() = h_system.dfdu * s_filter.getCdiag();
     h.dfdu.noalias() = h_system.dfdu * s_filter.getDdiag();
   } else {
-    h.dfdx.rightCols(filtStateDim).noalias() = h_system.dfdu * s_filter.getC();
-    h.dfdu.noalias() = h_system.dfdu * s_filter.getD();
+    s_filter.rightMultiplyC(h_system.dfdu, h.dfdx.rightCols(filtStateDim));
+    h.dfdu.resize(numConstraints, s_filter.getNumInputs());
+    s_filter.rightMultiplyD(h_system.dfdu, h.dfdu);
   }
 
   h.dfdxx.resize(numConstraints);
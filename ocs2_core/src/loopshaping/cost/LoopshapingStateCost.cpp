@@ -70,4 +70,23 @@ ScalarFunctionQuadraticApproximation LoopshapingStateCost::getQuadraticApproxima
   return Phi;
 }
 
+void LoopshapingStateCost::accumulateQuadraticApproximation(scalar_t t, const vector_t& x, const TargetTrajectories& targetTrajectories,
+                                                            const PreComputation& preComp,
+                                                            ScalarFunctionQuadraticApproximation& accumulator) const {
+  if (this->empty()) {
+    return;
+  }
+
+  const LoopshapingPreComputation& preCompLS = cast<LoopshapingPreComputation>(preComp);
+  const auto& x_system = preCompLS.getSystemState();
+  const auto sysStateDim = x_system.rows();
+
+  const auto Phi_system =
+      StateCostCollection::getQuadraticApproximation(t, x_system, targetTrajectories, preCompLS.getSystemPreComputation());
+
+  accumulator.f += Phi_system.f;
+  accumulator.dfdx.head(sysStateDim) += Phi_system.dfdx;
+  accumulator.dfdxx.topLeftCorner(sysStateDim, sysStateDim) += Phi_system.dfdxx;
+}
+
 }  // namespace ocs2
@@ -49,4 +49,13 @@ scalar_t LoopshapingStateInputCost::getValue(scalar_t t, const vector_t& x, cons
   return L_system + loopshapingDefinition_->loopshapingCost(u_filter);
 }
 
+void LoopshapingStateInputCost::accumulateQuadraticApproximation(scalar_t t, const vector_t& x, const vector_t& u,
+                                                                 const TargetTrajectories& targetTrajectories,
+                                                                 const PreComputation& preComp,
+                                                                 ScalarFunctionQuadraticApproximation& accumulator) const {
+  if (!this->empty()) {
+    accumulator += getQuadraticApproximation(t, x, u, targetTrajectories, preComp);
+  }
+}
+
 }  // namespace ocs2
@@ -41,10 +41,10 @@ vector_t LoopshapingDynamics::computeFlowMap(scalar_t time, const vector_t& stat
   const auto& x_filter = preCompLS.getFilterState();
   const auto& u_filter = preCompLS.getFilteredInput();
 
-  const vector_t dynamics_system = systemDynamics_->computeFlowMap(time, x_system, u_system, preComp_system);
-  const vector_t dynamics_filter = filterFlowmap(x_filter, u_filter, u_system);
-
-  return loopshapingDefinition_->concatenateSystemAndFilterState(dynamics_system, dynamics_filter);
+  vector_t dynamics(state.rows());
+  dynamics.head(x_system.rows()) = systemDynamics_->computeFlowMap(time, x_system, u_system, preComp_system);
+  dynamics.tail(x_filter.rows()) = filterFlowmap(x_filter, u_filter, u_system);
+  return dynamics;
 }
 
 vector_t LoopshapingDynamics::computeJumpMap(scalar_t time, const vector_t& state, const PreComputation& preComp) {
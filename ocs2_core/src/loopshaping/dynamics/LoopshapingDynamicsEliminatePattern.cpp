@@ -36,8 +36,8 @@ vector_t LoopshapingDynamicsEliminatePattern::filterFlowmap(const vector_t& x_fi
   if (loopshapingDefinition_->isDiagonal()) {
     return s_filter.getAdiag().diagonal().cwiseProduct(x_filter) + s_filter.getBdiag().diagonal().cwiseProduct(u_filter);
   } else {
-    vector_t dynamics_filter = s_filter.getA() * x_filter;
-    dynamics_filter.noalias() += s_filter.getB() * u_filter;
+    vector_t dynamics_filter;
+    s_filter.computeStateDerivative(x_filter, u_filter, dynamics_filter);
     return dynamics_filter;
   }
 }
@@ -67,7 +67,7 @@ VectorFunctionLinearApproximation LoopshapingDynamicsEliminatePattern::linearApp
   if (isDiagonal) {
     dynamics.dfdx.topRightCorner(sysStateDim, filtStateDim).noalias() = dynamics_system.dfdu * s_filter.getCdiag();
   } else {
-    dynamics.dfdx.topRightCorner(sysStateDim, filtStateDim).noalias() = dynamics_system.dfdu * s_filter.getC();
+    s_filter.rightMultiplyC(dynamics_system.dfdu, dynamics.dfdx.topRightCorner(sysStateDim, filtStateDim));
   }
   dynamics.dfdx.bottomRightCorner(filtStateDim, filtStateDim) = s_filter.getA();
 
@@ -75,7 +75,7 @@ VectorFunctionLinearApproximation LoopshapingDynamicsEliminatePattern::linearApp
   if (isDiagonal) {
     dynamics.dfdu.topRows(sysStateDim).noalias() = dynamics_system.dfdu * s_filter.getDdiag();
   } else {
-    dynamics.dfdu.topRows(sysStateDim).noalias() = dynamics_system.dfdu * s_filter.getD();
+    s_filter.rightMultiplyD(dynamics_system.dfdu, dynamics.dfdu.topRows(sysStateDim));
   }
   dynamics.dfdu.bottomRows(filtStateDim) = s_filter.getB();
 
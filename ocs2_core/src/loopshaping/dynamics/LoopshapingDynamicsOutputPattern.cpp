@@ -36,8 +36,8 @@ vector_t LoopshapingDynamicsOutputPattern::filterFlowmap(const vector_t& x_filte
   if (loopshapingDefinition_->isDiagonal()) {
     return r_filter.getAdiag().diagonal().cwiseProduct(x_filter) + r_filter.getBdiag().diagonal().cwiseProduct(u_system);
   } else {
-    vector_t dynamics_filter = r_filter.getA() * x_filter;
-    dynamics_filter.noalias() += r_filter.getB() * u_system;
+    vector_t dynamics_filter;
+    r_filter.computeStateDerivative(x_filter, u_system, dynamics_filter);
     return dynamics_filter;
   }
 }
@@ -50,7 +50,7 @@ VectorFunctionLinearApproximation LoopshapingDynamicsOutputPattern::linearApprox
   const auto& u_system = preCompLS.getSystemInput();
   const auto& x_filter = preCompLS.getFilterState();
   const auto& u_filter = preCompLS.getFilteredInput();
-  const auto dynamics_system = systemDynamics_->linearApproximation(t, x_system, u_system);
+  const auto dynamics_system = systemDynamics_->linearApproximation(t, x_system, u_system, preCompLS.getSystemPreComputation());
 
   const auto stateDim = x.rows();
   const auto inputDim = u.rows();
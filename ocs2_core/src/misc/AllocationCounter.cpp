@@ -0,0 +1,92 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_core/misc/AllocationCounter.h"
+
+#include <atomic>
+
+namespace ocs2 {
+namespace benchmark {
+namespace allocation_counter {
+
+namespace {
+// plain thread-local counters without constructors, such that they can be used while a thread is started or destroyed
+thread_local size_t threadNumAllocations = 0;
+thread_local size_t threadNumAllocatedBytes = 0;
+std::atomic<size_t> numAllocations{0};
+std::atomic<bool> enabled{false};
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool isEnabled() noexcept {
+  return enabled.load(std::memory_order_relaxed);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t getThreadNumAllocations() noexcept {
+  return threadNumAllocations;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t getThreadNumAllocatedBytes() noexcept {
+  return threadNumAllocatedBytes;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t getNumAllocations() noexcept {
+  return numAllocations.load(std::memory_order_relaxed);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void recordAllocation(size_t numBytes) noexcept {
+  ++threadNumAllocations;
+  threadNumAllocatedBytes += numBytes;
+  numAllocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void enable() noexcept {
+  enabled.store(true, std::memory_order_relaxed);
+}
+
+}  // namespace allocation_counter
+}  // namespace benchmark
+}  // namespace ocs2
@@ -0,0 +1,411 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_core/misc/Benchmark.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <utility>
+
+namespace ocs2 {
+namespace benchmark {
+
+struct Profiler::Node {
+  Node(std::string nodeName, Node* parent, size_t maxNumSamples) : name(std::move(nodeName)), parentPtr(parent) {
+    samples.reserve(maxNumSamples);
+  }
+
+  Node* getChild(const char* childName, size_t length, size_t maxNumSamples) {
+    for (auto& childPtr : children) {
+      if (childPtr->name.compare(0, std::string::npos, childName, length) == 0) {
+        return childPtr.get();
+      }
+    }
+    children.emplace_back(new Node(std::string(childName, length), this, maxNumSamples));
+    return children.back().get();
+  }
+
+  void record(std::chrono::nanoseconds duration, size_t numScopeAllocations, const PerfCounterValues& scopePerfCounters) {
+    numCalls++;
+    numAllocations += numScopeAllocations;
+    perfCounters += scopePerfCounters;
+    total += duration;
+    max = std::max(max, duration);
+    if (samples.size() < samples.capacity()) {
+      samples.push_back(duration.count());
+    } else if (!samples.empty()) {
+      samples[nextSample] = duration.count();
+      nextSample = (nextSample + 1) % samples.size();
+    }
+  }
+
+  void reset() {
+    numCalls = 0;
+    numAllocations = 0;
+    perfCounters = PerfCounterValues();
+    total = max = std::chrono::nanoseconds::zero();
+    samples.clear();
+    nextSample = 0;
+    for (auto& childPtr : children) {
+      childPtr->reset();
+    }
+  }
+
+  const std::string name;
+  Node* const parentPtr;
+  std::vector<std::unique_ptr<Node>> children;
+
+  size_t numCalls = 0;
+  size_t numAllocations = 0;
+  PerfCounterValues perfCounters;
+  std::chrono::nanoseconds total = std::chrono::nanoseconds::zero();
+  std::chrono::nanoseconds max = std::chrono::nanoseconds::zero();
+  std::vector<int64_t> samples;  // ring buffer of the latest durations in nanoseconds
+  size_t nextSample = 0;
+};
+
+struct Profiler::ThreadBuffer {
+  explicit ThreadBuffer(size_t index) : workerIndex(index), root("", nullptr, 0), currentPtr(&root) {}
+
+  const size_t workerIndex;
+  Node root;
+  Node* currentPtr;
+};
+
+namespace {
+
+scalar_t toMilliseconds(std::chrono::nanoseconds duration) {
+  return std::chrono::duration<scalar_t, std::milli>(duration).count();
+}
+
+/** The nearest-rank percentile of the sorted samples */
+scalar_t percentileInMilliseconds(const std::vector<int64_t>& sortedSamples, scalar_t fraction) {
+  if (sortedSamples.empty()) {
+    return 0.0;
+  }
+  const auto rank = static_cast<size_t>(std::ceil(fraction * sortedSamples.size()));
+  const auto index = std::min(std::max(rank, size_t(1)), sortedSamples.size()) - 1;
+  return toMilliseconds(std::chrono::nanoseconds(sortedSamples[index]));
+}
+
+/** The statistics of a scope before the percentiles are computed */
+struct Accumulator {
+  Profiler::Statistics statistics;
+  std::chrono::nanoseconds total = std::chrono::nanoseconds::zero();
+  std::chrono::nanoseconds max = std::chrono::nanoseconds::zero();
+  std::vector<int64_t> samples;
+
+  Profiler::Statistics finalize() {
+    std::sort(samples.begin(), samples.end());
+    statistics.totalInMilliseconds = toMilliseconds(total);
+    statistics.averageInMilliseconds = statistics.numCalls > 0 ? statistics.totalInMilliseconds / statistics.numCalls : 0.0;
+    statistics.p50InMilliseconds = percentileInMilliseconds(samples, 0.5);
+    statistics.p99InMilliseconds = percentileInMilliseconds(samples, 0.99);
+    statistics.maxInMilliseconds = toMilliseconds(max);
+    return statistics;
+  }
+};
+
+/** Appends the accumulators of the visited scopes of the tree in depth-first order. */
+void collect(const Profiler::Node& node, const std::string& path, size_t workerIndex, std::vector<Accumulator>& accumulators) {
+  for (const auto& childPtr : node.children) {
+    const auto& child = *childPtr;
+    const std::string childPath = path.empty() ? child.name : path + '/' + child.name;
+    if (child.numCalls > 0) {
+      Accumulator accumulator;
+      accumulator.statistics.path = childPath;
+      accumulator.statistics.workerIndex = workerIndex;
+      accumulator.statistics.numCalls = child.numCalls;
+      accumulator.statistics.numAllocations = child.numAllocations;
+      accumulator.statistics.perfCounters = child.perfCounters;
+      accumulator.total = child.total;
+      accumulator.max = child.max;
+      accumulator.samples = child.samples;
+      accumulators.push_back(std::move(accumulator));
+    }
+    collect(child, childPath, workerIndex, accumulators);
+  }
+}
+
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+Profiler::Scope::Scope(Profiler& profiler, const char* name)
+    : bufferPtr_(&profiler.getThreadBuffer()),
+      nodePtr_(bufferPtr_->currentPtr->getChild(name, std::strlen(name), profiler.maxNumSamples_)),
+      previousNodePtr_(bufferPtr_->currentPtr),
+      tracerPtr_(profiler.getTracer()),
+      name_(name) {
+  bufferPtr_->currentPtr = nodePtr_;
+  startNumAllocations_ = allocation_counter::getThreadNumAllocations();
+  startPerfCounters_ = perf_counters::readThreadCounters();
+  startTime_ = std::chrono::steady_clock::now();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+Profiler::Scope::Scope(Profiler& profiler, const char* name, const char* parentPath)
+    : bufferPtr_(&profiler.getThreadBuffer()),
+      nodePtr_(nullptr),
+      previousNodePtr_(bufferPtr_->currentPtr),
+      tracerPtr_(profiler.getTracer()),
+      name_(name) {
+  Node* parentNodePtr = &bufferPtr_->root;
+  const char* segment = parentPath;
+  while (*segment != '\0') {
+    const char* segmentEnd = std::strchr(segment, '/');
+    const size_t length = (segmentEnd != nullptr) ? segmentEnd - segment : std::strlen(segment);
+    parentNodePtr = parentNodePtr->getChild(segment, length, profiler.maxNumSamples_);
+    segment += (segmentEnd != nullptr) ? length + 1 : length;
+  }
+  nodePtr_ = parentNodePtr->getChild(name, std::strlen(name), profiler.maxNumSamples_);
+  bufferPtr_->currentPtr = nodePtr_;
+  startNumAllocations_ = allocation_counter::getThreadNumAllocations();
+  startPerfCounters_ = perf_counters::readThreadCounters();
+  startTime_ = std::chrono::steady_clock::now();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+Profiler::Scope::~Scope() {
+  const auto endTime = std::chrono::steady_clock::now();
+  const auto perfCounters = perf_counters::readThreadCounters() - startPerfCounters_;
+  const size_t numAllocations = allocation_counter::getThreadNumAllocations() - startNumAllocations_;
+  nodePtr_->record(std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime_), numAllocations, perfCounters);
+  bufferPtr_->currentPtr = previousNodePtr_;
+  if (tracerPtr_ != nullptr) {
+    tracerPtr_->addEvent(name_, startTime_, endTime);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+Profiler::Profiler(size_t maxNumSamples) : id_(getUniqueId()), maxNumSamples_(maxNumSamples) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+Profiler::~Profiler() = default;
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+uint64_t Profiler::getUniqueId() {
+  static std::atomic<uint64_t> counter(0);
+  return ++counter;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+Profiler::ThreadBuffer& Profiler::getThreadBuffer() {
+  // a small cache of the buffers of this thread. The ids of the profilers are never reused, so entries of deleted profilers are not hit.
+  constexpr size_t maxCacheSize = 16;
+  thread_local std::vector<std::pair<uint64_t, ThreadBuffer*>> cache;
+  for (const auto& entry : cache) {
+    if (entry.first == id_) {
+      return *entry.second;
+    }
+  }
+
+  ThreadBuffer* bufferPtr;
+  {
+    std::lock_guard<std::mutex> lock(threadBuffersMutex_);
+    threadBuffers_.emplace_back(new ThreadBuffer(threadBuffers_.size()));
+    bufferPtr = threadBuffers_.back().get();
+  }
+  if (cache.size() == maxCacheSize) {
+    cache.erase(cache.begin());
+  }
+  cache.emplace_back(id_, bufferPtr);
+  return *bufferPtr;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void Profiler::reset() {
+  std::lock_guard<std::mutex> lock(threadBuffersMutex_);
+  for (auto& bufferPtr : threadBuffers_) {
+    bufferPtr->root.reset();
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::vector<Profiler::Statistics> Profiler::getWorkerStatistics() const {
+  std::vector<Accumulator> accumulators;
+  {
+    std::lock_guard<std::mutex> lock(threadBuffersMutex_);
+    for (const auto& bufferPtr : threadBuffers_) {
+      collect(bufferPtr->root, "", bufferPtr->workerIndex, accumulators);
+    }
+  }
+
+  std::vector<Statistics> statistics;
+  statistics.reserve(accumulators.size());
+  for (auto& accumulator : accumulators) {
+    statistics.push_back(accumulator.finalize());
+  }
+  return statistics;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::vector<Profiler::Statistics> Profiler::getStatistics() const {
+  std::vector<Accumulator> accumulators;
+  {
+    std::lock_guard<std::mutex> lock(threadBuffersMutex_);
+    for (const auto& bufferPtr : threadBuffers_) {
+      std::vector<Accumulator> workerAccumulators;
+      collect(bufferPtr->root, "", bufferPtr->workerIndex, workerAccumulators);
+
+      // merge by path, keeping the order of the first visit
+      for (auto& workerAccumulator : workerAccumulators) {
+        auto it = std::find_if(accumulators.begin(), accumulators.end(), [&](const Accumulator& accumulator) {
+          return accumulator.statistics.path == workerAccumulator.statistics.path;
+        });
+        if (it == accumulators.end()) {
+          accumulators.push_back(std::move(workerAccumulator));
+        } else {
+          it->statistics.numCalls += workerAccumulator.statistics.numCalls;
+          it->statistics.numAllocations += workerAccumulator.statistics.numAllocations;
+          it->statistics.perfCounters += workerAccumulator.statistics.perfCounters;
+          it->total += workerAccumulator.total;
+          it->max = std::max(it->max, workerAccumulator.max);
+          it->samples.insert(it->samples.end(), workerAccumulator.samples.begin(), workerAccumulator.samples.end());
+        }
+      }
+    }
+  }
+
+  std::vector<Statistics> statistics;
+  statistics.reserve(accumulators.size());
+  for (auto& accumulator : accumulators) {
+    statistics.push_back(accumulator.finalize());
+  }
+  return statistics;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+Profiler::Statistics Profiler::getStatistics(const std::string& path) const {
+  for (auto& statistics : getStatistics()) {
+    if (statistics.path == path) {
+      return statistics;
+    }
+  }
+  Statistics statistics;
+  statistics.path = path;
+  return statistics;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::string Profiler::getReport() const {
+  const auto mergedStatistics = getStatistics();
+  const auto workerStatistics = getWorkerStatistics();
+
+  constexpr int nameWidth = 40;
+  constexpr int width = 12;
+  const bool showAllocations = allocation_counter::isEnabled();
+  const bool showPerfCounters = perf_counters::isEnabled();
+  auto printRow = [&](std::ostream& stream, const std::string& name, const Statistics& statistics) {
+    stream << std::left << std::setw(nameWidth) << name << std::right << std::setw(width) << statistics.numCalls << std::setw(width)
+           << statistics.totalInMilliseconds << std::setw(width) << statistics.averageInMilliseconds << std::setw(width)
+           << statistics.p50InMilliseconds << std::setw(width) << statistics.p99InMilliseconds << std::setw(width)
+           << statistics.maxInMilliseconds;
+    if (showAllocations) {
+      stream << std::setw(width) << statistics.numAllocations;
+    }
+    if (showPerfCounters) {
+      const auto& counters = statistics.perfCounters;
+      const scalar_t numCalls = std::max(statistics.numCalls, size_t(1));
+      stream << std::setw(width) << (counters.cycles > 0 ? static_cast<scalar_t>(counters.instructions) / counters.cycles : 0.0)
+             << std::setw(width) << counters.llcMisses / numCalls << std::setw(width) << counters.branchMisses / numCalls;
+    }
+    stream << '\n';
+  };
+
+  std::stringstream infoStream;
+  infoStream << std::fixed << std::setprecision(3);
+  infoStream << std::left << std::setw(nameWidth) << "Scope" << std::right << std::setw(width) << "Calls" << std::setw(width)
+             << "Total [ms]" << std::setw(width) << "Avg [ms]" << std::setw(width) << "p50 [ms]" << std::setw(width) << "p99 [ms]"
+             << std::setw(width) << "Max [ms]";
+  if (showAllocations) {
+    infoStream << std::setw(width) << "Allocs";
+  }
+  if (showPerfCounters) {
+    infoStream << std::setw(width) << "IPC" << std::setw(width) << "LLC/call" << std::setw(width) << "BrMiss/call";
+  }
+  infoStream << '\n';
+  for (const auto& statistics : mergedStatistics) {
+    const auto depth = std::count(statistics.path.begin(), statistics.path.end(), '/');
+    const auto nameStart = statistics.path.find_last_of('/');
+    const auto name = (nameStart == std::string::npos) ? statistics.path : statistics.path.substr(nameStart + 1);
+    printRow(infoStream, std::string(2 * depth, ' ') + name, statistics);
+  }
+
+  // per-worker breakdown of the scopes which are visited by several threads
+  bool hasHeader = false;
+  for (const auto& statistics : mergedStatistics) {
+    const auto numWorkers = std::count_if(workerStatistics.begin(), workerStatistics.end(),
+                                          [&](const Statistics& worker) { return worker.path == statistics.path; });
+    if (numWorkers < 2) {
+      continue;
+    }
+    if (!hasHeader) {
+      infoStream << "Per-worker breakdown:\n";
+      hasHeader = true;
+    }
+    for (const auto& worker : workerStatistics) {
+      if (worker.path == statistics.path) {
+        printRow(infoStream, statistics.path + " [worker " + std::to_string(worker.workerIndex) + "]", worker);
+      }
+    }
+  }
+
+  return infoStream.str();
+}
+
+}  // namespace benchmark
+}  // namespace ocs2
@@ -0,0 +1,127 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_core/misc/Footprint.h"
+
+#include <algorithm>
+
+namespace ocs2 {
+
+namespace {
+
+/** Sorts the blocks and merges the overlapping and touching ones. */
+void mergeBlocks(std::vector<IndexBlock>& blocks) {
+  std::sort(blocks.begin(), blocks.end(), [](const IndexBlock& lhs, const IndexBlock& rhs) { return lhs.start < rhs.start; });
+
+  size_t numMerged = 0;
+  for (const auto& block : blocks) {
+    if (block.size == 0) {
+      continue;
+    }
+    if (numMerged > 0 && block.start <= blocks[numMerged - 1].start + blocks[numMerged - 1].size) {
+      auto& last = blocks[numMerged - 1];
+      last.size = std::max(last.start + last.size, block.start + block.size) - last.start;
+    } else {
+      blocks[numMerged++] = block;
+    }
+  }
+  blocks.resize(numMerged);
+}
+
+std::vector<IndexBlock> indicesToBlocks(const std::vector<size_t>& indices) {
+  std::vector<IndexBlock> blocks;
+  blocks.reserve(indices.size());
+  for (const auto i : indices) {
+    blocks.push_back({i, 1});
+  }
+  mergeBlocks(blocks);
+  return blocks;
+}
+
+void addBlock(const matrix_t& source, const IndexBlock& row, const IndexBlock& col, matrix_t& destination) {
+  destination.block(row.start, col.start, row.size, col.size) += source.block(row.start, col.start, row.size, col.size);
+}
+
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+Footprint Footprint::fromIndices(std::vector<size_t> stateIndices, std::vector<size_t> inputIndices) {
+  Footprint footprint;
+  footprint.stateBlocks = indicesToBlocks(stateIndices);
+  footprint.inputBlocks = indicesToBlocks(inputIndices);
+  return footprint;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void addFootprintBlocks(const Footprint& footprint, const ScalarFunctionQuadraticApproximation& approximation,
+                        ScalarFunctionQuadraticApproximation& accumulator) {
+  accumulator.f += approximation.f;
+
+  for (const auto& row : footprint.stateBlocks) {
+    accumulator.dfdx.segment(row.start, row.size) += approximation.dfdx.segment(row.start, row.size);
+    for (const auto& col : footprint.stateBlocks) {
+      addBlock(approximation.dfdxx, row, col, accumulator.dfdxx);
+    }
+  }
+
+  for (const auto& row : footprint.inputBlocks) {
+    accumulator.dfdu.segment(row.start, row.size) += approximation.dfdu.segment(row.start, row.size);
+    for (const auto& col : footprint.stateBlocks) {
+      addBlock(approximation.dfdux, row, col, accumulator.dfdux);
+    }
+    for (const auto& col : footprint.inputBlocks) {
+      addBlock(approximation.dfduu, row, col, accumulator.dfduu);
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void writeFootprintBlocks(const Footprint& footprint, const VectorFunctionLinearApproximation& approximation, size_t startRow,
+                          VectorFunctionLinearApproximation& stackedApproximation) {
+  const size_t nc = approximation.f.rows();
+  stackedApproximation.f.segment(startRow, nc) = approximation.f;
+
+  stackedApproximation.dfdx.middleRows(startRow, nc).setZero();
+  for (const auto& col : footprint.stateBlocks) {
+    stackedApproximation.dfdx.block(startRow, col.start, nc, col.size) = approximation.dfdx.middleCols(col.start, col.size);
+  }
+
+  stackedApproximation.dfdu.middleRows(startRow, nc).setZero();
+  for (const auto& col : footprint.inputBlocks) {
+    stackedApproximation.dfdu.block(startRow, col.start, nc, col.size) = approximation.dfdu.middleCols(col.start, col.size);
+  }
+}
+
+}  // namespace ocs2
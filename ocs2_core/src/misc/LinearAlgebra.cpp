@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/misc/LinearAlgebra.h>
 
+#include <stdexcept>
+
 namespace ocs2 {
 namespace LinearAlgebra {
 
@@ -38,7 +40,7 @@ namespace LinearAlgebra {
 void makePsdEigenvalue(matrix_t& squareMatrix, scalar_t minEigenvalue) {
   assert(squareMatrix.rows() == squareMatrix.cols());
 
-  Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> eig(squareMatrix, Eigen::EigenvaluesOnly);
+  Eigen::SelfAdjointEigenSolver<matrix_t> eig(squareMatrix, Eigen::EigenvaluesOnly);
   vector_t lambda = eig.eigenvalues();
 
   bool hasNegativeEigenValue = false;
@@ -51,7 +53,8 @@ void makePsdEigenvalue(matrix_t& squareMatrix, scalar_t minEigenvalue) {
 
   if (hasNegativeEigenValue) {
     eig.compute(squareMatrix, Eigen::ComputeEigenvectors);
-    squareMatrix = eig.eigenvectors() * lambda.asDiagonal() * eig.eigenvectors().inverse();
+    // the eigenvectors of a self-adjoint matrix are orthonormal
+    squareMatrix.noalias() = eig.eigenvectors() * lambda.asDiagonal() * eig.eigenvectors().transpose();
   } else {
     squareMatrix = 0.5 * (squareMatrix + squareMatrix.transpose()).eval();
   }
@@ -86,6 +89,44 @@ void makePsdCholesky(matrix_t& A, scalar_t minEigenvalue) {
   A.diagonal().array() += minEigenvalue;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void makePsdCholeskyShift(matrix_t& A, scalar_t minEigenvalue) {
+  assert(A.rows() == A.cols());
+  if (A.size() == 0) {
+    return;
+  }
+
+  if (!A.allFinite()) {
+    throw std::runtime_error("[LinearAlgebra::makePsdCholeskyShift] The matrix contains NaN or Inf!");
+  }
+
+  thread_local matrix_t shiftedMatrix;
+  thread_local Eigen::LLT<matrix_t> llt;
+
+  A = 0.5 * (A + A.transpose()).eval();
+
+  // the initial shift only makes the diagonal positive, the minimum shift on failure is relative to the scale of the diagonal
+  const scalar_t minDiagonal = A.diagonal().minCoeff() - minEigenvalue;
+  const scalar_t minShift = std::max(scalar_t(1e-3) * A.diagonal().cwiseAbs().maxCoeff(), numeric_traits::limitEpsilon<scalar_t>());
+  scalar_t shift = (minDiagonal > 0.0) ? 0.0 : minShift - minDiagonal;
+  // the shift is bounded by the Gershgorin radius, hence the doubling terminates long before the cap unless the scales are extreme
+  constexpr size_t maxNumDoublings = 100;
+  for (size_t i = 0; i < maxNumDoublings; i++) {
+    shiftedMatrix = A;
+    shiftedMatrix.diagonal().array() += shift - minEigenvalue;
+    llt.compute(shiftedMatrix);
+    if (llt.info() == Eigen::Success) {
+      A.diagonal().array() += shift;
+      return;
+    }
+    shift = std::max(scalar_t(2.0) * shift, minShift);
+  }
+
+  makePsdEigenvalue(A, minEigenvalue);
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -119,7 +160,7 @@ void computeConstraintProjection(const matrix_t& Dm, const matrix_t& RmInvUmUmT,
 
 // Explicit instantiations for dynamic sized matrices
 template int rank(const matrix_t& A);
-template Eigen::VectorXcd eigenvalues(const matrix_t& A);
+template Eigen::Matrix<std::complex<scalar_t>, Eigen::Dynamic, 1> eigenvalues(const matrix_t& A);
 template vector_t symmetricEigenvalues(const matrix_t& A);
 
 }  // namespace LinearAlgebra
@@ -0,0 +1,212 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_core/misc/LoadData.h"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+#include <sys/stat.h>
+
+namespace ocs2 {
+namespace loadData {
+
+namespace {
+
+constexpr char BUNDLE_MAGIC[8] = {'O', 'C', 'S', '2', 'I', 'N', 'F', 'O'};
+constexpr uint32_t BUNDLE_VERSION = 1;
+
+/** The parsed INFO file and the state of the file when it was parsed. */
+struct CacheEntry {
+  std::shared_ptr<const boost::property_tree::ptree> ptPtr;
+  bool isBundled = false;
+  int64_t modificationTime = 0;
+  int64_t size = 0;
+  uint64_t inode = 0;
+};
+
+struct Cache {
+  std::mutex mutex;
+  std::unordered_map<std::string, CacheEntry> entries;
+};
+
+Cache& getCache() {
+  static Cache cache;
+  return cache;
+}
+
+void writeString(std::ostream& stream, const std::string& string) {
+  const uint64_t size = string.size();
+  stream.write(reinterpret_cast<const char*>(&size), sizeof(size));
+  stream.write(string.data(), size);
+}
+
+std::string readString(std::istream& stream) {
+  uint64_t size = 0;
+  stream.read(reinterpret_cast<char*>(&size), sizeof(size));
+  std::string string(stream ? size : 0, '\0');
+  stream.read(&string[0], string.size());
+  return string;
+}
+
+void writeTree(std::ostream& stream, const boost::property_tree::ptree& pt) {
+  writeString(stream, pt.data());
+  const uint64_t numChildren = pt.size();
+  stream.write(reinterpret_cast<const char*>(&numChildren), sizeof(numChildren));
+  for (const auto& child : pt) {
+    writeString(stream, child.first);
+    writeTree(stream, child.second);
+  }
+}
+
+void readTree(std::istream& stream, boost::property_tree::ptree& pt) {
+  pt.data() = readString(stream);
+  uint64_t numChildren = 0;
+  stream.read(reinterpret_cast<char*>(&numChildren), sizeof(numChildren));
+  for (uint64_t i = 0; i < numChildren && stream; i++) {
+    const auto key = readString(stream);
+    readTree(stream, pt.push_back({key, boost::property_tree::ptree()})->second);
+  }
+}
+
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::shared_ptr<const boost::property_tree::ptree> readInfoFile(const std::string& filename) {
+  auto& cache = getCache();
+  std::lock_guard<std::mutex> lock(cache.mutex);
+
+  auto& entry = cache.entries[filename];
+  if (entry.isBundled) {
+    return entry.ptPtr;
+  }
+
+  // if the file can not be accessed, read_info throws the corresponding error
+  struct stat fileStat;
+  if (stat(filename.c_str(), &fileStat) == 0) {
+    const int64_t modificationTime = static_cast<int64_t>(fileStat.st_mtim.tv_sec) * 1000000000 + fileStat.st_mtim.tv_nsec;
+    if (entry.ptPtr != nullptr && entry.modificationTime == modificationTime && entry.size == fileStat.st_size &&
+        entry.inode == fileStat.st_ino) {
+      return entry.ptPtr;
+    }
+    entry.modificationTime = modificationTime;
+    entry.size = fileStat.st_size;
+    entry.inode = fileStat.st_ino;
+  }
+
+  std::unique_ptr<boost::property_tree::ptree> ptPtr(new boost::property_tree::ptree);
+  try {
+    boost::property_tree::read_info(filename, *ptPtr);
+  } catch (...) {
+    cache.entries.erase(filename);
+    throw;
+  }
+  entry.ptPtr = std::move(ptPtr);
+  return entry.ptPtr;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void clearInfoFileCache() {
+  auto& cache = getCache();
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  cache.entries.clear();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void saveSettingsBundle(const std::string& bundleFile, const std::vector<std::string>& filenames) {
+  std::ofstream stream(bundleFile, std::ios::binary);
+  if (!stream) {
+    throw std::runtime_error("[saveSettingsBundle] Could not open file \"" + bundleFile + "\".");
+  }
+
+  stream.write(BUNDLE_MAGIC, sizeof(BUNDLE_MAGIC));
+  stream.write(reinterpret_cast<const char*>(&BUNDLE_VERSION), sizeof(BUNDLE_VERSION));
+  const uint64_t numFiles = filenames.size();
+  stream.write(reinterpret_cast<const char*>(&numFiles), sizeof(numFiles));
+  for (const auto& filename : filenames) {
+    writeString(stream, filename);
+    writeTree(stream, *readInfoFile(filename));
+  }
+
+  if (!stream) {
+    throw std::runtime_error("[saveSettingsBundle] Could not write file \"" + bundleFile + "\".");
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void loadSettingsBundle(const std::string& bundleFile) {
+  std::ifstream stream(bundleFile, std::ios::binary);
+  if (!stream) {
+    throw std::runtime_error("[loadSettingsBundle] Could not open file \"" + bundleFile + "\".");
+  }
+
+  char magic[sizeof(BUNDLE_MAGIC)];
+  uint32_t version = 0;
+  stream.read(magic, sizeof(magic));
+  stream.read(reinterpret_cast<char*>(&version), sizeof(version));
+  if (!stream || std::memcmp(magic, BUNDLE_MAGIC, sizeof(BUNDLE_MAGIC)) != 0 || version != BUNDLE_VERSION) {
+    throw std::runtime_error("[loadSettingsBundle] \"" + bundleFile + "\" is not a settings bundle of this version.");
+  }
+
+  uint64_t numFiles = 0;
+  stream.read(reinterpret_cast<char*>(&numFiles), sizeof(numFiles));
+  std::vector<std::pair<std::string, std::shared_ptr<const boost::property_tree::ptree>>> bundledFiles;
+  for (uint64_t i = 0; i < numFiles && stream; i++) {
+    auto filename = readString(stream);
+    std::unique_ptr<boost::property_tree::ptree> ptPtr(new boost::property_tree::ptree);
+    readTree(stream, *ptPtr);
+    bundledFiles.emplace_back(std::move(filename), std::move(ptPtr));
+  }
+  if (!stream) {
+    throw std::runtime_error("[loadSettingsBundle] The settings bundle \"" + bundleFile + "\" is truncated.");
+  }
+
+  auto& cache = getCache();
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  for (auto& file : bundledFiles) {
+    auto& entry = cache.entries[file.first];
+    entry.ptPtr = std::move(file.second);
+    entry.isBundled = true;
+  }
+}
+
+}  // namespace loadData
+}  // namespace ocs2
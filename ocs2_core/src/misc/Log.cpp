@@ -27,14 +27,20 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <iomanip>
 #include <memory>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
 #include <boost/log/core.hpp>
 
 #include <boost/core/null_deleter.hpp>
 #include <boost/log/expressions.hpp>
+#include <boost/log/sinks/sink.hpp>
 #include <boost/log/sinks/sync_frontend.hpp>
 #include <boost/log/sinks/text_file_backend.hpp>
 #include <boost/log/sinks/text_ostream_backend.hpp>
@@ -55,10 +61,171 @@ namespace log {
 using text_sink_t = boost::log::sinks::synchronous_sink<boost::log::sinks::text_ostream_backend>;
 using file_sink_t = boost::log::sinks::synchronous_sink<boost::log::sinks::text_file_backend>;
 
+BOOST_LOG_ATTRIBUTE_KEYWORD(severity, "Severity", SeverityLevel);
+
+namespace {
+
+/**
+ * Bounded multi-producer single-consumer ring buffer. Each cell carries a sequence number which tells the producers whether the cell
+ * is free and the consumer whether it is written, such that pushing never locks and fails instead of blocking when the buffer is full.
+ */
+template <typename T>
+class BoundedRingBuffer {
+ public:
+  explicit BoundedRingBuffer(size_t capacity) : capacity_(roundUpToPowerOfTwo(capacity)), cells_(new Cell[capacity_]) {
+    for (size_t i = 0; i < capacity_; i++) {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  /** Thread-safe, returns false if the buffer is full. */
+  bool tryPush(const T& value) {
+    size_t position = pushPosition_.load(std::memory_order_relaxed);
+    Cell* cell;
+    while (true) {
+      cell = &cells_[position & (capacity_ - 1)];
+      const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+      const auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+      if (difference == 0) {
+        if (pushPosition_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (difference < 0) {
+        return false;
+      } else {
+        position = pushPosition_.load(std::memory_order_relaxed);
+      }
+    }
+    cell->value = value;
+    cell->sequence.store(position + 1, std::memory_order_release);
+    return true;
+  }
+
+  /** Must only be called by the single consumer thread, returns false if the buffer is empty. */
+  bool tryPop(T& value) {
+    Cell& cell = cells_[popPosition_ & (capacity_ - 1)];
+    if (cell.sequence.load(std::memory_order_acquire) != popPosition_ + 1) {
+      return false;
+    }
+    value = std::move(cell.value);
+    cell.value = T();
+    cell.sequence.store(popPosition_ + capacity_, std::memory_order_release);
+    popPosition_++;
+    return true;
+  }
+
+ private:
+  struct Cell {
+    std::atomic<size_t> sequence;
+    T value;
+  };
+
+  static size_t roundUpToPowerOfTwo(size_t n) {
+    size_t powerOfTwo = 1;
+    while (powerOfTwo < n) {
+      powerOfTwo <<= 1;
+    }
+    return powerOfTwo;
+  }
+
+  const size_t capacity_;
+  std::unique_ptr<Cell[]> cells_;
+  std::atomic<size_t> pushPosition_{0};
+  size_t popPosition_ = 0;
+};
+
+/**
+ * Sink which queues the records in a lock-free ring buffer and forwards them to the synchronous sinks on a background thread. The
+ * records which do not fit into the full buffer are dropped and counted.
+ */
+class AsynchronousSink : public boost::log::sinks::sink {
+ public:
+  AsynchronousSink(size_t bufferSize, SeverityLevel minSeverity, std::vector<std::shared_ptr<boost::log::sinks::sink>> sinks)
+      : boost::log::sinks::sink(true), minSeverity_(minSeverity), sinks_(std::move(sinks)), buffer_(bufferSize) {
+    worker_ = std::thread([this]() { run(); });
+  }
+
+  /** Writes the remaining buffered records before returning. */
+  ~AsynchronousSink() override {
+    stop_ = true;
+    worker_.join();
+  }
+
+  bool will_consume(const boost::log::attribute_value_set& attributes) override {
+    const auto lvl = boost::log::extract<SeverityLevel>(severity.get_name(), attributes);
+    return !lvl || lvl.get() >= minSeverity_;
+  }
+
+  void consume(const boost::log::record_view& rec) override {
+    if (buffer_.tryPush(rec)) {
+      numPushedRecords_++;
+    } else {
+      numDroppedRecords_++;
+    }
+  }
+
+  bool try_consume(const boost::log::record_view& rec) override {
+    consume(rec);
+    return true;
+  }
+
+  /** Waits until the records pushed before the call are written and flushes the sinks. */
+  void flush() override {
+    const size_t numPushedRecords = numPushedRecords_;
+    while (numWrittenRecords_ < numPushedRecords) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    for (const auto& sink : sinks_) {
+      sink->flush();
+    }
+  }
+
+  size_t getNumDroppedRecords() const { return numDroppedRecords_; }
+
+ private:
+  void run() {
+    boost::log::record_view rec;
+    while (true) {
+      // read the stop flag before draining, such that the records pushed before the stop are written
+      const bool stop = stop_;
+      bool hasWritten = false;
+      while (buffer_.tryPop(rec)) {
+        for (const auto& sink : sinks_) {
+          if (sink->will_consume(rec.attribute_values())) {
+            sink->consume(rec);
+          }
+        }
+        rec = boost::log::record_view();
+        numWrittenRecords_++;
+        hasWritten = true;
+      }
+      if (hasWritten) {
+        for (const auto& sink : sinks_) {
+          sink->flush();
+        }
+      }
+      if (stop) {
+        break;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+
+  const SeverityLevel minSeverity_;
+  const std::vector<std::shared_ptr<boost::log::sinks::sink>> sinks_;
+  BoundedRingBuffer<boost::log::record_view> buffer_;
+  std::atomic_bool stop_{false};
+  std::atomic<size_t> numPushedRecords_{0};
+  std::atomic<size_t> numWrittenRecords_{0};
+  std::atomic<size_t> numDroppedRecords_{0};
+  std::thread worker_;
+};
+
+}  // unnamed namespace
+
 static std::shared_ptr<text_sink_t> consoleSink_;
 static std::shared_ptr<file_sink_t> fileSink_;
-
-BOOST_LOG_ATTRIBUTE_KEYWORD(severity, "Severity", SeverityLevel);
+static boost::shared_ptr<AsynchronousSink> asynchronousSink_;
 
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -83,8 +250,8 @@ SeverityLevel fromString(const std::string& severity) {
 /******************************************************************************************************/
 Settings loadSettings(const std::string& fileName, const std::string& fieldName) {
   Settings settings;
-  boost::property_tree::ptree pt;
-  boost::property_tree::read_info(fileName, pt);
+  const auto ptPtr = loadData::readInfoFile(fileName);
+  const boost::property_tree::ptree& pt = *ptPtr;
 
   loadData::loadPtreeValue(pt, settings.useConsole, fieldName + ".useConsole", false);
 
@@ -99,6 +266,8 @@ Settings loadSettings(const std::string& fileName, const std::string& fieldName)
   settings.logFileSeverity = fromString(logFileSeverity);
 
   loadData::loadPtreeValue(pt, settings.logFileName, fieldName + ".logFileName", false);
+  loadData::loadPtreeValue(pt, settings.asynchronous, fieldName + ".asynchronous", false);
+  loadData::loadPtreeValue(pt, settings.asynchronousBufferSize, fieldName + ".asynchronousBufferSize", false);
 
   return settings;
 }
@@ -115,6 +284,8 @@ std::ostream& operator<<(std::ostream& stream, const Settings& settings) {
   loadData::printValue(stream, settings.useLogFile, "useLogFile");
   loadData::printValue(stream, settings.logFileSeverity, "logFileSeverity");
   loadData::printValue(stream, settings.logFileName, "logFileName");
+  loadData::printValue(stream, settings.asynchronous, "asynchronous");
+  loadData::printValue(stream, settings.asynchronousBufferSize, "asynchronousBufferSize");
 
   stream << " #### =============================================================================\n";
   return stream;
@@ -137,7 +308,9 @@ void init(const Settings& settings, std::ostream* console_stream) {
     consoleSink_->set_filter(ocs2::log::severity >= settings.consoleSeverity);
 
     // connect boost::shared_ptr to global consoleSink_
-    core->add_sink(boost::shared_ptr<text_sink_t>(consoleSink_.get(), [=](text_sink_t*) { consoleSink_.reset(); }));
+    if (!settings.asynchronous) {
+      core->add_sink(boost::shared_ptr<text_sink_t>(consoleSink_.get(), [=](text_sink_t*) { consoleSink_.reset(); }));
+    }
   }
 
   if (settings.useLogFile) {
@@ -152,7 +325,25 @@ void init(const Settings& settings, std::ostream* console_stream) {
     fileSink_->set_filter(ocs2::log::severity >= settings.logFileSeverity);
 
     // connect boost::shared_ptr to global fileSink_
-    core->add_sink(boost::shared_ptr<file_sink_t>(fileSink_.get(), [=](file_sink_t*) { fileSink_.reset(); }));
+    if (!settings.asynchronous) {
+      core->add_sink(boost::shared_ptr<file_sink_t>(fileSink_.get(), [=](file_sink_t*) { fileSink_.reset(); }));
+    }
+  }
+
+  // the synchronous sinks are only written by the background thread of the asynchronous sink
+  if (settings.asynchronous && (settings.useConsole || settings.useLogFile)) {
+    std::vector<std::shared_ptr<boost::log::sinks::sink>> sinks;
+    auto minSeverity = SeverityLevel::ERROR;
+    if (settings.useConsole) {
+      sinks.push_back(consoleSink_);
+      minSeverity = std::min(minSeverity, settings.consoleSeverity);
+    }
+    if (settings.useLogFile) {
+      sinks.push_back(fileSink_);
+      minSeverity = std::min(minSeverity, settings.logFileSeverity);
+    }
+    asynchronousSink_ = boost::make_shared<AsynchronousSink>(settings.asynchronousBufferSize, minSeverity, std::move(sinks));
+    core->add_sink(asynchronousSink_);
   }
 
   boost::log::add_common_attributes();
@@ -164,6 +355,12 @@ void init(const Settings& settings, std::ostream* console_stream) {
 void reset() {
   auto core = boost::log::core::get();
 
+  // the background thread stops after writing the buffered records, once the records in flight release the sink
+  if (asynchronousSink_ != nullptr) {
+    core->remove_sink(asynchronousSink_);
+    asynchronousSink_.reset();
+  }
+
   if (consoleSink_ != nullptr) {
     core->remove_sink(boost::shared_ptr<text_sink_t>(consoleSink_.get(), boost::null_deleter()));
     consoleSink_.reset();
@@ -175,6 +372,20 @@ void reset() {
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void flush() {
+  boost::log::core::get()->flush();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t getNumDroppedRecords() {
+  return (asynchronousSink_ != nullptr) ? asynchronousSink_->getNumDroppedRecords() : 0;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
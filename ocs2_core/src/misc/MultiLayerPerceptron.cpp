@@ -0,0 +1,137 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_core/misc/MultiLayerPerceptron.h"
+
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <stdexcept>
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+MultiLayerPerceptron::MultiLayerPerceptron(std::vector<matrix_t> weights, std::vector<vector_t> biases)
+    : weights_(std::move(weights)), biases_(std::move(biases)) {
+  if (weights_.empty() || weights_.size() != biases_.size()) {
+    throw std::runtime_error("[MultiLayerPerceptron] The network requires at least one layer and a bias for each layer!");
+  }
+  for (size_t k = 0; k < weights_.size(); k++) {
+    if (biases_[k].size() != weights_[k].rows()) {
+      throw std::runtime_error("[MultiLayerPerceptron] The bias of layer " + std::to_string(k) + " does not match its weights!");
+    }
+    if (k > 0 && weights_[k].cols() != weights_[k - 1].rows()) {
+      throw std::runtime_error("[MultiLayerPerceptron] The input of layer " + std::to_string(k) + " does not match the previous layer!");
+    }
+  }
+
+  layerOutputs_.reserve(weights_.size());
+  for (const auto& b : biases_) {
+    layerOutputs_.emplace_back(b.size());
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+MultiLayerPerceptron MultiLayerPerceptron::load(const std::string& fileName) {
+  std::ifstream file(fileName);
+  if (!file.is_open()) {
+    throw std::runtime_error("[MultiLayerPerceptron] Could not open the network file " + fileName);
+  }
+
+  size_t numLayers = 0;
+  file >> numLayers;
+  std::vector<matrix_t> weights(numLayers);
+  std::vector<vector_t> biases(numLayers);
+  for (size_t k = 0; k < numLayers; k++) {
+    size_t rows = 0, cols = 0;
+    file >> rows >> cols;
+    weights[k].resize(rows, cols);
+    for (size_t i = 0; i < rows; i++) {
+      for (size_t j = 0; j < cols; j++) {
+        file >> weights[k](i, j);
+      }
+    }
+    biases[k].resize(rows);
+    for (size_t i = 0; i < rows; i++) {
+      file >> biases[k](i);
+    }
+  }
+
+  if (file.fail()) {
+    throw std::runtime_error("[MultiLayerPerceptron] The network file " + fileName + " is malformed!");
+  }
+  return {std::move(weights), std::move(biases)};
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MultiLayerPerceptron::save(const std::string& fileName) const {
+  std::ofstream file(fileName);
+  if (!file.is_open()) {
+    throw std::runtime_error("[MultiLayerPerceptron] Could not open the network file " + fileName);
+  }
+
+  file << std::setprecision(std::numeric_limits<scalar_t>::max_digits10);
+  file << weights_.size() << '\n';
+  for (size_t k = 0; k < weights_.size(); k++) {
+    file << weights_[k].rows() << ' ' << weights_[k].cols() << '\n';
+    for (Eigen::Index i = 0; i < weights_[k].rows(); i++) {
+      file << weights_[k].row(i) << '\n';
+    }
+    file << biases_[k].transpose() << '\n';
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+const vector_t& MultiLayerPerceptron::evaluate(const vector_t& input) {
+  if (static_cast<size_t>(input.size()) != getInputDim()) {
+    throw std::runtime_error("[MultiLayerPerceptron] The input size " + std::to_string(input.size()) + " does not match the network!");
+  }
+
+  const size_t numLayers = weights_.size();
+  for (size_t k = 0; k < numLayers; k++) {
+    const vector_t& layerInput = (k == 0) ? input : layerOutputs_[k - 1];
+    auto& layerOutput = layerOutputs_[k];
+    layerOutput = biases_[k];
+    layerOutput.noalias() += weights_[k] * layerInput;
+    if (k + 1 < numLayers) {
+      layerOutput = layerOutput.array().tanh();
+    }
+  }
+  return layerOutputs_.back();
+}
+
+}  // namespace ocs2
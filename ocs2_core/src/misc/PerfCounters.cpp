@@ -0,0 +1,166 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_core/misc/PerfCounters.h"
+
+#include <atomic>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace ocs2 {
+namespace benchmark {
+namespace perf_counters {
+
+namespace {
+
+std::atomic_bool enabled{false};
+
+#ifdef __linux__
+constexpr int numEvents = 4;
+
+/** The counters in the order of the fields of PerfCounterValues */
+const struct {
+  uint32_t type;
+  uint64_t config;
+} events[numEvents] = {{PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+                       {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+                       {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+                       {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES}};
+
+int openEvent(int eventIndex, int groupFd) {
+  perf_event_attr attr{};
+  attr.size = sizeof(perf_event_attr);
+  attr.type = events[eventIndex].type;
+  attr.config = events[eventIndex].config;
+  attr.read_format = PERF_FORMAT_GROUP;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  // the calling thread on any CPU
+  return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, groupFd, 0));
+}
+
+/** The counter group of a thread. The counters which could not be opened are skipped. */
+struct ThreadGroup {
+  ThreadGroup() {
+    for (int i = 0; i < numEvents; i++) {
+      const int fd = openEvent(i, leaderFd);
+      if (fd >= 0) {
+        if (leaderFd < 0) {
+          leaderFd = fd;
+        }
+        fds[numOpenEvents] = fd;
+        eventIndices[numOpenEvents] = i;
+        numOpenEvents++;
+      }
+    }
+  }
+
+  ~ThreadGroup() {
+    for (int i = 0; i < numOpenEvents; i++) {
+      close(fds[i]);
+    }
+  }
+
+  PerfCounterValues read() const {
+    PerfCounterValues values;
+    struct {
+      uint64_t nr;
+      uint64_t values[numEvents];
+    } groupValues;
+    if (leaderFd < 0 || ::read(leaderFd, &groupValues, sizeof(groupValues)) <= 0) {
+      return values;
+    }
+    uint64_t* fields[numEvents] = {&values.cycles, &values.instructions, &values.llcMisses, &values.branchMisses};
+    for (uint64_t i = 0; i < groupValues.nr && i < static_cast<uint64_t>(numOpenEvents); i++) {
+      *fields[eventIndices[i]] = groupValues.values[i];
+    }
+    return values;
+  }
+
+  int leaderFd = -1;
+  int numOpenEvents = 0;
+  int fds[numEvents];
+  int eventIndices[numEvents];
+};
+
+const ThreadGroup& getThreadGroup() {
+  thread_local ThreadGroup threadGroup;
+  return threadGroup;
+}
+#endif
+
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool enable() {
+#ifdef __linux__
+  // the access is checked by opening the group of the calling thread
+  if (getThreadGroup().leaderFd >= 0) {
+    enabled = true;
+  }
+#endif
+  return enabled;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void disable() {
+  enabled = false;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool isEnabled() {
+  return enabled;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+PerfCounterValues readThreadCounters() {
+#ifdef __linux__
+  if (enabled.load(std::memory_order_relaxed)) {
+    return getThreadGroup().read();
+  }
+#endif
+  return PerfCounterValues();
+}
+
+}  // namespace perf_counters
+}  // namespace benchmark
+}  // namespace ocs2
@@ -0,0 +1,120 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_core/misc/ScratchArena.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+
+namespace ocs2 {
+
+namespace {
+
+constexpr size_t ALIGNMENT = EIGEN_MAX_ALIGN_BYTES > 0 ? EIGEN_MAX_ALIGN_BYTES : 16;
+
+size_t alignUp(size_t numBytes) {
+  return (numBytes + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+}
+
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ScratchArena::Block::Block(size_t size) : memory(new char[size + ALIGNMENT]), size(size) {
+  const auto address = reinterpret_cast<std::uintptr_t>(memory.get());
+  data = memory.get() + (alignUp(address) - address);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ScratchArena::ScratchArena(size_t initialCapacity) : initialCapacity_(alignUp(std::max(initialCapacity, size_t(1)))) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void* ScratchArena::allocate(size_t numBytes) {
+  if (numBytes == 0) {
+    return nullptr;
+  }
+  const size_t size = alignUp(numBytes);
+
+  // the rest of a block which is too small is skipped
+  while (blockIndex_ < blocks_.size()) {
+    auto& block = blocks_[blockIndex_];
+    if (offset_ + size <= block.size) {
+      void* ptr = block.data + offset_;
+      offset_ += size;
+      return ptr;
+    }
+    ++blockIndex_;
+    offset_ = 0;
+  }
+
+  // grow geometrically
+  const size_t blockSize = std::max(blocks_.empty() ? initialCapacity_ : 2 * blocks_.back().size, size);
+  blocks_.emplace_back(blockSize);
+  blockIndex_ = blocks_.size() - 1;
+  offset_ = size;
+  return blocks_.back().data;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ScratchArena::rewind(const Marker& marker) {
+  blockIndex_ = marker.blockIndex;
+  offset_ = marker.offset;
+
+  // merge the blocks once the arena is empty, such that the same requests fit into a single block next time
+  if (blockIndex_ == 0 && offset_ == 0 && blocks_.size() > 1) {
+    const size_t capacity = getCapacity();
+    blocks_.clear();
+    blocks_.emplace_back(capacity);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t ScratchArena::getCapacity() const {
+  return std::accumulate(blocks_.begin(), blocks_.end(), size_t(0), [](size_t sum, const Block& block) { return sum + block.size; });
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ScratchArena& getThreadScratchArena() {
+  static thread_local ScratchArena arena;
+  return arena;
+}
+
+}  // namespace ocs2
@@ -0,0 +1,181 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_core/misc/Tracer.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+
+namespace ocs2 {
+namespace benchmark {
+
+/*
+ * The sequence of a slot is odd while the slot is written and equal to 2 * (n + 1) once the n-th event is completely written. The
+ * duration of an instantaneous event is negative.
+ */
+struct Tracer::Slot {
+  std::atomic<uint64_t> sequence{0};
+  std::atomic<const char*> name{nullptr};
+  std::atomic<uint32_t> threadId{0};
+  std::atomic<int64_t> startTime{0};
+  std::atomic<int64_t> duration{0};
+};
+
+namespace {
+
+uint32_t getThreadId() {
+  static std::atomic<uint32_t> counter(0);
+  thread_local const uint32_t threadId = counter++;
+  return threadId;
+}
+
+void writeEscaped(std::ostream& stream, const char* name) {
+  for (const char* c = name; *c != '\0'; ++c) {
+    if (*c == '"' || *c == '\\') {
+      stream << '\\';
+    }
+    stream << *c;
+  }
+}
+
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+Tracer::Tracer(size_t capacity) : originTime_(clock::now()), capacity_(std::max(capacity, size_t(1))), slots_(new Slot[capacity_]) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+Tracer::~Tracer() = default;
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void Tracer::addEvent(const char* name, clock::time_point startTime, clock::time_point endTime) {
+  addEvent(name, startTime, std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime).count());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void Tracer::addInstantEvent(const char* name) {
+  addEvent(name, clock::now(), -1);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void Tracer::addEvent(const char* name, clock::time_point startTime, int64_t durationInNanoseconds) {
+  const uint64_t n = numRecordedEvents_.fetch_add(1, std::memory_order_relaxed);
+  auto& slot = slots_[n % capacity_];
+
+  slot.sequence.store(2 * n + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.name.store(name, std::memory_order_relaxed);
+  slot.threadId.store(getThreadId(), std::memory_order_relaxed);
+  slot.startTime.store(std::chrono::duration_cast<std::chrono::nanoseconds>(startTime - originTime_).count(), std::memory_order_relaxed);
+  slot.duration.store(durationInNanoseconds, std::memory_order_relaxed);
+  slot.sequence.store(2 * n + 2, std::memory_order_release);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void Tracer::clear() {
+  numRecordedEvents_.store(0);
+  for (size_t i = 0; i < capacity_; i++) {
+    slots_[i].sequence.store(0);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t Tracer::getNumEvents() const {
+  return std::min<uint64_t>(numRecordedEvents_.load(std::memory_order_acquire), capacity_);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void Tracer::writeChromeTrace(std::ostream& stream) const {
+  const uint64_t numRecordedEvents = numRecordedEvents_.load(std::memory_order_acquire);
+  const uint64_t firstEvent = (numRecordedEvents > capacity_) ? numRecordedEvents - capacity_ : 0;
+
+  stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  stream << std::fixed << std::setprecision(3);
+  bool isFirst = true;
+  for (uint64_t n = firstEvent; n < numRecordedEvents; n++) {
+    const auto& slot = slots_[n % capacity_];
+
+    // seqlock read: the copy is only valid if the slot has not been touched by a writer in the meantime
+    const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+    if (sequence != 2 * n + 2) {
+      continue;
+    }
+    const char* name = slot.name.load(std::memory_order_relaxed);
+    const uint32_t threadId = slot.threadId.load(std::memory_order_relaxed);
+    const int64_t startTime = slot.startTime.load(std::memory_order_relaxed);
+    const int64_t duration = slot.duration.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) != sequence || name == nullptr) {
+      continue;
+    }
+
+    // the timestamps are in microseconds
+    stream << (isFirst ? "\n" : ",\n") << "{\"name\":\"";
+    writeEscaped(stream, name);
+    stream << "\",\"pid\":0,\"tid\":" << threadId << ",\"ts\":" << 1e-3 * startTime;
+    if (duration < 0) {
+      stream << ",\"ph\":\"i\",\"s\":\"t\"}";
+    } else {
+      stream << ",\"ph\":\"X\",\"dur\":" << 1e-3 * duration << "}";
+    }
+    isFirst = false;
+  }
+  stream << "\n]}\n";
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool Tracer::dumpChromeTrace(const std::string& fileName) const {
+  std::ofstream file(fileName);
+  if (!file) {
+    return false;
+  }
+  writeChromeTrace(file);
+  return file.good();
+}
+
+}  // namespace benchmark
+}  // namespace ocs2
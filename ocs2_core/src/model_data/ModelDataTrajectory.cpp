@@ -0,0 +1,210 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+
+#include "ocs2_core/model_data/ModelDataTrajectory.h"
+
+namespace ocs2 {
+
+namespace {
+
+/** Interpolation of the nodes index and index + 1, or the closest of them if their sizes differ */
+template <typename Result>
+void interpolateTrajectory(LinearInterpolation::index_alpha_t indexAlpha, const MatrixTrajectory& trajectory, Result& result) {
+  assert(trajectory.size() > 0);
+  if (trajectory.size() > 1) {
+    const int index = indexAlpha.first;
+    const scalar_t alpha = indexAlpha.second;
+    const auto lhs = trajectory[index];
+    const auto rhs = trajectory[index + 1];
+    if (trajectory.areSameSize(index, index + 1)) {
+      result = alpha * lhs + (scalar_t(1.0) - alpha) * rhs;
+    } else {
+      result = (alpha > 0.5) ? lhs : rhs;
+    }
+  } else {
+    result = trajectory[0];
+  }
+}
+
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MatrixTrajectory::clear() {
+  buffer_.clear();
+  offsets_.clear();
+  rows_.clear();
+  cols_.clear();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MatrixTrajectory::reserve(size_t numNodes, size_t numScalars) {
+  buffer_.reserve(numScalars);
+  offsets_.reserve(numNodes);
+  rows_.reserve(numNodes);
+  cols_.reserve(numNodes);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ModelDataTrajectory::clear() {
+  time.clear();
+  dynamicsBias.clear();
+  dynamicsCovariance.clear();
+  dynamics_f.clear();
+  dynamics_dfdx.clear();
+  dynamics_dfdu.clear();
+  cost_f.clear();
+  cost_dfdx.clear();
+  cost_dfdxx.clear();
+  cost_dfdu.clear();
+  cost_dfduu.clear();
+  cost_dfdux.clear();
+  stateEqConstraint_f.clear();
+  stateEqConstraint_dfdx.clear();
+  stateInputEqConstraint_f.clear();
+  stateInputEqConstraint_dfdx.clear();
+  stateInputEqConstraint_dfdu.clear();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ModelDataTrajectory::assign(const std::vector<ModelData>& modelDataTrajectory) {
+  clear();
+  for (const auto& modelData : modelDataTrajectory) {
+    time.push_back(modelData.time);
+    dynamicsBias.push_back(modelData.dynamicsBias);
+    dynamicsCovariance.push_back(modelData.dynamicsCovariance);
+    dynamics_f.push_back(modelData.dynamics.f);
+    dynamics_dfdx.push_back(modelData.dynamics.dfdx);
+    dynamics_dfdu.push_back(modelData.dynamics.dfdu);
+    cost_f.push_back(modelData.cost.f);
+    cost_dfdx.push_back(modelData.cost.dfdx);
+    cost_dfdxx.push_back(modelData.cost.dfdxx);
+    cost_dfdu.push_back(modelData.cost.dfdu);
+    cost_dfduu.push_back(modelData.cost.dfduu);
+    cost_dfdux.push_back(modelData.cost.dfdux);
+    stateEqConstraint_f.push_back(modelData.stateEqConstraint.f);
+    stateEqConstraint_dfdx.push_back(modelData.stateEqConstraint.dfdx);
+    stateInputEqConstraint_f.push_back(modelData.stateInputEqConstraint.f);
+    stateInputEqConstraint_dfdx.push_back(modelData.stateInputEqConstraint.dfdx);
+    stateInputEqConstraint_dfdu.push_back(modelData.stateInputEqConstraint.dfdu);
+  }
+}
+
+namespace LinearInterpolation {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void interpolate(index_alpha_t indexAlpha, const MatrixTrajectory& trajectory, matrix_t& result) {
+  interpolateTrajectory(indexAlpha, trajectory, result);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void interpolate(index_alpha_t indexAlpha, const MatrixTrajectory& trajectory, vector_t& result) {
+  interpolateTrajectory(indexAlpha, trajectory, result);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void interpolate(index_alpha_t indexAlpha, const ModelDataTrajectory& trajectory, uint32_t fields, ModelData& result) {
+  // Time
+  if (fields & model_data::TIME) {
+    result.time = interpolate(indexAlpha, trajectory.time);
+  }
+
+  // Dynamics
+  if (fields & model_data::DYNAMICS_BIAS) {
+    interpolateTrajectory(indexAlpha, trajectory.dynamicsBias, result.dynamicsBias);
+  }
+  if (fields & model_data::DYNAMICS_COVARIANCE) {
+    interpolateTrajectory(indexAlpha, trajectory.dynamicsCovariance, result.dynamicsCovariance);
+  }
+  if (fields & model_data::DYNAMICS_F) {
+    interpolateTrajectory(indexAlpha, trajectory.dynamics_f, result.dynamics.f);
+  }
+  if (fields & model_data::DYNAMICS_DFDX) {
+    interpolateTrajectory(indexAlpha, trajectory.dynamics_dfdx, result.dynamics.dfdx);
+  }
+  if (fields & model_data::DYNAMICS_DFDU) {
+    interpolateTrajectory(indexAlpha, trajectory.dynamics_dfdu, result.dynamics.dfdu);
+  }
+
+  // Cost
+  if (fields & model_data::COST_F) {
+    result.cost.f = interpolate(indexAlpha, trajectory.cost_f);
+  }
+  if (fields & model_data::COST_DFDX) {
+    interpolateTrajectory(indexAlpha, trajectory.cost_dfdx, result.cost.dfdx);
+  }
+  if (fields & model_data::COST_DFDXX) {
+    interpolateTrajectory(indexAlpha, trajectory.cost_dfdxx, result.cost.dfdxx);
+  }
+  if (fields & model_data::COST_DFDU) {
+    interpolateTrajectory(indexAlpha, trajectory.cost_dfdu, result.cost.dfdu);
+  }
+  if (fields & model_data::COST_DFDUU) {
+    interpolateTrajectory(indexAlpha, trajectory.cost_dfduu, result.cost.dfduu);
+  }
+  if (fields & model_data::COST_DFDUX) {
+    interpolateTrajectory(indexAlpha, trajectory.cost_dfdux, result.cost.dfdux);
+  }
+
+  // State equality constraints
+  if (fields & model_data::STATE_EQ_CONSTRAINT_F) {
+    interpolateTrajectory(indexAlpha, trajectory.stateEqConstraint_f, result.stateEqConstraint.f);
+  }
+  if (fields & model_data::STATE_EQ_CONSTRAINT_DFDX) {
+    interpolateTrajectory(indexAlpha, trajectory.stateEqConstraint_dfdx, result.stateEqConstraint.dfdx);
+  }
+
+  // State-input equality constraints
+  if (fields & model_data::STATE_INPUT_EQ_CONSTRAINT_F) {
+    interpolateTrajectory(indexAlpha, trajectory.stateInputEqConstraint_f, result.stateInputEqConstraint.f);
+  }
+  if (fields & model_data::STATE_INPUT_EQ_CONSTRAINT_DFDX) {
+    interpolateTrajectory(indexAlpha, trajectory.stateInputEqConstraint_dfdx, result.stateInputEqConstraint.dfdx);
+  }
+  if (fields & model_data::STATE_INPUT_EQ_CONSTRAINT_DFDU) {
+    interpolateTrajectory(indexAlpha, trajectory.stateInputEqConstraint_dfdu, result.stateInputEqConstraint.dfdu);
+  }
+}
+
+}  // namespace LinearInterpolation
+}  // namespace ocs2
@@ -93,69 +93,52 @@ Multiplier interpolate(const index_alpha_t& indexAlpha, const std::vector<Multip
   return {penalty, lagrangian};
 }
 
+namespace {
+/** Interpolates the multipliers of one type of constraint terms into the preallocated output. */
+void interpolateTerms(const index_alpha_t& indexAlpha, const std::vector<MultiplierCollection>& dataArray,
+                      std::vector<Multiplier> MultiplierCollection::*terms, std::vector<Multiplier>& out) {
+  assert(!dataArray.empty());
+  if (dataArray.size() == 1) {
+    out = dataArray[0].*terms;
+    return;
+  }
+
+  const auto alpha = indexAlpha.second;
+  const auto& lhs = dataArray[indexAlpha.first].*terms;
+  const auto& rhs = dataArray[indexAlpha.first + 1].*terms;
+  const auto& closest = alpha > 0.5 ? lhs : rhs;
+
+  out.resize(closest.size());
+  for (size_t i = 0; i < closest.size(); i++) {
+    out[i].penalty = alpha * lhs[i].penalty + (1.0 - alpha) * rhs[i].penalty;
+    if (lhs[i].lagrangian.size() == rhs[i].lagrangian.size()) {
+      out[i].lagrangian = alpha * lhs[i].lagrangian + (1.0 - alpha) * rhs[i].lagrangian;
+    } else {
+      out[i].lagrangian = closest[i].lagrangian;
+    }
+  }  // end of i loop
+}
+}  // unnamed namespace
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 MultiplierCollection interpolate(const index_alpha_t& indexAlpha, const std::vector<MultiplierCollection>& dataArray) {
-  // number of terms
-  const auto ind = indexAlpha.second > 0.5 ? indexAlpha.first : indexAlpha.first + 1;
-  const size_t mumStateEq = dataArray[ind].stateEq.size();
-  const size_t mumStateIneq = dataArray[ind].stateIneq.size();
-  const size_t mumStateInputEq = dataArray[ind].stateInputEq.size();
-  const size_t mumStateInputIneq = dataArray[ind].stateInputIneq.size();
-
   MultiplierCollection out;
-
-  // state equality
-  out.stateEq.reserve(mumStateEq);
-  for (size_t i = 0; i < mumStateEq; i++) {
-    auto penalty = interpolate(indexAlpha, dataArray, [i](const std::vector<MultiplierCollection>& array, size_t t) -> const scalar_t& {
-      return array[t].stateEq[i].penalty;
-    });
-    auto lagrangian = interpolate(indexAlpha, dataArray, [i](const std::vector<MultiplierCollection>& array, size_t t) -> const vector_t& {
-      return array[t].stateEq[i].lagrangian;
-    });
-    out.stateEq.emplace_back(penalty, std::move(lagrangian));
-  }  // end of i loop
-
-  // state inequality
-  out.stateIneq.reserve(mumStateIneq);
-  for (size_t i = 0; i < mumStateIneq; i++) {
-    auto penalty = interpolate(indexAlpha, dataArray, [i](const std::vector<MultiplierCollection>& array, size_t t) -> const scalar_t& {
-      return array[t].stateIneq[i].penalty;
-    });
-    auto lagrangian = interpolate(indexAlpha, dataArray, [i](const std::vector<MultiplierCollection>& array, size_t t) -> const vector_t& {
-      return array[t].stateIneq[i].lagrangian;
-    });
-    out.stateIneq.emplace_back(penalty, std::move(lagrangian));
-  }  // end of i loop
-
-  // state-input equality
-  out.stateInputEq.reserve(mumStateInputEq);
-  for (size_t i = 0; i < mumStateInputEq; i++) {
-    auto penalty = interpolate(indexAlpha, dataArray, [i](const std::vector<MultiplierCollection>& array, size_t t) -> const scalar_t& {
-      return array[t].stateInputEq[i].penalty;
-    });
-    auto lagrangian = interpolate(indexAlpha, dataArray, [i](const std::vector<MultiplierCollection>& array, size_t t) -> const vector_t& {
-      return array[t].stateInputEq[i].lagrangian;
-    });
-    out.stateInputEq.emplace_back(penalty, std::move(lagrangian));
-  }  // end of i loop
-
-  // state-input inequality
-  out.stateInputIneq.reserve(mumStateInputIneq);
-  for (size_t i = 0; i < mumStateInputIneq; i++) {
-    auto penalty = interpolate(indexAlpha, dataArray, [i](const std::vector<MultiplierCollection>& array, size_t t) -> const scalar_t& {
-      return array[t].stateInputIneq[i].penalty;
-    });
-    auto lagrangian = interpolate(indexAlpha, dataArray, [i](const std::vector<MultiplierCollection>& array, size_t t) -> const vector_t& {
-      return array[t].stateInputIneq[i].lagrangian;
-    });
-    out.stateInputIneq.emplace_back(penalty, std::move(lagrangian));
-  }  // end of i loop
-
+  interpolate(indexAlpha, dataArray, out);
   return out;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void interpolate(const index_alpha_t& indexAlpha, const std::vector<MultiplierCollection>& dataArray,
+                 MultiplierCollection& multiplierCollection) {
+  interpolateTerms(indexAlpha, dataArray, &MultiplierCollection::stateEq, multiplierCollection.stateEq);
+  interpolateTerms(indexAlpha, dataArray, &MultiplierCollection::stateIneq, multiplierCollection.stateIneq);
+  interpolateTerms(indexAlpha, dataArray, &MultiplierCollection::stateInputEq, multiplierCollection.stateInputEq);
+  interpolateTerms(indexAlpha, dataArray, &MultiplierCollection::stateInputIneq, multiplierCollection.stateInputIneq);
+}
+
 }  // namespace LinearInterpolation
 }  // namespace ocs2
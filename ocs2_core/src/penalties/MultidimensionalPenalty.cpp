@@ -31,6 +31,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/penalties/MultidimensionalPenalty.h>
 
+#include <ocs2_core/misc/ScratchArena.h>
+
 namespace ocs2 {
 
 namespace {
@@ -49,6 +51,12 @@ class PenaltyBaseWrapper final : public augmented::AugmentedPenaltyBase {
   scalar_t getDerivative(scalar_t t, scalar_t l, scalar_t h) const override { return penaltyPtr_->getDerivative(t, h); }
   scalar_t getSecondDerivative(scalar_t t, scalar_t l, scalar_t h) const override { return penaltyPtr_->getSecondDerivative(t, h); }
 
+  scalar_t getTotalValue(scalar_t t, const vector_t* l, const vector_t& h) const override { return penaltyPtr_->getTotalValue(t, h); }
+  scalar_t getTotalValueAndDerivatives(scalar_t t, const vector_t* l, const vector_t& h, vector_t& derivative,
+                                       vector_t& secondDerivative) const override {
+    return penaltyPtr_->getTotalValueAndDerivatives(t, h, derivative, secondDerivative);
+  }
+
   scalar_t updateMultiplier(scalar_t t, scalar_t l, scalar_t h) const override {
     throw std::runtime_error("[" + name() + "] This penalty is only applicable to soft constraints!");
   }
@@ -70,6 +78,44 @@ scalar_t getMultiplier(const vector_t* l, size_t ind) {
   return (l == nullptr) ? 0.0 : (*l)(ind);
 }
 
+/** Sets hessian += jacobian' * jacobian with a symmetric rank-k update of the lower triangle, then mirrors it to the upper triangle. */
+void addGaussNewtonHessian(const Eigen::Ref<const matrix_t>& jacobian, matrix_t& hessian) {
+  hessian.selfadjointView<Eigen::Lower>().rankUpdate(jacobian.transpose());
+  hessian.triangularView<Eigen::StrictlyUpper>() = hessian.triangularView<Eigen::StrictlyLower>().transpose();
+}
+
+/**
+ * Adds the Gauss-Newton Hessian dhdz' * diag(weights) * dhdz with z = [x; u] to the accumulator. For nonnegative weights, which is the
+ * case for convex penalties, the square-root weighted Jacobian is used for symmetric rank updates of the state and input Hessians.
+ */
+void addWeightedGaussNewtonHessian(const matrix_t& dhdx, const matrix_t& dhdu, const vector_t& weights,
+                                   ScalarFunctionQuadraticApproximation& accumulator) {
+  const bool hasInput = dhdu.cols() > 0;
+  // the weighted Jacobians are temporaries of every node, they are taken from the scratch arena of the thread
+  ScratchArena::Scope scratch(getThreadScratchArena());
+  if ((weights.array() >= 0.0).all()) {
+    auto sqrtWeights = scratch.getVector(weights.rows());
+    sqrtWeights = weights.cwiseSqrt();
+    auto sqrtWeights_dhdx = scratch.getMatrix(dhdx.rows(), dhdx.cols());
+    sqrtWeights_dhdx.noalias() = sqrtWeights.asDiagonal() * dhdx;
+    addGaussNewtonHessian(sqrtWeights_dhdx, accumulator.dfdxx);
+    if (hasInput) {
+      auto sqrtWeights_dhdu = scratch.getMatrix(dhdu.rows(), dhdu.cols());
+      sqrtWeights_dhdu.noalias() = sqrtWeights.asDiagonal() * dhdu;
+      addGaussNewtonHessian(sqrtWeights_dhdu, accumulator.dfduu);
+      accumulator.dfdux.noalias() += sqrtWeights_dhdu.transpose() * sqrtWeights_dhdx;
+    }
+  } else {
+    auto weights_dhdx = scratch.getMatrix(dhdx.rows(), dhdx.cols());
+    weights_dhdx.noalias() = weights.asDiagonal() * dhdx;
+    accumulator.dfdxx.noalias() += dhdx.transpose() * weights_dhdx;
+    if (hasInput) {
+      accumulator.dfdux.noalias() += dhdu.transpose() * weights_dhdx;
+      accumulator.dfduu.noalias() += dhdu.transpose() * weights.asDiagonal() * dhdu;
+    }
+  }
+}
+
 }  // namespace
 
 /******************************************************************************************************/
@@ -125,6 +171,11 @@ scalar_t MultidimensionalPenalty::getValue(scalar_t t, const vector_t& h, const
   const auto numConstraints = h.rows();
   assert(penaltyPtrArray_.size() == 1 || penaltyPtrArray_.size() == numConstraints);
 
+  // a single penalty is evaluated on the whole constraint vector at once
+  if (penaltyPtrArray_.size() == 1) {
+    return penaltyPtrArray_[0]->getTotalValue(t, l, h);
+  }
+
   scalar_t penalty = 0;
   for (size_t i = 0; i < numConstraints; i++) {
     const auto& penaltyTerm = (penaltyPtrArray_.size() == 1) ? penaltyPtrArray_[0] : penaltyPtrArray_[i];
@@ -201,6 +252,51 @@ ScalarFunctionQuadraticApproximation MultidimensionalPenalty::getQuadraticApprox
   return penaltyApproximation;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MultidimensionalPenalty::accumulateQuadraticApproximation(scalar_t t, const VectorFunctionLinearApproximation& h, const vector_t* l,
+                                                               ScalarFunctionQuadraticApproximation& accumulator) const {
+  scalar_t penaltyValue = 0.0;
+  vector_t penaltyDerivative, penaltySecondDerivative;
+  std::tie(penaltyValue, penaltyDerivative, penaltySecondDerivative) = getPenaltyValue1stDev2ndDev(t, h.f, l);
+
+  accumulator.f += penaltyValue;
+  accumulator.dfdx.noalias() += h.dfdx.transpose() * penaltyDerivative;
+  if (h.dfdu.cols() > 0) {
+    accumulator.dfdu.noalias() += h.dfdu.transpose() * penaltyDerivative;
+  }
+  addWeightedGaussNewtonHessian(h.dfdx, h.dfdu, penaltySecondDerivative, accumulator);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MultidimensionalPenalty::accumulateQuadraticApproximation(scalar_t t, const VectorFunctionQuadraticApproximation& h,
+                                                               const vector_t* l, ScalarFunctionQuadraticApproximation& accumulator) const {
+  const auto numConstraints = h.f.rows();
+  const bool hasInput = h.dfdu.cols() > 0;
+
+  scalar_t penaltyValue = 0.0;
+  vector_t penaltyDerivative, penaltySecondDerivative;
+  std::tie(penaltyValue, penaltyDerivative, penaltySecondDerivative) = getPenaltyValue1stDev2ndDev(t, h.f, l);
+
+  accumulator.f += penaltyValue;
+  accumulator.dfdx.noalias() += h.dfdx.transpose() * penaltyDerivative;
+  if (hasInput) {
+    accumulator.dfdu.noalias() += h.dfdu.transpose() * penaltyDerivative;
+  }
+  addWeightedGaussNewtonHessian(h.dfdx, h.dfdu, penaltySecondDerivative, accumulator);
+
+  for (size_t i = 0; i < numConstraints; i++) {
+    accumulator.dfdxx += penaltyDerivative(i) * h.dfdxx[i];
+    if (hasInput) {
+      accumulator.dfdux += penaltyDerivative(i) * h.dfdux[i];
+      accumulator.dfduu += penaltyDerivative(i) * h.dfduu[i];
+    }
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -210,8 +306,16 @@ std::tuple<scalar_t, vector_t, vector_t> MultidimensionalPenalty::getPenaltyValu
   assert(penaltyPtrArray_.size() == 1 || penaltyPtrArray_.size() == numConstraints);
 
   scalar_t penaltyValue = 0.0;
-  vector_t penaltyDerivative(numConstraints);
-  vector_t penaltySecondDerivative(numConstraints);
+  vector_t penaltyDerivative, penaltySecondDerivative;
+
+  // a single penalty is evaluated on the whole constraint vector at once
+  if (penaltyPtrArray_.size() == 1) {
+    penaltyValue = penaltyPtrArray_[0]->getTotalValueAndDerivatives(t, l, h, penaltyDerivative, penaltySecondDerivative);
+    return {penaltyValue, penaltyDerivative, penaltySecondDerivative};
+  }
+
+  penaltyDerivative.resize(numConstraints);
+  penaltySecondDerivative.resize(numConstraints);
   for (size_t i = 0; i < numConstraints; i++) {
     const auto& penaltyTerm = (penaltyPtrArray_.size() == 1) ? penaltyPtrArray_[0] : penaltyPtrArray_[i];
     penaltyValue += penaltyTerm->getValue(t, getMultiplier(l, i), h(i));
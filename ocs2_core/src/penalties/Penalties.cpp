@@ -43,8 +43,8 @@ namespace loadData {
 template <>
 void loadPenaltyConfig<augmented::SmoothAbsolutePenalty::Config>(const std::string& fileName, const std::string& fieldName,
                                                                  augmented::SmoothAbsolutePenalty::Config& config, bool verbose) {
-  boost::property_tree::ptree pt;
-  boost::property_tree::read_info(fileName, pt);
+  const auto ptPtr = loadData::readInfoFile(fileName);
+  const boost::property_tree::ptree& pt = *ptPtr;
 
   if (verbose) {
     std::cerr << "\n #### " << fieldName;
@@ -66,8 +66,8 @@ void loadPenaltyConfig<augmented::SmoothAbsolutePenalty::Config>(const std::stri
 template <>
 void loadPenaltyConfig<augmented::QuadraticPenalty::Config>(const std::string& fileName, const std::string& fieldName,
                                                             augmented::QuadraticPenalty::Config& config, bool verbose) {
-  boost::property_tree::ptree pt;
-  boost::property_tree::read_info(fileName, pt);
+  const auto ptPtr = loadData::readInfoFile(fileName);
+  const boost::property_tree::ptree& pt = *ptPtr;
 
   if (verbose) {
     std::cerr << "\n #### " << fieldName;
@@ -89,8 +89,8 @@ template <>
 void loadPenaltyConfig<augmented::ModifiedRelaxedBarrierPenalty::Config>(const std::string& fileName, const std::string& fieldName,
                                                                          augmented::ModifiedRelaxedBarrierPenalty::Config& config,
                                                                          bool verbose) {
-  boost::property_tree::ptree pt;
-  boost::property_tree::read_info(fileName, pt);
+  const auto ptPtr = loadData::readInfoFile(fileName);
+  const boost::property_tree::ptree& pt = *ptPtr;
 
   if (verbose) {
     std::cerr << "\n #### " << fieldName;
@@ -113,8 +113,8 @@ template <>
 void loadPenaltyConfig<augmented::SlacknessSquaredHingePenalty::Config>(const std::string& fileName, const std::string& fieldName,
                                                                         augmented::SlacknessSquaredHingePenalty::Config& config,
                                                                         bool verbose) {
-  boost::property_tree::ptree pt;
-  boost::property_tree::read_info(fileName, pt);
+  const auto ptPtr = loadData::readInfoFile(fileName);
+  const boost::property_tree::ptree& pt = *ptPtr;
 
   if (verbose) {
     std::cerr << "\n #### " << fieldName;
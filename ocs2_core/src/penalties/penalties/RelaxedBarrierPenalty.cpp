@@ -65,4 +65,27 @@ scalar_t RelaxedBarrierPenalty::getSecondDerivative(scalar_t t, scalar_t h) cons
   };
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t RelaxedBarrierPenalty::getTotalValue(scalar_t t, const vector_t& h) const {
+  const scalar_t mu = config_.mu;
+  const scalar_t delta = config_.delta;
+  const auto deltaH = (h.array() - 2.0 * delta) / delta;
+  return (h.array() > delta).select(-mu * h.array().log(), mu * (-std::log(delta) + 0.5 * deltaH.square() - 0.5)).sum();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t RelaxedBarrierPenalty::getTotalValueAndDerivatives(scalar_t t, const vector_t& h, vector_t& derivative,
+                                                            vector_t& secondDerivative) const {
+  const scalar_t mu = config_.mu;
+  const scalar_t delta = config_.delta;
+  const auto isBarrier = h.array() > delta;
+  derivative = isBarrier.select(-mu * h.array().inverse(), (mu / (delta * delta)) * (h.array() - 2.0 * delta));
+  secondDerivative = isBarrier.select(mu * h.array().square().inverse(), mu / (delta * delta));
+  return getTotalValue(t, h);
+}
+
 }  // namespace ocs2
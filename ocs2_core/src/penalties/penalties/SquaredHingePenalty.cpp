@@ -65,4 +65,22 @@ scalar_t SquaredHingePenalty::getSecondDerivative(scalar_t t, scalar_t h) const
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t SquaredHingePenalty::getTotalValue(scalar_t t, const vector_t& h) const {
+  return 0.5 * config_.mu * (h.array() - config_.delta).min(0.0).square().sum();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t SquaredHingePenalty::getTotalValueAndDerivatives(scalar_t t, const vector_t& h, vector_t& derivative,
+                                                          vector_t& secondDerivative) const {
+  const auto violation = (h.array() - config_.delta).min(0.0);
+  derivative = config_.mu * violation;
+  secondDerivative = config_.mu * (h.array() < config_.delta).cast<scalar_t>();
+  return 0.5 * config_.mu * violation.square().sum();
+}
+
 }  // namespace ocs2
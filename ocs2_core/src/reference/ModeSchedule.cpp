@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_core/reference/ModeSchedule.h"
 
+#include <atomic>
+
 #include <ocs2_core/misc/Display.h>
 #include <ocs2_core/misc/Lookup.h>
 #include <ocs2_core/misc/Numerics.h>
@@ -52,6 +54,43 @@ size_t ModeSchedule::modeAtTime(scalar_t time) const {
   return modeSequence[ind];
 }
 
+namespace {
+uint64_t getNewLookupId() {
+  static std::atomic<uint64_t> counter{0};
+  return ++counter;
+}
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ModeScheduleLookup::ModeScheduleLookup(ModeSchedule modeSchedule) : modeSchedule_(std::move(modeSchedule)), id_(getNewLookupId()) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ModeScheduleLookup::setModeSchedule(ModeSchedule modeSchedule) {
+  modeSchedule_ = std::move(modeSchedule);
+  id_ = getNewLookupId();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t ModeScheduleLookup::getModeIndex(scalar_t time) const {
+  struct Cursor {
+    uint64_t id = 0;
+    int index = -1;
+  };
+  thread_local Cursor cursor;
+
+  if (cursor.id != id_) {
+    cursor.id = id_;
+    cursor.index = -1;
+  }
+  return static_cast<size_t>(lookup::findIndexInTimeArray(modeSchedule_.eventTimes, time, cursor.index));
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -0,0 +1,96 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_core/reference/SampledReference.h"
+
+#include <algorithm>
+
+#include <ocs2_core/misc/LinearInterpolation.h>
+
+namespace ocs2 {
+
+namespace {
+
+/** Linearly interpolates into the given vector, such that its memory is reused. */
+void interpolateInPlace(LinearInterpolation::index_alpha_t indexAlpha, const vector_array_t& dataArray, vector_t& result) {
+  const auto index = indexAlpha.first;
+  const auto alpha = indexAlpha.second;
+  if (dataArray.size() == 1 || alpha >= 1.0) {
+    result = dataArray[index];
+  } else if (alpha <= 0.0) {
+    result = dataArray[index + 1];
+  } else if (dataArray[index].size() != dataArray[index + 1].size()) {
+    // snap to the closest point, see LinearInterpolation::interpolate
+    result = (alpha > 0.5) ? dataArray[index] : dataArray[index + 1];
+  } else {
+    result = alpha * dataArray[index] + (1.0 - alpha) * dataArray[index + 1];
+  }
+}
+
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SampledReference::update(const scalar_array_t& timeTrajectory, const vector_array_t& stateTrajectory,
+                              const vector_array_t& inputTrajectory, const scalar_array_t& timeGrid) {
+  if (timeTrajectory.empty() || stateTrajectory.size() != timeTrajectory.size()) {
+    throw std::runtime_error("[SampledReference::update] The target trajectories are empty or inconsistent!");
+  }
+
+  hasInput_ = !inputTrajectory.empty();
+  timeGrid_.assign(timeGrid.cbegin(), timeGrid.cend());
+  stateSamples_.resize(timeGrid_.size());
+  inputSamples_.resize(timeGrid_.size());
+
+  int cursor = 0;
+  for (size_t i = 0; i < timeGrid_.size(); i++) {
+    const auto indexAlpha = LinearInterpolation::timeSegment(timeGrid_[i], timeTrajectory, cursor);
+    interpolateInPlace(indexAlpha, stateTrajectory, stateSamples_[i]);
+    if (hasInput_) {
+      interpolateInPlace(indexAlpha, inputTrajectory, inputSamples_[i]);
+    } else {
+      inputSamples_[i].resize(0);
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+int SampledReference::find(scalar_t time) const {
+  const auto itr = std::lower_bound(timeGrid_.cbegin(), timeGrid_.cend(), time);
+  if (itr != timeGrid_.cend() && *itr == time) {
+    return static_cast<int>(std::distance(timeGrid_.cbegin(), itr));
+  } else {
+    return -1;
+  }
+}
+
+}  // namespace ocs2
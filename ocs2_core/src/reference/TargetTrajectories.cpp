@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_core/reference/TargetTrajectories.h"
 
+#include <algorithm>
+
 #include <ocs2_core/misc/Display.h>
 #include <ocs2_core/misc/LinearInterpolation.h>
 
@@ -60,6 +62,7 @@ void TargetTrajectories::clear() {
   timeTrajectory.clear();
   stateTrajectory.clear();
   inputTrajectory.clear();
+  sampledReference_.clear();
 }
 
 /******************************************************************************************************/
@@ -76,6 +79,8 @@ bool TargetTrajectories::operator==(const TargetTrajectories& other) {
 vector_t TargetTrajectories::getDesiredState(scalar_t time) const {
   if (this->empty()) {
     throw std::runtime_error("[TargetTrajectories] TargetTrajectories is empty!");
+  } else if (const auto* sampledStatePtr = getSampledDesiredState(time)) {
+    return *sampledStatePtr;
   } else {
     return LinearInterpolation::interpolate(time, timeTrajectory, stateTrajectory);
   }
@@ -89,11 +94,95 @@ vector_t TargetTrajectories::getDesiredInput(scalar_t time) const {
     throw std::runtime_error("[TargetTrajectories] TargetTrajectories is empty!");
   } else if (inputTrajectory.empty()) {
     throw std::runtime_error("[TargetTrajectories] TargetTrajectories does not have inputTrajectory!");
+  } else if (const auto* sampledInputPtr = getSampledDesiredInput(time)) {
+    return *sampledInputPtr;
   } else {
     return LinearInterpolation::interpolate(time, timeTrajectory, inputTrajectory);
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/***************************************************************************************************** */
+void TargetTrajectories::sampleOnGrid(const scalar_array_t& timeGrid, TargetTrajectories& sampledTargetTrajectories) const {
+  if (this->empty()) {
+    throw std::runtime_error("[TargetTrajectories] TargetTrajectories is empty!");
+  } else if (&sampledTargetTrajectories == this) {
+    throw std::runtime_error("[TargetTrajectories] The samples should be returned to other TargetTrajectories!");
+  }
+
+  // the member-wise copy reuses the storage of the caller
+  sampledTargetTrajectories.timeTrajectory = timeTrajectory;
+  sampledTargetTrajectories.stateTrajectory = stateTrajectory;
+  sampledTargetTrajectories.inputTrajectory = inputTrajectory;
+  sampledTargetTrajectories.sampledReference_.update(timeTrajectory, stateTrajectory, inputTrajectory, timeGrid);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/***************************************************************************************************** */
+const vector_t* TargetTrajectories::getSampledDesiredState(scalar_t time) const {
+  const int index = sampledReference_.find(time);
+  return (index < 0) ? nullptr : &sampledReference_.getState(index);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/***************************************************************************************************** */
+const vector_t* TargetTrajectories::getSampledDesiredInput(scalar_t time) const {
+  if (!sampledReference_.hasInput()) {
+    return nullptr;
+  }
+  const int index = sampledReference_.find(time);
+  return (index < 0) ? nullptr : &sampledReference_.getInput(index);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/***************************************************************************************************** */
+void TargetTrajectories::append(const TargetTrajectories& segment) {
+  if (segment.empty()) {
+    return;
+  } else if (this->empty()) {
+    *this = segment;
+    sampledReference_.clear();
+    return;
+  } else if (inputTrajectory.empty() != segment.inputTrajectory.empty()) {
+    throw std::runtime_error("[TargetTrajectories] Either both or none of the TargetTrajectories should have inputTrajectory!");
+  }
+
+  sampledReference_.clear();
+
+  // the points at or after the start of the segment are replaced
+  const auto firstReplaced = std::lower_bound(timeTrajectory.cbegin(), timeTrajectory.cend(), segment.timeTrajectory.front());
+  const auto numKept = static_cast<size_t>(std::distance(timeTrajectory.cbegin(), firstReplaced));
+  timeTrajectory.resize(numKept);
+  stateTrajectory.resize(numKept);
+  timeTrajectory.insert(timeTrajectory.end(), segment.timeTrajectory.cbegin(), segment.timeTrajectory.cend());
+  stateTrajectory.insert(stateTrajectory.end(), segment.stateTrajectory.cbegin(), segment.stateTrajectory.cend());
+  if (!inputTrajectory.empty()) {
+    inputTrajectory.resize(numKept);
+    inputTrajectory.insert(inputTrajectory.end(), segment.inputTrajectory.cbegin(), segment.inputTrajectory.cend());
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/***************************************************************************************************** */
+void TargetTrajectories::trimBefore(scalar_t time) {
+  // index of the last point at or before time
+  const auto lastElapsed = std::upper_bound(timeTrajectory.cbegin(), timeTrajectory.cend(), time);
+  const auto numRemoved = std::max<std::ptrdiff_t>(std::distance(timeTrajectory.cbegin(), lastElapsed) - 1, 0);
+  if (numRemoved > 0) {
+    sampledReference_.clear();
+    timeTrajectory.erase(timeTrajectory.begin(), timeTrajectory.begin() + numRemoved);
+    stateTrajectory.erase(stateTrajectory.begin(), stateTrajectory.begin() + numRemoved);
+    if (!inputTrajectory.empty()) {
+      inputTrajectory.erase(inputTrajectory.begin(), inputTrajectory.begin() + numRemoved);
+    }
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /***************************************************************************************************** */
@@ -101,6 +190,7 @@ void swap(TargetTrajectories& lh, TargetTrajectories& rh) {
   lh.timeTrajectory.swap(rh.timeTrajectory);
   lh.stateTrajectory.swap(rh.stateTrajectory);
   lh.inputTrajectory.swap(rh.inputTrajectory);
+  std::swap(lh.sampledReference_, rh.sampledReference_);
 }
 
 /******************************************************************************************************/
@@ -56,6 +56,16 @@ StateInputSoftBoxConstraint::StateInputSoftBoxConstraint(std::vector<BoxConstrai
     : stateBoxConstraints_(std::move(stateBoxConstraints)), inputBoxConstraints_(std::move(inputBoxConstraints)), offset_(0.0) {
   sortByIndex(stateBoxConstraints_);
   sortByIndex(inputBoxConstraints_);
+
+  auto getIndices = [](const std::vector<BoxConstraint>& boxConstraints) {
+    std::vector<size_t> indices;
+    indices.reserve(boxConstraints.size());
+    for (const auto& boxConstraint : boxConstraints) {
+      indices.push_back(boxConstraint.index);
+    }
+    return indices;
+  };
+  footprint_ = Footprint::fromIndices(getIndices(stateBoxConstraints_), getIndices(inputBoxConstraints_));
 }
 
 /******************************************************************************************************/
@@ -109,6 +119,18 @@ ScalarFunctionQuadraticApproximation StateInputSoftBoxConstraint::getQuadraticAp
   return cost;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void StateInputSoftBoxConstraint::accumulateQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                                   const TargetTrajectories&, const PreComputation& preComp,
+                                                                   ScalarFunctionQuadraticApproximation& accumulator) const {
+  // the box penalties only touch the diagonal, hence they are directly added to the accumulator
+  fillQuadraticApproximation(time, state, stateBoxConstraints_, accumulator.f, accumulator.dfdx, accumulator.dfdxx);
+  fillQuadraticApproximation(time, input, inputBoxConstraints_, accumulator.f, accumulator.dfdu, accumulator.dfduu);
+  accumulator.f += offset_;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -89,4 +89,24 @@ ScalarFunctionQuadraticApproximation StateInputSoftConstraint::getQuadraticAppro
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void StateInputSoftConstraint::accumulateQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                                const TargetTrajectories&, const PreComputation& preComp,
+                                                                ScalarFunctionQuadraticApproximation& accumulator) const {
+  switch (constraintPtr_->getOrder()) {
+    case ConstraintOrder::Linear:
+      penalty_.accumulateQuadraticApproximation(time, constraintPtr_->getLinearApproximation(time, state, input, preComp), nullptr,
+                                                accumulator);
+      break;
+    case ConstraintOrder::Quadratic:
+      penalty_.accumulateQuadraticApproximation(time, constraintPtr_->getQuadraticApproximation(time, state, input, preComp), nullptr,
+                                                accumulator);
+      break;
+    default:
+      throw std::runtime_error("[StateInputSoftConstraint] Unknown constraint Order");
+  }
+}
+
 }  // namespace ocs2
@@ -88,4 +88,23 @@ ScalarFunctionQuadraticApproximation StateSoftConstraint::getQuadraticApproximat
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void StateSoftConstraint::accumulateQuadraticApproximation(scalar_t time, const vector_t& state, const TargetTrajectories&,
+                                                           const PreComputation& preComp,
+                                                           ScalarFunctionQuadraticApproximation& accumulator) const {
+  switch (constraintPtr_->getOrder()) {
+    case ConstraintOrder::Linear:
+      penalty_.accumulateQuadraticApproximation(time, constraintPtr_->getLinearApproximation(time, state, preComp), nullptr, accumulator);
+      break;
+    case ConstraintOrder::Quadratic:
+      penalty_.accumulateQuadraticApproximation(time, constraintPtr_->getQuadraticApproximation(time, state, preComp), nullptr,
+                                                accumulator);
+      break;
+    default:
+      throw std::runtime_error("[StateSoftConstraint] Unknown constraint Order");
+  }
+}
+
 }  // namespace ocs2
@@ -0,0 +1,169 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <ocs2_core/thread_support/TaskGraph.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TaskGraph::TaskId TaskGraph::addTask(std::function<void(int)> taskFunction, std::vector<TaskId> dependencies) {
+  auto loopFunction = [taskFunction](int workerIndex, int) { taskFunction(workerIndex); };
+  return addParallelFor(0, 1, 1, std::move(loopFunction), std::move(dependencies));
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TaskGraph::TaskId TaskGraph::addParallelFor(int begin, int end, int grain, std::function<void(int, int)> taskFunction,
+                                            std::vector<TaskId> dependencies) {
+  for (const auto dependency : dependencies) {
+    if (dependency >= nodes_.size()) {
+      throw std::runtime_error("[TaskGraph::addParallelFor] dependency " + std::to_string(dependency) + " is not a node of the graph!");
+    }
+  }
+  nodes_.push_back({begin, std::max(begin, end), std::max(grain, 1), std::move(taskFunction), std::move(dependencies)});
+  return nodes_.size() - 1;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void TaskGraph::run(ThreadPool& threadPool, size_t maxNumThreads) {
+  if (nodes_.empty()) {
+    return;
+  }
+
+  // execution state of the nodes, protected by mutex
+  struct NodeState {
+    int nextIndex;
+    int numRemainingIndices;
+    size_t numPendingDependencies;
+    std::vector<TaskId> dependents;
+  };
+  std::vector<NodeState> states(nodes_.size());
+  for (TaskId id = 0; id < nodes_.size(); ++id) {
+    states[id].nextIndex = nodes_[id].begin;
+    states[id].numRemainingIndices = nodes_[id].end - nodes_[id].begin;
+    states[id].numPendingDependencies = nodes_[id].dependencies.size();
+    for (const auto dependency : nodes_[id].dependencies) {
+      states[dependency].dependents.push_back(id);
+    }
+  }
+
+  std::mutex mutex;
+  std::condition_variable condition;
+  std::vector<TaskId> readyNodes;  // nodes with completed dependencies and unclaimed indices
+  size_t numUnfinishedNodes = nodes_.size();
+  std::exception_ptr exceptionPtr = nullptr;
+
+  // completes a node and releases its dependents, called while holding the lock
+  std::function<void(TaskId)> complete;
+  auto release = [&](TaskId id) {
+    if (states[id].numRemainingIndices > 0) {
+      readyNodes.push_back(id);
+    } else {
+      complete(id);  // empty range
+    }
+  };
+  complete = [&](TaskId id) {
+    --numUnfinishedNodes;
+    for (const auto dependent : states[id].dependents) {
+      if (--states[dependent].numPendingDependencies == 0) {
+        release(dependent);
+      }
+    }
+  };
+
+  for (TaskId id = 0; id < nodes_.size(); ++id) {
+    if (states[id].numPendingDependencies == 0) {
+      release(id);
+    }
+  }
+
+  auto participate = [&](int workerIndex, int) {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+      condition.wait(lock, [&] { return !readyNodes.empty() || numUnfinishedNodes == 0 || exceptionPtr != nullptr; });
+      if (numUnfinishedNodes == 0 || exceptionPtr != nullptr) {
+        return;
+      }
+
+      // spread the threads over the ready nodes
+      const TaskId id = readyNodes[workerIndex % readyNodes.size()];
+      const Node& node = nodes_[id];
+      NodeState& state = states[id];
+      const int chunkBegin = state.nextIndex;
+      const int chunkEnd = std::min(chunkBegin + node.grain, node.end);
+      state.nextIndex = chunkEnd;
+      if (chunkEnd >= node.end) {
+        // all indices are claimed, the node completes when the running chunks are done
+        readyNodes.erase(std::find(readyNodes.begin(), readyNodes.end(), id));
+      }
+
+      lock.unlock();
+      try {
+        for (int i = chunkBegin; i < chunkEnd; ++i) {
+          node.taskFunction(workerIndex, i);
+        }
+      } catch (...) {
+        lock.lock();
+        if (exceptionPtr == nullptr) {
+          exceptionPtr = std::current_exception();
+        }
+        condition.notify_all();
+        return;
+      }
+      lock.lock();
+
+      state.numRemainingIndices -= chunkEnd - chunkBegin;
+      if (state.numRemainingIndices == 0) {
+        complete(id);
+        condition.notify_all();
+      }
+    }
+  };
+
+  const size_t numParticipants = (maxNumThreads == 0) ? threadPool.numThreads() + 1 : std::min(maxNumThreads, threadPool.numThreads() + 1);
+  threadPool.parallelFor(0, static_cast<int>(numParticipants), 1, participate, numParticipants);
+
+  if (exceptionPtr != nullptr) {
+    std::rethrow_exception(exceptionPtr);
+  }
+}
+
+}  // namespace ocs2
@@ -30,16 +30,97 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/thread_support/SetThreadPriority.h>
 #include <ocs2_core/thread_support/ThreadPool.h>
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
 namespace ocs2 {
 
+namespace {
+
+/** Hints the processor that the calling thread is in a spin-wait loop. */
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+  asm volatile("yield");
+#else
+  std::this_thread::yield();
+#endif
+}
+
+/** The not yet processed part of the index block owned by one participant of ThreadPool::parallelFor. */
+struct IndexRange {
+  std::mutex mutex;
+  int begin = 0;
+  int end = 0;
+};
+
+/** Takes up to grain indices from the front of the own block. */
+bool popFront(IndexRange& range, int grain, int& chunkBegin, int& chunkEnd) {
+  std::lock_guard<std::mutex> lock(range.mutex);
+  if (range.begin >= range.end) {
+    return false;
+  }
+  chunkBegin = range.begin;
+  chunkEnd = std::min(range.begin + grain, range.end);
+  range.begin = chunkEnd;
+  return true;
+}
+
+/** Moves half of the remaining indices of another participant's block (taken from its back) into the own, empty, block. */
+bool steal(std::vector<IndexRange>& ranges, int ownIndex, int grain) {
+  const int numRanges = static_cast<int>(ranges.size());
+  for (int k = 1; k < numRanges; ++k) {
+    IndexRange& victim = ranges[(ownIndex + k) % numRanges];
+    int stolenBegin, stolenEnd;
+    {
+      std::lock_guard<std::mutex> lock(victim.mutex);
+      const int remaining = victim.end - victim.begin;
+      if (remaining <= 0) {
+        continue;
+      }
+      const int numStolen = (remaining > grain) ? remaining / 2 : remaining;
+      stolenEnd = victim.end;
+      stolenBegin = victim.end - numStolen;
+      victim.end = stolenBegin;
+    }
+    IndexRange& own = ranges[ownIndex];
+    std::lock_guard<std::mutex> lock(own.mutex);
+    own.begin = stolenBegin;
+    own.end = stolenEnd;
+    return true;
+  }
+  return false;
+}
+
+/** Waits for all futures. Stores the first exception in exceptionPtr if it is not already set. */
+void waitForAll(std::vector<std::future<void>>& futures, std::exception_ptr& exceptionPtr) {
+  for (auto&& fut : futures) {
+    try {
+      fut.get();
+    } catch (...) {
+      if (!exceptionPtr) {
+        exceptionPtr = std::current_exception();
+      }
+    }
+  }
+}
+
+}  // unnamed namespace
+
 /**************************************************************************************************/
 /**************************************************************************************************/
 /**************************************************************************************************/
-ThreadPool::ThreadPool(size_t nThreads, int priority) {
+ThreadPool::ThreadPool(size_t nThreads, int priority, std::chrono::microseconds spinDuration, const std::vector<int>& cpuAffinity)
+    : spinDuration_(spinDuration) {
   workerThreads_.reserve(nThreads);
   for (size_t i = 0; i < nThreads; i++) {
     workerThreads_.emplace_back(&ThreadPool::worker, this, i);
     setThreadPriority(priority, workerThreads_.back());
+    if (!cpuAffinity.empty()) {
+      setThreadAffinity({cpuAffinity[i % cpuAffinity.size()]}, workerThreads_.back());
+    }
   }
 }
 
@@ -51,6 +132,7 @@ ThreadPool::~ThreadPool() {
     std::lock_guard<std::mutex> lock(taskQueueLock_);
     stop_ = true;
   }
+  stopSpinning_ = true;
   taskQueueCondition_.notify_all();
   for (auto& thread : workerThreads_) {
     if (thread.joinable()) {
@@ -64,6 +146,10 @@ ThreadPool::~ThreadPool() {
 /**************************************************************************************************/
 void ThreadPool::worker(int workerIndex) {
   while (true) {
+    if (spinDuration_.count() > 0) {
+      spinWait();
+    }
+
     std::unique_ptr<ThreadPool::TaskBase> taskPtr;
     {
       std::unique_lock<std::mutex> lock(taskQueueLock_);
@@ -78,6 +164,7 @@ void ThreadPool::worker(int workerIndex) {
       if (!taskQueue_.empty()) {
         taskPtr = std::move(taskQueue_.front());
         taskQueue_.pop();
+        numQueuedTasks_ = taskQueue_.size();
       }
     }
 
@@ -94,10 +181,27 @@ void ThreadPool::runTask(std::unique_ptr<TaskBase> taskPtr) {
   {
     std::lock_guard<std::mutex> lock(taskQueueLock_);
     taskQueue_.push(std::move(taskPtr));
+    numQueuedTasks_ = taskQueue_.size();
   }
   taskQueueCondition_.notify_one();
 }
 
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+void ThreadPool::spinWait() const {
+  constexpr int numRelaxPerCheck = 16;
+  const auto deadline = std::chrono::steady_clock::now() + spinDuration_;
+  while (numQueuedTasks_ == 0 && !stopSpinning_) {
+    if (std::chrono::steady_clock::now() >= deadline) {
+      break;
+    }
+    for (int i = 0; i < numRelaxPerCheck; ++i) {
+      cpuRelax();
+    }
+  }
+}
+
 /**************************************************************************************************/
 /**************************************************************************************************/
 /**************************************************************************************************/
@@ -122,4 +226,122 @@ void ThreadPool::runParallel(std::function<void(int)> taskFunction, int N) {
   }
 }
 
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+void ThreadPool::parallelFor(int begin, int end, int grain, std::function<void(int, int)> taskFunction, size_t maxNumThreads) {
+  if (begin >= end) {
+    return;
+  }
+  grain = std::max(grain, 1);
+  const int maxNumParticipants = static_cast<int>(maxNumThreads == 0 ? numThreads() + 1 : std::min(maxNumThreads, numThreads() + 1));
+  const int callerWorkerIndex = maxNumThreads == 0 ? static_cast<int>(numThreads()) : static_cast<int>(maxNumThreads) - 1;
+
+  // One participant per chunk at most, the calling thread is one of them.
+  const int numIndices = end - begin;
+  const int numChunks = (numIndices + grain - 1) / grain;
+  const int numParticipants = std::min(maxNumParticipants, numChunks);
+
+  // Initial even split of the range
+  std::vector<IndexRange> ranges(numParticipants);
+  for (int p = 0; p < numParticipants; ++p) {
+    ranges[p].begin = begin + static_cast<int>((static_cast<long long>(numIndices) * p) / numParticipants);
+    ranges[p].end = begin + static_cast<int>((static_cast<long long>(numIndices) * (p + 1)) / numParticipants);
+  }
+
+  std::atomic_bool abort{false};
+  auto participate = [&](int participantIndex, int workerIndex) {
+    try {
+      int chunkBegin, chunkEnd;
+      while (!abort && (popFront(ranges[participantIndex], grain, chunkBegin, chunkEnd) ||
+                        (steal(ranges, participantIndex, grain) && popFront(ranges[participantIndex], grain, chunkBegin, chunkEnd)))) {
+        for (int i = chunkBegin; i < chunkEnd; ++i) {
+          taskFunction(workerIndex, i);
+        }
+      }
+    } catch (...) {
+      abort = true;
+      throw;
+    }
+  };
+
+  // The helpers use the worker indices in [0, callerWorkerIndex - 1]. A helper keeps the index of the pool worker it runs on if that one
+  // is in range and not yet taken, otherwise it takes the first free one. There are never more helpers than indices.
+  std::vector<std::atomic_bool> indexTaken(callerWorkerIndex);
+  for (auto& taken : indexTaken) {
+    taken = false;
+  }
+  auto claimWorkerIndex = [&](int poolWorkerIndex) {
+    if (poolWorkerIndex < callerWorkerIndex && !indexTaken[poolWorkerIndex].exchange(true)) {
+      return poolWorkerIndex;
+    }
+    int workerIndex = 0;
+    while (indexTaken[workerIndex].exchange(true)) {
+      ++workerIndex;
+    }
+    return workerIndex;
+  };
+
+  // Launch helpers, the first block is processed by this thread.
+  std::vector<std::future<void>> futures;
+  futures.reserve(numParticipants - 1);
+  for (int p = 1; p < numParticipants; ++p) {
+    futures.emplace_back(
+        run([&participate, &claimWorkerIndex, p](int poolWorkerIndex) { participate(p, claimWorkerIndex(poolWorkerIndex)); }));
+  }
+
+  std::exception_ptr exceptionPtr;
+  try {
+    participate(0, callerWorkerIndex);
+  } catch (...) {
+    exceptionPtr = std::current_exception();
+  }
+
+  // Wait for all helpers to finish before rethrowing, since they reference data of this scope.
+  waitForAll(futures, exceptionPtr);
+  if (exceptionPtr) {
+    std::rethrow_exception(exceptionPtr);
+  }
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+void ThreadPool::runOnEachThread(std::function<void(int)> taskFunction) {
+  const size_t numWorkers = numThreads();
+
+  // Each helper blocks until all helpers have started, hence no worker can run two of them.
+  std::mutex barrierMutex;
+  std::condition_variable barrierCondition;
+  size_t numStarted = 0;
+  auto helperTask = [&](int workerIndex) {
+    {
+      std::unique_lock<std::mutex> lock(barrierMutex);
+      ++numStarted;
+      barrierCondition.notify_all();
+      barrierCondition.wait(lock, [&] { return numStarted == numWorkers; });
+    }
+    taskFunction(workerIndex);
+  };
+
+  std::vector<std::future<void>> futures;
+  futures.reserve(numWorkers);
+  for (size_t i = 0; i < numWorkers; ++i) {
+    futures.emplace_back(run(helperTask));
+  }
+
+  std::exception_ptr exceptionPtr;
+  try {
+    taskFunction(static_cast<int>(numWorkers));  // threadpool workers use ID 0 -> nThreads - 1
+  } catch (...) {
+    exceptionPtr = std::current_exception();
+  }
+
+  // Wait for all helpers to finish before rethrowing, since they reference data of this scope.
+  waitForAll(futures, exceptionPtr);
+  if (exceptionPtr) {
+    std::rethrow_exception(exceptionPtr);
+  }
+}
+
 }  // namespace ocs2
@@ -0,0 +1,65 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/constraint/BoxConstraint.h>
+
+TEST(TestBoxConstraint, sortedBounds) {
+  const ocs2::BoxConstraint constraint({{2, -1.0, 1.0}, {0, -2.0, 2.0}}, {{1, 0.0, 1.0}});
+  ASSERT_EQ(constraint.getStateBounds().size(), 2);
+  EXPECT_EQ(constraint.getStateBounds()[0].index, 0);
+  EXPECT_EQ(constraint.getStateBounds()[1].index, 2);
+  ASSERT_EQ(constraint.getInputBounds().size(), 1);
+  EXPECT_FALSE(constraint.empty());
+  EXPECT_TRUE(ocs2::BoxConstraint().empty());
+}
+
+TEST(TestBoxConstraint, inconsistentBounds) {
+  EXPECT_ANY_THROW(ocs2::BoxConstraint({{0, -1.0, 1.0}, {0, -2.0, 2.0}}, {}));
+  EXPECT_ANY_THROW(ocs2::BoxConstraint({}, {{0, 1.0, -1.0}}));
+}
+
+TEST(TestBoxConstraint, deviationBounds) {
+  const ocs2::BoxConstraint constraint({{2, -1.0, 1.0}, {0, -2.0, 2.0}}, {{1, 0.0, 1.0}});
+  const ocs2::vector_t x = (ocs2::vector_t(3) << 0.5, 10.0, 1.5).finished();
+  const ocs2::vector_t u = (ocs2::vector_t(2) << 0.0, -1.0).finished();
+
+  ocs2::vector_t lowerBound, upperBound;
+  constraint.getStateDeviationBounds(x, lowerBound, upperBound);
+  EXPECT_TRUE(lowerBound.isApprox((ocs2::vector_t(2) << -2.5, -2.5).finished()));
+  EXPECT_TRUE(upperBound.isApprox((ocs2::vector_t(2) << 1.5, -0.5).finished()));
+  constraint.getInputDeviationBounds(u, lowerBound, upperBound);
+  EXPECT_TRUE(lowerBound.isApprox((ocs2::vector_t(1) << 1.0).finished()));
+  EXPECT_TRUE(upperBound.isApprox((ocs2::vector_t(1) << 2.0).finished()));
+
+  // only the third state and the second input are out of bounds
+  EXPECT_DOUBLE_EQ(constraint.getStateViolationSquaredNorm(x), 0.25);
+  EXPECT_DOUBLE_EQ(constraint.getInputViolationSquaredNorm(u), 1.0);
+}
@@ -122,3 +122,34 @@ TEST(TestStateInputConstraintCppAd, getValue) {
   EXPECT_TRUE(quad.dfduu[0].isZero());
   EXPECT_TRUE(quad.dfduu[1].isApprox((ocs2::matrix_t(1, 1) << -2).finished()));
 }
+
+TEST(TestStateInputConstraintCppAd, getSparseApproximation) {
+  TestStateInputConstraint constraint;
+
+  const ocs2::scalar_t t = 0.0;
+  const ocs2::vector_t x = ocs2::vector_t::Ones(2);
+  const ocs2::vector_t u = ocs2::vector_t::Ones(1);
+  const ocs2::vector_t multipliers = (ocs2::vector_t(2) << 2.0, 3.0).finished();
+
+  const auto quad = constraint.getQuadraticApproximation(t, x, u, ocs2::PreComputation());
+
+  ocs2::vector_t value;
+  ocs2::CppAdInterface::sparse_matrix_t jacobian;
+  ocs2::CppAdInterface::sparse_matrix_t hessian;
+  constraint.getSparseLinearApproximation(t, x, u, ocs2::PreComputation(), value, jacobian);
+  constraint.getSparseWeightedHessian(t, x, u, ocs2::PreComputation(), multipliers, hessian);
+
+  EXPECT_TRUE(value.isApprox(quad.f));
+  const ocs2::matrix_t denseJacobian = jacobian;
+  EXPECT_TRUE(denseJacobian.col(0).isZero());
+  EXPECT_TRUE(denseJacobian.middleCols(1, 2).isApprox(quad.dfdx));
+  EXPECT_TRUE(denseJacobian.rightCols(1).isApprox(quad.dfdu));
+
+  const ocs2::matrix_t denseHessian = hessian;
+  EXPECT_TRUE(denseHessian.block(1, 1, 2, 2).isApprox(2.0 * quad.dfdxx[0] + 3.0 * quad.dfdxx[1]));
+  EXPECT_TRUE(denseHessian.bottomRightCorner(1, 1).isApprox(2.0 * quad.dfduu[0] + 3.0 * quad.dfduu[1]));
+  EXPECT_TRUE(denseHessian.triangularView<Eigen::StrictlyLower>().toDenseMatrix().isZero());
+  // only the nonzeros are stored
+  EXPECT_EQ(jacobian.nonZeros(), 6);
+  EXPECT_EQ(hessian.nonZeros(), 3);
+}
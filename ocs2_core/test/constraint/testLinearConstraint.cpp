@@ -51,6 +51,27 @@ TEST(TestLinearConstraint, testLinearStateInputConstraint) {
   EXPECT_TRUE(approx.dfdu.isApprox(D));
 }
 
+TEST(TestLinearConstraint, testLinearStateInputConstraintStacked) {
+  const ocs2::vector_t e = ocs2::vector_t::Random(3);
+  const ocs2::matrix_t C = ocs2::matrix_t::Random(3, 2);
+  const ocs2::matrix_t D = ocs2::matrix_t::Random(3, 1);
+  ocs2::LinearStateInputConstraint constraint(e, C, D);
+
+  const ocs2::scalar_t t = 0.0;
+  const ocs2::vector_t x = ocs2::vector_t::Random(2);
+  const ocs2::vector_t u = ocs2::vector_t::Random(1);
+
+  // the constraint is written into the rows [2, 5) of the stacked approximation and the other rows are untouched
+  auto stacked = ocs2::VectorFunctionLinearApproximation::Zero(7, 2, 1);
+  constraint.writeLinearApproximation(t, x, u, ocs2::PreComputation(), 2, stacked);
+  const auto approx = constraint.getLinearApproximation(t, x, u, ocs2::PreComputation());
+  EXPECT_TRUE(stacked.f.segment(2, 3).isApprox(approx.f));
+  EXPECT_TRUE(stacked.dfdx.middleRows(2, 3).isApprox(approx.dfdx));
+  EXPECT_TRUE(stacked.dfdu.middleRows(2, 3).isApprox(approx.dfdu));
+  EXPECT_TRUE(stacked.f.head(2).isZero() && stacked.f.tail(2).isZero());
+  EXPECT_TRUE(stacked.dfdx.topRows(2).isZero() && stacked.dfdx.bottomRows(2).isZero());
+}
+
 TEST(TestLinearConstraint, testLinearStateConstraint) {
   const ocs2::vector_t e = ocs2::vector_t::Random(3);
   const ocs2::matrix_t C = ocs2::matrix_t::Random(3, 2);
@@ -22,3 +22,24 @@ TEST(testFeedforwardController, testSerialization) {
     EXPECT_TRUE(controller.uffArray_[k].isApprox(controllerOut.uffArray_[k], 1e-6));
   }
 }
+
+TEST(testFeedforwardController, testContiguousSerialization) {
+  scalar_array_t time = {0.0, 0.5, 0.5, 1.0};
+  vector_array_t uff = {vector_t::Random(2), vector_t::Random(2), vector_t::Random(3), vector_t::Random(3)};
+  FeedforwardController controller(time, uff);
+
+  const scalar_array_t queryTime = {0.0, 0.25, 0.5, 0.75, 1.0};
+  const size_array_t inputDim = {2, 2, 2, 3, 3};
+
+  std::vector<float> flatData;
+  controller.flatten(queryTime, flatData);
+  ASSERT_EQ(flatData.size(), 12);
+
+  const auto controllerOut = FeedforwardController::unFlatten(inputDim, queryTime, flatData);
+  for (int k = 0; k < queryTime.size(); k++) {
+    EXPECT_TRUE(LinearInterpolation::interpolate(queryTime[k], time, uff).isApprox(controllerOut.uffArray_[k], 1e-6));
+  }
+
+  flatData.pop_back();
+  EXPECT_ANY_THROW(FeedforwardController::unFlatten(inputDim, queryTime, flatData));
+}
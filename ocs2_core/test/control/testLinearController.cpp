@@ -24,3 +24,59 @@ TEST(testLinearController, testSerialization) {
     EXPECT_TRUE(controller.biasArray_[k].isApprox(controllerOut.biasArray_[k], 1e-6));
   }
 }
+
+TEST(testLinearController, testContiguousSerialization) {
+  scalar_array_t time = {0.0, 0.5, 0.5, 1.0};
+  vector_array_t bias = {vector_t::Random(2), vector_t::Random(2), vector_t::Random(3), vector_t::Random(3)};
+  matrix_array_t gain = {matrix_t::Random(2, 3), matrix_t::Random(2, 3), matrix_t::Random(3, 4), matrix_t::Random(3, 4)};
+  LinearController controller(time, bias, gain);
+
+  const scalar_array_t queryTime = {0.0, 0.25, 0.5, 0.75, 1.0};
+  const size_array_t stateDim = {3, 3, 3, 4, 4};
+  const size_array_t inputDim = {2, 2, 2, 3, 3};
+
+  std::vector<std::vector<float>> data(queryTime.size());
+  std::vector<std::vector<float>*> dataPtr;
+  for (auto& d : data) {
+    dataPtr.push_back(&d);
+  }
+  controller.flatten(queryTime, dataPtr);
+
+  std::vector<float> flatData;
+  controller.flatten(queryTime, flatData);
+
+  // the contiguous buffer is the concatenation of the per time data
+  std::vector<float> concatenatedData;
+  for (const auto& d : data) {
+    concatenatedData.insert(concatenatedData.end(), d.begin(), d.end());
+  }
+  EXPECT_EQ(flatData, concatenatedData);
+
+  const auto controllerOut = LinearController::unFlatten(stateDim, inputDim, queryTime, flatData);
+  for (int k = 0; k < queryTime.size(); k++) {
+    const auto t = queryTime[k];
+    EXPECT_TRUE(LinearInterpolation::interpolate(t, time, gain).isApprox(controllerOut.gainArray_[k], 1e-6));
+    EXPECT_TRUE(LinearInterpolation::interpolate(t, time, bias).isApprox(controllerOut.biasArray_[k], 1e-6));
+  }
+
+  flatData.pop_back();
+  EXPECT_ANY_THROW(LinearController::unFlatten(stateDim, inputDim, queryTime, flatData));
+}
+
+TEST(testLinearController, testComputeInput) {
+  scalar_array_t time = {0.0, 0.5, 0.5, 1.0};
+  vector_array_t bias = {vector_t::Random(2), vector_t::Random(2), vector_t::Random(2), vector_t::Random(2)};
+  matrix_array_t gain = {matrix_t::Random(2, 3), matrix_t::Random(2, 3), matrix_t::Random(2, 3), matrix_t::Random(2, 3)};
+  LinearController controller(time, bias, gain);
+
+  const vector_t x = vector_t::Random(3);
+  for (const auto t : {-0.1, 0.0, 0.1, 0.5, 0.6, 1.0, 1.1}) {
+    const vector_t uRef = LinearInterpolation::interpolate(t, time, bias) + LinearInterpolation::interpolate(t, time, gain) * x;
+    EXPECT_TRUE(controller.computeInput(t, x).isApprox(uRef, 1e-9)) << "at time " << t;
+  }
+
+  // a single node is a constant control law
+  LinearController singleNodeController({0.0}, {bias.front()}, {gain.front()});
+  const vector_t uRef = bias.front() + gain.front() * x;
+  EXPECT_TRUE(singleNodeController.computeInput(1.0, x).isApprox(uRef, 1e-9));
+}
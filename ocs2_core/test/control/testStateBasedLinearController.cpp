@@ -0,0 +1,37 @@
+#include <gtest/gtest.h>
+
+#include <ocs2_core/control/LinearController.h>
+#include <ocs2_core/control/StateBasedLinearController.h>
+
+using namespace ocs2;
+
+TEST(testStateBasedLinearController, testComputeInput) {
+  // the controller is designed for the events at 1.0 and 2.0
+  const scalar_array_t time = {0.0, 0.5, 1.0, 1.0, 1.5, 2.0, 2.0, 2.5, 3.0};
+  vector_array_t bias;
+  matrix_array_t gain;
+  for (size_t i = 0; i < time.size(); i++) {
+    bias.push_back(vector_t::Random(2));
+    gain.push_back(matrix_t::Random(2, 3));
+  }
+  LinearController controller(time, bias, gain);
+  LinearController referenceController(time, bias, gain);
+  const auto eventTimes = controller.controllerEventTimes();
+  ASSERT_EQ(eventTimes.size(), 3);
+
+  StateBasedLinearController stateBasedController;
+  stateBasedController.setController(&controller);
+
+  // the events of the rollout happen before, at, or after the designed event times
+  const std::vector<std::pair<scalar_t, size_t>> queries = {{0.0, 0},  {0.4, 0}, {0.8, 0}, {0.9, 1}, {1.2, 1}, {1.2, 0}, {1.6, 1},
+                                                            {2.1, 1},  {2.1, 2}, {2.4, 2}, {2.9, 2}, {3.2, 2}, {0.2, 1}, {0.7, 0},
+                                                            {2.6, 3},  {1.7, 2}, {3.0, 4}, {0.3, 0}};
+  for (const auto& query : queries) {
+    vector_t x = vector_t::Random(3);
+    x(2) = query.second;
+    const vector_t uRef =
+        StateBasedLinearController::computeTrajectorySpreadingInput(query.first, x, eventTimes, &referenceController);
+    EXPECT_TRUE(stateBasedController.computeInput(query.first, x).isApprox(uRef, 1e-9))
+        << "at time " << query.first << " in mode " << query.second;
+  }
+}
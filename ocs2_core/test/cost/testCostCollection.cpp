@@ -29,8 +29,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <gtest/gtest.h>
 
+#include <thread>
+
+#include <ocs2_core/cost/QuadraticStateInputCost.h>
 #include <ocs2_core/cost/StateCostCollection.h>
 #include <ocs2_core/cost/StateInputCostCollection.h>
+#include <ocs2_core/penalties/penalties/RelaxedBarrierPenalty.h>
+#include <ocs2_core/soft_constraint/StateInputSoftBoxConstraint.h>
 
 class SimpleQuadraticCost final : public ocs2::StateInputCost {
  public:
@@ -117,6 +122,47 @@ TEST_F(StateInputCost_TestFixture, getStateInputCostApproximation) {
   EXPECT_TRUE((cost.dfdux.array() == 0.0).all());
 }
 
+TEST_F(StateInputCost_TestFixture, accumulateStateInputCostApproximation) {
+  auto cost = ocs2::ScalarFunctionQuadraticApproximation::Zero(STATE_DIM, INPUT_DIM);
+  cost.f = 1.0;
+  costCollection.accumulateQuadraticApproximation(t, x, u, targetTrajectories, {}, cost);
+  costCollection.accumulateQuadraticApproximation(t, x, u, targetTrajectories, {}, cost);
+  EXPECT_NEAR(cost.f, 1.0 + 2.0 * expectedCost, 1e-6);
+  EXPECT_TRUE(cost.dfdx.isApprox(2.0 * expectedCostApproximation.dfdx));
+  EXPECT_TRUE(cost.dfdu.isApprox(2.0 * expectedCostApproximation.dfdu));
+  EXPECT_TRUE(cost.dfdxx.isApprox(2.0 * expectedCostApproximation.dfdxx));
+  EXPECT_TRUE(cost.dfduu.isApprox(2.0 * expectedCostApproximation.dfduu));
+}
+
+/** Scales the approximation of its terms, without overriding accumulateQuadraticApproximation() */
+class ScaledCostCollection final : public ocs2::StateInputCostCollection {
+ public:
+  ScaledCostCollection* clone() const override { return new ScaledCostCollection(*this); }
+
+  ocs2::ScalarFunctionQuadraticApproximation getQuadraticApproximation(ocs2::scalar_t t, const ocs2::vector_t& x, const ocs2::vector_t& u,
+                                                                       const ocs2::TargetTrajectories& targetTrajectories,
+                                                                       const ocs2::PreComputation& preComp) const override {
+    auto cost = ocs2::StateInputCostCollection::getQuadraticApproximation(t, x, u, targetTrajectories, preComp);
+    cost *= 2.0;
+    return cost;
+  }
+};
+
+TEST_F(StateInputCost_TestFixture, accumulateOverriddenCostApproximation) {
+  ScaledCostCollection scaledCollection;
+  scaledCollection.add("Simple quadratic cost", std::unique_ptr<ocs2::StateInputCost>(costCollection.get("Simple quadratic cost").clone()));
+  scaledCollection.add("Another simple quadratic cost",
+                       std::unique_ptr<ocs2::StateInputCost>(costCollection.get("Another simple quadratic cost").clone()));
+
+  auto cost = ocs2::ScalarFunctionQuadraticApproximation::Zero(STATE_DIM, INPUT_DIM);
+  scaledCollection.accumulateQuadraticApproximation(t, x, u, targetTrajectories, {}, cost);
+  EXPECT_NEAR(cost.f, 2.0 * expectedCost, 1e-6);
+  EXPECT_TRUE(cost.dfdx.isApprox(2.0 * expectedCostApproximation.dfdx));
+  EXPECT_TRUE(cost.dfdu.isApprox(2.0 * expectedCostApproximation.dfdu));
+  EXPECT_TRUE(cost.dfdxx.isApprox(2.0 * expectedCostApproximation.dfdxx));
+  EXPECT_TRUE(cost.dfduu.isApprox(2.0 * expectedCostApproximation.dfduu));
+}
+
 TEST_F(StateInputCost_TestFixture, canGetCostFunction) {
   const auto& costFunction = costCollection.get("Simple quadratic cost");
 }
@@ -148,12 +194,122 @@ TEST_F(StateInputCost_TestFixture, canDeactivateCost) {
   EXPECT_DOUBLE_EQ(cost, cost2.getValue(t, x, u, targetTrajectories, {}));
 }
 
+TEST_F(StateInputCost_TestFixture, canCacheTermActivity) {
+  auto& cost1 = costCollection.get<SimpleQuadraticCost>("Simple quadratic cost");
+  auto& cost2 = costCollection.get<SimpleQuadraticCost>("Another simple quadratic cost");
+  const auto cost2Value = cost2.getValue(t, x, u, targetTrajectories, {});
+
+  // the activity is evaluated once per interval and not on every call
+  cost1.active_ = false;
+  costCollection.cacheTermActivity(ocs2::ModeSchedule({0.5, 1.0}, {0, 1, 2}));
+  cost1.active_ = true;
+  for (const ocs2::scalar_t time : {0.0, 0.5, 0.75, 2.0}) {
+    EXPECT_DOUBLE_EQ(costCollection.getValue(time, x, u, targetTrajectories, {}), cost2Value);
+  }
+
+  // the cache is copied on clone
+  std::unique_ptr<ocs2::StateInputCostCollection> newCollection(costCollection.clone());
+  EXPECT_DOUBLE_EQ(newCollection->getValue(t, x, u, targetTrajectories, {}), cost2Value);
+
+  costCollection.clearTermActivityCache();
+  EXPECT_NEAR(costCollection.getValue(t, x, u, targetTrajectories, {}), expectedCost, 1e-6);
+}
+
 TEST_F(StateInputCost_TestFixture, canClone) {
   std::unique_ptr<ocs2::StateInputCostCollection> newCollection(costCollection.clone());
   const auto cost = newCollection->getValue(t, x, u, targetTrajectories, {});
   EXPECT_NEAR(cost, expectedCost, 1e-6);
 }
 
+class SwitchedQuadraticCost final : public ocs2::QuadraticStateInputCost {
+ public:
+  using ocs2::QuadraticStateInputCost::QuadraticStateInputCost;
+  SwitchedQuadraticCost* clone() const override { return new SwitchedQuadraticCost(*this); }
+  bool isActive(ocs2::scalar_t time) const override { return time < 1.0; }
+};
+
+TEST_F(StateInputCost_TestFixture, canCacheConstantHessians) {
+  const ocs2::TargetTrajectories targets({0.0}, {ocs2::vector_t::Random(STATE_DIM)}, {ocs2::vector_t::Random(INPUT_DIM)});
+  const ocs2::matrix_t Q = ocs2::matrix_t::Identity(STATE_DIM, STATE_DIM);
+  const ocs2::matrix_t R = 2.0 * ocs2::matrix_t::Identity(INPUT_DIM, INPUT_DIM);
+  const ocs2::matrix_t P = ocs2::matrix_t::Random(INPUT_DIM, STATE_DIM);
+  costCollection.add("Constant quadratic cost", std::unique_ptr<ocs2::QuadraticStateInputCost>(new ocs2::QuadraticStateInputCost(Q, R)));
+  costCollection.add("Switched quadratic cost", std::unique_ptr<SwitchedQuadraticCost>(new SwitchedQuadraticCost(Q, R, P)));
+
+  auto expectApproximationOfActiveTerms = [&](const ocs2::StateInputCostCollection& collection, ocs2::scalar_t time) {
+    auto expected = ocs2::ScalarFunctionQuadraticApproximation::Zero(STATE_DIM, INPUT_DIM);
+    const std::vector<std::string> names{"Simple quadratic cost", "Another simple quadratic cost", "Constant quadratic cost",
+                                         "Switched quadratic cost"};
+    for (const auto& name : names) {
+      const auto& term = costCollection.get(name);
+      if (term.isActive(time)) {
+        expected += term.getQuadraticApproximation(time, x, u, targets, {});
+      }
+    }
+    // evaluate twice such that the cached Hessian is used as well
+    for (size_t i = 0; i < 2; i++) {
+      const auto cost = collection.getQuadraticApproximation(time, x, u, targets, {});
+      EXPECT_NEAR(cost.f, expected.f, 1e-9);
+      EXPECT_TRUE(cost.dfdx.isApprox(expected.dfdx));
+      EXPECT_TRUE(cost.dfdu.isApprox(expected.dfdu));
+      EXPECT_TRUE(cost.dfdxx.isApprox(expected.dfdxx));
+      EXPECT_TRUE(cost.dfdux.isApprox(expected.dfdux));
+      EXPECT_TRUE(cost.dfduu.isApprox(expected.dfduu));
+    }
+  };
+
+  // the activity pattern of the constant terms differs between the two times
+  expectApproximationOfActiveTerms(costCollection, 0.5);
+  expectApproximationOfActiveTerms(costCollection, 1.5);
+
+  std::unique_ptr<ocs2::StateInputCostCollection> newCollection(costCollection.clone());
+  expectApproximationOfActiveTerms(*newCollection, 0.5);
+
+  // the cached Hessians are invalidated by adding a term
+  costCollection.add("Another constant quadratic cost",
+                     std::unique_ptr<ocs2::QuadraticStateInputCost>(new ocs2::QuadraticStateInputCost(Q, R)));
+  const auto cost = costCollection.getQuadraticApproximation(0.5, x, u, targets, {});
+  EXPECT_TRUE(cost.dfduu.isApprox(newCollection->getQuadraticApproximation(0.5, x, u, targets, {}).dfduu + R));
+}
+
+TEST_F(StateInputCost_TestFixture, canCacheConstantHessiansConcurrently) {
+  const ocs2::TargetTrajectories targets({0.0}, {ocs2::vector_t::Random(STATE_DIM)}, {ocs2::vector_t::Random(INPUT_DIM)});
+  const ocs2::matrix_t Q = ocs2::matrix_t::Identity(STATE_DIM, STATE_DIM);
+  const ocs2::matrix_t R = 2.0 * ocs2::matrix_t::Identity(INPUT_DIM, INPUT_DIM);
+  const ocs2::matrix_t P = ocs2::matrix_t::Random(INPUT_DIM, STATE_DIM);
+  costCollection.add("Constant quadratic cost", std::unique_ptr<ocs2::QuadraticStateInputCost>(new ocs2::QuadraticStateInputCost(Q, R)));
+  costCollection.add("Switched quadratic cost", std::unique_ptr<SwitchedQuadraticCost>(new SwitchedQuadraticCost(Q, R, P)));
+
+  // expected results from a separate collection, such that the shared one starts with an empty cache
+  std::unique_ptr<ocs2::StateInputCostCollection> referenceCollection(costCollection.clone());
+  const ocs2::scalar_array_t times{0.5, 1.5};
+  std::vector<ocs2::ScalarFunctionQuadraticApproximation> expected;
+  for (const auto time : times) {
+    expected.push_back(referenceCollection->getQuadraticApproximation(time, x, u, targets, {}));
+  }
+
+  constexpr size_t numThreads = 4;
+  std::vector<int> numMismatches(numThreads, 0);
+  std::vector<std::thread> threads;
+  for (size_t j = 0; j < numThreads; j++) {
+    threads.emplace_back([&, j]() {
+      for (size_t k = 0; k < 100; k++) {
+        const size_t i = (j + k) % times.size();
+        const auto cost = costCollection.getQuadraticApproximation(times[i], x, u, targets, {});
+        if (!cost.dfdxx.isApprox(expected[i].dfdxx) || !cost.dfdux.isApprox(expected[i].dfdux) || !cost.dfduu.isApprox(expected[i].dfduu)) {
+          numMismatches[j]++;
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (size_t j = 0; j < numThreads; j++) {
+    EXPECT_EQ(numMismatches[j], 0) << "in thread " << j;
+  }
+}
+
 class SimpleQuadraticFinalCost final : public ocs2::StateCost {
  public:
   SimpleQuadraticFinalCost(ocs2::matrix_t Q) : Q_(std::move(Q)) {}
@@ -220,3 +376,50 @@ TEST_F(StateCost_TestFixture, testStateCostApproximation) {
   EXPECT_TRUE(cost.dfdx.isApprox(expectedCostApproximation.dfdx));
   EXPECT_TRUE(cost.dfdxx.isApprox(expectedCostApproximation.dfdxx));
 }
+
+TEST_F(StateCost_TestFixture, accumulateStateCostApproximation) {
+  // a state-only cost is also accumulated to a state-input approximation
+  auto cost = ocs2::ScalarFunctionQuadraticApproximation::Zero(STATE_DIM, INPUT_DIM);
+  costCollection.accumulateQuadraticApproximation(t, x, targetTrajectories, {}, cost);
+  EXPECT_NEAR(cost.f, expectedCost, 1e-6);
+  EXPECT_TRUE(cost.dfdx.isApprox(expectedCostApproximation.dfdx));
+  EXPECT_TRUE(cost.dfdxx.isApprox(expectedCostApproximation.dfdxx));
+  EXPECT_TRUE(cost.dfdu.isZero());
+  EXPECT_TRUE(cost.dfduu.isZero());
+}
+
+TEST(StateInputCostFootprint, softBoxConstraint) {
+  const size_t STATE_DIM = 6;
+  const size_t INPUT_DIM = 3;
+  const ocs2::TargetTrajectories targetTrajectories;
+  const ocs2::vector_t x = ocs2::vector_t::Random(STATE_DIM);
+  const ocs2::vector_t u = ocs2::vector_t::Random(INPUT_DIM);
+
+  auto getBoxConstraint = [](size_t index) {
+    ocs2::StateInputSoftBoxConstraint::BoxConstraint boxConstraint;
+    boxConstraint.index = index;
+    boxConstraint.lowerBound = -2.0;
+    boxConstraint.upperBound = 2.0;
+    boxConstraint.penaltyPtr.reset(new ocs2::RelaxedBarrierPenalty({0.1, 0.1}));
+    return boxConstraint;
+  };
+  std::vector<ocs2::StateInputSoftBoxConstraint::BoxConstraint> stateBoxConstraints;
+  stateBoxConstraints.push_back(getBoxConstraint(4));
+  stateBoxConstraints.push_back(getBoxConstraint(1));
+  stateBoxConstraints.push_back(getBoxConstraint(2));
+  std::vector<ocs2::StateInputSoftBoxConstraint::BoxConstraint> inputBoxConstraints;
+  inputBoxConstraints.push_back(getBoxConstraint(0));
+  std::unique_ptr<ocs2::StateInputSoftBoxConstraint> boxCost(
+      new ocs2::StateInputSoftBoxConstraint(std::move(stateBoxConstraints), std::move(inputBoxConstraints)));
+  const auto expected = boxCost->getQuadraticApproximation(0.0, x, u, targetTrajectories, {});
+
+  ocs2::StateInputCostCollection costCollection;
+  costCollection.add("box", std::move(boxCost));
+
+  const auto cost = costCollection.getQuadraticApproximation(0.0, x, u, targetTrajectories, {});
+  EXPECT_NEAR(cost.f, expected.f, 1e-9);
+  EXPECT_TRUE(cost.dfdx.isApprox(expected.dfdx));
+  EXPECT_TRUE(cost.dfdu.isApprox(expected.dfdu));
+  EXPECT_TRUE(cost.dfdxx.isApprox(expected.dfdxx));
+  EXPECT_TRUE(cost.dfduu.isApprox(expected.dfduu));
+}
@@ -109,6 +109,33 @@ TEST(TestStateInputCostCppAd, getValue) {
   EXPECT_TRUE(approx.dfdux.isApprox((ocs2::matrix_t(1, 2) << 1, 1).finished()));
 }
 
+TEST(TestStateInputCostCppAd, getSparseQuadraticApproximation) {
+  TestStateInputCost cost;
+  const ocs2::TargetTrajectories desiredTrajectory;
+
+  const ocs2::scalar_t t = 0.0;
+  const ocs2::vector_t x = ocs2::vector_t::Ones(2);
+  const ocs2::vector_t u = ocs2::vector_t::Ones(1);
+
+  const auto approx = cost.getQuadraticApproximation(t, x, u, desiredTrajectory, ocs2::PreComputation());
+
+  ocs2::scalar_t value;
+  ocs2::CppAdInterface::sparse_matrix_t gradient;
+  ocs2::CppAdInterface::sparse_matrix_t hessian;
+  cost.getSparseQuadraticApproximation(t, x, u, desiredTrajectory, ocs2::PreComputation(), value, gradient, hessian);
+
+  EXPECT_NEAR(value, approx.f, 1e-6);
+  const ocs2::matrix_t denseGradient = gradient;
+  EXPECT_TRUE(denseGradient.block(0, 1, 1, 2).transpose().isApprox(approx.dfdx));
+  EXPECT_TRUE(denseGradient.rightCols(1).transpose().isApprox(approx.dfdu));
+
+  const ocs2::matrix_t denseHessian = hessian;
+  EXPECT_TRUE(denseHessian.block(1, 1, 2, 2).isApprox(approx.dfdxx));
+  EXPECT_TRUE(denseHessian.block(1, 3, 2, 1).transpose().isApprox(approx.dfdux));
+  EXPECT_TRUE(denseHessian.bottomRightCorner(1, 1).isApprox(approx.dfduu));
+  EXPECT_TRUE(denseHessian.triangularView<Eigen::StrictlyLower>().toDenseMatrix().isZero());
+}
+
 class TestGNStateInputCost : public ocs2::StateInputCostGaussNewtonAd {
  public:
   TestGNStateInputCost() { initialize(2, 1, 0, "TestGNStateInputCost", "/tmp/ocs2", true, false); }
@@ -159,3 +186,22 @@ TEST(TestGNStateInputCostCppAd, getValue) {
   ASSERT_DOUBLE_EQ(approx.dfdux(0, 1), 0.0);
   ASSERT_DOUBLE_EQ(approx.dfduu(0, 0), (t * t + 1.0));
 }
+
+TEST(TestGNStateInputCostCppAd, getResidualLinearApproximation) {
+  TestGNStateInputCost cost;
+  const ocs2::TargetTrajectories desiredTrajectory;
+
+  const ocs2::scalar_t t = 0.4;
+  const ocs2::vector_t x = (ocs2::vector_t(2) << 0.1, 0.2).finished();
+  const ocs2::vector_t u = (ocs2::vector_t(1) << 0.3).finished();
+
+  const auto residual = cost.getResidualLinearApproximation(t, x, u, desiredTrajectory, ocs2::PreComputation());
+  const auto approx = cost.getQuadraticApproximation(t, x, u, desiredTrajectory, ocs2::PreComputation());
+
+  EXPECT_TRUE(residual.f.isApprox(TestGNStateInputCost::costVector(t, x, u)));
+  EXPECT_TRUE(residual.dfdx.isApprox((ocs2::matrix_t(4, 2) << 1, 0, 0, 1, 0, 0, 1, 0).finished()));
+  EXPECT_TRUE(residual.dfdu.isApprox((ocs2::matrix_t(4, 1) << 0, 0, t, 1).finished()));
+  EXPECT_TRUE(approx.dfdxx.isApprox(residual.dfdx.transpose() * residual.dfdx));
+  EXPECT_TRUE(approx.dfdux.isApprox(residual.dfdu.transpose() * residual.dfdx));
+  EXPECT_TRUE(approx.dfduu.isApprox(residual.dfdu.transpose() * residual.dfdu));
+}
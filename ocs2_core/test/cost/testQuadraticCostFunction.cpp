@@ -67,6 +67,22 @@ TEST_F(testQuadraticCost, StateInputCostApproximation) {
   EXPECT_TRUE(L.dfduu.isApprox(R_, PRECISION));
 }
 
+TEST_F(testQuadraticCost, StateInputCostAccumulate) {
+  QuadraticStateInputCost costFunction(Q_, R_, P_);
+
+  const auto L = costFunction.getQuadraticApproximation(t_, x_, u_, targetTrajectories_, preComputation_);
+  auto accumulator = ScalarFunctionQuadraticApproximation::Zero(x_.rows(), u_.rows());
+  costFunction.accumulateQuadraticApproximation(t_, x_, u_, targetTrajectories_, preComputation_, accumulator);
+  costFunction.accumulateQuadraticApproximation(t_, x_, u_, targetTrajectories_, preComputation_, accumulator);
+
+  EXPECT_NEAR(accumulator.f, 2.0 * L.f, PRECISION);
+  EXPECT_TRUE(accumulator.dfdx.isApprox(2.0 * L.dfdx, PRECISION));
+  EXPECT_TRUE(accumulator.dfdu.isApprox(2.0 * L.dfdu, PRECISION));
+  EXPECT_TRUE(accumulator.dfdxx.isApprox(2.0 * L.dfdxx, PRECISION));
+  EXPECT_TRUE(accumulator.dfdux.isApprox(2.0 * L.dfdux, PRECISION));
+  EXPECT_TRUE(accumulator.dfduu.isApprox(2.0 * L.dfduu, PRECISION));
+}
+
 TEST_F(testQuadraticCost, StateInputCostClone) {
   QuadraticStateInputCost costFunction(Q_, R_, P_);
   auto costFunctionClone = std::unique_ptr<StateInputCost>(costFunction.clone());
@@ -94,6 +110,19 @@ TEST_F(testQuadraticCost, StateCostApproximation) {
   EXPECT_TRUE(Phi.dfdxx.isApprox(Qf_, PRECISION));
 }
 
+TEST_F(testQuadraticCost, StateCostAccumulate) {
+  QuadraticStateCost costFunction(Qf_);
+
+  const auto Phi = costFunction.getQuadraticApproximation(t_, x_, targetTrajectories_, preComputation_);
+  auto accumulator = ScalarFunctionQuadraticApproximation::Zero(x_.rows());
+  costFunction.accumulateQuadraticApproximation(t_, x_, targetTrajectories_, preComputation_, accumulator);
+  costFunction.accumulateQuadraticApproximation(t_, x_, targetTrajectories_, preComputation_, accumulator);
+
+  EXPECT_NEAR(accumulator.f, 2.0 * Phi.f, PRECISION);
+  EXPECT_TRUE(accumulator.dfdx.isApprox(2.0 * Phi.dfdx, PRECISION));
+  EXPECT_TRUE(accumulator.dfdxx.isApprox(2.0 * Phi.dfdxx, PRECISION));
+}
+
 TEST_F(testQuadraticCost, StateCostClone) {
   QuadraticStateCost costFunction(Qf_);
   auto costFunctionClone = std::unique_ptr<StateCost>(costFunction.clone());
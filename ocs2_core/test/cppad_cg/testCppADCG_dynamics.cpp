@@ -142,3 +142,51 @@ TEST_F(testCppADCG_dynamicsFixture, multithread_test) {
 
   ASSERT_TRUE(success && successClone);
 }
+
+/******************************************************************************/
+/******************************************************************************/
+/******************************************************************************/
+TEST(testCppADCG_dynamics, flowMapWeightedHessian) {
+  // dx/dt = [x1 * u0; sin(x0)]
+  class NonlinearSystemDynamicsAD : public SystemDynamicsBaseAD {
+   public:
+    NonlinearSystemDynamicsAD* clone() const override { return new NonlinearSystemDynamicsAD(*this); }
+
+   protected:
+    ad_vector_t systemFlowMap(ad_scalar_t time, const ad_vector_t& state, const ad_vector_t& input,
+                              const ad_vector_t& parameters) const override {
+      ad_vector_t stateDerivative(2);
+      stateDerivative << state(1) * input(0), sin(state(0));
+      return stateDerivative;
+    }
+  };
+
+  boost::filesystem::path filePath(__FILE__);
+  const std::string libraryFolder = filePath.parent_path().generic_string() + "/testCppADCG_generated";
+  NonlinearSystemDynamicsAD system;
+  system.initialize(2, 1, "testCppADCG_dynamics_hessian", libraryFolder, true, false, true);
+  std::unique_ptr<SystemDynamicsBase> systemPtr(system.clone());
+
+  const scalar_t t = 0.0;
+  const vector_t x = vector_t::Random(2);
+  const vector_t u = vector_t::Random(1);
+  const vector_t w = vector_t::Random(2);
+
+  // w' * f = w0 * x1 * u0 + w1 * sin(x0)
+  matrix_t dfdxx = matrix_t::Zero(2, 2);
+  dfdxx(0, 0) = -w(1) * std::sin(x(0));
+  matrix_t dfdux = matrix_t::Zero(1, 2);
+  dfdux(0, 1) = w(0);
+
+  for (auto* dynamicsPtr : {static_cast<SystemDynamicsBase*>(&system), systemPtr.get()}) {
+    const auto hessian = dynamicsPtr->flowMapWeightedHessian(t, x, u, w);
+    EXPECT_TRUE(hessian.dfdxx.isApprox(dfdxx));
+    EXPECT_TRUE(hessian.dfdux.isApprox(dfdux));
+    EXPECT_TRUE(hessian.dfduu.isZero());
+  }
+
+  // The first order models do not provide the Hessian
+  NonlinearSystemDynamicsAD firstOrderSystem;
+  firstOrderSystem.initialize(2, 1, "testCppADCG_dynamics_hessian", libraryFolder, true, false);
+  EXPECT_ANY_THROW(static_cast<SystemDynamicsBase&>(firstOrderSystem).flowMapWeightedHessian(t, x, u, w));
+}
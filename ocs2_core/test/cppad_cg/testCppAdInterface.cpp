@@ -1,7 +1,13 @@
 
 
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
 #include <gtest/gtest.h>
 
+#include <boost/filesystem.hpp>
+
 #include "commonFixture.h"
 
 using namespace ocs2;
@@ -43,6 +49,78 @@ TEST_F(CppAdInterfaceParameterizedFixture, testModelGeneration) {
   ASSERT_TRUE(gnApproximation.dfdxx.isApprox(testJacobian(x, p).transpose() * testJacobian(x, p)));
 }
 
+TEST_F(CppAdInterfaceParameterizedFixture, evaluateIntoPreallocatedOutputs) {
+  ocs2::CppAdInterface adInterface(funImpl, variableDim_, parameterDim_, "testModelEvaluateInto");
+  adInterface.createModels(ocs2::CppAdInterface::ApproximationOrder::Second, false);
+
+  vector_t value(rangeDim_);
+  matrix_t jacobian(rangeDim_, variableDim_);
+  // outputs can be blocks of larger matrices
+  matrix_t hessians = matrix_t::Zero(variableDim_, 2 * variableDim_);
+  for (int i = 0; i < 3; i++) {
+    vector_t x = vector_t::Random(variableDim_);
+    vector_t p = vector_t::Random(parameterDim_);
+    vector_t w = vector_t::Random(rangeDim_);
+
+    adInterface.getFunctionValue(x, p, value);
+    adInterface.getJacobian(x, p, jacobian);
+    adInterface.getHessian(w, x, p, hessians.rightCols(variableDim_));
+    ASSERT_TRUE(value.isApprox(testFun(x, p)));
+    ASSERT_TRUE(jacobian.isApprox(testJacobian(x, p)));
+    ASSERT_TRUE(hessians.rightCols(variableDim_).isApprox(adInterface.getHessian(w, x, p)));
+    ASSERT_TRUE(hessians.leftCols(variableDim_).isZero());
+  }
+}
+
+TEST_F(CppAdInterfaceParameterizedFixture, evaluateBatch) {
+  ocs2::CppAdInterface adInterface(funImpl, variableDim_, parameterDim_, "testModelEvaluateBatch");
+  adInterface.createModels(ocs2::CppAdInterface::ApproximationOrder::First, false);
+
+  constexpr int batchSize = 5;
+  const matrix_t xBatch = matrix_t::Random(variableDim_, batchSize);
+  const matrix_t pBatch = matrix_t::Random(parameterDim_, batchSize);
+  matrix_t valueBatch(rangeDim_, batchSize);
+  matrix_t jacobianBatch(rangeDim_, variableDim_ * batchSize);
+  adInterface.getFunctionValueBatch(xBatch, pBatch, valueBatch);
+  adInterface.getJacobianBatch(xBatch, pBatch, jacobianBatch);
+
+  for (int k = 0; k < batchSize; k++) {
+    const vector_t x = xBatch.col(k);
+    const vector_t p = pBatch.col(k);
+    ASSERT_TRUE(valueBatch.col(k).isApprox(testFun(x, p)));
+    ASSERT_TRUE(jacobianBatch.middleCols(k * variableDim_, variableDim_).isApprox(testJacobian(x, p)));
+  }
+}
+
+TEST_F(CppAdInterfaceParameterizedFixture, sparseOutputs) {
+  ocs2::CppAdInterface adInterface(funImpl, variableDim_, parameterDim_, "testModelSparseOutputs");
+  adInterface.createModels(ocs2::CppAdInterface::ApproximationOrder::Second, false);
+
+  ocs2::CppAdInterface::sparse_matrix_t sparseJacobian;
+  ocs2::CppAdInterface::sparse_matrix_t sparseHessian;
+  const scalar_t* jacobianValues = nullptr;
+  const scalar_t* hessianValues = nullptr;
+  for (int i = 0; i < 3; i++) {
+    vector_t x = vector_t::Random(variableDim_);
+    vector_t p = vector_t::Random(parameterDim_);
+    vector_t w = vector_t::Random(rangeDim_);
+
+    adInterface.getSparseJacobian(x, p, sparseJacobian);
+    adInterface.getSparseHessian(w, x, p, sparseHessian);
+    ASSERT_TRUE(matrix_t(sparseJacobian).isApprox(adInterface.getJacobian(x, p)));
+    const matrix_t hessian = adInterface.getHessian(w, x, p);
+    ASSERT_TRUE(matrix_t(sparseHessian).isApprox(matrix_t(hessian.triangularView<Eigen::Upper>())));
+
+    // the storage of the outputs is reused
+    if (i > 0) {
+      ASSERT_EQ(jacobianValues, sparseJacobian.valuePtr());
+      ASSERT_EQ(hessianValues, sparseHessian.valuePtr());
+    }
+    jacobianValues = sparseJacobian.valuePtr();
+    hessianValues = sparseHessian.valuePtr();
+  }
+}
+
 TEST_F(CppAdInterfaceParameterizedFixture, loadIfAvailable) {
   ocs2::CppAdInterface adInterface(funImpl, variableDim_, parameterDim_, "testModelLoadIfAvailable");
 
@@ -60,3 +138,191 @@ TEST_F(CppAdInterfaceParameterizedFixture, loadIfAvailable) {
   ASSERT_TRUE(gnApproximation.dfdx.isApprox(testJacobian(x, p).transpose() * testFun(x, p)));
   ASSERT_TRUE(gnApproximation.dfdxx.isApprox(testJacobian(x, p).transpose() * testJacobian(x, p)));
 }
+
+TEST_F(CppAdInterfaceParameterizedFixture, createModelsConcurrently) {
+  constexpr size_t numModels = 4;
+  std::vector<std::unique_ptr<ocs2::CppAdInterface>> adInterfaces;
+  std::vector<ocs2::CppAdInterface*> adInterfacePtrs;
+  for (size_t i = 0; i < numModels; i++) {
+    adInterfaces.emplace_back(new ocs2::CppAdInterface(funImpl, variableDim_, parameterDim_, "testModelConcurrent" + std::to_string(i)));
+    adInterfacePtrs.push_back(adInterfaces.back().get());
+  }
+
+  ocs2::CppAdInterface::setMaxNumCompilerJobs(2);
+  ocs2::CppAdInterface::createModelsConcurrently(adInterfacePtrs, ocs2::CppAdInterface::ApproximationOrder::Second, false);
+
+  vector_t x = vector_t::Random(variableDim_);
+  vector_t p = vector_t::Random(parameterDim_);
+  for (const auto& adInterface : adInterfaces) {
+    ASSERT_TRUE(adInterface->getFunctionValue(x, p).isApprox(testFun(x, p)));
+    ASSERT_TRUE(adInterface->getJacobian(x, p).isApprox(testJacobian(x, p)));
+    ASSERT_TRUE(adInterface->getHessian(0, x, p).isApprox(testHessian(0, x, p)));
+  }
+
+  // load the libraries that were just created
+  std::vector<std::unique_ptr<ocs2::CppAdInterface>> loadedInterfaces;
+  adInterfacePtrs.clear();
+  for (size_t i = 0; i < numModels; i++) {
+    loadedInterfaces.emplace_back(new ocs2::CppAdInterface(funImpl, variableDim_, parameterDim_, "testModelConcurrent" + std::to_string(i)));
+    adInterfacePtrs.push_back(loadedInterfaces.back().get());
+  }
+  ocs2::CppAdInterface::loadModelsIfAvailableConcurrently(adInterfacePtrs, ocs2::CppAdInterface::ApproximationOrder::Second, false);
+  for (const auto& adInterface : loadedInterfaces) {
+    ASSERT_TRUE(adInterface->getFunctionValue(x, p).isApprox(testFun(x, p)));
+  }
+}
+
+TEST_F(CppAdInterfaceParameterizedFixture, loadIfAvailableByTapeHash) {
+  const std::string modelName = "testModelTapeHash";
+  const boost::filesystem::path libraryFolder = boost::filesystem::path("/tmp/ocs2") / modelName / "cppad_generated";
+  boost::filesystem::remove_all(libraryFolder.parent_path());
+
+  auto countLibraries = [&]() {
+    size_t numLibraries = 0;
+    for (const auto& entry : boost::filesystem::directory_iterator(libraryFolder)) {
+      numLibraries += (entry.path().extension() == ".so") ? 1 : 0;
+    }
+    return numLibraries;
+  };
+
+  auto scaledFunImpl = [](const ad_vector_t& x, const ad_vector_t& p, ad_vector_t& y) {
+    funImpl(x, p, y);
+    y *= ad_scalar_t(2.0);
+  };
+
+  vector_t x = vector_t::Random(variableDim_);
+  vector_t p = vector_t::Random(parameterDim_);
+
+  ocs2::CppAdInterface adInterface(funImpl, variableDim_, parameterDim_, modelName);
+  adInterface.loadModelsIfAvailable(ocs2::CppAdInterface::ApproximationOrder::Second, false);
+  ASSERT_EQ(countLibraries(), 1);
+
+  // a changed function under the same name is regenerated
+  ocs2::CppAdInterface scaledInterface(scaledFunImpl, variableDim_, parameterDim_, modelName);
+  scaledInterface.loadModelsIfAvailable(ocs2::CppAdInterface::ApproximationOrder::Second, false);
+  ASSERT_EQ(countLibraries(), 2);
+  ASSERT_TRUE(scaledInterface.getFunctionValue(x, p).isApprox(2.0 * testFun(x, p)));
+  ASSERT_TRUE(scaledInterface.getJacobian(x, p).isApprox(2.0 * testJacobian(x, p)));
+
+  // a different approximation order is a different library
+  ocs2::CppAdInterface firstOrderInterface(funImpl, variableDim_, parameterDim_, modelName);
+  firstOrderInterface.loadModelsIfAvailable(ocs2::CppAdInterface::ApproximationOrder::First, false);
+  ASSERT_EQ(countLibraries(), 3);
+
+  // the unchanged function reuses its library
+  ocs2::CppAdInterface reloadedInterface(funImpl, variableDim_, parameterDim_, modelName);
+  reloadedInterface.loadModelsIfAvailable(ocs2::CppAdInterface::ApproximationOrder::Second, false);
+  ASSERT_EQ(countLibraries(), 3);
+  ASSERT_TRUE(reloadedInterface.getFunctionValue(x, p).isApprox(testFun(x, p)));
+  ASSERT_TRUE(reloadedInterface.getHessian(1, x, p).isApprox(testHessian(1, x, p)));
+
+  // copies load the library of the original
+  ocs2::CppAdInterface copiedInterface(scaledInterface);
+  ASSERT_TRUE(copiedInterface.getFunctionValue(x, p).isApprox(2.0 * testFun(x, p)));
+}
+
+TEST_F(CppAdInterfaceParameterizedFixture, inMemoryCompilation) {
+  const std::string modelName = "testModelInMemory";
+  const boost::filesystem::path modelFolder = boost::filesystem::path("/tmp/ocs2") / modelName;
+  boost::filesystem::remove_all(modelFolder);
+
+  ocs2::CppAdInterface::setInMemoryCompilation(true);
+  ocs2::CppAdInterface adInterface(funImpl, variableDim_, parameterDim_, modelName);
+  adInterface.loadModelsIfAvailable(ocs2::CppAdInterface::ApproximationOrder::Second, false);
+  ocs2::CppAdInterface::setInMemoryCompilation(false);
+  ASSERT_FALSE(boost::filesystem::exists(modelFolder / "cppad_generated"));
+
+  vector_t x = vector_t::Random(variableDim_);
+  vector_t p = vector_t::Random(parameterDim_);
+  ASSERT_TRUE(adInterface.getFunctionValue(x, p).isApprox(testFun(x, p)));
+  ASSERT_TRUE(adInterface.getHessian(1, x, p).isApprox(testHessian(1, x, p)));
+
+  // copies load the same in-memory library
+  ocs2::CppAdInterface copiedInterface(adInterface);
+  ASSERT_TRUE(copiedInterface.getJacobian(x, p).isApprox(testJacobian(x, p)));
+}
+
+TEST_F(CppAdInterfaceParameterizedFixture, compilationDisabled) {
+  const std::string modelName = "testModelCompilationDisabled";
+  boost::filesystem::remove_all(boost::filesystem::path("/tmp/ocs2") / modelName);
+
+  ocs2::CppAdInterface::setCompilationAllowed(false);
+  ocs2::CppAdInterface adInterface(funImpl, variableDim_, parameterDim_, modelName);
+  EXPECT_THROW(adInterface.loadModelsIfAvailable(ocs2::CppAdInterface::ApproximationOrder::Second, false), std::runtime_error);
+  ocs2::CppAdInterface::setCompilationAllowed(true);
+
+  // a prebuilt library is loaded when compilation is disabled
+  adInterface.loadModelsIfAvailable(ocs2::CppAdInterface::ApproximationOrder::Second, false);
+  ocs2::CppAdInterface::setCompilationAllowed(false);
+  ocs2::CppAdInterface loadedInterface(funImpl, variableDim_, parameterDim_, modelName);
+  ASSERT_NO_THROW(loadedInterface.loadModelsIfAvailable(ocs2::CppAdInterface::ApproximationOrder::Second, false));
+  ocs2::CppAdInterface::setCompilationAllowed(true);
+
+  vector_t x = vector_t::Random(variableDim_);
+  vector_t p = vector_t::Random(parameterDim_);
+  ASSERT_TRUE(loadedInterface.getFunctionValue(x, p).isApprox(testFun(x, p)));
+}
+
+TEST_F(CppAdInterfaceParameterizedFixture, copyPerThread) {
+  ocs2::CppAdInterface adInterface(funImpl, variableDim_, parameterDim_, "testModelCopyPerThread");
+  adInterface.createModels(ocs2::CppAdInterface::ApproximationOrder::Second, false);
+
+  // copies share the loaded library, hence the construction time of the per-thread copies should only grow slightly with their number
+  for (const size_t nThreads : {1, 2, 4, 8, 16}) {
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::unique_ptr<ocs2::CppAdInterface>> copies;
+    for (size_t i = 0; i < nThreads; i++) {
+      copies.emplace_back(new ocs2::CppAdInterface(adInterface));
+    }
+    const auto duration = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cerr << "[CppAdInterface] Copying for " << nThreads << " threads took " << duration << " [ms]\n";
+
+    // the random inputs are generated before starting the threads, since the random generator of Eigen is not thread-safe
+    constexpr size_t numSamples = 100;
+    std::vector<std::vector<vector_t>> xSamples(nThreads), pSamples(nThreads);
+    for (size_t i = 0; i < nThreads; i++) {
+      for (size_t j = 0; j < numSamples; j++) {
+        xSamples[i].push_back(vector_t::Random(variableDim_));
+        pSamples[i].push_back(vector_t::Random(parameterDim_));
+      }
+    }
+
+    std::vector<std::thread> threads;
+    std::vector<int> success(nThreads, 0);
+    for (size_t i = 0; i < nThreads; i++) {
+      threads.emplace_back([&, i]() {
+        bool result = true;
+        for (size_t j = 0; j < numSamples; j++) {
+          const vector_t& x = xSamples[i][j];
+          const vector_t& p = pSamples[i][j];
+          result = result && copies[i]->getFunctionValue(x, p).isApprox(testFun(x, p));
+          result = result && copies[i]->getJacobian(x, p).isApprox(testJacobian(x, p));
+        }
+        success[i] = result;
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    ASSERT_TRUE(std::all_of(success.begin(), success.end(), [](int s) { return s != 0; }));
+  }
+}
+
+TEST_F(CppAdInterfaceParameterizedFixture, loadOnFirstEvaluation) {
+  ocs2::CppAdInterface adInterface(funImpl, variableDim_, parameterDim_, "testModelLoadOnFirstEvaluation");
+  adInterface.loadModelsIfAvailable(ocs2::CppAdInterface::ApproximationOrder::Second, false);
+  ASSERT_FALSE(adInterface.isLoaded());
+
+  // copies share the library, which is opened by the first evaluation of any of them
+  ocs2::CppAdInterface copiedInterface(adInterface);
+  ocs2::CppAdInterface secondCopiedInterface(copiedInterface);
+  ASSERT_FALSE(copiedInterface.isLoaded());
+
+  vector_t x = vector_t::Random(variableDim_);
+  vector_t p = vector_t::Random(parameterDim_);
+  ASSERT_TRUE(copiedInterface.getJacobian(x, p).isApprox(testJacobian(x, p)));
+  ASSERT_TRUE(adInterface.isLoaded());
+  ASSERT_TRUE(secondCopiedInterface.isLoaded());
+  ASSERT_TRUE(adInterface.getFunctionValue(x, p).isApprox(testFun(x, p)));
+  ASSERT_TRUE(secondCopiedInterface.getHessian(0, x, p).isApprox(testHessian(0, x, p)));
+}
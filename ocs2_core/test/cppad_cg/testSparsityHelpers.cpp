@@ -47,3 +47,20 @@ TEST(CppAdSparsity, hessianSparsity) {
   cppad_sparsity::SparsityPattern trueSparsityDiagonal{{0, 1}, {1}, {}};
   ASSERT_EQ(sparsityDiagonal, trueSparsityDiagonal);
 }
+
+TEST(CppAdSparsity, coloring) {
+  // J = [1 0 0 1; 0 1 0 0; 0 0 1 0]: the first row shares a column with no other row, the first and last column share a row
+  cppad_sparsity::SparsityPattern sparsity{{0, 3}, {1}, {2}};
+  ASSERT_EQ(cppad_sparsity::getNumberOfRowColors(sparsity), 1);
+  ASSERT_EQ(cppad_sparsity::getNumberOfColumnColors(sparsity, 4), 2);
+
+  // Dense: every row and column needs its own color
+  auto denseSparsity = cppad_sparsity::getJacobianVariableSparsity(3, 5);
+  ASSERT_EQ(cppad_sparsity::getNumberOfRowColors(denseSparsity), 3);
+  ASSERT_EQ(cppad_sparsity::getNumberOfColumnColors(denseSparsity, 5), 5);
+
+  // Block diagonal with 2x2 blocks: two colors in both directions
+  cppad_sparsity::SparsityPattern blockSparsity{{0, 1}, {0, 1}, {2, 3}, {2, 3}, {4, 5}, {4, 5}};
+  ASSERT_EQ(cppad_sparsity::getNumberOfRowColors(blockSparsity), 2);
+  ASSERT_EQ(cppad_sparsity::getNumberOfColumnColors(blockSparsity, 6), 2);
+}
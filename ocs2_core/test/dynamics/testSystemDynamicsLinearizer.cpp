@@ -100,6 +100,93 @@ TEST(testSystemDynamicsLinearizer, testPendulum) {
   }
 }
 
+/**
+ * A chain of pendulums, each driven by its own input: the Jacobian is block diagonal.
+ */
+class PendulumChainSystem final : public SystemDynamicsBase {
+ public:
+  explicit PendulumChainSystem(size_t numPendulums) : SystemDynamicsBase(), numPendulums_(numPendulums) {}
+  ~PendulumChainSystem() override = default;
+  PendulumChainSystem* clone() const override { return new PendulumChainSystem(*this); }
+
+  vector_t computeFlowMap(scalar_t t, const vector_t& x, const vector_t& u, const PreComputation&) override {
+    vector_t dfdt(2 * numPendulums_);
+    for (size_t i = 0; i < numPendulums_; i++) {
+      dfdt(2 * i) = x(2 * i + 1);
+      dfdt(2 * i + 1) = sin(x(2 * i)) + 0.1 * u(i) * u(i);
+    }
+    return dfdt;
+  }
+
+  VectorFunctionLinearApproximation linearApproximation(scalar_t t, const vector_t& x, const vector_t& u, const PreComputation&) override {
+    VectorFunctionLinearApproximation linearDynamics;
+    linearDynamics.f = computeFlowMap(t, x, u, PreComputation());
+    linearDynamics.dfdx.setZero(2 * numPendulums_, 2 * numPendulums_);
+    linearDynamics.dfdu.setZero(2 * numPendulums_, numPendulums_);
+    for (size_t i = 0; i < numPendulums_; i++) {
+      linearDynamics.dfdx(2 * i, 2 * i + 1) = 1.0;
+      linearDynamics.dfdx(2 * i + 1, 2 * i) = cos(x(2 * i));
+      linearDynamics.dfdu(2 * i + 1, i) = 0.2 * u(i);
+    }
+    return linearDynamics;
+  }
+
+  sparsity_pattern_t getJacobianSparsity() const {
+    sparsity_pattern_t sparsity = sparsity_pattern_t::Constant(2 * numPendulums_, 3 * numPendulums_, false);
+    for (size_t i = 0; i < numPendulums_; i++) {
+      sparsity.block(2 * i, 2 * i, 2, 2).setConstant(true);
+      sparsity(2 * i + 1, 2 * numPendulums_ + i) = true;
+    }
+    return sparsity;
+  }
+
+ private:
+  size_t numPendulums_;
+};
+
+TEST(testSystemDynamicsLinearizer, testColoring) {
+  const size_t numPendulums = 5;
+  PendulumChainSystem chainSys(numPendulums);
+
+  // Every pendulum has its own rows, such that three colors suffice: two for the states and one for the input of each pendulum
+  const FiniteDifferenceColoring coloring(chainSys.getJacobianSparsity());
+  ASSERT_EQ(coloring.getNumColors(), 3);
+  ASSERT_EQ(FiniteDifferenceColoring(2 * numPendulums, 3 * numPendulums).getNumColors(), 3 * numPendulums);
+
+  SystemDynamicsLinearizer denseSys(std::unique_ptr<ControlledSystemBase>(chainSys.clone()), /*doubleSidedDerivative=*/true,
+                                    /*isSecondOrderSystem=*/false, EPSILON);
+  SystemDynamicsLinearizer sparseSys(std::unique_ptr<ControlledSystemBase>(chainSys.clone()), chainSys.getJacobianSparsity(),
+                                     /*doubleSidedDerivative=*/true, /*isSecondOrderSystem=*/false, EPSILON);
+  SystemDynamicsLinearizer oneSidedSparseSys(std::unique_ptr<ControlledSystemBase>(chainSys.clone()), chainSys.getJacobianSparsity(),
+                                             /*doubleSidedDerivative=*/false, /*isSecondOrderSystem=*/false, 1e-7);
+
+  std::srand((unsigned int)0);  // Seed repeatably
+  for (int i = 0; i < 10; ++i) {
+    const vector_t state = vector_t::Random(2 * numPendulums);
+    const vector_t input = vector_t::Random(numPendulums);
+    ASSERT_TRUE(derivativeChecker(chainSys, denseSys, TOLERANCE, 0.0, state, input));
+    ASSERT_TRUE(derivativeChecker(chainSys, sparseSys, TOLERANCE, 0.0, state, input));
+    ASSERT_TRUE(derivativeChecker(chainSys, oneSidedSparseSys, 1e-6, 0.0, state, input));
+  }
+}
+
+TEST(testSystemDynamicsLinearizer, testBatchedDerivative) {
+  PendulumSystem nonLinSys;
+  const vector_t state = vector_t::Random(2);
+  const vector_t input = vector_t::Random(1);
+
+  // Same as the column by column finite differences
+  matrix_t A;
+  matrix_t B;
+  finiteDifferenceDerivativeBatch(nonLinSys, 0.0, state, input, FiniteDifferenceColoring(2, 3), EPSILON, true, A, B);
+  ASSERT_TRUE(A.isApprox(finiteDifferenceDerivativeState(nonLinSys, 0.0, state, input, EPSILON, true)));
+  ASSERT_TRUE(B.isApprox(finiteDifferenceDerivativeInput(nonLinSys, 0.0, state, input, EPSILON, true)));
+
+  // The coloring has to match the dimensions
+  ASSERT_THROW(finiteDifferenceDerivativeBatch(nonLinSys, 0.0, state, input, FiniteDifferenceColoring(2, 2), EPSILON, true, A, B),
+               std::runtime_error);
+}
+
 static bool derivativeChecker(SystemDynamicsBase& sys1, SystemDynamicsBase& sys2, scalar_t tolerance, scalar_t t, const vector_t& x,
                               const vector_t& u) {
   auto derivatives1 = sys1.linearApproximation(t, x, u, PreComputation());
@@ -0,0 +1,85 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace ocs2 {
+
+/** The number of allocations of all CountingAllocators. */
+inline std::atomic_size_t& countedAllocations() {
+  static std::atomic_size_t numAllocations{0};
+  return numAllocations;
+}
+
+/** A std::allocator which counts its allocations in countedAllocations(), for testing that containers reuse their storage. */
+template <typename T>
+struct CountingAllocator : public std::allocator<T> {
+  template <typename U>
+  struct rebind {
+    using other = CountingAllocator<U>;
+  };
+
+  CountingAllocator() = default;
+
+  template <typename U>
+  CountingAllocator(const CountingAllocator<U>&) noexcept {}
+
+  T* allocate(std::size_t n) {
+    ++countedAllocations();
+    return std::allocator<T>::allocate(n);
+  }
+};
+
+template <typename T>
+using counted_vector_t = std::vector<T, CountingAllocator<T>>;
+
+/** A trajectory of vectors with counted allocations, similar to TargetTrajectories. */
+struct CountedTrajectories {
+  counted_vector_t<double> timeTrajectory;
+  counted_vector_t<counted_vector_t<double>> stateTrajectory;
+
+  bool operator==(const CountedTrajectories& other) const {
+    return timeTrajectory == other.timeTrajectory && stateTrajectory == other.stateTrajectory;
+  }
+};
+
+/** Returns trajectories of N samples of dimension dim, all of which have the given value. */
+inline CountedTrajectories getCountedTrajectories(double value, size_t N = 50, size_t dim = 24) {
+  CountedTrajectories trajectories;
+  trajectories.timeTrajectory.assign(N, value);
+  trajectories.stateTrajectory.assign(N, counted_vector_t<double>(dim, value));
+  return trajectories;
+}
+
+}  // namespace ocs2
@@ -0,0 +1,103 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include <ocs2_core/integration/Integrator.h>
+
+namespace {
+/** Stiff linear system with a slow and a fast mode, the fast mode decays with the rate 1e4. */
+class StiffSystem final : public ocs2::OdeBase {
+ public:
+  ~StiffSystem() override = default;
+  ocs2::vector_t computeFlowMap(ocs2::scalar_t t, const ocs2::vector_t& x) override { return getA() * x; }
+
+  static ocs2::matrix_t getA() {
+    return (ocs2::matrix_t(2, 2) << -1.0, 0.0,  // clang-format off
+                                    1e4, -1e4).finished();  // clang-format on
+  }
+
+  static ocs2::vector_t analyticSolution(ocs2::scalar_t t) {
+    // x0 = [1, 0], x1 = exp(-t), x2 = c * (exp(-t) - exp(-1e4 t)) with c = 1e4 / (1e4 - 1)
+    const ocs2::scalar_t c = 1e4 / (1e4 - 1.0);
+    return (ocs2::vector_t(2) << std::exp(-t), c * (std::exp(-t) - std::exp(-1e4 * t))).finished();
+  }
+};
+}  // unnamed namespace
+
+TEST(Rosenbrock2Test, finiteDifferenceJacobian) {
+  StiffSystem sys;
+  const ocs2::matrix_t jacobian = sys.computeFlowMapJacobian(0.0, ocs2::vector_t::Random(2));
+  EXPECT_TRUE(jacobian.isApprox(StiffSystem::getA(), 1e-6));
+}
+
+TEST(Rosenbrock2Test, integrateStiffSystem) {
+  const ocs2::scalar_t t0 = 0.0;
+  const ocs2::scalar_t t1 = 2.0;
+  const ocs2::vector_t x0 = (ocs2::vector_t(2) << 1.0, 0.0).finished();
+
+  StiffSystem sys;
+  ocs2::scalar_array_t timeTrajectory;
+  ocs2::vector_array_t stateTrajectory;
+  ocs2::Observer observer(&stateTrajectory, &timeTrajectory);
+  auto integrator = ocs2::newIntegrator(ocs2::IntegratorType::ROS2);
+  integrator->integrateAdaptive(sys, observer, x0, t0, t1, 1e-3, 1e-6, 1e-4);
+  const auto numFunctionCallsRos2 = sys.getNumFunctionCalls();
+
+  EXPECT_DOUBLE_EQ(timeTrajectory.back(), t1);
+  for (size_t i = 0; i < timeTrajectory.size(); i++) {
+    EXPECT_TRUE(stateTrajectory[i].isApprox(StiffSystem::analyticSolution(timeTrajectory[i]), 1e-3)) << "at time " << timeTrajectory[i];
+  }
+
+  // the explicit integrator is limited by the stability of the fast mode
+  sys.resetNumFunctionCalls();
+  ocs2::vector_array_t stateTrajectoryOde45;
+  ocs2::Observer observerOde45(&stateTrajectoryOde45);
+  auto integratorOde45 = ocs2::newIntegrator(ocs2::IntegratorType::ODE45_OCS2);
+  integratorOde45->integrateAdaptive(sys, observerOde45, x0, t0, t1, 1e-3, 1e-6, 1e-4);
+  EXPECT_LT(10 * numFunctionCallsRos2, sys.getNumFunctionCalls());
+}
+
+TEST(Rosenbrock2Test, integrateTimes) {
+  const ocs2::vector_t x0 = (ocs2::vector_t(2) << 1.0, 0.0).finished();
+  const ocs2::scalar_array_t times = {0.0, 0.5, 1.0, 1.5, 2.0};
+
+  StiffSystem sys;
+  ocs2::vector_array_t stateTrajectory;
+  ocs2::Observer observer(&stateTrajectory);
+  auto integrator = ocs2::newIntegrator(ocs2::IntegratorType::ROS2);
+  integrator->integrateTimes(sys, observer, x0, times.begin(), times.end(), 1e-3, 1e-6, 1e-4);
+
+  ASSERT_EQ(stateTrajectory.size(), times.size());
+  for (size_t i = 0; i < times.size(); i++) {
+    EXPECT_TRUE(stateTrajectory[i].isApprox(StiffSystem::analyticSolution(times[i]), 1e-3)) << "at time " << times[i];
+  }
+}
@@ -116,8 +116,34 @@ TEST(RungeKuttaDormandPrince5Test, IntegrateTimesCompareWithBoost) {
   auto integrator_boost = ocs2::newIntegrator(ocs2::IntegratorType::ODE45);
   integrator_boost->integrateTimes(sys, observer_boost, x0, times.begin(), times.end(), dt);
 
+  // the observed states are interpolated within the steps, hence they only agree up to the integration tolerances
   for (size_t i = 0; i < times.size(); i++) {
-    EXPECT_TRUE(xTraj[i].isApprox(xTraj_boost[i], 1e-6));
+    EXPECT_TRUE(xTraj[i].isApprox(xTraj_boost[i], 1e-4));
+  }
+}
+
+TEST(RungeKuttaDormandPrince5Test, IntegrateTimesDenseOutput) {
+  LinearSystem sys;
+  const ocs2::vector_t x0 = ocs2::vector_t::Zero(2);
+
+  // observation times much finer than the integration steps
+  ocs2::scalar_array_t times;
+  for (int i = 0; i <= 1000; i++) {
+    times.push_back(0.01 * i);
+  }
+
+  ocs2::vector_array_t xTraj;
+  ocs2::Observer observer(&xTraj);
+  auto integrator = ocs2::newIntegrator(ocs2::IntegratorType::ODE45_OCS2);
+  integrator->integrateTimes(sys, observer, x0, times.begin(), times.end(), 0.05, 1e-9, 1e-9);
+  ASSERT_EQ(xTraj.size(), times.size());
+  EXPECT_LT(sys.getNumFunctionCalls(), times.size());
+
+  // analytic solution of the critically damped system
+  for (size_t i = 0; i < times.size(); i++) {
+    const ocs2::scalar_t t = times[i];
+    const ocs2::vector_t xAnalytic = (ocs2::vector_t(2) << t * std::exp(-t), 1.0 - (1.0 + t) * std::exp(-t)).finished();
+    EXPECT_TRUE(xTraj[i].isApprox(xAnalytic, 1e-6)) << "at time " << t;
   }
 }
 
@@ -33,6 +33,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ocs2_core/integration/SensitivityIntegrator.h"
 
 #include <ocs2_core/control/FeedforwardController.h>
+#include <ocs2_core/control/LinearController.h>
 #include <ocs2_core/dynamics/LinearSystemDynamics.h>
 #include <ocs2_core/dynamics/SystemDynamicsBase.h>
 
@@ -209,4 +210,121 @@ TEST(test_sensitivity_integrator, vsBoostRK4) {
 
   // Check
   ASSERT_TRUE(rk4ForwardDynamics.isApprox(boostRk4ForwardDynamics));
-}
\ No newline at end of file
+}
+TEST(test_sensitivity_integrator, ensemble) {
+  constexpr size_t ensembleSize = 5;
+  auto system = getSystem();
+  const ocs2::scalar_t initTime = 0.5;
+  const ocs2::scalar_t finalTime = 1.25;
+  const ocs2::scalar_t timeStep = 0.1;
+  const ocs2::matrix_t initStateBatch = ocs2::matrix_t::Random(2, ensembleSize);
+
+  const ocs2::matrix_t K = ocs2::matrix_t::Random(1, 2);
+  ocs2::LinearController controller({initTime, finalTime}, {ocs2::vector_t::Random(1), ocs2::vector_t::Random(1)}, {K, K});
+  system->setController(&controller);
+
+  for (auto type : {ocs2::SensitivityIntegratorType::EULER, ocs2::SensitivityIntegratorType::RK2, ocs2::SensitivityIntegratorType::RK4}) {
+    ocs2::scalar_array_t timeTrajectory;
+    ocs2::matrix_array_t stateBatchTrajectory;
+    ocs2::integrateEnsemble(*system, type, initTime, initStateBatch, finalTime, timeStep, timeTrajectory, stateBatchTrajectory);
+    ASSERT_EQ(timeTrajectory.size(), 9);
+    ASSERT_EQ(stateBatchTrajectory.size(), timeTrajectory.size());
+    ASSERT_DOUBLE_EQ(timeTrajectory.back(), finalTime);
+
+    // each member of the ensemble is integrated independently
+    const auto discretization = ocs2::selectDynamicsDiscretization(type);
+    for (size_t k = 0; k < ensembleSize; k++) {
+      ocs2::vector_t x = initStateBatch.col(k);
+      for (size_t i = 0; i + 1 < timeTrajectory.size(); i++) {
+        const ocs2::vector_t u = controller.computeInput(timeTrajectory[i], x);
+        x = discretization(*system, timeTrajectory[i], x, u, timeTrajectory[i + 1] - timeTrajectory[i]);
+      }
+      ASSERT_TRUE(x.isApprox(stateBatchTrajectory.back().col(k)));
+    }
+  }
+}
+
+TEST(test_sensitivity_integrator, sensitivityVsFiniteDifference) {
+  auto system = getSystem();
+  const ocs2::scalar_t t = 0.5;
+  const ocs2::vector_t x = ocs2::vector_t::Random(2);
+  const ocs2::vector_t u = ocs2::vector_t::Random(1);
+  const ocs2::scalar_t dt = 0.1;
+  const ocs2::scalar_t eps = 1e-6;
+
+  for (auto type : {ocs2::SensitivityIntegratorType::RK3, ocs2::SensitivityIntegratorType::IMPLICIT_MIDPOINT}) {
+    const auto discretization = ocs2::selectDynamicsDiscretization(type);
+    const auto sensitivityDiscretization = ocs2::selectDynamicsSensitivityDiscretization(type);
+    const auto approximation = sensitivityDiscretization(*system, t, x, u, dt);
+    ASSERT_TRUE(approximation.f.isApprox(discretization(*system, t, x, u, dt)));
+    ASSERT_EQ(ocs2::sensitivity_integrator::fromString(ocs2::sensitivity_integrator::toString(type)), type);
+
+    ocs2::matrix_t dfdx(2, 2);
+    for (int i = 0; i < 2; i++) {
+      const ocs2::vector_t dx = eps * ocs2::vector_t::Unit(2, i);
+      dfdx.col(i) = (discretization(*system, t, x + dx, u, dt) - discretization(*system, t, x - dx, u, dt)) / (2.0 * eps);
+    }
+    const ocs2::vector_t du = eps * ocs2::vector_t::Ones(1);
+    const ocs2::matrix_t dfdu = (discretization(*system, t, x, u + du, dt) - discretization(*system, t, x, u - du, dt)) / (2.0 * eps);
+    EXPECT_TRUE(approximation.dfdx.isApprox(dfdx, 1e-6));
+    EXPECT_TRUE(approximation.dfdu.isApprox(dfdu, 1e-6));
+  }
+}
+
+TEST(test_sensitivity_integrator, implicitMidpoint) {
+  auto system = getSystem();
+  const ocs2::scalar_t t = 0.5;
+  const ocs2::vector_t x = ocs2::vector_t::Random(2);
+  const ocs2::vector_t u = ocs2::vector_t::Random(1);
+  const ocs2::scalar_t dt = 0.1;
+
+  // x_{k+1} solves the implicit midpoint equation
+  const auto discretization = ocs2::selectDynamicsDiscretization(ocs2::SensitivityIntegratorType::IMPLICIT_MIDPOINT);
+  const ocs2::vector_t xNext = discretization(*system, t, x, u, dt);
+  const ocs2::vector_t xMid = 0.5 * (x + xNext);
+  const ocs2::PreComputation preComp;
+  EXPECT_TRUE(xNext.isApprox(x + dt * system->computeFlowMap(t + 0.5 * dt, xMid, u, preComp)));
+
+  // third order RK agrees with RK4 up to the local error
+  const auto rk3Discretization = ocs2::selectDynamicsDiscretization(ocs2::SensitivityIntegratorType::RK3);
+  const auto rk4Discretization = ocs2::selectDynamicsDiscretization(ocs2::SensitivityIntegratorType::RK4);
+  EXPECT_LT((rk3Discretization(*system, t, x, u, dt) - rk4Discretization(*system, t, x, u, dt)).norm(), 1e-4);
+}
+
+TEST(test_sensitivity_integrator, multiStep) {
+  auto system = getSystem();
+  const ocs2::scalar_t t = 0.5;
+  const ocs2::vector_t x = ocs2::vector_t::Random(2);
+  const ocs2::vector_t u = ocs2::vector_t::Random(1);
+  const ocs2::scalar_t maxStep = 0.1;
+  const ocs2::scalar_t eps = 1e-6;
+
+  const auto discretization = ocs2::selectDynamicsDiscretization(ocs2::SensitivityIntegratorType::RK2);
+  const auto sensitivityDiscretization = ocs2::selectDynamicsSensitivityDiscretization(ocs2::SensitivityIntegratorType::RK2);
+  const auto multiStepDiscretization = ocs2::multiStepDynamicsDiscretization(discretization, maxStep);
+  const auto multiStepSensitivityDiscretization = ocs2::multiStepDynamicsSensitivityDiscretization(sensitivityDiscretization, maxStep);
+
+  // a single step up to maxStep
+  ASSERT_TRUE(multiStepDiscretization(*system, t, x, u, maxStep).isApprox(discretization(*system, t, x, u, maxStep)));
+
+  // an interval of three steps with the input held constant
+  const ocs2::scalar_t dt = 3.0 * maxStep;
+  ocs2::vector_t xNext = x;
+  for (int i = 0; i < 3; i++) {
+    xNext = discretization(*system, t + i * maxStep, xNext, u, maxStep);
+  }
+  ASSERT_TRUE(multiStepDiscretization(*system, t, x, u, dt).isApprox(xNext));
+
+  const auto approximation = multiStepSensitivityDiscretization(*system, t, x, u, dt);
+  ASSERT_TRUE(approximation.f.isApprox(xNext));
+  ocs2::matrix_t dfdx(2, 2);
+  for (int i = 0; i < 2; i++) {
+    const ocs2::vector_t dx = eps * ocs2::vector_t::Unit(2, i);
+    dfdx.col(i) = (multiStepDiscretization(*system, t, x + dx, u, dt) - multiStepDiscretization(*system, t, x - dx, u, dt)) / (2.0 * eps);
+  }
+  const ocs2::vector_t du = eps * ocs2::vector_t::Ones(1);
+  const ocs2::matrix_t dfdu =
+      (multiStepDiscretization(*system, t, x, u + du, dt) - multiStepDiscretization(*system, t, x, u - du, dt)) / (2.0 * eps);
+  EXPECT_TRUE(approximation.dfdx.isApprox(dfdx, 1e-6));
+  EXPECT_TRUE(approximation.dfdu.isApprox(dfdu, 1e-6));
+}
@@ -63,3 +63,55 @@ TEST(testLoopshapingFilterDynamics, Integration) {
     ASSERT_NEAR(filter_state(d), filter_state0(d) * exp(A(d, d) * dt), 1e-3);
   }
 }
+
+TEST(testLoopshapingFilterDynamics, BlockDiagonalSections) {
+  // second order section, first order section, and pure gain
+  matrix_t A = matrix_t::Zero(3, 3), B = matrix_t::Zero(3, 3), C = matrix_t::Zero(3, 3), D = matrix_t::Zero(3, 3);
+  A.topLeftCorner(2, 2) << 0.0, 1.0, -4.0, -2.0;
+  A(2, 2) = -10.0;
+  B.col(0).head(2) << 0.0, 1.0;
+  B(2, 1) = 10.0;
+  C.row(0).head(2) << 4.0, 0.5;
+  C(1, 2) = 1.0;
+  D.diagonal() << 0.1, 0.2, 3.0;
+  const Filter filter(A, B, C, D);
+
+  ASSERT_TRUE(filter.isBlockDiagonal());
+  ASSERT_EQ(filter.getSections().size(), 3);
+  EXPECT_EQ(filter.getSections()[0].numStates, 2);
+  EXPECT_EQ(filter.getSections()[1].numStates, 1);
+  EXPECT_EQ(filter.getSections()[2].numStates, 0);
+
+  const vector_t x = vector_t::Random(3);
+  const vector_t u = vector_t::Random(3);
+  vector_t dxdt, y;
+  filter.computeStateDerivative(x, u, dxdt);
+  filter.computeOutput(x, u, y);
+  EXPECT_TRUE(dxdt.isApprox(A * x + B * u));
+  EXPECT_TRUE(y.isApprox(C * x + D * u));
+
+  const matrix_t M = matrix_t::Random(4, 3);
+  matrix_t MC(4, 3), MD(4, 3);
+  filter.rightMultiplyC(M, MC);
+  filter.rightMultiplyD(M, MD);
+  EXPECT_TRUE(MC.isApprox(M * C));
+  EXPECT_TRUE(MD.isApprox(M * D));
+}
+
+TEST(testLoopshapingFilterDynamics, CoupledFilter) {
+  // the first and the last state are coupled, hence the filter can not be split into contiguous sections
+  matrix_t A = -matrix_t::Identity(3, 3);
+  A(0, 2) = 1.0;
+  const matrix_t B = matrix_t::Identity(3, 3);
+  const matrix_t C = matrix_t::Identity(3, 3);
+  const matrix_t D = matrix_t::Zero(3, 3);
+  const Filter filter(A, B, C, D);
+
+  ASSERT_FALSE(filter.isBlockDiagonal());
+
+  const vector_t x = vector_t::Random(3);
+  const vector_t u = vector_t::Random(3);
+  vector_t dxdt;
+  filter.computeStateDerivative(x, u, dxdt);
+  EXPECT_TRUE(dxdt.isApprox(A * x + B * u));
+}
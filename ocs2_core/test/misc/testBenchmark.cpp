@@ -0,0 +1,211 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include <ocs2_core/misc/AllocationHooks.h>
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
+
+using namespace ocs2;
+using namespace benchmark;
+
+TEST(testProfiler, nestedScopes) {
+  Profiler profiler;
+  for (int i = 0; i < 10; i++) {
+    Profiler::Scope outerScope(profiler, "outer");
+    for (int j = 0; j < 3; j++) {
+      Profiler::Scope innerScope(profiler, "inner");
+    }
+  }
+  {
+    Profiler::Scope innerScope(profiler, "inner");
+    Profiler::Scope pathScope(profiler, "path", "outer/inner");
+  }
+
+  const auto outer = profiler.getStatistics("outer");
+  EXPECT_EQ(outer.numCalls, 10);
+  EXPECT_LE(outer.p50InMilliseconds, outer.p99InMilliseconds);
+  EXPECT_LE(outer.p99InMilliseconds, outer.maxInMilliseconds);
+  EXPECT_EQ(profiler.getStatistics("outer/inner").numCalls, 30);
+  EXPECT_EQ(profiler.getStatistics("inner").numCalls, 1);
+  EXPECT_EQ(profiler.getStatistics("outer/inner/path").numCalls, 1);
+  EXPECT_GE(outer.totalInMilliseconds, profiler.getStatistics("outer/inner").totalInMilliseconds);
+
+  profiler.reset();
+  EXPECT_EQ(profiler.getStatistics("outer").numCalls, 0);
+  EXPECT_TRUE(profiler.getStatistics().empty());
+}
+
+TEST(testProfiler, percentiles) {
+  Profiler profiler(100);
+  for (int i = 1; i <= 200; i++) {
+    Profiler::Scope scope(profiler, "sleep");
+    if (i == 200) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+  }
+
+  // the percentiles are computed over the latest 100 samples, the count and the maximum over all calls
+  const auto statistics = profiler.getStatistics("sleep");
+  EXPECT_EQ(statistics.numCalls, 200);
+  EXPECT_GE(statistics.maxInMilliseconds, 20.0);
+  EXPECT_LT(statistics.p50InMilliseconds, 20.0);
+  EXPECT_GE(statistics.p99InMilliseconds, statistics.p50InMilliseconds);
+}
+
+TEST(testProfiler, parallelWorkers) {
+  constexpr size_t numThreads = 3;
+  ThreadPool threadPool(numThreads);
+  Profiler profiler;
+  {
+    Profiler::Scope regionScope(profiler, "region");
+    threadPool.parallelFor(0, 100, 1, [&](int workerIndex, int i) {
+      Profiler::Scope taskScope(profiler, "task", "region");
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+    });
+  }
+
+  EXPECT_EQ(profiler.getStatistics("region").numCalls, 1);
+  EXPECT_EQ(profiler.getStatistics("region/task").numCalls, 100);
+
+  size_t numTasks = 0;
+  for (const auto& statistics : profiler.getWorkerStatistics()) {
+    if (statistics.path == "region/task") {
+      numTasks += statistics.numCalls;
+    } else {
+      EXPECT_EQ(statistics.path, "region");
+    }
+  }
+  EXPECT_EQ(numTasks, 100);
+  EXPECT_NE(profiler.getReport().find("task"), std::string::npos);
+}
+
+TEST(testTracer, ringBuffer) {
+  Tracer tracer(10);
+  for (int i = 0; i < 25; i++) {
+    const auto startTime = Tracer::clock::now();
+    tracer.addEvent(i < 20 ? "old" : "new", startTime, startTime + std::chrono::microseconds(5));
+  }
+  tracer.addInstantEvent("instant");
+
+  // only the latest 10 events are kept
+  EXPECT_EQ(tracer.getNumEvents(), 10);
+  std::stringstream trace;
+  tracer.writeChromeTrace(trace);
+  const auto json = trace.str();
+  auto count = [&](const std::string& pattern) {
+    size_t n = 0;
+    for (auto pos = json.find(pattern); pos != std::string::npos; pos = json.find(pattern, pos + 1)) {
+      n++;
+    }
+    return n;
+  };
+  EXPECT_EQ(count("\"old\""), 4);
+  EXPECT_EQ(count("\"new\""), 5);
+  EXPECT_NE(json.find("\"ph\":\"i\""), std::string::npos);
+  EXPECT_NE(json.find("\"dur\":5.000"), std::string::npos);
+
+  tracer.clear();
+  EXPECT_EQ(tracer.getNumEvents(), 0);
+}
+
+TEST(testTracer, profilerScopes) {
+  auto tracerPtr = std::make_shared<Tracer>();
+  ThreadPool threadPool(2);
+  Profiler profiler;
+  profiler.setTracer(tracerPtr);
+  {
+    Profiler::Scope regionScope(profiler, "region");
+    threadPool.parallelFor(0, 10, 1, [&](int workerIndex, int i) { Profiler::Scope taskScope(profiler, "task", "region"); });
+  }
+  EXPECT_EQ(tracerPtr->getNumEvents(), 11);
+
+  profiler.setTracer(nullptr);
+  {
+    Profiler::Scope scope(profiler, "untraced");
+  }
+  EXPECT_EQ(tracerPtr->getNumEvents(), 11);
+}
+
+TEST(testAllocationCounter, threadCounts) {
+  ASSERT_TRUE(allocation_counter::isEnabled());
+  std::vector<std::unique_ptr<std::vector<double>>> sink;
+  sink.reserve(10);
+
+  AllocationCounter allocationCounter;
+  for (int i = 0; i < 10; i++) {
+    sink.emplace_back(new std::vector<double>(100));
+  }
+  EXPECT_EQ(allocationCounter.getNumAllocations(), 20);
+  EXPECT_GE(allocationCounter.getNumAllocatedBytes(), 10 * 100 * sizeof(double));
+
+  // the allocations of the other threads are not counted
+  std::atomic<bool> start{false};
+  std::thread thread([&]() {
+    while (!start) {
+    }
+    sink.front().reset(new std::vector<double>(100));
+  });
+  allocationCounter.reset();
+  const size_t numAllocationsBefore = allocation_counter::getNumAllocations();
+  start = true;
+  thread.join();
+  EXPECT_EQ(allocationCounter.getNumAllocations(), 0);
+  EXPECT_GT(allocation_counter::getNumAllocations(), numAllocationsBefore);
+}
+
+TEST(testAllocationCounter, profilerScopes) {
+  Profiler profiler;
+  std::vector<std::unique_ptr<double>> sink;
+  sink.reserve(100);
+  // the first visit of a scope allocates its statistics
+  for (int i = 0; i < 6; i++) {
+    if (i == 1) {
+      profiler.reset();
+    }
+    Profiler::Scope outerScope(profiler, "outer");
+    {
+      Profiler::Scope allocatingScope(profiler, "allocating");
+      sink.emplace_back(new double(i));
+    }
+    {
+      // a steady-state hot path only works on the preallocated memory
+      Profiler::Scope steadyScope(profiler, "steady");
+      for (auto& valuePtr : sink) {
+        *valuePtr += 1.0;
+      }
+    }
+  }
+
+  EXPECT_EQ(profiler.getStatistics("outer/allocating").numAllocations, 5);
+  EXPECT_EQ(profiler.getStatistics("outer/steady").numAllocations, 0);
+  EXPECT_EQ(profiler.getStatistics("outer").numAllocations, 5);
+  EXPECT_NE(profiler.getReport().find("Allocs"), std::string::npos);
+}
+
+TEST(testPerfCounters, profilerScopes) {
+  // the counters are not accessible on every machine, in which case they read zero
+  const bool isAccessible = perf_counters::enable();
+  Profiler profiler;
+  volatile double sum = 0.0;
+  for (int i = 0; i < 3; i++) {
+    Profiler::Scope scope(profiler, "loop");
+    for (int j = 0; j < 100000; j++) {
+      sum = sum + j;
+    }
+  }
+  const auto statistics = profiler.getStatistics("loop");
+  perf_counters::disable();
+
+  if (isAccessible) {
+    EXPECT_GT(statistics.perfCounters.instructions, 300000);
+  } else {
+    EXPECT_EQ(statistics.perfCounters.instructions, 0);
+    EXPECT_EQ(statistics.perfCounters.cycles, 0);
+  }
+  EXPECT_EQ(perf_counters::readThreadCounters().instructions, 0);
+}
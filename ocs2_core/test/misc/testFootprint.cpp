@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/misc/Footprint.h>
+
+using namespace ocs2;
+
+TEST(testFootprint, fromIndices) {
+  const auto footprint = Footprint::fromIndices({5, 1, 2, 3, 8, 2}, {});
+  ASSERT_EQ(footprint.stateBlocks.size(), 3);
+  EXPECT_EQ(footprint.stateBlocks[0].start, 1);
+  EXPECT_EQ(footprint.stateBlocks[0].size, 3);
+  EXPECT_EQ(footprint.stateBlocks[1].start, 5);
+  EXPECT_EQ(footprint.stateBlocks[1].size, 1);
+  EXPECT_EQ(footprint.stateBlocks[2].start, 8);
+  EXPECT_EQ(footprint.stateBlocks[2].size, 1);
+  EXPECT_TRUE(footprint.inputBlocks.empty());
+}
+
+TEST(testFootprint, addFootprintBlocks) {
+  const size_t nx = 6;
+  const size_t nu = 3;
+  const auto footprint = Footprint::fromIndices({1, 2, 4}, {2});
+
+  // approximation which is zero outside of the footprint
+  auto approximation = ScalarFunctionQuadraticApproximation::Zero(nx, nu);
+  approximation.f = 1.0;
+  for (const auto& row : footprint.stateBlocks) {
+    approximation.dfdx.segment(row.start, row.size).setRandom();
+    for (const auto& col : footprint.stateBlocks) {
+      approximation.dfdxx.block(row.start, col.start, row.size, col.size).setRandom();
+    }
+  }
+  for (const auto& row : footprint.inputBlocks) {
+    approximation.dfdu.segment(row.start, row.size).setRandom();
+    for (const auto& col : footprint.stateBlocks) {
+      approximation.dfdux.block(row.start, col.start, row.size, col.size).setRandom();
+    }
+    for (const auto& col : footprint.inputBlocks) {
+      approximation.dfduu.block(row.start, col.start, row.size, col.size).setRandom();
+    }
+  }
+
+  auto accumulator = ScalarFunctionQuadraticApproximation::Zero(nx, nu);
+  accumulator.dfdxx.setRandom();
+  auto expected = accumulator;
+  expected += approximation;
+  addFootprintBlocks(footprint, approximation, accumulator);
+
+  EXPECT_DOUBLE_EQ(accumulator.f, expected.f);
+  EXPECT_TRUE(accumulator.dfdx.isApprox(expected.dfdx));
+  EXPECT_TRUE(accumulator.dfdu.isApprox(expected.dfdu));
+  EXPECT_TRUE(accumulator.dfdxx.isApprox(expected.dfdxx));
+  EXPECT_TRUE(accumulator.dfdux.isApprox(expected.dfdux));
+  EXPECT_TRUE(accumulator.dfduu.isApprox(expected.dfduu));
+}
+
+TEST(testFootprint, writeFootprintBlocks) {
+  const size_t nx = 5;
+  const size_t nu = 2;
+  const auto footprint = Footprint::fromIndices({0, 3}, {1});
+
+  auto approximation = VectorFunctionLinearApproximation::Zero(2, nx, nu);
+  approximation.f.setRandom();
+  approximation.dfdx.col(0).setRandom();
+  approximation.dfdx.col(3).setRandom();
+  approximation.dfdu.col(1).setRandom();
+
+  VectorFunctionLinearApproximation stacked(4, nx, nu);
+  stacked.f.setRandom();
+  stacked.dfdx.setRandom();
+  stacked.dfdu.setRandom();
+  const auto initial = stacked;
+  writeFootprintBlocks(footprint, approximation, 1, stacked);
+
+  EXPECT_TRUE(stacked.f.segment(1, 2).isApprox(approximation.f));
+  EXPECT_TRUE(stacked.dfdx.middleRows(1, 2).isApprox(approximation.dfdx));
+  EXPECT_TRUE(stacked.dfdu.middleRows(1, 2).isApprox(approximation.dfdu));
+  EXPECT_TRUE(stacked.dfdx.row(0).isApprox(initial.dfdx.row(0)));
+  EXPECT_TRUE(stacked.dfdx.row(3).isApprox(initial.dfdx.row(3)));
+}
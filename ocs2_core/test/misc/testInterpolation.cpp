@@ -54,6 +54,19 @@ TEST(testLinearInterpolation, testInterpolation) {
   test_interpolation(t[5] + 1.0, 4, t[5]);
 }
 
+TEST(testLinearInterpolation, testCursor) {
+  const std::vector<double> t = {0.0, 1.0, 2.0, 3.0, 3.0, 4.0};
+
+  // the cursor is only a hint, the result is the same for any order of queries
+  int cursor = 0;
+  for (const double time : {-1.0, 0.0, 0.25, 1.0, 2.5, 3.0, 3.5, 4.0, 5.0, 1.5, 3.0}) {
+    const auto expected = ocs2::LinearInterpolation::timeSegment(time, t);
+    const auto indexAlpha = ocs2::LinearInterpolation::timeSegment(time, t, cursor);
+    EXPECT_EQ(indexAlpha.first, expected.first);
+    EXPECT_DOUBLE_EQ(indexAlpha.second, expected.second);
+  }
+}
+
 TEST(testLinearInterpolation, testEventTimeInterpolation) {
   {  // Only an event
     std::vector<double> time{1.0, 1.0};
@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 
+#include <limits>
+
 #include <ocs2_core/Types.h>
 #include <ocs2_core/misc/LinearAlgebra.h>
 #include <ocs2_core/misc/randomMatrices.h>
@@ -133,3 +135,36 @@ TEST(makePsdCholesky, makePsdCholesky) {
 
   ASSERT_GE(lambdaSparseMatCorr.minCoeff(), minDesiredEigenvalue);
 }
+
+TEST(makePsdCholeskyShift, makePsdCholeskyShift) {
+  const size_t n = 10;        // matrix size
+  const scalar_t tol = 1e-9;  // Coefficient-wise tolerance
+
+  // positive definite matrix is not modified
+  matrix_t psdMat = generateSPDmatrix<matrix_t>(n);
+  matrix_t psdMatCorr = psdMat;
+  makePsdCholeskyShift(psdMatCorr, 0.0);
+  ASSERT_TRUE(psdMat.isApprox(psdMatCorr, tol));
+
+  // non-definite matrix
+  const auto lambdaMin = ocs2::LinearAlgebra::symmetricEigenvalues(psdMat).minCoeff();
+  const scalar_t minDesiredEigenvalue = 1e-1;
+  for (const matrix_t& ndMat : {matrix_t(psdMat - (lambdaMin + 1e-2) * matrix_t::Identity(n, n)), matrix_t(matrix_t::Zero(n, n)),
+                                matrix_t(-psdMat)}) {
+    matrix_t ndMatCorr = ndMat;
+    makePsdCholeskyShift(ndMatCorr, minDesiredEigenvalue);
+    const vector_t lambdaCorr = ocs2::LinearAlgebra::symmetricEigenvalues(ndMatCorr);
+    ASSERT_GE(lambdaCorr.minCoeff(), minDesiredEigenvalue);
+    // only the diagonal is shifted
+    ASSERT_TRUE((ndMatCorr - ndMat).isDiagonal(tol));
+  }
+}
+
+TEST(makePsdCholeskyShift, throwsOnNonFiniteMatrix) {
+  const size_t n = 5;
+  for (const scalar_t value : {std::numeric_limits<scalar_t>::quiet_NaN(), std::numeric_limits<scalar_t>::infinity()}) {
+    matrix_t mat = generateSPDmatrix<matrix_t>(n);
+    mat(1, 2) = value;
+    EXPECT_THROW(makePsdCholeskyShift(mat, 1e-1), std::runtime_error);
+  }
+}
@@ -2,6 +2,8 @@
 // Created by rgrandia on 27.04.22.
 //
 
+#include <fstream>
+
 #include <gtest/gtest.h>
 
 #include <ocs2_core/misc/LoadStdVectorOfPair.h>
@@ -54,4 +56,63 @@ TEST(testLoadPair, loadStringSizePair) {
   EXPECT_EQ(loadVector[0].second, 2);
   EXPECT_EQ(loadVector[1].first, "s3");
   EXPECT_EQ(loadVector[1].second, 4);
-}
\ No newline at end of file
+}
+TEST(testReadInfoFile, cache) {
+  const auto tmpFolder = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+  boost::filesystem::create_directories(tmpFolder);
+  const std::string filename = (tmpFolder / "settings.info").string();
+
+  std::ofstream(filename) << "settings { value 1 }\n";
+  const auto ptPtr = ocs2::loadData::readInfoFile(filename);
+  EXPECT_EQ(ptPtr->get<int>("settings.value"), 1);
+  EXPECT_EQ(ocs2::loadData::readInfoFile(filename), ptPtr);
+
+  // a modified file is parsed again
+  std::ofstream(filename) << "settings { value 22 }\n";
+  const auto modifiedPtPtr = ocs2::loadData::readInfoFile(filename);
+  EXPECT_NE(modifiedPtPtr, ptPtr);
+  EXPECT_EQ(modifiedPtPtr->get<int>("settings.value"), 22);
+  EXPECT_EQ(ptPtr->get<int>("settings.value"), 1);
+
+  boost::filesystem::remove_all(tmpFolder);
+  EXPECT_ANY_THROW(ocs2::loadData::readInfoFile(filename));
+  ocs2::loadData::clearInfoFileCache();
+}
+
+TEST(testReadInfoFile, settingsBundle) {
+  const auto tmpFolder = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+  boost::filesystem::create_directories(tmpFolder);
+  const std::string filename = (tmpFolder / "settings.info").string();
+  const std::string bundleFile = (tmpFolder / "settings.bin").string();
+  const std::string pairVectorsFile = dataFolder + "/pairVectors.info";
+
+  std::ofstream(filename) << "settings\n{\n  value 1\n  name \"robot name\"\n  matrix\n  {\n    (0,0) 2.0\n    (1,1) 3.0\n  }\n}\n";
+  ocs2::loadData::saveSettingsBundle(bundleFile, {filename, pairVectorsFile});
+  const auto bundledFile = tmpFolder / "bundled.info";
+  boost::filesystem::rename(filename, bundledFile);
+  ocs2::loadData::clearInfoFileCache();
+
+  // the bundled settings are used although the file is not available
+  ocs2::loadData::loadSettingsBundle(bundleFile);
+  int value = 0;
+  ocs2::loadData::loadCppDataType(filename, "settings.value", value);
+  EXPECT_EQ(value, 1);
+  std::string name;
+  ocs2::loadData::loadCppDataType(filename, "settings.name", name);
+  EXPECT_EQ(name, "robot name");
+  Eigen::Matrix2d matrix;
+  ocs2::loadData::loadEigenMatrix(filename, "settings.matrix", matrix);
+  EXPECT_TRUE(matrix.isApprox(Eigen::Vector2d(2.0, 3.0).asDiagonal().toDenseMatrix()));
+  std::vector<std::pair<std::string, size_t>> loadVector;
+  ocs2::loadData::loadStdVectorOfPair(pairVectorsFile, "stringSizePairs", loadVector);
+  ASSERT_EQ(loadVector.size(), 2);
+  EXPECT_EQ(loadVector[1].second, 4);
+
+  // the bundle is the same as the parsed file
+  boost::property_tree::ptree pt;
+  boost::property_tree::read_info(bundledFile.string(), pt);
+  EXPECT_TRUE(*ocs2::loadData::readInfoFile(filename) == pt);
+
+  boost::filesystem::remove_all(tmpFolder);
+  ocs2::loadData::clearInfoFileCache();
+}
@@ -29,6 +29,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <array>
 #include <fstream>
 #include <sstream>
@@ -130,6 +131,54 @@ TEST(testLogging, canFilterSeverity) {
   ocs2::log::reset();
 }
 
+TEST(testLogging, writesAsynchronously) {
+  ocs2::log::Settings settings;
+
+  settings.useLogFile = false;
+  settings.useConsole = true;
+  settings.consoleSeverity = ocs2::log::SeverityLevel::INFO;
+  settings.asynchronous = true;
+
+  std::ostringstream console_stream;
+  ocs2::log::init(settings, &console_stream);
+
+  OCS2_LOG(DEBUG) << "NOT logged";
+  OCS2_LOG(INFO) << "An informational severity message";
+  OCS2_LOG(ERROR) << "An error severity message";
+
+  ocs2::log::flush();
+  EXPECT_EQ(console_stream.str(), "[    INFO ] An informational severity message\n[   ERROR ] An error severity message\n");
+  EXPECT_EQ(ocs2::log::getNumDroppedRecords(), 0);
+
+  ocs2::log::reset();
+}
+
+TEST(testLogging, dropsRecordsOfFullAsynchronousBuffer) {
+  ocs2::log::Settings settings;
+
+  settings.useLogFile = false;
+  settings.useConsole = true;
+  settings.consoleSeverity = ocs2::log::SeverityLevel::DEBUG;
+  settings.asynchronous = true;
+  settings.asynchronousBufferSize = 4;
+
+  std::ostringstream console_stream;
+  ocs2::log::init(settings, &console_stream);
+
+  constexpr size_t numRecords = 10000;
+  for (size_t i = 0; i < numRecords; i++) {
+    OCS2_LOG(INFO) << "Record " << i;
+  }
+
+  ocs2::log::flush();
+  const auto output = console_stream.str();
+  const auto numWrittenRecords = static_cast<size_t>(std::count(output.begin(), output.end(), '\n'));
+  EXPECT_GT(ocs2::log::getNumDroppedRecords(), 0);
+  EXPECT_EQ(numWrittenRecords + ocs2::log::getNumDroppedRecords(), numRecords);
+
+  ocs2::log::reset();
+}
+
 TEST(testLogging, canLoadSettings) {
   const std::string settingsFileName = "ocs2_test_log_settings.info";
 
@@ -143,6 +192,7 @@ log
   useLogFile        1         ; enable file log
   logFileSeverity   WARNING   ; file severity level
   logFileName       ocs2.log  ; log file name
+  asynchronous      1         ; write log in background thread
 }
 )";
   file.close();
@@ -154,4 +204,5 @@ log
   EXPECT_EQ(settings.useLogFile, true);
   EXPECT_EQ(settings.logFileSeverity, ocs2::log::SeverityLevel::WARNING);
   EXPECT_EQ(settings.logFileName, "ocs2.log");
+  EXPECT_EQ(settings.asynchronous, true);
 }
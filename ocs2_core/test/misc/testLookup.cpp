@@ -36,6 +36,47 @@ TEST(testLookup, findIndexInTimeArray) {
   ASSERT_EQ(findIndexInTimeArray(timeArrayEmpty, 1.0), 0);
 }
 
+TEST(testLookup, findIndexInTimeArray_hint) {
+  std::vector<double> timeArray{-1.0, 0.0, 0.5, 2.0, 2.0, 2.0, 3.0, 3.5, 4.0, 6.0, 6.5, 7.0};
+
+  // increasing queries with small and large steps, then queries that go back in time
+  std::vector<double> queries{-2.0, -1.0, -0.5, 0.5, 1.0, 2.0, 2.1, 6.8, 7.0, 8.0, 8.0, 1.9, 2.0, -1.5};
+  int hint = 0;
+  for (const auto time : queries) {
+    ASSERT_EQ(findIndexInTimeArray(timeArray, time, hint), findIndexInTimeArray(timeArray, time));
+    ASSERT_EQ(hint, findIndexInTimeArray(timeArray, time));
+  }
+
+  // invalid hint
+  hint = 100;
+  ASSERT_EQ(findIndexInTimeArray(timeArray, 2.5, hint), 6);
+
+  // empty time
+  std::vector<double> timeArrayEmpty;
+  hint = 0;
+  ASSERT_EQ(findIndexInTimeArray(timeArrayEmpty, 1.0, hint), 0);
+}
+
+TEST(testLookup, findIndexInTimeArray_hintDecreasing) {
+  std::vector<double> timeArray{-1.0, 0.0, 0.5, 2.0, 2.0, 2.0, 3.0, 3.5, 4.0, 6.0, 6.5, 7.0};
+
+  // decreasing queries as in the backward Riccati integration, starting from past the end
+  std::vector<double> queries{8.0, 7.0, 6.9, 6.5, 5.0, 3.5, 2.0, 2.0, 1.9, 0.5, 0.1, -1.0, -2.0, -2.0, 6.6, 2.0};
+  int hint = static_cast<int>(timeArray.size());
+  for (const auto time : queries) {
+    ASSERT_EQ(findIndexInTimeArray(timeArray, time, hint), findIndexInTimeArray(timeArray, time));
+    ASSERT_EQ(hint, findIndexInTimeArray(timeArray, time));
+  }
+
+  // every pair of consecutive queries
+  for (int i = -4; i <= 18; i++) {
+    for (int j = -4; j <= 18; j++) {
+      hint = findIndexInTimeArray(timeArray, 0.5 * i);
+      ASSERT_EQ(findIndexInTimeArray(timeArray, 0.5 * j, hint), findIndexInTimeArray(timeArray, 0.5 * j));
+    }
+  }
+}
+
 TEST(testLookup, findIndexInTimeArray_precision_lowNumbers) {
   std::vector<double> timeArray{0.0};
   double tQuery = timeArray.front();
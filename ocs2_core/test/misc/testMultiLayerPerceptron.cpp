@@ -0,0 +1,77 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/misc/MultiLayerPerceptron.h>
+
+using namespace ocs2;
+
+namespace {
+MultiLayerPerceptron getRandomNetwork() {
+  return MultiLayerPerceptron({matrix_t::Random(8, 3), matrix_t::Random(8, 8), matrix_t::Random(2, 8)},
+                              {vector_t::Random(8), vector_t::Random(8), vector_t::Random(2)});
+}
+}  // unnamed namespace
+
+TEST(testMultiLayerPerceptron, evaluate) {
+  const matrix_t W0 = matrix_t::Random(4, 3);
+  const matrix_t W1 = matrix_t::Random(2, 4);
+  const vector_t b0 = vector_t::Random(4);
+  const vector_t b1 = vector_t::Random(2);
+  MultiLayerPerceptron network({W0, W1}, {b0, b1});
+  EXPECT_EQ(network.getInputDim(), 3);
+  EXPECT_EQ(network.getOutputDim(), 2);
+
+  const vector_t input = vector_t::Random(3);
+  const vector_t hidden = (W0 * input + b0).array().tanh();
+  const vector_t expected = W1 * hidden + b1;
+  EXPECT_TRUE(network.evaluate(input).isApprox(expected));
+
+  EXPECT_ANY_THROW(network.evaluate(vector_t::Random(2)));
+}
+
+TEST(testMultiLayerPerceptron, inconsistentLayers) {
+  EXPECT_ANY_THROW(MultiLayerPerceptron({matrix_t::Random(4, 3), matrix_t::Random(2, 5)}, {vector_t::Random(4), vector_t::Random(2)}));
+  EXPECT_ANY_THROW(MultiLayerPerceptron({matrix_t::Random(4, 3)}, {vector_t::Random(3)}));
+  EXPECT_ANY_THROW(MultiLayerPerceptron({}, {}));
+}
+
+TEST(testMultiLayerPerceptron, saveAndLoad) {
+  const std::string fileName = "ocs2_test_multi_layer_perceptron.txt";
+  auto network = getRandomNetwork();
+  network.save(fileName);
+  auto loadedNetwork = MultiLayerPerceptron::load(fileName);
+
+  ASSERT_EQ(loadedNetwork.getNumLayers(), network.getNumLayers());
+  const vector_t input = vector_t::Random(network.getInputDim());
+  EXPECT_TRUE(loadedNetwork.evaluate(input).isApprox(network.evaluate(input)));
+
+  EXPECT_ANY_THROW(MultiLayerPerceptron::load("ocs2_non_existing_network.txt"));
+}
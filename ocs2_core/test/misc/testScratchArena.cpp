@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <thread>
+
+#include <ocs2_core/misc/AllocationCounter.h>
+#include <ocs2_core/misc/ScratchArena.h>
+
+using namespace ocs2;
+
+TEST(testScratchArena, alignedAndDisjoint) {
+  ScratchArena arena(1024);
+  ScratchArena::Scope scope(arena);
+  auto v = scope.getVector(3);
+  auto A = scope.getMatrix(5, 7);
+  ASSERT_EQ(reinterpret_cast<std::uintptr_t>(v.data()) % EIGEN_MAX_ALIGN_BYTES, 0);
+  ASSERT_EQ(reinterpret_cast<std::uintptr_t>(A.data()) % EIGEN_MAX_ALIGN_BYTES, 0);
+  ASSERT_GE(A.data(), v.data() + v.size());
+
+  v.setOnes();
+  A.setConstant(2.0);
+  ASSERT_TRUE(v.isApprox(vector_t::Ones(3)));
+  ASSERT_TRUE(A.isApprox(matrix_t::Constant(5, 7, 2.0)));
+  ASSERT_EQ(scope.getVector(0).size(), 0);
+}
+
+TEST(testScratchArena, scopesRewind) {
+  ScratchArena arena(1024);
+  scalar_t* outerData = nullptr;
+  {
+    ScratchArena::Scope outer(arena);
+    outerData = outer.getVector(4).data();
+    scalar_t* innerData = nullptr;
+    {
+      ScratchArena::Scope inner(arena);
+      innerData = inner.getVector(4).data();
+      ASSERT_NE(innerData, outerData);
+    }
+    // the memory of the inner scope is handed out again
+    ASSERT_EQ(outer.getVector(4).data(), innerData);
+  }
+  ScratchArena::Scope scope(arena);
+  ASSERT_EQ(scope.getVector(4).data(), outerData);
+}
+
+TEST(testScratchArena, growsAndMerges) {
+  ScratchArena arena(1024);
+  {
+    ScratchArena::Scope scope(arena);
+    for (int i = 0; i < 10; i++) {
+      scope.getMatrix(10, 10);
+    }
+    ASSERT_GT(arena.getNumBlocks(), 1);
+  }
+
+  // the blocks are merged once the arena is empty, the same requests then fit into one block without allocations
+  ASSERT_EQ(arena.getNumBlocks(), 1);
+  const auto capacity = arena.getCapacity();
+  benchmark::AllocationCounter allocationCounter;
+  {
+    ScratchArena::Scope scope(arena);
+    for (int i = 0; i < 10; i++) {
+      scope.getMatrix(10, 10);
+    }
+  }
+  ASSERT_EQ(arena.getNumBlocks(), 1);
+  ASSERT_EQ(arena.getCapacity(), capacity);
+  if (benchmark::allocation_counter::isEnabled()) {
+    ASSERT_EQ(allocationCounter.getNumAllocations(), 0);
+  }
+}
+
+TEST(testScratchArena, threadArenas) {
+  const auto* arenaPtr = &getThreadScratchArena();
+  ASSERT_EQ(&getThreadScratchArena(), arenaPtr);
+  const ScratchArena* otherArenaPtr = nullptr;
+  std::thread thread([&]() { otherArenaPtr = &getThreadScratchArena(); });
+  thread.join();
+  ASSERT_NE(otherArenaPtr, arenaPtr);
+}
@@ -33,6 +33,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <gtest/gtest.h>
 
 #include <ocs2_core/model_data/ModelDataLinearInterpolation.h>
+#include <ocs2_core/model_data/ModelDataTrajectory.h>
 
 using namespace ocs2;
 
@@ -63,6 +64,89 @@ TEST(testModelData, testModelDataLinearInterpolation) {
   EXPECT_TRUE(enquiryMatrix.isApprox(Eigen::Matrix3d::Ones() * time));
 }
 
+TEST(testModelData, testModelDataTrajectoryInterpolation) {
+  // create data, the input dimension changes in the middle of the trajectory
+  const size_t N = 10;
+  std::vector<double> timeArray(N);
+  std::vector<ModelData> modelDataBaseArray(N);
+  for (size_t i = 0; i < N; i++) {
+    const int inputDim = (i < N / 2) ? 2 : 1;
+    timeArray[i] = 2.0 * i;
+    modelDataBaseArray[i].time = timeArray[i];
+    modelDataBaseArray[i].dynamicsBias = vector_t::Random(3);
+    modelDataBaseArray[i].dynamics.dfdx = matrix_t::Random(3, 3);
+    modelDataBaseArray[i].dynamics.dfdu = matrix_t::Random(3, inputDim);
+    modelDataBaseArray[i].cost.f = static_cast<scalar_t>(i);
+    modelDataBaseArray[i].cost.dfdux = matrix_t::Random(inputDim, 3);
+  }
+
+  ModelDataTrajectory modelDataTrajectory;
+  modelDataTrajectory.assign(modelDataBaseArray);
+  ASSERT_EQ(modelDataTrajectory.size(), N);
+
+  matrix_t matrix;
+  vector_t vector;
+  for (const double time : {-1.0, 0.0, 3.0, 8.5, 9.0, 11.0, 18.0, 20.0}) {
+    const auto indexAlpha = LinearInterpolation::timeSegment(time, timeArray);
+
+    LinearInterpolation::interpolate(indexAlpha, modelDataTrajectory.dynamicsBias, vector);
+    EXPECT_TRUE(vector.isApprox(LinearInterpolation::interpolate(indexAlpha, modelDataBaseArray, model_data::dynamicsBias)));
+    LinearInterpolation::interpolate(indexAlpha, modelDataTrajectory.dynamics_dfdx, matrix);
+    EXPECT_TRUE(matrix.isApprox(LinearInterpolation::interpolate(indexAlpha, modelDataBaseArray, model_data::dynamics_dfdx)));
+    LinearInterpolation::interpolate(indexAlpha, modelDataTrajectory.dynamics_dfdu, matrix);
+    EXPECT_TRUE(matrix.isApprox(LinearInterpolation::interpolate(indexAlpha, modelDataBaseArray, model_data::dynamics_dfdu)));
+    LinearInterpolation::interpolate(indexAlpha, modelDataTrajectory.cost_dfdux, matrix);
+    EXPECT_TRUE(matrix.isApprox(LinearInterpolation::interpolate(indexAlpha, modelDataBaseArray, model_data::cost_dfdux)));
+    EXPECT_DOUBLE_EQ(LinearInterpolation::interpolate(indexAlpha, modelDataTrajectory.cost_f),
+                     LinearInterpolation::interpolate(indexAlpha, modelDataBaseArray, model_data::cost_f));
+  }
+
+  // Refilling with a single node gives a constant function
+  modelDataTrajectory.assign({modelDataBaseArray.front()});
+  LinearInterpolation::interpolate({0, 0.3}, modelDataTrajectory.dynamics_dfdu, matrix);
+  EXPECT_TRUE(matrix.isApprox(modelDataBaseArray.front().dynamics.dfdu));
+}
+
+TEST(testModelData, testFusedModelDataTrajectoryInterpolation) {
+  const size_t N = 10;
+  std::vector<double> timeArray(N);
+  std::vector<ModelData> modelDataBaseArray(N);
+  for (size_t i = 0; i < N; i++) {
+    timeArray[i] = 2.0 * i;
+    modelDataBaseArray[i].time = timeArray[i];
+    modelDataBaseArray[i].dynamicsBias = vector_t::Random(3);
+    modelDataBaseArray[i].dynamics.dfdx = matrix_t::Random(3, 3);
+    modelDataBaseArray[i].dynamics.dfdu = matrix_t::Random(3, 2);
+    modelDataBaseArray[i].cost.f = static_cast<scalar_t>(i);
+    modelDataBaseArray[i].cost.dfdxx = matrix_t::Random(3, 3);
+    modelDataBaseArray[i].cost.dfdux = matrix_t::Random(2, 3);
+  }
+
+  ModelDataTrajectory modelDataTrajectory;
+  modelDataTrajectory.assign(modelDataBaseArray);
+
+  const uint32_t fields = model_data::TIME | model_data::DYNAMICS_DFDX | model_data::DYNAMICS_DFDU | model_data::COST_F |
+                          model_data::COST_DFDXX | model_data::COST_DFDUX;
+  ModelData modelData;
+  for (const double time : {-1.0, 0.0, 3.0, 8.5, 9.0, 11.0, 18.0, 20.0}) {
+    const auto indexAlpha = LinearInterpolation::timeSegment(time, timeArray);
+    LinearInterpolation::interpolate(indexAlpha, modelDataTrajectory, fields, modelData);
+
+    EXPECT_DOUBLE_EQ(modelData.time, LinearInterpolation::interpolate(indexAlpha, modelDataBaseArray, model_data::time));
+    const matrix_t dfdx = LinearInterpolation::interpolate(indexAlpha, modelDataBaseArray, model_data::dynamics_dfdx);
+    EXPECT_TRUE(modelData.dynamics.dfdx.isApprox(dfdx));
+    const matrix_t dfdu = LinearInterpolation::interpolate(indexAlpha, modelDataBaseArray, model_data::dynamics_dfdu);
+    EXPECT_TRUE(modelData.dynamics.dfdu.isApprox(dfdu));
+    EXPECT_DOUBLE_EQ(modelData.cost.f, LinearInterpolation::interpolate(indexAlpha, modelDataBaseArray, model_data::cost_f));
+    EXPECT_TRUE(modelData.cost.dfdxx.isApprox(LinearInterpolation::interpolate(indexAlpha, modelDataBaseArray, model_data::cost_dfdxx)));
+    EXPECT_TRUE(modelData.cost.dfdux.isApprox(LinearInterpolation::interpolate(indexAlpha, modelDataBaseArray, model_data::cost_dfdux)));
+
+    // the fields which are not selected are not touched
+    EXPECT_EQ(modelData.dynamicsBias.size(), 0);
+    EXPECT_EQ(modelData.cost.dfdu.size(), 0);
+  }
+}
+
 TEST(testModelData, testMovableCopyable) {
   ASSERT_TRUE(std::is_copy_constructible<ModelData>::value);
   ASSERT_TRUE(std::is_move_constructible<ModelData>::value);
@@ -181,3 +181,40 @@ TEST(TestMultiplier, testInterpolation) {
     EXPECT_TRUE(ocs2::isApprox(multiplierCollection, multiplierCollectionNew, prec));
   }  // end of i loop
 }
+
+TEST(TestMultiplier, testInPlaceInterpolation) {
+  const ocs2::size_array_t stateEqTermsSize{3};
+  const ocs2::size_array_t stateInputIneqTermsSize{0, 2, 4};
+
+  const size_t N = 11;
+  ocs2::scalar_array_t timeTrajectory(N);
+  std::vector<ocs2::MultiplierCollection> multiplierCollectionTrajectory(N);
+  for (size_t i = 0; i < N; i++) {
+    ocs2::vector_t serialized;
+    timeTrajectory[i] = i * 0.1;
+    ocs2::random(stateEqTermsSize, serialized, multiplierCollectionTrajectory[i].stateEq);
+    ocs2::random(stateInputIneqTermsSize, serialized, multiplierCollectionTrajectory[i].stateInputIneq);
+  }  // end of i loop
+  // a node with a different constraint size snaps to the closest node
+  multiplierCollectionTrajectory[5].stateInputIneq[2].lagrangian = ocs2::vector_t::Random(1);
+
+  // the output is reused for all the queries
+  ocs2::MultiplierCollection multiplierCollection;
+  const ocs2::scalar_array_t timeTrajectoryTest{-1.0, 0.0, 0.42, 0.46, 0.55, 0.87, 1.0, 100.0};
+  for (const auto t : timeTrajectoryTest) {
+    const auto indexAlpha = ocs2::LinearInterpolation::timeSegment(t, timeTrajectory);
+    ocs2::LinearInterpolation::interpolate(indexAlpha, multiplierCollectionTrajectory, multiplierCollection);
+    const auto multiplierCollectionRef = ocs2::interpolateNew(indexAlpha, multiplierCollectionTrajectory);
+    const auto stateEqRef = ocs2::LinearInterpolation::interpolate(
+        indexAlpha, multiplierCollectionTrajectory,
+        [](const std::vector<ocs2::MultiplierCollection>& array, size_t ind) -> const ocs2::vector_t& {
+          return array[ind].stateEq[0].lagrangian;
+        });
+
+    EXPECT_TRUE(multiplierCollection.stateEq[0].lagrangian.isApprox(stateEqRef, 1e-8));
+    EXPECT_EQ(getSizes(multiplierCollection.stateInputIneq), getSizes(multiplierCollectionRef.stateInputIneq));
+    if (indexAlpha.first != 4 && indexAlpha.first != 5) {
+      EXPECT_TRUE(ocs2::isApprox(multiplierCollection, multiplierCollectionRef, 1e-8));
+    }
+  }  // end of t loop
+}
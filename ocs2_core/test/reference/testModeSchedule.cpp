@@ -168,3 +168,27 @@ TEST(testModeSchedule, findIntersectionToExtendableInterval) {
   output = findIntersectionToExtendableInterval(timeTrajectory, eventTimes, timePeriod);
   EXPECT_TRUE(output.first > output.second) << "The interval should be empty!";
 }
+
+TEST(testModeSchedule, modeScheduleLookup) {
+  const ModeSchedule modeSchedule({1.0, 2.0, 3.0, 4.0}, {0, 1, 2, 3, 4});
+  ModeScheduleLookup modeScheduleLookup(modeSchedule);
+
+  // nodes in the order of time, each queried by several terms
+  for (scalar_t t = 0.0; t < 5.0; t += 0.05) {
+    for (int term = 0; term < 3; term++) {
+      EXPECT_EQ(modeScheduleLookup.modeAtTime(t), modeSchedule.modeAtTime(t)) << "t: " << t;
+    }
+  }
+  // event times and arbitrary order
+  for (const scalar_t t : {4.0, 1.0, 3.0, 2.0, 5.5, -1.0, 2.5, 1.0}) {
+    EXPECT_EQ(modeScheduleLookup.modeAtTime(t), modeSchedule.modeAtTime(t)) << "t: " << t;
+  }
+
+  // the interval kept from the previous mode schedule is not used
+  const ModeSchedule updatedModeSchedule({2.5}, {5, 6});
+  modeScheduleLookup.setModeSchedule(updatedModeSchedule);
+  for (const scalar_t t : {1.0, 2.5, 3.0, 0.0}) {
+    EXPECT_EQ(modeScheduleLookup.modeAtTime(t), updatedModeSchedule.modeAtTime(t)) << "t: " << t;
+    EXPECT_EQ(modeScheduleLookup.getModeIndex(t), (t <= 2.5) ? 0 : 1) << "t: " << t;
+  }
+}
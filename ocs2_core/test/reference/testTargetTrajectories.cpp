@@ -0,0 +1,125 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/reference/TargetTrajectories.h>
+
+using namespace ocs2;
+
+namespace {
+TargetTrajectories getTargetTrajectories(const scalar_array_t& timeTrajectory) {
+  TargetTrajectories targetTrajectories;
+  for (const auto t : timeTrajectory) {
+    targetTrajectories.timeTrajectory.push_back(t);
+    targetTrajectories.stateTrajectory.push_back(vector_t::Constant(2, t));
+    targetTrajectories.inputTrajectory.push_back(vector_t::Constant(1, -t));
+  }
+  return targetTrajectories;
+}
+}  // unnamed namespace
+
+TEST(testTargetTrajectories, append) {
+  auto targetTrajectories = getTargetTrajectories({0.0, 1.0, 2.0});
+
+  // append after the last point
+  targetTrajectories.append(getTargetTrajectories({3.0, 4.0}));
+  EXPECT_TRUE(targetTrajectories == getTargetTrajectories({0.0, 1.0, 2.0, 3.0, 4.0}));
+
+  // the overlapping points are replaced
+  targetTrajectories.append(getTargetTrajectories({2.5, 5.0}));
+  EXPECT_TRUE(targetTrajectories == getTargetTrajectories({0.0, 1.0, 2.0, 2.5, 5.0}));
+  targetTrajectories.append(getTargetTrajectories({2.0}));
+  EXPECT_TRUE(targetTrajectories == getTargetTrajectories({0.0, 1.0, 2.0}));
+
+  // appending to empty target trajectories
+  TargetTrajectories emptyTargetTrajectories;
+  emptyTargetTrajectories.append(targetTrajectories);
+  EXPECT_TRUE(emptyTargetTrajectories == targetTrajectories);
+
+  // inconsistent input trajectories
+  EXPECT_THROW(targetTrajectories.append(TargetTrajectories({3.0}, {vector_t::Zero(2)})), std::runtime_error);
+}
+
+TEST(testTargetTrajectories, trimBefore) {
+  auto targetTrajectories = getTargetTrajectories({0.0, 1.0, 2.0, 3.0});
+
+  // nothing is elapsed
+  targetTrajectories.trimBefore(-1.0);
+  EXPECT_TRUE(targetTrajectories == getTargetTrajectories({0.0, 1.0, 2.0, 3.0}));
+
+  // the last point before the time is kept for the interpolation
+  targetTrajectories.trimBefore(1.5);
+  EXPECT_TRUE(targetTrajectories == getTargetTrajectories({1.0, 2.0, 3.0}));
+  EXPECT_TRUE(targetTrajectories.getDesiredState(1.5).isApprox(vector_t::Constant(2, 1.5)));
+
+  targetTrajectories.trimBefore(2.0);
+  EXPECT_TRUE(targetTrajectories == getTargetTrajectories({2.0, 3.0}));
+
+  // the last point is never removed
+  targetTrajectories.trimBefore(10.0);
+  EXPECT_TRUE(targetTrajectories == getTargetTrajectories({3.0}));
+}
+
+TEST(testTargetTrajectories, sampleOnGrid) {
+  const auto originalTrajectories = getTargetTrajectories({0.0, 1.0, 2.0});
+  const scalar_array_t timeGrid{-1.0, 0.25, 1.0, 1.5, 3.0};
+  TargetTrajectories targetTrajectories;
+  originalTrajectories.sampleOnGrid(timeGrid, targetTrajectories);
+  EXPECT_TRUE(targetTrajectories == originalTrajectories);
+  EXPECT_EQ(originalTrajectories.getSampledDesiredState(1.0), nullptr);
+
+  // the samples match the interpolation
+  for (const auto t : timeGrid) {
+    const auto* sampledStatePtr = targetTrajectories.getSampledDesiredState(t);
+    const auto* sampledInputPtr = targetTrajectories.getSampledDesiredInput(t);
+    ASSERT_NE(sampledStatePtr, nullptr);
+    ASSERT_NE(sampledInputPtr, nullptr);
+    const auto clampedTime = std::min(std::max(t, 0.0), 2.0);
+    EXPECT_TRUE(sampledStatePtr->isApprox(vector_t::Constant(2, clampedTime)));
+    EXPECT_TRUE(sampledInputPtr->isApprox(vector_t::Constant(1, -clampedTime)));
+    EXPECT_TRUE(targetTrajectories.getDesiredState(t).isApprox(*sampledStatePtr));
+  }
+
+  // off the grid, the target trajectories are interpolated
+  EXPECT_EQ(targetTrajectories.getSampledDesiredState(0.5), nullptr);
+  EXPECT_TRUE(targetTrajectories.getDesiredState(0.5).isApprox(vector_t::Constant(2, 0.5)));
+
+  // a modification discards the samples
+  targetTrajectories.append(getTargetTrajectories({1.0, 4.0}));
+  EXPECT_EQ(targetTrajectories.getSampledDesiredState(1.5), nullptr);
+  EXPECT_TRUE(targetTrajectories.getDesiredState(1.5).isApprox(vector_t::Constant(2, 1.5)));
+
+  // without an input trajectory, only the state is sampled
+  const TargetTrajectories stateOnlyTrajectories({0.0, 1.0}, {vector_t::Zero(2), vector_t::Ones(2)});
+  stateOnlyTrajectories.sampleOnGrid({0.5}, targetTrajectories);
+  ASSERT_NE(targetTrajectories.getSampledDesiredState(0.5), nullptr);
+  EXPECT_TRUE(targetTrajectories.getSampledDesiredState(0.5)->isApprox(vector_t::Constant(2, 0.5)));
+  EXPECT_EQ(targetTrajectories.getSampledDesiredInput(0.5), nullptr);
+}
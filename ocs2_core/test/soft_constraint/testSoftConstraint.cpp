@@ -29,6 +29,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <gtest/gtest.h>
 
+#include <ocs2_core/constraint/LinearStateInputConstraint.h>
 #include <ocs2_core/penalties/Penalties.h>
 #include <ocs2_core/soft_constraint/StateInputSoftConstraint.h>
 #include <ocs2_core/soft_constraint/StateSoftConstraint.h>
@@ -163,6 +164,37 @@ TEST(testSoftConstraint, softStateInputConstraint) {
   EXPECT_NO_THROW(stateInputQuadraticConstraintPtr->getQuadraticApproximation(0.0, state, input, targetTrajectories, preComp));
 }
 
+TEST(testSoftConstraint, accumulateStateInputConstraint) {
+  constexpr size_t numConstraints = 4;
+  constexpr size_t stateDim = 6;
+  constexpr size_t inputDim = 3;
+  const ocs2::vector_t state = ocs2::vector_t::Random(stateDim);
+  const ocs2::vector_t input = ocs2::vector_t::Random(inputDim);
+  const ocs2::TargetTrajectories targetTrajectories;
+  const ocs2::PreComputation preComp;
+
+  const ocs2::vector_t e = ocs2::vector_t::Random(numConstraints);
+  const ocs2::matrix_t C = ocs2::matrix_t::Random(numConstraints, stateDim);
+  const ocs2::matrix_t D = ocs2::matrix_t::Random(numConstraints, inputDim);
+  std::unique_ptr<ocs2::LinearStateInputConstraint> constraintPtr(new ocs2::LinearStateInputConstraint(e, C, D));
+  std::unique_ptr<ocs2::RelaxedBarrierPenalty> penaltyPtr(new ocs2::RelaxedBarrierPenalty({0.1, 0.5}));
+  ocs2::StateInputSoftConstraint softConstraint(std::move(constraintPtr), std::move(penaltyPtr));
+
+  // the accumulated approximation adds to the given one
+  auto accumulator = ocs2::ScalarFunctionQuadraticApproximation::Zero(stateDim, inputDim);
+  accumulator.dfdxx.setIdentity();
+  accumulator.dfduu.setIdentity();
+  softConstraint.accumulateQuadraticApproximation(0.0, state, input, targetTrajectories, preComp, accumulator);
+
+  const auto expected = softConstraint.getQuadraticApproximation(0.0, state, input, targetTrajectories, preComp);
+  EXPECT_NEAR(accumulator.f, expected.f, 1e-9);
+  EXPECT_TRUE(accumulator.dfdx.isApprox(expected.dfdx));
+  EXPECT_TRUE(accumulator.dfdu.isApprox(expected.dfdu));
+  EXPECT_TRUE(accumulator.dfdxx.isApprox(expected.dfdxx + ocs2::matrix_t::Identity(stateDim, stateDim)));
+  EXPECT_TRUE(accumulator.dfdux.isApprox(expected.dfdux));
+  EXPECT_TRUE(accumulator.dfduu.isApprox(expected.dfduu + ocs2::matrix_t::Identity(inputDim, inputDim)));
+}
+
 class ActivityTestStateConstraint : public ocs2::StateConstraint {
  public:
   ActivityTestStateConstraint() : StateConstraint(ocs2::ConstraintOrder::Quadratic) {}
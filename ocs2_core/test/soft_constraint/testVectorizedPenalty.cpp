@@ -0,0 +1,95 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/penalties/augmented/QuadraticPenalty.h>
+#include <ocs2_core/penalties/penalties/QuadraticPenalty.h>
+#include <ocs2_core/penalties/penalties/RelaxedBarrierPenalty.h>
+#include <ocs2_core/penalties/penalties/SquaredHingePenalty.h>
+
+namespace {
+
+/** Compares the vectorized evaluation to the element-wise evaluation of the scalar methods */
+void checkVectorizedPenalty(const ocs2::PenaltyBase& penalty) {
+  constexpr ocs2::scalar_t tol = 1e-9;
+  const ocs2::scalar_t t = 0.0;
+  // covers both sides of the relaxation thresholds
+  const ocs2::vector_t h = ocs2::vector_t::LinSpaced(101, -1.0, 1.0);
+
+  ocs2::scalar_t expectedValue = 0.0;
+  ocs2::vector_t expectedDerivative(h.size());
+  ocs2::vector_t expectedSecondDerivative(h.size());
+  for (size_t i = 0; i < h.size(); i++) {
+    expectedValue += penalty.getValue(t, h(i));
+    expectedDerivative(i) = penalty.getDerivative(t, h(i));
+    expectedSecondDerivative(i) = penalty.getSecondDerivative(t, h(i));
+  }
+
+  ocs2::vector_t derivative, secondDerivative;
+  const auto value = penalty.getTotalValueAndDerivatives(t, h, derivative, secondDerivative);
+  EXPECT_NEAR(penalty.getTotalValue(t, h), expectedValue, tol) << penalty.name();
+  EXPECT_NEAR(value, expectedValue, tol) << penalty.name();
+  EXPECT_TRUE(derivative.isApprox(expectedDerivative, tol)) << penalty.name();
+  EXPECT_TRUE(secondDerivative.isApprox(expectedSecondDerivative, tol)) << penalty.name();
+}
+
+}  // unnamed namespace
+
+TEST(testVectorizedPenalty, relaxedBarrierPenalty) {
+  checkVectorizedPenalty(ocs2::RelaxedBarrierPenalty({0.1, 0.05}));
+}
+
+TEST(testVectorizedPenalty, squaredHingePenalty) {
+  checkVectorizedPenalty(ocs2::SquaredHingePenalty({10.0, 0.1}));
+}
+
+TEST(testVectorizedPenalty, quadraticPenalty) {
+  checkVectorizedPenalty(ocs2::QuadraticPenalty(3.0));
+}
+
+TEST(testVectorizedPenalty, augmentedQuadraticPenalty) {
+  ocs2::augmented::QuadraticPenalty penalty({3.0, 0.5});
+  const ocs2::scalar_t t = 0.0;
+  const ocs2::vector_t h = ocs2::vector_t::Random(10);
+  const ocs2::vector_t l = ocs2::vector_t::Random(10);
+
+  ocs2::scalar_t expectedValue = 0.0;
+  ocs2::vector_t expectedDerivative(h.size());
+  for (size_t i = 0; i < h.size(); i++) {
+    expectedValue += penalty.getValue(t, l(i), h(i));
+    expectedDerivative(i) = penalty.getDerivative(t, l(i), h(i));
+  }
+
+  ocs2::vector_t derivative, secondDerivative;
+  const auto value = penalty.getTotalValueAndDerivatives(t, &l, h, derivative, secondDerivative);
+  EXPECT_NEAR(value, expectedValue, 1e-9);
+  EXPECT_TRUE(derivative.isApprox(expectedDerivative));
+  EXPECT_TRUE((secondDerivative.array() == 3.0).all());
+}
@@ -0,0 +1,97 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include <ocs2_core/cost/StateCost.h>
+#include <ocs2_core/thread_support/ParameterBuffer.h>
+
+namespace {
+/** Cost with a weight that is shared by all clones through a parameter buffer. */
+class WeightedStateCost final : public ocs2::StateCost {
+ public:
+  explicit WeightedStateCost(std::shared_ptr<ocs2::ParameterBuffer> weightPtr) : weightPtr_(std::move(weightPtr)) {}
+  WeightedStateCost* clone() const override { return new WeightedStateCost(*this); }
+
+  ocs2::scalar_t getValue(ocs2::scalar_t, const ocs2::vector_t& x, const ocs2::TargetTrajectories&,
+                          const ocs2::PreComputation&) const override {
+    return weightPtr_->get()(0) * x.squaredNorm();
+  }
+
+  ocs2::ScalarFunctionQuadraticApproximation getQuadraticApproximation(ocs2::scalar_t, const ocs2::vector_t& x,
+                                                                       const ocs2::TargetTrajectories&,
+                                                                       const ocs2::PreComputation&) const override {
+    const ocs2::scalar_t weight = weightPtr_->get()(0);
+    ocs2::ScalarFunctionQuadraticApproximation cost;
+    cost.f = weight * x.squaredNorm();
+    cost.dfdx = 2.0 * weight * x;
+    cost.dfdxx = 2.0 * weight * ocs2::matrix_t::Identity(x.size(), x.size());
+    return cost;
+  }
+
+ private:
+  WeightedStateCost(const WeightedStateCost& rhs) = default;
+  std::shared_ptr<ocs2::ParameterBuffer> weightPtr_;
+};
+}  // unnamed namespace
+
+TEST(testParameterBuffer, updateFromBuffer) {
+  ocs2::ParameterBuffer parameterBuffer(ocs2::vector_t::Ones(2));
+  ASSERT_FALSE(parameterBuffer.updateFromBuffer());
+
+  parameterBuffer.setBuffer(ocs2::vector_t::Constant(2, 2.0));
+  ASSERT_TRUE(parameterBuffer.get().isApprox(ocs2::vector_t::Ones(2)));
+  ASSERT_TRUE(parameterBuffer.updateFromBuffer());
+  ASSERT_TRUE(parameterBuffer.get().isApprox(ocs2::vector_t::Constant(2, 2.0)));
+  ASSERT_FALSE(parameterBuffer.updateFromBuffer());
+
+  ASSERT_THROW(parameterBuffer.setBuffer(ocs2::vector_t::Ones(3)), std::runtime_error);
+}
+
+TEST(testParameterBuffer, sharedByClones) {
+  auto weightPtr = std::make_shared<ocs2::ParameterBuffer>(ocs2::vector_t::Ones(1));
+  WeightedStateCost cost(weightPtr);
+  std::unique_ptr<ocs2::StateCost> clonedCost(cost.clone());
+
+  const ocs2::vector_t x = ocs2::vector_t::Ones(3);
+  const ocs2::TargetTrajectories targetTrajectories;
+  const ocs2::PreComputation preComp;
+  weightPtr->setBuffer(ocs2::vector_t::Constant(1, 2.0));
+  ASSERT_DOUBLE_EQ(clonedCost->getValue(0.0, x, targetTrajectories, preComp), 3.0);
+  weightPtr->updateFromBuffer();
+  ASSERT_DOUBLE_EQ(cost.getValue(0.0, x, targetTrajectories, preComp), 6.0);
+  ASSERT_DOUBLE_EQ(clonedCost->getValue(0.0, x, targetTrajectories, preComp), 6.0);
+
+  const auto approximation = clonedCost->getQuadraticApproximation(0.0, x, targetTrajectories, preComp);
+  ASSERT_DOUBLE_EQ(approximation.f, 6.0);
+  ASSERT_TRUE(approximation.dfdx.isApprox(ocs2::vector_t::Constant(3, 4.0)));
+  ASSERT_TRUE(approximation.dfdxx.isApprox(4.0 * ocs2::matrix_t::Identity(3, 3)));
+}
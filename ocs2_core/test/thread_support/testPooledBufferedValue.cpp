@@ -0,0 +1,99 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/reference/TargetTrajectories.h>
+#include <ocs2_core/thread_support/BufferedValue.h>
+#include <ocs2_core/thread_support/PooledBufferedValue.h>
+
+#include <ocs2_core/test/CountingAllocator.h>
+
+namespace {
+ocs2::TargetTrajectories getTargetTrajectories(ocs2::scalar_t t) {
+  constexpr size_t N = 50;
+  constexpr size_t stateDim = 24;
+  constexpr size_t inputDim = 12;
+  ocs2::TargetTrajectories targetTrajectories;
+  for (size_t i = 0; i < N; i++) {
+    targetTrajectories.timeTrajectory.push_back(t + i);
+    targetTrajectories.stateTrajectory.push_back(ocs2::vector_t::Constant(stateDim, t));
+    targetTrajectories.inputTrajectory.push_back(ocs2::vector_t::Constant(inputDim, t));
+  }
+  return targetTrajectories;
+}
+
+/** Returns the average number of counted allocations per setBuffer()/updateFromBuffer() cycle. */
+template <typename BufferedValueType, typename T>
+double countAllocationsPerUpdate(BufferedValueType& bufferedValue, const std::vector<T>& newValues, size_t numUpdates) {
+  const size_t numAllocationsStart = ocs2::countedAllocations();
+  for (size_t i = 0; i < numUpdates; i++) {
+    bufferedValue.setBuffer(newValues[i % newValues.size()]);
+    bufferedValue.updateFromBuffer();
+  }
+  return static_cast<double>(ocs2::countedAllocations() - numAllocationsStart) / numUpdates;
+}
+}  // unnamed namespace
+
+TEST(testPooledBufferedValue, updates) {
+  ocs2::PooledBufferedValue<ocs2::TargetTrajectories> bufferedValue(getTargetTrajectories(0.0));
+  ASSERT_TRUE(bufferedValue.get() == getTargetTrajectories(0.0));
+  ASSERT_FALSE(bufferedValue.updateFromBuffer());
+
+  bufferedValue.setBuffer(getTargetTrajectories(1.0));
+  ASSERT_TRUE(bufferedValue.get() == getTargetTrajectories(0.0));
+  ASSERT_TRUE(bufferedValue.updateFromBuffer());
+  ASSERT_TRUE(bufferedValue.get() == getTargetTrajectories(1.0));
+  ASSERT_FALSE(bufferedValue.updateFromBuffer());
+  ASSERT_TRUE(bufferedValue.get() == getTargetTrajectories(1.0));
+
+  // only the latest value is kept
+  const auto targetTrajectories2 = getTargetTrajectories(2.0);
+  bufferedValue.setBuffer(targetTrajectories2);
+  bufferedValue.setBuffer(getTargetTrajectories(3.0));
+  ASSERT_TRUE(bufferedValue.updateFromBuffer());
+  ASSERT_TRUE(bufferedValue.get() == getTargetTrajectories(3.0));
+}
+
+TEST(testPooledBufferedValue, steadyStateAllocations) {
+  constexpr size_t numUpdates = 1000;
+  const std::vector<ocs2::CountedTrajectories> trajectories{ocs2::getCountedTrajectories(1.0), ocs2::getCountedTrajectories(2.0)};
+
+  // reference: BufferedValue allocates a new buffer object for every update
+  ocs2::BufferedValue<ocs2::CountedTrajectories> bufferedValue(ocs2::getCountedTrajectories(0.0));
+  const double bufferedAllocations = countAllocationsPerUpdate(bufferedValue, trajectories, numUpdates);
+
+  ocs2::PooledBufferedValue<ocs2::CountedTrajectories> pooledValue(ocs2::getCountedTrajectories(0.0));
+  countAllocationsPerUpdate(pooledValue, trajectories, 2);  // warm up: fills the storage of both slots
+  const double pooledAllocations = countAllocationsPerUpdate(pooledValue, trajectories, numUpdates);
+
+  EXPECT_GT(bufferedAllocations, 0.0);
+  EXPECT_EQ(pooledAllocations, 0.0);
+  EXPECT_TRUE(pooledValue.get() == trajectories[(numUpdates - 1) % 2]);
+}
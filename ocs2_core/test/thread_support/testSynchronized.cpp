@@ -2,6 +2,8 @@
 
 #include <ocs2_core/thread_support/Synchronized.h>
 
+#include <ocs2_core/test/CountingAllocator.h>
+
 #include <functional>
 
 enum class ClassId { A, B };
@@ -176,4 +178,17 @@ TEST(testLockable, lockMultiple) {
   synchronizedA.getMutex().unlock();
   synchronizedB.getMutex().unlock();
   synchronizedDouble.getMutex().unlock();
-}
\ No newline at end of file
+}
+
+TEST(testLockable, assignAllocations) {
+  const std::vector<ocs2::CountedTrajectories> trajectories{ocs2::getCountedTrajectories(1.0), ocs2::getCountedTrajectories(2.0)};
+  ocs2::Synchronized<ocs2::CountedTrajectories> synchronized;
+  synchronized.assign(trajectories[0]);  // first assignment allocates the wrapped object
+
+  const size_t numAllocationsStart = ocs2::countedAllocations();
+  for (size_t i = 0; i < 100; i++) {
+    synchronized.assign(trajectories[i % 2]);
+  }
+  EXPECT_EQ(ocs2::countedAllocations() - numAllocationsStart, 0);
+  EXPECT_TRUE(*synchronized.lock() == trajectories[1]);
+}
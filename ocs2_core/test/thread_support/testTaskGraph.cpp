@@ -0,0 +1,165 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <ocs2_core/thread_support/TaskGraph.h>
+
+using namespace ocs2;
+
+TEST(testTaskGraph, dependencies) {
+  constexpr int N = 100;
+  ThreadPool pool(3);
+
+  std::vector<std::atomic_int> visits(N);
+  for (auto& v : visits) {
+    v = 0;
+  }
+  std::atomic_int numIntermediate{0};
+  std::atomic_bool finalRan{false};
+  std::atomic_bool orderViolated{false};
+  int reduction = 0;
+
+  TaskGraph graph;
+  const auto intermediate = graph.addParallelFor(0, N, 2, [&](int, int i) {
+    visits[i]++;
+    numIntermediate++;
+  });
+  const auto final = graph.addTask([&](int) { finalRan = true; });
+  const auto empty = graph.addParallelFor(5, 5, 1, [&](int, int) { orderViolated = true; }, {final});
+  graph.addTask(
+      [&](int) {
+        if (numIntermediate != N || !finalRan) {
+          orderViolated = true;
+        }
+        reduction = numIntermediate + 1;
+      },
+      {intermediate, final, empty});
+  ASSERT_EQ(graph.size(), 4);
+
+  graph.run(pool);
+
+  EXPECT_FALSE(orderViolated);
+  EXPECT_EQ(reduction, N + 1);
+  for (const auto& v : visits) {
+    EXPECT_EQ(v, 1);
+  }
+
+  // run again
+  numIntermediate = 0;
+  finalRan = false;
+  graph.run(pool);
+  EXPECT_FALSE(orderViolated);
+  for (const auto& v : visits) {
+    EXPECT_EQ(v, 2);
+  }
+}
+
+TEST(testTaskGraph, overlappingNodes) {
+  // two independent nodes, each blocking until the other has started, can only finish if they run concurrently
+  ThreadPool pool(1);
+  std::atomic_int numStarted{0};
+  auto task = [&](int) {
+    numStarted++;
+    const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (numStarted < 2 && std::chrono::steady_clock::now() < timeout) {
+      std::this_thread::yield();
+    }
+  };
+
+  TaskGraph graph;
+  graph.addTask(task);
+  graph.addTask(task);
+  const auto startTime = std::chrono::steady_clock::now();
+  graph.run(pool);
+  EXPECT_LT(std::chrono::steady_clock::now() - startTime, std::chrono::seconds(5));
+}
+
+TEST(testTaskGraph, uniqueWorkerIndex) {
+  constexpr size_t maxNumThreads = 3;
+  ThreadPool pool(4);
+  std::vector<std::atomic_bool> workerBusy(maxNumThreads);
+  for (auto& b : workerBusy) {
+    b = false;
+  }
+  std::atomic_bool invalidWorkerIndex{false};
+  auto task = [&](int workerIndex, int) {
+    if (workerIndex < 0 || workerIndex >= maxNumThreads || workerBusy[workerIndex].exchange(true)) {
+      invalidWorkerIndex = true;
+      return;
+    }
+    std::this_thread::sleep_for(std::chrono::microseconds(20));
+    workerBusy[workerIndex] = false;
+  };
+
+  TaskGraph graph;
+  const auto first = graph.addParallelFor(0, 50, 1, task);
+  graph.addParallelFor(0, 50, 1, task);
+  graph.addParallelFor(0, 50, 3, task, {first});
+  graph.run(pool, maxNumThreads);
+  EXPECT_FALSE(invalidWorkerIndex);
+}
+
+TEST(testTaskGraph, noThreads) {
+  ThreadPool pool(0);
+  int counter = 0;
+  TaskGraph graph;
+  const auto first = graph.addParallelFor(0, 10, 1, [&](int workerIndex, int) {
+    EXPECT_EQ(workerIndex, 0);
+    counter++;
+  });
+  graph.addTask([&](int) { counter *= 2; }, {first});
+  graph.run(pool);
+  EXPECT_EQ(counter, 20);
+}
+
+TEST(testTaskGraph, propagateException) {
+  ThreadPool pool(2);
+  std::atomic_bool dependentRan{false};
+  TaskGraph graph;
+  const auto throwing = graph.addParallelFor(0, 20, 1, [&](int, int i) {
+    if (i == 7) {
+      throw std::runtime_error("index 7");
+    }
+  });
+  graph.addTask([&](int) { dependentRan = true; }, {throwing});
+  EXPECT_THROW(graph.run(pool), std::runtime_error);
+  EXPECT_FALSE(dependentRan);
+}
+
+TEST(testTaskGraph, invalidDependency) {
+  TaskGraph graph;
+  EXPECT_THROW(graph.addTask([](int) {}, {0}), std::runtime_error);
+}
@@ -1,4 +1,6 @@
 #include <gtest/gtest.h>
+#include <pthread.h>
+
 #include <ocs2_core/thread_support/ThreadPool.h>
 
 using namespace ocs2;
@@ -121,3 +123,158 @@ TEST(testThreadPool, testMoveOnlyTask) {
 
   EXPECT_EQ(result.get(), 3.14);
 }
+
+TEST(testThreadPool, testParallelFor) {
+  ThreadPool pool(3);
+  constexpr int N = 1000;
+  std::vector<std::atomic_int> visits(N);
+  for (auto& v : visits) {
+    v = 0;
+  }
+
+  // grain sizes smaller, equal and larger than the per-thread block
+  for (int grain : {1, 7, 250, 2 * N}) {
+    pool.parallelFor(0, N, grain, [&](int, int i) { visits[i]++; });
+  }
+
+  for (const auto& v : visits) {
+    EXPECT_EQ(v, 4);
+  }
+}
+
+TEST(testThreadPool, testParallelForImbalanced) {
+  ThreadPool pool(3);
+  constexpr int N = 64;
+  std::vector<int> visits(N, 0);
+  std::vector<std::atomic_bool> workerBusy(pool.numThreads() + 1);
+  for (auto& b : workerBusy) {
+    b = false;
+  }
+  std::atomic_bool sharedWorkerIndex{false};
+
+  // the first quarter of the range is much more expensive than the rest
+  pool.parallelFor(0, N, 1, [&](int workerIndex, int i) {
+    if (workerBusy[workerIndex].exchange(true)) {
+      sharedWorkerIndex = true;
+    }
+    visits[i]++;
+    if (i < N / 4) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    workerBusy[workerIndex] = false;
+  });
+
+  EXPECT_FALSE(sharedWorkerIndex);
+  for (const auto& v : visits) {
+    EXPECT_EQ(v, 1);
+  }
+}
+
+TEST(testThreadPool, testParallelForNoThreads) {
+  ThreadPool pool(0);
+  std::atomic_int counter;
+  counter = 0;
+
+  pool.parallelFor(5, 47, 4, [&](int workerIndex, int) {
+    EXPECT_EQ(workerIndex, 0);
+    counter++;
+  });
+  EXPECT_EQ(counter, 42);
+
+  // empty range
+  pool.parallelFor(0, 0, 1, [&](int, int) { counter++; });
+  EXPECT_EQ(counter, 42);
+}
+
+TEST(testThreadPool, testParallelForPropagateException) {
+  ThreadPool pool(2);
+  EXPECT_THROW(pool.parallelFor(0, 100, 1,
+                                [](int, int i) {
+                                  if (i == 50) {
+                                    throw std::runtime_error("exception");
+                                  }
+                                }),
+               std::runtime_error);
+}
+
+TEST(testThreadPool, testSpinningWorkers) {
+  ThreadPool pool(2, 0, std::chrono::microseconds(200));
+  std::atomic_int counter;
+  counter = 0;
+
+  // tasks arriving while the workers spin, and after they went to sleep
+  for (int i = 0; i < 2; ++i) {
+    pool.runParallel([&](int) { counter++; }, 42);
+    pool.parallelFor(0, 42, 1, [&](int, int) { counter++; });
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  EXPECT_EQ(counter, 4 * 42);
+}
+
+TEST(testThreadPool, testRunOnEachThread) {
+  ThreadPool pool(3);
+  std::vector<std::thread::id> threadIds(pool.numThreads() + 1);
+
+  pool.runOnEachThread([&](int workerIndex) { threadIds[workerIndex] = std::this_thread::get_id(); });
+
+  EXPECT_EQ(threadIds.back(), std::this_thread::get_id());
+  for (size_t i = 0; i < threadIds.size(); ++i) {
+    for (size_t j = i + 1; j < threadIds.size(); ++j) {
+      EXPECT_NE(threadIds[i], threadIds[j]);
+    }
+  }
+}
+
+TEST(testThreadPool, testCpuAffinity) {
+  const std::vector<int> cpuAffinity{0};
+  ThreadPool pool(2, 0, std::chrono::microseconds(0), cpuAffinity);
+  std::atomic_int numPinned;
+  numPinned = 0;
+
+  pool.runOnEachThread([&](int workerIndex) {
+    if (workerIndex < pool.numThreads()) {
+      cpu_set_t cpuSet;
+      CPU_ZERO(&cpuSet);
+      pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuSet);
+      if (CPU_COUNT(&cpuSet) == 1 && CPU_ISSET(0, &cpuSet)) {
+        numPinned++;
+      }
+    }
+  });
+
+  EXPECT_EQ(numPinned, pool.numThreads());
+}
+
+TEST(testThreadPool, testParallelForSharedPool) {
+  // two clients sharing one pool, each limited to two threads
+  auto poolPtr = std::make_shared<ThreadPool>(4);
+  constexpr size_t maxNumThreads = 2;
+  constexpr int N = 200;
+
+  auto client = [&]() {
+    std::vector<std::atomic_bool> workerBusy(maxNumThreads);
+    for (auto& b : workerBusy) {
+      b = false;
+    }
+    std::atomic_int counter{0};
+    std::atomic_bool invalidWorkerIndex{false};
+    poolPtr->parallelFor(
+        0, N, 1,
+        [&](int workerIndex, int) {
+          if (workerIndex < 0 || workerIndex >= maxNumThreads || workerBusy[workerIndex].exchange(true)) {
+            invalidWorkerIndex = true;
+            return;
+          }
+          counter++;
+          std::this_thread::sleep_for(std::chrono::microseconds(50));
+          workerBusy[workerIndex] = false;
+        },
+        maxNumThreads);
+    return !invalidWorkerIndex && counter == N;
+  };
+
+  auto otherClient = std::async(std::launch::async, client);
+  EXPECT_TRUE(client());
+  EXPECT_TRUE(otherClient.get());
+}
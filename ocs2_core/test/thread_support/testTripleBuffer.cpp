@@ -0,0 +1,109 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <memory>
+#include <thread>
+
+#include <ocs2_core/thread_support/TripleBuffer.h>
+
+TEST(testTripleBuffer, singleThread) {
+  ocs2::TripleBuffer<int> tripleBuffer;
+  ASSERT_EQ(tripleBuffer.front(), 0);
+  ASSERT_FALSE(tripleBuffer.hasNewValue());
+  ASSERT_FALSE(tripleBuffer.updateFromBuffer());
+
+  tripleBuffer.back() = 1;
+  tripleBuffer.publish();
+  ASSERT_EQ(tripleBuffer.front(), 0);
+  ASSERT_TRUE(tripleBuffer.hasNewValue());
+  ASSERT_TRUE(tripleBuffer.updateFromBuffer());
+  ASSERT_EQ(tripleBuffer.front(), 1);
+  ASSERT_FALSE(tripleBuffer.updateFromBuffer());
+  ASSERT_EQ(tripleBuffer.front(), 1);
+
+  // only the latest published value is kept
+  tripleBuffer.back() = 2;
+  ASSERT_FALSE(tripleBuffer.publish());
+  tripleBuffer.back() = 3;
+  ASSERT_TRUE(tripleBuffer.publish());
+  ASSERT_TRUE(tripleBuffer.updateFromBuffer());
+  ASSERT_EQ(tripleBuffer.front(), 3);
+
+  tripleBuffer.reset();
+  ASSERT_EQ(tripleBuffer.front(), 0);
+  ASSERT_FALSE(tripleBuffer.hasNewValue());
+}
+
+TEST(testTripleBuffer, moveOnly) {
+  ocs2::TripleBuffer<std::unique_ptr<int>> tripleBuffer;
+  ASSERT_EQ(tripleBuffer.front(), nullptr);
+
+  tripleBuffer.back().reset(new int(42));
+  tripleBuffer.publish();
+  ASSERT_TRUE(tripleBuffer.updateFromBuffer());
+  ASSERT_NE(tripleBuffer.front(), nullptr);
+  ASSERT_EQ(*tripleBuffer.front(), 42);
+}
+
+TEST(testTripleBuffer, producerConsumer) {
+  // The producer writes increasing sequences, the consumer must always see a complete sequence with an increasing head.
+  constexpr int numSamples = 20000;
+  constexpr int sequenceLength = 16;
+  ocs2::TripleBuffer<std::array<int, sequenceLength>> tripleBuffer;
+
+  std::thread producer([&]() {
+    for (int i = 1; i <= numSamples; i++) {
+      auto& value = tripleBuffer.back();
+      for (int j = 0; j < sequenceLength; j++) {
+        value[j] = i;
+      }
+      tripleBuffer.publish();
+    }
+  });
+
+  int lastValue = 0;
+  bool isConsistent = true;
+  while (lastValue < numSamples && isConsistent) {
+    if (tripleBuffer.updateFromBuffer()) {
+      const auto& value = tripleBuffer.front();
+      for (int j = 0; j < sequenceLength; j++) {
+        isConsistent = isConsistent && (value[j] == value[0]);
+      }
+      isConsistent = isConsistent && (value[0] > lastValue);
+      lastValue = value[0];
+    }
+  }
+  producer.join();
+
+  ASSERT_TRUE(isConsistent);
+  ASSERT_EQ(lastValue, numSamples);
+}
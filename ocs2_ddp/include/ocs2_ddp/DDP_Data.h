@@ -40,6 +40,21 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace ocs2 {
 
+/**
+ * Resizes a trajectory of the data containers without clearing it. The remaining elements keep their memory, such that refilling them
+ * in place does not allocate once the trajectory lengths are steady.
+ *
+ * @param [out] trajectory: The trajectory to resize.
+ * @param [in] size: The new length of the trajectory.
+ * @return true if the capacity of the trajectory had to grow, i.e. memory was allocated.
+ */
+template <typename Data>
+bool resizeTrajectory(std::vector<Data>& trajectory, size_t size) {
+  const bool grows = size > trajectory.capacity();
+  trajectory.resize(size);
+  return grows;
+}
+
 /**
  * Primal data container
  *
@@ -77,6 +92,23 @@ struct PrimalDataContainer {
   }
 };
 
+/**
+ * The shooting nodes of the multiple-shooting forward pass. The partition p > 0 of the forward pass starts at times[p - 1] from
+ * states[p - 1] + stepLength * stateUpdates[p - 1], where states are the nominal states and stateUpdates are the state updates of the
+ * linearized closed-loop system for a unit step length.
+ */
+struct ShootingNodes {
+  scalar_array_t times;
+  vector_array_t states;
+  vector_array_t stateUpdates;
+
+  void clear() {
+    times.clear();
+    states.clear();
+    stateUpdates.clear();
+  }
+};
+
 /**
  * Dual data container
  *
@@ -33,10 +33,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/control/LinearController.h>
 #include <ocs2_core/model_data/Metrics.h>
 #include <ocs2_core/penalties/MultidimensionalPenalty.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
 #include <ocs2_oc/oc_data/DualSolution.h>
 #include <ocs2_oc/oc_data/PerformanceIndex.h>
 #include <ocs2_oc/oc_problem/OptimalControlProblem.h>
 #include <ocs2_oc/rollout/RolloutBase.h>
+#include <ocs2_oc/trajectory_adjustment/TrajectorySpreading.h>
 
 #include "ocs2_ddp/DDP_Data.h"
 
@@ -63,6 +65,19 @@ void computeRolloutMetrics(OptimalControlProblem& problem, const PrimalSolution&
  */
 PerformanceIndex computeRolloutPerformanceIndex(const scalar_array_t& timeTrajectory, const ProblemMetrics& problemMetrics);
 
+/**
+ * Calculates the PerformanceIndex of the primalSolution rollout without storing the metrics of its points. The result is the same as
+ * computeRolloutPerformanceIndex() of the metrics computed by computeRolloutMetrics(), except for dynamicsViolationSSE and merit which
+ * are not set.
+ *
+ * @param [in] problem: A reference to the optimal control problem.
+ * @param [in] primalSolution: The primal solution.
+ * @param [in] dualSolution: Const reference view to the dual solution
+ * @return The PerformanceIndex of the trajectory.
+ */
+PerformanceIndex computeRolloutPerformanceIndex(OptimalControlProblem& problem, const PrimalSolution& primalSolution,
+                                                DualSolutionConstRef dualSolution);
+
 /**
  * Forward integrate the system dynamics with given controller. It uses the given control policies and initial state,
  * to integrate the system dynamics in time period [initTime, finalTime].
@@ -154,6 +169,41 @@ void retrieveActiveNormalizedTime(const std::pair<int, int>& partitionInterval,
                                   const size_array_t& postEventIndices, scalar_array_t& normalizedTimeTrajectory,
                                   size_array_t& normalizedPostEventIndices);
 
+/**
+ * Computes the shooting times of the multiple-shooting forward pass, i.e. the start times of all partitions except the first one. The time
+ * horizon is split into numPartitions intervals of equal length, similar to computePartitionIntervals. A partition time which is closer
+ * than 1% of the partition length to an event time is dropped, such that the partitions never start at an event.
+ *
+ * @param [in] initTime: The initial time.
+ * @param [in] finalTime: The final time.
+ * @param [in] numPartitions: The number of partitions.
+ * @param [in] eventTimes: The event times of the mode schedule.
+ * @return The increasing shooting times.
+ */
+scalar_array_t computeShootingTimes(scalar_t initTime, scalar_t finalTime, size_t numPartitions, const scalar_array_t& eventTimes);
+
+/**
+ * Rolls out the partitions of the multiple-shooting forward pass in parallel. The first partition starts at initTime from initState and
+ * the partition p > 0 starts at shootingTimes[p - 1] from shootingStates[p - 1]. The partitions are concatenated, where the final node
+ * of each partition but the last one is replaced by the first node of the next partition. The difference between the two is the defect.
+ *
+ * @param [in] threadPool: The thread pool which runs the partitions.
+ * @param [in] rollouts: The rollout instances, at least one per partition.
+ * @param [in] initTime: The initial time.
+ * @param [in] initState: The initial state.
+ * @param [in] finalTime: The final time.
+ * @param [in] shootingTimes: The start times of the partitions except the first one.
+ * @param [in] shootingStates: The initial states of the partitions except the first one.
+ * @param [in, out] primalSolution: The resulting primal solution. The controller and the mode schedule of the primal solution are used
+ *                                  for the rollouts, see rolloutTrajectory.
+ * @return A pair of the average time step and the sum of the squared norms of the defects.
+ */
+std::pair<scalar_t, scalar_t> rolloutMultipleShootingTrajectory(ThreadPool& threadPool,
+                                                                const std::vector<std::reference_wrapper<RolloutBase>>& rollouts,
+                                                                scalar_t initTime, const vector_t& initState, scalar_t finalTime,
+                                                                const scalar_array_t& shootingTimes, const vector_array_t& shootingStates,
+                                                                PrimalSolution& primalSolution);
+
 /**
  * Get the Partition Intervals From Time Trajectory. Intervals are defined as [start, end).
  *
@@ -174,6 +224,30 @@ void retrieveActiveNormalizedTime(const std::pair<int, int>& partitionInterval,
  */
 std::vector<std::pair<int, int>> computePartitionIntervals(const scalar_array_t& timeTrajectory, int numWorkers);
 
+/**
+ * Moves the expansion point of the cost and constraint approximations of the model data by (deltaState, deltaInput) while keeping
+ * their derivatives, which is exact for quadratic costs and linear constraints. The dynamics are not changed, since DDP only uses their
+ * derivatives around the dynamically feasible rollout.
+ *
+ * @param [in] deltaState: The change of the state.
+ * @param [in] deltaInput: The change of the input.
+ * @param [in, out] modelData: The model data to be shifted.
+ */
+void shiftModelDataExpansionPoint(const vector_t& deltaState, const vector_t& deltaInput, ModelData& modelData);
+
+/**
+ * Adjusts in-place all the trajectories of a primal data container based on the last changes in mode schedule. The spreading strategy
+ * is computed once and applied to the primal solution, the metrics, and the model data trajectories.
+ * Note: PrimalSolution::controllerPtr_ will not be adjusted. If the trajectories are truncated, the final-time data are cleared.
+ *
+ * @param [in] oldModeSchedule: The old mode schedule associated to the trajectories which should be adjusted.
+ * @param [in] newModeSchedule: The new mode schedule that should be adapted to.
+ * @param [in, out] primalData: The primal data container that is associated with the old mode schedule.
+ * @returns the status of the devised trajectory spreading strategy.
+ */
+TrajectorySpreading::Status trajectorySpread(const ModeSchedule& oldModeSchedule, const ModeSchedule& newModeSchedule,
+                                             PrimalDataContainer& primalData);
+
 /**
  * Gets a reference to the linear controller from the given primal solution.
  */
@@ -30,6 +30,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include <ocs2_core/Types.h>
 #include <ocs2_core/integration/Integrator.h>
@@ -68,6 +69,10 @@ struct Settings {
   size_t nThreads_ = 1;
   /** Priority of threads used in the multi-threading scheme. */
   int threadPriority_ = 99;
+  /** Time in microseconds that an idle worker thread busy-waits for new tasks before it sleeps. Zero lets it sleep immediately. */
+  size_t threadSpinDuration_ = 0;
+  /** The CPUs the worker threads are pinned to, one CPU per worker. If empty, the workers may run on any CPU. */
+  std::vector<int> threadAffinity_;
 
   /** Maximum number of iterations of DDP. */
   size_t maxNumIterations_ = 15;
@@ -82,6 +87,16 @@ struct Settings {
   bool displayShortSummary_ = false;
   /** Check the numerical stability of the algorithms for debugging purpose. */
   bool checkNumericalStability_ = true;
+  /**
+   * The fraction of the nodes whose LQ approximation and value function are checked per iteration if checkNumericalStability_ is set.
+   * Each node is sampled with this probability and a new subset is sampled in every iteration. The sizes are checked at every node.
+   */
+  scalar_t numericalStabilityCheckRatio_ = 1.0;
+  /**
+   * If true, the LQ approximations and the value functions of the sampled nodes are copied and checked on a background thread with the
+   * lowest scheduling priority. The violations are then logged as warnings and counted instead of thrown. See NumericalStabilityChecker.
+   */
+  bool asynchronousNumericalStabilityCheck_ = false;
   /** Printing rollout trajectory for debugging. */
   bool debugPrintRollout_ = false;
 
@@ -95,12 +110,46 @@ struct Settings {
   scalar_t timeStep_ = 1e-2;
   /** The backward pass integrator type: SLQ uses it for solving Riccati equation and ILQR uses it for discretizing LQ approximation. */
   IntegratorType backwardPassIntegratorType_ = IntegratorType::ODE45;
+  /**
+   * If true, SLQ replaces the integration of the Riccati equations by one discrete-time Riccati update per rollout time step, using the
+   * second-order zero-order-hold discretization of the projected LQ approximation. The backward pass then costs one map per node, but
+   * its accuracy depends on the rollout time resolution. The risk sensitive variant is not supported.
+   */
+  bool discreteRiccatiBackwardPass_ = false;
+  /**
+   * If true, ILQR propagates an upper-triangular square-root factor U of the value function Hessian, Sm = U^T * U, instead of Sm itself.
+   * The factor of each node is the triangular factor of the QR decomposition of the stacked factors of the closed-loop stage cost and
+   * of the propagated value function, such that Sm stays symmetric and positive semi-definite under round-off errors. The risk sensitive
+   * variant is not supported.
+   */
+  bool squareRootRiccati_ = false;
+  /**
+   * If true, the forward pass of ILQR splits the time horizon into nThreads_ partitions of equal length which are rolled out in parallel,
+   * each from its own initial state. The initial states of the partitions are the nominal states moved along the linearized closed-loop
+   * update, and the defects between the end of a partition and the start of the next one are closed by the next backward pass. The
+   * defects are added to the equality constraint violation of the merit function. Only valid for ILQR with the line-search strategy.
+   */
+  bool multipleShootingForwardPass_ = false;
 
   /** The initial coefficient of the quadratic penalty function in the merit function. It should be greater than one. */
   scalar_t constraintPenaltyInitialValue_ = 2.0;
   /** The rate that the coefficient of the quadratic penalty function in the merit function grows. It should be greater than one. */
   scalar_t constraintPenaltyIncreaseRate_ = 2.0;
 
+  /**
+   * If positive, the LQ approximation of an intermediate node is reused from the previous iteration when the time grid around the node
+   * is unchanged and both the state and input moved less than this tolerance in the infinity norm. The cost and constraint terms of the
+   * reused approximation are shifted to the new expansion point to the first order, while the multiplier and penalty terms stay those of
+   * the previous iteration. Zero disables the reuse.
+   */
+  scalar_t lqReuseTolerance_ = 0.0;
+
+  /**
+   * If true, the activity of the cost and constraint terms is evaluated once per interval of the mode schedule at the beginning of each
+   * run instead of on every evaluation. Only valid if the activity of the terms changes only at the event times.
+   */
+  bool cacheTermActivity_ = false;
+
   /** If true, terms of the Riccati equation will be pre-computed before interpolation in the flow-map */
   bool preComputeRiccatiTerms_ = true;
 
@@ -29,6 +29,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <atomic>
+#include <mutex>
+
 #include <ocs2_core/Types.h>
 #include <ocs2_core/control/LinearController.h>
 #include <ocs2_core/dynamics/SystemDynamicsBase.h>
@@ -39,6 +42,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/model_data/Metrics.h>
 #include <ocs2_core/model_data/ModelData.h>
 #include <ocs2_core/model_data/ModelDataLinearInterpolation.h>
+#include <ocs2_core/thread_support/TaskGraph.h>
 #include <ocs2_core/thread_support/ThreadPool.h>
 
 #include <ocs2_oc/approximate_model/LinearQuadraticApproximator.h>
@@ -49,6 +53,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_ddp/DDP_Data.h"
 #include "ocs2_ddp/DDP_Settings.h"
+#include "ocs2_ddp/NumericalStabilityChecker.h"
 #include "ocs2_ddp/riccati_equations/RiccatiModification.h"
 #include "ocs2_ddp/search_strategy/SearchStrategyBase.h"
 
@@ -66,9 +71,11 @@ class GaussNewtonDDP : public SolverBase {
    * @param [in] rollout: The rollout class used for simulating the system dynamics.
    * @param [in] optimalControlProblem: The optimal control problem formulation.
    * @param [in] initializer: This class initializes the state-input for the time steps that no controller is available.
+   * @param [in] threadPoolPtr: A thread pool which is shared with other clients. The solver uses at most ddpSettings.nThreads of its
+   *                            threads. If nullptr, the solver creates its own pool with ddpSettings.nThreads - 1 workers.
    */
   GaussNewtonDDP(ddp::Settings ddpSettings, const RolloutBase& rollout, const OptimalControlProblem& optimalControlProblem,
-                 const Initializer& initializer);
+                 const Initializer& initializer, std::shared_ptr<ThreadPool> threadPoolPtr = nullptr);
 
   /**
    * Destructor.
@@ -91,7 +98,7 @@ class GaussNewtonDDP : public SolverBase {
 
   const DualSolution& getDualSolution() const override { return optimizedDualSolution_; }
 
-  const ProblemMetrics& getSolutionMetrics() const override { return optimizedProblemMetrics_; }
+  const ProblemMetrics& getSolutionMetrics() const override;
 
   ScalarFunctionQuadraticApproximation getValueFunction(scalar_t time, const vector_t& state) const override {
     return getValueFunctionImpl(time, state, nominalPrimalData_.primalSolution, nominalDualData_.valueFunctionTrajectory);
@@ -99,6 +106,27 @@ class GaussNewtonDDP : public SolverBase {
 
   ScalarFunctionQuadraticApproximation getHamiltonian(scalar_t time, const vector_t& state, const vector_t& input) override;
 
+  /**
+   * Computes the derivatives of the cost w.r.t. the event times of the mode schedule with the adjoint (costate) method. Using the
+   * gradient of the value function as the costate, the derivative w.r.t. an event time is the jump of the Hamiltonian over the event,
+   * H(t_e^-) - H(t_e^+). Therefore, all the derivatives are read off the last backward pass, instead of integrating one sensitivity
+   * system per event time. The derivatives are accurate once the solver has converged.
+   *
+   * @return The derivatives w.r.t. the event times of the mode schedule. They are zero for the events outside of the time horizon.
+   */
+  vector_t getEventTimesCostDerivative();
+
+  /**
+   * Swaps the data of the last LQ approximation, i.e. the LQ problem around the nominal trajectories of the last iteration and its
+   * Riccati solution, with the given containers. It hands these data over without copying them, see DDP_DataCollector. The solver
+   * continues with the given containers, therefore the queries which read these data, e.g. getValueFunction(), are not available until
+   * the next run.
+   *
+   * @param [in, out] primalData: The primal data container. Its primal solution should have a LinearController.
+   * @param [in, out] dualData: The dual data container.
+   */
+  void swapLqApproximationData(PrimalDataContainer& primalData, DualDataContainer& dualData);
+
   vector_t getStateInputEqualityConstraintLagrangian(scalar_t time, const vector_t& state) const override {
     return getStateInputEqualityConstraintLagrangianImpl(time, state, nominalPrimalData_, nominalDualData_);
   }
@@ -109,6 +137,19 @@ class GaussNewtonDDP : public SolverBase {
 
   std::string getBenchmarkingInfo() const override;
 
+  void setTracer(std::shared_ptr<benchmark::Tracer> tracerPtr) override {
+    profiler_.setTracer(tracerPtr);
+    searchStrategyPtr_->setTracer(tracerPtr.get());
+    SolverBase::setTracer(std::move(tracerPtr));
+  }
+
+  const benchmark::Profiler* getProfiler() const override { return &profiler_; }
+
+  /**
+   * The checker of the numerical stability, which counts the checks and the violations. It is nullptr if the check is disabled.
+   */
+  const NumericalStabilityChecker* getNumericalStabilityChecker() const { return numericalStabilityCheckerPtr_.get(); }
+
   /**
    * Const access to ddp settings
    */
@@ -122,7 +163,19 @@ class GaussNewtonDDP : public SolverBase {
    * @param [in] N: number of times to run taskFunction, if N = 1 it is run in the main thread
    */
   void runParallel(std::function<void(void)> taskFunction, size_t N) {
-    threadPool_.runParallel([&](int) { taskFunction(); }, N);
+    threadPoolPtr_->runParallel([&](int) { taskFunction(); }, N);
+  }
+
+  /**
+   * Helper to run a loop over [0, N) in parallel with load balancing between the threads (blocking)
+   *
+   * @param [in] N: number of loop iterations
+   * @param [in] taskFunction: task function with signature void(int workerIndex, int index). workerIndex is in [0, nThreads - 1]
+   * and can be used to index the thread resources.
+   */
+  void parallelFor(size_t N, std::function<void(int, int)> taskFunction) {
+    constexpr int grain = 1;  // time nodes are expensive and can differ strongly in cost
+    threadPoolPtr_->parallelFor(0, static_cast<int>(N), grain, std::move(taskFunction), ddpSettings_.nThreads_);
   }
 
   /**
@@ -149,12 +202,16 @@ class GaussNewtonDDP : public SolverBase {
   virtual matrix_t computeHamiltonianHessian(const ModelData& modelData, const matrix_t& Sm) const = 0;
 
   /**
-   * Calculates an LQ approximate of the optimal control problem for the nodes.
+   * Calculates an LQ approximate of the optimal control problem for an intermediate node. The model data trajectory of primalData
+   * is already resized. This method is called concurrently for different nodes.
    *
+   * @param [in] workerIndex: The index of the calling thread in [0, nThreads - 1], which can be used to index the thread resources.
+   * @param [in] timeIndex: The index of the node.
    * @param [in] dualSolution: The dual solution
    * @param [in,out] primalData: The primal Data
    */
-  virtual void approximateIntermediateLQ(const DualSolution& dualSolution, PrimalDataContainer& primalData) = 0;
+  virtual void approximateIntermediateLQ(int workerIndex, size_t timeIndex, const DualSolution& dualSolution,
+                                         PrimalDataContainer& primalData) = 0;
 
   /**
    * Calculate controller for the timeIndex by using primal and dual and write the result back to dstController
@@ -265,6 +322,13 @@ class GaussNewtonDDP : public SolverBase {
    */
   void calculateController();
 
+  /**
+   * Computes the states and the state updates of the shooting nodes of the multiple-shooting forward pass. The state updates are found
+   * by propagating the discrete-time LQ model with the unoptimized controller and a unit step length from a zero initial state update.
+   * The shooting times should be already set.
+   */
+  void computeShootingNodes();
+
   /**
    * Display rollout info and scores.
    */
@@ -291,6 +355,18 @@ class GaussNewtonDDP : public SolverBase {
    */
   void approximateOptimalControlProblem();
 
+  /** Applies the Hessian correction of the line search to the given cost Hessian of the LQ approximation. */
+  void correctHessian(matrix_t& hessian) const;
+
+  /**
+   * Reuses the LQ approximation of the previous iteration at the given intermediate time index, if the time stamps of the node and its
+   * successor are unchanged and the state and input moved less than lqReuseTolerance in the infinity norm.
+   *
+   * @param [in] timeIndex: The time index of the intermediate node.
+   * @return true if the approximation is reused.
+   */
+  bool reuseIntermediateLQ(size_t timeIndex);
+
   /**
    *
    * @param [in] Hm: inv(Hm) defines the oblique projection for state-input equality constraints.
@@ -321,8 +397,12 @@ class GaussNewtonDDP : public SolverBase {
    */
   void initializeDualSolutionAndMetrics();
 
-  /** Based on the current LQ solution updates the optimized primal and dual solutions. */
-  void takePrimalDualStep(scalar_t lqModelExpectedCost);
+  /**
+   * Based on the current LQ solution updates the optimized primal and dual solutions.
+   *
+   * @return false if the search strategy has rejected the step, in which case the optimized solutions are the nominal ones.
+   */
+  bool takePrimalDualStep(scalar_t lqModelExpectedCost);
 
   /**
    * Checks convergence of the main loop of DDP.
@@ -341,6 +421,9 @@ class GaussNewtonDDP : public SolverBase {
 
   void runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime, const PrimalSolution& primalSolution) override;
 
+  void runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime, const PrimalSolution& primalSolution,
+               const DualSolution& dualSolution) override;
+
  protected:
   // nominal data
   DualDataContainer nominalDualData_;
@@ -351,7 +434,6 @@ class GaussNewtonDDP : public SolverBase {
 
   // multi-threading helper variables
   std::atomic_size_t nextTaskId_{0};
-  std::atomic_size_t nextTimeIndex_{0};
 
   scalar_t initTime_ = 0.0;
   scalar_t finalTime_ = 0.0;
@@ -360,10 +442,32 @@ class GaussNewtonDDP : public SolverBase {
   std::unique_ptr<SearchStrategyBase> searchStrategyPtr_;
   std::vector<OptimalControlProblem> optimalControlProblemStock_;
 
+  // number of times the capacity of a nominal data trajectory had to grow, which stays constant once the trajectory lengths are steady
+  size_t numTrajectoryAllocations_ = 0;
+
+  // number of all and reused LQ approximations of the intermediate nodes
+  size_t numIntermediateLQ_ = 0;
+  std::atomic_size_t numReusedIntermediateLQ_{0};
+
+  // shooting nodes of the multiple-shooting forward pass, empty for single shooting
+  ShootingNodes shootingNodes_;
+
+  // checks the LQ approximations of the sampled nodes, nullptr if ddp::Settings::checkNumericalStability_ is false
+  std::unique_ptr<NumericalStabilityChecker> numericalStabilityCheckerPtr_;
+
  private:
   const ddp::Settings ddpSettings_;
 
-  ThreadPool threadPool_;
+  std::shared_ptr<ThreadPool> threadPoolPtr_;
+
+  // the LQ approximation of a linear-quadratic problem is exact, hence its first accepted full step terminates the iterations, unless
+  // the LQ approximation has been regularized by the Hessian correction or the search strategy. See isLinearQuadratic().
+  bool isLinearQuadratic_ = false;
+  mutable std::atomic_bool isLqRegularized_{false};
+
+  // the metrics of the rollout points are required for updating the multipliers of the Lagrangian terms, otherwise they are only
+  // computed on demand. See getSolutionMetrics().
+  bool hasLagrangianTerms_ = false;
 
   unsigned long long int totalNumIterations_{0};
 
@@ -376,7 +480,8 @@ class GaussNewtonDDP : public SolverBase {
   // optimized data
   DualSolution optimizedDualSolution_;
   PrimalSolution optimizedPrimalSolution_;
-  ProblemMetrics optimizedProblemMetrics_;
+  mutable std::mutex optimizedProblemMetricsMutex_;
+  mutable ProblemMetrics optimizedProblemMetrics_;  // computed on demand if empty, see getSolutionMetrics()
 
   // cached data used for caching the nominal trajectories for which the LQ problem is
   // constructed and solved before terminating run()
@@ -394,12 +499,7 @@ class GaussNewtonDDP : public SolverBase {
   scalar_t avgTimeStepBP_ = 0.0;
 
   // benchmarking
-  benchmark::RepeatedTimer initializationTimer_;
-  benchmark::RepeatedTimer linearQuadraticApproximationTimer_;
-  benchmark::RepeatedTimer backwardPassTimer_;
-  benchmark::RepeatedTimer computeControllerTimer_;
-  benchmark::RepeatedTimer searchStrategyTimer_;
-  benchmark::RepeatedTimer totalDualSolutionTimer_;
+  benchmark::Profiler profiler_;
 };
 
 }  // namespace ocs2
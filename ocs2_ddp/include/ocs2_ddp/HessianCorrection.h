@@ -39,9 +39,10 @@ namespace hessian_correction {
 
 /**
  * @brief The Hessian matrix correction strategy
- * Enum used in selecting either DIAGONAL_SHIFT, CHOLESKY_MODIFICATION, EIGENVALUE_MODIFICATION, or GERSHGORIN_MODIFICATION strategies.
+ * Enum used in selecting either DIAGONAL_SHIFT, CHOLESKY_MODIFICATION, CHOLESKY_SHIFT, EIGENVALUE_MODIFICATION, or
+ * GERSHGORIN_MODIFICATION strategies.
  */
-enum class Strategy { DIAGONAL_SHIFT, CHOLESKY_MODIFICATION, EIGENVALUE_MODIFICATION, GERSHGORIN_MODIFICATION };
+enum class Strategy { DIAGONAL_SHIFT, CHOLESKY_MODIFICATION, CHOLESKY_SHIFT, EIGENVALUE_MODIFICATION, GERSHGORIN_MODIFICATION };
 
 /**
  * Get string name of Hessian_Correction type
@@ -67,17 +68,22 @@ template <typename Derived>
 void shiftHessian(Strategy strategy, Eigen::MatrixBase<Derived>& matrix,
                   scalar_t minEigenvalue = numeric_traits::limitEpsilon<scalar_t>()) {
   assert(matrix.rows() == matrix.cols());
+  // derived() dispatches to the matrix_t overloads without a copy if Derived is matrix_t
   switch (strategy) {
     case Strategy::DIAGONAL_SHIFT: {
       matrix.diagonal().array() += minEigenvalue;
       break;
     }
     case Strategy::CHOLESKY_MODIFICATION: {
-      LinearAlgebra::makePsdCholesky(matrix, minEigenvalue);
+      LinearAlgebra::makePsdCholesky(matrix.derived(), minEigenvalue);
+      break;
+    }
+    case Strategy::CHOLESKY_SHIFT: {
+      LinearAlgebra::makePsdCholeskyShift(matrix.derived(), minEigenvalue);
       break;
     }
     case Strategy::EIGENVALUE_MODIFICATION: {
-      LinearAlgebra::makePsdEigenvalue(matrix, minEigenvalue);
+      LinearAlgebra::makePsdEigenvalue(matrix.derived(), minEigenvalue);
       break;
     }
     case Strategy::GERSHGORIN_MODIFICATION: {
@@ -49,9 +49,11 @@ class ILQR : public GaussNewtonDDP {
    * @param [in] rollout: The rollout class used for simulating the system dynamics.
    * @param [in] optimalControlProblem: The optimal control problem formulation.
    * @param [in] initializer: This class initializes the state-input for the time steps that no controller is available.
+   * @param [in] threadPoolPtr: A thread pool which is shared with other clients. The solver uses at most ddpSettings.nThreads of its
+   *                            threads. If nullptr, the solver creates its own pool with ddpSettings.nThreads - 1 workers.
    */
   ILQR(ddp::Settings ddpSettings, const RolloutBase& rollout, const OptimalControlProblem& optimalControlProblem,
-       const Initializer& initializer);
+       const Initializer& initializer, std::shared_ptr<ThreadPool> threadPoolPtr = nullptr);
 
   /**
    * Default destructor.
@@ -69,7 +71,8 @@ class ILQR : public GaussNewtonDDP {
 
   matrix_t computeHamiltonianHessian(const ModelData& modelData, const matrix_t& Sm) const override;
 
-  void approximateIntermediateLQ(const DualSolution& dualSolution, PrimalDataContainer& primalData) override;
+  void approximateIntermediateLQ(int workerIndex, size_t timeIndex, const DualSolution& dualSolution,
+                                 PrimalDataContainer& primalData) override;
 
   /**
    * Calculates the discrete-time LQ approximation from the continuous-time LQ approximation.
@@ -81,18 +84,21 @@ class ILQR : public GaussNewtonDDP {
    * @param [in] timeStep: Time step between the x_{k} and x_{k+1}.
    * @param [in] continuousTimeModelData: continuous time model data.
    * @param [out] modelData: Discretized mode data.
+   * @param [in] nextStatePtr: If not nullptr, the state x_{k+1} which the dynamics bias is computed for. Otherwise, the bias is zero.
    */
   void discreteLQWorker(SystemDynamicsBase& system, scalar_t time, const vector_t& state, const vector_t& input, scalar_t timeStep,
-                        const ModelData& continuousTimeModelData, ModelData& modelData);
+                        const ModelData& continuousTimeModelData, ModelData& modelData, const vector_t* nextStatePtr = nullptr);
 
   /****************
    *** Variables **
    ****************/
   matrix_array_t projectedKmTrajectoryStock_;  // projected feedback
   vector_array_t projectedLvTrajectoryStock_;  // projected feedforward
+  matrix_array_t SmFactorTrajectoryStock_;     // upper-triangular factor of the Riccati matrix in the square-root form
 
   DynamicsSensitivityDiscretizer sensitivityDiscretizer_;
   std::vector<std::unique_ptr<DiscreteTimeRiccatiEquations>> riccatiEquationsPtrStock_;
+  std::vector<ModelData> continuousTimeModelDataStock_;  // continuous-time LQ buffer of each worker
 };
 
 }  // namespace ocs2
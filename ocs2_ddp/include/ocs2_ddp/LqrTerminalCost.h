@@ -0,0 +1,180 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include <ocs2_core/cost/StateCost.h>
+
+#include "ocs2_ddp/ContinuousTimeLqr.h"
+
+namespace ocs2 {
+namespace continuous_time_lqr {
+
+/** An operating point around which the LQR problem is solved. */
+struct OperatingPoint {
+  /** The value of the scheduling variable at this operating point */
+  scalar_t scheduling;
+  /** Time, state, and input around which the LQ approximation is made */
+  scalar_t time;
+  vector_t state;
+  vector_t input;
+};
+
+/**
+ * The value function matrices of the LQR problem tabulated over a grid of the scheduling variable. In between the grid points the
+ * matrices are linearly interpolated, outside of the grid the first or last matrix is used.
+ */
+class ValueFunctionTable {
+ public:
+  /**
+   * Constructor.
+   *
+   * @param [in] schedulingGrid: The strictly increasing values of the scheduling variable.
+   * @param [in] valueFunctions: The value function matrix at each grid point.
+   */
+  ValueFunctionTable(scalar_array_t schedulingGrid, matrix_array_t valueFunctions);
+
+  /** Gets the interpolated value function matrix at the given value of the scheduling variable. */
+  matrix_t getValueFunction(scalar_t scheduling) const;
+
+  const scalar_array_t& getSchedulingGrid() const { return schedulingGrid_; }
+  const matrix_array_t& getValueFunctions() const { return valueFunctions_; }
+
+ private:
+  scalar_array_t schedulingGrid_;
+  matrix_array_t valueFunctions_;
+};
+
+/**
+ * Solves the LQR problem at each of the operating points and tabulates the value functions.
+ *
+ * @param [in] problem: The optimal control problem.
+ * @param [in] operatingPoints: The operating points. They are sorted by the scheduling variable, which must be unique.
+ * @param [in] settings: The LQR settings.
+ * @return The value function table.
+ */
+ValueFunctionTable solveValueFunctionTable(OptimalControlProblem& problem, std::vector<OperatingPoint> operatingPoints,
+                                           const Settings& settings = Settings());
+
+/**
+ * Holds the latest value function table. The table can be recomputed in a background thread such that the users of the table, e.g.
+ * the MPC, never wait for the LQR solutions. They keep reading the previous table until the new one is swapped in.
+ */
+class ValueFunctionTableProvider {
+ public:
+  /** Constructor. No table is available until setTable() is called or a background update has finished. */
+  ValueFunctionTableProvider() = default;
+
+  /** Constructor with an initial table. */
+  explicit ValueFunctionTableProvider(ValueFunctionTable table);
+
+  /** Destructor. Waits for a running background update to finish. */
+  ~ValueFunctionTableProvider();
+
+  ValueFunctionTableProvider(const ValueFunctionTableProvider&) = delete;
+  ValueFunctionTableProvider& operator=(const ValueFunctionTableProvider&) = delete;
+
+  /** Gets the latest table. Returns nullptr if no table is available yet. */
+  std::shared_ptr<const ValueFunctionTable> getTable() const;
+
+  /** Replaces the table. */
+  void setTable(ValueFunctionTable table);
+
+  /**
+   * Starts recomputing the table in a background thread. If the computation fails, the error is printed and the previous table is kept.
+   *
+   * @param [in] problemPtr: The optimal control problem which is used by the background thread only.
+   * @param [in] operatingPoints: The operating points.
+   * @param [in] settings: The LQR settings.
+   * @return false if the previous background update is still running, in which case no update is started.
+   */
+  bool updateInBackground(std::unique_ptr<OptimalControlProblem> problemPtr, std::vector<OperatingPoint> operatingPoints,
+                          const Settings& settings = Settings());
+
+  /** Whether a background update is running. */
+  bool isUpdating() const { return isUpdating_; }
+
+  /** Waits for a running background update to finish. */
+  void wait();
+
+ private:
+  mutable std::mutex tableMutex_;
+  std::shared_ptr<const ValueFunctionTable> tablePtr_;
+
+  std::thread workerThread_;
+  std::atomic_bool isUpdating_{false};
+};
+
+}  // namespace continuous_time_lqr
+
+/**
+ * Terminal cost J = 0.5 (x - x_ref)' S (x - x_ref) where S is interpolated from a precomputed LQR value function table and x_ref is the
+ * target state at the final time. The table is shared among the clones of the cost, hence it can be updated in the background while
+ * the solvers are running.
+ */
+class LqrTerminalCost final : public StateCost {
+ public:
+  /** Maps time, state, and target trajectories to the scheduling variable of the value function table. */
+  using scheduling_function_t = std::function<scalar_t(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories)>;
+
+  /**
+   * Constructor.
+   *
+   * @param [in] tableProviderPtr: The provider of the value function table.
+   * @param [in] schedulingFunction: The scheduling function.
+   */
+  LqrTerminalCost(std::shared_ptr<continuous_time_lqr::ValueFunctionTableProvider> tableProviderPtr,
+                  scheduling_function_t schedulingFunction);
+
+  ~LqrTerminalCost() override = default;
+  LqrTerminalCost* clone() const override { return new LqrTerminalCost(*this); }
+
+  scalar_t getValue(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
+                    const PreComputation& preComp) const override;
+
+  ScalarFunctionQuadraticApproximation getQuadraticApproximation(scalar_t time, const vector_t& state,
+                                                                 const TargetTrajectories& targetTrajectories,
+                                                                 const PreComputation& preComp) const override;
+
+ private:
+  LqrTerminalCost(const LqrTerminalCost& rhs) = default;
+
+  matrix_t getValueFunction(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories) const;
+
+  std::shared_ptr<continuous_time_lqr::ValueFunctionTableProvider> tableProviderPtr_;
+  scheduling_function_t schedulingFunction_;
+};
+
+}  // namespace ocs2
@@ -0,0 +1,147 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/model_data/ModelData.h>
+
+namespace ocs2 {
+
+/**
+ * Checks the numerical properties of the LQ approximation of the nodes of DDP, i.e. checkDynamicsProperties(), checkCostProperties(),
+ * and checkConstraintProperties(), and the positive semi-definiteness of the value function, which involve eigenvalue decompositions per
+ * node. To keep the checks enabled in production, only a
+ * random subset of the nodes can be checked per iteration, and the checks can be offloaded to a background thread with the lowest
+ * scheduling priority, which checks copies of the sampled data.
+ *
+ * A synchronous check throws on a violation. An asynchronous check detects a violation after the iteration has moved on, it therefore
+ * logs the violation as a warning and counts it instead.
+ */
+class NumericalStabilityChecker {
+ public:
+  /**
+   * Constructor
+   *
+   * @param [in] checkRatio: The fraction of the nodes which are checked per iteration, each node is sampled with this probability.
+   * @param [in] asynchronous: If true, the sampled nodes are checked on a background thread.
+   * @param [in] maxQueueSize: The maximum number of nodes waiting for the background thread, further nodes are skipped.
+   */
+  explicit NumericalStabilityChecker(scalar_t checkRatio = 1.0, bool asynchronous = false, size_t maxQueueSize = 1000);
+
+  /** Destructor. Finishes the queued checks. */
+  ~NumericalStabilityChecker();
+
+  NumericalStabilityChecker(const NumericalStabilityChecker&) = delete;
+  NumericalStabilityChecker& operator=(const NumericalStabilityChecker&) = delete;
+
+  /** Starts a new iteration, in which a new subset of the nodes is sampled. Not thread-safe with respect to the other methods. */
+  void newIteration() { ++iteration_; }
+
+  /** Whether the node of the given index is sampled in the current iteration. The sample only depends on the iteration and the index. */
+  bool isSampled(size_t index) const;
+
+  /**
+   * Checks the properties of the LQ approximation of a node if the node is sampled. This method can be called concurrently.
+   *
+   * @param [in] index: The index of the node, which determines the sample.
+   * @param [in] time: The time of the node.
+   * @param [in] modelData: The LQ approximation of the node.
+   * @param [in] description: The description of a violation, which is followed by the time and the error, e.g. "[SLQ] Ill-posed problem
+   *                          at intermediate time". It should be a string literal since it is kept for the background thread.
+   * @throw std::runtime_error on a violation if the check is synchronous.
+   */
+  void check(size_t index, scalar_t time, const ModelData& modelData, const char* description);
+
+  /**
+   * Checks that the Hessian of the value function of a node is positive semi-definite if the node is sampled. This method can be called
+   * concurrently.
+   *
+   * @param [in] index: The index of the node, which determines the sample.
+   * @param [in] time: The time of the node.
+   * @param [in] valueFunction: The value function of the node.
+   * @param [in] description: The description of a violation, see check().
+   * @throw std::runtime_error on a violation if the check is synchronous.
+   */
+  void checkValueFunction(size_t index, scalar_t time, const ScalarFunctionQuadraticApproximation& valueFunction,
+                          const char* description);
+
+  /** Waits until the background thread has checked the queued nodes. */
+  void waitForChecks() const;
+
+  /** The number of checked nodes. */
+  size_t getNumChecks() const { return numChecks_; }
+
+  /** The number of nodes which violate the properties. */
+  size_t getNumViolations() const { return numViolations_; }
+
+  /** The number of sampled nodes which have been skipped since the queue of the background thread was full. */
+  size_t getNumSkippedChecks() const { return numSkippedChecks_; }
+
+ private:
+  struct Job {
+    scalar_t time;
+    const char* description;
+    std::function<std::string()> check;  // returns the description of the violations, owns a copy of the checked data
+  };
+
+  /** Counts the check and throws on a violation, i.e. a non-empty error. */
+  void throwOnViolation(scalar_t time, const char* description, const std::string& err);
+
+  /** Queues a check for the background thread, or skips it if the queue is full. */
+  void enqueue(Job job);
+
+  void backgroundWorker();
+
+  const scalar_t checkRatio_;
+  const bool asynchronous_;
+  const size_t maxQueueSize_;
+  size_t iteration_ = 0;
+
+  std::atomic_size_t numChecks_{0};
+  std::atomic_size_t numViolations_{0};
+  std::atomic_size_t numSkippedChecks_{0};
+
+  mutable std::mutex mutex_;
+  mutable std::condition_variable jobsDoneCondition_;
+  std::condition_variable newJobCondition_;
+  std::deque<Job> jobs_;
+  bool isChecking_ = false;
+  bool stop_ = false;
+  std::thread thread_;
+};
+
+}  // namespace ocs2
@@ -34,6 +34,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_ddp/GaussNewtonDDP.h"
 #include "ocs2_ddp/riccati_equations/ContinuousTimeRiccatiEquations.h"
+#include "ocs2_ddp/riccati_equations/DiscreteTimeRiccatiEquations.h"
 
 namespace ocs2 {
 
@@ -49,9 +50,11 @@ class SLQ final : public GaussNewtonDDP {
    * @param [in] rollout: The rollout class used for simulating the system dynamics.
    * @param [in] optimalControlProblem: The optimal control problem formulation.
    * @param [in] initializer: This class initializes the state-input for the time steps that no controller is available.
+   * @param [in] threadPoolPtr: A thread pool which is shared with other clients. The solver uses at most ddpSettings.nThreads of its
+   *                            threads. If nullptr, the solver creates its own pool with ddpSettings.nThreads - 1 workers.
    */
   SLQ(ddp::Settings ddpSettings, const RolloutBase& rollout, const OptimalControlProblem& optimalControlProblem,
-      const Initializer& initializer);
+      const Initializer& initializer, std::shared_ptr<ThreadPool> threadPoolPtr = nullptr);
 
   /**
    * Default destructor.
@@ -61,7 +64,8 @@ class SLQ final : public GaussNewtonDDP {
  protected:
   matrix_t computeHamiltonianHessian(const ModelData& modelData, const matrix_t& Sm) const override;
 
-  void approximateIntermediateLQ(const DualSolution& dualSolution, PrimalDataContainer& primalData) override;
+  void approximateIntermediateLQ(int workerIndex, size_t timeIndex, const DualSolution& dualSolution,
+                                 PrimalDataContainer& primalData) override;
 
   void calculateControllerWorker(size_t timeIndex, const PrimalDataContainer& primalData, const DualDataContainer& dualData,
                                  LinearController& dstController) override;
@@ -89,14 +93,34 @@ class SLQ final : public GaussNewtonDDP {
                                            scalar_array_t& SsNormalizedTime, size_array_t& SsNormalizedPostEventIndices,
                                            vector_array_t& allSsTrajectory);
 
+  /**
+   * Solves the Riccati equations of the partition with one discrete-time Riccati update per time step of the nominal time trajectory.
+   * The flow over each interval is approximated by the zero-order-hold discretization of the projected LQ approximation at its start.
+   *
+   * @param [in] workerIndex: Working agent index.
+   * @param [in] partitionInterval: The time partition of the value function, [first, second).
+   * @param [in] finalValueFunction: The value function at the end of the partition.
+   */
+  void discreteRiccatiEquationsWorker(size_t workerIndex, const std::pair<int, int>& partitionInterval,
+                                      const ScalarFunctionQuadraticApproximation& finalValueFunction);
+
   /****************
    *** Variables **
    ****************/
+  // the projected model data trajectory, stored field by field for the interpolations of the Riccati equations
+  ModelDataTrajectory projectedModelDataTrajectory_;
   std::vector<std::shared_ptr<ContinuousTimeRiccatiEquations>> riccatiEquationsPtrStock_;
   std::vector<std::unique_ptr<IntegratorBase>> riccatiIntegratorPtrStock_;
   vector_array2_t allSsTrajectoryStock_;
   scalar_array2_t SsNormalizedTimeTrajectoryStock_;
   size_array2_t SsNormalizedEventsPastTheEndIndecesStock_;
+
+  // discrete-time backward pass
+  std::vector<std::unique_ptr<DiscreteTimeRiccatiEquations>> discreteRiccatiEquationsPtrStock_;
+  std::vector<ModelData> discreteModelDataStock_;
+  std::vector<riccati_modification::Data> discreteRiccatiModificationStock_;
+  matrix_array_t projectedKmStock_;
+  vector_array_t projectedLvStock_;
 };
 
 }  // namespace ocs2
@@ -37,6 +37,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/integration/OdeBase.h>
 #include <ocs2_core/misc/LinearInterpolation.h>
 #include <ocs2_core/model_data/ModelData.h>
+#include <ocs2_core/model_data/ModelDataTrajectory.h>
 
 #include "ocs2_ddp/riccati_equations/RiccatiModification.h"
 
@@ -54,11 +55,8 @@ struct ContinuousTimeRiccatiData {
   vector_t dSv_;
   matrix_t dSm_;
 
-  vector_t projectedHv_;
-  matrix_t projectedAm_;
-  matrix_t projectedBm_;
-  matrix_t projectedRm_;
-  matrix_t dynamicsCovariance_;
+  // the interpolated fields of the projected model data which are used in the flow map
+  ModelData projectedModelData_;
 
   matrix_t deltaQm_;
 
@@ -168,12 +166,12 @@ class ContinuousTimeRiccatiEquations final : public OdeBase {
    * Sets coefficients of the model.
    *
    * @param [in] timeStampPtr: A pointer to the time stamp trajectory.
-   * @param [in] projectedModelDataPtr: A pointer to the projected model data trajectory.
+   * @param [in] projectedModelDataPtr: A pointer to the projected model data trajectory, in the structure-of-arrays layout.
    * @param [in] eventsPastTheEndIndecesPtr: A pointer to the post event indices.
    * @param [in] modelDataEventTimesPtr: A pointer to the model data at event times.
    * @param [in] riccatiModificationPtr: A pointer to the RiccatiModification trajectory.
    */
-  void setData(const scalar_array_t* timeStampPtr, const std::vector<ModelData>* projectedModelDataPtr,
+  void setData(const scalar_array_t* timeStampPtr, const ModelDataTrajectory* projectedModelDataPtr,
                const size_array_t* eventsPastTheEndIndecesPtr, const std::vector<ModelData>* modelDataEventTimesPtr,
                const std::vector<riccati_modification::Data>* riccatiModificationPtr);
 
@@ -230,13 +228,15 @@ class ContinuousTimeRiccatiEquations final : public OdeBase {
   bool reducedFormRiccati_;
   bool isRiskSensitive_;
   scalar_t riskSensitiveCoeff_ = 0.0;
+  uint32_t flowMapFields_;  // the mask of the projected model data fields which are interpolated in the flow map
 
   // array pointers
   const scalar_array_t* timeStampPtr_ = nullptr;
-  const std::vector<ModelData>* projectedModelDataPtr_ = nullptr;
+  const ModelDataTrajectory* projectedModelDataPtr_ = nullptr;
   const std::vector<ModelData>* modelDataEventTimesPtr_ = nullptr;
   const std::vector<riccati_modification::Data>* riccatiModificationPtr_ = nullptr;
   scalar_array_t eventTimes_;
+  int timeSegmentCursor_ = 0;  // the lookup hint of the time segment in computeFlowMap
 
   ContinuousTimeRiccatiData continuousTimeRiccatiData_;
 };
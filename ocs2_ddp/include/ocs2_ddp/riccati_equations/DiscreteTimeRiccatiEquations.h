@@ -63,6 +63,16 @@ struct DiscreteTimeRiccatiData {
   scalar_t sNextStochastic_ = 0.0;
   vector_t SvNextStochastic_;
   matrix_t SmNextStochastic_;
+
+  // square-root data
+  matrix_t U_projectedAm_;
+  matrix_t U_projectedBm_;
+  vector_t U_projectedHv_;
+  matrix_t projectedPm_projectedKm_;
+  matrix_t closedLoopCost_;
+  matrix_t closedLoopCostFactor_;
+  matrix_t stackedFactors_;
+  Eigen::HouseholderQR<matrix_t> stackedFactorsQR_;
 };
 
 /**
@@ -107,6 +117,36 @@ class DiscreteTimeRiccatiEquations {
                   const vector_t& SvNext, const scalar_t& sNext, matrix_t& projectedKm, vector_t& projectedLv, matrix_t& Sm, vector_t& Sv,
                   scalar_t& s);
 
+  /**
+   * Computes one step Riccati difference equations in the square-root form for ILQR formulation. Instead of the Riccati matrix, its
+   * upper-triangular factor U is propagated, where Sm = U^T * U. The new factor is the triangular factor of the QR decomposition of the
+   * stacked factors of the closed-loop stage cost and of U * (Am + Bm * Km). The risk sensitive variant is not supported.
+   *
+   * @param [in] projectedModelData: The projected model data.
+   * @param [in] riccatiModification: The RiccatiModification.
+   * @param [in] SmNextFactor: The upper-triangular factor of the Riccati matrix of the next time step.
+   * @param [in] SvNext: The Riccati vector of the next time step.
+   * @param [in] sNext: The Riccati scalar of the next time step.
+   * @param [out] projectedKm: The projected feedback controller.
+   * @param [out] projectedLv: The projected feedforward controller.
+   * @param [out] SmFactor: The upper-triangular factor of the current Riccati matrix.
+   * @param [out] Sm: The current Riccati matrix.
+   * @param [out] Sv: The current Riccati vector.
+   * @param [out] s: The current Riccati scalar.
+   */
+  void computeMapSquareRoot(const ModelData& projectedModelData, const riccati_modification::Data& riccatiModification,
+                            const matrix_t& SmNextFactor, const vector_t& SvNext, const scalar_t& sNext, matrix_t& projectedKm,
+                            vector_t& projectedLv, matrix_t& SmFactor, matrix_t& Sm, vector_t& Sv, scalar_t& s);
+
+  /**
+   * Computes an upper-triangular factor U such that Sm = U^T * U. If Sm is not positive definite, the factor of its positive
+   * semi-definite part is computed, i.e. the negative pivots of its LDLT decomposition are set to zero.
+   *
+   * @param [in] Sm: A symmetric matrix.
+   * @param [out] SmFactor: The upper-triangular factor.
+   */
+  static void computeSquareRootFactor(const matrix_t& Sm, matrix_t& SmFactor);
+
  private:
   /**
    * Computes one step Riccati difference equations for ILQR formulation.
@@ -74,6 +74,8 @@ class LevenbergMarquardtStrategy final : public SearchStrategyBase {
            const LinearController& unoptimizedController, const DualSolution& dualSolution, const ModeSchedule& modeSchedule,
            search_strategy::SolutionRef solution) override;
 
+  bool isLastStepFull() const override { return isLastStepFull_; }
+
   std::pair<bool, std::string> checkConvergence(bool unreliableControllerIncrement, const PerformanceIndex& previousPerformanceIndex,
                                                 const PerformanceIndex& currentPerformanceIndex) const override;
 
@@ -103,6 +105,7 @@ class LevenbergMarquardtStrategy final : public SearchStrategyBase {
 
   const levenberg_marquardt::Settings settings_;
   LevenbergMarquardtModule lmModule_;
+  bool isLastStepFull_ = false;  // the last accepted step has the step length one and no Riccati multiple
 
   RolloutBase& rolloutRef_;
   OptimalControlProblem& optimalControlProblemRef_;
@@ -35,11 +35,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/Types.h>
 #include <ocs2_core/dynamics/SystemDynamicsBase.h>
+#include <ocs2_core/misc/Numerics.h>
 #include <ocs2_core/thread_support/ThreadPool.h>
 
 #include <ocs2_oc/oc_problem/OptimalControlProblem.h>
 #include <ocs2_oc/rollout/RolloutBase.h>
 
+#include "ocs2_ddp/DDP_Data.h"
 #include "ocs2_ddp/search_strategy/SearchStrategyBase.h"
 #include "ocs2_ddp/search_strategy/StrategySettings.h"
 
@@ -72,10 +74,21 @@ class LineSearchStrategy final : public SearchStrategyBase {
 
   void reset() override {}
 
+  /**
+   * Sets the shooting nodes of the multiple-shooting forward pass. If the shooting nodes are not empty, the trial rollouts are split into
+   * partitions which are rolled out in parallel, while the step lengths are tried sequentially. The defects of the partitions are
+   * reported as dynamicsViolationSSE of the performance index. The shooting nodes should outlive the calls to run().
+   *
+   * @param [in] shootingNodesPtr: A pointer to the shooting nodes, or nullptr for single shooting.
+   */
+  void setShootingNodes(const ShootingNodes* shootingNodesPtr) { shootingNodesPtr_ = shootingNodesPtr; }
+
   bool run(const std::pair<scalar_t, scalar_t>& timePeriod, const vector_t& initState, const scalar_t expectedCost,
            const LinearController& unoptimizedController, const DualSolution& dualSolution, const ModeSchedule& modeSchedule,
            search_strategy::SolutionRef solution) override;
 
+  bool isLastStepFull() const override { return numerics::almost_eq(bestStepSize_.load(), scalar_t(1.0)); }
+
   std::pair<bool, std::string> checkConvergence(bool unreliableControllerIncrement, const PerformanceIndex& previousPerformanceIndex,
                                                 const PerformanceIndex& currentPerformanceIndex) const override;
 
@@ -93,6 +106,9 @@ class LineSearchStrategy final : public SearchStrategyBase {
     const ModeSchedule* modeSchedulePtr;
   };
 
+  /** Whether the forward pass uses multiple shooting. */
+  bool isMultipleShooting() const { return shootingNodesPtr_ != nullptr && !shootingNodesPtr_->times.empty(); }
+
   /** number of line search iterations (the if statements order is important) */
   size_t maxNumOfSearches() const;
 
@@ -115,6 +131,8 @@ class LineSearchStrategy final : public SearchStrategyBase {
   std::vector<std::reference_wrapper<RolloutBase>> rolloutRefStock_;
   std::vector<std::reference_wrapper<OptimalControlProblem>> optimalControlProblemRefStock_;
   std::function<scalar_t(PerformanceIndex)> meritFunc_;
+  const ShootingNodes* shootingNodesPtr_ = nullptr;
+  vector_array_t shootingStates_;
 
   // input
   LineSearchInputRef lineSearchInputRef_;
@@ -29,12 +29,15 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <functional>
 #include <utility>
 #include <vector>
 
 #include <ocs2_core/Types.h>
 #include <ocs2_core/control/LinearController.h>
+#include <ocs2_core/misc/Tracer.h>
 #include <ocs2_core/model_data/Metrics.h>
 #include <ocs2_core/model_data/ModelData.h>
 #include <ocs2_core/reference/ModeSchedule.h>
@@ -73,6 +76,18 @@ class SearchStrategyBase {
    */
   virtual void reset() = 0;
 
+  /**
+   * Sets the wall-clock deadline of the search. Strategies that evaluate several candidates stop trying new ones once it has passed
+   * and keep the best candidate found so far.
+   */
+  void setDeadline(std::chrono::steady_clock::time_point deadline) { deadline_ = deadline; }
+
+  /** Sets the tracer which records the evaluated candidates, or null to disable the tracing. */
+  void setTracer(benchmark::Tracer* tracerPtr) { tracerPtr_ = tracerPtr; }
+
+  /** Gets the number of the candidate steps which are evaluated since the construction. */
+  size_t getNumTrials() const { return numTrials_.load(std::memory_order_relaxed); }
+
   /**
    * Finds the optimal trajectories, controller, and performance index based on the given controller and its increment.
    *
@@ -83,13 +98,19 @@ class SearchStrategyBase {
    * @param [in] dualSolution: The dual solution.
    * @param [in] ModeSchedule The current mode schedule.
    * @param [in/out]
-   * @param [out] solution: Output of search (primalSolution, performanceIndex, problemMetrics, avgTimeStep)
+   * @param [out] solution: Output of search (primalSolution, dualSolution, performanceIndex, avgTimeStep)
    * @return whether the search was successful or failed.
    */
   virtual bool run(const std::pair<scalar_t, scalar_t>& timePeriod, const vector_t& initState, const scalar_t expectedCost,
                    const LinearController& unoptimizedController, const DualSolution& dualSolution, const ModeSchedule& modeSchedule,
                    search_strategy::SolutionRef solution) = 0;
 
+  /**
+   * Whether the last call of run() has taken the full step of the LQ solution, without any regularization by the strategy. Strategies
+   * which can not tell return false.
+   */
+  virtual bool isLastStepFull() const { return false; }
+
   /**
    * Checks convergence of the main loop of DDP.
    *
@@ -125,6 +146,9 @@ class SearchStrategyBase {
 
  protected:
   const search_strategy::Settings baseSettings_;
+  std::chrono::steady_clock::time_point deadline_ = std::chrono::steady_clock::time_point::max();
+  benchmark::Tracer* tracerPtr_ = nullptr;
+  std::atomic<size_t> numTrials_{0};  // incremented by the strategies for each evaluated candidate, possibly on several threads
 };
 
 }  // namespace ocs2
@@ -139,7 +163,6 @@ struct Solution {
   scalar_t avgTimeStep;
   DualSolution dualSolution;
   PrimalSolution primalSolution;
-  ProblemMetrics problemMetrics;
   PerformanceIndex performanceIndex;
 };
 
@@ -148,21 +171,17 @@ struct SolutionRef {
       : avgTimeStep(s.avgTimeStep),
         dualSolution(s.dualSolution),
         primalSolution(s.primalSolution),
-        problemMetrics(s.problemMetrics),
         performanceIndex(s.performanceIndex) {}
 
-  SolutionRef(scalar_t& avgTimeStepArg, DualSolution& dualSolutionArg, PrimalSolution& primalSolutionArg, ProblemMetrics& problemMetricsArg,
-              PerformanceIndex& performanceIndexArg)
+  SolutionRef(scalar_t& avgTimeStepArg, DualSolution& dualSolutionArg, PrimalSolution& primalSolutionArg, PerformanceIndex& performanceIndexArg)
       : avgTimeStep(avgTimeStepArg),
         dualSolution(dualSolutionArg),
         primalSolution(primalSolutionArg),
-        problemMetrics(problemMetricsArg),
         performanceIndex(performanceIndexArg) {}
 
   scalar_t& avgTimeStep;
   DualSolution& dualSolution;
   PrimalSolution& primalSolution;
-  ProblemMetrics& problemMetrics;
   PerformanceIndex& performanceIndex;
 };
 
@@ -170,7 +189,6 @@ inline void swap(SolutionRef lhs, SolutionRef rhs) {
   std::swap(lhs.avgTimeStep, rhs.avgTimeStep);
   lhs.dualSolution.swap(rhs.dualSolution);
   lhs.primalSolution.swap(rhs.primalSolution);
-  lhs.problemMetrics.swap(rhs.problemMetrics);
   ocs2::swap(lhs.performanceIndex, rhs.performanceIndex);
 }
 
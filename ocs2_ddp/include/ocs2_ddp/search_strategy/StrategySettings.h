@@ -94,7 +94,7 @@ struct Settings {
   /** Armijo coefficient, c defined as f(u + a*p) < f(u) + c*a dfdu.dot(p)  */
   scalar_t armijoCoefficient = 1e-4;
   /** The Hessian correction strategy. */
-  hessian_correction::Strategy hessianCorrectionStrategy = hessian_correction::Strategy::DIAGONAL_SHIFT;
+  hessian_correction::Strategy hessianCorrectionStrategy = hessian_correction::Strategy::CHOLESKY_SHIFT;
   /** The multiple used for correcting the Hessian for numerical stability of the Riccati backward pass.*/
   scalar_t hessianCorrectionMultiple = numeric_traits::limitEpsilon<scalar_t>();
 };  // end of Settings
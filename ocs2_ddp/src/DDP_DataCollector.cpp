@@ -27,198 +27,34 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
-#include <ocs2_ddp/DDP_DataCollector.h>
+#include "ocs2_ddp/DDP_DataCollector.h"
 
-namespace ocs2 {
-
-/******************************************************************************************************/
-/******************************************************************************************************/
-/******************************************************************************************************/
-DDP_DataCollector::DDP_DataCollector(const RolloutBase* rolloutPtr, const SystemDynamicsBase* systemDynamicsPtr,
-                                     const ConstraintBase* systemConstraintsPtr, const CostFunctionBase* costFunctionPtr)
-
-    : rolloutPtr_(rolloutPtr->clone()),
-      systemDynamicsPtr_(systemDynamicsPtr->clone()),
-      systemConstraintsPtr_(systemConstraintsPtr->clone()),
-      costFunctionPtr_(costFunctionPtr->clone()) {}
-
-/******************************************************************************************************/
-/******************************************************************************************************/
-/******************************************************************************************************/
-void DDP_DataCollector::collect(const GaussNewtonDDP* constDdpPtr) {
-  // TODO(mspieler): avoid const_cast
-  auto* ddpPtr = const_cast<GaussNewtonDDP*>(constDdpPtr);
-
-  /*
-   * Data which should be copied
-   */
-  // initial time and state plus final time
-  initTime_ = ddpPtr->initTime_;
-  finalTime_ = ddpPtr->finalTime_;
-  initState_ = ddpPtr->initState_;
-
-  // active partitions range: [initActivePartition_, finalActivePartition_]
-  initActivePartition_ = ddpPtr->initActivePartition_;
-  finalActivePartition_ = ddpPtr->finalActivePartition_;
-
-  // data resizing
-  bool numPartitionsChanged = numPartitions_ != ddpPtr->numPartitions_;
-  if (numPartitionsChanged) {
-    resizeDataContainer(ddpPtr->numPartitions_);
-  }
-
-  numPartitions_ = ddpPtr->numPartitions_;
-  partitioningTimes_ = ddpPtr->partitioningTimes_;
-
-  rewindCounter_ = ddpPtr->rewindCounter_;
-
-  modeSchedule_ = ddpPtr->getReferenceManager().getModeSchedule();
-
-  // optimized controller
-  optimizedControllersStock_ = ddpPtr->nominalControllersStock_;
-
-  // nominal trajectories (LQ approximation is around the cached trajectories)
-  nominalPostEventIndicesStock_ = ddpPtr->cachedPostEventIndicesStock_;
-  nominalTimeTrajectoriesStock_ = ddpPtr->cachedTimeTrajectoriesStock_;
-  nominalStateTrajectoriesStock_ = ddpPtr->cachedStateTrajectoriesStock_;
-  nominalInputTrajectoriesStock_ = ddpPtr->cachedInputTrajectoriesStock_;
-
-  /*
-   * Data which can be swapped. Note that these variables should have correct size.
-   * Otherwise use setOptimizer() to construct them with correct size
-   */
-  // model data trajectory
-  modelDataTrajectoriesStock_.swap(ddpPtr->cachedModelDataTrajectoriesStock_);
-
-  // event times model data
-  modelDataEventTimesStock_.swap(ddpPtr->cachedModelDataEventTimesStock_);
-
-  // projected model data trajectory
-  projectedModelDataTrajectoriesStock_.swap(ddpPtr->cachedProjectedModelDataTrajectoriesStock_);
+#include <algorithm>
 
-  // Riccati modification
-  riccatiModificationTrajectoriesStock_.swap(ddpPtr->cachedRiccatiModificationTrajectoriesStock_);
+#include <ocs2_core/control/LinearController.h>
 
-  // final cost which is interpreted as the Heuristic function
-  std::swap(heuristics_, ddpPtr->heuristics_);
-
-  // Riccati coefficients
-  SsTimeTrajectoriesStock_.swap(ddpPtr->SsTimeTrajectoryStock_);
-  SsNormalizedTimeTrajectoriesStock_.swap(ddpPtr->SsNormalizedTimeTrajectoryStock_);
-  SsNormalizedEventsPastTheEndIndecesStock_.swap(ddpPtr->SsNormalizedEventsPastTheEndIndecesStock_);
-  SmTrajectoriesStock_.swap(ddpPtr->SmTrajectoryStock_);
-  SvTrajectoriesStock_.swap(ddpPtr->SvTrajectoryStock_);
-  sTrajectoriesStock_.swap(ddpPtr->sTrajectoryStock_);
-
-  // state-input constraints derivatives w.r.t. to the event times
-  calculateStateInputConstraintsSensitivity(constDdpPtr, nominalTimeTrajectoriesStock_, nominalStateTrajectoriesStock_,
-                                            nominalInputTrajectoriesStock_, EvDevEventTimesTrajectoryStockSet_,
-                                            EvDevEventTimesProjectedTrajectoryStockSet_);
-}
-
-/******************************************************************************************************/
-/******************************************************************************************************/
-/******************************************************************************************************/
-void DDP_DataCollector::calculateStateInputConstraintsSensitivity(const GaussNewtonDDP* constDdpPtr,
-                                                                  const std::vector<scalar_array_t>& timeTrajectoriesStock,
-                                                                  const vector_array2_t& stateTrajectoriesStock,
-                                                                  const vector_array2_t& inputTrajectoriesStock,
-                                                                  vector_array3_t& EvDevEventTimesTrajectoriesStockSet,
-                                                                  vector_array3_t& EvDevEventTimesProjectedTrajectoriesStockSet) {
-  auto* ddpPtr = const_cast<GaussNewtonDDP*>(constDdpPtr);
-
-  const size_t numEventTimes = constDdpPtr->getReferenceManager().getModeSchedule().eventTimes.size();
-
-  // resizing EvDev container
-  EvDevEventTimesTrajectoriesStockSet.resize(numEventTimes);
-  for (auto& EvDevEventTimesTrajectoryStock : EvDevEventTimesTrajectoriesStockSet) {
-    EvDevEventTimesTrajectoryStock.resize(constDdpPtr->numPartitions_);
-    for (size_t i = 0; i < constDdpPtr->numPartitions_; i++) {
-      EvDevEventTimesTrajectoryStock[i].resize(timeTrajectoriesStock[i].size());
-    }  // end of i loop
-  }
-  // resizing EvDevProjected container
-  EvDevEventTimesProjectedTrajectoriesStockSet.resize(numEventTimes);
-  for (auto& EvDevEventTimesProjectedTrajectoriesStock : EvDevEventTimesProjectedTrajectoriesStockSet) {
-    EvDevEventTimesProjectedTrajectoriesStock.resize(constDdpPtr->numPartitions_);
-    for (size_t i = 0; i < constDdpPtr->numPartitions_; i++) {
-      EvDevEventTimesProjectedTrajectoriesStock[i].resize(timeTrajectoriesStock[i].size());
-    }  // end of i loop
-  }
-
-  for (size_t i = 0; i < constDdpPtr->numPartitions_; i++) {
-    for (size_t k = 0; k < timeTrajectoriesStock[i].size(); k++) {
-      // evaluation
-      vector_array_t g1DevArray = systemConstraintsPtr_->stateInputEqualityConstraintDerivativesEventTimes(
-          timeTrajectoriesStock[i][k], stateTrajectoriesStock[i][k], inputTrajectoriesStock[i][k]);
-
-      // if derivatives where available
-      if (!g1DevArray.empty()) {
-        if (g1DevArray.size() != numEventTimes) {
-          throw std::runtime_error("Incorrect array dimension for constraint1 derivatives w.r.t. event times.");
-        }
-
-        for (size_t j = 0; j < numEventTimes; j++) {
-          EvDevEventTimesTrajectoriesStockSet[j][i][k] = g1DevArray[j];
-          EvDevEventTimesProjectedTrajectoriesStockSet[j][i][k] =
-              riccatiModificationTrajectoriesStock_[i][k].constraintRangeProjector_ * EvDevEventTimesTrajectoriesStockSet[j][i][k];
-        }  // end of j loop
-
-      } else {
-        for (size_t j = 0; j < numEventTimes; j++) {
-          // TODO(mspieler): get nc1 from somewhere. But is it actually used when no derivatives available?
-          size_t nc1 = 0;
-          EvDevEventTimesTrajectoriesStockSet[j][i][k].setZero(nc1);
-          EvDevEventTimesProjectedTrajectoriesStockSet[j][i][k].setZero();
-        }  // end of j loop
-      }
-    }  // end of k loop
-  }    // end of i loop
-}
+namespace ocs2 {
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-void DDP_DataCollector::resizeDataContainer(size_t numPartitions) {
-  if (numPartitions == 0) {
-    throw std::runtime_error("The number of Partitions cannot be zero!");
+std::shared_ptr<const DDP_DataCollector::Snapshot> DDP_DataCollector::collect(GaussNewtonDDP& ddp) {
+  // a snapshot which is only referenced by the pool can be recycled
+  auto snapshotItr = std::find_if(snapshotPool_.begin(), snapshotPool_.end(),
+                                  [](const std::shared_ptr<Snapshot>& snapshotPtr) { return snapshotPtr.use_count() == 1; });
+  if (snapshotItr == snapshotPool_.end()) {
+    snapshotPool_.emplace_back(new Snapshot);
+    snapshotPool_.back()->primalData.primalSolution.controllerPtr_.reset(new LinearController);
+    snapshotItr = std::prev(snapshotPool_.end());
   }
 
-  /*
-   * Data which should be copied
-   */
-  // optimized controller
-  optimizedControllersStock_.resize(numPartitions);
-
-  // nominal trajectories
-  nominalTimeTrajectoriesStock_.resize(numPartitions);
-  nominalPostEventIndicesStock_.resize(numPartitions);
-  nominalStateTrajectoriesStock_.resize(numPartitions);
-  nominalInputTrajectoriesStock_.resize(numPartitions);
-
-  /*
-   * Data which can be swapped. Note that these variables should have correct size.
-   * Otherwise use setOptimizer() to construct them with correct size
-   */
-  // model data trajectory
-  modelDataTrajectoriesStock_.resize(numPartitions);
-
-  // event times model data
-  modelDataEventTimesStock_.resize(numPartitions);
-
-  // projected model data trajectory
-  projectedModelDataTrajectoriesStock_.resize(numPartitions);
-
-  // Riccati modification
-  riccatiModificationTrajectoriesStock_.resize(numPartitions);
+  // the recycled containers keep their memory, but not their data since the solver would take them as its cache
+  auto& snapshot = **snapshotItr;
+  snapshot.primalData.clear();
+  snapshot.dualData.clear();
+  ddp.swapLqApproximationData(snapshot.primalData, snapshot.dualData);
 
-  // Riccati coefficients
-  SsTimeTrajectoriesStock_.resize(numPartitions);
-  SsNormalizedTimeTrajectoriesStock_.resize(numPartitions);
-  SsNormalizedEventsPastTheEndIndecesStock_.resize(numPartitions);
-  SmTrajectoriesStock_.resize(numPartitions);
-  SvTrajectoriesStock_.resize(numPartitions);
-  sTrajectoriesStock_.resize(numPartitions);
+  return *snapshotItr;
 }
 
 }  // namespace ocs2
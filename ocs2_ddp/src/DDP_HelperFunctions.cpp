@@ -30,7 +30,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ocs2_ddp/DDP_HelperFunctions.h"
 
 #include <algorithm>
+#include <atomic>
+#include <exception>
 #include <iostream>
+#include <iterator>
 
 #include <ocs2_core/PreComputation.h>
 #include <ocs2_core/integration/TrapezoidalIntegration.h>
@@ -167,6 +170,79 @@ PerformanceIndex computeRolloutPerformanceIndex(const scalar_array_t& timeTrajec
   return performanceIndex;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+PerformanceIndex computeRolloutPerformanceIndex(OptimalControlProblem& problem, const PrimalSolution& primalSolution,
+                                                DualSolutionConstRef dualSolution) {
+  const auto& tTrajectory = primalSolution.timeTrajectory_;
+  const auto& xTrajectory = primalSolution.stateTrajectory_;
+  const auto& uTrajectory = primalSolution.inputTrajectory_;
+  const auto& postEventIndices = primalSolution.postEventIndices_;
+  auto& preComputation = *problem.preComputationPtr;
+
+  PerformanceIndex performanceIndex;
+  if (tTrajectory.empty()) {
+    return performanceIndex;
+  }
+
+  // the intermediate values are integrated over time, while the event and final values are summed up
+  scalar_array_t costTrajectory(tTrajectory.size());
+  scalar_array_t equalityNorm2Trajectory(tTrajectory.size());
+  scalar_array_t equalityPenaltyTrajectory(tTrajectory.size());
+  scalar_array_t inequalityPenaltyTrajectory(tTrajectory.size());
+
+  auto nextPostEventIndexItr = postEventIndices.begin();
+  const auto request = Request::Cost + Request::Constraint + Request::SoftConstraint;
+  for (size_t k = 0; k < tTrajectory.size(); k++) {
+    const auto& t = tTrajectory[k];
+    const auto& x = xTrajectory[k];
+    const auto& u = uTrajectory[k];
+    const auto& multipliers = dualSolution.intermediates[k];
+
+    // intermediate time cost and constraints
+    preComputation.request(request, t, x, u);
+    costTrajectory[k] = computeCost(problem, t, x, u);
+    equalityNorm2Trajectory[k] = problem.stateEqualityConstraintPtr->getValue(t, x, preComputation).squaredNorm() +
+                                 problem.equalityConstraintPtr->getValue(t, x, u, preComputation).squaredNorm();
+    equalityPenaltyTrajectory[k] = sumPenalties(problem.stateEqualityLagrangianPtr->getValue(t, x, multipliers.stateEq, preComputation)) +
+                                   sumPenalties(problem.equalityLagrangianPtr->getValue(t, x, u, multipliers.stateInputEq, preComputation));
+    inequalityPenaltyTrajectory[k] =
+        sumPenalties(problem.stateInequalityLagrangianPtr->getValue(t, x, multipliers.stateIneq, preComputation)) +
+        sumPenalties(problem.inequalityLagrangianPtr->getValue(t, x, u, multipliers.stateInputIneq, preComputation));
+
+    // event time cost and constraints
+    if (nextPostEventIndexItr != postEventIndices.end() && k + 1 == *nextPostEventIndexItr) {
+      const auto& m = dualSolution.preJumps[std::distance(postEventIndices.begin(), nextPostEventIndexItr)];
+      preComputation.requestPreJump(request, t, x);
+      performanceIndex.cost += computeEventCost(problem, t, x);
+      performanceIndex.equalityConstraintsSSE += problem.preJumpEqualityConstraintPtr->getValue(t, x, preComputation).squaredNorm();
+      performanceIndex.equalityLagrangian += sumPenalties(problem.preJumpEqualityLagrangianPtr->getValue(t, x, m.stateEq, preComputation));
+      performanceIndex.inequalityLagrangian +=
+          sumPenalties(problem.preJumpInequalityLagrangianPtr->getValue(t, x, m.stateIneq, preComputation));
+      nextPostEventIndexItr++;
+    }
+  }
+
+  // final time cost and constraints
+  const auto& tf = tTrajectory.back();
+  const auto& xf = xTrajectory.back();
+  const auto& mf = dualSolution.final;
+  preComputation.requestFinal(request, tf, xf);
+  performanceIndex.cost += computeFinalCost(problem, tf, xf);
+  performanceIndex.equalityConstraintsSSE += problem.finalEqualityConstraintPtr->getValue(tf, xf, preComputation).squaredNorm();
+  performanceIndex.equalityLagrangian += sumPenalties(problem.finalEqualityLagrangianPtr->getValue(tf, xf, mf.stateEq, preComputation));
+  performanceIndex.inequalityLagrangian +=
+      sumPenalties(problem.finalInequalityLagrangianPtr->getValue(tf, xf, mf.stateIneq, preComputation));
+
+  performanceIndex.cost += trapezoidalIntegration(tTrajectory, costTrajectory);
+  performanceIndex.equalityConstraintsSSE += trapezoidalIntegration(tTrajectory, equalityNorm2Trajectory);
+  performanceIndex.equalityLagrangian += trapezoidalIntegration(tTrajectory, equalityPenaltyTrajectory);
+  performanceIndex.inequalityLagrangian += trapezoidalIntegration(tTrajectory, inequalityPenaltyTrajectory);
+
+  return performanceIndex;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -198,6 +274,19 @@ void projectLQ(const ModelData& modelData, const matrix_t& constraintRangeProjec
   // unhandled constraints
   projectedModelData.stateEqConstraint.f = vector_t();
 
+  // The change of input variables is written directly to the projected data. It reduces to picking the selected inputs if Pu is a
+  // selection, e.g. the identity.
+  auto projectModelData = [&](const matrix_t& Pu, const matrix_t& Px, const vector_t& u0) {
+    std::vector<int> selectedInputs;
+    if (isInputSelection(Pu, selectedInputs)) {
+      changeOfInputVariables(modelData.dynamics, selectedInputs, Px, u0, projectedModelData.dynamics);
+      changeOfInputVariables(modelData.cost, selectedInputs, Px, u0, projectedModelData.cost);
+    } else {
+      changeOfInputVariables(modelData.dynamics, Pu, Px, u0, projectedModelData.dynamics);
+      changeOfInputVariables(modelData.cost, Pu, Px, u0, projectedModelData.cost);
+    }
+  };
+
   if (modelData.stateInputEqConstraint.f.rows() == 0) {
     // Change of variables u = Pu * tilde{u}
     // Pu = constraintNullProjector;
@@ -207,17 +296,12 @@ void projectLQ(const ModelData& modelData, const matrix_t& constraintRangeProjec
     projectedModelData.stateInputEqConstraint.dfdx.setZero(projectedModelData.inputDim, projectedModelData.stateDim);
     projectedModelData.stateInputEqConstraint.dfdu.setZero(modelData.inputDim, modelData.inputDim);
 
-    // dynamics
-    projectedModelData.dynamics = modelData.dynamics;
-    changeOfInputVariables(projectedModelData.dynamics, constraintNullProjector);
+    // dynamics and cost
+    projectModelData(constraintNullProjector, matrix_t(), vector_t());
 
     // dynamics bias
     projectedModelData.dynamicsBias = modelData.dynamicsBias;
 
-    // cost
-    projectedModelData.cost = modelData.cost;
-    changeOfInputVariables(projectedModelData.cost, constraintNullProjector);
-
   } else {
     // Change of variables u = Pu * tilde{u} + Px * x + u0
     // Pu = constraintNullProjector;
@@ -232,19 +316,14 @@ void projectLQ(const ModelData& modelData, const matrix_t& constraintRangeProjec
     // Change of variable matrices
     const auto& Pu = constraintNullProjector;
     const matrix_t Px = -projectedModelData.stateInputEqConstraint.dfdx;
-    const matrix_t u0 = -projectedModelData.stateInputEqConstraint.f;
+    const vector_t u0 = -projectedModelData.stateInputEqConstraint.f;
 
-    // dynamics
-    projectedModelData.dynamics = modelData.dynamics;
-    changeOfInputVariables(projectedModelData.dynamics, Pu, Px, u0);
+    // dynamics and cost
+    projectModelData(Pu, Px, u0);
 
     // dynamics bias
     projectedModelData.dynamicsBias = modelData.dynamicsBias;
     projectedModelData.dynamicsBias.noalias() += modelData.dynamics.dfdu * u0;
-
-    // cost
-    projectedModelData.cost = modelData.cost;
-    changeOfInputVariables(projectedModelData.cost, Pu, Px, u0);
   }
 }
 
@@ -375,6 +454,110 @@ void retrieveActiveNormalizedTime(const std::pair<int, int>& partitionInterval,
                  [N, &partitionInterval](size_t i) -> size_t { return N - i + partitionInterval.first; });
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_array_t computeShootingTimes(scalar_t initTime, scalar_t finalTime, size_t numPartitions, const scalar_array_t& eventTimes) {
+  const scalar_t partitionLength = (finalTime - initTime) / static_cast<scalar_t>(std::max(numPartitions, size_t(1)));
+  const scalar_t minEventDistance = 0.01 * partitionLength;
+
+  scalar_array_t shootingTimes;
+  shootingTimes.reserve(numPartitions);
+  for (size_t p = 1; p < numPartitions; p++) {
+    const scalar_t shootingTime = initTime + static_cast<scalar_t>(p) * partitionLength;
+    const bool isCloseToEvent = std::any_of(eventTimes.begin(), eventTimes.end(),
+                                            [&](scalar_t eventTime) { return std::abs(eventTime - shootingTime) < minEventDistance; });
+    if (!isCloseToEvent) {
+      shootingTimes.push_back(shootingTime);
+    }
+  }
+
+  return shootingTimes;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::pair<scalar_t, scalar_t> rolloutMultipleShootingTrajectory(ThreadPool& threadPool,
+                                                                const std::vector<std::reference_wrapper<RolloutBase>>& rollouts,
+                                                                scalar_t initTime, const vector_t& initState, scalar_t finalTime,
+                                                                const scalar_array_t& shootingTimes, const vector_array_t& shootingStates,
+                                                                PrimalSolution& primalSolution) {
+  const size_t numPartitions = shootingTimes.size() + 1;
+  if (rollouts.size() < numPartitions || shootingStates.size() != shootingTimes.size()) {
+    throw std::runtime_error(
+        "[rolloutMultipleShootingTrajectory] There should be one rollout per partition and one state per shooting time!");
+  }
+
+  struct PartitionTrajectory {
+    std::unique_ptr<ControllerBase> controllerPtr;  // the controllers keep a lookup cursor, hence each partition uses its own copy
+    scalar_array_t timeTrajectory;
+    size_array_t postEventIndices;
+    vector_array_t stateTrajectory;
+    vector_array_t inputTrajectory;
+    vector_t finalState;
+    std::exception_ptr error;
+  };
+  std::vector<PartitionTrajectory> partitions(numPartitions);
+
+  std::atomic_size_t nextPartition{0};
+  auto task = [&](int) {
+    const size_t p = nextPartition++;
+    auto& partition = partitions[p];
+    const scalar_t partitionInitTime = (p == 0) ? initTime : shootingTimes[p - 1];
+    const scalar_t partitionFinalTime = (p + 1 < numPartitions) ? shootingTimes[p] : finalTime;
+    const vector_t& partitionInitState = (p == 0) ? initState : shootingStates[p - 1];
+    try {
+      partition.controllerPtr.reset(primalSolution.controllerPtr_->clone());
+      partition.finalState = rollouts[p].get().run(partitionInitTime, partitionInitState, partitionFinalTime, partition.controllerPtr.get(),
+                                                   primalSolution.modeSchedule_, partition.timeTrajectory, partition.postEventIndices,
+                                                   partition.stateTrajectory, partition.inputTrajectory);
+    } catch (...) {
+      partition.error = std::current_exception();
+    }
+  };
+  threadPool.runParallel(task, numPartitions);
+
+  // concatenate the partitions
+  primalSolution.timeTrajectory_.clear();
+  primalSolution.postEventIndices_.clear();
+  primalSolution.stateTrajectory_.clear();
+  primalSolution.inputTrajectory_.clear();
+  scalar_t defectsSSE = 0.0;
+  for (size_t p = 0; p < numPartitions; p++) {
+    auto& partition = partitions[p];
+    if (partition.error != nullptr) {
+      std::rethrow_exception(partition.error);
+    }
+    if (!partition.finalState.allFinite()) {
+      throw std::runtime_error("[rolloutMultipleShootingTrajectory] System became unstable during the rollout!");
+    }
+
+    const bool isLastPartition = (p + 1 == numPartitions);
+    const size_t numNodes = isLastPartition ? partition.timeTrajectory.size() : partition.timeTrajectory.size() - 1;
+    const size_t offset = primalSolution.timeTrajectory_.size();
+    for (const auto index : partition.postEventIndices) {
+      if (index < numNodes) {
+        primalSolution.postEventIndices_.push_back(offset + index);
+      }
+    }
+    primalSolution.timeTrajectory_.insert(primalSolution.timeTrajectory_.end(), partition.timeTrajectory.begin(),
+                                          partition.timeTrajectory.begin() + numNodes);
+    std::move(partition.stateTrajectory.begin(), partition.stateTrajectory.begin() + numNodes,
+              std::back_inserter(primalSolution.stateTrajectory_));
+    std::move(partition.inputTrajectory.begin(), partition.inputTrajectory.begin() + numNodes,
+              std::back_inserter(primalSolution.inputTrajectory_));
+
+    if (!isLastPartition) {
+      defectsSSE += (partition.finalState - shootingStates[p]).squaredNorm();
+    }
+  }
+
+  // average time step
+  const scalar_t avgTimeStep = (finalTime - initTime) / static_cast<scalar_t>(primalSolution.timeTrajectory_.size());
+  return {avgTimeStep, defectsSSE};
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -404,4 +587,66 @@ std::vector<std::pair<int, int>> computePartitionIntervals(const scalar_array_t&
   return partitionIntervals;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void shiftModelDataExpansionPoint(const vector_t& deltaState, const vector_t& deltaInput, ModelData& modelData) {
+  // cost, the value is updated first since it uses the gradients of the old expansion point
+  auto& cost = modelData.cost;
+  cost.f += cost.dfdx.dot(deltaState) + cost.dfdu.dot(deltaInput) + 0.5 * deltaState.dot(cost.dfdxx * deltaState) +
+            deltaInput.dot(cost.dfdux * deltaState) + 0.5 * deltaInput.dot(cost.dfduu * deltaInput);
+  cost.dfdx.noalias() += cost.dfdxx * deltaState;
+  cost.dfdx.noalias() += cost.dfdux.transpose() * deltaInput;
+  cost.dfdu.noalias() += cost.dfdux * deltaState;
+  cost.dfdu.noalias() += cost.dfduu * deltaInput;
+
+  // constraints
+  if (modelData.stateEqConstraint.f.size() > 0) {
+    modelData.stateEqConstraint.f.noalias() += modelData.stateEqConstraint.dfdx * deltaState;
+  }
+  if (modelData.stateInputEqConstraint.f.size() > 0) {
+    modelData.stateInputEqConstraint.f.noalias() += modelData.stateInputEqConstraint.dfdx * deltaState;
+    modelData.stateInputEqConstraint.f.noalias() += modelData.stateInputEqConstraint.dfdu * deltaInput;
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TrajectorySpreading::Status trajectorySpread(const ModeSchedule& oldModeSchedule, const ModeSchedule& newModeSchedule,
+                                             PrimalDataContainer& primalData) {
+  auto& primalSolution = primalData.primalSolution;
+
+  // trajectory spreading
+  constexpr bool debugPrint = false;
+  TrajectorySpreading trajectorySpreading(debugPrint);
+  const auto status = trajectorySpreading.set(oldModeSchedule, newModeSchedule, primalSolution.timeTrajectory_);
+
+  // primal solution
+  primalSolution.modeSchedule_ = newModeSchedule;
+  trajectorySpreading.adjustTrajectory(primalSolution.stateTrajectory_);
+  trajectorySpreading.adjustTrajectory(primalSolution.inputTrajectory_);
+  trajectorySpreading.adjustTimeTrajectory(primalSolution.timeTrajectory_);
+  primalSolution.postEventIndices_ = trajectorySpreading.getPostEventIndices();
+
+  // metrics, which are only computed on demand
+  auto& problemMetrics = primalData.problemMetrics;
+  if (status.willTruncate) {
+    problemMetrics.final.clear();
+  }
+  if (!problemMetrics.intermediates.empty()) {
+    trajectorySpreading.adjustEventsArray(problemMetrics.preJumps);
+    trajectorySpreading.adjustTrajectory(problemMetrics.intermediates);
+  }
+
+  // model data
+  if (status.willTruncate) {
+    primalData.modelDataFinalTime = ModelData();
+  }
+  trajectorySpreading.adjustEventsArray(primalData.modelDataEventTimes);
+  trajectorySpreading.adjustTrajectory(primalData.modelDataTrajectory);
+
+  return status;
+}
+
 }  // namespace ocs2
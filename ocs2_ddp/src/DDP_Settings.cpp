@@ -53,8 +53,8 @@ Algorithm fromAlgorithmName(std::string name) {
 }
 
 Settings loadSettings(const std::string& filename, const std::string& fieldName, bool verbose) {
-  boost::property_tree::ptree pt;
-  boost::property_tree::read_info(filename, pt);
+  const auto ptPtr = loadData::readInfoFile(filename);
+  const boost::property_tree::ptree& pt = *ptPtr;
 
   Settings settings;
 
@@ -69,6 +69,8 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
 
   loadData::loadPtreeValue(pt, settings.nThreads_, fieldName + ".nThreads", verbose);
   loadData::loadPtreeValue(pt, settings.threadPriority_, fieldName + ".threadPriority", verbose);
+  loadData::loadPtreeValue(pt, settings.threadSpinDuration_, fieldName + ".threadSpinDuration", verbose);
+  loadData::loadStdVector(filename, fieldName + ".threadAffinity", settings.threadAffinity_, verbose);
 
   loadData::loadPtreeValue(pt, settings.maxNumIterations_, fieldName + ".maxNumIterations", verbose);
   loadData::loadPtreeValue(pt, settings.minRelCost_, fieldName + ".minRelCost", verbose);
@@ -77,6 +79,9 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
   loadData::loadPtreeValue(pt, settings.displayInfo_, fieldName + ".displayInfo", verbose);
   loadData::loadPtreeValue(pt, settings.displayShortSummary_, fieldName + ".displayShortSummary", verbose);
   loadData::loadPtreeValue(pt, settings.checkNumericalStability_, fieldName + ".checkNumericalStability", verbose);
+  loadData::loadPtreeValue(pt, settings.numericalStabilityCheckRatio_, fieldName + ".numericalStabilityCheckRatio", verbose);
+  loadData::loadPtreeValue(pt, settings.asynchronousNumericalStabilityCheck_, fieldName + ".asynchronousNumericalStabilityCheck",
+                           verbose);
   loadData::loadPtreeValue(pt, settings.debugPrintRollout_, fieldName + ".debugPrintRollout", verbose);
 
   loadData::loadPtreeValue(pt, settings.absTolODE_, fieldName + ".AbsTolODE", verbose);
@@ -86,10 +91,17 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
   auto integratorName = integrator_type::toString(settings.backwardPassIntegratorType_);  // keep default
   loadData::loadPtreeValue(pt, integratorName, fieldName + ".backwardPassIntegratorType", verbose);
   settings.backwardPassIntegratorType_ = integrator_type::fromString(integratorName);
+  loadData::loadPtreeValue(pt, settings.discreteRiccatiBackwardPass_, fieldName + ".discreteRiccatiBackwardPass", verbose);
+  loadData::loadPtreeValue(pt, settings.squareRootRiccati_, fieldName + ".squareRootRiccati", verbose);
+  loadData::loadPtreeValue(pt, settings.multipleShootingForwardPass_, fieldName + ".multipleShootingForwardPass", verbose);
 
   loadData::loadPtreeValue(pt, settings.constraintPenaltyInitialValue_, fieldName + ".constraintPenaltyInitialValue", verbose);
   loadData::loadPtreeValue(pt, settings.constraintPenaltyIncreaseRate_, fieldName + ".constraintPenaltyIncreaseRate", verbose);
 
+  loadData::loadPtreeValue(pt, settings.lqReuseTolerance_, fieldName + ".lqReuseTolerance", verbose);
+
+  loadData::loadPtreeValue(pt, settings.cacheTermActivity_, fieldName + ".cacheTermActivity", verbose);
+
   loadData::loadPtreeValue(pt, settings.preComputeRiccatiTerms_, fieldName + ".preComputeRiccatiTerms", verbose);
 
   loadData::loadPtreeValue(pt, settings.useFeedbackPolicy_, fieldName + ".useFeedbackPolicy", verbose);
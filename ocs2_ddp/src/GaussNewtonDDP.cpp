@@ -30,11 +30,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ocs2_ddp/GaussNewtonDDP.h"
 
 #include <algorithm>
+#include <iomanip>
 #include <numeric>
 
 #include <ocs2_core/control/FeedforwardController.h>
 #include <ocs2_core/integration/TrapezoidalIntegration.h>
 #include <ocs2_core/misc/LinearAlgebra.h>
+#include <ocs2_core/misc/LinearInterpolation.h>
 
 #include <ocs2_oc/oc_problem/OptimalControlProblemHelperFunction.h>
 #include <ocs2_oc/rollout/InitializerRollout.h>
@@ -52,8 +54,13 @@ namespace ocs2 {
 /******************************************************************************************************/
 /******************************************************************************************************/
 GaussNewtonDDP::GaussNewtonDDP(ddp::Settings ddpSettings, const RolloutBase& rollout, const OptimalControlProblem& optimalControlProblem,
-                               const Initializer& initializer)
-    : ddpSettings_(std::move(ddpSettings)), threadPool_(std::max(ddpSettings_.nThreads_, size_t(1)) - 1, ddpSettings_.threadPriority_) {
+                               const Initializer& initializer, std::shared_ptr<ThreadPool> threadPoolPtr)
+    : ddpSettings_(std::move(ddpSettings)),
+      threadPoolPtr_(threadPoolPtr != nullptr ? threadPoolPtr
+                                              : std::make_shared<ThreadPool>(std::max(ddpSettings_.nThreads_, size_t(1)) - 1,
+                                                                             ddpSettings_.threadPriority_,
+                                                                             std::chrono::microseconds(ddpSettings_.threadSpinDuration_),
+                                                                             ddpSettings_.threadAffinity_)) {
   Eigen::setNbThreads(1);  // no multithreading within Eigen.
   Eigen::initParallel();
 
@@ -73,17 +80,56 @@ GaussNewtonDDP::GaussNewtonDDP(ddp::Settings ddpSettings, const RolloutBase& rol
         "[GaussNewtonDDP] DDP does not support final equality constraints (a.k.a. finalEqualityConstraintPtr), instead use the Lagrangian "
         "method!");
   }
+  if (!optimalControlProblem.boxConstraintPtr->empty()) {
+    throw std::runtime_error(
+        "[GaussNewtonDDP] DDP does not support box constraints (a.k.a. boxConstraintPtr), instead use a soft box constraint "
+        "(StateInputSoftBoxConstraint)!");
+  }
+  if (!optimalControlProblem.inequalityConstraintPtr->empty()) {
+    throw std::runtime_error(
+        "[GaussNewtonDDP] DDP does not support hard inequality constraints (a.k.a. inequalityConstraintPtr), instead use the Lagrangian "
+        "method or a soft constraint!");
+  }
+  isLinearQuadratic_ = isLinearQuadratic(optimalControlProblem);
+  hasLagrangianTerms_ = hasLagrangianTerms(optimalControlProblem);
+
+  if (ddpSettings_.checkNumericalStability_) {
+    numericalStabilityCheckerPtr_.reset(new NumericalStabilityChecker(ddpSettings_.numericalStabilityCheckRatio_,
+                                                                      ddpSettings_.asynchronousNumericalStabilityCheck_));
+  }
 
   // initializer Rollout
   initializerRolloutPtr_.reset(new InitializerRollout(initializer, rollout.settings()));
 
-  // initialize rollout and OCP instances for multi-thread compuation
-  optimalControlProblemStock_.reserve(ddpSettings_.nThreads_);
-  dynamicsForwardRolloutPtrStock_.reserve(ddpSettings_.nThreads_);
-  for (size_t i = 0; i < ddpSettings_.nThreads_; i++) {
-    optimalControlProblemStock_.push_back(optimalControlProblem);
-    dynamicsForwardRolloutPtrStock_.emplace_back(rollout.clone());
-  }  // end of i loop
+  // initialize rollout and OCP instances for multi-thread compuation. With an own thread pool, each thread clones its own instances
+  // such that their memory is allocated close to the CPU it runs on. The clones are created one after another since the source objects
+  // are shared.
+  optimalControlProblemStock_.resize(ddpSettings_.nThreads_);
+  dynamicsForwardRolloutPtrStock_.resize(ddpSettings_.nThreads_);
+  std::mutex cloneMutex;
+  auto cloneTask = [&](int workerIndex) {
+    std::lock_guard<std::mutex> lock(cloneMutex);
+    optimalControlProblemStock_[workerIndex] = optimalControlProblem;
+    dynamicsForwardRolloutPtrStock_[workerIndex].reset(rollout.clone());
+  };
+  if (threadPoolPtr == nullptr) {
+    threadPoolPtr_->runOnEachThread(cloneTask);
+  } else {
+    for (size_t i = 0; i < ddpSettings_.nThreads_; i++) {
+      cloneTask(i);
+    }
+  }
+
+  // multiple-shooting forward pass
+  if (ddpSettings_.multipleShootingForwardPass_) {
+    if (ddpSettings_.algorithm_ != ddp::Algorithm::ILQR || ddpSettings_.strategy_ != search_strategy::Type::LINE_SEARCH) {
+      throw std::runtime_error(
+          "[GaussNewtonDDP] The multiple-shooting forward pass is only supported by ILQR with the line-search strategy!");
+    }
+    if (ddpSettings_.lqReuseTolerance_ > 0.0) {
+      throw std::runtime_error("[GaussNewtonDDP] The multiple-shooting forward pass does not support the reuse of the LQ approximation!");
+    }
+  }
 
   // search strategy method
   const auto basicStrategySettings = [&]() {
@@ -103,8 +149,11 @@ GaussNewtonDDP::GaussNewtonDDP(ddp::Settings ddpSettings, const RolloutBase& rol
         rolloutRefStock.emplace_back(*dynamicsForwardRolloutPtrStock_[i]);
         problemRefStock.emplace_back(optimalControlProblemStock_[i]);
       }  // end of i loop
-      searchStrategyPtr_.reset(new LineSearchStrategy(basicStrategySettings, ddpSettings_.lineSearch_, threadPool_,
-                                                      std::move(rolloutRefStock), std::move(problemRefStock), meritFunc));
+      std::unique_ptr<LineSearchStrategy> lineSearchStrategyPtr(new LineSearchStrategy(basicStrategySettings, ddpSettings_.lineSearch_,
+                                                                                       *threadPoolPtr_, std::move(rolloutRefStock),
+                                                                                       std::move(problemRefStock), meritFunc));
+      lineSearchStrategyPtr->setShootingNodes(&shootingNodes_);
+      searchStrategyPtr_ = std::move(lineSearchStrategyPtr);
       break;
     }
     case search_strategy::Type::LEVENBERG_MARQUARDT: {
@@ -134,34 +183,50 @@ GaussNewtonDDP::~GaussNewtonDDP() {
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-std::string GaussNewtonDDP::getBenchmarkingInfo() const {
-  const auto initializationTotal = initializationTimer_.getTotalInMilliseconds();
-  const auto linearQuadraticApproximationTotal = linearQuadraticApproximationTimer_.getTotalInMilliseconds();
-  const auto backwardPassTotal = backwardPassTimer_.getTotalInMilliseconds();
-  const auto computeControllerTotal = computeControllerTimer_.getTotalInMilliseconds();
-  const auto searchStrategyTotal = searchStrategyTimer_.getTotalInMilliseconds();
-  const auto dualSolutionTotal = totalDualSolutionTimer_.getTotalInMilliseconds();
+const ProblemMetrics& GaussNewtonDDP::getSolutionMetrics() const {
+  std::lock_guard<std::mutex> lock(optimizedProblemMetricsMutex_);
+  if (optimizedProblemMetrics_.intermediates.empty() && !optimizedPrimalSolution_.timeTrajectory_.empty()) {
+    // the problem of the first worker is only evaluated by run(), which is not concurrent with this query
+    auto& problem = const_cast<OptimalControlProblem&>(optimalControlProblemStock_[0]);
+    computeRolloutMetrics(problem, optimizedPrimalSolution_, optimizedDualSolution_, optimizedProblemMetrics_);
+  }
+  return optimizedProblemMetrics_;
+}
 
-  const auto benchmarkTotal = initializationTotal + linearQuadraticApproximationTotal + backwardPassTotal + computeControllerTotal +
-                              searchStrategyTotal + dualSolutionTotal;
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::string GaussNewtonDDP::getBenchmarkingInfo() const {
+  const std::vector<std::string> scopeNames{"Initialization",     "LQ Approximation", "Backward Pass",
+                                            "Compute Controller", "Search Strategy",  "Dual Solution"};
+
+  std::vector<benchmark::Profiler::Statistics> statistics;
+  scalar_t benchmarkTotal = 0.0;
+  for (const auto& name : scopeNames) {
+    statistics.push_back(profiler_.getStatistics(name));
+    benchmarkTotal += statistics.back().totalInMilliseconds;
+  }
 
   std::stringstream infoStream;
   if (benchmarkTotal > 0.0) {
     infoStream << "\n########################################################################\n";
     infoStream << "The benchmarking is computed over " << totalNumIterations_ << " iterations. \n";
     infoStream << "DDP Benchmarking\t   :\tAverage time [ms]   (% of total runtime)\n";
-    infoStream << "\tInitialization     :\t" << initializationTimer_.getAverageInMilliseconds() << " [ms] \t\t("
-               << initializationTotal / benchmarkTotal * 100 << "%)\n";
-    infoStream << "\tLQ Approximation   :\t" << linearQuadraticApproximationTimer_.getAverageInMilliseconds() << " [ms] \t\t("
-               << linearQuadraticApproximationTotal / benchmarkTotal * 100 << "%)\n";
-    infoStream << "\tBackward Pass      :\t" << backwardPassTimer_.getAverageInMilliseconds() << " [ms] \t\t("
-               << backwardPassTotal / benchmarkTotal * 100 << "%)\n";
-    infoStream << "\tCompute Controller :\t" << computeControllerTimer_.getAverageInMilliseconds() << " [ms] \t\t("
-               << computeControllerTotal / benchmarkTotal * 100 << "%)\n";
-    infoStream << "\tSearch Strategy    :\t" << searchStrategyTimer_.getAverageInMilliseconds() << " [ms] \t\t("
-               << searchStrategyTotal / benchmarkTotal * 100 << "%)\n";
-    infoStream << "\tDual Solution      :\t" << totalDualSolutionTimer_.getAverageInMilliseconds() << " [ms] \t\t("
-               << dualSolutionTotal / benchmarkTotal * 100 << "%)\n\n";
+    for (size_t i = 0; i < scopeNames.size(); i++) {
+      infoStream << "\t" << std::left << std::setw(19) << scopeNames[i] << std::right << ":\t" << statistics[i].averageInMilliseconds
+                 << " [ms] \t\t(" << statistics[i].totalInMilliseconds / benchmarkTotal * 100 << "%)\n";
+    }
+    infoStream << "\tData allocations   :\t" << numTrajectoryAllocations_ << " (growths of the trajectory capacities)\n";
+    if (ddpSettings_.lqReuseTolerance_ > 0.0 && numIntermediateLQ_ > 0) {
+      infoStream << "\tLQ reuse rate      :\t" << 100.0 * numReusedIntermediateLQ_ / numIntermediateLQ_
+                 << "% (intermediate nodes reused from the previous iteration)\n";
+    }
+    if (numericalStabilityCheckerPtr_ != nullptr) {
+      infoStream << "\tStability checks   :\t" << numericalStabilityCheckerPtr_->getNumChecks() << " nodes checked, "
+                 << numericalStabilityCheckerPtr_->getNumViolations() << " violations, "
+                 << numericalStabilityCheckerPtr_->getNumSkippedChecks() << " skipped\n";
+    }
+    infoStream << "\n" << profiler_.getReport() << "\n";
   }
   return infoStream.str();
 }
@@ -190,13 +255,11 @@ void GaussNewtonDDP::reset() {
   totalNumIterations_ = 0;
   performanceIndexHistory_.clear();
 
-  // benchmarking timers
-  initializationTimer_.reset();
-  linearQuadraticApproximationTimer_.reset();
-  backwardPassTimer_.reset();
-  computeControllerTimer_.reset();
-  searchStrategyTimer_.reset();
-  totalDualSolutionTimer_.reset();
+  // benchmarking
+  profiler_.reset();
+  numTrajectoryAllocations_ = 0;
+  numIntermediateLQ_ = 0;
+  numReusedIntermediateLQ_ = 0;
 }
 
 /******************************************************************************************************/
@@ -221,36 +284,45 @@ void GaussNewtonDDP::getPrimalSolution(scalar_t finalTime, PrimalSolution* prima
   const int length = getRequestedDataLength(optimizedPrimalSolution_.timeTrajectory_, finalTime);
   const int eventLenght = getRequestedEventDataLength(optimizedPrimalSolution_.postEventIndices_, length - 1);
 
-  // fill trajectories
-  primalSolutionPtr->timeTrajectory_.clear();
-  primalSolutionPtr->timeTrajectory_.reserve(length);
-  primalSolutionPtr->stateTrajectory_.clear();
-  primalSolutionPtr->stateTrajectory_.reserve(length);
-  primalSolutionPtr->inputTrajectory_.clear();
-  primalSolutionPtr->inputTrajectory_.reserve(length);
-  primalSolutionPtr->postEventIndices_.clear();
-  primalSolutionPtr->postEventIndices_.reserve(eventLenght);
-
-  primalSolutionPtr->timeTrajectory_.insert(primalSolutionPtr->timeTrajectory_.end(), optimizedPrimalSolution_.timeTrajectory_.begin(),
-                                            optimizedPrimalSolution_.timeTrajectory_.begin() + length);
-  primalSolutionPtr->stateTrajectory_.insert(primalSolutionPtr->stateTrajectory_.end(), optimizedPrimalSolution_.stateTrajectory_.begin(),
-                                             optimizedPrimalSolution_.stateTrajectory_.begin() + length);
-  primalSolutionPtr->inputTrajectory_.insert(primalSolutionPtr->inputTrajectory_.end(), optimizedPrimalSolution_.inputTrajectory_.begin(),
-                                             optimizedPrimalSolution_.inputTrajectory_.begin() + length);
-  primalSolutionPtr->postEventIndices_.insert(primalSolutionPtr->postEventIndices_.end(),
-                                              optimizedPrimalSolution_.postEventIndices_.begin(),
-                                              optimizedPrimalSolution_.postEventIndices_.begin() + eventLenght);
-
-  // fill controller
+  // fill trajectories: assign reuses the memory of the given primal solution
+  const auto& optimizedSolution = optimizedPrimalSolution_;
+  primalSolutionPtr->timeTrajectory_.assign(optimizedSolution.timeTrajectory_.begin(), optimizedSolution.timeTrajectory_.begin() + length);
+  primalSolutionPtr->stateTrajectory_.assign(optimizedSolution.stateTrajectory_.begin(),
+                                             optimizedSolution.stateTrajectory_.begin() + length);
+  primalSolutionPtr->inputTrajectory_.assign(optimizedSolution.inputTrajectory_.begin(),
+                                             optimizedSolution.inputTrajectory_.begin() + length);
+  primalSolutionPtr->postEventIndices_.assign(optimizedSolution.postEventIndices_.begin(),
+                                              optimizedSolution.postEventIndices_.begin() + eventLenght);
+
+  // fill controller: a controller of the same type is reused
   if (ddpSettings_.useFeedbackPolicy_) {
-    primalSolutionPtr->controllerPtr_.reset(new LinearController);
+    auto* controllerPtr = dynamic_cast<LinearController*>(primalSolutionPtr->controllerPtr_.get());
+    if (controllerPtr == nullptr) {
+      controllerPtr = new LinearController;
+      primalSolutionPtr->controllerPtr_.reset(controllerPtr);
+    }
     // length of the copy
-    const int length = getRequestedDataLength(getLinearController(optimizedPrimalSolution_).timeStamp_, finalTime);
-    primalSolutionPtr->controllerPtr_->concatenate(optimizedPrimalSolution_.controllerPtr_.get(), 0, length);
+    const auto& optimizedController = getLinearController(optimizedSolution);
+    const int length = getRequestedDataLength(optimizedController.timeStamp_, finalTime);
+    controllerPtr->timeStamp_.assign(optimizedController.timeStamp_.begin(), optimizedController.timeStamp_.begin() + length);
+    controllerPtr->biasArray_.assign(optimizedController.biasArray_.begin(), optimizedController.biasArray_.begin() + length);
+    controllerPtr->gainArray_.assign(optimizedController.gainArray_.begin(), optimizedController.gainArray_.begin() + length);
+    // deltaBiasArray can be of different, incompatible size (see LinearController::concatenate)
+    if (length < optimizedController.deltaBiasArray_.size()) {
+      controllerPtr->deltaBiasArray_.assign(optimizedController.deltaBiasArray_.begin(),
+                                            optimizedController.deltaBiasArray_.begin() + length);
+    } else {
+      controllerPtr->deltaBiasArray_.clear();
+    }
 
   } else {
-    primalSolutionPtr->controllerPtr_.reset(
-        new FeedforwardController(primalSolutionPtr->timeTrajectory_, primalSolutionPtr->inputTrajectory_));
+    auto* controllerPtr = dynamic_cast<FeedforwardController*>(primalSolutionPtr->controllerPtr_.get());
+    if (controllerPtr == nullptr) {
+      controllerPtr = new FeedforwardController;
+      primalSolutionPtr->controllerPtr_.reset(controllerPtr);
+    }
+    controllerPtr->timeStamp_ = primalSolutionPtr->timeTrajectory_;
+    controllerPtr->uffArray_ = primalSolutionPtr->inputTrajectory_;
   }
 
   // fill mode schedule
@@ -286,6 +358,17 @@ ScalarFunctionQuadraticApproximation GaussNewtonDDP::getValueFunctionImpl(
   return valueFunction;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void GaussNewtonDDP::swapLqApproximationData(PrimalDataContainer& primalData, DualDataContainer& dualData) {
+  if (dynamic_cast<LinearController*>(primalData.primalSolution.controllerPtr_.get()) == nullptr) {
+    throw std::runtime_error("[GaussNewtonDDP::swapLqApproximationData] The primal solution should have a LinearController!");
+  }
+  nominalPrimalData_.swap(primalData);
+  nominalDualData_.swap(dualData);
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -335,6 +418,40 @@ ScalarFunctionQuadraticApproximation GaussNewtonDDP::getHamiltonian(scalar_t tim
   return hamiltonian;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t GaussNewtonDDP::getEventTimesCostDerivative() {
+  const auto& primalSolution = nominalPrimalData_.primalSolution;
+  const auto& eventTimes = primalSolution.modeSchedule_.eventTimes;
+
+  vector_t eventTimesCostDerivative = vector_t::Zero(eventTimes.size());
+  for (const auto postEventIndex : primalSolution.postEventIndices_) {
+    // an event at the final time has no post-event node
+    if (postEventIndex >= primalSolution.timeTrajectory_.size()) {
+      continue;
+    }
+
+    // the pre-event node is at the event time and the post-event node is shifted by an epsilon into the next mode
+    const size_t preEventIndex = postEventIndex - 1;
+    const auto& eventTime = primalSolution.timeTrajectory_[preEventIndex];
+    const auto eventTimeItr = std::lower_bound(eventTimes.cbegin(), eventTimes.cend(), eventTime);
+    if (eventTimeItr == eventTimes.cend() || *eventTimeItr != eventTime) {
+      throw std::runtime_error("[GaussNewtonDDP::getEventTimesCostDerivative] The event at time " + std::to_string(eventTime) +
+                               " [sec] is not in the mode schedule!");
+    }
+
+    const auto preEventHamiltonian = getHamiltonian(eventTime, primalSolution.stateTrajectory_[preEventIndex],
+                                                    primalSolution.inputTrajectory_[preEventIndex]);
+    const auto postEventHamiltonian = getHamiltonian(primalSolution.timeTrajectory_[postEventIndex],
+                                                     primalSolution.stateTrajectory_[postEventIndex],
+                                                     primalSolution.inputTrajectory_[postEventIndex]);
+    eventTimesCostDerivative(std::distance(eventTimes.cbegin(), eventTimeItr)) = preEventHamiltonian.f - postEventHamiltonian.f;
+  }  // end of postEventIndex loop
+
+  return eventTimesCostDerivative;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -502,6 +619,8 @@ scalar_t GaussNewtonDDP::calculateRolloutMerit(const PerformanceIndex& performan
   scalar_t merit = performanceIndex.cost;
   // state/state-input equality constraints
   merit += constraintPenaltyCoefficients_.penaltyCoeff * std::sqrt(performanceIndex.equalityConstraintsSSE);
+  // defects of the multiple-shooting forward pass
+  merit += constraintPenaltyCoefficients_.penaltyCoeff * std::sqrt(performanceIndex.dynamicsViolationSSE);
   // state/state-input equality Lagrangian
   merit += performanceIndex.equalityLagrangian;
   // state/state-input inequality Lagrangian
@@ -516,8 +635,7 @@ scalar_t GaussNewtonDDP::calculateRolloutMerit(const PerformanceIndex& performan
 scalar_t GaussNewtonDDP::solveSequentialRiccatiEquationsImpl(const ScalarFunctionQuadraticApproximation& finalValueFunction) {
   // pre-allocate memory for dual solution
   const size_t outputN = nominalPrimalData_.primalSolution.timeTrajectory_.size();
-  nominalDualData_.valueFunctionTrajectory.clear();
-  nominalDualData_.valueFunctionTrajectory.resize(outputN);
+  numTrajectoryAllocations_ += resizeTrajectory(nominalDualData_.valueFunctionTrajectory, outputN);
 
   // the last index of the partition is excluded, namely [first, last), so the value function approximation of the end point of the end
   // partition is filled manually.
@@ -525,8 +643,8 @@ scalar_t GaussNewtonDDP::solveSequentialRiccatiEquationsImpl(const ScalarFunctio
   // [first1,last1), [first2(last1), last2).
   nominalDualData_.valueFunctionTrajectory.back() = finalValueFunction;
 
-  // solve it sequentially for the first iteration
-  if (totalNumIterations_ == 0) {
+  // solve it sequentially for the first iteration or if the cached value function has been handed over, see swapLqApproximationData()
+  if (totalNumIterations_ == 0 || cachedDualData_.valueFunctionTrajectory.empty()) {
     const std::pair<int, int> partitionInterval{0, outputN - 1};
     riccatiEquationsWorker(0, partitionInterval, finalValueFunction);
   } else {  // solve it in parallel
@@ -546,6 +664,7 @@ scalar_t GaussNewtonDDP::solveSequentialRiccatiEquationsImpl(const ScalarFunctio
     nextTaskId_ = 0;
     auto task = [this, &partitionIntervals, &finalValueFunctionOfEachPartition]() {
       const size_t taskId = nextTaskId_++;  // assign task ID (atomic)
+      benchmark::Profiler::Scope partitionScope(profiler_, "partition", "Backward Pass");
       riccatiEquationsWorker(taskId, partitionIntervals[taskId], finalValueFunctionOfEachPartition[taskId]);
     };
     runParallel(task, partitionIntervals.size());
@@ -561,12 +680,14 @@ scalar_t GaussNewtonDDP::solveSequentialRiccatiEquationsImpl(const ScalarFunctio
       if (!errorDescription.empty()) {
         throw std::runtime_error(errorDescription);
       }
-      // check PSD
-      errorDescription = checkBeingPSD(nominalDualData_.valueFunctionTrajectory[k], "ValueFunction");
-      if (!errorDescription.empty()) {
+      // check PSD at the sampled nodes, a violation is only thrown by a synchronous check
+      try {
+        numericalStabilityCheckerPtr_->checkValueFunction(k, nominalPrimalData_.primalSolution.timeTrajectory_[k],
+                                                          nominalDualData_.valueFunctionTrajectory[k],
+                                                          "[GaussNewtonDDP] Ill-posed value function at time");
+      } catch (const std::runtime_error& error) {
         std::stringstream throwMsg;
-        throwMsg << "at time " << nominalPrimalData_.primalSolution.timeTrajectory_[k] << ":\n";
-        throwMsg << errorDescription << "The error takes place in the following segment of trajectory:\n";
+        throwMsg << error.what() << "The error takes place in the following segment of trajectory:\n";
         for (int kp = k; kp < std::min(k + 10, N); kp++) {
           throwMsg << ">>> time: " << nominalPrimalData_.primalSolution.timeTrajectory_[kp] << "\n";
           throwMsg << "|| Sm ||:\t" << nominalDualData_.valueFunctionTrajectory[kp].dfdxx.norm() << "\n";
@@ -594,15 +715,11 @@ void GaussNewtonDDP::calculateController() {
   unoptimizedController_.biasArray_.resize(N);
   unoptimizedController_.deltaBiasArray_.resize(N);
 
-  nextTimeIndex_ = 0;
-  auto task = [this, N] {
-    int timeIndex;
-    // get next time index (atomic)
-    while ((timeIndex = nextTimeIndex_++) < N) {
-      calculateControllerWorker(timeIndex, nominalPrimalData_, nominalDualData_, unoptimizedController_);
-    }
+  auto task = [this](int, int timeIndex) {
+    benchmark::Profiler::Scope nodeScope(profiler_, "node", "Compute Controller");
+    calculateControllerWorker(timeIndex, nominalPrimalData_, nominalDualData_, unoptimizedController_);
   };
-  runParallel(task, ddpSettings_.nThreads_);
+  parallelFor(N, task);
 
   // Since the controller for the last timestamp is invalid, if the last time is not the event time, use the control policy of the second to
   // last time for the last time
@@ -641,90 +758,201 @@ void GaussNewtonDDP::calculateController() {
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void GaussNewtonDDP::computeShootingNodes() {
+  const auto& timeTrajectory = nominalPrimalData_.primalSolution.timeTrajectory_;
+  const auto& stateTrajectory = nominalPrimalData_.primalSolution.stateTrajectory_;
+  const auto& postEventIndices = nominalPrimalData_.primalSolution.postEventIndices_;
+  const size_t N = timeTrajectory.size();
+
+  // linearized closed-loop state update: dx(k+1) = A dx(k) + B (K dx(k) + deltaBias) + dynamicsBias
+  vector_array_t stateUpdateTrajectory(N);
+  stateUpdateTrajectory[0].setZero(stateTrajectory[0].size());
+  auto postEventIndexItr = postEventIndices.cbegin();
+  for (size_t k = 0; k + 1 < N; k++) {
+    const auto& dx = stateUpdateTrajectory[k];
+    if (postEventIndexItr != postEventIndices.cend() && *postEventIndexItr == k + 1) {
+      const auto eventIndex = std::distance(postEventIndices.cbegin(), postEventIndexItr);
+      stateUpdateTrajectory[k + 1].noalias() = nominalPrimalData_.modelDataEventTimes[eventIndex].dynamics.dfdx * dx;
+      ++postEventIndexItr;
+    } else if (numerics::almost_eq(timeTrajectory[k + 1], timeTrajectory[k])) {
+      stateUpdateTrajectory[k + 1] = dx;
+    } else {
+      const auto& modelData = nominalPrimalData_.modelDataTrajectory[k];
+      vector_t du = unoptimizedController_.deltaBiasArray_[k];
+      du.noalias() += unoptimizedController_.gainArray_[k] * dx;
+      stateUpdateTrajectory[k + 1] = modelData.dynamicsBias;
+      stateUpdateTrajectory[k + 1].noalias() += modelData.dynamics.dfdx * dx;
+      stateUpdateTrajectory[k + 1].noalias() += modelData.dynamics.dfdu * du;
+    }
+  }
+
+  // interpolate at the shooting times
+  const size_t numNodes = shootingNodes_.times.size();
+  shootingNodes_.states.resize(numNodes);
+  shootingNodes_.stateUpdates.resize(numNodes);
+  for (size_t i = 0; i < numNodes; i++) {
+    const auto indexAlpha = LinearInterpolation::timeSegment(shootingNodes_.times[i], timeTrajectory);
+    shootingNodes_.states[i] = LinearInterpolation::interpolate(indexAlpha, stateTrajectory);
+    shootingNodes_.stateUpdates[i] = LinearInterpolation::interpolate(indexAlpha, stateUpdateTrajectory);
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 void GaussNewtonDDP::approximateOptimalControlProblem() {
+  isLqRegularized_ = false;
+
+  /*
+   * The LQ approximations of the intermediate times, the event times, and the final time are independent of each other. They are
+   * nodes of one task graph, such that the event and final time approximations overlap with the intermediate ones instead of
+   * waiting at a barrier.
+   */
+  TaskGraph taskGraph;
+
   /*
    * compute and augment the LQ approximation of intermediate times
    */
-  // perform the LQ approximation for intermediate times
-  approximateIntermediateLQ(nominalDualData_.dualSolution, nominalPrimalData_);
+  const size_t N = nominalPrimalData_.primalSolution.timeTrajectory_.size();
+  numTrajectoryAllocations_ += resizeTrajectory(nominalPrimalData_.modelDataTrajectory, N);
+  numIntermediateLQ_ += N;
+  if (ddpSettings_.checkNumericalStability_) {
+    numericalStabilityCheckerPtr_->newIteration();
+  }
+  auto intermediateTask = [this](int workerIndex, int timeIndex) {
+    benchmark::Profiler::Scope nodeScope(profiler_, "intermediate node", "LQ Approximation");
+    if (ddpSettings_.lqReuseTolerance_ > 0.0 && reuseIntermediateLQ(timeIndex)) {
+      ++numReusedIntermediateLQ_;
+    } else {
+      approximateIntermediateLQ(workerIndex, timeIndex, nominalDualData_.dualSolution, nominalPrimalData_);
+    }
+  };
+  constexpr int grain = 1;  // time nodes are expensive and can differ strongly in cost
+  taskGraph.addParallelFor(0, static_cast<int>(N), grain, intermediateTask);
 
   /*
    * compute and augment the LQ approximation of the event times.
    * also call shiftHessian on the event time's cost 2nd order derivative.
    */
   const size_t NE = nominalPrimalData_.primalSolution.postEventIndices_.size();
-  nominalPrimalData_.modelDataEventTimes.clear();
-  nominalPrimalData_.modelDataEventTimes.resize(NE);
+  numTrajectoryAllocations_ += resizeTrajectory(nominalPrimalData_.modelDataEventTimes, NE);
   if (NE > 0) {
-    nextTimeIndex_ = 0;
-    nextTaskId_ = 0;
-    auto task = [this, NE]() {
-      const size_t taskId = nextTaskId_++;  // assign task ID (atomic)
-
-      // timeIndex is atomic
-      int timeIndex;
-      while ((timeIndex = nextTimeIndex_++) < NE) {
-        ModelData& modelData = nominalPrimalData_.modelDataEventTimes[timeIndex];
-        const size_t preEventIndex = nominalPrimalData_.primalSolution.postEventIndices_[timeIndex] - 1;
-        const auto& time = nominalPrimalData_.primalSolution.timeTrajectory_[preEventIndex];
-        const auto& state = nominalPrimalData_.primalSolution.stateTrajectory_[preEventIndex];
-        const auto& multiplier = nominalDualData_.dualSolution.preJumps[timeIndex];
-
-        // approximate LQ for the pre-event node
-        ocs2::approximatePreJumpLQ(optimalControlProblemStock_[taskId], time, state, multiplier, modelData);
-
-        // checking the numerical properties
-        if (ddpSettings_.checkNumericalStability_) {
-          const auto errSize = checkSize(modelData, state.rows(), 0);
-          if (!errSize.empty()) {
-            throw std::runtime_error("[GaussNewtonDDP::approximateOptimalControlProblem] Mismatch in dimensions at intermediate time: " +
-                                     std::to_string(time) + "\n" + errSize);
-          }
-          const std::string errProperties =
-              checkDynamicsProperties(modelData) + checkCostProperties(modelData) + checkConstraintProperties(modelData);
-          if (!errProperties.empty()) {
-            throw std::runtime_error("[GaussNewtonDDP::approximateOptimalControlProblem] Ill-posed problem at event time: " +
-                                     std::to_string(time) + "\n" + errProperties);
-          }
+    auto eventTask = [this](int workerIndex, int timeIndex) {
+      ModelData& modelData = nominalPrimalData_.modelDataEventTimes[timeIndex];
+      const size_t preEventIndex = nominalPrimalData_.primalSolution.postEventIndices_[timeIndex] - 1;
+      const auto& time = nominalPrimalData_.primalSolution.timeTrajectory_[preEventIndex];
+      const auto& state = nominalPrimalData_.primalSolution.stateTrajectory_[preEventIndex];
+      const auto& multiplier = nominalDualData_.dualSolution.preJumps[timeIndex];
+
+      // approximate LQ for the pre-event node
+      ocs2::approximatePreJumpLQ(optimalControlProblemStock_[workerIndex], time, state, multiplier, modelData);
+
+      // checking the numerical properties
+      if (ddpSettings_.checkNumericalStability_) {
+        const auto errSize = checkSize(modelData, state.rows(), 0);
+        if (!errSize.empty()) {
+          throw std::runtime_error("[GaussNewtonDDP::approximateOptimalControlProblem] Mismatch in dimensions at intermediate time: " +
+                                   std::to_string(time) + "\n" + errSize);
         }
+        numericalStabilityCheckerPtr_->check(preEventIndex, time, modelData,
+                                             "[GaussNewtonDDP::approximateOptimalControlProblem] Ill-posed problem at event time");
+      }
 
-        // shift Hessian
-        if (ddpSettings_.strategy_ == search_strategy::Type::LINE_SEARCH) {
-          hessian_correction::shiftHessian(ddpSettings_.lineSearch_.hessianCorrectionStrategy, modelData.cost.dfdxx,
-                                           ddpSettings_.lineSearch_.hessianCorrectionMultiple);
-        }
+      // shift Hessian
+      if (ddpSettings_.strategy_ == search_strategy::Type::LINE_SEARCH) {
+        correctHessian(modelData.cost.dfdxx);
       }
     };
-    runParallel(task, ddpSettings_.nThreads_);
+    taskGraph.addParallelFor(0, static_cast<int>(NE), grain, eventTask);
   }
 
   /*
    * compute the Heuristics function at the final time. Also call shiftHessian on the Heuristics 2nd order derivative.
    */
-  if (!nominalPrimalData_.primalSolution.timeTrajectory_.empty()) {
-    ModelData& modelData = nominalPrimalData_.modelDataFinalTime;
-    const auto& time = nominalPrimalData_.primalSolution.timeTrajectory_.back();
-    const auto& state = nominalPrimalData_.primalSolution.stateTrajectory_.back();
-    const auto& multiplier = nominalDualData_.dualSolution.final;
-    modelData = ocs2::approximateFinalLQ(optimalControlProblemStock_[0], time, state, multiplier);
-
-    // checking the numerical properties
-    if (ddpSettings_.checkNumericalStability_) {
-      const std::string err = checkCostProperties(modelData) + checkConstraintProperties(modelData);
-      if (!err.empty()) {
-        throw std::runtime_error(
-            "[GaussNewtonDDP::approximateOptimalControlProblem] Ill-posed problem at final time: " + std::to_string(time) + "\n" + err);
+  if (N > 0) {
+    auto finalTask = [this](int workerIndex) {
+      ModelData& modelData = nominalPrimalData_.modelDataFinalTime;
+      const auto& time = nominalPrimalData_.primalSolution.timeTrajectory_.back();
+      const auto& state = nominalPrimalData_.primalSolution.stateTrajectory_.back();
+      const auto& multiplier = nominalDualData_.dualSolution.final;
+      ocs2::approximateFinalLQ(optimalControlProblemStock_[workerIndex], time, state, multiplier, modelData);
+
+      // checking the numerical properties
+      if (ddpSettings_.checkNumericalStability_) {
+        const size_t finalIndex = nominalPrimalData_.primalSolution.timeTrajectory_.size() - 1;
+        numericalStabilityCheckerPtr_->check(finalIndex, time, modelData,
+                                             "[GaussNewtonDDP::approximateOptimalControlProblem] Ill-posed problem at final time");
       }
-    }
 
-    // shift Hessian for final time
-    if (ddpSettings_.strategy_ == search_strategy::Type::LINE_SEARCH) {
-      hessian_correction::shiftHessian(ddpSettings_.lineSearch_.hessianCorrectionStrategy, modelData.cost.dfdxx,
-                                       ddpSettings_.lineSearch_.hessianCorrectionMultiple);
-    }
+      // shift Hessian for final time
+      if (ddpSettings_.strategy_ == search_strategy::Type::LINE_SEARCH) {
+        correctHessian(modelData.cost.dfdxx);
+      }
+    };
+    taskGraph.addTask(finalTask);
+  }
+
+  taskGraph.run(*threadPoolPtr_, ddpSettings_.nThreads_);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool GaussNewtonDDP::reuseIntermediateLQ(size_t timeIndex) {
+  // the previous LQ approximation is kept in the cached data, see runImpl()
+  const auto& previousSolution = cachedPrimalData_.primalSolution;
+  const auto& currentSolution = nominalPrimalData_.primalSolution;
+  const auto N = currentSolution.timeTrajectory_.size();
+  if (previousSolution.timeTrajectory_.size() != N || cachedPrimalData_.modelDataTrajectory.size() != N) {
+    return false;
+  }
+
+  // the time step to the next node enters the discretization of ILQR
+  const auto nextIndex = std::min(timeIndex + 1, N - 1);
+  if (!numerics::almost_eq(previousSolution.timeTrajectory_[timeIndex], currentSolution.timeTrajectory_[timeIndex]) ||
+      !numerics::almost_eq(previousSolution.timeTrajectory_[nextIndex], currentSolution.timeTrajectory_[nextIndex])) {
+    return false;
+  }
+
+  const auto& previousState = previousSolution.stateTrajectory_[timeIndex];
+  const auto& previousInput = previousSolution.inputTrajectory_[timeIndex];
+  const auto& state = currentSolution.stateTrajectory_[timeIndex];
+  const auto& input = currentSolution.inputTrajectory_[timeIndex];
+  if (previousState.size() != state.size() || previousInput.size() != input.size()) {
+    return false;
+  }
+
+  const vector_t deltaState = state - previousState;
+  const vector_t deltaInput = input - previousInput;
+  const auto tolerance = ddpSettings_.lqReuseTolerance_;
+  if (deltaState.lpNorm<Eigen::Infinity>() >= tolerance || deltaInput.lpNorm<Eigen::Infinity>() >= tolerance) {
+    return false;
+  }
+
+  auto& modelData = nominalPrimalData_.modelDataTrajectory[timeIndex];
+  modelData = cachedPrimalData_.modelDataTrajectory[timeIndex];
+  shiftModelDataExpansionPoint(deltaState, deltaInput, modelData);
+  return true;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void GaussNewtonDDP::correctHessian(matrix_t& hessian) const {
+  if (!isLinearQuadratic_) {
+    hessian_correction::shiftHessian(ddpSettings_.lineSearch_.hessianCorrectionStrategy, hessian,
+                                     ddpSettings_.lineSearch_.hessianCorrectionMultiple);
+    return;
+  }
+
+  const matrix_t uncorrectedHessian = hessian;
+  hessian_correction::shiftHessian(ddpSettings_.lineSearch_.hessianCorrectionStrategy, hessian,
+                                   ddpSettings_.lineSearch_.hessianCorrectionMultiple);
+  if (!(hessian - uncorrectedHessian).isZero(numeric_traits::weakEpsilon<scalar_t>())) {
+    isLqRegularized_ = true;
   }
 }
 
@@ -747,6 +975,13 @@ void GaussNewtonDDP::computeProjectionAndRiccatiModification(const ModelData& mo
   // compute deltaQm, deltaGv, deltaGm
   searchStrategyPtr_->computeRiccatiModification(projectedModelData, riccatiModification.deltaQm_, riccatiModification.deltaGv_,
                                                  riccatiModification.deltaGm_);
+  if (isLinearQuadratic_) {
+    constexpr auto eps = numeric_traits::weakEpsilon<scalar_t>();
+    if (!riccatiModification.deltaQm_.isZero(eps) || !riccatiModification.deltaGv_.isZero(eps) ||
+        !riccatiModification.deltaGm_.isZero(eps)) {
+      isLqRegularized_ = true;
+    }
+  }
 }
 
 /******************************************************************************************************/
@@ -774,7 +1009,7 @@ void GaussNewtonDDP::computeProjections(const matrix_t& Hm, const matrix_t& Dm,
   if (ddpSettings_.checkNumericalStability_) {
     matrix_t HmProjected = constraintNullProjector.transpose() * Hm * constraintNullProjector;
     const int nullSpaceDim = Hm.rows() - Dm.rows();
-    if (!HmProjected.isApprox(matrix_t::Identity(nullSpaceDim, nullSpaceDim), 1e-6)) {
+    if (!HmProjected.isApprox(matrix_t::Identity(nullSpaceDim, nullSpaceDim), numeric_traits::limitEpsilon<scalar_t>())) {
       std::cerr << "HmProjected:\n" << HmProjected << "\n";
       throw std::runtime_error("HmProjected should be identity!");
     }
@@ -830,9 +1065,11 @@ void GaussNewtonDDP::updateConstraintPenalties(scalar_t equalityConstraintsSSE)
 /******************************************************************************************************/
 /******************************************************************************************************/
 bool GaussNewtonDDP::initializePrimalSolution() {
+  benchmark::Profiler::Scope rolloutScope(profiler_, "Rollout");
   try {
-    // clear before starting to fill
-    nominalPrimalData_.clear();
+    // clear before starting to fill, the model data is kept to be refilled in place by approximateOptimalControlProblem()
+    nominalPrimalData_.primalSolution.clear();
+    nominalPrimalData_.problemMetrics.clear();
 
     // for non-StateTriggeredRollout case, set modeSchedule
     nominalPrimalData_.primalSolution.modeSchedule_ = getReferenceManager().getModeSchedule();
@@ -871,58 +1108,61 @@ bool GaussNewtonDDP::initializePrimalSolution() {
 /******************************************************************************************************/
 /******************************************************************************************************/
 void GaussNewtonDDP::initializeDualSolutionAndMetrics() {
-  // adjust dual solution
-  totalDualSolutionTimer_.startTimer();
-  if (!optimizedDualSolution_.timeTrajectory.empty()) {
-    const auto status =
-        trajectorySpread(optimizedPrimalSolution_.modeSchedule_, nominalPrimalData_.primalSolution.modeSchedule_, optimizedDualSolution_);
-  }
-
-  // initialize dual solution
-  ocs2::initializeDualSolution(optimalControlProblemStock_[0], nominalPrimalData_.primalSolution, optimizedDualSolution_,
-                               nominalDualData_.dualSolution);
-  totalDualSolutionTimer_.endTimer();
+  {
+    benchmark::Profiler::Scope dualSolutionScope(profiler_, "Dual Solution");
 
-  computeRolloutMetrics(optimalControlProblemStock_[0], nominalPrimalData_.primalSolution, nominalDualData_.dualSolution,
-                        nominalPrimalData_.problemMetrics);
+    // adjust dual solution
+    if (!optimizedDualSolution_.timeTrajectory.empty()) {
+      const auto status =
+          trajectorySpread(optimizedPrimalSolution_.modeSchedule_, nominalPrimalData_.primalSolution.modeSchedule_, optimizedDualSolution_);
+    }
 
-  // update dual
-  //  totalDualSolutionTimer_.startTimer();
-  //  ocs2::updateDualSolution(optimalControlProblemStock_[0], nominalPrimalData_.primalSolution, nominalPrimalData_.problemMetrics,
-  //  nominalDualData_.dualSolution);
-  //  totalDualSolutionTimer_.endTimer();
+    // initialize dual solution
+    ocs2::initializeDualSolution(optimalControlProblemStock_[0], nominalPrimalData_.primalSolution, optimizedDualSolution_,
+                                 nominalDualData_.dualSolution);
+  }
 
-  // calculates rollout merit
-  performanceIndex_ = computeRolloutPerformanceIndex(nominalPrimalData_.primalSolution.timeTrajectory_, nominalPrimalData_.problemMetrics);
+  // calculates rollout merit. The metrics of the rollout points are computed on demand.
+  nominalPrimalData_.problemMetrics.clear();
+  performanceIndex_ = computeRolloutPerformanceIndex(optimalControlProblemStock_[0], nominalPrimalData_.primalSolution,
+                                                     nominalDualData_.dualSolution);
   performanceIndex_.merit = calculateRolloutMerit(performanceIndex_);
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-void GaussNewtonDDP::takePrimalDualStep(scalar_t lqModelExpectedCost) {
+bool GaussNewtonDDP::takePrimalDualStep(scalar_t lqModelExpectedCost) {
   // update primal: run search strategy and find the optimal stepLength
-  searchStrategyTimer_.startTimer();
-  scalar_t avgTimeStep;
-  const auto& modeSchedule = this->getReferenceManager().getModeSchedule();
-  search_strategy::SolutionRef solution(avgTimeStep, optimizedDualSolution_, optimizedPrimalSolution_, optimizedProblemMetrics_,
-                                        performanceIndex_);
-  const bool success = searchStrategyPtr_->run({initTime_, finalTime_}, initState_, lqModelExpectedCost, unoptimizedController_,
-                                               nominalDualData_.dualSolution, modeSchedule, solution);
-
-  if (success) {
-    avgTimeStepFP_ = 0.9 * avgTimeStepFP_ + 0.1 * avgTimeStep;
+  bool success;
+  {
+    benchmark::Profiler::Scope searchStrategyScope(profiler_, "Search Strategy");
+    scalar_t avgTimeStep;
+    const auto& modeSchedule = this->getReferenceManager().getModeSchedule();
+    search_strategy::SolutionRef solution(avgTimeStep, optimizedDualSolution_, optimizedPrimalSolution_, performanceIndex_);
+    success = searchStrategyPtr_->run({initTime_, finalTime_}, initState_, lqModelExpectedCost, unoptimizedController_,
+                                      nominalDualData_.dualSolution, modeSchedule, solution);
+
+    if (success) {
+      avgTimeStepFP_ = 0.9 * avgTimeStepFP_ + 0.1 * avgTimeStep;
+    }
   }
-  searchStrategyTimer_.endTimer();
 
-  // update dual
-  totalDualSolutionTimer_.startTimer();
+  // update dual. The metrics of the rollout points are only required by the update of the Lagrangian multipliers, otherwise they are
+  // computed on demand, see getSolutionMetrics().
   if (success) {
-    ocs2::updateDualSolution(optimalControlProblemStock_[0], optimizedPrimalSolution_, optimizedProblemMetrics_, optimizedDualSolution_);
-    performanceIndex_ = computeRolloutPerformanceIndex(optimizedPrimalSolution_.timeTrajectory_, optimizedProblemMetrics_);
-    performanceIndex_.merit = calculateRolloutMerit(performanceIndex_);
+    optimizedProblemMetrics_.clear();
+    if (hasLagrangianTerms_) {
+      benchmark::Profiler::Scope dualSolutionScope(profiler_, "Dual Solution");
+      computeRolloutMetrics(optimalControlProblemStock_[0], optimizedPrimalSolution_, optimizedDualSolution_, optimizedProblemMetrics_);
+      ocs2::updateDualSolution(optimalControlProblemStock_[0], optimizedPrimalSolution_, optimizedProblemMetrics_, optimizedDualSolution_,
+                               *threadPoolPtr_, ddpSettings_.nThreads_);
+      const scalar_t defectsSSE = performanceIndex_.dynamicsViolationSSE;  // not part of the problem metrics
+      performanceIndex_ = computeRolloutPerformanceIndex(optimizedPrimalSolution_.timeTrajectory_, optimizedProblemMetrics_);
+      performanceIndex_.dynamicsViolationSSE = defectsSSE;
+      performanceIndex_.merit = calculateRolloutMerit(performanceIndex_);
+    }
   }
-  totalDualSolutionTimer_.endTimer();
 
   // if failed, use nominal and to keep the consistency of cached data, all cache should be left untouched
   if (!success) {
@@ -931,6 +1171,8 @@ void GaussNewtonDDP::takePrimalDualStep(scalar_t lqModelExpectedCost) {
     optimizedProblemMetrics_ = nominalPrimalData_.problemMetrics;
     performanceIndex_ = performanceIndexHistory_.back();
   }
+
+  return success;
 }
 
 /******************************************************************************************************/
@@ -974,6 +1216,16 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime, const PrimalSolution& primalSolution,
+                             const DualSolution& dualSolution) {
+  // the dual solution is spread to the mode schedule of the new rollout in initializeDualSolutionAndMetrics()
+  optimizedDualSolution_ = dualSolution;
+  runImpl(initTime, initState, finalTime, primalSolution);
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -989,6 +1241,9 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
   // set cost desired trajectories
   for (auto& ocp : optimalControlProblemStock_) {
     ocp.targetTrajectoriesPtr = &this->getReferenceManager().getTargetTrajectories();
+    if (ddpSettings_.cacheTermActivity_) {
+      cacheTermActivity(this->getReferenceManager().getModeSchedule(), ocp);
+    }
   }
 
   // initialize parameters
@@ -997,8 +1252,16 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
   finalTime_ = finalTime;
   performanceIndexHistory_.clear();
   const auto initIteration = totalNumIterations_;
+  const auto initNumTrials = searchStrategyPtr_->getNumTrials();
   initializeConstraintPenalties();  // initialize penalty coefficients
 
+  // partitions of the multiple-shooting forward pass
+  shootingNodes_.clear();
+  if (ddpSettings_.multipleShootingForwardPass_) {
+    shootingNodes_.times =
+        computeShootingTimes(initTime_, finalTime_, ddpSettings_.nThreads_, this->getReferenceManager().getModeSchedule().eventTimes);
+  }
+
   // display
   if (ddpSettings_.displayInfo_) {
     std::cerr << "\n###################";
@@ -1011,11 +1274,13 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
   nominalPrimalData_.swap(cachedPrimalData_);
 
   // optimized --> nominal: initializes the nominal primal and dual solutions based on the optimized ones
-  initializationTimer_.startTimer();
-  bool initialSolutionExists = initializePrimalSolution();  // true if the rollout is not purely from the Initializer
-  initializeDualSolutionAndMetrics();
-  performanceIndexHistory_.push_back(performanceIndex_);
-  initializationTimer_.endTimer();
+  bool initialSolutionExists;
+  {
+    benchmark::Profiler::Scope initializationScope(profiler_, "Initialization");
+    initialSolutionExists = initializePrimalSolution();  // true if the rollout is not purely from the Initializer
+    initializeDualSolutionAndMetrics();
+    performanceIndexHistory_.push_back(performanceIndex_);
+  }
 
   // display
   if (ddpSettings_.displayInfo_) {
@@ -1024,7 +1289,10 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
 
   // convergence variables of the main loop
   bool isConverged = false;
+  bool isDeadlineReached = false;
+  bool isStepRejected = false;
   std::string convergenceInfo;
+  searchStrategyPtr_->setDeadline(getDeadline());
 
   // DDP main loop
   while (true) {
@@ -1034,26 +1302,33 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
       std::cerr << "\n###################\n";
     }
 
-    // nominal --> nominal: constructs the LQ problem around the nominal trajectories
-    linearQuadraticApproximationTimer_.startTimer();
-    approximateOptimalControlProblem();
-    linearQuadraticApproximationTimer_.endTimer();
+    // nominal --> nominal: constructs the LQ problem around the nominal trajectories. After a rejected step, the nominal trajectories
+    // and their LQ approximation are unchanged, hence only the backward pass is repeated with the new regularization.
+    if (!isStepRejected) {
+      benchmark::Profiler::Scope lqScope(profiler_, "LQ Approximation");
+      approximateOptimalControlProblem();
+    }
 
     // nominal --> nominal: solves the LQ problem
-    backwardPassTimer_.startTimer();
-    avgTimeStepBP_ = solveSequentialRiccatiEquations(nominalPrimalData_.modelDataFinalTime.cost);
-    backwardPassTimer_.endTimer();
+    {
+      benchmark::Profiler::Scope backwardPassScope(profiler_, "Backward Pass");
+      avgTimeStepBP_ = solveSequentialRiccatiEquations(nominalPrimalData_.modelDataFinalTime.cost);
+    }
 
     // calculate controller and store the result in unoptimizedController_
-    computeControllerTimer_.startTimer();
-    calculateController();
-    computeControllerTimer_.endTimer();
+    {
+      benchmark::Profiler::Scope computeControllerScope(profiler_, "Compute Controller");
+      calculateController();
+      if (!shootingNodes_.times.empty()) {
+        computeShootingNodes();
+      }
+    }
 
     // the expected cost/merit calculated by the Riccati solution is not reliable
     const auto lqModelExpectedCost = initialSolutionExists ? nominalDualData_.valueFunctionTrajectory.front().f : performanceIndex_.merit;
 
     // nominal --> optimized: based on the current LQ solution updates the optimized primal and dual solutions
-    takePrimalDualStep(lqModelExpectedCost);
+    isStepRejected = !takePrimalDualStep(lqModelExpectedCost);
 
     // iteration info
     ++totalNumIterations_;
@@ -1064,26 +1339,44 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
       printRolloutInfo();
     }
 
-    // check convergence
-    std::tie(isConverged, convergenceInfo) = searchStrategyPtr_->checkConvergence(
-        !initialSolutionExists, *std::prev(performanceIndexHistory_.end(), 2), performanceIndexHistory_.back());
+    // check convergence. The full step of an unregularized linear-quadratic problem is its solution, hence no further iteration is
+    // required. A shorter or regularized step only approaches it.
+    if (isLinearQuadratic_ && !isStepRejected && searchStrategyPtr_->isLastStepFull() && !isLqRegularized_) {
+      isConverged = true;
+      convergenceInfo = "The linear-quadratic problem is solved by a single step.";
+    } else {
+      std::tie(isConverged, convergenceInfo) = searchStrategyPtr_->checkConvergence(
+          !initialSolutionExists, *std::prev(performanceIndexHistory_.end(), 2), performanceIndexHistory_.back());
+    }
     initialSolutionExists = true;
+    isDeadlineReached = !isConverged && this->isDeadlineReached();
 
-    if (isConverged || (totalNumIterations_ - initIteration) == ddpSettings_.maxNumIterations_) {
+    if (isConverged || isDeadlineReached || (totalNumIterations_ - initIteration) == ddpSettings_.maxNumIterations_) {
       break;
 
     } else {
       // update the constraint penalty coefficients
-      updateConstraintPenalties(performanceIndex_.equalityConstraintsSSE);
-
-      // optimized --> nominal: use the optimized solution as the nominal for the next iteration
-      nominalDualData_.swap(cachedDualData_);
-      nominalPrimalData_.swap(cachedPrimalData_);
-      optimizedDualSolution_.swap(nominalDualData_.dualSolution);
-      optimizedPrimalSolution_.swap(nominalPrimalData_.primalSolution);
-      optimizedProblemMetrics_.swap(nominalPrimalData_.problemMetrics);
+      updateConstraintPenalties(performanceIndex_.equalityConstraintsSSE + performanceIndex_.dynamicsViolationSSE);
+
+      // optimized --> nominal: use the optimized solution as the nominal for the next iteration. A rejected step keeps the nominal data.
+      if (!isStepRejected) {
+        nominalDualData_.swap(cachedDualData_);
+        nominalPrimalData_.swap(cachedPrimalData_);
+        optimizedDualSolution_.swap(nominalDualData_.dualSolution);
+        optimizedPrimalSolution_.swap(nominalPrimalData_.primalSolution);
+        optimizedProblemMetrics_.swap(nominalPrimalData_.problemMetrics);
+      } else {
+        // the cached value function initializes the partitions of the next backward pass
+        cachedPrimalData_.primalSolution = nominalPrimalData_.primalSolution;
+        cachedDualData_.valueFunctionTrajectory = nominalDualData_.valueFunctionTrajectory;
+      }
     }
   }  // end of while loop
+  runStatistics().numLineSearchTrials = searchStrategyPtr_->getNumTrials() - initNumTrials;
+
+  // flag the anytime solution
+  performanceIndex_.deadlineReached = isDeadlineReached;
+  performanceIndexHistory_.back().deadlineReached = isDeadlineReached;
 
   // display
   if (ddpSettings_.displayInfo_ || ddpSettings_.displayShortSummary_) {
@@ -1097,6 +1390,9 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
 
     if (isConverged) {
       std::cerr << convergenceInfo << std::endl;
+    } else if (isDeadlineReached) {
+      std::cerr << "The algorithm has terminated as: \n";
+      std::cerr << "    * The wall-clock deadline has been reached." << std::endl;
     } else if (totalNumIterations_ - initIteration == ddpSettings_.maxNumIterations_) {
       std::cerr << "The algorithm has terminated as: \n";
       std::cerr << "    * The maximum number of iterations (i.e., " << ddpSettings_.maxNumIterations_ << ") has reached." << std::endl;
@@ -37,6 +37,7 @@ namespace hessian_correction {
 std::string toString(Strategy strategy) {
   static const std::unordered_map<Strategy, std::string> strategyMap{{Strategy::DIAGONAL_SHIFT, "DIAGONAL_SHIFT"},
                                                                      {Strategy::CHOLESKY_MODIFICATION, "CHOLESKY_MODIFICATION"},
+                                                                     {Strategy::CHOLESKY_SHIFT, "CHOLESKY_SHIFT"},
                                                                      {Strategy::EIGENVALUE_MODIFICATION, "EIGENVALUE_MODIFICATION"},
                                                                      {Strategy::GERSHGORIN_MODIFICATION, "GERSHGORIN_MODIFICATION"}};
   return strategyMap.at(strategy);
@@ -45,6 +46,7 @@ std::string toString(Strategy strategy) {
 Strategy fromString(const std::string& name) {
   static const std::unordered_map<std::string, Strategy> strategyMap{{"DIAGONAL_SHIFT", Strategy::DIAGONAL_SHIFT},
                                                                      {"CHOLESKY_MODIFICATION", Strategy::CHOLESKY_MODIFICATION},
+                                                                     {"CHOLESKY_SHIFT", Strategy::CHOLESKY_SHIFT},
                                                                      {"EIGENVALUE_MODIFICATION", Strategy::EIGENVALUE_MODIFICATION},
                                                                      {"GERSHGORIN_MODIFICATION", Strategy::GERSHGORIN_MODIFICATION}};
   return strategyMap.at(name);
@@ -28,6 +28,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
 #include "ocs2_ddp/ILQR.h"
+
+#include <algorithm>
+
+#include <ocs2_core/NumericTraits.h>
 #include <ocs2_ddp/riccati_equations/RiccatiTransversalityConditions.h>
 
 namespace ocs2 {
@@ -36,13 +40,17 @@ namespace ocs2 {
 /******************************************************************************************************/
 /******************************************************************************************************/
 ILQR::ILQR(ddp::Settings ddpSettings, const RolloutBase& rollout, const OptimalControlProblem& optimalControlProblem,
-           const Initializer& initializer)
-    : GaussNewtonDDP(std::move(ddpSettings), rollout, optimalControlProblem, initializer) {
+           const Initializer& initializer, std::shared_ptr<ThreadPool> threadPoolPtr)
+    : GaussNewtonDDP(std::move(ddpSettings), rollout, optimalControlProblem, initializer, std::move(threadPoolPtr)) {
   if (settings().algorithm_ != ddp::Algorithm::ILQR) {
     throw std::runtime_error("[ILQR] In DDP setting the algorithm name is set \"" + ddp::toAlgorithmName(settings().algorithm_) +
                              "\" while ILQR is instantiated!");
   }
 
+  if (settings().squareRootRiccati_ && !numerics::almost_eq(settings().riskSensitiveCoeff_, 0.0)) {
+    throw std::runtime_error("[ILQR] The square-root Riccati recursion does not support the risk sensitive variant!");
+  }
+
   // dynamics discretizer
   sensitivityDiscretizer_ = [&]() {
     switch (settings().backwardPassIntegratorType_) {
@@ -70,79 +78,70 @@ ILQR::ILQR(ddp::Settings ddpSettings, const RolloutBase& rollout, const OptimalC
     riccatiEquationsPtrStock_.back()->setRiskSensitiveCoefficient(settings().riskSensitiveCoeff_);
   }  // end of i loop
 
+  continuousTimeModelDataStock_.resize(settings().nThreads_);
+
   Eigen::initParallel();
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-void ILQR::approximateIntermediateLQ(const DualSolution& dualSolution, PrimalDataContainer& primalData) {
+void ILQR::approximateIntermediateLQ(int workerIndex, size_t timeIndex, const DualSolution& dualSolution, PrimalDataContainer& primalData) {
   // create alias
   const auto& timeTrajectory = primalData.primalSolution.timeTrajectory_;
-  const auto& stateTrajectory = primalData.primalSolution.stateTrajectory_;
-  const auto& inputTrajectory = primalData.primalSolution.inputTrajectory_;
-  const auto& postEventIndices = primalData.primalSolution.postEventIndices_;
-  const auto& multiplierTrajectory = dualSolution.intermediates;
-  auto& modelDataTrajectory = primalData.modelDataTrajectory;
-
-  modelDataTrajectory.clear();
-  modelDataTrajectory.resize(timeTrajectory.size());
-
-  nextTimeIndex_ = 0;
-  nextTaskId_ = 0;
-  auto task = [&]() {
-    size_t taskId = nextTaskId_++;  // assign task ID (atomic)
-
-    ModelData continuousTimeModelData;
-
-    // get next time index is atomic
-    size_t timeIndex;
-    while ((timeIndex = nextTimeIndex_++) < timeTrajectory.size()) {
-      // approximate continuous LQ for the given time index
-      ocs2::approximateIntermediateLQ(optimalControlProblemStock_[taskId], timeTrajectory[timeIndex], stateTrajectory[timeIndex],
-                                      inputTrajectory[timeIndex], multiplierTrajectory[timeIndex], continuousTimeModelData);
-
-      // checking the numerical properties
-      if (settings().checkNumericalStability_) {
-        const auto errSize = checkSize(continuousTimeModelData, stateTrajectory[timeIndex].rows(), inputTrajectory[timeIndex].rows());
-        if (!errSize.empty()) {
-          throw std::runtime_error("[ILQR::approximateIntermediateLQ] Mismatch in dimensions at intermediate time: " +
-                                   std::to_string(timeTrajectory[timeIndex]) + "\n" + errSize);
-        }
-        const auto errProperties = checkDynamicsProperties(continuousTimeModelData) + checkCostProperties(continuousTimeModelData) +
-                                   checkConstraintProperties(continuousTimeModelData);
-        if (!errProperties.empty()) {
-          throw std::runtime_error("[ILQR::approximateIntermediateLQ] Ill-posed problem at intermediate time: " +
-                                   std::to_string(timeTrajectory[timeIndex]) + "\n" + errProperties);
-        }
-      }
-
-      // discretize LQ problem
-      const scalar_t timeStep = (timeIndex + 1 < timeTrajectory.size()) ? (timeTrajectory[timeIndex + 1] - timeTrajectory[timeIndex]) : 0.0;
-      if (!numerics::almost_eq(timeStep, 0.0)) {
-        discreteLQWorker(*optimalControlProblemStock_[taskId].dynamicsPtr, timeTrajectory[timeIndex], stateTrajectory[timeIndex],
-                         inputTrajectory[timeIndex], timeStep, continuousTimeModelData, modelDataTrajectory[timeIndex]);
-      } else {
-        modelDataTrajectory[timeIndex] = continuousTimeModelData;
-      }
+  const auto& time = timeTrajectory[timeIndex];
+  const auto& state = primalData.primalSolution.stateTrajectory_[timeIndex];
+  const auto& input = primalData.primalSolution.inputTrajectory_[timeIndex];
+  const auto& multiplier = dualSolution.intermediates[timeIndex];
+  ModelData& continuousTimeModelData = continuousTimeModelDataStock_[workerIndex];
+
+  // approximate continuous LQ for the given time index
+  ocs2::approximateIntermediateLQ(optimalControlProblemStock_[workerIndex], time, state, input, multiplier, continuousTimeModelData);
+
+  // checking the numerical properties
+  if (settings().checkNumericalStability_) {
+    const auto errSize = checkSize(continuousTimeModelData, state.rows(), input.rows());
+    if (!errSize.empty()) {
+      throw std::runtime_error("[ILQR::approximateIntermediateLQ] Mismatch in dimensions at intermediate time: " + std::to_string(time) +
+                               "\n" + errSize);
     }
-  };
+    numericalStabilityCheckerPtr_->check(timeIndex, time, continuousTimeModelData,
+                                         "[ILQR::approximateIntermediateLQ] Ill-posed problem at intermediate time");
+  }
 
-  runParallel(task, settings().nThreads_);
+  // discretize LQ problem
+  const scalar_t timeStep = (timeIndex + 1 < timeTrajectory.size()) ? (timeTrajectory[timeIndex + 1] - time) : 0.0;
+  if (!numerics::almost_eq(timeStep, 0.0)) {
+    // the next node starts a partition of the multiple-shooting forward pass, hence its defect enters the LQ model. The rollouts
+    // start weakEpsilon after the shooting times.
+    const auto& nextTime = timeTrajectory[timeIndex + 1];
+    const auto shootingTimeItr = std::lower_bound(shootingNodes_.times.cbegin(), shootingNodes_.times.cend(),
+                                                  nextTime - 2.0 * numeric_traits::weakEpsilon<scalar_t>());
+    const bool isShootingNode = shootingTimeItr != shootingNodes_.times.cend() && *shootingTimeItr <= nextTime;
+    const vector_t* nextStatePtr = isShootingNode ? &primalData.primalSolution.stateTrajectory_[timeIndex + 1] : nullptr;
+    discreteLQWorker(*optimalControlProblemStock_[workerIndex].dynamicsPtr, time, state, input, timeStep, continuousTimeModelData,
+                     primalData.modelDataTrajectory[timeIndex], nextStatePtr);
+  } else {
+    primalData.modelDataTrajectory[timeIndex] = continuousTimeModelData;
+  }
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 void ILQR::discreteLQWorker(SystemDynamicsBase& system, scalar_t time, const vector_t& state, const vector_t& input, scalar_t timeStep,
-                            const ModelData& continuousTimeModelData, ModelData& modelData) {
+                            const ModelData& continuousTimeModelData, ModelData& modelData, const vector_t* nextStatePtr) {
   modelData.time = continuousTimeModelData.time;
   modelData.stateDim = continuousTimeModelData.stateDim;
   modelData.inputDim = continuousTimeModelData.inputDim;
 
   // linearize system dynamics
-  modelData.dynamicsBias.setZero(modelData.stateDim);
   modelData.dynamics = sensitivityDiscretizer_(system, time, state, input, timeStep);
+  if (nextStatePtr != nullptr) {
+    modelData.dynamicsBias = modelData.dynamics.f - *nextStatePtr;
+  } else {
+    modelData.dynamicsBias.setZero(modelData.stateDim);
+  }
   modelData.dynamics.f.setZero(modelData.stateDim);
 
   // quadratic approximation to the cost function
@@ -185,11 +184,14 @@ void ILQR::calculateControllerWorker(size_t timeIndex, const PrimalDataContainer
 /***************************************************************************************************** */
 scalar_t ILQR::solveSequentialRiccatiEquations(const ScalarFunctionQuadraticApproximation& finalValueFunction) {
   const size_t N = nominalPrimalData_.primalSolution.timeTrajectory_.size();
-  projectedLvTrajectoryStock_.resize(N);
-  projectedKmTrajectoryStock_.resize(N);
+  numTrajectoryAllocations_ += resizeTrajectory(projectedLvTrajectoryStock_, N);
+  numTrajectoryAllocations_ += resizeTrajectory(projectedKmTrajectoryStock_, N);
+  if (settings().squareRootRiccati_) {
+    numTrajectoryAllocations_ += resizeTrajectory(SmFactorTrajectoryStock_, N);
+  }
 
-  nominalDualData_.riccatiModificationTrajectory.resize(N);
-  nominalDualData_.projectedModelDataTrajectory.resize(N);
+  numTrajectoryAllocations_ += resizeTrajectory(nominalDualData_.riccatiModificationTrajectory, N);
+  numTrajectoryAllocations_ += resizeTrajectory(nominalDualData_.projectedModelDataTrajectory, N);
 
   const auto& finalModelData = nominalPrimalData_.modelDataTrajectory.back();
   auto& finalRiccatiModification = nominalDualData_.riccatiModificationTrajectory.back();
@@ -233,11 +235,16 @@ void ILQR::riccatiEquationsWorker(size_t workerIndex, const std::pair<int, int>&
 
   // final temporal values. Used to store pre-jump value
   ScalarFunctionQuadraticApproximation finalValueTemp = finalValueFunction;
+  matrix_t finalSmFactorTemp;
+  if (settings().squareRootRiccati_) {
+    DiscreteTimeRiccatiEquations::computeSquareRootFactor(finalValueTemp.dfdxx, finalSmFactorTemp);
+  }
 
   /*
    * solving the Riccati equations
    */
   const ScalarFunctionQuadraticApproximation* valueFunctionNext = &finalValueTemp;
+  const matrix_t* SmFactorNext = &finalSmFactorTemp;
 
   int curIndex = partitionInterval.second - 1;
   auto nextEventItr = lastEventItr - 1;
@@ -255,9 +262,17 @@ void ILQR::riccatiEquationsWorker(size_t workerIndex, const std::pair<int, int>&
 
     computeProjectionAndRiccatiModification(curModelData, valueFunctionNext->dfdxx, curProjectedModelData, curRiccatiModification);
 
-    riccatiEquationsPtrStock_[workerIndex]->computeMap(curProjectedModelData, curRiccatiModification, valueFunctionNext->dfdxx,
-                                                       valueFunctionNext->dfdx, valueFunctionNext->f, curProjectedKm, curProjectedLv, curSm,
-                                                       curSv, curs);
+    if (settings().squareRootRiccati_) {
+      auto& curSmFactor = SmFactorTrajectoryStock_[curIndex];
+      riccatiEquationsPtrStock_[workerIndex]->computeMapSquareRoot(curProjectedModelData, curRiccatiModification, *SmFactorNext,
+                                                                   valueFunctionNext->dfdx, valueFunctionNext->f, curProjectedKm,
+                                                                   curProjectedLv, curSmFactor, curSm, curSv, curs);
+      SmFactorNext = &curSmFactor;
+    } else {
+      riccatiEquationsPtrStock_[workerIndex]->computeMap(curProjectedModelData, curRiccatiModification, valueFunctionNext->dfdxx,
+                                                         valueFunctionNext->dfdx, valueFunctionNext->f, curProjectedKm, curProjectedLv,
+                                                         curSm, curSv, curs);
+    }
     valueFunctionNext = &(nominalDualData_.valueFunctionTrajectory[curIndex]);
 
     if (std::distance(firstEventItr, nextEventItr) >= 0 && curIndex == *nextEventItr) {
@@ -290,6 +305,10 @@ void ILQR::riccatiEquationsWorker(size_t workerIndex, const std::pair<int, int>&
           finalProjectedModelData.dynamics.dfdu.transpose() * nominalDualData_.valueFunctionTrajectory[curIndex].dfdxx;
 
       valueFunctionNext = &finalValueTemp;
+      if (settings().squareRootRiccati_) {
+        DiscreteTimeRiccatiEquations::computeSquareRootFactor(finalValueTemp.dfdxx, finalSmFactorTemp);
+        SmFactorNext = &finalSmFactorTemp;
+      }
 
       --nextEventItr;
     }
@@ -0,0 +1,198 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_ddp/LqrTerminalCost.h"
+
+#include <algorithm>
+#include <iostream>
+
+#include <ocs2_core/misc/LinearInterpolation.h>
+
+namespace ocs2 {
+namespace continuous_time_lqr {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ValueFunctionTable::ValueFunctionTable(scalar_array_t schedulingGrid, matrix_array_t valueFunctions)
+    : schedulingGrid_(std::move(schedulingGrid)), valueFunctions_(std::move(valueFunctions)) {
+  if (schedulingGrid_.empty()) {
+    throw std::runtime_error("[ValueFunctionTable] The scheduling grid is empty!");
+  }
+  if (schedulingGrid_.size() != valueFunctions_.size()) {
+    throw std::runtime_error("[ValueFunctionTable] The scheduling grid and the value functions have different sizes!");
+  }
+  for (size_t i = 1; i < schedulingGrid_.size(); i++) {
+    if (!(schedulingGrid_[i - 1] < schedulingGrid_[i])) {
+      throw std::runtime_error("[ValueFunctionTable] The scheduling grid is not strictly increasing!");
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+matrix_t ValueFunctionTable::getValueFunction(scalar_t scheduling) const {
+  return LinearInterpolation::interpolate(scheduling, schedulingGrid_, valueFunctions_);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ValueFunctionTable solveValueFunctionTable(OptimalControlProblem& problem, std::vector<OperatingPoint> operatingPoints,
+                                           const Settings& settings) {
+  std::sort(operatingPoints.begin(), operatingPoints.end(),
+            [](const OperatingPoint& lhs, const OperatingPoint& rhs) { return lhs.scheduling < rhs.scheduling; });
+
+  scalar_array_t schedulingGrid;
+  matrix_array_t valueFunctions;
+  schedulingGrid.reserve(operatingPoints.size());
+  valueFunctions.reserve(operatingPoints.size());
+  for (const auto& point : operatingPoints) {
+    schedulingGrid.push_back(point.scheduling);
+    valueFunctions.push_back(solve(problem, point.time, point.state, point.input, settings).valueFunction);
+  }
+
+  return {std::move(schedulingGrid), std::move(valueFunctions)};
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ValueFunctionTableProvider::ValueFunctionTableProvider(ValueFunctionTable table)
+    : tablePtr_(std::make_shared<const ValueFunctionTable>(std::move(table))) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ValueFunctionTableProvider::~ValueFunctionTableProvider() {
+  wait();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::shared_ptr<const ValueFunctionTable> ValueFunctionTableProvider::getTable() const {
+  std::lock_guard<std::mutex> lock(tableMutex_);
+  return tablePtr_;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ValueFunctionTableProvider::setTable(ValueFunctionTable table) {
+  auto tablePtr = std::make_shared<const ValueFunctionTable>(std::move(table));
+  std::lock_guard<std::mutex> lock(tableMutex_);
+  tablePtr_.swap(tablePtr);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool ValueFunctionTableProvider::updateInBackground(std::unique_ptr<OptimalControlProblem> problemPtr,
+                                                    std::vector<OperatingPoint> operatingPoints, const Settings& settings) {
+  if (isUpdating_) {
+    return false;
+  }
+  wait();
+
+  isUpdating_ = true;
+  // the problem and operating points are moved into the worker through a shared state since C++11 lambdas cannot capture by move
+  auto problemSharedPtr = std::shared_ptr<OptimalControlProblem>(std::move(problemPtr));
+  auto operatingPointsPtr = std::make_shared<std::vector<OperatingPoint>>(std::move(operatingPoints));
+  workerThread_ = std::thread([this, problemSharedPtr, operatingPointsPtr, settings]() {
+    try {
+      setTable(solveValueFunctionTable(*problemSharedPtr, std::move(*operatingPointsPtr), settings));
+    } catch (const std::exception& e) {
+      std::cerr << "[ValueFunctionTableProvider] The background update failed, the previous table is kept: " << e.what() << "\n";
+    }
+    isUpdating_ = false;
+  });
+  return true;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ValueFunctionTableProvider::wait() {
+  if (workerThread_.joinable()) {
+    workerThread_.join();
+  }
+}
+
+}  // namespace continuous_time_lqr
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+LqrTerminalCost::LqrTerminalCost(std::shared_ptr<continuous_time_lqr::ValueFunctionTableProvider> tableProviderPtr,
+                                 scheduling_function_t schedulingFunction)
+    : tableProviderPtr_(std::move(tableProviderPtr)), schedulingFunction_(std::move(schedulingFunction)) {
+  if (tableProviderPtr_ == nullptr) {
+    throw std::runtime_error("[LqrTerminalCost] The value function table provider is not set!");
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+matrix_t LqrTerminalCost::getValueFunction(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories) const {
+  const auto tablePtr = tableProviderPtr_->getTable();
+  if (tablePtr == nullptr) {
+    throw std::runtime_error("[LqrTerminalCost] No value function table is available yet!");
+  }
+  return tablePtr->getValueFunction(schedulingFunction_(time, state, targetTrajectories));
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t LqrTerminalCost::getValue(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
+                                   const PreComputation&) const {
+  const matrix_t S = getValueFunction(time, state, targetTrajectories);
+  const vector_t xDeviation = state - targetTrajectories.getDesiredState(time);
+  return 0.5 * xDeviation.dot(S * xDeviation);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ScalarFunctionQuadraticApproximation LqrTerminalCost::getQuadraticApproximation(scalar_t time, const vector_t& state,
+                                                                                const TargetTrajectories& targetTrajectories,
+                                                                                const PreComputation&) const {
+  const vector_t xDeviation = state - targetTrajectories.getDesiredState(time);
+
+  ScalarFunctionQuadraticApproximation Phi;
+  Phi.dfdxx = getValueFunction(time, state, targetTrajectories);
+  Phi.dfdx.noalias() = Phi.dfdxx * xDeviation;
+  Phi.f = 0.5 * xDeviation.dot(Phi.dfdx);
+  return Phi;
+}
+
+}  // namespace ocs2
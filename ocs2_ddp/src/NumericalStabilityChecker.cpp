@@ -0,0 +1,193 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_ddp/NumericalStabilityChecker.h"
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <stdexcept>
+
+#include <ocs2_core/misc/Log.h>
+
+namespace ocs2 {
+
+namespace {
+/** Maps an integer to a uniformly distributed one, see the SplitMix64 generator. */
+uint64_t mixBits(uint64_t z) {
+  z += 0x9e3779b97f4a7c15ULL;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
+
+std::string checkProperties(const ModelData& modelData) {
+  return checkDynamicsProperties(modelData) + checkCostProperties(modelData) + checkConstraintProperties(modelData);
+}
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+NumericalStabilityChecker::NumericalStabilityChecker(scalar_t checkRatio, bool asynchronous, size_t maxQueueSize)
+    : checkRatio_(checkRatio), asynchronous_(asynchronous), maxQueueSize_(maxQueueSize) {
+  if (asynchronous_) {
+    thread_ = std::thread([this]() { backgroundWorker(); });
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+NumericalStabilityChecker::~NumericalStabilityChecker() {
+  if (thread_.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    newJobCondition_.notify_one();
+    thread_.join();
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool NumericalStabilityChecker::isSampled(size_t index) const {
+  if (checkRatio_ >= 1.0) {
+    return true;
+  } else if (checkRatio_ <= 0.0) {
+    return false;
+  }
+  const auto bits = mixBits(static_cast<uint64_t>(iteration_) * 0x100000001b3ULL + index);
+  // the 53 most significant bits give a uniform sample in [0, 1)
+  return static_cast<scalar_t>(bits >> 11) * (1.0 / 9007199254740992.0) < checkRatio_;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void NumericalStabilityChecker::check(size_t index, scalar_t time, const ModelData& modelData, const char* description) {
+  if (!isSampled(index)) {
+    return;
+  }
+
+  if (asynchronous_) {
+    enqueue(Job{time, description, [modelData]() { return checkProperties(modelData); }});
+  } else {
+    throwOnViolation(time, description, checkProperties(modelData));
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void NumericalStabilityChecker::checkValueFunction(size_t index, scalar_t time, const ScalarFunctionQuadraticApproximation& valueFunction,
+                                                   const char* description) {
+  if (!isSampled(index)) {
+    return;
+  }
+
+  if (asynchronous_) {
+    enqueue(Job{time, description, [valueFunction]() { return checkBeingPSD(valueFunction, "ValueFunction"); }});
+  } else {
+    throwOnViolation(time, description, checkBeingPSD(valueFunction, "ValueFunction"));
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void NumericalStabilityChecker::throwOnViolation(scalar_t time, const char* description, const std::string& err) {
+  ++numChecks_;
+  if (!err.empty()) {
+    ++numViolations_;
+    throw std::runtime_error(std::string(description) + ": " + std::to_string(time) + "\n" + err);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void NumericalStabilityChecker::enqueue(Job job) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (jobs_.size() >= maxQueueSize_) {
+      ++numSkippedChecks_;
+      return;
+    }
+    jobs_.push_back(std::move(job));
+  }
+  newJobCondition_.notify_one();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void NumericalStabilityChecker::waitForChecks() const {
+  std::unique_lock<std::mutex> lock(mutex_);
+  jobsDoneCondition_.wait(lock, [this]() { return jobs_.empty() && !isChecking_; });
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void NumericalStabilityChecker::backgroundWorker() {
+  // the thread only runs when a CPU would otherwise be idle
+  sched_param sched{};
+  pthread_setschedparam(pthread_self(), SCHED_IDLE, &sched);
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    newJobCondition_.wait(lock, [this]() { return stop_ || !jobs_.empty(); });
+    if (jobs_.empty()) {
+      // stop only once the queued checks are finished
+      return;
+    }
+    Job job = std::move(jobs_.front());
+    jobs_.pop_front();
+    isChecking_ = true;
+    lock.unlock();
+
+    ++numChecks_;
+    const auto err = job.check();
+    if (!err.empty()) {
+      ++numViolations_;
+      OCS2_WARN << job.description << ": " << job.time << "\n" << err;
+    }
+
+    lock.lock();
+    isChecking_ = false;
+    if (jobs_.empty()) {
+      jobsDoneCondition_.notify_all();
+    }
+  }
+}
+
+}  // namespace ocs2
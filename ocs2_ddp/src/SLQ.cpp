@@ -31,15 +31,74 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_ddp/DDP_HelperFunctions.h"
 #include "ocs2_ddp/riccati_equations/RiccatiModificationInterpolation.h"
+#include "ocs2_ddp/riccati_equations/RiccatiTransversalityConditions.h"
 
 namespace ocs2 {
 
+namespace {
+
+/**
+ * Discretizes the projected continuous-time LQ approximation over a time step dt with the second-order zero-order-hold scheme, i.e.
+ *  x(k+1) = (I + dt*Am + 0.5*dt^2*Am^2) x(k) + dt*(I + 0.5*dt*Am) (Bm u(k) + Hv)
+ *  cost = dt * L(x(k), u(k))
+ *
+ * The input is then transformed such that the Hessian of the Hamiltonian, Hm = dt*Rm + Bd'*SmNext*Bd = Lm*Lm', becomes identity which
+ * is the assumption of the reduced form of the projected discrete-time Riccati equations.
+ */
+void discretizeProjectedLQ(scalar_t dt, const ModelData& projectedModelData, const riccati_modification::Data& riccatiModification,
+                           const matrix_t& SmNext, ModelData& discreteModelData, riccati_modification::Data& discreteRiccatiModification) {
+  const auto& Am = projectedModelData.dynamics.dfdx;
+
+  discreteModelData.time = projectedModelData.time;
+  discreteModelData.stateDim = projectedModelData.stateDim;
+  discreteModelData.inputDim = projectedModelData.dynamics.dfdu.cols();
+
+  // dynamics: the input and bias matrices use dfdx = I + 0.5*dt*Am as a buffer
+  discreteModelData.dynamics.dfdx = (0.5 * dt) * Am;
+  discreteModelData.dynamics.dfdx.diagonal().array() += 1.0;
+  discreteModelData.dynamicsBias.noalias() = dt * (discreteModelData.dynamics.dfdx * projectedModelData.dynamicsBias);
+  discreteModelData.dynamics.dfdu.noalias() = dt * (discreteModelData.dynamics.dfdx * projectedModelData.dynamics.dfdu);
+  discreteModelData.dynamics.dfdx.noalias() = (0.5 * dt * dt) * (Am * Am);
+  discreteModelData.dynamics.dfdx.noalias() += dt * Am;
+  discreteModelData.dynamics.dfdx.diagonal().array() += 1.0;
+
+  // cost
+  discreteModelData.cost.f = dt * projectedModelData.cost.f;
+  discreteModelData.cost.dfdx = dt * projectedModelData.cost.dfdx;
+  discreteModelData.cost.dfdxx = dt * projectedModelData.cost.dfdxx;
+  discreteModelData.cost.dfdu = dt * projectedModelData.cost.dfdu;
+  discreteModelData.cost.dfdux = dt * projectedModelData.cost.dfdux;
+
+  // Riccati modification
+  discreteRiccatiModification.time_ = riccatiModification.time_;
+  discreteRiccatiModification.deltaQm_ = dt * riccatiModification.deltaQm_;
+  discreteRiccatiModification.deltaGm_ = dt * riccatiModification.deltaGm_;
+  discreteRiccatiModification.deltaGv_ = dt * riccatiModification.deltaGv_;
+
+  // Hm = dt * Rm + Bd' * SmNext * Bd
+  auto& Hm = discreteModelData.cost.dfduu;
+  Hm = dt * projectedModelData.cost.dfduu;
+  const matrix_t SmNextBd = SmNext * discreteModelData.dynamics.dfdu;
+  Hm.noalias() += discreteModelData.dynamics.dfdu.transpose() * SmNextBd;
+
+  // input transformation u = inv(Lm') * v
+  const Eigen::LLT<matrix_t> HmLLT(Hm);
+  HmLLT.matrixU().solveInPlace<Eigen::OnTheRight>(discreteModelData.dynamics.dfdu);
+  HmLLT.matrixL().solveInPlace(discreteModelData.cost.dfdu);
+  HmLLT.matrixL().solveInPlace(discreteModelData.cost.dfdux);
+  HmLLT.matrixL().solveInPlace(discreteRiccatiModification.deltaGm_);
+  HmLLT.matrixL().solveInPlace(discreteRiccatiModification.deltaGv_);
+  Hm.setIdentity();
+}
+
+}  // unnamed namespace
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 SLQ::SLQ(ddp::Settings ddpSettings, const RolloutBase& rollout, const OptimalControlProblem& optimalControlProblem,
-         const Initializer& initializer)
-    : GaussNewtonDDP(std::move(ddpSettings), rollout, optimalControlProblem, initializer) {
+         const Initializer& initializer, std::shared_ptr<ThreadPool> threadPoolPtr)
+    : GaussNewtonDDP(std::move(ddpSettings), rollout, optimalControlProblem, initializer, std::move(threadPoolPtr)) {
   if (settings().algorithm_ != ddp::Algorithm::SLQ) {
     throw std::runtime_error("[SLQ] In DDP setting the algorithm name is set \"" + ddp::toAlgorithmName(settings().algorithm_) +
                              "\" while SLQ is instantiated!");
@@ -56,11 +115,25 @@ SLQ::SLQ(ddp::Settings ddpSettings, const RolloutBase& rollout, const OptimalCon
 
   const auto integratorType = settings().backwardPassIntegratorType_;
   if (integratorType != IntegratorType::ODE45 && integratorType != IntegratorType::BULIRSCH_STOER &&
-      integratorType != IntegratorType::ODE45_OCS2 && integratorType != IntegratorType::RK4) {
+      integratorType != IntegratorType::ODE45_OCS2 && integratorType != IntegratorType::RK4 && integratorType != IntegratorType::ROS2) {
     throw(std::runtime_error("Unsupported Riccati equation integrator type: " +
                              integrator_type::toString(settings().backwardPassIntegratorType_)));
   }
 
+  if (settings().discreteRiccatiBackwardPass_) {
+    if (!numerics::almost_eq(settings().riskSensitiveCoeff_, 0.0)) {
+      throw std::runtime_error("[SLQ] The discrete Riccati backward pass does not support the risk sensitive variant!");
+    }
+    discreteRiccatiEquationsPtrStock_.reserve(settings().nThreads_);
+    for (size_t i = 0; i < settings().nThreads_; i++) {
+      discreteRiccatiEquationsPtrStock_.emplace_back(new DiscreteTimeRiccatiEquations(true));
+    }
+    discreteModelDataStock_.resize(settings().nThreads_);
+    discreteRiccatiModificationStock_.resize(settings().nThreads_);
+    projectedKmStock_.resize(settings().nThreads_);
+    projectedLvStock_.resize(settings().nThreads_);
+  }
+
   for (size_t i = 0; i < settings().nThreads_; i++) {
     bool preComputeRiccatiTerms = settings().preComputeRiccatiTerms_ && (settings().strategy_ == search_strategy::Type::LINE_SEARCH);
     bool isRiskSensitive = !numerics::almost_eq(settings().riskSensitiveCoeff_, 0.0);
@@ -75,50 +148,27 @@ SLQ::SLQ(ddp::Settings ddpSettings, const RolloutBase& rollout, const OptimalCon
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-void SLQ::approximateIntermediateLQ(const DualSolution& dualSolution, PrimalDataContainer& primalData) {
+void SLQ::approximateIntermediateLQ(int workerIndex, size_t timeIndex, const DualSolution& dualSolution, PrimalDataContainer& primalData) {
   // create alias
-  const auto& timeTrajectory = primalData.primalSolution.timeTrajectory_;
-  const auto& stateTrajectory = primalData.primalSolution.stateTrajectory_;
-  const auto& inputTrajectory = primalData.primalSolution.inputTrajectory_;
-  const auto& postEventIndices = primalData.primalSolution.postEventIndices_;
-  const auto& multiplierTrajectory = dualSolution.intermediates;
-  auto& modelDataTrajectory = primalData.modelDataTrajectory;
-
-  modelDataTrajectory.clear();
-  modelDataTrajectory.resize(timeTrajectory.size());
-
-  nextTimeIndex_ = 0;
-  nextTaskId_ = 0;
-  auto task = [&]() {
-    const size_t taskId = nextTaskId_++;  // assign task ID (atomic)
-
-    // get next time index is atomic
-    size_t timeIndex;
-    while ((timeIndex = nextTimeIndex_++) < timeTrajectory.size()) {
-      // approximate LQ for the given time index
-      ocs2::approximateIntermediateLQ(optimalControlProblemStock_[taskId], timeTrajectory[timeIndex], stateTrajectory[timeIndex],
-                                      inputTrajectory[timeIndex], multiplierTrajectory[timeIndex], modelDataTrajectory[timeIndex]);
-
-      // checking the numerical properties
-      if (settings().checkNumericalStability_) {
-        const auto errSize =
-            checkSize(modelDataTrajectory[timeIndex], stateTrajectory[timeIndex].rows(), inputTrajectory[timeIndex].rows());
-        if (!errSize.empty()) {
-          throw std::runtime_error("[SLQ::approximateIntermediateLQ] Mismatch in dimensions at intermediate time: " +
-                                   std::to_string(timeTrajectory[timeIndex]) + "\n" + errSize);
-        }
-        const std::string errProperties = checkDynamicsProperties(modelDataTrajectory[timeIndex]) +
-                                          checkCostProperties(modelDataTrajectory[timeIndex]) +
-                                          checkConstraintProperties(modelDataTrajectory[timeIndex]);
-        if (!errProperties.empty()) {
-          throw std::runtime_error("[SLQ::approximateIntermediateLQ] Ill-posed problem at intermediate time: " +
-                                   std::to_string(timeTrajectory[timeIndex]) + "\n" + errProperties);
-        }
-      }
-    }  // end of while loop
-  };
-
-  runParallel(task, settings().nThreads_);
+  const auto& time = primalData.primalSolution.timeTrajectory_[timeIndex];
+  const auto& state = primalData.primalSolution.stateTrajectory_[timeIndex];
+  const auto& input = primalData.primalSolution.inputTrajectory_[timeIndex];
+  const auto& multiplier = dualSolution.intermediates[timeIndex];
+  auto& modelData = primalData.modelDataTrajectory[timeIndex];
+
+  // approximate LQ for the given time index
+  ocs2::approximateIntermediateLQ(optimalControlProblemStock_[workerIndex], time, state, input, multiplier, modelData);
+
+  // checking the numerical properties
+  if (settings().checkNumericalStability_) {
+    const auto errSize = checkSize(modelData, state.rows(), input.rows());
+    if (!errSize.empty()) {
+      throw std::runtime_error("[SLQ::approximateIntermediateLQ] Mismatch in dimensions at intermediate time: " + std::to_string(time) +
+                               "\n" + errSize);
+    }
+    numericalStabilityCheckerPtr_->check(timeIndex, time, modelData,
+                                         "[SLQ::approximateIntermediateLQ] Ill-posed problem at intermediate time");
+  }
 }
 
 /******************************************************************************************************/
@@ -176,26 +226,20 @@ scalar_t SLQ::solveSequentialRiccatiEquations(const ScalarFunctionQuadraticAppro
   // number of the intermediate LQ variables
   const size_t N = nominalPrimalData_.primalSolution.timeTrajectory_.size();
 
-  nominalDualData_.riccatiModificationTrajectory.resize(N);
-  nominalDualData_.projectedModelDataTrajectory.resize(N);
+  numTrajectoryAllocations_ += resizeTrajectory(nominalDualData_.riccatiModificationTrajectory, N);
+  numTrajectoryAllocations_ += resizeTrajectory(nominalDualData_.projectedModelDataTrajectory, N);
 
   if (N > 0) {
     // perform the computeRiccatiModificationTerms for partition i
-    nextTimeIndex_ = 0;
-    nextTaskId_ = 0;
-    auto task = [this, N]() {
-      int timeIndex;
-      const matrix_t SmDummy = matrix_t::Zero(0, 0);
-
-      // get next time index is atomic
-      while ((timeIndex = nextTimeIndex_++) < N) {
-        computeProjectionAndRiccatiModification(nominalPrimalData_.modelDataTrajectory[timeIndex], SmDummy,
-                                                nominalDualData_.projectedModelDataTrajectory[timeIndex],
-                                                nominalDualData_.riccatiModificationTrajectory[timeIndex]);
-      }
+    const matrix_t SmDummy = matrix_t::Zero(0, 0);
+    auto task = [this, &SmDummy](int, int timeIndex) {
+      computeProjectionAndRiccatiModification(nominalPrimalData_.modelDataTrajectory[timeIndex], SmDummy,
+                                              nominalDualData_.projectedModelDataTrajectory[timeIndex],
+                                              nominalDualData_.riccatiModificationTrajectory[timeIndex]);
     };
-    runParallel(task, settings().nThreads_);
+    parallelFor(N, task);
   }
+  projectedModelDataTrajectory_.assign(nominalDualData_.projectedModelDataTrajectory);
 
   return solveSequentialRiccatiEquationsImpl(finalValueFunction);
 }
@@ -212,10 +256,15 @@ matrix_t SLQ::computeHamiltonianHessian(const ModelData& modelData, const matrix
 /******************************************************************************************************/
 void SLQ::riccatiEquationsWorker(size_t workerIndex, const std::pair<int, int>& partitionInterval,
                                  const ScalarFunctionQuadraticApproximation& finalValueFunction) {
+  if (settings().discreteRiccatiBackwardPass_) {
+    discreteRiccatiEquationsWorker(workerIndex, partitionInterval, finalValueFunction);
+    return;
+  }
+
   // set data for Riccati equations
   riccatiEquationsPtrStock_[workerIndex]->resetNumFunctionCalls();
   riccatiEquationsPtrStock_[workerIndex]->setData(
-      &(nominalPrimalData_.primalSolution.timeTrajectory_), &(nominalDualData_.projectedModelDataTrajectory),
+      &(nominalPrimalData_.primalSolution.timeTrajectory_), &projectedModelDataTrajectory_,
       &(nominalPrimalData_.primalSolution.postEventIndices_), &(nominalPrimalData_.modelDataEventTimes),
       &(nominalDualData_.riccatiModificationTrajectory));
 
@@ -250,6 +299,52 @@ void SLQ::riccatiEquationsWorker(size_t workerIndex, const std::pair<int, int>&
   }  // end of k loop
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SLQ::discreteRiccatiEquationsWorker(size_t workerIndex, const std::pair<int, int>& partitionInterval,
+                                         const ScalarFunctionQuadraticApproximation& finalValueFunction) {
+  const auto& timeTrajectory = nominalPrimalData_.primalSolution.timeTrajectory_;
+  const auto& postEventIndices = nominalPrimalData_.primalSolution.postEventIndices_;
+  auto& valueFunctionTrajectory = nominalDualData_.valueFunctionTrajectory;
+
+  auto& riccatiEquations = *discreteRiccatiEquationsPtrStock_[workerIndex];
+  auto& discreteModelData = discreteModelDataStock_[workerIndex];
+  auto& discreteRiccatiModification = discreteRiccatiModificationStock_[workerIndex];
+
+  // the last event which is not after the end of the partition
+  auto eventItr = std::upper_bound(postEventIndices.cbegin(), postEventIndices.cend(), partitionInterval.second);
+
+  const ScalarFunctionQuadraticApproximation* valueFunctionNext = &finalValueFunction;
+  for (int k = partitionInterval.second - 1; k >= partitionInterval.first; k--) {
+    auto& valueFunction = valueFunctionTrajectory[k];
+
+    while (eventItr != postEventIndices.cbegin() && *std::prev(eventItr) > k + 1) {
+      --eventItr;
+    }
+    if (eventItr != postEventIndices.cbegin() && *std::prev(eventItr) == k + 1) {
+      // k is the pre-event index of an event
+      --eventItr;
+      const auto eventIndex = std::distance(postEventIndices.cbegin(), eventItr);
+      std::tie(valueFunction.dfdxx, valueFunction.dfdx, valueFunction.f) = riccatiTransversalityConditions(
+          nominalPrimalData_.modelDataEventTimes[eventIndex], valueFunctionNext->dfdxx, valueFunctionNext->dfdx, valueFunctionNext->f);
+
+    } else if (timeTrajectory[k + 1] - timeTrajectory[k] < numeric_traits::weakEpsilon<scalar_t>()) {
+      valueFunction = *valueFunctionNext;
+
+    } else {
+      const scalar_t dt = timeTrajectory[k + 1] - timeTrajectory[k];
+      discretizeProjectedLQ(dt, nominalDualData_.projectedModelDataTrajectory[k], nominalDualData_.riccatiModificationTrajectory[k],
+                            valueFunctionNext->dfdxx, discreteModelData, discreteRiccatiModification);
+      riccatiEquations.computeMap(discreteModelData, discreteRiccatiModification, valueFunctionNext->dfdxx, valueFunctionNext->dfdx,
+                                  valueFunctionNext->f, projectedKmStock_[workerIndex], projectedLvStock_[workerIndex], valueFunction.dfdxx,
+                                  valueFunction.dfdx, valueFunction.f);
+    }
+
+    valueFunctionNext = &valueFunction;
+  }  // end of k loop
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -286,7 +381,7 @@ void SLQ::integrateRiccatiEquationNominalTime(IntegratorBase& riccatiIntegrator,
 
     // solve Riccati equations
     Observer observer(&allSsTrajectory);
-    const auto maxNumTimeSteps = static_cast<size_t>(settings().maxNumStepsPerSecond_ * std::max(1.0, partitionDuration));
+    const auto maxNumTimeSteps = static_cast<size_t>(settings().maxNumStepsPerSecond_ * std::max(scalar_t(1.0), partitionDuration));
     riccatiIntegrator.integrateTimes(riccatiEquation, observer, allSsFinal, beginTimeItr, endTimeItr, settings().timeStep_,
                                      settings().absTolODE_, settings().relTolODE_, maxNumTimeSteps);
 
@@ -3,6 +3,7 @@
 #include <ocs2_ddp/GaussNewtonDDP.h>
 
 #include <ocs2_ddp/ILQR.h>
+#include <ocs2_ddp/NumericalStabilityChecker.h>
 #include <ocs2_ddp/SLQ.h>
 
 // Riccati equations
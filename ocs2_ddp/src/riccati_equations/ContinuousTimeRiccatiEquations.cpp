@@ -28,7 +28,6 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  ******************************************************************************/
 
 #include <ocs2_core/misc/Lookup.h>
-#include <ocs2_core/model_data/ModelDataLinearInterpolation.h>
 
 #include <ocs2_ddp/riccati_equations/ContinuousTimeRiccatiEquations.h>
 #include <ocs2_ddp/riccati_equations/RiccatiModificationInterpolation.h>
@@ -40,7 +39,16 @@ namespace ocs2 {
 /******************************************************************************************************/
 /******************************************************************************************************/
 ContinuousTimeRiccatiEquations::ContinuousTimeRiccatiEquations(bool reducedFormRiccati, bool isRiskSensitive)
-    : reducedFormRiccati_(reducedFormRiccati), isRiskSensitive_(isRiskSensitive) {}
+    : reducedFormRiccati_(reducedFormRiccati), isRiskSensitive_(isRiskSensitive) {
+  flowMapFields_ = model_data::DYNAMICS_BIAS | model_data::DYNAMICS_DFDX | model_data::DYNAMICS_DFDU | model_data::COST_F |
+                   model_data::COST_DFDX | model_data::COST_DFDXX | model_data::COST_DFDU | model_data::COST_DFDUX;
+  if (!reducedFormRiccati_) {
+    flowMapFields_ |= model_data::COST_DFDUU;
+  }
+  if (isRiskSensitive_) {
+    flowMapFields_ |= model_data::DYNAMICS_COVARIANCE;
+  }
+}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -110,7 +118,7 @@ void ContinuousTimeRiccatiEquations::convert2Matrix(const vector_t& allSs, matri
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-void ContinuousTimeRiccatiEquations::setData(const scalar_array_t* timeStampPtr, const std::vector<ModelData>* projectedModelDataPtr,
+void ContinuousTimeRiccatiEquations::setData(const scalar_array_t* timeStampPtr, const ModelDataTrajectory* projectedModelDataPtr,
                                              const size_array_t* eventsPastTheEndIndecesPtr,
                                              const std::vector<ModelData>* modelDataEventTimesPtr,
                                              const std::vector<riccati_modification::Data>* riccatiModificationPtr) {
@@ -121,6 +129,7 @@ void ContinuousTimeRiccatiEquations::setData(const scalar_array_t* timeStampPtr,
   projectedModelDataPtr_ = projectedModelDataPtr;
   modelDataEventTimesPtr_ = modelDataEventTimesPtr;
   riccatiModificationPtr_ = riccatiModificationPtr;
+  timeSegmentCursor_ = static_cast<int>(timeStampPtr->size());
 
   eventTimes_.clear();
   eventTimes_.reserve(eventsPastTheEndIndecesPtr->size());
@@ -138,7 +147,7 @@ vector_t ContinuousTimeRiccatiEquations::computeJumpMap(scalar_t z, const vector
 
   // epsilon is set to include times past event times which have been artificially increased in the rollout
   const auto time = -z;
-  const auto index = lookup::findFirstIndexWithinTol(eventTimes_, time, 1e-5);
+  const auto index = lookup::findFirstIndexWithinTol(eventTimes_, time, scalar_t(1e-5));
 
   const auto SsPreEvent = riccatiTransversalityConditions((*modelDataEventTimesPtr_)[index], continuousTimeRiccatiData_.Sm_,
                                                           continuousTimeRiccatiData_.Sv_, continuousTimeRiccatiData_.s_);
@@ -152,7 +161,8 @@ vector_t ContinuousTimeRiccatiEquations::computeJumpMap(scalar_t z, const vector
 vector_t ContinuousTimeRiccatiEquations::computeFlowMap(scalar_t z, const vector_t& allSs) {
   // index
   const scalar_t t = -z;  // denormalized time
-  const auto indexAlpha = LinearInterpolation::timeSegment(t, *timeStampPtr_);
+  // the integration runs backward in time, therefore the cursor makes the lookup O(1)
+  const auto indexAlpha = LinearInterpolation::timeSegment(t, *timeStampPtr_, timeSegmentCursor_);
 
   convert2Matrix(allSs, continuousTimeRiccatiData_.Sm_, continuousTimeRiccatiData_.Sv_, continuousTimeRiccatiData_.s_);
   if (isRiskSensitive_) {
@@ -180,22 +190,13 @@ void ContinuousTimeRiccatiEquations::computeFlowMapSLQ(std::pair<int, scalar_t>
    * because of vectorization
    */
 
-  // Hv
-  creCache.projectedHv_ = LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::dynamicsBias);
-  // Am
-  creCache.projectedAm_ = LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::dynamics_dfdx);
-  // Bm
-  creCache.projectedBm_ = LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::dynamics_dfdu);
-  // q
-  ds = LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::cost_f);
-  // Qv
-  dSv = LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::cost_dfdx);
-  // Qm
-  dSm = LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::cost_dfdxx);
-  // Rv
-  creCache.projectedGv_ = LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::cost_dfdu);
-  // Pm
-  creCache.projectedGm_ = LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::cost_dfdux);
+  // all the fields of the projected model data which are used in the flow map are interpolated in one pass and in place
+  LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, flowMapFields_, creCache.projectedModelData_);
+  const auto& projectedModelData = creCache.projectedModelData_;
+  const vector_t& projectedHv = projectedModelData.dynamicsBias;
+  const matrix_t& projectedAm = projectedModelData.dynamics.dfdx;
+  const matrix_t& projectedBm = projectedModelData.dynamics.dfdu;
+  const matrix_t& projectedRm = projectedModelData.cost.dfduu;
   // delatQm
   creCache.deltaQm_ = LinearInterpolation::interpolate(indexAlpha, *riccatiModificationPtr_, riccati_modification::deltaQm);
   // delatGm
@@ -204,10 +205,12 @@ void ContinuousTimeRiccatiEquations::computeFlowMapSLQ(std::pair<int, scalar_t>
   creCache.projectedLv_ = LinearInterpolation::interpolate(indexAlpha, *riccatiModificationPtr_, riccati_modification::deltaGv);
 
   // projectedGm = projectedPm + projectedBm^T * Sm [COMPLEXITY: nx^2 * np]
-  creCache.projectedGm_.noalias() += creCache.projectedBm_.transpose() * Sm;
+  creCache.projectedGm_.noalias() = projectedBm.transpose() * Sm;
+  creCache.projectedGm_ += projectedModelData.cost.dfdux;
 
   // projectedGv = projectedRv + projectedBm^T * Sv [COMPLEXITY: nx * np]
-  creCache.projectedGv_.noalias() += creCache.projectedBm_.transpose() * Sv;
+  creCache.projectedGv_.noalias() = projectedBm.transpose() * Sv;
+  creCache.projectedGv_ += projectedModelData.cost.dfdu;
 
   // projected feedback
   creCache.projectedKm_ = -(creCache.projectedGm_ + creCache.projectedKm_);
@@ -216,15 +219,13 @@ void ContinuousTimeRiccatiEquations::computeFlowMapSLQ(std::pair<int, scalar_t>
 
   // precomputation
   // [COMPLEXITY: nx^3 + nx^2 * np]
-  creCache.SmTrans_projectedAm_.noalias() = Sm.transpose() * creCache.projectedAm_;
+  creCache.SmTrans_projectedAm_.noalias() = Sm.transpose() * projectedAm;
   creCache.projectedKm_T_projectedGm_.noalias() = creCache.projectedKm_.transpose() * creCache.projectedGm_;
   if (!reducedFormRiccati_) {
-    // Rm
-    creCache.projectedRm_ = LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::cost_dfduu);
     // [COMPLEXITY: nx * np^2]
-    creCache.projectedRm_projectedKm_.noalias() = creCache.projectedRm_ * creCache.projectedKm_;
+    creCache.projectedRm_projectedKm_.noalias() = projectedRm * creCache.projectedKm_;
     // [COMPLEXITY: np^2]
-    creCache.projectedRm_projectedLv_.noalias() = creCache.projectedRm_ * creCache.projectedLv_;
+    creCache.projectedRm_projectedLv_.noalias() = projectedRm * creCache.projectedLv_;
   }
 
   /*
@@ -235,7 +236,8 @@ void ContinuousTimeRiccatiEquations::computeFlowMapSLQ(std::pair<int, scalar_t>
    * other
    *   [TOTAL COMPLEXITY: (nx^3) + 3(nx^2 * np) + (nx * np^2)]
    */
-  // += deltaQm + Sm^T * Am + Am^T * Sm
+  // = Qm + deltaQm + Sm^T * Am + Am^T * Sm
+  dSm = projectedModelData.cost.dfdxx;
   dSm += creCache.deltaQm_ + creCache.SmTrans_projectedAm_ + creCache.SmTrans_projectedAm_.transpose();
   if (reducedFormRiccati_) {
     // += Km^T * Gm-
@@ -255,10 +257,11 @@ void ContinuousTimeRiccatiEquations::computeFlowMapSLQ(std::pair<int, scalar_t>
    * other
    *   [TOTAL COMPLEXITY: 2*(nx^2) + 3(nx * np)]
    */
-  // += Sm * Hv
-  dSv.noalias() += Sm.transpose() * creCache.projectedHv_;
+  // = Qv + Sm * Hv
+  dSv = projectedModelData.cost.dfdx;
+  dSv.noalias() += Sm.transpose() * projectedHv;
   // += Am^T * Sv
-  dSv.noalias() += creCache.projectedAm_.transpose() * Sv;
+  dSv.noalias() += projectedAm.transpose() * Sv;
   if (reducedFormRiccati_) {
     // += Gm^T * Lv
     dSv.noalias() += creCache.projectedGm_.transpose() * creCache.projectedLv_;
@@ -278,8 +281,8 @@ void ContinuousTimeRiccatiEquations::computeFlowMapSLQ(std::pair<int, scalar_t>
    * other
    *   [TOTAL COMPLEXITY: nx + 2np + np^2]
    */
-  // += Hv^T * Sv
-  ds += creCache.projectedHv_.dot(Sv);
+  // = q + Hv^T * Sv
+  ds = projectedModelData.cost.f + projectedHv.dot(Sv);
   if (reducedFormRiccati_) {
     // += 0.5 Lv^T Gv
     ds += 0.5 * creCache.projectedLv_.dot(creCache.projectedGv_);
@@ -299,11 +302,11 @@ void ContinuousTimeRiccatiEquations::computeFlowMapILEG(std::pair<int, scalar_t>
                                                         vector_t& dSv, scalar_t& ds) const {
   computeFlowMapSLQ(indexAlpha, Sm, Sv, s, creCache, dSm, dSv, ds);
 
-  // Sigma
-  creCache.dynamicsCovariance_ = LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::dynamicsCovariance);
+  // Sigma, which is interpolated in computeFlowMapSLQ
+  const matrix_t& dynamicsCovariance = creCache.projectedModelData_.dynamicsCovariance;
 
-  creCache.Sigma_Sv_.noalias() = creCache.dynamicsCovariance_ * Sv;
-  creCache.Sigma_Sm_.noalias() = creCache.dynamicsCovariance_ * Sm;
+  creCache.Sigma_Sv_.noalias() = dynamicsCovariance * Sv;
+  creCache.Sigma_Sm_.noalias() = dynamicsCovariance * Sm;
 
   dSm.noalias() += riskSensitiveCoeff_ * Sm.transpose() * creCache.Sigma_Sm_;
   dSv.noalias() += riskSensitiveCoeff_ * creCache.Sigma_Sm_.transpose() * Sv;
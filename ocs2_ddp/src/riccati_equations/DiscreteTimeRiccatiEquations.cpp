@@ -59,6 +59,128 @@ void DiscreteTimeRiccatiEquations::computeMap(const ModelData& projectedModelDat
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void DiscreteTimeRiccatiEquations::computeMapSquareRoot(const ModelData& projectedModelData,
+                                                        const riccati_modification::Data& riccatiModification,
+                                                        const matrix_t& SmNextFactor, const vector_t& SvNext, const scalar_t& sNext,
+                                                        matrix_t& projectedKm, vector_t& projectedLv, matrix_t& SmFactor, matrix_t& Sm,
+                                                        vector_t& Sv, scalar_t& s) {
+  if (isRiskSensitive_) {
+    throw std::runtime_error("[DiscreteTimeRiccatiEquations] The square-root form does not support the risk sensitive variant!");
+  }
+
+  auto& dreCache = discreteTimeRiccatiData_;
+  const auto stateDim = projectedModelData.stateDim;
+  const auto& Am = projectedModelData.dynamics.dfdx;
+  const auto& Bm = projectedModelData.dynamics.dfdu;
+  const auto& Hv = projectedModelData.dynamicsBias;
+  const auto& Pm = projectedModelData.cost.dfdux;
+  const auto& Rm = projectedModelData.cost.dfduu;
+  const auto U = SmNextFactor.triangularView<Eigen::Upper>();
+
+  // precomputation (1): triangular products with the factor of SmNext
+  dreCache.U_projectedAm_.noalias() = U * Am;
+  dreCache.U_projectedBm_.noalias() = U * Bm;
+  dreCache.U_projectedHv_.noalias() = U * Hv;
+  dreCache.Sm_projectedHv_.noalias() = U.transpose() * dreCache.U_projectedHv_;
+  dreCache.Sv_plus_Sm_projectedHv_ = SvNext + dreCache.Sm_projectedHv_;
+
+  // projectedGm = projectedPm + (U * projectedBm)^T * (U * projectedAm)
+  dreCache.projectedGm_ = Pm;
+  dreCache.projectedGm_.noalias() += dreCache.U_projectedBm_.transpose() * dreCache.U_projectedAm_;
+
+  // projectedGv = projectedRv + projectedBm^T * (Sv + Sm * projectedHv)
+  dreCache.projectedGv_ = projectedModelData.cost.dfdu;
+  dreCache.projectedGv_.noalias() += Bm.transpose() * dreCache.Sv_plus_Sm_projectedHv_;
+
+  // projectedHm = projectedRm + (U * projectedBm)^T * (U * projectedBm)
+  dreCache.projectedHm_ = Rm;
+  dreCache.projectedHm_.noalias() += dreCache.U_projectedBm_.transpose() * dreCache.U_projectedBm_;
+
+  // projected feedback
+  projectedKm = -dreCache.projectedGm_ - riccatiModification.deltaGm_;
+  // projected feedforward
+  projectedLv = -dreCache.projectedGv_ - riccatiModification.deltaGv_;
+
+  dreCache.projectedHm_projectedKm_.noalias() = dreCache.projectedHm_ * projectedKm;
+  dreCache.projectedHm_projectedLv_.noalias() = dreCache.projectedHm_ * projectedLv;
+
+  /*
+   * SmFactor: Sm = (Am + Bm * Km)^T * SmNext * (Am + Bm * Km) + closedLoopCost
+   */
+  // closedLoopCost = Qm + deltaQm + Km^T * Pm + Pm^T * Km + Km^T * Rm * Km
+  dreCache.projectedPm_projectedKm_.noalias() = Pm.transpose() * projectedKm;
+  dreCache.closedLoopCost_ = projectedModelData.cost.dfdxx + riccatiModification.deltaQm_;
+  dreCache.closedLoopCost_ += dreCache.projectedPm_projectedKm_ + dreCache.projectedPm_projectedKm_.transpose();
+  dreCache.closedLoopCost_.noalias() += projectedKm.transpose() * (Rm * projectedKm);
+  computeSquareRootFactor(dreCache.closedLoopCost_, dreCache.closedLoopCostFactor_);
+
+  // stack [closedLoopCostFactor; U * (Am + Bm * Km)] and take the triangular factor of its QR decomposition
+  dreCache.stackedFactors_.resize(2 * stateDim, stateDim);
+  dreCache.stackedFactors_.topRows(stateDim) = dreCache.closedLoopCostFactor_;
+  dreCache.stackedFactors_.bottomRows(stateDim) = dreCache.U_projectedAm_;
+  dreCache.stackedFactors_.bottomRows(stateDim).noalias() += dreCache.U_projectedBm_ * projectedKm;
+  dreCache.stackedFactorsQR_.compute(dreCache.stackedFactors_);
+  SmFactor = dreCache.stackedFactorsQR_.matrixQR().topRows(stateDim).triangularView<Eigen::Upper>();
+
+  /*
+   * Sm = SmFactor^T * SmFactor, symmetric by construction
+   */
+  Sm.setZero(stateDim, stateDim);
+  Sm.selfadjointView<Eigen::Upper>().rankUpdate(SmFactor.transpose());
+  Sm.triangularView<Eigen::StrictlyLower>() = Sm.transpose();
+
+  /*
+   * Sv
+   */
+  // = Qv
+  Sv = projectedModelData.cost.dfdx;
+  // += Am^T * (Sv + Sm * Hv)
+  Sv.noalias() += Am.transpose() * dreCache.Sv_plus_Sm_projectedHv_;
+  // += Gm^T * Lv
+  Sv.noalias() += dreCache.projectedGm_.transpose() * projectedLv;
+  // += Km^T * Gv
+  Sv.noalias() += projectedKm.transpose() * dreCache.projectedGv_;
+  // += Km^T * Hm * Lv
+  Sv.noalias() += dreCache.projectedHm_projectedKm_.transpose() * projectedLv;
+
+  /*
+   * s
+   */
+  // = s + q
+  s = sNext + projectedModelData.cost.f;
+  // += Hv^T * (Sv + Sm * Hv)
+  s += Hv.dot(dreCache.Sv_plus_Sm_projectedHv_);
+  // -= 0.5 Hv^T * Sm * Hv
+  s -= 0.5 * dreCache.U_projectedHv_.squaredNorm();
+  // += Lv^T Gv
+  s += projectedLv.dot(dreCache.projectedGv_);
+  // += 0.5 Lv^T Hm Lv
+  s += 0.5 * projectedLv.dot(dreCache.projectedHm_projectedLv_);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void DiscreteTimeRiccatiEquations::computeSquareRootFactor(const matrix_t& Sm, matrix_t& SmFactor) {
+  const Eigen::LLT<matrix_t> llt(Sm);
+  if (llt.info() == Eigen::Success) {
+    SmFactor = llt.matrixU();
+    return;
+  }
+
+  // Sm = P^T * L * D * L^T * P, hence the factor of its positive semi-definite part is sqrt(max(D, 0)) * L^T * P
+  const Eigen::LDLT<matrix_t> ldlt(Sm);
+  const vector_t sqrtD = ldlt.vectorD().cwiseMax(0.0).cwiseSqrt();
+  const matrix_t factor = sqrtD.asDiagonal() * matrix_t(ldlt.matrixU()) * ldlt.transpositionsP();
+
+  // triangularize the factor
+  const Eigen::HouseholderQR<matrix_t> qr(factor);
+  SmFactor = qr.matrixQR().triangularView<Eigen::Upper>();
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -113,6 +235,8 @@ void DiscreteTimeRiccatiEquations::computeMapILQR(const ModelData& projectedMode
     // += Km^T * Hm * Km
     Sm.noalias() += projectedKm.transpose() * dreCache.projectedHm_projectedKm_;
   }
+  // the recursion does not preserve the symmetry under round-off errors
+  Sm = 0.5 * (Sm + Sm.transpose()).eval();
 
   /*
    * Sv
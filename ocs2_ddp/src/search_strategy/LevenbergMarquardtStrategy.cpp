@@ -54,6 +54,7 @@ LevenbergMarquardtStrategy::LevenbergMarquardtStrategy(search_strategy::Settings
 /******************************************************************************************************/
 void LevenbergMarquardtStrategy::reset() {
   lmModule_ = LevenbergMarquardtModule();
+  isLastStepFull_ = false;
 }
 
 /******************************************************************************************************/
@@ -71,12 +72,18 @@ bool LevenbergMarquardtStrategy::run(const std::pair<scalar_t, scalar_t>& timePe
 
   // stepsize
   const scalar_t stepLength = numerics::almost_eq(expectedReduction, 0.0) ? 0.0 : 1.0;
+  const bool isFullStep = stepLength == 1.0 && lmModule_.riccatiMultiple == 0.0;  // the multiple is adjusted below for the next step
+  isLastStepFull_ = false;
 
   try {
     // compute primal solution
     solution.primalSolution.modeSchedule_ = modeSchedule;
     incrementController(stepLength, unoptimizedController, getLinearController(solution.primalSolution));
-    solution.avgTimeStep = rolloutTrajectory(rolloutRef_, timePeriod.first, initState, timePeriod.second, solution.primalSolution);
+    {
+      benchmark::TraceScope rolloutScope(tracerPtr_, "Rollout");
+      numTrials_.fetch_add(1, std::memory_order_relaxed);
+      solution.avgTimeStep = rolloutTrajectory(rolloutRef_, timePeriod.first, initState, timePeriod.second, solution.primalSolution);
+    }
 
     // adjust dual solution only if it is required
     const DualSolution* adjustedDualSolutionPtr = &dualSolution;
@@ -94,11 +101,8 @@ bool LevenbergMarquardtStrategy::run(const std::pair<scalar_t, scalar_t>& timePe
     // initialize dual solution
     initializeDualSolution(optimalControlProblemRef_, solution.primalSolution, *adjustedDualSolutionPtr, solution.dualSolution);
 
-    // compute problem metrics
-    computeRolloutMetrics(optimalControlProblemRef_, solution.primalSolution, solution.dualSolution, solution.problemMetrics);
-
-    // compute performanceIndex
-    solution.performanceIndex = computeRolloutPerformanceIndex(solution.primalSolution.timeTrajectory_, solution.problemMetrics);
+    // compute performanceIndex. The metrics of the rollout points are computed on demand, see GaussNewtonDDP::getSolutionMetrics()
+    solution.performanceIndex = computeRolloutPerformanceIndex(optimalControlProblemRef_, solution.primalSolution, solution.dualSolution);
     solution.performanceIndex.merit = meritFunc_(solution.performanceIndex);
 
     // display
@@ -129,7 +133,7 @@ bool LevenbergMarquardtStrategy::run(const std::pair<scalar_t, scalar_t>& timePe
   // adjust riccatiMultipleAdaptiveRatio and riccatiMultiple
   if (pho < 0.25) {
     // increase riccatiMultipleAdaptiveRatio
-    lmModule_.riccatiMultipleAdaptiveRatio = std::max(1.0, lmModule_.riccatiMultipleAdaptiveRatio) * settings_.riccatiMultipleDefaultRatio;
+    lmModule_.riccatiMultipleAdaptiveRatio = std::max(scalar_t(1.0), lmModule_.riccatiMultipleAdaptiveRatio) * settings_.riccatiMultipleDefaultRatio;
 
     // increase riccatiMultiple
     const auto riccatiMultipleTemp = lmModule_.riccatiMultipleAdaptiveRatio * lmModule_.riccatiMultiple;
@@ -137,7 +141,7 @@ bool LevenbergMarquardtStrategy::run(const std::pair<scalar_t, scalar_t>& timePe
 
   } else if (pho > 0.75) {
     // decrease riccatiMultipleAdaptiveRatio
-    lmModule_.riccatiMultipleAdaptiveRatio = std::min(1.0, lmModule_.riccatiMultipleAdaptiveRatio) / settings_.riccatiMultipleDefaultRatio;
+    lmModule_.riccatiMultipleAdaptiveRatio = std::min(scalar_t(1.0), lmModule_.riccatiMultipleAdaptiveRatio) / settings_.riccatiMultipleDefaultRatio;
 
     // decrease riccatiMultiple
     const auto riccatiMultipleTemp = lmModule_.riccatiMultipleAdaptiveRatio * lmModule_.riccatiMultiple;
@@ -179,6 +183,7 @@ bool LevenbergMarquardtStrategy::run(const std::pair<scalar_t, scalar_t>& timePe
   if (pho >= settings_.minAcceptedPho) {
     // accept the solution
     lmModule_.numSuccessiveRejections = 0;
+    isLastStepFull_ = isFullStep;
     return true;
 
   } else {
@@ -32,6 +32,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ocs2_ddp/DDP_HelperFunctions.h"
 #include "ocs2_ddp/HessianCorrection.h"
 
+#include <tuple>
+
 #include <ocs2_oc/oc_problem/OptimalControlProblemHelperFunction.h>
 #include <ocs2_oc/trajectory_adjustment/TrajectorySpreadingHelperFunctions.h>
 
@@ -84,14 +86,29 @@ size_t LineSearchStrategy::maxNumOfSearches() const {
 /******************************************************************************************************/
 /******************************************************************************************************/
 void LineSearchStrategy::computeSolution(size_t taskId, scalar_t stepLength, search_strategy::Solution& solution) {
+  benchmark::TraceScope trialScope(tracerPtr_, "Line-Search Trial");
+  numTrials_.fetch_add(1, std::memory_order_relaxed);
   auto& problem = optimalControlProblemRefStock_[taskId];
   auto& rollout = rolloutRefStock_[taskId];
 
   // compute primal solution
   solution.primalSolution.modeSchedule_ = *lineSearchInputRef_.modeSchedulePtr;
   incrementController(stepLength, *lineSearchInputRef_.unoptimizedControllerPtr, getLinearController(solution.primalSolution));
-  solution.avgTimeStep = rolloutTrajectory(rollout, lineSearchInputRef_.timePeriodPtr->first, *lineSearchInputRef_.initStatePtr,
-                                           lineSearchInputRef_.timePeriodPtr->second, solution.primalSolution);
+  scalar_t defectsSSE = 0.0;
+  if (isMultipleShooting()) {
+    benchmark::TraceScope rolloutScope(tracerPtr_, "Rollout");
+    shootingStates_.resize(shootingNodesPtr_->states.size());
+    for (size_t i = 0; i < shootingStates_.size(); i++) {
+      shootingStates_[i] = shootingNodesPtr_->states[i] + stepLength * shootingNodesPtr_->stateUpdates[i];
+    }
+    std::tie(solution.avgTimeStep, defectsSSE) = rolloutMultipleShootingTrajectory(
+        threadPoolRef_, rolloutRefStock_, lineSearchInputRef_.timePeriodPtr->first, *lineSearchInputRef_.initStatePtr,
+        lineSearchInputRef_.timePeriodPtr->second, shootingNodesPtr_->times, shootingStates_, solution.primalSolution);
+  } else {
+    benchmark::TraceScope rolloutScope(tracerPtr_, "Rollout");
+    solution.avgTimeStep = rolloutTrajectory(rollout, lineSearchInputRef_.timePeriodPtr->first, *lineSearchInputRef_.initStatePtr,
+                                             lineSearchInputRef_.timePeriodPtr->second, solution.primalSolution);
+  }
 
   // adjust dual solution only if it is required
   const DualSolution* adjustedDualSolutionPtr = lineSearchInputRef_.dualSolutionPtr;
@@ -110,11 +127,9 @@ void LineSearchStrategy::computeSolution(size_t taskId, scalar_t stepLength, sea
   // initialize dual solution
   initializeDualSolution(problem, solution.primalSolution, *adjustedDualSolutionPtr, solution.dualSolution);
 
-  // compute problem metrics
-  computeRolloutMetrics(problem, solution.primalSolution, solution.dualSolution, solution.problemMetrics);
-
-  // compute performanceIndex
-  solution.performanceIndex = computeRolloutPerformanceIndex(solution.primalSolution.timeTrajectory_, solution.problemMetrics);
+  // compute performanceIndex. The metrics of the rollout points are computed on demand, see GaussNewtonDDP::getSolutionMetrics()
+  solution.performanceIndex = computeRolloutPerformanceIndex(problem, solution.primalSolution, solution.dualSolution);
+  solution.performanceIndex.dynamicsViolationSSE = defectsSSE;
   solution.performanceIndex.merit = meritFunc_(solution.performanceIndex);
 
   // display
@@ -164,8 +179,15 @@ bool LineSearchStrategy::run(const std::pair<scalar_t, scalar_t>& timePeriod, co
   nextTaskId_ = 0;
   alphaExpNext_ = 0;
   alphaProcessed_ = std::vector<bool>(maxNumOfSearches(), false);
-  auto task = [&](int) { lineSearchTask(nextTaskId_++); };
-  threadPoolRef_.runParallel(task, threadPoolRef_.numThreads());
+  if (isMultipleShooting()) {
+    // the partitions of each trial already run in parallel
+    lineSearchTask(0);
+  } else {
+    auto task = [&](int) { lineSearchTask(nextTaskId_++); };
+    // the pool might be shared with other clients, hence it is limited to the number of thread resources
+    const size_t numTasks = std::min(threadPoolRef_.numThreads(), rolloutRefStock_.size() - 1);
+    threadPoolRef_.runParallel(task, numTasks);
+  }
 
   // revitalize all integrators
   for (RolloutBase& rollout : rolloutRefStock_) {
@@ -197,6 +219,15 @@ void LineSearchStrategy::lineSearchTask(const size_t taskId) {
       break;
     }
 
+    // out of time: keep the best candidate found so far, which is at least the rollout with step length zero
+    if (std::chrono::steady_clock::now() >= deadline_) {
+      if (baseSettings_.displayInfo) {
+        printString("    [Thread " + std::to_string(taskId) + "] rollout with step length " + std::to_string(stepLength) +
+                    " is skipped: The deadline has been reached!\n");
+      }
+      break;
+    }
+
     // skip if the current learning rate is less than the best candidate
     if (stepLength < bestStepSize_) {
       // display
@@ -268,7 +299,8 @@ std::pair<bool, std::string> LineSearchStrategy::checkConvergence(bool unreliabl
       previousPerformanceIndex.cost + previousPerformanceIndex.equalityLagrangian + previousPerformanceIndex.inequalityLagrangian;
   const scalar_t relCost = std::abs(currentTotalCost - previousTotalCost);
   const bool isCostFunctionConverged = relCost <= baseSettings_.minRelCost;
-  const bool isConstraintsSatisfied = currentPerformanceIndex.equalityConstraintsSSE <= baseSettings_.constraintTolerance;
+  const bool isConstraintsSatisfied = currentPerformanceIndex.equalityConstraintsSSE <= baseSettings_.constraintTolerance &&
+                                      currentPerformanceIndex.dynamicsViolationSSE <= baseSettings_.constraintTolerance;
   const bool isOptimizationConverged = isCostFunctionConverged && isConstraintsSatisfied;
 
   // convergence info
@@ -281,6 +313,11 @@ std::pair<bool, std::string> LineSearchStrategy::checkConvergence(bool unreliabl
 
     infoStream << "    * The SSE of equality constraints (i.e., " << currentPerformanceIndex.equalityConstraintsSSE
                << ") has reached to its minimum value (" << baseSettings_.constraintTolerance << ").";
+
+    if (isMultipleShooting()) {
+      infoStream << "\n    * The SSE of the shooting defects (i.e., " << currentPerformanceIndex.dynamicsViolationSSE
+                 << ") has reached to its minimum value (" << baseSettings_.constraintTolerance << ").";
+    }
   }
 
   return {isOptimizationConverged, infoStream.str()};
@@ -28,6 +28,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
 #include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
 #include <cstdlib>
 #include <ctime>
 #include <iostream>
@@ -35,10 +37,16 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/control/FeedforwardController.h>
 #include <ocs2_core/initialization/DefaultInitializer.h>
 #include <ocs2_oc/rollout/TimeTriggeredRollout.h>
+#include <ocs2_oc/synchronized_module/SolutionDatabase.h>
 #include <ocs2_oc/test/EXP0.h>
 
+#include <ocs2_ddp/DDP_DataCollector.h>
+#include <ocs2_ddp/GaussNewtonDDP_MPC.h>
 #include <ocs2_ddp/ILQR.h>
 #include <ocs2_ddp/SLQ.h>
+#include <ocs2_mpc/ClosedLoopSimulation.h>
+#include <ocs2_mpc/ContingencyMpc.h>
+#include <ocs2_mpc/MPC_MRT_Interface.h>
 
 class Exp0 : public testing::Test {
  protected:
@@ -151,6 +159,20 @@ TEST_F(Exp0, ddp_feedback_policy) {
   EXPECT_TRUE(ctrlPtr != nullptr) << "MESSAGE: SLQ solution does not contain a linear feedback policy!";
   EXPECT_DOUBLE_EQ(ctrlPtr->timeStamp_.back(), finalTime) << "MESSAGE: SLQ failed in policy final time of controller!";
   EXPECT_DOUBLE_EQ(solution.timeTrajectory_.back(), finalTime) << "MESSAGE: SLQ failed in policy final time of trajectory!";
+
+  // the storage of a previous policy is reused
+  const ocs2::scalar_t windowTime = 0.5 * (startTime + finalTime);
+  const auto windowSolution = ddp.primalSolution(windowTime);
+  ocs2::PrimalSolution reusedSolution = solution;
+  ddp.getPrimalSolution(windowTime, &reusedSolution);
+  const auto* windowCtrlPtr = dynamic_cast<ocs2::LinearController*>(windowSolution.controllerPtr_.get());
+  const auto* reusedCtrlPtr = dynamic_cast<ocs2::LinearController*>(reusedSolution.controllerPtr_.get());
+  ASSERT_TRUE(reusedCtrlPtr != nullptr);
+  EXPECT_EQ(reusedSolution.timeTrajectory_, windowSolution.timeTrajectory_);
+  EXPECT_EQ(reusedSolution.stateTrajectory_.size(), windowSolution.stateTrajectory_.size());
+  EXPECT_EQ(reusedCtrlPtr->timeStamp_, windowCtrlPtr->timeStamp_);
+  EXPECT_EQ(reusedCtrlPtr->gainArray_.size(), windowCtrlPtr->gainArray_.size());
+  EXPECT_TRUE(reusedCtrlPtr->gainArray_.back().isApprox(windowCtrlPtr->gainArray_.back()));
 }
 
 /******************************************************************************************************/
@@ -294,6 +316,450 @@ TEST_F(Exp0, ddp_hamiltonian) {
   EXPECT_FALSE(dHdu3.isZero(precision)) << "MESSAGE for test 3: Derivative of Hamiltonian w.r.t. to u is zero: " << dHdu3.transpose();
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_F(Exp0, ddp_discrete_riccati_backward_pass) {
+  // dynamics and rollout
+  ocs2::EXP0_System systemDynamics(referenceManagerPtr);
+  ocs2::TimeTriggeredRollout rollout(systemDynamics, rolloutSettings());
+
+  // solves the problem and returns the run time in milliseconds
+  auto solve = [&](const ocs2::ddp::Settings& ddpSettings, ocs2::PerformanceIndex& performanceIndex, size_t& numIterations) {
+    ocs2::SLQ ddp(ddpSettings, rollout, problem, *initializerPtr);
+    ddp.setReferenceManager(referenceManagerPtr);
+    const auto start = std::chrono::steady_clock::now();
+    ddp.run(startTime, initState, finalTime);
+    const auto end = std::chrono::steady_clock::now();
+    performanceIndex = ddp.getPerformanceIndeces();
+    numIterations = ddp.getNumIterations();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+  };
+
+  auto ddpSettings = getSettings(ocs2::ddp::Algorithm::SLQ, 1, ocs2::search_strategy::Type::LINE_SEARCH);
+  ocs2::PerformanceIndex ode45Performance;
+  size_t ode45Iterations;
+  const auto ode45Time = solve(ddpSettings, ode45Performance, ode45Iterations);
+
+  ddpSettings.discreteRiccatiBackwardPass_ = true;
+  ocs2::PerformanceIndex discretePerformance;
+  size_t discreteIterations;
+  const auto discreteTime = solve(ddpSettings, discretePerformance, discreteIterations);
+
+  std::cerr << "[Exp0] ODE45 backward pass:    cost " << ode45Performance.cost << ",\titerations " << ode45Iterations << ",\trun time "
+            << ode45Time << " [ms]\n";
+  std::cerr << "[Exp0] Discrete backward pass: cost " << discretePerformance.cost << ",\titerations " << discreteIterations
+            << ",\trun time " << discreteTime << " [ms]\n";
+
+  // the backward pass only changes the search direction, therefore both converge to the same optimum
+  performanceIndexTest(ddpSettings, discretePerformance);
+  EXPECT_NEAR(discretePerformance.cost, ode45Performance.cost, 10.0 * minRelCost);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_F(Exp0, ddp_square_root_riccati) {
+  // dynamics and rollout
+  ocs2::EXP0_System systemDynamics(referenceManagerPtr);
+  ocs2::TimeTriggeredRollout rollout(systemDynamics, rolloutSettings());
+
+  auto solve = [&](const ocs2::ddp::Settings& ddpSettings) {
+    ocs2::ILQR ddp(ddpSettings, rollout, problem, *initializerPtr);
+    ddp.setReferenceManager(referenceManagerPtr);
+    ddp.run(startTime, initState, finalTime);
+    return ddp.getPerformanceIndeces();
+  };
+
+  auto ddpSettings = getSettings(ocs2::ddp::Algorithm::ILQR, 1, ocs2::search_strategy::Type::LINE_SEARCH);
+  const auto performance = solve(ddpSettings);
+
+  ddpSettings.squareRootRiccati_ = true;
+  const auto squareRootPerformance = solve(ddpSettings);
+
+  // the square-root form only changes the round-off errors of the backward pass, therefore both converge to the same optimum
+  performanceIndexTest(ddpSettings, squareRootPerformance);
+  EXPECT_NEAR(squareRootPerformance.cost, performance.cost, 10.0 * minRelCost);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_F(Exp0, ddp_lq_reuse) {
+  // a fixed step rollout keeps the time grid between the iterations
+  auto settings = rolloutSettings();
+  settings.integratorType = ocs2::IntegratorType::RK4;
+  ocs2::EXP0_System systemDynamics(referenceManagerPtr);
+  ocs2::TimeTriggeredRollout rollout(systemDynamics, settings);
+
+  auto solve = [&](const ocs2::ddp::Settings& ddpSettings, std::string& benchmarkingInfo) {
+    ocs2::ILQR ddp(ddpSettings, rollout, problem, *initializerPtr);
+    ddp.setReferenceManager(referenceManagerPtr);
+    ddp.run(startTime, initState, finalTime);
+    benchmarkingInfo = ddp.getBenchmarkingInfo();
+    return ddp.getPerformanceIndeces();
+  };
+
+  auto ddpSettings = getSettings(ocs2::ddp::Algorithm::ILQR, 1, ocs2::search_strategy::Type::LINE_SEARCH);
+  std::string benchmarkingInfo;
+  const auto performance = solve(ddpSettings, benchmarkingInfo);
+  EXPECT_EQ(benchmarkingInfo.find("LQ reuse rate"), std::string::npos);
+
+  // a large tolerance such that the reuse happens before the convergence
+  ddpSettings.lqReuseTolerance_ = 1.0;
+  const auto reusePerformance = solve(ddpSettings, benchmarkingInfo);
+  std::cerr << benchmarkingInfo;
+  EXPECT_NE(benchmarkingInfo.find("LQ reuse rate"), std::string::npos);
+
+  // the cost of Exp0 is quadratic and its dynamics are linear in each mode, therefore the reused approximations are exact
+  EXPECT_NEAR(reusePerformance.cost, performance.cost, 10.0 * minRelCost);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_F(Exp0, ddp_sampled_numerical_stability_check) {
+  ocs2::EXP0_System systemDynamics(referenceManagerPtr);
+  ocs2::TimeTriggeredRollout rollout(systemDynamics, rolloutSettings());
+
+  auto ddpSettings = getSettings(ocs2::ddp::Algorithm::SLQ, 2, ocs2::search_strategy::Type::LINE_SEARCH);
+  ocs2::SLQ ddp(ddpSettings, rollout, problem, *initializerPtr);
+  ddp.setReferenceManager(referenceManagerPtr);
+  ddp.run(startTime, initState, finalTime);
+  const auto performance = ddp.getPerformanceIndeces();
+  const auto numChecks = ddp.getNumericalStabilityChecker()->getNumChecks();
+
+  ddpSettings.numericalStabilityCheckRatio_ = 0.2;
+  ddpSettings.asynchronousNumericalStabilityCheck_ = true;
+  ocs2::SLQ sampledDdp(ddpSettings, rollout, problem, *initializerPtr);
+  sampledDdp.setReferenceManager(referenceManagerPtr);
+  sampledDdp.run(startTime, initState, finalTime);
+  const auto& checker = *sampledDdp.getNumericalStabilityChecker();
+  checker.waitForChecks();
+
+  // the checks do not change the solution, a subset of the nodes is checked in the background
+  EXPECT_DOUBLE_EQ(sampledDdp.getPerformanceIndeces().cost, performance.cost);
+  EXPECT_GT(checker.getNumChecks() + checker.getNumSkippedChecks(), 0);
+  EXPECT_LT(checker.getNumChecks() + checker.getNumSkippedChecks(), numChecks / 2);
+  EXPECT_EQ(checker.getNumViolations(), 0);
+  EXPECT_NE(sampledDdp.getBenchmarkingInfo().find("Stability checks"), std::string::npos);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_F(Exp0, ddp_multiple_shooting) {
+  ocs2::EXP0_System systemDynamics(referenceManagerPtr);
+  ocs2::TimeTriggeredRollout rollout(systemDynamics, rolloutSettings());
+
+  auto solve = [&](const ocs2::ddp::Settings& ddpSettings) {
+    ocs2::ILQR ddp(ddpSettings, rollout, problem, *initializerPtr);
+    ddp.setReferenceManager(referenceManagerPtr);
+    ddp.run(startTime, initState, finalTime);
+    return ddp.getPerformanceIndeces();
+  };
+
+  auto ddpSettings = getSettings(ocs2::ddp::Algorithm::ILQR, 3, ocs2::search_strategy::Type::LINE_SEARCH);
+  const auto performance = solve(ddpSettings);
+
+  ddpSettings.multipleShootingForwardPass_ = true;
+  const auto multipleShootingPerformance = solve(ddpSettings);
+
+  // the defects are closed at the convergence
+  EXPECT_LT(multipleShootingPerformance.dynamicsViolationSSE, ddpSettings.constraintTolerance_);
+  EXPECT_NEAR(multipleShootingPerformance.cost, performance.cost, 10.0 * minRelCost);
+
+  // the multiple-shooting forward pass requires the line search
+  ddpSettings.strategy_ = ocs2::search_strategy::Type::LEVENBERG_MARQUARDT;
+  EXPECT_THROW(solve(ddpSettings), std::runtime_error);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_F(Exp0, ddp_deadline) {
+  const auto ddpSettings = getSettings(ocs2::ddp::Algorithm::SLQ, 2, ocs2::search_strategy::Type::LINE_SEARCH);
+  ocs2::EXP0_System systemDynamics(referenceManagerPtr);
+  ocs2::TimeTriggeredRollout rollout(systemDynamics, rolloutSettings());
+  ocs2::SLQ ddp(ddpSettings, rollout, problem, *initializerPtr);
+  ddp.setReferenceManager(referenceManagerPtr);
+
+  // an expired deadline still yields one iteration
+  ddp.setDeadline(std::chrono::steady_clock::now());
+  ddp.run(startTime, initState, finalTime);
+  EXPECT_EQ(ddp.getNumIterations(), 1);
+  EXPECT_TRUE(ddp.getPerformanceIndeces().deadlineReached);
+  EXPECT_TRUE(ddp.getIterationsLog().back().deadlineReached);
+
+  ddp.reset();
+  ddp.clearDeadline();
+  ddp.run(startTime, initState, finalTime);
+  EXPECT_GT(ddp.getNumIterations(), 1);
+  EXPECT_FALSE(ddp.getPerformanceIndeces().deadlineReached);
+  performanceIndexTest(ddpSettings, ddp.getPerformanceIndeces());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_F(Exp0, ddp_event_times_cost_derivative) {
+  auto ddpSettings = getSettings(ocs2::ddp::Algorithm::SLQ, 2, ocs2::search_strategy::Type::LINE_SEARCH);
+  ddpSettings.maxNumIterations_ = 50;
+  ddpSettings.minRelCost_ = 1e-9;
+  ddpSettings.timeStep_ = 1e-3;
+  // a fine fixed step rollout such that the cost is a smooth function of the event time
+  auto settings = rolloutSettings();
+  settings.integratorType = ocs2::IntegratorType::RK4;
+  settings.timeStep = 1e-3;
+
+  // solves the problem for the given event time and returns the cost and its derivative w.r.t. the event time
+  auto solve = [&](ocs2::scalar_t eventTime, ocs2::scalar_t& costDerivative) {
+    referenceManagerPtr->setModeSchedule(ocs2::ModeSchedule({eventTime}, {0, 1}));
+    ocs2::EXP0_System systemDynamics(referenceManagerPtr);
+    ocs2::TimeTriggeredRollout rollout(systemDynamics, settings);
+    ocs2::SLQ ddp(ddpSettings, rollout, problem, *initializerPtr);
+    ddp.setReferenceManager(referenceManagerPtr);
+    ddp.run(startTime, initState, finalTime);
+    const ocs2::vector_t eventTimesCostDerivative = ddp.getEventTimesCostDerivative();
+    EXPECT_EQ(eventTimesCostDerivative.size(), 1);
+    costDerivative = eventTimesCostDerivative(0);
+    return ddp.getPerformanceIndeces().cost;
+  };
+
+  // the derivative vanishes at the optimal event time
+  ocs2::scalar_t optimalCostDerivative;
+  solve(0.1897, optimalCostDerivative);
+  EXPECT_NEAR(optimalCostDerivative, 0.0, 5e-2);
+
+  // the derivative matches the central finite difference of the optimal cost
+  constexpr ocs2::scalar_t eventTime = 1.0;
+  constexpr ocs2::scalar_t delta = 1e-2;
+  ocs2::scalar_t costDerivative, unused;
+  solve(eventTime, costDerivative);
+  const auto finiteDifference = (solve(eventTime + delta, unused) - solve(eventTime - delta, unused)) / (2.0 * delta);
+  EXPECT_NEAR(costDerivative, finiteDifference, 1e-2 * std::abs(finiteDifference));
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_F(Exp0, ddp_contingency_mpc) {
+  const auto ddpSettings = getSettings(ocs2::ddp::Algorithm::SLQ, 1, ocs2::search_strategy::Type::LINE_SEARCH);
+  ocs2::mpc::Settings mpcSettings;
+  mpcSettings.timeHorizon_ = finalTime - startTime;
+
+  // each MPC has its own reference manager and optimal control problem
+  auto createMpc = [&](std::shared_ptr<ocs2::ReferenceManager> mpcReferenceManagerPtr) {
+    const auto mpcProblem = ocs2::createExp0Problem(mpcReferenceManagerPtr);
+    ocs2::TimeTriggeredRollout rollout(*mpcProblem.dynamicsPtr, rolloutSettings());
+    std::unique_ptr<ocs2::MPC_BASE> mpcPtr(
+        new ocs2::GaussNewtonDDP_MPC(mpcSettings, ddpSettings, rollout, mpcProblem, *initializerPtr));
+    mpcPtr->getSolverPtr()->setReferenceManager(std::move(mpcReferenceManagerPtr));
+    return mpcPtr;
+  };
+
+  // the hypothesis delays the next touchdown
+  constexpr ocs2::scalar_t delay = 0.1;
+  std::vector<std::unique_ptr<ocs2::MPC_BASE>> contingencyMpcPtrs;
+  contingencyMpcPtrs.push_back(createMpc(ocs2::getExp0ReferenceManager({0.1897}, {0, 1})));
+  std::vector<ocs2::ContingencyMpc::mode_schedule_modifier_t> modeScheduleModifiers{
+      [&](ocs2::scalar_t initTime, const ocs2::ModeSchedule& modeSchedule) {
+        auto modifiedModeSchedule = modeSchedule;
+        for (auto& eventTime : modifiedModeSchedule.eventTimes) {
+          eventTime += delay;
+        }
+        return modifiedModeSchedule;
+      }};
+  ocs2::ContingencyMpc mpc(createMpc(referenceManagerPtr), std::move(contingencyMpcPtrs), std::move(modeScheduleModifiers));
+  ASSERT_EQ(mpc.getNumContingencies(), 1);
+
+  ocs2::MPC_MRT_Interface mpcInterface(mpc);
+  mpcInterface.resetMpcNode(referenceManagerPtr->getTargetTrajectories());
+  ocs2::SystemObservation observation;
+  observation.time = startTime;
+  observation.state = initState;
+  observation.input = ocs2::vector_t::Zero(INPUT_DIM);
+  mpcInterface.setCurrentObservation(observation);
+  mpcInterface.advanceMpc();
+  ASSERT_TRUE(mpcInterface.updatePolicy());
+
+  const auto& contingencyModeSchedule = mpc.getContingencySolverPtr(0)->getReferenceManager().getModeSchedule();
+  ASSERT_EQ(contingencyModeSchedule.eventTimes.size(), 1);
+  EXPECT_NEAR(contingencyModeSchedule.eventTimes[0], 0.1897 + delay, 1e-9);
+
+  // the MRT switches to the hypothesis without waiting for the MPC
+  ASSERT_EQ(mpcInterface.getNumContingencyPolicies(), 1);
+  EXPECT_NEAR(mpcInterface.getPolicy().modeSchedule_.eventTimes[0], 0.1897, 1e-9);
+  mpcInterface.switchToContingencyPolicy(0);
+  EXPECT_NEAR(mpcInterface.getPolicy().modeSchedule_.eventTimes[0], 0.1897 + delay, 1e-9);
+  EXPECT_FALSE(mpcInterface.getPolicy().timeTrajectory_.empty());
+  EXPECT_THROW(mpcInterface.switchToContingencyPolicy(1), std::runtime_error);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_F(Exp0, ddp_checkpoint) {
+  const auto ddpSettings = getSettings(ocs2::ddp::Algorithm::SLQ, 2, ocs2::search_strategy::Type::LINE_SEARCH);
+  ocs2::mpc::Settings mpcSettings;
+  mpcSettings.timeHorizon_ = finalTime - startTime;
+  ocs2::TimeTriggeredRollout rollout(*problem.dynamicsPtr, rolloutSettings());
+  const std::string fileName = "/tmp/ocs2_exp0_checkpoint.bin";
+  constexpr uint64_t settingsHash = 42;
+
+  // the checkpoint is written when the writer is destroyed at the latest
+  size_t coldIterations;
+  {
+    ocs2::GaussNewtonDDP_MPC mpc(mpcSettings, ddpSettings, rollout, problem, *initializerPtr);
+    mpc.getSolverPtr()->setReferenceManager(referenceManagerPtr);
+    mpc.setCheckpointWriter(std::make_shared<ocs2::mpc_recording::CheckpointWriter>(fileName, settingsHash, 0.0));
+    ASSERT_TRUE(mpc.run(startTime, initState));
+    coldIterations = mpc.getSolverPtr()->getNumIterations();
+  }
+
+  ocs2::mpc_recording::Checkpoint checkpoint;
+  EXPECT_FALSE(ocs2::mpc_recording::loadCheckpoint(fileName, settingsHash + 1, checkpoint));
+  ASSERT_TRUE(ocs2::mpc_recording::loadCheckpoint(fileName, settingsHash, checkpoint));
+  EXPECT_DOUBLE_EQ(checkpoint.initTime, startTime);
+  EXPECT_FALSE(checkpoint.dualSolution.timeTrajectory.empty());
+
+  // the restarted MPC is warm at a later time, since the warm start and the references are shifted together to its first run
+  constexpr ocs2::scalar_t restartTime = 10.0;
+  auto restartReferenceManagerPtr = ocs2::getExp0ReferenceManager({1.0}, {0, 1});
+  const auto restartProblem = ocs2::createExp0Problem(restartReferenceManagerPtr);
+  ocs2::TimeTriggeredRollout restartRollout(*restartProblem.dynamicsPtr, rolloutSettings());
+  ocs2::GaussNewtonDDP_MPC restartedMpc(mpcSettings, ddpSettings, restartRollout, restartProblem, *initializerPtr);
+  restartedMpc.getSolverPtr()->setReferenceManager(restartReferenceManagerPtr);
+  const auto targetTimes = checkpoint.targetTrajectories.timeTrajectory;
+  ocs2::mpc_recording::restoreCheckpoint(restartedMpc, std::move(checkpoint), restartTime);
+  restartedMpc.reset();
+  ASSERT_TRUE(restartedMpc.run(restartTime, initState));
+  EXPECT_LT(restartedMpc.getSolverPtr()->getNumIterations(), coldIterations);
+  EXPECT_NEAR(restartedMpc.getSolverPtr()->getPerformanceIndeces().cost, expectedCost, 10.0 * minRelCost);
+  const auto& restoredModeSchedule = restartReferenceManagerPtr->getModeSchedule();
+  ASSERT_EQ(restoredModeSchedule.eventTimes.size(), 1);
+  EXPECT_NEAR(restoredModeSchedule.eventTimes[0], restartTime + 0.1897 - startTime, 1e-6);
+  const auto& restoredTargetTimes = restartReferenceManagerPtr->getTargetTrajectories().timeTrajectory;
+  ASSERT_EQ(restoredTargetTimes.size(), targetTimes.size());
+  for (size_t i = 0; i < targetTimes.size(); ++i) {
+    EXPECT_NEAR(restoredTargetTimes[i], targetTimes[i] + restartTime - startTime, 1e-6);
+  }
+  std::remove(fileName.c_str());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_F(Exp0, ddp_data_collector) {
+  const auto ddpSettings = getSettings(ocs2::ddp::Algorithm::SLQ, 2, ocs2::search_strategy::Type::LINE_SEARCH);
+  ocs2::TimeTriggeredRollout rollout(*problem.dynamicsPtr, rolloutSettings());
+  ocs2::SLQ ddp(ddpSettings, rollout, problem, *initializerPtr);
+  ddp.setReferenceManager(referenceManagerPtr);
+  ocs2::DDP_DataCollector dataCollector;
+
+  ddp.run(startTime, initState, finalTime);
+  const auto valueFunction = ddp.getValueFunction(startTime, initState);
+  auto snapshotPtr = dataCollector.collect(ddp);
+  const auto& timeTrajectory = snapshotPtr->primalData.primalSolution.timeTrajectory_;
+  ASSERT_FALSE(timeTrajectory.empty());
+  EXPECT_NEAR(timeTrajectory.front(), startTime, 1e-6);
+  EXPECT_EQ(snapshotPtr->primalData.modelDataTrajectory.size(), timeTrajectory.size());
+  EXPECT_EQ(snapshotPtr->dualData.valueFunctionTrajectory.size(), timeTrajectory.size());
+  EXPECT_NEAR(snapshotPtr->dualData.valueFunctionTrajectory.front().f, valueFunction.f, 1e-9);
+
+  // the solver continues with the containers of the first snapshot as long as it is referenced
+  ddp.run(startTime, initState, finalTime);
+  performanceIndexTest(ddpSettings, ddp.getPerformanceIndeces());
+  const auto secondSnapshotPtr = dataCollector.collect(ddp);
+  EXPECT_NE(secondSnapshotPtr, snapshotPtr);
+  EXPECT_EQ(dataCollector.getNumSnapshots(), 2u);
+  EXPECT_FALSE(snapshotPtr->primalData.primalSolution.timeTrajectory_.empty());
+
+  // a released snapshot is recycled
+  const auto* firstSnapshotAddress = snapshotPtr.get();
+  snapshotPtr.reset();
+  ddp.run(startTime, initState, finalTime);
+  const auto thirdSnapshotPtr = dataCollector.collect(ddp);
+  EXPECT_EQ(thirdSnapshotPtr.get(), firstSnapshotAddress);
+  EXPECT_EQ(dataCollector.getNumSnapshots(), 2u);
+  EXPECT_FALSE(thirdSnapshotPtr->primalData.primalSolution.timeTrajectory_.empty());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_F(Exp0, ddp_closed_loop_simulation) {
+  const auto ddpSettings = getSettings(ocs2::ddp::Algorithm::SLQ, 1, ocs2::search_strategy::Type::LINE_SEARCH);
+  ocs2::mpc::Settings mpcSettings;
+  mpcSettings.timeHorizon_ = finalTime - startTime;
+  ocs2::TimeTriggeredRollout rollout(*problem.dynamicsPtr, rolloutSettings());
+  ocs2::GaussNewtonDDP_MPC mpc(mpcSettings, ddpSettings, rollout, problem, *initializerPtr);
+  mpc.getSolverPtr()->setReferenceManager(referenceManagerPtr);
+
+  ocs2::closed_loop_simulation::Settings simulationSettings;
+  simulationSettings.mrtDesiredFrequency = 100.0;
+  simulationSettings.mpcDesiredFrequency = 20.0;
+  simulationSettings.duration = 1.0;
+  ocs2::ClosedLoopSimulation simulation(mpc, simulationSettings, &rollout);
+
+  ocs2::SystemObservation initObservation;
+  initObservation.time = startTime;
+  initObservation.state = initState;
+  initObservation.input = ocs2::vector_t::Zero(INPUT_DIM);
+  const auto targetTrajectories = referenceManagerPtr->getTargetTrajectories();
+  const auto result = simulation.run(initObservation, targetTrajectories);
+
+  EXPECT_EQ(result.numMpcRuns, 20);
+  ASSERT_EQ(result.timeTrajectory.size(), 101);
+  EXPECT_EQ(result.stateTrajectory.size(), result.timeTrajectory.size());
+  EXPECT_EQ(result.inputTrajectory.size(), result.timeTrajectory.size());
+  EXPECT_DOUBLE_EQ(result.timeTrajectory.front(), startTime);
+  EXPECT_NEAR(result.timeTrajectory.back(), startTime + simulationSettings.duration, 1e-9);
+  EXPECT_TRUE(result.stateTrajectory.front().isApprox(initState));
+  EXPECT_GT(result.cost, 0.0);
+  EXPECT_GT(result.maxSolveTime, 0.0);
+  EXPECT_GE(result.maxSolveTime, result.averageSolveTime);
+
+  // the lockstep simulation is reproducible
+  const auto repeatedResult = simulation.run(initObservation, targetTrajectories);
+  EXPECT_NEAR(repeatedResult.cost, result.cost, 1e-9 * result.cost);
+  EXPECT_TRUE(repeatedResult.stateTrajectory.back().isApprox(result.stateTrajectory.back()));
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_F(Exp0, ddp_solution_database) {
+  const auto ddpSettings = getSettings(ocs2::ddp::Algorithm::SLQ, 2, ocs2::search_strategy::Type::LINE_SEARCH);
+  ocs2::TimeTriggeredRollout rollout(*problem.dynamicsPtr, rolloutSettings());
+  ocs2::SLQ ddp(ddpSettings, rollout, problem, *initializerPtr);
+  ddp.setReferenceManager(referenceManagerPtr);
+  auto databasePtr = std::make_shared<ocs2::SolutionDatabase>(ddp, ocs2::SolutionDatabaseSettings());
+  ddp.addSynchronizedModule(databasePtr);
+
+  // the first run misses and stores its solution
+  ddp.run(startTime, initState, finalTime);
+  const auto coldIterations = ddp.getNumIterations();
+  ASSERT_EQ(databasePtr->size(), 1);
+
+  // the run after a reset is warm started by the stored solution
+  ddp.reset();
+  ddp.run(startTime, initState, finalTime);
+  EXPECT_LT(ddp.getNumIterations(), coldIterations);
+  performanceIndexTest(ddpSettings, ddp.getPerformanceIndeces());
+  EXPECT_EQ(databasePtr->size(), 1);
+
+  // the previous solution is a good guess for the same problem
+  ddp.run(startTime, initState, finalTime);
+
+  const auto& statistics = databasePtr->getStatistics();
+  EXPECT_EQ(statistics.numRuns, 3);
+  EXPECT_EQ(statistics.numQueries, 2);
+  EXPECT_EQ(statistics.numHits, 1);
+  EXPECT_DOUBLE_EQ(statistics.getHitRate(), 0.5);
+  EXPECT_GT(statistics.getIterationSaving(), 0.0);
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -40,7 +40,7 @@ class RiccatiInitializer {
   using riccati_t = ocs2::ContinuousTimeRiccatiEquations;
 
   ocs2::scalar_array_t timeStamp;
-  std::vector<ocs2::ModelData> projectedModelDataTrajectory;
+  ocs2::ModelDataTrajectory projectedModelDataTrajectory;
 
   ocs2::size_array_t eventsPastTheEndIndeces;
   std::vector<ocs2::ModelData> modelDataEventTimesArray;
@@ -66,7 +66,7 @@ class RiccatiInitializer {
     projectedModelData.stateEqConstraint.setZero(0, stateDim);
     projectedModelData.stateInputEqConstraint.setZero(inputDim, stateDim, inputDim);
 
-    projectedModelDataTrajectory = std::vector<ocs2::ModelData>{projectedModelData, projectedModelData};
+    projectedModelDataTrajectory.assign({projectedModelData, projectedModelData});
 
     ocs2::riccati_modification::Data riccatiModification;
     riccatiModification.deltaQm_ = 0.1 * ocs2::LinearAlgebra::generateSPDmatrix<ocs2::matrix_t>(stateDim);
@@ -61,6 +61,9 @@ class BouncingMassDynamics final : public ocs2::LinearSystemDynamics {
 
   BouncingMassDynamics* clone() const override { return new BouncingMassDynamics(*this); }
 
+  /** The jump map is nonlinear */
+  bool isLinear() const override { return false; }
+
   vector_t computeJumpMap(scalar_t t, const vector_t& x, const PreComputation& preComp) override {
     vector_t mappedState = LinearSystemDynamics::computeJumpMap(t, x, preComp);
     if (x(2) < 5) {
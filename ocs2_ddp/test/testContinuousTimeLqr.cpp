@@ -30,6 +30,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <gtest/gtest.h>
 
 #include "ocs2_ddp/ContinuousTimeLqr.h"
+#include "ocs2_ddp/LqrTerminalCost.h"
 
 #include <ocs2_core/cost/QuadraticStateInputCost.h>
 #include <ocs2_core/dynamics/LinearSystemDynamics.h>
@@ -112,3 +113,92 @@ TEST(testContinousTimeLqr, evaluateCAREresidual) {
     ASSERT_LT(careResidual.norm(), careResidualNormTolerance);
   }
 }
+
+namespace {
+/** Pendulum-like system whose linearization depends on the state, such that the LQR solution changes with the operating point */
+std::unique_ptr<OptimalControlProblem> getScheduledProblem(const TargetTrajectories& targetTrajectories, scalar_t stiffness) {
+  const matrix_t A = (matrix_t(2, 2) << 0.0, 1.0, -stiffness, -0.1).finished();
+  const matrix_t B = (matrix_t(2, 1) << 0.0, 1.0).finished();
+  const matrix_t Q = matrix_t::Identity(2, 2);
+  const matrix_t R = matrix_t::Identity(1, 1);
+
+  std::unique_ptr<OptimalControlProblem> problemPtr(new OptimalControlProblem);
+  problemPtr->dynamicsPtr.reset(new LinearSystemDynamics(A, B));
+  problemPtr->costPtr->add("cost", std::unique_ptr<StateInputCost>(new QuadraticStateInputCost(Q, R)));
+  problemPtr->targetTrajectoriesPtr = &targetTrajectories;
+  return problemPtr;
+}
+
+continuous_time_lqr::OperatingPoint getOperatingPoint(scalar_t scheduling) {
+  return {scheduling, 0.0, vector_t::Zero(2), vector_t::Zero(1)};
+}
+}  // unnamed namespace
+
+TEST(testLqrTerminalCost, valueFunctionTable) {
+  const TargetTrajectories targetTrajectories({0.0}, {vector_t::Zero(2)}, {vector_t::Zero(1)});
+  auto problemPtr = getScheduledProblem(targetTrajectories, 1.0);
+
+  // the operating points are unsorted on purpose
+  const auto table = continuous_time_lqr::solveValueFunctionTable(*problemPtr, {getOperatingPoint(1.0), getOperatingPoint(-1.0)});
+  const auto S = continuous_time_lqr::solve(*problemPtr, 0.0, vector_t::Zero(2), vector_t::Zero(1)).valueFunction;
+
+  ASSERT_EQ(table.getSchedulingGrid(), scalar_array_t({-1.0, 1.0}));
+  EXPECT_TRUE(table.getValueFunction(-1.0).isApprox(S));
+  EXPECT_TRUE(table.getValueFunction(0.0).isApprox(S));
+  EXPECT_TRUE(table.getValueFunction(5.0).isApprox(S));
+
+  // linear interpolation
+  const continuous_time_lqr::ValueFunctionTable customTable({0.0, 2.0}, {matrix_t::Zero(2, 2), 2.0 * matrix_t::Identity(2, 2)});
+  EXPECT_TRUE(customTable.getValueFunction(0.5).isApprox(0.5 * matrix_t::Identity(2, 2)));
+  EXPECT_TRUE(customTable.getValueFunction(-1.0).isZero());
+  EXPECT_TRUE(customTable.getValueFunction(3.0).isApprox(2.0 * matrix_t::Identity(2, 2)));
+
+  EXPECT_ANY_THROW(continuous_time_lqr::ValueFunctionTable({1.0, 0.0}, {matrix_t::Zero(2, 2), matrix_t::Zero(2, 2)}));
+}
+
+TEST(testLqrTerminalCost, terminalCost) {
+  const vector_t targetState = (vector_t(2) << 0.5, -0.5).finished();
+  const TargetTrajectories targetTrajectories({0.0}, {targetState}, {vector_t::Zero(1)});
+  const matrix_t S0 = matrix_t::Identity(2, 2);
+  const matrix_t S1 = 3.0 * matrix_t::Identity(2, 2);
+
+  auto tableProviderPtr = std::make_shared<continuous_time_lqr::ValueFunctionTableProvider>();
+  LqrTerminalCost cost(tableProviderPtr, [](scalar_t, const vector_t& x, const TargetTrajectories&) { return x(0); });
+
+  const vector_t state = (vector_t(2) << 1.0, 0.0).finished();
+  EXPECT_ANY_THROW(cost.getValue(0.0, state, targetTrajectories, PreComputation()));
+
+  tableProviderPtr->setTable(continuous_time_lqr::ValueFunctionTable({0.0, 2.0}, {S0, S1}));
+  std::unique_ptr<StateCost> clonePtr(cost.clone());
+
+  // scheduling variable is 1.0, hence S = 2 I
+  const vector_t xDeviation = state - targetState;
+  const auto Phi = clonePtr->getQuadraticApproximation(0.0, state, targetTrajectories, PreComputation());
+  EXPECT_TRUE(Phi.dfdxx.isApprox(2.0 * matrix_t::Identity(2, 2)));
+  EXPECT_TRUE(Phi.dfdx.isApprox(2.0 * xDeviation));
+  EXPECT_NEAR(Phi.f, xDeviation.squaredNorm(), 1e-12);
+  EXPECT_NEAR(clonePtr->getValue(0.0, state, targetTrajectories, PreComputation()), Phi.f, 1e-12);
+
+  // the update of the table is seen by all clones
+  tableProviderPtr->setTable(continuous_time_lqr::ValueFunctionTable({0.0}, {S1}));
+  EXPECT_NEAR(cost.getValue(0.0, state, targetTrajectories, PreComputation()), 1.5 * xDeviation.squaredNorm(), 1e-12);
+}
+
+TEST(testLqrTerminalCost, backgroundUpdate) {
+  const TargetTrajectories targetTrajectories({0.0}, {vector_t::Zero(2)}, {vector_t::Zero(1)});
+  continuous_time_lqr::ValueFunctionTableProvider tableProvider(
+      continuous_time_lqr::ValueFunctionTable({0.0}, {matrix_t::Identity(2, 2)}));
+
+  ASSERT_TRUE(tableProvider.updateInBackground(getScheduledProblem(targetTrajectories, 4.0), {getOperatingPoint(0.0)}));
+  tableProvider.wait();
+  EXPECT_FALSE(tableProvider.isUpdating());
+
+  auto problemPtr = getScheduledProblem(targetTrajectories, 4.0);
+  const auto S = continuous_time_lqr::solve(*problemPtr, 0.0, vector_t::Zero(2), vector_t::Zero(1)).valueFunction;
+  EXPECT_TRUE(tableProvider.getTable()->getValueFunction(0.0).isApprox(S));
+
+  // a failing update keeps the previous table
+  ASSERT_TRUE(tableProvider.updateInBackground(getScheduledProblem(targetTrajectories, 1.0), {}));
+  tableProvider.wait();
+  EXPECT_TRUE(tableProvider.getTable()->getValueFunction(0.0).isApprox(S));
+}
@@ -32,6 +32,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <gtest/gtest.h>
 
 #include <ocs2_ddp/DDP_HelperFunctions.h>
+#include <ocs2_ddp/NumericalStabilityChecker.h>
 
 using namespace ocs2;
 
@@ -99,3 +100,121 @@ TEST(extractPrimalSolution, eventAtInitTime) {
   //  std::cerr << ">>>>>> Test 3\n" << PrimalSolutionTest3 << "\n";
   EXPECT_EQ(PrimalSolutionTest3.timeTrajectory_.size(), 1);
 }
+
+TEST(trajectorySpread, primalDataContainer) {
+  constexpr size_t numTime = 10;
+  constexpr scalar_t timeStep = 0.1;
+  constexpr scalar_t eventTime = 0.5;
+  constexpr auto eps = numeric_traits::weakEpsilon<scalar_t>();
+
+  // a two-mode trajectory with the event at eventTime. The state and the dynamics bias are the mode.
+  const ModeSchedule oldModeSchedule({eventTime}, {0, 1});
+  PrimalDataContainer primalData;
+  auto& primalSolution = primalData.primalSolution;
+  for (size_t n = 0; n <= numTime; ++n) {
+    const scalar_t time = n * timeStep;
+    const size_t mode = oldModeSchedule.modeAtTime(time);
+    if (n > 0 && primalSolution.timeTrajectory_.back() < eventTime && time >= eventTime) {
+      primalSolution.postEventIndices_.push_back(primalSolution.timeTrajectory_.size() + 1);
+      primalSolution.timeTrajectory_.push_back(eventTime);
+      primalSolution.stateTrajectory_.push_back(vector_t::Zero(1));
+      primalSolution.inputTrajectory_.push_back(vector_t::Zero(1));
+      primalData.modelDataEventTimes.emplace_back();
+      primalData.modelDataEventTimes.back().time = eventTime;
+      primalData.problemMetrics.preJumps.emplace_back();
+    }
+    primalSolution.timeTrajectory_.push_back(mode == 0 ? time : std::max(time, eventTime + eps));
+    primalSolution.stateTrajectory_.push_back(vector_t::Constant(1, mode));
+    primalSolution.inputTrajectory_.push_back(vector_t::Zero(1));
+  }
+  primalSolution.modeSchedule_ = oldModeSchedule;
+  for (const auto& state : primalSolution.stateTrajectory_) {
+    primalData.modelDataTrajectory.emplace_back();
+    primalData.modelDataTrajectory.back().dynamicsBias = state;
+    primalData.problemMetrics.intermediates.emplace_back();
+  }
+
+  // the event moves backward
+  const ModeSchedule newModeSchedule({0.25}, {0, 1});
+  const auto status = trajectorySpread(oldModeSchedule, newModeSchedule, primalData);
+  EXPECT_FALSE(status.willTruncate);
+  EXPECT_TRUE(status.willPerformTrajectorySpreading);
+
+  const auto numNodes = primalSolution.timeTrajectory_.size();
+  ASSERT_EQ(primalSolution.stateTrajectory_.size(), numNodes);
+  ASSERT_EQ(primalSolution.inputTrajectory_.size(), numNodes);
+  ASSERT_EQ(primalData.modelDataTrajectory.size(), numNodes);
+  ASSERT_EQ(primalData.problemMetrics.intermediates.size(), numNodes);
+  ASSERT_EQ(primalSolution.postEventIndices_.size(), 1);
+  EXPECT_EQ(primalData.modelDataEventTimes.size(), 1);
+  EXPECT_EQ(primalData.problemMetrics.preJumps.size(), 1);
+  EXPECT_TRUE(primalSolution.modeSchedule_.eventTimes == newModeSchedule.eventTimes);
+
+  // all the nodes after the new event belong to the second mode
+  for (size_t i = 0; i < numNodes; ++i) {
+    const scalar_t expectedMode = (i < primalSolution.postEventIndices_.front()) ? 0.0 : 1.0;
+    EXPECT_EQ(primalSolution.stateTrajectory_[i](0), expectedMode) << "at index " << i;
+    EXPECT_TRUE(primalData.modelDataTrajectory[i].dynamicsBias == primalSolution.stateTrajectory_[i]) << "at index " << i;
+  }
+}
+
+TEST(numericalStabilityChecker, sampling) {
+  constexpr size_t numNodes = 10000;
+  NumericalStabilityChecker checker(0.25);
+  size_t numSampled = 0;
+  for (size_t i = 0; i < numNodes; i++) {
+    numSampled += checker.isSampled(i) ? 1 : 0;
+  }
+  EXPECT_NEAR(static_cast<scalar_t>(numSampled) / numNodes, 0.25, 0.02);
+
+  // the sample is repeatable within an iteration and changes with the iteration
+  const auto isSampled = [&](size_t i) { return checker.isSampled(i); };
+  std::vector<bool> samples;
+  for (size_t i = 0; i < 100; i++) {
+    samples.push_back(isSampled(i));
+    EXPECT_EQ(isSampled(i), samples.back());
+  }
+  checker.newIteration();
+  size_t numChanged = 0;
+  for (size_t i = 0; i < 100; i++) {
+    numChanged += (isSampled(i) != samples[i]) ? 1 : 0;
+  }
+  EXPECT_GT(numChanged, 0);
+
+  EXPECT_TRUE(NumericalStabilityChecker(1.0).isSampled(0));
+  EXPECT_FALSE(NumericalStabilityChecker(0.0).isSampled(0));
+}
+
+TEST(numericalStabilityChecker, violation) {
+  ModelData modelData;
+  modelData.cost = ScalarFunctionQuadraticApproximation::Zero(2, 1);
+  modelData.cost.dfdxx = -matrix_t::Identity(2, 2);  // not positive semi-definite
+  modelData.cost.dfduu = matrix_t::Identity(1, 1);
+
+  NumericalStabilityChecker synchronousChecker;
+  EXPECT_THROW(synchronousChecker.check(0, 0.5, modelData, "Ill-posed problem at time"), std::runtime_error);
+  EXPECT_EQ(synchronousChecker.getNumViolations(), 1);
+
+  NumericalStabilityChecker asynchronousChecker(1.0, true);
+  for (size_t i = 0; i < 10; i++) {
+    EXPECT_NO_THROW(asynchronousChecker.check(i, 0.5, modelData, "Ill-posed problem at time"));
+  }
+  asynchronousChecker.waitForChecks();
+  EXPECT_EQ(asynchronousChecker.getNumChecks() + asynchronousChecker.getNumSkippedChecks(), 10);
+  EXPECT_EQ(asynchronousChecker.getNumViolations(), asynchronousChecker.getNumChecks());
+}
+
+TEST(numericalStabilityChecker, valueFunctionViolation) {
+  auto valueFunction = ScalarFunctionQuadraticApproximation::Zero(2, 0);
+  valueFunction.dfdxx = -matrix_t::Identity(2, 2);  // not positive semi-definite
+
+  NumericalStabilityChecker synchronousChecker;
+  EXPECT_THROW(synchronousChecker.checkValueFunction(0, 0.5, valueFunction, "Ill-posed value function at time"), std::runtime_error);
+  EXPECT_EQ(synchronousChecker.getNumViolations(), 1);
+
+  NumericalStabilityChecker asynchronousChecker(1.0, true);
+  EXPECT_NO_THROW(asynchronousChecker.checkValueFunction(0, 0.5, valueFunction, "Ill-posed value function at time"));
+  asynchronousChecker.waitForChecks();
+  EXPECT_EQ(asynchronousChecker.getNumChecks(), 1);
+  EXPECT_EQ(asynchronousChecker.getNumViolations(), 1);
+}
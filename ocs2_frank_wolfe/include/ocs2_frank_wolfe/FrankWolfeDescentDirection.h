@@ -51,8 +51,10 @@ class FrankWolfeDescentDirection {
    * Constructor.
    *
    * @param [in] display:
+   * @param [in] warmStart: If true, the LP is kept between the calls as long as its dimensions do not change. Only its data is updated
+   * and the simplex method starts from the optimal basis of the last call.
    */
-  explicit FrankWolfeDescentDirection(bool display);
+  explicit FrankWolfeDescentDirection(bool display, bool warmStart = true);
 
   /**
    * Default destructor.
@@ -96,8 +98,15 @@ class FrankWolfeDescentDirection {
   /***********
    * Variables
    **********/
+  const bool warmStart_;
   std::unique_ptr<glp_prob, void (*)(glp_prob*)> lpPtr_;
   std::unique_ptr<glp_smcp> lpOptionsPtr_;
+
+  // dimensions and constraint matrix of the LP in lpPtr_
+  size_t numParameters_ = 0;
+  size_t numEqualityConstraints_ = 0;
+  size_t numInequalityConstraints_ = 0;
+  matrix_t constraintMatrix_;
 };
 
 }  // namespace ocs2
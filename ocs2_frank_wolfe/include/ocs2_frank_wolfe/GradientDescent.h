@@ -31,6 +31,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <Eigen/Dense>
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 #include <limits>
@@ -38,6 +39,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <vector>
 
 #include <ocs2_core/Types.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
 #include "ocs2_frank_wolfe/FrankWolfeDescentDirection.h"
 #include "ocs2_frank_wolfe/NLP_Constraints.h"
 #include "ocs2_frank_wolfe/NLP_Cost.h"
@@ -125,26 +127,36 @@ class GradientDescent {
    * Line search to find the best learning rate using decreasing scheme where the step size eventually decreases
    * from the maximum value to the minimum.
    *
+   * The step sizes are evaluated in batches of NLP_Settings::nThreads_ in parallel, each on its own NLP cost instance. The batch
+   * results are then accepted or rejected in the order of the sequential scheme, therefore the result does not depend on the
+   * number of threads. The NLP cost instance which holds the optimized solution is never used for a new evaluation.
+   *
    * @param [in] parameters: The current parameter vector.
    * @param [in] gradient: The current gradient.
-   * @param [in] costPtr: A pointer to the NLP cost.
    * @param [in] constraintsPtr: A pointer to the NLP constraints.
    * @param [out] optimizedParameters: The parameter vector.
    * @param [out] optimizedCost: The optimized cost.
    * @param [out] optimizedID: The ID of the optimized solution.
+   * @param [out] optimizedCostPtr: A pointer to the NLP cost instance which holds the optimized solution.
    * @param [out] optimizedLearningRate: The optimized learning rate.
    */
-  void lineSearch(const vector_t& parameters, const vector_t& gradient, NLP_Cost* costPtr, NLP_Constraints* constraintsPtr,
-                  vector_t& optimizedParameters, scalar_t& optimizedCost, size_t& optimizedID, scalar_t& optimizedLearningRate);
+  void lineSearch(const vector_t& parameters, const vector_t& gradient, NLP_Constraints* constraintsPtr, vector_t& optimizedParameters,
+                  scalar_t& optimizedCost, size_t& optimizedID, NLP_Cost*& optimizedCostPtr, scalar_t& optimizedLearningRate);
 
   /*
    * Variables
    */
   NLP_Settings nlpSettings_;
   std::unique_ptr<FrankWolfeDescentDirection> frankWolfeDescentDirectionPtr_;
+  ThreadPool threadPool_;
+
+  // the given NLP cost followed by its clones for the parallel line search
+  std::vector<NLP_Cost*> costInstancesPtr_;
+  std::vector<std::unique_ptr<NLP_Cost>> costClonesPtr_;
 
   scalar_t optimizedCost_;
   size_t optimizedID_;
+  NLP_Cost* optimizedCostPtr_;
   vector_t optimizedParameters_;
   vector_t optimizedGradient_;
   size_t numFuntionCall_;
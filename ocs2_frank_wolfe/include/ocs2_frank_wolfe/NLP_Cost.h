@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <stdexcept>
+
 #include <ocs2_core/Types.h>
 
 namespace ocs2 {
@@ -48,6 +50,14 @@ class NLP_Cost {
    */
   virtual ~NLP_Cost() = default;
 
+  /**
+   * Clones the NLP cost. It is only required if the line search step sizes are evaluated concurrently, i.e.
+   * NLP_Settings::nThreads_ > 1. The clone should be independent of this instance such that both can be evaluated in parallel.
+   *
+   * @return A pointer to the cloned NLP cost.
+   */
+  virtual NLP_Cost* clone() const { throw std::runtime_error("[NLP_Cost] clone() is not implemented!"); }
+
   /**
    * Sets the current parameter vector.
    *
@@ -44,7 +44,9 @@ class NLP_Settings {
         minRelCost_(1e-6),
         maxLearningRate_(1.0),
         minLearningRate_(0.05),
-        useAscendingLineSearchNLP_(true) {}
+        useAscendingLineSearchNLP_(true),
+        warmStartLP_(true),
+        nThreads_(1) {}
 
   /** This value determines to display the log output.*/
   bool displayInfo_;
@@ -62,6 +64,13 @@ class NLP_Settings {
    * - \b Descending: The step size eventually decreases from the minimum value to the maximum.
    * */
   bool useAscendingLineSearchNLP_;
+  /** This value determines to warm start the linear program of the Frank-Wolfe descent direction from its last basis. */
+  bool warmStartLP_;
+  /**
+   * This value determines the number of the line search step sizes which are evaluated concurrently, each on its own clone of the
+   * NLP cost (see NLP_Cost::clone()). For the value 1, the step sizes are evaluated sequentially on the given NLP cost.
+   */
+  size_t nThreads_;
 };
 
 }  // namespace ocs2
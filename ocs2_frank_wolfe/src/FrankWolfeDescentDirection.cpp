@@ -34,8 +34,8 @@ namespace ocs2 {
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-FrankWolfeDescentDirection::FrankWolfeDescentDirection(bool display)
-    : lpPtr_(glp_create_prob(), glp_delete_prob), lpOptionsPtr_(new glp_smcp) {
+FrankWolfeDescentDirection::FrankWolfeDescentDirection(bool display, bool warmStart /*= true*/)
+    : warmStart_(warmStart), lpPtr_(glp_create_prob(), glp_delete_prob), lpOptionsPtr_(new glp_smcp) {
   // set LP options
   glp_init_smcp(lpOptionsPtr_.get());
   if (!display) lpOptionsPtr_->msg_lev = GLP_MSG_ERR;
@@ -65,30 +65,6 @@ void FrankWolfeDescentDirection::setupLP(const vector_t& parameter, const vector
   // return if there is no parameter
   if (parameterDim == 0) return;
 
-  // set parameters limits
-  glp_add_cols(lpPtr_.get(), parameterDim);
-
-  // set the LP cost function of Frank-Wolfe algorithm
-  for (size_t i = 0; i < parameterDim; i++) glp_set_obj_coef(lpPtr_.get(), i + 1, gradient(i));
-
-  // set descent directions reciprocal element-wise max
-  const vector_t Ev = maxGradientInverse.cwiseAbs();
-  for (size_t i = 0; i < parameterDim; i++) {
-    // if the gradient is zero in one direction
-    if (numerics::almost_eq(gradient(i), 0.0)) {
-      glp_set_col_bnds(lpPtr_.get(), i + 1, GLP_FX, 0.0, 0.0);
-
-      // if the gradient should be limited
-    } else if (!numerics::almost_eq(Ev(i), 0.0)) {
-      glp_set_col_bnds(lpPtr_.get(), i + 1, GLP_DB, -1.0 / Ev(i), 1.0 / Ev(i));
-
-      // if free
-    } else {
-      glp_set_col_bnds(lpPtr_.get(), i + 1, GLP_FR, 0.0, 0.0);
-    }
-
-  }  // end of i loop
-
   // set the current parameter vector.
   nlpConstraintsPtr->setCurrentParameter(parameter);
 
@@ -120,38 +96,73 @@ void FrankWolfeDescentDirection::setupLP(const vector_t& parameter, const vector
         "calculateLinearInequalityConstraint: The number of rows of Jacobian matrix "
         "should be equal to the number of inequality constraints.");
 
-  // set the total number of constraint limits
-  glp_add_rows(lpPtr_.get(), g.size() + h.size());
-  scalar_array_t values{0.1};     // 0 index is not used!
-  std::vector<int> xIndices{-1};  // 0 index is not used!
-  std::vector<int> yIndices{-1};  // 0 index is not used!
+  const size_t numEqualityConstraints = g.size();
+  const size_t numInequalityConstraints = h.size();
+  const size_t numConstraints = numEqualityConstraints + numInequalityConstraints;
+
+  // the LP is only rebuilt if its dimensions change, otherwise the basis of the last LP is kept
+  if (!warmStart_ || parameterDim != numParameters_ || numEqualityConstraints != numEqualityConstraints_ ||
+      numInequalityConstraints != numInequalityConstraints_) {
+    instantiateGLPK();
+    glp_add_cols(lpPtr_.get(), parameterDim);
+    if (numConstraints > 0) glp_add_rows(lpPtr_.get(), numConstraints);
+    numParameters_ = parameterDim;
+    numEqualityConstraints_ = numEqualityConstraints;
+    numInequalityConstraints_ = numInequalityConstraints;
+    constraintMatrix_.resize(0, 0);
+  }
 
-  // domain equality constraints
-  for (size_t i = 0; i < g.size(); i++) {
-    for (size_t j = 0; j < parameterDim; j++) {
-      if (!numerics::almost_eq(dgdx(i, j), 0.0)) {
-        values.push_back(dgdx(i, j));
-        xIndices.push_back(i + 1);
-        yIndices.push_back(j + 1);
-      }
+  // set the LP cost function of Frank-Wolfe algorithm
+  for (size_t i = 0; i < parameterDim; i++) glp_set_obj_coef(lpPtr_.get(), i + 1, gradient(i));
+
+  // set descent directions reciprocal element-wise max
+  const vector_t Ev = maxGradientInverse.cwiseAbs();
+  for (size_t i = 0; i < parameterDim; i++) {
+    // if the gradient is zero in one direction
+    if (numerics::almost_eq(gradient(i), 0.0)) {
+      glp_set_col_bnds(lpPtr_.get(), i + 1, GLP_FX, 0.0, 0.0);
+
+      // if the gradient should be limited
+    } else if (!numerics::almost_eq(Ev(i), 0.0)) {
+      glp_set_col_bnds(lpPtr_.get(), i + 1, GLP_DB, -1.0 / Ev(i), 1.0 / Ev(i));
+
+      // if free
+    } else {
+      glp_set_col_bnds(lpPtr_.get(), i + 1, GLP_FR, 0.0, 0.0);
     }
+
+  }  // end of i loop
+
+  // domain equality constraints
+  for (size_t i = 0; i < numEqualityConstraints; i++) {
     glp_set_row_bnds(lpPtr_.get(), i + 1, GLP_FX, -g(i), -g(i));
   }
 
   // domain inequality constraints
-  for (size_t i = 0; i < h.size(); i++) {
-    for (size_t j = 0; j < parameterDim; j++) {
-      if (!numerics::almost_eq(dhdx(i, j), 0.0)) {
-        values.push_back(dhdx(i, j));
-        xIndices.push_back(i + 1);
-        yIndices.push_back(j + 1);
+  for (size_t i = 0; i < numInequalityConstraints; i++) {
+    glp_set_row_bnds(lpPtr_.get(), numEqualityConstraints + i + 1, GLP_LO, -h(i), 0.0);
+  }
+
+  // the constraint coefficients are only loaded if they have changed
+  matrix_t constraintMatrix(numConstraints, parameterDim);
+  if (numEqualityConstraints > 0) constraintMatrix.topRows(numEqualityConstraints) = dgdx;
+  if (numInequalityConstraints > 0) constraintMatrix.bottomRows(numInequalityConstraints) = dhdx;
+  if (numConstraints > 0 && (constraintMatrix_.rows() != constraintMatrix.rows() || constraintMatrix_ != constraintMatrix)) {
+    scalar_array_t values{0.1};     // 0 index is not used!
+    std::vector<int> xIndices{-1};  // 0 index is not used!
+    std::vector<int> yIndices{-1};  // 0 index is not used!
+    for (size_t i = 0; i < numConstraints; i++) {
+      for (size_t j = 0; j < parameterDim; j++) {
+        if (!numerics::almost_eq(constraintMatrix(i, j), 0.0)) {
+          values.push_back(constraintMatrix(i, j));
+          xIndices.push_back(i + 1);
+          yIndices.push_back(j + 1);
+        }
       }
     }
-    glp_set_row_bnds(lpPtr_.get(), i + 1, GLP_LO, -h(i), 0.0);
+    glp_load_matrix(lpPtr_.get(), values.size() - 1, xIndices.data(), yIndices.data(), values.data());
+    constraintMatrix_.swap(constraintMatrix);
   }
-
-  // set the constraint coefficients
-  glp_load_matrix(lpPtr_.get(), g.size() + h.size(), xIndices.data(), yIndices.data(), values.data());
 }
 
 /******************************************************************************************************/
@@ -163,14 +174,16 @@ void FrankWolfeDescentDirection::run(const vector_t& parameter, const vector_t&
   if (maxGradientInverse.size() != gradient.size())
     throw std::runtime_error("The gradient limit size is incompatible to the gradient size.");
 
-  // instantiate GLPK
-  instantiateGLPK();
-
   // setup LP
   setupLP(parameter, gradient, maxGradientInverse, nlpConstraintsPtr);
 
-  // solve LP
-  glp_simplex(lpPtr_.get(), lpOptionsPtr_.get());
+  // solve LP, starting from the basis of the last LP
+  const int status = glp_simplex(lpPtr_.get(), lpOptionsPtr_.get());
+  if (status == GLP_EBADB || status == GLP_ESING || status == GLP_ECOND) {
+    // the last basis is not valid for the new constraint matrix
+    glp_adv_basis(lpPtr_.get(), 0);
+    glp_simplex(lpPtr_.get(), lpOptionsPtr_.get());
+  }
 
   // get the solution
   fwDescentDirection.resize(parameter.size());
@@ -36,7 +36,9 @@ namespace ocs2 {
 /******************************************************************************************************/
 GradientDescent::GradientDescent(const NLP_Settings& nlpSettings)
 
-    : nlpSettings_(nlpSettings), frankWolfeDescentDirectionPtr_(new FrankWolfeDescentDirection(nlpSettings.displayInfo_)) {
+    : nlpSettings_(nlpSettings),
+      frankWolfeDescentDirectionPtr_(new FrankWolfeDescentDirection(nlpSettings.displayInfo_, nlpSettings.warmStartLP_)),
+      threadPool_(std::max(nlpSettings.nThreads_, size_t(1)) - 1) {
   CleanFmtDisplay_ = Eigen::IOFormat(3, 0, ", ", "\n", "[", "]");
 }
 
@@ -78,8 +80,8 @@ NLP_Settings& GradientDescent::nlpSettings() {
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-void GradientDescent::lineSearch(const vector_t& parameters, const vector_t& gradient, NLP_Cost* costPtr, NLP_Constraints* constraintsPtr,
-                                 vector_t& optimizedParameters, scalar_t& optimizedCost, size_t& optimizedID,
+void GradientDescent::lineSearch(const vector_t& parameters, const vector_t& gradient, NLP_Constraints* constraintsPtr,
+                                 vector_t& optimizedParameters, scalar_t& optimizedCost, size_t& optimizedID, NLP_Cost*& optimizedCostPtr,
                                  scalar_t& optimizedLearningRate) {
   scalar_t learningRate, contractionRate;
   if (nlpSettings_.useAscendingLineSearchNLP_ == true) {
@@ -101,71 +103,107 @@ void GradientDescent::lineSearch(const vector_t& parameters, const vector_t& gra
     return;
   }
 
-  while (learningRate >= nlpSettings_.minLearningRate_) {
-    // lineSerach parameter
-    vector_t lsParameters = parameters - learningRate * gradient;
-
-    // set the parameter
-    size_t lsID = costPtr->setCurrentParameter(lsParameters);
-
-    // calculate cost function
+  // the trial points step from a copy, since the output parameters may alias the input ones (as in run())
+  const vector_t initialParameters = parameters;
+
+  // the batch of step sizes which are evaluated in parallel
+  const size_t batchSize = std::max(costInstancesPtr_.size() - 1, size_t(1));
+  std::vector<NLP_Cost*> batchCostPtrs(batchSize);
+  scalar_array_t batchLearningRates(batchSize);
+  vector_array_t batchParameters(batchSize);
+  std::vector<size_t> batchIDs(batchSize);
+  scalar_array_t batchCosts(batchSize);
+  std::vector<char> batchStatus(batchSize);
+
+  auto evaluateStepSize = [&](int workerIndex, int i) {
+    batchParameters[i] = initialParameters - batchLearningRates[i] * gradient;
+    batchIDs[i] = batchCostPtrs[i]->setCurrentParameter(batchParameters[i]);
     scalar_t lsCost;
-    bool status = costPtr->getCost(lsID, lsCost);
-
-    // increment the number of function calls
-    numFuntionCall_++;
-
-    // skip it if status is not OK
-    if (status == false) {
-      // display
-      if (nlpSettings_.displayInfo_) {
-        std::cerr << "\t learningRate: " << learningRate;
-        std::cerr << "\t cost: " << lsCost << " (rejected)" << std::endl;
+    batchStatus[i] = batchCostPtrs[i]->getCost(batchIDs[i], lsCost);
+    batchCosts[i] = lsCost;
+  };
+
+  bool isTerminated = false;
+  while (!isTerminated && learningRate >= nlpSettings_.minLearningRate_) {
+    // assign the NLP cost instances which do not hold the optimized solution
+    size_t numCandidates = 0;
+    for (auto* costPtr : costInstancesPtr_) {
+      if (numCandidates < batchSize && (costPtr != optimizedCostPtr || costInstancesPtr_.size() == 1)) {
+        batchCostPtrs[numCandidates++] = costPtr;
       }
+    }
+
+    // lineSerach parameters
+    numCandidates = 0;
+    while (numCandidates < batchSize && learningRate >= nlpSettings_.minLearningRate_) {
+      batchLearningRates[numCandidates++] = learningRate;
       learningRate *= contractionRate;
-      continue;
     }
 
-    // display
-    if (nlpSettings_.displayInfo_) {
-      scalar_t equalitySE(0.0), inequalitySE(0.0);
-      if (constraintsPtr) {
-        vector_t g, h;
-        constraintsPtr->setCurrentParameter(lsParameters);
-        constraintsPtr->getLinearEqualityConstraint(g);
-        equalitySE = (g.size() > 0) ? g.squaredNorm() : 0.0;
-        constraintsPtr->getLinearInequalityConstraint(h);
-        inequalitySE = (h.size() > 0) ? h.dot(h.cwiseMin(0.0)) : 0.0;
-        std::cerr << "\t h: " << h.transpose().format(CleanFmtDisplay_) << std::endl;
-      }
-      std::cerr << "\t learningRate: " << learningRate;
-      std::cerr << "\t cost: " << lsCost;
-      std::cerr << "\t equality SE: " << equalitySE;
-      std::cerr << "\t inequality SE: " << inequalitySE << std::endl;
+    // calculate cost functions
+    if (numCandidates == 1) {
+      evaluateStepSize(0, 0);
+    } else {
+      threadPool_.parallelFor(0, static_cast<int>(numCandidates), 1, evaluateStepSize);
     }
 
-    // termination check
-    if (nlpSettings_.useAscendingLineSearchNLP_ == true) {
-      if (lsCost > optimizedCost_ * (1.0 - learningRate * 1e-3)) {
-        break;
+    // increment the number of function calls
+    numFuntionCall_ += numCandidates;
+
+    for (size_t i = 0; i < numCandidates; i++) {
+      // skip it if status is not OK
+      if (batchStatus[i] == 0) {
+        // display
+        if (nlpSettings_.displayInfo_) {
+          std::cerr << "\t learningRate: " << batchLearningRates[i];
+          std::cerr << "\t cost: " << batchCosts[i] << " (rejected)" << std::endl;
+        }
+        continue;
       }
-      optimizedParameters = lsParameters;
-      optimizedCost = lsCost;
-      optimizedID = lsID;
-      optimizedLearningRate = learningRate;
 
-    } else {
-      if (lsCost < optimizedCost_ * (1.0 - learningRate * 1e-3)) {
-        optimizedParameters = lsParameters;
-        optimizedCost = lsCost;
-        optimizedID = lsID;
-        optimizedLearningRate = learningRate;
-        break;
+      // display
+      if (nlpSettings_.displayInfo_) {
+        scalar_t equalitySE(0.0), inequalitySE(0.0);
+        if (constraintsPtr) {
+          vector_t g, h;
+          constraintsPtr->setCurrentParameter(batchParameters[i]);
+          constraintsPtr->getLinearEqualityConstraint(g);
+          equalitySE = (g.size() > 0) ? g.squaredNorm() : 0.0;
+          constraintsPtr->getLinearInequalityConstraint(h);
+          inequalitySE = (h.size() > 0) ? h.dot(h.cwiseMin(0.0)) : 0.0;
+          std::cerr << "\t h: " << h.transpose().format(CleanFmtDisplay_) << std::endl;
+        }
+        std::cerr << "\t learningRate: " << batchLearningRates[i];
+        std::cerr << "\t cost: " << batchCosts[i];
+        std::cerr << "\t equality SE: " << equalitySE;
+        std::cerr << "\t inequality SE: " << inequalitySE << std::endl;
       }
-    }
 
-    learningRate *= contractionRate;
-  }  // end of while loop
+      // termination check
+      if (nlpSettings_.useAscendingLineSearchNLP_ == true) {
+        if (batchCosts[i] > optimizedCost_ * (1.0 - batchLearningRates[i] * 1e-3)) {
+          isTerminated = true;
+          break;
+        }
+        optimizedParameters = batchParameters[i];
+        optimizedCost = batchCosts[i];
+        optimizedID = batchIDs[i];
+        optimizedCostPtr = batchCostPtrs[i];
+        optimizedLearningRate = batchLearningRates[i];
+
+      } else {
+        if (batchCosts[i] < optimizedCost_ * (1.0 - batchLearningRates[i] * 1e-3)) {
+          optimizedParameters = batchParameters[i];
+          optimizedCost = batchCosts[i];
+          optimizedID = batchIDs[i];
+          optimizedCostPtr = batchCostPtrs[i];
+          optimizedLearningRate = batchLearningRates[i];
+          isTerminated = true;
+          break;
+        }
+      }
+    }  // end of for loop
+  }    // end of while loop
 
   if (nlpSettings_.displayInfo_) {
     std::cerr << "Line search terminates with learning rate: " << optimizedLearningRate << std::endl;
@@ -188,6 +226,16 @@ void GradientDescent::run(const vector_t& initParameters, const vector_t& maxGra
     throw std::runtime_error("Cost function pointer is null.");
   }
 
+  // the line search step sizes are evaluated on the given NLP cost and on its clones
+  costInstancesPtr_.assign(1, costPtr);
+  costClonesPtr_.clear();
+  if (nlpSettings_.nThreads_ > 1) {
+    for (size_t i = 0; i < nlpSettings_.nThreads_; i++) {
+      costClonesPtr_.emplace_back(costPtr->clone());
+      costInstancesPtr_.push_back(costClonesPtr_.back().get());
+    }
+  }
+
   numFuntionCall_ = 0;
   iterationCost_.clear();
   optimizedParameters_ = initParameters;
@@ -198,6 +246,7 @@ void GradientDescent::run(const vector_t& initParameters, const vector_t& maxGra
   }
 
   // initial cost
+  optimizedCostPtr_ = costPtr;
   optimizedID_ = costPtr->setCurrentParameter(optimizedParameters_);
   bool status = costPtr->getCost(optimizedID_, optimizedCost_);
   iterationCost_.push_back(optimizedCost_);
@@ -221,7 +270,7 @@ void GradientDescent::run(const vector_t& initParameters, const vector_t& maxGra
 
     // compute the gradient
     scalar_t cachedCost = optimizedCost_;
-    costPtr->getCostDerivative(optimizedID_, optimizedGradient_);
+    optimizedCostPtr_->getCostDerivative(optimizedID_, optimizedGradient_);
     if (nlpSettings_.displayInfo_) {
       std::cerr << "Gradient:             " << optimizedGradient_.transpose().format(CleanFmtDisplay_) << '\n';
     }
@@ -238,8 +287,8 @@ void GradientDescent::run(const vector_t& initParameters, const vector_t& maxGra
     }
 
     // line search
-    lineSearch(optimizedParameters_, optimizedGradient_, costPtr, constraintsPtr, optimizedParameters_, optimizedCost_, optimizedID_,
-               optimizedLearningRate);
+    lineSearch(optimizedParameters_, optimizedGradient_, constraintsPtr, optimizedParameters_, optimizedCost_, optimizedID_,
+               optimizedCostPtr_, optimizedLearningRate);
 
     // loop variables
     relCost = std::fabs(optimizedCost_ - cachedCost);
@@ -256,6 +305,13 @@ void GradientDescent::run(const vector_t& initParameters, const vector_t& maxGra
 
   }  // end of while loop
 
+  // the optimized solution should be accessible through the given NLP cost
+  if (optimizedCostPtr_ != costPtr) {
+    optimizedID_ = costPtr->setCurrentParameter(optimizedParameters_);
+    optimizedCostPtr_ = costPtr;
+    numFuntionCall_++;
+  }
+
   // display
   if (nlpSettings_.displayInfo_) {
     std::cerr << "\n++++++++++++++++++++++++++++++++++++++++++++++++++++++";
@@ -42,6 +42,8 @@ class MatyasCost final : public NLP_Cost {
   MatyasCost() = default;
   ~MatyasCost() = default;
 
+  MatyasCost* clone() const override { return new MatyasCost(*this); }
+
   size_t setCurrentParameter(const vector_t& x) override {
     x_ = x;
     return 0;
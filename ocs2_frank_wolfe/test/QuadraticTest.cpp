@@ -28,6 +28,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
 #include <iostream>
 
 #include "ocs2_frank_wolfe/GradientDescent.h"
@@ -39,6 +41,8 @@ class QuadraticCost final : public NLP_Cost {
   QuadraticCost() = default;
   ~QuadraticCost() = default;
 
+  QuadraticCost* clone() const override { return new QuadraticCost(*this); }
+
   size_t setCurrentParameter(const vector_t& x) override {
     x_ = x;
     return 0;
@@ -88,6 +92,40 @@ class QuadraticConstraints final : public NLP_Constraints {
   vector_t Dv_;
 };
 
+/**
+ * The box constraints of QuadraticConstraints with the additional ordering x(i) <= x(i+1), similar to the event times.
+ */
+class OrderedQuadraticConstraints final : public NLP_Constraints {
+ public:
+  OrderedQuadraticConstraints(scalar_t minX, scalar_t maxX, size_t numParameters) {
+    const size_t numOrderings = numParameters - 1;
+    Cm_.setZero(numOrderings + 2, numParameters);
+    Dv_.setZero(numOrderings + 2);
+
+    for (size_t i = 0; i < numOrderings; i++) {
+      Cm_(i, i) = -1.0;
+      Cm_(i, i + 1) = 1.0;
+    }
+    Cm_(numOrderings, 0) = 1.0;
+    Dv_(numOrderings) = -minX;
+    Cm_(numOrderings + 1, numParameters - 1) = -1.0;
+    Dv_(numOrderings + 1) = maxX;
+  }
+
+  ~OrderedQuadraticConstraints() = default;
+
+  void setCurrentParameter(const vector_t& x) override { x_ = x; }
+
+  void getLinearInequalityConstraint(vector_t& h) override { h = Cm_ * x_ + Dv_; }
+
+  void getLinearInequalityConstraintDerivative(matrix_t& dhdx) override { dhdx = Cm_; }
+
+ private:
+  vector_t x_;
+  matrix_t Cm_;
+  vector_t Dv_;
+};
+
 TEST(QuadraticTest, QuadraticTest) {
   NLP_Settings nlpSettings;
   nlpSettings.displayInfo_ = true;
@@ -120,3 +158,159 @@ TEST(QuadraticTest, QuadraticTest) {
 
   ASSERT_NEAR(cost, optimalCost, nlpSettings.minRelCost_) << "MESSAGE: Frank_Wolfe failed in the Quadratic test!";
 }
+
+TEST(QuadraticTest, WarmStartLP) {
+  NLP_Settings nlpSettings;
+  nlpSettings.displayInfo_ = false;
+  nlpSettings.maxIterations_ = 500;
+  nlpSettings.minRelCost_ = 1e-6;
+  nlpSettings.maxLearningRate_ = 1.0;
+  nlpSettings.minLearningRate_ = 1e-4;
+  nlpSettings.useAscendingLineSearchNLP_ = false;
+
+  constexpr size_t numParameters = 20;
+  const scalar_t minX = 1.0;
+  const scalar_t maxX = 3.0;
+  QuadraticCost cost;
+  OrderedQuadraticConstraints constraints(minX, maxX, numParameters);
+
+  vector_t initParameters = vector_t::Constant(numParameters, 0.5 * (maxX + minX)) + 0.5 * (maxX - minX) * vector_t::Random(numParameters);
+  std::sort(initParameters.data(), initParameters.data() + numParameters);
+  const vector_t maxGradientInverse = 0.1 * vector_t::Ones(numParameters);
+
+  // returns the average run time of a Frank-Wolfe iteration in microseconds
+  auto solve = [&](bool warmStartLP, scalar_t& optimizedCost, size_t& numIterations) {
+    nlpSettings.warmStartLP_ = warmStartLP;
+    GradientDescent nlpSolver(nlpSettings);
+    const auto start = std::chrono::steady_clock::now();
+    nlpSolver.run(initParameters, maxGradientInverse, &cost, &constraints);
+    const auto end = std::chrono::steady_clock::now();
+    nlpSolver.getCost(optimizedCost);
+    scalar_array_t iterationCost;
+    nlpSolver.getIterationsLog(iterationCost);
+    numIterations = iterationCost.size() - 1;
+    return std::chrono::duration<scalar_t, std::micro>(end - start).count() / std::max(numIterations, size_t(1));
+  };
+
+  scalar_t coldStartCost, warmStartCost;
+  size_t coldStartIterations, warmStartIterations;
+  const auto coldStartLatency = solve(false, coldStartCost, coldStartIterations);
+  const auto warmStartLatency = solve(true, warmStartCost, warmStartIterations);
+
+  std::cerr << "[QuadraticTest] LP cold start: iterations " << coldStartIterations << ",\tlatency per iteration " << coldStartLatency
+            << " [us]\n";
+  std::cerr << "[QuadraticTest] LP warm start: iterations " << warmStartIterations << ",\tlatency per iteration " << warmStartLatency
+            << " [us]\n";
+
+  // the warm start only changes the initial basis of the simplex method, therefore both converge to the same optimum
+  const scalar_t optimalCost = 0.5 * numParameters * minX * minX;
+  EXPECT_NEAR(coldStartCost, optimalCost, numParameters * nlpSettings.minRelCost_);
+  EXPECT_NEAR(warmStartCost, optimalCost, numParameters * nlpSettings.minRelCost_);
+}
+
+TEST(QuadraticTest, ParallelLineSearch) {
+  NLP_Settings nlpSettings;
+  nlpSettings.displayInfo_ = false;
+  nlpSettings.maxIterations_ = 500;
+  nlpSettings.minRelCost_ = 1e-6;
+  nlpSettings.maxLearningRate_ = 1.0;
+  nlpSettings.minLearningRate_ = 1e-4;
+  nlpSettings.useAscendingLineSearchNLP_ = false;
+
+  constexpr size_t numParameters = 20;
+  const scalar_t minX = 1.0;
+  const scalar_t maxX = 3.0;
+  QuadraticCost cost;
+  OrderedQuadraticConstraints constraints(minX, maxX, numParameters);
+
+  vector_t initParameters = vector_t::Constant(numParameters, 0.5 * (maxX + minX)) + 0.5 * (maxX - minX) * vector_t::Random(numParameters);
+  std::sort(initParameters.data(), initParameters.data() + numParameters);
+  const vector_t maxGradientInverse = 0.1 * vector_t::Ones(numParameters);
+
+  auto solve = [&](size_t nThreads, scalar_t& optimizedCost, vector_t& optimizedParameters, scalar_array_t& iterationCost) {
+    nlpSettings.nThreads_ = nThreads;
+    GradientDescent nlpSolver(nlpSettings);
+    nlpSolver.run(initParameters, maxGradientInverse, &cost, &constraints);
+    nlpSolver.getCost(optimizedCost);
+    nlpSolver.getParameters(optimizedParameters);
+    nlpSolver.getIterationsLog(iterationCost);
+  };
+
+  scalar_t sequentialCost, parallelCost;
+  vector_t sequentialParameters, parallelParameters;
+  scalar_array_t sequentialIterationCost, parallelIterationCost;
+  solve(1, sequentialCost, sequentialParameters, sequentialIterationCost);
+  solve(4, parallelCost, parallelParameters, parallelIterationCost);
+
+  // the batches of step sizes are accepted in the sequential order, therefore both take the same iterates
+  EXPECT_EQ(sequentialIterationCost.size(), parallelIterationCost.size());
+  EXPECT_DOUBLE_EQ(sequentialCost, parallelCost);
+  EXPECT_TRUE(sequentialParameters.isApprox(parallelParameters));
+  EXPECT_NEAR(parallelCost, 0.5 * numParameters * minX * minX, numParameters * nlpSettings.minRelCost_);
+}
+
+/**
+ * The cost of QuadraticCost which keeps the parameters of each ID, such that the line search trials do not overwrite the solution which
+ * the optimized ID refers to.
+ */
+class CachedQuadraticCost final : public NLP_Cost {
+ public:
+  CachedQuadraticCost* clone() const override { return new CachedQuadraticCost(*this); }
+
+  size_t setCurrentParameter(const vector_t& x) override {
+    xCache_.push_back(x);
+    return xCache_.size() - 1;
+  }
+
+  bool getCost(size_t id, scalar_t& f) override {
+    f = 0.5 * xCache_[id].dot(xCache_[id]);
+    return true;
+  }
+
+  void getCostDerivative(size_t id, vector_t& g) override { g = xCache_[id]; }
+
+  void getCostSecondDerivative(size_t id, matrix_t& H) override { H.setIdentity(xCache_[id].size(), xCache_[id].size()); }
+
+  void clearCache() override { xCache_.clear(); }
+
+ private:
+  vector_array_t xCache_;
+};
+
+TEST(QuadraticTest, ParallelAscendingLineSearch) {
+  NLP_Settings nlpSettings;
+  nlpSettings.displayInfo_ = false;
+  nlpSettings.maxIterations_ = 500;
+  nlpSettings.minRelCost_ = 1e-9;
+  nlpSettings.maxLearningRate_ = 1.0;
+  nlpSettings.minLearningRate_ = 1e-3;
+  nlpSettings.useAscendingLineSearchNLP_ = true;
+
+  constexpr size_t numParameters = 10;
+  CachedQuadraticCost cost;
+  const vector_t initParameters = vector_t::Random(numParameters);
+  const vector_t maxGradientInverse = vector_t::Zero(numParameters);
+
+  auto solve = [&](size_t nThreads, scalar_t& optimizedCost, vector_t& optimizedParameters, scalar_array_t& iterationCost) {
+    nlpSettings.nThreads_ = nThreads;
+    GradientDescent nlpSolver(nlpSettings);
+    nlpSolver.run(initParameters, maxGradientInverse, &cost);
+    nlpSolver.getCost(optimizedCost);
+    nlpSolver.getParameters(optimizedParameters);
+    nlpSolver.getIterationsLog(iterationCost);
+  };
+
+  scalar_t sequentialCost, parallelCost;
+  vector_t sequentialParameters, parallelParameters;
+  scalar_array_t sequentialIterationCost, parallelIterationCost;
+  solve(1, sequentialCost, sequentialParameters, sequentialIterationCost);
+  solve(4, parallelCost, parallelParameters, parallelIterationCost);
+
+  // all the trial steps of an ascending line search start from the same parameters
+  ASSERT_EQ(sequentialIterationCost.size(), parallelIterationCost.size());
+  for (size_t i = 0; i < sequentialIterationCost.size(); i++) {
+    EXPECT_DOUBLE_EQ(sequentialIterationCost[i], parallelIterationCost[i]);
+  }
+  EXPECT_TRUE(sequentialParameters.isApprox(parallelParameters));
+  EXPECT_LT(parallelCost, 1e-6);
+}
@@ -0,0 +1,128 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <functional>
+#include <iosfwd>
+#include <memory>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/reference/TargetTrajectories.h>
+#include <ocs2_oc/oc_problem/OptimalControlProblem.h>
+#include <ocs2_oc/rollout/RolloutBase.h>
+
+#include "ocs2_mpc/MPC_BASE.h"
+#include "ocs2_mpc/MPC_MRT_Interface.h"
+#include "ocs2_mpc/SystemObservation.h"
+
+namespace ocs2 {
+namespace closed_loop_simulation {
+
+/** The settings of the closed-loop simulation. */
+struct Settings {
+  /** The frequency of the simulation steps in Hz, i.e. the simulated MRT loop. */
+  scalar_t mrtDesiredFrequency = 100.0;
+  /** The simulated MPC frequency in Hz. MPC runs on every mrtDesiredFrequency / mpcDesiredFrequency simulation step. */
+  scalar_t mpcDesiredFrequency = 10.0;
+  /** The simulated duration in seconds. */
+  scalar_t duration = 1.0;
+  /** Whether the closed-loop trajectories are stored in the result. */
+  bool storeTrajectories = true;
+};
+
+/** The result of the closed-loop simulation. */
+struct Result {
+  /** The closed-loop trajectories, sampled at the simulation steps. The input is the one applied over the following step. */
+  scalar_array_t timeTrajectory;
+  vector_array_t stateTrajectory;
+  vector_array_t inputTrajectory;
+
+  /** The intermediate cost (i.e. cost + soft constraints) of the closed-loop trajectory, integrated by the rectangle rule. */
+  scalar_t cost = 0.0;
+
+  /** The number of MPC runs and their solve time statistics in milliseconds. */
+  size_t numMpcRuns = 0;
+  scalar_t averageSolveTime = 0.0;
+  scalar_t maxSolveTime = 0.0;
+  scalar_t totalSolveTime = 0.0;
+
+  /** The wall time of the simulation in seconds and the ratio of the simulated time to it. */
+  scalar_t wallTime = 0.0;
+  scalar_t realTimeFactor = 0.0;
+};
+
+/** Prints the statistics of the result. */
+std::ostream& operator<<(std::ostream& stream, const Result& result);
+
+}  // namespace closed_loop_simulation
+
+/**
+ * A ROS independent closed-loop simulation of an MPC, which runs MPC and the simulation in lockstep as fast as possible. The MPC and the
+ * MRT run in one process through MPC_MRT_Interface, and time is simulated: MPC is run synchronously at the simulated MPC frequency and
+ * its policy is applied from the time of the observation on, i.e. the solve time does not delay the policy. This makes the closed-loop
+ * behavior reproducible and allows to evaluate long horizons of it much faster than real time, e.g., for regression tests and tuning.
+ *
+ * Contrary to the synchronized loop of MRT_ROS_Dummy_Loop, there are no rate sleeps and no topic round-trips.
+ */
+class ClosedLoopSimulation {
+ public:
+  /** Modifies the observation after each simulation step, e.g., to add a disturbance. */
+  using observation_modifier_t = std::function<void(SystemObservation&)>;
+
+  /**
+   * Constructor.
+   *
+   * @param [in] mpc: The MPC to be simulated.
+   * @param [in] settings: The simulation settings.
+   * @param [in] rolloutPtr: The rollout which integrates the system dynamics under the policy. If nullptr, the simulation follows the
+   *                         planned state of the policy instead.
+   */
+  ClosedLoopSimulation(MPC_BASE& mpc, closed_loop_simulation::Settings settings, const RolloutBase* rolloutPtr = nullptr);
+
+  /** Sets the function which modifies the observation after each simulation step. */
+  void setObservationModifier(observation_modifier_t observationModifier) { observationModifier_ = std::move(observationModifier); }
+
+  /**
+   * Resets the MPC and runs the closed-loop simulation for the duration of the settings.
+   *
+   * @param [in] initObservation: The initial observation.
+   * @param [in] initTargetTrajectories: The initial target trajectories.
+   * @return The closed-loop trajectories, the closed-loop cost, and the solve time statistics.
+   */
+  closed_loop_simulation::Result run(const SystemObservation& initObservation, const TargetTrajectories& initTargetTrajectories);
+
+ private:
+  const closed_loop_simulation::Settings settings_;
+  MPC_MRT_Interface mrt_;
+  std::unique_ptr<OptimalControlProblem> problemPtr_;  // used to evaluate the closed-loop cost
+  observation_modifier_t observationModifier_;
+};
+
+}  // namespace ocs2
@@ -36,12 +36,26 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace ocs2 {
 
+/**
+ * The wall times in seconds which the MPC has spent on a policy. They are durations rather than time stamps, hence the clocks of the MPC
+ * and the MRT need not be synchronized. All of them are zero if they are not measured.
+ */
+struct MpcTiming {
+  /** The reference manager and the synchronized modules (e.g. the gait receiver), which are part of the MPC run. */
+  scalar_t synchronizedModulesTime = 0.0;
+  /** The MPC run. */
+  scalar_t runTime = 0.0;
+  /** From receiving the initial observation to buffering the policy for the MRT, which includes the MPC run. */
+  scalar_t processingTime = 0.0;
+};
+
 /**
  * This class contains the policy requirements and desired set-point.
  */
 struct CommandData {
   SystemObservation mpcInitObservation_;
   TargetTrajectories mpcTargetTrajectories_;
+  MpcTiming mpcTiming_;
 };
 
 }  // namespace ocs2
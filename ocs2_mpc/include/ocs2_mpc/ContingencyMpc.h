@@ -0,0 +1,105 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <ocs2_core/reference/ModeSchedule.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
+
+#include "ocs2_mpc/MPC_BASE.h"
+
+namespace ocs2 {
+
+/**
+ * Contingency MPC: Besides the nominal problem, it solves the problems of several mode schedule hypotheses, e.g. an early or a late
+ * touchdown, concurrently from the same initial state. Each hypothesis has its own MPC instance, hence its own solver and optimal control
+ * problem, and its solver runs on a dedicated thread. The solvers share the cores through the thread pool which is passed to their
+ * constructors, where the number of threads in their settings limits the share of each of them.
+ *
+ * Before each run, the target trajectories and the mode schedule of the nominal reference manager are copied to the reference managers
+ * of the hypotheses, where the mode schedule is modified by the modifier of the hypothesis. Since the nominal solver updates its
+ * references concurrently, the hypotheses use the references of the previous run, except for the first run where the nominal problem is
+ * solved first. The policies of the hypotheses are passed to the MRT alongside the nominal policy (see MPC_MRT_Interface), which
+ * switches to one of them once the corresponding contact event is detected (see MRT_BASE::switchToContingencyPolicy).
+ */
+class ContingencyMpc final : public MPC_BASE {
+ public:
+  /**
+   * Modifies the mode schedule of the nominal problem into the mode schedule of a hypothesis.
+   * The function should have the following signature: ModeSchedule modifier(scalar_t initTime, const ModeSchedule& modeSchedule)
+   */
+  using mode_schedule_modifier_t = std::function<ModeSchedule(scalar_t, const ModeSchedule&)>;
+
+  /**
+   * Constructor
+   *
+   * @param [in] nominalMpcPtr: The MPC of the nominal problem. Its settings are the settings of the contingency MPC.
+   * @param [in] contingencyMpcPtrs: The MPCs of the hypotheses.
+   * @param [in] modeScheduleModifiers: The mode schedule modifier of each hypothesis.
+   */
+  ContingencyMpc(std::unique_ptr<MPC_BASE> nominalMpcPtr, std::vector<std::unique_ptr<MPC_BASE>> contingencyMpcPtrs,
+                 std::vector<mode_schedule_modifier_t> modeScheduleModifiers);
+
+  ~ContingencyMpc() override = default;
+
+  void reset() override;
+
+  void prepare(scalar_t nextTime) override;
+
+  SolverBase* getSolverPtr() override { return nominalMpcPtr_->getSolverPtr(); }
+  const SolverBase* getSolverPtr() const override { return nominalMpcPtr_->getSolverPtr(); }
+
+  size_t getNumContingencies() const override { return contingencyMpcPtrs_.size(); }
+  const SolverBase* getContingencySolverPtr(size_t index) const override { return contingencyMpcPtrs_.at(index)->getSolverPtr(); }
+
+  /** Gets the MPC of the given hypothesis. */
+  MPC_BASE& getContingencyMpc(size_t index) { return *contingencyMpcPtrs_.at(index); }
+
+ private:
+  void calculateController(scalar_t initTime, const vector_t& initState, scalar_t finalTime) override;
+
+  /** Copies the references of the nominal problem to the hypotheses. */
+  void updateContingencyReferences(scalar_t initTime);
+
+  /** Solves the problems of the hypotheses concurrently, and the nominal problem in the calling thread if solveNominal is set. */
+  void solveConcurrently(bool solveNominal, scalar_t initTime, const vector_t& initState, scalar_t finalTime);
+
+  std::unique_ptr<MPC_BASE> nominalMpcPtr_;
+  std::vector<std::unique_ptr<MPC_BASE>> contingencyMpcPtrs_;
+  std::vector<mode_schedule_modifier_t> modeScheduleModifiers_;
+
+  // runs the solvers of the hypotheses, the nominal solver runs in the calling thread
+  ThreadPool hypothesisThreadPool_;
+};
+
+}  // namespace ocs2
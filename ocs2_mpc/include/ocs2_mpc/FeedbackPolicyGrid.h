@@ -0,0 +1,90 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+
+#pragma once
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/reference/ModeSchedule.h>
+#include <ocs2_oc/oc_data/PrimalSolution.h>
+
+namespace ocs2 {
+
+/**
+ * A linear feedback policy u = u_ff(t) + K(t) * (x - x_ref(t)) which is sampled from a primal solution on a uniform time grid and
+ * stored in contiguous buffers. Since the grid is uniform, the evaluation does not search the time and it does not allocate memory
+ * once its outputs have their sizes, which makes it suitable for a high-rate feedback loop, e.g. at the actuator rate.
+ *
+ * The nominal state x_ref and the feedforward input u_ff are linearly interpolated between the grid points while the gain K is taken
+ * from the nearest grid point. The time step should therefore be small compared to the duration of the modes and the time scale of the
+ * gains. Controllers without feedback, e.g. FeedforwardController, result in a zero gain.
+ */
+class FeedbackPolicyGrid {
+ public:
+  /**
+   * Samples the policy of the primal solution on a uniform grid that covers its time trajectory.
+   *
+   * @param [in] primalSolution: The primal solution with a non-empty controller. The state and input dimensions should be constant.
+   * @param [in] timeStep: The time step of the grid.
+   */
+  void update(const PrimalSolution& primalSolution, scalar_t timeStep);
+
+  /** Clears the grid. */
+  void clear();
+
+  /** Whether the grid has been sampled. */
+  bool empty() const { return numPoints_ == 0; }
+
+  /** The time of the last grid point. */
+  scalar_t getFinalTime() const { return startTime_ + (numPoints_ - 1) * timeStep_; }
+
+  /**
+   * Evaluates the feedback policy. For times outside of the grid the policy is extrapolated with a zero-order hold.
+   *
+   * @param [in] time: The query time.
+   * @param [in] state: The query state.
+   * @param [out] nominalState: The nominal state x_ref(t).
+   * @param [out] input: The input u_ff(t) + K(t) * (x - x_ref(t)).
+   * @param [out] mode: The active mode.
+   */
+  void evaluate(scalar_t time, const vector_t& state, vector_t& nominalState, vector_t& input, size_t& mode) const;
+
+ private:
+  scalar_t startTime_ = 0.0;
+  scalar_t timeStep_ = 0.0;
+  size_t numPoints_ = 0;
+  bool hasFeedback_ = false;
+
+  matrix_t nominalStates_;      // stateDim x numPoints
+  matrix_t feedforwardInputs_;  // inputDim x numPoints
+  matrix_t gains_;              // inputDim x (stateDim * numPoints)
+  ModeSchedule modeSchedule_;
+};
+
+}  // namespace ocs2
@@ -33,8 +33,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/misc/Benchmark.h>
 
 #include <ocs2_oc/oc_solver/SolverBase.h>
+#include <ocs2_oc/rollout/RolloutBase.h>
 
 #include "ocs2_mpc/MPC_Settings.h"
+#include "ocs2_mpc/MpcRecording.h"
+#include "ocs2_mpc/MpcScheduler.h"
 
 namespace ocs2 {
 
@@ -67,18 +70,66 @@ class MPC_BASE {
    */
   virtual bool run(scalar_t currentTime, const vector_t& currentState);
 
+  /**
+   * Prepares the problem of the next run at nextTime, e.g. the time discretization and the LQ approximation around the predicted
+   * solution, such that the next run(nextTime, state) only does the state dependent work. The default implementation does nothing.
+   *
+   * @param [in] nextTime: The predicted time of the next run.
+   */
+  virtual void prepare(scalar_t nextTime) {}
+
+  /**
+   * Calls prepare() for the predicted time of the next run if the pipelined preparation is enabled in the settings. The next run is
+   * predicted at 1 / mpcDesiredFrequency_ after the current one or, if the frequency is not set, after the average run time of MPC.
+   *
+   * @param [in] currentTime: The time of the latest run.
+   */
+  void prepareNextRun(scalar_t currentTime);
+
   /** Gets a pointer to the underlying solver used in the MPC. */
   virtual SolverBase* getSolverPtr() = 0;
 
   /** Gets a const pointer to the underlying solver used in the MPC. */
   virtual const SolverBase* getSolverPtr() const = 0;
 
-  /** Returns the time horizon for which the optimizer is called. */
-  scalar_t getTimeHorizon() const { return mpcSettings_.timeHorizon_; }
+  /** Gets the number of the contingency hypotheses which are solved besides the nominal problem, see ContingencyMpc. */
+  virtual size_t getNumContingencies() const { return 0; }
+
+  /** Gets a const pointer to the solver of the given contingency hypothesis. */
+  virtual const SolverBase* getContingencySolverPtr(size_t index) const {
+    throw std::runtime_error("[MPC_BASE::getContingencySolverPtr] This MPC does not solve contingency hypotheses!");
+  }
+
+  /** Returns the time horizon for which the optimizer is called, which is adapted by the scheduler if adaptiveScheduling_ is set. */
+  scalar_t getTimeHorizon() const {
+    return mpcSettings_.adaptiveScheduling_ ? scheduler_.getSchedule().timeHorizon : mpcSettings_.timeHorizon_;
+  }
+
+  /** Gets the scheduler which adapts the time horizon and the solver deadline if adaptiveScheduling_ is set. */
+  MpcScheduler& getScheduler() { return scheduler_; }
+  const MpcScheduler& getScheduler() const { return scheduler_; }
 
   /** Gets the MPC settings. */
   const mpc::Settings& settings() const { return mpcSettings_; }
 
+  /** Gets the estimated MPC delay in seconds which is compensated if delayCompensation_ is set. */
+  scalar_t getDelayEstimate() const { return delayEstimate_; }
+
+  /**
+   * Sets the recorder which logs the inputs of each cycle, i.e. the initial condition, the references, and the warm start of the solver,
+   * for an offline replay (see mpc_recording::replayCycle). A null pointer disables the recording.
+   */
+  void setRecorder(std::shared_ptr<mpc_recording::Recorder> recorderPtr) { recorderPtr_ = std::move(recorderPtr); }
+
+  /**
+   * Sets the writer of the checkpoints of the warm state of the MPC, which a restarted MPC restores (see
+   * mpc_recording::restoreCheckpoint). The state is captured after the solver runs at the period of the writer. A null pointer disables
+   * the checkpoints.
+   */
+  void setCheckpointWriter(std::shared_ptr<mpc_recording::CheckpointWriter> checkpointWriterPtr) {
+    checkpointWriterPtr_ = std::move(checkpointWriterPtr);
+  }
+
  protected:
   /**
    * Solves the optimal control problem for the given state and time period ([initTime,finalTime]).
@@ -93,10 +144,25 @@ class MPC_BASE {
   bool isFirstMpcRun() const { return initRun_; }
 
  private:
+  /**
+   * Predicts the initial time and state of MPC by the estimated delay with a rollout of the previous policy.
+   *
+   * @param [in, out] time: The current time which is moved to the predicted time.
+   * @param [in, out] state: The current state which is replaced by the predicted state.
+   */
+  void predictInitialCondition(scalar_t& time, vector_t& state);
+
   bool initRun_ = true;
   const mpc::Settings mpcSettings_;
 
   benchmark::RepeatedTimer mpcTimer_;
+
+  scalar_t delayEstimate_ = 0.0;
+  std::unique_ptr<RolloutBase> delayRolloutPtr_;
+
+  MpcScheduler scheduler_;
+  std::shared_ptr<mpc_recording::Recorder> recorderPtr_;
+  std::shared_ptr<mpc_recording::CheckpointWriter> checkpointWriterPtr_;
 };
 
 }  // namespace ocs2
@@ -38,6 +38,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/misc/Benchmark.h>
 #include <ocs2_core/model_data/Multiplier.h>
+#include <ocs2_core/thread_support/TripleBuffer.h>
 #include "ocs2_mpc/MPC_BASE.h"
 #include "ocs2_mpc/MRT_BASE.h"
 
@@ -59,6 +60,10 @@ class MPC_MRT_Interface final : public MRT_BASE {
 
   void resetMpcNode(const TargetTrajectories& initTargetTrajectories) override;
 
+  /**
+   * Sets the observation used by the next advanceMpc() call. This method is wait-free and does not allocate once the observation
+   * dimensions are constant. It should only be called from a single thread.
+   */
   void setCurrentObservation(const SystemObservation& currentObservation) override;
 
   /*
@@ -116,19 +121,12 @@ class MPC_MRT_Interface final : public MRT_BASE {
   MultiplierCollection getIntermediateDualSolution(scalar_t time) const;
 
  private:
-  /**
-   * Updates the buffer variables from the MPC object. This method is automatically called by advanceMpc()
-   *
-   * @param [in] mpcInitObservation: The observation used to run the MPC.
-   */
-  void copyToBuffer(const SystemObservation& mpcInitObservation);
-
   MPC_BASE& mpc_;
   benchmark::RepeatedTimer mpcTimer_;
 
   // MPC inputs
-  SystemObservation currentObservation_;
-  std::mutex observationMutex_;
+  TripleBuffer<SystemObservation> observationBuffer_;  // written by setCurrentObservation(), read by advanceMpc()
+  SystemObservation mpcObservation_;                    // the observation used by the current MPC iteration
 };
 
 }  // namespace ocs2
@@ -68,6 +68,32 @@ struct Settings {
    * set to a positive number which can be interpreted as the tracking controller's frequency.
    */
   scalar_t mrtDesiredFrequency_ = 100.0;
+
+  /**
+   * If true, the MPC interfaces start the preparation of the next MPC problem (see MPC_BASE::prepare) right after the policy is handed
+   * over for publication, such that the preparation overlaps with the publication and with the wait for the next observation.
+   */
+  bool pipelinedPreparation_ = false;
+
+  /**
+   * If true, MPC solves from the state predicted at the current time plus the estimated MPC delay instead of from the measured state,
+   * since the policy is only applied once it is computed. The state is predicted with a rollout of the previous policy. The delay is
+   * estimated by an exponential moving average of the measured MPC run times, where the latest run time is weighted with
+   * delayCompensationSmoothing_.
+   */
+  bool delayCompensation_ = false;
+  scalar_t delayCompensationSmoothing_ = 0.2;
+
+  /**
+   * If true, the time horizon is adapted within [minTimeHorizon_, maxTimeHorizon_] to meet targetLatency_ (in seconds) per run, and
+   * the solver stops iterating at targetLatency_ after the start of a run (see MpcScheduler). A non-positive bound is interpreted as
+   * timeHorizon_. The schedulingAdaptationRate_ in [0, 1] is the gain of the horizon update.
+   */
+  bool adaptiveScheduling_ = false;
+  scalar_t targetLatency_ = 0.01;
+  scalar_t minTimeHorizon_ = -1;
+  scalar_t maxTimeHorizon_ = -1;
+  scalar_t schedulingAdaptationRate_ = 0.5;
 };
 
 /**
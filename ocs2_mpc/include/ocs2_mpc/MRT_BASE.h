@@ -35,18 +35,24 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <cstddef>
 #include <memory>
 #include <mutex>
+#include <vector>
 
 #include <ocs2_core/Types.h>
 #include <ocs2_core/control/ControllerBase.h>
 #include <ocs2_core/misc/LinearInterpolation.h>
+#include <ocs2_core/misc/Tracer.h>
 #include <ocs2_core/reference/ModeSchedule.h>
 #include <ocs2_core/reference/TargetTrajectories.h>
+#include <ocs2_core/thread_support/TripleBuffer.h>
 #include <ocs2_oc/oc_data/PerformanceIndex.h>
 #include <ocs2_oc/oc_data/PrimalSolution.h>
 #include <ocs2_oc/rollout/RolloutBase.h>
 
 #include "ocs2_mpc/CommandData.h"
+#include "ocs2_mpc/FeedbackPolicyGrid.h"
+#include "ocs2_mpc/MPC_BASE.h"
 #include "ocs2_mpc/MrtObserver.h"
+#include "ocs2_mpc/PolicySelector.h"
 #include "ocs2_mpc/SystemObservation.h"
 
 namespace ocs2 {
@@ -63,6 +69,7 @@ class MRT_BASE {
 
   /**
    * Resets the class to its instantiated state.
+   * @warning This method should not be called concurrently with updatePolicy().
    */
   void reset();
 
@@ -115,7 +122,9 @@ class MRT_BASE {
   void initRollout(const RolloutBase* rolloutPtr);
 
   /**
-   * @brief Evaluates the controller
+   * @brief Evaluates the controller. The lookups in the policy start where the previous evaluation ended, hence the evaluation does
+   * constant work for the increasing query times of a control loop. The linear and feedforward controllers are evaluated without
+   * memory allocation once mpcState and mpcInput have their sizes.
    *
    * @param [in] currentTime: the query time.
    * @param [in] currentState: the query state.
@@ -138,15 +147,56 @@ class MRT_BASE {
   void rolloutPolicy(scalar_t currentTime, const vector_t& currentState, const scalar_t& timeStep, vector_t& mpcState, vector_t& mpcInput,
                      size_t& mode);
 
+  /**
+   * @brief Enables the high-rate feedback mode, see evaluateFeedbackPolicy(). Each policy that is received afterwards is sampled on a
+   * uniform time grid by the thread that fills the policy buffer, hence modifications by MrtObserver::modifyActiveSolution() are not
+   * reflected in the sampled policy. A non-positive time step disables the mode.
+   *
+   * @param [in] timeStep: The time step of the grid.
+   */
+  void initFeedbackPolicyGrid(scalar_t timeStep);
+
+  /**
+   * @brief Evaluates the linear feedback policy u = u_ff(t) + K(t) * (x - x_ref(t)) of the MPC solution, which is sampled on the grid
+   * of initFeedbackPolicyGrid(). The evaluation is constant time and it does not allocate memory once mpcState and mpcInput have their
+   * sizes, which suits a feedback loop at the actuator rate while the nominal solution is only rolled out occasionally.
+   *
+   * @param [in] currentTime: the query time.
+   * @param [in] currentState: the query state.
+   * @param [out] mpcState: the nominal state of MPC x_ref(t).
+   * @param [out] mpcInput: the feedback control input.
+   * @param [out] mode: the active mode.
+   */
+  void evaluateFeedbackPolicy(scalar_t currentTime, const vector_t& currentState, vector_t& mpcState, vector_t& mpcInput, size_t& mode);
+
   /**
    * Checks the data buffer for an update of the MPC policy. If a new policy
    * is available on the buffer this method will load it to the in-use policy.
    * This method also calls the modifyActiveSolution() method.
    *
+   * This method never blocks: the policy is exchanged through a wait-free triple buffer and the previously
+   * in-use policy is released by the thread that fills the buffer.
+   *
    * @return True if the policy is updated.
    */
   bool updatePolicy();
 
+  /**
+   * Gets the number of the contingency policies of the in-use policy, see ContingencyMpc.
+   */
+  size_t getNumContingencyPolicies() const { return policyBuffer_.front().contingencyPolicyPtrs.size(); }
+
+  /**
+   * Switches to the policy of the given contingency hypothesis of the MPC, e.g. once an early touchdown is detected. The switch swaps the
+   * in-use policy with the contingency policy, hence it is constant time and the previous policy can be switched back to with the same
+   * index. The policy stays in use until the next call of updatePolicy() loads a new one. This method also calls the
+   * modifyActiveSolution() method.
+   * @warning This method should not be called concurrently with the evaluation methods and updatePolicy().
+   *
+   * @param [in] index: The index of the contingency hypothesis.
+   */
+  void switchToContingencyPolicy(size_t index);
+
   /**
    * @brief rolloutSet: Whether or not the internal rollout object has been set
    * @return True if a rollout object is available.
@@ -158,38 +208,125 @@ class MRT_BASE {
    */
   void addMrtObserver(std::shared_ptr<MrtObserver> mrtObserver) { observerPtrArray_.push_back(std::move(mrtObserver)); };
 
+  /**
+   * Sets the tracer which records the buffering and the swaps of the policies (see benchmark::Tracer). A null pointer disables the
+   * tracing. It should be set before the first policy is received.
+   */
+  void setTracer(std::shared_ptr<benchmark::Tracer> tracerPtr) { tracerPtr_ = std::move(tracerPtr); }
+
+  /**
+   * Gets the number of buffered policies which have been replaced by a newer policy before updatePolicy() has picked them up.
+   */
+  size_t getNumOverwrittenPolicies() const { return numOverwrittenPolicies_; }
+
+  /**
+   * Sets the selector which decides whether a policy received by moveToBuffer() replaces the previous one, e.g. if the policies of a
+   * remote and an onboard MPC are received, see PolicySelector. The rejected policies are not buffered. By default, all the policies
+   * are accepted.
+   */
+  void setPolicySelector(PolicySelector policySelector);
+
+  /**
+   * Gets the number of policies which have been rejected by the policy selector.
+   */
+  size_t getNumRejectedPolicies() const { return numRejectedPolicies_; }
+
+  /**
+   * Gets the index of the source of the in-use policy, see setPolicySelector().
+   */
+  size_t getPolicySource() const { return policyBuffer_.front().source; }
+
  protected:
+  /**
+   * Moves the policy of the MPC to the buffer, from which updatePolicy() loads it.
+   *
+   * @param [in] commandDataPtr: The command data of the MPC.
+   * @param [in] primalSolutionPtr: The policy data of the MPC.
+   * @param [in] performanceIndicesPtr: The performance indices data of the solver.
+   * @param [in] contingencyPolicyPtrs: The policies of the contingency hypotheses of the MPC, if any.
+   * @param [in] policySource: The index of the source of the policy, see setPolicySelector().
+   */
   void moveToBuffer(std::unique_ptr<CommandData> commandDataPtr, std::unique_ptr<PrimalSolution> primalSolutionPtr,
-                    std::unique_ptr<PerformanceIndex> performanceIndicesPtr);
+                    std::unique_ptr<PerformanceIndex> performanceIndicesPtr,
+                    std::vector<std::unique_ptr<PrimalSolution>> contingencyPolicyPtrs = {}, size_t policySource = 0);
+
+  /**
+   * Copies the solution of the latest MPC iteration, including its contingency hypotheses, into recycled storage and moves it to the
+   * buffer.
+   *
+   * @param [in] mpc: The MPC which has just been run.
+   * @param [in] mpcInitObservation: The observation used to run the MPC.
+   * @param [in] policySource: The index of the source of the policy, see setPolicySelector().
+   */
+  void copySolutionToBuffer(const MPC_BASE& mpc, const SystemObservation& mpcInitObservation, size_t policySource = 0);
+
+  /**
+   * Gets the storage of a policy which has been released by the MRT, or new storage if there is none. The storage of the released
+   * policies is recycled instead of destroyed, hence filling it by copy assignment reuses the memory of its trajectories and the
+   * policies are handed to moveToBuffer() without allocating their trajectories anew.
+   *
+   * @param [out] commandDataPtr: The storage of the command data.
+   * @param [out] primalSolutionPtr: The storage of the policy data.
+   * @param [out] performanceIndicesPtr: The storage of the performance indices data.
+   */
+  void getRecycledPolicy(std::unique_ptr<CommandData>& commandDataPtr, std::unique_ptr<PrimalSolution>& primalSolutionPtr,
+                         std::unique_ptr<PerformanceIndex>& performanceIndicesPtr);
+
+  /**
+   * Gets the storage of the contingency policies which have been released by the MRT, see getRecycledPolicy().
+   *
+   * @param [in] numContingencies: The number of the contingency hypotheses.
+   * @param [out] contingencyPolicyPtrs: The storage of the contingency policies.
+   */
+  void getRecycledContingencyPolicies(size_t numContingencies, std::vector<std::unique_ptr<PrimalSolution>>& contingencyPolicyPtrs);
 
  private:
-  /** Calls modifyActiveSolution on all mrt observers. This function is called while holding a policyBufferMutex lock */
+  /** The MPC output which is exchanged between the MPC and the MRT threads. */
+  struct Policy {
+    std::unique_ptr<CommandData> commandPtr;
+    std::unique_ptr<PrimalSolution> primalSolutionPtr;
+    std::unique_ptr<PerformanceIndex> performanceIndicesPtr;
+    FeedbackPolicyGrid feedbackPolicyGrid;  // only sampled if the feedback policy grid is enabled
+    std::vector<std::unique_ptr<PrimalSolution>> contingencyPolicyPtrs;
+    std::vector<FeedbackPolicyGrid> contingencyFeedbackPolicyGrids;  // sampled like feedbackPolicyGrid
+    size_t source = 0;
+  };
+
+  /** Calls modifyActiveSolution on all mrt observers. This function is called on the thread calling updatePolicy() */
   void modifyActiveSolution(const CommandData& command, PrimalSolution& primalSolution);
 
-  /** Calls modifyBufferedSolution on all mrt observers. This function is called while holding a policyBufferMutex lock */
+  /** Calls modifyBufferedSolution on all mrt observers. This function is called on the thread calling moveToBuffer() */
   void modifyBufferedSolution(const CommandData& commandBuffer, PrimalSolution& primalSolutionBuffer);
 
   // flags on state of the class
   std::atomic_bool policyReceivedEver_;
-  bool newPolicyInBuffer_;  // whether a new policy is waiting to be swapped in
+  std::atomic<size_t> numOverwrittenPolicies_{0};
+  std::atomic<size_t> numRejectedPolicies_{0};
+
+  // variables related to the MPC output: front is the in-use policy, back is filled by moveToBuffer()
+  TripleBuffer<Policy> policyBuffer_;
 
-  // variables related to the MPC output
-  std::unique_ptr<CommandData> activeCommandPtr_;
-  std::unique_ptr<CommandData> bufferCommandPtr_;
-  std::unique_ptr<PrimalSolution> activePrimalSolutionPtr_;
-  std::unique_ptr<PrimalSolution> bufferPrimalSolutionPtr_;
-  std::unique_ptr<PerformanceIndex> activePerformanceIndicesPtr_;
-  std::unique_ptr<PerformanceIndex> bufferPerformanceIndicesPtr_;
+  // the storage of the last policy which has been released by the MRT, guarded by producerMutex_
+  std::unique_ptr<CommandData> recycledCommandPtr_;
+  std::unique_ptr<PrimalSolution> recycledPrimalSolutionPtr_;
+  std::unique_ptr<PerformanceIndex> recycledPerformanceIndicesPtr_;
+  std::vector<std::unique_ptr<PrimalSolution>> recycledContingencyPolicyPtrs_;
 
   // thread safety
-  mutable std::mutex bufferMutex_;  // for policy variables with the prefix (buffer*)
-  const size_t mrtTrylockWarningThreshold_ = 5;
-  size_t mrtTrylockWarningCount_;
+  std::mutex producerMutex_;  // serializes moveToBuffer(), getRecycledPolicy(), and reset()
+  scalar_t feedbackPolicyGridTimeStep_ = 0.0;  // guarded by producerMutex_
+  PolicySelector policySelector_;               // guarded by producerMutex_
 
   // variables needed for policy evaluation
   std::unique_ptr<RolloutBase> rolloutPtr_;
+  scalar_array_t rolloutQueryTimes_;    // buffer of rolloutPolicy()
+  vector_array_t rolloutQueryStates_;  // buffer of rolloutPolicy()
+  int stateCursor_ = 0;  // cursor of the state trajectory lookup in evaluatePolicy()
+  int inputCursor_ = 0;  // cursor of the controller lookup in evaluatePolicy()
 
   std::vector<std::shared_ptr<MrtObserver>> observerPtrArray_;
+
+  std::shared_ptr<benchmark::Tracer> tracerPtr_;
 };
 
 }  // namespace ocs2
@@ -0,0 +1,248 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/reference/ModeSchedule.h>
+#include <ocs2_core/reference/TargetTrajectories.h>
+#include <ocs2_oc/oc_data/DualSolution.h>
+#include <ocs2_oc/oc_data/PrimalSolution.h>
+
+namespace ocs2 {
+
+class MPC_BASE;
+
+namespace mpc_recording {
+
+/** The inputs of an MPC cycle as seen by the solver, and its recorded solve time */
+struct CycleRecord {
+  /** The index of the cycle since the recorder was created. */
+  uint64_t cycleIndex = 0;
+  /** The hash of the settings of the recorded MPC (see hashFile). */
+  uint64_t settingsHash = 0;
+  /** The initial time and state of the solver, i.e. after the delay compensation, and the final time. */
+  scalar_t initTime = 0.0;
+  vector_t initState;
+  scalar_t finalTime = 0.0;
+  /** The wall time of the solver run in milliseconds. */
+  scalar_t solveTime = 0.0;
+  /** The references which are active in the solver run. */
+  TargetTrajectories targetTrajectories;
+  ModeSchedule modeSchedule;
+  /** The solution of the previous cycle which warm starts the solver. It is empty on the first cycle and for cold starts. */
+  PrimalSolution warmStart;
+};
+
+/** Returns the FNV-1a hash of the content of a file, e.g. the task file with the solver settings. Throws if the file can not be read. */
+uint64_t hashFile(const std::string& fileName);
+
+/**
+ * Writes the MPC cycles into a binary log. The log starts with a header (magic number and format version) followed by the records, each
+ * of which is its size followed by the serialized CycleRecord in full precision. The records are written on the calling thread.
+ */
+class Recorder {
+ public:
+  /**
+   * Constructor. Creates the log file, an existing file is overwritten.
+   *
+   * @param [in] fileName: The file of the log.
+   * @param [in] settingsHash: The hash of the settings of the recorded MPC which is stored in every record (see hashFile).
+   */
+  Recorder(const std::string& fileName, uint64_t settingsHash);
+
+  /** Gets the hash of the settings of the recorded MPC. */
+  uint64_t getSettingsHash() const { return settingsHash_; }
+
+  /**
+   * Appends a cycle to the log. The cycle index and the settings hash of the record are set by the recorder.
+   *
+   * @param [in] record: The cycle.
+   */
+  void record(const CycleRecord& record);
+
+ private:
+  std::ofstream file_;
+  const uint64_t settingsHash_;
+  uint64_t numCycles_ = 0;
+  std::vector<uint8_t> buffer_;
+};
+
+/**
+ * Reads the log written by Recorder. The file is memory-mapped and indexed on construction, a record is only decoded when it is read. A
+ * truncated last record, e.g. of a process which has been killed, is ignored.
+ */
+class LogReader {
+ public:
+  /**
+   * Constructor. Throws if the file is not a log of MPC cycles.
+   *
+   * @param [in] fileName: The file of the log.
+   */
+  explicit LogReader(const std::string& fileName);
+
+  /** Destructor. Unmaps the file. */
+  ~LogReader();
+
+  LogReader(const LogReader&) = delete;
+  LogReader& operator=(const LogReader&) = delete;
+
+  /** The number of records in the log. */
+  size_t size() const { return recordOffsets_.size(); }
+
+  /**
+   * Decodes a record. Throws if the record is malformed.
+   *
+   * @param [in] index: The index of the record in the log.
+   */
+  CycleRecord read(size_t index) const;
+
+ private:
+  const uint8_t* dataPtr_ = nullptr;
+  size_t dataSize_ = 0;
+  std::vector<std::pair<size_t, size_t>> recordOffsets_;  // the offset and the size of the payload of each record
+};
+
+/**
+ * Reruns a recorded cycle with the solver of the given MPC: the solver is reset, the recorded references are set, and the solver is run
+ * from the recorded initial condition with the recorded warm start and without a deadline. With the same problem and solver settings,
+ * the replay is deterministic for the solvers which are only warm started by the primal solution. Note that a reference manager which
+ * generates its references in preSolverRun (e.g. from a gait schedule) may modify the recorded ones.
+ *
+ * @param [in, out] mpc: The MPC whose solver is run.
+ * @param [in] record: The recorded cycle.
+ * @return The wall time of the solver run in milliseconds.
+ */
+scalar_t replayCycle(MPC_BASE& mpc, const CycleRecord& record);
+
+/** The warm state of an MPC from which it continues after a restart */
+struct Checkpoint {
+  /** The hash of the settings of the MPC (see hashFile). */
+  uint64_t settingsHash = 0;
+  /** The initial and the final time of the solver run. */
+  scalar_t initTime = 0.0;
+  scalar_t finalTime = 0.0;
+  /** The references of the solver run. */
+  TargetTrajectories targetTrajectories;
+  ModeSchedule modeSchedule;
+  /** The solution of the solver run. The time discretization of the solvers is recovered from the time trajectory of the solution. */
+  PrimalSolution primalSolution;
+  DualSolution dualSolution;
+};
+
+/**
+ * Writes the warm state of an MPC periodically into a checkpoint file, from which a restarted MPC continues warm (see loadCheckpoint and
+ * restoreCheckpoint). The state is copied by capture() on the MPC thread, while it is serialized and written on a background thread. The
+ * checkpoint is written into a temporary file which then replaces the previous checkpoint, hence a process which is killed while writing
+ * leaves the previous checkpoint intact. Set it to the MPC with MPC_BASE::setCheckpointWriter().
+ *
+ * The file starts with a header (magic number and format version) followed by the serialized Checkpoint in full precision.
+ */
+class CheckpointWriter {
+ public:
+  /**
+   * Constructor. Starts the writer thread.
+   *
+   * @param [in] fileName: The file of the checkpoint.
+   * @param [in] settingsHash: The hash of the settings of the MPC which is stored in the checkpoint (see hashFile).
+   * @param [in] period: The minimum wall time between two checkpoints in seconds.
+   */
+  CheckpointWriter(std::string fileName, uint64_t settingsHash, scalar_t period = 1.0);
+
+  /** Destructor. Writes the pending checkpoint and stops the writer thread. */
+  ~CheckpointWriter();
+
+  CheckpointWriter(const CheckpointWriter&) = delete;
+  CheckpointWriter& operator=(const CheckpointWriter&) = delete;
+
+  /**
+   * Copies the warm state of the MPC after a solver run, if the period has elapsed since the previous checkpoint and the writer thread has
+   * written it. Otherwise it returns immediately without waiting for the writer thread.
+   *
+   * @param [in] mpc: The MPC whose solver has just been run.
+   * @param [in] initTime: The initial time of the solver run.
+   * @param [in] finalTime: The final time of the solver run.
+   */
+  void capture(const MPC_BASE& mpc, scalar_t initTime, scalar_t finalTime);
+
+  /** Gets the number of the written checkpoints. */
+  size_t getNumCheckpoints() const;
+
+ private:
+  void writerWorker();
+
+  const std::string fileName_;
+  const std::chrono::steady_clock::duration period_;
+  std::chrono::steady_clock::time_point lastCaptureTime_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable pendingCondition_;
+  Checkpoint checkpoint_;  // guarded by mutex_
+  bool isPending_ = false;
+  bool terminate_ = false;
+  size_t numCheckpoints_ = 0;
+  std::vector<uint8_t> buffer_;  // only accessed by the writer thread
+  std::thread writerThread_;
+};
+
+/**
+ * Loads a checkpoint written by CheckpointWriter. A missing or malformed file, or a checkpoint of other settings is not an error, since
+ * the MPC then starts cold.
+ *
+ * @param [in] fileName: The file of the checkpoint.
+ * @param [in] settingsHash: The hash of the settings of the MPC (see hashFile).
+ * @param [out] checkpoint: The loaded checkpoint.
+ * @return true if the checkpoint is loaded.
+ */
+bool loadCheckpoint(const std::string& fileName, uint64_t settingsHash, Checkpoint& checkpoint);
+
+/**
+ * Restores the warm state of the MPC from a checkpoint: the references are set to the reference manager of the solver, and the solution
+ * warm starts the first solver run (see SolverBase::setWarmStart), where it is shifted to the initial time of the run. The references are
+ * shifted by the same time, hence the given initial time should be the initial time of the first MPC run. It should be called at
+ * start-up before the first MPC run; the warm start survives a reset of the MPC, e.g. by the reset service of the MPC node, which also
+ * overrides the target trajectories.
+ *
+ * @param [in, out] mpc: The MPC to restore.
+ * @param [in] checkpoint: The checkpoint.
+ * @param [in] initTime: The initial time at which the MPC restarts.
+ */
+void restoreCheckpoint(MPC_BASE& mpc, Checkpoint checkpoint, scalar_t initTime);
+
+}  // namespace mpc_recording
+}  // namespace ocs2
@@ -0,0 +1,111 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+
+#include <ocs2_core/Types.h>
+
+#include "ocs2_mpc/MPC_Settings.h"
+
+namespace ocs2 {
+namespace mpc {
+
+/** The configuration of MPC chosen by the MpcScheduler for the next run. */
+struct Schedule {
+  /** The time horizon of the next run in seconds. */
+  scalar_t timeHorizon = 0.0;
+  /** The wall-clock budget of the next run in seconds, which bounds the number of solver iterations. */
+  scalar_t timeBudget = 0.0;
+  /** The measured duration of the latest run in seconds. */
+  scalar_t latestLatency = 0.0;
+};
+
+}  // namespace mpc
+
+/**
+ * Adapts the MPC time horizon to the measured run times such that MPC meets the target latency of the settings on computers of
+ * different speeds. Since the run time of the solvers grows about linearly with the horizon length at a fixed time step, the horizon is
+ * scaled by the ratio of the target latency to the measured one, with the adaptation rate as a gain, within
+ * [minTimeHorizon_, maxTimeHorizon_]. The number of iterations adapts through the deadline of the solver, which is set to the target
+ * latency after the start of each run (see SolverBase::setDeadline).
+ */
+class MpcScheduler {
+ public:
+  /** Input argument is the configuration of the next run. */
+  using schedule_callback_t = std::function<void(const mpc::Schedule&)>;
+
+  /**
+   * Constructor
+   *
+   * @param [in] mpcSettings: The MPC settings with the scheduling bounds.
+   */
+  explicit MpcScheduler(const mpc::Settings& mpcSettings);
+
+  /** Resets the schedule to the nominal time horizon. */
+  void reset();
+
+  /** Gets the configuration of the next run. */
+  const mpc::Schedule& getSchedule() const { return schedule_; }
+
+  /** Gets the solver deadline of a run that started at startTime. */
+  std::chrono::steady_clock::time_point getDeadline(std::chrono::steady_clock::time_point startTime) const;
+
+  /**
+   * Adapts the schedule to the measured duration of the latest run and passes it to the callback.
+   *
+   * @param [in] latency: The measured duration of the latest run in seconds.
+   */
+  void update(scalar_t latency);
+
+  /**
+   * Sets the callback which observes the chosen configuration after each update.
+   * The callback should have the following signature:
+   * void callback(const mpc::Schedule& schedule)
+   */
+  template <class CallbackType>
+  void setScheduleCallback(CallbackType&& callback) {
+    scheduleCallback_ = std::forward<CallbackType>(callback);
+  }
+
+ private:
+  const scalar_t nominalTimeHorizon_;
+  const scalar_t minTimeHorizon_;
+  const scalar_t maxTimeHorizon_;
+  const scalar_t targetLatency_;
+  const scalar_t adaptationRate_;
+
+  mpc::Schedule schedule_;
+  schedule_callback_t scheduleCallback_;
+};
+
+}  // namespace ocs2
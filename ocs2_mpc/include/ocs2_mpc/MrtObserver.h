@@ -29,6 +29,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <ocs2_oc/oc_data/PerformanceIndex.h>
 #include <ocs2_oc/oc_data/PrimalSolution.h>
 
 #include "ocs2_mpc/CommandData.h"
@@ -46,7 +47,8 @@ namespace ocs2 {
  * When a user requests an update, the in-use policy is swapped for the buffered policy.
  *      - At this point the "modifyActiveSolution" of this class is called.
  *
- * Both filling of the buffer and the update swapping are protected by the same mutex.
+ * Filling of the buffer and the update swapping are exchanged through a wait-free buffer. They are not mutually exclusive and
+ * can run concurrently on different threads, so any state shared between the two callbacks has to be synchronized by the observer.
  */
 class MrtObserver {
  public:
@@ -66,7 +68,7 @@ class MrtObserver {
    * This function is executed sequentially with updatePolicy and thus blocks the main thread. Computationally expensive modifications
    * should therefore rather be done in "modifyBufferedSolution".
    *
-   * A call to this function is protected by the same mutex as modifyBufferedSolution.
+   * This function may run concurrently with modifyBufferedSolution.
    */
   virtual void modifyActiveSolution(const CommandData& command, PrimalSolution& primalSolution) {}
 
@@ -74,11 +76,22 @@ class MrtObserver {
    * This method is called by the MRT when a new policy is loaded into the buffer.
    * It allows the user to modify the buffered solution before it can be swapped during the updatePolicy call.
    *
-   * When using a multi-threaded MRT, this function does not block the main thread.
+   * This function is executed by the thread that fills the buffer and thus never blocks the main thread.
    *
-   * A call to this function is protected by the same mutex as modifyActiveSolution.
+   * This function may run concurrently with modifyActiveSolution.
    */
   virtual void modifyBufferedSolution(const CommandData& commandBuffer, PrimalSolution& primalSolutionBuffer) {}
+
+  /**
+   * This method is called by the MRT after the buffered solution is modified by all the observers and before it can be swapped during
+   * the updatePolicy call. It allows the user to observe the final buffered policy together with its performance indices, e.g. for logging.
+   *
+   * This function is executed by the thread that fills the buffer and thus never blocks the main thread.
+   *
+   * This function may run concurrently with modifyActiveSolution.
+   */
+  virtual void bufferedPolicyReceived(const CommandData& commandBuffer, const PrimalSolution& primalSolutionBuffer,
+                                      const PerformanceIndex& performanceIndicesBuffer) {}
 };
 
 }  // namespace ocs2
\ No newline at end of file
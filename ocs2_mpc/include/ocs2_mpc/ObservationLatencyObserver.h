@@ -0,0 +1,141 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+
+#include "ocs2_mpc/MrtObserver.h"
+
+namespace ocs2 {
+
+/** Statistics of the latency from sending an observation to receiving the policy which is computed from it. */
+struct ObservationLatencyStatistics {
+  /** The number of received policies which are matched to a sent observation. */
+  size_t numSamples = 0;
+  /** The latest latency in seconds. */
+  scalar_t latest = 0.0;
+  /** The average latency in seconds. */
+  scalar_t average = 0.0;
+  /** The maximum latency in seconds. */
+  scalar_t maximum = 0.0;
+};
+
+/**
+ * The latency of a policy from sending its initial observation to the first actuation with it, split into consecutive stages which add
+ * up to the end-to-end latency. The durations are in seconds.
+ */
+struct PolicyLatency {
+  /** The reference manager and the synchronized modules of the MPC, e.g. a gait receiver or a ROS reference manager. */
+  scalar_t mpcModules = 0.0;
+  /** The MPC run without the synchronized modules. */
+  scalar_t mpcSolver = 0.0;
+  /** The rest of the MPC processing, e.g. waiting for the MPC node and buffering the policy. */
+  scalar_t mpcOverhead = 0.0;
+  /** Sending the observation and receiving the policy, including their serialization. */
+  scalar_t transport = 0.0;
+  /** From buffering the policy in the MRT until the control loop loads it with updatePolicy(). */
+  scalar_t policyWaiting = 0.0;
+  /** From loading the policy until the control loop actuates the system with it, e.g. the policy evaluation. */
+  scalar_t evaluation = 0.0;
+  /** From sending the observation until the actuation. */
+  scalar_t endToEnd = 0.0;
+};
+
+/**
+ * Measures the round trip latency of the MPC: the wall-clock time from sending an observation to the MPC until the policy computed from
+ * it is loaded into the MRT buffer. The policy is matched to the observation by the time of its initial observation, hence the wall
+ * clocks of the MPC and the MRT need not be synchronized. Add it to the MRT with MRT_BASE::addMrtObserver() and report each sent
+ * observation with observationSent().
+ *
+ * If the control loop also reports its actuations with policyActuated(), the observer breaks down the latency up to the first actuation
+ * with a policy into stages (see PolicyLatency), using the wall times which the MPC reports in CommandData::mpcTiming_.
+ */
+class ObservationLatencyObserver final : public MrtObserver {
+ public:
+  /**
+   * Constructor
+   *
+   * @param [in] historyLength: The number of the latest sent observations which are kept for matching.
+   */
+  explicit ObservationLatencyObserver(size_t historyLength = 64);
+
+  /** Records the wall-clock time at which the observation with the given time is sent. */
+  void observationSent(scalar_t observationTime);
+
+  /** Gets the latency statistics. */
+  ObservationLatencyStatistics getStatistics() const;
+
+  /**
+   * Reports that the control loop has actuated the system with the active policy. This method should be called on the thread which calls
+   * MRT_BASE::updatePolicy().
+   *
+   * @param [out] latency: The latency of the active policy, if it is actuated for the first time and it is matched to a sent observation.
+   * @return true if the latency is computed.
+   */
+  bool policyActuated(PolicyLatency& latency);
+
+  /** Clears the history and the statistics. */
+  void reset();
+
+  void modifyActiveSolution(const CommandData& command, PrimalSolution& primalSolution) override;
+
+  void modifyBufferedSolution(const CommandData& commandBuffer, PrimalSolution& primalSolutionBuffer) override;
+
+ private:
+  using clock = std::chrono::steady_clock;
+
+  /** The wall times of a policy which is matched to a sent observation. */
+  struct PolicyTimes {
+    scalar_t observationTime = -1.0;
+    clock::time_point sendTime;
+    clock::time_point bufferTime;
+    clock::time_point loadTime;
+    MpcTiming mpcTiming;
+  };
+
+  mutable std::mutex mutex_;
+  std::vector<std::pair<scalar_t, clock::time_point>> sentObservations_;  // ring buffer of (observation time, send time)
+  size_t next_ = 0;
+  ObservationLatencyStatistics statistics_;
+
+  // the MRT holds at most three policies, hence a policy is still in this ring buffer when it is loaded
+  std::array<PolicyTimes, 3> bufferedPolicies_;
+  size_t nextBuffered_ = 0;
+  PolicyTimes activePolicy_;  // only accessed by the thread of updatePolicy()
+  bool activePolicyActuated_ = true;
+};
+
+}  // namespace ocs2
@@ -0,0 +1,150 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_oc/oc_data/PerformanceIndex.h>
+#include <ocs2_oc/oc_data/PrimalSolution.h>
+
+#include "ocs2_mpc/CommandData.h"
+#include "ocs2_mpc/MrtObserver.h"
+
+namespace ocs2 {
+namespace policy_log {
+
+/** A logged policy */
+struct PolicyRecord {
+  /** The index of the policy since the logger was created. */
+  uint64_t policyIndex = 0;
+  /** The wall-clock time at which the policy is logged, in nanoseconds since the epoch. */
+  int64_t wallTime = 0;
+  CommandData command;
+  PrimalSolution primalSolution;
+  PerformanceIndex performanceIndices;
+};
+
+/**
+ * Logs the policies received by the MRT into a ring of fixed-size records in a preallocated memory-mapped file, such that the latest
+ * numRecords policies survive a crash of the process and can be read without ROS by LogReader or the Python reader policy_log.py of
+ * ocs2_python_interface. Add it to the MRT with MRT_BASE::addMrtObserver().
+ *
+ * A policy is serialized in full precision directly into its record by the thread that fills the policy buffer, hence the control loop
+ * is never blocked. The file is allocated and its pages are touched on construction, such that logging does not allocate memory or grow
+ * the file. A policy which does not fit into a record is dropped (see getNumDroppedPolicies()).
+ *
+ * The file starts with a header of 64 bytes: the magic number "OCPL", the format version (uint32), the record capacity, the number of
+ * records and the record stride (uint64). The n-th record (n = 1, 2, ...) is written at offset 64 + (n % numRecords) * recordStride. A
+ * record starts with its sequence number and the size of its payload (uint64), where the sequence is odd while the record is written and
+ * equal to 2 * n once the n-th policy is completely written.
+ */
+class PolicyLogger final : public MrtObserver {
+ public:
+  /**
+   * Constructor. Creates the log file, an existing file is overwritten.
+   *
+   * @param [in] fileName: The file of the log.
+   * @param [in] recordCapacity: The maximum size of a serialized policy in bytes.
+   * @param [in] numRecords: The number of records in the ring.
+   */
+  explicit PolicyLogger(const std::string& fileName, size_t recordCapacity = 1024 * 1024, size_t numRecords = 1000);
+
+  /** Destructor. Unmaps the file. */
+  ~PolicyLogger() override;
+
+  /**
+   * Writes a policy into the next record.
+   *
+   * @param [in] command: The command data of the MPC.
+   * @param [in] primalSolution: The policy data of the MPC.
+   * @param [in] performanceIndices: The performance indices data of the solver.
+   * @return false if the policy does not fit into a record and is dropped.
+   */
+  bool write(const CommandData& command, const PrimalSolution& primalSolution, const PerformanceIndex& performanceIndices);
+
+  /** Gets the number of policies which have been dropped since they do not fit into a record. */
+  size_t getNumDroppedPolicies() const { return numDroppedPolicies_; }
+
+  void bufferedPolicyReceived(const CommandData& commandBuffer, const PrimalSolution& primalSolutionBuffer,
+                              const PerformanceIndex& performanceIndicesBuffer) override;
+
+ private:
+  uint8_t* dataPtr_ = nullptr;
+  size_t dataSize_ = 0;
+  size_t recordCapacity_;
+  size_t numRecords_;
+  size_t recordStride_;
+  uint64_t numPolicies_ = 0;
+  std::atomic<size_t> numDroppedPolicies_{0};
+};
+
+/**
+ * Reads the log written by PolicyLogger. The file is memory-mapped and the complete records are indexed in the order of logging on
+ * construction, a record is only decoded when it is read. The log of a running logger can be read as well, in which case the oldest
+ * records may be overwritten while the reader is open.
+ */
+class LogReader {
+ public:
+  /**
+   * Constructor. Throws if the file is not a policy log.
+   *
+   * @param [in] fileName: The file of the log.
+   */
+  explicit LogReader(const std::string& fileName);
+
+  /** Destructor. Unmaps the file. */
+  ~LogReader();
+
+  LogReader(const LogReader&) = delete;
+  LogReader& operator=(const LogReader&) = delete;
+
+  /** The number of records in the log. */
+  size_t size() const { return recordOffsets_.size(); }
+
+  /**
+   * Decodes a record. Throws if the record is malformed or if it has been overwritten by the logger.
+   *
+   * @param [in] index: The index of the record in the log, where 0 is the oldest record.
+   */
+  PolicyRecord read(size_t index) const;
+
+ private:
+  const uint8_t* dataPtr_ = nullptr;
+  size_t dataSize_ = 0;
+  size_t recordCapacity_ = 0;
+  std::vector<std::pair<uint64_t, size_t>> recordOffsets_;  // the sequence and the offset of each record
+};
+
+}  // namespace policy_log
+}  // namespace ocs2
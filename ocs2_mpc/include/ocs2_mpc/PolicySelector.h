@@ -0,0 +1,87 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <limits>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_oc/oc_data/PerformanceIndex.h>
+
+#include "ocs2_mpc/CommandData.h"
+
+namespace ocs2 {
+
+/**
+ * Selects among the policies of several MPCs which feed the same MRT, e.g. a remote MPC with a long horizon and an onboard MPC with a
+ * short horizon as its fallback. A policy is valid if its merit is finite and its constraint violation does not exceed a threshold. A
+ * valid policy is selected if it is at least as fresh as the previously selected one, where the freshness is the time of the observation
+ * which the policy is computed from plus the time margin of its source. Hence the policies of a source with a larger margin are preferred,
+ * and the other sources only take over once its policies are older than the margin, e.g. on the loss of the link to a remote MPC.
+ */
+class PolicySelector {
+ public:
+  /**
+   * Constructor. The default selector accepts all the policies of the single source 0.
+   *
+   * @param [in] sourceTimeMargins: The time margin of each policy source. The sources are indexed from 0.
+   * @param [in] maxConstraintViolationSSE: The maximum sum of the dynamics and equality constraints violation SSE of a valid policy.
+   */
+  explicit PolicySelector(scalar_array_t sourceTimeMargins = {0.0},
+                          scalar_t maxConstraintViolationSSE = std::numeric_limits<scalar_t>::infinity());
+
+  /** Forgets the previously selected policy. */
+  void reset() { isSelected_ = false; }
+
+  /** Gets the number of the policy sources. */
+  size_t getNumSources() const { return sourceTimeMargins_.size(); }
+
+  /** Whether the performance indices belong to a valid policy. */
+  bool isValid(const PerformanceIndex& performanceIndices) const;
+
+  /**
+   * Decides whether a new policy replaces the previously selected one. If so, it becomes the selected policy.
+   *
+   * @param [in] source: The index of the policy source.
+   * @param [in] command: The command data of the policy.
+   * @param [in] performanceIndices: The performance indices of the policy.
+   * @return true if the policy is selected.
+   */
+  bool select(size_t source, const CommandData& command, const PerformanceIndex& performanceIndices);
+
+ private:
+  scalar_array_t sourceTimeMargins_;
+  scalar_t maxConstraintViolationSSE_;
+
+  bool isSelected_ = false;
+  scalar_t selectedFreshness_ = 0.0;
+  scalar_t selectedMerit_ = 0.0;
+};
+
+}  // namespace ocs2
@@ -0,0 +1,164 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_mpc/ClosedLoopSimulation.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_oc/approximate_model/LinearQuadraticApproximator.h>
+
+namespace ocs2 {
+namespace closed_loop_simulation {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::ostream& operator<<(std::ostream& stream, const Result& result) {
+  stream << "\n### Closed-loop simulation";
+  stream << "\n###   Closed-loop cost        : " << result.cost;
+  stream << "\n###   Number of MPC runs      : " << result.numMpcRuns;
+  stream << "\n###   Average solve time      : " << result.averageSolveTime << "[ms].";
+  stream << "\n###   Maximum solve time      : " << result.maxSolveTime << "[ms].";
+  stream << "\n###   Wall time               : " << result.wallTime << "[s].";
+  stream << "\n###   Real-time factor        : " << result.realTimeFactor << "\n";
+  return stream;
+}
+
+}  // namespace closed_loop_simulation
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ClosedLoopSimulation::ClosedLoopSimulation(MPC_BASE& mpc, closed_loop_simulation::Settings settings, const RolloutBase* rolloutPtr)
+    : settings_(std::move(settings)), mrt_(mpc), problemPtr_(new OptimalControlProblem(mpc.getSolverPtr()->getOptimalControlProblem())) {
+  if (settings_.mrtDesiredFrequency <= 0.0 || settings_.mpcDesiredFrequency <= 0.0) {
+    throw std::runtime_error("[ClosedLoopSimulation] The MRT and MPC frequencies should be positive numbers!");
+  }
+  if (settings_.mpcDesiredFrequency > settings_.mrtDesiredFrequency) {
+    throw std::runtime_error("[ClosedLoopSimulation] The MPC frequency should not be larger than the MRT frequency!");
+  }
+  if (rolloutPtr != nullptr) {
+    mrt_.initRollout(rolloutPtr);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+closed_loop_simulation::Result ClosedLoopSimulation::run(const SystemObservation& initObservation,
+                                                         const TargetTrajectories& initTargetTrajectories) {
+  const scalar_t dt = 1.0 / settings_.mrtDesiredFrequency;
+  const auto numSteps = static_cast<size_t>(std::round(settings_.duration * settings_.mrtDesiredFrequency));
+  const auto mpcUpdateRatio = std::max(static_cast<size_t>(std::round(settings_.mrtDesiredFrequency / settings_.mpcDesiredFrequency)),
+                                       size_t(1));
+
+  closed_loop_simulation::Result result;
+  if (settings_.storeTrajectories) {
+    result.timeTrajectory.reserve(numSteps + 1);
+    result.stateTrajectory.reserve(numSteps + 1);
+    result.inputTrajectory.reserve(numSteps + 1);
+  }
+
+  // the policy of a previous run is discarded
+  mrt_.reset();
+  mrt_.resetMpcNode(initTargetTrajectories);
+  benchmark::RepeatedTimer solveTimer;
+  const auto wallStartTime = std::chrono::steady_clock::now();
+
+  SystemObservation currentObservation = initObservation;
+  SystemObservation nextObservation;
+  vector_t plannedState;
+  for (size_t k = 0; k < numSteps; k++) {
+    // MPC runs on the current observation and its policy is applied right away
+    if (k % mpcUpdateRatio == 0) {
+      mrt_.setCurrentObservation(currentObservation);
+      solveTimer.startTimer();
+      mrt_.advanceMpc();
+      solveTimer.endTimer();
+      if (!mrt_.updatePolicy()) {
+        throw std::runtime_error("[ClosedLoopSimulation::run] MPC has not provided a policy at time " +
+                                 std::to_string(currentObservation.time) + "!");
+      }
+    }
+
+    // the input of the policy at the current observation
+    mrt_.evaluatePolicy(currentObservation.time, currentObservation.state, plannedState, currentObservation.input,
+                        currentObservation.mode);
+
+    // closed-loop cost of the step
+    problemPtr_->targetTrajectoriesPtr = &mrt_.getReferenceManager().getTargetTrajectories();
+    problemPtr_->preComputationPtr->request(Request::Cost + Request::SoftConstraint, currentObservation.time, currentObservation.state,
+                                            currentObservation.input);
+    result.cost += dt * computeCost(*problemPtr_, currentObservation.time, currentObservation.state, currentObservation.input);
+
+    if (settings_.storeTrajectories) {
+      result.timeTrajectory.push_back(currentObservation.time);
+      result.stateTrajectory.push_back(currentObservation.state);
+      result.inputTrajectory.push_back(currentObservation.input);
+    }
+
+    // forward simulation
+    nextObservation.time = currentObservation.time + dt;
+    if (mrt_.isRolloutSet()) {
+      mrt_.rolloutPolicy(currentObservation.time, currentObservation.state, dt, nextObservation.state, nextObservation.input,
+                         nextObservation.mode);
+    } else {
+      mrt_.evaluatePolicy(nextObservation.time, currentObservation.state, nextObservation.state, nextObservation.input,
+                          nextObservation.mode);
+    }
+
+    if (observationModifier_) {
+      observationModifier_(nextObservation);
+    }
+    std::swap(currentObservation, nextObservation);
+  }
+
+  if (settings_.storeTrajectories) {
+    result.timeTrajectory.push_back(currentObservation.time);
+    result.stateTrajectory.push_back(currentObservation.state);
+    result.inputTrajectory.push_back(currentObservation.input);
+  }
+
+  result.wallTime = std::chrono::duration<scalar_t>(std::chrono::steady_clock::now() - wallStartTime).count();
+  result.realTimeFactor = (result.wallTime > 0.0) ? numSteps * dt / result.wallTime : 0.0;
+  result.numMpcRuns = solveTimer.getNumTimedIntervals();
+  if (result.numMpcRuns > 0) {
+    result.averageSolveTime = solveTimer.getAverageInMilliseconds();
+    result.maxSolveTime = solveTimer.getMaxIntervalInMilliseconds();
+    result.totalSolveTime = solveTimer.getTotalInMilliseconds();
+  }
+
+  return result;
+}
+
+}  // namespace ocs2
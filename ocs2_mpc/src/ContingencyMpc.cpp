@@ -0,0 +1,169 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_mpc/ContingencyMpc.h"
+
+#include <exception>
+#include <future>
+
+namespace ocs2 {
+
+namespace {
+
+const mpc::Settings& getNominalSettings(const std::unique_ptr<MPC_BASE>& nominalMpcPtr) {
+  if (nominalMpcPtr == nullptr) {
+    throw std::runtime_error("[ContingencyMpc] nominalMpcPtr cannot be a null pointer!");
+  }
+  return nominalMpcPtr->settings();
+}
+
+/** Solves the problem of the given MPC, the solver is run directly as in the calculateController() of the MPC implementations. */
+void solveMpc(MPC_BASE& mpc, scalar_t initTime, const vector_t& initState, scalar_t finalTime) {
+  if (mpc.settings().coldStart_) {
+    mpc.getSolverPtr()->reset();
+  }
+  mpc.getSolverPtr()->run(initTime, initState, finalTime);
+}
+
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ContingencyMpc::ContingencyMpc(std::unique_ptr<MPC_BASE> nominalMpcPtr, std::vector<std::unique_ptr<MPC_BASE>> contingencyMpcPtrs,
+                               std::vector<mode_schedule_modifier_t> modeScheduleModifiers)
+    : MPC_BASE(getNominalSettings(nominalMpcPtr)),
+      nominalMpcPtr_(std::move(nominalMpcPtr)),
+      contingencyMpcPtrs_(std::move(contingencyMpcPtrs)),
+      modeScheduleModifiers_(std::move(modeScheduleModifiers)),
+      hypothesisThreadPool_(contingencyMpcPtrs_.size()) {
+  if (contingencyMpcPtrs_.empty()) {
+    throw std::runtime_error("[ContingencyMpc] At least one contingency hypothesis is required!");
+  }
+  if (modeScheduleModifiers_.size() != contingencyMpcPtrs_.size()) {
+    throw std::runtime_error("[ContingencyMpc] Each contingency hypothesis requires a mode schedule modifier!");
+  }
+  for (size_t i = 0; i < contingencyMpcPtrs_.size(); i++) {
+    if (contingencyMpcPtrs_[i] == nullptr || !modeScheduleModifiers_[i]) {
+      throw std::runtime_error("[ContingencyMpc] The MPC and the mode schedule modifier of hypothesis " + std::to_string(i) +
+                               " cannot be empty!");
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ContingencyMpc::reset() {
+  MPC_BASE::reset();
+  nominalMpcPtr_->reset();
+  for (auto& mpcPtr : contingencyMpcPtrs_) {
+    mpcPtr->reset();
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ContingencyMpc::prepare(scalar_t nextTime) {
+  nominalMpcPtr_->prepare(nextTime);
+  for (auto& mpcPtr : contingencyMpcPtrs_) {
+    mpcPtr->prepare(nextTime);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ContingencyMpc::calculateController(scalar_t initTime, const vector_t& initState, scalar_t finalTime) {
+  // the deadline of the nominal solver is set by MPC_BASE::run()
+  const auto deadline = getSolverPtr()->getDeadline();
+  for (auto& mpcPtr : contingencyMpcPtrs_) {
+    mpcPtr->getSolverPtr()->setDeadline(deadline);
+  }
+
+  if (isFirstMpcRun()) {
+    // the references are only set in the nominal reference manager once it has been run
+    solveMpc(*nominalMpcPtr_, initTime, initState, finalTime);
+    updateContingencyReferences(initTime);
+    solveConcurrently(false, initTime, initState, finalTime);
+  } else {
+    updateContingencyReferences(initTime);
+    solveConcurrently(true, initTime, initState, finalTime);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ContingencyMpc::updateContingencyReferences(scalar_t initTime) {
+  const auto& nominalReferenceManager = getSolverPtr()->getReferenceManager();
+  for (size_t i = 0; i < contingencyMpcPtrs_.size(); i++) {
+    auto& referenceManager = contingencyMpcPtrs_[i]->getSolverPtr()->getReferenceManager();
+    referenceManager.setTargetTrajectories(nominalReferenceManager.getTargetTrajectories());
+    referenceManager.setModeSchedule(modeScheduleModifiers_[i](initTime, nominalReferenceManager.getModeSchedule()));
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ContingencyMpc::solveConcurrently(bool solveNominal, scalar_t initTime, const vector_t& initState, scalar_t finalTime) {
+  std::vector<std::future<void>> futures;
+  futures.reserve(contingencyMpcPtrs_.size());
+  for (auto& mpcPtr : contingencyMpcPtrs_) {
+    MPC_BASE* contingencyMpcPtr = mpcPtr.get();
+    futures.push_back(hypothesisThreadPool_.run([=, &initState](int) { solveMpc(*contingencyMpcPtr, initTime, initState, finalTime); }));
+  }
+
+  std::exception_ptr exceptionPtr;
+  if (solveNominal) {
+    try {
+      solveMpc(*nominalMpcPtr_, initTime, initState, finalTime);
+    } catch (...) {
+      exceptionPtr = std::current_exception();
+    }
+  }
+
+  // the tasks reference the initial state, hence all of them are awaited before an exception is rethrown
+  for (auto& future : futures) {
+    try {
+      future.get();
+    } catch (...) {
+      if (!exceptionPtr) {
+        exceptionPtr = std::current_exception();
+      }
+    }
+  }
+  if (exceptionPtr) {
+    std::rethrow_exception(exceptionPtr);
+  }
+}
+
+}  // namespace ocs2
@@ -0,0 +1,130 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+
+#include "ocs2_mpc/FeedbackPolicyGrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <ocs2_core/NumericTraits.h>
+#include <ocs2_core/control/LinearController.h>
+#include <ocs2_core/misc/LinearInterpolation.h>
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void FeedbackPolicyGrid::update(const PrimalSolution& primalSolution, scalar_t timeStep) {
+  const auto& timeTrajectory = primalSolution.timeTrajectory_;
+  const auto& stateTrajectory = primalSolution.stateTrajectory_;
+  if (timeStep <= 0.0) {
+    throw std::runtime_error("[FeedbackPolicyGrid::update] timeStep should be positive!");
+  }
+  if (timeTrajectory.empty() || primalSolution.controllerPtr_ == nullptr || primalSolution.controllerPtr_->empty()) {
+    throw std::runtime_error("[FeedbackPolicyGrid::update] The primal solution is empty!");
+  }
+
+  startTime_ = timeTrajectory.front();
+  timeStep_ = timeStep;
+  const scalar_t numSteps = (timeTrajectory.back() - startTime_) / timeStep_ - numeric_traits::weakEpsilon<scalar_t>();
+  numPoints_ = static_cast<size_t>(std::ceil(std::max(numSteps, scalar_t(0.0)))) + 1;
+  modeSchedule_ = primalSolution.modeSchedule_;
+
+  auto& controller = *primalSolution.controllerPtr_;
+  const auto* linearControllerPtr = dynamic_cast<const LinearController*>(&controller);
+  hasFeedback_ = linearControllerPtr != nullptr;
+
+  const auto stateDim = stateTrajectory.front().size();
+  const auto inputDim = controller.computeInput(startTime_, stateTrajectory.front()).size();
+  nominalStates_.resize(stateDim, numPoints_);
+  feedforwardInputs_.resize(inputDim, numPoints_);
+  gains_.resize(inputDim, hasFeedback_ ? stateDim * numPoints_ : 0);
+
+  int stateCursor = 0;
+  int gainCursor = 0;
+  for (size_t k = 0; k < numPoints_; k++) {
+    const scalar_t time = startTime_ + k * timeStep_;
+    const auto stateIndexAlpha = LinearInterpolation::timeSegment(time, timeTrajectory, stateCursor);
+    const vector_t nominalState = LinearInterpolation::interpolate(stateIndexAlpha, stateTrajectory);
+    const vector_t feedforwardInput = controller.computeInput(time, nominalState);
+    if (nominalState.size() != stateDim || feedforwardInput.size() != inputDim) {
+      throw std::runtime_error("[FeedbackPolicyGrid::update] The state and input dimensions should be constant over the horizon!");
+    }
+    nominalStates_.col(k) = nominalState;
+    feedforwardInputs_.col(k) = feedforwardInput;
+
+    if (hasFeedback_) {
+      const auto gainIndexAlpha = LinearInterpolation::timeSegment(time, linearControllerPtr->timeStamp_, gainCursor);
+      gains_.middleCols(k * stateDim, stateDim) = LinearInterpolation::interpolate(gainIndexAlpha, linearControllerPtr->gainArray_);
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void FeedbackPolicyGrid::clear() {
+  numPoints_ = 0;
+  hasFeedback_ = false;
+  nominalStates_.resize(0, 0);
+  feedforwardInputs_.resize(0, 0);
+  gains_.resize(0, 0);
+  modeSchedule_ = ModeSchedule();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void FeedbackPolicyGrid::evaluate(scalar_t time, const vector_t& state, vector_t& nominalState, vector_t& input, size_t& mode) const {
+  if (empty()) {
+    throw std::runtime_error("[FeedbackPolicyGrid::evaluate] The grid is empty!");
+  }
+
+  // grid point before the query time and the interpolation coefficient towards the next one
+  const scalar_t gridTime = std::min(std::max((time - startTime_) / timeStep_, scalar_t(0.0)), static_cast<scalar_t>(numPoints_ - 1));
+  const auto index = std::min(static_cast<size_t>(gridTime), numPoints_ - 1);
+  const auto nextIndex = std::min(index + 1, numPoints_ - 1);
+  const scalar_t alpha = gridTime - index;
+
+  nominalState = (scalar_t(1.0) - alpha) * nominalStates_.col(index) + alpha * nominalStates_.col(nextIndex);
+  input = (scalar_t(1.0) - alpha) * feedforwardInputs_.col(index) + alpha * feedforwardInputs_.col(nextIndex);
+  if (hasFeedback_) {
+    const auto stateDim = nominalStates_.rows();
+    const auto gainIndex = (alpha < 0.5) ? index : nextIndex;
+    const auto gain = gains_.middleCols(gainIndex * stateDim, stateDim);
+    input.noalias() += gain * state;
+    input.noalias() -= gain * nominalState;
+  }
+
+  mode = modeSchedule_.modeAtTime(time);
+}
+
+}  // namespace ocs2
@@ -28,15 +28,18 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
 #include <algorithm>
+#include <chrono>
 
 #include <ocs2_mpc/MPC_BASE.h>
 
+#include <ocs2_oc/rollout/TimeTriggeredRollout.h>
+
 namespace ocs2 {
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-MPC_BASE::MPC_BASE(mpc::Settings mpcSettings) : mpcSettings_(std::move(mpcSettings)) {}
+MPC_BASE::MPC_BASE(mpc::Settings mpcSettings) : mpcSettings_(std::move(mpcSettings)), scheduler_(mpcSettings_) {}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -44,6 +47,8 @@ MPC_BASE::MPC_BASE(mpc::Settings mpcSettings) : mpcSettings_(std::move(mpcSettin
 void MPC_BASE::reset() {
   initRun_ = true;
   mpcTimer_.reset();
+  delayEstimate_ = 0.0;
+  scheduler_.reset();
   getSolverPtr()->reset();
 }
 
@@ -58,7 +63,24 @@ bool MPC_BASE::run(scalar_t currentTime, const vector_t& currentState) {
     return false;
   }
 
-  const scalar_t finalTime = currentTime + mpcSettings_.timeHorizon_;
+  // the delay of MPC includes the prediction
+  mpcTimer_.startTimer();
+  if (mpcSettings_.adaptiveScheduling_) {
+    // the first run is a cold start, which should not be cut short
+    if (initRun_) {
+      getSolverPtr()->clearDeadline();
+    } else {
+      getSolverPtr()->setDeadline(scheduler_.getDeadline(std::chrono::steady_clock::now()));
+    }
+  }
+  scalar_t initTime = currentTime;
+  vector_t initState = currentState;
+  if (mpcSettings_.delayCompensation_ && !initRun_) {
+    predictInitialCondition(initTime, initState);
+  }
+
+  const scalar_t timeHorizon = getTimeHorizon();
+  const scalar_t finalTime = initTime + timeHorizon;
 
   // display
   if (mpcSettings_.debugPrint_) {
@@ -66,20 +88,51 @@ bool MPC_BASE::run(scalar_t currentTime, const vector_t& currentState) {
     std::cerr << "\n#####################################################";
     std::cerr << "\n#####################################################";
     std::cerr << "\n### MPC is called at time:  " << currentTime << " [s].";
+    std::cerr << "\n### MPC initial time:       " << initTime << " [s].";
     std::cerr << "\n### MPC final Time:         " << finalTime << " [s].";
-    std::cerr << "\n### MPC time horizon:       " << mpcSettings_.timeHorizon_ << " [s].\n";
-    mpcTimer_.startTimer();
+    std::cerr << "\n### MPC time horizon:       " << timeHorizon << " [s].\n";
+  }
+
+  // the warm start is the solution of the previous cycle
+  mpc_recording::CycleRecord cycleRecord;
+  if (recorderPtr_ != nullptr && !initRun_ && !mpcSettings_.coldStart_) {
+    getSolverPtr()->getPrimalSolution(getSolverPtr()->getFinalTime(), &cycleRecord.warmStart);
   }
 
   // calculate the MPC policy
-  calculateController(currentTime, currentState, finalTime);
+  const auto solverStartTime = std::chrono::steady_clock::now();
+  calculateController(initTime, initState, finalTime);
+  mpcTimer_.endTimer();
+
+  if (recorderPtr_ != nullptr) {
+    cycleRecord.initTime = initTime;
+    cycleRecord.initState = initState;
+    cycleRecord.finalTime = finalTime;
+    cycleRecord.solveTime = std::chrono::duration<scalar_t, std::milli>(std::chrono::steady_clock::now() - solverStartTime).count();
+    cycleRecord.targetTrajectories = getSolverPtr()->getReferenceManager().getTargetTrajectories();
+    cycleRecord.modeSchedule = getSolverPtr()->getReferenceManager().getModeSchedule();
+    recorderPtr_->record(cycleRecord);
+  }
+
+  if (checkpointWriterPtr_ != nullptr) {
+    checkpointWriterPtr_->capture(*this, initTime, finalTime);
+  }
+
+  // the first run is a cold start, therefore it is excluded from the delay estimate and the scheduling
+  if (!initRun_) {
+    const scalar_t delay = 1e-3 * mpcTimer_.getLastIntervalInMilliseconds();
+    const scalar_t smoothing = (delayEstimate_ > 0.0) ? mpcSettings_.delayCompensationSmoothing_ : 1.0;
+    delayEstimate_ = smoothing * delay + (1.0 - smoothing) * delayEstimate_;
+    if (mpcSettings_.adaptiveScheduling_) {
+      scheduler_.update(delay);
+    }
+  }
 
   // set initRun flag to false
   initRun_ = false;
 
   // display
   if (mpcSettings_.debugPrint_) {
-    mpcTimer_.endTimer();
     std::cerr << "\n### MPC Benchmarking";
     std::cerr << "\n###   Maximum : " << mpcTimer_.getMaxIntervalInMilliseconds() << "[ms].";
     std::cerr << "\n###   Average : " << mpcTimer_.getAverageInMilliseconds() << "[ms].";
@@ -89,4 +142,45 @@ bool MPC_BASE::run(scalar_t currentTime, const vector_t& currentState) {
   return true;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_BASE::predictInitialCondition(scalar_t& time, vector_t& state) {
+  const scalar_t predictedTime = time + delayEstimate_;
+  if (delayEstimate_ <= 0.0 || predictedTime >= getSolverPtr()->getFinalTime()) {
+    return;
+  }
+
+  auto primalSolution = getSolverPtr()->primalSolution(predictedTime);
+  if (primalSolution.controllerPtr_ == nullptr || primalSolution.controllerPtr_->empty()) {
+    return;
+  }
+
+  // the rollout keeps its own copy of the dynamics, the solver might use them concurrently in the preparation phase
+  if (delayRolloutPtr_ == nullptr) {
+    delayRolloutPtr_.reset(new TimeTriggeredRollout(*getSolverPtr()->getOptimalControlProblem().dynamicsPtr));
+  }
+
+  scalar_array_t timeTrajectory;
+  size_array_t postEventIndices;
+  vector_array_t stateTrajectory;
+  vector_array_t inputTrajectory;
+  state = delayRolloutPtr_->run(time, state, predictedTime, primalSolution.controllerPtr_.get(), primalSolution.modeSchedule_,
+                                timeTrajectory, postEventIndices, stateTrajectory, inputTrajectory);
+  time = predictedTime;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_BASE::prepareNextRun(scalar_t currentTime) {
+  if (!mpcSettings_.pipelinedPreparation_) {
+    return;
+  }
+
+  const scalar_t period =
+      (mpcSettings_.mpcDesiredFrequency_ > 0.0) ? 1.0 / mpcSettings_.mpcDesiredFrequency_ : 1e-3 * mpcTimer_.getAverageInMilliseconds();
+  prepare(currentTime + period);
+}
+
 }  // namespace ocs2
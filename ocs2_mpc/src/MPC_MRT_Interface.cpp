@@ -54,8 +54,9 @@ void MPC_MRT_Interface::resetMpcNode(const TargetTrajectories& initTargetTraject
 /******************************************************************************************************/
 /******************************************************************************************************/
 void MPC_MRT_Interface::setCurrentObservation(const SystemObservation& currentObservation) {
-  std::lock_guard<std::mutex> lock(observationMutex_);
-  currentObservation_ = currentObservation;
+  // copy assignment reuses the memory of the stale observation in the back slot
+  observationBuffer_.back() = currentObservation;
+  observationBuffer_.publish();
 }
 
 /******************************************************************************************************/
@@ -79,17 +80,15 @@ void MPC_MRT_Interface::advanceMpc() {
   // measure the delay in running MPC
   mpcTimer_.startTimer();
 
-  SystemObservation currentObservation;
-  {
-    std::lock_guard<std::mutex> lock(observationMutex_);
-    currentObservation = currentObservation_;
-  }
+  // the front slot keeps the latest observation, even if nothing new was set since the last iteration
+  observationBuffer_.updateFromBuffer();
+  mpcObservation_ = observationBuffer_.front();
 
-  bool controllerIsUpdated = mpc_.run(currentObservation.time, currentObservation.state);
+  bool controllerIsUpdated = mpc_.run(mpcObservation_.time, mpcObservation_.state);
   if (!controllerIsUpdated) {
     return;
   }
-  copyToBuffer(currentObservation);
+  this->copySolutionToBuffer(mpc_, mpcObservation_);
 
   // measure the delay for sending ROS messages
   mpcTimer_.endTimer();
@@ -97,7 +96,7 @@ void MPC_MRT_Interface::advanceMpc() {
   // check MPC delay and solution window compatibility
   scalar_t timeWindow = mpc_.settings().solutionTimeWindow_;
   if (mpc_.settings().solutionTimeWindow_ < 0) {
-    timeWindow = mpc_.getSolverPtr()->getFinalTime() - currentObservation.time;
+    timeWindow = mpc_.getSolverPtr()->getFinalTime() - mpcObservation_.time;
   }
   if (timeWindow < 2.0 * mpcTimer_.getAverageInMilliseconds() * 1e-3) {
     std::cerr << "[MPC_MRT_Interface::advanceMpc] WARNING: The solution time window might be shorter than the MPC delay!\n";
@@ -110,29 +109,9 @@ void MPC_MRT_Interface::advanceMpc() {
     std::cerr << "\n###   Average : " << mpcTimer_.getAverageInMilliseconds() << "[ms].";
     std::cerr << "\n###   Latest  : " << mpcTimer_.getLastIntervalInMilliseconds() << "[ms]." << std::endl;
   }
-}
-
-/******************************************************************************************************/
-/******************************************************************************************************/
-/******************************************************************************************************/
-void MPC_MRT_Interface::copyToBuffer(const SystemObservation& mpcInitObservation) {
-  // policy
-  std::unique_ptr<PrimalSolution> primalSolutionPtr(new PrimalSolution);
-  const scalar_t startTime = mpcInitObservation.time;
-  const scalar_t finalTime =
-      (mpc_.settings().solutionTimeWindow_ < 0) ? mpc_.getSolverPtr()->getFinalTime() : startTime + mpc_.settings().solutionTimeWindow_;
-  mpc_.getSolverPtr()->getPrimalSolution(finalTime, primalSolutionPtr.get());
-
-  // command
-  std::unique_ptr<CommandData> commandPtr(new CommandData);
-  commandPtr->mpcInitObservation_ = mpcInitObservation;
-  commandPtr->mpcTargetTrajectories_ = mpc_.getSolverPtr()->getReferenceManager().getTargetTrajectories();
-
-  // performance indices
-  std::unique_ptr<PerformanceIndex> performanceIndicesPtr(new PerformanceIndex);
-  *performanceIndicesPtr = mpc_.getSolverPtr()->getPerformanceIndeces();
 
-  this->moveToBuffer(std::move(commandPtr), std::move(primalSolutionPtr), std::move(performanceIndicesPtr));
+  // the policy is already in the buffer of the MRT
+  mpc_.prepareNextRun(mpcObservation_.time);
 }
 
 /******************************************************************************************************/
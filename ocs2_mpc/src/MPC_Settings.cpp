@@ -38,8 +38,8 @@ namespace ocs2 {
 namespace mpc {
 
 Settings loadSettings(const std::string& filename, const std::string& fieldName, bool verbose) {
-  boost::property_tree::ptree pt;
-  boost::property_tree::read_info(filename, pt);
+  const auto ptPtr = loadData::readInfoFile(filename);
+  const boost::property_tree::ptree& pt = *ptPtr;
 
   Settings settings;
 
@@ -57,6 +57,17 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
   loadData::loadPtreeValue(pt, settings.mpcDesiredFrequency_, fieldName + ".mpcDesiredFrequency", verbose);
   loadData::loadPtreeValue(pt, settings.mrtDesiredFrequency_, fieldName + ".mrtDesiredFrequency", verbose);
 
+  loadData::loadPtreeValue(pt, settings.pipelinedPreparation_, fieldName + ".pipelinedPreparation", verbose);
+
+  loadData::loadPtreeValue(pt, settings.delayCompensation_, fieldName + ".delayCompensation", verbose);
+  loadData::loadPtreeValue(pt, settings.delayCompensationSmoothing_, fieldName + ".delayCompensationSmoothing", verbose);
+
+  loadData::loadPtreeValue(pt, settings.adaptiveScheduling_, fieldName + ".adaptiveScheduling", verbose);
+  loadData::loadPtreeValue(pt, settings.targetLatency_, fieldName + ".targetLatency", verbose);
+  loadData::loadPtreeValue(pt, settings.minTimeHorizon_, fieldName + ".minTimeHorizon", verbose);
+  loadData::loadPtreeValue(pt, settings.maxTimeHorizon_, fieldName + ".maxTimeHorizon", verbose);
+  loadData::loadPtreeValue(pt, settings.schedulingAdaptationRate_, fieldName + ".schedulingAdaptationRate", verbose);
+
   if (verbose) {
     std::cerr << " #### =============================================================================" << std::endl;
   }
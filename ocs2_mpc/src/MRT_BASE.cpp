@@ -29,10 +29,43 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_mpc/MRT_BASE.h"
 
+#include <ocs2_core/control/FeedforwardController.h>
+#include <ocs2_core/control/LinearController.h>
 #include <ocs2_oc/rollout/TimeTriggeredRollout.h>
 
 namespace ocs2 {
 
+namespace {
+
+/** Linear interpolation into the given vector, which does not allocate memory if the vector already has the size of the result. */
+void interpolateInto(LinearInterpolation::index_alpha_t indexAlpha, const vector_array_t& dataArray, vector_t& result) {
+  const auto index = indexAlpha.first;
+  if (dataArray.size() > 1 && dataArray[index].size() == dataArray[index + 1].size()) {
+    const scalar_t alpha = indexAlpha.second;
+    result = alpha * dataArray[index] + (scalar_t(1.0) - alpha) * dataArray[index + 1];
+  } else {
+    result = LinearInterpolation::interpolate(indexAlpha, dataArray);
+  }
+}
+
+/** Same as LinearController::computeInput, but it evaluates the gains without temporaries and into the given input vector. */
+void computeInputInto(const LinearController& controller, LinearInterpolation::index_alpha_t indexAlpha, const vector_t& state,
+                      vector_t& input) {
+  interpolateInto(indexAlpha, controller.biasArray_, input);
+
+  const auto index = indexAlpha.first;
+  const auto& gainArray = controller.gainArray_;
+  if (gainArray.size() > 1 && gainArray[index].rows() == gainArray[index + 1].rows()) {
+    const scalar_t alpha = indexAlpha.second;
+    input.noalias() += alpha * gainArray[index] * state;
+    input.noalias() += (scalar_t(1.0) - alpha) * gainArray[index + 1] * state;
+  } else {
+    input.noalias() += LinearInterpolation::interpolate(indexAlpha, gainArray) * state;
+  }
+}
+
+}  // unnamed namespace
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -44,26 +77,21 @@ MRT_BASE::MRT_BASE() {
 /******************************************************************************************************/
 /******************************************************************************************************/
 void MRT_BASE::reset() {
-  std::lock_guard<std::mutex> lock(bufferMutex_);
+  std::lock_guard<std::mutex> lock(producerMutex_);
 
   policyReceivedEver_ = false;
-  newPolicyInBuffer_ = false;
-  mrtTrylockWarningCount_ = 0;
-
-  activeCommandPtr_.reset();
-  bufferCommandPtr_.reset();
-  activePrimalSolutionPtr_.reset();
-  bufferPrimalSolutionPtr_.reset();
-  activePerformanceIndicesPtr_.reset();
-  bufferPerformanceIndicesPtr_.reset();
+  policyBuffer_.reset();
+  policySelector_.reset();
+  stateCursor_ = 0;
+  inputCursor_ = 0;
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 const CommandData& MRT_BASE::getCommand() const {
-  if (activeCommandPtr_ != nullptr) {
-    return *activeCommandPtr_;
+  if (policyBuffer_.front().commandPtr != nullptr) {
+    return *policyBuffer_.front().commandPtr;
   } else {
     throw std::runtime_error("[MRT_BASE::getCommand] updatePolicy() should be called first!");
   }
@@ -73,8 +101,9 @@ const CommandData& MRT_BASE::getCommand() const {
 /******************************************************************************************************/
 /******************************************************************************************************/
 const PrimalSolution& MRT_BASE::getPolicy() const {
-  if (activePrimalSolutionPtr_ != nullptr) {
-    return *activePrimalSolutionPtr_;
+  const auto& activePrimalSolutionPtr = policyBuffer_.front().primalSolutionPtr;
+  if (activePrimalSolutionPtr != nullptr) {
+    return *activePrimalSolutionPtr;
   } else {
     throw std::runtime_error("[MRT_BASE::getPolicy] updatePolicy() should be called first!");
   }
@@ -84,8 +113,8 @@ const PrimalSolution& MRT_BASE::getPolicy() const {
 /******************************************************************************************************/
 /******************************************************************************************************/
 const PerformanceIndex& MRT_BASE::getPerformanceIndices() const {
-  if (activePerformanceIndicesPtr_ != nullptr) {
-    return *activePerformanceIndicesPtr_;
+  if (policyBuffer_.front().performanceIndicesPtr != nullptr) {
+    return *policyBuffer_.front().performanceIndicesPtr;
   } else {
     throw std::runtime_error("[MRT_BASE::getPerformanceIndices] updatePolicy() should be called first!");
   }
@@ -102,20 +131,34 @@ void MRT_BASE::initRollout(const RolloutBase* rolloutPtr) {
 /******************************************************************************************************/
 /******************************************************************************************************/
 void MRT_BASE::evaluatePolicy(scalar_t currentTime, const vector_t& currentState, vector_t& mpcState, vector_t& mpcInput, size_t& mode) {
-  if (activePrimalSolutionPtr_ == nullptr) {
+  const auto& activePrimalSolutionPtr = policyBuffer_.front().primalSolutionPtr;
+  if (activePrimalSolutionPtr == nullptr) {
     throw std::runtime_error("[MRT_BASE::evaluatePolicy] updatePolicy() should be called first!");
   }
 
-  if (currentTime > activePrimalSolutionPtr_->timeTrajectory_.back()) {
+  if (currentTime > activePrimalSolutionPtr->timeTrajectory_.back()) {
     std::cerr << "The requested currentTime is greater than the received plan: " << std::to_string(currentTime) << ">"
-              << std::to_string(activePrimalSolutionPtr_->timeTrajectory_.back()) << "\n";
+              << std::to_string(activePrimalSolutionPtr->timeTrajectory_.back()) << "\n";
   }
 
-  mpcInput = activePrimalSolutionPtr_->controllerPtr_->computeInput(currentTime, currentState);
-  mpcState =
-      LinearInterpolation::interpolate(currentTime, activePrimalSolutionPtr_->timeTrajectory_, activePrimalSolutionPtr_->stateTrajectory_);
+  // the query times increase between the policy updates, therefore the cursors make the lookups O(1)
+  const auto& primalSolution = *activePrimalSolutionPtr;
+  const auto stateIndexAlpha = LinearInterpolation::timeSegment(currentTime, primalSolution.timeTrajectory_, stateCursor_);
+  interpolateInto(stateIndexAlpha, primalSolution.stateTrajectory_, mpcState);
+
+  // the common controllers are evaluated without memory allocation
+  ControllerBase* controllerPtr = primalSolution.controllerPtr_.get();
+  if (const auto* linearControllerPtr = dynamic_cast<const LinearController*>(controllerPtr)) {
+    const auto inputIndexAlpha = LinearInterpolation::timeSegment(currentTime, linearControllerPtr->timeStamp_, inputCursor_);
+    computeInputInto(*linearControllerPtr, inputIndexAlpha, currentState, mpcInput);
+  } else if (const auto* feedforwardControllerPtr = dynamic_cast<const FeedforwardController*>(controllerPtr)) {
+    const auto inputIndexAlpha = LinearInterpolation::timeSegment(currentTime, feedforwardControllerPtr->timeStamp_, inputCursor_);
+    interpolateInto(inputIndexAlpha, feedforwardControllerPtr->uffArray_, mpcInput);
+  } else {
+    mpcInput = controllerPtr->computeInput(currentTime, currentState);
+  }
 
-  mode = activePrimalSolutionPtr_->modeSchedule_.modeAtTime(currentTime);
+  mode = primalSolution.modeSchedule_.modeAtTime(currentTime);
 }
 
 /******************************************************************************************************/
@@ -123,59 +166,77 @@ void MRT_BASE::evaluatePolicy(scalar_t currentTime, const vector_t& currentState
 /******************************************************************************************************/
 void MRT_BASE::rolloutPolicy(scalar_t currentTime, const vector_t& currentState, const scalar_t& timeStep, vector_t& mpcState,
                              vector_t& mpcInput, size_t& mode) {
+  const auto& activePrimalSolutionPtr = policyBuffer_.front().primalSolutionPtr;
   if (rolloutPtr_ == nullptr) {
     throw std::runtime_error("[MRT_BASE::rolloutPolicy] rollout class is not set! Use initRollout() to initialize it!");
   }
 
-  if (activePrimalSolutionPtr_ == nullptr) {
+  if (activePrimalSolutionPtr == nullptr) {
     throw std::runtime_error("[MRT_BASE::rolloutPolicy] updatePolicy() should be called first!");
   }
 
-  if (currentTime > activePrimalSolutionPtr_->timeTrajectory_.back()) {
+  if (currentTime > activePrimalSolutionPtr->timeTrajectory_.back()) {
     std::cerr << "The requested currentTime is greater than the received plan: " << std::to_string(currentTime) << ">"
-              << std::to_string(activePrimalSolutionPtr_->timeTrajectory_.back()) << "\n";
+              << std::to_string(activePrimalSolutionPtr->timeTrajectory_.back()) << "\n";
   }
 
-  // perform a rollout
-  scalar_array_t timeTrajectory;
-  size_array_t postEventIndicesStock;
-  vector_array_t stateTrajectory, inputTrajectory;
+  // perform a rollout which only integrates to the final time
   const scalar_t finalTime = currentTime + timeStep;
-  rolloutPtr_->run(currentTime, currentState, finalTime, activePrimalSolutionPtr_->controllerPtr_.get(),
-                   activePrimalSolutionPtr_->modeSchedule_, timeTrajectory, postEventIndicesStock, stateTrajectory, inputTrajectory);
+  rolloutQueryTimes_.assign(1, finalTime);
+  rolloutPtr_->runAtQueryTimes(currentTime, currentState, activePrimalSolutionPtr->controllerPtr_.get(),
+                               activePrimalSolutionPtr->modeSchedule_, rolloutQueryTimes_, rolloutQueryStates_);
+
+  mpcState = rolloutQueryStates_.back();
+  mpcInput = activePrimalSolutionPtr->controllerPtr_->computeInput(finalTime, mpcState);
+
+  mode = activePrimalSolutionPtr->modeSchedule_.modeAtTime(finalTime);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MRT_BASE::initFeedbackPolicyGrid(scalar_t timeStep) {
+  std::lock_guard<std::mutex> lock(producerMutex_);
+  feedbackPolicyGridTimeStep_ = timeStep;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MRT_BASE::setPolicySelector(PolicySelector policySelector) {
+  std::lock_guard<std::mutex> lock(producerMutex_);
+  policySelector_ = std::move(policySelector);
+}
 
-  mpcState = stateTrajectory.back();
-  mpcInput = inputTrajectory.back();
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MRT_BASE::evaluateFeedbackPolicy(scalar_t currentTime, const vector_t& currentState, vector_t& mpcState, vector_t& mpcInput,
+                                      size_t& mode) {
+  const auto& activePolicy = policyBuffer_.front();
+  if (activePolicy.primalSolutionPtr == nullptr) {
+    throw std::runtime_error("[MRT_BASE::evaluateFeedbackPolicy] updatePolicy() should be called first!");
+  }
+  if (activePolicy.feedbackPolicyGrid.empty()) {
+    throw std::runtime_error("[MRT_BASE::evaluateFeedbackPolicy] The policy is not sampled! Use initFeedbackPolicyGrid() to enable it!");
+  }
 
-  mode = activePrimalSolutionPtr_->modeSchedule_.modeAtTime(finalTime);
+  activePolicy.feedbackPolicyGrid.evaluate(currentTime, currentState, mpcState, mpcInput, mode);
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 bool MRT_BASE::updatePolicy() {
-  std::unique_lock<std::mutex> lock(bufferMutex_, std::try_to_lock);
-  if (lock.owns_lock()) {
-    mrtTrylockWarningCount_ = 0;
-    if (newPolicyInBuffer_) {
-      // update the active solution from buffer
-      activeCommandPtr_.swap(bufferCommandPtr_);
-      activePrimalSolutionPtr_.swap(bufferPrimalSolutionPtr_);
-      activePerformanceIndicesPtr_.swap(bufferPerformanceIndicesPtr_);
-      newPolicyInBuffer_ = false;  // make sure we don't swap in the old policy again
-
-      modifyActiveSolution(*activeCommandPtr_, *activePrimalSolutionPtr_);
-      return true;
-    } else {
-      return false;  // No policy update: the buffer contains nothing new.
-    }
+  if (policyBuffer_.updateFromBuffer()) {
+    benchmark::TraceScope swapScope(tracerPtr_.get(), "Policy Swap");
+    stateCursor_ = 0;
+    inputCursor_ = 0;
+    auto& activePolicy = policyBuffer_.front();
+    modifyActiveSolution(*activePolicy.commandPtr, *activePolicy.primalSolutionPtr);
+    return true;
   } else {
-    ++mrtTrylockWarningCount_;
-    if (mrtTrylockWarningCount_ > mrtTrylockWarningThreshold_) {
-      std::cerr << "[MRT_BASE::updatePolicy] failed to lock the policyBufferMutex for " << mrtTrylockWarningCount_
-                << " consecutive times.\n";
-    }
-    return false;  // No policy update: the lock could not be acquired.
+    return false;  // No policy update: the buffer contains nothing new.
   }
 }
 
@@ -183,7 +244,8 @@ bool MRT_BASE::updatePolicy() {
 /******************************************************************************************************/
 /******************************************************************************************************/
 void MRT_BASE::moveToBuffer(std::unique_ptr<CommandData> commandDataPtr, std::unique_ptr<PrimalSolution> primalSolutionPtr,
-                            std::unique_ptr<PerformanceIndex> performanceIndicesPtr) {
+                            std::unique_ptr<PerformanceIndex> performanceIndicesPtr,
+                            std::vector<std::unique_ptr<PrimalSolution>> contingencyPolicyPtrs, size_t policySource) {
   if (commandDataPtr == nullptr) {
     throw std::runtime_error("[MRT_BASE::moveToBuffer] commandDataPtr cannot be a null pointer!");
   }
@@ -196,19 +258,171 @@ void MRT_BASE::moveToBuffer(std::unique_ptr<CommandData> commandDataPtr, std::un
     throw std::runtime_error("[MRT_BASE::moveToBuffer] performanceIndicesPtr cannot be a null pointer!");
   }
 
-  std::lock_guard<std::mutex> lk(bufferMutex_);
-  // use swap such that the old objects are destroyed after releasing the lock.
-  bufferCommandPtr_.swap(commandDataPtr);
-  bufferPrimalSolutionPtr_.swap(primalSolutionPtr);
-  bufferPerformanceIndicesPtr_.swap(performanceIndicesPtr);
+  for (const auto& contingencyPolicyPtr : contingencyPolicyPtrs) {
+    if (contingencyPolicyPtr == nullptr) {
+      throw std::runtime_error("[MRT_BASE::moveToBuffer] contingencyPolicyPtrs cannot contain a null pointer!");
+    }
+  }
+
+  benchmark::TraceScope bufferScope(tracerPtr_.get(), "Policy Buffering");
+  std::lock_guard<std::mutex> lk(producerMutex_);
+  if (!policySelector_.select(policySource, *commandDataPtr, *performanceIndicesPtr)) {
+    // the storage of the rejected policy is recycled
+    recycledCommandPtr_ = std::move(commandDataPtr);
+    recycledPrimalSolutionPtr_ = std::move(primalSolutionPtr);
+    recycledPerformanceIndicesPtr_ = std::move(performanceIndicesPtr);
+    recycledContingencyPolicyPtrs_ = std::move(contingencyPolicyPtrs);
+    numRejectedPolicies_++;
+    return;
+  }
+
+  // use swap such that the stale policy in the back slot is recycled by getRecycledPolicy() instead of destroyed
+  auto& bufferPolicy = policyBuffer_.back();
+  bufferPolicy.commandPtr.swap(commandDataPtr);
+  bufferPolicy.primalSolutionPtr.swap(primalSolutionPtr);
+  bufferPolicy.performanceIndicesPtr.swap(performanceIndicesPtr);
+  recycledCommandPtr_.swap(commandDataPtr);
+  recycledPrimalSolutionPtr_.swap(primalSolutionPtr);
+  recycledPerformanceIndicesPtr_.swap(performanceIndicesPtr);
+  bufferPolicy.contingencyPolicyPtrs.swap(contingencyPolicyPtrs);
+  recycledContingencyPolicyPtrs_.swap(contingencyPolicyPtrs);
+  bufferPolicy.source = policySource;
 
   // allow user to modify the buffer
-  modifyBufferedSolution(*bufferCommandPtr_, *bufferPrimalSolutionPtr_);
+  modifyBufferedSolution(*bufferPolicy.commandPtr, *bufferPolicy.primalSolutionPtr);
+  for (auto& contingencyPolicyPtr : bufferPolicy.contingencyPolicyPtrs) {
+    modifyBufferedSolution(*bufferPolicy.commandPtr, *contingencyPolicyPtr);
+  }
+  for (auto& mrtObserver : observerPtrArray_) {
+    if (mrtObserver != nullptr) {
+      mrtObserver->bufferedPolicyReceived(*bufferPolicy.commandPtr, *bufferPolicy.primalSolutionPtr, *bufferPolicy.performanceIndicesPtr);
+    }
+  }
 
-  newPolicyInBuffer_ = true;
+  // sample the policy for evaluateFeedbackPolicy() on this thread
+  const size_t numContingencies = bufferPolicy.contingencyPolicyPtrs.size();
+  bufferPolicy.contingencyFeedbackPolicyGrids.resize(numContingencies);
+  if (feedbackPolicyGridTimeStep_ > 0.0) {
+    bufferPolicy.feedbackPolicyGrid.update(*bufferPolicy.primalSolutionPtr, feedbackPolicyGridTimeStep_);
+    for (size_t i = 0; i < numContingencies; i++) {
+      bufferPolicy.contingencyFeedbackPolicyGrids[i].update(*bufferPolicy.contingencyPolicyPtrs[i], feedbackPolicyGridTimeStep_);
+    }
+  } else {
+    bufferPolicy.feedbackPolicyGrid.clear();
+    for (auto& contingencyFeedbackPolicyGrid : bufferPolicy.contingencyFeedbackPolicyGrids) {
+      contingencyFeedbackPolicyGrid.clear();
+    }
+  }
+
+  if (policyBuffer_.publish()) {
+    numOverwrittenPolicies_++;
+  }
   policyReceivedEver_ = true;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MRT_BASE::copySolutionToBuffer(const MPC_BASE& mpc, const SystemObservation& mpcInitObservation, size_t policySource) {
+  // the storage of a released policy is reused such that the copies do not allocate the trajectories anew
+  std::unique_ptr<CommandData> commandPtr;
+  std::unique_ptr<PrimalSolution> primalSolutionPtr;
+  std::unique_ptr<PerformanceIndex> performanceIndicesPtr;
+  getRecycledPolicy(commandPtr, primalSolutionPtr, performanceIndicesPtr);
+
+  // policy
+  const auto* solverPtr = mpc.getSolverPtr();
+  const scalar_t startTime = mpcInitObservation.time;
+  const scalar_t finalTime =
+      (mpc.settings().solutionTimeWindow_ < 0) ? solverPtr->getFinalTime() : startTime + mpc.settings().solutionTimeWindow_;
+  solverPtr->getPrimalSolution(finalTime, primalSolutionPtr.get());
+
+  // command
+  commandPtr->mpcInitObservation_ = mpcInitObservation;
+  commandPtr->mpcTargetTrajectories_ = solverPtr->getReferenceManager().getTargetTrajectories();
+  commandPtr->mpcTiming_ = MpcTiming();
+
+  // performance indices
+  *performanceIndicesPtr = solverPtr->getPerformanceIndeces();
+
+  // policies of the contingency hypotheses, see ContingencyMpc
+  std::vector<std::unique_ptr<PrimalSolution>> contingencyPolicyPtrs;
+  const size_t numContingencies = mpc.getNumContingencies();
+  if (numContingencies > 0) {
+    getRecycledContingencyPolicies(numContingencies, contingencyPolicyPtrs);
+    for (size_t i = 0; i < numContingencies; i++) {
+      mpc.getContingencySolverPtr(i)->getPrimalSolution(finalTime, contingencyPolicyPtrs[i].get());
+    }
+  }
+
+  moveToBuffer(std::move(commandPtr), std::move(primalSolutionPtr), std::move(performanceIndicesPtr), std::move(contingencyPolicyPtrs),
+               policySource);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MRT_BASE::getRecycledPolicy(std::unique_ptr<CommandData>& commandDataPtr, std::unique_ptr<PrimalSolution>& primalSolutionPtr,
+                                 std::unique_ptr<PerformanceIndex>& performanceIndicesPtr) {
+  {
+    std::lock_guard<std::mutex> lk(producerMutex_);
+    commandDataPtr = std::move(recycledCommandPtr_);
+    primalSolutionPtr = std::move(recycledPrimalSolutionPtr_);
+    performanceIndicesPtr = std::move(recycledPerformanceIndicesPtr_);
+  }
+
+  if (commandDataPtr == nullptr) {
+    commandDataPtr.reset(new CommandData);
+  }
+  if (primalSolutionPtr == nullptr) {
+    primalSolutionPtr.reset(new PrimalSolution);
+  }
+  if (performanceIndicesPtr == nullptr) {
+    performanceIndicesPtr.reset(new PerformanceIndex);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MRT_BASE::getRecycledContingencyPolicies(size_t numContingencies,
+                                              std::vector<std::unique_ptr<PrimalSolution>>& contingencyPolicyPtrs) {
+  {
+    std::lock_guard<std::mutex> lk(producerMutex_);
+    contingencyPolicyPtrs = std::move(recycledContingencyPolicyPtrs_);
+    recycledContingencyPolicyPtrs_.clear();
+  }
+
+  contingencyPolicyPtrs.resize(numContingencies);
+  for (auto& contingencyPolicyPtr : contingencyPolicyPtrs) {
+    if (contingencyPolicyPtr == nullptr) {
+      contingencyPolicyPtr.reset(new PrimalSolution);
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MRT_BASE::switchToContingencyPolicy(size_t index) {
+  auto& activePolicy = policyBuffer_.front();
+  if (activePolicy.primalSolutionPtr == nullptr) {
+    throw std::runtime_error("[MRT_BASE::switchToContingencyPolicy] updatePolicy() should be called first!");
+  }
+  if (index >= activePolicy.contingencyPolicyPtrs.size()) {
+    throw std::runtime_error("[MRT_BASE::switchToContingencyPolicy] The policy has " +
+                             std::to_string(activePolicy.contingencyPolicyPtrs.size()) + " contingency policies, index " +
+                             std::to_string(index) + " is out of range!");
+  }
+
+  benchmark::TraceScope swapScope(tracerPtr_.get(), "Contingency Policy Swap");
+  activePolicy.primalSolutionPtr.swap(activePolicy.contingencyPolicyPtrs[index]);
+  std::swap(activePolicy.feedbackPolicyGrid, activePolicy.contingencyFeedbackPolicyGrids[index]);
+  stateCursor_ = 0;
+  inputCursor_ = 0;
+  modifyActiveSolution(*activePolicy.commandPtr, *activePolicy.primalSolutionPtr);
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
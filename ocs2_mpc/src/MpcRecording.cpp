@@ -0,0 +1,624 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_mpc/MpcRecording.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <ocs2_core/control/FeedforwardController.h>
+#include <ocs2_core/control/LinearController.h>
+
+#include "ocs2_mpc/MPC_BASE.h"
+
+namespace ocs2 {
+namespace mpc_recording {
+
+namespace {
+
+constexpr uint32_t MAGIC = 0x524d434f;  // "OCMR"
+constexpr uint32_t VERSION = 1;
+constexpr uint32_t CHECKPOINT_MAGIC = 0x5043434f;  // "OCCP"
+constexpr uint32_t CHECKPOINT_VERSION = 1;
+constexpr size_t HEADER_SIZE = 2 * sizeof(uint32_t);
+
+enum class RecordedController : uint8_t { NONE, FEEDFORWARD, LINEAR };
+
+/** Appends the serialized values to a buffer */
+class Writer {
+ public:
+  explicit Writer(std::vector<uint8_t>& buffer) : buffer_(buffer) {}
+
+  template <typename T>
+  void write(T value) {
+    const auto* bytes = reinterpret_cast<const uint8_t*>(&value);
+    buffer_.insert(buffer_.end(), bytes, bytes + sizeof(T));
+  }
+
+  void write(const scalar_t* data, size_t size) {
+    const auto* bytes = reinterpret_cast<const uint8_t*>(data);
+    buffer_.insert(buffer_.end(), bytes, bytes + size * sizeof(scalar_t));
+  }
+
+  void write(const scalar_array_t& array) {
+    write<uint64_t>(array.size());
+    write(array.data(), array.size());
+  }
+
+  void write(const size_array_t& array) {
+    write<uint64_t>(array.size());
+    for (const auto value : array) {
+      write<uint64_t>(value);
+    }
+  }
+
+  void write(const vector_t& vector) {
+    write<uint64_t>(vector.size());
+    write(vector.data(), vector.size());
+  }
+
+  void write(const matrix_t& matrix) {
+    write<uint64_t>(matrix.rows());
+    write<uint64_t>(matrix.cols());
+    write(matrix.data(), matrix.size());
+  }
+
+  template <typename T>
+  void writeArray(const std::vector<T, Eigen::aligned_allocator<T>>& array) {
+    write<uint64_t>(array.size());
+    for (const auto& value : array) {
+      write(value);
+    }
+  }
+
+  template <typename T>
+  void writeArray(const std::vector<T>& array) {
+    write<uint64_t>(array.size());
+    for (const auto& value : array) {
+      write(value);
+    }
+  }
+
+  void write(const ModeSchedule& modeSchedule) {
+    write(modeSchedule.eventTimes);
+    write(modeSchedule.modeSequence);
+  }
+
+  void write(const Multiplier& multiplier) {
+    write(multiplier.penalty);
+    write(multiplier.lagrangian);
+  }
+
+  void write(const MultiplierCollection& multipliers) {
+    writeArray(multipliers.stateEq);
+    writeArray(multipliers.stateIneq);
+    writeArray(multipliers.stateInputEq);
+    writeArray(multipliers.stateInputIneq);
+  }
+
+ private:
+  std::vector<uint8_t>& buffer_;
+};
+
+/** Reads the values written by Writer. Throws if the data ends prematurely. */
+class Reader {
+ public:
+  Reader(const uint8_t* data, size_t size) : data_(data), end_(data + size) {}
+
+  template <typename T>
+  T read() {
+    T value;
+    readBytes(&value, sizeof(T));
+    return value;
+  }
+
+  void read(scalar_array_t& array) {
+    array.resize(readSize(sizeof(scalar_t)));
+    readBytes(array.data(), array.size() * sizeof(scalar_t));
+  }
+
+  void read(size_array_t& array) {
+    array.resize(readSize(sizeof(uint64_t)));
+    for (auto& value : array) {
+      value = read<uint64_t>();
+    }
+  }
+
+  void read(vector_t& vector) {
+    vector.resize(readSize(sizeof(scalar_t)));
+    readBytes(vector.data(), vector.size() * sizeof(scalar_t));
+  }
+
+  void read(matrix_t& matrix) {
+    const auto rows = read<uint64_t>();
+    const auto cols = read<uint64_t>();
+    if (cols > 0 && rows > static_cast<uint64_t>(end_ - data_) / sizeof(scalar_t) / cols) {
+      throw std::runtime_error("[mpc_recording::LogReader] The record is truncated!");
+    }
+    matrix.resize(rows, cols);
+    readBytes(matrix.data(), matrix.size() * sizeof(scalar_t));
+  }
+
+  template <typename Array>
+  void readArray(Array& array) {
+    array.resize(readSize(sizeof(uint64_t)));
+    for (auto& value : array) {
+      read(value);
+    }
+  }
+
+  void read(ModeSchedule& modeSchedule) {
+    read(modeSchedule.eventTimes);
+    read(modeSchedule.modeSequence);
+  }
+
+  void read(Multiplier& multiplier) {
+    multiplier.penalty = read<scalar_t>();
+    read(multiplier.lagrangian);
+  }
+
+  void read(MultiplierCollection& multipliers) {
+    readArray(multipliers.stateEq);
+    readArray(multipliers.stateIneq);
+    readArray(multipliers.stateInputEq);
+    readArray(multipliers.stateInputIneq);
+  }
+
+ private:
+  /** Reads the size of an array, checking that its elements of at least elementSize bytes fit into the remaining data */
+  size_t readSize(size_t elementSize) {
+    const auto size = read<uint64_t>();
+    if (size > static_cast<uint64_t>(end_ - data_) / elementSize) {
+      throw std::runtime_error("[mpc_recording::LogReader] The record is truncated!");
+    }
+    return size;
+  }
+
+  void readBytes(void* destination, size_t size) {
+    if (size > static_cast<size_t>(end_ - data_)) {
+      throw std::runtime_error("[mpc_recording::LogReader] The record is truncated!");
+    }
+    std::memcpy(destination, data_, size);
+    data_ += size;
+  }
+
+  const uint8_t* data_;
+  const uint8_t* const end_;
+};
+
+void writeController(Writer& writer, const ControllerBase* controllerPtr) {
+  if (controllerPtr != nullptr && !controllerPtr->empty()) {
+    if (const auto* linearControllerPtr = dynamic_cast<const LinearController*>(controllerPtr)) {
+      writer.write(RecordedController::LINEAR);
+      writer.write(linearControllerPtr->timeStamp_);
+      writer.writeArray(linearControllerPtr->biasArray_);
+      writer.writeArray(linearControllerPtr->gainArray_);
+      return;
+    }
+    if (const auto* feedforwardControllerPtr = dynamic_cast<const FeedforwardController*>(controllerPtr)) {
+      writer.write(RecordedController::FEEDFORWARD);
+      writer.write(feedforwardControllerPtr->timeStamp_);
+      writer.writeArray(feedforwardControllerPtr->uffArray_);
+      return;
+    }
+  }
+  // other controllers are not recorded, the solver is then warm started by the state-input trajectories
+  writer.write(RecordedController::NONE);
+}
+
+std::unique_ptr<ControllerBase> readController(Reader& reader) {
+  switch (reader.read<RecordedController>()) {
+    case RecordedController::NONE:
+      return nullptr;
+    case RecordedController::FEEDFORWARD: {
+      std::unique_ptr<FeedforwardController> controllerPtr(new FeedforwardController);
+      reader.read(controllerPtr->timeStamp_);
+      reader.readArray(controllerPtr->uffArray_);
+      return std::move(controllerPtr);
+    }
+    case RecordedController::LINEAR: {
+      std::unique_ptr<LinearController> controllerPtr(new LinearController);
+      reader.read(controllerPtr->timeStamp_);
+      reader.readArray(controllerPtr->biasArray_);
+      reader.readArray(controllerPtr->gainArray_);
+      return std::move(controllerPtr);
+    }
+    default:
+      throw std::runtime_error("[mpc_recording::LogReader] Unknown controller type!");
+  }
+}
+
+void writePrimalSolution(Writer& writer, const PrimalSolution& primalSolution) {
+  writer.write(primalSolution.timeTrajectory_);
+  writer.writeArray(primalSolution.stateTrajectory_);
+  writer.writeArray(primalSolution.inputTrajectory_);
+  writer.write(primalSolution.postEventIndices_);
+  writer.write(primalSolution.modeSchedule_);
+  writeController(writer, primalSolution.controllerPtr_.get());
+}
+
+void readPrimalSolution(Reader& reader, PrimalSolution& primalSolution) {
+  reader.read(primalSolution.timeTrajectory_);
+  reader.readArray(primalSolution.stateTrajectory_);
+  reader.readArray(primalSolution.inputTrajectory_);
+  reader.read(primalSolution.postEventIndices_);
+  reader.read(primalSolution.modeSchedule_);
+  primalSolution.controllerPtr_ = readController(reader);
+}
+
+void writeTargetTrajectories(Writer& writer, const TargetTrajectories& targetTrajectories) {
+  writer.write(targetTrajectories.timeTrajectory);
+  writer.writeArray(targetTrajectories.stateTrajectory);
+  writer.writeArray(targetTrajectories.inputTrajectory);
+}
+
+void readTargetTrajectories(Reader& reader, TargetTrajectories& targetTrajectories) {
+  reader.read(targetTrajectories.timeTrajectory);
+  reader.readArray(targetTrajectories.stateTrajectory);
+  reader.readArray(targetTrajectories.inputTrajectory);
+}
+
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+uint64_t hashFile(const std::string& fileName) {
+  std::ifstream file(fileName, std::ios::binary);
+  if (!file) {
+    throw std::runtime_error("[mpc_recording::hashFile] Could not read " + fileName + "!");
+  }
+  uint64_t hash = 0xcbf29ce484222325;
+  char character;
+  while (file.get(character)) {
+    hash ^= static_cast<uint8_t>(character);
+    hash *= 0x100000001b3;
+  }
+  return hash;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+Recorder::Recorder(const std::string& fileName, uint64_t settingsHash)
+    : file_(fileName, std::ios::binary | std::ios::trunc), settingsHash_(settingsHash) {
+  if (!file_) {
+    throw std::runtime_error("[mpc_recording::Recorder] Could not create " + fileName + "!");
+  }
+  Writer writer(buffer_);
+  writer.write(MAGIC);
+  writer.write(VERSION);
+  file_.write(reinterpret_cast<const char*>(buffer_.data()), buffer_.size());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void Recorder::record(const CycleRecord& record) {
+  buffer_.clear();
+  Writer writer(buffer_);
+  writer.write<uint64_t>(0);  // the size of the payload, set below
+  writer.write(numCycles_++);
+  writer.write(settingsHash_);
+  writer.write(record.initTime);
+  writer.write(record.initState);
+  writer.write(record.finalTime);
+  writer.write(record.solveTime);
+
+  writeTargetTrajectories(writer, record.targetTrajectories);
+  writer.write(record.modeSchedule);
+  writePrimalSolution(writer, record.warmStart);
+
+  const uint64_t payloadSize = buffer_.size() - sizeof(uint64_t);
+  std::memcpy(buffer_.data(), &payloadSize, sizeof(uint64_t));
+  file_.write(reinterpret_cast<const char*>(buffer_.data()), buffer_.size());
+  file_.flush();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+LogReader::LogReader(const std::string& fileName) {
+  const int fd = open(fileName.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("[mpc_recording::LogReader] Could not open " + fileName + "!");
+  }
+  struct stat fileStat;
+  if (fstat(fd, &fileStat) != 0 || static_cast<size_t>(fileStat.st_size) < HEADER_SIZE) {
+    close(fd);
+    throw std::runtime_error("[mpc_recording::LogReader] " + fileName + " is not a log of MPC cycles!");
+  }
+  dataSize_ = static_cast<size_t>(fileStat.st_size);
+  void* dataPtr = mmap(nullptr, dataSize_, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (dataPtr == MAP_FAILED) {
+    throw std::runtime_error("[mpc_recording::LogReader] Could not map " + fileName + "!");
+  }
+  dataPtr_ = static_cast<const uint8_t*>(dataPtr);
+
+  uint32_t header[2];
+  std::memcpy(header, dataPtr_, HEADER_SIZE);
+  if (header[0] != MAGIC || header[1] != VERSION) {
+    munmap(const_cast<uint8_t*>(dataPtr_), dataSize_);
+    throw std::runtime_error("[mpc_recording::LogReader] " + fileName + " is not a log of MPC cycles of version " +
+                             std::to_string(VERSION) + "!");
+  }
+
+  // index the complete records
+  size_t offset = HEADER_SIZE;
+  while (dataSize_ - offset >= sizeof(uint64_t)) {
+    uint64_t payloadSize;
+    std::memcpy(&payloadSize, dataPtr_ + offset, sizeof(uint64_t));
+    offset += sizeof(uint64_t);
+    if (payloadSize > dataSize_ - offset) {
+      break;
+    }
+    recordOffsets_.emplace_back(offset, payloadSize);
+    offset += payloadSize;
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+LogReader::~LogReader() {
+  munmap(const_cast<uint8_t*>(dataPtr_), dataSize_);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+CycleRecord LogReader::read(size_t index) const {
+  if (index >= recordOffsets_.size()) {
+    throw std::runtime_error("[mpc_recording::LogReader] The record " + std::to_string(index) + " is out of range!");
+  }
+  Reader reader(dataPtr_ + recordOffsets_[index].first, recordOffsets_[index].second);
+
+  CycleRecord record;
+  record.cycleIndex = reader.read<uint64_t>();
+  record.settingsHash = reader.read<uint64_t>();
+  record.initTime = reader.read<scalar_t>();
+  reader.read(record.initState);
+  record.finalTime = reader.read<scalar_t>();
+  record.solveTime = reader.read<scalar_t>();
+
+  readTargetTrajectories(reader, record.targetTrajectories);
+  reader.read(record.modeSchedule);
+  readPrimalSolution(reader, record.warmStart);
+  return record;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t replayCycle(MPC_BASE& mpc, const CycleRecord& record) {
+  auto& solver = *mpc.getSolverPtr();
+  solver.reset();
+  solver.clearDeadline();
+  solver.getReferenceManager().setTargetTrajectories(record.targetTrajectories);
+  solver.getReferenceManager().setModeSchedule(record.modeSchedule);
+
+  const auto startTime = std::chrono::steady_clock::now();
+  if (record.warmStart.timeTrajectory_.empty()) {
+    solver.run(record.initTime, record.initState, record.finalTime);
+  } else {
+    solver.run(record.initTime, record.initState, record.finalTime, record.warmStart);
+  }
+  return std::chrono::duration<scalar_t, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+CheckpointWriter::CheckpointWriter(std::string fileName, uint64_t settingsHash, scalar_t period)
+    : fileName_(std::move(fileName)),
+      period_(std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<scalar_t>(period))) {
+  checkpoint_.settingsHash = settingsHash;
+  writerThread_ = std::thread(&CheckpointWriter::writerWorker, this);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+CheckpointWriter::~CheckpointWriter() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    terminate_ = true;
+  }
+  pendingCondition_.notify_one();
+  writerThread_.join();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CheckpointWriter::capture(const MPC_BASE& mpc, scalar_t initTime, scalar_t finalTime) {
+  const auto now = std::chrono::steady_clock::now();
+  if (now - lastCaptureTime_ < period_) {
+    return;
+  }
+
+  // the MPC thread never waits for the writer thread
+  std::unique_lock<std::mutex> lock(mutex_, std::try_to_lock);
+  if (!lock.owns_lock() || isPending_) {
+    return;
+  }
+
+  // copy assignment reuses the memory of the previous checkpoint
+  const auto& solver = *mpc.getSolverPtr();
+  checkpoint_.initTime = initTime;
+  checkpoint_.finalTime = finalTime;
+  checkpoint_.targetTrajectories = solver.getReferenceManager().getTargetTrajectories();
+  checkpoint_.modeSchedule = solver.getReferenceManager().getModeSchedule();
+  solver.getPrimalSolution(finalTime, &checkpoint_.primalSolution);
+  checkpoint_.dualSolution = solver.getDualSolution();
+  if (checkpoint_.primalSolution.timeTrajectory_.empty()) {
+    return;
+  }
+
+  lastCaptureTime_ = now;
+  isPending_ = true;
+  lock.unlock();
+  pendingCondition_.notify_one();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t CheckpointWriter::getNumCheckpoints() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return numCheckpoints_;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CheckpointWriter::writerWorker() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    pendingCondition_.wait(lock, [this] { return isPending_ || terminate_; });
+    if (!isPending_) {
+      return;
+    }
+
+    // serialize while the checkpoint is guarded, capture() skips meanwhile
+    buffer_.clear();
+    Writer writer(buffer_);
+    writer.write(CHECKPOINT_MAGIC);
+    writer.write(CHECKPOINT_VERSION);
+    writer.write(checkpoint_.settingsHash);
+    writer.write(checkpoint_.initTime);
+    writer.write(checkpoint_.finalTime);
+    writeTargetTrajectories(writer, checkpoint_.targetTrajectories);
+    writer.write(checkpoint_.modeSchedule);
+    writePrimalSolution(writer, checkpoint_.primalSolution);
+    const auto& dualSolution = checkpoint_.dualSolution;
+    writer.write(dualSolution.timeTrajectory);
+    writer.write(dualSolution.postEventIndices);
+    writer.write(dualSolution.final);
+    writer.writeArray(dualSolution.preJumps);
+    writer.writeArray(dualSolution.intermediates);
+    lock.unlock();
+
+    // the previous checkpoint is atomically replaced once the new one is completely written
+    const std::string temporaryFileName = fileName_ + ".tmp";
+    bool isWritten;
+    {
+      std::ofstream file(temporaryFileName, std::ios::binary | std::ios::trunc);
+      file.write(reinterpret_cast<const char*>(buffer_.data()), buffer_.size());
+      file.close();
+      isWritten = !file.fail();
+    }
+    isWritten = isWritten && std::rename(temporaryFileName.c_str(), fileName_.c_str()) == 0;
+    if (!isWritten) {
+      std::cerr << "[mpc_recording::CheckpointWriter] Could not write " << fileName_ << "!\n";
+    }
+
+    lock.lock();
+    isPending_ = false;
+    if (isWritten) {
+      numCheckpoints_++;
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool loadCheckpoint(const std::string& fileName, uint64_t settingsHash, Checkpoint& checkpoint) {
+  std::ifstream file(fileName, std::ios::binary);
+  if (!file) {
+    return false;
+  }
+  const std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+  try {
+    Reader reader(data.data(), data.size());
+    if (reader.read<uint32_t>() != CHECKPOINT_MAGIC || reader.read<uint32_t>() != CHECKPOINT_VERSION) {
+      std::cerr << "[mpc_recording::loadCheckpoint] " << fileName << " is not a checkpoint of version " << CHECKPOINT_VERSION << "!\n";
+      return false;
+    }
+    checkpoint.settingsHash = reader.read<uint64_t>();
+    if (checkpoint.settingsHash != settingsHash) {
+      std::cerr << "[mpc_recording::loadCheckpoint] The checkpoint " << fileName << " belongs to other settings!\n";
+      return false;
+    }
+    checkpoint.initTime = reader.read<scalar_t>();
+    checkpoint.finalTime = reader.read<scalar_t>();
+    readTargetTrajectories(reader, checkpoint.targetTrajectories);
+    reader.read(checkpoint.modeSchedule);
+    readPrimalSolution(reader, checkpoint.primalSolution);
+    auto& dualSolution = checkpoint.dualSolution;
+    reader.read(dualSolution.timeTrajectory);
+    reader.read(dualSolution.postEventIndices);
+    reader.read(dualSolution.final);
+    reader.readArray(dualSolution.preJumps);
+    reader.readArray(dualSolution.intermediates);
+  } catch (const std::exception& error) {
+    std::cerr << "[mpc_recording::loadCheckpoint] The checkpoint " << fileName << " is malformed: " << error.what() << "\n";
+    return false;
+  }
+
+  return !checkpoint.primalSolution.timeTrajectory_.empty();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void restoreCheckpoint(MPC_BASE& mpc, Checkpoint checkpoint, scalar_t initTime) {
+  if (checkpoint.primalSolution.timeTrajectory_.empty()) {
+    throw std::runtime_error("[restoreCheckpoint] The primal solution of the checkpoint is empty!");
+  }
+
+  // the references are shifted as the warm start, which the solver shifts to the initial time of its run
+  const scalar_t timeShift = initTime - checkpoint.primalSolution.timeTrajectory_.front();
+  for (auto& time : checkpoint.targetTrajectories.timeTrajectory) {
+    time += timeShift;
+  }
+  for (auto& time : checkpoint.modeSchedule.eventTimes) {
+    time += timeShift;
+  }
+
+  auto& solver = *mpc.getSolverPtr();
+  solver.getReferenceManager().setTargetTrajectories(std::move(checkpoint.targetTrajectories));
+  solver.getReferenceManager().setModeSchedule(std::move(checkpoint.modeSchedule));
+  solver.setWarmStart(std::move(checkpoint.primalSolution), std::move(checkpoint.dualSolution));
+}
+
+}  // namespace mpc_recording
+}  // namespace ocs2
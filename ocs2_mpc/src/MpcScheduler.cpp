@@ -0,0 +1,92 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+
+#include "ocs2_mpc/MpcScheduler.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+MpcScheduler::MpcScheduler(const mpc::Settings& mpcSettings)
+    : nominalTimeHorizon_(mpcSettings.timeHorizon_),
+      minTimeHorizon_(mpcSettings.minTimeHorizon_ > 0.0 ? mpcSettings.minTimeHorizon_ : mpcSettings.timeHorizon_),
+      maxTimeHorizon_(mpcSettings.maxTimeHorizon_ > 0.0 ? mpcSettings.maxTimeHorizon_ : mpcSettings.timeHorizon_),
+      targetLatency_(mpcSettings.targetLatency_),
+      adaptationRate_(mpcSettings.schedulingAdaptationRate_) {
+  if (minTimeHorizon_ > maxTimeHorizon_) {
+    throw std::runtime_error("[MpcScheduler] minTimeHorizon cannot be larger than maxTimeHorizon!");
+  }
+  if (adaptationRate_ < 0.0 || adaptationRate_ > 1.0) {
+    throw std::runtime_error("[MpcScheduler] schedulingAdaptationRate should be in [0, 1]!");
+  }
+  reset();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MpcScheduler::reset() {
+  schedule_.timeHorizon = std::min(std::max(nominalTimeHorizon_, minTimeHorizon_), maxTimeHorizon_);
+  schedule_.timeBudget = targetLatency_;
+  schedule_.latestLatency = 0.0;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::chrono::steady_clock::time_point MpcScheduler::getDeadline(std::chrono::steady_clock::time_point startTime) const {
+  if (schedule_.timeBudget <= 0.0) {
+    return std::chrono::steady_clock::time_point::max();
+  }
+  const std::chrono::duration<scalar_t> timeBudget(schedule_.timeBudget);
+  return startTime + std::chrono::duration_cast<std::chrono::steady_clock::duration>(timeBudget);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MpcScheduler::update(scalar_t latency) {
+  schedule_.latestLatency = latency;
+
+  if (targetLatency_ > 0.0 && latency > 0.0) {
+    const scalar_t scaling = 1.0 + adaptationRate_ * (targetLatency_ / latency - 1.0);
+    schedule_.timeHorizon = std::min(std::max(scaling * schedule_.timeHorizon, minTimeHorizon_), maxTimeHorizon_);
+  }
+
+  if (scheduleCallback_) {
+    scheduleCallback_(schedule_);
+  }
+}
+
+}  // namespace ocs2
@@ -0,0 +1,143 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_mpc/ObservationLatencyObserver.h"
+
+#include <algorithm>
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ObservationLatencyObserver::ObservationLatencyObserver(size_t historyLength)
+    : sentObservations_(std::max<size_t>(historyLength, 1), {-1.0, clock::time_point()}) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ObservationLatencyObserver::observationSent(scalar_t observationTime) {
+  const auto now = clock::now();
+  std::lock_guard<std::mutex> lock(mutex_);
+  sentObservations_[next_] = {observationTime, now};
+  next_ = (next_ + 1) % sentObservations_.size();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ObservationLatencyStatistics ObservationLatencyObserver::getStatistics() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return statistics_;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool ObservationLatencyObserver::policyActuated(PolicyLatency& latency) {
+  if (activePolicyActuated_) {
+    return false;
+  }
+  activePolicyActuated_ = true;
+
+  const auto now = clock::now();
+  const auto toSeconds = [](clock::duration duration) { return std::chrono::duration<scalar_t>(duration).count(); };
+  const auto& mpcTiming = activePolicy_.mpcTiming;
+  latency.mpcModules = mpcTiming.synchronizedModulesTime;
+  latency.mpcSolver = mpcTiming.runTime - mpcTiming.synchronizedModulesTime;
+  latency.mpcOverhead = mpcTiming.processingTime - mpcTiming.runTime;
+  latency.transport = toSeconds(activePolicy_.bufferTime - activePolicy_.sendTime) - mpcTiming.processingTime;
+  latency.policyWaiting = toSeconds(activePolicy_.loadTime - activePolicy_.bufferTime);
+  latency.evaluation = toSeconds(now - activePolicy_.loadTime);
+  latency.endToEnd = toSeconds(now - activePolicy_.sendTime);
+  return true;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ObservationLatencyObserver::reset() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::fill(sentObservations_.begin(), sentObservations_.end(), std::make_pair(scalar_t(-1.0), clock::time_point()));
+  next_ = 0;
+  statistics_ = ObservationLatencyStatistics();
+  bufferedPolicies_.fill(PolicyTimes());
+  nextBuffered_ = 0;
+  activePolicyActuated_ = true;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ObservationLatencyObserver::modifyActiveSolution(const CommandData& command, PrimalSolution& primalSolution) {
+  const auto now = clock::now();
+  const scalar_t observationTime = command.mpcInitObservation_.time;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto it = std::find_if(bufferedPolicies_.cbegin(), bufferedPolicies_.cend(),
+                               [observationTime](const PolicyTimes& policy) { return policy.observationTime == observationTime; });
+  if (it == bufferedPolicies_.cend()) {
+    activePolicyActuated_ = true;  // unknown policy
+    return;
+  }
+
+  activePolicy_ = *it;
+  activePolicy_.loadTime = now;
+  activePolicyActuated_ = false;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ObservationLatencyObserver::modifyBufferedSolution(const CommandData& commandBuffer, PrimalSolution& primalSolutionBuffer) {
+  const auto now = clock::now();
+  const scalar_t observationTime = commandBuffer.mpcInitObservation_.time;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto it = std::find_if(sentObservations_.cbegin(), sentObservations_.cend(),
+                               [observationTime](const std::pair<scalar_t, clock::time_point>& sent) { return sent.first == observationTime; });
+  if (it == sentObservations_.cend()) {
+    return;
+  }
+
+  const scalar_t latency = std::chrono::duration<scalar_t>(now - it->second).count();
+  statistics_.numSamples++;
+  statistics_.latest = latency;
+  statistics_.average += (latency - statistics_.average) / static_cast<scalar_t>(statistics_.numSamples);
+  statistics_.maximum = std::max(statistics_.maximum, latency);
+
+  auto& bufferedPolicy = bufferedPolicies_[nextBuffered_];
+  bufferedPolicy.observationTime = observationTime;
+  bufferedPolicy.sendTime = it->second;
+  bufferedPolicy.bufferTime = now;
+  bufferedPolicy.mpcTiming = commandBuffer.mpcTiming_;
+  nextBuffered_ = (nextBuffered_ + 1) % bufferedPolicies_.size();
+}
+
+}  // namespace ocs2
@@ -0,0 +1,495 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_mpc/PolicyLog.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <tuple>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <ocs2_core/control/FeedforwardController.h>
+#include <ocs2_core/control/LinearController.h>
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "The policy log requires lock-free atomics.");
+
+namespace ocs2 {
+namespace policy_log {
+
+namespace {
+
+constexpr uint32_t MAGIC = 0x4c50434f;  // "OCPL"
+constexpr uint32_t VERSION = 1;
+constexpr size_t HEADER_SIZE = 64;
+constexpr size_t ALIGNMENT = 64;
+
+enum class LoggedController : uint8_t { NONE, FEEDFORWARD, LINEAR };
+
+struct FileHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint64_t recordCapacity;
+  uint64_t numRecords;
+  uint64_t recordStride;
+};
+
+struct RecordHeader {
+  std::atomic<uint64_t> sequence;
+  uint64_t size;
+};
+
+size_t alignUp(size_t size) {
+  return (size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+}
+
+/** Writes the serialized values into a fixed-size memory block. The writer fails once the values do not fit. */
+class Writer {
+ public:
+  Writer(uint8_t* data, size_t capacity) : begin_(data), current_(data), end_(data + capacity) {}
+
+  bool ok() const { return ok_; }
+
+  size_t size() const { return static_cast<size_t>(current_ - begin_); }
+
+  template <typename T>
+  void write(T value) {
+    writeBytes(&value, sizeof(T));
+  }
+
+  void write(const scalar_t* data, size_t size) { writeBytes(data, size * sizeof(scalar_t)); }
+
+  void write(const scalar_array_t& array) {
+    write<uint64_t>(array.size());
+    write(array.data(), array.size());
+  }
+
+  void write(const size_array_t& array) {
+    write<uint64_t>(array.size());
+    for (const auto value : array) {
+      write<uint64_t>(value);
+    }
+  }
+
+  void write(const vector_t& vector) {
+    write<uint64_t>(vector.size());
+    write(vector.data(), vector.size());
+  }
+
+  void write(const matrix_t& matrix) {
+    write<uint64_t>(matrix.rows());
+    write<uint64_t>(matrix.cols());
+    write(matrix.data(), matrix.size());
+  }
+
+  template <typename Array>
+  void writeArray(const Array& array) {
+    write<uint64_t>(array.size());
+    for (const auto& value : array) {
+      write(value);
+    }
+  }
+
+ private:
+  void writeBytes(const void* source, size_t size) {
+    if (!ok_ || size > static_cast<size_t>(end_ - current_)) {
+      ok_ = false;
+      return;
+    }
+    std::memcpy(current_, source, size);
+    current_ += size;
+  }
+
+  uint8_t* const begin_;
+  uint8_t* current_;
+  uint8_t* const end_;
+  bool ok_ = true;
+};
+
+/** Reads the values written by Writer. Throws if the data ends prematurely. */
+class Reader {
+ public:
+  Reader(const uint8_t* data, size_t size) : data_(data), end_(data + size) {}
+
+  template <typename T>
+  T read() {
+    T value;
+    readBytes(&value, sizeof(T));
+    return value;
+  }
+
+  void read(scalar_array_t& array) {
+    array.resize(readSize(sizeof(scalar_t)));
+    readBytes(array.data(), array.size() * sizeof(scalar_t));
+  }
+
+  void read(size_array_t& array) {
+    array.resize(readSize(sizeof(uint64_t)));
+    for (auto& value : array) {
+      value = read<uint64_t>();
+    }
+  }
+
+  void read(vector_t& vector) {
+    vector.resize(readSize(sizeof(scalar_t)));
+    readBytes(vector.data(), vector.size() * sizeof(scalar_t));
+  }
+
+  void read(matrix_t& matrix) {
+    const auto rows = read<uint64_t>();
+    const auto cols = read<uint64_t>();
+    if (cols > 0 && rows > static_cast<uint64_t>(end_ - data_) / sizeof(scalar_t) / cols) {
+      throw std::runtime_error("[policy_log::LogReader] The record is truncated!");
+    }
+    matrix.resize(rows, cols);
+    readBytes(matrix.data(), matrix.size() * sizeof(scalar_t));
+  }
+
+  template <typename Array>
+  void readArray(Array& array) {
+    array.resize(readSize(sizeof(uint64_t)));
+    for (auto& value : array) {
+      read(value);
+    }
+  }
+
+ private:
+  /** Reads the size of an array, checking that its elements of at least elementSize bytes fit into the remaining data */
+  size_t readSize(size_t elementSize) {
+    const auto size = read<uint64_t>();
+    if (size > static_cast<uint64_t>(end_ - data_) / elementSize) {
+      throw std::runtime_error("[policy_log::LogReader] The record is truncated!");
+    }
+    return size;
+  }
+
+  void readBytes(void* destination, size_t size) {
+    if (size > static_cast<size_t>(end_ - data_)) {
+      throw std::runtime_error("[policy_log::LogReader] The record is truncated!");
+    }
+    std::memcpy(destination, data_, size);
+    data_ += size;
+  }
+
+  const uint8_t* data_;
+  const uint8_t* const end_;
+};
+
+void writePerformanceIndex(Writer& writer, const PerformanceIndex& performanceIndex) {
+  writer.write(performanceIndex.merit);
+  writer.write(performanceIndex.cost);
+  writer.write(performanceIndex.dynamicsViolationSSE);
+  writer.write(performanceIndex.equalityConstraintsSSE);
+  writer.write(performanceIndex.equalityLagrangian);
+  writer.write(performanceIndex.inequalityLagrangian);
+  writer.write<uint8_t>(performanceIndex.deadlineReached ? 1 : 0);
+}
+
+void readPerformanceIndex(Reader& reader, PerformanceIndex& performanceIndex) {
+  performanceIndex.merit = reader.read<scalar_t>();
+  performanceIndex.cost = reader.read<scalar_t>();
+  performanceIndex.dynamicsViolationSSE = reader.read<scalar_t>();
+  performanceIndex.equalityConstraintsSSE = reader.read<scalar_t>();
+  performanceIndex.equalityLagrangian = reader.read<scalar_t>();
+  performanceIndex.inequalityLagrangian = reader.read<scalar_t>();
+  performanceIndex.deadlineReached = reader.read<uint8_t>() != 0;
+}
+
+void writeCommand(Writer& writer, const CommandData& command) {
+  const auto& observation = command.mpcInitObservation_;
+  writer.write<uint64_t>(observation.mode);
+  writer.write(observation.time);
+  writer.write(observation.state);
+  writer.write(observation.input);
+
+  const auto& targetTrajectories = command.mpcTargetTrajectories_;
+  writer.write(targetTrajectories.timeTrajectory);
+  writer.writeArray(targetTrajectories.stateTrajectory);
+  writer.writeArray(targetTrajectories.inputTrajectory);
+
+  writer.write(command.mpcTiming_.synchronizedModulesTime);
+  writer.write(command.mpcTiming_.runTime);
+  writer.write(command.mpcTiming_.processingTime);
+}
+
+void readCommand(Reader& reader, CommandData& command) {
+  auto& observation = command.mpcInitObservation_;
+  observation.mode = reader.read<uint64_t>();
+  observation.time = reader.read<scalar_t>();
+  reader.read(observation.state);
+  reader.read(observation.input);
+
+  auto& targetTrajectories = command.mpcTargetTrajectories_;
+  reader.read(targetTrajectories.timeTrajectory);
+  reader.readArray(targetTrajectories.stateTrajectory);
+  reader.readArray(targetTrajectories.inputTrajectory);
+
+  command.mpcTiming_.synchronizedModulesTime = reader.read<scalar_t>();
+  command.mpcTiming_.runTime = reader.read<scalar_t>();
+  command.mpcTiming_.processingTime = reader.read<scalar_t>();
+}
+
+void writeController(Writer& writer, const ControllerBase* controllerPtr) {
+  if (controllerPtr != nullptr && !controllerPtr->empty()) {
+    if (const auto* linearControllerPtr = dynamic_cast<const LinearController*>(controllerPtr)) {
+      writer.write(LoggedController::LINEAR);
+      writer.write(linearControllerPtr->timeStamp_);
+      writer.writeArray(linearControllerPtr->biasArray_);
+      writer.writeArray(linearControllerPtr->gainArray_);
+      return;
+    }
+    if (const auto* feedforwardControllerPtr = dynamic_cast<const FeedforwardController*>(controllerPtr)) {
+      writer.write(LoggedController::FEEDFORWARD);
+      writer.write(feedforwardControllerPtr->timeStamp_);
+      writer.writeArray(feedforwardControllerPtr->uffArray_);
+      return;
+    }
+  }
+  // other controllers are not logged
+  writer.write(LoggedController::NONE);
+}
+
+std::unique_ptr<ControllerBase> readController(Reader& reader) {
+  switch (reader.read<LoggedController>()) {
+    case LoggedController::NONE:
+      return nullptr;
+    case LoggedController::FEEDFORWARD: {
+      std::unique_ptr<FeedforwardController> controllerPtr(new FeedforwardController);
+      reader.read(controllerPtr->timeStamp_);
+      reader.readArray(controllerPtr->uffArray_);
+      return std::move(controllerPtr);
+    }
+    case LoggedController::LINEAR: {
+      std::unique_ptr<LinearController> controllerPtr(new LinearController);
+      reader.read(controllerPtr->timeStamp_);
+      reader.readArray(controllerPtr->biasArray_);
+      reader.readArray(controllerPtr->gainArray_);
+      return std::move(controllerPtr);
+    }
+    default:
+      throw std::runtime_error("[policy_log::LogReader] Unknown controller type!");
+  }
+}
+
+void writePrimalSolution(Writer& writer, const PrimalSolution& primalSolution) {
+  writer.write(primalSolution.timeTrajectory_);
+  writer.writeArray(primalSolution.stateTrajectory_);
+  writer.writeArray(primalSolution.inputTrajectory_);
+  writer.write(primalSolution.postEventIndices_);
+  writer.write(primalSolution.modeSchedule_.eventTimes);
+  writer.write(primalSolution.modeSchedule_.modeSequence);
+  writeController(writer, primalSolution.controllerPtr_.get());
+}
+
+void readPrimalSolution(Reader& reader, PrimalSolution& primalSolution) {
+  reader.read(primalSolution.timeTrajectory_);
+  reader.readArray(primalSolution.stateTrajectory_);
+  reader.readArray(primalSolution.inputTrajectory_);
+  reader.read(primalSolution.postEventIndices_);
+  reader.read(primalSolution.modeSchedule_.eventTimes);
+  reader.read(primalSolution.modeSchedule_.modeSequence);
+  primalSolution.controllerPtr_ = readController(reader);
+}
+
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+PolicyLogger::PolicyLogger(const std::string& fileName, size_t recordCapacity, size_t numRecords)
+    : recordCapacity_(recordCapacity), numRecords_(numRecords), recordStride_(alignUp(sizeof(RecordHeader) + recordCapacity)) {
+  if (numRecords_ < 1) {
+    throw std::runtime_error("[policy_log::PolicyLogger] numRecords must be at least 1!");
+  }
+  dataSize_ = HEADER_SIZE + numRecords_ * recordStride_;
+
+  const int fd = open(fileName.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    throw std::runtime_error("[policy_log::PolicyLogger] Could not create " + fileName + "!");
+  }
+  if (ftruncate(fd, static_cast<off_t>(dataSize_)) != 0) {
+    close(fd);
+    throw std::runtime_error("[policy_log::PolicyLogger] Could not resize " + fileName + "!");
+  }
+  // allocate the blocks of the file beforehand, this is best effort since not all file systems support it
+  std::ignore = posix_fallocate(fd, 0, static_cast<off_t>(dataSize_));
+  void* dataPtr = mmap(nullptr, dataSize_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (dataPtr == MAP_FAILED) {
+    throw std::runtime_error("[policy_log::PolicyLogger] Could not map " + fileName + "!");
+  }
+  dataPtr_ = static_cast<uint8_t*>(dataPtr);
+
+  // touch all the pages such that logging does not cause page faults
+  std::memset(dataPtr_, 0, dataSize_);
+  for (size_t i = 0; i < numRecords_; i++) {
+    auto* recordPtr = new (dataPtr_ + HEADER_SIZE + i * recordStride_) RecordHeader;
+    recordPtr->sequence.store(0, std::memory_order_relaxed);
+    recordPtr->size = 0;
+  }
+
+  const FileHeader header{MAGIC, VERSION, recordCapacity_, numRecords_, recordStride_};
+  std::memcpy(dataPtr_, &header, sizeof(FileHeader));
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+PolicyLogger::~PolicyLogger() {
+  munmap(dataPtr_, dataSize_);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool PolicyLogger::write(const CommandData& command, const PrimalSolution& primalSolution, const PerformanceIndex& performanceIndices) {
+  const uint64_t policyIndex = numPolicies_ + 1;
+  auto* recordPtr = reinterpret_cast<RecordHeader*>(dataPtr_ + HEADER_SIZE + (policyIndex % numRecords_) * recordStride_);
+  recordPtr->sequence.store(2 * policyIndex - 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  // the policy is serialized directly into the record
+  Writer writer(reinterpret_cast<uint8_t*>(recordPtr) + sizeof(RecordHeader), recordCapacity_);
+  writer.write(policyIndex);
+  writer.write<int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+  writePerformanceIndex(writer, performanceIndices);
+  writeCommand(writer, command);
+  writePrimalSolution(writer, primalSolution);
+
+  if (!writer.ok()) {
+    // the record, which is the oldest one, is left empty
+    recordPtr->size = 0;
+    recordPtr->sequence.store(0, std::memory_order_release);
+    numDroppedPolicies_++;
+    return false;
+  }
+
+  recordPtr->size = writer.size();
+  recordPtr->sequence.store(2 * policyIndex, std::memory_order_release);
+  numPolicies_ = policyIndex;
+  return true;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PolicyLogger::bufferedPolicyReceived(const CommandData& commandBuffer, const PrimalSolution& primalSolutionBuffer,
+                                          const PerformanceIndex& performanceIndicesBuffer) {
+  std::ignore = write(commandBuffer, primalSolutionBuffer, performanceIndicesBuffer);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+LogReader::LogReader(const std::string& fileName) {
+  const int fd = open(fileName.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("[policy_log::LogReader] Could not open " + fileName + "!");
+  }
+  struct stat fileStat;
+  if (fstat(fd, &fileStat) != 0 || static_cast<size_t>(fileStat.st_size) < HEADER_SIZE) {
+    close(fd);
+    throw std::runtime_error("[policy_log::LogReader] " + fileName + " is not a policy log!");
+  }
+  dataSize_ = static_cast<size_t>(fileStat.st_size);
+  void* dataPtr = mmap(nullptr, dataSize_, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (dataPtr == MAP_FAILED) {
+    throw std::runtime_error("[policy_log::LogReader] Could not map " + fileName + "!");
+  }
+  dataPtr_ = static_cast<const uint8_t*>(dataPtr);
+
+  FileHeader header;
+  std::memcpy(&header, dataPtr_, sizeof(FileHeader));
+  if (header.magic != MAGIC || header.version != VERSION || header.recordStride < sizeof(RecordHeader) + header.recordCapacity ||
+      dataSize_ < HEADER_SIZE + header.numRecords * header.recordStride) {
+    munmap(const_cast<uint8_t*>(dataPtr_), dataSize_);
+    throw std::runtime_error("[policy_log::LogReader] " + fileName + " is not a policy log of version " + std::to_string(VERSION) + "!");
+  }
+  recordCapacity_ = header.recordCapacity;
+
+  // index the complete records in the order of logging
+  for (size_t i = 0; i < header.numRecords; i++) {
+    const size_t offset = HEADER_SIZE + i * header.recordStride;
+    const auto* recordPtr = reinterpret_cast<const RecordHeader*>(dataPtr_ + offset);
+    const uint64_t sequence = recordPtr->sequence.load(std::memory_order_acquire);
+    if (sequence > 0 && sequence % 2 == 0 && recordPtr->size <= header.recordCapacity) {
+      recordOffsets_.emplace_back(sequence, offset);
+    }
+  }
+  std::sort(recordOffsets_.begin(), recordOffsets_.end());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+LogReader::~LogReader() {
+  munmap(const_cast<uint8_t*>(dataPtr_), dataSize_);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+PolicyRecord LogReader::read(size_t index) const {
+  if (index >= recordOffsets_.size()) {
+    throw std::runtime_error("[policy_log::LogReader] The record " + std::to_string(index) + " is out of range!");
+  }
+  const auto sequence = recordOffsets_[index].first;
+  const auto* recordPtr = reinterpret_cast<const RecordHeader*>(dataPtr_ + recordOffsets_[index].second);
+
+  // the buffer is copied first such that a record which is overwritten by a running logger is detected
+  if (recordPtr->sequence.load(std::memory_order_acquire) != sequence) {
+    throw std::runtime_error("[policy_log::LogReader] The record " + std::to_string(index) + " has been overwritten!");
+  }
+  const auto* payloadPtr = reinterpret_cast<const uint8_t*>(recordPtr) + sizeof(RecordHeader);
+  const std::vector<uint8_t> buffer(payloadPtr, payloadPtr + std::min<size_t>(recordPtr->size, recordCapacity_));
+  std::atomic_thread_fence(std::memory_order_acquire);
+  if (recordPtr->sequence.load(std::memory_order_relaxed) != sequence) {
+    throw std::runtime_error("[policy_log::LogReader] The record " + std::to_string(index) + " has been overwritten!");
+  }
+
+  Reader reader(buffer.data(), buffer.size());
+  PolicyRecord record;
+  record.policyIndex = reader.read<uint64_t>();
+  record.wallTime = reader.read<int64_t>();
+  readPerformanceIndex(reader, record.performanceIndices);
+  readCommand(reader, record.command);
+  readPrimalSolution(reader, record.primalSolution);
+  return record;
+}
+
+}  // namespace policy_log
+}  // namespace ocs2
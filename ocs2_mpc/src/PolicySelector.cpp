@@ -0,0 +1,81 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_mpc/PolicySelector.h"
+
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+PolicySelector::PolicySelector(scalar_array_t sourceTimeMargins, scalar_t maxConstraintViolationSSE)
+    : sourceTimeMargins_(std::move(sourceTimeMargins)), maxConstraintViolationSSE_(maxConstraintViolationSSE) {
+  if (sourceTimeMargins_.empty()) {
+    throw std::runtime_error("[PolicySelector] There should be at least one policy source!");
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool PolicySelector::isValid(const PerformanceIndex& performanceIndices) const {
+  const scalar_t constraintViolationSSE = performanceIndices.dynamicsViolationSSE + performanceIndices.equalityConstraintsSSE;
+  return std::isfinite(performanceIndices.merit) && !std::isnan(constraintViolationSSE) &&
+         constraintViolationSSE <= maxConstraintViolationSSE_;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool PolicySelector::select(size_t source, const CommandData& command, const PerformanceIndex& performanceIndices) {
+  if (source >= sourceTimeMargins_.size()) {
+    throw std::runtime_error("[PolicySelector::select] The policy source " + std::to_string(source) + " is out of range!");
+  }
+
+  if (!isValid(performanceIndices)) {
+    return false;
+  }
+
+  // among the equally fresh policies, the one with the lower merit is preferred
+  const scalar_t freshness = command.mpcInitObservation_.time + sourceTimeMargins_[source];
+  if (isSelected_ && (freshness < selectedFreshness_ || (freshness == selectedFreshness_ && performanceIndices.merit > selectedMerit_))) {
+    return false;
+  }
+
+  isSelected_ = true;
+  selectedFreshness_ = freshness;
+  selectedMerit_ = performanceIndices.merit;
+  return true;
+}
+
+}  // namespace ocs2
@@ -1,3 +1,4 @@
+#include <ocs2_mpc/ClosedLoopSimulation.h>
 #include <ocs2_mpc/MPC_BASE.h>
 #include <ocs2_mpc/MPC_MRT_Interface.h>
 #include <ocs2_mpc/MPC_Settings.h>
@@ -0,0 +1,133 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+#include "ocs2_mpc/ObservationLatencyObserver.h"
+
+using namespace ocs2;
+
+namespace {
+CommandData getCommand(scalar_t observationTime) {
+  CommandData command;
+  command.mpcInitObservation_.time = observationTime;
+  return command;
+}
+
+void sleepFor(scalar_t duration) {
+  std::this_thread::sleep_for(std::chrono::duration<scalar_t>(duration));
+}
+}  // unnamed namespace
+
+TEST(testObservationLatencyObserver, statistics) {
+  ObservationLatencyObserver observer;
+  PrimalSolution primalSolution;
+
+  observer.observationSent(1.0);
+  sleepFor(0.01);
+  observer.modifyBufferedSolution(getCommand(1.0), primalSolution);
+  const auto firstStatistics = observer.getStatistics();
+  ASSERT_EQ(firstStatistics.numSamples, 1);
+  EXPECT_GE(firstStatistics.latest, 0.01);
+  EXPECT_DOUBLE_EQ(firstStatistics.average, firstStatistics.latest);
+  EXPECT_DOUBLE_EQ(firstStatistics.maximum, firstStatistics.latest);
+
+  observer.observationSent(2.0);
+  sleepFor(0.02);
+  observer.modifyBufferedSolution(getCommand(2.0), primalSolution);
+  const auto secondStatistics = observer.getStatistics();
+  ASSERT_EQ(secondStatistics.numSamples, 2);
+  EXPECT_GE(secondStatistics.latest, 0.02);
+  EXPECT_DOUBLE_EQ(secondStatistics.average, 0.5 * (firstStatistics.latest + secondStatistics.latest));
+  EXPECT_DOUBLE_EQ(secondStatistics.maximum, std::max(firstStatistics.latest, secondStatistics.latest));
+
+  // a policy of an observation which was not sent is not matched
+  observer.modifyBufferedSolution(getCommand(3.0), primalSolution);
+  EXPECT_EQ(observer.getStatistics().numSamples, 2);
+
+  observer.reset();
+  EXPECT_EQ(observer.getStatistics().numSamples, 0);
+  EXPECT_DOUBLE_EQ(observer.getStatistics().maximum, 0.0);
+}
+
+TEST(testObservationLatencyObserver, historyLength) {
+  ObservationLatencyObserver observer(2);
+  PrimalSolution primalSolution;
+
+  // the oldest observation is overwritten
+  observer.observationSent(1.0);
+  observer.observationSent(2.0);
+  observer.observationSent(3.0);
+  observer.modifyBufferedSolution(getCommand(1.0), primalSolution);
+  EXPECT_EQ(observer.getStatistics().numSamples, 0);
+  observer.modifyBufferedSolution(getCommand(2.0), primalSolution);
+  observer.modifyBufferedSolution(getCommand(3.0), primalSolution);
+  EXPECT_EQ(observer.getStatistics().numSamples, 2);
+}
+
+TEST(testObservationLatencyObserver, policyLatency) {
+  ObservationLatencyObserver observer;
+  PrimalSolution primalSolution;
+  PolicyLatency latency;
+
+  auto command = getCommand(1.0);
+  command.mpcTiming_.synchronizedModulesTime = 0.001;
+  command.mpcTiming_.runTime = 0.003;
+  command.mpcTiming_.processingTime = 0.004;
+
+  observer.observationSent(1.0);
+  sleepFor(0.005);
+  observer.modifyBufferedSolution(command, primalSolution);
+  EXPECT_FALSE(observer.policyActuated(latency));  // no active policy
+  sleepFor(0.005);
+  observer.modifyActiveSolution(command, primalSolution);
+  sleepFor(0.005);
+
+  // the stages add up to the end-to-end latency
+  ASSERT_TRUE(observer.policyActuated(latency));
+  EXPECT_DOUBLE_EQ(latency.mpcModules, 0.001);
+  EXPECT_DOUBLE_EQ(latency.mpcSolver, 0.002);
+  EXPECT_DOUBLE_EQ(latency.mpcOverhead, 0.001);
+  EXPECT_GE(latency.policyWaiting, 0.005);
+  EXPECT_GE(latency.evaluation, 0.005);
+  EXPECT_GE(latency.endToEnd, observer.getStatistics().latest + 0.01);
+  const scalar_t sumOfStages =
+      latency.mpcModules + latency.mpcSolver + latency.mpcOverhead + latency.transport + latency.policyWaiting + latency.evaluation;
+  EXPECT_NEAR(sumOfStages, latency.endToEnd, 1e-9);
+
+  // only the first actuation with a policy is measured
+  EXPECT_FALSE(observer.policyActuated(latency));
+
+  // a policy which is not matched to a sent observation is not measured
+  observer.modifyActiveSolution(getCommand(2.0), primalSolution);
+  EXPECT_FALSE(observer.policyActuated(latency));
+}
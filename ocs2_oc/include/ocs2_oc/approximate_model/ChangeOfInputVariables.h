@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <vector>
+
 #include <ocs2_core/Types.h>
 
 namespace ocs2 {
@@ -54,4 +56,53 @@ void changeOfInputVariables(ScalarFunctionQuadraticApproximation& quadraticAppro
 void changeOfInputVariables(VectorFunctionLinearApproximation& linearApproximation, const matrix_t& Pu, const matrix_t& Px = matrix_t(),
                             const vector_t& u0 = vector_t());
 
+/**
+ * Same as changeOfInputVariables(quadraticApproximation, Pu, Px, u0), but the result is written to an output, e.g. the stage data of the
+ * projected problem, instead of a copy of the input. The temporaries are kept in a per-thread workspace, such that no memory is allocated
+ * once the output and the workspace have their sizes.
+ *
+ * @param quadraticApproximation : Approximation to be adapted, it should not be the same object as the result.
+ * @param Pu : Matrix defining the range of \tilde{\delta u}
+ * @param Px : Matrix defining the range of \delta x, can be empty.
+ * @param u0 : Input offset, can be empty.
+ * @param [out] result : The adapted approximation.
+ */
+void changeOfInputVariables(const ScalarFunctionQuadraticApproximation& quadraticApproximation, const matrix_t& Pu, const matrix_t& Px,
+                            const vector_t& u0, ScalarFunctionQuadraticApproximation& result);
+
+/** Applies the change of input variables to a linear system, the result is written to an output. */
+void changeOfInputVariables(const VectorFunctionLinearApproximation& linearApproximation, const matrix_t& Pu, const matrix_t& Px,
+                            const vector_t& u0, VectorFunctionLinearApproximation& result);
+
+/**
+ * Checks whether Pu selects a subset of the inputs, i.e. every column of Pu is a distinct unit vector. The change of input variables
+ * then reduces to picking the rows and columns of the selected inputs, see the overloads with selectedInputs. The identity is the
+ * selection of all inputs in order.
+ *
+ * @param Pu : Matrix defining the range of \tilde{\delta u}
+ * @param [out] selectedInputs : The input selected by every column of Pu, only valid if true is returned.
+ * @return true if Pu is a selection of inputs.
+ */
+bool isInputSelection(const matrix_t& Pu, std::vector<int>& selectedInputs);
+
+/** Checks whether the selection takes all inputs in order, in which case Pu is the identity. */
+bool isIdentitySelection(const std::vector<int>& selectedInputs, int inputDim);
+
+/**
+ * Applies the change of input variables with the selection matrix Pu of selectedInputs, see isInputSelection(), without any matrix
+ * product with Pu. If the selection is the identity and Px and u0 are empty, the approximation is only copied.
+ *
+ * @param quadraticApproximation : Approximation to be adapted, it should not be the same object as the result.
+ * @param selectedInputs : The input selected by every column of Pu.
+ * @param Px : Matrix defining the range of \delta x, can be empty.
+ * @param u0 : Input offset, can be empty.
+ * @param [out] result : The adapted approximation.
+ */
+void changeOfInputVariables(const ScalarFunctionQuadraticApproximation& quadraticApproximation, const std::vector<int>& selectedInputs,
+                            const matrix_t& Px, const vector_t& u0, ScalarFunctionQuadraticApproximation& result);
+
+/** Applies the change of input variables with the selection matrix Pu of selectedInputs to a linear system. */
+void changeOfInputVariables(const VectorFunctionLinearApproximation& linearApproximation, const std::vector<int>& selectedInputs,
+                            const matrix_t& Px, const vector_t& u0, VectorFunctionLinearApproximation& result);
+
 }  // namespace ocs2
\ No newline at end of file
@@ -107,7 +107,20 @@ inline MultiplierCollection getIntermediateDualSolutionAtTime(const DualSolution
 }
 
 /**
- * Samples the intermediate dual solution at the given time array.
+ * Calculates in-place the intermediate dual solution at the given time. The memory of multiplierCollection is reused.
+ *
+ * @param [in] dualSolution: The dual solution
+ * @param [in] time: The inquiry time
+ * @param [out] multiplierCollection: The collection of multipliers associated to state/state-input, equality/inequality Lagrangian terms.
+ */
+inline void getIntermediateDualSolutionAtTime(const DualSolution& dualSolution, scalar_t time, MultiplierCollection& multiplierCollection) {
+  const auto indexAlpha = LinearInterpolation::timeSegment(time, dualSolution.timeTrajectory);
+  LinearInterpolation::interpolate(indexAlpha, dualSolution.intermediates, multiplierCollection);
+}
+
+/**
+ * Samples the intermediate dual solution at the given time array. The already allocated MultiplierCollections of the output are reused,
+ * such that resampling on the time grid of the next MPC iteration does not allocate if the constraint sizes are unchanged.
  *
  * @param [in] dualSolution: The dual solution
  * @param [in] timeTrajectory: The time array
@@ -116,10 +129,11 @@ inline MultiplierCollection getIntermediateDualSolutionAtTime(const DualSolution
 inline void sampleIntermediateDualSolution(const DualSolution& dualSolution, const scalar_array_t& timeTrajectory,
                                            std::vector<MultiplierCollection>& intermediateDualSolution) {
   // re-sample dual solution
-  intermediateDualSolution.clear();
-  intermediateDualSolution.reserve(timeTrajectory.size());
-  for (const auto& t : timeTrajectory) {
-    intermediateDualSolution.push_back(getIntermediateDualSolutionAtTime(dualSolution, t));
+  intermediateDualSolution.resize(timeTrajectory.size());
+  int cursor = 0;
+  for (size_t i = 0; i < timeTrajectory.size(); i++) {
+    const auto indexAlpha = LinearInterpolation::timeSegment(timeTrajectory[i], dualSolution.timeTrajectory, cursor);
+    LinearInterpolation::interpolate(indexAlpha, dualSolution.intermediates, intermediateDualSolution[i]);
   }
 }
 
@@ -52,7 +52,8 @@ struct PerformanceIndex {
   /** Sum of Squared Error (SSE) of equality constraints:
    * - Final: squared norm of violation in state equality constraints
    * - PreJumps: sum of squared norm of violation in state equality constraints
-   * - Intermediates: Integral of squared norm violation in state/state-input equality constraints
+   * - Intermediates: Integral of squared norm violation in state/state-input equality constraints, and in the hard inequality
+   *   constraints of the multiple shooting solver
    */
   scalar_t equalityConstraintsSSE = 0.0;
 
@@ -70,6 +71,9 @@ struct PerformanceIndex {
    */
   scalar_t inequalityLagrangian = 0.0;
 
+  /** Whether the solver stopped at its deadline (see SolverBase::setDeadline) before it converged. */
+  bool deadlineReached = false;
+
   /** Add performance indices */
   PerformanceIndex& operator+=(const PerformanceIndex& rhs) {
     this->merit += rhs.merit;
@@ -78,6 +82,7 @@ struct PerformanceIndex {
     this->equalityConstraintsSSE += rhs.equalityConstraintsSSE;
     this->equalityLagrangian += rhs.equalityLagrangian;
     this->inequalityLagrangian += rhs.inequalityLagrangian;
+    this->deadlineReached = this->deadlineReached || rhs.deadlineReached;
     return *this;
   }
 };
@@ -95,6 +100,7 @@ inline void swap(PerformanceIndex& lhs, PerformanceIndex& rhs) {
   std::swap(lhs.equalityConstraintsSSE, rhs.equalityConstraintsSSE);
   std::swap(lhs.equalityLagrangian, rhs.equalityLagrangian);
   std::swap(lhs.inequalityLagrangian, rhs.inequalityLagrangian);
+  std::swap(lhs.deadlineReached, rhs.deadlineReached);
 }
 
 inline std::ostream& operator<<(std::ostream& stream, const PerformanceIndex& performanceIndex) {
@@ -114,6 +120,11 @@ inline std::ostream& operator<<(std::ostream& stream, const PerformanceIndex& pe
   stream << "Equality Lagrangian:        " << std::setw(tabSpace) << performanceIndex.equalityLagrangian;
   stream << "Inequality Lagrangian:      " << std::setw(tabSpace) << performanceIndex.inequalityLagrangian;
 
+  if (performanceIndex.deadlineReached) {
+    stream << '\n' << std::setw(indentation) << "";
+    stream << "Deadline reached";
+  }
+
   return stream;
 }
 
@@ -35,6 +35,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/Types.h>
 #include <ocs2_core/augmented_lagrangian/StateAugmentedLagrangianCollection.h>
 #include <ocs2_core/augmented_lagrangian/StateInputAugmentedLagrangianCollection.h>
+#include <ocs2_core/constraint/BoxConstraint.h>
 #include <ocs2_core/constraint/StateConstraintCollection.h>
 #include <ocs2_core/constraint/StateInputConstraintCollection.h>
 #include <ocs2_core/cost/StateCostCollection.h>
@@ -75,6 +76,11 @@ struct OptimalControlProblem {
   std::unique_ptr<StateConstraintCollection> preJumpEqualityConstraintPtr;
   /** Final equality constraints */
   std::unique_ptr<StateConstraintCollection> finalEqualityConstraintPtr;
+  /** Intermediate inequality constraints h(x, u) >= 0, only supported by the solvers which impose them as hard QP constraints (multiple
+   * shooting), otherwise use the inequality Lagrangians or soft constraints */
+  std::unique_ptr<StateInputConstraintCollection> inequalityConstraintPtr;
+  /** Hard box constraints on states and inputs, only supported by the solvers which handle simple bounds natively (multiple shooting) */
+  std::unique_ptr<BoxConstraint> boxConstraintPtr;
 
   /* Lagrangians */
   /** Lagrangian for intermediate equality constraints */
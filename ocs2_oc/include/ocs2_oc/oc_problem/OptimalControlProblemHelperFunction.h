@@ -31,6 +31,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/model_data/Metrics.h>
 #include <ocs2_core/model_data/Multiplier.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
 
 #include "ocs2_oc/oc_data/DualSolution.h"
 #include "ocs2_oc/oc_data/PrimalSolution.h"
@@ -39,6 +40,33 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace ocs2 {
 
+/**
+ * Caches the activity of the terms of all the collections of the optimal control problem for each interval of the mode schedule, such
+ * that isActive() of the terms is not called on every evaluation. The activity of a term is assumed to only change at the event times.
+ *
+ * @param [in] modeSchedule : The mode schedule.
+ * @param [in, out] ocp : The optimal control problem.
+ */
+void cacheTermActivity(const ModeSchedule& modeSchedule, OptimalControlProblem& ocp);
+
+/**
+ * Checks whether the optimal control problem has Lagrangian terms, i.e. terms whose multipliers are updated by the solver.
+ *
+ * @param [in] ocp: The optimal control problem.
+ * @return true if any of the Lagrangian collections is not empty.
+ */
+bool hasLagrangianTerms(const OptimalControlProblem& ocp);
+
+/**
+ * Checks whether the optimal control problem is linear-quadratic: the dynamics are linear (see SystemDynamicsBase::isLinear()), all the
+ * cost and soft constraint terms have a constant Hessian (see StateInputCost::isHessianConstant()), and there are no equality, inequality,
+ * or box constraints nor Lagrangian terms. The LQ approximation of such a problem is exact, hence it is solved by a single QP.
+ *
+ * @param [in] ocp : The optimal control problem.
+ * @return Whether the problem is linear-quadratic.
+ */
+bool isLinearQuadratic(const OptimalControlProblem& ocp);
+
 /**
  * Initializes the dual solution based on the cached dual solution. It will use interpolation if cachedDualSolution has any component
  * in the same mode otherwise it will use the Lagrangian initialization method of ocp.
@@ -91,6 +119,21 @@ void initializeIntermediateMultiplierCollection(const OptimalControlProblem& ocp
 void updateDualSolution(const OptimalControlProblem& ocp, const PrimalSolution& primalSolution, ProblemMetrics& problemMetrics,
                         DualSolutionRef dualSolution);
 
+/**
+ * Same as updateDualSolution above, but the updates of the intermediate nodes are distributed over the threads of the pool. The ocp is
+ * shared among the threads since the Lagrangian update methods are required to be stateless.
+ *
+ * @param [in] ocp : A const reference to the optimal control problem.
+ * @param [in] primalSolution : The primal solution.
+ * @param [in, out] problemMetrics : The problem metric. Its penalties will be updated based on the update of dualSolution.
+ * @param [out] dualSolution : The updated dual solution.
+ * @param [in] threadPool : The thread pool.
+ * @param [in] maxNumThreads : The maximum number of threads working on the update, including the calling thread (see
+ *                             ThreadPool::parallelFor).
+ */
+void updateDualSolution(const OptimalControlProblem& ocp, const PrimalSolution& primalSolution, ProblemMetrics& problemMetrics,
+                        DualSolutionRef dualSolution, ThreadPool& threadPool, size_t maxNumThreads = 0);
+
 /**
  * Updates in-place final MultiplierCollection for equality and inequality Lagrangians.
  * Moreover it also updates the penalties of MetricsCollection based on the update of multipliers.
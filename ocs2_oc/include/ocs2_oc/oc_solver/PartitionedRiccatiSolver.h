@@ -0,0 +1,138 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+
+#pragma once
+
+#include <vector>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
+
+namespace ocs2 {
+
+/**
+ * This class solves unconstrained discrete linear quadratic optimal control problems with a Riccati recursion that is parallelized over
+ * partitions of the horizon:
+ *
+ *  min  0.5 x_N' Q_N x_N + q_N' x_N + sum_k [ 0.5 x_k' Q_k x_k + u_k' S_k x_k + 0.5 u_k' R_k u_k + q_k' x_k + r_k' u_k ]
+ *  s.t. x_{k+1} = A_k x_k + B_k u_k + b_k,  x_0 given.
+ *
+ * Every partition, except for the first one, first computes its cost-to-go as a function of the multiplier of the state at its end, which
+ * does not depend on the other partitions. A sequential sweep over the partition boundaries then recovers the exact cost-to-go at the
+ * boundaries, from which all partitions, except for the last one, compute their Riccati quantities in parallel. The result is the same as
+ * that of the sequential Riccati recursion, at the cost of about twice the computations of the sequential recursion in the inner
+ * partitions. Parallel threads are therefore only beneficial for three or more partitions.
+ *
+ * The dimensions of the states and inputs may change over the horizon. Stages without inputs, e.g., at events, are supported.
+ */
+class PartitionedRiccatiSolver {
+ public:
+  /**
+   * Constructor
+   * @param [in] numPartitions : Number of partitions of the horizon. It is limited to the number of stages of the problem.
+   * @param [in] maxNumThreads : Maximum number of threads working on the partitions, including the calling thread. Zero means all
+   * threads of the thread pool, see ThreadPool::parallelFor().
+   */
+  explicit PartitionedRiccatiSolver(size_t numPartitions = 1, size_t maxNumThreads = 0);
+
+  /**
+   * Solves a discrete linear quadratic optimal control problem.
+   * The problem should be consistently defined in absolute or delta decision variables in x and u.
+   *
+   * @param [in] x0 : Initial state (deviation).
+   * @param [in] dynamics : Linear approximation of the discrete dynamics at the N stages.
+   * @param [in] cost : Quadratic approximation of the cost at the N stages and at the final node. The input terms of the final node are
+   * ignored. The cost Hessians with respect to the inputs need to be positive definite.
+   * @param [in] threadPool : The thread pool which runs the partitions in parallel together with the calling thread.
+   * @param [out] stateTrajectory : Solution state (deviation) trajectory.
+   * @param [out] inputTrajectory : Solution input (deviation) trajectory.
+   */
+  void solve(const vector_t& x0, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+             const std::vector<ScalarFunctionQuadraticApproximation>& cost, ThreadPool& threadPool, vector_array_t& stateTrajectory,
+             vector_array_t& inputTrajectory);
+
+  /**
+   * Return the Riccati cost-to-go for the previously solved problem.
+   *
+   * Cost-to-go at a node is: V_k(x) = 0.5 * x' * dfdxx * x + x' * dfdx + f
+   * The value for f is set to 0.0, it is not needed for the solution.
+   *
+   * @return Sequence of the N + 1 quadratic cost-to-go's.
+   */
+  const std::vector<ScalarFunctionQuadraticApproximation>& getRiccatiCostToGo() const { return costToGo_; }
+
+  /** Return the sequence of N feedback matrices K of the optimal solution u = K x + k for the previously solved problem. */
+  const matrix_array_t& getRiccatiFeedback() const { return feedback_; }
+
+  /** Return the sequence of N feedforward vectors k of the optimal solution u = K x + k for the previously solved problem. */
+  const vector_array_t& getRiccatiFeedforward() const { return feedforward_; }
+
+  /** Number of partitions of the horizon. */
+  size_t getNumPartitions() const { return numPartitions_; }
+
+ private:
+  /**
+   * The cost-to-go at the start of a partition, as a function of the start state x and of the multiplier l of the state at the end:
+   *  V(x, l) = 0.5 x' Phi x + x' (phi + Gamma l) - 0.5 l' Theta l + theta' l
+   */
+  struct Partition {
+    int start;  // first stage
+    int end;    // past-the-end stage, i.e., the node at the end of the partition
+    matrix_t Phi;
+    vector_t phi;
+    matrix_t Gamma;
+    matrix_t Theta;
+    vector_t theta;
+    ScalarFunctionQuadraticApproximation finalCostToGo;  // exact cost-to-go at the end node
+  };
+
+  /**
+   * Riccati recursion over the stages of a partition, starting from the given cost-to-go at its end node. The cost-to-go, feedback and
+   * feedforward are written for the stages of the partition only, not for the end node, such that the partitions do not share any output.
+   * If parametricPtr is not null, the cost-to-go as a function of the multiplier of the end state is additionally computed in it. The
+   * given final cost-to-go then needs to be zero.
+   */
+  void backwardSweep(const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                     const std::vector<ScalarFunctionQuadraticApproximation>& cost, int start, int end,
+                     const ScalarFunctionQuadraticApproximation& finalCostToGo, Partition* parametricPtr);
+
+  /** Combines the parametric cost-to-go of a partition with the exact cost-to-go at its end node into the cost-to-go at its start node. */
+  static void combine(const Partition& partition, ScalarFunctionQuadraticApproximation& startCostToGo);
+
+  size_t numPartitions_;
+  size_t maxNumThreads_;
+  std::vector<Partition> partitions_;
+
+  std::vector<ScalarFunctionQuadraticApproximation> costToGo_;
+  matrix_array_t feedback_;
+  vector_array_t feedforward_;
+};
+
+}  // namespace ocs2
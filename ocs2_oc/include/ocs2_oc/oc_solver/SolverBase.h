@@ -29,6 +29,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <chrono>
 #include <iostream>
 #include <memory>
 #include <mutex>
@@ -36,6 +37,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/Types.h>
 #include <ocs2_core/control/ControllerBase.h>
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_core/misc/Tracer.h>
 
 #include "ocs2_oc/oc_data/DualSolution.h"
 #include "ocs2_oc/oc_data/PerformanceIndex.h"
@@ -48,6 +51,21 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace ocs2 {
 
+/** The statistics of a single run of the solver */
+struct SolverRunStatistics {
+  /** The number of iterations of the run. */
+  size_t numIterations = 0;
+  /** The number of the candidate steps which are evaluated by the search strategy (e.g. line-search trials) over all iterations. */
+  size_t numLineSearchTrials = 0;
+  /** The status of the QP solver of the latest iteration, where zero is success. Zero for the solvers without a QP solver. */
+  int qpStatus = 0;
+  /**
+   * The wall time in seconds of the reference manager, the synchronized modules, and the augmented Lagrangian observers before and after
+   * the solver run.
+   */
+  scalar_t synchronizedModulesTime = 0.0;
+};
+
 /**
  * This class is an interface class for the single-thread and multi-thread SLQ.
  */
@@ -102,6 +120,18 @@ class SolverBase {
    */
   void run(scalar_t initTime, const vector_t& initState, scalar_t finalTime, const PrimalSolution& primalSolution);
 
+  /**
+   * Sets the primal and dual solutions which warm start the next call of run(initTime, initState, finalTime), e.g. the solutions restored
+   * from a checkpoint after a restart (see mpc_recording::restoreCheckpoint). They are shifted in time such that they start at the
+   * initial time of that run. The warm start is only used once and it is kept by reset(), such that it survives the reset of the MPC.
+   * @warning This method should not be called concurrently with run().
+   *
+   * @param [in] primalSolution: The primal solution to initialize the solver with.
+   * @param [in] dualSolution: The dual solution to initialize the solver with. It is ignored by the solvers which do not warm start
+   * their multipliers.
+   */
+  void setWarmStart(PrimalSolution primalSolution, DualSolution dualSolution);
+
   /**
    * Sets the ReferenceManager which manages both ModeSchedule and TargetTrajectories. This module updates before SynchronizedModules.
    */
@@ -141,6 +171,34 @@ class SolverBase {
     augmentedLagrangianObservers_.push_back(std::move(observerModule));
   }
 
+  /**
+   * Sets a wall-clock deadline for the subsequent runs. Once the deadline has passed, the solver finishes its current iteration and
+   * returns the best solution found so far, which is flagged by PerformanceIndex::deadlineReached. At least one iteration is always
+   * performed such that a valid policy exists.
+   */
+  void setDeadline(std::chrono::steady_clock::time_point deadline) { deadline_ = deadline; }
+
+  /** Removes the wall-clock deadline. */
+  void clearDeadline() { deadline_ = std::chrono::steady_clock::time_point::max(); }
+
+  /** Gets the wall-clock deadline. */
+  std::chrono::steady_clock::time_point getDeadline() const { return deadline_; }
+
+  /** Whether the wall-clock deadline has passed. */
+  bool isDeadlineReached() const { return std::chrono::steady_clock::now() >= deadline_; }
+
+  /**
+   * Sets the tracer which records the timeline of the solver runs (see benchmark::Tracer). A null pointer disables the tracing. Solvers
+   * which profile their stages override this method to record the stages as well. It must not be called while the solver runs.
+   */
+  virtual void setTracer(std::shared_ptr<benchmark::Tracer> tracerPtr) { tracerPtr_ = std::move(tracerPtr); }
+
+  /** Gets the tracer, or null if the tracing is disabled. */
+  benchmark::Tracer* getTracer() const { return tracerPtr_.get(); }
+
+  /** Gets the profiler of the solver stages, or null if the solver does not profile its stages. The profiler is cleared by reset(). */
+  virtual const benchmark::Profiler* getProfiler() const { return nullptr; }
+
   /**
    * @brief Returns a const reference to the definition of optimal control problem.
    *
@@ -162,6 +220,9 @@ class SolverBase {
    */
   virtual size_t getNumIterations() const = 0;
 
+  /** Gets the statistics of the latest run. */
+  const SolverRunStatistics& getRunStatistics() const { return runStatistics_; }
+
   /**
    * Returns the history of the cost, merit function and ISEs of constraints for the iterations os the optimized trajectory.
    *
@@ -200,7 +261,9 @@ class SolverBase {
   virtual const DualSolution& getDualSolution() const = 0;
 
   /**
-   * @brief Returns the optimized value of the Metrics.
+   * @brief Returns the optimized value of the Metrics. The solvers only compute the metrics of the solution on demand, i.e. on the
+   * first call after a run, since their per-term values are not required for the optimization. The result is cached, and concurrent
+   * calls are safe as long as they are not concurrent with run().
    *
    * @return: The solution's metrics.
    */
@@ -254,6 +317,10 @@ class SolverBase {
    */
   void printString(const std::string& text) const;
 
+ protected:
+  /** The statistics of the current run which are filled in by the solver. They are cleared before each run. */
+  SolverRunStatistics& runStatistics() { return runStatistics_; }
+
  private:
   virtual void runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime) = 0;
 
@@ -261,6 +328,11 @@ class SolverBase {
 
   virtual void runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime, const PrimalSolution& primalSolution) = 0;
 
+  virtual void runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime, const PrimalSolution& primalSolution,
+                       const DualSolution& dualSolution) {
+    runImpl(initTime, initState, finalTime, primalSolution);
+  }
+
   void preRun(scalar_t initTime, const vector_t& initState, scalar_t finalTime);
 
   void postRun();
@@ -272,6 +344,14 @@ class SolverBase {
   std::shared_ptr<ReferenceManagerInterface> referenceManagerPtr_;  // this pointer cannot be nullptr
   std::vector<std::shared_ptr<SolverSynchronizedModule>> synchronizedModules_;
   std::vector<std::unique_ptr<AugmentedLagrangianObserver>> augmentedLagrangianObservers_;
+  std::chrono::steady_clock::time_point deadline_ = std::chrono::steady_clock::time_point::max();
+  std::shared_ptr<benchmark::Tracer> tracerPtr_;
+  SolverRunStatistics runStatistics_;
+  size_t initNumIterations_ = 0;
+
+  bool hasWarmStart_ = false;
+  PrimalSolution warmStartPrimalSolution_;
+  DualSolution warmStartDualSolution_;
 };
 
 }  // namespace ocs2
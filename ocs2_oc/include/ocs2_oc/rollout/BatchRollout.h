@@ -0,0 +1,93 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/control/ControllerBase.h>
+#include <ocs2_core/reference/ModeSchedule.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
+
+#include "ocs2_oc/oc_data/PrimalSolution.h"
+#include "ocs2_oc/rollout/RolloutBase.h"
+
+namespace ocs2 {
+
+/**
+ * This class rolls out a batch of controllers concurrently on a thread pool, e.g. to compare several candidate initial guesses.
+ * The rollout is cloned once per thread and the trajectories of each rollout are written into a designated primal solution whose
+ * memory is reused between the calls.
+ */
+class BatchRollout {
+ public:
+  /** Merit of a rolled out primal solution. The lower the better. */
+  using merit_function_t = std::function<scalar_t(const PrimalSolution&)>;
+
+  /**
+   * Constructor.
+   *
+   * @param [in] rollout: The rollout which is cloned for each thread.
+   * @param [in] threadPool: The thread pool. It should outlive this class.
+   * @param [in] maxNumThreads: The maximum number of threads working on a batch, including the calling thread. Zero means
+   *                            threadPool.numThreads() + 1.
+   */
+  BatchRollout(const RolloutBase& rollout, ThreadPool& threadPool, size_t maxNumThreads = 0);
+
+  /**
+   * Rolls out the given controllers from the same initial state. A rollout which throws an exception gets an infinite merit.
+   *
+   * @param [in] initTime: The initial time.
+   * @param [in] initState: The initial state.
+   * @param [in] finalTime: The final time.
+   * @param [in] controllers: The controllers of the batch. A controller should not appear twice in the batch.
+   * @param [in] modeSchedule: The mode schedule of all rollouts.
+   * @param [in] meritFunction: The merit of a rollout. It is called concurrently and should therefore be thread-safe.
+   * @param [out] primalSolutions: The primal solution of each controller. The controllerPtr_ field is not modified.
+   * @return The index of the rollout with the lowest merit.
+   */
+  size_t run(scalar_t initTime, const vector_t& initState, scalar_t finalTime, const std::vector<ControllerBase*>& controllers,
+             const ModeSchedule& modeSchedule, const merit_function_t& meritFunction, std::vector<PrimalSolution>& primalSolutions);
+
+  /** Returns the merits of the last batch. */
+  const scalar_array_t& getMerits() const { return merits_; }
+
+  /** Returns the number of threads working on a batch. */
+  size_t numThreads() const { return rolloutPtrs_.size(); }
+
+ private:
+  ThreadPool& threadPool_;
+  std::vector<std::unique_ptr<RolloutBase>> rolloutPtrs_;
+  scalar_array_t merits_;
+};
+
+}  // namespace ocs2
@@ -108,6 +108,24 @@ class RolloutBase {
                        ModeSchedule& modeSchedule, scalar_array_t& timeTrajectory, size_array_t& postEventIndices,
                        vector_array_t& stateTrajectory, vector_array_t& inputTrajectory) = 0;
 
+  /**
+   * Lightweight forward integration of the system dynamics which only returns the states at the given query times, e.g. for the
+   * MRT and for visualization. Neither the input trajectory is reconstructed nor the numerical stability checked.
+   *
+   * @note The default implementation runs the full rollout up to the last query time into internal buffers and interpolates the
+   *       states at the query times. The derived classes can override it with a cheaper integration.
+   *
+   * @param [in] initTime: The initial time.
+   * @param [in] initState: The initial state.
+   * @param [in] controller: control policy.
+   * @param [in, out] modeSchedule: The mode schedule, see run().
+   * @param [in] queryTimes: The query times in increasing order, not less than initTime. A query at an event time returns the
+   *                         pre-event state.
+   * @param [out] queryStates: The states at the query times. The memory is reused between the calls.
+   */
+  virtual void runAtQueryTimes(scalar_t initTime, const vector_t& initState, ControllerBase* controller, ModeSchedule& modeSchedule,
+                               const scalar_array_t& queryTimes, vector_array_t& queryStates);
+
   /**
    * Prints out the rollout.
    *
@@ -129,6 +147,12 @@ class RolloutBase {
                                const vector_array_t& stateTrajectory, const vector_array_t& inputTrajectory) const;
 
   const rollout::Settings rolloutSettings_;
+
+  // trajectory buffers which are reused by runAtQueryTimes()
+  scalar_array_t timeTrajectoryBuffer_;
+  size_array_t postEventIndicesBuffer_;
+  vector_array_t stateTrajectoryBuffer_;
+  vector_array_t inputTrajectoryBuffer_;
 };
 
 }  // namespace ocs2
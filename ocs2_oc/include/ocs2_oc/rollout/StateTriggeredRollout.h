@@ -69,6 +69,22 @@ class StateTriggeredRollout : public RolloutBase {
                vector_array_t& inputTrajectory) override;
 
  private:
+  /**
+   * Locates the guard crossing within an integration step on the cubic Hermite interpolation of the state. This avoids the
+   * re-integration of the step for each iteration of the root-finding method.
+   *
+   * @param [in] eventID: The index of the triggered guard surface.
+   * @param [in] t0: The time before the crossing.
+   * @param [in] x0: The state before the crossing.
+   * @param [in] guard0: The guard value before the crossing.
+   * @param [in] t1: The time after the crossing.
+   * @param [in] x1: The state after the crossing.
+   * @param [in] guard1: The guard value after the crossing.
+   * @return The estimated crossing time.
+   */
+  scalar_t locateEventOnStep(size_t eventID, scalar_t t0, const vector_t& x0, scalar_t guard0, scalar_t t1, const vector_t& x1,
+                             scalar_t guard1);
+
   std::unique_ptr<PreComputation> preCompPtr_;
   std::unique_ptr<ControlledSystemBase> systemDynamicsPtr_;
 
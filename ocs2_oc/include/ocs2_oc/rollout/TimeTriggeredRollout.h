@@ -68,6 +68,13 @@ class TimeTriggeredRollout : public RolloutBase {
                scalar_array_t& timeTrajectory, size_array_t& postEventIndices, vector_array_t& stateTrajectory,
                vector_array_t& inputTrajectory) override;
 
+  /**
+   * Integrates the system only to the query times and the event times, see RolloutBase::runAtQueryTimes().
+   * @note The integrator observes the query times directly, therefore no intermediate states are stored.
+   */
+  void runAtQueryTimes(scalar_t initTime, const vector_t& initState, ControllerBase* controller, ModeSchedule& modeSchedule,
+                       const scalar_array_t& queryTimes, vector_array_t& queryStates) override;
+
  private:
   std::unique_ptr<PreComputation> preCompPtr_;
   std::unique_ptr<ControlledSystemBase> systemDynamicsPtr_;
@@ -0,0 +1,111 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include <ocs2_core/initialization/Initializer.h>
+#include <ocs2_core/misc/MultiLayerPerceptron.h>
+#include <ocs2_core/reference/ModeSchedule.h>
+#include <ocs2_core/reference/TargetTrajectories.h>
+
+#include "ocs2_oc/synchronized_module/SolverSynchronizedModule.h"
+
+namespace ocs2 {
+
+/**
+ * An Initializer which evaluates a network that is trained offline to predict the solution from the state, the reference, and the mode.
+ * The input features and the outputs of the network are
+ *    features = [x; x_ref(t); u_ref(t); mode(t)]
+ *    output = [u; dx/dt]
+ * and the next state is given by x + (nextTime - time) * dx/dt. The reference of the features is zero where the target trajectories are
+ * empty or do not contain an input. The fallback initializer is used before the first reference is available.
+ *
+ * The reference and the mode schedule are provided by the synchronized module which is returned by getSynchronizedModule(). It must be
+ * added to the solver, e.g.:
+ *    LearnedInitializer initializer(MultiLayerPerceptron::load(networkFile), stateDim, inputDim, DefaultInitializer(inputDim));
+ *    GaussNewtonDDP solver(..., initializer);  // or MultipleShootingSolver
+ *    solver.addSynchronizedModule(initializer.getSynchronizedModule(dataFile));
+ * If a data file name is given, the module also appends the features and outputs of each solution to this file, one sample per row and
+ * separated by spaces, which serves as the training data of the network.
+ */
+class LearnedInitializer final : public Initializer {
+ public:
+  /**
+   * Constructor
+   * @param [in] network: The network with 2 * stateDim + inputDim + 1 inputs and inputDim + stateDim outputs.
+   * @param [in] stateDim: The state dimension.
+   * @param [in] inputDim: The input dimension.
+   * @param [in] fallbackInitializer: The initializer which is used before the first reference is available.
+   */
+  LearnedInitializer(MultiLayerPerceptron network, size_t stateDim, size_t inputDim, const Initializer& fallbackInitializer);
+
+  ~LearnedInitializer() override = default;
+
+  LearnedInitializer* clone() const override { return new LearnedInitializer(*this); }
+
+  void compute(scalar_t time, const vector_t& state, scalar_t nextTime, vector_t& input, vector_t& nextState) override;
+
+  /**
+   * Returns the synchronized module which updates the reference of this initializer and all its clones.
+   * @param [in] dataFileName: If not empty, the training data is appended to this file after each solver run.
+   */
+  std::shared_ptr<SolverSynchronizedModule> getSynchronizedModule(const std::string& dataFileName = "") const;
+
+  /** The reference of the current solver run. */
+  struct Reference {
+    bool valid = false;
+    TargetTrajectories targetTrajectories;
+    ModeSchedule modeSchedule;
+  };
+
+  /**
+   * Computes the input features of the network.
+   * @param [in] reference: The reference of the solver run.
+   * @param [in] time: The time.
+   * @param [in] state: The state.
+   * @param [in] inputDim: The input dimension.
+   * @param [out] features: The input features of the network.
+   */
+  static void computeFeatures(const Reference& reference, scalar_t time, const vector_t& state, size_t inputDim, vector_t& features);
+
+ private:
+  LearnedInitializer(const LearnedInitializer& other);
+
+  MultiLayerPerceptron network_;
+  const size_t stateDim_;
+  const size_t inputDim_;
+  std::unique_ptr<Initializer> fallbackInitializerPtr_;
+  std::shared_ptr<Reference> referencePtr_;
+  vector_t features_;
+};
+
+}  // namespace ocs2
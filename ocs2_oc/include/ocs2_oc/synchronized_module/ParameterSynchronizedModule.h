@@ -0,0 +1,62 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <ocs2_core/thread_support/ParameterBuffer.h>
+
+#include "ocs2_oc/synchronized_module/SolverSynchronizedModule.h"
+
+namespace ocs2 {
+
+/**
+ * Activates the new parameters of the cost and constraint terms right before the solver runs. Since the parameter buffers are shared by
+ * the clones of the terms, the parameters of all worker threads are updated without reconstructing the optimal control problem.
+ */
+class ParameterSynchronizedModule : public SolverSynchronizedModule {
+ public:
+  ParameterSynchronizedModule() = default;
+  explicit ParameterSynchronizedModule(std::vector<std::shared_ptr<ParameterBuffer>> parameterBufferPtrArray);
+  ~ParameterSynchronizedModule() override = default;
+
+  void preSolverRun(scalar_t initTime, scalar_t finalTime, const vector_t& initState,
+                    const ReferenceManagerInterface& referenceManager) override;
+
+  void postSolverRun(const PrimalSolution& primalSolution) override {}
+
+  void add(std::shared_ptr<ParameterBuffer> parameterBufferPtr) { parameterBufferPtrArray_.push_back(std::move(parameterBufferPtr)); }
+
+ private:
+  std::vector<std::shared_ptr<ParameterBuffer>> parameterBufferPtrArray_;
+};
+
+}  // namespace ocs2
@@ -29,7 +29,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
-#include "ocs2_core/thread_support/BufferedValue.h"
+#include <mutex>
+
+#include "ocs2_core/thread_support/PooledBufferedValue.h"
 #include "ocs2_oc/synchronized_module/ReferenceManagerInterface.h"
 
 namespace ocs2 {
@@ -51,13 +53,16 @@ class ReferenceManager : public ReferenceManagerInterface {
   void setModeSchedule(const ModeSchedule& modeSchedule) override { modeSchedule_.setBuffer(modeSchedule); }
   void setModeSchedule(ModeSchedule&& modeSchedule) override { modeSchedule_.setBuffer(std::move(modeSchedule)); }
 
+  /**
+   * Lookup of the active ModeSchedule, which is updated once per solver run. Terms that query the mode at every node should use it
+   * instead of searching the event times of getModeSchedule() on each call.
+   */
+  const ModeScheduleLookup& getModeScheduleLookup() const { return modeScheduleLookup_; }
+
   const TargetTrajectories& getTargetTrajectories() const override { return targetTrajectories_.get(); }
-  void setTargetTrajectories(const TargetTrajectories& targetTrajectories) override {
-    return targetTrajectories_.setBuffer(targetTrajectories);
-  }
-  void setTargetTrajectories(TargetTrajectories&& targetTrajectories) override {
-    return targetTrajectories_.setBuffer(std::move(targetTrajectories));
-  }
+  void setTargetTrajectories(const TargetTrajectories& targetTrajectories) override;
+  void setTargetTrajectories(TargetTrajectories&& targetTrajectories) override;
+  void appendTargetTrajectories(const TargetTrajectories& targetTrajectoriesSegment) override;
 
  protected:
   /**
@@ -75,8 +80,13 @@ class ReferenceManager : public ReferenceManagerInterface {
                                 ModeSchedule& modeSchedule) {}
 
  private:
-  BufferedValue<ModeSchedule> modeSchedule_;
-  BufferedValue<TargetTrajectories> targetTrajectories_;
+  PooledBufferedValue<ModeSchedule> modeSchedule_;
+  ModeScheduleLookup modeScheduleLookup_;
+  PooledBufferedValue<TargetTrajectories> targetTrajectories_;
+
+  // the appended segments which are not merged yet
+  std::mutex appendedSegmentsMutex_;
+  TargetTrajectories appendedSegments_;
 };
 
 }  // namespace ocs2
@@ -63,6 +63,9 @@ class ReferenceManagerDecorator : public ReferenceManagerInterface {
   void setTargetTrajectories(TargetTrajectories&& targetTrajectories) override {
     referenceManagerPtr_->setTargetTrajectories(std::move(targetTrajectories));
   }
+  void appendTargetTrajectories(const TargetTrajectories& targetTrajectoriesSegment) override {
+    referenceManagerPtr_->appendTargetTrajectories(targetTrajectoriesSegment);
+  }
 
  protected:
   std::shared_ptr<ReferenceManagerInterface> referenceManagerPtr_;
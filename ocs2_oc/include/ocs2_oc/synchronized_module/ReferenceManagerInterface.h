@@ -90,6 +90,14 @@ class ReferenceManagerInterface {
    * @note: This method must be thread safe.
    */
   virtual void setTargetTrajectories(TargetTrajectories&& targetTrajectories) = 0;
+
+  /**
+   * Appends a segment to the TargetTrajectories (see TargetTrajectories::append). The segments are merged into the active
+   * TargetTrajectories once preSolverRun() is called, after which the elapsed points are removed. A later call of
+   * setTargetTrajectories() discards the segments which have not been merged yet.
+   * @note: This method must be thread safe.
+   */
+  virtual void appendTargetTrajectories(const TargetTrajectories& targetTrajectoriesSegment) = 0;
 };
 
 }  // namespace ocs2
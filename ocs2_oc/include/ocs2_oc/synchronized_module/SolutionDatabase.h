@@ -0,0 +1,176 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <functional>
+#include <iosfwd>
+#include <vector>
+
+#include <ocs2_core/reference/TargetTrajectories.h>
+
+#include "ocs2_oc/oc_data/DualSolution.h"
+#include "ocs2_oc/oc_data/PrimalSolution.h"
+#include "ocs2_oc/oc_solver/SolverBase.h"
+#include "ocs2_oc/synchronized_module/SolverSynchronizedModule.h"
+
+namespace ocs2 {
+
+/** The settings of the SolutionDatabase. */
+struct SolutionDatabaseSettings {
+  /** The maximum number of stored solutions. Once it is reached, the oldest solution is replaced. */
+  size_t maxNumSolutions = 100;
+  /** The maximum feature distance of a stored solution to warm start a run. */
+  scalar_t maxQueryDistance = 1.0;
+  /** A converged solution replaces the stored solution closer than this feature distance instead of being added. */
+  scalar_t minInsertDistance = 0.05;
+  /** The feature distance to the previous run above which its shifted solution is considered a poor guess, e.g. a target jump. */
+  scalar_t jumpDistance = 0.5;
+  /** The maximum sum of the dynamics and equality constraint SSEs of a converged solution. */
+  scalar_t convergenceTolerance = 1e-3;
+};
+
+/**
+ * A database of converged solutions which warm starts the solver with the solution of the nearest stored problem, for the tasks where
+ * similar problems recur, e.g. repeated pick-and-place motions. The problems are compared by a compact feature of the initial state
+ * and the target, which is by default [x0; x_ref(finalTime)], and the nearest neighbour is found by a KD-tree.
+ *
+ * The database is a synchronized module of the solver:
+ *    auto databasePtr = std::make_shared<SolutionDatabase>(solver, SolutionDatabaseSettings());
+ *    solver.addSynchronizedModule(databasePtr);
+ * Before a run, the database is queried if the solver has no previous solution (e.g. after a reset) or if the feature jumped since the
+ * previous run (e.g. a new target). The nearest stored primal and dual solutions are then set as the warm start of the run, see
+ * SolverBase::setWarmStart(). After a run, the solution is stored if it converged and did not stop at the deadline. The warm start
+ * therefore only applies to SolverBase::run(initTime, initState, finalTime), as used by the MPC.
+ */
+class SolutionDatabase final : public SolverSynchronizedModule {
+ public:
+  /** The feature of a problem from the initial time, the final time, the initial state, and the target trajectories. */
+  using feature_function_t = std::function<vector_t(scalar_t, scalar_t, const vector_t&, const TargetTrajectories&)>;
+
+  /** The statistics of the database */
+  struct Statistics {
+    /** The number of the solver runs. */
+    size_t numRuns = 0;
+    /** The number of the runs with a poor previous solution, for which the database was queried. */
+    size_t numQueries = 0;
+    /** The number of the queries which found a stored solution to warm start the run. */
+    size_t numHits = 0;
+    /** The total number of iterations of the runs which were warm started by the database. */
+    size_t numIterationsOfHits = 0;
+    /** The total number of iterations of the queried runs which found no stored solution. */
+    size_t numIterationsOfMisses = 0;
+
+    /** The ratio of the hits to the queries. */
+    scalar_t getHitRate() const;
+
+    /** The average number of iterations which a hit saves compared to a miss, zero without both a hit and a miss. */
+    scalar_t getIterationSaving() const;
+  };
+
+  /**
+   * Constructor
+   * @param [in] solver: The solver which is warm started. It must outlive the database.
+   * @param [in] settings: The settings of the database.
+   * @param [in] featureFunction: The feature function of the problems, by default [x0; x_ref(finalTime)].
+   */
+  SolutionDatabase(SolverBase& solver, SolutionDatabaseSettings settings, feature_function_t featureFunction = nullptr);
+
+  ~SolutionDatabase() override = default;
+
+  void preSolverRun(scalar_t initTime, scalar_t finalTime, const vector_t& initState,
+                    const ReferenceManagerInterface& referenceManager) override;
+
+  void postSolverRun(const PrimalSolution& primalSolution) override;
+
+  /** Stores a solution with the given feature, e.g. of an offline run. */
+  void insert(const vector_t& feature, PrimalSolution primalSolution, DualSolution dualSolution);
+
+  /**
+   * Finds the stored solution with the nearest feature.
+   * @param [in] feature: The feature of the query.
+   * @param [out] distance: The feature distance of the nearest stored solution.
+   * @return The index of the nearest stored solution, or the number of stored solutions if the database has no solution of this feature
+   * size.
+   */
+  size_t findNearest(const vector_t& feature, scalar_t& distance) const;
+
+  /** The number of stored solutions. */
+  size_t size() const { return entries_.size(); }
+
+  /** The stored primal solution at the given index. */
+  const PrimalSolution& getPrimalSolution(size_t index) const { return entries_[index].primalSolution; }
+
+  /** The statistics of the database. */
+  const Statistics& getStatistics() const { return statistics_; }
+
+  /** The default feature function, [x0; x_ref(finalTime)] or x0 if the target trajectories are empty. */
+  static vector_t defaultFeature(scalar_t initTime, scalar_t finalTime, const vector_t& initState,
+                                 const TargetTrajectories& targetTrajectories);
+
+ private:
+  struct Entry {
+    vector_t feature;
+    PrimalSolution primalSolution;
+    DualSolution dualSolution;
+  };
+
+  /** The KD-tree node, which splits the features of its subtrees along an axis at the feature of its entry. A missing child is -1. */
+  struct Node {
+    size_t entryIndex;
+    size_t axis;
+    int left;
+    int right;
+  };
+
+  enum class Query { None, Hit, Miss };
+
+  void addToTree(size_t entryIndex);
+  void rebuildTree();
+  int buildSubtree(std::vector<size_t>& entryIndices, size_t begin, size_t end, size_t depth);
+  void searchSubtree(int nodeIndex, const vector_t& feature, size_t& nearestIndex, scalar_t& nearestSquaredDistance) const;
+
+  SolverBase& solver_;
+  const SolutionDatabaseSettings settings_;
+  const feature_function_t featureFunction_;
+
+  std::vector<Entry> entries_;
+  std::vector<Node> tree_;
+  size_t oldestEntryIndex_ = 0;
+
+  vector_t feature_;
+  vector_t previousFeature_;
+  Query query_ = Query::None;
+  Statistics statistics_;
+};
+
+/** Writes the statistics of the solution database to the stream. */
+std::ostream& operator<<(std::ostream& stream, const SolutionDatabase::Statistics& statistics);
+
+}  // namespace ocs2
@@ -0,0 +1,91 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <memory>
+
+#include <ocs2_core/dynamics/SystemDynamicsBase.h>
+#include <ocs2_core/initialization/Initializer.h>
+
+#include "ocs2_oc/synchronized_module/SolverSynchronizedModule.h"
+
+namespace ocs2 {
+
+/**
+ * An Initializer which extrapolates the tail of the previous solution. After a horizon shift, the part of the new horizon which lies
+ * beyond the final time of the previous solution is initialized by applying the final feedback policy of the previous solution, i.e.
+ * u = u_f + K_f (x - x_f), and integrating the model forward with it. The gain is only used if the controller of the previous solution is
+ * a LinearController, otherwise the final input is held. The fallback initializer is used before the first solution is available and
+ * for times before the final time of the previous solution.
+ *
+ * The previous solution is provided by the synchronized module which is returned by getSynchronizedModule(). It must be added to the
+ * solver, e.g.:
+ *    SolutionExtrapolationInitializer initializer(dynamics, DefaultInitializer(inputDim));
+ *    GaussNewtonDDP solver(..., initializer);  // or MultipleShootingSolver
+ *    solver.addSynchronizedModule(initializer.getSynchronizedModule());
+ * Since the solver keeps clones of the initializer, the solution tail is shared by all the clones. It is updated in postSolverRun which
+ * is not concurrent to the solver run.
+ */
+class SolutionExtrapolationInitializer final : public Initializer {
+ public:
+  /**
+   * Constructor
+   * @param [in] dynamics: The system dynamics which is used to extrapolate the state.
+   * @param [in] fallbackInitializer: The initializer which is used where no previous solution is available.
+   */
+  SolutionExtrapolationInitializer(const SystemDynamicsBase& dynamics, const Initializer& fallbackInitializer);
+
+  ~SolutionExtrapolationInitializer() override = default;
+
+  SolutionExtrapolationInitializer* clone() const override { return new SolutionExtrapolationInitializer(*this); }
+
+  void compute(scalar_t time, const vector_t& state, scalar_t nextTime, vector_t& input, vector_t& nextState) override;
+
+  /** Returns the synchronized module which updates the solution tail of this initializer and all its clones. */
+  std::shared_ptr<SolverSynchronizedModule> getSynchronizedModule() const;
+
+  /** The final node and feedback gain of the previous solution. */
+  struct SolutionTail {
+    bool valid = false;
+    scalar_t time = 0.0;
+    vector_t state;
+    vector_t input;
+    matrix_t gain;  // empty if the previous controller is not a LinearController
+  };
+
+ private:
+  SolutionExtrapolationInitializer(const SolutionExtrapolationInitializer& other);
+
+  std::unique_ptr<SystemDynamicsBase> dynamicsPtr_;
+  std::unique_ptr<Initializer> fallbackInitializerPtr_;
+  std::shared_ptr<SolutionTail> solutionTailPtr_;
+};
+
+}  // namespace ocs2
@@ -29,6 +29,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <algorithm>
+#include <vector>
+
 #include <ocs2_core/Types.h>
 #include <ocs2_core/reference/ModeSchedule.h>
 
@@ -61,7 +64,8 @@ class TrajectorySpreading final {
   const Status& getStatus() const { return status_; }
 
   /**
-   * Adjust continuous-time trajectory.
+   * Adjust in-place continuous-time trajectory. Only the spreading values which are overwritten by an earlier spreading interval
+   * are copied aside, all the other nodes are updated within the existing storage.
    *
    * @tparam data type.
    * @param [in, out] trajectory: trajectory for rectification.
@@ -79,6 +83,15 @@ class TrajectorySpreading final {
   template <typename T>
   std::vector<T> extractEventsArray(const std::vector<T>& array) const;
 
+  /**
+   * Extracts in-place event-time data. The kept elements are moved to the front of the array.
+   *
+   * @tparam data type.
+   * @param [in, out] array: The array for rectification.
+   */
+  template <typename T>
+  void adjustEventsArray(std::vector<T>& array) const;
+
   /**
    * Adjust time stamp of the trajectories and post event indices of the trajectories.
    *
@@ -145,6 +158,8 @@ class TrajectorySpreading final {
   size_array_t beginIndices_;
   size_array_t endIndices_;
   size_array_t spreadingValueIndices_;
+  std::vector<bool> isSpreadingValueOverwritten_; /**< Whether the spreading value is erased or overwritten by an earlier interval **/
+  size_t numOverwrittenSpreadingValues_ = 0;
 
   size_array_t updatedPostEventIndices_;
   scalar_array_t updatedMatchedEventTimes_;
@@ -161,25 +176,40 @@ std::vector<T> TrajectorySpreading::extractEventsArray(const std::vector<T>& arr
   return out;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <typename T>
+void TrajectorySpreading::adjustEventsArray(std::vector<T>& array) const {
+  array.erase(array.begin() + keepEventDataInInterval_.second, array.end());
+  array.erase(array.begin(), array.begin() + keepEventDataInInterval_.first);
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 template <typename T>
 void TrajectorySpreading::adjustTrajectory(std::vector<T>& trajectory) const {
+  // extract the spreading values beforehand which might be erased or overridden
+  std::vector<T> overwrittenValues;
+  if (numOverwrittenSpreadingValues_ > 0) {
+    overwrittenValues.reserve(numOverwrittenSpreadingValues_);
+    for (size_t i = 0; i < spreadingValueIndices_.size(); i++) {
+      if (isSpreadingValueOverwritten_[i]) {
+        overwrittenValues.push_back(trajectory[spreadingValueIndices_[i]]);
+      }
+    }
+  }
+
   // erase segment of trajectory associated to mismatched modes
   trajectory.erase(trajectory.begin() + eraseFromIndex_, trajectory.end());
 
-  // extract spreading values beforehand since they might be overridden
-  std::vector<T> spreadingValues(spreadingValueIndices_.size());
-  std::transform(spreadingValueIndices_.begin(), spreadingValueIndices_.end(), spreadingValues.begin(),
-                 [&](const size_t& ind) { return trajectory[ind]; });
-
-  // spread
+  // spread. The spreading value is never inside its own interval.
+  auto overwrittenValueItr = overwrittenValues.cbegin();
   for (size_t i = 0; i < spreadingValueIndices_.size(); i++) {
-    for (size_t j = beginIndices_[i]; j < endIndices_[i]; j++) {
-      trajectory[j] = spreadingValues[i];
-    }  // end of i loop
-  }    // end of j loop
+    const T& value = isSpreadingValueOverwritten_[i] ? *(overwrittenValueItr++) : trajectory[spreadingValueIndices_[i]];
+    std::fill(trajectory.begin() + beginIndices_[i], trajectory.begin() + endIndices_[i], value);
+  }  // end of i loop
 }
 
 }  // namespace ocs2
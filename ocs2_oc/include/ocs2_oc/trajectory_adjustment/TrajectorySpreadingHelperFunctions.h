@@ -81,7 +81,7 @@ inline TrajectorySpreading::Status trajectorySpread(const ModeSchedule& oldModeS
   if (status.willTruncate) {
     dualSolution.final.clear();
   }
-  dualSolution.preJumps = trajectorySpreading.extractEventsArray(dualSolution.preJumps);
+  trajectorySpreading.adjustEventsArray(dualSolution.preJumps);
   trajectorySpreading.adjustTrajectory(dualSolution.intermediates);
   trajectorySpreading.adjustTimeTrajectory(dualSolution.timeTrajectory);
   dualSolution.postEventIndices = trajectorySpreading.getPostEventIndices();
@@ -99,18 +99,20 @@ inline TrajectorySpreading::Status trajectorySpread(const ModeSchedule& oldModeS
  */
 inline void trajectorySpread(const TrajectorySpreading& trajectorySpreading, const DualSolution& oldDualSolution,
                              DualSolution& newDualSolution) {
-  newDualSolution.clear();
-
+  // the arrays are assigned rather than cleared, such that the memory of the elements of newDualSolution is reused
   // adjust time and postEventIndices
   newDualSolution.timeTrajectory = oldDualSolution.timeTrajectory;
   trajectorySpreading.adjustTimeTrajectory(newDualSolution.timeTrajectory);
   newDualSolution.postEventIndices = trajectorySpreading.getPostEventIndices();
 
   // adjust final, pre-jump and intermediate
-  if (!trajectorySpreading.getStatus().willTruncate) {
+  if (trajectorySpreading.getStatus().willTruncate) {
+    newDualSolution.final.clear();
+  } else {
     newDualSolution.final = oldDualSolution.final;
   }
-  newDualSolution.preJumps = trajectorySpreading.extractEventsArray(oldDualSolution.preJumps);
+  newDualSolution.preJumps = oldDualSolution.preJumps;
+  trajectorySpreading.adjustEventsArray(newDualSolution.preJumps);
   newDualSolution.intermediates = oldDualSolution.intermediates;
   trajectorySpreading.adjustTrajectory(newDualSolution.intermediates);
 }
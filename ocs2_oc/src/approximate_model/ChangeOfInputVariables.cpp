@@ -31,6 +31,82 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace ocs2 {
 
+namespace {
+
+/** Per thread buffers for the temporaries, such that repeated changes of variables of the same size do not allocate memory. */
+struct ChangeOfInputVariablesWorkspace {
+  matrix_t P_plus_R_Px;
+  vector_t r_plus_R_u0;
+  matrix_t R_Pu;
+};
+
+ChangeOfInputVariablesWorkspace& getWorkspace() {
+  thread_local ChangeOfInputVariablesWorkspace workspace;
+  return workspace;
+}
+
+/**
+ * Writes the terms of the quadratic approximation which do not depend on Pu to the result, i.e. Q, q, and c. The shared terms P + R*Px
+ * and r + R*u0 are left in the workspace.
+ */
+void changeOfInputVariablesStateTerms(const ScalarFunctionQuadraticApproximation& quadraticApproximation, const matrix_t& Px,
+                                      const vector_t& u0, ScalarFunctionQuadraticApproximation& result,
+                                      ChangeOfInputVariablesWorkspace& workspace) {
+  const bool hasPx(Px.size() > 0);
+  const bool hasu0(u0.size() > 0);
+  const auto& P = quadraticApproximation.dfdux;
+  const auto& R = quadraticApproximation.dfduu;
+
+  workspace.P_plus_R_Px = P;
+  if (hasPx) {
+    workspace.P_plus_R_Px.noalias() += R * Px;
+  }
+  workspace.r_plus_R_u0 = quadraticApproximation.dfdu;
+  if (hasu0) {
+    workspace.r_plus_R_u0.noalias() += R * u0;
+  }
+
+  // Q = Q + P'*Px + Px'*(P + R*Px)
+  result.dfdxx = quadraticApproximation.dfdxx;
+  if (hasPx) {
+    result.dfdxx.noalias() += P.transpose() * Px;
+    result.dfdxx.noalias() += Px.transpose() * workspace.P_plus_R_Px;
+  }
+
+  // q = q + P' * u0 + Px' (R*u0 + r)
+  result.dfdx = quadraticApproximation.dfdx;
+  if (hasu0) {
+    result.dfdx.noalias() += P.transpose() * u0;
+  }
+  if (hasPx) {
+    result.dfdx.noalias() += Px.transpose() * workspace.r_plus_R_u0;
+  }
+
+  // c = c + 1/2*u0'((R*u0 + r) + r)
+  result.f = quadraticApproximation.f;
+  if (hasu0) {
+    result.f += 0.5 * u0.dot(workspace.r_plus_R_u0 + quadraticApproximation.dfdu);
+  }
+}
+
+/** Writes the terms of the linear approximation which do not depend on Pu to the result, i.e. A and b. */
+void changeOfInputVariablesStateTerms(const VectorFunctionLinearApproximation& linearApproximation, const matrix_t& Px, const vector_t& u0,
+                                      VectorFunctionLinearApproximation& result) {
+  // A = A + B*Px
+  result.dfdx = linearApproximation.dfdx;
+  if (Px.size() > 0) {
+    result.dfdx.noalias() += linearApproximation.dfdu * Px;
+  }
+
+  // b = b + B*u0
+  result.f = linearApproximation.f;
+  if (u0.size() > 0) {
+    result.f.noalias() += linearApproximation.dfdu * u0;
+  }
+}
+
+}  // unnamed namespace
+
 void changeOfInputVariables(ScalarFunctionQuadraticApproximation& quadraticApproximation, const matrix_t& Pu, const matrix_t& Px,
                             const vector_t& u0) {
   /*
@@ -45,15 +121,18 @@ void changeOfInputVariables(ScalarFunctionQuadraticApproximation& quadraticAppro
    */
   const bool hasPx(Px.size() > 0);
   const bool hasu0(u0.size() > 0);
+  auto& workspace = getWorkspace();
 
   // Shared term number 1
-  matrix_t P_plus_R_Px = quadraticApproximation.dfdux;
+  matrix_t& P_plus_R_Px = workspace.P_plus_R_Px;
+  P_plus_R_Px = quadraticApproximation.dfdux;
   if (hasPx) {
     P_plus_R_Px.noalias() += quadraticApproximation.dfduu * Px;
   }  // else added term is zero
 
   // Shared term number 2
-  vector_t r_plus_R_u0 = quadraticApproximation.dfdu;
+  vector_t& r_plus_R_u0 = workspace.r_plus_R_u0;
+  r_plus_R_u0 = quadraticApproximation.dfdu;
   if (hasu0) {
     r_plus_R_u0.noalias() += quadraticApproximation.dfduu * u0;
   }  // else added term is zero
@@ -81,7 +160,8 @@ void changeOfInputVariables(ScalarFunctionQuadraticApproximation& quadraticAppro
   quadraticApproximation.dfdux.noalias() = Pu.transpose() * P_plus_R_Px;
 
   // R = Pu' * R * Pu
-  matrix_t R_Pu = quadraticApproximation.dfduu * Pu;  // make the required temporary explicit, to save it in the second multiplication
+  matrix_t& R_Pu = workspace.R_Pu;  // make the required temporary explicit, to save it in the second multiplication
+  R_Pu.noalias() = quadraticApproximation.dfduu * Pu;
   quadraticApproximation.dfduu.noalias() = Pu.transpose() * R_Pu;
 
   // r = Pu' * (R*u0 + r)
@@ -107,4 +187,106 @@ void changeOfInputVariables(VectorFunctionLinearApproximation& linearApproximati
   linearApproximation.dfdu = linearApproximation.dfdu * Pu;  // temporary matrix unavoidable
 }
 
+void changeOfInputVariables(const ScalarFunctionQuadraticApproximation& quadraticApproximation, const matrix_t& Pu, const matrix_t& Px,
+                            const vector_t& u0, ScalarFunctionQuadraticApproximation& result) {
+  auto& workspace = getWorkspace();
+  changeOfInputVariablesStateTerms(quadraticApproximation, Px, u0, result, workspace);
+
+  // P = Pu'*(P + R*Px)
+  result.dfdux.noalias() = Pu.transpose() * workspace.P_plus_R_Px;
+
+  // R = Pu' * R * Pu
+  workspace.R_Pu.noalias() = quadraticApproximation.dfduu * Pu;
+  result.dfduu.noalias() = Pu.transpose() * workspace.R_Pu;
+
+  // r = Pu' * (R*u0 + r)
+  result.dfdu.noalias() = Pu.transpose() * workspace.r_plus_R_u0;
+}
+
+void changeOfInputVariables(const VectorFunctionLinearApproximation& linearApproximation, const matrix_t& Pu, const matrix_t& Px,
+                            const vector_t& u0, VectorFunctionLinearApproximation& result) {
+  changeOfInputVariablesStateTerms(linearApproximation, Px, u0, result);
+
+  // B = B*Pu
+  result.dfdu.noalias() = linearApproximation.dfdu * Pu;
+}
+
+bool isInputSelection(const matrix_t& Pu, std::vector<int>& selectedInputs) {
+  const int inputDim = Pu.rows();
+  std::vector<bool> isSelected(inputDim, false);
+  selectedInputs.clear();
+  selectedInputs.reserve(Pu.cols());
+  for (int j = 0; j < Pu.cols(); j++) {
+    int selectedInput = -1;
+    for (int i = 0; i < inputDim; i++) {
+      if (Pu(i, j) == 1.0 && selectedInput < 0) {
+        selectedInput = i;
+      } else if (Pu(i, j) != 0.0) {
+        return false;
+      }
+    }
+    if (selectedInput < 0 || isSelected[selectedInput]) {
+      return false;
+    }
+    isSelected[selectedInput] = true;
+    selectedInputs.push_back(selectedInput);
+  }
+  return true;
+}
+
+bool isIdentitySelection(const std::vector<int>& selectedInputs, int inputDim) {
+  if (static_cast<int>(selectedInputs.size()) != inputDim) {
+    return false;
+  }
+  for (int i = 0; i < inputDim; i++) {
+    if (selectedInputs[i] != i) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void changeOfInputVariables(const ScalarFunctionQuadraticApproximation& quadraticApproximation, const std::vector<int>& selectedInputs,
+                            const matrix_t& Px, const vector_t& u0, ScalarFunctionQuadraticApproximation& result) {
+  const int inputDim = quadraticApproximation.dfdu.size();
+  if (Px.size() == 0 && u0.size() == 0 && isIdentitySelection(selectedInputs, inputDim)) {
+    result = quadraticApproximation;
+    return;
+  }
+
+  auto& workspace = getWorkspace();
+  changeOfInputVariablesStateTerms(quadraticApproximation, Px, u0, result, workspace);
+
+  // P, R, and r are the rows (and columns) of the selected inputs
+  const int numSelected = selectedInputs.size();
+  result.dfdux.resize(numSelected, workspace.P_plus_R_Px.cols());
+  result.dfduu.resize(numSelected, numSelected);
+  result.dfdu.resize(numSelected);
+  for (int i = 0; i < numSelected; i++) {
+    result.dfdux.row(i) = workspace.P_plus_R_Px.row(selectedInputs[i]);
+    for (int j = 0; j < numSelected; j++) {
+      result.dfduu(i, j) = quadraticApproximation.dfduu(selectedInputs[i], selectedInputs[j]);
+    }
+    result.dfdu(i) = workspace.r_plus_R_u0(selectedInputs[i]);
+  }
+}
+
+void changeOfInputVariables(const VectorFunctionLinearApproximation& linearApproximation, const std::vector<int>& selectedInputs,
+                            const matrix_t& Px, const vector_t& u0, VectorFunctionLinearApproximation& result) {
+  const int inputDim = linearApproximation.dfdu.cols();
+  if (Px.size() == 0 && u0.size() == 0 && isIdentitySelection(selectedInputs, inputDim)) {
+    result = linearApproximation;
+    return;
+  }
+
+  changeOfInputVariablesStateTerms(linearApproximation, Px, u0, result);
+
+  // B are the columns of the selected inputs
+  const int numSelected = selectedInputs.size();
+  result.dfdu.resize(linearApproximation.dfdu.rows(), numSelected);
+  for (int j = 0; j < numSelected; j++) {
+    result.dfdu.col(j) = linearApproximation.dfdu.col(selectedInputs[j]);
+  }
+}
+
 }  // namespace ocs2
@@ -35,6 +35,55 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace ocs2 {
 
+namespace {
+
+/** Adds the quadratic approximations of all intermediate costs and soft constraints to the cost, which is sized to state and input. */
+void accumulateCost(const OptimalControlProblem& problem, scalar_t time, const vector_t& state, const vector_t& input,
+                    ScalarFunctionQuadraticApproximation& cost) {
+  const auto& targetTrajectories = *problem.targetTrajectoriesPtr;
+  const auto& preComputation = *problem.preComputationPtr;
+
+  // state-input cost approximations
+  problem.costPtr->accumulateQuadraticApproximation(time, state, input, targetTrajectories, preComputation, cost);
+  if (!problem.softConstraintPtr->empty()) {
+    problem.softConstraintPtr->accumulateQuadraticApproximation(time, state, input, targetTrajectories, preComputation, cost);
+  }
+
+  // state only cost approximations
+  if (!problem.stateCostPtr->empty()) {
+    problem.stateCostPtr->accumulateQuadraticApproximation(time, state, targetTrajectories, preComputation, cost);
+  }
+  if (!problem.stateSoftConstraintPtr->empty()) {
+    problem.stateSoftConstraintPtr->accumulateQuadraticApproximation(time, state, targetTrajectories, preComputation, cost);
+  }
+}
+
+/** Adds the quadratic approximations of the pre-jump cost and soft constraint to the cost, which is sized to the state. */
+void accumulateEventCost(const OptimalControlProblem& problem, scalar_t time, const vector_t& state,
+                         ScalarFunctionQuadraticApproximation& cost) {
+  const auto& targetTrajectories = *problem.targetTrajectoriesPtr;
+  const auto& preComputation = *problem.preComputationPtr;
+
+  problem.preJumpCostPtr->accumulateQuadraticApproximation(time, state, targetTrajectories, preComputation, cost);
+  if (!problem.preJumpSoftConstraintPtr->empty()) {
+    problem.preJumpSoftConstraintPtr->accumulateQuadraticApproximation(time, state, targetTrajectories, preComputation, cost);
+  }
+}
+
+/** Adds the quadratic approximations of the final cost and soft constraint to the cost, which is sized to the state. */
+void accumulateFinalCost(const OptimalControlProblem& problem, scalar_t time, const vector_t& state,
+                         ScalarFunctionQuadraticApproximation& cost) {
+  const auto& targetTrajectories = *problem.targetTrajectoriesPtr;
+  const auto& preComputation = *problem.preComputationPtr;
+
+  problem.finalCostPtr->accumulateQuadraticApproximation(time, state, targetTrajectories, preComputation, cost);
+  if (!problem.finalSoftConstraintPtr->empty()) {
+    problem.finalSoftConstraintPtr->accumulateQuadraticApproximation(time, state, targetTrajectories, preComputation, cost);
+  }
+}
+
+}  // unnamed namespace
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -53,8 +102,9 @@ void approximateIntermediateLQ(OptimalControlProblem& problem, const scalar_t ti
   modelData.dynamicsCovariance = problem.dynamicsPtr->dynamicsCovariance(time, state, input);
   modelData.dynamics = problem.dynamicsPtr->linearApproximation(time, state, input, preComputation);
 
-  // Cost
-  modelData.cost = ocs2::approximateCost(problem, time, state, input);
+  // Cost, accumulated in the memory of modelData
+  modelData.cost.setZero(state.rows(), input.rows());
+  accumulateCost(problem, time, state, input, modelData.cost);
 
   // Equality constraints
   modelData.stateEqConstraint = problem.stateEqualityConstraintPtr->getLinearApproximation(time, state, preComputation);
@@ -101,7 +151,8 @@ void approximatePreJumpLQ(OptimalControlProblem& problem, const scalar_t& time,
   modelData.dynamics = problem.dynamicsPtr->jumpMapLinearApproximation(time, state, preComputation);
 
   // Pre-jump cost
-  modelData.cost = approximateEventCost(problem, time, state);
+  modelData.cost.setZero(state.rows());
+  accumulateEventCost(problem, time, state, modelData.cost);
 
   // state equality constraint
   modelData.stateEqConstraint = problem.preJumpEqualityConstraintPtr->getLinearApproximation(time, state, preComputation);
@@ -142,7 +193,8 @@ void approximateFinalLQ(OptimalControlProblem& problem, const scalar_t& time, co
   modelData.stateEqConstraint = problem.finalEqualityConstraintPtr->getLinearApproximation(time, state, preComputation);
 
   // Final cost
-  modelData.cost = approximateFinalCost(problem, time, state);
+  modelData.cost.setZero(state.rows());
+  accumulateFinalCost(problem, time, state, modelData.cost);
 
   // Lagrangians
   if (!problem.finalEqualityLagrangianPtr->empty()) {
@@ -180,31 +232,8 @@ scalar_t computeCost(const OptimalControlProblem& problem, const scalar_t& time,
 /******************************************************************************************************/
 ScalarFunctionQuadraticApproximation approximateCost(const OptimalControlProblem& problem, const scalar_t& time, const vector_t& state,
                                                      const vector_t& input) {
-  const auto& targetTrajectories = *problem.targetTrajectoriesPtr;
-  const auto& preComputation = *problem.preComputationPtr;
-
-  // get the state-input cost approximations
-  auto cost = problem.costPtr->getQuadraticApproximation(time, state, input, targetTrajectories, preComputation);
-
-  if (!problem.softConstraintPtr->empty()) {
-    cost += problem.softConstraintPtr->getQuadraticApproximation(time, state, input, targetTrajectories, preComputation);
-  }
-
-  // get the state only cost approximations
-  if (!problem.stateCostPtr->empty()) {
-    auto stateCost = problem.stateCostPtr->getQuadraticApproximation(time, state, targetTrajectories, preComputation);
-    cost.f += stateCost.f;
-    cost.dfdx += stateCost.dfdx;
-    cost.dfdxx += stateCost.dfdxx;
-  }
-
-  if (!problem.stateSoftConstraintPtr->empty()) {
-    auto stateCost = problem.stateSoftConstraintPtr->getQuadraticApproximation(time, state, targetTrajectories, preComputation);
-    cost.f += stateCost.f;
-    cost.dfdx += stateCost.dfdx;
-    cost.dfdxx += stateCost.dfdxx;
-  }
-
+  auto cost = ScalarFunctionQuadraticApproximation::Zero(state.rows(), input.rows());
+  accumulateCost(problem, time, state, input, cost);
   return cost;
 }
 
@@ -226,14 +255,8 @@ scalar_t computeEventCost(const OptimalControlProblem& problem, const scalar_t&
 /******************************************************************************************************/
 ScalarFunctionQuadraticApproximation approximateEventCost(const OptimalControlProblem& problem, const scalar_t& time,
                                                           const vector_t& state) {
-  const auto& targetTrajectories = *problem.targetTrajectoriesPtr;
-  const auto& preComputation = *problem.preComputationPtr;
-
-  auto cost = problem.preJumpCostPtr->getQuadraticApproximation(time, state, targetTrajectories, preComputation);
-  if (!problem.preJumpSoftConstraintPtr->empty()) {
-    cost += problem.preJumpSoftConstraintPtr->getQuadraticApproximation(time, state, targetTrajectories, preComputation);
-  }
-
+  auto cost = ScalarFunctionQuadraticApproximation::Zero(state.rows());
+  accumulateEventCost(problem, time, state, cost);
   return cost;
 }
 
@@ -255,14 +278,8 @@ scalar_t computeFinalCost(const OptimalControlProblem& problem, const scalar_t&
 /******************************************************************************************************/
 ScalarFunctionQuadraticApproximation approximateFinalCost(const OptimalControlProblem& problem, const scalar_t& time,
                                                           const vector_t& state) {
-  const auto& targetTrajectories = *problem.targetTrajectoriesPtr;
-  const auto& preComputation = *problem.preComputationPtr;
-
-  auto cost = problem.finalCostPtr->getQuadraticApproximation(time, state, targetTrajectories, preComputation);
-  if (!problem.finalSoftConstraintPtr->empty()) {
-    cost += problem.finalSoftConstraintPtr->getQuadraticApproximation(time, state, targetTrajectories, preComputation);
-  }
-
+  auto cost = ScalarFunctionQuadraticApproximation::Zero(state.rows());
+  accumulateFinalCost(problem, time, state, cost);
   return cost;
 }
 
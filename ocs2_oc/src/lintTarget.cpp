@@ -42,6 +42,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_oc/oc_problem/OptimalControlProblemHelperFunction.h>
 
 // oc_solver
+#include <ocs2_oc/oc_solver/PartitionedRiccatiSolver.h>
 #include <ocs2_oc/oc_solver/SolverBase.h>
 
 // synchronized_module
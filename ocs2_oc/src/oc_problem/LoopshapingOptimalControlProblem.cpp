@@ -35,6 +35,14 @@ namespace ocs2 {
 namespace LoopshapingOptimalControlProblem {
 
 OptimalControlProblem create(const OptimalControlProblem& problem, std::shared_ptr<LoopshapingDefinition> loopshapingDefinition) {
+  if (!problem.boxConstraintPtr->empty()) {
+    throw std::runtime_error("[LoopshapingOptimalControlProblem] Box constraints are not supported, instead use a soft box constraint!");
+  }
+  if (!problem.inequalityConstraintPtr->empty()) {
+    throw std::runtime_error(
+        "[LoopshapingOptimalControlProblem] Hard inequality constraints are not supported, instead use a soft constraint!");
+  }
+
   OptimalControlProblem augmentedProblem;
 
   // Dynamics
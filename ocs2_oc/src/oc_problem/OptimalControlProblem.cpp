@@ -50,6 +50,8 @@ OptimalControlProblem::OptimalControlProblem()
       stateEqualityConstraintPtr(new StateConstraintCollection),
       preJumpEqualityConstraintPtr(new StateConstraintCollection),
       finalEqualityConstraintPtr(new StateConstraintCollection),
+      inequalityConstraintPtr(new StateInputConstraintCollection),
+      boxConstraintPtr(new BoxConstraint),
       /* Lagrangians */
       equalityLagrangianPtr(new StateInputAugmentedLagrangianCollection),
       stateEqualityLagrangianPtr(new StateAugmentedLagrangianCollection),
@@ -82,6 +84,8 @@ OptimalControlProblem::OptimalControlProblem(const OptimalControlProblem& other)
       stateEqualityConstraintPtr(other.stateEqualityConstraintPtr->clone()),
       preJumpEqualityConstraintPtr(other.preJumpEqualityConstraintPtr->clone()),
       finalEqualityConstraintPtr(other.finalEqualityConstraintPtr->clone()),
+      inequalityConstraintPtr(other.inequalityConstraintPtr->clone()),
+      boxConstraintPtr(other.boxConstraintPtr->clone()),
       /* Lagrangians */
       equalityLagrangianPtr(other.equalityLagrangianPtr->clone()),
       stateEqualityLagrangianPtr(other.stateEqualityLagrangianPtr->clone()),
@@ -129,6 +133,8 @@ void OptimalControlProblem::swap(OptimalControlProblem& other) noexcept {
   stateEqualityConstraintPtr.swap(other.stateEqualityConstraintPtr);
   preJumpEqualityConstraintPtr.swap(other.preJumpEqualityConstraintPtr);
   finalEqualityConstraintPtr.swap(other.finalEqualityConstraintPtr);
+  inequalityConstraintPtr.swap(other.inequalityConstraintPtr);
+  boxConstraintPtr.swap(other.boxConstraintPtr);
 
   /* Lagrangians */
   equalityLagrangianPtr.swap(other.equalityLagrangianPtr);
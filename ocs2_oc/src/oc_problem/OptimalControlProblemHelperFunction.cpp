@@ -31,6 +31,64 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace ocs2 {
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void cacheTermActivity(const ModeSchedule& modeSchedule, OptimalControlProblem& ocp) {
+  ocp.costPtr->cacheTermActivity(modeSchedule);
+  ocp.stateCostPtr->cacheTermActivity(modeSchedule);
+  ocp.preJumpCostPtr->cacheTermActivity(modeSchedule);
+  ocp.finalCostPtr->cacheTermActivity(modeSchedule);
+
+  ocp.softConstraintPtr->cacheTermActivity(modeSchedule);
+  ocp.stateSoftConstraintPtr->cacheTermActivity(modeSchedule);
+  ocp.preJumpSoftConstraintPtr->cacheTermActivity(modeSchedule);
+  ocp.finalSoftConstraintPtr->cacheTermActivity(modeSchedule);
+
+  ocp.equalityConstraintPtr->cacheTermActivity(modeSchedule);
+  ocp.stateEqualityConstraintPtr->cacheTermActivity(modeSchedule);
+  ocp.preJumpEqualityConstraintPtr->cacheTermActivity(modeSchedule);
+  ocp.finalEqualityConstraintPtr->cacheTermActivity(modeSchedule);
+  ocp.inequalityConstraintPtr->cacheTermActivity(modeSchedule);
+
+  ocp.equalityLagrangianPtr->cacheTermActivity(modeSchedule);
+  ocp.stateEqualityLagrangianPtr->cacheTermActivity(modeSchedule);
+  ocp.inequalityLagrangianPtr->cacheTermActivity(modeSchedule);
+  ocp.stateInequalityLagrangianPtr->cacheTermActivity(modeSchedule);
+  ocp.preJumpEqualityLagrangianPtr->cacheTermActivity(modeSchedule);
+  ocp.preJumpInequalityLagrangianPtr->cacheTermActivity(modeSchedule);
+  ocp.finalEqualityLagrangianPtr->cacheTermActivity(modeSchedule);
+  ocp.finalInequalityLagrangianPtr->cacheTermActivity(modeSchedule);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool hasLagrangianTerms(const OptimalControlProblem& ocp) {
+  return !ocp.equalityLagrangianPtr->empty() || !ocp.stateEqualityLagrangianPtr->empty() || !ocp.inequalityLagrangianPtr->empty() ||
+         !ocp.stateInequalityLagrangianPtr->empty() || !ocp.preJumpEqualityLagrangianPtr->empty() ||
+         !ocp.preJumpInequalityLagrangianPtr->empty() || !ocp.finalEqualityLagrangianPtr->empty() ||
+         !ocp.finalInequalityLagrangianPtr->empty();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool isLinearQuadratic(const OptimalControlProblem& ocp) {
+  const bool isCostQuadratic = ocp.costPtr->isHessianConstant() && ocp.stateCostPtr->isHessianConstant() &&
+                               ocp.preJumpCostPtr->isHessianConstant() && ocp.finalCostPtr->isHessianConstant();
+
+  const bool isSoftConstraintQuadratic = ocp.softConstraintPtr->isHessianConstant() && ocp.stateSoftConstraintPtr->isHessianConstant() &&
+                                         ocp.preJumpSoftConstraintPtr->isHessianConstant() &&
+                                         ocp.finalSoftConstraintPtr->isHessianConstant();
+
+  const bool isUnconstrained = ocp.equalityConstraintPtr->empty() && ocp.stateEqualityConstraintPtr->empty() &&
+                               ocp.preJumpEqualityConstraintPtr->empty() && ocp.finalEqualityConstraintPtr->empty() &&
+                               ocp.inequalityConstraintPtr->empty() && ocp.boxConstraintPtr->empty();
+
+  return ocp.dynamicsPtr->isLinear() && isCostQuadratic && isSoftConstraintQuadratic && isUnconstrained && !hasLagrangianTerms(ocp);
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -42,8 +100,7 @@ void initializeDualSolution(const OptimalControlProblem& ocp, const PrimalSoluti
       findIntersectionToExtendableInterval(cachedDualSolution.timeTrajectory, primalSolution.modeSchedule_.eventTimes, timePeriod);
   const bool interpolateTillFinalTime = numerics::almost_eq(interpolatableTimePeriod.second, timePeriod.second);
 
-  // clear and set time
-  dualSolution.clear();
+  // set time. The multiplier collections are not cleared such that their memory is reused.
   dualSolution.timeTrajectory = primalSolution.timeTrajectory_;
   dualSolution.postEventIndices = primalSolution.postEventIndices_;
 
@@ -79,7 +136,7 @@ void initializeDualSolution(const OptimalControlProblem& ocp, const PrimalSoluti
     const auto& time = primalSolution.timeTrajectory_[i];
     auto& multiplierCollection = dualSolution.intermediates[i];
     if (interpolatableTimePeriod.first <= time && time <= interpolatableTimePeriod.second) {
-      multiplierCollection = getIntermediateDualSolutionAtTime(cachedDualSolution, time);
+      getIntermediateDualSolutionAtTime(cachedDualSolution, time, multiplierCollection);
     } else {
       initializeIntermediateMultiplierCollection(ocp, time, multiplierCollection);
     }
@@ -152,6 +209,40 @@ void updateDualSolution(const OptimalControlProblem& ocp, const PrimalSolution&
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void updateDualSolution(const OptimalControlProblem& ocp, const PrimalSolution& primalSolution, ProblemMetrics& problemMetrics,
+                        DualSolutionRef dualSolution, ThreadPool& threadPool, size_t maxNumThreads) {
+  // final and preJumps are only a few nodes
+  if (!primalSolution.timeTrajectory_.empty()) {
+    const auto& time = primalSolution.timeTrajectory_.back();
+    const auto& state = primalSolution.stateTrajectory_.back();
+    updateFinalMultiplierCollection(ocp, time, state, problemMetrics.final, dualSolution.final);
+  }
+
+  assert(dualSolution.preJumps.size() == primalSolution.postEventIndices_.size());
+  assert(problemMetrics.preJumps.size() == primalSolution.postEventIndices_.size());
+  for (size_t i = 0; i < primalSolution.postEventIndices_.size(); i++) {
+    const auto timeIndex = primalSolution.postEventIndices_[i] - 1;
+    const auto& time = primalSolution.timeTrajectory_[timeIndex];
+    const auto& state = primalSolution.stateTrajectory_[timeIndex];
+    updatePreJumpMultiplierCollection(ocp, time, state, problemMetrics.preJumps[i], dualSolution.preJumps[i]);
+  }
+
+  // intermediates: the nodes are independent and the Lagrangian updates are stateless
+  assert(dualSolution.intermediates.size() == primalSolution.timeTrajectory_.size());
+  assert(problemMetrics.intermediates.size() == primalSolution.timeTrajectory_.size());
+  auto updateNode = [&](int /*workerIndex*/, int i) {
+    const auto& time = primalSolution.timeTrajectory_[i];
+    const auto& state = primalSolution.stateTrajectory_[i];
+    const auto& input = primalSolution.inputTrajectory_[i];
+    updateIntermediateMultiplierCollection(ocp, time, state, input, problemMetrics.intermediates[i], dualSolution.intermediates[i]);
+  };
+  constexpr int grain = 16;
+  threadPool.parallelFor(0, static_cast<int>(primalSolution.timeTrajectory_.size()), grain, updateNode, maxNumThreads);
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -0,0 +1,234 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+
+#include "ocs2_oc/oc_solver/PartitionedRiccatiSolver.h"
+
+#include <algorithm>
+#include <string>
+
+#include <Eigen/Cholesky>
+#include <Eigen/LU>
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+PartitionedRiccatiSolver::PartitionedRiccatiSolver(size_t numPartitions, size_t maxNumThreads)
+    : numPartitions_(std::max<size_t>(numPartitions, 1)), maxNumThreads_(maxNumThreads) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PartitionedRiccatiSolver::solve(const vector_t& x0, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                                     const std::vector<ScalarFunctionQuadraticApproximation>& cost, ThreadPool& threadPool,
+                                     vector_array_t& stateTrajectory, vector_array_t& inputTrajectory) {
+  const int N = dynamics.size();
+  if (static_cast<int>(cost.size()) != N + 1) {
+    throw std::runtime_error("[PartitionedRiccatiSolver] The cost needs to be given at the N + 1 nodes of the N stages.");
+  }
+
+  costToGo_.resize(N + 1);
+  feedback_.resize(N);
+  feedforward_.resize(N);
+
+  costToGo_[N].f = 0.0;
+  costToGo_[N].dfdx = cost[N].dfdx;
+  costToGo_[N].dfdxx = cost[N].dfdxx;
+
+  // Partitions with an equal number of stages, each partition has at least one stage.
+  const int numPartitions = std::max(1, std::min(static_cast<int>(numPartitions_), N));
+  partitions_.resize(numPartitions);
+  for (int p = 0; p < numPartitions; ++p) {
+    partitions_[p].start = p * N / numPartitions;
+    partitions_[p].end = (p + 1) * N / numPartitions;
+  }
+
+  if (numPartitions == 1) {
+    backwardSweep(dynamics, cost, 0, N, costToGo_[N], nullptr);
+  } else {
+    // The last partition starts from the final cost. The inner partitions start from the unknown multiplier of their end state.
+    auto firstSweep = [&](int /* workerIndex */, int p) {
+      auto& partition = partitions_[p];
+      if (p + 1 == numPartitions) {
+        backwardSweep(dynamics, cost, partition.start, partition.end, costToGo_[N], nullptr);
+      } else {
+        const auto endStateDim = dynamics[partition.end - 1].dfdx.rows();
+        partition.finalCostToGo.f = 0.0;
+        partition.finalCostToGo.dfdx.setZero(endStateDim);
+        partition.finalCostToGo.dfdxx.setZero(endStateDim, endStateDim);
+        backwardSweep(dynamics, cost, partition.start, partition.end, partition.finalCostToGo, &partition);
+      }
+    };
+    threadPool.parallelFor(1, numPartitions, 1, firstSweep, maxNumThreads_);
+
+    // Exact cost-to-go at the partition boundaries
+    const auto& lastPartition = partitions_.back();
+    partitions_[numPartitions - 2].finalCostToGo = costToGo_[lastPartition.start];
+    for (int p = numPartitions - 2; p > 0; --p) {
+      combine(partitions_[p], partitions_[p - 1].finalCostToGo);
+    }
+
+    // All partitions apart from the last one, from the exact cost-to-go at their end
+    auto secondSweep = [&](int /* workerIndex */, int p) {
+      const auto& partition = partitions_[p];
+      backwardSweep(dynamics, cost, partition.start, partition.end, partition.finalCostToGo, nullptr);
+    };
+    threadPool.parallelFor(0, numPartitions - 1, 1, secondSweep, maxNumThreads_);
+  }
+
+  // Forward rollout of the optimal policy
+  stateTrajectory.resize(N + 1);
+  inputTrajectory.resize(N);
+  stateTrajectory[0] = x0;
+  for (int k = 0; k < N; ++k) {
+    inputTrajectory[k] = feedforward_[k];
+    inputTrajectory[k].noalias() += feedback_[k] * stateTrajectory[k];
+    stateTrajectory[k + 1] = dynamics[k].f;
+    stateTrajectory[k + 1].noalias() += dynamics[k].dfdx * stateTrajectory[k];
+    stateTrajectory[k + 1].noalias() += dynamics[k].dfdu * inputTrajectory[k];
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PartitionedRiccatiSolver::backwardSweep(const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                                             const std::vector<ScalarFunctionQuadraticApproximation>& cost, int start, int end,
+                                             const ScalarFunctionQuadraticApproximation& finalCostToGo, Partition* parametricPtr) {
+  if (parametricPtr != nullptr) {
+    const auto endStateDim = finalCostToGo.dfdx.size();
+    parametricPtr->Gamma.setIdentity(endStateDim, endStateDim);
+    parametricPtr->Theta.setZero(endStateDim, endStateDim);
+    parametricPtr->theta.setZero(endStateDim);
+  }
+
+  matrix_t PA, PB, H, F, BtGamma, closedLoopA;
+  vector_t Pbp, h, closedLoopB;
+  for (int k = end - 1; k >= start; --k) {
+    const auto& A = dynamics[k].dfdx;
+    const auto& B = dynamics[k].dfdu;
+    const auto& b = dynamics[k].f;
+    const auto& L = cost[k];
+    const auto& next = (k + 1 == end) ? finalCostToGo : costToGo_[k + 1];
+    auto& V = costToGo_[k];
+    auto& K = feedback_[k];
+    auto& kff = feedforward_[k];
+
+    // Pbp = P * b + p
+    Pbp = next.dfdx;
+    Pbp.noalias() += next.dfdxx * b;
+    PA.noalias() = next.dfdxx * A;
+
+    V.f = 0.0;
+    V.dfdxx = L.dfdxx;
+    V.dfdxx.noalias() += A.transpose() * PA;
+    V.dfdx = L.dfdx;
+    V.dfdx.noalias() += A.transpose() * Pbp;
+
+    if (B.cols() > 0) {
+      PB.noalias() = next.dfdxx * B;
+      H = L.dfduu;
+      H.noalias() += B.transpose() * PB;
+      F = L.dfdux;
+      F.noalias() += PB.transpose() * A;
+      h = L.dfdu;
+      h.noalias() += B.transpose() * Pbp;
+
+      const Eigen::LLT<matrix_t> HChol(H);
+      if (HChol.info() != Eigen::Success) {
+        throw std::runtime_error("[PartitionedRiccatiSolver] The input Hessian of the cost-to-go is not positive definite at stage " +
+                                 std::to_string(k) + ".");
+      }
+      K = -HChol.solve(F);
+      kff = -HChol.solve(h);
+
+      // -F' H^-1 F = F' K, and -F' H^-1 h = F' k
+      V.dfdxx.noalias() += F.transpose() * K;
+      V.dfdx.noalias() += F.transpose() * kff;
+
+      if (parametricPtr != nullptr) {
+        auto& Gamma = parametricPtr->Gamma;
+        BtGamma.noalias() = B.transpose() * Gamma;
+        parametricPtr->Theta.noalias() += BtGamma.transpose() * HChol.solve(BtGamma);
+        closedLoopB = b;
+        closedLoopB.noalias() += B * kff;
+        parametricPtr->theta.noalias() += Gamma.transpose() * closedLoopB;
+        closedLoopA = A;
+        closedLoopA.noalias() += B * K;
+        Gamma = closedLoopA.transpose() * Gamma;
+      }
+    } else {
+      K.setZero(0, A.cols());
+      kff.resize(0);
+
+      if (parametricPtr != nullptr) {
+        auto& Gamma = parametricPtr->Gamma;
+        parametricPtr->theta.noalias() += Gamma.transpose() * b;
+        Gamma = A.transpose() * Gamma;
+      }
+    }
+
+    V.dfdxx.triangularView<Eigen::StrictlyUpper>() = V.dfdxx.triangularView<Eigen::StrictlyLower>().transpose();
+  }
+
+  if (parametricPtr != nullptr) {
+    parametricPtr->Phi = costToGo_[start].dfdxx;
+    parametricPtr->phi = costToGo_[start].dfdx;
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PartitionedRiccatiSolver::combine(const Partition& partition, ScalarFunctionQuadraticApproximation& startCostToGo) {
+  // Stationarity with respect to the end state x_e and its multiplier l:
+  //  l = S x_e + s,  x_e = Gamma' x - Theta l + theta  =>  (I + Theta S) x_e = Gamma' x + theta - Theta s
+  const auto& S = partition.finalCostToGo.dfdxx;
+  const auto& s = partition.finalCostToGo.dfdx;
+
+  // X = S (I + Theta S)^-1 = ((I + S Theta)^-1 S)', which is symmetric
+  matrix_t M = S * partition.Theta;
+  M.diagonal().array() += 1.0;
+  const matrix_t X = M.partialPivLu().solve(S).transpose();
+
+  vector_t multiplierOffset = s;
+  vector_t stateOffset = partition.theta;
+  stateOffset.noalias() -= partition.Theta * s;
+  multiplierOffset.noalias() += X * stateOffset;
+
+  startCostToGo.f = 0.0;
+  startCostToGo.dfdxx = partition.Phi;
+  startCostToGo.dfdxx.noalias() += partition.Gamma * X * partition.Gamma.transpose();
+  startCostToGo.dfdx = partition.phi;
+  startCostToGo.dfdx.noalias() += partition.Gamma * multiplierOffset;
+}
+
+}  // namespace ocs2
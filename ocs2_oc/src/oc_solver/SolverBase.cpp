@@ -27,9 +27,12 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
+#include <chrono>
 #include <iostream>
 #include <mutex>
 
+#include <ocs2_core/control/FeedforwardController.h>
+#include <ocs2_core/control/LinearController.h>
 #include <ocs2_core/misc/LinearAlgebra.h>
 #include <ocs2_core/misc/Numerics.h>
 
@@ -38,6 +41,29 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace ocs2 {
 
+namespace {
+
+void shiftTime(scalar_array_t& timeArray, scalar_t timeShift) {
+  for (auto& time : timeArray) {
+    time += timeShift;
+  }
+}
+
+/** Shifts the primal solution in time. The controllers other than the linear and feedforward ones are dropped. */
+void shiftTime(PrimalSolution& primalSolution, scalar_t timeShift) {
+  shiftTime(primalSolution.timeTrajectory_, timeShift);
+  shiftTime(primalSolution.modeSchedule_.eventTimes, timeShift);
+  if (auto* linearControllerPtr = dynamic_cast<LinearController*>(primalSolution.controllerPtr_.get())) {
+    shiftTime(linearControllerPtr->timeStamp_, timeShift);
+  } else if (auto* feedforwardControllerPtr = dynamic_cast<FeedforwardController*>(primalSolution.controllerPtr_.get())) {
+    shiftTime(feedforwardControllerPtr->timeStamp_, timeShift);
+  } else {
+    primalSolution.controllerPtr_.reset();
+  }
+}
+
+}  // unnamed namespace
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -47,8 +73,19 @@ SolverBase::SolverBase() : referenceManagerPtr_(new ReferenceManager) {}
 /******************************************************************************************************/
 /******************************************************************************************************/
 void SolverBase::run(scalar_t initTime, const vector_t& initState, scalar_t finalTime) {
+  benchmark::TraceScope runScope(getTracer(), "Solver Run");
   preRun(initTime, initState, finalTime);
-  runImpl(initTime, initState, finalTime);
+  if (hasWarmStart_) {
+    hasWarmStart_ = false;
+    const scalar_t timeShift = initTime - warmStartPrimalSolution_.timeTrajectory_.front();
+    shiftTime(warmStartPrimalSolution_, timeShift);
+    shiftTime(warmStartDualSolution_.timeTrajectory, timeShift);
+    runImpl(initTime, initState, finalTime, warmStartPrimalSolution_, warmStartDualSolution_);
+    warmStartPrimalSolution_.clear();
+    warmStartDualSolution_.clear();
+  } else {
+    runImpl(initTime, initState, finalTime);
+  }
   postRun();
 }
 
@@ -56,6 +93,7 @@ void SolverBase::run(scalar_t initTime, const vector_t& initState, scalar_t fina
 /******************************************************************************************************/
 /******************************************************************************************************/
 void SolverBase::run(scalar_t initTime, const vector_t& initState, scalar_t finalTime, const ControllerBase* externalControllerPtr) {
+  benchmark::TraceScope runScope(getTracer(), "Solver Run");
   preRun(initTime, initState, finalTime);
   runImpl(initTime, initState, finalTime, externalControllerPtr);
   postRun();
@@ -65,11 +103,24 @@ void SolverBase::run(scalar_t initTime, const vector_t& initState, scalar_t fina
 /******************************************************************************************************/
 /******************************************************************************************************/
 void SolverBase::run(scalar_t initTime, const vector_t& initState, scalar_t finalTime, const PrimalSolution& primalSolution) {
+  benchmark::TraceScope runScope(getTracer(), "Solver Run");
   preRun(initTime, initState, finalTime);
   runImpl(initTime, initState, finalTime, primalSolution);
   postRun();
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SolverBase::setWarmStart(PrimalSolution primalSolution, DualSolution dualSolution) {
+  if (primalSolution.timeTrajectory_.empty()) {
+    throw std::runtime_error("[SolverBase::setWarmStart] The primal solution of the warm start is empty!");
+  }
+  warmStartPrimalSolution_.swap(primalSolution);
+  warmStartDualSolution_.swap(dualSolution);
+  hasWarmStart_ = true;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -91,18 +142,26 @@ void SolverBase::printString(const std::string& text) const {
 /******************************************************************************************************/
 /******************************************************************************************************/
 void SolverBase::preRun(scalar_t initTime, const vector_t& initState, scalar_t finalTime) {
+  runStatistics_ = SolverRunStatistics();
+  initNumIterations_ = getNumIterations();
+
+  const auto modulesStart = std::chrono::steady_clock::now();
   referenceManagerPtr_->preSolverRun(initTime, finalTime, initState);
 
   for (auto& module : synchronizedModules_) {
     module->preSolverRun(initTime, finalTime, initState, *referenceManagerPtr_);
   }
+  runStatistics_.synchronizedModulesTime = std::chrono::duration<scalar_t>(std::chrono::steady_clock::now() - modulesStart).count();
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 void SolverBase::postRun() {
+  runStatistics_.numIterations = getNumIterations() - initNumIterations_;
+
   if (!synchronizedModules_.empty() || !augmentedLagrangianObservers_.empty()) {
+    const auto modulesStart = std::chrono::steady_clock::now();
     const auto solution = primalSolution(getFinalTime());
     for (auto& module : synchronizedModules_) {
       module->postSolverRun(solution);
@@ -111,6 +170,8 @@ void SolverBase::postRun() {
       observer->extractTermMetrics(getOptimalControlProblem(), solution, getSolutionMetrics());
       observer->extractTermMultipliers(getOptimalControlProblem(), getDualSolution());
     }
+    runStatistics_.synchronizedModulesTime +=
+        std::chrono::duration<scalar_t>(std::chrono::steady_clock::now() - modulesStart).count();
   }
 }
 
@@ -0,0 +1,82 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_oc/rollout/BatchRollout.h"
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+BatchRollout::BatchRollout(const RolloutBase& rollout, ThreadPool& threadPool, size_t maxNumThreads) : threadPool_(threadPool) {
+  const size_t numThreads = (maxNumThreads == 0) ? threadPool_.numThreads() + 1 : maxNumThreads;
+  rolloutPtrs_.reserve(numThreads);
+  for (size_t i = 0; i < numThreads; i++) {
+    rolloutPtrs_.emplace_back(rollout.clone());
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t BatchRollout::run(scalar_t initTime, const vector_t& initState, scalar_t finalTime, const std::vector<ControllerBase*>& controllers,
+                         const ModeSchedule& modeSchedule, const merit_function_t& meritFunction,
+                         std::vector<PrimalSolution>& primalSolutions) {
+  if (controllers.empty()) {
+    throw std::runtime_error("[BatchRollout::run] The batch has no controllers!");
+  }
+
+  const size_t batchSize = controllers.size();
+  primalSolutions.resize(batchSize);
+  merits_.resize(batchSize);
+
+  auto task = [&](int workerIndex, int i) {
+    auto& solution = primalSolutions[i];
+    solution.modeSchedule_ = modeSchedule;
+    try {
+      // a simulator based rollout might otherwise continue from the final state of its previous rollout
+      rolloutPtrs_[workerIndex]->resetRollout();
+      rolloutPtrs_[workerIndex]->run(initTime, initState, finalTime, controllers[i], solution.modeSchedule_, solution.timeTrajectory_,
+                                     solution.postEventIndices_, solution.stateTrajectory_, solution.inputTrajectory_);
+      merits_[i] = meritFunction(solution);
+    } catch (const std::exception&) {
+      merits_[i] = std::numeric_limits<scalar_t>::infinity();
+    }
+  };
+  threadPool_.parallelFor(0, static_cast<int>(batchSize), 1, task, rolloutPtrs_.size());
+
+  return std::distance(merits_.cbegin(), std::min_element(merits_.cbegin(), merits_.cend()));
+}
+
+}  // namespace ocs2
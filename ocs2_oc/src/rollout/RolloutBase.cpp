@@ -34,6 +34,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <iostream>
 
 #include <ocs2_core/NumericTraits.h>
+#include <ocs2_core/misc/LinearInterpolation.h>
 #include <ocs2_core/misc/Numerics.h>
 
 namespace ocs2 {
@@ -67,6 +68,26 @@ std::vector<std::pair<scalar_t, scalar_t>> RolloutBase::findActiveModesTimeInter
   return timeIntervalArray;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void RolloutBase::runAtQueryTimes(scalar_t initTime, const vector_t& initState, ControllerBase* controller, ModeSchedule& modeSchedule,
+                                  const scalar_array_t& queryTimes, vector_array_t& queryStates) {
+  queryStates.resize(queryTimes.size());
+  if (queryTimes.empty()) {
+    return;
+  }
+
+  run(initTime, initState, queryTimes.back(), controller, modeSchedule, timeTrajectoryBuffer_, postEventIndicesBuffer_,
+      stateTrajectoryBuffer_, inputTrajectoryBuffer_);
+
+  int cursor = 0;
+  for (size_t i = 0; i < queryTimes.size(); i++) {
+    const auto indexAlpha = LinearInterpolation::timeSegment(queryTimes[i], timeTrajectoryBuffer_, cursor);
+    queryStates[i] = LinearInterpolation::interpolate(indexAlpha, stateTrajectoryBuffer_);
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
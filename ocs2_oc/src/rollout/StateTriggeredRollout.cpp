@@ -59,7 +59,7 @@ vector_t StateTriggeredRollout::run(scalar_t initTime, const vector_t& initState
   }
 
   // max number of steps for integration
-  const auto maxNumSteps = static_cast<size_t>(this->settings().maxNumStepsPerSecond * std::max(1.0, finalTime - initTime));
+  const auto maxNumSteps = static_cast<size_t>(this->settings().maxNumStepsPerSecond * std::max(scalar_t(1.0), finalTime - initTime));
 
   // clearing the output trajectories
   modeSchedule.clear();
@@ -170,6 +170,7 @@ vector_t StateTriggeredRollout::run(scalar_t initTime, const vector_t& initState
     } else {           // otherwise keep or start refining
       if (refining) {  // apply the rules of the root-finding method to continue refining
         rootFinder.updateBracket(queryTime, queryGuard);
+        t1 = rootFinder.getNewQuery();
       } else {  // properly configure root-finding method to start refining
         const scalar_t& timeBefore = timeTrajectory.back();
         const vector_t& stateBefore = stateTrajectory.back();
@@ -178,8 +179,9 @@ vector_t StateTriggeredRollout::run(scalar_t initTime, const vector_t& initState
 
         rootFinder.setInitBracket(timeBefore, queryTime, guardBefore, queryGuard);
         refining = true;
+        // the first query is located on the interpolation of the step, such that the step is usually re-integrated only once
+        t1 = locateEventOnStep(eventID, timeBefore, stateBefore, guardBefore, queryTime, queryState, queryGuard);
       }
-      t1 = rootFinder.getNewQuery();
       t0 = timeTrajectory.back();
       x0 = stateTrajectory.back();
 
@@ -198,4 +200,37 @@ vector_t StateTriggeredRollout::run(scalar_t initTime, const vector_t& initState
   return stateTrajectory.back();
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t StateTriggeredRollout::locateEventOnStep(size_t eventID, scalar_t t0, const vector_t& x0, scalar_t guard0, scalar_t t1,
+                                                  const vector_t& x1, scalar_t guard1) {
+  // cubic Hermite interpolation of the state over the step
+  const scalar_t h = t1 - t0;
+  const vector_t hf0 = h * systemDynamicsPtr_->computeFlowMap(t0, x0);
+  const vector_t hf1 = h * systemDynamicsPtr_->computeFlowMap(t1, x1);
+  vector_t x(x0.size());
+  auto interpolatedGuard = [&](scalar_t t) {
+    const scalar_t s = (t - t0) / h;
+    const scalar_t s2 = s * s;
+    const scalar_t s3 = s2 * s;
+    x = (2.0 * s3 - 3.0 * s2 + 1.0) * x0 + (s3 - 2.0 * s2 + s) * hf0 + (3.0 * s2 - 2.0 * s3) * x1 + (s3 - s2) * hf1;
+    return systemDynamicsPtr_->computeGuardSurfaces(t, x)[eventID];
+  };
+
+  // the guard is cheap to evaluate on the interpolation, therefore the root is located up to the tolerance
+  RootFinder rootFinder(this->settings().rootFindingAlgorithm);
+  rootFinder.setInitBracket(t0, t1, guard0, guard1);
+  scalar_t query = rootFinder.getNewQuery();
+  for (int i = 0; i < this->settings().maxSingleEventIterations; i++) {
+    const scalar_t guard = interpolatedGuard(query);
+    if (std::abs(guard) < this->settings().absTolODE) {
+      break;
+    }
+    rootFinder.updateBracket(query, guard);
+    query = rootFinder.getNewQuery();
+  }
+  return query;
+}
+
 }  // namespace ocs2
@@ -59,7 +59,7 @@ vector_t TimeTriggeredRollout::run(scalar_t initTime, const vector_t& initState,
   const int numEvents = numSubsystems - 1;
 
   // max number of steps for integration
-  const auto maxNumSteps = static_cast<size_t>(this->settings().maxNumStepsPerSecond * std::max(1.0, finalTime - initTime));
+  const auto maxNumSteps = static_cast<size_t>(this->settings().maxNumStepsPerSecond * std::max(scalar_t(1.0), finalTime - initTime));
 
   // clearing the output trajectories
   timeTrajectory.clear();
@@ -115,4 +115,84 @@ vector_t TimeTriggeredRollout::run(scalar_t initTime, const vector_t& initState,
   return stateTrajectory.back();
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void TimeTriggeredRollout::runAtQueryTimes(scalar_t initTime, const vector_t& initState, ControllerBase* controller,
+                                           ModeSchedule& modeSchedule, const scalar_array_t& queryTimes, vector_array_t& queryStates) {
+  queryStates.resize(queryTimes.size());
+  if (queryTimes.empty()) {
+    return;
+  }
+  if (initTime > queryTimes.front()) {
+    throw std::runtime_error("[TimeTriggeredRollout::runAtQueryTimes] The initial time should be less-equal to the query times!");
+  }
+  if (controller == nullptr) {
+    throw std::runtime_error("[TimeTriggeredRollout::runAtQueryTimes] Controller is not set!");
+  }
+
+  // extract sub-systems
+  const auto timeIntervalArray = findActiveModesTimeInterval(initTime, queryTimes.back(), modeSchedule.eventTimes);
+  const int numSubsystems = timeIntervalArray.size();
+  const int numEvents = numSubsystems - 1;
+
+  // max number of steps for integration
+  const auto maxNumSteps =
+      static_cast<size_t>(this->settings().maxNumStepsPerSecond * std::max(scalar_t(1.0), queryTimes.back() - initTime));
+
+  systemDynamicsPtr_->setController(controller);
+  systemDynamicsPtr_->resetNumFunctionCalls();
+  systemEventHandlersPtr_->reset();
+
+  vector_t beginState = initState;
+  auto queryItr = queryTimes.cbegin();
+  auto queryStateItr = queryStates.begin();
+  for (int i = 0; i < numSubsystems; i++) {
+    const auto& interval = timeIntervalArray[i];
+
+    // the states at the query times which coincide with the start of the interval
+    for (; queryItr != queryTimes.cend() && *queryItr <= interval.first; ++queryItr, ++queryStateItr) {
+      *queryStateItr = beginState;
+    }
+    if (queryItr == queryTimes.cend()) {
+      break;
+    }
+
+    // observe the start of the interval, the query times in the interval, and the end of the interval if a jump follows
+    timeTrajectoryBuffer_.clear();
+    timeTrajectoryBuffer_.push_back(interval.first);
+    const auto firstQueryItr = queryItr;
+    for (; queryItr != queryTimes.cend() && *queryItr <= interval.second; ++queryItr) {
+      timeTrajectoryBuffer_.push_back(*queryItr);
+    }
+    if (i < numEvents && timeTrajectoryBuffer_.back() < interval.second) {
+      timeTrajectoryBuffer_.push_back(interval.second);
+    }
+
+    stateTrajectoryBuffer_.clear();
+    if (interval.first < interval.second) {
+      Observer observer(&stateTrajectoryBuffer_);
+      dynamicsIntegratorPtr_->integrateTimes(*systemDynamicsPtr_, observer, beginState, timeTrajectoryBuffer_.cbegin(),
+                                             timeTrajectoryBuffer_.cend(), this->settings().timeStep, this->settings().absTolODE,
+                                             this->settings().relTolODE, maxNumSteps);
+    } else {
+      stateTrajectoryBuffer_.assign(timeTrajectoryBuffer_.size(), beginState);
+    }
+
+    if (stateTrajectoryBuffer_.size() != timeTrajectoryBuffer_.size()) {
+      throw std::runtime_error("[TimeTriggeredRollout::runAtQueryTimes] The integration is terminated before the final query time!");
+    }
+
+    // the first observation is the start of the interval
+    const auto numQueries = std::distance(firstQueryItr, queryItr);
+    std::copy(std::next(stateTrajectoryBuffer_.cbegin()), std::next(stateTrajectoryBuffer_.cbegin(), 1 + numQueries), queryStateItr);
+    queryStateItr += numQueries;
+
+    // jump map
+    if (i < numEvents) {
+      beginState = systemDynamicsPtr_->computeJumpMap(interval.second, stateTrajectoryBuffer_.back());
+    }
+  }
+}
+
 }  // namespace ocs2
@@ -0,0 +1,167 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_oc/synchronized_module/LearnedInitializer.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <stdexcept>
+
+#include <ocs2_core/NumericTraits.h>
+
+namespace ocs2 {
+
+namespace {
+
+/** Stores the reference before each solver run and optionally exports the solution as training data after it. */
+class LearnedInitializerModule final : public SolverSynchronizedModule {
+ public:
+  LearnedInitializerModule(std::shared_ptr<LearnedInitializer::Reference> referencePtr, size_t inputDim, const std::string& dataFileName)
+      : referencePtr_(std::move(referencePtr)), inputDim_(inputDim) {
+    if (!dataFileName.empty()) {
+      dataFile_.open(dataFileName, std::ios::out | std::ios::app);
+      if (!dataFile_.is_open()) {
+        throw std::runtime_error("[LearnedInitializer] Could not open the data file " + dataFileName);
+      }
+      dataFile_ << std::setprecision(std::numeric_limits<scalar_t>::max_digits10);
+    }
+  }
+
+  void preSolverRun(scalar_t initTime, scalar_t finalTime, const vector_t& initState,
+                    const ReferenceManagerInterface& referenceManager) override {
+    auto& reference = *referencePtr_;
+    reference.targetTrajectories = referenceManager.getTargetTrajectories();
+    reference.modeSchedule = referenceManager.getModeSchedule();
+    reference.valid = true;
+  }
+
+  void postSolverRun(const PrimalSolution& primalSolution) override {
+    if (!dataFile_.is_open()) {
+      return;
+    }
+
+    const auto& t = primalSolution.timeTrajectory_;
+    const auto& x = primalSolution.stateTrajectory_;
+    const auto& u = primalSolution.inputTrajectory_;
+    const size_t N = std::min({t.size(), x.size(), u.size()});
+    for (size_t i = 0; i + 1 < N; i++) {
+      // skip the zero length intervals of the events
+      const scalar_t dt = t[i + 1] - t[i];
+      if (dt < numeric_traits::weakEpsilon<scalar_t>()) {
+        continue;
+      }
+      LearnedInitializer::computeFeatures(*referencePtr_, t[i], x[i], inputDim_, features_);
+      dataFile_ << features_.transpose() << ' ' << u[i].transpose() << ' ' << ((x[i + 1] - x[i]) / dt).transpose() << '\n';
+    }
+    dataFile_.flush();
+  }
+
+ private:
+  std::shared_ptr<LearnedInitializer::Reference> referencePtr_;
+  const size_t inputDim_;
+  std::ofstream dataFile_;
+  vector_t features_;
+};
+
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+LearnedInitializer::LearnedInitializer(MultiLayerPerceptron network, size_t stateDim, size_t inputDim,
+                                       const Initializer& fallbackInitializer)
+    : network_(std::move(network)),
+      stateDim_(stateDim),
+      inputDim_(inputDim),
+      fallbackInitializerPtr_(fallbackInitializer.clone()),
+      referencePtr_(std::make_shared<Reference>()) {
+  if (network_.getInputDim() != 2 * stateDim_ + inputDim_ + 1 || network_.getOutputDim() != inputDim_ + stateDim_) {
+    throw std::runtime_error("[LearnedInitializer] The network dimensions do not match the state and input dimensions!");
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+LearnedInitializer::LearnedInitializer(const LearnedInitializer& other)
+    : Initializer(other),
+      network_(other.network_),
+      stateDim_(other.stateDim_),
+      inputDim_(other.inputDim_),
+      fallbackInitializerPtr_(other.fallbackInitializerPtr_->clone()),
+      referencePtr_(other.referencePtr_) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LearnedInitializer::compute(scalar_t time, const vector_t& state, scalar_t nextTime, vector_t& input, vector_t& nextState) {
+  const auto& reference = *referencePtr_;
+  if (!reference.valid || static_cast<size_t>(state.size()) != stateDim_) {
+    fallbackInitializerPtr_->compute(time, state, nextTime, input, nextState);
+    return;
+  }
+
+  computeFeatures(reference, time, state, inputDim_, features_);
+  const auto& output = network_.evaluate(features_);
+  input = output.head(inputDim_);
+  nextState = state;
+  nextState.noalias() += (nextTime - time) * output.tail(stateDim_);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::shared_ptr<SolverSynchronizedModule> LearnedInitializer::getSynchronizedModule(const std::string& dataFileName) const {
+  return std::make_shared<LearnedInitializerModule>(referencePtr_, inputDim_, dataFileName);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LearnedInitializer::computeFeatures(const Reference& reference, scalar_t time, const vector_t& state, size_t inputDim,
+                                         vector_t& features) {
+  const size_t stateDim = state.size();
+  features.setZero(2 * stateDim + inputDim + 1);
+  features.head(stateDim) = state;
+
+  const auto& targetTrajectories = reference.targetTrajectories;
+  if (!targetTrajectories.empty()) {
+    if (static_cast<size_t>(targetTrajectories.stateTrajectory.front().size()) == stateDim) {
+      features.segment(stateDim, stateDim) = targetTrajectories.getDesiredState(time);
+    }
+    if (!targetTrajectories.inputTrajectory.empty() && static_cast<size_t>(targetTrajectories.inputTrajectory.front().size()) == inputDim) {
+      features.segment(2 * stateDim, inputDim) = targetTrajectories.getDesiredInput(time);
+    }
+  }
+  features(2 * stateDim + inputDim) = static_cast<scalar_t>(reference.modeSchedule.modeAtTime(time));
+}
+
+}  // namespace ocs2
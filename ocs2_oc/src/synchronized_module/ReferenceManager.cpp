@@ -35,15 +35,54 @@ namespace ocs2 {
 /******************************************************************************************************/
 /******************************************************************************************************/
 ReferenceManager::ReferenceManager(TargetTrajectories initialTargetTrajectories, ModeSchedule initialModeSchedule)
-    : targetTrajectories_(std::move(initialTargetTrajectories)), modeSchedule_(std::move(initialModeSchedule)) {}
+    : modeSchedule_(initialModeSchedule),
+      modeScheduleLookup_(std::move(initialModeSchedule)),
+      targetTrajectories_(std::move(initialTargetTrajectories)) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ReferenceManager::setTargetTrajectories(const TargetTrajectories& targetTrajectories) {
+  std::lock_guard<std::mutex> lock(appendedSegmentsMutex_);
+  appendedSegments_.clear();
+  targetTrajectories_.setBuffer(targetTrajectories);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ReferenceManager::setTargetTrajectories(TargetTrajectories&& targetTrajectories) {
+  std::lock_guard<std::mutex> lock(appendedSegmentsMutex_);
+  appendedSegments_.clear();
+  targetTrajectories_.setBuffer(std::move(targetTrajectories));
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ReferenceManager::appendTargetTrajectories(const TargetTrajectories& targetTrajectoriesSegment) {
+  std::lock_guard<std::mutex> lock(appendedSegmentsMutex_);
+  appendedSegments_.append(targetTrajectoriesSegment);
+}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 void ReferenceManager::preSolverRun(scalar_t initTime, scalar_t finalTime, const vector_t& initState) {
-  targetTrajectories_.updateFromBuffer();
+  {
+    // the lock orders the buffered TargetTrajectories before the segments which are appended to it
+    std::lock_guard<std::mutex> lock(appendedSegmentsMutex_);
+    targetTrajectories_.updateFromBuffer();
+    if (!appendedSegments_.empty()) {
+      auto& targetTrajectories = targetTrajectories_.get();
+      targetTrajectories.append(appendedSegments_);
+      targetTrajectories.trimBefore(initTime);
+      appendedSegments_.clear();
+    }
+  }
   modeSchedule_.updateFromBuffer();
   modifyReferences(initTime, finalTime, initState, targetTrajectories_.get(), modeSchedule_.get());
+  modeScheduleLookup_.setModeSchedule(modeSchedule_.get());
 }
 
 }  // namespace ocs2
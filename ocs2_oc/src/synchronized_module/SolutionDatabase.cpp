@@ -0,0 +1,269 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_oc/synchronized_module/SolutionDatabase.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <numeric>
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t SolutionDatabase::Statistics::getHitRate() const {
+  return (numQueries > 0) ? static_cast<scalar_t>(numHits) / static_cast<scalar_t>(numQueries) : 0.0;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t SolutionDatabase::Statistics::getIterationSaving() const {
+  const size_t numMisses = numQueries - numHits;
+  if (numHits == 0 || numMisses == 0) {
+    return 0.0;
+  }
+  return static_cast<scalar_t>(numIterationsOfMisses) / static_cast<scalar_t>(numMisses) -
+         static_cast<scalar_t>(numIterationsOfHits) / static_cast<scalar_t>(numHits);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+SolutionDatabase::SolutionDatabase(SolverBase& solver, SolutionDatabaseSettings settings, feature_function_t featureFunction)
+    : solver_(solver),
+      settings_(std::move(settings)),
+      featureFunction_(featureFunction != nullptr ? std::move(featureFunction) : feature_function_t(&SolutionDatabase::defaultFeature)) {
+  if (settings_.maxNumSolutions == 0) {
+    throw std::runtime_error("[SolutionDatabase] The maximum number of solutions should be positive!");
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SolutionDatabase::preSolverRun(scalar_t initTime, scalar_t finalTime, const vector_t& initState,
+                                    const ReferenceManagerInterface& referenceManager) {
+  feature_ = featureFunction_(initTime, finalTime, initState, referenceManager.getTargetTrajectories());
+  statistics_.numRuns++;
+
+  // the shifted previous solution is a poor guess if there is none (e.g. after a reset) or if the problem jumped (e.g. a new target)
+  const bool hasPreviousSolution = solver_.getNumIterations() > 0 && previousFeature_.size() == feature_.size();
+  const bool isPoorGuess = !hasPreviousSolution || (feature_ - previousFeature_).norm() > settings_.jumpDistance;
+  previousFeature_ = feature_;
+
+  query_ = Query::None;
+  if (isPoorGuess) {
+    statistics_.numQueries++;
+    scalar_t distance;
+    const size_t index = findNearest(feature_, distance);
+    if (index < entries_.size() && distance <= settings_.maxQueryDistance) {
+      solver_.setWarmStart(entries_[index].primalSolution, entries_[index].dualSolution);
+      statistics_.numHits++;
+      query_ = Query::Hit;
+    } else {
+      query_ = Query::Miss;
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SolutionDatabase::postSolverRun(const PrimalSolution& primalSolution) {
+  const size_t numIterations = solver_.getRunStatistics().numIterations;
+  if (query_ == Query::Hit) {
+    statistics_.numIterationsOfHits += numIterations;
+  } else if (query_ == Query::Miss) {
+    statistics_.numIterationsOfMisses += numIterations;
+  }
+
+  const auto& performance = solver_.getPerformanceIndeces();
+  const bool converged = !performance.deadlineReached &&
+                         performance.dynamicsViolationSSE + performance.equalityConstraintsSSE <= settings_.convergenceTolerance;
+  if (converged && !primalSolution.timeTrajectory_.empty()) {
+    insert(feature_, primalSolution, solver_.getDualSolution());
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SolutionDatabase::insert(const vector_t& feature, PrimalSolution primalSolution, DualSolution dualSolution) {
+  if (primalSolution.timeTrajectory_.empty()) {
+    throw std::runtime_error("[SolutionDatabase] The primal solution is empty!");
+  }
+  if (!entries_.empty() && feature.size() != entries_.front().feature.size()) {
+    throw std::runtime_error("[SolutionDatabase] The feature size " + std::to_string(feature.size()) +
+                             " does not match the stored features of size " + std::to_string(entries_.front().feature.size()) + "!");
+  }
+
+  // a solution which is close to a stored one replaces its solution, such that recurring problems do not grow the database
+  scalar_t distance;
+  const size_t nearestIndex = findNearest(feature, distance);
+  if (nearestIndex < entries_.size() && distance < settings_.minInsertDistance) {
+    entries_[nearestIndex].primalSolution.swap(primalSolution);
+    entries_[nearestIndex].dualSolution.swap(dualSolution);
+    return;
+  }
+
+  if (entries_.size() < settings_.maxNumSolutions) {
+    entries_.push_back({feature, std::move(primalSolution), std::move(dualSolution)});
+    addToTree(entries_.size() - 1);
+  } else {
+    entries_[oldestEntryIndex_] = {feature, std::move(primalSolution), std::move(dualSolution)};
+    oldestEntryIndex_ = (oldestEntryIndex_ + 1) % entries_.size();
+    rebuildTree();
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t SolutionDatabase::findNearest(const vector_t& feature, scalar_t& distance) const {
+  size_t nearestIndex = entries_.size();
+  scalar_t nearestSquaredDistance = std::numeric_limits<scalar_t>::infinity();
+  if (!entries_.empty() && feature.size() == entries_.front().feature.size()) {
+    searchSubtree(0, feature, nearestIndex, nearestSquaredDistance);
+  }
+  distance = std::sqrt(nearestSquaredDistance);
+  return nearestIndex;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t SolutionDatabase::defaultFeature(scalar_t initTime, scalar_t finalTime, const vector_t& initState,
+                                          const TargetTrajectories& targetTrajectories) {
+  if (targetTrajectories.empty()) {
+    return initState;
+  }
+  const vector_t targetState = targetTrajectories.getDesiredState(finalTime);
+  vector_t feature(initState.size() + targetState.size());
+  feature << initState, targetState;
+  return feature;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SolutionDatabase::addToTree(size_t entryIndex) {
+  const auto& feature = entries_[entryIndex].feature;
+  if (tree_.empty()) {
+    tree_.push_back(Node{entryIndex, 0, -1, -1});
+    return;
+  }
+
+  int nodeIndex = 0;
+  while (true) {
+    auto& node = tree_[nodeIndex];
+    int& child = (feature(node.axis) < entries_[node.entryIndex].feature(node.axis)) ? node.left : node.right;
+    if (child < 0) {
+      const size_t axis = (node.axis + 1) % feature.size();
+      child = static_cast<int>(tree_.size());
+      tree_.push_back(Node{entryIndex, axis, -1, -1});  // invalidates node and child
+      return;
+    }
+    nodeIndex = child;
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SolutionDatabase::rebuildTree() {
+  tree_.clear();
+  tree_.reserve(entries_.size());
+  std::vector<size_t> entryIndices(entries_.size());
+  std::iota(entryIndices.begin(), entryIndices.end(), 0);
+  buildSubtree(entryIndices, 0, entryIndices.size(), 0);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+int SolutionDatabase::buildSubtree(std::vector<size_t>& entryIndices, size_t begin, size_t end, size_t depth) {
+  if (begin >= end) {
+    return -1;
+  }
+
+  // split at the median along the axis of this depth
+  const size_t axis = depth % entries_.front().feature.size();
+  const size_t median = begin + (end - begin) / 2;
+  std::nth_element(entryIndices.begin() + begin, entryIndices.begin() + median, entryIndices.begin() + end,
+                   [&](size_t a, size_t b) { return entries_[a].feature(axis) < entries_[b].feature(axis); });
+
+  const auto nodeIndex = static_cast<int>(tree_.size());
+  tree_.push_back(Node{entryIndices[median], axis, -1, -1});
+  const int left = buildSubtree(entryIndices, begin, median, depth + 1);
+  const int right = buildSubtree(entryIndices, median + 1, end, depth + 1);
+  tree_[nodeIndex].left = left;
+  tree_[nodeIndex].right = right;
+  return nodeIndex;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SolutionDatabase::searchSubtree(int nodeIndex, const vector_t& feature, size_t& nearestIndex,
+                                     scalar_t& nearestSquaredDistance) const {
+  if (nodeIndex < 0) {
+    return;
+  }
+
+  const auto& node = tree_[nodeIndex];
+  const auto& nodeFeature = entries_[node.entryIndex].feature;
+  const scalar_t squaredDistance = (nodeFeature - feature).squaredNorm();
+  if (squaredDistance < nearestSquaredDistance) {
+    nearestSquaredDistance = squaredDistance;
+    nearestIndex = node.entryIndex;
+  }
+
+  // the far side of the splitting plane is only searched if it may contain a nearer feature
+  const scalar_t axisDistance = feature(node.axis) - nodeFeature(node.axis);
+  searchSubtree(axisDistance < 0.0 ? node.left : node.right, feature, nearestIndex, nearestSquaredDistance);
+  if (axisDistance * axisDistance < nearestSquaredDistance) {
+    searchSubtree(axisDistance < 0.0 ? node.right : node.left, feature, nearestIndex, nearestSquaredDistance);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::ostream& operator<<(std::ostream& stream, const SolutionDatabase::Statistics& statistics) {
+  stream << "Solution database: " << statistics.numRuns << " runs, " << statistics.numQueries << " queries, " << statistics.numHits
+         << " hits (hit rate " << 100.0 * statistics.getHitRate() << " %), " << statistics.getIterationSaving()
+         << " iterations saved per hit\n";
+  return stream;
+}
+
+}  // namespace ocs2
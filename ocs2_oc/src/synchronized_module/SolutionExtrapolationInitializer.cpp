@@ -0,0 +1,118 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_oc/synchronized_module/SolutionExtrapolationInitializer.h"
+
+#include <ocs2_core/control/LinearController.h>
+#include <ocs2_core/integration/SensitivityIntegratorImpl.h>
+
+namespace ocs2 {
+
+namespace {
+
+/** Extracts the tail of the primal solution after each solver run. */
+class SolutionTailModule final : public SolverSynchronizedModule {
+ public:
+  explicit SolutionTailModule(std::shared_ptr<SolutionExtrapolationInitializer::SolutionTail> solutionTailPtr)
+      : solutionTailPtr_(std::move(solutionTailPtr)) {}
+
+  void preSolverRun(scalar_t initTime, scalar_t finalTime, const vector_t& initState,
+                    const ReferenceManagerInterface& referenceManager) override {}
+
+  void postSolverRun(const PrimalSolution& primalSolution) override {
+    auto& tail = *solutionTailPtr_;
+    tail.valid = !primalSolution.timeTrajectory_.empty() && !primalSolution.inputTrajectory_.empty();
+    if (!tail.valid) {
+      return;
+    }
+
+    tail.time = primalSolution.timeTrajectory_.back();
+    tail.state = primalSolution.stateTrajectory_.back();
+    tail.input = primalSolution.inputTrajectory_.back();
+
+    const auto* linearControllerPtr = dynamic_cast<const LinearController*>(primalSolution.controllerPtr_.get());
+    if (linearControllerPtr != nullptr && !linearControllerPtr->gainArray_.empty() &&
+        linearControllerPtr->gainArray_.back().rows() == tail.input.size() &&
+        linearControllerPtr->gainArray_.back().cols() == tail.state.size()) {
+      tail.gain = linearControllerPtr->gainArray_.back();
+    } else {
+      tail.gain.resize(0, 0);
+    }
+  }
+
+ private:
+  std::shared_ptr<SolutionExtrapolationInitializer::SolutionTail> solutionTailPtr_;
+};
+
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+SolutionExtrapolationInitializer::SolutionExtrapolationInitializer(const SystemDynamicsBase& dynamics,
+                                                                   const Initializer& fallbackInitializer)
+    : dynamicsPtr_(dynamics.clone()),
+      fallbackInitializerPtr_(fallbackInitializer.clone()),
+      solutionTailPtr_(std::make_shared<SolutionTail>()) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+SolutionExtrapolationInitializer::SolutionExtrapolationInitializer(const SolutionExtrapolationInitializer& other)
+    : Initializer(other),
+      dynamicsPtr_(other.dynamicsPtr_->clone()),
+      fallbackInitializerPtr_(other.fallbackInitializerPtr_->clone()),
+      solutionTailPtr_(other.solutionTailPtr_) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SolutionExtrapolationInitializer::compute(scalar_t time, const vector_t& state, scalar_t nextTime, vector_t& input,
+                                               vector_t& nextState) {
+  const auto& tail = *solutionTailPtr_;
+  if (!tail.valid || time < tail.time || state.size() != tail.state.size()) {
+    fallbackInitializerPtr_->compute(time, state, nextTime, input, nextState);
+    return;
+  }
+
+  input = tail.input;
+  if (tail.gain.size() > 0) {
+    input.noalias() += tail.gain * (state - tail.state);
+  }
+  nextState = (nextTime > time) ? rk4Discretization(*dynamicsPtr_, time, state, input, nextTime - time) : state;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::shared_ptr<SolverSynchronizedModule> SolutionExtrapolationInitializer::getSynchronizedModule() const {
+  return std::make_shared<SolutionTailModule>(solutionTailPtr_);
+}
+
+}  // namespace ocs2
@@ -368,6 +368,19 @@ void TrajectorySpreading::computeSpreadingStrategy(const scalar_array_t& oldTime
       updatedMatchedEventTimes_.push_back(newMatchedEventTimes[j]);
     }
   }  // end of j loop
+
+  // a spreading value should be set aside if it is erased or it is overwritten by an earlier interval
+  isSpreadingValueOverwritten_.assign(spreadingValueIndices_.size(), false);
+  numOverwrittenSpreadingValues_ = 0;
+  for (size_t i = 0; i < spreadingValueIndices_.size(); i++) {
+    const auto ind = spreadingValueIndices_[i];
+    bool isOverwritten = ind >= eraseFromIndex_;
+    for (size_t j = 0; j < i && !isOverwritten; j++) {
+      isOverwritten = beginIndices_[j] <= ind && ind < endIndices_[j];
+    }
+    isSpreadingValueOverwritten_[i] = isOverwritten;
+    numOverwrittenSpreadingValues_ += isOverwritten ? 1 : 0;
+  }  // end of i loop
 }
 
 /******************************************************************************************************/
@@ -0,0 +1,137 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+
+#include <gtest/gtest.h>
+
+#include "ocs2_oc/oc_solver/PartitionedRiccatiSolver.h"
+#include "ocs2_oc/test/testProblemsGeneration.h"
+
+using namespace ocs2;
+
+namespace {
+/** Random LQ problem with stable-ish dynamics and an event stage without inputs in the middle of the horizon */
+struct RandomLqProblem {
+  RandomLqProblem(int N, int nx, int nu) {
+    const int eventStage = N / 2;
+    for (int k = 0; k < N; ++k) {
+      const int m = (k == eventStage) ? 0 : nu;
+      auto stageDynamics = getRandomDynamics(nx, m);
+      stageDynamics.dfdx = matrix_t::Identity(nx, nx) + 0.1 * stageDynamics.dfdx;
+      dynamics.push_back(std::move(stageDynamics));
+      auto stageCost = getRandomCost(nx, m);
+      stageCost.dfduu.diagonal().array() += 0.1;
+      cost.push_back(std::move(stageCost));
+    }
+    cost.push_back(getRandomCost(nx, 0));
+    x0 = vector_t::Random(nx);
+  }
+
+  vector_t x0;
+  std::vector<VectorFunctionLinearApproximation> dynamics;
+  std::vector<ScalarFunctionQuadraticApproximation> cost;
+};
+}  // namespace
+
+class PartitionedRiccatiSolverTest : public testing::TestWithParam<size_t> {
+ protected:
+  static constexpr int N = 20;
+  static constexpr int nx = 4;
+  static constexpr int nu = 3;
+  static constexpr scalar_t tol = 1e-8;
+
+  PartitionedRiccatiSolverTest() : problem(N, nx, nu), threadPool(3) {}
+
+  RandomLqProblem problem;
+  ThreadPool threadPool;
+};
+
+constexpr int PartitionedRiccatiSolverTest::N;
+constexpr int PartitionedRiccatiSolverTest::nx;
+constexpr int PartitionedRiccatiSolverTest::nu;
+constexpr scalar_t PartitionedRiccatiSolverTest::tol;
+
+TEST_P(PartitionedRiccatiSolverTest, optimality) {
+  PartitionedRiccatiSolver solver(GetParam());
+  vector_array_t xSol, uSol;
+  solver.solve(problem.x0, problem.dynamics, problem.cost, threadPool, xSol, uSol);
+  const auto& costToGo = solver.getRiccatiCostToGo();
+
+  ASSERT_EQ(xSol.size(), N + 1);
+  ASSERT_EQ(uSol.size(), N);
+  ASSERT_EQ(costToGo.size(), N + 1);
+  EXPECT_TRUE(xSol[0].isApprox(problem.x0));
+
+  // The costate is the gradient of the cost-to-go: lambda_k = P_k x_k + p_k
+  vector_array_t costate(N + 1);
+  for (int k = 0; k <= N; ++k) {
+    costate[k] = costToGo[k].dfdx + costToGo[k].dfdxx * xSol[k];
+  }
+
+  // KKT conditions of the LQ problem
+  EXPECT_TRUE(costate[N].isApprox(problem.cost[N].dfdx + problem.cost[N].dfdxx * xSol[N], tol));
+  for (int k = 0; k < N; ++k) {
+    const auto& A = problem.dynamics[k].dfdx;
+    const auto& B = problem.dynamics[k].dfdu;
+    const auto& L = problem.cost[k];
+    const vector_t nextState = A * xSol[k] + B * uSol[k] + problem.dynamics[k].f;
+    EXPECT_TRUE(xSol[k + 1].isApprox(nextState, tol));
+
+    const vector_t costateRecursion = L.dfdxx * xSol[k] + L.dfdux.transpose() * uSol[k] + L.dfdx + A.transpose() * costate[k + 1];
+    EXPECT_TRUE(costate[k].isApprox(costateRecursion, tol)) << "at stage " << k;
+
+    if (uSol[k].size() > 0) {
+      const vector_t inputGradient = L.dfduu * uSol[k] + L.dfdux * xSol[k] + L.dfdu + B.transpose() * costate[k + 1];
+      EXPECT_LT(inputGradient.norm(), tol) << "at stage " << k;
+    }
+  }
+}
+
+TEST_P(PartitionedRiccatiSolverTest, compareToSequential) {
+  PartitionedRiccatiSolver sequentialSolver;
+  vector_array_t xSequential, uSequential;
+  sequentialSolver.solve(problem.x0, problem.dynamics, problem.cost, threadPool, xSequential, uSequential);
+
+  PartitionedRiccatiSolver partitionedSolver(GetParam());
+  vector_array_t xPartitioned, uPartitioned;
+  partitionedSolver.solve(problem.x0, problem.dynamics, problem.cost, threadPool, xPartitioned, uPartitioned);
+
+  for (int k = 0; k <= N; ++k) {
+    EXPECT_TRUE(xPartitioned[k].isApprox(xSequential[k], tol));
+    EXPECT_TRUE(partitionedSolver.getRiccatiCostToGo()[k].dfdxx.isApprox(sequentialSolver.getRiccatiCostToGo()[k].dfdxx, tol));
+    EXPECT_TRUE(partitionedSolver.getRiccatiCostToGo()[k].dfdx.isApprox(sequentialSolver.getRiccatiCostToGo()[k].dfdx, tol));
+  }
+  for (int k = 0; k < N; ++k) {
+    EXPECT_TRUE(uPartitioned[k].isApprox(uSequential[k], tol));
+    EXPECT_TRUE(partitionedSolver.getRiccatiFeedback()[k].isApprox(sequentialSolver.getRiccatiFeedback()[k], tol));
+    EXPECT_TRUE(partitionedSolver.getRiccatiFeedforward()[k].isApprox(sequentialSolver.getRiccatiFeedforward()[k], tol));
+  }
+}
+
+INSTANTIATE_TEST_CASE_P(NumPartitions, PartitionedRiccatiSolverTest, testing::Values(1, 2, 3, 4, 7, 20, 25));
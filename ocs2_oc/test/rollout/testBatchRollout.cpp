@@ -0,0 +1,93 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <memory>
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/control/LinearController.h>
+#include <ocs2_core/dynamics/LinearSystemDynamics.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
+#include <ocs2_oc/rollout/BatchRollout.h>
+#include <ocs2_oc/rollout/TimeTriggeredRollout.h>
+
+using namespace ocs2;
+
+TEST(BatchRollout, matchesSequentialRollout) {
+  constexpr size_t nx = 2;
+  constexpr size_t nu = 1;
+  constexpr size_t batchSize = 7;
+  const scalar_t initTime = 0.0;
+  const scalar_t finalTime = 2.0;
+  const vector_t initState = vector_t::Zero(nx);
+  const ModeSchedule modeSchedule;
+
+  const matrix_t A = (matrix_t(nx, nx) << -2.0, -1.0, 1.0, 0.0).finished();
+  const matrix_t B = (matrix_t(nx, nu) << 1.0, 0.0).finished();
+  LinearSystemDynamics systemDynamics(A, B);
+
+  rollout::Settings rolloutSettings;
+  rolloutSettings.timeStep = 1e-2;
+  TimeTriggeredRollout rollout(systemDynamics, rolloutSettings);
+
+  // the feedforward input of the candidates is spread around the best candidate with uff = 0
+  const scalar_array_t timeStamps{initTime, finalTime};
+  std::vector<LinearController> candidates;
+  for (size_t i = 0; i < batchSize; i++) {
+    const vector_array_t uff(2, vector_t::Constant(nu, static_cast<scalar_t>(i) - 4.0));
+    candidates.emplace_back(timeStamps, uff, matrix_array_t(2, matrix_t::Zero(nu, nx)));
+  }
+  std::vector<ControllerBase*> controllers;
+  for (auto& c : candidates) {
+    controllers.push_back(&c);
+  }
+
+  auto merit = [](const PrimalSolution& solution) { return solution.stateTrajectory_.back().squaredNorm(); };
+
+  ThreadPool threadPool(3);
+  BatchRollout batchRollout(rollout, threadPool);
+  ASSERT_EQ(batchRollout.numThreads(), 4);
+
+  std::vector<PrimalSolution> solutions;
+  const auto bestIndex = batchRollout.run(initTime, initState, finalTime, controllers, modeSchedule, merit, solutions);
+  ASSERT_EQ(solutions.size(), batchSize);
+  EXPECT_EQ(bestIndex, 4);
+  EXPECT_DOUBLE_EQ(batchRollout.getMerits()[bestIndex], 0.0);
+
+  for (size_t i = 0; i < batchSize; i++) {
+    ModeSchedule modeScheduleTemp = modeSchedule;
+    PrimalSolution expected;
+    rollout.run(initTime, initState, finalTime, controllers[i], modeScheduleTemp, expected.timeTrajectory_, expected.postEventIndices_,
+                expected.stateTrajectory_, expected.inputTrajectory_);
+    ASSERT_EQ(solutions[i].timeTrajectory_.size(), expected.timeTrajectory_.size());
+    EXPECT_TRUE(solutions[i].stateTrajectory_.back().isApprox(expected.stateTrajectory_.back()));
+    EXPECT_DOUBLE_EQ(batchRollout.getMerits()[i], merit(expected));
+  }
+}
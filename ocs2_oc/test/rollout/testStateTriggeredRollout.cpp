@@ -27,6 +27,10 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
+#include <chrono>
+#include <iostream>
+#include <memory>
+
 #include <gtest/gtest.h>
 
 #include <ocs2_core/Types.h>
@@ -302,3 +306,70 @@ TEST(StateRolloutTests, runHybridDynamics) {
     EXPECT_NEAR(eventTestTimes[i], modeSchedule.eventTimes[i], 1e-6);
   }
 }
+
+/*
+ *     Benchmark of the event localization of StateTriggeredRollout. The rollout is wrapped such that the flow map calls of the
+ *     integration are counted. The number of calls per event is dominated by the steps spent on locating the guard crossings.
+ */
+namespace {
+class FunctionCallCounter final : public ocs2::ControlledSystemBase {
+ public:
+  explicit FunctionCallCounter(const ocs2::ControlledSystemBase& system)
+      : systemPtr_(system.clone()), numFlowMapCallsPtr_(std::make_shared<size_t>(0)) {}
+  FunctionCallCounter(const FunctionCallCounter& other)
+      : ocs2::ControlledSystemBase(other), systemPtr_(other.systemPtr_->clone()), numFlowMapCallsPtr_(other.numFlowMapCallsPtr_) {}
+  FunctionCallCounter* clone() const override { return new FunctionCallCounter(*this); }
+
+  vector_t computeFlowMap(scalar_t t, const vector_t& x, const vector_t& u, const ocs2::PreComputation& preComp) override {
+    ++(*numFlowMapCallsPtr_);
+    return systemPtr_->computeFlowMap(t, x, u, preComp);
+  }
+  vector_t computeJumpMap(scalar_t t, const vector_t& x, const ocs2::PreComputation& preComp) override {
+    return systemPtr_->computeJumpMap(t, x, preComp);
+  }
+  vector_t computeGuardSurfaces(scalar_t t, const vector_t& x) override { return systemPtr_->computeGuardSurfaces(t, x); }
+
+  size_t numFlowMapCalls() const { return *numFlowMapCallsPtr_; }
+
+ private:
+  std::unique_ptr<ocs2::ControlledSystemBase> systemPtr_;
+  std::shared_ptr<size_t> numFlowMapCallsPtr_;
+};
+
+void benchmarkEventLocalization(const std::string& name, const ocs2::ControlledSystemBase& system, const ocs2::rollout::Settings& settings,
+                                const vector_t& initState, scalar_t finalTime) {
+  constexpr size_t numRuns = 20;
+  const FunctionCallCounter countingSystem(system);
+  ocs2::StateTriggeredRollout rollout(countingSystem, settings);
+  ocs2::LinearController controller({0.0}, {vector_t::Zero(1)}, {matrix_t::Zero(1, initState.size())});
+
+  scalar_array_t timeTrajectory;
+  size_array_t postEventIndices;
+  vector_array_t stateTrajectory;
+  vector_array_t inputTrajectory;
+  ocs2::ModeSchedule modeSchedule;
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < numRuns; i++) {
+    rollout.run(0.0, initState, finalTime, &controller, modeSchedule, timeTrajectory, postEventIndices, stateTrajectory, inputTrajectory);
+  }
+  const auto end = std::chrono::steady_clock::now();
+  const auto runTime = std::chrono::duration<scalar_t, std::milli>(end - start).count() / numRuns;
+
+  // the counter is shared with the clone inside of the rollout
+  const auto numCalls = countingSystem.numFlowMapCalls() / numRuns;
+  std::cerr << "[" << name << "] events: " << modeSchedule.eventTimes.size() << ", flow map calls: " << numCalls
+            << ", time per rollout: " << runTime << " [ms]\n";
+  EXPECT_FALSE(modeSchedule.eventTimes.empty());
+}
+}  // namespace
+
+TEST(StateRolloutTests, benchmarkEventLocalization) {
+  ocs2::rollout::Settings ballSettings;
+  ballSettings.absTolODE = 1e-10;
+  ballSettings.relTolODE = 1e-7;
+  ballSettings.timeStep = 1e-3;
+  benchmarkEventLocalization("ball", ocs2::ballDyn(), ballSettings, (vector_t(2) << 1.0, 0.0).finished(), 10.0);
+
+  const ocs2::rollout::Settings pendulumSettings;
+  benchmarkEventLocalization("pendulum", ocs2::pendulum_dyn(), pendulumSettings, (vector_t(2) << 3.1415, 0.0).finished(), 15.0);
+}
@@ -87,3 +87,49 @@ TEST(time_rollout_test, time_rollout_test) {
   ASSERT_EQ(totalSize, stateTrajectory.size());
   ASSERT_EQ(totalSize, inputTrajectory.size());
 }
+
+TEST(time_rollout_test, runAtQueryTimes) {
+  constexpr size_t nx = 2;
+  constexpr size_t nu = 1;
+  const scalar_t initTime = 0.0;
+  const scalar_t finalTime = 5.0;
+  const vector_t initState = vector_t::Ones(nx);
+
+  // the jump map of the linear system is the identity, therefore the events only split the integration
+  ModeSchedule modeSchedule({1.0, 2.5}, {0, 1, 2});
+
+  const matrix_t A = (matrix_t(nx, nx) << -2.0, -1.0, 1.0, 0.0).finished();
+  const matrix_t B = (matrix_t(nx, nu) << 1.0, 0.0).finished();
+  LinearSystemDynamics systemDynamics(A, B);
+
+  const scalar_array_t cntTimeStamp{initTime, finalTime};
+  const vector_array_t uff(2, vector_t::Ones(nu));
+  const matrix_array_t k(2, matrix_t::Ones(nu, nx));
+  LinearController controller(cntTimeStamp, uff, k);
+
+  rollout::Settings rolloutSettings;
+  rolloutSettings.absTolODE = 1e-9;
+  rolloutSettings.relTolODE = 1e-7;
+  TimeTriggeredRollout rollout(systemDynamics, rolloutSettings);
+
+  // query times at the initial time, at an event, and in between
+  const scalar_array_t queryTimes{0.0, 0.3, 1.0, 1.7, 2.5, 4.2, 5.0};
+  vector_array_t queryStates;
+  rollout.runAtQueryTimes(initTime, initState, &controller, modeSchedule, queryTimes, queryStates);
+  ASSERT_EQ(queryStates.size(), queryTimes.size());
+
+  // each query state is compared against a full rollout which ends at the query time
+  for (size_t i = 0; i < queryTimes.size(); i++) {
+    scalar_array_t timeTrajectory;
+    size_array_t postEventIndices;
+    vector_array_t stateTrajectory;
+    vector_array_t inputTrajectory;
+    rollout.run(initTime, initState, queryTimes[i], &controller, modeSchedule, timeTrajectory, postEventIndices, stateTrajectory,
+                inputTrajectory);
+    EXPECT_TRUE(queryStates[i].isApprox(stateTrajectory.back(), 1e-6)) << "query time: " << queryTimes[i];
+  }
+
+  // the buffers are reused for a second call
+  rollout.runAtQueryTimes(initTime, initState, &controller, modeSchedule, {finalTime}, queryStates);
+  ASSERT_EQ(queryStates.size(), 1);
+}
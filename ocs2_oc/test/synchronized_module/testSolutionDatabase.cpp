@@ -0,0 +1,105 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <limits>
+
+#include "ocs2_oc/synchronized_module/SolutionDatabase.h"
+
+using namespace ocs2;
+
+namespace {
+
+/** A solver which is never run, since the database is only filled and queried directly. */
+class DummySolver final : public SolverBase {
+ public:
+  void reset() override {}
+  const OptimalControlProblem& getOptimalControlProblem() const override { return problem_; }
+  const PerformanceIndex& getPerformanceIndeces() const override { return performanceIndex_; }
+  size_t getNumIterations() const override { return 0; }
+  const std::vector<PerformanceIndex>& getIterationsLog() const override { return iterationsLog_; }
+  scalar_t getFinalTime() const override { return 0.0; }
+  void getPrimalSolution(scalar_t finalTime, PrimalSolution* primalSolutionPtr) const override {}
+  const DualSolution& getDualSolution() const override { return dualSolution_; }
+  const ProblemMetrics& getSolutionMetrics() const override { return problemMetrics_; }
+  ScalarFunctionQuadraticApproximation getValueFunction(scalar_t time, const vector_t& state) const override { return {}; }
+  ScalarFunctionQuadraticApproximation getHamiltonian(scalar_t time, const vector_t& state, const vector_t& input) override { return {}; }
+  vector_t getStateInputEqualityConstraintLagrangian(scalar_t time, const vector_t& state) const override { return {}; }
+  MultiplierCollection getIntermediateDualSolution(scalar_t time) const override { return {}; }
+
+ private:
+  void runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime) override {}
+  void runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime, const ControllerBase* externalControllerPtr) override {}
+  void runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime, const PrimalSolution& primalSolution) override {}
+
+  OptimalControlProblem problem_;
+  PerformanceIndex performanceIndex_;
+  std::vector<PerformanceIndex> iterationsLog_;
+  DualSolution dualSolution_;
+  ProblemMetrics problemMetrics_;
+};
+
+}  // unnamed namespace
+
+TEST(testSolutionDatabase, nearestNeighbour) {
+  DummySolver solver;
+  SolutionDatabaseSettings settings;
+  settings.maxNumSolutions = 50;
+  settings.minInsertDistance = 0.0;
+  SolutionDatabase database(solver, settings);
+
+  // more features than the capacity, such that the KD-tree is also rebuilt
+  PrimalSolution primalSolution;
+  primalSolution.timeTrajectory_ = {0.0};
+  std::vector<vector_t> features;
+  for (size_t i = 0; i < 80; i++) {
+    features.push_back(vector_t::Random(4));
+    database.insert(features.back(), primalSolution, DualSolution());
+  }
+  ASSERT_EQ(database.size(), settings.maxNumSolutions);
+  const std::vector<vector_t> storedFeatures(features.end() - settings.maxNumSolutions, features.end());
+
+  for (size_t i = 0; i < 100; i++) {
+    const vector_t query = vector_t::Random(4);
+    scalar_t expectedDistance = std::numeric_limits<scalar_t>::infinity();
+    for (const auto& feature : storedFeatures) {
+      expectedDistance = std::min(expectedDistance, (feature - query).norm());
+    }
+    scalar_t distance;
+    EXPECT_LT(database.findNearest(query, distance), database.size());
+    EXPECT_DOUBLE_EQ(distance, expectedDistance);
+  }
+
+  // features of another size are not found
+  scalar_t distance;
+  EXPECT_EQ(database.findNearest(vector_t::Random(3), distance), database.size());
+  EXPECT_ANY_THROW(database.insert(vector_t::Random(3), primalSolution, DualSolution()));
+}
@@ -63,6 +63,17 @@ vector_t evaluate(const VectorFunctionLinearApproximation& vectorFunctionLinearA
   b.noalias() += B * du;
   return b;
 }
+
+bool isApprox(const ScalarFunctionQuadraticApproximation& lhs, const ScalarFunctionQuadraticApproximation& rhs) {
+  const scalar_t prec = 1e-9;
+  return std::abs(lhs.f - rhs.f) < prec && lhs.dfdx.isApprox(rhs.dfdx, prec) && lhs.dfdu.isApprox(rhs.dfdu, prec) &&
+         lhs.dfdxx.isApprox(rhs.dfdxx, prec) && lhs.dfdux.isApprox(rhs.dfdux, prec) && lhs.dfduu.isApprox(rhs.dfduu, prec);
+}
+
+bool isApprox(const VectorFunctionLinearApproximation& lhs, const VectorFunctionLinearApproximation& rhs) {
+  const scalar_t prec = 1e-9;
+  return lhs.f.isApprox(rhs.f, prec) && lhs.dfdx.isApprox(rhs.dfdx, prec) && lhs.dfdu.isApprox(rhs.dfdu, prec);
+}
 }  // namespace
 
 TEST(quadratic_change_of_input_variables, noPx_noU0) {
@@ -255,4 +266,95 @@ TEST(linear_change_of_input_variables, bothPx_U0) {
   const vector_t unprojected = evaluate(linear, dx, Pu * du_tilde + Px * dx + u0);
   const vector_t projected = evaluate(linearProjected, dx, du_tilde);
   ASSERT_TRUE(unprojected.isApprox(projected));
-}
\ No newline at end of file
+}
+
+TEST(quadratic_change_of_input_variables, toOutput) {
+  const int n = 4;
+  const int m = 3;
+  const int p = 2;
+
+  // Create change of variables
+  const matrix_t Pu = matrix_t::Random(m, p);
+  const matrix_t Px = matrix_t::Random(m, n);
+  const vector_t u0 = vector_t::Random(m);
+  const auto quadratic = getRandomCost(n, m);
+
+  // Apply change of variables in place and to an output
+  auto quadraticProjected = quadratic;
+  changeOfInputVariables(quadraticProjected, Pu, Px, u0);
+  ScalarFunctionQuadraticApproximation quadraticOutput;
+  changeOfInputVariables(quadratic, Pu, Px, u0, quadraticOutput);
+
+  ASSERT_TRUE(isApprox(quadraticProjected, quadraticOutput));
+}
+
+TEST(linear_change_of_input_variables, toOutput) {
+  const int n = 4;
+  const int m = 3;
+  const int p = 2;
+
+  // Create change of variables
+  const matrix_t Pu = matrix_t::Random(m, p);
+  const matrix_t Px = matrix_t::Random(m, n);
+  const vector_t u0 = vector_t::Random(m);
+  const auto linear = getRandomDynamics(n, m);
+
+  // Apply change of variables in place and to an output
+  auto linearProjected = linear;
+  changeOfInputVariables(linearProjected, Pu, Px, u0);
+  VectorFunctionLinearApproximation linearOutput;
+  changeOfInputVariables(linear, Pu, Px, u0, linearOutput);
+
+  ASSERT_TRUE(isApprox(linearProjected, linearOutput));
+}
+
+TEST(selection_change_of_input_variables, isInputSelection) {
+  std::vector<int> selectedInputs;
+  ASSERT_FALSE(isInputSelection(matrix_t::Random(3, 2), selectedInputs));
+  ASSERT_FALSE(isInputSelection(matrix_t::Ones(3, 1), selectedInputs));
+  ASSERT_FALSE(isInputSelection(matrix_t::Zero(3, 1), selectedInputs));
+
+  // The same input selected twice
+  matrix_t Pu = matrix_t::Zero(3, 2);
+  Pu(1, 0) = Pu(1, 1) = 1.0;
+  ASSERT_FALSE(isInputSelection(Pu, selectedInputs));
+
+  Pu.setZero();
+  Pu(2, 0) = Pu(0, 1) = 1.0;
+  ASSERT_TRUE(isInputSelection(Pu, selectedInputs));
+  ASSERT_EQ(selectedInputs, (std::vector<int>{2, 0}));
+  ASSERT_FALSE(isIdentitySelection(selectedInputs, 3));
+
+  ASSERT_TRUE(isInputSelection(matrix_t::Identity(3, 3), selectedInputs));
+  ASSERT_TRUE(isIdentitySelection(selectedInputs, 3));
+}
+
+TEST(selection_change_of_input_variables, compareToDense) {
+  const int n = 4;
+  const int m = 3;
+  const std::vector<std::vector<int>> selections{{0, 1, 2}, {2, 0}, {1}};
+  const auto quadratic = getRandomCost(n, m);
+  const auto linear = getRandomDynamics(n, m);
+
+  for (const auto& selectedInputs : selections) {
+    matrix_t Pu = matrix_t::Zero(m, selectedInputs.size());
+    for (int j = 0; j < static_cast<int>(selectedInputs.size()); j++) {
+      Pu(selectedInputs[j], j) = 1.0;
+    }
+
+    for (const bool withOffsets : {false, true}) {
+      const matrix_t Px = withOffsets ? matrix_t::Random(m, n) : matrix_t();
+      const vector_t u0 = withOffsets ? vector_t::Random(m) : vector_t();
+
+      ScalarFunctionQuadraticApproximation quadraticDense, quadraticSelection;
+      changeOfInputVariables(quadratic, Pu, Px, u0, quadraticDense);
+      changeOfInputVariables(quadratic, selectedInputs, Px, u0, quadraticSelection);
+      ASSERT_TRUE(isApprox(quadraticDense, quadraticSelection));
+
+      VectorFunctionLinearApproximation linearDense, linearSelection;
+      changeOfInputVariables(linear, Pu, Px, u0, linearDense);
+      changeOfInputVariables(linear, selectedInputs, Px, u0, linearSelection);
+      ASSERT_TRUE(isApprox(linearDense, linearSelection));
+    }
+  }
+}
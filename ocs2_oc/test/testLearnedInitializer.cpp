@@ -0,0 +1,131 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+
+#include <ocs2_core/initialization/DefaultInitializer.h>
+
+#include "ocs2_oc/synchronized_module/LearnedInitializer.h"
+#include "ocs2_oc/synchronized_module/ReferenceManager.h"
+
+using namespace ocs2;
+
+class LearnedInitializerTest : public testing::Test {
+ protected:
+  static constexpr size_t STATE_DIM = 3;
+  static constexpr size_t INPUT_DIM = 2;
+  static constexpr size_t FEATURE_DIM = 2 * STATE_DIM + INPUT_DIM + 1;
+
+  LearnedInitializerTest()
+      : weights(matrix_t::Random(INPUT_DIM + STATE_DIM, FEATURE_DIM)),
+        bias(vector_t::Random(INPUT_DIM + STATE_DIM)),
+        initializer(MultiLayerPerceptron({weights}, {bias}), STATE_DIM, INPUT_DIM, DefaultInitializer(INPUT_DIM)),
+        referenceManager(TargetTrajectories({0.0}, {vector_t::Random(STATE_DIM)}, {vector_t::Random(INPUT_DIM)}),
+                         ModeSchedule({}, {2})) {}
+
+  matrix_t weights;
+  vector_t bias;
+  LearnedInitializer initializer;
+  ReferenceManager referenceManager;
+};
+
+constexpr size_t LearnedInitializerTest::STATE_DIM;
+constexpr size_t LearnedInitializerTest::INPUT_DIM;
+constexpr size_t LearnedInitializerTest::FEATURE_DIM;
+
+TEST_F(LearnedInitializerTest, fallbackWithoutReference) {
+  const vector_t state = vector_t::Random(STATE_DIM);
+  vector_t input, nextState;
+  initializer.compute(0.0, state, 0.1, input, nextState);
+  EXPECT_TRUE(input.isZero());
+  EXPECT_TRUE(nextState.isApprox(state));
+}
+
+TEST_F(LearnedInitializerTest, evaluateNetwork) {
+  initializer.getSynchronizedModule()->preSolverRun(0.0, 1.0, vector_t::Zero(STATE_DIM), referenceManager);
+
+  // the clones share the reference
+  std::unique_ptr<Initializer> clonePtr(initializer.clone());
+
+  const vector_t state = vector_t::Random(STATE_DIM);
+  vector_t features(FEATURE_DIM);
+  features << state, referenceManager.getTargetTrajectories().stateTrajectory.front(),
+      referenceManager.getTargetTrajectories().inputTrajectory.front(), 2.0;
+  const vector_t output = weights * features + bias;
+
+  vector_t input, nextState;
+  clonePtr->compute(0.5, state, 0.6, input, nextState);
+  EXPECT_TRUE(input.isApprox(output.head(INPUT_DIM)));
+  EXPECT_TRUE(nextState.isApprox(state + 0.1 * output.tail(STATE_DIM)));
+}
+
+TEST_F(LearnedInitializerTest, exportData) {
+  const std::string dataFileName = "ocs2_test_learned_initializer_data.txt";
+  std::remove(dataFileName.c_str());
+  auto modulePtr = initializer.getSynchronizedModule(dataFileName);
+  modulePtr->preSolverRun(0.0, 1.0, vector_t::Zero(STATE_DIM), referenceManager);
+
+  PrimalSolution primalSolution;
+  primalSolution.timeTrajectory_ = {0.0, 0.5, 0.5, 1.0};
+  primalSolution.stateTrajectory_ = {vector_t::Random(STATE_DIM), vector_t::Random(STATE_DIM), vector_t::Random(STATE_DIM),
+                                     vector_t::Random(STATE_DIM)};
+  primalSolution.inputTrajectory_ = {vector_t::Random(INPUT_DIM), vector_t::Random(INPUT_DIM), vector_t::Random(INPUT_DIM),
+                                     vector_t::Random(INPUT_DIM)};
+  modulePtr->postSolverRun(primalSolution);
+
+  // the event interval is skipped
+  std::ifstream dataFile(dataFileName);
+  std::vector<vector_t> samples;
+  vector_t sample(FEATURE_DIM + INPUT_DIM + STATE_DIM);
+  while (true) {
+    for (Eigen::Index i = 0; i < sample.size(); i++) {
+      dataFile >> sample(i);
+    }
+    if (dataFile.fail()) {
+      break;
+    }
+    samples.push_back(sample);
+  }
+  ASSERT_EQ(samples.size(), 2);
+
+  const auto& x = primalSolution.stateTrajectory_;
+  const auto& u = primalSolution.inputTrajectory_;
+  EXPECT_TRUE(samples[0].head(STATE_DIM).isApprox(x[0]));
+  EXPECT_TRUE(samples[0].segment(FEATURE_DIM, INPUT_DIM).isApprox(u[0]));
+  EXPECT_TRUE(samples[0].tail(STATE_DIM).isApprox((x[1] - x[0]) / 0.5));
+  EXPECT_TRUE(samples[1].head(STATE_DIM).isApprox(x[2]));
+  EXPECT_TRUE(samples[1].tail(STATE_DIM).isApprox((x[3] - x[2]) / 0.5));
+}
+
+TEST_F(LearnedInitializerTest, inconsistentNetwork) {
+  EXPECT_ANY_THROW(LearnedInitializer(MultiLayerPerceptron({weights}, {bias}), STATE_DIM + 1, INPUT_DIM, DefaultInitializer(INPUT_DIM)));
+}
@@ -0,0 +1,101 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/control/LinearController.h>
+#include <ocs2_core/dynamics/LinearSystemDynamics.h>
+#include <ocs2_core/initialization/DefaultInitializer.h>
+#include <ocs2_core/integration/SensitivityIntegratorImpl.h>
+
+#include "ocs2_oc/synchronized_module/SolutionExtrapolationInitializer.h"
+
+using namespace ocs2;
+
+class SolutionExtrapolationInitializerTest : public testing::Test {
+ protected:
+  static constexpr size_t STATE_DIM = 3;
+  static constexpr size_t INPUT_DIM = 2;
+
+  SolutionExtrapolationInitializerTest()
+      : dynamics(matrix_t::Random(STATE_DIM, STATE_DIM), matrix_t::Random(STATE_DIM, INPUT_DIM)),
+        initializer(dynamics, DefaultInitializer(INPUT_DIM)) {
+    primalSolution.timeTrajectory_ = {0.0, 1.0};
+    primalSolution.stateTrajectory_ = {vector_t::Random(STATE_DIM), vector_t::Random(STATE_DIM)};
+    primalSolution.inputTrajectory_ = {vector_t::Random(INPUT_DIM), vector_t::Random(INPUT_DIM)};
+    gain = matrix_t::Random(INPUT_DIM, STATE_DIM);
+    const vector_t bias = primalSolution.inputTrajectory_.back() - gain * primalSolution.stateTrajectory_.back();
+    primalSolution.controllerPtr_.reset(new LinearController(primalSolution.timeTrajectory_, {bias, bias}, {gain, gain}));
+  }
+
+  LinearSystemDynamics dynamics;
+  SolutionExtrapolationInitializer initializer;
+  PrimalSolution primalSolution;
+  matrix_t gain;
+};
+
+constexpr size_t SolutionExtrapolationInitializerTest::STATE_DIM;
+constexpr size_t SolutionExtrapolationInitializerTest::INPUT_DIM;
+
+TEST_F(SolutionExtrapolationInitializerTest, fallbackWithoutSolution) {
+  const vector_t state = vector_t::Random(STATE_DIM);
+  vector_t input, nextState;
+  initializer.compute(2.0, state, 2.1, input, nextState);
+  EXPECT_TRUE(input.isZero());
+  EXPECT_TRUE(nextState.isApprox(state));
+}
+
+TEST_F(SolutionExtrapolationInitializerTest, extrapolateTail) {
+  initializer.getSynchronizedModule()->postSolverRun(primalSolution);
+
+  // the clones share the solution tail
+  std::unique_ptr<Initializer> clonePtr(initializer.clone());
+
+  const vector_t state = vector_t::Random(STATE_DIM);
+  vector_t input, nextState;
+  clonePtr->compute(1.5, state, 1.6, input, nextState);
+
+  const vector_t expectedInput = primalSolution.inputTrajectory_.back() + gain * (state - primalSolution.stateTrajectory_.back());
+  EXPECT_TRUE(input.isApprox(expectedInput));
+  EXPECT_TRUE(nextState.isApprox(rk4Discretization(dynamics, 1.5, state, expectedInput, 0.1)));
+
+  // before the final time of the previous solution the fallback is used
+  clonePtr->compute(0.5, state, 0.6, input, nextState);
+  EXPECT_TRUE(input.isZero());
+  EXPECT_TRUE(nextState.isApprox(state));
+}
+
+TEST_F(SolutionExtrapolationInitializerTest, holdInputWithoutLinearController) {
+  primalSolution.controllerPtr_.reset();
+  initializer.getSynchronizedModule()->postSolverRun(primalSolution);
+
+  vector_t input, nextState;
+  initializer.compute(1.5, vector_t::Random(STATE_DIM), 1.6, input, nextState);
+  EXPECT_TRUE(input.isApprox(primalSolution.inputTrajectory_.back()));
+}
@@ -338,6 +338,30 @@ TEST_F(TrajectorySpreadingTest, partially_matching_modes) {
   EXPECT_TRUE(status.willPerformTrajectorySpreading);
 }
 
+TEST_F(TrajectorySpreadingTest, adjust_events_array_in_place) {
+  const ocs2::scalar_array_t eventTimes{0.6, 1.7, 2.3};
+  const ocs2::size_array_t modeSequence{0, 1, 2, 3};
+
+  const ocs2::scalar_array_t updatedEventTimes{0.9, 1.1, 2.1};
+  const ocs2::size_array_t updatedModeSequence{10, 1, 2, 30};
+
+  const std::pair<ocs2::scalar_t, ocs2::scalar_t> period{0.0, 2.5};
+  const ocs2::ModeSchedule modeSchedule{eventTimes, modeSequence};
+  const auto result = rollout(modeSchedule, period);
+  const auto status = trajectorySpreadingPtr->set(modeSchedule, {updatedEventTimes, updatedModeSequence}, result.timeTrajectory);
+  EXPECT_TRUE(status.willTruncate);
+
+  // the in-place adjustment keeps the same event data as the extraction
+  auto eventDataArray = result.eventDataArray;
+  trajectorySpreadingPtr->adjustEventsArray(eventDataArray);
+  const auto expectedEventDataArray = trajectorySpreadingPtr->extractEventsArray(result.eventDataArray);
+  ASSERT_EQ(eventDataArray.size(), expectedEventDataArray.size());
+  EXPECT_LT(eventDataArray.size(), result.eventDataArray.size());
+  for (size_t i = 0; i < eventDataArray.size(); i++) {
+    EXPECT_TRUE(eventDataArray[i].isApprox(expectedEventDataArray[i]));
+  }
+}
+
 TEST_F(TrajectorySpreadingTest, final_time_is_the_same_as_event_time_1) {
   const ocs2::scalar_array_t eventTimes{1.1, 1.3};
   const ocs2::size_array_t modeSequence{0, 1, 2};
@@ -135,8 +135,8 @@ class GDDP_Settings {
 };  // end of GDDP_Settings class
 
 inline void GDDP_Settings::loadSettings(const std::string& filename, const std::string& fieldName /*= ilqr*/, bool verbose /*= true*/) {
-  boost::property_tree::ptree pt;
-  boost::property_tree::read_info(filename, pt);
+  const auto ptPtr = loadData::readInfoFile(filename);
+  const boost::property_tree::ptree& pt = *ptPtr;
 
   if (verbose) {
     std::cerr << std::endl << " #### GDDP Settings: " << std::endl;
@@ -0,0 +1,139 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <condition_variable>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <ocs2_core/thread_support/TripleBuffer.h>
+
+#include "ocs2_perceptive/distance_transform/DistanceTransformInterface.h"
+#include "ocs2_perceptive/distance_transform/GridDistanceField.h"
+#include "ocs2_perceptive/distance_transform/GridDistanceTransform.h"
+
+namespace ocs2 {
+
+/**
+ * A signed distance field which is rebuilt asynchronously from the occupancy grids of the perception. A worker thread computes the
+ * next field (see GridDistanceTransform) while the queries keep using the active field, and the consumer swaps in the latest built
+ * field by calling updateFromBuffer() at a point where no query is running, e.g., right before the solver runs. The built fields are
+ * exchanged through a triple buffer, hence neither the worker nor the consumer ever waits for the other.
+ *
+ * If the occupancy is set together with a dirty region and the field is truncated, the worker only updates the neighbourhood of the
+ * dirty regions which have accumulated since its last run.
+ */
+class AsyncGridDistanceField final : public DistanceTransformInterface {
+ public:
+  /**
+   * Constructor. The active field is initialized to the field of an empty grid.
+   *
+   * @param [in] gridSize: The number of cells per axis.
+   * @param [in] resolution: The size of a cell.
+   * @param [in] origin: The position of the center of the cell with the index (0, 0, 0).
+   * @param [in] maxDistance: The absolute distance at which the field is truncated.
+   * @param [in] threadPoolPtr: An optional thread pool which is used by the worker for the distance transform.
+   */
+  AsyncGridDistanceField(const std::array<size_t, 3>& gridSize, scalar_t resolution, const vector3_t& origin,
+                         scalar_t maxDistance = std::numeric_limits<scalar_t>::infinity(), ThreadPool* threadPoolPtr = nullptr);
+
+  /** Destructor. Stops the worker thread. */
+  ~AsyncGridDistanceField() override;
+
+  /**
+   * Sets a new occupancy grid from which the next field is built. This method is thread-safe.
+   *
+   * @param [in] occupancy: The occupancy of the cells in the layout of GridDistanceTransform, where non-zero is occupied.
+   */
+  void setOccupancy(const std::vector<uint8_t>& occupancy);
+
+  /**
+   * Sets a new occupancy grid which differs from the previously set one (initially an empty grid) only within the dirty region. This
+   * method is thread-safe.
+   *
+   * @param [in] occupancy: The occupancy of the cells in the layout of GridDistanceTransform, where non-zero is occupied.
+   * @param [in] dirtyRegion: The region which contains all the cells whose occupancy has changed.
+   */
+  void setOccupancy(const std::vector<uint8_t>& occupancy, const GridRegion& dirtyRegion);
+
+  /**
+   * Swaps in the latest built field. This method is NOT thread-safe w.r.t. the queries.
+   * @return True if the active field was updated.
+   */
+  bool updateFromBuffer() { return fields_.updateFromBuffer(); }
+
+  /** The active field. */
+  const GridDistanceField& getActiveField() const { return *fields_.front(); }
+
+  scalar_t getValue(const vector3_t& p) const override { return getActiveField().getValue(p); }
+  vector3_t getProjectedPoint(const vector3_t& p) const override { return getActiveField().getProjectedPoint(p); }
+  std::pair<scalar_t, vector3_t> getLinearApproximation(const vector3_t& p) const override {
+    return getActiveField().getLinearApproximation(p);
+  }
+  void getValues(const std::vector<vector3_t>& points, scalar_array_t& values) const override {
+    getActiveField().getValues(points, values);
+  }
+  void getLinearApproximations(const std::vector<vector3_t>& points,
+                               std::vector<std::pair<scalar_t, vector3_t>>& linearApproximations) const override {
+    getActiveField().getLinearApproximations(points, linearApproximations);
+  }
+  void getValues(const Eigen::Ref<const matrix3x_t>& points, vector_t& values) const override { getActiveField().getValues(points, values); }
+  void getLinearApproximations(const Eigen::Ref<const matrix3x_t>& points, vector_t& values, matrix3x_t& gradients) const override {
+    getActiveField().getLinearApproximations(points, values, gradients);
+  }
+
+ private:
+  void workerThread();
+
+  const scalar_t resolution_;
+  const scalar_t maxDistance_;
+  GridDistanceTransform distanceTransform_;
+  TripleBuffer<std::unique_ptr<GridDistanceField>> fields_;
+
+  // the occupancy which is set by the perception
+  std::mutex occupancyMutex_;
+  std::condition_variable occupancyCondition_;
+  std::vector<uint8_t> occupancyBuffer_;
+  GridRegion dirtyRegionBuffer_;
+  bool isOccupancyUpdated_ = false;
+  bool isFullUpdate_ = false;
+  bool terminateThread_ = false;
+
+  // only accessed by the worker
+  std::vector<uint8_t> occupancy_;
+  std::vector<float> signedDistance_;
+
+  std::thread worker_;
+};
+
+}  // namespace ocs2
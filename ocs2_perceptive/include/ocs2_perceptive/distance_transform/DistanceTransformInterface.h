@@ -30,6 +30,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #pragma once
 
 #include <utility>
+#include <vector>
 
 #include <ocs2_core/Types.h>
 
@@ -39,6 +40,7 @@ namespace ocs2 {
 class DistanceTransformInterface {
  public:
   using vector3_t = Eigen::Matrix<scalar_t, 3, 1>;
+  using matrix3x_t = Eigen::Matrix<scalar_t, 3, Eigen::Dynamic>;
 
   DistanceTransformInterface() = default;
   virtual ~DistanceTransformInterface() = default;
@@ -56,6 +58,45 @@ class DistanceTransformInterface {
 
   /** Gets the distance's value and its gradient at the given point. */
   virtual std::pair<scalar_t, vector3_t> getLinearApproximation(const vector3_t& p) const = 0;
+
+  /** Gets the distances to the given points. Implementations can override this to amortize the lookups over the points. */
+  virtual void getValues(const std::vector<vector3_t>& points, scalar_array_t& values) const {
+    values.resize(points.size());
+    for (size_t i = 0; i < points.size(); i++) {
+      values[i] = getValue(points[i]);
+    }
+  }
+
+  /** Gets the distances' values and their gradients at the given points. Implementations can override this to amortize the lookups. */
+  virtual void getLinearApproximations(const std::vector<vector3_t>& points,
+                                       std::vector<std::pair<scalar_t, vector3_t>>& linearApproximations) const {
+    linearApproximations.resize(points.size());
+    for (size_t i = 0; i < points.size(); i++) {
+      linearApproximations[i] = getLinearApproximation(points[i]);
+    }
+  }
+
+  /** Gets the distances to the points which are stored in the columns of the given matrix. */
+  virtual void getValues(const Eigen::Ref<const matrix3x_t>& points, vector_t& values) const {
+    values.resize(points.cols());
+    for (Eigen::Index i = 0; i < points.cols(); i++) {
+      values(i) = getValue(points.col(i));
+    }
+  }
+
+  /**
+   * Gets the distances' values and their gradients at the points which are stored in the columns of the given matrix. The gradient of
+   * the i-th point is stored in the i-th column of gradients.
+   */
+  virtual void getLinearApproximations(const Eigen::Ref<const matrix3x_t>& points, vector_t& values, matrix3x_t& gradients) const {
+    values.resize(points.cols());
+    gradients.resize(3, points.cols());
+    for (Eigen::Index i = 0; i < points.cols(); i++) {
+      const auto valueGradient = getLinearApproximation(points.col(i));
+      values(i) = valueGradient.first;
+      gradients.col(i) = valueGradient.second;
+    }
+  }
 };
 
 /** Identity distance transform with constant zero value and zero gradients. */
@@ -0,0 +1,117 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "ocs2_perceptive/distance_transform/DistanceTransformInterface.h"
+
+namespace ocs2 {
+
+/**
+ * A distance field which is sampled on a regular 3D grid and trilinearly interpolated in between the samples (see
+ * trilinear_interpolation::getLinearApproximation). The points outside of the grid are projected onto the grid boundary.
+ *
+ * The samples are stored in tiles of TileSize^3 cells, such that the eight samples around a point mostly lie in the same few cache
+ * lines. The batch queries process the points in chunks: the sample indices of all points of a chunk are computed and prefetched
+ * before the interpolation. The queries are thread-safe.
+ */
+class GridDistanceField final : public DistanceTransformInterface {
+ public:
+  static constexpr size_t TileSize = 4;
+
+  /**
+   * Constructor. The samples are initialized to zero.
+   *
+   * @param [in] gridSize: The number of samples per axis. A 2D field has a single sample in the z direction.
+   * @param [in] resolution: The distance between two samples.
+   * @param [in] origin: The position of the sample with the index (0, 0, 0).
+   */
+  GridDistanceField(const std::array<size_t, 3>& gridSize, scalar_t resolution, const vector3_t& origin);
+
+  ~GridDistanceField() override = default;
+
+  /**
+   * Sets the samples from a contiguous array in which the x index runs fastest, as computed by GridDistanceTransform.
+   *
+   * @param [in] values: The sampled distances. The size should be the number of samples.
+   */
+  void setValues(const std::vector<float>& values);
+
+  /** Sets the sample with the index (ix, iy, iz). */
+  void setValue(size_t ix, size_t iy, size_t iz, float value) { data_[getStorageIndex(ix, iy, iz)] = value; }
+
+  /** Gets the sample with the index (ix, iy, iz). */
+  float getSample(size_t ix, size_t iy, size_t iz) const { return data_[getStorageIndex(ix, iy, iz)]; }
+
+  const std::array<size_t, 3>& getGridSize() const { return gridSize_; }
+  scalar_t getResolution() const { return resolution_; }
+  const vector3_t& getOrigin() const { return origin_; }
+
+  scalar_t getValue(const vector3_t& p) const override;
+  vector3_t getProjectedPoint(const vector3_t& p) const override;
+  std::pair<scalar_t, vector3_t> getLinearApproximation(const vector3_t& p) const override;
+
+  void getValues(const std::vector<vector3_t>& points, scalar_array_t& values) const override;
+  void getLinearApproximations(const std::vector<vector3_t>& points,
+                               std::vector<std::pair<scalar_t, vector3_t>>& linearApproximations) const override;
+  void getValues(const Eigen::Ref<const matrix3x_t>& points, vector_t& values) const override;
+  void getLinearApproximations(const Eigen::Ref<const matrix3x_t>& points, vector_t& values, matrix3x_t& gradients) const override;
+
+ private:
+  /** The cell of a point: the storage indices of its eight corner samples, the reference corner, and the clamped point. */
+  struct Cell {
+    std::array<size_t, 8> cornerIndices;
+    vector3_t referenceCorner;
+    vector3_t position;
+  };
+
+  size_t getStorageIndex(size_t ix, size_t iy, size_t iz) const {
+    const size_t tileIndex = (ix / TileSize) + numTiles_[0] * ((iy / TileSize) + numTiles_[1] * (iz / TileSize));
+    return tileIndex * TileSize * TileSize * TileSize + (ix % TileSize) + TileSize * ((iy % TileSize) + TileSize * (iz % TileSize));
+  }
+
+  Cell getCell(const vector3_t& p) const;
+  std::array<scalar_t, 8> getCornerValues(const Cell& cell) const;
+  void prefetch(const Cell& cell) const;
+
+  /** Calls interpolate(i, cell) for the cells of the points getPoint(i), i in [0, numPoints), after prefetching them chunk-wise. */
+  template <typename GetPoint, typename Interpolate>
+  void forEachCell(size_t numPoints, GetPoint getPoint, Interpolate interpolate) const;
+
+  const std::array<size_t, 3> gridSize_;
+  const scalar_t resolution_;
+  const vector3_t origin_;
+  std::array<size_t, 3> numTiles_;
+  std::vector<float> data_;
+};
+
+}  // namespace ocs2
@@ -0,0 +1,179 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
+
+namespace ocs2 {
+
+/** An axis-aligned box of cells in a grid, given by its first cell and its past-the-end cell. */
+struct GridRegion {
+  std::array<size_t, 3> begin{{0, 0, 0}};
+  std::array<size_t, 3> end{{0, 0, 0}};
+
+  bool empty() const { return begin[0] >= end[0] || begin[1] >= end[1] || begin[2] >= end[2]; }
+};
+
+/**
+ * Computes the exact Euclidean distance transform of 2D and 3D grids by applying the one-dimensional distance transform (see
+ * computeDistanceTransform) successively along the x, y, and z axes. The lines of a pass are independent of each other and are
+ * distributed over a thread pool, where each thread works on its own buffers.
+ *
+ * The grid values are stored contiguously in a single array with the x index running fastest, i.e., the value of the cell (ix, iy, iz)
+ * is at index ix + sizeX * (iy + sizeY * iz). A 2D grid is a 3D grid with sizeZ = 1.
+ *
+ * The distances can be truncated at a maximum distance. A truncated field supports incremental updates: if the occupancy only
+ * changes within a region, only the cells within the maximum distance of the region can change, and their distances only depend on
+ * the occupancy within twice the maximum distance of the region. The update therefore transforms this neighbourhood instead of the
+ * whole grid.
+ */
+class GridDistanceTransform {
+ public:
+  /** The value of the cells which are not sites of the distance transform. */
+  static constexpr float Infinity = 1e20;
+
+  /**
+   * Constructor.
+   *
+   * @param [in] sizeX: The number of cells in the x direction.
+   * @param [in] sizeY: The number of cells in the y direction.
+   * @param [in] sizeZ: The number of cells in the z direction.
+   * @param [in] threadPoolPtr: An optional thread pool which is shared with the caller. If nullptr, the lines are processed in the
+   * calling thread.
+   */
+  GridDistanceTransform(size_t sizeX, size_t sizeY, size_t sizeZ = 1, ThreadPool* threadPoolPtr = nullptr);
+
+  /** Returns the number of cells per axis. */
+  const std::array<size_t, 3>& getGridSize() const { return gridSize_; }
+
+  /** Returns the total number of cells. */
+  size_t getNumCells() const { return gridSize_[0] * gridSize_[1] * gridSize_[2]; }
+
+  /** Returns the index of the cell (ix, iy, iz) in the contiguous storage. */
+  size_t getIndex(size_t ix, size_t iy, size_t iz = 0) const { return ix + gridSize_[0] * (iy + gridSize_[1] * iz); }
+
+  /**
+   * Computes the squared distance transform in place.
+   *
+   * @param [in, out] values: On input, zero (or any finite cost) at the sites and Infinity elsewhere. On output, the squared distance
+   * in number of cells to the nearest site. The size should be getNumCells().
+   */
+  void computeSquaredDistance(std::vector<float>& values);
+
+  /**
+   * Computes the distance to the nearest occupied cell.
+   *
+   * @param [in] occupancy: The occupancy of the cells, where non-zero is occupied. The size should be getNumCells().
+   * @param [in] resolution: The size of a cell.
+   * @param [out] distance: The distance of each cell to the nearest occupied cell. It is zero for the occupied cells.
+   * @param [in] maxDistance: The distance at which the field is truncated.
+   */
+  void computeDistance(const std::vector<uint8_t>& occupancy, scalar_t resolution, std::vector<float>& distance,
+                       scalar_t maxDistance = std::numeric_limits<scalar_t>::infinity());
+
+  /**
+   * Updates the distance field after the occupancy has changed within the dirty region.
+   *
+   * @param [in] occupancy: The updated occupancy of the cells.
+   * @param [in] dirtyRegion: The region which contains all the cells whose occupancy has changed.
+   * @param [in] resolution: The size of a cell.
+   * @param [in] maxDistance: The distance at which the field is truncated. The field should have been computed with the same value.
+   * If it is infinite, the whole field is recomputed.
+   * @param [in, out] distance: The distance field which is updated.
+   */
+  void updateDistance(const std::vector<uint8_t>& occupancy, const GridRegion& dirtyRegion, scalar_t resolution, scalar_t maxDistance,
+                      std::vector<float>& distance);
+
+  /**
+   * Computes the signed distance field, which is the distance to the nearest occupied cell for the free cells and the negative
+   * distance to the nearest free cell for the occupied cells.
+   *
+   * @param [in] occupancy: The occupancy of the cells, where non-zero is occupied. The size should be getNumCells().
+   * @param [in] resolution: The size of a cell.
+   * @param [out] signedDistance: The signed distance of each cell.
+   * @param [in] maxDistance: The absolute distance at which the field is truncated.
+   */
+  void computeSignedDistance(const std::vector<uint8_t>& occupancy, scalar_t resolution, std::vector<float>& signedDistance,
+                             scalar_t maxDistance = std::numeric_limits<scalar_t>::infinity());
+
+  /**
+   * Updates the signed distance field after the occupancy has changed within the dirty region.
+   *
+   * @param [in] occupancy: The updated occupancy of the cells.
+   * @param [in] dirtyRegion: The region which contains all the cells whose occupancy has changed.
+   * @param [in] resolution: The size of a cell.
+   * @param [in] maxDistance: The absolute distance at which the field is truncated. The field should have been computed with the same
+   * value. If it is infinite, the whole field is recomputed.
+   * @param [in, out] signedDistance: The signed distance field which is updated.
+   */
+  void updateSignedDistance(const std::vector<uint8_t>& occupancy, const GridRegion& dirtyRegion, scalar_t resolution,
+                            scalar_t maxDistance, std::vector<float>& signedDistance);
+
+ private:
+  struct LineBuffers {
+    std::vector<size_t> vBuffer;
+    std::vector<float> zBuffer;
+    std::vector<float> line;
+  };
+
+  /** Computes the squared distance of the cells in the region to the occupied (or free) cells in the region. */
+  void computeRegionSquaredDistance(const std::vector<uint8_t>& occupancy, const GridRegion& region, bool occupiedSites,
+                                    std::vector<float>& regionValues);
+  void computeSquaredDistance(const std::array<size_t, 3>& gridSize, float* values);
+  void computePass(const std::array<size_t, 3>& gridSize, size_t axis, float* values);
+  GridRegion getFullRegion() const;
+  GridRegion dilate(const GridRegion& region, size_t numCells) const;
+
+  const std::array<size_t, 3> gridSize_;
+  ThreadPool* threadPoolPtr_;
+  std::vector<LineBuffers> lineBuffers_;
+  std::vector<float> regionBuffer_;
+  std::vector<float> complementBuffer_;
+};
+
+/**
+ * Fills the occupancy of a 3D grid from an elevation map. A cell is occupied if its center is below the elevation of its column.
+ *
+ * @param [in] elevation: The elevation of the (ix, iy) columns with the x index running fastest. Its size should be sizeX * sizeY.
+ * @param [in] gridSize: The number of cells per axis.
+ * @param [in] minHeight: The height of the bottom of the lowest cell.
+ * @param [in] resolution: The size of a cell.
+ * @param [out] occupancy: The occupancy of the cells in the layout of GridDistanceTransform.
+ */
+void elevationToOccupancy(const std::vector<float>& elevation, const std::array<size_t, 3>& gridSize, scalar_t minHeight,
+                          scalar_t resolution, std::vector<uint8_t>& occupancy);
+
+}  // namespace ocs2
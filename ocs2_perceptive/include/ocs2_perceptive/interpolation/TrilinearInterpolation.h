@@ -0,0 +1,109 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <utility>
+
+#include <ocs2_core/Types.h>
+
+namespace ocs2 {
+namespace trilinear_interpolation {
+
+/*
+ * The corner values are ordered such that the index of the corner with the offsets (bx, by, bz) from the reference corner is
+ * bx + 2 * by + 4 * bz, where each offset is either 0 or 1.
+ */
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <typename Scalar>
+Scalar getValue(Scalar resolution, const Eigen::Matrix<Scalar, 3, 1>& referenceCorner, const std::array<Scalar, 8>& cornerValues,
+                const Eigen::Matrix<Scalar, 3, 1>& position) {
+  // auxiliary variables
+  const Scalar r_inv = 1.0 / resolution;
+  const Scalar tx = (position.x() - referenceCorner.x()) * r_inv;
+  const Scalar ty = (position.y() - referenceCorner.y()) * r_inv;
+  const Scalar tz = (position.z() - referenceCorner.z()) * r_inv;
+
+  // interpolate along x, then y, then z
+  const Scalar c00 = cornerValues[0] + tx * (cornerValues[1] - cornerValues[0]);
+  const Scalar c10 = cornerValues[2] + tx * (cornerValues[3] - cornerValues[2]);
+  const Scalar c01 = cornerValues[4] + tx * (cornerValues[5] - cornerValues[4]);
+  const Scalar c11 = cornerValues[6] + tx * (cornerValues[7] - cornerValues[6]);
+  const Scalar c0 = c00 + ty * (c10 - c00);
+  const Scalar c1 = c01 + ty * (c11 - c01);
+
+  return c0 + tz * (c1 - c0);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <typename Scalar>
+std::pair<Scalar, Eigen::Matrix<Scalar, 3, 1>> getLinearApproximation(Scalar resolution, const Eigen::Matrix<Scalar, 3, 1>& referenceCorner,
+                                                                      const std::array<Scalar, 8>& cornerValues,
+                                                                      const Eigen::Matrix<Scalar, 3, 1>& position) {
+  // auxiliary variables
+  const Scalar r_inv = 1.0 / resolution;
+  const Scalar tx = (position.x() - referenceCorner.x()) * r_inv;
+  const Scalar ty = (position.y() - referenceCorner.y()) * r_inv;
+  const Scalar tz = (position.z() - referenceCorner.z()) * r_inv;
+
+  // differences along x
+  const Scalar dx00 = cornerValues[1] - cornerValues[0];
+  const Scalar dx10 = cornerValues[3] - cornerValues[2];
+  const Scalar dx01 = cornerValues[5] - cornerValues[4];
+  const Scalar dx11 = cornerValues[7] - cornerValues[6];
+
+  // interpolate along x, then y, then z
+  const Scalar c00 = cornerValues[0] + tx * dx00;
+  const Scalar c10 = cornerValues[2] + tx * dx10;
+  const Scalar c01 = cornerValues[4] + tx * dx01;
+  const Scalar c11 = cornerValues[6] + tx * dx11;
+  const Scalar c0 = c00 + ty * (c10 - c00);
+  const Scalar c1 = c01 + ty * (c11 - c01);
+
+  const Scalar value = c0 + tz * (c1 - c0);
+
+  // gradient
+  const Scalar dx0 = dx00 + ty * (dx10 - dx00);
+  const Scalar dx1 = dx01 + ty * (dx11 - dx01);
+  Eigen::Matrix<Scalar, 3, 1> gradient;
+  gradient.x() = (dx0 + tz * (dx1 - dx0)) * r_inv;
+  gradient.y() = ((c10 - c00) + tz * ((c11 - c01) - (c10 - c00))) * r_inv;
+  gradient.z() = (c1 - c0) * r_inv;
+
+  return {value, gradient};
+}
+
+}  // namespace trilinear_interpolation
+}  // namespace ocs2
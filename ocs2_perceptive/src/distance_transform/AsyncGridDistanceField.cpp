@@ -0,0 +1,147 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_perceptive/distance_transform/AsyncGridDistanceField.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+AsyncGridDistanceField::AsyncGridDistanceField(const std::array<size_t, 3>& gridSize, scalar_t resolution, const vector3_t& origin,
+                                               scalar_t maxDistance, ThreadPool* threadPoolPtr)
+    : resolution_(resolution),
+      maxDistance_(maxDistance),
+      distanceTransform_(gridSize[0], gridSize[1], gridSize[2], threadPoolPtr),
+      occupancy_(distanceTransform_.getNumCells(), 0) {
+  // all the slots start with the field of the empty grid
+  distanceTransform_.computeSignedDistance(occupancy_, resolution_, signedDistance_, maxDistance_);
+  fields_.front().reset(new GridDistanceField(gridSize, resolution_, origin));
+  fields_.front()->setValues(signedDistance_);
+  fields_.back().reset(new GridDistanceField(gridSize, resolution_, origin));
+  fields_.back()->setValues(signedDistance_);
+  fields_.publish();
+  fields_.back().reset(new GridDistanceField(gridSize, resolution_, origin));
+  fields_.back()->setValues(signedDistance_);
+  fields_.updateFromBuffer();
+
+  worker_ = std::thread(&AsyncGridDistanceField::workerThread, this);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+AsyncGridDistanceField::~AsyncGridDistanceField() {
+  {
+    std::lock_guard<std::mutex> lock(occupancyMutex_);
+    terminateThread_ = true;
+  }
+  occupancyCondition_.notify_one();
+  if (worker_.joinable()) {
+    worker_.join();
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void AsyncGridDistanceField::setOccupancy(const std::vector<uint8_t>& occupancy) {
+  if (occupancy.size() != distanceTransform_.getNumCells()) {
+    throw std::runtime_error("[AsyncGridDistanceField] The size of the occupancy does not match the grid size!");
+  }
+  {
+    std::lock_guard<std::mutex> lock(occupancyMutex_);
+    occupancyBuffer_ = occupancy;
+    isFullUpdate_ = true;
+    isOccupancyUpdated_ = true;
+  }
+  occupancyCondition_.notify_one();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void AsyncGridDistanceField::setOccupancy(const std::vector<uint8_t>& occupancy, const GridRegion& dirtyRegion) {
+  if (occupancy.size() != distanceTransform_.getNumCells()) {
+    throw std::runtime_error("[AsyncGridDistanceField] The size of the occupancy does not match the grid size!");
+  }
+  {
+    std::lock_guard<std::mutex> lock(occupancyMutex_);
+    occupancyBuffer_ = occupancy;
+    // the dirty regions which have not been processed yet are merged into their bounding box
+    if (dirtyRegionBuffer_.empty()) {
+      dirtyRegionBuffer_ = dirtyRegion;
+    } else if (!dirtyRegion.empty()) {
+      for (size_t axis = 0; axis < 3; axis++) {
+        dirtyRegionBuffer_.begin[axis] = std::min(dirtyRegionBuffer_.begin[axis], dirtyRegion.begin[axis]);
+        dirtyRegionBuffer_.end[axis] = std::max(dirtyRegionBuffer_.end[axis], dirtyRegion.end[axis]);
+      }
+    }
+    isOccupancyUpdated_ = true;
+  }
+  occupancyCondition_.notify_one();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void AsyncGridDistanceField::workerThread() {
+  while (true) {
+    bool isFullUpdate;
+    GridRegion dirtyRegion;
+    {
+      std::unique_lock<std::mutex> lock(occupancyMutex_);
+      occupancyCondition_.wait(lock, [this] { return isOccupancyUpdated_ || terminateThread_; });
+      if (terminateThread_) {
+        return;
+      }
+      occupancy_.swap(occupancyBuffer_);
+      isFullUpdate = isFullUpdate_;
+      dirtyRegion = dirtyRegionBuffer_;
+      isOccupancyUpdated_ = false;
+      isFullUpdate_ = false;
+      dirtyRegionBuffer_ = GridRegion();
+    }
+
+    if (isFullUpdate || !std::isfinite(maxDistance_)) {
+      distanceTransform_.computeSignedDistance(occupancy_, resolution_, signedDistance_, maxDistance_);
+    } else {
+      distanceTransform_.updateSignedDistance(occupancy_, dirtyRegion, resolution_, maxDistance_, signedDistance_);
+    }
+
+    fields_.back()->setValues(signedDistance_);
+    fields_.publish();
+  }
+}
+
+}  // namespace ocs2
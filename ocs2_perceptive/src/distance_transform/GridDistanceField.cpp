@@ -0,0 +1,233 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_perceptive/distance_transform/GridDistanceField.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "ocs2_perceptive/interpolation/TrilinearInterpolation.h"
+
+namespace ocs2 {
+
+constexpr size_t GridDistanceField::TileSize;
+
+namespace {
+// number of points of a batch query whose samples are prefetched together
+constexpr size_t BatchChunkSize = 16;
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+GridDistanceField::GridDistanceField(const std::array<size_t, 3>& gridSize, scalar_t resolution, const vector3_t& origin)
+    : gridSize_(gridSize), resolution_(resolution), origin_(origin) {
+  if (gridSize_[0] == 0 || gridSize_[1] == 0 || gridSize_[2] == 0) {
+    throw std::runtime_error("[GridDistanceField] The grid size should be positive!");
+  }
+  if (resolution_ <= 0.0) {
+    throw std::runtime_error("[GridDistanceField] The resolution should be positive!");
+  }
+
+  for (size_t axis = 0; axis < 3; axis++) {
+    numTiles_[axis] = (gridSize_[axis] + TileSize - 1) / TileSize;
+  }
+  data_.resize(numTiles_[0] * numTiles_[1] * numTiles_[2] * TileSize * TileSize * TileSize, 0.0f);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void GridDistanceField::setValues(const std::vector<float>& values) {
+  if (values.size() != gridSize_[0] * gridSize_[1] * gridSize_[2]) {
+    throw std::runtime_error("[GridDistanceField] The number of values does not match the grid size!");
+  }
+
+  auto valueIt = values.cbegin();
+  for (size_t iz = 0; iz < gridSize_[2]; iz++) {
+    for (size_t iy = 0; iy < gridSize_[1]; iy++) {
+      for (size_t ix = 0; ix < gridSize_[0]; ix++) {
+        data_[getStorageIndex(ix, iy, iz)] = *valueIt++;
+      }
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t GridDistanceField::getValue(const vector3_t& p) const {
+  const auto cell = getCell(p);
+  return trilinear_interpolation::getValue(resolution_, cell.referenceCorner, getCornerValues(cell), cell.position);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+GridDistanceField::vector3_t GridDistanceField::getProjectedPoint(const vector3_t& p) const {
+  const auto distanceAndGradient = getLinearApproximation(p);
+  const scalar_t gradientNorm = distanceAndGradient.second.norm();
+  if (gradientNorm > 0.0) {
+    return p - distanceAndGradient.first / gradientNorm * distanceAndGradient.second;
+  } else {
+    return p;
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::pair<scalar_t, GridDistanceField::vector3_t> GridDistanceField::getLinearApproximation(const vector3_t& p) const {
+  const auto cell = getCell(p);
+  return trilinear_interpolation::getLinearApproximation(resolution_, cell.referenceCorner, getCornerValues(cell), cell.position);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <typename GetPoint, typename Interpolate>
+void GridDistanceField::forEachCell(size_t numPoints, GetPoint getPoint, Interpolate interpolate) const {
+  std::array<Cell, BatchChunkSize> cells;
+  for (size_t chunkStart = 0; chunkStart < numPoints; chunkStart += BatchChunkSize) {
+    const size_t chunkSize = std::min(BatchChunkSize, numPoints - chunkStart);
+    for (size_t i = 0; i < chunkSize; i++) {
+      cells[i] = getCell(getPoint(chunkStart + i));
+      prefetch(cells[i]);
+    }
+    for (size_t i = 0; i < chunkSize; i++) {
+      interpolate(chunkStart + i, cells[i]);
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void GridDistanceField::getValues(const std::vector<vector3_t>& points, scalar_array_t& values) const {
+  values.resize(points.size());
+  forEachCell(
+      points.size(), [&](size_t i) -> const vector3_t& { return points[i]; },
+      [&](size_t i, const Cell& cell) {
+        values[i] = trilinear_interpolation::getValue(resolution_, cell.referenceCorner, getCornerValues(cell), cell.position);
+      });
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void GridDistanceField::getLinearApproximations(const std::vector<vector3_t>& points,
+                                                std::vector<std::pair<scalar_t, vector3_t>>& linearApproximations) const {
+  linearApproximations.resize(points.size());
+  forEachCell(
+      points.size(), [&](size_t i) -> const vector3_t& { return points[i]; },
+      [&](size_t i, const Cell& cell) {
+        linearApproximations[i] =
+            trilinear_interpolation::getLinearApproximation(resolution_, cell.referenceCorner, getCornerValues(cell), cell.position);
+      });
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void GridDistanceField::getValues(const Eigen::Ref<const matrix3x_t>& points, vector_t& values) const {
+  values.resize(points.cols());
+  forEachCell(
+      points.cols(), [&](size_t i) -> vector3_t { return points.col(i); },
+      [&](size_t i, const Cell& cell) {
+        values(i) = trilinear_interpolation::getValue(resolution_, cell.referenceCorner, getCornerValues(cell), cell.position);
+      });
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void GridDistanceField::getLinearApproximations(const Eigen::Ref<const matrix3x_t>& points, vector_t& values,
+                                                matrix3x_t& gradients) const {
+  values.resize(points.cols());
+  gradients.resize(3, points.cols());
+  forEachCell(
+      points.cols(), [&](size_t i) -> vector3_t { return points.col(i); },
+      [&](size_t i, const Cell& cell) {
+        const auto valueGradient =
+            trilinear_interpolation::getLinearApproximation(resolution_, cell.referenceCorner, getCornerValues(cell), cell.position);
+        values(i) = valueGradient.first;
+        gradients.col(i) = valueGradient.second;
+      });
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+GridDistanceField::Cell GridDistanceField::getCell(const vector3_t& p) const {
+  Cell cell;
+  std::array<size_t, 3> index;
+  std::array<size_t, 3> offset;
+  for (size_t axis = 0; axis < 3; axis++) {
+    // the point is clamped to the grid, and the last cell along an axis also covers its upper boundary
+    const scalar_t maxCoordinate = static_cast<scalar_t>(gridSize_[axis] - 1);
+    const scalar_t coordinate = std::min(std::max((p(axis) - origin_(axis)) / resolution_, scalar_t(0.0)), maxCoordinate);
+    index[axis] = std::min(static_cast<size_t>(coordinate), gridSize_[axis] > 1 ? gridSize_[axis] - 2 : 0);
+    offset[axis] = gridSize_[axis] > 1 ? 1 : 0;
+    cell.referenceCorner(axis) = origin_(axis) + static_cast<scalar_t>(index[axis]) * resolution_;
+    cell.position(axis) = origin_(axis) + coordinate * resolution_;
+  }
+
+  for (size_t corner = 0; corner < 8; corner++) {
+    const size_t ix = index[0] + ((corner & 1) != 0 ? offset[0] : 0);
+    const size_t iy = index[1] + ((corner & 2) != 0 ? offset[1] : 0);
+    const size_t iz = index[2] + ((corner & 4) != 0 ? offset[2] : 0);
+    cell.cornerIndices[corner] = getStorageIndex(ix, iy, iz);
+  }
+  return cell;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::array<scalar_t, 8> GridDistanceField::getCornerValues(const Cell& cell) const {
+  std::array<scalar_t, 8> cornerValues;
+  for (size_t corner = 0; corner < 8; corner++) {
+    cornerValues[corner] = static_cast<scalar_t>(data_[cell.cornerIndices[corner]]);
+  }
+  return cornerValues;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void GridDistanceField::prefetch(const Cell& cell) const {
+#if defined(__GNUC__) || defined(__clang__)
+  // a z-layer of a tile is 64 bytes, hence the lowest and the highest corner cover the cell unless it crosses a tile boundary
+  __builtin_prefetch(data_.data() + cell.cornerIndices[0]);
+  __builtin_prefetch(data_.data() + cell.cornerIndices[7]);
+#endif
+}
+
+}  // namespace ocs2
@@ -0,0 +1,299 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_perceptive/distance_transform/GridDistanceTransform.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "ocs2_perceptive/distance_transform/ComputeDistanceTransform.h"
+
+namespace ocs2 {
+
+constexpr float GridDistanceTransform::Infinity;
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+GridDistanceTransform::GridDistanceTransform(size_t sizeX, size_t sizeY, size_t sizeZ, ThreadPool* threadPoolPtr)
+    : gridSize_{sizeX, sizeY, sizeZ}, threadPoolPtr_(threadPoolPtr) {
+  if (sizeX == 0 || sizeY == 0 || sizeZ == 0) {
+    throw std::runtime_error("[GridDistanceTransform] The grid size should be positive!");
+  }
+
+  // one set of buffers per thread which can work on a pass (see ThreadPool::parallelFor)
+  const size_t numBuffers = (threadPoolPtr_ != nullptr) ? threadPoolPtr_->numThreads() + 1 : 1;
+  const size_t maxLineSize = std::max({sizeX, sizeY, sizeZ});
+  lineBuffers_.resize(numBuffers);
+  for (auto& buffers : lineBuffers_) {
+    buffers.vBuffer.resize(maxLineSize);
+    buffers.zBuffer.resize(maxLineSize + 1);
+    buffers.line.resize(maxLineSize);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void GridDistanceTransform::computeSquaredDistance(std::vector<float>& values) {
+  if (values.size() != getNumCells()) {
+    throw std::runtime_error("[GridDistanceTransform] The number of values does not match the grid size!");
+  }
+  computeSquaredDistance(gridSize_, values.data());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void GridDistanceTransform::computeDistance(const std::vector<uint8_t>& occupancy, scalar_t resolution, std::vector<float>& distance,
+                                            scalar_t maxDistance) {
+  computeRegionSquaredDistance(occupancy, getFullRegion(), true, distance);
+
+  const auto r = static_cast<float>(resolution);
+  const auto dMax = static_cast<float>(std::min<scalar_t>(maxDistance, Infinity));
+  std::for_each(distance.begin(), distance.end(), [r, dMax](float& d) { d = std::min(r * std::sqrt(d), dMax); });
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void GridDistanceTransform::updateDistance(const std::vector<uint8_t>& occupancy, const GridRegion& dirtyRegion, scalar_t resolution,
+                                           scalar_t maxDistance, std::vector<float>& distance) {
+  if (dirtyRegion.empty()) {
+    return;
+  } else if (!std::isfinite(maxDistance)) {
+    computeDistance(occupancy, resolution, distance, maxDistance);
+    return;
+  }
+  if (distance.size() != getNumCells()) {
+    throw std::runtime_error("[GridDistanceTransform] The distance field does not match the grid size!");
+  }
+
+  // the cells within maxDistance of the dirty region depend on the sites within 2 * maxDistance of the dirty region
+  const auto margin = static_cast<size_t>(std::ceil(maxDistance / resolution));
+  const auto updatedRegion = dilate(dirtyRegion, margin);
+  const auto sitesRegion = dilate(dirtyRegion, 2 * margin);
+  computeRegionSquaredDistance(occupancy, sitesRegion, true, regionBuffer_);
+
+  const auto r = static_cast<float>(resolution);
+  const auto dMax = static_cast<float>(maxDistance);
+  const size_t regionSizeX = sitesRegion.end[0] - sitesRegion.begin[0];
+  const size_t regionSizeY = sitesRegion.end[1] - sitesRegion.begin[1];
+  for (size_t iz = updatedRegion.begin[2]; iz < updatedRegion.end[2]; iz++) {
+    for (size_t iy = updatedRegion.begin[1]; iy < updatedRegion.end[1]; iy++) {
+      const size_t regionRowStart = regionSizeX * ((iy - sitesRegion.begin[1]) + regionSizeY * (iz - sitesRegion.begin[2]));
+      for (size_t ix = updatedRegion.begin[0]; ix < updatedRegion.end[0]; ix++) {
+        const size_t i = regionRowStart + (ix - sitesRegion.begin[0]);
+        distance[getIndex(ix, iy, iz)] = std::min(r * std::sqrt(regionBuffer_[i]), dMax);
+      }
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void GridDistanceTransform::computeSignedDistance(const std::vector<uint8_t>& occupancy, scalar_t resolution,
+                                                  std::vector<float>& signedDistance, scalar_t maxDistance) {
+  // distance of the free cells to the occupied cells and vice versa
+  computeRegionSquaredDistance(occupancy, getFullRegion(), true, signedDistance);
+  computeRegionSquaredDistance(occupancy, getFullRegion(), false, complementBuffer_);
+
+  const auto r = static_cast<float>(resolution);
+  const auto dMax = static_cast<float>(std::min<scalar_t>(maxDistance, Infinity));
+  for (size_t i = 0; i < signedDistance.size(); i++) {
+    signedDistance[i] = std::min(r * std::sqrt(signedDistance[i]), dMax) - std::min(r * std::sqrt(complementBuffer_[i]), dMax);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void GridDistanceTransform::updateSignedDistance(const std::vector<uint8_t>& occupancy, const GridRegion& dirtyRegion,
+                                                 scalar_t resolution, scalar_t maxDistance, std::vector<float>& signedDistance) {
+  if (dirtyRegion.empty()) {
+    return;
+  } else if (!std::isfinite(maxDistance)) {
+    computeSignedDistance(occupancy, resolution, signedDistance, maxDistance);
+    return;
+  }
+  if (signedDistance.size() != getNumCells()) {
+    throw std::runtime_error("[GridDistanceTransform] The signed distance field does not match the grid size!");
+  }
+
+  // see updateDistance
+  const auto margin = static_cast<size_t>(std::ceil(maxDistance / resolution));
+  const auto updatedRegion = dilate(dirtyRegion, margin);
+  const auto sitesRegion = dilate(dirtyRegion, 2 * margin);
+  computeRegionSquaredDistance(occupancy, sitesRegion, true, regionBuffer_);
+  computeRegionSquaredDistance(occupancy, sitesRegion, false, complementBuffer_);
+
+  const auto r = static_cast<float>(resolution);
+  const auto dMax = static_cast<float>(maxDistance);
+  const size_t regionSizeX = sitesRegion.end[0] - sitesRegion.begin[0];
+  const size_t regionSizeY = sitesRegion.end[1] - sitesRegion.begin[1];
+  for (size_t iz = updatedRegion.begin[2]; iz < updatedRegion.end[2]; iz++) {
+    for (size_t iy = updatedRegion.begin[1]; iy < updatedRegion.end[1]; iy++) {
+      const size_t regionRowStart = regionSizeX * ((iy - sitesRegion.begin[1]) + regionSizeY * (iz - sitesRegion.begin[2]));
+      for (size_t ix = updatedRegion.begin[0]; ix < updatedRegion.end[0]; ix++) {
+        const size_t i = regionRowStart + (ix - sitesRegion.begin[0]);
+        signedDistance[getIndex(ix, iy, iz)] =
+            std::min(r * std::sqrt(regionBuffer_[i]), dMax) - std::min(r * std::sqrt(complementBuffer_[i]), dMax);
+      }
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void GridDistanceTransform::computeRegionSquaredDistance(const std::vector<uint8_t>& occupancy, const GridRegion& region,
+                                                         bool occupiedSites, std::vector<float>& regionValues) {
+  if (occupancy.size() != getNumCells()) {
+    throw std::runtime_error("[GridDistanceTransform] The size of the occupancy does not match the grid size!");
+  }
+
+  const std::array<size_t, 3> regionSize{region.end[0] - region.begin[0], region.end[1] - region.begin[1],
+                                         region.end[2] - region.begin[2]};
+  regionValues.resize(regionSize[0] * regionSize[1] * regionSize[2]);
+
+  const float siteValue = 0.0f;
+  const float otherValue = Infinity;
+  auto* valuePtr = regionValues.data();
+  for (size_t iz = region.begin[2]; iz < region.end[2]; iz++) {
+    for (size_t iy = region.begin[1]; iy < region.end[1]; iy++) {
+      const auto* occupancyPtr = occupancy.data() + getIndex(region.begin[0], iy, iz);
+      for (size_t i = 0; i < regionSize[0]; i++) {
+        *valuePtr++ = ((occupancyPtr[i] != 0) == occupiedSites) ? siteValue : otherValue;
+      }
+    }
+  }
+
+  computeSquaredDistance(regionSize, regionValues.data());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void GridDistanceTransform::computeSquaredDistance(const std::array<size_t, 3>& gridSize, float* values) {
+  for (size_t axis = 0; axis < 3; axis++) {
+    computePass(gridSize, axis, values);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void GridDistanceTransform::computePass(const std::array<size_t, 3>& gridSize, size_t axis, float* values) {
+  const size_t lineSize = gridSize[axis];
+  if (lineSize <= 1) {
+    return;  // the distance transform of a single sample is the identity
+  }
+
+  // the lines of the pass are enumerated such that consecutive lines are adjacent in memory
+  const size_t stride = (axis == 0) ? 1 : (axis == 1) ? gridSize[0] : gridSize[0] * gridSize[1];
+  const size_t numLines = gridSize[0] * gridSize[1] * gridSize[2] / lineSize;
+  const auto getLineStart = [&](size_t l) -> size_t {
+    switch (axis) {
+      case 0:
+        return l * gridSize[0];
+      case 1:
+        return (l % gridSize[0]) + (l / gridSize[0]) * gridSize[0] * gridSize[1];
+      default:
+        return l;
+    }
+  };
+
+  auto processLine = [&](int workerIndex, int l) {
+    auto& buffers = lineBuffers_[workerIndex];
+    const size_t lineStart = getLineStart(static_cast<size_t>(l));
+
+    // the line is gathered into a contiguous buffer since the transform reads the input while writing the output
+    auto& line = buffers.line;
+    for (size_t i = 0; i < lineSize; i++) {
+      line[i] = values[lineStart + i * stride];
+    }
+    computeDistanceTransform(
+        lineSize, [&](size_t i) { return line[i]; }, [&](size_t i, float val) { values[lineStart + i * stride] = val; }, 0, lineSize,
+        buffers.vBuffer, buffers.zBuffer);
+  };
+
+  if (threadPoolPtr_ != nullptr) {
+    constexpr int grain = 16;
+    threadPoolPtr_->parallelFor(0, static_cast<int>(numLines), grain, processLine);
+  } else {
+    for (size_t l = 0; l < numLines; l++) {
+      processLine(0, static_cast<int>(l));
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+GridRegion GridDistanceTransform::getFullRegion() const {
+  GridRegion region;
+  region.end = gridSize_;
+  return region;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+GridRegion GridDistanceTransform::dilate(const GridRegion& region, size_t numCells) const {
+  GridRegion dilatedRegion;
+  for (size_t axis = 0; axis < 3; axis++) {
+    dilatedRegion.begin[axis] = region.begin[axis] > numCells ? region.begin[axis] - numCells : 0;
+    dilatedRegion.end[axis] = std::min(region.end[axis] + numCells, gridSize_[axis]);
+  }
+  return dilatedRegion;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void elevationToOccupancy(const std::vector<float>& elevation, const std::array<size_t, 3>& gridSize, scalar_t minHeight,
+                          scalar_t resolution, std::vector<uint8_t>& occupancy) {
+  const size_t numColumns = gridSize[0] * gridSize[1];
+  if (elevation.size() != numColumns) {
+    throw std::runtime_error("[elevationToOccupancy] The size of the elevation map does not match the grid size!");
+  }
+
+  occupancy.resize(numColumns * gridSize[2]);
+  for (size_t iz = 0; iz < gridSize[2]; iz++) {
+    const auto cellHeight = static_cast<float>(minHeight + (iz + 0.5) * resolution);
+    auto* occupancySlice = occupancy.data() + iz * numColumns;
+    for (size_t c = 0; c < numColumns; c++) {
+      occupancySlice[c] = (cellHeight < elevation[c]) ? 1 : 0;
+    }
+  }
+}
+
+}  // namespace ocs2
@@ -103,9 +103,12 @@ vector_t EndEffectorDistanceConstraint::getValue(scalar_t time, const vector_t&
   const auto numEEs = kinematicsPtr_->getIds().size();
   const auto eePositions = kinematicsPtr_->getPosition(state);
 
+  scalar_array_t distances;
+  distanceTransformPtr_->getValues(eePositions, distances);
+
   vector_t g(numEEs);
   for (size_t i = 0; i < numEEs; i++) {
-    g(i) = weight_ * (distanceTransformPtr_->getValue(eePositions[i]) - clearances_[i]);
+    g(i) = weight_ * (distances[i] - clearances_[i]);
   }  // end of i loop
 
   return g;
@@ -123,11 +126,19 @@ VectorFunctionLinearApproximation EndEffectorDistanceConstraint::getLinearApprox
   const auto numEEs = kinematicsPtr_->getIds().size();
   const auto eePosLinApprox = kinematicsPtr_->getPositionLinearApproximation(state);
 
+  DistanceTransformInterface::matrix3x_t eePositions(3, numEEs);
+  for (size_t i = 0; i < numEEs; i++) {
+    eePositions.col(i) = eePosLinApprox[i].f;
+  }  // end of i loop
+
+  vector_t distances;
+  DistanceTransformInterface::matrix3x_t distanceGradients;
+  distanceTransformPtr_->getLinearApproximations(eePositions, distances, distanceGradients);
+
   VectorFunctionLinearApproximation approx = VectorFunctionLinearApproximation::Zero(numEEs, stateDim_, 0);
   for (size_t i = 0; i < numEEs; i++) {
-    const auto distanceValueGradient = distanceTransformPtr_->getLinearApproximation(eePosLinApprox[i].f);
-    approx.f(i) = weight_ * (distanceValueGradient.first - clearances_[i]);
-    approx.dfdx.row(i).noalias() = weight_ * (distanceValueGradient.second.transpose() * eePosLinApprox[i].dfdx);
+    approx.f(i) = weight_ * (distances(i) - clearances_[i]);
+    approx.dfdx.row(i).noalias() = weight_ * (distanceGradients.col(i).transpose() * eePosLinApprox[i].dfdx);
   }  // end of i loop
 
   return approx;
@@ -106,12 +106,11 @@ vector_t EndEffectorDistanceConstraintCppAd::getValue(scalar_t time, const vecto
   const auto eePositions = kinematicsModelPtr_->getFunctionValue(state);
   assert(eePositions.size() == 3 * numEEs);
 
-  vector_t g(numEEs);
-  for (size_t i = 0; i < numEEs; i++) {
-    g(i) = config_.weight * (distanceTransformPtr_->getValue(eePositions.segment<3>(3 * i)) - clearances_[i]);
-  }  // end of i loop
+  // the stacked positions are the columns of a 3xN matrix
+  vector_t distances;
+  distanceTransformPtr_->getValues(Eigen::Map<const DistanceTransformInterface::matrix3x_t>(eePositions.data(), 3, numEEs), distances);
 
-  return g;
+  return config_.weight * (distances - clearances_);
 }
 
 /******************************************************************************************************/
@@ -127,11 +126,15 @@ VectorFunctionLinearApproximation EndEffectorDistanceConstraintCppAd::getLinearA
   assert(eeJacobians.rows() == 3 * numEEs);
   assert(eeJacobians.cols() == stateDim_);
 
+  vector_t distances;
+  DistanceTransformInterface::matrix3x_t distanceGradients;
+  distanceTransformPtr_->getLinearApproximations(Eigen::Map<const DistanceTransformInterface::matrix3x_t>(eePositions.data(), 3, numEEs),
+                                                 distances, distanceGradients);
+
   VectorFunctionLinearApproximation approx = VectorFunctionLinearApproximation::Zero(numEEs, stateDim_, inputDim_);
+  approx.f = config_.weight * (distances - clearances_);
   for (size_t i = 0; i < numEEs; i++) {
-    const auto distanceValueGradient = distanceTransformPtr_->getLinearApproximation(eePositions.segment<3>(3 * i));
-    approx.f(i) = config_.weight * (distanceValueGradient.first - clearances_[i]);
-    approx.dfdx.row(i).noalias() = config_.weight * (distanceValueGradient.second.transpose() * eeJacobians.middleRows<3>(3 * i));
+    approx.dfdx.row(i).noalias() = config_.weight * (distanceGradients.col(i).transpose() * eeJacobians.middleRows<3>(3 * i));
   }  // end of i loop
 
   return approx;
@@ -0,0 +1,118 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+#include "ocs2_perceptive/distance_transform/AsyncGridDistanceField.h"
+
+namespace ocs2 {
+
+class TestAsyncGridDistanceField : public ::testing::Test {
+ protected:
+  using vector3_t = GridDistanceField::vector3_t;
+
+  static constexpr scalar_t resolution = 0.1;
+  static constexpr scalar_t maxDistance = 0.5;
+
+  TestAsyncGridDistanceField() : distanceTransform(gridSize[0], gridSize[1], gridSize[2]) {}
+
+  /** Waits until the worker has published a new field. */
+  static bool waitForUpdate(AsyncGridDistanceField& distanceField) {
+    const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (std::chrono::steady_clock::now() < timeout) {
+      if (distanceField.updateFromBuffer()) {
+        return true;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return false;
+  }
+
+  void expectEqual(const AsyncGridDistanceField& distanceField, const std::vector<uint8_t>& occupancy) {
+    std::vector<float> expected;
+    distanceTransform.computeSignedDistance(occupancy, resolution, expected, maxDistance);
+    for (size_t iz = 0; iz < gridSize[2]; iz++) {
+      for (size_t iy = 0; iy < gridSize[1]; iy++) {
+        for (size_t ix = 0; ix < gridSize[0]; ix++) {
+          const auto index = distanceTransform.getIndex(ix, iy, iz);
+          ASSERT_FLOAT_EQ(distanceField.getActiveField().getSample(ix, iy, iz), expected[index]);
+        }
+      }
+    }
+  }
+
+  const std::array<size_t, 3> gridSize{{20, 15, 10}};
+  const vector3_t origin{0.0, 0.0, 0.0};
+  GridDistanceTransform distanceTransform;
+};
+
+constexpr scalar_t TestAsyncGridDistanceField::resolution;
+constexpr scalar_t TestAsyncGridDistanceField::maxDistance;
+
+TEST_F(TestAsyncGridDistanceField, fullUpdate) {
+  AsyncGridDistanceField distanceField(gridSize, resolution, origin, maxDistance);
+  std::vector<uint8_t> occupancy(distanceTransform.getNumCells(), 0);
+  expectEqual(distanceField, occupancy);
+
+  occupancy[distanceTransform.getIndex(5, 5, 5)] = 1;
+  occupancy[distanceTransform.getIndex(12, 3, 7)] = 1;
+  distanceField.setOccupancy(occupancy);
+  ASSERT_TRUE(waitForUpdate(distanceField));
+  expectEqual(distanceField, occupancy);
+}
+
+TEST_F(TestAsyncGridDistanceField, incrementalUpdate) {
+  AsyncGridDistanceField distanceField(gridSize, resolution, origin, maxDistance);
+  std::vector<uint8_t> occupancy(distanceTransform.getNumCells(), 0);
+
+  // the dirty regions of the updates which are not picked up by the worker in between are merged
+  for (size_t i = 0; i < 5; i++) {
+    const std::array<size_t, 3> cell{{2 + 3 * i, 1 + 2 * i, 1 + i}};
+    occupancy[distanceTransform.getIndex(cell[0], cell[1], cell[2])] = 1;
+    GridRegion dirtyRegion;
+    dirtyRegion.begin = cell;
+    dirtyRegion.end = {{cell[0] + 1, cell[1] + 1, cell[2] + 1}};
+    distanceField.setOccupancy(occupancy, dirtyRegion);
+  }
+
+  // wait until the last occupancy is processed
+  std::vector<float> expected;
+  distanceTransform.computeSignedDistance(occupancy, resolution, expected, maxDistance);
+  const auto index = distanceTransform.getIndex(14, 9, 5);
+  const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (distanceField.getActiveField().getSample(14, 9, 5) != expected[index] && std::chrono::steady_clock::now() < timeout) {
+    waitForUpdate(distanceField);
+  }
+  expectEqual(distanceField, occupancy);
+}
+
+}  // namespace ocs2
@@ -0,0 +1,151 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/misc/Numerics.h>
+
+#include "ocs2_perceptive/distance_transform/GridDistanceField.h"
+
+namespace ocs2 {
+
+class TestGridDistanceField : public ::testing::Test {
+ protected:
+  using vector3_t = GridDistanceField::vector3_t;
+
+  static constexpr scalar_t resolution = 0.1;
+  static constexpr scalar_t tolerance = 1e-5;
+
+  TestGridDistanceField() : distanceField(gridSize, resolution, origin) {
+    // an affine function is exactly represented by the trilinear interpolation
+    std::vector<float> values;
+    values.reserve(gridSize[0] * gridSize[1] * gridSize[2]);
+    for (size_t iz = 0; iz < gridSize[2]; iz++) {
+      for (size_t iy = 0; iy < gridSize[1]; iy++) {
+        for (size_t ix = 0; ix < gridSize[0]; ix++) {
+          const vector3_t p = origin + resolution * vector3_t(ix, iy, iz);
+          values.push_back(affineFunction(p));
+        }
+      }
+    }
+    distanceField.setValues(values);
+  }
+
+  scalar_t affineFunction(const vector3_t& p) const { return slope.dot(p) + 0.5; }
+
+  const std::array<size_t, 3> gridSize{{9, 6, 5}};
+  const vector3_t origin{-0.3, 0.2, 0.1};
+  const vector3_t slope{0.3, -0.2, 0.1};
+  GridDistanceField distanceField;
+};
+
+constexpr scalar_t TestGridDistanceField::resolution;
+constexpr scalar_t TestGridDistanceField::tolerance;
+
+TEST_F(TestGridDistanceField, samples) {
+  for (size_t iz = 0; iz < gridSize[2]; iz++) {
+    for (size_t iy = 0; iy < gridSize[1]; iy++) {
+      for (size_t ix = 0; ix < gridSize[0]; ix++) {
+        const vector3_t p = origin + resolution * vector3_t(ix, iy, iz);
+        EXPECT_NEAR(distanceField.getSample(ix, iy, iz), affineFunction(p), tolerance);
+      }
+    }
+  }
+}
+
+TEST_F(TestGridDistanceField, linearApproximation) {
+  srand(0);
+  const vector3_t gridExtent = resolution * vector3_t(gridSize[0] - 1, gridSize[1] - 1, gridSize[2] - 1);
+  for (size_t i = 0; i < 100; i++) {
+    const vector3_t p = origin + gridExtent.cwiseProduct(vector3_t::Random().cwiseAbs());
+    const auto linearApproximation = distanceField.getLinearApproximation(p);
+    EXPECT_NEAR(distanceField.getValue(p), affineFunction(p), tolerance);
+    EXPECT_NEAR(linearApproximation.first, affineFunction(p), tolerance);
+    EXPECT_TRUE(linearApproximation.second.isApprox(slope, tolerance));
+  }
+
+  // the points outside of the grid are projected onto the boundary
+  const vector3_t outside = origin - vector3_t::Ones();
+  EXPECT_NEAR(distanceField.getValue(outside), affineFunction(origin), tolerance);
+}
+
+TEST_F(TestGridDistanceField, batchQueries) {
+  srand(1);
+  std::vector<vector3_t> points(37);
+  for (auto& p : points) {
+    p = origin + vector3_t::Random();
+  }
+
+  scalar_array_t values;
+  std::vector<std::pair<scalar_t, vector3_t>> linearApproximations;
+  distanceField.getValues(points, values);
+  distanceField.getLinearApproximations(points, linearApproximations);
+
+  ASSERT_EQ(values.size(), points.size());
+  ASSERT_EQ(linearApproximations.size(), points.size());
+  for (size_t i = 0; i < points.size(); i++) {
+    const auto expected = distanceField.getLinearApproximation(points[i]);
+    EXPECT_DOUBLE_EQ(values[i], expected.first);
+    EXPECT_DOUBLE_EQ(linearApproximations[i].first, expected.first);
+    EXPECT_TRUE(linearApproximations[i].second.isApprox(expected.second));
+  }
+}
+
+TEST_F(TestGridDistanceField, matrixBatchQueries) {
+  srand(1);
+  const GridDistanceField::matrix3x_t points = origin.replicate(1, 37) + GridDistanceField::matrix3x_t::Random(3, 37);
+
+  // the queries are made through the interface
+  const DistanceTransformInterface& distanceTransform = distanceField;
+  vector_t values, linearValues;
+  GridDistanceField::matrix3x_t gradients;
+  distanceTransform.getValues(points, values);
+  distanceTransform.getLinearApproximations(points, linearValues, gradients);
+
+  ASSERT_EQ(values.size(), points.cols());
+  ASSERT_EQ(gradients.cols(), points.cols());
+  for (Eigen::Index i = 0; i < points.cols(); i++) {
+    const auto expected = distanceField.getLinearApproximation(points.col(i));
+    EXPECT_DOUBLE_EQ(values(i), expected.first);
+    EXPECT_DOUBLE_EQ(linearValues(i), expected.first);
+    EXPECT_TRUE(gradients.col(i).isApprox(expected.second));
+  }
+}
+
+TEST(testGridDistanceField2D, singleLayer) {
+  using vector3_t = GridDistanceField::vector3_t;
+  GridDistanceField distanceField({{2, 2, 1}}, 1.0, vector3_t::Zero());
+  distanceField.setValues({0.0, 1.0, 2.0, 3.0});
+
+  const auto linearApproximation = distanceField.getLinearApproximation(vector3_t(0.5, 0.5, 3.0));
+  EXPECT_NEAR(linearApproximation.first, 1.5, 1e-9);
+  EXPECT_TRUE(linearApproximation.second.isApprox(vector3_t(1.0, 2.0, 0.0)));
+}
+
+}  // namespace ocs2
@@ -0,0 +1,168 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <cmath>
+#include <limits>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "ocs2_perceptive/distance_transform/GridDistanceTransform.h"
+
+namespace ocs2 {
+
+class TestGridDistanceTransform : public ::testing::TestWithParam<std::array<size_t, 3>> {
+ protected:
+  static constexpr scalar_t resolution = 0.1;
+  static constexpr scalar_t tolerance = 1e-5;
+
+  TestGridDistanceTransform() : gridSize(GetParam()) {
+    std::mt19937 generator(0);
+    std::bernoulli_distribution occupied(0.1);
+    occupancy.resize(gridSize[0] * gridSize[1] * gridSize[2]);
+    for (auto& o : occupancy) {
+      o = occupied(generator) ? 1 : 0;
+    }
+  }
+
+  /** Brute force distance of the cell to the nearest cell with the given occupancy. */
+  scalar_t getBruteForceDistance(size_t ix, size_t iy, size_t iz, uint8_t targetOccupancy) const {
+    scalar_t minSquaredDistance = std::numeric_limits<scalar_t>::max();
+    for (size_t jz = 0; jz < gridSize[2]; jz++) {
+      for (size_t jy = 0; jy < gridSize[1]; jy++) {
+        for (size_t jx = 0; jx < gridSize[0]; jx++) {
+          if (occupancy[jx + gridSize[0] * (jy + gridSize[1] * jz)] == targetOccupancy) {
+            const scalar_t dx = static_cast<scalar_t>(ix) - static_cast<scalar_t>(jx);
+            const scalar_t dy = static_cast<scalar_t>(iy) - static_cast<scalar_t>(jy);
+            const scalar_t dz = static_cast<scalar_t>(iz) - static_cast<scalar_t>(jz);
+            minSquaredDistance = std::min(minSquaredDistance, dx * dx + dy * dy + dz * dz);
+          }
+        }
+      }
+    }
+    return resolution * std::sqrt(minSquaredDistance);
+  }
+
+  const std::array<size_t, 3> gridSize;
+  std::vector<uint8_t> occupancy;
+};
+
+constexpr scalar_t TestGridDistanceTransform::resolution;
+constexpr scalar_t TestGridDistanceTransform::tolerance;
+
+TEST_P(TestGridDistanceTransform, distance) {
+  ThreadPool threadPool(3);
+  GridDistanceTransform serialTransform(gridSize[0], gridSize[1], gridSize[2]);
+  GridDistanceTransform parallelTransform(gridSize[0], gridSize[1], gridSize[2], &threadPool);
+
+  std::vector<float> serialDistance, parallelDistance;
+  serialTransform.computeDistance(occupancy, resolution, serialDistance);
+  parallelTransform.computeDistance(occupancy, resolution, parallelDistance);
+
+  for (size_t iz = 0; iz < gridSize[2]; iz++) {
+    for (size_t iy = 0; iy < gridSize[1]; iy++) {
+      for (size_t ix = 0; ix < gridSize[0]; ix++) {
+        const size_t index = serialTransform.getIndex(ix, iy, iz);
+        const scalar_t expected = getBruteForceDistance(ix, iy, iz, 1);
+        EXPECT_NEAR(serialDistance[index], expected, tolerance);
+        EXPECT_EQ(serialDistance[index], parallelDistance[index]);
+      }
+    }
+  }
+}
+
+TEST_P(TestGridDistanceTransform, signedDistance) {
+  ThreadPool threadPool(2);
+  GridDistanceTransform distanceTransform(gridSize[0], gridSize[1], gridSize[2], &threadPool);
+
+  std::vector<float> signedDistance;
+  distanceTransform.computeSignedDistance(occupancy, resolution, signedDistance);
+
+  for (size_t iz = 0; iz < gridSize[2]; iz++) {
+    for (size_t iy = 0; iy < gridSize[1]; iy++) {
+      for (size_t ix = 0; ix < gridSize[0]; ix++) {
+        const size_t index = distanceTransform.getIndex(ix, iy, iz);
+        const scalar_t expected =
+            occupancy[index] != 0 ? -getBruteForceDistance(ix, iy, iz, 0) : getBruteForceDistance(ix, iy, iz, 1);
+        EXPECT_NEAR(signedDistance[index], expected, tolerance);
+      }
+    }
+  }
+}
+
+TEST_P(TestGridDistanceTransform, incrementalUpdate) {
+  constexpr scalar_t maxDistance = 0.35;
+  ThreadPool threadPool(2);
+  GridDistanceTransform distanceTransform(gridSize[0], gridSize[1], gridSize[2], &threadPool);
+
+  std::vector<float> distance, signedDistance;
+  distanceTransform.computeDistance(occupancy, resolution, distance, maxDistance);
+  distanceTransform.computeSignedDistance(occupancy, resolution, signedDistance, maxDistance);
+
+  // change the occupancy within a region
+  GridRegion dirtyRegion;
+  for (size_t axis = 0; axis < 3; axis++) {
+    dirtyRegion.begin[axis] = gridSize[axis] / 3;
+    dirtyRegion.end[axis] = std::max(gridSize[axis] / 2, dirtyRegion.begin[axis] + 1);
+  }
+  for (size_t iz = dirtyRegion.begin[2]; iz < dirtyRegion.end[2]; iz++) {
+    for (size_t iy = dirtyRegion.begin[1]; iy < dirtyRegion.end[1]; iy++) {
+      for (size_t ix = dirtyRegion.begin[0]; ix < dirtyRegion.end[0]; ix++) {
+        auto& o = occupancy[distanceTransform.getIndex(ix, iy, iz)];
+        o = 1 - o;
+      }
+    }
+  }
+  distanceTransform.updateDistance(occupancy, dirtyRegion, resolution, maxDistance, distance);
+  distanceTransform.updateSignedDistance(occupancy, dirtyRegion, resolution, maxDistance, signedDistance);
+
+  std::vector<float> expectedDistance, expectedSignedDistance;
+  distanceTransform.computeDistance(occupancy, resolution, expectedDistance, maxDistance);
+  distanceTransform.computeSignedDistance(occupancy, resolution, expectedSignedDistance, maxDistance);
+  for (size_t i = 0; i < distance.size(); i++) {
+    EXPECT_NEAR(distance[i], expectedDistance[i], tolerance);
+    EXPECT_NEAR(signedDistance[i], expectedSignedDistance[i], tolerance);
+  }
+}
+
+INSTANTIATE_TEST_CASE_P(GridSizes, TestGridDistanceTransform,
+                        ::testing::Values(std::array<size_t, 3>{13, 11, 1}, std::array<size_t, 3>{9, 7, 6},
+                                          std::array<size_t, 3>{1, 12, 5}));
+
+TEST(testElevationToOccupancy, columns) {
+  const std::array<size_t, 3> gridSize{2, 1, 4};
+  const std::vector<float> elevation{0.25, 0.0};
+  std::vector<uint8_t> occupancy;
+  elevationToOccupancy(elevation, gridSize, 0.0, 0.1, occupancy);
+
+  const std::vector<uint8_t> expected{1, 0, 1, 0, 0, 0, 0, 0};
+  EXPECT_EQ(occupancy, expected);
+}
+
+}  // namespace ocs2
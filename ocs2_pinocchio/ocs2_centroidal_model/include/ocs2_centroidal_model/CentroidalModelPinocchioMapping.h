@@ -90,6 +90,12 @@ class CentroidalModelPinocchioMappingTpl final : public PinocchioStateInputMappi
    */
   vector_t getPinocchioJointPosition(const vector_t& state) const override;
 
+  /**
+   * Writes the pinocchio joint positions into q without allocating memory once q has the right size. Use
+   * centroidal_model::getGeneralizedCoordinates(state, info) to access them in the state without a copy.
+   */
+  void getPinocchioJointPosition(const vector_t& state, vector_t& q) const override;
+
   /**
    * Computes the vector of generalized velocities (vPinocchio) used by pinocchio functions from the robot state and input variables
    * @param [in] state: system state vector
@@ -101,6 +107,9 @@ class CentroidalModelPinocchioMappingTpl final : public PinocchioStateInputMappi
    */
   vector_t getPinocchioJointVelocity(const vector_t& state, const vector_t& input) const override;
 
+  /** Writes the pinocchio joint velocities into v without allocating memory once v has the right size. */
+  void getPinocchioJointVelocity(const vector_t& state, const vector_t& input, vector_t& v) const override;
+
   /**
    * Maps pinocchio jacobians dfdq, dfdv to OCS2 jacobians dfdx, dfdu.
    * @param [in] state: system state vector
@@ -115,6 +124,12 @@ class CentroidalModelPinocchioMappingTpl final : public PinocchioStateInputMappi
    */
   std::pair<matrix_t, matrix_t> getOcs2Jacobian(const vector_t& state, const matrix_t& Jq, const matrix_t& Jv) const override;
 
+  /**
+   * Writes the OCS2 jacobians into dfdx and dfdu, see getOcs2Jacobian(state, Jq, Jv). The jacobians of the pinocchio velocities with
+   * respect to the state and input are not formed, Jv is multiplied by their nonzero blocks directly.
+   */
+  void getOcs2Jacobian(const vector_t& state, const matrix_t& Jq, const matrix_t& Jv, matrix_t& dfdx, matrix_t& dfdu) const override;
+
   /**
    * Returns a structure containing robot-specific information needed for the centroidal dynamics computations.
    */
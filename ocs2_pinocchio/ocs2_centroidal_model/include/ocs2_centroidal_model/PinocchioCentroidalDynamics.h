@@ -118,5 +118,10 @@ class PinocchioCentroidalDynamics final {
   Matrix3x normalizedAngularMomentumRateDerivativeQ_;
   Matrix3x normalizedLinearMomentumRateDerivativeInput_;
   Matrix3x normalizedAngularMomentumRateDerivativeInput_;
+
+  // buffers of the pinocchio joint velocities and of the jacobians with respect to the pinocchio coordinates
+  vector_t vPinocchio_;
+  matrix_t dfdq_;
+  matrix_t dfdv_;
 };
 }  // namespace ocs2
@@ -77,13 +77,30 @@ auto CentroidalModelPinocchioMappingTpl<SCALAR>::getPinocchioJointPosition(const
   return centroidal_model::getGeneralizedCoordinates(state, centroidalModelInfo_);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <typename SCALAR>
+void CentroidalModelPinocchioMappingTpl<SCALAR>::getPinocchioJointPosition(const vector_t& state, vector_t& q) const {
+  q = centroidal_model::getGeneralizedCoordinates(state, centroidalModelInfo_);
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 template <typename SCALAR>
 auto CentroidalModelPinocchioMappingTpl<SCALAR>::getPinocchioJointVelocity(const vector_t& state, const vector_t& input) const -> vector_t {
-  const auto& model = pinocchioInterfacePtr_->getModel();
-  const auto& data = pinocchioInterfacePtr_->getData();
+  vector_t vPinocchio;
+  getPinocchioJointVelocity(state, input, vPinocchio);
+  return vPinocchio;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <typename SCALAR>
+void CentroidalModelPinocchioMappingTpl<SCALAR>::getPinocchioJointVelocity(const vector_t& state, const vector_t& input,
+                                                                           vector_t& vPinocchio) const {
   const auto& info = centroidalModelInfo_;
   assert(info.stateDim == state.rows());
   assert(info.inputDim == input.rows());
@@ -99,11 +116,9 @@ auto CentroidalModelPinocchioMappingTpl<SCALAR>::getPinocchioJointVelocity(const
     momentum.noalias() -= A.rightCols(info.actuatedDofNum) * jointVelocities;
   }
 
-  vector_t vPinocchio(info.generalizedCoordinatesNum);
+  vPinocchio.resize(info.generalizedCoordinatesNum);
   vPinocchio.template head<6>().noalias() = Ab_inv * momentum;
   vPinocchio.tail(info.actuatedDofNum) = jointVelocities;
-
-  return vPinocchio;
 }
 
 /******************************************************************************************************/
@@ -112,23 +127,40 @@ auto CentroidalModelPinocchioMappingTpl<SCALAR>::getPinocchioJointVelocity(const
 template <typename SCALAR>
 auto CentroidalModelPinocchioMappingTpl<SCALAR>::getOcs2Jacobian(const vector_t& state, const matrix_t& Jq, const matrix_t& Jv) const
     -> std::pair<matrix_t, matrix_t> {
+  std::pair<matrix_t, matrix_t> dfdxu;
+  getOcs2Jacobian(state, Jq, Jv, dfdxu.first, dfdxu.second);
+  return dfdxu;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <typename SCALAR>
+void CentroidalModelPinocchioMappingTpl<SCALAR>::getOcs2Jacobian(const vector_t& state, const matrix_t& Jq, const matrix_t& Jv,
+                                                                 matrix_t& dfdx, matrix_t& dfdu) const {
   const auto& model = pinocchioInterfacePtr_->getModel();
   const auto& data = pinocchioInterfacePtr_->getData();
   const auto& info = centroidalModelInfo_;
   assert(info.stateDim == state.rows());
+  assert(Jq.rows() == Jv.rows());
 
-  // Partial derivatives of joint velocities
-  matrix_t jointVelocitiesDerivativeInput = matrix_t::Zero(info.actuatedDofNum, info.inputDim);
-  jointVelocitiesDerivativeInput.rightCols(info.actuatedDofNum).setIdentity();
-
-  // Partial derivatives of the floating base variables
+  /*
+   * The pinocchio velocities are v = [vb; u_joints] with the floating base velocities vb = Ab_inv * (mass * h_normalized - Aj * u_joints).
+   * Hence, dfdx = [0, Jq] + Jv_b * dvb/dx and dfdu = Jv_b * dvb/du + [0, Jv_j], where the derivatives of vb are only formed as
+   * products with Jv_b = Jv.leftCols<6>().
+   */
   // TODO: move getFloatingBaseCentroidalMomentumMatrixInverse(Ab) to PreComputation
-  matrix_t floatingBaseVelocitiesDerivativeState = matrix_t::Zero(6, info.stateDim);
-  matrix_t floatingBaseVelocitiesDerivativeInput = matrix_t::Zero(6, info.inputDim);
   const auto& A = getCentroidalMomentumMatrix(*pinocchioInterfacePtr_);
   const Eigen::Matrix<SCALAR, 6, 6> Ab = A.template leftCols<6>();
   const auto Ab_inv = computeFloatingBaseCentroidalMomentumMatrixInverse(Ab);
-  floatingBaseVelocitiesDerivativeState.leftCols(6) = info.robotMass * Ab_inv;
+  const matrix_t JvbAbInv = Jv.leftCols(6) * Ab_inv;
+
+  dfdx.setZero(Jq.rows(), info.stateDim);
+  dfdx.leftCols(6) = info.robotMass * JvbAbInv;
+  dfdx.middleCols(6, info.generalizedCoordinatesNum) = Jq;
+
+  dfdu.setZero(Jq.rows(), info.inputDim);
+  dfdu.rightCols(info.actuatedDofNum) = Jv.rightCols(info.actuatedDofNum);
 
   using matrix6x_t = Eigen::Matrix<SCALAR, 6, Eigen::Dynamic>;
   matrix6x_t dhdq(6, info.generalizedCoordinatesNum);
@@ -141,29 +173,19 @@ auto CentroidalModelPinocchioMappingTpl<SCALAR>::getOcs2Jacobian(const vector_t&
       }
       dhdq.middleCols(3, 3) = data.dFdq.middleCols(3, 3);
       const auto Aj = A.rightCols(info.actuatedDofNum);
-      floatingBaseVelocitiesDerivativeState.rightCols(info.generalizedCoordinatesNum).noalias() = -Ab_inv * dhdq;
-      floatingBaseVelocitiesDerivativeInput.rightCols(info.actuatedDofNum).noalias() = -Ab_inv * Aj;
+      dfdx.rightCols(info.generalizedCoordinatesNum).noalias() -= JvbAbInv * dhdq;
+      dfdu.rightCols(info.actuatedDofNum).noalias() -= JvbAbInv * Aj;
       break;
     }
     case CentroidalModelType::SingleRigidBodyDynamics: {
       dhdq = data.dFdq;
-      floatingBaseVelocitiesDerivativeState.middleCols(6, 6).noalias() = -Ab_inv * dhdq.leftCols(6);
+      dfdx.middleCols(6, 6).noalias() -= JvbAbInv * dhdq.leftCols(6);
       break;
     }
     default: {
       throw std::runtime_error("The chosen centroidal model type is not supported.");
     }
   }
-
-  matrix_t dvdx = matrix_t::Zero(info.generalizedCoordinatesNum, info.stateDim);
-  dvdx.template topRows<6>() = floatingBaseVelocitiesDerivativeState;
-  matrix_t dvdu = matrix_t::Zero(info.generalizedCoordinatesNum, info.inputDim);
-  dvdu << floatingBaseVelocitiesDerivativeInput, jointVelocitiesDerivativeInput;
-  matrix_t dfdx = matrix_t::Zero(Jq.rows(), centroidalModelInfo_.stateDim);
-  dfdx.middleCols(6, info.generalizedCoordinatesNum) = Jq;
-  dfdx.noalias() += Jv * dvdx;
-  const matrix_t dfdu = Jv * dvdu;
-  return {dfdx, dfdu};
 }
 
 // explicit template instantiation
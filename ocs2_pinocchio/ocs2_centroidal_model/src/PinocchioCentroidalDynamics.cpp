@@ -57,7 +57,9 @@ vector_t PinocchioCentroidalDynamics::getValue(scalar_t time, const vector_t& st
   assert(info.stateDim == state.rows());
 
   vector_t f(info.stateDim);
-  f << getNormalizedCentroidalMomentumRate(interface, info, input), mapping_.getPinocchioJointVelocity(state, input);
+  f.head<6>() = getNormalizedCentroidalMomentumRate(interface, info, input);
+  mapping_.getPinocchioJointVelocity(state, input, vPinocchio_);
+  f.tail(info.generalizedCoordinatesNum) = vPinocchio_;
 
   return f;
 }
@@ -71,18 +73,22 @@ VectorFunctionLinearApproximation PinocchioCentroidalDynamics::getLinearApproxim
   assert(info.stateDim == state.rows());
   assert(info.inputDim == input.rows());
 
-  auto dynamics = ocs2::VectorFunctionLinearApproximation::Zero(info.stateDim, info.stateDim, info.inputDim);
+  VectorFunctionLinearApproximation dynamics;
   dynamics.f = getValue(time, state, input);
 
   // Partial derivatives of the normalized momentum rates
   computeNormalizedCentroidalMomentumRateGradients(state, input);
 
-  matrix_t dfdq = matrix_t::Zero(info.stateDim, info.generalizedCoordinatesNum);
-  matrix_t dfdv = matrix_t::Zero(info.stateDim, info.generalizedCoordinatesNum);
-  dfdq.topRows<6>() << normalizedLinearMomentumRateDerivativeQ_, normalizedAngularMomentumRateDerivativeQ_;
-  dfdv.bottomRows(info.generalizedCoordinatesNum).setIdentity();
+  // the buffers are only resized on the first call
+  dfdq_.setZero(info.stateDim, info.generalizedCoordinatesNum);
+  dfdq_.topRows<3>() = normalizedLinearMomentumRateDerivativeQ_;
+  dfdq_.middleRows<3>(3) = normalizedAngularMomentumRateDerivativeQ_;
+  if (dfdv_.rows() != info.stateDim || dfdv_.cols() != info.generalizedCoordinatesNum) {
+    dfdv_.setZero(info.stateDim, info.generalizedCoordinatesNum);
+    dfdv_.bottomRows(info.generalizedCoordinatesNum).setIdentity();
+  }
 
-  std::tie(dynamics.dfdx, dynamics.dfdu) = mapping_.getOcs2Jacobian(state, dfdq, dfdv);
+  mapping_.getOcs2Jacobian(state, dfdq_, dfdv_, dynamics.dfdx, dynamics.dfdu);
 
   // Add partial derivative of f with respect to u since part of f depends explicitly on the inputs (contact forces + torques)
   dynamics.dfdu.topRows<3>() += normalizedLinearMomentumRateDerivativeInput_;
@@ -125,8 +131,8 @@ void PinocchioCentroidalDynamics::computeNormalizedCentroidalMomentumRateGradien
     normalizedAngularMomentumRateDerivativeQ_.noalias() -= f_hat * J;
     normalizedLinearMomentumRateDerivativeInput_.block<3, 3>(0, inputIdx).diagonal().array() = 1.0 / info.robotMass;
     p_hat = skewSymmetricMatrix(getPositionComToContactPointInWorldFrame(interface, info, i)) / info.robotMass;
-    normalizedAngularMomentumRateDerivativeInput_.block<3, 3>(0, 3 * inputIdx) = p_hat;
-    normalizedAngularMomentumRateDerivativeInput_.block<3, 3>(0, 3 * inputIdx + 3).diagonal().array() = 1.0 / info.robotMass;
+    normalizedAngularMomentumRateDerivativeInput_.block<3, 3>(0, inputIdx) = p_hat;
+    normalizedAngularMomentumRateDerivativeInput_.block<3, 3>(0, inputIdx + 3).diagonal().array() = 1.0 / info.robotMass;
   }
 }
 
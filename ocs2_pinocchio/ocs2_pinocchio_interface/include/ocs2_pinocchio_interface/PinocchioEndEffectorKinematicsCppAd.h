@@ -109,6 +109,23 @@ class PinocchioEndEffectorKinematicsCppAd final : public EndEffectorKinematics<s
   std::vector<VectorFunctionLinearApproximation> getOrientationErrorLinearApproximation(
       const vector_t& state, const std::vector<quaternion_t>& referenceOrientations) const override;
 
+  /**
+   * Evaluates the positions and the linear velocities of all the end-effectors with a single evaluation of the combined model.
+   *
+   * @param [in] state: The state vector.
+   * @param [in] input: The input vector.
+   * @param [out] kinematics: The stacked values [positions; velocities] of size 6 * numEndEffectors, where the position and the velocity
+   *                          of the i-th end-effector start at rows 3 * i and 3 * (numEndEffectors + i). The memory is reused.
+   */
+  void getPositionAndVelocity(const vector_t& state, const vector_t& input, vector_t& kinematics) const;
+
+  /**
+   * Linear approximation of the positions and the linear velocities of all the end-effectors with a single evaluation of the combined
+   * model. The rows are stacked as in getPositionAndVelocity(). The memory of the output is reused.
+   */
+  void getPositionAndVelocityLinearApproximation(const vector_t& state, const vector_t& input,
+                                                 VectorFunctionLinearApproximation& kinematics) const;
+
  private:
   PinocchioEndEffectorKinematicsCppAd(const PinocchioEndEffectorKinematicsCppAd& rhs);
 
@@ -123,6 +140,7 @@ class PinocchioEndEffectorKinematicsCppAd final : public EndEffectorKinematics<s
   std::unique_ptr<CppAdInterface> positionCppAdInterfacePtr_;
   std::unique_ptr<CppAdInterface> velocityCppAdInterfacePtr_;
   std::unique_ptr<CppAdInterface> orientationErrorCppAdInterfacePtr_;
+  std::unique_ptr<CppAdInterface> kinematicsCppAdInterfacePtr_;
 
   const std::vector<std::string> endEffectorIds_;
   std::vector<size_t> endEffectorFrameIds_;
@@ -54,7 +54,8 @@ using PinocchioInterfaceCppAd = PinocchioInterfaceTpl<ad_scalar_t>;
 
 /**
  * Pinocchio interface class contatining robot model and data.
- * The robot model is shared between interface instances.
+ * The robot model is shared between interface instances. The data is a per-instance workspace: a copy gets its own data allocated from
+ * the shared model instead of a copy of the data content, i.e., the kinematic quantities have to be recomputed after copying.
  */
 template <typename SCALAR>
 class PinocchioInterfaceTpl final {
@@ -77,13 +78,13 @@ class PinocchioInterfaceTpl final {
   /** Destructor */
   ~PinocchioInterfaceTpl();
 
-  /** Copy constructor */
+  /** Copy constructor. Shares the model and allocates new data. */
   PinocchioInterfaceTpl(const PinocchioInterfaceTpl& rhs);
 
   /** Move constructor */
   PinocchioInterfaceTpl(PinocchioInterfaceTpl&& rhs);
 
-  /** Copy assignment operator */
+  /** Copy assignment operator. Shares the model and keeps the current data if it is allocated for the same model. */
   PinocchioInterfaceTpl& operator=(const PinocchioInterfaceTpl& rhs);
 
   /** Move assignment */
@@ -0,0 +1,108 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <memory>
+
+#include <ocs2_core/PreComputation.h>
+#include <ocs2_pinocchio_interface/PinocchioInterface.h>
+#include <ocs2_pinocchio_interface/PinocchioStateInputMapping.h>
+
+namespace ocs2 {
+
+/**
+ * Pre-computation of the kinematic quantities of a PinocchioInterface which are shared by all the pinocchio based cost and constraint
+ * terms. The terms read the updated pinocchio::Data through getPinocchioInterface(), e.g., by setting it to a
+ * PinocchioEndEffectorKinematics.
+ *
+ * The quantities are computed at most once per (state, input) and request: if a request only needs quantities which are already
+ * computed for the same point, e.g., a value request following an approximation request, the computation is skipped.
+ */
+class PinocchioPreComputation : public PreComputation {
+ public:
+  /** Selects the computed quantities. */
+  struct Settings {
+    /** The requests which trigger the computation. */
+    RequestSet triggerRequests = Request::Cost + Request::Constraint + Request::SoftConstraint;
+
+    /** pinocchio::updateFramePlacements(model, data) */
+    bool updateFramePlacements = true;
+
+    /** pinocchio::forwardKinematics(model, data, q, v) instead of pinocchio::forwardKinematics(model, data, q) at intermediate times. */
+    bool computeVelocities = false;
+
+    /** pinocchio::computeJointJacobians(model, data). Only for approximation requests. */
+    bool computeJointJacobians = true;
+
+    /** pinocchio::computeForwardKinematicsDerivatives(model, data, q, v, 0). Only for approximation requests at intermediate times. */
+    bool computeKinematicsDerivatives = false;
+  };
+
+  /**
+   * Constructor
+   *
+   * @param [in] pinocchioInterface: The pinocchio interface whose data is updated.
+   * @param [in] mapping: The mapping from the OCS2 state and input to the pinocchio joint position and velocity.
+   * @param [in] settings: The computed quantities.
+   */
+  PinocchioPreComputation(PinocchioInterface pinocchioInterface, const PinocchioStateInputMapping<scalar_t>& mapping, Settings settings);
+
+  ~PinocchioPreComputation() override = default;
+  PinocchioPreComputation* clone() const override { return new PinocchioPreComputation(*this); }
+
+  void request(RequestSet request, scalar_t t, const vector_t& x, const vector_t& u) override;
+  void requestPreJump(RequestSet request, scalar_t t, const vector_t& x) override;
+  void requestFinal(RequestSet request, scalar_t t, const vector_t& x) override;
+
+  const PinocchioInterface& getPinocchioInterface() const { return pinocchioInterface_; }
+  const PinocchioStateInputMapping<scalar_t>& getPinocchioMapping() const { return *mappingPtr_; }
+  const Settings& getSettings() const { return settings_; }
+
+ protected:
+  PinocchioPreComputation(const PinocchioPreComputation& rhs);
+
+ private:
+  /** The levels of the computed quantities */
+  enum class Level { None, Value, Approximation };
+
+  void update(RequestSet request, const vector_t& x, const vector_t* uPtr);
+
+  PinocchioInterface pinocchioInterface_;
+  std::unique_ptr<PinocchioStateInputMapping<scalar_t>> mappingPtr_;
+  const Settings settings_;
+
+  // the point at which the pinocchio data is computed
+  Level computedLevel_ = Level::None;
+  bool hasVelocity_ = false;
+  vector_t q_;
+  vector_t v_;
+};
+
+}  // namespace ocs2
@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <tuple>
+
 #include <ocs2_core/Types.h>
 #include <ocs2_pinocchio_interface/PinocchioInterface.h>
 
@@ -56,6 +58,22 @@ class PinocchioStateInputMapping {
   /** Mapps pinocchio jacobians dfdq, dfdv to OCS2 jacobians dfdx, dfdu. */
   virtual std::pair<matrix_t, matrix_t> getOcs2Jacobian(const vector_t& state, const matrix_t& Jq, const matrix_t& Jv) const = 0;
 
+  /**
+   * Writes the pinocchio joint configuration into an output whose memory is reused between the calls. The default implementation
+   * copies the result of getPinocchioJointPosition(state).
+   */
+  virtual void getPinocchioJointPosition(const vector_t& state, vector_t& q) const { q = getPinocchioJointPosition(state); }
+
+  /** Writes the pinocchio joint velocity into an output whose memory is reused between the calls, see getPinocchioJointPosition(). */
+  virtual void getPinocchioJointVelocity(const vector_t& state, const vector_t& input, vector_t& v) const {
+    v = getPinocchioJointVelocity(state, input);
+  }
+
+  /** Writes the OCS2 jacobians dfdx, dfdu into outputs whose memory is reused between the calls, see getPinocchioJointPosition(). */
+  virtual void getOcs2Jacobian(const vector_t& state, const matrix_t& Jq, const matrix_t& Jv, matrix_t& dfdx, matrix_t& dfdu) const {
+    std::tie(dfdx, dfdu) = getOcs2Jacobian(state, Jq, Jv);
+  }
+
   /** If the mapping requires PinocchioInterface, use this method and set an updated PinocchioInterface. */
   virtual void setPinocchioInterface(const PinocchioInterfaceTpl<SCALAR>& pinocchioInterface) {}
 
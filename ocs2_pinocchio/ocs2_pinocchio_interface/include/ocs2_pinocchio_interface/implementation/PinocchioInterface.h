@@ -59,7 +59,7 @@ PinocchioInterfaceTpl<SCALAR>::~PinocchioInterfaceTpl() = default;
 /******************************************************************************************************/
 template <typename SCALAR>
 PinocchioInterfaceTpl<SCALAR>::PinocchioInterfaceTpl(const PinocchioInterfaceTpl<SCALAR>& rhs)
-    : robotModelPtr_(rhs.robotModelPtr_), robotDataPtr_(new Data(*rhs.robotDataPtr_)), urdfModelPtr_(rhs.urdfModelPtr_) {}
+    : robotModelPtr_(rhs.robotModelPtr_), robotDataPtr_(new Data(*rhs.robotModelPtr_)), urdfModelPtr_(rhs.urdfModelPtr_) {}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -75,8 +75,14 @@ PinocchioInterfaceTpl<SCALAR>::PinocchioInterfaceTpl(PinocchioInterfaceTpl<SCALA
 /******************************************************************************************************/
 template <typename SCALAR>
 PinocchioInterfaceTpl<SCALAR>& PinocchioInterfaceTpl<SCALAR>::operator=(const PinocchioInterfaceTpl<SCALAR>& rhs) {
+  if (this == &rhs) {
+    return *this;
+  }
+  // the data is only reallocated if it does not match the model
+  if (robotDataPtr_ == nullptr || robotModelPtr_ != rhs.robotModelPtr_) {
+    robotDataPtr_.reset(new Data(*rhs.robotModelPtr_));
+  }
   robotModelPtr_ = rhs.robotModelPtr_;
-  robotDataPtr_.reset(new Data(*rhs.robotDataPtr_));
   urdfModelPtr_ = rhs.urdfModelPtr_;
   return *this;
 }
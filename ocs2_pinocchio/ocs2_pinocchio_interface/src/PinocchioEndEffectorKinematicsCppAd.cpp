@@ -39,6 +39,24 @@ namespace {
 
 void defaultUpdatePinocchioInterface(const ocs2::ad_vector_t&, ocs2::PinocchioInterfaceTpl<ocs2::ad_scalar_t>&) {}
 
+/** Per thread buffers for the evaluation of the taped kinematics, such that repeated evaluations do not allocate memory. */
+struct KinematicsWorkspace {
+  ocs2::vector_t input;
+  ocs2::vector_t parameters;
+  ocs2::vector_t values;
+  ocs2::matrix_t jacobian;
+};
+
+KinematicsWorkspace& getWorkspace(size_t inputDim, size_t parameterDim, size_t rangeDim) {
+  thread_local KinematicsWorkspace workspace;
+  // resizing is a no-op if the dimensions do not change
+  workspace.input.resize(inputDim);
+  workspace.parameters.resize(parameterDim);
+  workspace.values.resize(rangeDim);
+  workspace.jacobian.resize(rangeDim, inputDim);
+  return workspace;
+}
+
 }  // unnamed namespace
 
 namespace ocs2 {
@@ -99,14 +117,28 @@ PinocchioEndEffectorKinematicsCppAd::PinocchioEndEffectorKinematicsCppAd(
   orientationErrorCppAdInterfacePtr_.reset(
       new CppAdInterface(orientationFunc, stateDim, 4 * endEffectorFrameIds_.size(), modelName + "_orientation", modelFolder));
 
+  // combined position and velocity function
+  auto kinematicsFunc = [&, this](const ad_vector_t& x, ad_vector_t& y) {
+    const ad_vector_t state = x.head(stateDim);
+    const ad_vector_t input = x.tail(inputDim);
+    updateCallback(state, pinocchioInterfaceCppAd);
+    const ad_vector_t velocities = getVelocityCppAd(pinocchioInterfaceCppAd, *mappingPtr, state, input);
+    // the placements of the velocity computation are reused
+    pinocchio::updateFramePlacements(pinocchioInterfaceCppAd.getModel(), pinocchioInterfaceCppAd.getData());
+    y.resize(2 * velocities.size());
+    for (int i = 0; i < endEffectorFrameIds_.size(); i++) {
+      y.segment<3>(3 * i) = pinocchioInterfaceCppAd.getData().oMf[endEffectorFrameIds_[i]].translation();
+    }
+    y.tail(velocities.size()) = velocities;
+  };
+  kinematicsCppAdInterfacePtr_.reset(new CppAdInterface(kinematicsFunc, stateDim + inputDim, modelName + "_kinematics", modelFolder));
+
+  const std::vector<CppAdInterface*> interfaces{positionCppAdInterfacePtr_.get(), velocityCppAdInterfacePtr_.get(),
+                                                orientationErrorCppAdInterfacePtr_.get(), kinematicsCppAdInterfacePtr_.get()};
   if (recompileLibraries) {
-    positionCppAdInterfacePtr_->createModels(CppAdInterface::ApproximationOrder::First, verbose);
-    velocityCppAdInterfacePtr_->createModels(CppAdInterface::ApproximationOrder::First, verbose);
-    orientationErrorCppAdInterfacePtr_->createModels(CppAdInterface::ApproximationOrder::First, verbose);
+    CppAdInterface::createModelsConcurrently(interfaces, CppAdInterface::ApproximationOrder::First, verbose);
   } else {
-    positionCppAdInterfacePtr_->loadModelsIfAvailable(CppAdInterface::ApproximationOrder::First, verbose);
-    velocityCppAdInterfacePtr_->loadModelsIfAvailable(CppAdInterface::ApproximationOrder::First, verbose);
-    orientationErrorCppAdInterfacePtr_->loadModelsIfAvailable(CppAdInterface::ApproximationOrder::First, verbose);
+    CppAdInterface::loadModelsIfAvailableConcurrently(interfaces, CppAdInterface::ApproximationOrder::First, verbose);
   }
 }
 
@@ -118,6 +150,7 @@ PinocchioEndEffectorKinematicsCppAd::PinocchioEndEffectorKinematicsCppAd(const P
       positionCppAdInterfacePtr_(new CppAdInterface(*rhs.positionCppAdInterfacePtr_)),
       velocityCppAdInterfacePtr_(new CppAdInterface(*rhs.velocityCppAdInterfacePtr_)),
       orientationErrorCppAdInterfacePtr_(new CppAdInterface(*rhs.orientationErrorCppAdInterfacePtr_)),
+      kinematicsCppAdInterfacePtr_(new CppAdInterface(*rhs.kinematicsCppAdInterfacePtr_)),
       endEffectorIds_(rhs.endEffectorIds_),
       endEffectorFrameIds_(rhs.endEffectorFrameIds_) {}
 
@@ -160,11 +193,12 @@ ad_vector_t PinocchioEndEffectorKinematicsCppAd::getPositionCppAd(PinocchioInter
 /******************************************************************************************************/
 /******************************************************************************************************/
 auto PinocchioEndEffectorKinematicsCppAd::getPosition(const vector_t& state) const -> std::vector<vector3_t> {
-  const vector_t positionValues = positionCppAdInterfacePtr_->getFunctionValue(state);
+  auto& workspace = getWorkspace(state.rows(), 0, 3 * endEffectorIds_.size());
+  positionCppAdInterfacePtr_->getFunctionValue(state, workspace.parameters, workspace.values);
 
   std::vector<vector3_t> positions;
   for (int i = 0; i < endEffectorIds_.size(); i++) {
-    positions.emplace_back(positionValues.segment<3>(3 * i));
+    positions.emplace_back(workspace.values.segment<3>(3 * i));
   }
   return positions;
 }
@@ -174,14 +208,15 @@ auto PinocchioEndEffectorKinematicsCppAd::getPosition(const vector_t& state) con
 /******************************************************************************************************/
 std::vector<VectorFunctionLinearApproximation> PinocchioEndEffectorKinematicsCppAd::getPositionLinearApproximation(
     const vector_t& state) const {
-  const vector_t positionValues = positionCppAdInterfacePtr_->getFunctionValue(state);
-  const matrix_t positionJacobian = positionCppAdInterfacePtr_->getJacobian(state);
+  auto& workspace = getWorkspace(state.rows(), 0, 3 * endEffectorIds_.size());
+  positionCppAdInterfacePtr_->getFunctionValue(state, workspace.parameters, workspace.values);
+  positionCppAdInterfacePtr_->getJacobian(state, workspace.parameters, workspace.jacobian);
 
   std::vector<VectorFunctionLinearApproximation> positions;
   for (int i = 0; i < endEffectorIds_.size(); i++) {
     VectorFunctionLinearApproximation pos;
-    pos.f = positionValues.segment<3>(3 * i);
-    pos.dfdx = positionJacobian.block(3 * i, 0, 3, state.rows());
+    pos.f = workspace.values.segment<3>(3 * i);
+    pos.dfdx = workspace.jacobian.block(3 * i, 0, 3, state.rows());
     positions.emplace_back(std::move(pos));
   }
   return positions;
@@ -213,13 +248,13 @@ ad_vector_t PinocchioEndEffectorKinematicsCppAd::getVelocityCppAd(PinocchioInter
 /******************************************************************************************************/
 /******************************************************************************************************/
 auto PinocchioEndEffectorKinematicsCppAd::getVelocity(const vector_t& state, const vector_t& input) const -> std::vector<vector3_t> {
-  vector_t stateInput(state.rows() + input.rows());
-  stateInput << state, input;
-  const vector_t velocityValues = velocityCppAdInterfacePtr_->getFunctionValue(stateInput);
+  auto& workspace = getWorkspace(state.rows() + input.rows(), 0, 3 * endEffectorIds_.size());
+  workspace.input << state, input;
+  velocityCppAdInterfacePtr_->getFunctionValue(workspace.input, workspace.parameters, workspace.values);
 
   std::vector<vector3_t> velocities;
   for (int i = 0; i < endEffectorIds_.size(); i++) {
-    velocities.emplace_back(velocityValues.segment<3>(3 * i));
+    velocities.emplace_back(workspace.values.segment<3>(3 * i));
   }
   return velocities;
 }
@@ -229,17 +264,17 @@ auto PinocchioEndEffectorKinematicsCppAd::getVelocity(const vector_t& state, con
 /******************************************************************************************************/
 std::vector<VectorFunctionLinearApproximation> PinocchioEndEffectorKinematicsCppAd::getVelocityLinearApproximation(
     const vector_t& state, const vector_t& input) const {
-  vector_t stateInput(state.rows() + input.rows());
-  stateInput << state, input;
-  const vector_t velocityValues = velocityCppAdInterfacePtr_->getFunctionValue(stateInput);
-  const matrix_t velocityJacobian = velocityCppAdInterfacePtr_->getJacobian(stateInput);
+  auto& workspace = getWorkspace(state.rows() + input.rows(), 0, 3 * endEffectorIds_.size());
+  workspace.input << state, input;
+  velocityCppAdInterfacePtr_->getFunctionValue(workspace.input, workspace.parameters, workspace.values);
+  velocityCppAdInterfacePtr_->getJacobian(workspace.input, workspace.parameters, workspace.jacobian);
 
   std::vector<VectorFunctionLinearApproximation> velocities;
   for (int i = 0; i < endEffectorIds_.size(); i++) {
     VectorFunctionLinearApproximation vel;
-    vel.f = velocityValues.segment<3>(3 * i);
-    vel.dfdx = velocityJacobian.block(3 * i, 0, 3, state.rows());
-    vel.dfdu = velocityJacobian.block(3 * i, state.rows(), 3, input.rows());
+    vel.f = workspace.values.segment<3>(3 * i);
+    vel.dfdx = workspace.jacobian.block(3 * i, 0, 3, state.rows());
+    vel.dfdu = workspace.jacobian.block(3 * i, state.rows(), 3, input.rows());
     velocities.emplace_back(std::move(vel));
   }
   return velocities;
@@ -251,16 +286,16 @@ std::vector<VectorFunctionLinearApproximation> PinocchioEndEffectorKinematicsCpp
 auto PinocchioEndEffectorKinematicsCppAd::getOrientationError(const vector_t& state,
                                                               const std::vector<quaternion_t>& referenceOrientations) const
     -> std::vector<vector3_t> {
-  vector_t params(4 * endEffectorIds_.size());
+  auto& workspace = getWorkspace(state.rows(), 4 * endEffectorIds_.size(), 3 * endEffectorIds_.size());
   for (int i = 0; i < endEffectorIds_.size(); i++) {
-    params.segment<4>(i) = referenceOrientations[i].coeffs();
+    workspace.parameters.segment<4>(4 * i) = referenceOrientations[i].coeffs();
   }
 
-  const vector_t errorValues = orientationErrorCppAdInterfacePtr_->getFunctionValue(state, params);
+  orientationErrorCppAdInterfacePtr_->getFunctionValue(state, workspace.parameters, workspace.values);
 
   std::vector<vector3_t> errors;
   for (int i = 0; i < endEffectorIds_.size(); i++) {
-    errors.emplace_back(errorValues.segment<3>(3 * i));
+    errors.emplace_back(workspace.values.segment<3>(3 * i));
   }
   return errors;
 }
@@ -270,24 +305,48 @@ auto PinocchioEndEffectorKinematicsCppAd::getOrientationError(const vector_t& st
 /******************************************************************************************************/
 std::vector<VectorFunctionLinearApproximation> PinocchioEndEffectorKinematicsCppAd::getOrientationErrorLinearApproximation(
     const vector_t& state, const std::vector<quaternion_t>& referenceOrientations) const {
-  vector_t params(4 * endEffectorIds_.size());
+  auto& workspace = getWorkspace(state.rows(), 4 * endEffectorIds_.size(), 3 * endEffectorIds_.size());
   for (int i = 0; i < endEffectorIds_.size(); i++) {
-    params.segment<4>(i) = referenceOrientations[i].coeffs();
+    workspace.parameters.segment<4>(4 * i) = referenceOrientations[i].coeffs();
   }
 
-  const vector_t errorValues = orientationErrorCppAdInterfacePtr_->getFunctionValue(state, params);
-  const matrix_t errorJacobian = orientationErrorCppAdInterfacePtr_->getJacobian(state, params);
+  orientationErrorCppAdInterfacePtr_->getFunctionValue(state, workspace.parameters, workspace.values);
+  orientationErrorCppAdInterfacePtr_->getJacobian(state, workspace.parameters, workspace.jacobian);
 
   std::vector<VectorFunctionLinearApproximation> errors;
   for (int i = 0; i < endEffectorIds_.size(); i++) {
     VectorFunctionLinearApproximation err;
-    err.f = errorValues.segment<3>(3 * i);
-    err.dfdx = errorJacobian.block(3 * i, 0, 3, state.rows());
+    err.f = workspace.values.segment<3>(3 * i);
+    err.dfdx = workspace.jacobian.block(3 * i, 0, 3, state.rows());
     errors.emplace_back(std::move(err));
   }
   return errors;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PinocchioEndEffectorKinematicsCppAd::getPositionAndVelocity(const vector_t& state, const vector_t& input, vector_t& kinematics) const {
+  auto& workspace = getWorkspace(state.rows() + input.rows(), 0, 6 * endEffectorIds_.size());
+  workspace.input << state, input;
+  kinematics.resize(6 * endEffectorIds_.size());
+  kinematicsCppAdInterfacePtr_->getFunctionValue(workspace.input, workspace.parameters, kinematics);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PinocchioEndEffectorKinematicsCppAd::getPositionAndVelocityLinearApproximation(const vector_t& state, const vector_t& input,
+                                                                                    VectorFunctionLinearApproximation& kinematics) const {
+  auto& workspace = getWorkspace(state.rows() + input.rows(), 0, 6 * endEffectorIds_.size());
+  workspace.input << state, input;
+  kinematics.resize(6 * endEffectorIds_.size(), state.rows(), input.rows());
+  kinematicsCppAdInterfacePtr_->getFunctionValue(workspace.input, workspace.parameters, kinematics.f);
+  kinematicsCppAdInterfacePtr_->getJacobian(workspace.input, workspace.parameters, workspace.jacobian);
+  kinematics.dfdx = workspace.jacobian.leftCols(state.rows());
+  kinematics.dfdu = workspace.jacobian.rightCols(input.rows());
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -0,0 +1,132 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <pinocchio/fwd.hpp>
+
+#include <pinocchio/algorithm/frames.hpp>
+#include <pinocchio/algorithm/jacobian.hpp>
+#include <pinocchio/algorithm/kinematics-derivatives.hpp>
+#include <pinocchio/algorithm/kinematics.hpp>
+
+#include <ocs2_pinocchio_interface/PinocchioPreComputation.h>
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+PinocchioPreComputation::PinocchioPreComputation(PinocchioInterface pinocchioInterface, const PinocchioStateInputMapping<scalar_t>& mapping,
+                                                 Settings settings)
+    : pinocchioInterface_(std::move(pinocchioInterface)), mappingPtr_(mapping.clone()), settings_(std::move(settings)) {
+  mappingPtr_->setPinocchioInterface(pinocchioInterface_);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+PinocchioPreComputation::PinocchioPreComputation(const PinocchioPreComputation& rhs)
+    : PreComputation(rhs), pinocchioInterface_(rhs.pinocchioInterface_), mappingPtr_(rhs.mappingPtr_->clone()), settings_(rhs.settings_) {
+  mappingPtr_->setPinocchioInterface(pinocchioInterface_);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PinocchioPreComputation::request(RequestSet request, scalar_t t, const vector_t& x, const vector_t& u) {
+  update(request, x, &u);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PinocchioPreComputation::requestPreJump(RequestSet request, scalar_t t, const vector_t& x) {
+  update(request, x, nullptr);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PinocchioPreComputation::requestFinal(RequestSet request, scalar_t t, const vector_t& x) {
+  update(request, x, nullptr);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PinocchioPreComputation::update(RequestSet request, const vector_t& x, const vector_t* uPtr) {
+  if (!request.containsAny(settings_.triggerRequests)) {
+    return;
+  }
+
+  const Level requiredLevel = request.contains(Request::Approximation) ? Level::Approximation : Level::Value;
+  const bool withVelocities = settings_.computeVelocities && uPtr != nullptr;
+  const bool withKinematicsDerivatives =
+      settings_.computeKinematicsDerivatives && requiredLevel == Level::Approximation && uPtr != nullptr;
+
+  const bool needsVelocity = withVelocities || withKinematicsDerivatives;
+
+  auto q = mappingPtr_->getPinocchioJointPosition(x);
+  vector_t v;
+  if (needsVelocity) {
+    v = mappingPtr_->getPinocchioJointVelocity(x, *uPtr);
+  }
+
+  // skip if the required quantities are already computed at the same point
+  const bool isSamePoint = q.size() == q_.size() && q == q_ && (!needsVelocity || (hasVelocity_ && v.size() == v_.size() && v == v_));
+  if (isSamePoint && computedLevel_ >= requiredLevel) {
+    return;
+  }
+
+  const auto& model = pinocchioInterface_.getModel();
+  auto& data = pinocchioInterface_.getData();
+
+  if (withVelocities) {
+    pinocchio::forwardKinematics(model, data, q, v);
+  } else {
+    pinocchio::forwardKinematics(model, data, q);
+  }
+  if (settings_.updateFramePlacements) {
+    pinocchio::updateFramePlacements(model, data);
+  }
+  if (requiredLevel == Level::Approximation) {
+    if (settings_.computeJointJacobians) {
+      pinocchio::computeJointJacobians(model, data);
+    }
+    if (withKinematicsDerivatives) {
+      pinocchio::computeForwardKinematicsDerivatives(model, data, q, v, vector_t::Zero(model.nv));
+    }
+  }
+
+  computedLevel_ = requiredLevel;
+  hasVelocity_ = needsVelocity;
+  q_.swap(q);
+  v_.swap(v);
+}
+
+}  // namespace ocs2
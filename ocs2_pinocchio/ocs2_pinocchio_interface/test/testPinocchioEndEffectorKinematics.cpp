@@ -35,6 +35,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_pinocchio_interface/PinocchioEndEffectorKinematics.h>
 #include <ocs2_pinocchio_interface/PinocchioEndEffectorKinematicsCppAd.h>
+#include <ocs2_pinocchio_interface/PinocchioPreComputation.h>
 #include <ocs2_pinocchio_interface/urdf.h>
 
 #include <ocs2_core/automatic_differentiation/FiniteDifferenceMethods.h>
@@ -172,6 +173,26 @@ TEST_F(TestEndEffectorKinematics, testPositionApproximation) {
   compareApproximation(eePosLin, eePosLinAd);
 }
 
+TEST_F(TestEndEffectorKinematics, testPreComputation) {
+  ocs2::PinocchioPreComputation preComputation(*pinocchioInterfacePtr, pinocchioMapping, ocs2::PinocchioPreComputation::Settings());
+  eeKinematicsPtr->setPinocchioInterface(preComputation.getPinocchioInterface());
+
+  preComputation.request(ocs2::Request::Constraint + ocs2::Request::Approximation, 0.0, x, u);
+  compareApproximation(eeKinematicsPtr->getPositionLinearApproximation(x)[0], eeKinematicsCppAdPtr->getPositionLinearApproximation(x)[0]);
+
+  // a value request at the same point keeps the joint jacobians
+  preComputation.request(ocs2::Request::Cost, 0.0, x, u);
+  compareApproximation(eeKinematicsPtr->getPositionLinearApproximation(x)[0], eeKinematicsCppAdPtr->getPositionLinearApproximation(x)[0]);
+
+  // requests which are not triggering the computation are ignored
+  const ocs2::vector_t xNew = x + ocs2::vector_t::Constant(x.size(), 0.1);
+  preComputation.request(ocs2::Request::Dynamics, 0.0, xNew, u);
+  EXPECT_TRUE(eeKinematicsPtr->getPosition(x)[0].isApprox(eeKinematicsCppAdPtr->getPosition(x)[0]));
+
+  preComputation.requestFinal(ocs2::Request::Cost, 0.0, xNew);
+  EXPECT_TRUE(eeKinematicsPtr->getPosition(xNew)[0].isApprox(eeKinematicsCppAdPtr->getPosition(xNew)[0]));
+}
+
 TEST_F(TestEndEffectorKinematics, testVelocity) {
   const auto& model = pinocchioInterfacePtr->getModel();
   auto& data = pinocchioInterfacePtr->getData();
@@ -200,6 +221,24 @@ TEST_F(TestEndEffectorKinematics, testVelocityApproximation) {
   compareApproximation(eeVelLin, eeVelLinAd, /* functionOfInput = */ true);
 }
 
+TEST_F(TestEndEffectorKinematics, testPositionAndVelocityApproximation) {
+  const auto positionApprox = eeKinematicsCppAdPtr->getPositionLinearApproximation(x)[0];
+  const auto velocityApprox = eeKinematicsCppAdPtr->getVelocityLinearApproximation(x, u)[0];
+
+  ocs2::vector_t kinematics;
+  eeKinematicsCppAdPtr->getPositionAndVelocity(x, u, kinematics);
+  ocs2::VectorFunctionLinearApproximation kinematicsApprox;
+  eeKinematicsCppAdPtr->getPositionAndVelocityLinearApproximation(x, u, kinematicsApprox);
+
+  EXPECT_TRUE(kinematics.isApprox(kinematicsApprox.f));
+  EXPECT_TRUE(kinematicsApprox.f.head<3>().isApprox(positionApprox.f));
+  EXPECT_TRUE(kinematicsApprox.dfdx.topRows<3>().isApprox(positionApprox.dfdx));
+  EXPECT_TRUE(kinematicsApprox.dfdu.topRows<3>().isZero());
+  EXPECT_TRUE(kinematicsApprox.f.tail<3>().isApprox(velocityApprox.f));
+  EXPECT_TRUE(kinematicsApprox.dfdx.bottomRows<3>().isApprox(velocityApprox.dfdx));
+  EXPECT_TRUE(kinematicsApprox.dfdu.bottomRows<3>().isApprox(velocityApprox.dfdu));
+}
+
 TEST_F(TestEndEffectorKinematics, testOrientationError) {
   const auto& model = pinocchioInterfacePtr->getModel();
   auto& data = pinocchioInterfacePtr->getData();
@@ -8,3 +8,16 @@ TEST(testPinocchioInterface, buildFromXml) {
   auto pinocchio = ocs2::getPinocchioInterfaceFromUrdfString(cartPoleUrdf);
   std::cout << pinocchio;
 }
+
+TEST(testPinocchioInterface, copySharesModel) {
+  auto pinocchio = ocs2::getPinocchioInterfaceFromUrdfString(cartPoleUrdf);
+  ocs2::PinocchioInterface copy(pinocchio);
+  EXPECT_EQ(&pinocchio.getModel(), &copy.getModel());
+  EXPECT_NE(&pinocchio.getData(), &copy.getData());
+
+  // assigning an interface of the same model keeps the data
+  const auto* dataPtr = &copy.getData();
+  copy = pinocchio;
+  EXPECT_EQ(&pinocchio.getModel(), &copy.getModel());
+  EXPECT_EQ(dataPtr, &copy.getData());
+}
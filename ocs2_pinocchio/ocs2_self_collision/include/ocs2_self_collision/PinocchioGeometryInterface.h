@@ -29,8 +29,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <limits>
+#include <stdexcept>
 #include <utility>
+#include <vector>
 
+#include <ocs2_core/thread_support/ThreadPool.h>
 #include <ocs2_pinocchio_interface/PinocchioInterface.h>
 
 #include <hpp/fcl/collision_data.h>
@@ -70,12 +74,38 @@ class PinocchioGeometryInterface final {
   /**
    * Compute collision pair distances
    *
+   * The pairs whose bounding spheres are further apart than the broad phase distance plus the blending width (see
+   * setBroadPhaseDistance) skip the exact distance computation. For these pairs, the distance between the bounding spheres is
+   * returned, which is a lower bound of the actual distance, and the nearest points are the points of the spheres on the line through
+   * their centers. Within the blending width, the exact and the sphere results are interpolated linearly in the sphere distance, such
+   * that the returned distance stays a continuous lower bound of the actual distance.
+   *
    * @note Requires pinocchioInterface with updated joint placements by calling forwardKinematics().
    *
    * @param [in] pinocchioInterface: pinocchio interface of the robot model
+   * @param [in] threadPoolPtr: An optional thread pool over which the collision pairs are distributed.
    * @return An array of distances between pairs of collision bodies defined in the constructor.
    */
-  std::vector<hpp::fcl::DistanceResult> computeDistances(const PinocchioInterface& pinocchioInterface) const;
+  std::vector<hpp::fcl::DistanceResult> computeDistances(const PinocchioInterface& pinocchioInterface,
+                                                         ThreadPool* threadPoolPtr = nullptr) const;
+
+  /**
+   * Sets the distance between the bounding spheres of a collision pair above which the exact distance is blended into the sphere
+   * distance. By default, the exact distance is computed for all pairs.
+   *
+   * @param [in] broadPhaseDistance: The sphere distance up to which the exact distance is returned.
+   * @param [in] blendingWidth: The width of the sphere distance interval beyond broadPhaseDistance over which the exact distance is
+   * blended into the sphere distance. A zero width makes the distance discontinuous at the broad phase distance.
+   */
+  void setBroadPhaseDistance(scalar_t broadPhaseDistance, scalar_t blendingWidth) {
+    if (blendingWidth < 0.0) {
+      throw std::runtime_error("[PinocchioGeometryInterface] The broad phase blending width must be non-negative!");
+    }
+    broadPhaseDistance_ = broadPhaseDistance;
+    broadPhaseBlendingWidth_ = blendingWidth;
+  }
+  scalar_t getBroadPhaseDistance() const { return broadPhaseDistance_; }
+  scalar_t getBroadPhaseBlendingWidth() const { return broadPhaseBlendingWidth_; }
 
   /** Get the number of collision pairs */
   size_t getNumCollisionPairs() const;
@@ -91,8 +121,15 @@ class PinocchioGeometryInterface final {
                                const std::vector<std::pair<size_t, size_t>>& collisionObjectPairs);
   void addCollisionLinkPairs(const PinocchioInterface& pinocchioInterface,
                              const std::vector<std::pair<std::string, std::string>>& collisionLinkPairs);
+  void computeBoundingSpheres();
 
   std::shared_ptr<pinocchio::GeometryModel> geometryModelPtr_;
+
+  // the bounding spheres of the geometry objects in their local frames
+  std::vector<Eigen::Matrix<scalar_t, 3, 1>> boundingSphereCenters_;
+  scalar_array_t boundingSphereRadii_;
+  scalar_t broadPhaseDistance_ = std::numeric_limits<scalar_t>::infinity();
+  scalar_t broadPhaseBlendingWidth_ = 0.0;
 };
 
 }  // namespace ocs2
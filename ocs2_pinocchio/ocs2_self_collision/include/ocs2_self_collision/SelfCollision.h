@@ -43,8 +43,9 @@ class SelfCollision {
    *
    * @param [in] pinocchioGeometryInterface: pinocchio geometry interface of the robot model
    * @parma [in] minimumDistance: minimum allowed distance between each collision pair
+   * @param [in] threadPoolPtr: An optional thread pool over which the collision pairs are distributed.
    */
-  SelfCollision(PinocchioGeometryInterface pinocchioGeometryInterface, scalar_t minimumDistance);
+  SelfCollision(PinocchioGeometryInterface pinocchioGeometryInterface, scalar_t minimumDistance, ThreadPool* threadPoolPtr = nullptr);
 
   /** Get the number of collision pairs */
   size_t getNumCollisionPairs() const { return pinocchioGeometryInterface_.getNumCollisionPairs(); }
@@ -76,6 +77,11 @@ class SelfCollision {
  private:
   PinocchioGeometryInterface pinocchioGeometryInterface_;
   scalar_t minimumDistance_;
+  ThreadPool* threadPoolPtr_;
+
+  // the parent joints of the collision objects, and the index of the parent joints of each pair in collisionJoints_
+  std::vector<size_t> collisionJoints_;
+  std::vector<std::pair<size_t, size_t>> pairJointIndices_;
 };
 
 }  // namespace ocs2
@@ -49,9 +49,10 @@ class SelfCollisionConstraint : public StateConstraint {
    * @param [in] mapping: The pinocchio mapping from pinocchio states to ocs2 states.
    * @param [in] pinocchioGeometryInterface: Pinocchio geometry interface of the robot model.
    * @param [in] minimumDistance: The minimum allowed distance between collision pairs.
+   * @param [in] threadPoolPtr: An optional thread pool over which the collision pairs are distributed.
    */
   SelfCollisionConstraint(const PinocchioStateInputMapping<scalar_t>& mapping, PinocchioGeometryInterface pinocchioGeometryInterface,
-                          scalar_t minimumDistance);
+                          scalar_t minimumDistance, ThreadPool* threadPoolPtr = nullptr);
 
   ~SelfCollisionConstraint() override = default;
 
@@ -40,6 +40,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <urdf_parser/urdf_parser.h>
 
+#include <algorithm>
+#include <cmath>
+
 namespace ocs2 {
 
 /******************************************************************************************************/
@@ -51,6 +54,7 @@ PinocchioGeometryInterface::PinocchioGeometryInterface(const PinocchioInterface&
   buildGeomFromPinocchioInterface(pinocchioInterface, *geometryModelPtr_);
 
   addCollisionObjectPairs(pinocchioInterface, collisionObjectPairs);
+  computeBoundingSpheres();
 }
 
 PinocchioGeometryInterface::PinocchioGeometryInterface(const PinocchioInterface& pinocchioInterface,
@@ -61,16 +65,67 @@ PinocchioGeometryInterface::PinocchioGeometryInterface(const PinocchioInterface&
 
   addCollisionObjectPairs(pinocchioInterface, collisionObjectPairs);
   addCollisionLinkPairs(pinocchioInterface, collisionLinkPairs);
+  computeBoundingSpheres();
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-std::vector<hpp::fcl::DistanceResult> PinocchioGeometryInterface::computeDistances(const PinocchioInterface& pinocchioInterface) const {
+std::vector<hpp::fcl::DistanceResult> PinocchioGeometryInterface::computeDistances(const PinocchioInterface& pinocchioInterface,
+                                                                                   ThreadPool* threadPoolPtr) const {
   pinocchio::GeometryData geometryData(*geometryModelPtr_);
 
   pinocchio::updateGeometryPlacements(pinocchioInterface.getModel(), pinocchioInterface.getData(), *geometryModelPtr_, geometryData);
-  pinocchio::computeDistances(*geometryModelPtr_, geometryData);
+  if (std::isinf(broadPhaseDistance_) && threadPoolPtr == nullptr) {
+    pinocchio::computeDistances(*geometryModelPtr_, geometryData);
+    return std::move(geometryData.distanceResults);
+  }
+
+  // the computation of a pair only writes to the request and result entries of that pair in geometryData
+  auto computePairDistance = [&](int workerIndex, int i) {
+    const auto& collisionPair = geometryModelPtr_->collisionPairs[i];
+    if (!std::isinf(broadPhaseDistance_)) {
+      const Eigen::Matrix<scalar_t, 3, 1> center1 = geometryData.oMg[collisionPair.first].act(boundingSphereCenters_[collisionPair.first]);
+      const Eigen::Matrix<scalar_t, 3, 1> center2 =
+          geometryData.oMg[collisionPair.second].act(boundingSphereCenters_[collisionPair.second]);
+      const scalar_t centerDistance = (center2 - center1).norm();
+      const scalar_t sphereDistance =
+          centerDistance - boundingSphereRadii_[collisionPair.first] - boundingSphereRadii_[collisionPair.second];
+
+      // the exact distance is blended into the sphere distance over the blending width, such that the distance is continuous
+      const scalar_t exactDistanceBound = std::max(broadPhaseDistance_, scalar_t(0.0));
+      if (sphereDistance > exactDistanceBound) {
+        const Eigen::Matrix<scalar_t, 3, 1> direction = (center2 - center1) / centerDistance;
+        const Eigen::Matrix<scalar_t, 3, 1> spherePoint1 = center1 + boundingSphereRadii_[collisionPair.first] * direction;
+        const Eigen::Matrix<scalar_t, 3, 1> spherePoint2 = center2 - boundingSphereRadii_[collisionPair.second] * direction;
+        auto& distanceResult = geometryData.distanceResults[i];
+
+        if (sphereDistance >= exactDistanceBound + broadPhaseBlendingWidth_) {
+          distanceResult.clear();
+          distanceResult.min_distance = sphereDistance;
+          distanceResult.nearest_points[0] = spherePoint1;
+          distanceResult.nearest_points[1] = spherePoint2;
+        } else {
+          pinocchio::computeDistance(*geometryModelPtr_, geometryData, i);
+          const scalar_t sphereWeight = (sphereDistance - exactDistanceBound) / broadPhaseBlendingWidth_;
+          distanceResult.min_distance = (1.0 - sphereWeight) * distanceResult.min_distance + sphereWeight * sphereDistance;
+          distanceResult.nearest_points[0] = (1.0 - sphereWeight) * distanceResult.nearest_points[0] + sphereWeight * spherePoint1;
+          distanceResult.nearest_points[1] = (1.0 - sphereWeight) * distanceResult.nearest_points[1] + sphereWeight * spherePoint2;
+        }
+        return;
+      }
+    }
+    pinocchio::computeDistance(*geometryModelPtr_, geometryData, i);
+  };
+
+  const int numCollisionPairs = static_cast<int>(geometryModelPtr_->collisionPairs.size());
+  if (threadPoolPtr != nullptr) {
+    threadPoolPtr->parallelFor(0, numCollisionPairs, 1, computePairDistance);
+  } else {
+    for (int i = 0; i < numCollisionPairs; ++i) {
+      computePairDistance(0, i);
+    }
+  }
 
   return std::move(geometryData.distanceResults);
 }
@@ -139,4 +194,19 @@ void PinocchioGeometryInterface::addCollisionLinkPairs(const PinocchioInterface&
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PinocchioGeometryInterface::computeBoundingSpheres() {
+  const auto& geometryObjects = geometryModelPtr_->geometryObjects;
+  boundingSphereCenters_.resize(geometryObjects.size());
+  boundingSphereRadii_.resize(geometryObjects.size());
+  for (size_t i = 0; i < geometryObjects.size(); ++i) {
+    auto& geometry = *geometryObjects[i].geometry;
+    geometry.computeLocalAABB();
+    boundingSphereCenters_[i] = geometry.aabb_center;
+    boundingSphereRadii_[i] = geometry.aabb_radius;
+  }
+}
+
 }  // namespace ocs2
@@ -37,19 +37,39 @@
 
 #include <ocs2_self_collision/SelfCollision.h>
 
+#include <algorithm>
+
 namespace ocs2 {
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-SelfCollision::SelfCollision(PinocchioGeometryInterface pinocchioGeometryInterface, scalar_t minimumDistance)
-    : pinocchioGeometryInterface_(std::move(pinocchioGeometryInterface)), minimumDistance_(minimumDistance) {}
+SelfCollision::SelfCollision(PinocchioGeometryInterface pinocchioGeometryInterface, scalar_t minimumDistance, ThreadPool* threadPoolPtr)
+    : pinocchioGeometryInterface_(std::move(pinocchioGeometryInterface)), minimumDistance_(minimumDistance), threadPoolPtr_(threadPoolPtr) {
+  const auto& geometryModel = pinocchioGeometryInterface_.getGeometryModel();
+  auto getJointIndex = [&](size_t joint) {
+    const auto it = std::find(collisionJoints_.begin(), collisionJoints_.end(), joint);
+    if (it != collisionJoints_.end()) {
+      return static_cast<size_t>(std::distance(collisionJoints_.begin(), it));
+    }
+    collisionJoints_.push_back(joint);
+    return collisionJoints_.size() - 1;
+  };
+
+  pairJointIndices_.reserve(geometryModel.collisionPairs.size());
+  for (const auto& collisionPair : geometryModel.collisionPairs) {
+    const size_t jointIndex1 = getJointIndex(geometryModel.geometryObjects[collisionPair.first].parentJoint);
+    const size_t jointIndex2 = getJointIndex(geometryModel.geometryObjects[collisionPair.second].parentJoint);
+    pairJointIndices_.emplace_back(jointIndex1, jointIndex2);
+  }
+}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 vector_t SelfCollision::getValue(const PinocchioInterface& pinocchioInterface) const {
-  const std::vector<hpp::fcl::DistanceResult> distanceArray = pinocchioGeometryInterface_.computeDistances(pinocchioInterface);
+  const std::vector<hpp::fcl::DistanceResult> distanceArray =
+      pinocchioGeometryInterface_.computeDistances(pinocchioInterface, threadPoolPtr_);
 
   vector_t violations = vector_t::Zero(distanceArray.size());
   for (size_t i = 0; i < distanceArray.size(); ++i) {
@@ -63,39 +83,39 @@ vector_t SelfCollision::getValue(const PinocchioInterface& pinocchioInterface) c
 /******************************************************************************************************/
 /******************************************************************************************************/
 std::pair<vector_t, matrix_t> SelfCollision::getLinearApproximation(const PinocchioInterface& pinocchioInterface) const {
-  const std::vector<hpp::fcl::DistanceResult> distanceArray = pinocchioGeometryInterface_.computeDistances(pinocchioInterface);
+  const std::vector<hpp::fcl::DistanceResult> distanceArray =
+      pinocchioGeometryInterface_.computeDistances(pinocchioInterface, threadPoolPtr_);
 
   const auto& model = pinocchioInterface.getModel();
   const auto& data = pinocchioInterface.getData();
 
-  const auto& geometryModel = pinocchioGeometryInterface_.getGeometryModel();
+  // the joint jacobians are shared by all the pairs with the same parent joints
+  // Jacobians from pinocchio are given as
+  // [ position jacobian ]
+  // [ rotation jacobian ]
+  std::vector<matrix_t> jointJacobians(collisionJoints_.size(), matrix_t::Zero(6, model.nv));
+  for (size_t j = 0; j < collisionJoints_.size(); ++j) {
+    pinocchio::getJointJacobian(model, data, collisionJoints_[j], pinocchio::ReferenceFrame::LOCAL_WORLD_ALIGNED, jointJacobians[j]);
+  }
 
   vector_t f(distanceArray.size());
   matrix_t dfdq(distanceArray.size(), model.nq);
-  for (size_t i = 0; i < distanceArray.size(); ++i) {
+  auto computePairApproximation = [&](int workerIndex, int i) {
     // Distance violation
     f[i] = distanceArray[i].min_distance - minimumDistance_;
 
-    // Jacobian calculation
-    const auto& collisionPair = geometryModel.collisionPairs[i];
-    const auto& joint1 = geometryModel.geometryObjects[collisionPair.first].parentJoint;
-    const auto& joint2 = geometryModel.geometryObjects[collisionPair.second].parentJoint;
-
     // We need to get the jacobian of the point on the first object; use the joint jacobian translated to the point
+    const size_t joint1 = collisionJoints_[pairJointIndices_[i].first];
+    const auto& joint1Jacobian = jointJacobians[pairJointIndices_[i].first];
     const vector3_t joint1Position = data.oMi[joint1].translation();
     const vector3_t pt1Offset = distanceArray[i].nearest_points[0] - joint1Position;
-    matrix_t joint1Jacobian = matrix_t::Zero(6, model.nv);
-    pinocchio::getJointJacobian(model, data, joint1, pinocchio::ReferenceFrame::LOCAL_WORLD_ALIGNED, joint1Jacobian);
-    // Jacobians from pinocchio are given as
-    // [ position jacobian ]
-    // [ rotation jacobian ]
     const matrix_t pt1Jacobian = joint1Jacobian.topRows(3) - skewSymmetricMatrix(pt1Offset) * joint1Jacobian.bottomRows(3);
 
     // We need to get the jacobian of the point on the second object; use the joint jacobian translated to the point
+    const size_t joint2 = collisionJoints_[pairJointIndices_[i].second];
+    const auto& joint2Jacobian = jointJacobians[pairJointIndices_[i].second];
     const vector3_t joint2Position = data.oMi[joint2].translation();
     const vector3_t pt2Offset = distanceArray[i].nearest_points[1] - joint2Position;
-    matrix_t joint2Jacobian = matrix_t::Zero(6, model.nv);
-    pinocchio::getJointJacobian(model, data, joint2, pinocchio::ReferenceFrame::LOCAL_WORLD_ALIGNED, joint2Jacobian);
     const matrix_t pt2Jacobian = joint2Jacobian.topRows(3) - skewSymmetricMatrix(pt2Offset) * joint2Jacobian.bottomRows(3);
 
     // To get the (approximate) jacobian of the distance, get the difference between the two nearest point jacobians, then multiply by the
@@ -106,7 +126,16 @@ std::pair<vector_t, matrix_t> SelfCollision::getLinearApproximation(const Pinocc
                                          ? (distanceArray[i].nearest_points[1] - distanceArray[i].nearest_points[0]).normalized()
                                          : (distanceArray[i].nearest_points[0] - distanceArray[i].nearest_points[1]).normalized();
     dfdq.row(i).noalias() = distanceVector.transpose() * differenceJacobian;
-  }  // end of i loop
+  };
+
+  const int numCollisionPairs = static_cast<int>(distanceArray.size());
+  if (threadPoolPtr_ != nullptr) {
+    threadPoolPtr_->parallelFor(0, numCollisionPairs, 4, computePairApproximation);
+  } else {
+    for (int i = 0; i < numCollisionPairs; ++i) {
+      computePairApproximation(0, i);
+    }  // end of i loop
+  }
 
   return {f, dfdq};
 }
@@ -36,9 +36,10 @@ namespace ocs2 {
 /******************************************************************************************************/
 /******************************************************************************************************/
 SelfCollisionConstraint::SelfCollisionConstraint(const PinocchioStateInputMapping<scalar_t>& mapping,
-                                                 PinocchioGeometryInterface pinocchioGeometryInterface, scalar_t minimumDistance)
+                                                 PinocchioGeometryInterface pinocchioGeometryInterface, scalar_t minimumDistance,
+                                                 ThreadPool* threadPoolPtr)
     : StateConstraint(ConstraintOrder::Linear),
-      selfCollision_(std::move(pinocchioGeometryInterface), minimumDistance),
+      selfCollision_(std::move(pinocchioGeometryInterface), minimumDistance, threadPoolPtr),
       mappingPtr_(mapping.clone()) {}
 
 /******************************************************************************************************/
@@ -31,6 +31,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <pinocchio/multibody/model.hpp>
 
+#include <memory>
+#include <string>
 #include <utility>
 
 #include <ocs2_pinocchio_interface/PinocchioInterface.h>
@@ -49,6 +51,8 @@ namespace ocs2 {
  *
  * Currently the following primitive geometries are supported: box, cylinder, and sphere.
  *
+ * The geometry model and the sphere approximation are immutable after construction and shared between the copies of this class.
+ *
  * Reference:
  * [1] A. Voelz and K. Graichen, "Computation of Collision Distance and Gradient using an Automatic Sphere Approximation of the Robot Model
  * with Bounded Error," ISR 2018; 50th International Symposium on Robotics, 2018, pp. 1-8.
@@ -63,9 +67,11 @@ class PinocchioSphereInterface final {
    * @param [in] maxExcesses : vector of maximum allowed distances between the surfaces of the collision primitives and collision spheres
    * @param [in] shrinkRatio: shrinking ratio for maxExcess to recursively approximate the circular base of the cylinder when more than one
    * collision sphere is required along the radial direction
+   * @param [in] cacheFolder: If not empty, the sphere approximation is loaded from a cache file in this folder. The file is keyed by the
+   * hash of the URDF, the collision links, maxExcesses, and shrinkRatio. If it does not exist, the approximation is computed and written.
    */
   PinocchioSphereInterface(const PinocchioInterface& pinocchioInterface, std::vector<std::string> collisionLinks,
-                           const std::vector<scalar_t>& maxExcesses, scalar_t shrinkRatio);
+                           const std::vector<scalar_t>& maxExcesses, scalar_t shrinkRatio, const std::string& cacheFolder = "");
   ~PinocchioSphereInterface();
 
   PinocchioSphereInterface(const PinocchioSphereInterface& rhs);
@@ -84,53 +90,60 @@ class PinocchioSphereInterface final {
   const std::vector<std::string>& getCollisionLinks() const { return collisionLinks_; };
 
   /** Get the array of the names of the collision links where each primitive shape is from */
-  const std::vector<std::string>& getCollisionLinkOfEachPrimitveShape() const { return collisionLinkOfEachPrimitiveShape_; };
+  const std::vector<std::string>& getCollisionLinkOfEachPrimitveShape() const { return spheresPtr_->collisionLinkOfEachPrimitiveShape; };
 
   /** Get the array of the SphereApproximation objects */
-  const std::vector<SphereApproximation>& getSphereApproximations() const { return sphereApproximations_; }
+  const std::vector<SphereApproximation>& getSphereApproximations() const { return spheresPtr_->sphereApproximations; }
 
   /** Get the number of objects approximated with spheres */
-  size_t getNumPrimitiveShapes() const { return numPrimitiveShapes_; };
+  size_t getNumPrimitiveShapes() const { return spheresPtr_->sphereApproximations.size(); };
 
   /** Get the number of spheres in total */
-  size_t getNumSpheresInTotal() const { return numSpheresInTotal_; };
+  size_t getNumSpheresInTotal() const { return spheresPtr_->sphereRadii.size(); };
 
   /** Get the array of the number of spheres of each approximation */
-  const size_array_t& getNumSpheres() const { return numSpheres_; };
+  const size_array_t& getNumSpheres() const { return spheresPtr_->numSpheres; };
 
   /** Get the array of the geometry object index of each approximation */
-  const size_array_t& getGeomObjIds() const { return geomObjIds_; };
-
-  /** Get the array of the radius of each sphere */
-  const scalar_array_t& getSphereRadii() const { return sphereRadii_; };
+  const size_array_t& getGeomObjIds() const { return spheresPtr_->geomObjIds; };
 
   /** Get the array of the radius of each sphere */
-  scalar_array_t& getSphereRadii() { return sphereRadii_; };
+  const scalar_array_t& getSphereRadii() const { return spheresPtr_->sphereRadii; };
 
   /** Get the array of the center position of each sphere in world frame */
   const std::vector<vector3_t>& getSphereCentersToObjectCenter(size_t approxId) const {
-    return sphereApproximations_[approxId].getSphereCentersToObjectCenter();
+    return spheresPtr_->sphereApproximations[approxId].getSphereCentersToObjectCenter();
   };
 
   /** Access the pinocchio geometry model */
-  pinocchio::GeometryModel& getGeometryModel() { return *geometryModelPtr_; }
   const pinocchio::GeometryModel& getGeometryModel() const { return *geometryModelPtr_; }
 
  private:
+  /** The sphere approximation of all the primitive shapes */
+  struct Spheres {
+    std::vector<std::string> collisionLinkOfEachPrimitiveShape;
+    std::vector<SphereApproximation> sphereApproximations;
+    size_array_t numSpheres;
+    size_array_t geomObjIds;
+    scalar_array_t sphereRadii;
+
+    /** Appends the approximation of a primitive shape of the given collision link. */
+    void add(std::string collisionLink, SphereApproximation sphereApproximation);
+  };
+
   // Construction helpers
-  void buildGeomFromPinocchioInterface(const PinocchioInterface& pinocchioInterface, pinocchio::GeometryModel& geomModel);
+  static std::string getUrdfString(const PinocchioInterface& pinocchioInterface);
+  static bool loadSpheres(const std::string& cacheFile, const PinocchioInterface& pinocchioInterface,
+                          const pinocchio::GeometryModel& geomModel, Spheres& spheres);
+  static void saveSpheres(const std::string& cacheFile, const Spheres& spheres);
+  void computeSpheres(const PinocchioInterface& pinocchioInterface, const std::vector<scalar_t>& maxExcesses, scalar_t shrinkRatio,
+                      Spheres& spheres) const;
 
-  std::unique_ptr<pinocchio::GeometryModel> geometryModelPtr_;
+  std::shared_ptr<const pinocchio::GeometryModel> geometryModelPtr_;
 
   // Sphere approximation for environment collision
   const std::vector<std::string> collisionLinks_;
-  std::vector<std::string> collisionLinkOfEachPrimitiveShape_;
-  std::vector<SphereApproximation> sphereApproximations_;
-  size_t numPrimitiveShapes_ = 0;
-  size_t numSpheresInTotal_ = 0;
-  size_array_t numSpheres_;
-  size_array_t geomObjIds_;
-  scalar_array_t sphereRadii_;
+  std::shared_ptr<const Spheres> spheresPtr_;
 };
 
 }  // namespace ocs2
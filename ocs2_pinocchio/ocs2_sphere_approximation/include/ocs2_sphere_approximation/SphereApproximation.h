@@ -61,12 +61,25 @@ class SphereApproximation {
    */
   SphereApproximation(const hpp::fcl::CollisionGeometry& geometry, size_t geomObjectId, scalar_t maxExcess, scalar_t shrinkRatio);
 
+  /** Constructor from a previously computed approximation, e.g., loaded from a cache file.
+   * @param [in] geomObjectId : index of the geometry object in GeometryModel
+   * @param [in] maxExcess : maximum allowed excess from the object surface to the sphere surface
+   * @param [in] shrinkRatio: ratio of shrinking maxExcess when recursive approximation of the cylinder base is necessary
+   * @param [in] sphereRadius : radius of the spheres
+   * @param [in] sphereCentersToObjectCenter : positions of the sphere centers w.r.t the object center
+   */
+  SphereApproximation(size_t geomObjectId, scalar_t maxExcess, scalar_t shrinkRatio, scalar_t sphereRadius,
+                      std::vector<vector3_t> sphereCentersToObjectCenter);
+
   /** Get the index of the geometry object stored in GeometryModel */
   size_t getGeomObjId() const { return geomObjId_; };
 
   /** Get the maximum alloowed excess from the the object surface to the sphere surface */
   scalar_t getMaxExcess() const { return maxExcess_; };
 
+  /** Get the ratio of shrinking maxExcess for the recursive approximation of the cylinder base */
+  scalar_t getShrinkRatio() const { return shrinkRatio_; };
+
   /** Get the number of spheres approximating the object */
   size_t getNumSpheres() const { return numSpheres_; };
 
@@ -0,0 +1,92 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <ocs2_core/constraint/StateConstraint.h>
+#include <ocs2_robotic_tools/end_effector/EndEffectorKinematics.h>
+
+namespace ocs2 {
+
+class PinocchioSphereKinematics;
+
+/**
+ * Self-collision constraint of the links which are approximated with spheres (see PinocchioSphereInterface). The distance between two
+ * spheres is ||c_j - c_i|| - r_i - r_j and its gradient follows analytically from the jacobians of the sphere centers, hence no
+ * narrow-phase collision checking is involved.
+ *
+ * The sphere centers are provided by a sphere kinematics:
+ * - PinocchioSphereKinematicsCppAd evaluates the centers of all spheres with a single generated model.
+ * - PinocchioSphereKinematics reads the centers from the pinocchio data, which is updated by a PinocchioPreComputation. It requires
+ *   pinocchio::forwardKinematics(), pinocchio::updateFramePlacements(), and for the approximation pinocchio::computeJointJacobians().
+ */
+class SphereSelfCollisionConstraint final : public StateConstraint {
+ public:
+  /**
+   * Constructor
+   *
+   * @param [in] sphereKinematics: The kinematics of the sphere centers. Its IDs are the names of the links of the spheres.
+   * @param [in] sphereRadii: The radius of each sphere, see PinocchioSphereInterface::getSphereRadii().
+   * @param [in] collisionLinkPairs: The pairs of link names. All the combinations of their spheres are constrained.
+   * @param [in] minimumDistance: The minimum allowed distance between two spheres.
+   */
+  SphereSelfCollisionConstraint(const EndEffectorKinematics<scalar_t>& sphereKinematics, scalar_array_t sphereRadii,
+                                const std::vector<std::pair<std::string, std::string>>& collisionLinkPairs, scalar_t minimumDistance);
+
+  ~SphereSelfCollisionConstraint() override = default;
+  SphereSelfCollisionConstraint* clone() const override { return new SphereSelfCollisionConstraint(*this); }
+
+  size_t getNumConstraints(scalar_t time) const override { return spherePairs_.size(); }
+
+  /** The indices of the spheres of each constraint. */
+  const std::vector<std::pair<size_t, size_t>>& getSpherePairs() const { return spherePairs_; }
+
+  vector_t getValue(scalar_t time, const vector_t& state, const PreComputation& preComputation) const override;
+  VectorFunctionLinearApproximation getLinearApproximation(scalar_t time, const vector_t& state,
+                                                           const PreComputation& preComputation) const override;
+
+ private:
+  SphereSelfCollisionConstraint(const SphereSelfCollisionConstraint& rhs);
+
+  /** Sets the pinocchio interface of the pre-computation if the kinematics is pinocchio based. */
+  void setPinocchioInterface(const PreComputation& preComputation) const;
+
+  std::unique_ptr<EndEffectorKinematics<scalar_t>> sphereKinematicsPtr_;
+  PinocchioSphereKinematics* pinocchioSphereKinematicsPtr_ = nullptr;  // sphereKinematicsPtr_ if it is pinocchio based
+  const scalar_array_t sphereRadii_;
+  const scalar_t minimumDistance_;
+  std::vector<std::pair<size_t, size_t>> spherePairs_;
+};
+
+}  // namespace ocs2
@@ -35,43 +35,74 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <urdf_parser/urdf_parser.h>
 
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <ocs2_sphere_approximation/PinocchioSphereInterface.h>
 
+namespace {
+
+/** 64 bit FNV-1a hash, which is stable between processes and builds. */
+std::string getHashString(const std::string& data) {
+  uint64_t hash = 14695981039346656037ULL;
+  for (const char c : data) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 1099511628211ULL;
+  }
+  std::ostringstream hashString;
+  hashString << std::hex << std::setw(16) << std::setfill('0') << hash;
+  return hashString.str();
+}
+
+constexpr char CACHE_FILE_HEADER[] = "ocs2_sphere_approximation_v1";
+
+}  // unnamed namespace
+
 namespace ocs2 {
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 PinocchioSphereInterface::PinocchioSphereInterface(const PinocchioInterface& pinocchioInterface, std::vector<std::string> collisionLinks,
-                                                   const std::vector<scalar_t>& maxExcesses, scalar_t shrinkRatio)
-    : geometryModelPtr_(new pinocchio::GeometryModel), collisionLinks_(std::move(collisionLinks)) {
-  buildGeomFromPinocchioInterface(pinocchioInterface, *geometryModelPtr_);
+                                                   const std::vector<scalar_t>& maxExcesses, scalar_t shrinkRatio,
+                                                   const std::string& cacheFolder)
+    : collisionLinks_(std::move(collisionLinks)) {
+  if (maxExcesses.size() != collisionLinks_.size()) {
+    throw std::runtime_error("[PinocchioSphereInterface] The number of maxExcesses does not match the number of collision links!");
+  }
 
-  for (size_t i = 0; i < collisionLinks_.size(); i++) {
-    const auto& link = collisionLinks_[i];
-    for (size_t j = 0; j < geometryModelPtr_->geometryObjects.size(); ++j) {
-      const pinocchio::GeometryObject& object = geometryModelPtr_->geometryObjects[j];
-      const std::string parentFrameName = pinocchioInterface.getModel().frames[object.parentFrame].name;
-      if (parentFrameName == link) {
-        sphereApproximations_.emplace_back(*object.geometry, j, maxExcesses[i], shrinkRatio);
-        collisionLinkOfEachPrimitiveShape_.emplace_back(link);
-      }
+  const std::string urdfString = getUrdfString(pinocchioInterface);
+  std::unique_ptr<pinocchio::GeometryModel> geometryModelPtr(new pinocchio::GeometryModel);
+  std::istringstream urdfStream(urdfString);
+  pinocchio::urdf::buildGeom(pinocchioInterface.getModel(), urdfStream, pinocchio::COLLISION, *geometryModelPtr);
+  geometryModelPtr_ = std::move(geometryModelPtr);
+
+  std::unique_ptr<Spheres> spheresPtr(new Spheres);
+  if (cacheFolder.empty()) {
+    computeSpheres(pinocchioInterface, maxExcesses, shrinkRatio, *spheresPtr);
+  } else {
+    std::ostringstream key;
+    key << std::setprecision(std::numeric_limits<scalar_t>::max_digits10) << urdfString;
+    for (size_t i = 0; i < collisionLinks_.size(); i++) {
+      key << '\n' << collisionLinks_[i] << ' ' << maxExcesses[i];
     }
-  }
+    key << '\n' << shrinkRatio;
+    const std::string cacheFile = cacheFolder + "/sphere_approximation_" + getHashString(key.str()) + ".txt";
 
-  numPrimitiveShapes_ = sphereApproximations_.size();
-  numSpheres_.reserve(numPrimitiveShapes_);
-  geomObjIds_.reserve(numPrimitiveShapes_);
-  for (const auto& sphereApprox : sphereApproximations_) {
-    const size_t numSpheres = sphereApprox.getNumSpheres();
-    numSpheresInTotal_ += numSpheres;
-    numSpheres_.emplace_back(numSpheres);
-    geomObjIds_.emplace_back(sphereApprox.getGeomObjId());
-
-    for (size_t j = 0; j < numSpheres; j++) {
-      sphereRadii_.push_back(sphereApprox.getSphereRadius());
+    if (!loadSpheres(cacheFile, pinocchioInterface, *geometryModelPtr_, *spheresPtr)) {
+      computeSpheres(pinocchioInterface, maxExcesses, shrinkRatio, *spheresPtr);
+      ::mkdir(cacheFolder.c_str(), 0755);
+      saveSpheres(cacheFile, *spheresPtr);
     }
   }
+  spheresPtr_ = std::move(spheresPtr);
 }
 
 /******************************************************************************************************/
@@ -82,16 +113,7 @@ PinocchioSphereInterface::~PinocchioSphereInterface() = default;
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-PinocchioSphereInterface::PinocchioSphereInterface(const PinocchioSphereInterface& rhs)
-    : geometryModelPtr_(new pinocchio::GeometryModel(*rhs.geometryModelPtr_)),
-      collisionLinks_(rhs.collisionLinks_),
-      collisionLinkOfEachPrimitiveShape_(rhs.collisionLinkOfEachPrimitiveShape_),
-      sphereApproximations_(rhs.sphereApproximations_),
-      numPrimitiveShapes_(rhs.numPrimitiveShapes_),
-      numSpheresInTotal_(rhs.numSpheresInTotal_),
-      numSpheres_(rhs.numSpheres_),
-      geomObjIds_(rhs.geomObjIds_),
-      sphereRadii_(rhs.sphereRadii_) {}
+PinocchioSphereInterface::PinocchioSphereInterface(const PinocchioSphereInterface& rhs) = default;
 
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -101,22 +123,113 @@ PinocchioSphereInterface::PinocchioSphereInterface(PinocchioSphereInterface&& rh
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-void PinocchioSphereInterface::buildGeomFromPinocchioInterface(const PinocchioInterface& pinocchioInterface,
-                                                               pinocchio::GeometryModel& geomModel) {
+void PinocchioSphereInterface::Spheres::add(std::string collisionLink, SphereApproximation sphereApproximation) {
+  numSpheres.push_back(sphereApproximation.getNumSpheres());
+  geomObjIds.push_back(sphereApproximation.getGeomObjId());
+  sphereRadii.insert(sphereRadii.end(), sphereApproximation.getNumSpheres(), sphereApproximation.getSphereRadius());
+  collisionLinkOfEachPrimitiveShape.push_back(std::move(collisionLink));
+  sphereApproximations.push_back(std::move(sphereApproximation));
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PinocchioSphereInterface::computeSpheres(const PinocchioInterface& pinocchioInterface, const std::vector<scalar_t>& maxExcesses,
+                                              scalar_t shrinkRatio, Spheres& spheres) const {
+  for (size_t i = 0; i < collisionLinks_.size(); i++) {
+    const auto& link = collisionLinks_[i];
+    for (size_t j = 0; j < geometryModelPtr_->geometryObjects.size(); ++j) {
+      const pinocchio::GeometryObject& object = geometryModelPtr_->geometryObjects[j];
+      const std::string parentFrameName = pinocchioInterface.getModel().frames[object.parentFrame].name;
+      if (parentFrameName == link) {
+        spheres.add(link, SphereApproximation(*object.geometry, j, maxExcesses[i], shrinkRatio));
+      }
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool PinocchioSphereInterface::loadSpheres(const std::string& cacheFile, const PinocchioInterface& pinocchioInterface,
+                                           const pinocchio::GeometryModel& geomModel, Spheres& spheres) {
+  std::ifstream file(cacheFile);
+  std::string header;
+  size_t numPrimitiveShapes = 0;
+  if (!(file >> header >> numPrimitiveShapes) || header != CACHE_FILE_HEADER) {
+    return false;
+  }
+
+  Spheres loadedSpheres;
+  for (size_t i = 0; i < numPrimitiveShapes; i++) {
+    size_t geomObjId = 0;
+    size_t numSpheres = 0;
+    scalar_t maxExcess = 0.0;
+    scalar_t shrinkRatio = 0.0;
+    scalar_t sphereRadius = 0.0;
+    if (!(file >> geomObjId >> maxExcess >> shrinkRatio >> sphereRadius >> numSpheres) ||
+        geomObjId >= geomModel.geometryObjects.size()) {
+      return false;
+    }
+    std::vector<vector3_t> sphereCentersToObjectCenter(numSpheres);
+    for (auto& center : sphereCentersToObjectCenter) {
+      if (!(file >> center.x() >> center.y() >> center.z())) {
+        return false;
+      }
+    }
+    const auto parentFrame = geomModel.geometryObjects[geomObjId].parentFrame;
+    loadedSpheres.add(pinocchioInterface.getModel().frames[parentFrame].name,
+                      SphereApproximation(geomObjId, maxExcess, shrinkRatio, sphereRadius, std::move(sphereCentersToObjectCenter)));
+  }
+
+  spheres = std::move(loadedSpheres);
+  return true;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PinocchioSphereInterface::saveSpheres(const std::string& cacheFile, const Spheres& spheres) {
+  // write to a temporary file first, such that concurrent processes never read a partially written cache
+  const std::string tmpFile = cacheFile + ".tmp" + std::to_string(::getpid());
+  {
+    std::ofstream file(tmpFile);
+    file << std::setprecision(std::numeric_limits<scalar_t>::max_digits10);
+    file << CACHE_FILE_HEADER << '\n' << spheres.sphereApproximations.size() << '\n';
+    for (const auto& sphereApprox : spheres.sphereApproximations) {
+      file << sphereApprox.getGeomObjId() << ' ' << sphereApprox.getMaxExcess() << ' ' << sphereApprox.getShrinkRatio() << ' '
+           << sphereApprox.getSphereRadius() << ' ' << sphereApprox.getNumSpheres() << '\n';
+      for (const auto& center : sphereApprox.getSphereCentersToObjectCenter()) {
+        file << center.x() << ' ' << center.y() << ' ' << center.z() << '\n';
+      }
+    }
+    if (!file.good()) {
+      std::cerr << "[PinocchioSphereInterface] Could not write the sphere approximation cache " << cacheFile << "\n";
+      return;
+    }
+  }
+  if (std::rename(tmpFile.c_str(), cacheFile.c_str()) != 0) {
+    std::remove(tmpFile.c_str());
+    std::cerr << "[PinocchioSphereInterface] Could not write the sphere approximation cache " << cacheFile << "\n";
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::string PinocchioSphereInterface::getUrdfString(const PinocchioInterface& pinocchioInterface) {
   if (!pinocchioInterface.getUrdfModelPtr()) {
     throw std::runtime_error(
-        "[PinocchioSphereInterface::buildGeomFromPinocchioInterface]: The PinocchioInterface passed to PinocchioGeometryInterface(...) "
+        "[PinocchioSphereInterface::getUrdfString]: The PinocchioInterface passed to PinocchioSphereInterface(...) "
         "does not contain a urdf model!");
   }
 
   // TODO: Replace with pinocchio function that uses the ModelInterface directly
-  // As of 19-04-21 there is no buildGeom that takes a ModelInterface, so we deconstruct the modelInterface into a std::stringstream first
+  // As of 19-04-21 there is no buildGeom that takes a ModelInterface, so we deconstruct the modelInterface into a string first
   const std::unique_ptr<const TiXmlDocument> urdfAsXml(urdf::exportURDF(*pinocchioInterface.getUrdfModelPtr()));
   TiXmlPrinter printer;
   urdfAsXml->Accept(&printer);
-  const std::stringstream urdfAsStringStream(printer.Str());
-
-  pinocchio::urdf::buildGeom(pinocchioInterface.getModel(), urdfAsStringStream, pinocchio::COLLISION, geomModel);
+  return printer.Str();
 }
 
 /******************************************************************************************************/
@@ -124,17 +237,19 @@ void PinocchioSphereInterface::buildGeomFromPinocchioInterface(const PinocchioIn
 /******************************************************************************************************/
 auto PinocchioSphereInterface::computeSphereCentersInWorldFrame(const PinocchioInterface& pinocchioInterface) const
     -> std::vector<vector3_t> {
+  const auto& geomObjIds = getGeomObjIds();
+  const auto& numSpheres = getNumSpheres();
   pinocchio::GeometryData geometryData(*geometryModelPtr_);
 
   pinocchio::updateGeometryPlacements(pinocchioInterface.getModel(), pinocchioInterface.getData(), *geometryModelPtr_, geometryData);
 
-  std::vector<vector3_t> sphereCentersInWorldFrame(numSpheresInTotal_);
+  std::vector<vector3_t> sphereCentersInWorldFrame(getNumSpheresInTotal());
 
   size_t count = 0;
-  for (size_t i = 0; i < numPrimitiveShapes_; i++) {
-    const auto& objTransform = geometryData.oMg[geomObjIds_[i]];
-    const auto& sphereCentersToObjectCenter = sphereApproximations_[i].getSphereCentersToObjectCenter();
-    for (size_t j = 0; j < numSpheres_[i]; j++) {
+  for (size_t i = 0; i < getNumPrimitiveShapes(); i++) {
+    const auto& objTransform = geometryData.oMg[geomObjIds[i]];
+    const auto& sphereCentersToObjectCenter = getSphereCentersToObjectCenter(i);
+    for (size_t j = 0; j < numSpheres[i]; j++) {
       sphereCentersInWorldFrame[count] = objTransform.translation();
       sphereCentersInWorldFrame[count].noalias() += objTransform.rotation() * sphereCentersToObjectCenter[j];
       count++;
@@ -68,6 +68,18 @@ SphereApproximation::SphereApproximation(const hpp::fcl::CollisionGeometry& geom
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+SphereApproximation::SphereApproximation(size_t geomObjId, scalar_t maxExcess, scalar_t shrinkRatio, scalar_t sphereRadius,
+                                         std::vector<vector3_t> sphereCentersToObjectCenter)
+    : geomObjId_(geomObjId),
+      maxExcess_(maxExcess),
+      shrinkRatio_(shrinkRatio),
+      numSpheres_(sphereCentersToObjectCenter.size()),
+      sphereRadius_(sphereRadius),
+      sphereCentersToObjectCenter_(std::move(sphereCentersToObjectCenter)) {}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -0,0 +1,145 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <pinocchio/fwd.hpp>  // forward declarations must be included first.
+
+#include <ocs2_sphere_approximation/SphereSelfCollisionConstraint.h>
+
+#include <iostream>
+#include <limits>
+
+#include <ocs2_pinocchio_interface/PinocchioPreComputation.h>
+#include <ocs2_sphere_approximation/PinocchioSphereKinematics.h>
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+SphereSelfCollisionConstraint::SphereSelfCollisionConstraint(const EndEffectorKinematics<scalar_t>& sphereKinematics,
+                                                             scalar_array_t sphereRadii,
+                                                             const std::vector<std::pair<std::string, std::string>>& collisionLinkPairs,
+                                                             scalar_t minimumDistance)
+    : StateConstraint(ConstraintOrder::Linear),
+      sphereKinematicsPtr_(sphereKinematics.clone()),
+      sphereRadii_(std::move(sphereRadii)),
+      minimumDistance_(minimumDistance) {
+  pinocchioSphereKinematicsPtr_ = dynamic_cast<PinocchioSphereKinematics*>(sphereKinematicsPtr_.get());
+
+  const auto& linkIds = sphereKinematicsPtr_->getIds();
+  if (sphereRadii_.size() != linkIds.size()) {
+    throw std::runtime_error("[SphereSelfCollisionConstraint] The number of sphere radii does not match the number of spheres!");
+  }
+
+  for (const auto& linkPair : collisionLinkPairs) {
+    bool addedPair = false;
+    for (size_t i = 0; i < linkIds.size(); ++i) {
+      if (linkIds[i] != linkPair.first) {
+        continue;
+      }
+      for (size_t j = 0; j < linkIds.size(); ++j) {
+        if (linkIds[j] == linkPair.second && i != j) {
+          spherePairs_.emplace_back(i, j);
+          addedPair = true;
+        }
+      }
+    }
+    if (!addedPair) {
+      std::cerr << "WARNING: in collision link pair [" << linkPair.first << ", " << linkPair.second
+                << "], one or both of the links are not approximated with spheres\n";
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+SphereSelfCollisionConstraint::SphereSelfCollisionConstraint(const SphereSelfCollisionConstraint& rhs)
+    : StateConstraint(rhs),
+      sphereKinematicsPtr_(rhs.sphereKinematicsPtr_->clone()),
+      sphereRadii_(rhs.sphereRadii_),
+      minimumDistance_(rhs.minimumDistance_),
+      spherePairs_(rhs.spherePairs_) {
+  pinocchioSphereKinematicsPtr_ = dynamic_cast<PinocchioSphereKinematics*>(sphereKinematicsPtr_.get());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SphereSelfCollisionConstraint::setPinocchioInterface(const PreComputation& preComputation) const {
+  if (pinocchioSphereKinematicsPtr_ != nullptr) {
+    pinocchioSphereKinematicsPtr_->setPinocchioInterface(cast<PinocchioPreComputation>(preComputation).getPinocchioInterface());
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t SphereSelfCollisionConstraint::getValue(scalar_t time, const vector_t& state, const PreComputation& preComputation) const {
+  setPinocchioInterface(preComputation);
+  const auto centers = sphereKinematicsPtr_->getPosition(state);
+
+  vector_t f(spherePairs_.size());
+  for (size_t k = 0; k < spherePairs_.size(); ++k) {
+    const auto i = spherePairs_[k].first;
+    const auto j = spherePairs_[k].second;
+    f(k) = (centers[j] - centers[i]).norm() - sphereRadii_[i] - sphereRadii_[j] - minimumDistance_;
+  }  // end of k loop
+
+  return f;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+VectorFunctionLinearApproximation SphereSelfCollisionConstraint::getLinearApproximation(scalar_t time, const vector_t& state,
+                                                                                        const PreComputation& preComputation) const {
+  setPinocchioInterface(preComputation);
+  const auto centers = sphereKinematicsPtr_->getPositionLinearApproximation(state);
+
+  VectorFunctionLinearApproximation approx = VectorFunctionLinearApproximation::Zero(spherePairs_.size(), state.rows(), 0);
+  for (size_t k = 0; k < spherePairs_.size(); ++k) {
+    const auto i = spherePairs_[k].first;
+    const auto j = spherePairs_[k].second;
+    const EndEffectorKinematics<scalar_t>::vector3_t difference = centers[j].f - centers[i].f;
+    const scalar_t centerDistance = difference.norm();
+    approx.f(k) = centerDistance - sphereRadii_[i] - sphereRadii_[j] - minimumDistance_;
+
+    // the gradient of the distance is the direction between the centers; it is not defined for coinciding centers
+    if (centerDistance > std::numeric_limits<scalar_t>::epsilon()) {
+      const EndEffectorKinematics<scalar_t>::vector3_t direction = difference / centerDistance;
+      approx.dfdx.row(k).noalias() = direction.transpose() * centers[j].dfdx;
+      approx.dfdx.row(k).noalias() -= direction.transpose() * centers[i].dfdx;
+    }
+  }  // end of k loop
+
+  return approx;
+}
+
+}  // namespace ocs2
@@ -32,9 +32,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <pinocchio/algorithm/kinematics.hpp>
 #include <pinocchio/multibody/geometry.hpp>
 
+#include <ocs2_pinocchio_interface/PinocchioPreComputation.h>
 #include <ocs2_pinocchio_interface/urdf.h>
 #include <ocs2_sphere_approximation/PinocchioSphereKinematics.h>
 #include <ocs2_sphere_approximation/PinocchioSphereKinematicsCppAd.h>
+#include <ocs2_sphere_approximation/SphereSelfCollisionConstraint.h>
 
 #include <ocs2_robotic_assets/package_path.h>
 #include <ocs2_robotic_tools/common/SkewSymmetricMatrix.h>
@@ -201,4 +203,50 @@ TEST_F(TestSphereKinematics, testClone) {
   const auto spherePos = clonePtr->getPosition(x)[0];
   const auto spherePosAd = cloneCppAdPtr->getPosition(x)[0];
   EXPECT_TRUE(spherePos.isApprox(spherePosAd));
-}
\ No newline at end of file
+}
+
+TEST_F(TestSphereKinematics, testSphereCache) {
+  const std::string cacheFolder = "/tmp/ocs2";
+  const std::vector<std::string> collisionLinks{"ARM", "SHOULDER", "FOREARM", "WRIST_1"};
+  const std::vector<ocs2::scalar_t> maxExcesses{0.20, 0.10, 0.05, 0.05};
+  // the first construction computes the spheres (or loads them from a previous run), the second one loads them from the cache
+  const ocs2::PinocchioSphereInterface cachedInterface(*pinocchioInterfacePtr, collisionLinks, maxExcesses, 0.7, cacheFolder);
+  const ocs2::PinocchioSphereInterface loadedInterface(*pinocchioInterfacePtr, collisionLinks, maxExcesses, 0.7, cacheFolder);
+
+  for (const auto* interfacePtr : {&cachedInterface, &loadedInterface}) {
+    EXPECT_EQ(interfacePtr->getCollisionLinkOfEachPrimitveShape(), pinocchioSphereInterfacePtr->getCollisionLinkOfEachPrimitveShape());
+    EXPECT_EQ(interfacePtr->getGeomObjIds(), pinocchioSphereInterfacePtr->getGeomObjIds());
+    EXPECT_EQ(interfacePtr->getNumSpheres(), pinocchioSphereInterfacePtr->getNumSpheres());
+    EXPECT_EQ(interfacePtr->getSphereRadii(), pinocchioSphereInterfacePtr->getSphereRadii());
+    for (size_t i = 0; i < interfacePtr->getNumPrimitiveShapes(); i++) {
+      EXPECT_EQ(interfacePtr->getSphereCentersToObjectCenter(i), pinocchioSphereInterfacePtr->getSphereCentersToObjectCenter(i));
+    }
+  }
+
+  // copies share the sphere approximation
+  const ocs2::PinocchioSphereInterface copy(loadedInterface);
+  EXPECT_EQ(&copy.getSphereRadii(), &loadedInterface.getSphereRadii());
+}
+
+TEST_F(TestSphereKinematics, testSphereSelfCollisionConstraint) {
+  const std::vector<std::pair<std::string, std::string>> collisionLinkPairs{{"ARM", "FOREARM"}, {"SHOULDER", "WRIST_1"}};
+  const auto& sphereRadii = pinocchioSphereInterfacePtr->getSphereRadii();
+  ocs2::SphereSelfCollisionConstraint constraint(*sphereKinematicsPtr, sphereRadii, collisionLinkPairs, 0.1);
+  ocs2::SphereSelfCollisionConstraint constraintCppAd(*sphereKinematicsCppAdPtr, sphereRadii, collisionLinkPairs, 0.1);
+  ASSERT_GT(constraint.getNumConstraints(0.0), 0);
+
+  ocs2::PinocchioPreComputation preComputation(*pinocchioInterfacePtr, pinocchioMapping, ocs2::PinocchioPreComputation::Settings());
+  preComputation.requestFinal(ocs2::Request::Constraint + ocs2::Request::Approximation, 0.0, x);
+
+  const auto approx = constraint.getLinearApproximation(0.0, x, preComputation);
+  const auto approxCppAd = constraintCppAd.getLinearApproximation(0.0, x, ocs2::PreComputation());
+  compareApproximation(approx, approxCppAd);
+  EXPECT_TRUE(approx.f.isApprox(constraint.getValue(0.0, x, preComputation)));
+
+  // the distance of the first pair
+  const auto centers = sphereKinematicsCppAdPtr->getPosition(x);
+  const auto spherePair = constraint.getSpherePairs().front();
+  const ocs2::scalar_t distance = (centers[spherePair.second] - centers[spherePair.first]).norm() - sphereRadii[spherePair.first] -
+                                  sphereRadii[spherePair.second] - 0.1;
+  EXPECT_NEAR(approx.f(0), distance, 1e-9);
+}
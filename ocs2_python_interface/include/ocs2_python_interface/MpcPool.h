@@ -0,0 +1,143 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <ocs2_core/reference/TargetTrajectories.h>
+#include <ocs2_mpc/MPC_BASE.h>
+#include <ocs2_oc/oc_data/PerformanceIndex.h>
+
+#include "ocs2_python_interface/PythonInterface.h"
+
+namespace ocs2 {
+
+/** A job of the MPC pool: a single MPC solve from the initial state towards the target trajectories */
+struct MpcJob {
+  scalar_t initTime = 0.0;
+  vector_t initState;
+  TargetTrajectories targetTrajectories;
+};
+
+/** The result of an MPC job. The trajectories are stored with one row per node. */
+struct MpcJobResult {
+  size_t jobId = 0;
+  bool success = false;
+  std::string errorMessage;  // set if the solver has thrown
+  vector_t t;
+  row_matrix_t x;
+  row_matrix_t u;
+  PerformanceIndex performanceIndex;
+};
+
+/**
+ * MpcPool runs K independent MPC instances on K worker threads, e.g. to generate MPC demonstrations from Python on a many-core machine.
+ * The instances are created from one robot interface, such that the CppAD model libraries and the interface data are loaded once and
+ * shared. The jobs are queued and processed by the first idle instance, the results are collected asynchronously.
+ *
+ * Each job resets its instance, thus the results do not depend on the order or on the instance in which the jobs run.
+ */
+class MpcPool {
+ public:
+  using mpc_factory_t = std::function<std::unique_ptr<MPC_BASE>()>;
+
+  /** Destructor. Discards the queued jobs and waits for the running ones. */
+  virtual ~MpcPool();
+
+  MpcPool(const MpcPool&) = delete;
+  MpcPool& operator=(const MpcPool&) = delete;
+
+  /** The number of MPC instances. */
+  size_t getNumInstances() const { return workers_.size(); }
+
+  /**
+   * Queues a job.
+   * @param [in] job: The MPC job.
+   * @return The id of the job.
+   */
+  size_t submit(MpcJob job);
+
+  /**
+   * Queues a batch of jobs with one row per job.
+   * @param [in] initTimes: The initial times (N).
+   * @param [in] initStates: The initial states (N x stateDim).
+   * @param [in] targetTrajectories: The target trajectories of each job (N).
+   * @return The ids of the jobs.
+   */
+  std::vector<size_t> submitBatch(Eigen::Ref<const vector_t> initTimes, Eigen::Ref<const row_matrix_t> initStates,
+                                  const std::vector<TargetTrajectories>& targetTrajectories);
+
+  /**
+   * Returns the finished results, in the order of completion.
+   * @param [in] minResults: Blocks until at least this many results are finished or no job is left.
+   */
+  std::vector<MpcJobResult> collect(size_t minResults = 0);
+
+  /** The number of queued and running jobs. */
+  size_t getNumPending() const;
+
+ protected:
+  /** Constructor */
+  MpcPool() = default;
+
+  /**
+   * Creates the MPC instances and starts the worker threads.
+   * @note This should be called from derived class constructor.
+   * @param [in] numInstances: The number of MPC instances.
+   * @param [in] mpcFactory: Creates an MPC instance. It is called numInstances times in the calling thread.
+   */
+  void init(size_t numInstances, const mpc_factory_t& mpcFactory);
+
+ private:
+  void worker(MPC_BASE& mpc);
+
+  MpcJobResult solve(MPC_BASE& mpc, size_t jobId, const MpcJob& job) const;
+
+  std::vector<std::unique_ptr<MPC_BASE>> mpcs_;
+  std::vector<std::thread> workers_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable jobReady_;
+  std::condition_variable resultReady_;
+  std::deque<std::pair<size_t, MpcJob>> jobs_;
+  std::vector<MpcJobResult> results_;
+  size_t numRunning_ = 0;
+  size_t nextJobId_ = 0;
+  bool stop_ = false;
+};
+
+}  // namespace ocs2
@@ -34,9 +34,14 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <pybind11/stl.h>
 
 #include <ocs2_core/Types.h>
+#include <ocs2_python_interface/MpcPool.h>
+#include <ocs2_python_interface/VectorizedEnvironment.h>
 
 using namespace pybind11::literals;
 
+//! releases the GIL for the duration of a call, such that other Python threads can run meanwhile
+using release_gil = pybind11::call_guard<pybind11::gil_scoped_release>;
+
 //! convenience macro to bind all kinds of std::vector-like types
 #define VECTOR_TYPE_BINDING(VTYPE, NAME)                                                    \
   pybind11::class_<VTYPE>(m, NAME)                                                          \
@@ -60,11 +65,74 @@ using namespace pybind11::literals;
           "__iter__", [](VTYPE& v) { return pybind11::make_iterator(v.begin(), v.end()); }, \
           pybind11::keep_alive<0, 1>()); /* Keep vector alive while iterator is used */
 
+//! convenience macro to bind an MPC pool, see ocs2::MpcPool
+#define MPC_POOL_BINDING(PY_POOL)                                                                                                          \
+  pybind11::class_<ocs2::PerformanceIndex>(m, "PerformanceIndex")                                                                          \
+      .def_readonly("merit", &ocs2::PerformanceIndex::merit)                                                                               \
+      .def_readonly("cost", &ocs2::PerformanceIndex::cost)                                                                                 \
+      .def_readonly("dynamicsViolationSSE", &ocs2::PerformanceIndex::dynamicsViolationSSE)                                                 \
+      .def_readonly("equalityConstraintsSSE", &ocs2::PerformanceIndex::equalityConstraintsSSE)                                             \
+      .def_readonly("equalityLagrangian", &ocs2::PerformanceIndex::equalityLagrangian)                                                     \
+      .def_readonly("inequalityLagrangian", &ocs2::PerformanceIndex::inequalityLagrangian);                                                \
+  pybind11::class_<ocs2::MpcJobResult>(m, "MpcJobResult")                                                                                  \
+      .def_readonly("jobId", &ocs2::MpcJobResult::jobId)                                                                                   \
+      .def_readonly("success", &ocs2::MpcJobResult::success)                                                                               \
+      .def_readonly("errorMessage", &ocs2::MpcJobResult::errorMessage)                                                                     \
+      .def_readonly("t", &ocs2::MpcJobResult::t)                                                                                           \
+      .def_readonly("x", &ocs2::MpcJobResult::x)                                                                                           \
+      .def_readonly("u", &ocs2::MpcJobResult::u)                                                                                           \
+      .def_readonly("performanceIndex", &ocs2::MpcJobResult::performanceIndex);                                                            \
+  pybind11::class_<PY_POOL>(m, "mpc_pool")                                                                                                 \
+      .def(pybind11::init<const std::string&, const std::string&, const std::string&, size_t>(), "taskFile"_a, "libFolder"_a,              \
+           "urdfFile"_a = "", "numInstances"_a = 1)                                                                                        \
+      .def("getNumInstances", &PY_POOL::getNumInstances)                                                                                   \
+      .def("submitBatch", &PY_POOL::submitBatch, "initTimes"_a.noconvert(), "initStates"_a.noconvert(), "targetTrajectories"_a,            \
+           release_gil())                                                                                                                  \
+      .def("collect", &PY_POOL::collect, "minResults"_a = 0, release_gil())                                                                \
+      .def("getNumPending", &PY_POOL::getNumPending);
+
+//! convenience macro to bind a vectorized environment, see ocs2::VectorizedEnvironment. The buffers are returned as read-only NumPy views.
+#define VECTORIZED_ENVIRONMENT_BINDING(PY_ENV)                                                                                             \
+  pybind11::class_<ocs2::vectorized_environment::Settings>(m, "VectorizedEnvironmentSettings")                                             \
+      .def(pybind11::init<>())                                                                                                             \
+      .def_readwrite("controlTimeStep", &ocs2::vectorized_environment::Settings::controlTimeStep)                                          \
+      .def_readwrite("mpcTimeStep", &ocs2::vectorized_environment::Settings::mpcTimeStep)                                                  \
+      .def_readwrite("asynchronousMpc", &ocs2::vectorized_environment::Settings::asynchronousMpc)                                          \
+      .def_readwrite("episodeDuration", &ocs2::vectorized_environment::Settings::episodeDuration)                                          \
+      .def_readwrite("numThreads", &ocs2::vectorized_environment::Settings::numThreads)                                                    \
+      .def_readwrite("numMpcThreads", &ocs2::vectorized_environment::Settings::numMpcThreads);                                             \
+  pybind11::class_<PY_ENV>(m, "vectorized_environment")                                                                                    \
+      .def(pybind11::init<const std::string&, const std::string&, const std::string&, size_t, ocs2::vectorized_environment::Settings>(),   \
+           "taskFile"_a, "libFolder"_a, "urdfFile"_a = "", "numEnvironments"_a = 1,                                                        \
+           "settings"_a = ocs2::vectorized_environment::Settings())                                                                        \
+      .def("getNumEnvironments", &PY_ENV::getNumEnvironments)                                                                              \
+      .def("getStateDim", &PY_ENV::getStateDim)                                                                                            \
+      .def("getInputDim", &PY_ENV::getInputDim)                                                                                            \
+      .def("reset", &PY_ENV::reset, "initTimes"_a.noconvert(), "initStates"_a.noconvert(), "targetTrajectories"_a, release_gil())         \
+      .def("resetEnvironment", &PY_ENV::resetEnvironment, "index"_a, "initTime"_a, "initState"_a.noconvert(), "targetTrajectories"_a,      \
+           release_gil())                                                                                                                  \
+      .def("step", &PY_ENV::step, "actions"_a.noconvert(), release_gil())                                                                  \
+      .def("getTimes", &PY_ENV::getTimes, pybind11::return_value_policy::reference_internal)                                               \
+      .def("getStates", &PY_ENV::getStates, pybind11::return_value_policy::reference_internal)                                             \
+      .def("getMpcInputs", &PY_ENV::getMpcInputs, pybind11::return_value_policy::reference_internal)                                       \
+      .def("getRewards", &PY_ENV::getRewards, pybind11::return_value_policy::reference_internal)                                           \
+      .def("getDones", &PY_ENV::getDones, pybind11::return_value_policy::reference_internal);
+
 /**
  * @brief Convenience macro to bind robot interface with all required vectors.
  * @note LIB_NAME must match target name in CMakeLists
  */
-#define CREATE_ROBOT_PYTHON_BINDINGS(PY_INTERFACE, LIB_NAME)                                                                               \
+#define CREATE_ROBOT_PYTHON_BINDINGS(PY_INTERFACE, LIB_NAME) CREATE_ROBOT_PYTHON_BINDINGS_IMPL(PY_INTERFACE, LIB_NAME, )
+
+/**
+ * @brief Convenience macro to bind robot interface with all required vectors, and an MPC pool of the robot (see ocs2::MpcPool).
+ * @note LIB_NAME must match target name in CMakeLists
+ */
+#define CREATE_ROBOT_PYTHON_BINDINGS_WITH_MPC_POOL(PY_INTERFACE, PY_POOL, LIB_NAME)                                                        \
+  CREATE_ROBOT_PYTHON_BINDINGS_IMPL(PY_INTERFACE, LIB_NAME, MPC_POOL_BINDING(PY_POOL))
+
+//! implementation of the macros above, EXTRA_BINDINGS are added at the end of the module
+#define CREATE_ROBOT_PYTHON_BINDINGS_IMPL(PY_INTERFACE, LIB_NAME, EXTRA_BINDINGS)                                                          \
   /* make vector types opaque so they are not converted to python lists */                                                                 \
   PYBIND11_MAKE_OPAQUE(ocs2::scalar_array_t)                                                                                               \
   PYBIND11_MAKE_OPAQUE(ocs2::vector_array_t)                                                                                               \
@@ -94,6 +162,17 @@ using namespace pybind11::literals;
         .def_readwrite("dfdxx", &ocs2::ScalarFunctionQuadraticApproximation::dfdxx)                                                        \
         .def_readwrite("dfdux", &ocs2::ScalarFunctionQuadraticApproximation::dfdux)                                                        \
         .def_readwrite("dfduu", &ocs2::ScalarFunctionQuadraticApproximation::dfduu);                                                       \
+    pybind11::class_<ocs2::BatchedVectorFunctionLinearApproximation>(m, "BatchedVectorFunctionLinearApproximation")                        \
+        .def_readonly("f", &ocs2::BatchedVectorFunctionLinearApproximation::f)                                                             \
+        .def_readonly("dfdx", &ocs2::BatchedVectorFunctionLinearApproximation::dfdx)                                                       \
+        .def_readonly("dfdu", &ocs2::BatchedVectorFunctionLinearApproximation::dfdu);                                                      \
+    pybind11::class_<ocs2::BatchedScalarFunctionQuadraticApproximation>(m, "BatchedScalarFunctionQuadraticApproximation")                  \
+        .def_readonly("f", &ocs2::BatchedScalarFunctionQuadraticApproximation::f)                                                          \
+        .def_readonly("dfdx", &ocs2::BatchedScalarFunctionQuadraticApproximation::dfdx)                                                    \
+        .def_readonly("dfdu", &ocs2::BatchedScalarFunctionQuadraticApproximation::dfdu)                                                    \
+        .def_readonly("dfdxx", &ocs2::BatchedScalarFunctionQuadraticApproximation::dfdxx)                                                  \
+        .def_readonly("dfdux", &ocs2::BatchedScalarFunctionQuadraticApproximation::dfdux)                                                  \
+        .def_readonly("dfduu", &ocs2::BatchedScalarFunctionQuadraticApproximation::dfduu);                                                 \
     /* bind TargetTrajectories class */                                                                                                    \
     pybind11::class_<ocs2::TargetTrajectories>(m, "TargetTrajectories")                                                                    \
         .def(pybind11::init<ocs2::scalar_array_t, ocs2::vector_array_t, ocs2::vector_array_t>());                                          \
@@ -105,20 +184,31 @@ using namespace pybind11::literals;
         .def("setObservation", &PY_INTERFACE::setObservation, "t"_a, "x"_a.noconvert(), "u"_a.noconvert())                                 \
         .def("setTargetTrajectories", &PY_INTERFACE::setTargetTrajectories, "targetTrajectories"_a)                                        \
         .def("reset", &PY_INTERFACE::reset, "targetTrajectories"_a)                                                                        \
-        .def("advanceMpc", &PY_INTERFACE::advanceMpc)                                                                                      \
-        .def("getMpcSolution", &PY_INTERFACE::getMpcSolution, "t"_a.noconvert(), "x"_a.noconvert(), "u"_a.noconvert())                     \
-        .def("getLinearFeedbackGain", &PY_INTERFACE::getLinearFeedbackGain, "t"_a.noconvert())                                             \
-        .def("flowMap", &PY_INTERFACE::flowMap, "t"_a, "x"_a.noconvert(), "u"_a.noconvert())                                               \
-        .def("flowMapLinearApproximation", &PY_INTERFACE::flowMapLinearApproximation, "t"_a, "x"_a.noconvert(), "u"_a.noconvert())         \
-        .def("cost", &PY_INTERFACE::cost, "t"_a, "x"_a.noconvert(), "u"_a.noconvert())                                                     \
-        .def("costQuadraticApproximation", &PY_INTERFACE::costQuadraticApproximation, "t"_a, "x"_a.noconvert(), "u"_a.noconvert())         \
-        .def("valueFunction", &PY_INTERFACE::valueFunction, "t"_a, "x"_a.noconvert())                                                      \
-        .def("valueFunctionStateDerivative", &PY_INTERFACE::valueFunctionStateDerivative, "t"_a, "x"_a.noconvert())                        \
-        .def("stateInputEqualityConstraint", &PY_INTERFACE::stateInputEqualityConstraint, "t"_a, "x"_a.noconvert(), "u"_a.noconvert())     \
+        .def("advanceMpc", &PY_INTERFACE::advanceMpc, release_gil())                                                                       \
+        .def("getMpcSolution", &PY_INTERFACE::getMpcSolution, "t"_a.noconvert(), "x"_a.noconvert(), "u"_a.noconvert(), release_gil())      \
+        .def("getMpcSolutionArrays", &PY_INTERFACE::getMpcSolutionArrays, release_gil())                                                   \
+        .def("copyMpcSolution", &PY_INTERFACE::copyMpcSolution, "t"_a.noconvert(), "x"_a.noconvert(), "u"_a.noconvert(), release_gil())    \
+        .def("getLinearFeedbackGain", &PY_INTERFACE::getLinearFeedbackGain, "t"_a.noconvert(), release_gil())                              \
+        .def("flowMap", &PY_INTERFACE::flowMap, "t"_a, "x"_a.noconvert(), "u"_a.noconvert(), release_gil())                                \
+        .def("flowMapBatch", &PY_INTERFACE::flowMapBatch, "t"_a.noconvert(), "x"_a.noconvert(), "u"_a.noconvert(), release_gil())          \
+        .def("flowMapLinearApproximation", &PY_INTERFACE::flowMapLinearApproximation, "t"_a, "x"_a.noconvert(), "u"_a.noconvert(),         \
+             release_gil())                                                                                                                \
+        .def("flowMapLinearApproximationBatch", &PY_INTERFACE::flowMapLinearApproximationBatch, "t"_a.noconvert(), "x"_a.noconvert(),      \
+             "u"_a.noconvert(), release_gil())                                                                                             \
+        .def("cost", &PY_INTERFACE::cost, "t"_a, "x"_a.noconvert(), "u"_a.noconvert(), release_gil())                                      \
+        .def("costQuadraticApproximation", &PY_INTERFACE::costQuadraticApproximation, "t"_a, "x"_a.noconvert(), "u"_a.noconvert(),         \
+             release_gil())                                                                                                                \
+        .def("costQuadraticApproximationBatch", &PY_INTERFACE::costQuadraticApproximationBatch, "t"_a.noconvert(), "x"_a.noconvert(),      \
+             "u"_a.noconvert(), release_gil())                                                                                             \
+        .def("valueFunction", &PY_INTERFACE::valueFunction, "t"_a, "x"_a.noconvert(), release_gil())                                       \
+        .def("valueFunctionStateDerivative", &PY_INTERFACE::valueFunctionStateDerivative, "t"_a, "x"_a.noconvert(), release_gil())         \
+        .def("stateInputEqualityConstraint", &PY_INTERFACE::stateInputEqualityConstraint, "t"_a, "x"_a.noconvert(), "u"_a.noconvert(),     \
+             release_gil())                                                                                                                \
         .def("stateInputEqualityConstraintLinearApproximation", &PY_INTERFACE::stateInputEqualityConstraintLinearApproximation, "t"_a,     \
-             "x"_a.noconvert(), "u"_a.noconvert())                                                                                         \
+             "x"_a.noconvert(), "u"_a.noconvert(), release_gil())                                                                          \
         .def("stateInputEqualityConstraintLagrangian", &PY_INTERFACE::stateInputEqualityConstraintLagrangian, "t"_a, "x"_a.noconvert(),    \
-             "u"_a.noconvert())                                                                                                            \
+             "u"_a.noconvert(), release_gil())                                                                                             \
         .def("visualizeTrajectory", &PY_INTERFACE::visualizeTrajectory, "t"_a.noconvert(), "x"_a.noconvert(), "u"_a.noconvert(),           \
              "speed"_a);                                                                                                                   \
+    EXTRA_BINDINGS                                                                                                                         \
   }
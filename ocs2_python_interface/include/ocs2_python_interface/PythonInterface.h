@@ -29,17 +29,52 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <functional>
+#include <mutex>
+#include <tuple>
+
 #include <ocs2_core/dynamics/SystemDynamicsBase.h>
 #include <ocs2_core/penalties/penalties/PenaltyBase.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
 #include <ocs2_mpc/MPC_MRT_Interface.h>
 #include <ocs2_oc/oc_problem/OptimalControlProblem.h>
 #include <ocs2_robotic_tools/common/RobotInterface.h>
 
 namespace ocs2 {
 
+/** A row-major matrix, which maps to a C-contiguous NumPy array with one row per node */
+using row_matrix_t = Eigen::Matrix<scalar_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+/**
+ * The linear approximations of a vector function at N nodes, stacked into arrays with one row per node. The Jacobians are flattened in
+ * row-major order, e.g. the row i of dfdx is the (stateDim x stateDim) matrix of node i.
+ */
+struct BatchedVectorFunctionLinearApproximation {
+  row_matrix_t f;     // N x stateDim
+  row_matrix_t dfdx;  // N x (stateDim * stateDim)
+  row_matrix_t dfdu;  // N x (stateDim * inputDim)
+};
+
+/**
+ * The quadratic approximations of a scalar function at N nodes, stacked into arrays with one row per node. The second order derivatives
+ * are flattened in row-major order, e.g. the row i of dfdux is the (inputDim x stateDim) matrix of node i.
+ */
+struct BatchedScalarFunctionQuadraticApproximation {
+  vector_t f;          // N
+  row_matrix_t dfdx;   // N x stateDim
+  row_matrix_t dfdu;   // N x inputDim
+  row_matrix_t dfdxx;  // N x (stateDim * stateDim)
+  row_matrix_t dfdux;  // N x (inputDim * stateDim)
+  row_matrix_t dfduu;  // N x (inputDim * inputDim)
+};
+
 /**
  * PythonInterface provides a unified interface for all systems
  * to the MPC_MRT_Interface to be used for Python bindings
+ *
+ * The methods can be called from several threads, e.g. with the GIL released by the bindings. The calls which access the MPC and the
+ * calls which evaluate the optimal control problem are serialized separately, such that the model can be evaluated while the MPC runs.
+ * The batch methods evaluate the nodes in parallel on the thread pool with one copy of the optimal control problem per thread.
  */
 class PythonInterface {
  protected:
@@ -51,8 +86,10 @@ class PythonInterface {
    * @note This should be called from derived class constructor.
    * @param [in] robot: Robot interface.
    * @param [in] mpcPtr: The Python interface takes ownership of the mpcPtr
+   * @param [in] threadPoolPtr: The thread pool of the batch methods, typically the one shared with the solver. If nullptr, the batch
+   *                            methods run in the calling thread.
    */
-  void init(const RobotInterface& robot, std::unique_ptr<MPC_BASE> mpcPtr);
+  void init(const RobotInterface& robot, std::unique_ptr<MPC_BASE> mpcPtr, std::shared_ptr<ThreadPool> threadPoolPtr = nullptr);
 
  public:
   /** Destructor */
@@ -106,6 +143,23 @@ class PythonInterface {
    */
   void getMpcSolution(scalar_array_t& t, vector_array_t& x, vector_array_t& u);
 
+  /**
+   * @brief Obtain the full MPC solution as contiguous arrays with one row per node. The solution is copied once, the arrays are then
+   * handed over to NumPy without a copy.
+   * @return The time array (N), the state array (N x stateDim), and the input array (N x inputDim).
+   */
+  std::tuple<vector_t, row_matrix_t, row_matrix_t> getMpcSolutionArrays();
+
+  /**
+   * @brief Copies the MPC solution into preallocated arrays, e.g. C-contiguous NumPy arrays of type float64, which avoids any allocation.
+   * Throws if the arrays have less rows than the solution has nodes.
+   * @param[out] t time array of at least N rows
+   * @param[out] x state array of at least N x stateDim
+   * @param[out] u input array of at least N x inputDim
+   * @return The number of nodes N of the solution which are written.
+   */
+  size_t copyMpcSolution(Eigen::Ref<vector_t> t, Eigen::Ref<row_matrix_t> x, Eigen::Ref<row_matrix_t> u);
+
   /**
    * @brief Obtains feedback gain matrix, if the underlying MPC algorithm computes it
    * @param[in] t: Query time
@@ -119,12 +173,42 @@ class PythonInterface {
   /** System dynamics linearization */
   VectorFunctionLinearApproximation flowMapLinearApproximation(scalar_t t, Eigen::Ref<const vector_t> x, Eigen::Ref<const vector_t> u);
 
+  /**
+   * System dynamics evaluated at N nodes.
+   * @param[in] t time array (N)
+   * @param[in] x state array (N x stateDim)
+   * @param[in] u input array (N x inputDim)
+   * @return The flow map array (N x stateDim).
+   */
+  row_matrix_t flowMapBatch(Eigen::Ref<const vector_t> t, Eigen::Ref<const row_matrix_t> x, Eigen::Ref<const row_matrix_t> u);
+
+  /**
+   * System dynamics linear approximation evaluated at N nodes.
+   * @param[in] t time array (N)
+   * @param[in] x state array (N x stateDim)
+   * @param[in] u input array (N x inputDim)
+   * @return The stacked linear approximations.
+   */
+  BatchedVectorFunctionLinearApproximation flowMapLinearApproximationBatch(Eigen::Ref<const vector_t> t, Eigen::Ref<const row_matrix_t> x,
+                                                                           Eigen::Ref<const row_matrix_t> u);
+
   /** Cost function with added penalty term */
   scalar_t cost(scalar_t t, Eigen::Ref<const vector_t> x, Eigen::Ref<const vector_t> u);
 
   /** Cost function quadratic approximation with added penalty term */
   ScalarFunctionQuadraticApproximation costQuadraticApproximation(scalar_t t, Eigen::Ref<const vector_t> x, Eigen::Ref<const vector_t> u);
 
+  /**
+   * Cost function quadratic approximation with added penalty term evaluated at N nodes.
+   * @param[in] t time array (N)
+   * @param[in] x state array (N x stateDim)
+   * @param[in] u input array (N x inputDim)
+   * @return The stacked quadratic approximations.
+   */
+  BatchedScalarFunctionQuadraticApproximation costQuadraticApproximationBatch(Eigen::Ref<const vector_t> t,
+                                                                              Eigen::Ref<const row_matrix_t> x,
+                                                                              Eigen::Ref<const row_matrix_t> u);
+
   /**
    * The solver's internal value function
    * @param t query time
@@ -186,11 +270,25 @@ class PythonInterface {
   int inputDim_ = -1;  // -1 indicates that it is not initialized
 
  private:
+  /** Points the target trajectories of problem_ and problemStock_ to targetTrajectories_. Requires problemMutex_. */
+  void setTargetTrajectoriesPtr();
+
+  MultiplierCollection getIntermediateDualSolution(scalar_t t);
+
+  /** Runs taskFunction(workerIndex, index) for index in [0, numNodes) on the thread pool. Requires problemMutex_. */
+  void parallelFor(Eigen::Index numNodes, std::function<void(int, int)> taskFunction);
+
   std::unique_ptr<MPC_BASE> mpcPtr_;
   std::unique_ptr<MPC_MRT_Interface> mpcMrtInterface_;
 
   TargetTrajectories targetTrajectories_;
   OptimalControlProblem problem_;
+
+  std::shared_ptr<ThreadPool> threadPoolPtr_;
+  std::vector<OptimalControlProblem> problemStock_;  // one copy of problem_ per thread of the batch methods
+
+  std::mutex mpcMutex_;      // guards the MPC
+  std::mutex problemMutex_;  // guards problem_, problemStock_, and targetTrajectories_
 };
 
 }  // namespace ocs2
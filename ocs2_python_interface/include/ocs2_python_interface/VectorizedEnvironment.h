@@ -0,0 +1,211 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <vector>
+
+#include <ocs2_core/control/FeedforwardController.h>
+#include <ocs2_core/reference/ModeSchedule.h>
+#include <ocs2_core/reference/TargetTrajectories.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
+#include <ocs2_mpc/MPC_BASE.h>
+#include <ocs2_mpc/MPC_MRT_Interface.h>
+#include <ocs2_oc/oc_problem/OptimalControlProblem.h>
+#include <ocs2_oc/rollout/RolloutBase.h>
+
+#include "ocs2_python_interface/PythonInterface.h"
+
+namespace ocs2 {
+namespace vectorized_environment {
+
+/** The settings of the vectorized environment. */
+struct Settings {
+  /** The duration of an environment step in seconds. The input is held over a step. */
+  scalar_t controlTimeStep = 0.01;
+  /** The simulated time between the MPC updates of an environment in seconds. */
+  scalar_t mpcTimeStep = 0.1;
+  /**
+   * If true, the MPC updates run in the background and a new policy is used from the first step after it is finished. Otherwise, the
+   * environment waits for the MPC update, which makes the environment deterministic.
+   */
+  bool asynchronousMpc = true;
+  /** The duration of an episode in seconds, after which an environment is done. */
+  scalar_t episodeDuration = 10.0;
+  /** The number of threads stepping the environments, in addition to the calling thread. */
+  size_t numThreads = 0;
+  /** The number of threads running the MPC updates. If zero, the MPC updates run synchronously in the stepping threads. */
+  size_t numMpcThreads = 1;
+};
+
+}  // namespace vectorized_environment
+
+/**
+ * A vectorized environment for training residual policies on top of MPC, e.g. with reinforcement learning from Python. It steps K
+ * environments in parallel, each of which consists of an MPC-MRT pair (see MPC_MRT_Interface) and a simulator rollout. The action of an
+ * environment is a residual which is added to the input of the MPC policy.
+ *
+ * The observations, the MPC inputs, the rewards, and the done flags of all environments are kept in batched buffers with one row per
+ * environment, which are exposed to Python as NumPy arrays without copies. The reward of a step is the negative intermediate cost of the
+ * optimal control problem (i.e. cost + soft constraints) integrated over the step. An environment is done when its episode is over or
+ * its simulation has failed, and it has to be reset by the user.
+ *
+ * The instances are created from one robot interface, such that the CppAD model libraries and the interface data are loaded once and
+ * shared. The MPCs should run single-threaded since the environments run in parallel.
+ */
+class VectorizedEnvironment {
+ public:
+  using mpc_factory_t = std::function<std::unique_ptr<MPC_BASE>()>;
+  using bool_vector_t = Eigen::Matrix<bool, Eigen::Dynamic, 1>;
+
+  /** Destructor. Waits for the running MPC updates. */
+  virtual ~VectorizedEnvironment();
+
+  VectorizedEnvironment(const VectorizedEnvironment&) = delete;
+  VectorizedEnvironment& operator=(const VectorizedEnvironment&) = delete;
+
+  /** The number of environments. */
+  size_t getNumEnvironments() const { return environments_.size(); }
+
+  /** The state dimension. */
+  int getStateDim() const { return states_.cols(); }
+
+  /** The input dimension, which is also the dimension of the actions. */
+  int getInputDim() const { return mpcInputs_.cols(); }
+
+  /**
+   * Resets all environments. The MPC of each environment is solved for the initial state before the method returns.
+   * @param [in] initTimes: The initial times (K).
+   * @param [in] initStates: The initial states (K x stateDim).
+   * @param [in] targetTrajectories: The target trajectories of each environment (K).
+   */
+  void reset(Eigen::Ref<const vector_t> initTimes, Eigen::Ref<const row_matrix_t> initStates,
+             const std::vector<TargetTrajectories>& targetTrajectories);
+
+  /**
+   * Resets a single environment, e.g. once it is done.
+   * @param [in] index: The index of the environment.
+   * @param [in] initTime: The initial time.
+   * @param [in] initState: The initial state.
+   * @param [in] targetTrajectories: The target trajectories.
+   */
+  void resetEnvironment(size_t index, scalar_t initTime, Eigen::Ref<const vector_t> initState, TargetTrajectories targetTrajectories);
+
+  /**
+   * Steps all environments which are not done by the control time step.
+   * @param [in] actions: The residual inputs (K x inputDim), which are added to the inputs of the MPC policies.
+   */
+  void step(Eigen::Ref<const row_matrix_t> actions);
+
+  /** The current times of the environments (K). */
+  const vector_t& getTimes() const { return times_; }
+
+  /** The current states of the environments (K x stateDim). */
+  const row_matrix_t& getStates() const { return states_; }
+
+  /** The inputs of the MPC policies at the current states (K x inputDim), i.e. the inputs to which the next actions are added. */
+  const row_matrix_t& getMpcInputs() const { return mpcInputs_; }
+
+  /** The rewards of the latest step (K). */
+  const vector_t& getRewards() const { return rewards_; }
+
+  /** The done flags (K). */
+  const bool_vector_t& getDones() const { return dones_; }
+
+ protected:
+  /** Constructor */
+  VectorizedEnvironment() = default;
+
+  /**
+   * Creates the environments and the threads.
+   * @note This should be called from derived class constructor.
+   * @param [in] numEnvironments: The number of environments.
+   * @param [in] stateDim: The state dimension.
+   * @param [in] inputDim: The input dimension.
+   * @param [in] settings: The settings.
+   * @param [in] mpcFactory: Creates the MPC of an environment. It is called numEnvironments times in the calling thread. The MPCs must
+   * not share a reference manager.
+   * @param [in] simulator: The rollout which simulates the system, it is cloned for each environment. The clones are stepped in parallel,
+   * hence they should not share any simulation state.
+   */
+  void init(size_t numEnvironments, int stateDim, int inputDim, vectorized_environment::Settings settings, const mpc_factory_t& mpcFactory,
+            const RolloutBase& simulator);
+
+ private:
+  struct Environment {
+    std::unique_ptr<MPC_BASE> mpcPtr;
+    std::unique_ptr<MPC_MRT_Interface> mrtPtr;
+    std::unique_ptr<RolloutBase> simulatorPtr;
+    std::unique_ptr<OptimalControlProblem> problemPtr;  // used to evaluate the rewards
+    TargetTrajectories targetTrajectories;
+    SystemObservation observation;
+    size_t stepCount = 0;
+    scalar_t episodeEndTime = 0.0;
+    std::future<void> mpcUpdate;
+
+    // buffers of the simulation
+    vector_t plannedState;
+    vector_t mpcInput;
+    FeedforwardController controller;
+    ModeSchedule modeSchedule;
+    scalar_array_t timeTrajectory;
+    size_array_t postEventIndices;
+    vector_array_t stateTrajectory;
+    vector_array_t inputTrajectory;
+  };
+
+  /** Runs the MPC update of an environment on its current observation, asynchronously if enabled. */
+  void startMpcUpdate(Environment& environment);
+
+  /** Waits for the running MPC update of an environment, if wait is true, and loads its policy once it is finished. */
+  void finishMpcUpdate(Environment& environment, bool wait);
+
+  /** Steps an environment and writes its results to the row index of the buffers. */
+  void stepEnvironment(size_t index, const Eigen::Ref<const row_matrix_t>& actions);
+
+  /** Evaluates the MPC policy at the current observation of an environment and writes it to its row of the buffers. */
+  void updateBuffers(size_t index);
+
+  vectorized_environment::Settings settings_;
+  size_t mpcUpdateRatio_ = 1;
+  std::vector<Environment> environments_;
+  std::unique_ptr<ThreadPool> threadPoolPtr_;
+  std::unique_ptr<ThreadPool> mpcThreadPoolPtr_;
+
+  vector_t times_;
+  row_matrix_t states_;
+  row_matrix_t mpcInputs_;
+  vector_t rewards_;
+  bool_vector_t dones_;
+};
+
+}  // namespace ocs2
@@ -0,0 +1,188 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_python_interface/MpcPool.h"
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MpcPool::init(size_t numInstances, const mpc_factory_t& mpcFactory) {
+  if (numInstances < 1) {
+    throw std::runtime_error("[MpcPool] numInstances must be at least 1!");
+  }
+  if (!mpcs_.empty()) {
+    throw std::runtime_error("[MpcPool] The pool is already initialized!");
+  }
+
+  mpcs_.reserve(numInstances);
+  for (size_t i = 0; i < numInstances; i++) {
+    mpcs_.push_back(mpcFactory());
+    if (mpcs_.back() == nullptr) {
+      throw std::runtime_error("[MpcPool] The factory returned a nullptr!");
+    }
+  }
+
+  workers_.reserve(numInstances);
+  for (auto& mpcPtr : mpcs_) {
+    workers_.emplace_back(&MpcPool::worker, this, std::ref(*mpcPtr));
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+MpcPool::~MpcPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+    jobs_.clear();
+  }
+  jobReady_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t MpcPool::submit(MpcJob job) {
+  size_t jobId;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    jobId = nextJobId_++;
+    jobs_.emplace_back(jobId, std::move(job));
+  }
+  jobReady_.notify_one();
+  return jobId;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::vector<size_t> MpcPool::submitBatch(Eigen::Ref<const vector_t> initTimes, Eigen::Ref<const row_matrix_t> initStates,
+                                         const std::vector<TargetTrajectories>& targetTrajectories) {
+  const auto numJobs = initTimes.size();
+  if (initStates.rows() != numJobs || static_cast<Eigen::Index>(targetTrajectories.size()) != numJobs) {
+    throw std::runtime_error("[MpcPool::submitBatch] The initial states and the target trajectories must have " + std::to_string(numJobs) +
+                             " entries!");
+  }
+
+  std::vector<size_t> jobIds;
+  jobIds.reserve(numJobs);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (Eigen::Index i = 0; i < numJobs; i++) {
+      MpcJob job;
+      job.initTime = initTimes(i);
+      job.initState = initStates.row(i).transpose();
+      job.targetTrajectories = targetTrajectories[i];
+      jobIds.push_back(nextJobId_++);
+      jobs_.emplace_back(jobIds.back(), std::move(job));
+    }
+  }
+  jobReady_.notify_all();
+  return jobIds;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::vector<MpcJobResult> MpcPool::collect(size_t minResults) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  resultReady_.wait(lock, [&]() { return results_.size() >= minResults || (jobs_.empty() && numRunning_ == 0); });
+  std::vector<MpcJobResult> results;
+  results.swap(results_);
+  return results;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t MpcPool::getNumPending() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return jobs_.size() + numRunning_;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MpcPool::worker(MPC_BASE& mpc) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    jobReady_.wait(lock, [&]() { return stop_ || !jobs_.empty(); });
+    if (stop_) {
+      return;
+    }
+    const auto job = std::move(jobs_.front());
+    jobs_.pop_front();
+    ++numRunning_;
+
+    lock.unlock();
+    auto result = solve(mpc, job.first, job.second);
+    lock.lock();
+
+    results_.push_back(std::move(result));
+    --numRunning_;
+    resultReady_.notify_all();
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+MpcJobResult MpcPool::solve(MPC_BASE& mpc, size_t jobId, const MpcJob& job) const {
+  MpcJobResult result;
+  result.jobId = jobId;
+  try {
+    mpc.reset();
+    mpc.getSolverPtr()->getReferenceManager().setTargetTrajectories(job.targetTrajectories);
+    result.success = mpc.run(job.initTime, job.initState);
+
+    const auto* solverPtr = mpc.getSolverPtr();
+    const auto primalSolution = solverPtr->primalSolution(solverPtr->getFinalTime());
+    const auto numNodes = static_cast<Eigen::Index>(primalSolution.timeTrajectory_.size());
+    result.t = Eigen::Map<const vector_t>(primalSolution.timeTrajectory_.data(), numNodes);
+    result.x.resize(numNodes, job.initState.size());
+    result.u.resize(numNodes, numNodes > 0 ? primalSolution.inputTrajectory_.front().size() : 0);
+    for (Eigen::Index i = 0; i < numNodes; i++) {
+      result.x.row(i) = primalSolution.stateTrajectory_[i].transpose();
+      result.u.row(i) = primalSolution.inputTrajectory_[i].transpose();
+    }
+    result.performanceIndex = solverPtr->getPerformanceIndeces();
+  } catch (const std::exception& error) {
+    result.success = false;
+    result.errorMessage = error.what();
+  }
+  return result;
+}
+
+}  // namespace ocs2
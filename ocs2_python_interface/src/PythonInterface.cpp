@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_python_interface/PythonInterface.h"
 
+#include <algorithm>
+
 #include <ocs2_core/misc/LinearAlgebra.h>
 #include <ocs2_core/penalties/MultidimensionalPenalty.h>
 
@@ -39,7 +41,7 @@ namespace ocs2 {
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-void PythonInterface::init(const RobotInterface& robot, std::unique_ptr<MPC_BASE> mpcPtr) {
+void PythonInterface::init(const RobotInterface& robot, std::unique_ptr<MPC_BASE> mpcPtr, std::shared_ptr<ThreadPool> threadPoolPtr) {
   if (!mpcPtr) {
     throw std::runtime_error("[PythonInterface] Mpc pointer must be initialized before passing to the Python interface.");
   }
@@ -48,15 +50,20 @@ void PythonInterface::init(const RobotInterface& robot, std::unique_ptr<MPC_BASE
   mpcMrtInterface_.reset(new MPC_MRT_Interface(*mpcPtr_));
 
   problem_ = robot.getOptimalControlProblem();
+
+  threadPoolPtr_ = threadPoolPtr != nullptr ? std::move(threadPoolPtr) : std::make_shared<ThreadPool>(0);
+  problemStock_.assign(threadPoolPtr_->numThreads() + 1, problem_);
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 void PythonInterface::reset(TargetTrajectories targetTrajectories) {
+  std::lock_guard<std::mutex> mpcLock(mpcMutex_);
+  std::lock_guard<std::mutex> problemLock(problemMutex_);
   targetTrajectories_ = std::move(targetTrajectories);
   mpcMrtInterface_->resetMpcNode(targetTrajectories_);
-  problem_.targetTrajectoriesPtr = &targetTrajectories_;
+  setTargetTrajectoriesPtr();
 }
 
 /******************************************************************************************************/
@@ -74,15 +81,28 @@ void PythonInterface::setObservation(scalar_t t, Eigen::Ref<const vector_t> x, E
 /******************************************************************************************************/
 /******************************************************************************************************/
 void PythonInterface::setTargetTrajectories(TargetTrajectories targetTrajectories) {
+  std::lock_guard<std::mutex> mpcLock(mpcMutex_);
+  std::lock_guard<std::mutex> problemLock(problemMutex_);
   targetTrajectories_ = std::move(targetTrajectories);
-  problem_.targetTrajectoriesPtr = &targetTrajectories_;
+  setTargetTrajectoriesPtr();
   mpcMrtInterface_->getReferenceManager().setTargetTrajectories(targetTrajectories_);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PythonInterface::setTargetTrajectoriesPtr() {
+  problem_.targetTrajectoriesPtr = &targetTrajectories_;
+  for (auto& problem : problemStock_) {
+    problem.targetTrajectoriesPtr = &targetTrajectories_;
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 void PythonInterface::advanceMpc() {
+  std::lock_guard<std::mutex> lock(mpcMutex_);
   mpcMrtInterface_->advanceMpc();
 }
 
@@ -90,103 +110,293 @@ void PythonInterface::advanceMpc() {
 /******************************************************************************************************/
 /******************************************************************************************************/
 void PythonInterface::getMpcSolution(scalar_array_t& t, vector_array_t& x, vector_array_t& u) {
+  std::lock_guard<std::mutex> lock(mpcMutex_);
   mpcMrtInterface_->updatePolicy();
   t = mpcMrtInterface_->getPolicy().timeTrajectory_;
   x = mpcMrtInterface_->getPolicy().stateTrajectory_;
   u = mpcMrtInterface_->getPolicy().inputTrajectory_;
 }
 
-/******************************************************************************************************/
-/******************************************************************************************************/
-/******************************************************************************************************/
-matrix_t PythonInterface::getLinearFeedbackGain(scalar_t time) {
-  return mpcMrtInterface_->getLinearFeedbackGain(time);
+namespace {
+
+/** Checks that the state and input arrays have one row per time */
+void checkBatch(const char* functionName, Eigen::Index numNodes, const Eigen::Ref<const row_matrix_t>& x,
+                const Eigen::Ref<const row_matrix_t>& u) {
+  if (x.rows() != numNodes || u.rows() != numNodes) {
+    throw std::runtime_error(std::string("[PythonInterface::") + functionName + "] The state and input arrays must have " +
+                             std::to_string(numNodes) + " rows!");
+  }
 }
 
-/******************************************************************************************************/
-/******************************************************************************************************/
-/******************************************************************************************************/
-vector_t PythonInterface::flowMap(scalar_t t, Eigen::Ref<const vector_t> x, Eigen::Ref<const vector_t> u) {
-  return problem_.dynamicsPtr->computeFlowMap(t, x, u);
+/**
+ * Splits the nodes into blocks of consecutive nodes with the same time, which are evaluated in one call of the batched dynamics. The
+ * blocks are at most ceil(N / numWorkers) long such that all workers are busy.
+ */
+std::vector<std::pair<Eigen::Index, Eigen::Index>> getEqualTimeBlocks(const Eigen::Ref<const vector_t>& t, size_t numWorkers) {
+  const auto numNodes = t.size();
+  const Eigen::Index maxBlockSize = std::max<Eigen::Index>(1, (numNodes + numWorkers - 1) / std::max<size_t>(1, numWorkers));
+  std::vector<std::pair<Eigen::Index, Eigen::Index>> blocks;  // (first node, number of nodes)
+  Eigen::Index first = 0;
+  for (Eigen::Index i = 1; i <= numNodes; i++) {
+    if (i == numNodes || t(i) != t(first) || i - first == maxBlockSize) {
+      blocks.emplace_back(first, i - first);
+      first = i;
+    }
+  }
+  return blocks;
 }
 
-/******************************************************************************************************/
-/******************************************************************************************************/
-/******************************************************************************************************/
-VectorFunctionLinearApproximation PythonInterface::flowMapLinearApproximation(scalar_t t, Eigen::Ref<const vector_t> x,
-                                                                              Eigen::Ref<const vector_t> u) {
-  return problem_.dynamicsPtr->linearApproximation(t, x, u);
+/** Copies the policy into arrays with at least N rows and returns N */
+size_t copyPolicy(const PrimalSolution& policy, Eigen::Ref<vector_t> t, Eigen::Ref<row_matrix_t> x, Eigen::Ref<row_matrix_t> u) {
+  const auto numNodes = static_cast<Eigen::Index>(policy.timeTrajectory_.size());
+  if (t.size() < numNodes || x.rows() < numNodes || u.rows() < numNodes) {
+    throw std::runtime_error("[PythonInterface::copyMpcSolution] The arrays must have at least " + std::to_string(numNodes) + " rows!");
+  }
+
+  t.head(numNodes) = Eigen::Map<const vector_t>(policy.timeTrajectory_.data(), numNodes);
+  for (Eigen::Index i = 0; i < numNodes; i++) {
+    if (policy.stateTrajectory_[i].size() != x.cols() || policy.inputTrajectory_[i].size() != u.cols()) {
+      throw std::runtime_error("[PythonInterface::copyMpcSolution] The number of columns does not match the state and input dimensions!");
+    }
+    x.row(i) = policy.stateTrajectory_[i].transpose();
+    u.row(i) = policy.inputTrajectory_[i].transpose();
+  }
+  return static_cast<size_t>(numNodes);
 }
 
-/******************************************************************************************************/
-/******************************************************************************************************/
-/******************************************************************************************************/
-scalar_t PythonInterface::cost(scalar_t t, Eigen::Ref<const vector_t> x, Eigen::Ref<const vector_t> u) {
-  auto& preComputation = *problem_.preComputationPtr;
+/** Cost with the Lagrangians of the given multipliers */
+scalar_t computeCostWithLagrangians(OptimalControlProblem& problem, scalar_t t, const vector_t& x, const vector_t& u,
+                                    const MultiplierCollection& m) {
+  auto& preComputation = *problem.preComputationPtr;
   const auto request = Request::Cost + Request::SoftConstraint + Request::Constraint;
   preComputation.request(request, t, x, u);
 
   // cost
-  scalar_t cost = computeCost(problem_, t, x, u);
+  scalar_t cost = computeCost(problem, t, x, u);
 
   // Lagrangians
-  const auto m = mpcMrtInterface_->getIntermediateDualSolution(t);
-  if (!problem_.stateEqualityLagrangianPtr->empty()) {
-    cost += sumPenalties(problem_.stateEqualityLagrangianPtr->getValue(t, x, m.stateEq, preComputation));
+  if (!problem.stateEqualityLagrangianPtr->empty()) {
+    cost += sumPenalties(problem.stateEqualityLagrangianPtr->getValue(t, x, m.stateEq, preComputation));
   }
-  if (!problem_.stateInequalityLagrangianPtr->empty()) {
-    cost += sumPenalties(problem_.stateInequalityLagrangianPtr->getValue(t, x, m.stateIneq, preComputation));
+  if (!problem.stateInequalityLagrangianPtr->empty()) {
+    cost += sumPenalties(problem.stateInequalityLagrangianPtr->getValue(t, x, m.stateIneq, preComputation));
   }
-  if (!problem_.equalityLagrangianPtr->empty()) {
-    cost += sumPenalties(problem_.equalityLagrangianPtr->getValue(t, x, u, m.stateInputEq, preComputation));
+  if (!problem.equalityLagrangianPtr->empty()) {
+    cost += sumPenalties(problem.equalityLagrangianPtr->getValue(t, x, u, m.stateInputEq, preComputation));
   }
-  if (!problem_.inequalityLagrangianPtr->empty()) {
-    cost += sumPenalties(problem_.inequalityLagrangianPtr->getValue(t, x, u, m.stateInputIneq, preComputation));
+  if (!problem.inequalityLagrangianPtr->empty()) {
+    cost += sumPenalties(problem.inequalityLagrangianPtr->getValue(t, x, u, m.stateInputIneq, preComputation));
   }
 
   return cost;
 }
 
-/******************************************************************************************************/
-/******************************************************************************************************/
-/******************************************************************************************************/
-ScalarFunctionQuadraticApproximation PythonInterface::costQuadraticApproximation(scalar_t t, Eigen::Ref<const vector_t> x,
-                                                                                 Eigen::Ref<const vector_t> u) {
-  auto& preComputation = *problem_.preComputationPtr;
+/** Cost quadratic approximation with the Lagrangians of the given multipliers */
+ScalarFunctionQuadraticApproximation approximateCostWithLagrangians(OptimalControlProblem& problem, scalar_t t, const vector_t& x,
+                                                                    const vector_t& u, const MultiplierCollection& m) {
+  auto& preComputation = *problem.preComputationPtr;
   const auto request = Request::Cost + Request::SoftConstraint + Request::Constraint + Request::Approximation;
   preComputation.request(request, t, x, u);
 
   // cost
-  auto cost = approximateCost(problem_, t, x, u);
+  auto cost = approximateCost(problem, t, x, u);
 
   // Lagrangians
-  const auto m = mpcMrtInterface_->getIntermediateDualSolution(t);
-  if (!problem_.stateEqualityLagrangianPtr->empty()) {
-    auto approx = problem_.stateEqualityLagrangianPtr->getQuadraticApproximation(t, x, m.stateEq, preComputation);
+  if (!problem.stateEqualityLagrangianPtr->empty()) {
+    auto approx = problem.stateEqualityLagrangianPtr->getQuadraticApproximation(t, x, m.stateEq, preComputation);
     cost.f += approx.f;
     cost.dfdx += approx.dfdx;
     cost.dfdxx += approx.dfdxx;
   }
-  if (!problem_.stateInequalityLagrangianPtr->empty()) {
-    auto approx = problem_.stateInequalityLagrangianPtr->getQuadraticApproximation(t, x, m.stateIneq, preComputation);
+  if (!problem.stateInequalityLagrangianPtr->empty()) {
+    auto approx = problem.stateInequalityLagrangianPtr->getQuadraticApproximation(t, x, m.stateIneq, preComputation);
     cost.f += approx.f;
     cost.dfdx += approx.dfdx;
     cost.dfdxx += approx.dfdxx;
   }
-  if (!problem_.equalityLagrangianPtr->empty()) {
-    cost += problem_.equalityLagrangianPtr->getQuadraticApproximation(t, x, u, m.stateInputEq, preComputation);
+  if (!problem.equalityLagrangianPtr->empty()) {
+    cost += problem.equalityLagrangianPtr->getQuadraticApproximation(t, x, u, m.stateInputEq, preComputation);
   }
-  if (!problem_.inequalityLagrangianPtr->empty()) {
-    cost += problem_.inequalityLagrangianPtr->getQuadraticApproximation(t, x, u, m.stateInputIneq, preComputation);
+  if (!problem.inequalityLagrangianPtr->empty()) {
+    cost += problem.inequalityLagrangianPtr->getQuadraticApproximation(t, x, u, m.stateInputIneq, preComputation);
   }
 
   return cost;
 }
 
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::tuple<vector_t, row_matrix_t, row_matrix_t> PythonInterface::getMpcSolutionArrays() {
+  std::lock_guard<std::mutex> lock(mpcMutex_);
+  mpcMrtInterface_->updatePolicy();
+  const auto& policy = mpcMrtInterface_->getPolicy();
+  const auto numNodes = static_cast<Eigen::Index>(policy.timeTrajectory_.size());
+  const auto stateDim = numNodes > 0 ? policy.stateTrajectory_.front().size() : 0;
+  const auto inputDim = numNodes > 0 ? policy.inputTrajectory_.front().size() : 0;
+
+  std::tuple<vector_t, row_matrix_t, row_matrix_t> solution;
+  std::get<0>(solution).resize(numNodes);
+  std::get<1>(solution).resize(numNodes, stateDim);
+  std::get<2>(solution).resize(numNodes, inputDim);
+  copyPolicy(policy, std::get<0>(solution), std::get<1>(solution), std::get<2>(solution));
+  return solution;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t PythonInterface::copyMpcSolution(Eigen::Ref<vector_t> t, Eigen::Ref<row_matrix_t> x, Eigen::Ref<row_matrix_t> u) {
+  std::lock_guard<std::mutex> lock(mpcMutex_);
+  mpcMrtInterface_->updatePolicy();
+  return copyPolicy(mpcMrtInterface_->getPolicy(), t, x, u);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+matrix_t PythonInterface::getLinearFeedbackGain(scalar_t time) {
+  std::lock_guard<std::mutex> lock(mpcMutex_);
+  return mpcMrtInterface_->getLinearFeedbackGain(time);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t PythonInterface::flowMap(scalar_t t, Eigen::Ref<const vector_t> x, Eigen::Ref<const vector_t> u) {
+  std::lock_guard<std::mutex> lock(problemMutex_);
+  return problem_.dynamicsPtr->computeFlowMap(t, x, u);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+row_matrix_t PythonInterface::flowMapBatch(Eigen::Ref<const vector_t> t, Eigen::Ref<const row_matrix_t> x,
+                                           Eigen::Ref<const row_matrix_t> u) {
+  checkBatch("flowMapBatch", t.size(), x, u);
+  row_matrix_t dxdt(t.size(), x.cols());
+  std::lock_guard<std::mutex> lock(problemMutex_);
+  const auto blocks = getEqualTimeBlocks(t, problemStock_.size());
+  parallelFor(blocks.size(), [&](int workerIndex, int b) {
+    const auto first = blocks[b].first;
+    const auto size = blocks[b].second;
+    auto& dynamics = *problemStock_[workerIndex].dynamicsPtr;
+    matrix_t dxdtBlock;
+    dynamics.computeFlowMapBatch(t(first), x.middleRows(first, size).transpose(), u.middleRows(first, size).transpose(), dxdtBlock);
+    dxdt.middleRows(first, size) = dxdtBlock.transpose();
+  });
+  return dxdt;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+VectorFunctionLinearApproximation PythonInterface::flowMapLinearApproximation(scalar_t t, Eigen::Ref<const vector_t> x,
+                                                                              Eigen::Ref<const vector_t> u) {
+  std::lock_guard<std::mutex> lock(problemMutex_);
+  return problem_.dynamicsPtr->linearApproximation(t, x, u);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+BatchedVectorFunctionLinearApproximation PythonInterface::flowMapLinearApproximationBatch(Eigen::Ref<const vector_t> t,
+                                                                                          Eigen::Ref<const row_matrix_t> x,
+                                                                                          Eigen::Ref<const row_matrix_t> u) {
+  checkBatch("flowMapLinearApproximationBatch", t.size(), x, u);
+  const auto numNodes = t.size();
+  const auto stateDim = x.cols();
+  const auto inputDim = u.cols();
+  BatchedVectorFunctionLinearApproximation batch;
+  batch.f.resize(numNodes, stateDim);
+  batch.dfdx.resize(numNodes, stateDim * stateDim);
+  batch.dfdu.resize(numNodes, stateDim * inputDim);
+
+  std::lock_guard<std::mutex> lock(problemMutex_);
+  const auto blocks = getEqualTimeBlocks(t, problemStock_.size());
+  parallelFor(blocks.size(), [&](int workerIndex, int b) {
+    const auto first = blocks[b].first;
+    const auto size = blocks[b].second;
+    auto& dynamics = *problemStock_[workerIndex].dynamicsPtr;
+    matrix_t fBlock, dfdxBlock, dfduBlock;
+    dynamics.linearApproximationBatch(t(first), x.middleRows(first, size).transpose(), u.middleRows(first, size).transpose(), fBlock,
+                                      dfdxBlock, dfduBlock);
+    batch.f.middleRows(first, size) = fBlock.transpose();
+    for (Eigen::Index k = 0; k < size; k++) {
+      Eigen::Map<row_matrix_t>(batch.dfdx.row(first + k).data(), stateDim, stateDim) = dfdxBlock.middleCols(k * stateDim, stateDim);
+      Eigen::Map<row_matrix_t>(batch.dfdu.row(first + k).data(), stateDim, inputDim) = dfduBlock.middleCols(k * inputDim, inputDim);
+    }
+  });
+  return batch;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t PythonInterface::cost(scalar_t t, Eigen::Ref<const vector_t> x, Eigen::Ref<const vector_t> u) {
+  const auto m = getIntermediateDualSolution(t);
+  std::lock_guard<std::mutex> lock(problemMutex_);
+  return computeCostWithLagrangians(problem_, t, x, u, m);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ScalarFunctionQuadraticApproximation PythonInterface::costQuadraticApproximation(scalar_t t, Eigen::Ref<const vector_t> x,
+                                                                                 Eigen::Ref<const vector_t> u) {
+  const auto m = getIntermediateDualSolution(t);
+  std::lock_guard<std::mutex> lock(problemMutex_);
+  return approximateCostWithLagrangians(problem_, t, x, u, m);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+BatchedScalarFunctionQuadraticApproximation PythonInterface::costQuadraticApproximationBatch(Eigen::Ref<const vector_t> t,
+                                                                                             Eigen::Ref<const row_matrix_t> x,
+                                                                                             Eigen::Ref<const row_matrix_t> u) {
+  checkBatch("costQuadraticApproximationBatch", t.size(), x, u);
+  const auto numNodes = t.size();
+  const auto stateDim = x.cols();
+  const auto inputDim = u.cols();
+  BatchedScalarFunctionQuadraticApproximation batch;
+  batch.f.resize(numNodes);
+  batch.dfdx.resize(numNodes, stateDim);
+  batch.dfdu.resize(numNodes, inputDim);
+  batch.dfdxx.resize(numNodes, stateDim * stateDim);
+  batch.dfdux.resize(numNodes, inputDim * stateDim);
+  batch.dfduu.resize(numNodes, inputDim * inputDim);
+
+  std::vector<MultiplierCollection> multipliers;
+  multipliers.reserve(numNodes);
+  {
+    std::lock_guard<std::mutex> lock(mpcMutex_);
+    for (Eigen::Index i = 0; i < numNodes; i++) {
+      multipliers.push_back(mpcMrtInterface_->getIntermediateDualSolution(t(i)));
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(problemMutex_);
+  parallelFor(numNodes, [&](int workerIndex, int i) {
+    auto& problem = problemStock_[workerIndex];
+    const auto cost = approximateCostWithLagrangians(problem, t(i), x.row(i).transpose(), u.row(i).transpose(), multipliers[i]);
+    batch.f(i) = cost.f;
+    batch.dfdx.row(i) = cost.dfdx.transpose();
+    batch.dfdu.row(i) = cost.dfdu.transpose();
+    Eigen::Map<row_matrix_t>(batch.dfdxx.row(i).data(), stateDim, stateDim) = cost.dfdxx;
+    Eigen::Map<row_matrix_t>(batch.dfdux.row(i).data(), inputDim, stateDim) = cost.dfdux;
+    Eigen::Map<row_matrix_t>(batch.dfduu.row(i).data(), inputDim, inputDim) = cost.dfduu;
+  });
+  return batch;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 scalar_t PythonInterface::valueFunction(scalar_t t, Eigen::Ref<const vector_t> x) {
+  std::lock_guard<std::mutex> lock(mpcMutex_);
   return mpcMrtInterface_->getValueFunction(t, x).f;
 }
 
@@ -194,6 +404,7 @@ scalar_t PythonInterface::valueFunction(scalar_t t, Eigen::Ref<const vector_t> x
 /******************************************************************************************************/
 /******************************************************************************************************/
 vector_t PythonInterface::valueFunctionStateDerivative(scalar_t t, Eigen::Ref<const vector_t> x) {
+  std::lock_guard<std::mutex> lock(mpcMutex_);
   return mpcMrtInterface_->getValueFunction(t, x).dfdx;
 }
 
@@ -201,6 +412,7 @@ vector_t PythonInterface::valueFunctionStateDerivative(scalar_t t, Eigen::Ref<co
 /******************************************************************************************************/
 /******************************************************************************************************/
 vector_t PythonInterface::stateInputEqualityConstraint(scalar_t t, Eigen::Ref<const vector_t> x, Eigen::Ref<const vector_t> u) {
+  std::lock_guard<std::mutex> lock(problemMutex_);
   problem_.preComputationPtr->request(Request::Constraint, t, x, u);
   return problem_.equalityConstraintPtr->getValue(t, x, u, *problem_.preComputationPtr);
 }
@@ -210,6 +422,7 @@ vector_t PythonInterface::stateInputEqualityConstraint(scalar_t t, Eigen::Ref<co
 /******************************************************************************************************/
 VectorFunctionLinearApproximation PythonInterface::stateInputEqualityConstraintLinearApproximation(scalar_t t, Eigen::Ref<const vector_t> x,
                                                                                                    Eigen::Ref<const vector_t> u) {
+  std::lock_guard<std::mutex> lock(problemMutex_);
   problem_.preComputationPtr->request(Request::Constraint + Request::Approximation, t, x, u);
   return problem_.equalityConstraintPtr->getLinearApproximation(t, x, u, *problem_.preComputationPtr);
 }
@@ -240,4 +453,20 @@ vector_t PythonInterface::stateInputEqualityConstraintLagrangian(scalar_t t, Eig
   return DmDager.transpose() * (R * DmDager * c - r - B.transpose() * costate);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+MultiplierCollection PythonInterface::getIntermediateDualSolution(scalar_t t) {
+  std::lock_guard<std::mutex> lock(mpcMutex_);
+  return mpcMrtInterface_->getIntermediateDualSolution(t);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PythonInterface::parallelFor(Eigen::Index numNodes, std::function<void(int, int)> taskFunction) {
+  constexpr int grain = 4;
+  threadPoolPtr_->parallelFor(0, static_cast<int>(numNodes), grain, std::move(taskFunction), problemStock_.size());
+}
+
 }  // namespace ocs2
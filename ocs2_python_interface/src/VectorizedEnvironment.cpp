@@ -0,0 +1,267 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_python_interface/VectorizedEnvironment.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+#include <ocs2_oc/approximate_model/LinearQuadraticApproximator.h>
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void VectorizedEnvironment::init(size_t numEnvironments, int stateDim, int inputDim, vectorized_environment::Settings settings,
+                                 const mpc_factory_t& mpcFactory, const RolloutBase& simulator) {
+  if (numEnvironments < 1) {
+    throw std::runtime_error("[VectorizedEnvironment] numEnvironments must be at least 1!");
+  }
+  if (!environments_.empty()) {
+    throw std::runtime_error("[VectorizedEnvironment] The environment is already initialized!");
+  }
+  if (settings.controlTimeStep <= 0.0 || settings.mpcTimeStep < settings.controlTimeStep) {
+    throw std::runtime_error("[VectorizedEnvironment] The control time step must be positive and not larger than the MPC time step!");
+  }
+
+  settings_ = std::move(settings);
+  mpcUpdateRatio_ = std::max(static_cast<size_t>(std::round(settings_.mpcTimeStep / settings_.controlTimeStep)), size_t(1));
+
+  environments_.resize(numEnvironments);
+  for (auto& environment : environments_) {
+    environment.mpcPtr = mpcFactory();
+    if (environment.mpcPtr == nullptr) {
+      throw std::runtime_error("[VectorizedEnvironment] The factory returned a nullptr!");
+    }
+    environment.mrtPtr.reset(new MPC_MRT_Interface(*environment.mpcPtr));
+    environment.simulatorPtr.reset(simulator.clone());
+    environment.problemPtr.reset(new OptimalControlProblem(environment.mpcPtr->getSolverPtr()->getOptimalControlProblem()));
+    environment.problemPtr->targetTrajectoriesPtr = &environment.targetTrajectories;
+  }
+
+  threadPoolPtr_.reset(new ThreadPool(settings_.numThreads));
+  if (settings_.numMpcThreads > 0) {
+    mpcThreadPoolPtr_.reset(new ThreadPool(settings_.numMpcThreads));
+  }
+
+  // the environments are done until they are reset
+  times_.setZero(numEnvironments);
+  states_.setZero(numEnvironments, stateDim);
+  mpcInputs_.setZero(numEnvironments, inputDim);
+  rewards_.setZero(numEnvironments);
+  dones_.setConstant(numEnvironments, true);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+VectorizedEnvironment::~VectorizedEnvironment() {
+  for (auto& environment : environments_) {
+    if (environment.mpcUpdate.valid()) {
+      environment.mpcUpdate.wait();
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void VectorizedEnvironment::reset(Eigen::Ref<const vector_t> initTimes, Eigen::Ref<const row_matrix_t> initStates,
+                                  const std::vector<TargetTrajectories>& targetTrajectories) {
+  const auto numEnvironments = static_cast<Eigen::Index>(environments_.size());
+  if (initTimes.size() != numEnvironments || initStates.rows() != numEnvironments ||
+      static_cast<Eigen::Index>(targetTrajectories.size()) != numEnvironments) {
+    throw std::runtime_error("[VectorizedEnvironment::reset] The initial times, states, and target trajectories must have " +
+                             std::to_string(numEnvironments) + " entries!");
+  }
+
+  threadPoolPtr_->parallelFor(0, static_cast<int>(numEnvironments), 1, [&](int, int i) {
+    resetEnvironment(i, initTimes(i), initStates.row(i).transpose(), targetTrajectories[i]);
+  });
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void VectorizedEnvironment::resetEnvironment(size_t index, scalar_t initTime, Eigen::Ref<const vector_t> initState,
+                                             TargetTrajectories targetTrajectories) {
+  if (index >= environments_.size()) {
+    throw std::runtime_error("[VectorizedEnvironment::resetEnvironment] The index " + std::to_string(index) + " is out of range!");
+  }
+  if (initState.size() != getStateDim()) {
+    throw std::runtime_error("[VectorizedEnvironment::resetEnvironment] The initial state must have " + std::to_string(getStateDim()) +
+                             " entries!");
+  }
+
+  auto& environment = environments_[index];
+  if (environment.mpcUpdate.valid()) {
+    environment.mpcUpdate.wait();
+    environment.mpcUpdate = std::future<void>();
+  }
+
+  environment.targetTrajectories = std::move(targetTrajectories);
+  environment.observation.time = initTime;
+  environment.observation.state = initState;
+  environment.observation.input.setZero(getInputDim());
+  environment.observation.mode = environment.mpcPtr->getSolverPtr()->getReferenceManager().getModeSchedule().modeAtTime(initTime);
+  environment.stepCount = 0;
+  environment.episodeEndTime = initTime + settings_.episodeDuration;
+
+  // the policy of a previous episode is discarded, the first policy is solved synchronously
+  environment.mrtPtr->reset();
+  environment.mrtPtr->resetMpcNode(environment.targetTrajectories);
+  environment.simulatorPtr->resetRollout();
+  environment.mrtPtr->setCurrentObservation(environment.observation);
+  environment.mrtPtr->advanceMpc();
+  if (!environment.mrtPtr->updatePolicy()) {
+    throw std::runtime_error("[VectorizedEnvironment::resetEnvironment] MPC has not provided a policy for the environment " +
+                             std::to_string(index) + "!");
+  }
+
+  rewards_(index) = 0.0;
+  dones_(index) = false;
+  updateBuffers(index);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void VectorizedEnvironment::step(Eigen::Ref<const row_matrix_t> actions) {
+  const auto numEnvironments = static_cast<Eigen::Index>(environments_.size());
+  if (actions.rows() != numEnvironments || actions.cols() != getInputDim()) {
+    throw std::runtime_error("[VectorizedEnvironment::step] The actions must be of size " + std::to_string(numEnvironments) + " x " +
+                             std::to_string(getInputDim()) + "!");
+  }
+
+  threadPoolPtr_->parallelFor(0, static_cast<int>(numEnvironments), 1, [&](int, int i) {
+    if (dones_(i)) {
+      rewards_(i) = 0.0;
+    } else {
+      stepEnvironment(i, actions);
+    }
+  });
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void VectorizedEnvironment::stepEnvironment(size_t index, const Eigen::Ref<const row_matrix_t>& actions) {
+  auto& environment = environments_[index];
+  auto& observation = environment.observation;
+  const scalar_t dt = settings_.controlTimeStep;
+
+  // the residual is added to the input of the MPC policy, which is held over the step
+  observation.input = mpcInputs_.row(index).transpose() + actions.row(index).transpose();
+
+  // reward
+  auto& problem = *environment.problemPtr;
+  problem.preComputationPtr->request(Request::Cost + Request::SoftConstraint, observation.time, observation.state, observation.input);
+  rewards_(index) = -dt * computeCost(problem, observation.time, observation.state, observation.input);
+
+  // simulation
+  environment.controller.timeStamp_ = {observation.time, observation.time + dt};
+  environment.controller.uffArray_ = {observation.input, observation.input};
+  environment.modeSchedule = environment.mrtPtr->getPolicy().modeSchedule_;
+  bool failed = false;
+  try {
+    observation.state = environment.simulatorPtr->run(observation.time, observation.state, observation.time + dt, &environment.controller,
+                                                      environment.modeSchedule, environment.timeTrajectory,
+                                                      environment.postEventIndices, environment.stateTrajectory,
+                                                      environment.inputTrajectory);
+  } catch (const std::exception&) {
+    failed = true;
+  }
+  observation.time += dt;
+  environment.stepCount++;
+
+  failed = failed || !observation.state.allFinite() || !std::isfinite(rewards_(index));
+  if (failed || observation.time >= environment.episodeEndTime - 0.5 * dt) {
+    dones_(index) = true;
+    times_(index) = observation.time;
+    states_.row(index) = observation.state.transpose();
+    return;
+  }
+
+  // the MPC is updated at the simulated MPC rate, an asynchronous update which is still running delays the next one
+  finishMpcUpdate(environment, false);
+  if (environment.stepCount % mpcUpdateRatio_ == 0 && !environment.mpcUpdate.valid()) {
+    startMpcUpdate(environment);
+    finishMpcUpdate(environment, !settings_.asynchronousMpc);
+  }
+
+  updateBuffers(index);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void VectorizedEnvironment::startMpcUpdate(Environment& environment) {
+  environment.mrtPtr->setCurrentObservation(environment.observation);
+  if (mpcThreadPoolPtr_ != nullptr) {
+    auto* mrtPtr = environment.mrtPtr.get();
+    environment.mpcUpdate = mpcThreadPoolPtr_->run([mrtPtr](int) { mrtPtr->advanceMpc(); });
+  } else {
+    environment.mrtPtr->advanceMpc();
+    environment.mrtPtr->updatePolicy();
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void VectorizedEnvironment::finishMpcUpdate(Environment& environment, bool wait) {
+  if (!environment.mpcUpdate.valid()) {
+    return;
+  }
+  if (!wait && environment.mpcUpdate.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+    return;
+  }
+  environment.mpcUpdate.get();
+  environment.mrtPtr->updatePolicy();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void VectorizedEnvironment::updateBuffers(size_t index) {
+  auto& environment = environments_[index];
+  auto& observation = environment.observation;
+  environment.mrtPtr->evaluatePolicy(observation.time, observation.state, environment.plannedState, environment.mpcInput,
+                                     observation.mode);
+
+  times_(index) = observation.time;
+  states_.row(index) = observation.state.transpose();
+  mpcInputs_.row(index) = environment.mpcInput.transpose();
+}
+
+}  // namespace ocs2
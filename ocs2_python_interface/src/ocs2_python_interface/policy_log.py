@@ -0,0 +1,173 @@
+"""
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Reader of the policy logs written by ocs2::policy_log::PolicyLogger (see ocs2_mpc/PolicyLog.h). It only depends on numpy, hence the
+logs can be analyzed without ROS or the OCS2 libraries, e.g.
+
+    from ocs2_python_interface.policy_log import PolicyLogReader
+    for record in PolicyLogReader('policy.log'):
+        print(record['policy_index'], record['performance_indices']['merit'])
+"""
+
+import mmap
+import struct
+
+import numpy as np
+
+MAGIC = 0x4c50434f  # "OCPL"
+VERSION = 1
+HEADER_SIZE = 64
+RECORD_HEADER_SIZE = 16
+
+CONTROLLER_NONE = 0
+CONTROLLER_FEEDFORWARD = 1
+CONTROLLER_LINEAR = 2
+
+
+class _Reader(object):
+    """Reads the values serialized by the policy logger in the native byte order."""
+
+    def __init__(self, data):
+        self._data = data
+        self._offset = 0
+
+    def _unpack(self, fmt):
+        values = struct.unpack_from(fmt, self._data, self._offset)
+        self._offset += struct.calcsize(fmt)
+        return values[0]
+
+    def uint8(self):
+        return self._unpack('=B')
+
+    def uint64(self):
+        return self._unpack('=Q')
+
+    def int64(self):
+        return self._unpack('=q')
+
+    def scalar(self):
+        return self._unpack('=d')
+
+    def scalar_array(self):
+        size = self.uint64()
+        array = np.frombuffer(self._data, dtype=np.float64, count=size, offset=self._offset).copy()
+        self._offset += 8 * size
+        return array
+
+    def size_array(self):
+        size = self.uint64()
+        array = np.frombuffer(self._data, dtype=np.uint64, count=size, offset=self._offset).copy()
+        self._offset += 8 * size
+        return array
+
+    def matrix(self):
+        rows = self.uint64()
+        cols = self.uint64()
+        array = np.frombuffer(self._data, dtype=np.float64, count=rows * cols, offset=self._offset)
+        self._offset += 8 * rows * cols
+        return array.reshape((rows, cols), order='F').copy()
+
+    def vector_list(self):
+        return [self.scalar_array() for _ in range(self.uint64())]
+
+    def matrix_list(self):
+        return [self.matrix() for _ in range(self.uint64())]
+
+
+def _read_record(data):
+    reader = _Reader(data)
+    record = {'policy_index': reader.uint64(), 'wall_time': reader.int64()}
+
+    record['performance_indices'] = {
+        'merit': reader.scalar(),
+        'cost': reader.scalar(),
+        'dynamics_violation_sse': reader.scalar(),
+        'equality_constraints_sse': reader.scalar(),
+        'equality_lagrangian': reader.scalar(),
+        'inequality_lagrangian': reader.scalar(),
+        'deadline_reached': reader.uint8() != 0,
+    }
+
+    observation = {'mode': reader.uint64(), 'time': reader.scalar(), 'state': reader.scalar_array(), 'input': reader.scalar_array()}
+    target_trajectories = {'time': reader.scalar_array(), 'state': reader.vector_list(), 'input': reader.vector_list()}
+    mpc_timing = {'synchronized_modules_time': reader.scalar(), 'run_time': reader.scalar(), 'processing_time': reader.scalar()}
+    record['command'] = {'init_observation': observation, 'target_trajectories': target_trajectories, 'mpc_timing': mpc_timing}
+
+    primal_solution = {
+        'time': reader.scalar_array(),
+        'state': reader.vector_list(),
+        'input': reader.vector_list(),
+        'post_event_indices': reader.size_array(),
+        'event_times': reader.scalar_array(),
+        'mode_sequence': reader.size_array(),
+    }
+    controller_type = reader.uint8()
+    if controller_type == CONTROLLER_FEEDFORWARD:
+        primal_solution['controller'] = {'type': 'feedforward', 'time': reader.scalar_array(), 'feedforward': reader.vector_list()}
+    elif controller_type == CONTROLLER_LINEAR:
+        primal_solution['controller'] = {'type': 'linear', 'time': reader.scalar_array(), 'bias': reader.vector_list(),
+                                         'gain': reader.matrix_list()}
+    elif controller_type == CONTROLLER_NONE:
+        primal_solution['controller'] = None
+    else:
+        raise ValueError('Unknown controller type {}!'.format(controller_type))
+    record['primal_solution'] = primal_solution
+
+    return record
+
+
+class PolicyLogReader(object):
+    """Reads the complete records of a policy log in the order of logging. Each record is decoded into a dictionary."""
+
+    def __init__(self, file_name):
+        with open(file_name, 'rb') as log_file:
+            self._data = mmap.mmap(log_file.fileno(), 0, access=mmap.ACCESS_READ)
+
+        magic, version, record_capacity, num_records, record_stride = struct.unpack_from('=IIQQQ', self._data, 0)
+        if magic != MAGIC or version != VERSION or len(self._data) < HEADER_SIZE + num_records * record_stride:
+            raise ValueError('{} is not a policy log of version {}!'.format(file_name, VERSION))
+
+        # index the complete records, i.e. with an even and positive sequence number
+        self._records = []
+        for i in range(num_records):
+            offset = HEADER_SIZE + i * record_stride
+            sequence, size = struct.unpack_from('=QQ', self._data, offset)
+            if sequence > 0 and sequence % 2 == 0 and size <= record_capacity:
+                self._records.append((sequence, offset + RECORD_HEADER_SIZE, size))
+        self._records.sort()
+
+    def __len__(self):
+        return len(self._records)
+
+    def __getitem__(self, index):
+        _, offset, size = self._records[index]
+        return _read_record(self._data[offset:offset + size])
+
+    def __iter__(self):
+        for index in range(len(self)):
+            yield self[index]
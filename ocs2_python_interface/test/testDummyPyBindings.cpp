@@ -1,6 +1,11 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <thread>
+
 #include <ocs2_core/Types.h>
 #include <ocs2_core/cost/QuadraticStateCost.h>
 #include <ocs2_core/cost/QuadraticStateInputCost.h>
@@ -9,7 +14,9 @@
 #include <ocs2_ddp/GaussNewtonDDP_MPC.h>
 #include <ocs2_oc/rollout/TimeTriggeredRollout.h>
 
+#include <ocs2_python_interface/MpcPool.h>
 #include <ocs2_python_interface/PythonInterface.h>
+#include <ocs2_python_interface/VectorizedEnvironment.h>
 #include <ocs2_robotic_tools/common/RobotInterface.h>
 
 namespace ocs2 {
@@ -46,6 +53,7 @@ class DummyInterface final : public RobotInterface {
 
   const OptimalControlProblem& getOptimalControlProblem() const override { return problem_; }
   const Initializer& getInitializer() const override { return *initializerPtr_; }
+  const RolloutBase& getRollout() const { return *rolloutPtr_; }
 
  private:
   OptimalControlProblem problem_;
@@ -58,10 +66,30 @@ class DummyPyBindings final : public PythonInterface {
  public:
   using Base = PythonInterface;
 
-  DummyPyBindings() {
+  explicit DummyPyBindings(std::shared_ptr<ThreadPool> threadPoolPtr = nullptr) {
     DummyInterface robot;
-    PythonInterface::init(robot, robot.getMpc());
+    PythonInterface::init(robot, robot.getMpc(), std::move(threadPoolPtr));
+  }
+};
+
+class DummyMpcPool final : public MpcPool {
+ public:
+  explicit DummyMpcPool(size_t numInstances) {
+    MpcPool::init(numInstances, [this]() { return robot_.getMpc(); });
+  }
+
+ private:
+  DummyInterface robot_;
+};
+
+class DummyVectorizedEnvironment final : public VectorizedEnvironment {
+ public:
+  DummyVectorizedEnvironment(size_t numEnvironments, vectorized_environment::Settings settings) {
+    VectorizedEnvironment::init(numEnvironments, 2, 1, std::move(settings), [this]() { return robot_.getMpc(); }, robot_.getRollout());
   }
+
+ private:
+  DummyInterface robot_;
 };
 
 }  // namespace pybindings_test
@@ -70,3 +98,221 @@ class DummyPyBindings final : public PythonInterface {
 TEST(OCS2PyBindingsTest, createDummyPyBindings) {
   ocs2::pybindings_test::DummyPyBindings dummy;
 }
+
+TEST(OCS2PyBindingsTest, batchedEvaluation) {
+  using namespace ocs2;
+  pybindings_test::DummyPyBindings dummy;
+  dummy.reset(TargetTrajectories({0.0}, {vector_t::Zero(2)}, {vector_t::Zero(1)}));
+  dummy.setObservation(0.0, vector_t::Ones(2), vector_t::Zero(1));
+  dummy.advanceMpc();
+
+  scalar_array_t t;
+  vector_array_t x, u;
+  dummy.getMpcSolution(t, x, u);
+  const auto solution = dummy.getMpcSolutionArrays();
+  const auto& tArray = std::get<0>(solution);
+  const auto& xArray = std::get<1>(solution);
+  const auto& uArray = std::get<2>(solution);
+  ASSERT_EQ(tArray.size(), t.size());
+  ASSERT_EQ(xArray.rows(), x.size());
+  ASSERT_EQ(uArray.rows(), u.size());
+
+  // copy into a larger preallocated array
+  vector_t tCopy = vector_t::Zero(t.size() + 1);
+  row_matrix_t xCopy = row_matrix_t::Zero(x.size() + 1, 2);
+  row_matrix_t uCopy = row_matrix_t::Zero(u.size() + 1, 1);
+  ASSERT_EQ(dummy.copyMpcSolution(tCopy, xCopy, uCopy), t.size());
+  ASSERT_ANY_THROW(dummy.copyMpcSolution(tCopy.head(1), xCopy.topRows(1), uCopy.topRows(1)));
+
+  for (size_t i = 0; i < t.size(); i++) {
+    EXPECT_DOUBLE_EQ(tArray(i), t[i]);
+    EXPECT_TRUE(xArray.row(i).transpose().isApprox(x[i]));
+    EXPECT_TRUE(uArray.row(i).transpose().isApprox(u[i]));
+    EXPECT_TRUE(xCopy.row(i).isApprox(xArray.row(i)));
+    EXPECT_TRUE(uCopy.row(i).isApprox(uArray.row(i)));
+  }
+
+  const auto dxdt = dummy.flowMapBatch(tArray, xArray, uArray);
+  const auto cost = dummy.costQuadraticApproximationBatch(tArray, xArray, uArray);
+  for (size_t i = 0; i < t.size(); i++) {
+    EXPECT_TRUE(dxdt.row(i).transpose().isApprox(dummy.flowMap(t[i], x[i], u[i])));
+    const auto expectedCost = dummy.costQuadraticApproximation(t[i], x[i], u[i]);
+    EXPECT_DOUBLE_EQ(cost.f(i), expectedCost.f);
+    EXPECT_TRUE(cost.dfdx.row(i).transpose().isApprox(expectedCost.dfdx));
+    EXPECT_TRUE(cost.dfdu.row(i).transpose().isApprox(expectedCost.dfdu));
+    EXPECT_TRUE(Eigen::Map<const row_matrix_t>(cost.dfdxx.row(i).data(), 2, 2).isApprox(expectedCost.dfdxx));
+    EXPECT_TRUE(Eigen::Map<const row_matrix_t>(cost.dfduu.row(i).data(), 1, 1).isApprox(expectedCost.dfduu));
+  }
+  ASSERT_ANY_THROW(dummy.flowMapBatch(tArray, xArray.topRows(1), uArray));
+}
+
+TEST(OCS2PyBindingsTest, parallelBatchedEvaluation) {
+  using namespace ocs2;
+  pybindings_test::DummyPyBindings dummy(std::make_shared<ThreadPool>(3));
+  dummy.reset(TargetTrajectories({0.0}, {vector_t::Zero(2)}, {vector_t::Zero(1)}));
+  dummy.setObservation(0.0, vector_t::Ones(2), vector_t::Zero(1));
+  dummy.advanceMpc();
+
+  scalar_array_t t;
+  vector_array_t x, u;
+  dummy.getMpcSolution(t, x, u);
+  const auto solution = dummy.getMpcSolutionArrays();
+  const auto& tArray = std::get<0>(solution);
+  const auto& xArray = std::get<1>(solution);
+  const auto& uArray = std::get<2>(solution);
+
+  // the batches evaluated on the thread pool match the evaluation of the single nodes
+  const auto dxdt = dummy.flowMapBatch(tArray, xArray, uArray);
+  const auto flowMapApprox = dummy.flowMapLinearApproximationBatch(tArray, xArray, uArray);
+  const auto cost = dummy.costQuadraticApproximationBatch(tArray, xArray, uArray);
+  for (size_t i = 0; i < t.size(); i++) {
+    EXPECT_TRUE(dxdt.row(i).transpose().isApprox(dummy.flowMap(t[i], x[i], u[i])));
+    const auto expectedFlowMapApprox = dummy.flowMapLinearApproximation(t[i], x[i], u[i]);
+    EXPECT_TRUE(flowMapApprox.f.row(i).transpose().isApprox(expectedFlowMapApprox.f));
+    EXPECT_TRUE(Eigen::Map<const row_matrix_t>(flowMapApprox.dfdx.row(i).data(), 2, 2).isApprox(expectedFlowMapApprox.dfdx));
+    EXPECT_TRUE(Eigen::Map<const row_matrix_t>(flowMapApprox.dfdu.row(i).data(), 2, 1).isApprox(expectedFlowMapApprox.dfdu));
+    const auto expectedCost = dummy.costQuadraticApproximation(t[i], x[i], u[i]);
+    EXPECT_DOUBLE_EQ(cost.f(i), expectedCost.f);
+    EXPECT_TRUE(cost.dfdx.row(i).transpose().isApprox(expectedCost.dfdx));
+    EXPECT_TRUE(cost.dfdu.row(i).transpose().isApprox(expectedCost.dfdu));
+  }
+  ASSERT_ANY_THROW(dummy.flowMapBatch(tArray, xArray.topRows(1), uArray));
+}
+
+TEST(OCS2PyBindingsTest, concurrentCalls) {
+  using namespace ocs2;
+  pybindings_test::DummyPyBindings dummy(std::make_shared<ThreadPool>(2));
+  dummy.reset(TargetTrajectories({0.0}, {vector_t::Zero(2)}, {vector_t::Zero(1)}));
+  dummy.setObservation(0.0, vector_t::Ones(2), vector_t::Zero(1));
+
+  constexpr int numNodes = 100;
+  const vector_t t = vector_t::LinSpaced(numNodes, 0.0, 1.0);
+  const row_matrix_t x = row_matrix_t::Random(numNodes, 2);
+  const row_matrix_t u = row_matrix_t::Random(numNodes, 1);
+  const row_matrix_t expected = dummy.flowMapBatch(t, x, u);
+
+  std::vector<std::thread> threads;
+  std::atomic<int> numMismatches{0};
+  threads.emplace_back([&]() { dummy.advanceMpc(); });
+  for (int k = 0; k < 3; k++) {
+    threads.emplace_back([&]() {
+      for (int j = 0; j < 10; j++) {
+        if (!dummy.flowMapBatch(t, x, u).isApprox(expected)) {
+          ++numMismatches;
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(numMismatches, 0);
+}
+
+TEST(OCS2PyBindingsTest, mpcPool) {
+  using namespace ocs2;
+  constexpr size_t numJobs = 12;
+  pybindings_test::DummyMpcPool pool(3);
+  ASSERT_EQ(pool.getNumInstances(), 3);
+
+  const vector_t initTimes = vector_t::Zero(numJobs);
+  row_matrix_t initStates(numJobs, 2);
+  for (size_t i = 0; i < numJobs; i++) {
+    initStates.row(i) << 1.0, static_cast<scalar_t>(i % 3);
+  }
+  const std::vector<TargetTrajectories> targets(numJobs, TargetTrajectories({0.0}, {vector_t::Zero(2)}, {vector_t::Zero(1)}));
+  const auto jobIds = pool.submitBatch(initTimes, initStates, targets);
+  ASSERT_EQ(jobIds.size(), numJobs);
+
+  std::vector<MpcJobResult> results;
+  while (results.size() < numJobs) {
+    auto newResults = pool.collect(1);
+    ASSERT_FALSE(newResults.empty());
+    std::move(newResults.begin(), newResults.end(), std::back_inserter(results));
+  }
+  EXPECT_EQ(pool.getNumPending(), 0);
+  EXPECT_TRUE(pool.collect().empty());
+
+  // jobs with the same initial state have the same solution, independent of the instance they ran on
+  std::sort(results.begin(), results.end(), [](const MpcJobResult& lhs, const MpcJobResult& rhs) { return lhs.jobId < rhs.jobId; });
+  for (size_t i = 0; i < numJobs; i++) {
+    EXPECT_EQ(results[i].jobId, jobIds[i]);
+    EXPECT_TRUE(results[i].success) << results[i].errorMessage;
+    ASSERT_GT(results[i].t.size(), 0);
+    EXPECT_TRUE(results[i].x.row(0).isApprox(initStates.row(i)));
+    EXPECT_TRUE(results[i].x.isApprox(results[i % 3].x));
+    EXPECT_TRUE(results[i].u.isApprox(results[i % 3].u));
+  }
+}
+
+TEST(OCS2PyBindingsTest, vectorizedEnvironment) {
+  using namespace ocs2;
+  constexpr size_t numEnvironments = 4;
+  vectorized_environment::Settings settings;
+  settings.controlTimeStep = 0.01;
+  settings.mpcTimeStep = 0.05;
+  settings.asynchronousMpc = false;
+  settings.episodeDuration = 0.5;
+  settings.numThreads = 2;
+  pybindings_test::DummyVectorizedEnvironment environment(numEnvironments, settings);
+  ASSERT_EQ(environment.getNumEnvironments(), numEnvironments);
+  EXPECT_TRUE(environment.getDones().all());
+
+  const vector_t initTimes = vector_t::Zero(numEnvironments);
+  row_matrix_t initStates(numEnvironments, 2);
+  for (size_t i = 0; i < numEnvironments; i++) {
+    initStates.row(i) << 1.0, static_cast<scalar_t>(i % 2);
+  }
+  const std::vector<TargetTrajectories> targets(numEnvironments, TargetTrajectories({0.0}, {vector_t::Zero(2)}, {vector_t::Zero(1)}));
+  environment.reset(initTimes, initStates, targets);
+  EXPECT_FALSE(environment.getDones().any());
+  EXPECT_TRUE(environment.getStates().isApprox(initStates));
+
+  // the last environment gets a residual which pushes it away from the target
+  row_matrix_t actions = row_matrix_t::Zero(numEnvironments, 1);
+  actions(numEnvironments - 1, 0) = 10.0;
+  ASSERT_ANY_THROW(environment.step(actions.topRows(1)));
+
+  vector_t returns = vector_t::Zero(numEnvironments);
+  size_t numSteps = 0;
+  while (!environment.getDones().all()) {
+    environment.step(actions);
+    returns += environment.getRewards();
+    numSteps++;
+  }
+  EXPECT_EQ(numSteps, 50);
+  EXPECT_NEAR(environment.getTimes().maxCoeff(), settings.episodeDuration, 1e-9);
+  EXPECT_TRUE((returns.array() < 0.0).all());
+
+  // the MPC stabilizes the state, the synchronous environments with the same initial state are identical
+  EXPECT_LT(environment.getStates().row(0).norm(), initStates.row(0).norm());
+  EXPECT_TRUE(environment.getStates().row(0).isApprox(environment.getStates().row(2)));
+  EXPECT_NEAR(returns(0), returns(2), 1e-9);
+  EXPECT_LT(returns(numEnvironments - 1), returns(1));
+
+  // a done environment is reset individually
+  environment.resetEnvironment(1, 0.0, initStates.row(1).transpose(), targets[1]);
+  EXPECT_FALSE(environment.getDones()(1));
+  EXPECT_TRUE(environment.getDones()(0));
+}
+
+TEST(OCS2PyBindingsTest, vectorizedEnvironmentAsynchronous) {
+  using namespace ocs2;
+  constexpr size_t numEnvironments = 3;
+  vectorized_environment::Settings settings;
+  settings.asynchronousMpc = true;
+  settings.numMpcThreads = 2;
+  settings.episodeDuration = 0.2;
+  pybindings_test::DummyVectorizedEnvironment environment(numEnvironments, settings);
+
+  const row_matrix_t initStates = row_matrix_t::Ones(numEnvironments, 2);
+  const std::vector<TargetTrajectories> targets(numEnvironments, TargetTrajectories({0.0}, {vector_t::Zero(2)}, {vector_t::Zero(1)}));
+  environment.reset(vector_t::Zero(numEnvironments), initStates, targets);
+
+  const row_matrix_t actions = row_matrix_t::Zero(numEnvironments, 1);
+  while (!environment.getDones().all()) {
+    environment.step(actions);
+  }
+  EXPECT_TRUE(environment.getStates().allFinite());
+  EXPECT_LT(environment.getStates().row(0).norm(), initStates.row(0).norm());
+}
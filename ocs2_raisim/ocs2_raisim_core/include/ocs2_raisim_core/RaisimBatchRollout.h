@@ -0,0 +1,54 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#pragma once
+
+#include <memory>
+
+#include <ocs2_core/thread_support/ThreadPool.h>
+#include <ocs2_oc/rollout/BatchRollout.h>
+
+#include "ocs2_raisim_core/RaisimRollout.h"
+
+namespace ocs2 {
+
+/**
+ * Creates a batch rollout with one independent Raisim world per worker, e.g. for evaluating many policies in parallel.
+ * The worlds are headless copies of the given rollout. The terrain of the given rollout is only read and copied into each world,
+ * since Raisim objects can not be shared between worlds. Each rollout of a batch sets its initial state to the simulator.
+ *
+ * @param [in] rollout: The Raisim rollout including its terrain.
+ * @param [in] threadPool: The thread pool. It should outlive the batch rollout.
+ * @param [in] maxNumThreads: The maximum number of threads working on a batch, including the calling thread. Zero means
+ *                            threadPool.numThreads() + 1.
+ * @return The batch rollout.
+ */
+std::unique_ptr<BatchRollout> createRaisimBatchRollout(const RaisimRollout& rollout, ThreadPool& threadPool, size_t maxNumThreads = 0);
+
+}  // namespace ocs2
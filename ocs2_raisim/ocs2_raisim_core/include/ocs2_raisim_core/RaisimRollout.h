@@ -81,6 +81,12 @@ class RaisimRollout final : public RolloutBase {
   //! Copy constructor
   RaisimRollout(const RaisimRollout& other);
 
+  /**
+   * Copy constructor with different Raisim rollout settings, e.g. to create headless copies of a rollout.
+   * @note The terrain of other is copied into the world of the new rollout.
+   */
+  RaisimRollout(const RaisimRollout& other, RaisimRolloutSettings raisimRolloutSettings);
+
   void resetRollout() override { raisimRolloutSettings_.setSimulatorStateOnRolloutRunOnce_ = true; }
 
   RaisimRollout* clone() const override { return new RaisimRollout(*this); }
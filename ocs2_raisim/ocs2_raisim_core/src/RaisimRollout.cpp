@@ -84,9 +84,14 @@ RaisimRollout::RaisimRollout(std::string urdfFile, std::string resourcePath,
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-RaisimRollout::RaisimRollout(const RaisimRollout& other)
+RaisimRollout::RaisimRollout(const RaisimRollout& other) : RaisimRollout(other, other.raisimRolloutSettings_) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+RaisimRollout::RaisimRollout(const RaisimRollout& other, RaisimRolloutSettings raisimRolloutSettings)
     : RaisimRollout(other.urdfFile_, other.resourcePath_, other.stateToRaisimGenCoordGenVel_, other.raisimGenCoordGenVelToState_,
-                    other.inputToRaisimGeneralizedForce_, other.dataExtractionCallback_, other.raisimRolloutSettings_,
+                    other.inputToRaisimGeneralizedForce_, other.dataExtractionCallback_, std::move(raisimRolloutSettings),
                     other.inputToRaisimPdTargets_) {
   if (other.heightMap_ != nullptr) {
     deleteGroundPlane();
@@ -27,6 +27,7 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
+#include "ocs2_raisim_core/RaisimBatchRollout.h"
 #include "ocs2_raisim_core/RaisimRollout.h"
 #include "ocs2_raisim_core/RaisimRolloutSettings.h"
 
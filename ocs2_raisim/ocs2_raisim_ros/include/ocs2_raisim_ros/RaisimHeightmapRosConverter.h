@@ -27,6 +27,9 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  ******************************************************************************/
 
+#include <mutex>
+#include <vector>
+
 #include <grid_map_msgs/GridMap.h>
 #include <ros/node_handle.h>
 #include <ros/publisher.h>
@@ -57,6 +60,15 @@ class RaisimHeightmapRosConverter {
    */
   static grid_map_msgs::GridMapPtr convertHeightmapToGridmap(const raisim::HeightMap& heightMap, const std::string& frameId = "world");
 
+  /**
+   * @brief Converts the Raisim height map to an existing GridMap ROS message. The memory of the message is reused.
+   * @param[in] heightMap: The heightMap object from Raisim
+   * @param[out] gridMap: The GridMap ROS message
+   * @param[in] frameId: The frameId for the GridMap ROS message
+   */
+  static void convertHeightmapToGridmap(const raisim::HeightMap& heightMap, grid_map_msgs::GridMap& gridMap,
+                                        const std::string& frameId = "world");
+
   /**
    * @brief Converts a GridMap ROS message to a Raisim height map
    * @param[in] gridMap: The GridMap ROS message
@@ -64,6 +76,27 @@ class RaisimHeightmapRosConverter {
    */
   static std::unique_ptr<raisim::HeightMap> convertGridmapToHeightmap(const grid_map_msgs::GridMapConstPtr& gridMap);
 
+  /**
+   * @brief Updates an existing Raisim height map in place from a GridMap ROS message, e.g., for live terrain updates in simulation.
+   * The height map is only updated if its geometry or any of its samples has changed.
+   * @note The number of samples of the GridMap ROS message and of the height map must be identical
+   * @param[in] gridMap: The GridMap ROS message
+   * @param[in, out] heightMap: The heightMap object from Raisim
+   * @return Whether the height map has been changed
+   */
+  static bool updateHeightmapFromGridmap(const grid_map_msgs::GridMap& gridMap, raisim::HeightMap& heightMap);
+
+  /**
+   * @brief Updates an existing Raisim height map in place from a GridMap ROS message, see above. The samples are converted in the given
+   * buffer, whose memory is reused across updates.
+   * @param[in] gridMap: The GridMap ROS message
+   * @param[in, out] heightMap: The heightMap object from Raisim
+   * @param[in, out] heightBuffer: The buffer for the converted samples
+   * @return Whether the height map has been changed
+   */
+  static bool updateHeightmapFromGridmap(const grid_map_msgs::GridMap& gridMap, raisim::HeightMap& heightMap,
+                                         std::vector<double>& heightBuffer);
+
   /**
    * @brief Publishes the Raisim height map through a ROS publisher. It internally calls convertHeightmapToGridmap
    * @note The publisher is latched, hence the timing of publishing is not dependent on the subscriber's state
@@ -80,9 +113,30 @@ class RaisimHeightmapRosConverter {
    */
   static std::pair<std::unique_ptr<raisim::HeightMap>, grid_map_msgs::GridMapConstPtr> getHeightmapFromRos(double timeout = 5.0);
 
+  /**
+   * @brief Subscribes to the height map updates on ROS. The subscriber only keeps the latest message, which is shared without a copy if
+   * it is published from the same process, e.g., by publishGridmap. The message is applied by updateHeightmapFromRos.
+   */
+  void subscribeGridmap();
+
+  /**
+   * @brief Applies the latest GridMap message received by the subscriber to an existing Raisim height map in place. To be called from
+   * the thread of the simulation in between the rollouts.
+   * @param[in, out] heightMap: The heightMap object from Raisim
+   * @return Whether the height map has been changed
+   */
+  bool updateHeightmapFromRos(raisim::HeightMap& heightMap);
+
  private:
+  void gridmapCallback(const grid_map_msgs::GridMapConstPtr& gridMap);
+
   ros::NodeHandle nodeHandle_;
   std::unique_ptr<ros::Publisher> gridmapPublisher_;
+  std::unique_ptr<ros::Subscriber> gridmapSubscriber_;
+
+  std::mutex latestGridmapMutex_;
+  grid_map_msgs::GridMapConstPtr latestGridmap_;
+  std::vector<double> heightBuffer_;
 };
 
 }  // namespace ocs2
@@ -27,6 +27,8 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  ******************************************************************************/
 
+#include <algorithm>
+
 #include <ros/topic.h>
 
 #include "ocs2_raisim_ros/RaisimHeightmapRosConverter.h"
@@ -36,26 +38,33 @@ namespace ocs2 {
 grid_map_msgs::GridMapPtr RaisimHeightmapRosConverter::convertHeightmapToGridmap(const raisim::HeightMap& heightMap,
                                                                                  const std::string& frameId) {
   grid_map_msgs::GridMapPtr gridMapMsg(new grid_map_msgs::GridMap());
+  convertHeightmapToGridmap(heightMap, *gridMapMsg, frameId);
+  return gridMapMsg;
+}
 
-  gridMapMsg->info.header.frame_id = frameId;
-  gridMapMsg->info.header.stamp = ros::Time::now();
+void RaisimHeightmapRosConverter::convertHeightmapToGridmap(const raisim::HeightMap& heightMap, grid_map_msgs::GridMap& gridMap,
+                                                            const std::string& frameId) {
+  gridMap.info.header.frame_id = frameId;
+  gridMap.info.header.stamp = ros::Time::now();
 
   const auto xResolution = heightMap.getXSize() / static_cast<double>(heightMap.getXSamples());
   const auto yResolution = heightMap.getYSize() / static_cast<double>(heightMap.getYSamples());
   if (std::abs(xResolution - yResolution) > 1e-9) {
     throw std::runtime_error("RaisimHeightmapRosConverter::convertHeightmapToGridmap - Resolution in x and y must be identical");
   }
-  gridMapMsg->info.resolution = xResolution;
+  gridMap.info.resolution = xResolution;
 
-  gridMapMsg->info.length_x = heightMap.getXSize();
-  gridMapMsg->info.length_y = heightMap.getYSize();
+  gridMap.info.length_x = heightMap.getXSize();
+  gridMap.info.length_y = heightMap.getYSize();
 
-  gridMapMsg->info.pose.position.x = heightMap.getCenterX();
-  gridMapMsg->info.pose.position.y = heightMap.getCenterY();
-  gridMapMsg->info.pose.orientation.w = 1.0;
+  gridMap.info.pose.position.x = heightMap.getCenterX();
+  gridMap.info.pose.position.y = heightMap.getCenterY();
+  gridMap.info.pose.orientation.w = 1.0;
 
-  gridMapMsg->layers.emplace_back("elevation");
-  std_msgs::Float32MultiArray dataArray;
+  gridMap.layers.resize(1);
+  gridMap.layers[0] = "elevation";
+  gridMap.data.resize(1);
+  auto& dataArray = gridMap.data[0];
   dataArray.layout.dim.resize(2);
   dataArray.layout.dim[0].label = "column_index";
   dataArray.layout.dim[0].stride = heightMap.getHeightVector().size();
@@ -63,10 +72,7 @@ grid_map_msgs::GridMapPtr RaisimHeightmapRosConverter::convertHeightmapToGridmap
   dataArray.layout.dim[1].label = "row_index";
   dataArray.layout.dim[1].stride = heightMap.getYSamples();
   dataArray.layout.dim[1].size = heightMap.getYSamples();
-  dataArray.data.insert(dataArray.data.begin(), heightMap.getHeightVector().rbegin(), heightMap.getHeightVector().rend());
-  gridMapMsg->data.push_back(dataArray);
-
-  return gridMapMsg;
+  dataArray.data.assign(heightMap.getHeightVector().rbegin(), heightMap.getHeightVector().rend());
 }
 
 std::unique_ptr<raisim::HeightMap> RaisimHeightmapRosConverter::convertGridmapToHeightmap(const grid_map_msgs::GridMapConstPtr& gridMap) {
@@ -87,6 +93,43 @@ std::unique_ptr<raisim::HeightMap> RaisimHeightmapRosConverter::convertGridmapTo
   return heightMap;
 }
 
+bool RaisimHeightmapRosConverter::updateHeightmapFromGridmap(const grid_map_msgs::GridMap& gridMap, raisim::HeightMap& heightMap) {
+  std::vector<double> heightBuffer;
+  return updateHeightmapFromGridmap(gridMap, heightMap, heightBuffer);
+}
+
+bool RaisimHeightmapRosConverter::updateHeightmapFromGridmap(const grid_map_msgs::GridMap& gridMap, raisim::HeightMap& heightMap,
+                                                             std::vector<double>& heightBuffer) {
+  if (gridMap.data.empty() or gridMap.data[0].layout.dim.size() < 2) {
+    throw std::runtime_error("RaisimHeightmapRosConverter::updateHeightmapFromGridmap - gridMap has no data layer with a 2D layout");
+  }
+  const auto& dataArray = gridMap.data[0];
+  if (dataArray.layout.dim[0].label != "column_index" or dataArray.layout.dim[1].label != "row_index") {
+    throw std::runtime_error("RaisimHeightmapRosConverter::updateHeightmapFromGridmap - Layout of gridMap currently not supported");
+  }
+  if (dataArray.layout.dim[0].size != heightMap.getXSamples() or dataArray.layout.dim[1].size != heightMap.getYSamples() or
+      dataArray.data.size() != heightMap.getHeightVector().size()) {
+    throw std::runtime_error("RaisimHeightmapRosConverter::updateHeightmapFromGridmap - Number of samples of gridMap and heightMap differ");
+  }
+
+  const double xSize = gridMap.info.length_x;
+  const double ySize = gridMap.info.length_y;
+  const double centerX = gridMap.info.pose.position.x;
+  const double centerY = gridMap.info.pose.position.y;
+  const bool geometryChanged = xSize != heightMap.getXSize() or ySize != heightMap.getYSize() or centerX != heightMap.getCenterX() or
+                               centerY != heightMap.getCenterY();
+
+  // the float samples of the gridMap are exactly representable as double, hence they are compared as double
+  const auto isEqual = [](float gridMapHeight, double height) { return static_cast<double>(gridMapHeight) == height; };
+  if (!geometryChanged and std::equal(dataArray.data.rbegin(), dataArray.data.rend(), heightMap.getHeightVector().begin(), isEqual)) {
+    return false;
+  }
+
+  heightBuffer.assign(dataArray.data.rbegin(), dataArray.data.rend());
+  heightMap.update(centerX, centerY, xSize, ySize, heightBuffer);
+  return true;
+}
+
 void RaisimHeightmapRosConverter::publishGridmap(const raisim::HeightMap& heightMap, const std::string& frameId) {
   if (!gridmapPublisher_) {
     gridmapPublisher_.reset(new ros::Publisher(nodeHandle_.advertise<grid_map_msgs::GridMap>("/raisim_heightmap", 1, true)));
@@ -101,4 +144,25 @@ std::pair<std::unique_ptr<raisim::HeightMap>, grid_map_msgs::GridMapConstPtr> Ra
   return {gridMapMsg ? convertGridmapToHeightmap(gridMapMsg) : nullptr, gridMapMsg};
 }
 
+void RaisimHeightmapRosConverter::subscribeGridmap() {
+  if (!gridmapSubscriber_) {
+    gridmapSubscriber_.reset(
+        new ros::Subscriber(nodeHandle_.subscribe("/raisim_heightmap", 1, &RaisimHeightmapRosConverter::gridmapCallback, this)));
+  }
+}
+
+void RaisimHeightmapRosConverter::gridmapCallback(const grid_map_msgs::GridMapConstPtr& gridMap) {
+  std::lock_guard<std::mutex> lock(latestGridmapMutex_);
+  latestGridmap_ = gridMap;
+}
+
+bool RaisimHeightmapRosConverter::updateHeightmapFromRos(raisim::HeightMap& heightMap) {
+  grid_map_msgs::GridMapConstPtr gridMap;
+  {
+    std::lock_guard<std::mutex> lock(latestGridmapMutex_);
+    gridMap.swap(latestGridmap_);
+  }
+  return gridMap and updateHeightmapFromGridmap(*gridMap, heightMap, heightBuffer_);
+}
+
 }  // namespace ocs2
@@ -54,6 +54,44 @@ TEST(ocs2_raisim_ros, HeightmapRosConversion) {
   ASSERT_TRUE(gridMap1->data[0].data == gridMap2->data[0].data);
 }
 
+TEST(ocs2_raisim_ros, HeightmapInPlaceUpdate) {
+  raisim::TerrainProperties terrainProperties;
+  const raisim::HeightMap heightMap1(0.2, -2.1, terrainProperties);
+  terrainProperties.seed += 1;
+  raisim::HeightMap heightMap2(0.0, 0.0, terrainProperties);
+
+  const auto gridMap1 = ocs2::RaisimHeightmapRosConverter::convertHeightmapToGridmap(heightMap1);
+  ASSERT_TRUE(ocs2::RaisimHeightmapRosConverter::updateHeightmapFromGridmap(*gridMap1, heightMap2));
+  ASSERT_FALSE(ocs2::RaisimHeightmapRosConverter::updateHeightmapFromGridmap(*gridMap1, heightMap2));
+
+  ASSERT_DOUBLE_EQ(heightMap1.getCenterX(), heightMap2.getCenterX());
+  ASSERT_DOUBLE_EQ(heightMap1.getCenterY(), heightMap2.getCenterY());
+
+  // the conversion to an existing message gives the same message
+  grid_map_msgs::GridMap gridMap2;
+  ocs2::RaisimHeightmapRosConverter::convertHeightmapToGridmap(heightMap2, gridMap2);
+  ASSERT_TRUE(gridMap1->data[0].data == gridMap2.data[0].data);
+}
+
+TEST(ocs2_raisim_ros, HeightmapInPlaceUpdateWithBuffer) {
+  raisim::TerrainProperties terrainProperties;
+  const raisim::HeightMap heightMap1(0.2, -2.1, terrainProperties);
+  terrainProperties.seed += 1;
+  raisim::HeightMap heightMap2(0.0, 0.0, terrainProperties);
+
+  std::vector<double> heightBuffer;
+  auto gridMap = ocs2::RaisimHeightmapRosConverter::convertHeightmapToGridmap(heightMap1);
+  ASSERT_TRUE(ocs2::RaisimHeightmapRosConverter::updateHeightmapFromGridmap(*gridMap, heightMap2, heightBuffer));
+  ASSERT_FALSE(ocs2::RaisimHeightmapRosConverter::updateHeightmapFromGridmap(*gridMap, heightMap2, heightBuffer));
+  ASSERT_EQ(heightBuffer, heightMap2.getHeightVector());
+
+  // malformed messages are rejected
+  gridMap->data[0].layout.dim.resize(1);
+  ASSERT_THROW(ocs2::RaisimHeightmapRosConverter::updateHeightmapFromGridmap(*gridMap, heightMap2, heightBuffer), std::runtime_error);
+  gridMap->data.clear();
+  ASSERT_THROW(ocs2::RaisimHeightmapRosConverter::updateHeightmapFromGridmap(*gridMap, heightMap2, heightBuffer), std::runtime_error);
+}
+
 int main(int argc, char** argv) {
   // required for ros::Time()
   ros::Time::init();
@@ -58,14 +58,18 @@ class BallbotPyBindings final : public PythonInterface {
     // Robot interface
     BallbotInterface ballbotInterface(taskFile, libraryFolder);
 
+    // Thread pool which is shared by the solver and the batch methods
+    const auto& ddpSettings = ballbotInterface.ddpSettings();
+    auto threadPoolPtr = std::make_shared<ThreadPool>(std::max(ddpSettings.nThreads_, size_t(1)) - 1, ddpSettings.threadPriority_);
+
     // MPC
     std::unique_ptr<GaussNewtonDDP_MPC> mpcPtr(
-        new GaussNewtonDDP_MPC(ballbotInterface.mpcSettings(), ballbotInterface.ddpSettings(), ballbotInterface.getRollout(),
-                               ballbotInterface.getOptimalControlProblem(), ballbotInterface.getInitializer()));
+        new GaussNewtonDDP_MPC(ballbotInterface.mpcSettings(), ddpSettings, ballbotInterface.getRollout(),
+                               ballbotInterface.getOptimalControlProblem(), ballbotInterface.getInitializer(), threadPoolPtr));
     mpcPtr->getSolverPtr()->setReferenceManager(ballbotInterface.getReferenceManagerPtr());
 
     // Python interface
-    PythonInterface::init(ballbotInterface, std::move(mpcPtr));
+    PythonInterface::init(ballbotInterface, std::move(mpcPtr), std::move(threadPoolPtr));
   }
 };
 
@@ -0,0 +1,91 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <algorithm>
+#include <thread>
+
+#include <ros/init.h>
+#include <ros/package.h>
+
+#include <ocs2_ddp/GaussNewtonDDP_MPC.h>
+#include <ocs2_ros_interfaces/mpc/MultiRobotMpcServer.h>
+#include <ocs2_ros_interfaces/synchronized_module/RosReferenceManager.h>
+
+#include <ocs2_ballbot/BallbotInterface.h>
+
+int main(int argc, char** argv) {
+  const std::string robotName = "ballbot";
+
+  // task file and number of robots
+  std::vector<std::string> programArgs{};
+  ::ros::removeROSArgs(argc, argv, programArgs);
+  if (programArgs.size() <= 2) {
+    throw std::runtime_error("No task file or number of robots specified. Aborting.");
+  }
+  std::string taskFileFolderName = std::string(programArgs[1]);
+  const size_t numRobots = std::stoul(programArgs[2]);
+
+  // Initialize ros node
+  ros::init(argc, argv, robotName + "_multi_robot_mpc");
+  ros::NodeHandle nodeHandle;
+
+  // Robot interface, which is shared by all robots
+  const std::string taskFile = ros::package::getPath("ocs2_ballbot") + "/config/" + taskFileFolderName + "/task.info";
+  const std::string libFolder = ros::package::getPath("ocs2_ballbot") + "/auto_generated";
+  ocs2::ballbot::BallbotInterface ballbotInterface(taskFile, libFolder);
+
+  // The robots are addressed by the topic prefixes ballbot_0, ..., ballbot_<numRobots - 1>
+  std::vector<std::string> robotIds;
+  for (size_t i = 0; i < numRobots; i++) {
+    robotIds.push_back(std::to_string(i));
+  }
+
+  auto mpcFactory = [&](size_t robotIndex, const std::string& topicPrefix, ros::NodeHandle& robotNodeHandle,
+                        std::shared_ptr<ocs2::ThreadPool> threadPoolPtr) {
+    // ROS ReferenceManager of the robot
+    std::shared_ptr<ocs2::RosReferenceManager> rosReferenceManagerPtr(
+        new ocs2::RosReferenceManager(topicPrefix, std::make_shared<ocs2::ReferenceManager>()));
+    rosReferenceManagerPtr->subscribe(robotNodeHandle);
+
+    // MPC
+    std::unique_ptr<ocs2::MPC_BASE> mpcPtr(new ocs2::GaussNewtonDDP_MPC(
+        ballbotInterface.mpcSettings(), ballbotInterface.ddpSettings(), ballbotInterface.getRollout(),
+        ballbotInterface.getOptimalControlProblem(), ballbotInterface.getInitializer(), std::move(threadPoolPtr)));
+    mpcPtr->getSolverPtr()->setReferenceManager(rosReferenceManagerPtr);
+    return mpcPtr;
+  };
+
+  // Launch the MPC server
+  const size_t nThreads = std::max(1u, std::thread::hardware_concurrency());
+  ocs2::MultiRobotMpcServer mpcServer(nodeHandle, robotName, robotIds, mpcFactory, nThreads);
+  mpcServer.launchNodes();
+
+  // Successful exit
+  return 0;
+}
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <ocs2_ddp/GaussNewtonDDP_MPC.h>
+#include <ocs2_python_interface/MpcPool.h>
 #include <ocs2_python_interface/PythonInterface.h>
+#include <ocs2_python_interface/VectorizedEnvironment.h>
 
 #include "ocs2_double_integrator/DoubleIntegratorInterface.h"
 #include "ocs2_double_integrator/definitions.h"
@@ -29,15 +31,81 @@ class DoubleIntegratorPyBindings final : public PythonInterface {
     // Robot interface
     DoubleIntegratorInterface doubleIntegratorInterface(taskFile, libraryFolder);
 
+    // Thread pool which is shared by the solver and the batch methods
+    const auto& ddpSettings = doubleIntegratorInterface.ddpSettings();
+    auto threadPoolPtr = std::make_shared<ThreadPool>(std::max(ddpSettings.nThreads_, size_t(1)) - 1, ddpSettings.threadPriority_);
+
     // MPC
-    std::unique_ptr<GaussNewtonDDP_MPC> mpcPtr(new GaussNewtonDDP_MPC(
-        doubleIntegratorInterface.mpcSettings(), doubleIntegratorInterface.ddpSettings(), doubleIntegratorInterface.getRollout(),
-        doubleIntegratorInterface.getOptimalControlProblem(), doubleIntegratorInterface.getInitializer()));
+    std::unique_ptr<GaussNewtonDDP_MPC> mpcPtr(
+        new GaussNewtonDDP_MPC(doubleIntegratorInterface.mpcSettings(), ddpSettings, doubleIntegratorInterface.getRollout(),
+                               doubleIntegratorInterface.getOptimalControlProblem(), doubleIntegratorInterface.getInitializer(),
+                               threadPoolPtr));
     mpcPtr->getSolverPtr()->setReferenceManager(doubleIntegratorInterface.getReferenceManagerPtr());
 
     // Python interface
-    PythonInterface::init(doubleIntegratorInterface, std::move(mpcPtr));
+    PythonInterface::init(doubleIntegratorInterface, std::move(mpcPtr), std::move(threadPoolPtr));
+  }
+};
+
+class DoubleIntegratorMpcPool final : public MpcPool {
+ public:
+  /**
+   * Constructor
+   *
+   * @param [in] taskFile: The absolute path to the configuration file for the MPC.
+   * @param [in] libraryFolder: The absolute path to the directory to generate CppAD library into.
+   * @param [in] urdfFile: The absolute path to the URDF of the robot. This is not used for double integrator.
+   * @param [in] numInstances: The number of MPC instances. Each instance runs its solver single-threaded.
+   */
+  DoubleIntegratorMpcPool(const std::string& taskFile, const std::string& libraryFolder, const std::string urdfFile = "",
+                          size_t numInstances = 1)
+      : doubleIntegratorInterface_(taskFile, libraryFolder) {
+    auto ddpSettings = doubleIntegratorInterface_.ddpSettings();
+    ddpSettings.nThreads_ = 1;
+
+    MpcPool::init(numInstances, [&]() {
+      return std::unique_ptr<MPC_BASE>(new GaussNewtonDDP_MPC(doubleIntegratorInterface_.mpcSettings(), ddpSettings,
+                                                              doubleIntegratorInterface_.getRollout(),
+                                                              doubleIntegratorInterface_.getOptimalControlProblem(),
+                                                              doubleIntegratorInterface_.getInitializer()));
+    });
   }
+
+ private:
+  DoubleIntegratorInterface doubleIntegratorInterface_;
+};
+
+class DoubleIntegratorVectorizedEnvironment final : public VectorizedEnvironment {
+ public:
+  /**
+   * Constructor
+   *
+   * @param [in] taskFile: The absolute path to the configuration file for the MPC.
+   * @param [in] libraryFolder: The absolute path to the directory to generate CppAD library into.
+   * @param [in] urdfFile: The absolute path to the URDF of the robot. This is not used for double integrator.
+   * @param [in] numEnvironments: The number of environments. Each MPC runs its solver single-threaded.
+   * @param [in] settings: The settings of the environments.
+   */
+  DoubleIntegratorVectorizedEnvironment(const std::string& taskFile, const std::string& libraryFolder, const std::string urdfFile = "",
+                                        size_t numEnvironments = 1,
+                                        vectorized_environment::Settings settings = vectorized_environment::Settings())
+      : doubleIntegratorInterface_(taskFile, libraryFolder) {
+    auto ddpSettings = doubleIntegratorInterface_.ddpSettings();
+    ddpSettings.nThreads_ = 1;
+
+    // each MPC keeps its own reference manager since the environments have different targets
+    auto mpcFactory = [&]() {
+      return std::unique_ptr<MPC_BASE>(new GaussNewtonDDP_MPC(doubleIntegratorInterface_.mpcSettings(), ddpSettings,
+                                                              doubleIntegratorInterface_.getRollout(),
+                                                              doubleIntegratorInterface_.getOptimalControlProblem(),
+                                                              doubleIntegratorInterface_.getInitializer()));
+    };
+    // the system is simulated with the rollout of the MPC
+    VectorizedEnvironment::init(numEnvironments, STATE_DIM, INPUT_DIM, settings, mpcFactory, doubleIntegratorInterface_.getRollout());
+  }
+
+ private:
+  DoubleIntegratorInterface doubleIntegratorInterface_;
 };
 
 }  // namespace double_integrator
@@ -1,2 +1,2 @@
-from ocs2_double_integrator.DoubleIntegratorPyBindings import mpc_interface
+from ocs2_double_integrator.DoubleIntegratorPyBindings import mpc_interface, mpc_pool, vectorized_environment, VectorizedEnvironmentSettings
 from ocs2_double_integrator.DoubleIntegratorPyBindings import scalar_array, vector_array, matrix_array, TargetTrajectories
@@ -1,4 +1,6 @@
 #include <ocs2_double_integrator/DoubleIntegratorPyBindings.h>
 #include <ocs2_python_interface/PybindMacros.h>
 
-CREATE_ROBOT_PYTHON_BINDINGS(ocs2::double_integrator::DoubleIntegratorPyBindings, DoubleIntegratorPyBindings)
+CREATE_ROBOT_PYTHON_BINDINGS_IMPL(ocs2::double_integrator::DoubleIntegratorPyBindings, DoubleIntegratorPyBindings,
+                                  MPC_POOL_BINDING(ocs2::double_integrator::DoubleIntegratorMpcPool)
+                                      VECTORIZED_ENVIRONMENT_BINDING(ocs2::double_integrator::DoubleIntegratorVectorizedEnvironment))
@@ -57,9 +57,10 @@ class DoubleIntegratorIntegrationTest : public testing::Test {
     doubleIntegratorInterfacePtr->getReferenceManagerPtr()->setTargetTrajectories(std::move(targetTrajectories));
   }
 
-  std::unique_ptr<GaussNewtonDDP_MPC> getMpc(bool warmStart) {
+  std::unique_ptr<GaussNewtonDDP_MPC> getMpc(bool warmStart, bool delayCompensation = false) {
     auto& interface = *doubleIntegratorInterfacePtr;
     auto mpcSettings = interface.mpcSettings();
+    mpcSettings.delayCompensation_ = delayCompensation;
     auto ddpSettings = interface.ddpSettings();
     if (!warmStart) {
       mpcSettings.coldStart_ = true;
@@ -118,6 +119,102 @@ TEST_F(DoubleIntegratorIntegrationTest, synchronousTracking) {
   ASSERT_NEAR(observation.state(0), goalState(0), tolerance);
 }
 
+TEST_F(DoubleIntegratorIntegrationTest, delayCompensation) {
+  auto mpcPtr = getMpc(true, true);
+  MPC_MRT_Interface mpcInterface(*mpcPtr);
+
+  SystemObservation observation;
+  observation.time = initTime;
+  observation.state = initState;
+  observation.input.setZero(INPUT_DIM);
+  mpcInterface.setCurrentObservation(observation);
+
+  // run MPC for N iterations
+  auto time = initTime;
+  while (time < finalTime) {
+    // run MPC
+    mpcInterface.advanceMpc();
+    time += 1.0 / f_mpc;
+
+    if (mpcInterface.initialPolicyReceived()) {
+      size_t mode;
+      vector_t optimalState, optimalInput;
+
+      mpcInterface.updatePolicy();
+      mpcInterface.evaluatePolicy(time, vector_t::Zero(STATE_DIM), optimalState, optimalInput, mode);
+
+      // use optimal state for the next observation:
+      observation.time = time;
+      observation.state = optimalState;
+      observation.input.setZero(INPUT_DIM);
+      mpcInterface.setCurrentObservation(observation);
+    }
+  }
+
+  // MPC solves from the predicted state, therefore the policy starts after the observation time
+  EXPECT_GT(mpcPtr->getDelayEstimate(), 0.0);
+  EXPECT_GT(mpcInterface.getPolicy().timeTrajectory_.front(), mpcInterface.getCommand().mpcInitObservation_.time);
+  ASSERT_NEAR(observation.state(0), goalState(0), tolerance);
+}
+
+TEST_F(DoubleIntegratorIntegrationTest, adaptiveScheduling) {
+  auto& interface = *doubleIntegratorInterfacePtr;
+  auto mpcSettings = interface.mpcSettings();
+  mpcSettings.adaptiveScheduling_ = true;
+  mpcSettings.targetLatency_ = 1e-6;  // not feasible
+  mpcSettings.minTimeHorizon_ = 0.5 * mpcSettings.timeHorizon_;
+  GaussNewtonDDP_MPC mpc(mpcSettings, interface.ddpSettings(), interface.getRollout(), interface.getOptimalControlProblem(),
+                         interface.getInitializer());
+  mpc.getSolverPtr()->setReferenceManager(interface.getReferenceManagerPtr());
+
+  size_t numSchedules = 0;
+  mpc.getScheduler().setScheduleCallback([&](const mpc::Schedule& schedule) {
+    EXPECT_GT(schedule.latestLatency, 0.0);
+    ++numSchedules;
+  });
+
+  // the horizon shrinks to its lower bound, and every run after the cold start has a deadline
+  constexpr size_t numRuns = 20;
+  for (size_t i = 0; i < numRuns; i++) {
+    const scalar_t time = initTime + i / f_mpc;
+    const scalar_t timeHorizon = mpc.getTimeHorizon();
+    ASSERT_TRUE(mpc.run(time, initState));
+    ASSERT_NEAR(mpc.getSolverPtr()->getFinalTime(), time + timeHorizon, 1e-3);
+    EXPECT_EQ(mpc.getSolverPtr()->getDeadline() != std::chrono::steady_clock::time_point::max(), i > 0);
+  }
+  EXPECT_EQ(numSchedules, numRuns - 1);
+  EXPECT_DOUBLE_EQ(mpc.getTimeHorizon(), mpcSettings.minTimeHorizon_);
+}
+
+TEST_F(DoubleIntegratorIntegrationTest, feedbackPolicyGrid) {
+  auto mpcPtr = getMpc(true);
+  MPC_MRT_Interface mpcInterface(*mpcPtr);
+  const scalar_t gridTimeStep = 0.01;
+  mpcInterface.initFeedbackPolicyGrid(gridTimeStep);
+
+  SystemObservation observation;
+  observation.time = initTime;
+  observation.state = initState;
+  observation.input.setZero(INPUT_DIM);
+  mpcInterface.setCurrentObservation(observation);
+  mpcInterface.advanceMpc();
+  ASSERT_TRUE(mpcInterface.initialPolicyReceived());
+  mpcInterface.updatePolicy();
+
+  // on the grid points, the sampled policy is the linear controller of MPC
+  size_t mode, gridMode;
+  vector_t mpcState, mpcInput, gridState, gridInput;
+  for (size_t k = 0; k < 100; k++) {
+    const scalar_t time = initTime + k * gridTimeStep;
+    const vector_t state = vector_t::Random(STATE_DIM);
+    mpcInterface.evaluatePolicy(time, state, mpcState, mpcInput, mode);
+    mpcInterface.evaluateFeedbackPolicy(time, state, gridState, gridInput, gridMode);
+    EXPECT_TRUE(gridState.isApprox(mpcState, 1e-6));
+    EXPECT_TRUE(gridInput.isApprox(mpcInput, 1e-6));
+    EXPECT_EQ(gridMode, mode);
+  }
+}
+
 TEST_F(DoubleIntegratorIntegrationTest, coldStartMPC) {
   auto mpcPtr = getMpc(false);
   MPC_MRT_Interface mpcInterface(*mpcPtr);
@@ -75,6 +75,24 @@ class double_integrator_python_tests(unittest.TestCase):
         print("dLdx", L.dfdx)
         print("dLdu", L.dfdu)
 
+        print("\n### Testing the array interface")
+        t_array, x_array, u_array = self.mpc.getMpcSolutionArrays()
+        self.assertEqual(x_array.shape, (len(t_result), self.stateDim))
+        self.assertEqual(u_array.shape, (len(t_result), self.inputDim))
+        self.assertTrue(x_array.flags["C_CONTIGUOUS"])
+
+        t_buffer = np.zeros(len(t_result))
+        x_buffer = np.zeros((len(t_result), self.stateDim))
+        u_buffer = np.zeros((len(t_result), self.inputDim))
+        self.assertEqual(self.mpc.copyMpcSolution(t_buffer, x_buffer, u_buffer), len(t_result))
+        np.testing.assert_allclose(x_buffer, x_array)
+
+        dxdt = self.mpc.flowMapBatch(t_array, x_array, u_array)
+        np.testing.assert_allclose(dxdt[0], flowMap.f)
+        L_batch = self.mpc.costQuadraticApproximationBatch(t_array, x_array, u_array)
+        np.testing.assert_allclose(L_batch.f[0], L.f)
+        np.testing.assert_allclose(L_batch.dfdxx[0].reshape(self.stateDim, self.stateDim), L.dfdxx)
+
 
 if __name__ == "__main__":
     unittest.main()
@@ -84,22 +84,33 @@ class LeggedRobotInterface final : public RobotInterface {
   const LeggedRobotInitializer& getInitializer() const override { return *initializerPtr_; }
   std::shared_ptr<ReferenceManagerInterface> getReferenceManagerPtr() const override { return referenceManagerPtr_; }
 
+  /**
+   * Creates a foothold planner whose nominal foot positions are the positions of the feet relative to the base in the initial state.
+   * The reference manager uses it once it is set by SwitchedModelReferenceManager::setFootholdPlanner, and the terrain is provided by
+   * FootholdPlanner::setTerrain.
+   *
+   * @param [in] config: The foothold planner settings.
+   * @return The foothold planner.
+   */
+  std::shared_ptr<FootholdPlanner> createFootholdPlanner(const FootholdPlanner::Config& config = FootholdPlanner::Config());
+
  private:
   void setupOptimalConrolProblem(const std::string& taskFile, const std::string& urdfFile, const std::string& referenceFile, bool verbose);
 
   std::shared_ptr<GaitSchedule> loadGaitSchedule(const std::string& file, bool verbose) const;
 
+  std::unique_ptr<SystemDynamicsBase> getDynamics(const CentroidalModelInfo& info, const std::string& modelName,
+                                                  bool useAnalyticalGradients) const;
+
   std::unique_ptr<StateInputCost> getBaseTrackingCost(const std::string& taskFile, const CentroidalModelInfo& info, bool verbose);
   matrix_t initializeInputCostWeight(const std::string& taskFile, const CentroidalModelInfo& info);
 
   std::pair<scalar_t, RelaxedBarrierPenalty::Config> loadFrictionConeSettings(const std::string& taskFile, bool verbose) const;
-  std::unique_ptr<StateInputCost> getFrictionConeConstraint(size_t contactPointIndex, scalar_t frictionCoefficient,
-                                                            const RelaxedBarrierPenalty::Config& barrierPenaltyConfig);
+  std::unique_ptr<StateInputCost> getFrictionConeCost(scalar_t frictionCoefficient,
+                                                      const RelaxedBarrierPenalty::Config& barrierPenaltyConfig);
   std::unique_ptr<StateInputConstraint> getZeroForceConstraint(size_t contactPointIndex);
-  std::unique_ptr<StateInputConstraint> getZeroVelocityConstraint(const EndEffectorKinematics<scalar_t>& eeKinematics,
-                                                                  size_t contactPointIndex, bool useAnalyticalGradients);
-  std::unique_ptr<StateInputConstraint> getNormalVelocityConstraint(const EndEffectorKinematics<scalar_t>& eeKinematics,
-                                                                    size_t contactPointIndex, bool useAnalyticalGradients);
+  std::unique_ptr<StateInputConstraint> getZeroVelocityConstraint(size_t contactPointIndex, bool useAnalyticalGradients);
+  std::unique_ptr<StateInputConstraint> getNormalVelocityConstraint(size_t contactPointIndex, bool useAnalyticalGradients);
 
   ModelSettings modelSettings_;
   ddp::Settings ddpSettings_;
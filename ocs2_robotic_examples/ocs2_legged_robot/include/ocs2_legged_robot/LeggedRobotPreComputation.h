@@ -33,6 +33,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <string>
 
 #include <ocs2_core/PreComputation.h>
+#include <ocs2_pinocchio_interface/PinocchioEndEffectorKinematicsCppAd.h>
 #include <ocs2_pinocchio_interface/PinocchioInterface.h>
 
 #include <ocs2_centroidal_model/CentroidalModelPinocchioMapping.h>
@@ -47,8 +48,18 @@ namespace legged_robot {
 /** Callback for caching and reference update */
 class LeggedRobotPreComputation : public PreComputation {
  public:
+  /**
+   * Constructor
+   * @param [in] pinocchioInterface : The pinocchio interface.
+   * @param [in] info : The centroidal model information.
+   * @param [in] swingTrajectoryPlanner : The swing trajectory planner.
+   * @param [in] settings : The model settings.
+   * @param [in] eeKinematicsPtr : The kinematics of all the 3 DoF contacts. If given, their positions and velocities are evaluated once
+   *                               per constraint request and shared by the foot constraints, see getEeKinematics().
+   */
   LeggedRobotPreComputation(PinocchioInterface pinocchioInterface, CentroidalModelInfo info,
-                            const SwingTrajectoryPlanner& swingTrajectoryPlanner, ModelSettings settings);
+                            const SwingTrajectoryPlanner& swingTrajectoryPlanner, ModelSettings settings,
+                            const PinocchioEndEffectorKinematicsCppAd* eeKinematicsPtr = nullptr);
   ~LeggedRobotPreComputation() override = default;
 
   LeggedRobotPreComputation* clone() const override;
@@ -57,11 +68,19 @@ class LeggedRobotPreComputation : public PreComputation {
 
   const std::vector<EndEffectorLinearConstraint::Config>& getEeNormalVelocityConstraintConfigs() const { return eeNormalVelConConfigs_; }
 
+  /**
+   * The stacked positions and velocities of all the 3 DoF contacts. Only the values are updated for constraint requests without the
+   * approximation flag. See PinocchioEndEffectorKinematicsCppAd::getPositionAndVelocityLinearApproximation().
+   */
+  const VectorFunctionLinearApproximation& getEeKinematics() const { return eeKinematics_; }
+  size_t getEePositionRow(size_t contactPointIndex) const { return 3 * contactPointIndex; }
+  size_t getEeVelocityRow(size_t contactPointIndex) const { return 3 * (info_.numThreeDofContacts + contactPointIndex); }
+
   PinocchioInterface& getPinocchioInterface() { return pinocchioInterface_; }
   const PinocchioInterface& getPinocchioInterface() const { return pinocchioInterface_; }
 
  private:
-  LeggedRobotPreComputation(const LeggedRobotPreComputation& other) = default;
+  LeggedRobotPreComputation(const LeggedRobotPreComputation& other);
 
   PinocchioInterface pinocchioInterface_;
   CentroidalModelInfo info_;
@@ -69,6 +88,9 @@ class LeggedRobotPreComputation : public PreComputation {
   const ModelSettings settings_;
 
   std::vector<EndEffectorLinearConstraint::Config> eeNormalVelConConfigs_;
+
+  std::unique_ptr<PinocchioEndEffectorKinematicsCppAd> eeKinematicsPtr_;
+  VectorFunctionLinearApproximation eeKinematics_;
 };
 
 }  // namespace legged_robot
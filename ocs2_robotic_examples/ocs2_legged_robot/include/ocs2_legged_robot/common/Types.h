@@ -41,6 +41,7 @@ template <typename T>
 using feet_array_t = std::array<T, 4>;
 using contact_flag_t = feet_array_t<bool>;
 
+using vector2_t = Eigen::Matrix<scalar_t, 2, 1>;
 using vector3_t = Eigen::Matrix<scalar_t, 3, 1>;
 using matrix3_t = Eigen::Matrix<scalar_t, 3, 3>;
 using quaternion_t = Eigen::Quaternion<scalar_t>;
@@ -81,6 +81,25 @@ class EndEffectorLinearConstraint final : public StateInputConstraint {
   VectorFunctionLinearApproximation getLinearApproximation(scalar_t time, const vector_t& state, const vector_t& input,
                                                            const PreComputation& preComp) const override;
 
+  /**
+   * Computes the constraint value from the stacked positions and velocities of several end-effectors, see
+   * PinocchioEndEffectorKinematicsCppAd::getPositionAndVelocity().
+   *
+   * @param [in] config: The constraint coefficients.
+   * @param [in] kinematics: The stacked end-effector positions and velocities.
+   * @param [in] positionRow: The row of the end-effector position in kinematics.
+   * @param [in] velocityRow: The row of the end-effector velocity in kinematics.
+   */
+  static vector_t computeValue(const Config& config, const vector_t& kinematics, size_t positionRow, size_t velocityRow);
+
+  /**
+   * Computes the constraint linear approximation from the stacked linear approximation of the positions and velocities of several
+   * end-effectors, see PinocchioEndEffectorKinematicsCppAd::getPositionAndVelocityLinearApproximation().
+   */
+  static VectorFunctionLinearApproximation computeLinearApproximation(const Config& config,
+                                                                      const VectorFunctionLinearApproximation& kinematics,
+                                                                      size_t positionRow, size_t velocityRow);
+
  private:
   EndEffectorLinearConstraint(const EndEffectorLinearConstraint& rhs);
 
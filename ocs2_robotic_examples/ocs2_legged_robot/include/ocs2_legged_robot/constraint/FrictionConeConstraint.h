@@ -104,6 +104,22 @@ class FrictionConeConstraint final : public StateInputConstraint {
   /** Sets the estimated terrain normal expressed in the world frame. */
   void setSurfaceNormalInWorld(const vector3_t& surfaceNormalInWorld);
 
+  /**
+   * The quadratic approximation of the constraint w.r.t. the 3 contact forces of the foot in the world frame, which are the inputs
+   * [3 * contactPointIndex, 3 * contactPointIndex + 3). The constraint does not depend on the other inputs and on the state, apart from
+   * the Hessian diagonal shift (see Config) which is not included.
+   */
+  struct ForceApproximation {
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+    scalar_t f;
+    vector3_t dfdF;
+    matrix3_t d2fdF2;
+  };
+  ForceApproximation getForceQuadraticApproximation(const vector_t& input) const;
+
+  size_t getContactPointIndex() const { return contactPointIndex_; }
+  const Config& getConfig() const { return config_; }
+
  private:
   struct LocalForceDerivatives {
     EIGEN_MAKE_ALIGNED_OPERATOR_NEW
@@ -39,7 +39,7 @@ namespace legged_robot {
 
 /**
  * Specializes the CppAd version of normal velocity constraint on an end-effector position and linear velocity.
- * Constructs the member EndEffectorLinearConstraint object with number of constraints of 1.
+ * The end-effector kinematics of all the contacts are evaluated once by the LeggedRobotPreComputation.
  *
  * See also EndEffectorLinearConstraint for the underlying computation.
  */
@@ -48,11 +48,9 @@ class NormalVelocityConstraintCppAd final : public StateInputConstraint {
   /**
    * Constructor
    * @param [in] referenceManager : Switched model ReferenceManager
-   * @param [in] endEffectorKinematics: The kinematic interface to the target end-effector.
    * @param [in] contactPointIndex : The 3 DoF contact index.
    */
-  NormalVelocityConstraintCppAd(const SwitchedModelReferenceManager& referenceManager,
-                                const EndEffectorKinematics<scalar_t>& endEffectorKinematics, size_t contactPointIndex);
+  NormalVelocityConstraintCppAd(const SwitchedModelReferenceManager& referenceManager, size_t contactPointIndex);
 
   ~NormalVelocityConstraintCppAd() override = default;
   NormalVelocityConstraintCppAd* clone() const override { return new NormalVelocityConstraintCppAd(*this); }
@@ -64,10 +62,9 @@ class NormalVelocityConstraintCppAd final : public StateInputConstraint {
                                                            const PreComputation& preComp) const override;
 
  private:
-  NormalVelocityConstraintCppAd(const NormalVelocityConstraintCppAd& rhs);
+  NormalVelocityConstraintCppAd(const NormalVelocityConstraintCppAd& rhs) = default;
 
   const SwitchedModelReferenceManager* referenceManagerPtr_;
-  std::unique_ptr<EndEffectorLinearConstraint> eeLinearConstraintPtr_;
   const size_t contactPointIndex_;
 };
 
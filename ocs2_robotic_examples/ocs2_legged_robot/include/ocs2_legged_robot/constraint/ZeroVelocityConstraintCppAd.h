@@ -39,7 +39,7 @@ namespace legged_robot {
 
 /**
  * Specializes the CppAd version of zero velocity constraint on an end-effector position and linear velocity.
- * Constructs the member EndEffectorLinearConstraint object with number of constraints of 3.
+ * The end-effector kinematics of all the contacts are evaluated once by the LeggedRobotPreComputation.
  *
  * See also EndEffectorLinearConstraint for the underlying computation.
  */
@@ -48,13 +48,11 @@ class ZeroVelocityConstraintCppAd final : public StateInputConstraint {
   /**
    * Constructor
    * @param [in] referenceManager : Switched model ReferenceManager
-   * @param [in] endEffectorKinematics: The kinematic interface to the target end-effector.
    * @param [in] contactPointIndex : The 3 DoF contact index.
    * @param [in] config: The constraint coefficients
    */
-  ZeroVelocityConstraintCppAd(const SwitchedModelReferenceManager& referenceManager,
-                              const EndEffectorKinematics<scalar_t>& endEffectorKinematics, size_t contactPointIndex,
-                              EndEffectorLinearConstraint::Config config = EndEffectorLinearConstraint::Config());
+  ZeroVelocityConstraintCppAd(const SwitchedModelReferenceManager& referenceManager, size_t contactPointIndex,
+                              EndEffectorLinearConstraint::Config config);
 
   ~ZeroVelocityConstraintCppAd() override = default;
   ZeroVelocityConstraintCppAd* clone() const override { return new ZeroVelocityConstraintCppAd(*this); }
@@ -66,11 +64,11 @@ class ZeroVelocityConstraintCppAd final : public StateInputConstraint {
                                                            const PreComputation& preComp) const override;
 
  private:
-  ZeroVelocityConstraintCppAd(const ZeroVelocityConstraintCppAd& rhs);
+  ZeroVelocityConstraintCppAd(const ZeroVelocityConstraintCppAd& rhs) = default;
 
   const SwitchedModelReferenceManager* referenceManagerPtr_;
-  std::unique_ptr<EndEffectorLinearConstraint> eeLinearConstraintPtr_;
   const size_t contactPointIndex_;
+  const EndEffectorLinearConstraint::Config config_;
 };
 
 }  // namespace legged_robot
@@ -0,0 +1,81 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <ocs2_core/cost/StateInputCost.h>
+#include <ocs2_core/penalties/penalties/PenaltyBase.h>
+
+#include "ocs2_legged_robot/constraint/FrictionConeConstraint.h"
+
+namespace ocs2 {
+namespace legged_robot {
+
+/**
+ * The penalized friction cone constraints of all feet as a single cost term. It is equivalent to the sum of one StateInputSoftConstraint
+ * per FrictionConeConstraint, but the derivatives of each foot are added as 3x3 blocks at the offsets of its contact forces instead of
+ * as dense (inputDim x inputDim) and (stateDim x stateDim) Hessians. Only the Hessian diagonal shift touches the whole diagonals.
+ */
+class FrictionConeCost final : public StateInputCost {
+ public:
+  /**
+   * Constructor
+   * @param [in] constraints : The friction cone constraints of the feet.
+   * @param [in] penaltyPtr : The penalty function of the constraints.
+   */
+  FrictionConeCost(std::vector<std::unique_ptr<FrictionConeConstraint>> constraints, std::unique_ptr<PenaltyBase> penaltyPtr);
+
+  ~FrictionConeCost() override = default;
+  FrictionConeCost* clone() const override { return new FrictionConeCost(*this); }
+
+  bool isActive(scalar_t time) const override;
+
+  scalar_t getValue(scalar_t time, const vector_t& state, const vector_t& input, const TargetTrajectories& targetTrajectories,
+                    const PreComputation& preComp) const override;
+
+  ScalarFunctionQuadraticApproximation getQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                                 const TargetTrajectories& targetTrajectories,
+                                                                 const PreComputation& preComp) const override;
+
+  void accumulateQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                        const TargetTrajectories& targetTrajectories, const PreComputation& preComp,
+                                        ScalarFunctionQuadraticApproximation& accumulator) const override;
+
+ private:
+  FrictionConeCost(const FrictionConeCost& other);
+
+  std::vector<std::unique_ptr<FrictionConeConstraint>> constraints_;
+  std::unique_ptr<PenaltyBase> penaltyPtr_;
+};
+
+}  // namespace legged_robot
+}  // namespace ocs2
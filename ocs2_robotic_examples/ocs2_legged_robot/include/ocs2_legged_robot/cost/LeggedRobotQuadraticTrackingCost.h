@@ -56,7 +56,7 @@ class LeggedRobotStateInputQuadraticCost final : public QuadraticStateInputCost
 
   std::pair<vector_t, vector_t> getStateInputDeviation(scalar_t time, const vector_t& state, const vector_t& input,
                                                        const TargetTrajectories& targetTrajectories) const override {
-    const auto contactFlags = referenceManagerPtr_->getContactFlags(time);
+    const auto& contactFlags = referenceManagerPtr_->getContactFlags(time);
     const vector_t xNominal = targetTrajectories.getDesiredState(time);
     const vector_t uNominal = weightCompensatingInput(info_, contactFlags);
     return {state - xNominal, input - uNominal};
@@ -81,7 +81,7 @@ class LeggedRobotStateQuadraticCost final : public QuadraticStateCost {
   LeggedRobotStateQuadraticCost(const LeggedRobotStateQuadraticCost& rhs) = default;
 
   vector_t getStateDeviation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories) const override {
-    const auto contactFlags = referenceManagerPtr_->getContactFlags(time);
+    const auto& contactFlags = referenceManagerPtr_->getContactFlags(time);
     const vector_t xNominal = targetTrajectories.getDesiredState(time);
     return state - xNominal;
   }
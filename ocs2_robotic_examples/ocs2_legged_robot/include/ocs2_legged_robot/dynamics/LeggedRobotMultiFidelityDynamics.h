@@ -0,0 +1,85 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <memory>
+
+#include <ocs2_core/dynamics/SystemDynamicsBase.h>
+
+#include "ocs2_legged_robot/reference_manager/SwitchedModelReferenceManager.h"
+
+namespace ocs2 {
+namespace legged_robot {
+
+/**
+ * Multi-fidelity dynamics over the MPC horizon: the high-fidelity dynamics (e.g., the full centroidal dynamics) are used for the first
+ * part of the horizon and the low-fidelity dynamics (e.g., the single rigid body dynamics) for the remainder, which reduces the cost per
+ * node for long horizons. The horizon starts at the initial time of the last MPC iteration as given by the reference manager.
+ *
+ * Both dynamics should share the state and the input spaces, as the full centroidal and the single rigid body dynamics do. Hence the
+ * state at the junction is mapped by the identity.
+ */
+class LeggedRobotMultiFidelityDynamics final : public SystemDynamicsBase {
+ public:
+  /**
+   * Constructor.
+   *
+   * @param [in] highFidelityDynamicsPtr: The dynamics for the first part of the horizon.
+   * @param [in] lowFidelityDynamicsPtr: The dynamics for the remainder of the horizon.
+   * @param [in] referenceManager: The reference manager which provides the initial time of the horizon.
+   * @param [in] highFidelityHorizon: The duration of the first part of the horizon.
+   */
+  LeggedRobotMultiFidelityDynamics(std::unique_ptr<SystemDynamicsBase> highFidelityDynamicsPtr,
+                                   std::unique_ptr<SystemDynamicsBase> lowFidelityDynamicsPtr,
+                                   const SwitchedModelReferenceManager& referenceManager, scalar_t highFidelityHorizon);
+
+  ~LeggedRobotMultiFidelityDynamics() override = default;
+  LeggedRobotMultiFidelityDynamics* clone() const override { return new LeggedRobotMultiFidelityDynamics(*this); }
+
+  vector_t computeFlowMap(scalar_t time, const vector_t& state, const vector_t& input, const PreComputation& preComp) override;
+  VectorFunctionLinearApproximation linearApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                        const PreComputation& preComp) override;
+
+ private:
+  LeggedRobotMultiFidelityDynamics(const LeggedRobotMultiFidelityDynamics& rhs);
+
+  SystemDynamicsBase& getDynamics(scalar_t time) {
+    const bool isHighFidelity = time < referenceManagerPtr_->getInitTime() + highFidelityHorizon_;
+    return isHighFidelity ? *highFidelityDynamicsPtr_ : *lowFidelityDynamicsPtr_;
+  }
+
+  std::unique_ptr<SystemDynamicsBase> highFidelityDynamicsPtr_;
+  std::unique_ptr<SystemDynamicsBase> lowFidelityDynamicsPtr_;
+  const SwitchedModelReferenceManager* referenceManagerPtr_;
+  const scalar_t highFidelityHorizon_;
+};
+
+}  // namespace legged_robot
+}  // namespace ocs2
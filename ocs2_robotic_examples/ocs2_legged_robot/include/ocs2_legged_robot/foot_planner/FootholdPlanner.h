@@ -0,0 +1,162 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <ocs2_centroidal_model/CentroidalModelInfo.h>
+#include <ocs2_core/reference/ModeSchedule.h>
+#include <ocs2_core/reference/TargetTrajectories.h>
+#include <ocs2_core/thread_support/TripleBuffer.h>
+
+#include "ocs2_legged_robot/common/Types.h"
+#include "ocs2_legged_robot/foot_planner/TerrainHeightMap.h"
+
+namespace ocs2 {
+namespace legged_robot {
+
+/**
+ * The selected footholds of each foot, sorted by the times at which the feet touch down.
+ */
+struct FootholdPlan {
+  struct Foothold {
+    scalar_t touchDownTime;
+    vector3_t position;
+  };
+
+  bool empty() const {
+    return std::all_of(footholds.begin(), footholds.end(), [](const std::vector<Foothold>& f) { return f.empty(); });
+  }
+
+  /**
+   * Gets the height of the contact of a foot at the given time: the height of the last foothold which is touched down at or before the
+   * given time, or the height of the first foothold for the earlier times.
+   *
+   * @param [in] leg: The foot index.
+   * @param [in] time: The enquiry time.
+   * @param [in] defaultHeight: The height which is returned if there is no foothold for the foot.
+   * @return The height of the contact.
+   */
+  scalar_t getContactHeight(size_t leg, scalar_t time, scalar_t defaultHeight) const;
+
+  feet_array_t<std::vector<Foothold>> footholds;
+};
+
+/**
+ * Selects the footholds of the upcoming contacts on a terrain height map (see TerrainHeightMap::selectFoothold). The nominal foothold of
+ * a contact is the nominal foot position in the yaw-aligned base frame, placed at the base pose of the target trajectories at the
+ * touch-down time.
+ *
+ * The footholds are selected in a worker thread. The MPC loop requests a new plan once the mode schedule changes, which only copies the
+ * request, and swaps in the latest plan by calling updateFromBuffer(). The plans are exchanged through a triple buffer, hence the MPC
+ * loop never waits for the terrain queries. A new terrain replans the last request.
+ */
+class FootholdPlanner {
+ public:
+  struct Config {
+    scalar_t searchRadius = 0.15;  // the maximum distance between the selected and the nominal foothold
+  };
+
+  /**
+   * Constructor.
+   *
+   * @param [in] config: The foothold planner settings.
+   * @param [in] info: The centroidal model information.
+   * @param [in] nominalFootPositions: The nominal positions of the feet in the yaw-aligned base frame. Only x and y are used.
+   */
+  FootholdPlanner(Config config, CentroidalModelInfo info, std::vector<vector3_t> nominalFootPositions);
+
+  /** Destructor. Stops the worker thread. */
+  ~FootholdPlanner();
+
+  FootholdPlanner(const FootholdPlanner&) = delete;
+  FootholdPlanner& operator=(const FootholdPlanner&) = delete;
+
+  /**
+   * Sets the terrain on which the footholds are selected. This method is thread-safe.
+   *
+   * @param [in] terrainPtr: The terrain height map.
+   */
+  void setTerrain(std::shared_ptr<const TerrainHeightMap> terrainPtr);
+
+  /**
+   * Requests a new plan for the touch-downs after the initial time. This method is thread-safe.
+   *
+   * @param [in] initTime: The initial time.
+   * @param [in] modeSchedule: The mode schedule.
+   * @param [in] targetTrajectories: The target trajectories which define the nominal base poses.
+   */
+  void request(scalar_t initTime, const ModeSchedule& modeSchedule, const TargetTrajectories& targetTrajectories);
+
+  /**
+   * Swaps in the latest plan. This method is NOT thread-safe w.r.t. getPlan().
+   * @return True if the plan was updated.
+   */
+  bool updateFromBuffer() { return plans_.updateFromBuffer(); }
+
+  /** The active plan. It is empty until the first plan is computed. */
+  const FootholdPlan& getPlan() const { return plans_.front(); }
+
+ private:
+  void workerThread();
+
+  FootholdPlan computePlan(const TerrainHeightMap& terrain) const;
+
+  const Config config_;
+  const CentroidalModelInfo info_;
+  const std::vector<vector3_t> nominalFootPositions_;
+  TripleBuffer<FootholdPlan> plans_;
+
+  // the request and the terrain which are set by the MPC loop and the perception
+  std::mutex requestMutex_;
+  std::condition_variable requestCondition_;
+  scalar_t initTimeBuffer_ = 0.0;
+  ModeSchedule modeScheduleBuffer_;
+  TargetTrajectories targetTrajectoriesBuffer_;
+  std::shared_ptr<const TerrainHeightMap> terrainBuffer_;
+  bool hasRequest_ = false;
+  bool isUpdated_ = false;
+  bool terminateThread_ = false;
+
+  // only accessed by the worker
+  scalar_t initTime_ = 0.0;
+  ModeSchedule modeSchedule_;
+  TargetTrajectories targetTrajectories_;
+
+  std::thread worker_;
+};
+
+}  // namespace legged_robot
+}  // namespace ocs2
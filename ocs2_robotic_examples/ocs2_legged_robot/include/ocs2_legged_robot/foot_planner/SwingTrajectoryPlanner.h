@@ -58,6 +58,23 @@ class SwingTrajectoryPlanner {
   scalar_t getZpositionConstraint(size_t leg, scalar_t time) const;
 
  private:
+  /**
+   * Builds a table over uniform time buckets spanning the event times. Each bucket holds the phase index at its start time, such that
+   * the phase of any time is found in O(1) by the getPhaseIndex method. The bucket size is the shortest phase duration, hence at most one
+   * event has to be skipped after the table lookup.
+   *
+   * @param [in] eventTimes: The event times of the mode schedule.
+   */
+  void updatePhaseIndexTable(const scalar_array_t& eventTimes);
+
+  /**
+   * Returns the index of the phase which contains the given time. Same as lookup::findIndexInTimeArray on the event times.
+   *
+   * @param [in] time: The enquiry time.
+   * @return The phase index.
+   */
+  size_t getPhaseIndex(scalar_t time) const;
+
   /**
    * Extracts for each leg the contact sequence over the motion phase sequence.
    * @param phaseIDsStock
@@ -104,7 +121,11 @@ class SwingTrajectoryPlanner {
   const size_t numFeet_;
 
   feet_array_t<std::vector<SplineCpg>> feetHeightTrajectories_;
-  feet_array_t<std::vector<scalar_t>> feetHeightTrajectoriesEvents_;
+
+  scalar_array_t eventTimes_;
+  scalar_t phaseIndexTableStartTime_ = 0.0;
+  scalar_t phaseIndexTableTimeStep_ = 1.0;
+  std::vector<size_t> phaseIndexTable_;
 };
 
 SwingTrajectoryPlanner::Config loadSwingTrajectorySettings(const std::string& fileName,
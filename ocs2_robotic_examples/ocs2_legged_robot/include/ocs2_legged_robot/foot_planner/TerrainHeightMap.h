@@ -0,0 +1,103 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "ocs2_legged_robot/common/Types.h"
+
+namespace ocs2 {
+namespace legged_robot {
+
+/**
+ * A terrain height map which is sampled on a regular 2D grid and bilinearly interpolated in between the samples. The points outside of
+ * the grid are projected onto the grid boundary.
+ *
+ * The steppable samples are precomputed on construction: a sample is steppable if all the heights within the foot radius around it
+ * deviate by at most maxUnevenness from its own height. The connected areas of steppable samples are the flat regions in which the
+ * footholds are selected.
+ */
+class TerrainHeightMap {
+ public:
+  struct Config {
+    scalar_t footRadius = 0.05;     // the radius of the area around a foothold which has to be flat
+    scalar_t maxUnevenness = 0.02;  // the maximum height deviation within the foot radius of a steppable sample
+  };
+
+  /**
+   * Constructor.
+   *
+   * @param [in] config: The steppability settings.
+   * @param [in] gridSize: The number of samples per axis.
+   * @param [in] resolution: The distance between two samples.
+   * @param [in] origin: The position of the sample with the index (0, 0).
+   * @param [in] heights: The sampled heights in which the x index runs fastest.
+   */
+  TerrainHeightMap(Config config, const std::array<size_t, 2>& gridSize, scalar_t resolution, const vector2_t& origin,
+                   std::vector<float> heights);
+
+  const std::array<size_t, 2>& getGridSize() const { return gridSize_; }
+  scalar_t getResolution() const { return resolution_; }
+  const vector2_t& getOrigin() const { return origin_; }
+
+  /** Gets the interpolated height at the given position. */
+  scalar_t getHeight(const vector2_t& p) const;
+
+  /** Whether the sample closest to the given position is steppable. */
+  bool isSteppable(const vector2_t& p) const;
+
+  /**
+   * Selects the foothold closest to the nominal foothold: the closest steppable sample within the search radius at its height. If there
+   * is no steppable sample within the search radius, the nominal foothold is projected onto the terrain.
+   *
+   * @param [in] nominalFoothold: The position of the nominal foothold in the horizontal plane.
+   * @param [in] searchRadius: The maximum distance between the selected and the nominal foothold.
+   * @return The selected foothold.
+   */
+  vector3_t selectFoothold(const vector2_t& nominalFoothold, scalar_t searchRadius) const;
+
+ private:
+  size_t getIndex(size_t ix, size_t iy) const { return ix + gridSize_[0] * iy; }
+
+  /** The indices of the sample closest to the given position. */
+  std::array<size_t, 2> getClosestSample(const vector2_t& p) const;
+
+  const Config config_;
+  const std::array<size_t, 2> gridSize_;
+  const scalar_t resolution_;
+  const vector2_t origin_;
+  std::vector<float> heights_;
+  std::vector<uint8_t> steppable_;
+};
+
+}  // namespace legged_robot
+}  // namespace ocs2
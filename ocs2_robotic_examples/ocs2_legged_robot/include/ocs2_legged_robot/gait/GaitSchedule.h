@@ -44,11 +44,26 @@ class GaitSchedule {
   GaitSchedule(ModeSchedule initModeSchedule, ModeSequenceTemplate initModeSequenceTemplate, scalar_t phaseTransitionStanceTime);
 
   /**
+   * Updates the mode schedule and returns a copy of it.
+   *
    * @param [in] lowerBoundTime: The smallest time for which the ModeSchedule should be defined.
    * @param [in] upperBoundTime: The greatest time for which the ModeSchedule should be defined.
    */
   ModeSchedule getModeSchedule(scalar_t lowerBoundTime, scalar_t upperBoundTime);
 
+  /**
+   * Updates the mode schedule incrementally such that it is defined from lowerBoundTime to upperBoundTime. The phases which have elapsed
+   * before lowerBoundTime are dropped and the template is only tiled if the mode schedule does not reach upperBoundTime yet.
+   *
+   * @param [in] lowerBoundTime: The smallest time for which the ModeSchedule should be defined.
+   * @param [in] upperBoundTime: The greatest time for which the ModeSchedule should be defined.
+   * @return true if the mode schedule has changed since the last call of this method.
+   */
+  bool updateModeSchedule(scalar_t lowerBoundTime, scalar_t upperBoundTime);
+
+  /** Returns the current mode schedule. */
+  const ModeSchedule& getModeSchedule() const { return modeSchedule_; }
+
   /**
    * Used to insert a new user defined logic in the given time period.
    *
@@ -70,7 +85,20 @@ class GaitSchedule {
   ModeSchedule modeSchedule_;
   ModeSequenceTemplate modeSequenceTemplate_;
   scalar_t phaseTransitionStanceTime_;
+  bool modeScheduleChanged_ = true;
 };
 
+/**
+ * Shifts the next event after the given time at which a leg touches down. This gives the mode schedule of a contingency hypothesis, e.g.
+ * an early (negative shift) or a late (positive shift) touchdown (see ContingencyMpc). The neighboring phases keep at least 10% of their
+ * duration, such that the order of the events is retained.
+ *
+ * @param [in] modeSchedule: The nominal mode schedule.
+ * @param [in] time: The time after which the touchdown is searched, e.g. the initial time of MPC.
+ * @param [in] timeShift: The shift of the touchdown time.
+ * @return The mode schedule with the shifted touchdown.
+ */
+ModeSchedule shiftNextTouchDown(ModeSchedule modeSchedule, scalar_t time, scalar_t timeShift);
+
 }  // namespace legged_robot
 }  // namespace ocs2
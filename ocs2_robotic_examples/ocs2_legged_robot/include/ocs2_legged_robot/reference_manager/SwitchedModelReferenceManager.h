@@ -29,9 +29,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <atomic>
+
 #include <ocs2_core/thread_support/Synchronized.h>
 #include <ocs2_oc/synchronized_module/ReferenceManager.h>
 
+#include "ocs2_legged_robot/foot_planner/FootholdPlanner.h"
 #include "ocs2_legged_robot/foot_planner/SwingTrajectoryPlanner.h"
 #include "ocs2_legged_robot/gait/GaitSchedule.h"
 #include "ocs2_legged_robot/gait/MotionPhaseDefinition.h"
@@ -48,18 +51,51 @@ class SwitchedModelReferenceManager : public ReferenceManager {
 
   ~SwitchedModelReferenceManager() override = default;
 
-  contact_flag_t getContactFlags(scalar_t time) const;
+  /**
+   * Returns the contact flags at the given time. The flags of each mode of the active mode schedule are tabulated once per solver run
+   * and the mode interval is found through getModeScheduleLookup(), hence the terms can query them at every node.
+   */
+  const contact_flag_t& getContactFlags(scalar_t time) const;
+
+  void preSolverRun(scalar_t initTime, scalar_t finalTime, const vector_t& initState) override;
+
+  /**
+   * Sets a mode schedule which replaces the mode schedule of the gait schedule until the gait schedule changes, e.g. the mode schedule
+   * of a contingency hypothesis (see ContingencyMpc). The swing trajectories are planned for it in the next run.
+   */
+  void setModeSchedule(const ModeSchedule& modeSchedule) override;
+  void setModeSchedule(ModeSchedule&& modeSchedule) override;
+
+  /** The initial time of the last MPC iteration. */
+  scalar_t getInitTime() const { return initTime_; }
 
   const std::shared_ptr<GaitSchedule>& getGaitSchedule() { return gaitSchedulePtr_; }
 
   const std::shared_ptr<SwingTrajectoryPlanner>& getSwingTrajectoryPlanner() { return swingTrajectoryPtr_; }
 
+  /**
+   * Sets a foothold planner which selects the footholds on the terrain. The swing trajectories then lift off and touch down at the
+   * heights of the planned footholds instead of the flat ground. It should be set before the MPC starts.
+   *
+   * @param [in] footholdPlannerPtr: The foothold planner.
+   */
+  void setFootholdPlanner(std::shared_ptr<FootholdPlanner> footholdPlannerPtr) { footholdPlannerPtr_ = std::move(footholdPlannerPtr); }
+
+  const std::shared_ptr<FootholdPlanner>& getFootholdPlanner() { return footholdPlannerPtr_; }
+
  private:
   void modifyReferences(scalar_t initTime, scalar_t finalTime, const vector_t& initState, TargetTrajectories& targetTrajectories,
                         ModeSchedule& modeSchedule) override;
 
+  /** Updates the swing trajectories for the given mode schedule based on the active foothold plan. */
+  void updateSwingTrajectories(const ModeSchedule& modeSchedule);
+
   std::shared_ptr<GaitSchedule> gaitSchedulePtr_;
   std::shared_ptr<SwingTrajectoryPlanner> swingTrajectoryPtr_;
+  std::shared_ptr<FootholdPlanner> footholdPlannerPtr_;
+  scalar_t initTime_ = 0.0;
+  std::atomic_bool isModeScheduleSet_{false};
+  std::vector<contact_flag_t> contactFlagsSequence_;  // contact flags of the modes of the active mode schedule
 };
 
 }  // namespace legged_robot
@@ -27,6 +27,7 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
+#include <future>
 #include <iostream>
 #include <string>
 
@@ -42,7 +43,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_centroidal_model/CentroidalModelPinocchioMapping.h>
 #include <ocs2_centroidal_model/ModelHelperFunctions.h>
 #include <ocs2_core/misc/Display.h>
-#include <ocs2_core/soft_constraint/StateInputSoftConstraint.h>
+#include <ocs2_core/misc/LoadData.h>
 #include <ocs2_oc/synchronized_module/SolverSynchronizedModule.h>
 #include <ocs2_pinocchio_interface/PinocchioEndEffectorKinematicsCppAd.h>
 
@@ -51,8 +52,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ocs2_legged_robot/constraint/NormalVelocityConstraintCppAd.h"
 #include "ocs2_legged_robot/constraint/ZeroForceConstraint.h"
 #include "ocs2_legged_robot/constraint/ZeroVelocityConstraintCppAd.h"
+#include "ocs2_legged_robot/cost/FrictionConeCost.h"
 #include "ocs2_legged_robot/cost/LeggedRobotQuadraticTrackingCost.h"
+#include "ocs2_legged_robot/dynamics/LeggedRobotDynamics.h"
 #include "ocs2_legged_robot/dynamics/LeggedRobotDynamicsAD.h"
+#include "ocs2_legged_robot/dynamics/LeggedRobotMultiFidelityDynamics.h"
 
 // Boost
 #include <boost/filesystem/operations.hpp>
@@ -131,18 +135,31 @@ void LeggedRobotInterface::setupOptimalConrolProblem(const std::string& taskFile
   problemPtr_.reset(new OptimalControlProblem);
 
   // Dynamics
+  // The dynamics are created in separate tasks such that their CppAD libraries are generated concurrently with the libraries of the
+  // feet kinematics below. CppAdInterface serializes the taping, while the compilation of all the libraries shares one build queue.
   bool useAnalyticalGradientsDynamics = false;
   loadData::loadCppDataType(taskFile, "legged_robot_interface.useAnalyticalGradientsDynamics", useAnalyticalGradientsDynamics);
-  std::unique_ptr<SystemDynamicsBase> dynamicsPtr;
-  if (useAnalyticalGradientsDynamics) {
-    throw std::runtime_error("[LeggedRobotInterface::setupOptimalConrolProblem] The analytical dynamics class is not yet implemented!");
+  scalar_t fullCentroidalDynamicsHorizon = 0.0;
+  loadData::loadCppDataType(taskFile, "legged_robot_interface.fullCentroidalDynamicsHorizon", fullCentroidalDynamicsHorizon);
+  auto launchDynamics = [&](CentroidalModelInfo info, std::string modelName) {
+    return std::async(std::launch::async, [this, info, modelName, useAnalyticalGradientsDynamics]() {
+      return getDynamics(info, modelName, useAnalyticalGradientsDynamics);
+    });
+  };
+  std::vector<std::future<std::unique_ptr<SystemDynamicsBase>>> dynamicsFutures;
+  if (fullCentroidalDynamicsHorizon > 0.0) {
+    // the full centroidal dynamics at the beginning of the horizon and the single rigid body dynamics for the remainder
+    auto getInfo = [&](CentroidalModelType type) {
+      return centroidal_model::createCentroidalModelInfo(*pinocchioInterfacePtr_, type,
+                                                         centroidalModelInfo_.qPinocchioNominal.tail(centroidalModelInfo_.actuatedDofNum),
+                                                         modelSettings_.contactNames3DoF, modelSettings_.contactNames6DoF);
+    };
+    dynamicsFutures.push_back(launchDynamics(getInfo(CentroidalModelType::FullCentroidalDynamics), "dynamics_full"));
+    dynamicsFutures.push_back(launchDynamics(getInfo(CentroidalModelType::SingleRigidBodyDynamics), "dynamics_srbd"));
   } else {
-    const std::string modelName = "dynamics";
-    dynamicsPtr.reset(new LeggedRobotDynamicsAD(*pinocchioInterfacePtr_, centroidalModelInfo_, modelName, modelSettings_));
+    dynamicsFutures.push_back(launchDynamics(centroidalModelInfo_, "dynamics"));
   }
 
-  problemPtr_->dynamicsPtr = std::move(dynamicsPtr);
-
   // Cost terms
   problemPtr_->costPtr->add("baseTrackingCost", getBaseTrackingCost(taskFile, centroidalModelInfo_, false));
 
@@ -154,38 +171,49 @@ void LeggedRobotInterface::setupOptimalConrolProblem(const std::string& taskFile
 
   bool useAnalyticalGradientsConstraints = false;
   loadData::loadCppDataType(taskFile, "legged_robot_interface.useAnalyticalGradientsConstraints", useAnalyticalGradientsConstraints);
-  for (size_t i = 0; i < centroidalModelInfo_.numThreeDofContacts; i++) {
-    const std::string& footName = modelSettings_.contactNames3DoF[i];
 
-    std::unique_ptr<EndEffectorKinematics<scalar_t>> eeKinematicsPtr;
-    if (useAnalyticalGradientsConstraints) {
-      throw std::runtime_error(
-          "[LeggedRobotInterface::setupOptimalConrolProblem] The analytical end-effector linear constraint is not implemented!");
-    } else {
-      const auto infoCppAd = centroidalModelInfo_.toCppAd();
-      const CentroidalModelPinocchioMappingCppAd pinocchioMappingCppAd(infoCppAd);
-      auto velocityUpdateCallback = [&infoCppAd](const ad_vector_t& state, PinocchioInterfaceCppAd& pinocchioInterfaceAd) {
-        const ad_vector_t q = centroidal_model::getGeneralizedCoordinates(state, infoCppAd);
-        updateCentroidalDynamics(pinocchioInterfaceAd, infoCppAd, q);
-      };
-      eeKinematicsPtr.reset(new PinocchioEndEffectorKinematicsCppAd(*pinocchioInterfacePtr_, pinocchioMappingCppAd, {footName},
-                                                                    centroidalModelInfo_.stateDim, centroidalModelInfo_.inputDim,
-                                                                    velocityUpdateCallback, footName, modelSettings_.modelFolderCppAd,
-                                                                    modelSettings_.recompileLibrariesCppAd, modelSettings_.verboseCppAd));
-    }
+  // the kinematics of all the feet are evaluated once per node in the pre-computation and shared by the foot constraints
+  std::unique_ptr<PinocchioEndEffectorKinematicsCppAd> eeKinematicsPtr;
+  if (useAnalyticalGradientsConstraints) {
+    throw std::runtime_error(
+        "[LeggedRobotInterface::setupOptimalConrolProblem] The analytical end-effector linear constraint is not implemented!");
+  } else {
+    const auto infoCppAd = centroidalModelInfo_.toCppAd();
+    const CentroidalModelPinocchioMappingCppAd pinocchioMappingCppAd(infoCppAd);
+    auto velocityUpdateCallback = [&infoCppAd](const ad_vector_t& state, PinocchioInterfaceCppAd& pinocchioInterfaceAd) {
+      const ad_vector_t q = centroidal_model::getGeneralizedCoordinates(state, infoCppAd);
+      updateCentroidalDynamics(pinocchioInterfaceAd, infoCppAd, q);
+    };
+    eeKinematicsPtr.reset(new PinocchioEndEffectorKinematicsCppAd(*pinocchioInterfacePtr_, pinocchioMappingCppAd,
+                                                                  modelSettings_.contactNames3DoF, centroidalModelInfo_.stateDim,
+                                                                  centroidalModelInfo_.inputDim, velocityUpdateCallback, "feet",
+                                                                  modelSettings_.modelFolderCppAd, modelSettings_.recompileLibrariesCppAd,
+                                                                  modelSettings_.verboseCppAd));
+  }
 
-    problemPtr_->softConstraintPtr->add(footName + "_frictionCone",
-                                        getFrictionConeConstraint(i, frictionCoefficient, barrierPenaltyConfig));
+  // wait for the dynamics
+  if (fullCentroidalDynamicsHorizon > 0.0) {
+    auto fullDynamicsPtr = dynamicsFutures[0].get();
+    auto srbdDynamicsPtr = dynamicsFutures[1].get();
+    problemPtr_->dynamicsPtr.reset(new LeggedRobotMultiFidelityDynamics(std::move(fullDynamicsPtr), std::move(srbdDynamicsPtr),
+                                                                        *referenceManagerPtr_, fullCentroidalDynamicsHorizon));
+  } else {
+    problemPtr_->dynamicsPtr = dynamicsFutures[0].get();
+  }
+
+  problemPtr_->softConstraintPtr->add("frictionCone", getFrictionConeCost(frictionCoefficient, barrierPenaltyConfig));
+  for (size_t i = 0; i < centroidalModelInfo_.numThreeDofContacts; i++) {
+    const std::string& footName = modelSettings_.contactNames3DoF[i];
     problemPtr_->equalityConstraintPtr->add(footName + "_zeroForce", getZeroForceConstraint(i));
-    problemPtr_->equalityConstraintPtr->add(footName + "_zeroVelocity",
-                                            getZeroVelocityConstraint(*eeKinematicsPtr, i, useAnalyticalGradientsConstraints));
+    problemPtr_->equalityConstraintPtr->add(footName + "_zeroVelocity", getZeroVelocityConstraint(i, useAnalyticalGradientsConstraints));
     problemPtr_->equalityConstraintPtr->add(footName + "_normalVelocity",
-                                            getNormalVelocityConstraint(*eeKinematicsPtr, i, useAnalyticalGradientsConstraints));
+                                            getNormalVelocityConstraint(i, useAnalyticalGradientsConstraints));
   }
 
   // Pre-computation
   problemPtr_->preComputationPtr.reset(new LeggedRobotPreComputation(*pinocchioInterfacePtr_, centroidalModelInfo_,
-                                                                     *referenceManagerPtr_->getSwingTrajectoryPlanner(), modelSettings_));
+                                                                     *referenceManagerPtr_->getSwingTrajectoryPlanner(), modelSettings_,
+                                                                     eeKinematicsPtr.get()));
 
   // Rollout
   rolloutPtr_.reset(new TimeTriggeredRollout(*problemPtr_->dynamicsPtr, rolloutSettings_));
@@ -195,6 +223,42 @@ void LeggedRobotInterface::setupOptimalConrolProblem(const std::string& taskFile
   initializerPtr_.reset(new LeggedRobotInitializer(centroidalModelInfo_, *referenceManagerPtr_, extendNormalizedMomentum));
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::unique_ptr<SystemDynamicsBase> LeggedRobotInterface::getDynamics(const CentroidalModelInfo& info, const std::string& modelName,
+                                                                      bool useAnalyticalGradients) const {
+  std::unique_ptr<SystemDynamicsBase> dynamicsPtr;
+  if (useAnalyticalGradients) {
+    dynamicsPtr.reset(new LeggedRobotDynamics(*pinocchioInterfacePtr_, info));
+  } else {
+    dynamicsPtr.reset(new LeggedRobotDynamicsAD(*pinocchioInterfacePtr_, info, modelName, modelSettings_));
+  }
+  return dynamicsPtr;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::shared_ptr<FootholdPlanner> LeggedRobotInterface::createFootholdPlanner(const FootholdPlanner::Config& config) {
+  const auto& model = pinocchioInterfacePtr_->getModel();
+  auto& data = pinocchioInterfacePtr_->getData();
+  const auto q = centroidal_model::getGeneralizedCoordinates(initialState_, centroidalModelInfo_);
+  pinocchio::forwardKinematics(model, data, q);
+  pinocchio::updateFramePlacements(model, data);
+
+  // the feet positions in the yaw-aligned base frame
+  const auto basePose = centroidal_model::getBasePose(initialState_, centroidalModelInfo_);
+  const Eigen::AngleAxis<scalar_t> yawRotation(basePose(3), vector3_t::UnitZ());
+  std::vector<vector3_t> nominalFootPositions;
+  for (size_t i = 0; i < centroidalModelInfo_.numThreeDofContacts; i++) {
+    const auto frameId = model.getBodyId(modelSettings_.contactNames3DoF[i]);
+    nominalFootPositions.emplace_back(yawRotation.inverse() * (data.oMf[frameId].translation() - basePose.head<3>()));
+  }
+
+  return std::make_shared<FootholdPlanner>(config, centroidalModelInfo_, std::move(nominalFootPositions));
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -287,8 +351,8 @@ std::unique_ptr<StateInputCost> LeggedRobotInterface::getBaseTrackingCost(const
 /******************************************************************************************************/
 std::pair<scalar_t, RelaxedBarrierPenalty::Config> LeggedRobotInterface::loadFrictionConeSettings(const std::string& taskFile,
                                                                                                   bool verbose) const {
-  boost::property_tree::ptree pt;
-  boost::property_tree::read_info(taskFile, pt);
+  const auto ptPtr = loadData::readInfoFile(taskFile);
+  const boost::property_tree::ptree& pt = *ptPtr;
   const std::string prefix = "frictionConeSoftConstraint.";
 
   scalar_t frictionCoefficient = 1.0;
@@ -310,15 +374,17 @@ std::pair<scalar_t, RelaxedBarrierPenalty::Config> LeggedRobotInterface::loadFri
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-std::unique_ptr<StateInputCost> LeggedRobotInterface::getFrictionConeConstraint(size_t contactPointIndex, scalar_t frictionCoefficient,
-                                                                                const RelaxedBarrierPenalty::Config& barrierPenaltyConfig) {
-  FrictionConeConstraint::Config frictionConeConConfig(frictionCoefficient);
-  std::unique_ptr<FrictionConeConstraint> frictionConeConstraintPtr(
-      new FrictionConeConstraint(*referenceManagerPtr_, std::move(frictionConeConConfig), contactPointIndex, centroidalModelInfo_));
+std::unique_ptr<StateInputCost> LeggedRobotInterface::getFrictionConeCost(scalar_t frictionCoefficient,
+                                                                          const RelaxedBarrierPenalty::Config& barrierPenaltyConfig) {
+  const FrictionConeConstraint::Config frictionConeConConfig(frictionCoefficient);
+  std::vector<std::unique_ptr<FrictionConeConstraint>> frictionConeConstraints;
+  for (size_t i = 0; i < centroidalModelInfo_.numThreeDofContacts; i++) {
+    frictionConeConstraints.emplace_back(new FrictionConeConstraint(*referenceManagerPtr_, frictionConeConConfig, i, centroidalModelInfo_));
+  }
 
   std::unique_ptr<PenaltyBase> penalty(new RelaxedBarrierPenalty(barrierPenaltyConfig));
 
-  return std::unique_ptr<StateInputCost>(new StateInputSoftConstraint(std::move(frictionConeConstraintPtr), std::move(penalty)));
+  return std::unique_ptr<StateInputCost>(new FrictionConeCost(std::move(frictionConeConstraints), std::move(penalty)));
 }
 
 /******************************************************************************************************/
@@ -331,8 +397,7 @@ std::unique_ptr<StateInputConstraint> LeggedRobotInterface::getZeroForceConstrai
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-std::unique_ptr<StateInputConstraint> LeggedRobotInterface::getZeroVelocityConstraint(const EndEffectorKinematics<scalar_t>& eeKinematics,
-                                                                                      size_t contactPointIndex,
+std::unique_ptr<StateInputConstraint> LeggedRobotInterface::getZeroVelocityConstraint(size_t contactPointIndex,
                                                                                       bool useAnalyticalGradients) {
   auto eeZeroVelConConfig = [](scalar_t positionErrorGain) {
     EndEffectorLinearConstraint::Config config;
@@ -349,22 +414,21 @@ std::unique_ptr<StateInputConstraint> LeggedRobotInterface::getZeroVelocityConst
     throw std::runtime_error(
         "[LeggedRobotInterface::getZeroVelocityConstraint] The analytical end-effector zero velocity constraint is not implemented!");
   } else {
-    return std::unique_ptr<StateInputConstraint>(new ZeroVelocityConstraintCppAd(*referenceManagerPtr_, eeKinematics, contactPointIndex,
-                                                                                 eeZeroVelConConfig(modelSettings_.positionErrorGain)));
+    return std::unique_ptr<StateInputConstraint>(
+        new ZeroVelocityConstraintCppAd(*referenceManagerPtr_, contactPointIndex, eeZeroVelConConfig(modelSettings_.positionErrorGain)));
   }
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-std::unique_ptr<StateInputConstraint> LeggedRobotInterface::getNormalVelocityConstraint(const EndEffectorKinematics<scalar_t>& eeKinematics,
-                                                                                        size_t contactPointIndex,
+std::unique_ptr<StateInputConstraint> LeggedRobotInterface::getNormalVelocityConstraint(size_t contactPointIndex,
                                                                                         bool useAnalyticalGradients) {
   if (useAnalyticalGradients) {
     throw std::runtime_error(
         "[LeggedRobotInterface::getNormalVelocityConstraint] The analytical end-effector normal velocity constraint is not implemented!");
   } else {
-    return std::unique_ptr<StateInputConstraint>(new NormalVelocityConstraintCppAd(*referenceManagerPtr_, eeKinematics, contactPointIndex));
+    return std::unique_ptr<StateInputConstraint>(new NormalVelocityConstraintCppAd(*referenceManagerPtr_, contactPointIndex));
   }
 }
 
@@ -44,14 +44,28 @@ namespace legged_robot {
 /******************************************************************************************************/
 /******************************************************************************************************/
 LeggedRobotPreComputation::LeggedRobotPreComputation(PinocchioInterface pinocchioInterface, CentroidalModelInfo info,
-                                                     const SwingTrajectoryPlanner& swingTrajectoryPlanner, ModelSettings settings)
+                                                     const SwingTrajectoryPlanner& swingTrajectoryPlanner, ModelSettings settings,
+                                                     const PinocchioEndEffectorKinematicsCppAd* eeKinematicsPtr)
     : pinocchioInterface_(std::move(pinocchioInterface)),
       info_(std::move(info)),
       swingTrajectoryPlannerPtr_(&swingTrajectoryPlanner),
-      settings_(std::move(settings)) {
+      settings_(std::move(settings)),
+      eeKinematicsPtr_(eeKinematicsPtr != nullptr ? eeKinematicsPtr->clone() : nullptr) {
   eeNormalVelConConfigs_.resize(info_.numThreeDofContacts);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+LeggedRobotPreComputation::LeggedRobotPreComputation(const LeggedRobotPreComputation& other)
+    : PreComputation(other),
+      pinocchioInterface_(other.pinocchioInterface_),
+      info_(other.info_),
+      swingTrajectoryPlannerPtr_(other.swingTrajectoryPlannerPtr_),
+      settings_(other.settings_),
+      eeNormalVelConConfigs_(other.eeNormalVelConConfigs_),
+      eeKinematicsPtr_(other.eeKinematicsPtr_ != nullptr ? other.eeKinematicsPtr_->clone() : nullptr) {}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -67,21 +81,34 @@ void LeggedRobotPreComputation::request(RequestSet request, scalar_t t, const ve
     return;
   }
 
-  // lambda to set config for normal velocity constraints
-  auto eeNormalVelConConfig = [&](size_t footIndex) {
-    EndEffectorLinearConstraint::Config config;
-    config.b = (vector_t(1) << -swingTrajectoryPlannerPtr_->getZvelocityConstraint(footIndex, t)).finished();
-    config.Av = (matrix_t(1, 3) << 0.0, 0.0, 1.0).finished();
+  // lambda to set config for normal velocity constraints. The config is updated in place such that no memory is allocated after the
+  // first call.
+  auto setEeNormalVelConConfig = [&](size_t footIndex, EndEffectorLinearConstraint::Config& config) {
+    config.b.resize(1);
+    config.b(0) = -swingTrajectoryPlannerPtr_->getZvelocityConstraint(footIndex, t);
+    config.Av.resize(1, 3);
+    config.Av << 0.0, 0.0, 1.0;
     if (!numerics::almost_eq(settings_.positionErrorGain, 0.0)) {
       config.b(0) -= settings_.positionErrorGain * swingTrajectoryPlannerPtr_->getZpositionConstraint(footIndex, t);
-      config.Ax = (matrix_t(1, 3) << 0.0, 0.0, settings_.positionErrorGain).finished();
+      config.Ax.resize(1, 3);
+      config.Ax << 0.0, 0.0, settings_.positionErrorGain;
+    } else {
+      config.Ax.resize(0, 0);
     }
-    return config;
   };
 
   if (request.contains(Request::Constraint)) {
     for (size_t i = 0; i < info_.numThreeDofContacts; i++) {
-      eeNormalVelConConfigs_[i] = eeNormalVelConConfig(i);
+      setEeNormalVelConConfig(i, eeNormalVelConConfigs_[i]);
+    }
+
+    // a single evaluation for the foot constraints of all the contacts
+    if (eeKinematicsPtr_ != nullptr) {
+      if (request.contains(Request::Approximation)) {
+        eeKinematicsPtr_->getPositionAndVelocityLinearApproximation(x, u, eeKinematics_);
+      } else {
+        eeKinematicsPtr_->getPositionAndVelocity(x, u, eeKinematics_.f);
+      }
     }
   }
 }
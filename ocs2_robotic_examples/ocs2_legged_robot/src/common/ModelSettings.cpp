@@ -40,8 +40,8 @@ namespace legged_robot {
 ModelSettings loadModelSettings(const std::string& filename, const std::string& fieldName, bool verbose) {
   ModelSettings modelSettings;
 
-  boost::property_tree::ptree pt;
-  boost::property_tree::read_info(filename, pt);
+  const auto ptPtr = loadData::readInfoFile(filename);
+  const boost::property_tree::ptree& pt = *ptPtr;
 
   if (verbose) {
     std::cerr << "\n #### Legged Robot Model Settings:";
@@ -110,5 +110,44 @@ VectorFunctionLinearApproximation EndEffectorLinearConstraint::getLinearApproxim
   return linearApproximation;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t EndEffectorLinearConstraint::computeValue(const Config& config, const vector_t& kinematics, size_t positionRow,
+                                                   size_t velocityRow) {
+  vector_t f = config.b;
+  if (config.Ax.size() > 0) {
+    f.noalias() += config.Ax * kinematics.segment<3>(positionRow);
+  }
+  if (config.Av.size() > 0) {
+    f.noalias() += config.Av * kinematics.segment<3>(velocityRow);
+  }
+  return f;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+VectorFunctionLinearApproximation EndEffectorLinearConstraint::computeLinearApproximation(
+    const Config& config, const VectorFunctionLinearApproximation& kinematics, size_t positionRow, size_t velocityRow) {
+  VectorFunctionLinearApproximation linearApproximation =
+      VectorFunctionLinearApproximation::Zero(config.b.rows(), kinematics.dfdx.cols(), kinematics.dfdu.cols());
+
+  linearApproximation.f = config.b;
+
+  if (config.Ax.size() > 0) {
+    linearApproximation.f.noalias() += config.Ax * kinematics.f.segment<3>(positionRow);
+    linearApproximation.dfdx.noalias() += config.Ax * kinematics.dfdx.middleRows<3>(positionRow);
+  }
+
+  if (config.Av.size() > 0) {
+    linearApproximation.f.noalias() += config.Av * kinematics.f.segment<3>(velocityRow);
+    linearApproximation.dfdx.noalias() += config.Av * kinematics.dfdx.middleRows<3>(velocityRow);
+    linearApproximation.dfdu.noalias() += config.Av * kinematics.dfdu.middleRows<3>(velocityRow);
+  }
+
+  return linearApproximation;
+}
+
 }  // namespace legged_robot
 }  // namespace ocs2
@@ -113,6 +113,24 @@ VectorFunctionQuadraticApproximation FrictionConeConstraint::getQuadraticApproxi
   return quadraticApproximation;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+FrictionConeConstraint::ForceApproximation FrictionConeConstraint::getForceQuadraticApproximation(const vector_t& input) const {
+  const vector3_t forcesInWorldFrame = centroidal_model::getContactForces(input, contactPointIndex_, info_);
+  const vector3_t localForce = t_R_w * forcesInWorldFrame;
+
+  const auto localForceDerivatives = computeLocalForceDerivatives(forcesInWorldFrame);
+  const auto coneLocalDerivatives = computeConeLocalDerivatives(localForce);
+  const auto coneDerivatives = computeConeConstraintDerivatives(coneLocalDerivatives, localForceDerivatives);
+
+  ForceApproximation forceApproximation;
+  forceApproximation.f = coneConstraint(localForce)(0);
+  forceApproximation.dfdF = coneDerivatives.dCone_du;
+  forceApproximation.d2fdF2 = coneDerivatives.d2Cone_du2;
+  return forceApproximation;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
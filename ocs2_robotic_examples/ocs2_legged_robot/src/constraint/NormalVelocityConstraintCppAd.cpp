@@ -37,21 +37,8 @@ namespace legged_robot {
 /******************************************************************************************************/
 /******************************************************************************************************/
 NormalVelocityConstraintCppAd::NormalVelocityConstraintCppAd(const SwitchedModelReferenceManager& referenceManager,
-                                                             const EndEffectorKinematics<scalar_t>& endEffectorKinematics,
                                                              size_t contactPointIndex)
-    : StateInputConstraint(ConstraintOrder::Linear),
-      referenceManagerPtr_(&referenceManager),
-      eeLinearConstraintPtr_(new EndEffectorLinearConstraint(endEffectorKinematics, 1)),
-      contactPointIndex_(contactPointIndex) {}
-
-/******************************************************************************************************/
-/******************************************************************************************************/
-/******************************************************************************************************/
-NormalVelocityConstraintCppAd::NormalVelocityConstraintCppAd(const NormalVelocityConstraintCppAd& rhs)
-    : StateInputConstraint(rhs),
-      referenceManagerPtr_(rhs.referenceManagerPtr_),
-      eeLinearConstraintPtr_(rhs.eeLinearConstraintPtr_->clone()),
-      contactPointIndex_(rhs.contactPointIndex_) {}
+    : StateInputConstraint(ConstraintOrder::Linear), referenceManagerPtr_(&referenceManager), contactPointIndex_(contactPointIndex) {}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -66,9 +53,9 @@ bool NormalVelocityConstraintCppAd::isActive(scalar_t time) const {
 vector_t NormalVelocityConstraintCppAd::getValue(scalar_t time, const vector_t& state, const vector_t& input,
                                                  const PreComputation& preComp) const {
   const auto& preCompLegged = cast<LeggedRobotPreComputation>(preComp);
-  eeLinearConstraintPtr_->configure(preCompLegged.getEeNormalVelocityConstraintConfigs()[contactPointIndex_]);
-
-  return eeLinearConstraintPtr_->getValue(time, state, input, preComp);
+  return EndEffectorLinearConstraint::computeValue(preCompLegged.getEeNormalVelocityConstraintConfigs()[contactPointIndex_],
+                                                   preCompLegged.getEeKinematics().f, preCompLegged.getEePositionRow(contactPointIndex_),
+                                                   preCompLegged.getEeVelocityRow(contactPointIndex_));
 }
 
 /******************************************************************************************************/
@@ -78,9 +65,10 @@ VectorFunctionLinearApproximation NormalVelocityConstraintCppAd::getLinearApprox
                                                                                         const vector_t& input,
                                                                                         const PreComputation& preComp) const {
   const auto& preCompLegged = cast<LeggedRobotPreComputation>(preComp);
-  eeLinearConstraintPtr_->configure(preCompLegged.getEeNormalVelocityConstraintConfigs()[contactPointIndex_]);
-
-  return eeLinearConstraintPtr_->getLinearApproximation(time, state, input, preComp);
+  return EndEffectorLinearConstraint::computeLinearApproximation(preCompLegged.getEeNormalVelocityConstraintConfigs()[contactPointIndex_],
+                                                                 preCompLegged.getEeKinematics(),
+                                                                 preCompLegged.getEePositionRow(contactPointIndex_),
+                                                                 preCompLegged.getEeVelocityRow(contactPointIndex_));
 }
 
 }  // namespace legged_robot
@@ -28,6 +28,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
 #include "ocs2_legged_robot/constraint/ZeroVelocityConstraintCppAd.h"
+#include "ocs2_legged_robot/LeggedRobotPreComputation.h"
 
 namespace ocs2 {
 namespace legged_robot {
@@ -35,22 +36,16 @@ namespace legged_robot {
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-ZeroVelocityConstraintCppAd::ZeroVelocityConstraintCppAd(const SwitchedModelReferenceManager& referenceManager,
-                                                         const EndEffectorKinematics<scalar_t>& endEffectorKinematics,
-                                                         size_t contactPointIndex, EndEffectorLinearConstraint::Config config)
+ZeroVelocityConstraintCppAd::ZeroVelocityConstraintCppAd(const SwitchedModelReferenceManager& referenceManager, size_t contactPointIndex,
+                                                         EndEffectorLinearConstraint::Config config)
     : StateInputConstraint(ConstraintOrder::Linear),
       referenceManagerPtr_(&referenceManager),
-      eeLinearConstraintPtr_(new EndEffectorLinearConstraint(endEffectorKinematics, 3, std::move(config))),
-      contactPointIndex_(contactPointIndex) {}
-
-/******************************************************************************************************/
-/******************************************************************************************************/
-/******************************************************************************************************/
-ZeroVelocityConstraintCppAd::ZeroVelocityConstraintCppAd(const ZeroVelocityConstraintCppAd& rhs)
-    : StateInputConstraint(rhs),
-      referenceManagerPtr_(rhs.referenceManagerPtr_),
-      eeLinearConstraintPtr_(rhs.eeLinearConstraintPtr_->clone()),
-      contactPointIndex_(rhs.contactPointIndex_) {}
+      contactPointIndex_(contactPointIndex),
+      config_(std::move(config)) {
+  if (config_.b.rows() != 3) {
+    throw std::runtime_error("[ZeroVelocityConstraintCppAd] the constraint should have 3 rows!");
+  }
+}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -64,7 +59,10 @@ bool ZeroVelocityConstraintCppAd::isActive(scalar_t time) const {
 /******************************************************************************************************/
 vector_t ZeroVelocityConstraintCppAd::getValue(scalar_t time, const vector_t& state, const vector_t& input,
                                                const PreComputation& preComp) const {
-  return eeLinearConstraintPtr_->getValue(time, state, input, preComp);
+  const auto& preCompLegged = cast<LeggedRobotPreComputation>(preComp);
+  return EndEffectorLinearConstraint::computeValue(config_, preCompLegged.getEeKinematics().f,
+                                                   preCompLegged.getEePositionRow(contactPointIndex_),
+                                                   preCompLegged.getEeVelocityRow(contactPointIndex_));
 }
 
 /******************************************************************************************************/
@@ -73,7 +71,10 @@ vector_t ZeroVelocityConstraintCppAd::getValue(scalar_t time, const vector_t& st
 VectorFunctionLinearApproximation ZeroVelocityConstraintCppAd::getLinearApproximation(scalar_t time, const vector_t& state,
                                                                                       const vector_t& input,
                                                                                       const PreComputation& preComp) const {
-  return eeLinearConstraintPtr_->getLinearApproximation(time, state, input, preComp);
+  const auto& preCompLegged = cast<LeggedRobotPreComputation>(preComp);
+  return EndEffectorLinearConstraint::computeLinearApproximation(config_, preCompLegged.getEeKinematics(),
+                                                                 preCompLegged.getEePositionRow(contactPointIndex_),
+                                                                 preCompLegged.getEeVelocityRow(contactPointIndex_));
 }
 
 }  // namespace legged_robot
@@ -0,0 +1,119 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_legged_robot/cost/FrictionConeCost.h"
+
+namespace ocs2 {
+namespace legged_robot {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+FrictionConeCost::FrictionConeCost(std::vector<std::unique_ptr<FrictionConeConstraint>> constraints,
+                                   std::unique_ptr<PenaltyBase> penaltyPtr)
+    : constraints_(std::move(constraints)), penaltyPtr_(std::move(penaltyPtr)) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+FrictionConeCost::FrictionConeCost(const FrictionConeCost& other) : StateInputCost(other), penaltyPtr_(other.penaltyPtr_->clone()) {
+  constraints_.reserve(other.constraints_.size());
+  for (const auto& constraintPtr : other.constraints_) {
+    constraints_.emplace_back(constraintPtr->clone());
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool FrictionConeCost::isActive(scalar_t time) const {
+  for (const auto& constraintPtr : constraints_) {
+    if (constraintPtr->isActive(time)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t FrictionConeCost::getValue(scalar_t time, const vector_t& state, const vector_t& input, const TargetTrajectories&,
+                                    const PreComputation& preComp) const {
+  scalar_t cost = 0.0;
+  for (const auto& constraintPtr : constraints_) {
+    if (constraintPtr->isActive(time)) {
+      cost += penaltyPtr_->getValue(time, constraintPtr->getValue(time, state, input, preComp)(0));
+    }
+  }
+  return cost;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ScalarFunctionQuadraticApproximation FrictionConeCost::getQuadraticApproximation(scalar_t time, const vector_t& state,
+                                                                                 const vector_t& input,
+                                                                                 const TargetTrajectories& targetTrajectories,
+                                                                                 const PreComputation& preComp) const {
+  auto cost = ScalarFunctionQuadraticApproximation::Zero(state.size(), input.size());
+  accumulateQuadraticApproximation(time, state, input, targetTrajectories, preComp, cost);
+  return cost;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void FrictionConeCost::accumulateQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                        const TargetTrajectories&, const PreComputation&,
+                                                        ScalarFunctionQuadraticApproximation& accumulator) const {
+  for (const auto& constraintPtr : constraints_) {
+    if (!constraintPtr->isActive(time)) {
+      continue;
+    }
+
+    const auto h = constraintPtr->getForceQuadraticApproximation(input);
+    const scalar_t penaltyDerivative = penaltyPtr_->getDerivative(time, h.f);
+    const scalar_t penaltySecondDerivative = penaltyPtr_->getSecondDerivative(time, h.f);
+
+    const size_t forceIndex = 3 * constraintPtr->getContactPointIndex();
+    accumulator.f += penaltyPtr_->getValue(time, h.f);
+    accumulator.dfdu.segment<3>(forceIndex) += penaltyDerivative * h.dfdF;
+    accumulator.dfduu.block<3, 3>(forceIndex, forceIndex).noalias() +=
+        penaltySecondDerivative * h.dfdF * h.dfdF.transpose() + penaltyDerivative * h.d2fdF2;
+
+    // the Hessian diagonal shift of the constraint
+    const scalar_t diagonalShift = -penaltyDerivative * constraintPtr->getConfig().hessianDiagonalShift;
+    accumulator.dfdxx.diagonal().array() += diagonalShift;
+    accumulator.dfduu.diagonal().array() += diagonalShift;
+  }
+}
+
+}  // namespace legged_robot
+}  // namespace ocs2
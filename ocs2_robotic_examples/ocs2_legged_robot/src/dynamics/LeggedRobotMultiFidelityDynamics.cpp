@@ -0,0 +1,75 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_legged_robot/dynamics/LeggedRobotMultiFidelityDynamics.h"
+
+namespace ocs2 {
+namespace legged_robot {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+LeggedRobotMultiFidelityDynamics::LeggedRobotMultiFidelityDynamics(std::unique_ptr<SystemDynamicsBase> highFidelityDynamicsPtr,
+                                                                   std::unique_ptr<SystemDynamicsBase> lowFidelityDynamicsPtr,
+                                                                   const SwitchedModelReferenceManager& referenceManager,
+                                                                   scalar_t highFidelityHorizon)
+    : highFidelityDynamicsPtr_(std::move(highFidelityDynamicsPtr)),
+      lowFidelityDynamicsPtr_(std::move(lowFidelityDynamicsPtr)),
+      referenceManagerPtr_(&referenceManager),
+      highFidelityHorizon_(highFidelityHorizon) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+LeggedRobotMultiFidelityDynamics::LeggedRobotMultiFidelityDynamics(const LeggedRobotMultiFidelityDynamics& rhs)
+    : SystemDynamicsBase(rhs),
+      highFidelityDynamicsPtr_(rhs.highFidelityDynamicsPtr_->clone()),
+      lowFidelityDynamicsPtr_(rhs.lowFidelityDynamicsPtr_->clone()),
+      referenceManagerPtr_(rhs.referenceManagerPtr_),
+      highFidelityHorizon_(rhs.highFidelityHorizon_) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t LeggedRobotMultiFidelityDynamics::computeFlowMap(scalar_t time, const vector_t& state, const vector_t& input,
+                                                          const PreComputation& preComp) {
+  return getDynamics(time).computeFlowMap(time, state, input, preComp);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+VectorFunctionLinearApproximation LeggedRobotMultiFidelityDynamics::linearApproximation(scalar_t time, const vector_t& state,
+                                                                                        const vector_t& input,
+                                                                                        const PreComputation& preComp) {
+  return getDynamics(time).linearApproximation(time, state, input, preComp);
+}
+
+}  // namespace legged_robot
+}  // namespace ocs2
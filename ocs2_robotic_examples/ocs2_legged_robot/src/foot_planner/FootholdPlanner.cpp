@@ -0,0 +1,168 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_legged_robot/foot_planner/FootholdPlanner.h"
+
+#include <algorithm>
+
+#include <ocs2_centroidal_model/AccessHelperFunctions.h>
+#include <ocs2_core/misc/Lookup.h>
+
+#include "ocs2_legged_robot/gait/MotionPhaseDefinition.h"
+
+namespace ocs2 {
+namespace legged_robot {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t FootholdPlan::getContactHeight(size_t leg, scalar_t time, scalar_t defaultHeight) const {
+  const auto& legFootholds = footholds[leg];
+  if (legFootholds.empty()) {
+    return defaultHeight;
+  }
+  const auto it = std::upper_bound(legFootholds.begin(), legFootholds.end(), time,
+                                   [](scalar_t t, const Foothold& foothold) { return t < foothold.touchDownTime; });
+  return (it == legFootholds.begin()) ? it->position.z() : std::prev(it)->position.z();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+FootholdPlanner::FootholdPlanner(Config config, CentroidalModelInfo info, std::vector<vector3_t> nominalFootPositions)
+    : config_(std::move(config)), info_(std::move(info)), nominalFootPositions_(std::move(nominalFootPositions)) {
+  if (nominalFootPositions_.size() != info_.numThreeDofContacts) {
+    throw std::runtime_error("[FootholdPlanner] The number of nominal foot positions does not match the number of contacts!");
+  }
+  worker_ = std::thread(&FootholdPlanner::workerThread, this);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+FootholdPlanner::~FootholdPlanner() {
+  {
+    std::lock_guard<std::mutex> lock(requestMutex_);
+    terminateThread_ = true;
+  }
+  requestCondition_.notify_one();
+  if (worker_.joinable()) {
+    worker_.join();
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void FootholdPlanner::setTerrain(std::shared_ptr<const TerrainHeightMap> terrainPtr) {
+  {
+    std::lock_guard<std::mutex> lock(requestMutex_);
+    terrainBuffer_ = std::move(terrainPtr);
+    isUpdated_ = hasRequest_;
+  }
+  requestCondition_.notify_one();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void FootholdPlanner::request(scalar_t initTime, const ModeSchedule& modeSchedule, const TargetTrajectories& targetTrajectories) {
+  if (targetTrajectories.empty()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(requestMutex_);
+    initTimeBuffer_ = initTime;
+    modeScheduleBuffer_ = modeSchedule;
+    targetTrajectoriesBuffer_ = targetTrajectories;
+    hasRequest_ = true;
+    isUpdated_ = true;
+  }
+  requestCondition_.notify_one();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void FootholdPlanner::workerThread() {
+  while (true) {
+    std::shared_ptr<const TerrainHeightMap> terrainPtr;
+    {
+      std::unique_lock<std::mutex> lock(requestMutex_);
+      requestCondition_.wait(lock, [this] { return (isUpdated_ && terrainBuffer_ != nullptr) || terminateThread_; });
+      if (terminateThread_) {
+        return;
+      }
+      // the request is copied, since it is replanned on a new terrain
+      initTime_ = initTimeBuffer_;
+      modeSchedule_ = modeScheduleBuffer_;
+      targetTrajectories_ = targetTrajectoriesBuffer_;
+      terrainPtr = terrainBuffer_;
+      isUpdated_ = false;
+    }
+
+    plans_.back() = computePlan(*terrainPtr);
+    plans_.publish();
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+FootholdPlan FootholdPlanner::computePlan(const TerrainHeightMap& terrain) const {
+  const auto& eventTimes = modeSchedule_.eventTimes;
+  const auto& modeSequence = modeSchedule_.modeSequence;
+
+  // the nominal foothold at the base pose of the target trajectories
+  auto selectFoothold = [&](size_t leg, scalar_t time) {
+    const vector_t state = targetTrajectories_.getDesiredState(time);
+    const auto basePose = centroidal_model::getBasePose(state, info_);
+    const Eigen::Rotation2D<scalar_t> yawRotation(basePose(3));
+    const vector2_t nominalFoothold = basePose.head<2>() + yawRotation * nominalFootPositions_[leg].head<2>();
+    return FootholdPlan::Foothold{time, terrain.selectFoothold(nominalFoothold, config_.searchRadius)};
+  };
+
+  FootholdPlan plan;
+  const size_t initPhase = lookup::findIndexInTimeArray(eventTimes, initTime_);
+  for (size_t leg = 0; leg < info_.numThreeDofContacts; leg++) {
+    // the current contact, or the last one before the current swing
+    plan.footholds[leg].push_back(selectFoothold(leg, initTime_));
+
+    // the upcoming touch-downs
+    for (size_t p = initPhase + 1; p < modeSequence.size(); p++) {
+      if (modeNumber2StanceLeg(modeSequence[p])[leg] && !modeNumber2StanceLeg(modeSequence[p - 1])[leg]) {
+        plan.footholds[leg].push_back(selectFoothold(leg, eventTimes[p - 1]));
+      }
+    }
+  }
+  return plan;
+}
+
+}  // namespace legged_robot
+}  // namespace ocs2
@@ -27,11 +27,14 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
+#include <cmath>
+
 #include <boost/property_tree/info_parser.hpp>
 #include <boost/property_tree/ptree.hpp>
 
 #include "ocs2_legged_robot/foot_planner/SwingTrajectoryPlanner.h"
 
+#include <ocs2_core/misc/LoadData.h>
 #include <ocs2_core/misc/Lookup.h>
 
 #include "ocs2_legged_robot/gait/MotionPhaseDefinition.h"
@@ -48,16 +51,14 @@ SwingTrajectoryPlanner::SwingTrajectoryPlanner(Config config, size_t numFeet) :
 /******************************************************************************************************/
 /******************************************************************************************************/
 scalar_t SwingTrajectoryPlanner::getZvelocityConstraint(size_t leg, scalar_t time) const {
-  const auto index = lookup::findIndexInTimeArray(feetHeightTrajectoriesEvents_[leg], time);
-  return feetHeightTrajectories_[leg][index].velocity(time);
+  return feetHeightTrajectories_[leg][getPhaseIndex(time)].velocity(time);
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 scalar_t SwingTrajectoryPlanner::getZpositionConstraint(size_t leg, scalar_t time) const {
-  const auto index = lookup::findIndexInTimeArray(feetHeightTrajectoriesEvents_[leg], time);
-  return feetHeightTrajectories_[leg][index].position(time);
+  return feetHeightTrajectories_[leg][getPhaseIndex(time)].position(time);
 }
 
 /******************************************************************************************************/
@@ -113,8 +114,60 @@ void SwingTrajectoryPlanner::update(const ModeSchedule& modeSchedule, const feet
         feetHeightTrajectories_[j].emplace_back(liftOff, liftOffHeightSequence[j][p], touchDown);
       }
     }
-    feetHeightTrajectoriesEvents_[j] = eventTimes;
   }
+
+  updatePhaseIndexTable(eventTimes);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SwingTrajectoryPlanner::updatePhaseIndexTable(const scalar_array_t& eventTimes) {
+  constexpr size_t maxTableSize = 4096;
+
+  eventTimes_ = eventTimes;
+  phaseIndexTable_.clear();
+  if (eventTimes_.empty()) {
+    return;
+  }
+
+  const scalar_t timeSpan = eventTimes_.back() - eventTimes_.front();
+  scalar_t minPhaseDuration = timeSpan;
+  for (size_t i = 1; i < eventTimes_.size(); i++) {
+    const scalar_t phaseDuration = eventTimes_[i] - eventTimes_[i - 1];
+    if (phaseDuration > 0.0) {
+      minPhaseDuration = std::min(minPhaseDuration, phaseDuration);
+    }
+  }
+
+  phaseIndexTableStartTime_ = eventTimes_.front();
+  phaseIndexTableTimeStep_ = std::max(minPhaseDuration, timeSpan / static_cast<scalar_t>(maxTableSize - 1));
+  if (phaseIndexTableTimeStep_ <= 0.0) {
+    phaseIndexTableTimeStep_ = 1.0;
+  }
+  const auto tableSize = static_cast<size_t>(std::ceil(timeSpan / phaseIndexTableTimeStep_)) + 1;
+
+  phaseIndexTable_.reserve(tableSize);
+  for (size_t k = 0; k < tableSize; k++) {
+    const scalar_t bucketStartTime = phaseIndexTableStartTime_ + static_cast<scalar_t>(k) * phaseIndexTableTimeStep_;
+    phaseIndexTable_.push_back(lookup::findIndexInTimeArray(eventTimes_, bucketStartTime));
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t SwingTrajectoryPlanner::getPhaseIndex(scalar_t time) const {
+  if (phaseIndexTable_.empty() || time <= phaseIndexTableStartTime_) {
+    return 0;
+  }
+
+  const auto bucket = static_cast<size_t>((time - phaseIndexTableStartTime_) / phaseIndexTableTimeStep_);
+  size_t index = phaseIndexTable_[std::min(bucket, phaseIndexTable_.size() - 1)];
+  while (index < eventTimes_.size() && eventTimes_[index] < time) {
+    index++;
+  }
+  return index;
 }
 
 /******************************************************************************************************/
@@ -222,8 +275,8 @@ scalar_t SwingTrajectoryPlanner::swingTrajectoryScaling(scalar_t startTime, scal
 /******************************************************************************************************/
 /******************************************************************************************************/
 SwingTrajectoryPlanner::Config loadSwingTrajectorySettings(const std::string& fileName, const std::string& fieldName, bool verbose) {
-  boost::property_tree::ptree pt;
-  boost::property_tree::read_info(fileName, pt);
+  const auto ptPtr = loadData::readInfoFile(fileName);
+  const boost::property_tree::ptree& pt = *ptPtr;
 
   if (verbose) {
     std::cerr << "\n #### Swing Trajectory Config:";
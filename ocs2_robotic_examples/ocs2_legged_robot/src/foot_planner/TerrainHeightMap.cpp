@@ -0,0 +1,157 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_legged_robot/foot_planner/TerrainHeightMap.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include <ocs2_perceptive/interpolation/BilinearInterpolation.h>
+
+namespace ocs2 {
+namespace legged_robot {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TerrainHeightMap::TerrainHeightMap(Config config, const std::array<size_t, 2>& gridSize, scalar_t resolution, const vector2_t& origin,
+                                   std::vector<float> heights)
+    : config_(std::move(config)), gridSize_(gridSize), resolution_(resolution), origin_(origin), heights_(std::move(heights)) {
+  if (gridSize_[0] == 0 || gridSize_[1] == 0 || heights_.size() != gridSize_[0] * gridSize_[1]) {
+    throw std::runtime_error("[TerrainHeightMap] The number of heights does not match the grid size!");
+  }
+  if (resolution_ <= 0.0) {
+    throw std::runtime_error("[TerrainHeightMap] The resolution should be positive!");
+  }
+
+  // steppable samples
+  const auto radius = static_cast<int>(std::ceil(config_.footRadius / resolution_));
+  const scalar_t squaredRadius = std::pow(config_.footRadius / resolution_, 2);
+  const auto sizeX = static_cast<int>(gridSize_[0]);
+  const auto sizeY = static_cast<int>(gridSize_[1]);
+  steppable_.resize(heights_.size());
+  for (int iy = 0; iy < sizeY; iy++) {
+    for (int ix = 0; ix < sizeX; ix++) {
+      const float height = heights_[getIndex(ix, iy)];
+      bool isFlat = true;
+      for (int dy = std::max(-radius, -iy); dy <= std::min(radius, sizeY - 1 - iy) && isFlat; dy++) {
+        for (int dx = std::max(-radius, -ix); dx <= std::min(radius, sizeX - 1 - ix) && isFlat; dx++) {
+          if (dx * dx + dy * dy <= squaredRadius) {
+            isFlat = std::abs(heights_[getIndex(ix + dx, iy + dy)] - height) <= config_.maxUnevenness;
+          }
+        }
+      }
+      steppable_[getIndex(ix, iy)] = isFlat ? 1 : 0;
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t TerrainHeightMap::getHeight(const vector2_t& p) const {
+  // the position relative to the origin, projected onto the grid
+  vector2_t position;
+  std::array<size_t, 2> referenceIndices;
+  for (size_t axis = 0; axis < 2; axis++) {
+    const scalar_t maxPosition = static_cast<scalar_t>(gridSize_[axis] - 1) * resolution_;
+    position[axis] = std::min(std::max(p[axis] - origin_[axis], 0.0), maxPosition);
+    const auto index = static_cast<size_t>(position[axis] / resolution_);
+    referenceIndices[axis] = std::min(index, gridSize_[axis] > 1 ? gridSize_[axis] - 2 : 0);
+  }
+
+  const size_t ix = referenceIndices[0];
+  const size_t iy = referenceIndices[1];
+  const size_t ix1 = std::min(ix + 1, gridSize_[0] - 1);
+  const size_t iy1 = std::min(iy + 1, gridSize_[1] - 1);
+  const std::array<scalar_t, 4> cornerValues{heights_[getIndex(ix, iy)], heights_[getIndex(ix1, iy)], heights_[getIndex(ix, iy1)],
+                                             heights_[getIndex(ix1, iy1)]};
+  const vector2_t referenceCorner(static_cast<scalar_t>(ix) * resolution_, static_cast<scalar_t>(iy) * resolution_);
+
+  return bilinear_interpolation::getValue(resolution_, referenceCorner, cornerValues, position);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool TerrainHeightMap::isSteppable(const vector2_t& p) const {
+  const auto sample = getClosestSample(p);
+  return steppable_[getIndex(sample[0], sample[1])] != 0;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector3_t TerrainHeightMap::selectFoothold(const vector2_t& nominalFoothold, scalar_t searchRadius) const {
+  const auto center = getClosestSample(nominalFoothold);
+  const auto radius = static_cast<int>(std::ceil(searchRadius / resolution_));
+
+  scalar_t minSquaredDistance = searchRadius * searchRadius;
+  bool isFound = false;
+  std::array<size_t, 2> foothold = center;
+  for (int dy = -radius; dy <= radius; dy++) {
+    for (int dx = -radius; dx <= radius; dx++) {
+      const int ix = static_cast<int>(center[0]) + dx;
+      const int iy = static_cast<int>(center[1]) + dy;
+      if (ix < 0 || iy < 0 || ix >= static_cast<int>(gridSize_[0]) || iy >= static_cast<int>(gridSize_[1]) ||
+          steppable_[getIndex(ix, iy)] == 0) {
+        continue;
+      }
+      const vector2_t samplePosition = origin_ + resolution_ * vector2_t(ix, iy);
+      const scalar_t squaredDistance = (samplePosition - nominalFoothold).squaredNorm();
+      if (squaredDistance <= minSquaredDistance) {
+        minSquaredDistance = squaredDistance;
+        foothold = {static_cast<size_t>(ix), static_cast<size_t>(iy)};
+        isFound = true;
+      }
+    }
+  }
+
+  if (!isFound) {
+    return {nominalFoothold.x(), nominalFoothold.y(), getHeight(nominalFoothold)};
+  }
+  const vector2_t footholdPosition = origin_ + resolution_ * vector2_t(foothold[0], foothold[1]);
+  return {footholdPosition.x(), footholdPosition.y(), heights_[getIndex(foothold[0], foothold[1])]};
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::array<size_t, 2> TerrainHeightMap::getClosestSample(const vector2_t& p) const {
+  std::array<size_t, 2> indices;
+  for (size_t axis = 0; axis < 2; axis++) {
+    const scalar_t index = std::round((p[axis] - origin_[axis]) / resolution_);
+    indices[axis] = static_cast<size_t>(std::min(std::max(index, 0.0), static_cast<scalar_t>(gridSize_[axis] - 1)));
+  }
+  return indices;
+}
+
+}  // namespace legged_robot
+}  // namespace ocs2
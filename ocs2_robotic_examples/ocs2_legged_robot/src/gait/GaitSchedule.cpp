@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_legged_robot/gait/GaitSchedule.h"
 
+#include <algorithm>
+
 namespace ocs2 {
 namespace legged_robot {
 
@@ -70,35 +72,57 @@ void GaitSchedule::insertModeSequenceTemplate(const ModeSequenceTemplate& modeSe
 
   // tile the mode sequence template from startTime+phaseTransitionStanceTime to finalTime.
   tileModeSequenceTemplate(startTime + phaseTransitionStanceTime, finalTime);
+  modeScheduleChanged_ = true;
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 ModeSchedule GaitSchedule::getModeSchedule(scalar_t lowerBoundTime, scalar_t upperBoundTime) {
+  updateModeSchedule(lowerBoundTime, upperBoundTime);
+  return modeSchedule_;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool GaitSchedule::updateModeSchedule(scalar_t lowerBoundTime, scalar_t upperBoundTime) {
   auto& eventTimes = modeSchedule_.eventTimes;
   auto& modeSequence = modeSchedule_.modeSequence;
   const size_t index = std::lower_bound(eventTimes.begin(), eventTimes.end(), lowerBoundTime) - eventTimes.begin();
 
-  if (index > 0) {
-    // delete the old logic from index and set the default start phase to stance
+  if (index > 1) {
+    // delete the old logic before index
     eventTimes.erase(eventTimes.begin(), eventTimes.begin() + index - 1);  // keep the one before the last to make it stance
     modeSequence.erase(modeSequence.begin(), modeSequence.begin() + index - 1);
+    modeScheduleChanged_ = true;
+  }
 
-    // set the default initial phase
+  // set the default initial phase
+  if (index > 0 && modeSequence.front() != ModeNumber::STANCE) {
     modeSequence.front() = ModeNumber::STANCE;
+    modeScheduleChanged_ = true;
   }
 
-  // Start tiling at time
-  const auto tilingStartTime = eventTimes.empty() ? upperBoundTime : eventTimes.back();
+  // tile the template logic only if the mode schedule does not reach upperBoundTime
+  const bool hasTemplate = !modeSequenceTemplate_.modeSequence.empty();
+  if (hasTemplate && (eventTimes.empty() || eventTimes.back() < upperBoundTime)) {
+    // Start tiling at time
+    const auto tilingStartTime = eventTimes.empty() ? upperBoundTime : eventTimes.back();
 
-  // delete the last default stance phase
-  eventTimes.erase(eventTimes.end() - 1, eventTimes.end());
-  modeSequence.erase(modeSequence.end() - 1, modeSequence.end());
+    // delete the last default stance phase
+    if (!eventTimes.empty()) {
+      eventTimes.pop_back();
+      modeSequence.pop_back();
+    }
 
-  // tile the template logic
-  tileModeSequenceTemplate(tilingStartTime, upperBoundTime);
-  return modeSchedule_;
+    tileModeSequenceTemplate(tilingStartTime, upperBoundTime);
+    modeScheduleChanged_ = true;
+  }
+
+  const bool modeScheduleChanged = modeScheduleChanged_;
+  modeScheduleChanged_ = false;
+  return modeScheduleChanged;
 }
 
 /******************************************************************************************************/
@@ -136,5 +160,38 @@ void GaitSchedule::tileModeSequenceTemplate(scalar_t startTime, scalar_t finalTi
   modeSequence.push_back(ModeNumber::STANCE);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ModeSchedule shiftNextTouchDown(ModeSchedule modeSchedule, scalar_t time, scalar_t timeShift) {
+  auto& eventTimes = modeSchedule.eventTimes;
+  const auto& modeSequence = modeSchedule.modeSequence;
+
+  auto isTouchDown = [&](size_t eventIndex) {
+    const auto stanceLegsBefore = modeNumber2StanceLeg(modeSequence[eventIndex]);
+    const auto stanceLegsAfter = modeNumber2StanceLeg(modeSequence[eventIndex + 1]);
+    for (size_t leg = 0; leg < stanceLegsBefore.size(); leg++) {
+      if (!stanceLegsBefore[leg] && stanceLegsAfter[leg]) {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  const size_t firstIndex = std::distance(eventTimes.begin(), std::upper_bound(eventTimes.begin(), eventTimes.end(), time));
+  for (size_t i = firstIndex; i < eventTimes.size(); i++) {
+    if (isTouchDown(i)) {
+      const scalar_t lowerBound = (i > 0) ? std::max(eventTimes[i - 1], time) : time;
+      const scalar_t minTime = eventTimes[i] - 0.9 * (eventTimes[i] - lowerBound);
+      const scalar_t shiftedTime = std::max(eventTimes[i] + timeShift, minTime);
+      eventTimes[i] = (i + 1 < eventTimes.size()) ? std::min(shiftedTime, eventTimes[i] + 0.9 * (eventTimes[i + 1] - eventTimes[i]))
+                                                  : shiftedTime;
+      break;
+    }
+  }
+
+  return modeSchedule;
+}
+
 }  // namespace legged_robot
 }  // namespace ocs2
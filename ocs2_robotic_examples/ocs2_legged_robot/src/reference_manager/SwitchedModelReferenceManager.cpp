@@ -29,6 +29,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_legged_robot/reference_manager/SwitchedModelReferenceManager.h"
 
+#include <algorithm>
+#include <limits>
+
 namespace ocs2 {
 namespace legged_robot {
 
@@ -39,13 +42,41 @@ SwitchedModelReferenceManager::SwitchedModelReferenceManager(std::shared_ptr<Gai
                                                              std::shared_ptr<SwingTrajectoryPlanner> swingTrajectoryPtr)
     : ReferenceManager(TargetTrajectories(), ModeSchedule()),
       gaitSchedulePtr_(std::move(gaitSchedulePtr)),
-      swingTrajectoryPtr_(std::move(swingTrajectoryPtr)) {}
+      swingTrajectoryPtr_(std::move(swingTrajectoryPtr)),
+      contactFlagsSequence_(1, modeNumber2StanceLeg(0)) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+const contact_flag_t& SwitchedModelReferenceManager::getContactFlags(scalar_t time) const {
+  return contactFlagsSequence_[getModeScheduleLookup().getModeIndex(time)];
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SwitchedModelReferenceManager::preSolverRun(scalar_t initTime, scalar_t finalTime, const vector_t& initState) {
+  ReferenceManager::preSolverRun(initTime, finalTime, initState);
+
+  const auto& modeSequence = getModeScheduleLookup().getModeSchedule().modeSequence;
+  contactFlagsSequence_.resize(modeSequence.size());
+  std::transform(modeSequence.begin(), modeSequence.end(), contactFlagsSequence_.begin(), modeNumber2StanceLeg);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SwitchedModelReferenceManager::setModeSchedule(const ModeSchedule& modeSchedule) {
+  ReferenceManager::setModeSchedule(modeSchedule);
+  isModeScheduleSet_ = true;
+}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-contact_flag_t SwitchedModelReferenceManager::getContactFlags(scalar_t time) const {
-  return modeNumber2StanceLeg(this->getModeSchedule().modeAtTime(time));
+void SwitchedModelReferenceManager::setModeSchedule(ModeSchedule&& modeSchedule) {
+  ReferenceManager::setModeSchedule(std::move(modeSchedule));
+  isModeScheduleSet_ = true;
 }
 
 /******************************************************************************************************/
@@ -53,11 +84,69 @@ contact_flag_t SwitchedModelReferenceManager::getContactFlags(scalar_t time) con
 /******************************************************************************************************/
 void SwitchedModelReferenceManager::modifyReferences(scalar_t initTime, scalar_t finalTime, const vector_t& initState,
                                                      TargetTrajectories& targetTrajectories, ModeSchedule& modeSchedule) {
+  initTime_ = initTime;
   const auto timeHorizon = finalTime - initTime;
-  modeSchedule = gaitSchedulePtr_->getModeSchedule(initTime - timeHorizon, finalTime + timeHorizon);
 
+  // the mode schedule is only replaced if the gait schedule has changed, a mode schedule which has been set takes precedence
+  bool isModeScheduleUpdated = isModeScheduleSet_.exchange(false);
+  if (!isModeScheduleUpdated) {
+    isModeScheduleUpdated = gaitSchedulePtr_->updateModeSchedule(initTime - timeHorizon, finalTime + timeHorizon);
+    if (isModeScheduleUpdated) {
+      modeSchedule = gaitSchedulePtr_->getModeSchedule();
+    }
+  }
+
+  // the footholds of the new phases are selected asynchronously and used once they are available
+  bool isFootholdPlanUpdated = false;
+  if (footholdPlannerPtr_ != nullptr) {
+    if (isModeScheduleUpdated) {
+      footholdPlannerPtr_->request(initTime, modeSchedule, targetTrajectories);
+    }
+    isFootholdPlanUpdated = footholdPlannerPtr_->updateFromBuffer();
+  }
+
+  if (isModeScheduleUpdated || isFootholdPlanUpdated) {
+    updateSwingTrajectories(modeSchedule);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SwitchedModelReferenceManager::updateSwingTrajectories(const ModeSchedule& modeSchedule) {
   const scalar_t terrainHeight = 0.0;
-  swingTrajectoryPtr_->update(modeSchedule, terrainHeight);
+  if (footholdPlannerPtr_ == nullptr || footholdPlannerPtr_->getPlan().empty()) {
+    swingTrajectoryPtr_->update(modeSchedule, terrainHeight);
+    return;
+  }
+
+  const auto& footholdPlan = footholdPlannerPtr_->getPlan();
+  const auto& eventTimes = modeSchedule.eventTimes;
+  const auto& modeSequence = modeSchedule.modeSequence;
+  const size_t numPhases = modeSequence.size();
+
+  feet_array_t<scalar_array_t> liftOffHeightSequence;
+  feet_array_t<scalar_array_t> touchDownHeightSequence;
+  for (size_t leg = 0; leg < liftOffHeightSequence.size(); leg++) {
+    liftOffHeightSequence[leg].resize(numPhases);
+    touchDownHeightSequence[leg].resize(numPhases);
+    for (size_t p = 0; p < numPhases; p++) {
+      // the contact before a swing phase is the last one which has touched down before the phase starts
+      const scalar_t phaseStartTime = (p > 0) ? eventTimes[p - 1] : std::numeric_limits<scalar_t>::lowest();
+      liftOffHeightSequence[leg][p] = footholdPlan.getContactHeight(leg, phaseStartTime, terrainHeight);
+
+      // the contact after a swing phase touches down at the start of the next stance phase
+      size_t stancePhase = p + 1;
+      while (stancePhase < numPhases && !modeNumber2StanceLeg(modeSequence[stancePhase])[leg]) {
+        stancePhase++;
+      }
+      touchDownHeightSequence[leg][p] = (stancePhase < numPhases)
+                                            ? footholdPlan.getContactHeight(leg, eventTimes[stancePhase - 1], terrainHeight)
+                                            : liftOffHeightSequence[leg][p];
+    }
+  }
+
+  swingTrajectoryPtr_->update(modeSchedule, liftOffHeightSequence, touchDownHeightSequence);
 }
 
 }  // namespace legged_robot
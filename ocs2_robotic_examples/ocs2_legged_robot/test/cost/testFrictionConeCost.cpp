@@ -0,0 +1,98 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/penalties/penalties/RelaxedBarrierPenalty.h>
+#include <ocs2_core/soft_constraint/StateInputSoftConstraint.h>
+
+#include "ocs2_legged_robot/cost/FrictionConeCost.h"
+#include "ocs2_legged_robot/test/AnymalFactoryFunctions.h"
+
+using namespace ocs2;
+using namespace legged_robot;
+
+class TestFrictionConeCost : public testing::Test {
+ public:
+  TestFrictionConeCost() {
+    const FrictionConeConstraint::Config config;
+    const RelaxedBarrierPenalty::Config penaltyConfig(0.1, 5.0);
+
+    std::vector<std::unique_ptr<FrictionConeConstraint>> constraints;
+    for (size_t i = 0; i < centroidalModelInfo.numThreeDofContacts; i++) {
+      constraints.emplace_back(new FrictionConeConstraint(*referenceManagerPtr, config, i, centroidalModelInfo));
+      softConstraints.emplace_back(new StateInputSoftConstraint(std::unique_ptr<StateInputConstraint>(constraints.back()->clone()),
+                                                                std::unique_ptr<PenaltyBase>(new RelaxedBarrierPenalty(penaltyConfig))));
+    }
+    frictionConeCostPtr.reset(
+        new FrictionConeCost(std::move(constraints), std::unique_ptr<PenaltyBase>(new RelaxedBarrierPenalty(penaltyConfig))));
+  }
+
+  const CentroidalModelType centroidalModelType = CentroidalModelType::SingleRigidBodyDynamics;
+  std::unique_ptr<PinocchioInterface> pinocchioInterfacePtr = createAnymalPinocchioInterface();
+  const CentroidalModelInfo centroidalModelInfo = createAnymalCentroidalModelInfo(*pinocchioInterfacePtr, centroidalModelType);
+  const std::shared_ptr<SwitchedModelReferenceManager> referenceManagerPtr =
+      createReferenceManager(centroidalModelInfo.numThreeDofContacts);
+  const TargetTrajectories targetTrajectories;
+  PreComputation preComputation;
+
+  std::vector<std::unique_ptr<StateInputSoftConstraint>> softConstraints;
+  std::unique_ptr<FrictionConeCost> frictionConeCostPtr;
+};
+
+TEST_F(TestFrictionConeCost, equivalentToSoftConstraints) {
+  const std::unique_ptr<FrictionConeCost> costPtr(frictionConeCostPtr->clone());
+
+  for (const scalar_t t : {0.0, 0.3, 0.6, 0.9}) {
+    const vector_t x = 0.1 * vector_t::Random(centroidalModelInfo.stateDim);
+    vector_t u = 10.0 * vector_t::Random(centroidalModelInfo.inputDim);
+    for (size_t i = 0; i < centroidalModelInfo.numThreeDofContacts; i++) {
+      u(3 * i + 2) = 50.0;
+    }
+
+    scalar_t expectedValue = 0.0;
+    auto expectedApproximation = ScalarFunctionQuadraticApproximation::Zero(x.size(), u.size());
+    for (const auto& softConstraintPtr : softConstraints) {
+      if (softConstraintPtr->isActive(t)) {
+        expectedValue += softConstraintPtr->getValue(t, x, u, targetTrajectories, preComputation);
+        expectedApproximation += softConstraintPtr->getQuadraticApproximation(t, x, u, targetTrajectories, preComputation);
+      }
+    }
+
+    EXPECT_NEAR(costPtr->getValue(t, x, u, targetTrajectories, preComputation), expectedValue, 1e-9);
+
+    const auto approximation = costPtr->getQuadraticApproximation(t, x, u, targetTrajectories, preComputation);
+    EXPECT_NEAR(approximation.f, expectedApproximation.f, 1e-9);
+    EXPECT_TRUE(approximation.dfdx.isApprox(expectedApproximation.dfdx));
+    EXPECT_TRUE(approximation.dfdu.isApprox(expectedApproximation.dfdu));
+    EXPECT_TRUE(approximation.dfdxx.isApprox(expectedApproximation.dfdxx));
+    EXPECT_TRUE(approximation.dfdux.isApprox(expectedApproximation.dfdux));
+    EXPECT_TRUE(approximation.dfduu.isApprox(expectedApproximation.dfduu));
+  }
+}
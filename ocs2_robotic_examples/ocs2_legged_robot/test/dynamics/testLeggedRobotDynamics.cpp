@@ -0,0 +1,121 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <iostream>
+
+#include <ocs2_core/misc/Benchmark.h>
+
+#include "ocs2_legged_robot/common/ModelSettings.h"
+#include "ocs2_legged_robot/dynamics/LeggedRobotDynamics.h"
+#include "ocs2_legged_robot/dynamics/LeggedRobotDynamicsAD.h"
+#include "ocs2_legged_robot/dynamics/LeggedRobotMultiFidelityDynamics.h"
+#include "ocs2_legged_robot/test/AnymalFactoryFunctions.h"
+
+using namespace ocs2;
+using namespace legged_robot;
+
+class TestLeggedRobotDynamics : public ::testing::TestWithParam<CentroidalModelType> {
+ public:
+  TestLeggedRobotDynamics() { modelSettings.recompileLibrariesCppAd = false; }
+
+  ModelSettings modelSettings;
+  std::unique_ptr<PinocchioInterface> pinocchioInterfacePtr = createAnymalPinocchioInterface();
+  PreComputation preComputation;
+
+  static constexpr scalar_t tol = 1e-9;
+  static constexpr size_t numTests = 100;
+};
+
+constexpr scalar_t TestLeggedRobotDynamics::tol;
+constexpr size_t TestLeggedRobotDynamics::numTests;
+
+TEST_P(TestLeggedRobotDynamics, analyticalVsAutoDiff) {
+  const auto info = createAnymalCentroidalModelInfo(*pinocchioInterfacePtr, GetParam());
+  LeggedRobotDynamics dynamics(*pinocchioInterfacePtr, info);
+  LeggedRobotDynamicsAD dynamicsAd(*pinocchioInterfacePtr, info, "testLeggedRobotDynamics" + toString(GetParam()), modelSettings);
+  std::unique_ptr<LeggedRobotDynamics> dynamicsClonePtr(dynamics.clone());
+
+  benchmark::RepeatedTimer timer, timerAd;
+  for (size_t i = 0; i < numTests; i++) {
+    const scalar_t t = 0.0;
+    const vector_t x = vector_t::Random(info.stateDim);
+    const vector_t u = 100.0 * vector_t::Random(info.inputDim);
+
+    timer.startTimer();
+    const auto approx = dynamics.linearApproximation(t, x, u, preComputation);
+    timer.endTimer();
+    timerAd.startTimer();
+    const auto approxAd = dynamicsAd.linearApproximation(t, x, u, preComputation);
+    timerAd.endTimer();
+    const auto cloneApprox = dynamicsClonePtr->linearApproximation(t, x, u, preComputation);
+
+    EXPECT_TRUE(dynamics.computeFlowMap(t, x, u, preComputation).isApprox(approx.f, tol));
+    EXPECT_TRUE(approx.f.isApprox(approxAd.f, tol));
+    EXPECT_TRUE(approx.dfdx.isApprox(approxAd.dfdx, tol));
+    EXPECT_TRUE(approx.dfdu.isApprox(approxAd.dfdu, tol));
+    EXPECT_TRUE(approx.dfdx.isApprox(cloneApprox.dfdx));
+  }
+
+  std::cerr << "[TestLeggedRobotDynamics] " << toString(GetParam()) << " linear approximation, analytical: "
+            << timer.getAverageInMilliseconds() << " [ms], auto-differentiation: " << timerAd.getAverageInMilliseconds() << " [ms]\n";
+}
+
+INSTANTIATE_TEST_CASE_P(TestLeggedRobotDynamicsWithParam, TestLeggedRobotDynamics,
+                        testing::ValuesIn({CentroidalModelType::FullCentroidalDynamics, CentroidalModelType::SingleRigidBodyDynamics}),
+                        [](const testing::TestParamInfo<TestLeggedRobotDynamics::ParamType>& info) { return toString(info.param); });
+
+TEST(TestLeggedRobotMultiFidelityDynamics, switchAfterHorizon) {
+  const auto pinocchioInterfacePtr = createAnymalPinocchioInterface();
+  const auto fullInfo = createAnymalCentroidalModelInfo(*pinocchioInterfacePtr, CentroidalModelType::FullCentroidalDynamics);
+  const auto srbdInfo = createAnymalCentroidalModelInfo(*pinocchioInterfacePtr, CentroidalModelType::SingleRigidBodyDynamics);
+  const auto referenceManagerPtr = createReferenceManager(fullInfo.numThreeDofContacts);
+  const PreComputation preComputation;
+
+  // the initial time of the reference manager is zero before the first MPC iteration
+  constexpr scalar_t highFidelityHorizon = 0.5;
+  LeggedRobotDynamics fullDynamics(*pinocchioInterfacePtr, fullInfo);
+  LeggedRobotDynamics srbdDynamics(*pinocchioInterfacePtr, srbdInfo);
+  LeggedRobotMultiFidelityDynamics dynamics(std::unique_ptr<SystemDynamicsBase>(fullDynamics.clone()),
+                                            std::unique_ptr<SystemDynamicsBase>(srbdDynamics.clone()), *referenceManagerPtr,
+                                            highFidelityHorizon);
+  std::unique_ptr<LeggedRobotMultiFidelityDynamics> dynamicsClonePtr(dynamics.clone());
+
+  const vector_t x = vector_t::Random(fullInfo.stateDim);
+  const vector_t u = 100.0 * vector_t::Random(fullInfo.inputDim);
+  for (const scalar_t t : {0.0, 0.2, 0.8}) {
+    auto& expectedDynamics = (t < highFidelityHorizon) ? fullDynamics : srbdDynamics;
+    const auto expectedApprox = expectedDynamics.linearApproximation(t, x, u, preComputation);
+    const auto approx = dynamics.linearApproximation(t, x, u, preComputation);
+    EXPECT_TRUE(dynamics.computeFlowMap(t, x, u, preComputation).isApprox(expectedApprox.f));
+    EXPECT_TRUE(approx.dfdx.isApprox(expectedApprox.dfdx));
+    EXPECT_TRUE(approx.dfdu.isApprox(expectedApprox.dfdu));
+    EXPECT_TRUE(dynamicsClonePtr->linearApproximation(t, x, u, preComputation).dfdx.isApprox(expectedApprox.dfdx));
+  }
+}
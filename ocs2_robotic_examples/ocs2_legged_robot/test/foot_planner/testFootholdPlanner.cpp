@@ -0,0 +1,124 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+#include <ocs2_centroidal_model/AccessHelperFunctions.h>
+
+#include "ocs2_legged_robot/foot_planner/FootholdPlanner.h"
+#include "ocs2_legged_robot/foot_planner/TerrainHeightMap.h"
+#include "ocs2_legged_robot/gait/MotionPhaseDefinition.h"
+#include "ocs2_legged_robot/test/AnymalFactoryFunctions.h"
+
+using namespace ocs2;
+using namespace legged_robot;
+
+namespace {
+
+/** A 2m x 2m terrain with a step of the given height at x = 1.0. */
+std::shared_ptr<TerrainHeightMap> createStepTerrain(scalar_t stepHeight) {
+  constexpr scalar_t resolution = 0.02;
+  const std::array<size_t, 2> gridSize{101, 101};
+  std::vector<float> heights(gridSize[0] * gridSize[1]);
+  for (size_t iy = 0; iy < gridSize[1]; iy++) {
+    for (size_t ix = 0; ix < gridSize[0]; ix++) {
+      heights[ix + gridSize[0] * iy] = (ix * resolution < 1.0) ? 0.0 : stepHeight;
+    }
+  }
+  return std::make_shared<TerrainHeightMap>(TerrainHeightMap::Config(), gridSize, resolution, vector2_t::Zero(), std::move(heights));
+}
+
+}  // unnamed namespace
+
+TEST(TestTerrainHeightMap, stepTerrain) {
+  const TerrainHeightMap::Config config;
+  const auto terrainPtr = createStepTerrain(0.2);
+
+  EXPECT_NEAR(terrainPtr->getHeight(vector2_t(0.5, 0.5)), 0.0, 1e-6);
+  EXPECT_NEAR(terrainPtr->getHeight(vector2_t(1.5, 0.5)), 0.2, 1e-6);
+  EXPECT_NEAR(terrainPtr->getHeight(vector2_t(0.99, 0.5)), 0.1, 1e-6);
+  EXPECT_NEAR(terrainPtr->getHeight(vector2_t(5.0, 5.0)), 0.2, 1e-6);  // projected onto the grid
+
+  EXPECT_TRUE(terrainPtr->isSteppable(vector2_t(0.5, 0.5)));
+  EXPECT_TRUE(terrainPtr->isSteppable(vector2_t(1.5, 0.5)));
+  EXPECT_FALSE(terrainPtr->isSteppable(vector2_t(1.0, 0.5)));
+
+  // a nominal foothold on the edge is moved onto one of the flat sides
+  const vector3_t foothold = terrainPtr->selectFoothold(vector2_t(0.99, 0.5), 0.15);
+  EXPECT_GE(std::abs(foothold.x() - 0.99), config.footRadius - 0.02);
+  EXPECT_LE((foothold.head<2>() - vector2_t(0.99, 0.5)).norm(), 0.15);
+  EXPECT_TRUE(terrainPtr->isSteppable(foothold.head<2>()));
+  EXPECT_NEAR(foothold.z(), terrainPtr->getHeight(foothold.head<2>()), 1e-6);
+
+  // a steppable nominal foothold is kept
+  const vector3_t flatFoothold = terrainPtr->selectFoothold(vector2_t(0.5, 0.5), 0.15);
+  EXPECT_TRUE(flatFoothold.head<2>().isApprox(vector2_t(0.5, 0.5)));
+}
+
+TEST(TestFootholdPlanner, touchDowns) {
+  const auto pinocchioInterfacePtr = createAnymalPinocchioInterface();
+  const auto info = createAnymalCentroidalModelInfo(*pinocchioInterfacePtr, CentroidalModelType::SingleRigidBodyDynamics);
+
+  // the feet are placed 0.3m in front of and behind the base
+  std::vector<vector3_t> nominalFootPositions{vector3_t(0.3, 0.2, -0.5), vector3_t(0.3, -0.2, -0.5), vector3_t(-0.3, 0.2, -0.5),
+                                              vector3_t(-0.3, -0.2, -0.5)};
+  FootholdPlanner footholdPlanner(FootholdPlanner::Config(), info, nominalFootPositions);
+  EXPECT_TRUE(footholdPlanner.getPlan().empty());
+
+  // the base stands at (0.4, 0.5) with the front feet on the step
+  vector_t state = vector_t::Zero(info.stateDim);
+  centroidal_model::getBasePose(state, info).head<2>() << 0.8, 0.5;
+  const TargetTrajectories targetTrajectories({0.0}, {state}, {vector_t::Zero(info.inputDim)});
+  const ModeSchedule modeSchedule({0.0, 0.3, 0.35, 0.65, 0.7}, {STANCE, LF_RH, STANCE, RF_LH, STANCE, STANCE});
+
+  footholdPlanner.request(0.0, modeSchedule, targetTrajectories);
+  footholdPlanner.setTerrain(createStepTerrain(0.2));
+
+  const auto startTime = std::chrono::steady_clock::now();
+  while (!footholdPlanner.updateFromBuffer()) {
+    ASSERT_LT(std::chrono::steady_clock::now() - startTime, std::chrono::seconds(5));
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  const auto& plan = footholdPlanner.getPlan();
+  const feet_array_t<scalar_t> expectedHeights{0.2, 0.2, 0.0, 0.0};
+  for (size_t leg = 0; leg < info.numThreeDofContacts; leg++) {
+    // the current contact and one touch-down
+    ASSERT_EQ(plan.footholds[leg].size(), 2);
+    EXPECT_DOUBLE_EQ(plan.footholds[leg][0].touchDownTime, 0.0);
+    EXPECT_DOUBLE_EQ(plan.footholds[leg][1].touchDownTime, (leg == 1 || leg == 2) ? 0.3 : 0.65);
+    for (const auto& foothold : plan.footholds[leg]) {
+      EXPECT_NEAR(foothold.position.z(), expectedHeights[leg], 1e-6) << "leg: " << leg;
+    }
+    EXPECT_NEAR(plan.getContactHeight(leg, 0.5, 0.0), expectedHeights[leg], 1e-6);
+  }
+}
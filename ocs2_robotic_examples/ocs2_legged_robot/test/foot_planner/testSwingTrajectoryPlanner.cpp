@@ -0,0 +1,87 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/misc/Lookup.h>
+
+#include "ocs2_legged_robot/foot_planner/SwingTrajectoryPlanner.h"
+#include "ocs2_legged_robot/gait/MotionPhaseDefinition.h"
+
+using namespace ocs2;
+using namespace legged_robot;
+
+class TestSwingTrajectoryPlanner : public ::testing::Test {
+ public:
+  TestSwingTrajectoryPlanner() : swingTrajectoryPlanner(config, 4) {
+    modeSchedule.eventTimes = {0.0, 0.3, 0.35, 0.65, 0.7, 1.0};
+    modeSchedule.modeSequence = {STANCE, LF_RH, STANCE, RF_LH, STANCE, LF_RH, STANCE};
+    swingTrajectoryPlanner.update(modeSchedule, terrainHeight);
+  }
+
+  /** The reference height of the given foot based on a binary search in the event times. */
+  scalar_t expectedPosition(size_t leg, scalar_t time) const {
+    const auto phase = lookup::findIndexInTimeArray(modeSchedule.eventTimes, time);
+    const auto stanceLegs = modeNumber2StanceLeg(modeSchedule.modeSequence[phase]);
+    if (stanceLegs[leg]) {
+      return terrainHeight;
+    }
+    const scalar_t startTime = modeSchedule.eventTimes[phase - 1];
+    const scalar_t finalTime = modeSchedule.eventTimes[phase];
+    const SplineCpg spline({startTime, terrainHeight, 0.0}, terrainHeight + config.swingHeight, {finalTime, terrainHeight, 0.0});
+    return spline.position(time);
+  }
+
+  const SwingTrajectoryPlanner::Config config{};
+  const scalar_t terrainHeight = 0.1;
+  ModeSchedule modeSchedule;
+  SwingTrajectoryPlanner swingTrajectoryPlanner;
+};
+
+TEST_F(TestSwingTrajectoryPlanner, midSwingHeight) {
+  // RF and LH swing in [0.0, 0.3]
+  EXPECT_NEAR(swingTrajectoryPlanner.getZpositionConstraint(1, 0.15), terrainHeight + config.swingHeight, 1e-9);
+  EXPECT_NEAR(swingTrajectoryPlanner.getZpositionConstraint(2, 0.15), terrainHeight + config.swingHeight, 1e-9);
+  EXPECT_NEAR(swingTrajectoryPlanner.getZpositionConstraint(0, 0.15), terrainHeight, 1e-9);
+  EXPECT_NEAR(swingTrajectoryPlanner.getZvelocityConstraint(0, 0.15), 0.0, 1e-9);
+}
+
+TEST_F(TestSwingTrajectoryPlanner, phaseLookup) {
+  // includes the times before the first event, on the events, and after the last event
+  scalar_array_t times = modeSchedule.eventTimes;
+  for (scalar_t t = -0.2; t < 1.2; t += 0.0137) {
+    times.push_back(t);
+  }
+
+  for (const auto t : times) {
+    for (size_t leg = 0; leg < 4; leg++) {
+      EXPECT_NEAR(swingTrajectoryPlanner.getZpositionConstraint(leg, t), expectedPosition(leg, t), 1e-9) << "leg: " << leg << ", t: " << t;
+    }
+  }
+}
@@ -0,0 +1,92 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "ocs2_legged_robot/gait/GaitSchedule.h"
+
+using namespace ocs2;
+using namespace legged_robot;
+
+class TestGaitSchedule : public ::testing::Test {
+ public:
+  TestGaitSchedule()
+      : gaitSchedule(ModeSchedule({0.5}, {STANCE, STANCE}), ModeSequenceTemplate({0.0, 0.3, 0.6}, {LF_RH, RF_LH}), 0.2) {}
+
+  GaitSchedule gaitSchedule;
+};
+
+TEST_F(TestGaitSchedule, incrementalUpdate) {
+  ASSERT_TRUE(gaitSchedule.updateModeSchedule(0.0, 2.0));
+  const auto modeSchedule = gaitSchedule.getModeSchedule();
+  EXPECT_GE(modeSchedule.eventTimes.back(), 2.0);
+  EXPECT_EQ(modeSchedule.modeSequence.size(), modeSchedule.eventTimes.size() + 1);
+
+  // the schedule already covers the requested time interval
+  EXPECT_FALSE(gaitSchedule.updateModeSchedule(0.0, 2.0));
+  EXPECT_FALSE(gaitSchedule.updateModeSchedule(0.1, 1.9));
+  EXPECT_EQ(gaitSchedule.getModeSchedule().eventTimes, modeSchedule.eventTimes);
+  EXPECT_EQ(gaitSchedule.getModeSchedule().modeSequence, modeSchedule.modeSequence);
+
+  // the future phases are appended and the elapsed ones are dropped
+  ASSERT_TRUE(gaitSchedule.updateModeSchedule(1.5, 4.0));
+  const auto& updatedModeSchedule = gaitSchedule.getModeSchedule();
+  EXPECT_GE(updatedModeSchedule.eventTimes.back(), 4.0);
+  EXPECT_LT(updatedModeSchedule.eventTimes.front(), 1.5);
+  EXPECT_GE(updatedModeSchedule.eventTimes[1], 1.5);
+  EXPECT_EQ(updatedModeSchedule.modeSequence.front(), STANCE);
+  EXPECT_EQ(updatedModeSchedule.modeSequence.back(), STANCE);
+  EXPECT_EQ(updatedModeSchedule.modeSequence.size(), updatedModeSchedule.eventTimes.size() + 1);
+  for (scalar_t t = 1.55; t < modeSchedule.eventTimes.back(); t += 0.1) {
+    EXPECT_EQ(updatedModeSchedule.modeAtTime(t), modeSchedule.modeAtTime(t)) << "t: " << t;
+  }
+
+  // a new gait changes the schedule
+  gaitSchedule.insertModeSequenceTemplate(ModeSequenceTemplate({0.0, 1.0}, {STANCE}), 2.5, 4.0);
+  EXPECT_TRUE(gaitSchedule.updateModeSchedule(1.5, 4.0));
+  EXPECT_FALSE(gaitSchedule.updateModeSchedule(1.5, 4.0));
+}
+
+TEST(testContingencyModeSchedule, shiftNextTouchDown) {
+  // RF and LH lift off at 0.2 and touch down at 0.5, LF and RH lift off at 0.8
+  const ModeSchedule modeSchedule({0.2, 0.5, 0.8}, {STANCE, LF_RH, STANCE, RF_LH});
+
+  const auto earlyTouchDown = shiftNextTouchDown(modeSchedule, 0.0, -0.1);
+  EXPECT_EQ(earlyTouchDown.modeSequence, modeSchedule.modeSequence);
+  EXPECT_DOUBLE_EQ(earlyTouchDown.eventTimes[0], 0.2);
+  EXPECT_DOUBLE_EQ(earlyTouchDown.eventTimes[1], 0.4);
+  EXPECT_DOUBLE_EQ(earlyTouchDown.eventTimes[2], 0.8);
+
+  // the neighboring phases keep 10% of their duration
+  EXPECT_DOUBLE_EQ(shiftNextTouchDown(modeSchedule, 0.0, -1.0).eventTimes[1], 0.23);
+  EXPECT_DOUBLE_EQ(shiftNextTouchDown(modeSchedule, 0.0, 1.0).eventTimes[1], 0.77);
+
+  // there is no touchdown after the given time
+  EXPECT_EQ(shiftNextTouchDown(modeSchedule, 0.6, -0.1).eventTimes, modeSchedule.eventTimes);
+}
@@ -32,6 +32,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <robot_state_publisher/robot_state_publisher.h>
 #include <ros/node_handle.h>
 #include <tf/transform_broadcaster.h>
+#include <visualization_msgs/MarkerArray.h>
 
 #include <ocs2_centroidal_model/CentroidalModelInfo.h>
 #include <ocs2_core/Types.h>
@@ -102,6 +103,11 @@ class LeggedRobotVisualizer : public DummyObserver {
 
   ros::Publisher currentStatePublisher_;
 
+  // Message storage which is reused between the updates
+  visualization_msgs::Marker desiredBaseLineMsg_;
+  std::vector<visualization_msgs::Marker> desiredFeetLineMsgs_;
+  visualization_msgs::MarkerArray optimizedStateMarkerArray_;
+
   scalar_t lastTime_;
   scalar_t minPublishTimeDifference_;
 };
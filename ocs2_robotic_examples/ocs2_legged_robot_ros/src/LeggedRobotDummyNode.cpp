@@ -35,6 +35,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_pinocchio_interface/PinocchioEndEffectorKinematics.h>
 #include <ocs2_ros_interfaces/mrt/MRT_ROS_Dummy_Loop.h>
 #include <ocs2_ros_interfaces/mrt/MRT_ROS_Interface.h>
+#include <ocs2_ros_interfaces/visualization/AsyncVisualizer.h>
 
 #include "ocs2_legged_robot_ros/visualization/LeggedRobotVisualizer.h"
 
@@ -59,6 +60,7 @@ int main(int argc, char** argv) {
   // MRT
   MRT_ROS_Interface mrt(robotName);
   mrt.initRollout(&interface.getRollout());
+  mrt.enableLatencyMetrics(0.01);  // 10 ms from the observation to the actuation
   mrt.launchNodes(nodeHandle);
 
   // Visualization
@@ -67,11 +69,13 @@ int main(int argc, char** argv) {
                                                        interface.modelSettings().contactNames3DoF);
   std::shared_ptr<LeggedRobotVisualizer> leggedRobotVisualizer(
       new LeggedRobotVisualizer(interface.getPinocchioInterface(), interface.getCentroidalModelInfo(), endEffectorKinematics, nodeHandle));
+  // the markers are built on a low-priority thread from the time-decimated solution
+  std::shared_ptr<AsyncVisualizer> asyncVisualizer(new AsyncVisualizer(AsyncVisualizer::Settings(), {leggedRobotVisualizer}));
 
   // Dummy legged robot
   MRT_ROS_Dummy_Loop leggedRobotDummySimulator(mrt, interface.mpcSettings().mrtDesiredFrequency_,
                                                interface.mpcSettings().mpcDesiredFrequency_);
-  leggedRobotDummySimulator.subscribeObservers({leggedRobotVisualizer});
+  leggedRobotDummySimulator.subscribeObservers({asyncVisualizer});
 
   // Initial state
   SystemObservation initObservation;
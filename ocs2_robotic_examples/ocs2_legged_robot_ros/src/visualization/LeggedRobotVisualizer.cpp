@@ -216,58 +216,43 @@ void LeggedRobotVisualizer::publishCartesianMarkers(ros::Time timeStamp, const c
 /******************************************************************************************************/
 void LeggedRobotVisualizer::publishDesiredTrajectory(ros::Time timeStamp, const TargetTrajectories& targetTrajectories) {
   const auto& stateTrajectory = targetTrajectories.stateTrajectory;
-  const auto& inputTrajectory = targetTrajectories.inputTrajectory;
 
-  // Reserve com messages
-  std::vector<geometry_msgs::Point> desiredBasePositionMsg;
-  desiredBasePositionMsg.reserve(stateTrajectory.size());
-
-  // Reserve feet messages
-  feet_array_t<std::vector<geometry_msgs::Point>> desiredFeetPositionMsgs;
-  for (size_t i = 0; i < centroidalModelInfo_.numThreeDofContacts; i++) {
-    desiredFeetPositionMsgs[i].reserve(stateTrajectory.size());
+  // The line messages are members such that the storage of their points is reused
+  desiredBaseLineMsg_.points.resize(stateTrajectory.size());
+  desiredFeetLineMsgs_.resize(centroidalModelInfo_.numThreeDofContacts);
+  for (auto& footLineMsg : desiredFeetLineMsgs_) {
+    footLineMsg.points.resize(stateTrajectory.size());
   }
 
+  const auto& model = pinocchioInterface_.getModel();
+  auto& data = pinocchioInterface_.getData();
   for (size_t j = 0; j < stateTrajectory.size(); j++) {
-    const auto state = stateTrajectory.at(j);
-    vector_t input(centroidalModelInfo_.inputDim);
-    if (j < inputTrajectory.size()) {
-      input = inputTrajectory.at(j);
-    } else {
-      input.setZero();
-    }
+    const auto& state = stateTrajectory[j];
 
-    // Construct base pose msg
+    // Fill base msg
     const auto basePose = centroidal_model::getBasePose(state, centroidalModelInfo_);
-    geometry_msgs::Pose pose;
-    pose.position = getPointMsg(basePose.head<3>());
-
-    // Fill message containers
-    desiredBasePositionMsg.push_back(pose.position);
+    desiredBaseLineMsg_.points[j] = getPointMsg(basePose.head<3>());
 
     // Fill feet msgs
-    const auto& model = pinocchioInterface_.getModel();
-    auto& data = pinocchioInterface_.getData();
     pinocchio::forwardKinematics(model, data, centroidal_model::getGeneralizedCoordinates(state, centroidalModelInfo_));
     pinocchio::updateFramePlacements(model, data);
 
     const auto feetPositions = endEffectorKinematicsPtr_->getPosition(state);
     for (size_t i = 0; i < centroidalModelInfo_.numThreeDofContacts; i++) {
-      geometry_msgs::Pose footPose;
-      footPose.position = getPointMsg(feetPositions[i]);
-      desiredFeetPositionMsgs[i].push_back(footPose.position);
+      desiredFeetLineMsgs_[i].points[j] = getPointMsg(feetPositions[i]);
     }
   }
 
   // Headers
-  auto comLineMsg = getLineMsg(std::move(desiredBasePositionMsg), Color::green, trajectoryLineWidth_);
-  comLineMsg.header = getHeaderMsg(frameId_, timeStamp);
-  comLineMsg.id = 0;
+  setLineMsgProperties(desiredBaseLineMsg_, Color::green, trajectoryLineWidth_);
+  desiredBaseLineMsg_.header = getHeaderMsg(frameId_, timeStamp);
+  desiredBaseLineMsg_.id = 0;
 
   // Publish
-  costDesiredBasePositionPublisher_.publish(comLineMsg);
+  costDesiredBasePositionPublisher_.publish(desiredBaseLineMsg_);
   for (size_t i = 0; i < centroidalModelInfo_.numThreeDofContacts; i++) {
-    auto footLineMsg = getLineMsg(std::move(desiredFeetPositionMsgs[i]), feetColorMap_[i], trajectoryLineWidth_);
+    auto& footLineMsg = desiredFeetLineMsgs_[i];
+    setLineMsgProperties(footLineMsg, feetColorMap_[i], trajectoryLineWidth_);
     footLineMsg.header = getHeaderMsg(frameId_, timeStamp);
     footLineMsg.id = 0;
     costDesiredFeetPositionPublishers_[i].publish(footLineMsg);
@@ -283,55 +268,53 @@ void LeggedRobotVisualizer::publishOptimizedStateTrajectory(ros::Time timeStamp,
     return;  // Nothing to publish
   }
 
-  // Reserve Feet msg
-  feet_array_t<std::vector<geometry_msgs::Point>> feetMsgs;
-  std::for_each(feetMsgs.begin(), feetMsgs.end(), [&](std::vector<geometry_msgs::Point>& v) { v.reserve(mpcStateTrajectory.size()); });
-
-  // Reserve Com Msg
-  std::vector<geometry_msgs::Point> mpcComPositionMsgs;
-  mpcComPositionMsgs.reserve(mpcStateTrajectory.size());
+  // The marker array is a member such that the storage of the points is reused.
+  // 1 trajectory per foot + 1 for the com trajectory + 1 for the future footholds
+  const size_t comMarkerIndex = centroidalModelInfo_.numThreeDofContacts;
+  const size_t footholdMarkerIndex = comMarkerIndex + 1;
+  auto& markers = optimizedStateMarkerArray_.markers;
+  markers.resize(footholdMarkerIndex + 1);
+  for (size_t i = 0; i <= comMarkerIndex; i++) {
+    markers[i].points.resize(mpcStateTrajectory.size());
+  }
 
   // Extract Com and Feet from state
-  std::for_each(mpcStateTrajectory.begin(), mpcStateTrajectory.end(), [&](const vector_t& state) {
-    const auto basePose = centroidal_model::getBasePose(state, centroidalModelInfo_);
+  const auto& model = pinocchioInterface_.getModel();
+  auto& data = pinocchioInterface_.getData();
+  for (size_t j = 0; j < mpcStateTrajectory.size(); j++) {
+    const auto& state = mpcStateTrajectory[j];
 
-    // Fill com position and pose msgs
-    geometry_msgs::Pose pose;
-    pose.position = getPointMsg(basePose.head<3>());
-    mpcComPositionMsgs.push_back(pose.position);
+    // Fill com position msgs
+    const auto basePose = centroidal_model::getBasePose(state, centroidalModelInfo_);
+    markers[comMarkerIndex].points[j] = getPointMsg(basePose.head<3>());
 
     // Fill feet msgs
-    const auto& model = pinocchioInterface_.getModel();
-    auto& data = pinocchioInterface_.getData();
     pinocchio::forwardKinematics(model, data, centroidal_model::getGeneralizedCoordinates(state, centroidalModelInfo_));
     pinocchio::updateFramePlacements(model, data);
 
     const auto feetPositions = endEffectorKinematicsPtr_->getPosition(state);
     for (size_t i = 0; i < centroidalModelInfo_.numThreeDofContacts; i++) {
-      const auto position = getPointMsg(feetPositions[i]);
-      feetMsgs[i].push_back(position);
+      markers[i].points[j] = getPointMsg(feetPositions[i]);
     }
-  });
+  }
 
-  // Convert feet msgs to Array message
-  visualization_msgs::MarkerArray markerArray;
-  markerArray.markers.reserve(centroidalModelInfo_.numThreeDofContacts +
-                              2);  // 1 trajectory per foot + 1 for the future footholds + 1 for the com trajectory
   for (size_t i = 0; i < centroidalModelInfo_.numThreeDofContacts; i++) {
-    markerArray.markers.emplace_back(getLineMsg(std::move(feetMsgs[i]), feetColorMap_[i], trajectoryLineWidth_));
-    markerArray.markers.back().ns = "EE Trajectories";
+    setLineMsgProperties(markers[i], feetColorMap_[i], trajectoryLineWidth_);
+    markers[i].ns = "EE Trajectories";
   }
-  markerArray.markers.emplace_back(getLineMsg(std::move(mpcComPositionMsgs), Color::red, trajectoryLineWidth_));
-  markerArray.markers.back().ns = "CoM Trajectory";
+  setLineMsgProperties(markers[comMarkerIndex], Color::red, trajectoryLineWidth_);
+  markers[comMarkerIndex].ns = "CoM Trajectory";
 
   // Future footholds
-  visualization_msgs::Marker sphereList;
+  auto& sphereList = markers[footholdMarkerIndex];
   sphereList.type = visualization_msgs::Marker::SPHERE_LIST;
   sphereList.scale.x = footMarkerDiameter_;
   sphereList.scale.y = footMarkerDiameter_;
   sphereList.scale.z = footMarkerDiameter_;
   sphereList.ns = "Future footholds";
   sphereList.pose.orientation = getOrientationMsg({1., 0., 0., 0.});
+  sphereList.points.clear();
+  sphereList.colors.clear();
   const auto& eventTimes = modeSchedule.eventTimes;
   const auto& subsystemSequence = modeSchedule.modeSequence;
   const auto tStart = mpcTimeTrajectory.front();
@@ -342,8 +325,6 @@ void LeggedRobotVisualizer::publishOptimizedStateTrajectory(ros::Time timeStamp,
       const auto postEventContactFlags = modeNumber2StanceLeg(subsystemSequence[event + 1]);
       const auto postEventState = LinearInterpolation::interpolate(eventTimes[event], mpcTimeTrajectory, mpcStateTrajectory);
 
-      const auto& model = pinocchioInterface_.getModel();
-      auto& data = pinocchioInterface_.getData();
       pinocchio::forwardKinematics(model, data, centroidal_model::getGeneralizedCoordinates(postEventState, centroidalModelInfo_));
       pinocchio::updateFramePlacements(model, data);
 
@@ -356,13 +337,12 @@ void LeggedRobotVisualizer::publishOptimizedStateTrajectory(ros::Time timeStamp,
       }
     }
   }
-  markerArray.markers.push_back(std::move(sphereList));
 
   // Add headers and Id
-  assignHeader(markerArray.markers.begin(), markerArray.markers.end(), getHeaderMsg(frameId_, timeStamp));
-  assignIncreasingId(markerArray.markers.begin(), markerArray.markers.end());
+  assignHeader(markers.begin(), markers.end(), getHeaderMsg(frameId_, timeStamp));
+  assignIncreasingId(markers.begin(), markers.end());
 
-  stateOptimizedPublisher_.publish(markerArray);
+  stateOptimizedPublisher_.publish(optimizedStateMarkerArray_);
 }
 
 }  // namespace legged_robot
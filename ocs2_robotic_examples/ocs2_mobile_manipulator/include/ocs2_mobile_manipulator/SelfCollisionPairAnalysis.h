@@ -0,0 +1,104 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_pinocchio_interface/PinocchioInterface.h>
+#include <ocs2_self_collision/PinocchioGeometryInterface.h>
+
+#include "ocs2_mobile_manipulator/ManipulatorModelInfo.h"
+
+namespace ocs2 {
+namespace mobile_manipulator {
+
+/**
+ * The result of the offline self-collision pair analysis: the collision object pairs which can get closer than the pruning distance,
+ * and for each of them the smallest distance which is found over the sampled configurations.
+ */
+struct SelfCollisionPairAnalysis {
+  std::vector<std::pair<size_t, size_t>> collisionObjectPairs;
+  scalar_array_t distanceLowerBounds;
+};
+
+struct SelfCollisionPairAnalysisSettings {
+  /** The number of arm configurations which are sampled uniformly within the joint limits. */
+  size_t numSamples = 10000;
+  /**
+   * The pairs whose smallest sampled distance is larger than the minimum distance plus this margin are pruned. The margin accounts for
+   * the distance which can be missed in between the samples.
+   */
+  scalar_t pruningMargin = 0.05;
+  /** The seed of the random configuration sampler. */
+  unsigned int seed = 0;
+};
+
+/**
+ * Samples the arm configuration space within the joint limits of the URDF and prunes the collision pairs which can never get closer
+ * than the minimum distance. Since the base DOFs move all the links rigidly, they are kept at zero. Unbounded joints are sampled in
+ * [-pi, pi].
+ *
+ * @param [in] pinocchioInterface: pinocchio interface of the robot model
+ * @param [in] modelInfo: The manipulator model information.
+ * @param [in] geometryInterface: pinocchio geometry interface with the candidate collision pairs.
+ * @param [in] minimumDistance: minimum allowed distance between each collision pair
+ * @param [in] settings: The analysis settings.
+ * @return The pruned collision pairs and their distance bounds.
+ */
+SelfCollisionPairAnalysis analyzeSelfCollisionPairs(PinocchioInterface pinocchioInterface, const ManipulatorModelInfo& modelInfo,
+                                                    const PinocchioGeometryInterface& geometryInterface, scalar_t minimumDistance,
+                                                    const SelfCollisionPairAnalysisSettings& settings = {});
+
+/**
+ * Saves the analysis in the info format such that it can be loaded by loadSelfCollisionPairAnalysis().
+ *
+ * @param [in] analysis: The self-collision pair analysis.
+ * @param [in] filename: The output file.
+ * @param [in] fieldName: The field name of the analysis.
+ */
+void saveSelfCollisionPairAnalysis(const SelfCollisionPairAnalysis& analysis, const std::string& filename,
+                                   const std::string& fieldName = "selfCollisionPairAnalysis");
+
+/**
+ * Loads the analysis saved by saveSelfCollisionPairAnalysis().
+ *
+ * @param [in] filename: File name which contains the analysis.
+ * @param [in] fieldName: The field name of the analysis.
+ * @param [in] verbose: Flag to determine whether to print out the loaded pairs or not.
+ * @return The self-collision pair analysis.
+ */
+SelfCollisionPairAnalysis loadSelfCollisionPairAnalysis(const std::string& filename,
+                                                        const std::string& fieldName = "selfCollisionPairAnalysis", bool verbose = true);
+
+}  // namespace mobile_manipulator
+}  // namespace ocs2
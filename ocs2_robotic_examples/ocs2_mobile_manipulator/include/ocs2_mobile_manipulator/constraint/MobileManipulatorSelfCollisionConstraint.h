@@ -31,7 +31,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <memory>
 
-#include <ocs2_mobile_manipulator/MobileManipulatorPreComputation.h>
+#include <ocs2_pinocchio_interface/PinocchioPreComputation.h>
 #include <ocs2_self_collision/SelfCollisionConstraint.h>
 
 namespace ocs2 {
@@ -40,14 +40,15 @@ namespace mobile_manipulator {
 class MobileManipulatorSelfCollisionConstraint final : public SelfCollisionConstraint {
  public:
   MobileManipulatorSelfCollisionConstraint(const PinocchioStateInputMapping<scalar_t>& mapping,
-                                           PinocchioGeometryInterface pinocchioGeometryInterface, scalar_t minimumDistance)
-      : SelfCollisionConstraint(mapping, std::move(pinocchioGeometryInterface), minimumDistance) {}
+                                           PinocchioGeometryInterface pinocchioGeometryInterface, scalar_t minimumDistance,
+                                           ThreadPool* threadPoolPtr = nullptr)
+      : SelfCollisionConstraint(mapping, std::move(pinocchioGeometryInterface), minimumDistance, threadPoolPtr) {}
   ~MobileManipulatorSelfCollisionConstraint() override = default;
   MobileManipulatorSelfCollisionConstraint(const MobileManipulatorSelfCollisionConstraint& other) = default;
   MobileManipulatorSelfCollisionConstraint* clone() const { return new MobileManipulatorSelfCollisionConstraint(*this); }
 
   const PinocchioInterface& getPinocchioInterface(const PreComputation& preComputation) const override {
-    return cast<MobileManipulatorPreComputation>(preComputation).getPinocchioInterface();
+    return cast<PinocchioPreComputation>(preComputation).getPinocchioInterface();
   }
 };
 
@@ -29,10 +29,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
-#include <ocs2_core/dynamics/SystemDynamicsBaseAD.h>
+#include <ocs2_core/dynamics/SystemDynamicsBase.h>
 
 #include <ocs2_mobile_manipulator/ManipulatorModelInfo.h>
-#include <ocs2_pinocchio_interface/PinocchioInterface.h>
 
 namespace ocs2 {
 namespace mobile_manipulator {
@@ -44,28 +43,30 @@ namespace mobile_manipulator {
  * The end-effector targets are assumed to given with respect to the base frame.
  * The arm is assumed to be velocity controlled.
  */
-class DefaultManipulatorDynamics final : public SystemDynamicsBaseAD {
+class DefaultManipulatorDynamics final : public SystemDynamicsBase {
  public:
   /**
    * Constructor
    *
    * @param [in] modelInfo : The manipulator information.
-   * @param [in] modelName : name of the generate model library
-   * @param [in] modelFolder : folder to save the model library files to
-   * @param [in] recompileLibraries : If true, always compile the model library, else try to load existing library if available.
-   * @param [in] verbose : Display information.
    */
-  DefaultManipulatorDynamics(const ManipulatorModelInfo& modelInfo, const std::string& modelName,
-                             const std::string& modelFolder = "/tmp/ocs2", bool recompileLibraries = true, bool verbose = true);
+  explicit DefaultManipulatorDynamics(ManipulatorModelInfo modelInfo);
 
   ~DefaultManipulatorDynamics() override = default;
   DefaultManipulatorDynamics* clone() const override { return new DefaultManipulatorDynamics(*this); }
 
+  vector_t computeFlowMap(scalar_t time, const vector_t& state, const vector_t& input, const PreComputation&) override;
+
+  VectorFunctionLinearApproximation linearApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                        const PreComputation&) override;
+
+  ScalarFunctionQuadraticApproximation flowMapWeightedHessian(scalar_t time, const vector_t& state, const vector_t& input,
+                                                              const vector_t& weights, const PreComputation&) override;
+
  private:
   DefaultManipulatorDynamics(const DefaultManipulatorDynamics& rhs) = default;
 
-  ad_vector_t systemFlowMap(ad_scalar_t time, const ad_vector_t& state, const ad_vector_t& input,
-                            const ad_vector_t& /*parameters*/) const override;
+  const ManipulatorModelInfo info_;
 };
 
 }  // namespace mobile_manipulator
@@ -29,10 +29,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
-#include <ocs2_core/dynamics/SystemDynamicsBaseAD.h>
+#include <ocs2_core/dynamics/SystemDynamicsBase.h>
 
 #include <ocs2_mobile_manipulator/ManipulatorModelInfo.h>
-#include <ocs2_pinocchio_interface/PinocchioInterface.h>
 
 namespace ocs2 {
 namespace mobile_manipulator {
@@ -45,29 +44,30 @@ namespace mobile_manipulator {
  * The end-effector targets are assumed to given with respect to the world frame.
  * The arm is assumed to be velocity controlled.
  */
-class FullyActuatedFloatingArmManipulatorDynamics final : public SystemDynamicsBaseAD {
+class FullyActuatedFloatingArmManipulatorDynamics final : public SystemDynamicsBase {
  public:
   /**
    * Constructor
    *
    * @param [in] modelInfo : The manipulator information.
-   * @param [in] modelName : name of the generate model library
-   * @param [in] modelFolder : folder to save the model library files to
-   * @param [in] recompileLibraries : If true, always compile the model library, else try to load existing library if available.
-   * @param [in] verbose : Display information.
    */
-  FullyActuatedFloatingArmManipulatorDynamics(const ManipulatorModelInfo& modelInfo, const std::string& modelName,
-                                              const std::string& modelFolder = "/tmp/ocs2", bool recompileLibraries = true,
-                                              bool verbose = true);
+  explicit FullyActuatedFloatingArmManipulatorDynamics(ManipulatorModelInfo modelInfo);
 
   ~FullyActuatedFloatingArmManipulatorDynamics() override = default;
   FullyActuatedFloatingArmManipulatorDynamics* clone() const override { return new FullyActuatedFloatingArmManipulatorDynamics(*this); }
 
+  vector_t computeFlowMap(scalar_t time, const vector_t& state, const vector_t& input, const PreComputation&) override;
+
+  VectorFunctionLinearApproximation linearApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                        const PreComputation&) override;
+
+  ScalarFunctionQuadraticApproximation flowMapWeightedHessian(scalar_t time, const vector_t& state, const vector_t& input,
+                                                              const vector_t& weights, const PreComputation&) override;
+
  private:
   FullyActuatedFloatingArmManipulatorDynamics(const FullyActuatedFloatingArmManipulatorDynamics& rhs) = default;
 
-  ad_vector_t systemFlowMap(ad_scalar_t time, const ad_vector_t& state, const ad_vector_t& input,
-                            const ad_vector_t& /*parameters*/) const override;
+  const ManipulatorModelInfo info_;
 };
 
 }  // namespace mobile_manipulator
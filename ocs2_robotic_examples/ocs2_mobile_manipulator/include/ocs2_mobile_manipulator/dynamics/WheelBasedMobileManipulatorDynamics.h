@@ -29,8 +29,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
-#include <ocs2_core/dynamics/SystemDynamicsBaseAD.h>
-#include <ocs2_pinocchio_interface/PinocchioInterface.h>
+#include <ocs2_core/dynamics/SystemDynamicsBase.h>
 
 #include "ocs2_mobile_manipulator/ManipulatorModelInfo.h"
 
@@ -46,29 +45,29 @@ namespace mobile_manipulator {
  * The robot is assumed to be velocity controlled with the base commands as the forward
  * velocity and the angular velocity around z.
  */
-class WheelBasedMobileManipulatorDynamics final : public SystemDynamicsBaseAD {
+class WheelBasedMobileManipulatorDynamics final : public SystemDynamicsBase {
  public:
   /**
    * Constructor
    *
    * @param [in] modelInfo : The manipulator information.
-   * @param [in] modelName : name of the generate model library
-   * @param [in] modelFolder : folder to save the model library files to
-   * @param [in] recompileLibraries : If true, always compile the model library, else try to load existing library if available.
-   * @param [in] verbose : Display information.
    */
-  WheelBasedMobileManipulatorDynamics(ManipulatorModelInfo modelInfo, const std::string& modelName,
-                                      const std::string& modelFolder = "/tmp/ocs2", bool recompileLibraries = true, bool verbose = true);
+  explicit WheelBasedMobileManipulatorDynamics(ManipulatorModelInfo modelInfo);
 
   ~WheelBasedMobileManipulatorDynamics() override = default;
   WheelBasedMobileManipulatorDynamics* clone() const override { return new WheelBasedMobileManipulatorDynamics(*this); }
 
+  vector_t computeFlowMap(scalar_t time, const vector_t& state, const vector_t& input, const PreComputation&) override;
+
+  VectorFunctionLinearApproximation linearApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                        const PreComputation&) override;
+
+  ScalarFunctionQuadraticApproximation flowMapWeightedHessian(scalar_t time, const vector_t& state, const vector_t& input,
+                                                              const vector_t& weights, const PreComputation&) override;
+
  private:
   WheelBasedMobileManipulatorDynamics(const WheelBasedMobileManipulatorDynamics& rhs) = default;
 
-  ad_vector_t systemFlowMap(ad_scalar_t time, const ad_vector_t& state, const ad_vector_t& input,
-                            const ad_vector_t& /*parameters*/) const override;
-
   const ManipulatorModelInfo info_;
 };
 
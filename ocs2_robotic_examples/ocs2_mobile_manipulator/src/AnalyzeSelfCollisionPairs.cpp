@@ -0,0 +1,102 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <iostream>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/property_tree/info_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+#include <ocs2_core/misc/LoadData.h>
+#include <ocs2_core/misc/LoadStdVectorOfPair.h>
+
+#include "ocs2_mobile_manipulator/FactoryFunctions.h"
+#include "ocs2_mobile_manipulator/SelfCollisionPairAnalysis.h"
+
+using namespace ocs2;
+using namespace mobile_manipulator;
+
+/**
+ * Prunes the self-collision pairs of a task file which can never get closer than the minimum distance within the joint limits.
+ * The output file can be set as selfCollision.pairAnalysisFile in the task file.
+ *
+ * Usage: analyze_self_collision_pairs <taskFile> <urdfFile> <outputFile> [numSamples]
+ */
+int main(int argc, char** argv) {
+  if (argc < 4) {
+    std::cerr << "Usage: " << argv[0] << " <taskFile> <urdfFile> <outputFile> [numSamples]\n";
+    return 1;
+  }
+  const std::string taskFile(argv[1]);
+  const std::string urdfFile(argv[2]);
+  const std::string outputFile(argv[3]);
+
+  SelfCollisionPairAnalysisSettings settings;
+  if (argc > 4) {
+    settings.numSamples = std::stoul(argv[4]);
+  }
+
+  // model
+  const auto ptPtr = loadData::readInfoFile(taskFile);
+  const boost::property_tree::ptree& pt = *ptPtr;
+  const ManipulatorModelType modelType = loadManipulatorType(taskFile, "model_information.manipulatorModelType");
+  std::vector<std::string> removeJointNames;
+  loadData::loadStdVector<std::string>(taskFile, "model_information.removeJoints", removeJointNames, false);
+  std::string baseFrame, eeFrame;
+  loadData::loadPtreeValue<std::string>(pt, baseFrame, "model_information.baseFrame", false);
+  loadData::loadPtreeValue<std::string>(pt, eeFrame, "model_information.eeFrame", false);
+  const PinocchioInterface pinocchioInterface = createPinocchioInterface(urdfFile, modelType, removeJointNames);
+  const ManipulatorModelInfo modelInfo = createManipulatorModelInfo(pinocchioInterface, modelType, baseFrame, eeFrame);
+
+  // candidate pairs
+  std::vector<std::pair<size_t, size_t>> collisionObjectPairs;
+  std::vector<std::pair<std::string, std::string>> collisionLinkPairs;
+  scalar_t minimumDistance = 0.0;
+  loadData::loadPtreeValue(pt, minimumDistance, "selfCollision.minimumDistance", true);
+  loadData::loadPtreeValue(pt, settings.pruningMargin, "selfCollision.pruningMargin", true);
+  loadData::loadStdVectorOfPair(taskFile, "selfCollision.collisionObjectPairs", collisionObjectPairs, true);
+  loadData::loadStdVectorOfPair(taskFile, "selfCollision.collisionLinkPairs", collisionLinkPairs, true);
+  const PinocchioGeometryInterface geometryInterface(pinocchioInterface, collisionLinkPairs, collisionObjectPairs);
+
+  const auto analysis = analyzeSelfCollisionPairs(pinocchioInterface, modelInfo, geometryInterface, minimumDistance, settings);
+  saveSelfCollisionPairAnalysis(analysis, outputFile);
+
+  std::cerr << "SelfCollision: Kept " << analysis.collisionObjectPairs.size() << " out of " << geometryInterface.getNumCollisionPairs()
+            << " collision pairs after " << settings.numSamples << " samples\n";
+  for (size_t i = 0; i < analysis.collisionObjectPairs.size(); i++) {
+    std::cerr << "  (" << analysis.collisionObjectPairs[i].first << ", " << analysis.collisionObjectPairs[i].second
+              << "): smallest distance " << analysis.distanceLowerBounds[i] << "\n";
+  }
+  std::cerr << "SelfCollision: The pruned pairs are saved to " << outputFile << "\n";
+
+  return 0;
+}
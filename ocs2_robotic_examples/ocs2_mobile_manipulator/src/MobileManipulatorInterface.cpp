@@ -27,6 +27,7 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
+#include <limits>
 #include <string>
 
 #include <pinocchio/fwd.hpp>  // forward declarations must be included first.
@@ -51,6 +52,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_mobile_manipulator/ManipulatorModelInfo.h"
 #include "ocs2_mobile_manipulator/MobileManipulatorPreComputation.h"
+#include "ocs2_mobile_manipulator/SelfCollisionPairAnalysis.h"
 #include "ocs2_mobile_manipulator/constraint/EndEffectorConstraint.h"
 #include "ocs2_mobile_manipulator/constraint/MobileManipulatorSelfCollisionConstraint.h"
 #include "ocs2_mobile_manipulator/cost/QuadraticInputCost.h"
@@ -91,8 +93,8 @@ MobileManipulatorInterface::MobileManipulatorInterface(const std::string& taskFi
   std::cerr << "[MobileManipulatorInterface] Generated library path: " << libraryFolderPath << std::endl;
 
   // read the task file
-  boost::property_tree::ptree pt;
-  boost::property_tree::read_info(taskFile, pt);
+  const auto ptPtr = loadData::readInfoFile(taskFile);
+  const boost::property_tree::ptree& pt = *ptPtr;
   // resolve meta-information about the model
   // read manipulator type
   ManipulatorModelType modelType = mobile_manipulator::loadManipulatorType(taskFile, "model_information.manipulatorModelType");
@@ -182,23 +184,19 @@ MobileManipulatorInterface::MobileManipulatorInterface(const std::string& taskFi
   // Dynamics
   switch (manipulatorModelInfo_.manipulatorModelType) {
     case ManipulatorModelType::DefaultManipulator: {
-      problem_.dynamicsPtr.reset(
-          new DefaultManipulatorDynamics(manipulatorModelInfo_, "dynamics", libraryFolder, recompileLibraries, true));
+      problem_.dynamicsPtr.reset(new DefaultManipulatorDynamics(manipulatorModelInfo_));
       break;
     }
     case ManipulatorModelType::FloatingArmManipulator: {
-      problem_.dynamicsPtr.reset(
-          new FloatingArmManipulatorDynamics(manipulatorModelInfo_, "dynamics", libraryFolder, recompileLibraries, true));
+      problem_.dynamicsPtr.reset(new FloatingArmManipulatorDynamics(manipulatorModelInfo_));
       break;
     }
     case ManipulatorModelType::FullyActuatedFloatingArmManipulator: {
-      problem_.dynamicsPtr.reset(
-          new FullyActuatedFloatingArmManipulatorDynamics(manipulatorModelInfo_, "dynamics", libraryFolder, recompileLibraries, true));
+      problem_.dynamicsPtr.reset(new FullyActuatedFloatingArmManipulatorDynamics(manipulatorModelInfo_));
       break;
     }
     case ManipulatorModelType::WheelBasedMobileManipulator: {
-      problem_.dynamicsPtr.reset(
-          new WheelBasedMobileManipulatorDynamics(manipulatorModelInfo_, "dynamics", libraryFolder, recompileLibraries, true));
+      problem_.dynamicsPtr.reset(new WheelBasedMobileManipulatorDynamics(manipulatorModelInfo_));
       break;
     }
     default:
@@ -259,8 +257,8 @@ std::unique_ptr<StateCost> MobileManipulatorInterface::getEndEffectorConstraint(
   scalar_t muOrientation = 1.0;
   const std::string name = "WRIST_2";
 
-  boost::property_tree::ptree pt;
-  boost::property_tree::read_info(taskFile, pt);
+  const auto ptPtr = loadData::readInfoFile(taskFile);
+  const boost::property_tree::ptree& pt = *ptPtr;
   std::cerr << "\n #### " << prefix << " Settings: ";
   std::cerr << "\n #### =============================================================================\n";
   loadData::loadPtreeValue(pt, muPosition, prefix + ".muPosition", true);
@@ -304,19 +302,41 @@ std::unique_ptr<StateCost> MobileManipulatorInterface::getSelfCollisionConstrain
   scalar_t mu = 1e-2;
   scalar_t delta = 1e-3;
   scalar_t minimumDistance = 0.0;
+  scalar_t broadPhaseMargin = std::numeric_limits<scalar_t>::infinity();
+  scalar_t broadPhaseBlendingWidth = 0.0;
+  std::string pairAnalysisFile;
 
-  boost::property_tree::ptree pt;
-  boost::property_tree::read_info(taskFile, pt);
+  const auto ptPtr = loadData::readInfoFile(taskFile);
+  const boost::property_tree::ptree& pt = *ptPtr;
   std::cerr << "\n #### SelfCollision Settings: ";
   std::cerr << "\n #### =============================================================================\n";
   loadData::loadPtreeValue(pt, mu, prefix + ".mu", true);
   loadData::loadPtreeValue(pt, delta, prefix + ".delta", true);
   loadData::loadPtreeValue(pt, minimumDistance, prefix + ".minimumDistance", true);
-  loadData::loadStdVectorOfPair(taskFile, prefix + ".collisionObjectPairs", collisionObjectPairs, true);
-  loadData::loadStdVectorOfPair(taskFile, prefix + ".collisionLinkPairs", collisionLinkPairs, true);
+  loadData::loadPtreeValue(pt, broadPhaseMargin, prefix + ".broadPhaseMargin", true);
+  loadData::loadPtreeValue(pt, broadPhaseBlendingWidth, prefix + ".broadPhaseBlendingWidth", true);
+  loadData::loadPtreeValue(pt, pairAnalysisFile, prefix + ".pairAnalysisFile", true);
+  if (pairAnalysisFile.empty()) {
+    loadData::loadStdVectorOfPair(taskFile, prefix + ".collisionObjectPairs", collisionObjectPairs, true);
+    loadData::loadStdVectorOfPair(taskFile, prefix + ".collisionLinkPairs", collisionLinkPairs, true);
+  }
   std::cerr << " #### =============================================================================\n";
 
+  // the pruned pairs of the offline analysis replace the pairs of the task file. The pairs which never get closer than the broad
+  // phase distance and its blending width are dropped as well, since their exact distances would never be computed.
+  if (!pairAnalysisFile.empty()) {
+    const auto analysis = loadSelfCollisionPairAnalysis(pairAnalysisFile);
+    for (size_t i = 0; i < analysis.collisionObjectPairs.size(); i++) {
+      if (analysis.distanceLowerBounds[i] <= minimumDistance + broadPhaseMargin + broadPhaseBlendingWidth) {
+        collisionObjectPairs.push_back(analysis.collisionObjectPairs[i]);
+      }
+    }
+  }
+
   PinocchioGeometryInterface geometryInterface(pinocchioInterface, collisionLinkPairs, collisionObjectPairs);
+  // the exact distances are only computed for the pairs which are closer than the margin to the minimum distance. Beyond the margin,
+  // they are blended into the bounding sphere distances over the blending width.
+  geometryInterface.setBroadPhaseDistance(minimumDistance + broadPhaseMargin, broadPhaseBlendingWidth);
 
   const size_t numCollisionPairs = geometryInterface.getNumCollisionPairs();
   std::cerr << "SelfCollision: Testing for " << numCollisionPairs << " collision pairs\n";
@@ -341,8 +361,8 @@ std::unique_ptr<StateCost> MobileManipulatorInterface::getSelfCollisionConstrain
 /******************************************************************************************************/
 std::unique_ptr<StateInputCost> MobileManipulatorInterface::getJointLimitSoftConstraint(const PinocchioInterface& pinocchioInterface,
                                                                                         const std::string& taskFile) {
-  boost::property_tree::ptree pt;
-  boost::property_tree::read_info(taskFile, pt);
+  const auto ptPtr = loadData::readInfoFile(taskFile);
+  const boost::property_tree::ptree& pt = *ptPtr;
 
   bool activateJointPositionLimit = true;
   loadData::loadPtreeValue(pt, activateJointPositionLimit, "jointPositionLimits.activate", true);
@@ -0,0 +1,138 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <pinocchio/fwd.hpp>  // forward declarations must be included first.
+
+#include <pinocchio/algorithm/kinematics.hpp>
+#include <pinocchio/multibody/geometry.hpp>
+
+#include "ocs2_mobile_manipulator/SelfCollisionPairAnalysis.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <random>
+#include <stdexcept>
+
+#include <ocs2_core/misc/LoadData.h>
+#include <ocs2_core/misc/LoadStdVectorOfPair.h>
+
+namespace ocs2 {
+namespace mobile_manipulator {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+SelfCollisionPairAnalysis analyzeSelfCollisionPairs(PinocchioInterface pinocchioInterface, const ManipulatorModelInfo& modelInfo,
+                                                    const PinocchioGeometryInterface& geometryInterface, scalar_t minimumDistance,
+                                                    const SelfCollisionPairAnalysisSettings& settings) {
+  const auto& model = pinocchioInterface.getModel();
+  auto& data = pinocchioInterface.getData();
+  const int armDim = static_cast<int>(modelInfo.armDim);
+
+  // the exact distances are required for all the pairs
+  PinocchioGeometryInterface exactGeometryInterface = geometryInterface;
+  exactGeometryInterface.setBroadPhaseDistance(std::numeric_limits<scalar_t>::infinity(), 0.0);
+  const auto& collisionPairs = exactGeometryInterface.getGeometryModel().collisionPairs;
+
+  vector_t lowerBound = model.lowerPositionLimit.tail(armDim);
+  vector_t upperBound = model.upperPositionLimit.tail(armDim);
+  for (int i = 0; i < armDim; i++) {
+    if (!std::isfinite(upperBound[i] - lowerBound[i])) {
+      lowerBound[i] = -M_PI;
+      upperBound[i] = M_PI;
+    }
+  }
+
+  std::mt19937 generator(settings.seed);
+  std::uniform_real_distribution<scalar_t> distribution(0.0, 1.0);
+  vector_t q = vector_t::Zero(model.nq);
+  scalar_array_t smallestDistances(collisionPairs.size(), std::numeric_limits<scalar_t>::infinity());
+  for (size_t k = 0; k < settings.numSamples; k++) {
+    for (int i = 0; i < armDim; i++) {
+      q[model.nq - armDim + i] = lowerBound[i] + distribution(generator) * (upperBound[i] - lowerBound[i]);
+    }
+    pinocchio::forwardKinematics(model, data, q);
+    const auto distanceArray = exactGeometryInterface.computeDistances(pinocchioInterface);
+    for (size_t i = 0; i < distanceArray.size(); i++) {
+      smallestDistances[i] = std::min(smallestDistances[i], distanceArray[i].min_distance);
+    }
+  }
+
+  SelfCollisionPairAnalysis analysis;
+  for (size_t i = 0; i < collisionPairs.size(); i++) {
+    if (smallestDistances[i] <= minimumDistance + settings.pruningMargin) {
+      analysis.collisionObjectPairs.emplace_back(collisionPairs[i].first, collisionPairs[i].second);
+      analysis.distanceLowerBounds.push_back(smallestDistances[i]);
+    }
+  }
+  return analysis;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void saveSelfCollisionPairAnalysis(const SelfCollisionPairAnalysis& analysis, const std::string& filename, const std::string& fieldName) {
+  std::ofstream file(filename);
+  if (!file) {
+    throw std::runtime_error("[saveSelfCollisionPairAnalysis] Could not open " + filename);
+  }
+
+  file << std::setprecision(std::numeric_limits<scalar_t>::max_digits10);
+  file << fieldName << "\n{\n";
+  file << "  collisionObjectPairs\n  {\n";
+  for (size_t i = 0; i < analysis.collisionObjectPairs.size(); i++) {
+    file << "    [" << i << "] \"" << analysis.collisionObjectPairs[i].first << ", " << analysis.collisionObjectPairs[i].second << "\"\n";
+  }
+  file << "  }\n";
+  file << "  distanceLowerBounds\n  {\n";
+  for (size_t i = 0; i < analysis.distanceLowerBounds.size(); i++) {
+    file << "    [" << i << "] " << analysis.distanceLowerBounds[i] << "\n";
+  }
+  file << "  }\n}\n";
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+SelfCollisionPairAnalysis loadSelfCollisionPairAnalysis(const std::string& filename, const std::string& fieldName, bool verbose) {
+  SelfCollisionPairAnalysis analysis;
+  loadData::loadStdVectorOfPair(filename, fieldName + ".collisionObjectPairs", analysis.collisionObjectPairs, verbose);
+  loadData::loadStdVector(filename, fieldName + ".distanceLowerBounds", analysis.distanceLowerBounds, verbose);
+  if (analysis.collisionObjectPairs.size() != analysis.distanceLowerBounds.size()) {
+    throw std::runtime_error("[loadSelfCollisionPairAnalysis] The number of distance bounds does not match the number of pairs in " +
+                             filename);
+  }
+  return analysis;
+}
+
+}  // namespace mobile_manipulator
+}  // namespace ocs2
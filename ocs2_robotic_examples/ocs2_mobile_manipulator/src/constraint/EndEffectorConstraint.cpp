@@ -27,10 +27,10 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
-#include <ocs2_mobile_manipulator/MobileManipulatorPreComputation.h>
 #include <ocs2_mobile_manipulator/constraint/EndEffectorConstraint.h>
 
 #include <ocs2_core/misc/LinearInterpolation.h>
+#include <ocs2_pinocchio_interface/PinocchioPreComputation.h>
 
 namespace ocs2 {
 namespace mobile_manipulator {
@@ -62,8 +62,8 @@ size_t EndEffectorConstraint::getNumConstraints(scalar_t time) const {
 vector_t EndEffectorConstraint::getValue(scalar_t time, const vector_t& state, const PreComputation& preComputation) const {
   // PinocchioEndEffectorKinematics requires pre-computation with shared PinocchioInterface.
   if (pinocchioEEKinPtr_ != nullptr) {
-    const auto& preCompMM = cast<MobileManipulatorPreComputation>(preComputation);
-    pinocchioEEKinPtr_->setPinocchioInterface(preCompMM.getPinocchioInterface());
+    const auto& pinocchioPreComp = cast<PinocchioPreComputation>(preComputation);
+    pinocchioEEKinPtr_->setPinocchioInterface(pinocchioPreComp.getPinocchioInterface());
   }
 
   const auto desiredPositionOrientation = interpolateEndEffectorPose(time);
@@ -81,8 +81,8 @@ VectorFunctionLinearApproximation EndEffectorConstraint::getLinearApproximation(
                                                                                 const PreComputation& preComputation) const {
   // PinocchioEndEffectorKinematics requires pre-computation with shared PinocchioInterface.
   if (pinocchioEEKinPtr_ != nullptr) {
-    const auto& preCompMM = cast<MobileManipulatorPreComputation>(preComputation);
-    pinocchioEEKinPtr_->setPinocchioInterface(preCompMM.getPinocchioInterface());
+    const auto& pinocchioPreComp = cast<PinocchioPreComputation>(preComputation);
+    pinocchioEEKinPtr_->setPinocchioInterface(pinocchioPreComp.getPinocchioInterface());
   }
 
   const auto desiredPositionOrientation = interpolateEndEffectorPose(time);
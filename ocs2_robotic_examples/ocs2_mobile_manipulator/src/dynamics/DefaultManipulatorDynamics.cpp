@@ -4,14 +4,14 @@ Copyright (c) 2020, Farbod Farshidian. All rights reserved.
 Redistribution and use in source and binary forms, with or without
 modification, are permitted provided that the following conditions are met:
 
- * Redistributions of source code must retain the above copyright notice, this
+* Redistributions of source code must retain the above copyright notice, this
   list of conditions and the following disclaimer.
 
- * Redistributions in binary form must reproduce the above copyright notice,
+* Redistributions in binary form must reproduce the above copyright notice,
   this list of conditions and the following disclaimer in the documentation
   and/or other materials provided with the distribution.
 
- * Neither the name of the copyright holder nor the names of its
+* Neither the name of the copyright holder nor the names of its
   contributors may be used to endorse or promote products derived from
   this software without specific prior written permission.
 
@@ -35,19 +35,36 @@ namespace mobile_manipulator {
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-DefaultManipulatorDynamics::DefaultManipulatorDynamics(const ManipulatorModelInfo& info, const std::string& modelName,
-                                                       const std::string& modelFolder, bool recompileLibraries /*= true*/,
-                                                       bool verbose /*= true*/) {
-  this->initialize(info.stateDim, info.inputDim, modelName, modelFolder, recompileLibraries, verbose);
-}
+DefaultManipulatorDynamics::DefaultManipulatorDynamics(ManipulatorModelInfo modelInfo) : info_(std::move(modelInfo)) {}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-ad_vector_t DefaultManipulatorDynamics::systemFlowMap(ad_scalar_t time, const ad_vector_t& state, const ad_vector_t& input,
-                                                      const ad_vector_t&) const {
+vector_t DefaultManipulatorDynamics::computeFlowMap(scalar_t time, const vector_t& state, const vector_t& input, const PreComputation&) {
   return input;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+VectorFunctionLinearApproximation DefaultManipulatorDynamics::linearApproximation(scalar_t time, const vector_t& state,
+                                                                                  const vector_t& input, const PreComputation&) {
+  VectorFunctionLinearApproximation approximation;
+  approximation.f = input;
+  approximation.dfdx.setZero(info_.stateDim, info_.stateDim);
+  approximation.dfdu.setIdentity(info_.stateDim, info_.inputDim);
+  return approximation;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ScalarFunctionQuadraticApproximation DefaultManipulatorDynamics::flowMapWeightedHessian(scalar_t time, const vector_t& state,
+                                                                                        const vector_t& input, const vector_t& weights,
+                                                                                        const PreComputation&) {
+  // the flow map is linear
+  return ScalarFunctionQuadraticApproximation::Zero(info_.stateDim, info_.inputDim);
+}
+
 }  // namespace mobile_manipulator
 }  // namespace ocs2
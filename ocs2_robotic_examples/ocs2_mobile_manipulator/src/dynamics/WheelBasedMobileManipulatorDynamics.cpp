@@ -4,14 +4,14 @@ Copyright (c) 2020, Farbod Farshidian. All rights reserved.
 Redistribution and use in source and binary forms, with or without
 modification, are permitted provided that the following conditions are met:
 
- * Redistributions of source code must retain the above copyright notice, this
+* Redistributions of source code must retain the above copyright notice, this
   list of conditions and the following disclaimer.
 
- * Redistributions in binary form must reproduce the above copyright notice,
+* Redistributions in binary form must reproduce the above copyright notice,
   this list of conditions and the following disclaimer in the documentation
   and/or other materials provided with the distribution.
 
- * Neither the name of the copyright holder nor the names of its
+* Neither the name of the copyright holder nor the names of its
   contributors may be used to endorse or promote products derived from
   this software without specific prior written permission.
 
@@ -29,30 +29,68 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_mobile_manipulator/dynamics/WheelBasedMobileManipulatorDynamics.h"
 
+#include <cmath>
+
 namespace ocs2 {
 namespace mobile_manipulator {
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-WheelBasedMobileManipulatorDynamics::WheelBasedMobileManipulatorDynamics(ManipulatorModelInfo info, const std::string& modelName,
-                                                                         const std::string& modelFolder /*= "/tmp/ocs2"*/,
-                                                                         bool recompileLibraries /*= true*/, bool verbose /*= true*/)
-    : info_(std::move(info)) {
-  this->initialize(info_.stateDim, info_.inputDim, modelName, modelFolder, recompileLibraries, verbose);
-}
+WheelBasedMobileManipulatorDynamics::WheelBasedMobileManipulatorDynamics(ManipulatorModelInfo modelInfo) : info_(std::move(modelInfo)) {}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-ad_vector_t WheelBasedMobileManipulatorDynamics::systemFlowMap(ad_scalar_t time, const ad_vector_t& state, const ad_vector_t& input,
-                                                               const ad_vector_t&) const {
-  ad_vector_t dxdt(info_.stateDim);
-  const auto theta = state(2);
-  const auto v = input(0);  // forward velocity in base frame
-  dxdt << cos(theta) * v, sin(theta) * v, input(1), input.tail(info_.armDim);
+vector_t WheelBasedMobileManipulatorDynamics::computeFlowMap(scalar_t time, const vector_t& state, const vector_t& input,
+                                                             const PreComputation&) {
+  const scalar_t theta = state(2);
+  const scalar_t v = input(0);  // forward velocity in base frame
+  vector_t dxdt(info_.stateDim);
+  dxdt << std::cos(theta) * v, std::sin(theta) * v, input(1), input.tail(info_.armDim);
   return dxdt;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+VectorFunctionLinearApproximation WheelBasedMobileManipulatorDynamics::linearApproximation(scalar_t time, const vector_t& state,
+                                                                                           const vector_t& input, const PreComputation&) {
+  const scalar_t cosTheta = std::cos(state(2));
+  const scalar_t sinTheta = std::sin(state(2));
+  const scalar_t v = input(0);  // forward velocity in base frame
+
+  VectorFunctionLinearApproximation approximation;
+  approximation.f.resize(info_.stateDim);
+  approximation.f << cosTheta * v, sinTheta * v, input(1), input.tail(info_.armDim);
+
+  approximation.dfdx.setZero(info_.stateDim, info_.stateDim);
+  approximation.dfdx.block<2, 1>(0, 2) << -sinTheta * v, cosTheta * v;
+
+  approximation.dfdu.setZero(info_.stateDim, info_.inputDim);
+  approximation.dfdu.block<2, 1>(0, 0) << cosTheta, sinTheta;
+  approximation.dfdu(2, 1) = 1.0;
+  approximation.dfdu.bottomRightCorner(info_.armDim, info_.armDim).setIdentity();
+  return approximation;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ScalarFunctionQuadraticApproximation WheelBasedMobileManipulatorDynamics::flowMapWeightedHessian(scalar_t time, const vector_t& state,
+                                                                                                 const vector_t& input,
+                                                                                                 const vector_t& weights,
+                                                                                                 const PreComputation&) {
+  const scalar_t cosTheta = std::cos(state(2));
+  const scalar_t sinTheta = std::sin(state(2));
+  const scalar_t v = input(0);  // forward velocity in base frame
+
+  // only the base velocity in the world frame is nonlinear, in the base yaw and the forward velocity
+  auto hessian = ScalarFunctionQuadraticApproximation::Zero(info_.stateDim, info_.inputDim);
+  hessian.dfdxx(2, 2) = -(weights(0) * cosTheta + weights(1) * sinTheta) * v;
+  hessian.dfdux(0, 2) = -weights(0) * sinTheta + weights(1) * cosTheta;
+  return hessian;
+}
+
 }  // namespace mobile_manipulator
 }  // namespace ocs2
@@ -27,11 +27,6 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
-#include <pinocchio/fwd.hpp>
-
-#include <pinocchio/algorithm/frames.hpp>
-#include <pinocchio/algorithm/kinematics.hpp>
-
 #include <gtest/gtest.h>
 
 #include <ocs2_core/misc/LoadData.h>
@@ -83,8 +78,8 @@ class testEndEffectorConstraint : public ::testing::Test {
     // files
     const std::string taskFile = ocs2::mobile_manipulator::getPath() + "/config/mabi_mobile/task.info";
     // read the task file
-    boost::property_tree::ptree pt;
-    boost::property_tree::read_info(taskFile, pt);
+    const auto ptPtr = loadData::readInfoFile(taskFile);
+    const boost::property_tree::ptree& pt = *ptPtr;
     // resolve meta-information about the model
     // read manipulator type
     ManipulatorModelType modelType = mobile_manipulator::loadManipulatorType(taskFile, "model_information.manipulatorModelType");
@@ -113,13 +108,7 @@ class testEndEffectorConstraint : public ::testing::Test {
 TEST_F(testEndEffectorConstraint, testConstraintEvaluation) {
   EndEffectorConstraint eeConstraint(*eeKinematicsPtr, *referenceManagerPtr);
 
-  auto& pinocchioInterface = preComputationPtr->getPinocchioInterface();
-  const auto& model = pinocchioInterface.getModel();
-  auto& data = pinocchioInterface.getData();
-  const auto q = pinocchioMapping.getPinocchioJointPosition(x);
-  pinocchio::forwardKinematics(model, data, q);
-  pinocchio::updateFramePlacements(model, data);
-  pinocchio::computeJointJacobians(model, data);
+  preComputationPtr->requestFinal(Request::Constraint + Request::Approximation, 0.0, x);
 
   std::cerr << "constraint:\n" << eeConstraint.getValue(0.0, x, *preComputationPtr) << '\n';
   std::cerr << "approximation:\n" << eeConstraint.getLinearApproximation(0.0, x, *preComputationPtr);
@@ -0,0 +1,113 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/dynamics/SystemDynamicsLinearizer.h>
+
+#include "ocs2_mobile_manipulator/dynamics/DefaultManipulatorDynamics.h"
+#include "ocs2_mobile_manipulator/dynamics/FloatingArmManipulatorDynamics.h"
+#include "ocs2_mobile_manipulator/dynamics/FullyActuatedFloatingArmManipulatorDynamics.h"
+#include "ocs2_mobile_manipulator/dynamics/WheelBasedMobileManipulatorDynamics.h"
+
+using namespace ocs2;
+using namespace mobile_manipulator;
+
+namespace {
+
+ManipulatorModelInfo getModelInfo(ManipulatorModelType type, size_t baseStateDim, size_t baseInputDim) {
+  constexpr size_t armDim = 6;
+  ManipulatorModelInfo info;
+  info.manipulatorModelType = type;
+  info.armDim = armDim;
+  info.stateDim = baseStateDim + armDim;
+  info.inputDim = baseInputDim + armDim;
+  return info;
+}
+
+/** Compares the analytical derivatives with finite differences at random points */
+void testDerivatives(SystemDynamicsBase& dynamics, const ManipulatorModelInfo& info) {
+  constexpr scalar_t tol = 1e-5;
+  SystemDynamicsLinearizer finiteDifferenceDynamics(std::unique_ptr<ControlledSystemBase>(dynamics.clone()), true, false, 1e-6);
+
+  for (int i = 0; i < 10; i++) {
+    const scalar_t t = 0.0;
+    const vector_t x = vector_t::Random(info.stateDim);
+    const vector_t u = vector_t::Random(info.inputDim);
+    const vector_t w = vector_t::Random(info.stateDim);
+
+    const auto approximation = dynamics.linearApproximation(t, x, u);
+    const auto finiteDifferenceApproximation = static_cast<SystemDynamicsBase&>(finiteDifferenceDynamics).linearApproximation(t, x, u);
+    EXPECT_TRUE(approximation.f.isApprox(dynamics.computeFlowMap(t, x, u)));
+    EXPECT_TRUE(approximation.dfdx.isApprox(finiteDifferenceApproximation.dfdx, tol)) << approximation.dfdx;
+    EXPECT_TRUE(approximation.dfdu.isApprox(finiteDifferenceApproximation.dfdu, tol)) << approximation.dfdu;
+
+    // the weighted Hessian from finite differences of the weighted Jacobians
+    const auto hessian = dynamics.flowMapWeightedHessian(t, x, u, w);
+    constexpr scalar_t eps = 1e-6;
+    matrix_t dfdxx(info.stateDim, info.stateDim);
+    matrix_t dfdux(info.inputDim, info.stateDim);
+    for (size_t j = 0; j < info.stateDim; j++) {
+      const vector_t dx = eps * vector_t::Unit(info.stateDim, j);
+      const auto plus = dynamics.linearApproximation(t, x + dx, u);
+      const auto minus = dynamics.linearApproximation(t, x - dx, u);
+      dfdxx.col(j) = (plus.dfdx - minus.dfdx).transpose() * w / (2.0 * eps);
+      dfdux.col(j) = (plus.dfdu - minus.dfdu).transpose() * w / (2.0 * eps);
+    }
+    EXPECT_TRUE(hessian.dfdxx.isApprox(dfdxx, tol) || (hessian.dfdxx - dfdxx).norm() < tol) << hessian.dfdxx;
+    EXPECT_TRUE(hessian.dfdux.isApprox(dfdux, tol) || (hessian.dfdux - dfdux).norm() < tol) << hessian.dfdux;
+    EXPECT_TRUE(hessian.dfduu.isZero());
+  }
+}
+
+}  // unnamed namespace
+
+TEST(testManipulatorDynamics, defaultManipulator) {
+  const auto info = getModelInfo(ManipulatorModelType::DefaultManipulator, 0, 0);
+  DefaultManipulatorDynamics dynamics(info);
+  testDerivatives(dynamics, info);
+}
+
+TEST(testManipulatorDynamics, floatingArmManipulator) {
+  const auto info = getModelInfo(ManipulatorModelType::FloatingArmManipulator, 6, 0);
+  FloatingArmManipulatorDynamics dynamics(info);
+  testDerivatives(dynamics, info);
+}
+
+TEST(testManipulatorDynamics, fullyActuatedFloatingArmManipulator) {
+  const auto info = getModelInfo(ManipulatorModelType::FullyActuatedFloatingArmManipulator, 6, 6);
+  FullyActuatedFloatingArmManipulatorDynamics dynamics(info);
+  testDerivatives(dynamics, info);
+}
+
+TEST(testManipulatorDynamics, wheelBasedMobileManipulator) {
+  const auto info = getModelInfo(ManipulatorModelType::WheelBasedMobileManipulator, 3, 2);
+  WheelBasedMobileManipulatorDynamics dynamics(info);
+  testDerivatives(dynamics, info);
+}
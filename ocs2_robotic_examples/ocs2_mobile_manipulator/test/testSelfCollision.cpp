@@ -27,6 +27,9 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
+#include <algorithm>
+#include <limits>
+
 #include <pinocchio/fwd.hpp>
 
 #include <pinocchio/algorithm/frames.hpp>
@@ -42,6 +45,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_mobile_manipulator/FactoryFunctions.h"
 #include "ocs2_mobile_manipulator/MobileManipulatorInterface.h"
+#include "ocs2_mobile_manipulator/SelfCollisionPairAnalysis.h"
 #include "ocs2_mobile_manipulator/package_path.h"
 
 using namespace ocs2;
@@ -156,3 +160,34 @@ TEST_F(TestSelfCollision, testRandomJointPositions) {
     ASSERT_TRUE(Jd1.isApprox(Jd2));
   }
 }
+
+TEST_F(TestSelfCollision, pairAnalysis) {
+  const auto modelInfo =
+      createManipulatorModelInfo(pinocchioInterface, ManipulatorModelType::WheelBasedMobileManipulator, "base", "WRIST_2");
+  SelfCollisionPairAnalysisSettings settings;
+  settings.numSamples = 100;
+
+  // no pair is pruned with an infinite margin
+  settings.pruningMargin = std::numeric_limits<scalar_t>::infinity();
+  const auto analysis = analyzeSelfCollisionPairs(pinocchioInterface, modelInfo, geometryInterface, minDistance, settings);
+  ASSERT_EQ(analysis.collisionObjectPairs.size(), collisionPairs.size());
+  ASSERT_EQ(analysis.distanceLowerBounds.size(), collisionPairs.size());
+  for (size_t i = 0; i < collisionPairs.size(); i++) {
+    EXPECT_EQ(analysis.collisionObjectPairs[i], collisionPairs[i]);
+  }
+
+  // the pairs are pruned by their smallest sampled distance
+  settings.pruningMargin = *std::max_element(analysis.distanceLowerBounds.begin(), analysis.distanceLowerBounds.end()) - minDistance - 1e-6;
+  const auto prunedAnalysis = analyzeSelfCollisionPairs(pinocchioInterface, modelInfo, geometryInterface, minDistance, settings);
+  EXPECT_LT(prunedAnalysis.collisionObjectPairs.size(), collisionPairs.size());
+  for (const auto& bound : prunedAnalysis.distanceLowerBounds) {
+    EXPECT_LE(bound, minDistance + settings.pruningMargin);
+  }
+
+  // save and load
+  const std::string filename = "/tmp/ocs2_testSelfCollisionPairAnalysis.info";
+  saveSelfCollisionPairAnalysis(analysis, filename);
+  const auto loadedAnalysis = loadSelfCollisionPairAnalysis(filename, "selfCollisionPairAnalysis", false);
+  EXPECT_EQ(loadedAnalysis.collisionObjectPairs, analysis.collisionObjectPairs);
+  EXPECT_EQ(loadedAnalysis.distanceLowerBounds, analysis.distanceLowerBounds);
+}
@@ -30,7 +30,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #pragma once
 
 #include <robot_state_publisher/robot_state_publisher.h>
+#include <geometry_msgs/PoseArray.h>
 #include <tf/transform_broadcaster.h>
+#include <visualization_msgs/MarkerArray.h>
 
 #include <ocs2_ros_interfaces/mrt/DummyObserver.h>
 
@@ -68,6 +70,8 @@ class MobileManipulatorDummyVisualization final : public DummyObserver {
 
   ros::Publisher stateOptimizedPublisher_;
   ros::Publisher stateOptimizedPosePublisher_;
+  visualization_msgs::MarkerArray markerArray_;
+  geometry_msgs::PoseArray poseArray_;
 
   std::unique_ptr<GeometryInterfaceVisualization> geometryVisualization_;
 };
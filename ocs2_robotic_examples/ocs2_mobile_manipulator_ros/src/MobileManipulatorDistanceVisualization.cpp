@@ -81,8 +81,8 @@ int main(int argc, char** argv) {
   nodeHandle.getParam("/urdfFile", urdfPath);
 
   // read the task file
-  boost::property_tree::ptree pt;
-  boost::property_tree::read_info(taskFile, pt);
+  const auto ptPtr = loadData::readInfoFile(taskFile);
+  const boost::property_tree::ptree& pt = *ptPtr;
   // read manipulator type
   ManipulatorModelType modelType = mobile_manipulator::loadManipulatorType(taskFile, "model_information.manipulatorModelType");
   // read the joints to make fixed
@@ -34,6 +34,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_mpc/SystemObservation.h>
 #include <ocs2_ros_interfaces/mrt/MRT_ROS_Dummy_Loop.h>
 #include <ocs2_ros_interfaces/mrt/MRT_ROS_Interface.h>
+#include <ocs2_ros_interfaces/visualization/AsyncVisualizer.h>
 
 #include <ros/init.h>
 #include <ros/package.h>
@@ -66,10 +67,12 @@ int main(int argc, char** argv) {
   // Visualization
   std::shared_ptr<mobile_manipulator::MobileManipulatorDummyVisualization> dummyVisualization(
       new mobile_manipulator::MobileManipulatorDummyVisualization(nodeHandle, interface));
+  // the markers are built on a low-priority thread from the time-decimated solution
+  std::shared_ptr<AsyncVisualizer> asyncVisualizer(new AsyncVisualizer(AsyncVisualizer::Settings(), {dummyVisualization}));
 
   // Dummy MRT
   MRT_ROS_Dummy_Loop dummy(mrt, interface.mpcSettings().mrtDesiredFrequency_, interface.mpcSettings().mpcDesiredFrequency_);
-  dummy.subscribeObservers({dummyVisualization});
+  dummy.subscribeObservers({asyncVisualizer});
 
   // initial state
   SystemObservation initObservation;
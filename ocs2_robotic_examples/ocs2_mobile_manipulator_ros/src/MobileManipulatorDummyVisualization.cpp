@@ -102,8 +102,8 @@ void MobileManipulatorDummyVisualization::launchVisualizerNode(ros::NodeHandle&
   // read the joints to make fixed
   loadData::loadStdVector<std::string>(taskFile, "model_information.removeJoints", removeJointNames_, false);
   // read if self-collision checking active
-  boost::property_tree::ptree pt;
-  boost::property_tree::read_info(taskFile, pt);
+  const auto ptPtr = loadData::readInfoFile(taskFile);
+  const boost::property_tree::ptree& pt = *ptPtr;
   bool activateSelfCollision = true;
   loadData::loadPtreeValue(pt, activateSelfCollision, "selfCollision.activate", true);
   // create pinocchio interface
@@ -188,54 +188,47 @@ void MobileManipulatorDummyVisualization::publishOptimizedTrajectory(const ros::
   const std::array<scalar_t, 3> blue{0, 0.4470, 0.7410};
   const auto& mpcStateTrajectory = policy.stateTrajectory_;
 
-  visualization_msgs::MarkerArray markerArray;
+  // the messages are members such that the storage of the points and poses is reused
+  auto& markers = markerArray_.markers;
+  markers.resize(2);
+  auto& endEffectorLine = markers[0];
+  auto& baseLine = markers[1];
+  endEffectorLine.points.resize(mpcStateTrajectory.size());
+  baseLine.points.resize(mpcStateTrajectory.size());
+  poseArray_.poses.resize(mpcStateTrajectory.size());
 
-  // Base trajectory
-  std::vector<geometry_msgs::Point> baseTrajectory;
-  baseTrajectory.reserve(mpcStateTrajectory.size());
-  geometry_msgs::PoseArray poseArray;
-  poseArray.poses.reserve(mpcStateTrajectory.size());
-
-  // End effector trajectory
   const auto& model = pinocchioInterface_.getModel();
   auto& data = pinocchioInterface_.getData();
+  const auto eeIndex = model.getBodyId(modelInfo_.eeFrame);
+  for (size_t i = 0; i < mpcStateTrajectory.size(); i++) {
+    const auto& state = mpcStateTrajectory[i];
 
-  std::vector<geometry_msgs::Point> endEffectorTrajectory;
-  endEffectorTrajectory.reserve(mpcStateTrajectory.size());
-  std::for_each(mpcStateTrajectory.begin(), mpcStateTrajectory.end(), [&](const Eigen::VectorXd& state) {
+    // End effector trajectory
     pinocchio::forwardKinematics(model, data, state);
     pinocchio::updateFramePlacements(model, data);
-    const auto eeIndex = model.getBodyId(modelInfo_.eeFrame);
     const vector_t eePosition = data.oMf[eeIndex].translation();
-    endEffectorTrajectory.push_back(ros_msg_helpers::getPointMsg(eePosition));
-  });
-
-  markerArray.markers.emplace_back(ros_msg_helpers::getLineMsg(std::move(endEffectorTrajectory), blue, TRAJECTORYLINEWIDTH));
-  markerArray.markers.back().ns = "EE Trajectory";
+    endEffectorLine.points[i] = ros_msg_helpers::getPointMsg(eePosition);
 
-  // Extract base pose from state
-  std::for_each(mpcStateTrajectory.begin(), mpcStateTrajectory.end(), [&](const vector_t& state) {
-    // extract from observation
+    // Base trajectory
     const auto r_world_base = getBasePosition(state, modelInfo_);
     const Eigen::Quaternion<scalar_t> q_world_base = getBaseOrientation(state, modelInfo_);
-
-    // convert to ros message
-    geometry_msgs::Pose pose;
+    auto& pose = poseArray_.poses[i];
     pose.position = ros_msg_helpers::getPointMsg(r_world_base);
     pose.orientation = ros_msg_helpers::getOrientationMsg(q_world_base);
-    baseTrajectory.push_back(pose.position);
-    poseArray.poses.push_back(std::move(pose));
-  });
+    baseLine.points[i] = pose.position;
+  }
 
-  markerArray.markers.emplace_back(ros_msg_helpers::getLineMsg(std::move(baseTrajectory), red, TRAJECTORYLINEWIDTH));
-  markerArray.markers.back().ns = "Base Trajectory";
+  ros_msg_helpers::setLineMsgProperties(endEffectorLine, blue, TRAJECTORYLINEWIDTH);
+  endEffectorLine.ns = "EE Trajectory";
+  ros_msg_helpers::setLineMsgProperties(baseLine, red, TRAJECTORYLINEWIDTH);
+  baseLine.ns = "Base Trajectory";
 
-  assignHeader(markerArray.markers.begin(), markerArray.markers.end(), ros_msg_helpers::getHeaderMsg("world", timeStamp));
-  assignIncreasingId(markerArray.markers.begin(), markerArray.markers.end());
-  poseArray.header = ros_msg_helpers::getHeaderMsg("world", timeStamp);
+  assignHeader(markers.begin(), markers.end(), ros_msg_helpers::getHeaderMsg("world", timeStamp));
+  assignIncreasingId(markers.begin(), markers.end());
+  poseArray_.header = ros_msg_helpers::getHeaderMsg("world", timeStamp);
 
-  stateOptimizedPublisher_.publish(markerArray);
-  stateOptimizedPosePublisher_.publish(poseArray);
+  stateOptimizedPublisher_.publish(markerArray_);
+  stateOptimizedPosePublisher_.publish(poseArray_);
 }
 
 }  // namespace mobile_manipulator
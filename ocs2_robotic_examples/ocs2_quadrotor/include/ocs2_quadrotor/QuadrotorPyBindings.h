@@ -58,14 +58,18 @@ class QuadrotorPyBindings final : public PythonInterface {
     // Robot interface
     QuadrotorInterface quadrotorInterface(taskFile, libraryFolder);
 
+    // Thread pool which is shared by the solver and the batch methods
+    const auto& ddpSettings = quadrotorInterface.ddpSettings();
+    auto threadPoolPtr = std::make_shared<ThreadPool>(std::max(ddpSettings.nThreads_, size_t(1)) - 1, ddpSettings.threadPriority_);
+
     // MPC
     std::unique_ptr<GaussNewtonDDP_MPC> mpcPtr(
-        new GaussNewtonDDP_MPC(quadrotorInterface.mpcSettings(), quadrotorInterface.ddpSettings(), quadrotorInterface.getRollout(),
-                               quadrotorInterface.getOptimalControlProblem(), quadrotorInterface.getInitializer()));
+        new GaussNewtonDDP_MPC(quadrotorInterface.mpcSettings(), ddpSettings, quadrotorInterface.getRollout(),
+                               quadrotorInterface.getOptimalControlProblem(), quadrotorInterface.getInitializer(), threadPoolPtr));
     mpcPtr->getSolverPtr()->setReferenceManager(quadrotorInterface.getReferenceManagerPtr());
 
     // Python interface
-    PythonInterface::init(quadrotorInterface, std::move(mpcPtr));
+    PythonInterface::init(quadrotorInterface, std::move(mpcPtr), std::move(threadPoolPtr));
   }
 };
 
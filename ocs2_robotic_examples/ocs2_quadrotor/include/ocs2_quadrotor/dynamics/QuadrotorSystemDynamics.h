@@ -54,6 +54,13 @@ class QuadrotorSystemDynamics final : public SystemDynamicsBase {
   vector_t computeFlowMap(scalar_t time, const vector_t& state, const vector_t& input, const PreComputation&) override;
   VectorFunctionLinearApproximation linearApproximation(scalar_t t, const vector_t& x, const vector_t& u, const PreComputation&) override;
 
+  /** Vectorized over the columns of the batch with Eigen array expressions. */
+  void computeFlowMapBatch(scalar_t t, const matrix_t& xBatch, const matrix_t& uBatch, matrix_t& dxdtBatch) override;
+
+  /** Vectorized over the columns of the batch with Eigen array expressions. */
+  void linearApproximationBatch(scalar_t t, const matrix_t& xBatch, const matrix_t& uBatch, matrix_t& fBatch, matrix_t& dfdxBatch,
+                                matrix_t& dfduBatch) override;
+
  private:
   QuadrotorParameters param_;
 
@@ -230,5 +230,148 @@ VectorFunctionLinearApproximation QuadrotorSystemDynamics::linearApproximation(s
   return dynamics;
 }
 
+namespace {
+using row_array_t = Eigen::Array<scalar_t, 1, Eigen::Dynamic>;
+using strided_row_map_t = Eigen::Map<row_array_t, 0, Eigen::InnerStride<>>;
+
+/** Entry (i, j) of all the Jacobians placed side by side in a matrix with numRows rows and blocks of numCols columns. */
+strided_row_map_t jacobianEntries(matrix_t& jacobianBatch, Eigen::Index numCols, Eigen::Index i, Eigen::Index j) {
+  const auto numRows = jacobianBatch.rows();
+  const auto batchSize = jacobianBatch.cols() / numCols;
+  return strided_row_map_t(jacobianBatch.data() + j * numRows + i, batchSize, Eigen::InnerStride<>(numCols * numRows));
+}
+}  // unnamed namespace
+
+void QuadrotorSystemDynamics::computeFlowMapBatch(scalar_t t, const matrix_t& xBatch, const matrix_t& uBatch, matrix_t& dxdtBatch) {
+  const scalar_t m = param_.quadrotorMass_;
+  const scalar_t Ixy = param_.Thxxyy_;
+  const scalar_t Izz = param_.Thzz_;
+
+  const row_array_t sph = xBatch.row(3).array().sin();
+  const row_array_t cph = xBatch.row(3).array().cos();
+  const row_array_t sth = xBatch.row(4).array().sin();
+  const row_array_t cth = xBatch.row(4).array().cos();
+  const row_array_t sps = xBatch.row(5).array().sin();
+  const row_array_t cps = xBatch.row(5).array().cos();
+  const row_array_t cthInv = cth.inverse();
+
+  const auto dqph = xBatch.row(9).array();
+  const auto dqth = xBatch.row(10).array();
+  const auto dqps = xBatch.row(11).array();
+  const auto Fz = uBatch.row(0).array();
+  const auto Mx = uBatch.row(1).array();
+  const auto My = uBatch.row(2).array();
+  const auto Mz = uBatch.row(3).array();
+
+  // angular velocities in the Euler angles xy plane
+  const row_array_t a = cps * dqph - sps * dqth;
+  const row_array_t b = sps * dqph + cps * dqth;
+
+  dxdtBatch.resize(STATE_DIM, xBatch.cols());
+  dxdtBatch.topRows<3>() = xBatch.middleRows<3>(6);
+  dxdtBatch.row(3).array() = a * cthInv;
+  dxdtBatch.row(4).array() = b;
+  dxdtBatch.row(5).array() = dqps - sth * a * cthInv;
+  dxdtBatch.row(6).array() = Fz * sth / m;
+  dxdtBatch.row(7).array() = -Fz * cth * sph / m;
+  dxdtBatch.row(8).array() = Fz * cth * cph / m - param_.gravity_;
+  dxdtBatch.row(9).array() = cthInv * (Mx * cps - My * sps - Izz * dqps * dqth + (2.0 * Ixy - Izz) * dqph * dqth * sth) / Ixy;
+  dxdtBatch.row(10).array() = (Mx * sps + My * cps + (Izz - Ixy) * dqph.square() * sth * cth + Izz * dqph * dqps * cth) / Ixy;
+  const row_array_t f11 = Izz * dqph * dqth * sth.square() + Izz * dqps * dqth * sth - 2.0 * Ixy * dqph * dqth -
+                          (Mx * cps - My * sps) * sth + Ixy * dqph * dqth * cth.square();
+  dxdtBatch.row(11).array() = Mz / Izz + cthInv * f11 / Ixy;
+}
+
+void QuadrotorSystemDynamics::linearApproximationBatch(scalar_t t, const matrix_t& xBatch, const matrix_t& uBatch, matrix_t& fBatch,
+                                                       matrix_t& dfdxBatch, matrix_t& dfduBatch) {
+  computeFlowMapBatch(t, xBatch, uBatch, fBatch);
+
+  const scalar_t m = param_.quadrotorMass_;
+  const scalar_t Ixy = param_.Thxxyy_;
+  const scalar_t Izz = param_.Thzz_;
+  const auto batchSize = xBatch.cols();
+
+  const row_array_t sph = xBatch.row(3).array().sin();
+  const row_array_t cph = xBatch.row(3).array().cos();
+  const row_array_t sth = xBatch.row(4).array().sin();
+  const row_array_t cth = xBatch.row(4).array().cos();
+  const row_array_t sps = xBatch.row(5).array().sin();
+  const row_array_t cps = xBatch.row(5).array().cos();
+  const row_array_t cthInv = cth.inverse();
+  const row_array_t tth = sth * cthInv;
+
+  const auto dqph = xBatch.row(9).array();
+  const auto dqth = xBatch.row(10).array();
+  const auto dqps = xBatch.row(11).array();
+  const auto Fz = uBatch.row(0).array();
+  const auto Mx = uBatch.row(1).array();
+  const auto My = uBatch.row(2).array();
+
+  const row_array_t a = cps * dqph - sps * dqth;
+  const row_array_t b = sps * dqph + cps * dqth;
+  const row_array_t moments = Mx * cps - My * sps;
+  const row_array_t dMomentsDqps = -Mx * sps - My * cps;
+
+  dfdxBatch.setZero(STATE_DIM, STATE_DIM * batchSize);
+  const auto A = [&](Eigen::Index i, Eigen::Index j) { return jacobianEntries(dfdxBatch, STATE_DIM, i, j); };
+  for (int i = 0; i < 3; i++) {
+    A(i, 6 + i).setOnes();
+  }
+
+  // Euler angles derivatives
+  A(3, 4) = a * tth * cthInv;
+  A(3, 5) = -b * cthInv;
+  A(3, 9) = cps * cthInv;
+  A(3, 10) = -sps * cthInv;
+  A(4, 5) = a;
+  A(4, 9) = sps;
+  A(4, 10) = cps;
+  A(5, 4) = -a * cthInv.square();
+  A(5, 5) = b * tth;
+  A(5, 9) = -cps * tth;
+  A(5, 10) = sps * tth;
+  A(5, 11).setOnes();
+
+  // linear accelerations
+  A(6, 4) = Fz * cth / m;
+  A(7, 3) = -Fz * cth * cph / m;
+  A(7, 4) = Fz * sth * sph / m;
+  A(8, 3) = -Fz * cth * sph / m;
+  A(8, 4) = -Fz * sth * cph / m;
+
+  // angular accelerations
+  const row_array_t f9 = moments - Izz * dqps * dqth + (2.0 * Ixy - Izz) * dqph * dqth * sth;
+  A(9, 4) = (tth * cthInv * f9 + (2.0 * Ixy - Izz) * dqph * dqth) / Ixy;
+  A(9, 5) = cthInv * dMomentsDqps / Ixy;
+  A(9, 9) = (2.0 * Ixy - Izz) * dqth * tth / Ixy;
+  A(9, 10) = cthInv * (-Izz * dqps + (2.0 * Ixy - Izz) * dqph * sth) / Ixy;
+  A(9, 11) = -Izz * dqth * cthInv / Ixy;
+  A(10, 4) = ((Izz - Ixy) * dqph.square() * (cth.square() - sth.square()) - Izz * dqph * dqps * sth) / Ixy;
+  A(10, 5) = (Mx * cps - My * sps) / Ixy;
+  A(10, 9) = (2.0 * (Izz - Ixy) * dqph * sth * cth + Izz * dqps * cth) / Ixy;
+  A(10, 11) = Izz * dqph * cth / Ixy;
+  const row_array_t f11 = Izz * dqph * dqth * sth.square() + Izz * dqps * dqth * sth - 2.0 * Ixy * dqph * dqth - moments * sth +
+                          Ixy * dqph * dqth * cth.square();
+  const row_array_t df11Dqth = 2.0 * (Izz - Ixy) * dqph * dqth * sth * cth + Izz * dqps * dqth * cth - moments * cth;
+  A(11, 4) = (tth * cthInv * f11 + cthInv * df11Dqth) / Ixy;
+  A(11, 5) = -tth * dMomentsDqps / Ixy;
+  A(11, 9) = cthInv * dqth * (Izz * sth.square() - 2.0 * Ixy + Ixy * cth.square()) / Ixy;
+  A(11, 10) = cthInv * (Izz * dqph * sth.square() + Izz * dqps * sth - 2.0 * Ixy * dqph + Ixy * dqph * cth.square()) / Ixy;
+  A(11, 11) = Izz * dqth * tth / Ixy;
+
+  dfduBatch.setZero(STATE_DIM, INPUT_DIM * batchSize);
+  const auto B = [&](Eigen::Index i, Eigen::Index j) { return jacobianEntries(dfduBatch, INPUT_DIM, i, j); };
+  B(6, 0) = sth / m;
+  B(7, 0) = -cth * sph / m;
+  B(8, 0) = cth * cph / m;
+  B(9, 1) = cps * cthInv / Ixy;
+  B(9, 2) = -sps * cthInv / Ixy;
+  B(10, 1) = sps / Ixy;
+  B(10, 2) = cps / Ixy;
+  B(11, 1) = -cps * tth / Ixy;
+  B(11, 2) = sps * tth / Ixy;
+  B(11, 3).setConstant(1.0 / Izz);
+}
+
 }  // namespace quadrotor
 }  // namespace ocs2
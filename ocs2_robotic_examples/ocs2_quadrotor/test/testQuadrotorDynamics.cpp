@@ -0,0 +1,80 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "ocs2_quadrotor/dynamics/QuadrotorSystemDynamics.h"
+
+using namespace ocs2;
+using namespace quadrotor;
+
+class QuadrotorDynamicsTest : public ::testing::Test {
+ protected:
+  QuadrotorDynamicsTest() : dynamics_(getParameters()) {}
+
+  static QuadrotorParameters getParameters() {
+    QuadrotorParameters parameters;
+    parameters.quadrotorMass_ = 0.546;
+    parameters.Thzz_ = 0.0064;
+    parameters.Thxxyy_ = 0.0023;
+    return parameters;
+  }
+
+  const scalar_t t = 0.0;
+  const matrix_t xBatch = matrix_t::Random(STATE_DIM, 16);
+  const matrix_t uBatch = matrix_t::Random(INPUT_DIM, 16);
+  QuadrotorSystemDynamics dynamics_;
+};
+
+TEST_F(QuadrotorDynamicsTest, flowMapBatch) {
+  matrix_t dxdtBatch;
+  dynamics_.computeFlowMapBatch(t, xBatch, uBatch, dxdtBatch);
+
+  ASSERT_EQ(dxdtBatch.rows(), STATE_DIM);
+  ASSERT_EQ(dxdtBatch.cols(), xBatch.cols());
+  for (int k = 0; k < xBatch.cols(); k++) {
+    const vector_t dxdt = static_cast<SystemDynamicsBase&>(dynamics_).computeFlowMap(t, xBatch.col(k), uBatch.col(k));
+    EXPECT_TRUE(dxdtBatch.col(k).isApprox(dxdt)) << "batch:\n" << dxdtBatch.col(k).transpose() << "\nsingle:\n" << dxdt.transpose();
+  }
+}
+
+TEST_F(QuadrotorDynamicsTest, linearApproximationBatch) {
+  matrix_t fBatch, dfdxBatch, dfduBatch;
+  dynamics_.linearApproximationBatch(t, xBatch, uBatch, fBatch, dfdxBatch, dfduBatch);
+
+  ASSERT_EQ(dfdxBatch.cols(), STATE_DIM * xBatch.cols());
+  ASSERT_EQ(dfduBatch.cols(), INPUT_DIM * xBatch.cols());
+  for (int k = 0; k < xBatch.cols(); k++) {
+    const auto approximation = static_cast<SystemDynamicsBase&>(dynamics_).linearApproximation(t, xBatch.col(k), uBatch.col(k));
+    EXPECT_TRUE(fBatch.col(k).isApprox(approximation.f));
+    EXPECT_TRUE(dfdxBatch.middleCols(k * STATE_DIM, STATE_DIM).isApprox(approximation.dfdx))
+        << "batch:\n" << dfdxBatch.middleCols(k * STATE_DIM, STATE_DIM) << "\nsingle:\n" << approximation.dfdx;
+    EXPECT_TRUE(dfduBatch.middleCols(k * INPUT_DIM, INPUT_DIM).isApprox(approximation.dfdu));
+  }
+}
@@ -49,7 +49,8 @@ class TargetTrajectoriesRosPublisher final {
   /**
    * Constructor.
    * @param [in] nodeHandle: ROS node handle.
-   * @param [in] topicPrefix: The TargetTrajectories will be published on "topicPrefix_mpc_target" topic.
+   * @param [in] topicPrefix: The TargetTrajectories will be published on "topicPrefix_mpc_target" topic and the appended segments on
+   * "topicPrefix_mpc_target_append" topic.
    */
   TargetTrajectoriesRosPublisher(::ros::NodeHandle& nodeHandle, const std::string& topicPrefix = "anonymousRobot");
 
@@ -59,8 +60,12 @@ class TargetTrajectoriesRosPublisher final {
   /** Publishes the target trajectories. */
   void publishTargetTrajectories(const TargetTrajectories& targetTrajectories);
 
+  /** Publishes a segment which is appended to the target trajectories, see ReferenceManagerInterface::appendTargetTrajectories. */
+  void publishTargetTrajectoriesSegment(const TargetTrajectories& targetTrajectoriesSegment);
+
  private:
   ::ros::Publisher targetTrajectoriesPublisher_;
+  ::ros::Publisher targetTrajectoriesSegmentPublisher_;
 };
 
 }  // namespace ocs2
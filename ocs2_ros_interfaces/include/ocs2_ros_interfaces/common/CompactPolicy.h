@@ -0,0 +1,150 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_mpc/CommandData.h>
+#include <ocs2_oc/oc_data/PerformanceIndex.h>
+#include <ocs2_oc/oc_data/PrimalSolution.h>
+
+namespace ocs2 {
+namespace compact_policy {
+
+/**
+ * This structure holds the settings of the compact policy format.
+ */
+struct Settings {
+  /**
+   * The time window (in seconds) after the initial time of the policy which is sent. The first node after the window is kept such that
+   * the policy can be interpolated over the whole window. Any negative number will be interpreted as the whole policy.
+   */
+  scalar_t policyTimeWindow_ = -1;
+
+  /**
+   * The feedback gains of a linear controller are only sent on every gainDecimation_-th node, on the first and the last node, and on the
+   * nodes around events and dimension changes. In between, the receiver interpolates the gains linearly in time and recovers the bias
+   * such that the nominal input at the nominal state is retained.
+   */
+  size_t gainDecimation_ = 1;
+
+  /**
+   * If true, the policies in between two keyframes are sent as 16-bit quantized differences to the last keyframe, where each node is
+   * compared to the keyframe node closest in time. Every keyframeInterval_-th policy is a keyframe which is sent in full precision.
+   * A receiver which has missed a keyframe drops the policies until the next one arrives.
+   */
+  bool deltaEncoding_ = false;
+  size_t keyframeInterval_ = 10;
+
+  /** If false, the target trajectories of the command are not sent and the receiver gets empty target trajectories. */
+  bool sendTargetTrajectories_ = true;
+};
+
+/**
+ * Loads the compact policy settings from a given file.
+ *
+ * @param [in] filename: File name which contains the configuration data.
+ * @param [in] fieldName: Field name which contains the configuration data.
+ * @param [in] verbose: Flag to determine whether to print out the loaded settings or not.
+ * @return The compact policy settings
+ */
+Settings loadSettings(const std::string& filename, const std::string& fieldName = "compact_policy", bool verbose = true);
+
+/**
+ * The last keyframe as reconstructed by the receiver. It is the reference of the delta encoded policies.
+ */
+struct Keyframe {
+  bool valid = false;
+  uint32_t session = 0;
+  uint32_t sequence = 0;
+  scalar_array_t timeTrajectory;
+  std::vector<std::vector<float>> stateData;
+  std::vector<std::vector<float>> inputData;
+  std::vector<std::vector<float>> controllerData;
+};
+
+/**
+ * Serializes the MPC policy into a single contiguous buffer. The buffer starts with a header (format version, controller type, keyframe
+ * flag, and sequence numbers) followed by the command, the performance indices, the mode schedule, and the per-node state, input, and
+ * controller data.
+ */
+class Encoder {
+ public:
+  explicit Encoder(Settings settings);
+
+  /**
+   * Encodes the policy.
+   *
+   * @param [in] primalSolution: The policy data of the MPC.
+   * @param [in] commandData: The command data of the MPC.
+   * @param [in] performanceIndices: The performance indices data of the solver.
+   * @param [out] buffer: The encoded policy. The capacity of the buffer is reused.
+   */
+  void encode(const PrimalSolution& primalSolution, const CommandData& commandData, const PerformanceIndex& performanceIndices,
+              std::vector<uint8_t>& buffer);
+
+  /** Forces the next policy to be a keyframe. */
+  void reset() { keyframe_.valid = false; }
+
+  const Settings& settings() const { return settings_; }
+
+ private:
+  const Settings settings_;
+  const uint32_t session_;
+  uint32_t sequence_ = 0;
+  Keyframe keyframe_;
+};
+
+/**
+ * Reads the policies serialized by Encoder.
+ */
+class Decoder {
+ public:
+  /**
+   * Decodes the policy. Throws an exception if the buffer is malformed.
+   *
+   * @param [in] buffer: The encoded policy.
+   * @param [out] commandData: The MPC command data
+   * @param [out] primalSolution: The MPC policy data
+   * @param [out] performanceIndices: The MPC performance indices data
+   * @return false if the policy is delta encoded against a keyframe which has not been received.
+   */
+  bool decode(const std::vector<uint8_t>& buffer, CommandData& commandData, PrimalSolution& primalSolution,
+              PerformanceIndex& performanceIndices);
+
+ private:
+  Keyframe keyframe_;
+};
+
+}  // namespace compact_policy
+}  // namespace ocs2
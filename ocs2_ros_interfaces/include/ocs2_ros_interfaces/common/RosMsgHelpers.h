@@ -52,6 +52,8 @@ std_msgs::Header getHeaderMsg(const std::string& frame_id, const ros::Time& time
 
 visualization_msgs::Marker getLineMsg(std::vector<geometry_msgs::Point>&& points, std::array<double, 3> color, double lineWidth);
 
+void setLineMsgProperties(visualization_msgs::Marker& line, std::array<double, 3> color, double lineWidth);
+
 std_msgs::ColorRGBA getColor(std::array<double, 3> rgb, double alpha = 1.0);
 
 }  // namespace ros_msg_helpers
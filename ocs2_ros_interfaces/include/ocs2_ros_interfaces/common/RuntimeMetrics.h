@@ -0,0 +1,198 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include <ocs2_msgs/histogram.h>
+#include <ocs2_msgs/latency_metrics.h>
+#include <ocs2_msgs/mpc_solver_metrics.h>
+#include <ocs2_msgs/mrt_metrics.h>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_mpc/ObservationLatencyObserver.h>
+#include <ocs2_oc/oc_solver/SolverBase.h>
+
+namespace ocs2 {
+namespace runtime_metrics {
+
+/**
+ * A histogram with fixed bins. Bin i counts the samples in [binEdges[i], binEdges[i+1]), the last bin is open-ended. The samples below
+ * the first edge are counted in the first bin.
+ */
+class Histogram {
+ public:
+  /**
+   * Constructor.
+   *
+   * @param [in] binEdges: The increasing lower edges of the bins.
+   */
+  explicit Histogram(std::vector<scalar_t> binEdges);
+
+  /** Adds a sample. */
+  void add(scalar_t sample);
+
+  /** Removes all the samples. */
+  void clear();
+
+  size_t getNumSamples() const { return numSamples_; }
+  scalar_t getMean() const { return numSamples_ > 0 ? sum_ / static_cast<scalar_t>(numSamples_) : 0.0; }
+  scalar_t getMax() const { return max_; }
+  const std::vector<scalar_t>& getBinEdges() const { return binEdges_; }
+  const std::vector<size_t>& getCounts() const { return counts_; }
+
+ private:
+  std::vector<scalar_t> binEdges_;
+  std::vector<size_t> counts_;
+  size_t numSamples_ = 0;
+  scalar_t sum_ = 0.0;
+  scalar_t max_ = 0.0;
+};
+
+/** Creates the histogram message. */
+ocs2_msgs::histogram createHistogramMsg(const Histogram& histogram);
+
+/**
+ * Aggregates the metrics of the MPC cycles over a window of wall time.
+ */
+class MpcSolverMetrics {
+ public:
+  /**
+   * Constructor.
+   *
+   * @param [in] windowDuration: The duration of the aggregation window in seconds.
+   */
+  explicit MpcSolverMetrics(scalar_t windowDuration);
+
+  /**
+   * Adds an MPC cycle.
+   *
+   * @param [in] solveTime: The wall time of the MPC run in milliseconds.
+   * @param [in] runStatistics: The statistics of the solver run.
+   */
+  void addCycle(scalar_t solveTime, const SolverRunStatistics& runStatistics);
+
+  /**
+   * Creates the metrics message if the window has elapsed and starts a new window.
+   *
+   * @param [out] metricsMsg: The metrics of the elapsed window.
+   * @return true if the window has elapsed.
+   */
+  bool createMsgIfElapsed(ocs2_msgs::mpc_solver_metrics& metricsMsg);
+
+ private:
+  const std::chrono::steady_clock::duration windowDuration_;
+  std::chrono::steady_clock::time_point windowStart_;
+  Histogram solveTime_;
+  Histogram numIterations_;
+  size_t numLineSearchTrials_ = 0;
+  int qpStatus_ = 0;
+};
+
+/**
+ * Aggregates the metrics of the received policies over a window of wall time.
+ */
+class MrtMetrics {
+ public:
+  /**
+   * Constructor.
+   *
+   * @param [in] windowDuration: The duration of the aggregation window in seconds.
+   */
+  explicit MrtMetrics(scalar_t windowDuration);
+
+  /**
+   * Adds a received policy.
+   *
+   * @param [in] policyAge: The time from sending the observation to receiving the policy in milliseconds. A negative value indicates
+   * that the policy could not be matched to a sent observation.
+   * @param [in] numOverwrittenPolicies: The total number of policies which have been overwritten before they were used.
+   */
+  void addPolicy(scalar_t policyAge, size_t numOverwrittenPolicies);
+
+  /**
+   * Creates the metrics message if the window has elapsed and starts a new window.
+   *
+   * @param [out] metricsMsg: The metrics of the elapsed window.
+   * @return true if the window has elapsed.
+   */
+  bool createMsgIfElapsed(ocs2_msgs::mrt_metrics& metricsMsg);
+
+ private:
+  const std::chrono::steady_clock::duration windowDuration_;
+  std::chrono::steady_clock::time_point windowStart_;
+  size_t numPolicies_ = 0;
+  Histogram policyAge_;
+  size_t windowStartNumOverwrittenPolicies_ = 0;
+  size_t numOverwrittenPolicies_ = 0;
+};
+
+/**
+ * Aggregates the latencies of the policies up to their first actuation (see PolicyLatency) per stage over a window of wall time.
+ */
+class LatencyMetrics {
+ public:
+  /**
+   * Constructor.
+   *
+   * @param [in] budget: The end-to-end latency budget in seconds.
+   * @param [in] windowDuration: The duration of the aggregation window in seconds.
+   */
+  LatencyMetrics(scalar_t budget, scalar_t windowDuration);
+
+  /** Adds the latency of a policy. */
+  void addPolicy(const PolicyLatency& latency);
+
+  /**
+   * Creates the metrics message if the window has elapsed and starts a new window.
+   *
+   * @param [out] metricsMsg: The metrics of the elapsed window.
+   * @return true if the window has elapsed.
+   */
+  bool createMsgIfElapsed(ocs2_msgs::latency_metrics& metricsMsg);
+
+ private:
+  const scalar_t budget_;
+  const std::chrono::steady_clock::duration windowDuration_;
+  std::chrono::steady_clock::time_point windowStart_;
+  size_t numOverBudget_ = 0;
+  Histogram mpcModules_;
+  Histogram mpcSolver_;
+  Histogram mpcOverhead_;
+  Histogram transport_;
+  Histogram policyWaiting_;
+  Histogram evaluation_;
+  Histogram endToEnd_;
+};
+
+}  // namespace runtime_metrics
+}  // namespace ocs2
@@ -0,0 +1,132 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "ocs2_ros_interfaces/common/CompactPolicy.h"
+
+namespace ocs2 {
+namespace shared_memory_policy {
+
+struct SegmentHeader;
+
+/** Returns the name of the POSIX shared memory segment of the policies for the given topic prefix. */
+std::string getSegmentName(const std::string& topicPrefix);
+
+/**
+ * Writes the MPC policies into a ring of slots in a POSIX shared memory segment. A policy is serialized in the compact format (see
+ * compact_policy::Encoder) in full precision and copied into a slot. Each slot is guarded by a sequence number (seqlock), such that the
+ * writer never waits for the readers and a reader detects a slot which has been overwritten while it was read.
+ */
+class PolicyWriter {
+ public:
+  /**
+   * Constructor. Creates (or takes over) the shared memory segment.
+   *
+   * @param [in] segmentName: The name of the shared memory segment.
+   * @param [in] slotCapacity: The maximum size of a serialized policy in bytes.
+   * @param [in] numSlots: The number of slots in the ring.
+   */
+  explicit PolicyWriter(std::string segmentName, size_t slotCapacity = 8 * 1024 * 1024, size_t numSlots = 3);
+
+  /** Destructor. Marks the segment as closed and removes it. */
+  ~PolicyWriter();
+
+  PolicyWriter(const PolicyWriter&) = delete;
+  PolicyWriter& operator=(const PolicyWriter&) = delete;
+
+  /**
+   * Writes the policy into the next slot.
+   *
+   * @param [in] primalSolution: The policy data of the MPC.
+   * @param [in] commandData: The command data of the MPC.
+   * @param [in] performanceIndices: The performance indices data of the solver.
+   */
+  void write(const PrimalSolution& primalSolution, const CommandData& commandData, const PerformanceIndex& performanceIndices);
+
+ private:
+  const std::string segmentName_;
+  size_t segmentSize_;
+  SegmentHeader* headerPtr_;
+  compact_policy::Encoder encoder_;
+  std::vector<uint8_t> buffer_;
+  uint64_t sequence_ = 0;
+};
+
+/**
+ * Reads the latest MPC policy written by PolicyWriter. The segment is opened once the writer has created it, and reopened if the writer
+ * is shut down or restarted.
+ */
+class PolicyReader {
+ public:
+  /**
+   * Constructor.
+   *
+   * @param [in] segmentName: The name of the shared memory segment.
+   */
+  explicit PolicyReader(std::string segmentName);
+
+  /** Destructor. */
+  ~PolicyReader();
+
+  PolicyReader(const PolicyReader&) = delete;
+  PolicyReader& operator=(const PolicyReader&) = delete;
+
+  /**
+   * Reads the latest policy if it has not been read yet.
+   *
+   * @param [out] commandData: The MPC command data
+   * @param [out] primalSolution: The MPC policy data
+   * @param [out] performanceIndices: The MPC performance indices data
+   * @return true if a new policy is read.
+   */
+  bool read(CommandData& commandData, PrimalSolution& primalSolution, PerformanceIndex& performanceIndices);
+
+ private:
+  bool open();
+  void close();
+  bool isReplaced();
+
+  const std::string segmentName_;
+  size_t segmentSize_ = 0;
+  SegmentHeader* headerPtr_ = nullptr;
+  compact_policy::Decoder decoder_;
+  std::vector<uint8_t> buffer_;
+  uint64_t segmentId_ = 0;
+  uint64_t lastSequence_ = 0;
+  std::chrono::steady_clock::time_point lastReplacementCheck_;
+};
+
+}  // namespace shared_memory_policy
+}  // namespace ocs2
@@ -41,8 +41,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ros/callback_queue.h>
 #include <ros/ros.h>
 #include <ros/transport_hints.h>
+#include <std_srvs/Trigger.h>
 
 #include <ocs2_msgs/mode_schedule.h>
+#include <ocs2_msgs/mpc_compact_policy.h>
 #include <ocs2_msgs/mpc_flattened_controller.h>
 #include <ocs2_msgs/mpc_observation.h>
 #include <ocs2_msgs/mpc_target_trajectories.h>
@@ -51,11 +53,16 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/control/FeedforwardController.h>
 #include <ocs2_core/control/LinearController.h>
 #include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_core/misc/Tracer.h>
 #include <ocs2_mpc/CommandData.h>
 #include <ocs2_mpc/MPC_BASE.h>
 #include <ocs2_mpc/SystemObservation.h>
 #include <ocs2_oc/oc_data/PrimalSolution.h>
 
+#include "ocs2_ros_interfaces/common/CompactPolicy.h"
+#include "ocs2_ros_interfaces/common/RuntimeMetrics.h"
+#include "ocs2_ros_interfaces/common/SharedMemoryPolicy.h"
+
 #define PUBLISH_THREAD
 
 namespace ocs2 {
@@ -102,6 +109,57 @@ class MPC_ROS_Interface {
    */
   void launchNodes(ros::NodeHandle& nodeHandle);
 
+  /**
+   * Sets up the subscribers, the publishers, and the services of launchNodes() without spinning. The callbacks are served by the
+   * callback queue of nodeHandle, which allows to run several MPC nodes in one process (see MultiRobotMpcServer).
+   */
+  void advertise(ros::NodeHandle& nodeHandle);
+
+  /**
+   * Publishes the policy in the compact format (see compact_policy::Encoder) on the topic "topicPrefix_mpc_compact_policy" instead of
+   * the flattened controller on "topicPrefix_mpc_policy". This method should be called before launchNodes().
+   *
+   * @param [in] settings: The compact policy settings.
+   */
+  void enableCompactPolicy(const compact_policy::Settings& settings);
+
+  /**
+   * Hands the policy over to the MRT through a POSIX shared memory segment (see shared_memory_policy::PolicyWriter) instead of
+   * publishing it. The policy is written right after the MPC run, without the publisher thread. This is only applicable if the MPC and
+   * the MRT run on the same host. This method should be called before launchNodes().
+   *
+   * @param [in] slotCapacity: The maximum size of a serialized policy in bytes.
+   */
+  void enableSharedMemoryPolicy(size_t slotCapacity = 8 * 1024 * 1024);
+
+  /**
+   * Subscribes to the observations over UDP (with TCP as fallback) instead of TCP, which avoids the head-of-line blocking of TCP.
+   * Independent of the transport, an observation whose sequence number is not newer than the one of the latest processed observation
+   * is dropped. This method should be called before launchNodes().
+   */
+  void enableUnreliableObservation();
+
+  /**
+   * Records the timeline of the MPC cycles, i.e. the solver stages per worker, the rollouts, the line-search trials, and the policy
+   * publication, into a ring buffer (see benchmark::Tracer). The latest events are dumped to traceFileName in the Chrome trace format
+   * (readable by chrome://tracing and the Perfetto UI) on a call of the service "topicPrefix_mpc_dump_trace" or when the process receives
+   * SIGUSR1. This method should be called before launchNodes().
+   *
+   * @param [in] traceFileName: The file to which the trace is dumped.
+   * @param [in] capacity: The number of the latest events which are kept.
+   */
+  void enableTracing(std::string traceFileName, size_t capacity = 65536);
+
+  /**
+   * Publishes the metrics of the MPC cycles on the topic "topicPrefix_mpc_metrics" (see ocs2_msgs::mpc_solver_metrics): the histograms of
+   * the solve time and of the number of iterations, the number of line-search trials, and the latest QP status, aggregated over a window
+   * of wall time. The message is published by the first MPC cycle after the window has elapsed. This method should be called before
+   * launchNodes().
+   *
+   * @param [in] windowDuration: The duration of the aggregation window in seconds.
+   */
+  void enableMetrics(scalar_t windowDuration = 1.0);
+
  protected:
   /**
    * Callback to reset MPC.
@@ -111,6 +169,22 @@ class MPC_ROS_Interface {
    */
   bool resetMpcCallback(ocs2_msgs::reset::Request& req, ocs2_msgs::reset::Response& res);
 
+  /**
+   * Callback to dump the trace.
+   *
+   * @param req: Service request.
+   * @param res: Service response.
+   */
+  bool dumpTraceCallback(std_srvs::Trigger::Request& req, std_srvs::Trigger::Response& res);
+
+  /**
+   * Dumps the trace to the trace file.
+   *
+   * @param [out] message: The description of the result.
+   * @return true if the trace is written.
+   */
+  bool dumpTrace(std::string& message) const;
+
   /**
    * Creates MPC Policy message.
    *
@@ -122,6 +196,27 @@ class MPC_ROS_Interface {
   static ocs2_msgs::mpc_flattened_controller createMpcPolicyMsg(const PrimalSolution& primalSolution, const CommandData& commandData,
                                                                 const PerformanceIndex& performanceIndices);
 
+  /**
+   * Fills the MPC Policy message in place. The arrays of the message are resized, such that a message which is reused for every
+   * policy does not reallocate once the policies have reached their maximum length.
+   *
+   * @param [in] primalSolution: The policy data of the MPC.
+   * @param [in] commandData: The command data of the MPC.
+   * @param [in] performanceIndices: The performance indices data of the solver.
+   * @param [out] mpcPolicyMsg: MPC policy message.
+   */
+  static void fillMpcPolicyMsg(const PrimalSolution& primalSolution, const CommandData& commandData,
+                               const PerformanceIndex& performanceIndices, ocs2_msgs::mpc_flattened_controller& mpcPolicyMsg);
+
+  /**
+   * Publishes the policy either as the flattened controller message or in the compact format.
+   *
+   * @param [in] primalSolution: The policy data of the MPC.
+   * @param [in] commandData: The command data of the MPC.
+   * @param [in] performanceIndices: The performance indices data of the solver.
+   */
+  void publishPolicy(const PrimalSolution& primalSolution, const CommandData& commandData, const PerformanceIndex& performanceIndices);
+
   /**
    * Handles ROS publishing thread.
    */
@@ -131,8 +226,9 @@ class MPC_ROS_Interface {
    * Updates the buffer variables from the MPC object. This method is automatically called by advanceMpc()
    *
    * @param [in] mpcInitObservation: The observation used to run the MPC.
+   * @param [in] mpcTiming: The wall times which the MPC has spent on the policy.
    */
-  void copyToBuffer(const SystemObservation& mpcInitObservation);
+  void copyToBuffer(const SystemObservation& mpcInitObservation, const MpcTiming& mpcTiming);
 
   /**
    * The callback method which receives the current observation, invokes the MPC algorithm,
@@ -176,9 +272,35 @@ class MPC_ROS_Interface {
 
   benchmark::RepeatedTimer mpcTimer_;
 
+  // Loaned policy messages and the timer of their creation and publication. The messages are published as shared pointers such that
+  // subscribers in the same process receive them without serialization. A message is reused once ROS does not hold it anymore.
+  std::vector<ocs2_msgs::mpc_flattened_controller::Ptr> mpcPolicyMsgPool_;
+  benchmark::RepeatedTimer publishTimer_;
+
+  // compact policy
+  std::unique_ptr<compact_policy::Encoder> compactPolicyEncoderPtr_;
+  std::vector<ocs2_msgs::mpc_compact_policy::Ptr> compactPolicyMsgPool_;
+
+  // shared memory policy
+  std::unique_ptr<shared_memory_policy::PolicyWriter> sharedMemoryPolicyWriterPtr_;
+
+  // observation transport and the sequence number of the latest processed observation
+  ::ros::TransportHints observationTransportHints_ = ::ros::TransportHints().tcpNoDelay();
+  uint32_t latestObservationSequence_ = 0;
+
   // MPC reset
   std::mutex resetMutex_;
   std::atomic_bool resetRequestedEver_{false};
+
+  // tracing
+  std::shared_ptr<benchmark::Tracer> tracerPtr_;
+  std::string traceFileName_;
+  ::ros::ServiceServer dumpTraceServiceServer_;
+
+  // runtime metrics
+  std::unique_ptr<runtime_metrics::MpcSolverMetrics> metricsPtr_;
+  ::ros::Publisher metricsPublisher_;
+  ocs2_msgs::mpc_solver_metrics metricsMsg_;
 };
 
 }  // namespace ocs2
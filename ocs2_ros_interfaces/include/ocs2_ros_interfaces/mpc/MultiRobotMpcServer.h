@@ -0,0 +1,135 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <ros/callback_queue.h>
+#include <ros/ros.h>
+#include <ros/spinner.h>
+
+#include <ocs2_core/thread_support/ThreadPool.h>
+#include <ocs2_mpc/MPC_BASE.h>
+
+#include "ocs2_ros_interfaces/mpc/MPC_ROS_Interface.h"
+
+namespace ocs2 {
+
+/**
+ * This class hosts the MPCs of several identical robots in one process. Each robot has its own MPC and MPC_ROS_Interface, which
+ * communicate on the topics of the prefix "robotName_robotId" (see getTopicPrefix()), i.e. an MRT of a robot connects to the server
+ * as to a standalone MPC node of this prefix.
+ *
+ * The robots share the resources which are identical among them:
+ * - The MPCs should be created from the same robot interface. The solvers clone the optimal control problem, whose copies share the
+ *   generated CppAD libraries and the Pinocchio models instead of loading them per robot.
+ * - The solvers run on one thread pool, which is passed to the MPC factory. Its parallelFor balances the work of concurrent MPC cycles
+ *   by work stealing. Each solver still uses at most its own number of threads of the pool.
+ *
+ * The observations of each robot are served on a dedicated callback queue and thread, such that the MPC cycles of the robots run
+ * concurrently and a slow robot does not delay the others.
+ */
+class MultiRobotMpcServer {
+ public:
+  /**
+   * Creates the MPC of a robot.
+   *
+   * @param [in] robotIndex: The index of the robot.
+   * @param [in] topicPrefix: The topic prefix of the robot, e.g., for the RosReferenceManager of the robot.
+   * @param [in] nodeHandle: The node handle of the robot, whose callbacks are served on the callback queue of the robot.
+   * @param [in] threadPoolPtr: The thread pool which is shared by all robots.
+   * @return The MPC of the robot.
+   */
+  using mpc_factory_t = std::function<std::unique_ptr<MPC_BASE>(size_t robotIndex, const std::string& topicPrefix,
+                                                                 ::ros::NodeHandle& nodeHandle, std::shared_ptr<ThreadPool> threadPoolPtr)>;
+
+  /**
+   * Constructor. Creates the MPCs of all robots.
+   *
+   * @param [in] nodeHandle: The node handle from which the node handles of the robots are derived.
+   * @param [in] robotName: The name of the robots.
+   * @param [in] robotIds: The unique ids of the robots.
+   * @param [in] mpcFactory: Creates the MPC of a robot.
+   * @param [in] nThreads: The number of threads of the shared thread pool.
+   * @param [in] threadPriority: The priority of the threads of the shared thread pool.
+   */
+  MultiRobotMpcServer(::ros::NodeHandle& nodeHandle, const std::string& robotName, const std::vector<std::string>& robotIds,
+                      const mpc_factory_t& mpcFactory, size_t nThreads, int threadPriority = 0);
+
+  /**
+   * Destructor.
+   */
+  ~MultiRobotMpcServer();
+
+  /** Gets the topic prefix of a robot. */
+  static std::string getTopicPrefix(const std::string& robotName, const std::string& robotId) { return robotName + "_" + robotId; }
+
+  /** Gets the number of robots. */
+  size_t getNumRobots() const { return robots_.size(); }
+
+  /** Gets the MPC of a robot. */
+  MPC_BASE& getMpc(size_t robotIndex) { return *robots_[robotIndex].mpcPtr; }
+
+  /**
+   * Gets the MPC ROS interface of a robot, e.g., to enable the compact policy. The interface should be configured before launchNodes().
+   */
+  MPC_ROS_Interface& getMpcInterface(size_t robotIndex) { return *robots_[robotIndex].mpcInterfacePtr; }
+
+  /** Gets the thread pool which is shared by the robots. */
+  const std::shared_ptr<ThreadPool>& getThreadPoolPtr() const { return threadPoolPtr_; }
+
+  /**
+   * Launches the MPC nodes of all robots and spins until ROS is shut down.
+   */
+  void launchNodes();
+
+  /**
+   * Stops serving the robots and shutdowns their MPC nodes.
+   */
+  void shutdownNodes();
+
+ private:
+  struct Robot {
+    std::string topicPrefix;
+    std::unique_ptr<::ros::CallbackQueue> callbackQueuePtr;
+    std::unique_ptr<::ros::NodeHandle> nodeHandlePtr;
+    std::unique_ptr<MPC_BASE> mpcPtr;
+    std::unique_ptr<MPC_ROS_Interface> mpcInterfacePtr;
+    std::unique_ptr<::ros::AsyncSpinner> spinnerPtr;
+  };
+
+  std::shared_ptr<ThreadPool> threadPoolPtr_;
+  std::vector<Robot> robots_;
+};
+
+}  // namespace ocs2
@@ -29,25 +29,35 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <csignal>
 #include <ctime>
 #include <iostream>
+#include <limits>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include <ros/callback_queue.h>
 #include <ros/ros.h>
 #include <ros/transport_hints.h>
 
 // MPC messages
+#include <ocs2_msgs/mpc_compact_policy.h>
 #include <ocs2_msgs/mpc_flattened_controller.h>
 #include <ocs2_msgs/reset.h>
 
+#include <ocs2_core/thread_support/TripleBuffer.h>
+#include <ocs2_mpc/MPC_BASE.h>
 #include <ocs2_mpc/MRT_BASE.h>
+#include <ocs2_mpc/ObservationLatencyObserver.h>
 
+#include "ocs2_ros_interfaces/common/CompactPolicy.h"
 #include "ocs2_ros_interfaces/common/RosMsgConversions.h"
+#include "ocs2_ros_interfaces/common/RuntimeMetrics.h"
+#include "ocs2_ros_interfaces/common/SharedMemoryPolicy.h"
 
 #define PUBLISH_THREAD
 
@@ -62,7 +72,7 @@ class MRT_ROS_Interface : public MRT_BASE {
    * Constructor
    *
    * @param [in] topicPrefix: The prefix defines the names for: observation's publishing topic "topicPrefix_mpc_observation",
-   * policy's receiving topic "topicPrefix_mpc_policy", and MPC reset service "topicPrefix_mpc_reset".
+   * policy's receiving topics "topicPrefix_mpc_policy" and "topicPrefix_mpc_compact_policy", and MPC reset service "topicPrefix_mpc_reset".
    * @param [in] mrtTransportHints: ROS transmission protocol.
    */
   explicit MRT_ROS_Interface(std::string topicPrefix = "anonymousRobot",
@@ -86,10 +96,48 @@ class MRT_ROS_Interface : public MRT_BASE {
   void shutdownPublisher();
 
   /**
-   * spin the MRT callback queue
+   * spin the MRT callback queue, and read the shared memory policy if it is enabled. This is a no-op while the receiver thread is running.
    */
   void spinMRT();
 
+  /**
+   * Starts a thread which receives the policies in the background: it spins the MRT callback queue and reads the shared memory policy
+   * (if enabled), such that deserializing the policy does not run on the control loop. The control loop then only calls updatePolicy(),
+   * which swaps in the staged policy. This method should be called after launchNodes().
+   *
+   * @param [in] priority: The priority of the receiver thread from 0 (unchanged) to 99 (highest), see setThreadPriority.
+   * @param [in] cpus: The indices of the CPUs the receiver thread may run on. If empty, the affinity is not changed.
+   */
+  void launchReceiverThread(int priority = 0, const std::vector<int>& cpus = {});
+
+  /**
+   * Receives the policy through the POSIX shared memory segment written by MPC_ROS_Interface::enableSharedMemoryPolicy. The segment
+   * is polled in spinMRT(). The policy topics are still subscribed.
+   */
+  void enableSharedMemoryPolicy();
+
+  /**
+   * Runs an onboard MPC as the fallback of the (remote) MPC node, e.g. with a shorter horizon and fewer threads than the MPC node on an
+   * off-board computer. The policies of both are selected by PolicySelector: the policies of the MPC node (source 0) are preferred by
+   * the given time margin over the fresher policies of the fallback MPC (source 1), hence the fallback only takes over once the link to
+   * the MPC node is lost or its policies are invalid. The fallback MPC is reset by resetMpcNode() and it is run by advanceFallbackMpc().
+   *
+   * @param [in] fallbackMpc: The onboard MPC. It should outlive this class.
+   * @param [in] remoteTimeMargin: The time margin of the policies of the MPC node in seconds.
+   * @param [in] maxConstraintViolationSSE: The maximum constraint violation of a valid policy, see PolicySelector.
+   */
+  void enableFallbackMpc(MPC_BASE& fallbackMpc, scalar_t remoteTimeMargin,
+                         scalar_t maxConstraintViolationSSE = std::numeric_limits<scalar_t>::infinity());
+
+  /**
+   * Advances the fallback MPC for one iteration from the latest observation set by setCurrentObservation(), see enableFallbackMpc(). The
+   * evaluation methods can be called while this method is running. It should be called in a loop on a dedicated thread. A concurrent
+   * resetMpcNode() waits for the running iteration to finish.
+   *
+   * @return true if the fallback MPC has computed a new policy.
+   */
+  bool advanceFallbackMpc();
+
   /**
    * Launches the ROS publishers and subscribers to communicate with the MPC node.
    * @param nodeHandle
@@ -98,6 +146,47 @@ class MRT_ROS_Interface : public MRT_BASE {
 
   void setCurrentObservation(const SystemObservation& currentObservation) override;
 
+  /**
+   * Limits the rate at which the observations are published. An observation which follows the previously published one within less than
+   * the period is not published. Any non-positive number disables the throttling.
+   *
+   * @param [in] maxRate: The maximum publishing rate in Hz.
+   */
+  void setObservationPublishingRate(scalar_t maxRate);
+
+  /**
+   * Gets the statistics of the latency from publishing an observation to receiving the policy computed from it, as measured by an
+   * ObservationLatencyObserver which this class adds to its MRT observers.
+   */
+  ObservationLatencyStatistics getObservationLatencyStatistics() const { return observationLatencyObserverPtr_->getStatistics(); }
+
+  /**
+   * Publishes the metrics of the received policies on the topic "topicPrefix_mrt_metrics" (see ocs2_msgs::mrt_metrics): the histogram of
+   * the policy age on arrival, i.e. the time from publishing an observation to receiving the policy computed from it, and the number of
+   * policies which are overwritten before updatePolicy() picks them up, aggregated over a window of wall time. The message is published
+   * on the arrival of the first policy after the window has elapsed. This method should be called before launchNodes().
+   *
+   * @param [in] windowDuration: The duration of the aggregation window in seconds.
+   */
+  void enableMetrics(scalar_t windowDuration = 1.0);
+
+  /**
+   * Publishes the latency of the policies up to their first actuation on the topic "topicPrefix_mrt_latency" (see
+   * ocs2_msgs::latency_metrics). The latency is broken down into the stages of PolicyLatency, from the MPC synchronized modules and the
+   * solver to the transport, the waiting for updatePolicy(), and the evaluation, and it is aggregated over a window of wall time. The
+   * control loop reports the actuations with policyActuated(). This method should be called before launchNodes().
+   *
+   * @param [in] budget: The end-to-end latency budget in seconds.
+   * @param [in] windowDuration: The duration of the aggregation window in seconds.
+   */
+  void enableLatencyMetrics(scalar_t budget, scalar_t windowDuration = 1.0);
+
+  /**
+   * Reports that the control loop has actuated the system with the active policy, e.g. after evaluating the policy and sending the
+   * command. This method should be called on the thread which calls updatePolicy().
+   */
+  void policyActuated();
+
  private:
   /**
    * Callback method to receive the MPC policy as well as the mode sequence.
@@ -107,6 +196,25 @@ class MRT_ROS_Interface : public MRT_BASE {
    */
   void mpcPolicyCallback(const ocs2_msgs::mpc_flattened_controller::ConstPtr& msg);
 
+  /**
+   * Callback method to receive the MPC policy in the compact format (see compact_policy::Encoder).
+   * It only updates the policy variables with suffix (*Buffer_) variables.
+   *
+   * @param [in] msg: A constant pointer to the message
+   */
+  void mpcCompactPolicyCallback(const ocs2_msgs::mpc_compact_policy::ConstPtr& msg);
+
+  /**
+   * Reads the latest policy from the shared memory segment, if there is a new one.
+   */
+  void readSharedMemoryPolicy();
+
+  /**
+   * Moves the received policy to the buffer and updates the runtime metrics.
+   */
+  void bufferPolicy(std::unique_ptr<CommandData> commandPtr, std::unique_ptr<PrimalSolution> primalSolutionPtr,
+                    std::unique_ptr<PerformanceIndex> performanceIndicesPtr);
+
   /**
    * Helper function to read a MPC policy message.
    *
@@ -123,27 +231,67 @@ class MRT_ROS_Interface : public MRT_BASE {
    */
   void publisherWorkerThread();
 
+  /**
+   * A thread function which receives the policies.
+   */
+  void receiverWorkerThread();
+
+  /**
+   * Stops the receiver thread if it is running.
+   */
+  void shutdownReceiver();
+
  private:
   std::string topicPrefix_;
 
   // Publishers and subscribers
   ::ros::Publisher mpcObservationPublisher_;
   ::ros::Subscriber mpcPolicySubscriber_;
+  ::ros::Subscriber mpcCompactPolicySubscriber_;
   ::ros::ServiceClient mpcResetServiceClient_;
 
   // ROS messages
   ocs2_msgs::mpc_observation mpcObservationMsg_;
   ocs2_msgs::mpc_observation mpcObservationMsgBuffer_;
 
+  // Observation sequence, throttling, and latency
+  uint32_t observationSequence_ = 0;
+  std::chrono::steady_clock::duration minObservationPeriod_{0};
+  std::chrono::steady_clock::time_point lastObservationPublishTime_;
+  std::shared_ptr<ObservationLatencyObserver> observationLatencyObserverPtr_;
+
   ::ros::CallbackQueue mrtCallbackQueue_;
   ::ros::TransportHints mrtTransportHints_;
 
+  compact_policy::Decoder compactPolicyDecoder_;
+  std::unique_ptr<shared_memory_policy::PolicyReader> sharedMemoryPolicyReaderPtr_;
+
+  // Onboard fallback MPC
+  MPC_BASE* fallbackMpcPtr_ = nullptr;
+  TripleBuffer<SystemObservation> fallbackObservationBuffer_;  // written by setCurrentObservation(), read by advanceFallbackMpc()
+  SystemObservation fallbackMpcObservation_;
+  std::mutex fallbackMpcMutex_;  // serializes advanceFallbackMpc() and the reset of the fallback MPC in resetMpcNode()
+
+  // Runtime metrics
+  std::unique_ptr<runtime_metrics::MrtMetrics> metricsPtr_;
+  ::ros::Publisher metricsPublisher_;
+  ocs2_msgs::mrt_metrics metricsMsg_;
+  size_t numLatencySamples_ = 0;
+  std::unique_ptr<runtime_metrics::LatencyMetrics> latencyMetricsPtr_;
+  ::ros::Publisher latencyMetricsPublisher_;
+  ocs2_msgs::latency_metrics latencyMetricsMsg_;
+
   // Multi-threading for publishers
   bool terminateThread_;
   bool readyToPublish_;
   std::thread publisherWorker_;
   std::mutex publisherMutex_;
   std::condition_variable msgReady_;
+
+  // Receiver thread
+  std::atomic_bool terminateReceiverThread_{false};
+  std::atomic_bool receiverThreadRunning_{false};
+  std::thread receiverWorker_;
 };
 
 }  // namespace ocs2
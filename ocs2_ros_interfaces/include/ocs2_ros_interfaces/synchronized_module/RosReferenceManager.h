@@ -67,9 +67,11 @@ class RosReferenceManager final : public ReferenceManagerDecorator {
   static std::unique_ptr<RosReferenceManager> create(const std::string& topicPrefix, Args&&... args);
 
   /**
-   * Subscribers to "topicPrefix_mode_schedule" and "topicPrefix_mpc_target" topics to receive respectively:
+   * Subscribers to "topicPrefix_mode_schedule", "topicPrefix_mpc_target", and "topicPrefix_mpc_target_append" topics to receive
+   * respectively:
    * (1) ModeSchedule : The predefined mode schedule for time-triggered hybrid systems.
    * (2) TargetTrajectories : The commanded TargetTrajectories.
+   * (3) TargetTrajectories segments : The segments which are appended to the commanded TargetTrajectories.
    */
   void subscribe(ros::NodeHandle& nodeHandle);
 
@@ -78,6 +80,7 @@ class RosReferenceManager final : public ReferenceManagerDecorator {
 
   ::ros::Subscriber modeScheduleSubscriber_;
   ::ros::Subscriber targetTrajectoriesSubscriber_;
+  ::ros::Subscriber targetTrajectoriesSegmentSubscriber_;
 };
 
 /******************************************************************************************************/
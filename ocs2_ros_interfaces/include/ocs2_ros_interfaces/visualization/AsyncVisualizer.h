@@ -0,0 +1,109 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <ocs2_ros_interfaces/mrt/DummyObserver.h>
+
+namespace ocs2 {
+
+/**
+ * Decimates the primal solution in time. A node is kept if it is at least timeStep after the last kept node. The first and the last node
+ * as well as the nodes around the events are always kept. The controller is not copied.
+ *
+ * @param [in] primalSolution: The primal solution.
+ * @param [in] timeStep: The minimum time between two kept nodes. Any non-positive number keeps all the nodes.
+ * @param [out] decimatedPrimalSolution: The decimated primal solution. Its storage is reused.
+ */
+void decimatePrimalSolution(const PrimalSolution& primalSolution, scalar_t timeStep, PrimalSolution& decimatedPrimalSolution);
+
+/**
+ * This wraps dummy observers (e.g., the robot visualizers) and runs them on a separate worker thread. The update call only copies the
+ * latest observation, the time-decimated primal solution, and the command into a buffer and returns, such that the loop which calls the
+ * observers is not delayed by building and publishing the visualization messages. The observers always receive the latest data; updates
+ * which arrive while the worker is busy overwrite each other.
+ */
+class AsyncVisualizer : public DummyObserver {
+ public:
+  struct Settings {
+    /** The maximum rate (in wall time) at which the observers are updated. Any non-positive number disables the rate limit. */
+    scalar_t maxUpdateFrequency_ = 30.0;
+    /** The minimum time between two nodes of the primal solution, see decimatePrimalSolution. */
+    scalar_t trajectoryTimeStep_ = 0.02;
+    /** The nice value of the worker thread. A positive value lowers its priority. */
+    int niceness_ = 10;
+    /** The indices of the CPUs the worker thread may run on. If empty, the affinity is not changed. */
+    std::vector<int> cpus_;
+  };
+
+  /**
+   * Constructor. Launches the worker thread.
+   *
+   * @param [in] settings: The settings.
+   * @param [in] observersPtrArray: The wrapped observers. They are only called from the worker thread.
+   */
+  AsyncVisualizer(Settings settings, std::vector<std::shared_ptr<DummyObserver>> observersPtrArray);
+
+  /** Destructor. Stops the worker thread. */
+  ~AsyncVisualizer() override;
+
+  void update(const SystemObservation& observation, const PrimalSolution& primalSolution, const CommandData& command) override;
+
+ private:
+  void workerThread();
+
+  const Settings settings_;
+  std::vector<std::shared_ptr<DummyObserver>> observersPtrArray_;
+
+  std::chrono::steady_clock::time_point lastUpdateTime_;
+
+  std::mutex bufferMutex_;
+  std::condition_variable bufferCondition_;
+  bool bufferUpdated_ = false;
+  bool terminateThread_ = false;
+  SystemObservation bufferedObservation_;
+  PrimalSolution bufferedPrimalSolution_;
+  CommandData bufferedCommand_;
+
+  // only accessed by the worker
+  SystemObservation activeObservation_;
+  PrimalSolution activePrimalSolution_;
+  CommandData activeCommand_;
+
+  std::thread worker_;
+};
+
+}  // namespace ocs2
@@ -39,6 +39,8 @@ namespace ocs2 {
 /******************************************************************************************************/
 TargetTrajectoriesRosPublisher::TargetTrajectoriesRosPublisher(::ros::NodeHandle& nodeHandle, const std::string& topicPrefix) {
   targetTrajectoriesPublisher_ = nodeHandle.advertise<ocs2_msgs::mpc_target_trajectories>(topicPrefix + "_mpc_target", 1, false);
+  targetTrajectoriesSegmentPublisher_ =
+      nodeHandle.advertise<ocs2_msgs::mpc_target_trajectories>(topicPrefix + "_mpc_target_append", 100, false);
   ros::spinOnce();
   ROS_INFO_STREAM("The TargetTrajectories is publishing on " + topicPrefix + "_mpc_target topic.");
 }
@@ -48,6 +50,7 @@ TargetTrajectoriesRosPublisher::TargetTrajectoriesRosPublisher(::ros::NodeHandle
 /******************************************************************************************************/
 TargetTrajectoriesRosPublisher::~TargetTrajectoriesRosPublisher() {
   targetTrajectoriesPublisher_.shutdown();
+  targetTrajectoriesSegmentPublisher_.shutdown();
 }
 
 /******************************************************************************************************/
@@ -58,4 +61,12 @@ void TargetTrajectoriesRosPublisher::publishTargetTrajectories(const TargetTraje
   targetTrajectoriesPublisher_.publish(mpcTargetTrajectoriesMsg);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void TargetTrajectoriesRosPublisher::publishTargetTrajectoriesSegment(const TargetTrajectories& targetTrajectoriesSegment) {
+  const auto mpcTargetTrajectoriesMsg = ros_msg_conversions::createTargetTrajectoriesMsg(targetTrajectoriesSegment);
+  targetTrajectoriesSegmentPublisher_.publish(mpcTargetTrajectoriesMsg);
+}
+
 }  // namespace ocs2
@@ -0,0 +1,639 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_ros_interfaces/common/CompactPolicy.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+
+#include <boost/property_tree/info_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+#include <ocs2_core/control/FeedforwardController.h>
+#include <ocs2_core/control/LinearController.h>
+#include <ocs2_core/misc/LoadData.h>
+
+namespace ocs2 {
+namespace compact_policy {
+
+namespace {
+
+/*
+ * Buffer layout (host byte order):
+ *   header:   magic (u32), version (u8), controller type (u8), flags (u8), session (u32), sequence (u32), reference sequence (u32)
+ *   command:  observation, [target trajectories], MPC timing
+ *   solution: performance indices, mode schedule, time trajectory, post-event indices
+ *   nodes:    for each node: has gain (u8), state stream, input stream, controller stream
+ * where a stream is either raw (u8 = 0, size, float32 values) or delta (u8 = 1, size, float32 scale, int16 values).
+ */
+constexpr uint32_t MAGIC = 0x3150434f;  // "OCP1"
+constexpr uint8_t VERSION = 2;
+
+constexpr uint8_t CONTROLLER_FEEDFORWARD = 1;
+constexpr uint8_t CONTROLLER_LINEAR = 2;
+
+constexpr uint8_t KEYFRAME_FLAG = 1 << 0;
+constexpr uint8_t DELTA_ENCODING_FLAG = 1 << 1;
+constexpr uint8_t TARGET_TRAJECTORIES_FLAG = 1 << 2;
+
+constexpr uint8_t RAW_STREAM = 0;
+constexpr uint8_t DELTA_STREAM = 1;
+constexpr float QUANTIZATION_LEVELS = 32767.0;
+
+class BufferWriter {
+ public:
+  explicit BufferWriter(std::vector<uint8_t>& buffer) : buffer_(buffer) { buffer_.clear(); }
+
+  template <typename T>
+  void write(T value) {
+    const auto offset = buffer_.size();
+    buffer_.resize(offset + sizeof(T));
+    std::memcpy(buffer_.data() + offset, &value, sizeof(T));
+  }
+
+  template <typename T>
+  void writeArray(const T* data, size_t size) {
+    write(static_cast<uint32_t>(size));
+    if (size > 0) {
+      const auto offset = buffer_.size();
+      buffer_.resize(offset + size * sizeof(T));
+      std::memcpy(buffer_.data() + offset, data, size * sizeof(T));
+    }
+  }
+
+  void writeVector(const vector_t& vector) {
+    write(static_cast<uint32_t>(vector.size()));
+    for (size_t i = 0; i < vector.size(); i++) {
+      write(static_cast<float>(vector(i)));
+    }
+  }
+
+ private:
+  std::vector<uint8_t>& buffer_;
+};
+
+class BufferReader {
+ public:
+  explicit BufferReader(const std::vector<uint8_t>& buffer) : buffer_(buffer) {}
+
+  template <typename T>
+  T read() {
+    T value;
+    readBytes(&value, sizeof(T));
+    return value;
+  }
+
+  template <typename T>
+  void readArray(std::vector<T>& array) {
+    const auto size = read<uint32_t>();
+    if (size > (buffer_.size() - offset_) / sizeof(T)) {
+      throw std::runtime_error("[compact_policy::Decoder] The buffer is truncated!");
+    }
+    array.resize(size);
+    readBytes(array.data(), size * sizeof(T));
+  }
+
+  vector_t readVector() {
+    readArray(floatArray_);
+    return Eigen::Map<const Eigen::VectorXf>(floatArray_.data(), floatArray_.size()).cast<scalar_t>();
+  }
+
+ private:
+  void readBytes(void* data, size_t numBytes) {
+    if (numBytes > buffer_.size() - offset_) {
+      throw std::runtime_error("[compact_policy::Decoder] The buffer is truncated!");
+    }
+    if (numBytes > 0) {
+      std::memcpy(data, buffer_.data() + offset_, numBytes);
+      offset_ += numBytes;
+    }
+  }
+
+  const std::vector<uint8_t>& buffer_;
+  size_t offset_ = 0;
+  std::vector<float> floatArray_;
+};
+
+/** Writes the values either raw or, if a reference of the same size is given, as quantized differences to the reference. */
+void writeStream(BufferWriter& writer, const std::vector<float>& values, const std::vector<float>* referencePtr) {
+  if (referencePtr != nullptr && referencePtr->size() == values.size() && !values.empty()) {
+    const auto& reference = *referencePtr;
+    bool isFinite = true;
+    float maxDelta = 0.0;
+    for (size_t i = 0; i < values.size(); i++) {
+      const float delta = values[i] - reference[i];
+      isFinite = isFinite && std::isfinite(delta);
+      maxDelta = std::max(maxDelta, std::abs(delta));
+    }
+
+    if (isFinite) {
+      const float scale = maxDelta / QUANTIZATION_LEVELS;
+      writer.write(DELTA_STREAM);
+      writer.write(static_cast<uint32_t>(values.size()));
+      writer.write(scale);
+      for (size_t i = 0; i < values.size(); i++) {
+        const float level = (scale > 0.0) ? std::round((values[i] - reference[i]) / scale) : 0.0;
+        writer.write(static_cast<int16_t>(std::min(std::max(level, -QUANTIZATION_LEVELS), QUANTIZATION_LEVELS)));
+      }
+      return;
+    }
+  }
+
+  writer.write(RAW_STREAM);
+  writer.writeArray(values.data(), values.size());
+}
+
+/** Reads a stream written by writeStream. */
+void readStream(BufferReader& reader, const std::vector<float>* referencePtr, std::vector<float>& values) {
+  const auto streamType = reader.read<uint8_t>();
+  if (streamType == RAW_STREAM) {
+    reader.readArray(values);
+
+  } else if (streamType == DELTA_STREAM) {
+    const auto size = reader.read<uint32_t>();
+    if (referencePtr == nullptr || referencePtr->size() != size) {
+      throw std::runtime_error("[compact_policy::Decoder] The delta encoded data does not match the keyframe!");
+    }
+    const auto scale = reader.read<float>();
+    values.resize(size);
+    for (size_t i = 0; i < size; i++) {
+      values[i] = (*referencePtr)[i] + scale * static_cast<float>(reader.read<int16_t>());
+    }
+
+  } else {
+    throw std::runtime_error("[compact_policy::Decoder] Unknown stream type!");
+  }
+}
+
+/** Finds for each node the keyframe node which is closest in time. Both time trajectories are non-decreasing. */
+std::vector<size_t> closestKeyframeNodes(const scalar_array_t& timeTrajectory, const scalar_array_t& keyframeTimeTrajectory) {
+  std::vector<size_t> indices(timeTrajectory.size());
+  size_t j = 0;
+  for (size_t k = 0; k < timeTrajectory.size(); k++) {
+    const auto t = timeTrajectory[k];
+    while (j + 1 < keyframeTimeTrajectory.size() && std::abs(keyframeTimeTrajectory[j + 1] - t) <= std::abs(keyframeTimeTrajectory[j] - t)) {
+      ++j;
+    }
+    indices[k] = j;
+  }
+  return indices;
+}
+
+/**
+ * Selects the nodes on which the gains of a linear controller are sent: every gainDecimation-th node, the first and the last node, the
+ * pre- and post-event nodes, and the nodes on which the state or input dimension changes.
+ */
+std::vector<uint8_t> selectGainNodes(size_t gainDecimation, const size_array_t& postEventIndices, const std::vector<std::vector<float>>& stateData,
+                                     const std::vector<std::vector<float>>& inputData) {
+  const size_t N = stateData.size();
+  std::vector<uint8_t> hasGain(N, 0);
+  for (size_t k = 0; k < N; k++) {
+    hasGain[k] = static_cast<uint8_t>(k % gainDecimation == 0 || k + 1 == N);
+  }
+  for (const auto ind : postEventIndices) {
+    if (ind > 0 && ind < N) {
+      hasGain[ind] = 1;
+      hasGain[ind - 1] = 1;
+    }
+  }
+  for (size_t k = 1; k < N; k++) {
+    if (stateData[k].size() != stateData[k - 1].size() || inputData[k].size() != inputData[k - 1].size()) {
+      hasGain[k - 1] = 1;
+      hasGain[k] = 1;
+    }
+  }
+  return hasGain;
+}
+
+/**
+ * Recovers the flattened linear controller on the nodes without gains, where the controller data holds the nominal input u = uff + K * x.
+ * The gains are interpolated linearly in time between the neighboring nodes with gains, and the bias is set to u - K * x.
+ */
+void recoverGains(const scalar_array_t& timeTrajectory, const std::vector<uint8_t>& hasGain, const std::vector<std::vector<float>>& stateData,
+                  std::vector<std::vector<float>>& controllerData) {
+  const size_t N = timeTrajectory.size();
+  size_t previous = 0;
+  size_t next = 0;
+  for (size_t k = 0; k < N; k++) {
+    if (hasGain[k] != 0) {
+      previous = k;
+      continue;
+    }
+
+    if (next <= k) {
+      next = k + 1;
+      while (next < N && hasGain[next] == 0) {
+        ++next;
+      }
+    }
+    if (k == 0 || next == N) {
+      throw std::runtime_error("[compact_policy] The first and the last node must have gains!");
+    }
+
+    const size_t stateDim = stateData[k].size();
+    const size_t inputDim = controllerData[k].size();
+    const size_t rowSize = stateDim + 1;
+    const auto& previousData = controllerData[previous];
+    const auto& nextData = controllerData[next];
+    if (previousData.size() != inputDim * rowSize || nextData.size() != inputDim * rowSize) {
+      throw std::runtime_error("[compact_policy] The dimensions of the controller are inconsistent!");
+    }
+
+    const scalar_t dt = timeTrajectory[next] - timeTrajectory[previous];
+    const scalar_t alpha = (dt > 0.0) ? (timeTrajectory[k] - timeTrajectory[previous]) / dt : 0.0;
+
+    std::vector<float> data(inputDim * rowSize);
+    for (size_t i = 0; i < inputDim; i++) {
+      scalar_t feedback = 0.0;
+      for (size_t j = 0; j < stateDim; j++) {
+        const size_t ind = i * rowSize + 1 + j;
+        const scalar_t gain = (1.0 - alpha) * previousData[ind] + alpha * nextData[ind];
+        data[ind] = static_cast<float>(gain);
+        feedback += gain * stateData[k][j];
+      }
+      data[i * rowSize] = static_cast<float>(controllerData[k][i] - feedback);
+    }
+    controllerData[k].swap(data);
+  }
+}
+
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+Settings loadSettings(const std::string& filename, const std::string& fieldName, bool verbose) {
+  const auto ptPtr = loadData::readInfoFile(filename);
+  const boost::property_tree::ptree& pt = *ptPtr;
+
+  Settings settings;
+
+  if (verbose) {
+    std::cerr << "\n #### Compact Policy Settings:";
+    std::cerr << "\n #### =============================================================================\n";
+  }
+
+  loadData::loadPtreeValue(pt, settings.policyTimeWindow_, fieldName + ".policyTimeWindow", verbose);
+  loadData::loadPtreeValue(pt, settings.gainDecimation_, fieldName + ".gainDecimation", verbose);
+  loadData::loadPtreeValue(pt, settings.deltaEncoding_, fieldName + ".deltaEncoding", verbose);
+  loadData::loadPtreeValue(pt, settings.keyframeInterval_, fieldName + ".keyframeInterval", verbose);
+  loadData::loadPtreeValue(pt, settings.sendTargetTrajectories_, fieldName + ".sendTargetTrajectories", verbose);
+
+  if (verbose) {
+    std::cerr << " #### =============================================================================" << std::endl;
+  }
+
+  return settings;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+Encoder::Encoder(Settings settings) : settings_(std::move(settings)), session_(std::random_device()()) {
+  if (settings_.gainDecimation_ < 1) {
+    throw std::runtime_error("[compact_policy::Encoder] gainDecimation must be at least 1!");
+  }
+  if (settings_.keyframeInterval_ < 1) {
+    throw std::runtime_error("[compact_policy::Encoder] keyframeInterval must be at least 1!");
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void Encoder::encode(const PrimalSolution& primalSolution, const CommandData& commandData, const PerformanceIndex& performanceIndices,
+                     std::vector<uint8_t>& buffer) {
+  uint8_t controllerType;
+  switch (primalSolution.controllerPtr_->getType()) {
+    case ControllerType::FEEDFORWARD:
+      controllerType = CONTROLLER_FEEDFORWARD;
+      break;
+    case ControllerType::LINEAR:
+      controllerType = CONTROLLER_LINEAR;
+      break;
+    default:
+      throw std::runtime_error("[compact_policy::Encoder] Unknown ControllerType");
+  }
+
+  // truncate the horizon to the policy time window
+  const auto& fullTimeTrajectory = primalSolution.timeTrajectory_;
+  size_t N = fullTimeTrajectory.size();
+  if (settings_.policyTimeWindow_ >= 0.0) {
+    const scalar_t finalTime = commandData.mpcInitObservation_.time + settings_.policyTimeWindow_;
+    const auto firstAfterWindow = std::upper_bound(fullTimeTrajectory.cbegin(), fullTimeTrajectory.cend(), finalTime);
+    N = std::min(N, static_cast<size_t>(firstAfterWindow - fullTimeTrajectory.cbegin()) + 1);
+  }
+  if (N == 0) {
+    throw std::runtime_error("[compact_policy::Encoder] The policy is empty!");
+  }
+  const scalar_array_t timeTrajectory(fullTimeTrajectory.cbegin(), fullTimeTrajectory.cbegin() + N);
+
+  size_array_t postEventIndices;
+  for (const auto ind : primalSolution.postEventIndices_) {
+    if (ind < N) {
+      postEventIndices.push_back(ind);
+    }
+  }
+
+  // flatten
+  std::vector<std::vector<float>> stateData(N);
+  std::vector<std::vector<float>> inputData(N);
+  std::vector<std::vector<float>> controllerData(N);
+  std::vector<std::vector<float>*> controllerDataPtrArray(N);
+  for (size_t k = 0; k < N; k++) {
+    const auto& state = primalSolution.stateTrajectory_[k];
+    const auto& input = primalSolution.inputTrajectory_[k];
+    stateData[k].assign(state.data(), state.data() + state.size());
+    inputData[k].assign(input.data(), input.data() + input.size());
+    controllerDataPtrArray[k] = &controllerData[k];
+  }
+  primalSolution.controllerPtr_->flatten(timeTrajectory, controllerDataPtrArray);
+
+  // gain decimation: replace the linear controller by the nominal input u = uff + K * x on the nodes without gains
+  std::vector<uint8_t> hasGain(N, 1);
+  if (controllerType == CONTROLLER_LINEAR && settings_.gainDecimation_ > 1) {
+    hasGain = selectGainNodes(settings_.gainDecimation_, postEventIndices, stateData, inputData);
+    for (size_t k = 0; k < N; k++) {
+      if (hasGain[k] == 0) {
+        const size_t stateDim = stateData[k].size();
+        const size_t inputDim = controllerData[k].size() / (stateDim + 1);
+        std::vector<float> nominalInput(inputDim);
+        for (size_t i = 0; i < inputDim; i++) {
+          const float* row = &controllerData[k][i * (stateDim + 1)];
+          scalar_t input = row[0];
+          for (size_t j = 0; j < stateDim; j++) {
+            input += static_cast<scalar_t>(row[1 + j]) * stateData[k][j];
+          }
+          nominalInput[i] = static_cast<float>(input);
+        }
+        controllerData[k].swap(nominalInput);
+      }
+    }
+  }
+
+  const bool isKeyframe = !settings_.deltaEncoding_ || !keyframe_.valid || sequence_ - keyframe_.sequence >= settings_.keyframeInterval_;
+
+  uint8_t flags = 0;
+  flags |= isKeyframe ? KEYFRAME_FLAG : 0;
+  flags |= settings_.deltaEncoding_ ? DELTA_ENCODING_FLAG : 0;
+  flags |= settings_.sendTargetTrajectories_ ? TARGET_TRAJECTORIES_FLAG : 0;
+
+  // header
+  BufferWriter writer(buffer);
+  writer.write(MAGIC);
+  writer.write(VERSION);
+  writer.write(controllerType);
+  writer.write(flags);
+  writer.write(session_);
+  writer.write(sequence_);
+  writer.write(keyframe_.sequence);
+
+  // command
+  const auto& observation = commandData.mpcInitObservation_;
+  writer.write(observation.time);
+  writer.write(static_cast<uint64_t>(observation.mode));
+  writer.writeVector(observation.state);
+  writer.writeVector(observation.input);
+  if (settings_.sendTargetTrajectories_) {
+    const auto& targetTrajectories = commandData.mpcTargetTrajectories_;
+    writer.writeArray(targetTrajectories.timeTrajectory.data(), targetTrajectories.timeTrajectory.size());
+    writer.write(static_cast<uint32_t>(targetTrajectories.stateTrajectory.size()));
+    for (const auto& state : targetTrajectories.stateTrajectory) {
+      writer.writeVector(state);
+    }
+    writer.write(static_cast<uint32_t>(targetTrajectories.inputTrajectory.size()));
+    for (const auto& input : targetTrajectories.inputTrajectory) {
+      writer.writeVector(input);
+    }
+  }
+  writer.write(commandData.mpcTiming_.synchronizedModulesTime);
+  writer.write(commandData.mpcTiming_.runTime);
+  writer.write(commandData.mpcTiming_.processingTime);
+
+  // performance indices
+  writer.write(performanceIndices.merit);
+  writer.write(performanceIndices.cost);
+  writer.write(performanceIndices.dynamicsViolationSSE);
+  writer.write(performanceIndices.equalityConstraintsSSE);
+  writer.write(performanceIndices.equalityLagrangian);
+  writer.write(performanceIndices.inequalityLagrangian);
+  writer.write(static_cast<uint8_t>(performanceIndices.deadlineReached));
+
+  // mode schedule
+  const auto& modeSchedule = primalSolution.modeSchedule_;
+  writer.writeArray(modeSchedule.eventTimes.data(), modeSchedule.eventTimes.size());
+  writer.write(static_cast<uint32_t>(modeSchedule.modeSequence.size()));
+  for (const auto mode : modeSchedule.modeSequence) {
+    writer.write(static_cast<uint64_t>(mode));
+  }
+
+  // time and post-event indices
+  writer.writeArray(timeTrajectory.data(), timeTrajectory.size());
+  writer.write(static_cast<uint32_t>(postEventIndices.size()));
+  for (const auto ind : postEventIndices) {
+    writer.write(static_cast<uint32_t>(ind));
+  }
+
+  // nodes
+  std::vector<size_t> keyframeIndices;
+  if (!isKeyframe) {
+    keyframeIndices = closestKeyframeNodes(timeTrajectory, keyframe_.timeTrajectory);
+  }
+  for (size_t k = 0; k < N; k++) {
+    writer.write(hasGain[k]);
+    writeStream(writer, stateData[k], isKeyframe ? nullptr : &keyframe_.stateData[keyframeIndices[k]]);
+    writeStream(writer, inputData[k], isKeyframe ? nullptr : &keyframe_.inputData[keyframeIndices[k]]);
+    writeStream(writer, controllerData[k], isKeyframe ? nullptr : &keyframe_.controllerData[keyframeIndices[k]]);
+  }
+
+  // keep the keyframe as it is reconstructed by the receiver
+  if (isKeyframe && settings_.deltaEncoding_) {
+    if (controllerType == CONTROLLER_LINEAR) {
+      recoverGains(timeTrajectory, hasGain, stateData, controllerData);
+    }
+    keyframe_.valid = true;
+    keyframe_.session = session_;
+    keyframe_.sequence = sequence_;
+    keyframe_.timeTrajectory = timeTrajectory;
+    keyframe_.stateData.swap(stateData);
+    keyframe_.inputData.swap(inputData);
+    keyframe_.controllerData.swap(controllerData);
+  }
+
+  ++sequence_;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool Decoder::decode(const std::vector<uint8_t>& buffer, CommandData& commandData, PrimalSolution& primalSolution,
+                     PerformanceIndex& performanceIndices) {
+  BufferReader reader(buffer);
+
+  // header
+  if (reader.read<uint32_t>() != MAGIC) {
+    throw std::runtime_error("[compact_policy::Decoder] The buffer does not hold a compact policy!");
+  }
+  if (reader.read<uint8_t>() != VERSION) {
+    throw std::runtime_error("[compact_policy::Decoder] Unsupported compact policy version!");
+  }
+  const auto controllerType = reader.read<uint8_t>();
+  const auto flags = reader.read<uint8_t>();
+  const auto session = reader.read<uint32_t>();
+  const auto sequence = reader.read<uint32_t>();
+  const auto referenceSequence = reader.read<uint32_t>();
+
+  const bool isKeyframe = (flags & KEYFRAME_FLAG) != 0;
+  if (!isKeyframe && (!keyframe_.valid || keyframe_.session != session || keyframe_.sequence != referenceSequence)) {
+    return false;
+  }
+
+  // command
+  auto& observation = commandData.mpcInitObservation_;
+  observation.time = reader.read<scalar_t>();
+  observation.mode = static_cast<size_t>(reader.read<uint64_t>());
+  observation.state = reader.readVector();
+  observation.input = reader.readVector();
+  auto& targetTrajectories = commandData.mpcTargetTrajectories_;
+  targetTrajectories.clear();
+  if ((flags & TARGET_TRAJECTORIES_FLAG) != 0) {
+    reader.readArray(targetTrajectories.timeTrajectory);
+    targetTrajectories.stateTrajectory.resize(reader.read<uint32_t>());
+    for (auto& state : targetTrajectories.stateTrajectory) {
+      state = reader.readVector();
+    }
+    targetTrajectories.inputTrajectory.resize(reader.read<uint32_t>());
+    for (auto& input : targetTrajectories.inputTrajectory) {
+      input = reader.readVector();
+    }
+  }
+  commandData.mpcTiming_.synchronizedModulesTime = reader.read<scalar_t>();
+  commandData.mpcTiming_.runTime = reader.read<scalar_t>();
+  commandData.mpcTiming_.processingTime = reader.read<scalar_t>();
+
+  // performance indices
+  performanceIndices.merit = reader.read<scalar_t>();
+  performanceIndices.cost = reader.read<scalar_t>();
+  performanceIndices.dynamicsViolationSSE = reader.read<scalar_t>();
+  performanceIndices.equalityConstraintsSSE = reader.read<scalar_t>();
+  performanceIndices.equalityLagrangian = reader.read<scalar_t>();
+  performanceIndices.inequalityLagrangian = reader.read<scalar_t>();
+  performanceIndices.deadlineReached = reader.read<uint8_t>() != 0;
+
+  primalSolution.clear();
+
+  // mode schedule
+  auto& modeSchedule = primalSolution.modeSchedule_;
+  reader.readArray(modeSchedule.eventTimes);
+  modeSchedule.modeSequence.resize(reader.read<uint32_t>());
+  for (auto& mode : modeSchedule.modeSequence) {
+    mode = static_cast<size_t>(reader.read<uint64_t>());
+  }
+
+  // time and post-event indices
+  auto& timeTrajectory = primalSolution.timeTrajectory_;
+  reader.readArray(timeTrajectory);
+  const size_t N = timeTrajectory.size();
+  if (N == 0) {
+    throw std::runtime_error("[compact_policy::Decoder] The policy is empty!");
+  }
+  primalSolution.postEventIndices_.resize(reader.read<uint32_t>());
+  for (auto& ind : primalSolution.postEventIndices_) {
+    ind = static_cast<size_t>(reader.read<uint32_t>());
+  }
+
+  // nodes
+  std::vector<size_t> keyframeIndices;
+  if (!isKeyframe) {
+    keyframeIndices = closestKeyframeNodes(timeTrajectory, keyframe_.timeTrajectory);
+  }
+  std::vector<uint8_t> hasGain(N);
+  std::vector<std::vector<float>> stateData(N);
+  std::vector<std::vector<float>> inputData(N);
+  std::vector<std::vector<float>> controllerData(N);
+  for (size_t k = 0; k < N; k++) {
+    hasGain[k] = reader.read<uint8_t>();
+    readStream(reader, isKeyframe ? nullptr : &keyframe_.stateData[keyframeIndices[k]], stateData[k]);
+    readStream(reader, isKeyframe ? nullptr : &keyframe_.inputData[keyframeIndices[k]], inputData[k]);
+    readStream(reader, isKeyframe ? nullptr : &keyframe_.controllerData[keyframeIndices[k]], controllerData[k]);
+  }
+
+  size_array_t stateDim(N);
+  size_array_t inputDim(N);
+  primalSolution.stateTrajectory_.reserve(N);
+  primalSolution.inputTrajectory_.reserve(N);
+  for (size_t k = 0; k < N; k++) {
+    stateDim[k] = stateData[k].size();
+    inputDim[k] = inputData[k].size();
+    primalSolution.stateTrajectory_.emplace_back(Eigen::Map<const Eigen::VectorXf>(stateData[k].data(), stateDim[k]).cast<scalar_t>());
+    primalSolution.inputTrajectory_.emplace_back(Eigen::Map<const Eigen::VectorXf>(inputData[k].data(), inputDim[k]).cast<scalar_t>());
+  }
+
+  std::vector<std::vector<float> const*> controllerDataPtrArray(N);
+  for (size_t k = 0; k < N; k++) {
+    controllerDataPtrArray[k] = &controllerData[k];
+  }
+
+  // instantiate the correct controller
+  switch (controllerType) {
+    case CONTROLLER_FEEDFORWARD: {
+      auto controller = FeedforwardController::unFlatten(timeTrajectory, controllerDataPtrArray);
+      primalSolution.controllerPtr_.reset(new FeedforwardController(std::move(controller)));
+      break;
+    }
+    case CONTROLLER_LINEAR: {
+      recoverGains(timeTrajectory, hasGain, stateData, controllerData);
+      auto controller = LinearController::unFlatten(stateDim, inputDim, timeTrajectory, controllerDataPtrArray);
+      primalSolution.controllerPtr_.reset(new LinearController(std::move(controller)));
+      break;
+    }
+    default:
+      throw std::runtime_error("[compact_policy::Decoder] Unknown controllerType!");
+  }
+
+  // keep the keyframe as the reference of the following policies
+  if (isKeyframe && (flags & DELTA_ENCODING_FLAG) != 0) {
+    keyframe_.valid = true;
+    keyframe_.session = session;
+    keyframe_.sequence = sequence;
+    keyframe_.timeTrajectory = timeTrajectory;
+    keyframe_.stateData.swap(stateData);
+    keyframe_.inputData.swap(inputData);
+    keyframe_.controllerData.swap(controllerData);
+  }
+
+  return true;
+}
+
+}  // namespace compact_policy
+}  // namespace ocs2
@@ -66,12 +66,16 @@ std_msgs::Header getHeaderMsg(const std::string& frame_id, const ros::Time& time
 
 visualization_msgs::Marker getLineMsg(std::vector<geometry_msgs::Point>&& points, std::array<double, 3> color, double lineWidth) {
   visualization_msgs::Marker line;
+  setLineMsgProperties(line, color, lineWidth);
+  line.points = std::move(points);
+  return line;
+}
+
+void setLineMsgProperties(visualization_msgs::Marker& line, std::array<double, 3> color, double lineWidth) {
   line.type = visualization_msgs::Marker::LINE_STRIP;
   line.scale.x = lineWidth;
   line.color = getColor(color);
-  line.points = std::move(points);
   line.pose.orientation = getOrientationMsg({1., 0., 0., 0.});
-  return line;
 }
 
 std_msgs::ColorRGBA getColor(std::array<double, 3> rgb, double alpha /* = 1.0*/) {
@@ -0,0 +1,241 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_ros_interfaces/common/RuntimeMetrics.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace ocs2 {
+namespace runtime_metrics {
+
+namespace {
+
+std::chrono::steady_clock::duration toDuration(scalar_t seconds) {
+  return std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<scalar_t>(seconds));
+}
+
+scalar_t toSeconds(std::chrono::steady_clock::duration duration) {
+  return std::chrono::duration<scalar_t>(duration).count();
+}
+
+/** The bin edges of the latency stages in milliseconds. */
+std::vector<scalar_t> latencyBinEdges() {
+  return {0.0, 0.1, 0.2, 0.5, 1.0, 2.0, 5.0, 10.0, 20.0, 50.0, 100.0};
+}
+
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+Histogram::Histogram(std::vector<scalar_t> binEdges) : binEdges_(std::move(binEdges)), counts_(binEdges_.size(), 0) {
+  if (binEdges_.empty() || !std::is_sorted(binEdges_.cbegin(), binEdges_.cend())) {
+    throw std::runtime_error("[runtime_metrics::Histogram] The bin edges must be non-empty and increasing!");
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void Histogram::add(scalar_t sample) {
+  const auto upper = std::upper_bound(binEdges_.cbegin(), binEdges_.cend(), sample);
+  const size_t bin = (upper == binEdges_.cbegin()) ? 0 : std::distance(binEdges_.cbegin(), upper) - 1;
+  counts_[bin]++;
+  max_ = (numSamples_ == 0) ? sample : std::max(max_, sample);
+  sum_ += sample;
+  numSamples_++;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void Histogram::clear() {
+  std::fill(counts_.begin(), counts_.end(), 0);
+  numSamples_ = 0;
+  sum_ = 0.0;
+  max_ = 0.0;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ocs2_msgs::histogram createHistogramMsg(const Histogram& histogram) {
+  ocs2_msgs::histogram histogramMsg;
+  histogramMsg.binEdges.assign(histogram.getBinEdges().cbegin(), histogram.getBinEdges().cend());
+  histogramMsg.counts.assign(histogram.getCounts().cbegin(), histogram.getCounts().cend());
+  histogramMsg.mean = histogram.getMean();
+  histogramMsg.max = histogram.getMax();
+  return histogramMsg;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+MpcSolverMetrics::MpcSolverMetrics(scalar_t windowDuration)
+    : windowDuration_(toDuration(windowDuration)),
+      windowStart_(std::chrono::steady_clock::now()),
+      solveTime_({0.0, 1.0, 2.0, 5.0, 10.0, 20.0, 50.0, 100.0, 200.0, 500.0}),
+      numIterations_({0.0, 1.0, 2.0, 3.0, 5.0, 10.0, 20.0, 50.0}) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MpcSolverMetrics::addCycle(scalar_t solveTime, const SolverRunStatistics& runStatistics) {
+  solveTime_.add(solveTime);
+  numIterations_.add(static_cast<scalar_t>(runStatistics.numIterations));
+  numLineSearchTrials_ += runStatistics.numLineSearchTrials;
+  qpStatus_ = runStatistics.qpStatus;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool MpcSolverMetrics::createMsgIfElapsed(ocs2_msgs::mpc_solver_metrics& metricsMsg) {
+  const auto now = std::chrono::steady_clock::now();
+  if (now - windowStart_ < windowDuration_) {
+    return false;
+  }
+
+  metricsMsg.windowDuration = toSeconds(now - windowStart_);
+  metricsMsg.numCycles = solveTime_.getNumSamples();
+  metricsMsg.solveTime = createHistogramMsg(solveTime_);
+  metricsMsg.numIterations = createHistogramMsg(numIterations_);
+  metricsMsg.numLineSearchTrials = numLineSearchTrials_;
+  metricsMsg.qpStatus = qpStatus_;
+
+  windowStart_ = now;
+  solveTime_.clear();
+  numIterations_.clear();
+  numLineSearchTrials_ = 0;
+  return true;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+MrtMetrics::MrtMetrics(scalar_t windowDuration)
+    : windowDuration_(toDuration(windowDuration)),
+      windowStart_(std::chrono::steady_clock::now()),
+      policyAge_({0.0, 5.0, 10.0, 20.0, 50.0, 100.0, 200.0, 500.0}) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MrtMetrics::addPolicy(scalar_t policyAge, size_t numOverwrittenPolicies) {
+  numPolicies_++;
+  if (policyAge >= 0.0) {
+    policyAge_.add(policyAge);
+  }
+  numOverwrittenPolicies_ = numOverwrittenPolicies;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool MrtMetrics::createMsgIfElapsed(ocs2_msgs::mrt_metrics& metricsMsg) {
+  const auto now = std::chrono::steady_clock::now();
+  if (now - windowStart_ < windowDuration_) {
+    return false;
+  }
+
+  metricsMsg.windowDuration = toSeconds(now - windowStart_);
+  metricsMsg.numPolicies = numPolicies_;
+  metricsMsg.policyAge = createHistogramMsg(policyAge_);
+  metricsMsg.numOverwrittenPolicies = numOverwrittenPolicies_ - windowStartNumOverwrittenPolicies_;
+
+  windowStart_ = now;
+  numPolicies_ = 0;
+  policyAge_.clear();
+  windowStartNumOverwrittenPolicies_ = numOverwrittenPolicies_;
+  return true;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+LatencyMetrics::LatencyMetrics(scalar_t budget, scalar_t windowDuration)
+    : budget_(budget),
+      windowDuration_(toDuration(windowDuration)),
+      windowStart_(std::chrono::steady_clock::now()),
+      mpcModules_(latencyBinEdges()),
+      mpcSolver_(latencyBinEdges()),
+      mpcOverhead_(latencyBinEdges()),
+      transport_(latencyBinEdges()),
+      policyWaiting_(latencyBinEdges()),
+      evaluation_(latencyBinEdges()),
+      endToEnd_(latencyBinEdges()) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LatencyMetrics::addPolicy(const PolicyLatency& latency) {
+  mpcModules_.add(1e3 * latency.mpcModules);
+  mpcSolver_.add(1e3 * latency.mpcSolver);
+  mpcOverhead_.add(1e3 * latency.mpcOverhead);
+  transport_.add(1e3 * latency.transport);
+  policyWaiting_.add(1e3 * latency.policyWaiting);
+  evaluation_.add(1e3 * latency.evaluation);
+  endToEnd_.add(1e3 * latency.endToEnd);
+  if (latency.endToEnd > budget_) {
+    numOverBudget_++;
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool LatencyMetrics::createMsgIfElapsed(ocs2_msgs::latency_metrics& metricsMsg) {
+  const auto now = std::chrono::steady_clock::now();
+  if (now - windowStart_ < windowDuration_) {
+    return false;
+  }
+
+  metricsMsg.windowDuration = toSeconds(now - windowStart_);
+  metricsMsg.budget = 1e3 * budget_;
+  metricsMsg.numPolicies = endToEnd_.getNumSamples();
+  metricsMsg.numOverBudget = numOverBudget_;
+  metricsMsg.mpcModules = createHistogramMsg(mpcModules_);
+  metricsMsg.mpcSolver = createHistogramMsg(mpcSolver_);
+  metricsMsg.mpcOverhead = createHistogramMsg(mpcOverhead_);
+  metricsMsg.transport = createHistogramMsg(transport_);
+  metricsMsg.policyWaiting = createHistogramMsg(policyWaiting_);
+  metricsMsg.evaluation = createHistogramMsg(evaluation_);
+  metricsMsg.endToEnd = createHistogramMsg(endToEnd_);
+
+  windowStart_ = now;
+  numOverBudget_ = 0;
+  for (auto* histogramPtr : {&mpcModules_, &mpcSolver_, &mpcOverhead_, &transport_, &policyWaiting_, &evaluation_, &endToEnd_}) {
+    histogramPtr->clear();
+  }
+  return true;
+}
+
+}  // namespace runtime_metrics
+}  // namespace ocs2
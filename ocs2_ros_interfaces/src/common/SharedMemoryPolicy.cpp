@@ -0,0 +1,291 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_ros_interfaces/common/SharedMemoryPolicy.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2 && ATOMIC_INT_LOCK_FREE == 2, "The shared memory policy requires lock-free atomics.");
+
+namespace ocs2 {
+namespace shared_memory_policy {
+
+/*
+ * Segment layout: the segment header followed by numSlots slots, each of which is a slot header followed by slotCapacity bytes. The slot
+ * sequence is odd while the slot is written and equal to 2 * n once the n-th policy is completely written.
+ */
+struct SegmentHeader {
+  std::atomic<uint32_t> magic;
+  std::atomic<uint32_t> closed;
+  uint64_t numSlots;
+  uint64_t slotStride;
+  uint64_t slotCapacity;
+  std::atomic<uint64_t> latestSequence;
+};
+
+namespace {
+
+constexpr uint32_t MAGIC = 0x4d53434f;  // "OCSM"
+constexpr size_t ALIGNMENT = 64;
+
+struct SlotHeader {
+  std::atomic<uint64_t> sequence;
+  uint64_t size;
+};
+
+size_t alignUp(size_t size) {
+  return (size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+}
+
+size_t headerSize() {
+  return alignUp(sizeof(SegmentHeader));
+}
+
+SlotHeader* getSlot(SegmentHeader* headerPtr, uint64_t sequence) {
+  auto* slotsPtr = reinterpret_cast<uint8_t*>(headerPtr) + headerSize();
+  return reinterpret_cast<SlotHeader*>(slotsPtr + (sequence % headerPtr->numSlots) * headerPtr->slotStride);
+}
+
+uint8_t* getSlotData(SlotHeader* slotPtr) {
+  return reinterpret_cast<uint8_t*>(slotPtr) + sizeof(SlotHeader);
+}
+
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::string getSegmentName(const std::string& topicPrefix) {
+  std::string name = topicPrefix + "_mpc_policy";
+  std::replace(name.begin(), name.end(), '/', '_');
+  return "/" + name;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+PolicyWriter::PolicyWriter(std::string segmentName, size_t slotCapacity, size_t numSlots)
+    : segmentName_(std::move(segmentName)), encoder_(compact_policy::Settings()) {
+  if (numSlots < 1) {
+    throw std::runtime_error("[shared_memory_policy::PolicyWriter] numSlots must be at least 1!");
+  }
+  const size_t slotStride = alignUp(sizeof(SlotHeader) + slotCapacity);
+  segmentSize_ = headerSize() + numSlots * slotStride;
+
+  // a new segment is created such that the readers of a previous writer notice the restart
+  shm_unlink(segmentName_.c_str());
+  const int fd = shm_open(segmentName_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0666);
+  if (fd < 0) {
+    throw std::runtime_error("[shared_memory_policy::PolicyWriter] Could not create " + segmentName_ + ": " + std::strerror(errno));
+  }
+  if (ftruncate(fd, static_cast<off_t>(segmentSize_)) != 0) {
+    ::close(fd);
+    throw std::runtime_error("[shared_memory_policy::PolicyWriter] Could not resize " + segmentName_ + ": " + std::strerror(errno));
+  }
+  void* segmentPtr = mmap(nullptr, segmentSize_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (segmentPtr == MAP_FAILED) {
+    throw std::runtime_error("[shared_memory_policy::PolicyWriter] Could not map " + segmentName_ + ": " + std::strerror(errno));
+  }
+
+  headerPtr_ = new (segmentPtr) SegmentHeader;
+  headerPtr_->magic.store(0, std::memory_order_relaxed);
+  headerPtr_->closed.store(0, std::memory_order_relaxed);
+  headerPtr_->numSlots = numSlots;
+  headerPtr_->slotStride = slotStride;
+  headerPtr_->slotCapacity = slotCapacity;
+  headerPtr_->latestSequence.store(0, std::memory_order_relaxed);
+  for (size_t i = 0; i < numSlots; i++) {
+    auto* slotPtr = new (getSlot(headerPtr_, i)) SlotHeader;
+    slotPtr->sequence.store(0, std::memory_order_relaxed);
+    slotPtr->size = 0;
+  }
+  headerPtr_->magic.store(MAGIC, std::memory_order_release);
+
+  buffer_.reserve(slotCapacity);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+PolicyWriter::~PolicyWriter() {
+  headerPtr_->closed.store(1, std::memory_order_release);
+  munmap(headerPtr_, segmentSize_);
+  shm_unlink(segmentName_.c_str());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PolicyWriter::write(const PrimalSolution& primalSolution, const CommandData& commandData, const PerformanceIndex& performanceIndices) {
+  encoder_.encode(primalSolution, commandData, performanceIndices, buffer_);
+  if (buffer_.size() > headerPtr_->slotCapacity) {
+    throw std::runtime_error("[shared_memory_policy::PolicyWriter] The policy needs " + std::to_string(buffer_.size()) +
+                             " bytes which exceeds the slot capacity!");
+  }
+
+  ++sequence_;
+  auto* slotPtr = getSlot(headerPtr_, sequence_);
+  slotPtr->sequence.store(2 * sequence_ - 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  std::memcpy(getSlotData(slotPtr), buffer_.data(), buffer_.size());
+  slotPtr->size = buffer_.size();
+  slotPtr->sequence.store(2 * sequence_, std::memory_order_release);
+  headerPtr_->latestSequence.store(sequence_, std::memory_order_release);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+PolicyReader::PolicyReader(std::string segmentName) : segmentName_(std::move(segmentName)) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+PolicyReader::~PolicyReader() {
+  close();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool PolicyReader::open() {
+  const int fd = shm_open(segmentName_.c_str(), O_RDONLY, 0);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat segmentStat;
+  if (fstat(fd, &segmentStat) != 0 || static_cast<size_t>(segmentStat.st_size) < headerSize()) {
+    ::close(fd);
+    return false;
+  }
+  const auto segmentSize = static_cast<size_t>(segmentStat.st_size);
+  const auto segmentId = static_cast<uint64_t>(segmentStat.st_ino);
+  void* segmentPtr = mmap(nullptr, segmentSize, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (segmentPtr == MAP_FAILED) {
+    return false;
+  }
+
+  headerPtr_ = reinterpret_cast<SegmentHeader*>(segmentPtr);
+  segmentSize_ = segmentSize;
+  if (headerPtr_->magic.load(std::memory_order_acquire) != MAGIC ||
+      segmentSize_ < headerSize() + headerPtr_->numSlots * headerPtr_->slotStride) {
+    close();
+    return false;
+  }
+
+  segmentId_ = segmentId;
+  lastSequence_ = 0;
+  lastReplacementCheck_ = std::chrono::steady_clock::now();
+  return true;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PolicyReader::close() {
+  if (headerPtr_ != nullptr) {
+    munmap(headerPtr_, segmentSize_);
+    headerPtr_ = nullptr;
+    segmentSize_ = 0;
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool PolicyReader::isReplaced() {
+  const int fd = shm_open(segmentName_.c_str(), O_RDONLY, 0);
+  if (fd < 0) {
+    return true;
+  }
+  struct stat segmentStat;
+  const bool isReplaced = fstat(fd, &segmentStat) != 0 || static_cast<uint64_t>(segmentStat.st_ino) != segmentId_;
+  ::close(fd);
+  return isReplaced;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool PolicyReader::read(CommandData& commandData, PrimalSolution& primalSolution, PerformanceIndex& performanceIndices) {
+  if (headerPtr_ == nullptr && !open()) {
+    return false;
+  }
+
+  // the writer has been shut down
+  if (headerPtr_->closed.load(std::memory_order_acquire) != 0) {
+    close();
+    return false;
+  }
+
+  const uint64_t sequence = headerPtr_->latestSequence.load(std::memory_order_acquire);
+  if (sequence == 0 || sequence == lastSequence_) {
+    // a writer which has not shut down cleanly is detected by the segment being replaced by its successor
+    const auto now = std::chrono::steady_clock::now();
+    if (now - lastReplacementCheck_ > std::chrono::seconds(1)) {
+      lastReplacementCheck_ = now;
+      if (isReplaced()) {
+        close();
+      }
+    }
+    return false;
+  }
+
+  // seqlock read: the copy is only valid if the slot has not been touched by the writer in the meantime
+  const auto* slotPtr = getSlot(headerPtr_, sequence);
+  const uint64_t slotSequence = slotPtr->sequence.load(std::memory_order_acquire);
+  if (slotSequence != 2 * sequence) {
+    return false;
+  }
+  const size_t size = std::min<size_t>(slotPtr->size, headerPtr_->slotCapacity);
+  const auto* dataPtr = getSlotData(const_cast<SlotHeader*>(slotPtr));
+  buffer_.assign(dataPtr, dataPtr + size);
+  std::atomic_thread_fence(std::memory_order_acquire);
+  if (slotPtr->sequence.load(std::memory_order_relaxed) != slotSequence) {
+    return false;
+  }
+
+  lastSequence_ = sequence;
+  return decoder_.decode(buffer_, commandData, primalSolution, performanceIndices);
+}
+
+}  // namespace shared_memory_policy
+}  // namespace ocs2
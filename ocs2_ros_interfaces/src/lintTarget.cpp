@@ -9,6 +9,7 @@
 
 // mpc
 #include <ocs2_ros_interfaces/mpc/MPC_ROS_Interface.h>
+#include <ocs2_ros_interfaces/mpc/MultiRobotMpcServer.h>
 
 // mrt
 #include <ocs2_ros_interfaces/mrt/LoopshapingDummyObserver.h>
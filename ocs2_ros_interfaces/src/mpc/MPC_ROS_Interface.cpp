@@ -29,10 +29,42 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_ros_interfaces/mpc/MPC_ROS_Interface.h"
 
+#include <chrono>
+#include <csignal>
+
+#include <boost/make_shared.hpp>
+
 #include "ocs2_ros_interfaces/common/RosMsgConversions.h"
 
 namespace ocs2 {
 
+namespace {
+// set by the SIGUSR1 handler and served by spin()
+std::atomic_bool traceDumpRequested{false};
+
+void requestTraceDump(int) {
+  traceDumpRequested = true;
+}
+
+// the number of policy messages which are reused, more messages are only allocated while the subscribers hold on to them
+constexpr size_t MAX_NUM_LOANED_MSGS = 4;
+
+/** Loans a message of the pool which is not referenced by ROS anymore. The memory of the message is reused. */
+template <typename Msg>
+boost::shared_ptr<Msg> loanMessage(std::vector<boost::shared_ptr<Msg>>& pool) {
+  for (const auto& msgPtr : pool) {
+    if (msgPtr.use_count() == 1) {
+      return msgPtr;
+    }
+  }
+  auto msgPtr = boost::make_shared<Msg>();
+  if (pool.size() < MAX_NUM_LOANED_MSGS) {
+    pool.push_back(msgPtr);
+  }
+  return msgPtr;
+}
+}  // unnamed namespace
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -66,6 +98,7 @@ void MPC_ROS_Interface::resetMpcNode(TargetTrajectories&& initTargetTrajectories
   mpc_.reset();
   mpc_.getSolverPtr()->getReferenceManager().setTargetTrajectories(std::move(initTargetTrajectories));
   mpcTimer_.reset();
+  latestObservationSequence_ = 0;
   resetRequestedEver_ = true;
   terminateThread_ = false;
   readyToPublish_ = false;
@@ -100,12 +133,23 @@ ocs2_msgs::mpc_flattened_controller MPC_ROS_Interface::createMpcPolicyMsg(const
                                                                           const CommandData& commandData,
                                                                           const PerformanceIndex& performanceIndices) {
   ocs2_msgs::mpc_flattened_controller mpcPolicyMsg;
+  fillMpcPolicyMsg(primalSolution, commandData, performanceIndices, mpcPolicyMsg);
+  return mpcPolicyMsg;
+}
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_ROS_Interface::fillMpcPolicyMsg(const PrimalSolution& primalSolution, const CommandData& commandData,
+                                         const PerformanceIndex& performanceIndices, ocs2_msgs::mpc_flattened_controller& mpcPolicyMsg) {
   mpcPolicyMsg.initObservation = ros_msg_conversions::createObservationMsg(commandData.mpcInitObservation_);
   mpcPolicyMsg.planTargetTrajectories = ros_msg_conversions::createTargetTrajectoriesMsg(commandData.mpcTargetTrajectories_);
   mpcPolicyMsg.modeSchedule = ros_msg_conversions::createModeScheduleMsg(primalSolution.modeSchedule_);
   mpcPolicyMsg.performanceIndices =
       ros_msg_conversions::createPerformanceIndicesMsg(commandData.mpcInitObservation_.time, performanceIndices);
+  mpcPolicyMsg.mpcModulesTime = commandData.mpcTiming_.synchronizedModulesTime;
+  mpcPolicyMsg.mpcRunTime = commandData.mpcTiming_.runTime;
+  mpcPolicyMsg.mpcProcessingTime = commandData.mpcTiming_.processingTime;
 
   switch (primalSolution.controllerPtr_->getType()) {
     case ControllerType::FEEDFORWARD:
@@ -121,60 +165,58 @@ ocs2_msgs::mpc_flattened_controller MPC_ROS_Interface::createMpcPolicyMsg(const
   // maximum length of the message
   const size_t N = primalSolution.timeTrajectory_.size();
 
-  mpcPolicyMsg.timeTrajectory.clear();
-  mpcPolicyMsg.timeTrajectory.reserve(N);
-  mpcPolicyMsg.stateTrajectory.clear();
-  mpcPolicyMsg.stateTrajectory.reserve(N);
-  mpcPolicyMsg.data.clear();
-  mpcPolicyMsg.data.reserve(N);
-  mpcPolicyMsg.postEventIndices.clear();
-  mpcPolicyMsg.postEventIndices.reserve(primalSolution.postEventIndices_.size());
-
   // time
-  for (auto t : primalSolution.timeTrajectory_) {
-    mpcPolicyMsg.timeTrajectory.emplace_back(t);
-  }
+  mpcPolicyMsg.timeTrajectory.assign(primalSolution.timeTrajectory_.cbegin(), primalSolution.timeTrajectory_.cend());
 
   // post-event indices
-  for (auto ind : primalSolution.postEventIndices_) {
-    mpcPolicyMsg.postEventIndices.emplace_back(static_cast<uint16_t>(ind));
+  mpcPolicyMsg.postEventIndices.resize(primalSolution.postEventIndices_.size());
+  for (size_t i = 0; i < primalSolution.postEventIndices_.size(); i++) {
+    mpcPolicyMsg.postEventIndices[i] = static_cast<uint16_t>(primalSolution.postEventIndices_[i]);
   }
 
-  // state
+  // state and input: resized in place and bulk copied
+  mpcPolicyMsg.stateTrajectory.resize(N);
+  mpcPolicyMsg.inputTrajectory.resize(N);
   for (size_t k = 0; k < N; k++) {
-    ocs2_msgs::mpc_state mpcState;
-    mpcState.value.resize(primalSolution.stateTrajectory_[k].rows());
-    for (size_t j = 0; j < primalSolution.stateTrajectory_[k].rows(); j++) {
-      mpcState.value[j] = primalSolution.stateTrajectory_[k](j);
-    }
-    mpcPolicyMsg.stateTrajectory.emplace_back(mpcState);
+    const auto& state = primalSolution.stateTrajectory_[k];
+    auto& stateMsg = mpcPolicyMsg.stateTrajectory[k].value;
+    stateMsg.resize(state.size());
+    Eigen::Map<Eigen::VectorXf>(stateMsg.data(), state.size()) = state.cast<float>();
+
+    const auto& input = primalSolution.inputTrajectory_[k];
+    auto& inputMsg = mpcPolicyMsg.inputTrajectory[k].value;
+    inputMsg.resize(input.size());
+    Eigen::Map<Eigen::VectorXf>(inputMsg.data(), input.size()) = input.cast<float>();
   }  // end of k loop
 
-  // input
+  // controller: flattened into the existing data buffers
+  mpcPolicyMsg.data.resize(N);
+  std::vector<std::vector<float>*> policyMsgDataPointers(N);
   for (size_t k = 0; k < N; k++) {
-    ocs2_msgs::mpc_input mpcInput;
-    mpcInput.value.resize(primalSolution.inputTrajectory_[k].rows());
-    for (size_t j = 0; j < primalSolution.inputTrajectory_[k].rows(); j++) {
-      mpcInput.value[j] = primalSolution.inputTrajectory_[k](j);
-    }
-    mpcPolicyMsg.inputTrajectory.emplace_back(mpcInput);
-  }  // end of k loop
-
-  // controller
-  scalar_array_t timeTrajectoryTruncated;
-  std::vector<std::vector<float>*> policyMsgDataPointers;
-  policyMsgDataPointers.reserve(N);
-  for (auto t : primalSolution.timeTrajectory_) {
-    mpcPolicyMsg.data.emplace_back(ocs2_msgs::controller_data());
-
-    policyMsgDataPointers.push_back(&mpcPolicyMsg.data.back().data);
-    timeTrajectoryTruncated.push_back(t);
+    policyMsgDataPointers[k] = &mpcPolicyMsg.data[k].data;
   }  // end of k loop
 
   // serialize controller into data buffer
-  primalSolution.controllerPtr_->flatten(timeTrajectoryTruncated, policyMsgDataPointers);
+  primalSolution.controllerPtr_->flatten(mpcPolicyMsg.timeTrajectory, policyMsgDataPointers);
+}
 
-  return mpcPolicyMsg;
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_ROS_Interface::publishPolicy(const PrimalSolution& primalSolution, const CommandData& commandData,
+                                      const PerformanceIndex& performanceIndices) {
+  benchmark::TraceScope publicationScope(tracerPtr_.get(), "Policy Publication");
+  publishTimer_.startTimer();
+  if (compactPolicyEncoderPtr_ != nullptr) {
+    auto compactPolicyMsgPtr = loanMessage(compactPolicyMsgPool_);
+    compactPolicyEncoderPtr_->encode(primalSolution, commandData, performanceIndices, compactPolicyMsgPtr->buffer);
+    mpcPolicyPublisher_.publish(compactPolicyMsgPtr);
+  } else {
+    auto mpcPolicyMsgPtr = loanMessage(mpcPolicyMsgPool_);
+    fillMpcPolicyMsg(primalSolution, commandData, performanceIndices, *mpcPolicyMsgPtr);
+    mpcPolicyPublisher_.publish(mpcPolicyMsgPtr);
+  }
+  publishTimer_.endTimer();
 }
 
 /******************************************************************************************************/
@@ -197,11 +239,8 @@ void MPC_ROS_Interface::publisherWorker() {
       publisherPerformanceIndicesPtr_.swap(bufferPerformanceIndicesPtr_);
     }
 
-    ocs2_msgs::mpc_flattened_controller mpcPolicyMsg =
-        createMpcPolicyMsg(*publisherPrimalSolutionPtr_, *publisherCommandPtr_, *publisherPerformanceIndicesPtr_);
-
     // publish the message
-    mpcPolicyPublisher_.publish(mpcPolicyMsg);
+    publishPolicy(*publisherPrimalSolutionPtr_, *publisherCommandPtr_, *publisherPerformanceIndicesPtr_);
 
     readyToPublish_ = false;
     lk.unlock();
@@ -212,7 +251,7 @@ void MPC_ROS_Interface::publisherWorker() {
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-void MPC_ROS_Interface::copyToBuffer(const SystemObservation& mpcInitObservation) {
+void MPC_ROS_Interface::copyToBuffer(const SystemObservation& mpcInitObservation, const MpcTiming& mpcTiming) {
   // buffer policy mutex
   std::lock_guard<std::mutex> policyBufferLock(bufferMutex_);
 
@@ -226,6 +265,7 @@ void MPC_ROS_Interface::copyToBuffer(const SystemObservation& mpcInitObservation
   // command
   bufferCommandPtr_->mpcInitObservation_ = mpcInitObservation;
   bufferCommandPtr_->mpcTargetTrajectories_ = mpc_.getSolverPtr()->getReferenceManager().getTargetTrajectories();
+  bufferCommandPtr_->mpcTiming_ = mpcTiming;
 
   // performance indices
   *bufferPerformanceIndicesPtr_ = mpc_.getSolverPtr()->getPerformanceIndeces();
@@ -235,6 +275,7 @@ void MPC_ROS_Interface::copyToBuffer(const SystemObservation& mpcInitObservation
 /******************************************************************************************************/
 /******************************************************************************************************/
 void MPC_ROS_Interface::mpcObservationCallback(const ocs2_msgs::mpc_observation::ConstPtr& msg) {
+  const auto receiptTime = std::chrono::steady_clock::now();
   std::lock_guard<std::mutex> resetLock(resetMutex_);
 
   if (!resetRequestedEver_.load()) {
@@ -242,18 +283,41 @@ void MPC_ROS_Interface::mpcObservationCallback(const ocs2_msgs::mpc_observation:
     return;
   }
 
+  // drop the observations which are received out of order
+  if (msg->sequence != 0) {
+    if (msg->sequence <= latestObservationSequence_) {
+      return;
+    }
+    latestObservationSequence_ = msg->sequence;
+  }
+
   // current time, state, input, and subsystem
   const auto currentObservation = ros_msg_conversions::readObservationMsg(*msg);
 
   // measure the delay in running MPC
+  benchmark::TraceScope cycleScope(tracerPtr_.get(), "MPC Cycle");
   mpcTimer_.startTimer();
 
   // run MPC
+  const auto runStart = std::chrono::steady_clock::now();
   bool controllerIsUpdated = mpc_.run(currentObservation.time, currentObservation.state);
+  const auto runEnd = std::chrono::steady_clock::now();
+  if (metricsPtr_ != nullptr) {
+    const std::chrono::duration<scalar_t, std::milli> solveTime = runEnd - runStart;
+    metricsPtr_->addCycle(solveTime.count(), mpc_.getSolverPtr()->getRunStatistics());
+    if (metricsPtr_->createMsgIfElapsed(metricsMsg_)) {
+      metricsPublisher_.publish(metricsMsg_);
+    }
+  }
   if (!controllerIsUpdated) {
     return;
   }
-  copyToBuffer(currentObservation);
+
+  MpcTiming mpcTiming;
+  mpcTiming.synchronizedModulesTime = mpc_.getSolverPtr()->getRunStatistics().synchronizedModulesTime;
+  mpcTiming.runTime = std::chrono::duration<scalar_t>(runEnd - runStart).count();
+  mpcTiming.processingTime = std::chrono::duration<scalar_t>(std::chrono::steady_clock::now() - receiptTime).count();
+  copyToBuffer(currentObservation, mpcTiming);
 
   // measure the delay for sending ROS messages
   mpcTimer_.endTimer();
@@ -276,17 +340,23 @@ void MPC_ROS_Interface::mpcObservationCallback(const ocs2_msgs::mpc_observation:
     std::cerr << "\n###   Latest  : " << mpcTimer_.getLastIntervalInMilliseconds() << "[ms]." << std::endl;
   }
 
+  if (sharedMemoryPolicyWriterPtr_ != nullptr) {
+    // the publisher thread is not used, hence the buffer can be written without lock
+    sharedMemoryPolicyWriterPtr_->write(*bufferPrimalSolutionPtr_, *bufferCommandPtr_, *bufferPerformanceIndicesPtr_);
+  } else {
 #ifdef PUBLISH_THREAD
-  std::unique_lock<std::mutex> lk(publisherMutex_);
-  readyToPublish_ = true;
-  lk.unlock();
-  msgReady_.notify_one();
+    std::unique_lock<std::mutex> lk(publisherMutex_);
+    readyToPublish_ = true;
+    lk.unlock();
+    msgReady_.notify_one();
 
 #else
-  ocs2_msgs::mpc_flattened_controller mpcPolicyMsg =
-      createMpcPolicyMsg(*bufferPrimalSolutionPtr_, *bufferCommandPtr_, *bufferPerformanceIndicesPtr_);
-  mpcPolicyPublisher_.publish(mpcPolicyMsg);
+    publishPolicy(*bufferPrimalSolutionPtr_, *bufferCommandPtr_, *bufferPerformanceIndicesPtr_);
 #endif
+  }
+
+  // with the publisher thread, the preparation overlaps with the publication of the policy
+  mpc_.prepareNextRun(currentObservation.time);
 }
 
 /******************************************************************************************************/
@@ -309,6 +379,12 @@ void MPC_ROS_Interface::shutdownNode() {
   ROS_INFO_STREAM("All workers are shut down.");
 #endif
 
+  if (mpc_.settings().debugPrint_) {
+    std::cerr << "\n### MPC_ROS Policy Publication Benchmarking";
+    std::cerr << "\n###   Maximum : " << publishTimer_.getMaxIntervalInMilliseconds() << "[ms].";
+    std::cerr << "\n###   Average : " << publishTimer_.getAverageInMilliseconds() << "[ms]." << std::endl;
+  }
+
   // shutdown publishers
   mpcPolicyPublisher_.shutdown();
 }
@@ -321,6 +397,71 @@ void MPC_ROS_Interface::spin() {
   // Equivalent to ros::spin() + check if master is alive
   while (::ros::ok() && ::ros::master::check()) {
     ::ros::getGlobalCallbackQueue()->callAvailable(ros::WallDuration(0.1));
+
+    if (tracerPtr_ != nullptr && traceDumpRequested.exchange(false)) {
+      std::string message;
+      dumpTrace(message);
+      ROS_INFO_STREAM(message);
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_ROS_Interface::enableCompactPolicy(const compact_policy::Settings& settings) {
+  compactPolicyEncoderPtr_.reset(new compact_policy::Encoder(settings));
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_ROS_Interface::enableSharedMemoryPolicy(size_t slotCapacity) {
+  sharedMemoryPolicyWriterPtr_.reset(
+      new shared_memory_policy::PolicyWriter(shared_memory_policy::getSegmentName(topicPrefix_), slotCapacity));
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_ROS_Interface::enableUnreliableObservation() {
+  observationTransportHints_ = ::ros::TransportHints().unreliable().tcpNoDelay();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_ROS_Interface::enableTracing(std::string traceFileName, size_t capacity) {
+  traceFileName_ = std::move(traceFileName);
+  tracerPtr_ = std::make_shared<benchmark::Tracer>(capacity);
+  mpc_.getSolverPtr()->setTracer(tracerPtr_);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_ROS_Interface::enableMetrics(scalar_t windowDuration) {
+  metricsPtr_.reset(new runtime_metrics::MpcSolverMetrics(windowDuration));
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool MPC_ROS_Interface::dumpTraceCallback(std_srvs::Trigger::Request& req, std_srvs::Trigger::Response& res) {
+  res.success = dumpTrace(res.message);
+  return true;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool MPC_ROS_Interface::dumpTrace(std::string& message) const {
+  if (tracerPtr_->dumpChromeTrace(traceFileName_)) {
+    message = "Dumped " + std::to_string(tracerPtr_->getNumEvents()) + " trace events to " + traceFileName_ + ".";
+    return true;
+  } else {
+    message = "Could not write the trace to " + traceFileName_ + "!";
+    return false;
   }
 }
 
@@ -328,27 +469,52 @@ void MPC_ROS_Interface::spin() {
 /******************************************************************************************************/
 /******************************************************************************************************/
 void MPC_ROS_Interface::launchNodes(ros::NodeHandle& nodeHandle) {
+  advertise(nodeHandle);
+
+  // spin
+  spin();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_ROS_Interface::advertise(ros::NodeHandle& nodeHandle) {
   ROS_INFO_STREAM("MPC node is setting up ...");
 
   // Observation subscriber
   mpcObservationSubscriber_ = nodeHandle.subscribe(topicPrefix_ + "_mpc_observation", 1, &MPC_ROS_Interface::mpcObservationCallback, this,
-                                                   ::ros::TransportHints().tcpNoDelay());
+                                                   observationTransportHints_);
 
   // MPC publisher
-  mpcPolicyPublisher_ = nodeHandle.advertise<ocs2_msgs::mpc_flattened_controller>(topicPrefix_ + "_mpc_policy", 1, true);
+  if (compactPolicyEncoderPtr_ != nullptr) {
+    mpcPolicyPublisher_ = nodeHandle.advertise<ocs2_msgs::mpc_compact_policy>(topicPrefix_ + "_mpc_compact_policy", 1, true);
+  } else {
+    mpcPolicyPublisher_ = nodeHandle.advertise<ocs2_msgs::mpc_flattened_controller>(topicPrefix_ + "_mpc_policy", 1, true);
+  }
+
+  // metrics publisher
+  if (metricsPtr_ != nullptr) {
+    metricsPublisher_ = nodeHandle.advertise<ocs2_msgs::mpc_solver_metrics>(topicPrefix_ + "_mpc_metrics", 1);
+  }
 
   // MPC reset service server
   mpcResetServiceServer_ = nodeHandle.advertiseService(topicPrefix_ + "_mpc_reset", &MPC_ROS_Interface::resetMpcCallback, this);
 
+  // trace dump service server and signal
+  if (tracerPtr_ != nullptr) {
+    dumpTraceServiceServer_ =
+        nodeHandle.advertiseService(topicPrefix_ + "_mpc_dump_trace", &MPC_ROS_Interface::dumpTraceCallback, this);
+    std::signal(SIGUSR1, requestTraceDump);
+    ROS_INFO_STREAM("Tracing the MPC cycles. The trace is dumped to " << traceFileName_ << " on SIGUSR1 or the service "
+                                                                       << topicPrefix_ << "_mpc_dump_trace.");
+  }
+
   // display
 #ifdef PUBLISH_THREAD
   ROS_INFO_STREAM("Publishing SLQ-MPC messages on a separate thread.");
 #endif
 
   ROS_INFO_STREAM("MPC node is ready.");
-
-  // spin
-  spin();
 }
 
 }  // namespace ocs2
@@ -0,0 +1,113 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_ros_interfaces/mpc/MultiRobotMpcServer.h"
+
+#include <stdexcept>
+#include <unordered_set>
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+MultiRobotMpcServer::MultiRobotMpcServer(::ros::NodeHandle& nodeHandle, const std::string& robotName,
+                                         const std::vector<std::string>& robotIds, const mpc_factory_t& mpcFactory, size_t nThreads,
+                                         int threadPriority)
+    : threadPoolPtr_(std::make_shared<ThreadPool>(nThreads, threadPriority)) {
+  if (robotIds.empty()) {
+    throw std::runtime_error("[MultiRobotMpcServer] At least one robot id is required!");
+  }
+  const std::unordered_set<std::string> uniqueRobotIds(robotIds.begin(), robotIds.end());
+  if (uniqueRobotIds.size() != robotIds.size()) {
+    throw std::runtime_error("[MultiRobotMpcServer] The robot ids are not unique!");
+  }
+
+  robots_.resize(robotIds.size());
+  for (size_t i = 0; i < robotIds.size(); i++) {
+    auto& robot = robots_[i];
+    robot.topicPrefix = getTopicPrefix(robotName, robotIds[i]);
+    robot.callbackQueuePtr.reset(new ::ros::CallbackQueue);
+    robot.nodeHandlePtr.reset(new ::ros::NodeHandle(nodeHandle));
+    robot.nodeHandlePtr->setCallbackQueue(robot.callbackQueuePtr.get());
+
+    robot.mpcPtr = mpcFactory(i, robot.topicPrefix, *robot.nodeHandlePtr, threadPoolPtr_);
+    if (robot.mpcPtr == nullptr) {
+      throw std::runtime_error("[MultiRobotMpcServer] The MPC factory returned no MPC for the robot " + robotIds[i] + "!");
+    }
+    robot.mpcInterfacePtr.reset(new MPC_ROS_Interface(*robot.mpcPtr, robot.topicPrefix));
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+MultiRobotMpcServer::~MultiRobotMpcServer() {
+  shutdownNodes();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MultiRobotMpcServer::launchNodes() {
+  for (auto& robot : robots_) {
+    robot.mpcInterfacePtr->advertise(*robot.nodeHandlePtr);
+    // a single thread per robot, such that the observations of a robot are processed in order
+    robot.spinnerPtr.reset(new ::ros::AsyncSpinner(1, robot.callbackQueuePtr.get()));
+    robot.spinnerPtr->start();
+  }
+  ROS_INFO_STREAM("Serving the MPCs of " << robots_.size() << " robots on " << threadPoolPtr_->numThreads() << " shared threads.");
+
+  // Equivalent to ros::spin() + check if master is alive
+  while (::ros::ok() && ::ros::master::check()) {
+    ::ros::getGlobalCallbackQueue()->callAvailable(::ros::WallDuration(0.1));
+  }
+
+  shutdownNodes();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MultiRobotMpcServer::shutdownNodes() {
+  // no callback of a robot may run while its node is shut down
+  for (auto& robot : robots_) {
+    if (robot.spinnerPtr != nullptr) {
+      robot.spinnerPtr->stop();
+      robot.spinnerPtr.reset();
+    }
+  }
+  for (auto& robot : robots_) {
+    if (robot.mpcInterfacePtr != nullptr) {
+      robot.mpcInterfacePtr->shutdownNode();
+    }
+  }
+}
+
+}  // namespace ocs2
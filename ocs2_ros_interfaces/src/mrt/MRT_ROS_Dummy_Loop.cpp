@@ -106,6 +106,7 @@ void MRT_ROS_Dummy_Loop::synchronizedDummyLoop(const SystemObservation& initObse
 
     // Forward simulation
     currentObservation = forwardSimulation(currentObservation);
+    mrt_.policyActuated();
 
     // User-defined modifications before publishing
     modifyObservation(currentObservation);
@@ -148,6 +149,7 @@ void MRT_ROS_Dummy_Loop::realtimeDummyLoop(const SystemObservation& initObservat
 
     // Forward simulation
     currentObservation = forwardSimulation(currentObservation);
+    mrt_.policyActuated();
 
     // User-defined modifications before publishing
     modifyObservation(currentObservation);
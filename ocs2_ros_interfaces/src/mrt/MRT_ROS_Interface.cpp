@@ -31,6 +31,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/control/FeedforwardController.h>
 #include <ocs2_core/control/LinearController.h>
+#include <ocs2_core/thread_support/SetThreadPriority.h>
 
 namespace ocs2 {
 
@@ -38,7 +39,11 @@ namespace ocs2 {
 /******************************************************************************************************/
 /******************************************************************************************************/
 MRT_ROS_Interface::MRT_ROS_Interface(std::string topicPrefix, ros::TransportHints mrtTransportHints)
-    : topicPrefix_(std::move(topicPrefix)), mrtTransportHints_(mrtTransportHints) {
+    : topicPrefix_(std::move(topicPrefix)),
+      mrtTransportHints_(mrtTransportHints),
+      observationLatencyObserverPtr_(std::make_shared<ObservationLatencyObserver>()) {
+  this->addMrtObserver(observationLatencyObserverPtr_);
+
 // Start thread for publishing
 #ifdef PUBLISH_THREAD
   // Close old thread if it is already running
@@ -60,7 +65,17 @@ MRT_ROS_Interface::~MRT_ROS_Interface() {
 /******************************************************************************************************/
 /******************************************************************************************************/
 void MRT_ROS_Interface::resetMpcNode(const TargetTrajectories& initTargetTrajectories) {
-  this->reset();
+  {
+    // waits for a running iteration of the fallback MPC, such that its policy is not buffered after the reset
+    std::lock_guard<std::mutex> fallbackLock(fallbackMpcMutex_);
+    this->reset();
+    if (fallbackMpcPtr_ != nullptr) {
+      fallbackMpcPtr_->reset();
+      fallbackMpcPtr_->getSolverPtr()->getReferenceManager().setTargetTrajectories(initTargetTrajectories);
+    }
+  }
+  observationLatencyObserverPtr_->reset();
+  numLatencySamples_ = 0;
 
   ocs2_msgs::reset resetSrv;
   resetSrv.request.reset = static_cast<uint8_t>(true);
@@ -78,12 +93,27 @@ void MRT_ROS_Interface::resetMpcNode(const TargetTrajectories& initTargetTraject
 /******************************************************************************************************/
 /******************************************************************************************************/
 void MRT_ROS_Interface::setCurrentObservation(const SystemObservation& currentObservation) {
+  // the fallback MPC always gets the latest observation
+  if (fallbackMpcPtr_ != nullptr) {
+    fallbackObservationBuffer_.back() = currentObservation;
+    fallbackObservationBuffer_.publish();
+  }
+
+  // throttling
+  const auto now = std::chrono::steady_clock::now();
+  if (minObservationPeriod_.count() > 0 && now - lastObservationPublishTime_ < minObservationPeriod_) {
+    return;
+  }
+  lastObservationPublishTime_ = now;
+
 #ifdef PUBLISH_THREAD
   std::unique_lock<std::mutex> lk(publisherMutex_);
 #endif
 
   // create the message
   mpcObservationMsg_ = ros_msg_conversions::createObservationMsg(currentObservation);
+  mpcObservationMsg_.sequence = ++observationSequence_;
+  observationLatencyObserverPtr_->observationSent(currentObservation.time);
 
   // publish the current observation
 #ifdef PUBLISH_THREAD
@@ -95,6 +125,17 @@ void MRT_ROS_Interface::setCurrentObservation(const SystemObservation& currentOb
 #endif
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MRT_ROS_Interface::setObservationPublishingRate(scalar_t maxRate) {
+  if (maxRate > 0.0) {
+    minObservationPeriod_ = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<scalar_t>(1.0 / maxRate));
+  } else {
+    minObservationPeriod_ = std::chrono::steady_clock::duration::zero();
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -127,6 +168,9 @@ void MRT_ROS_Interface::readPolicyMsg(const ocs2_msgs::mpc_flattened_controller&
   commandData.mpcInitObservation_ = ros_msg_conversions::readObservationMsg(msg.initObservation);
   commandData.mpcTargetTrajectories_ = ros_msg_conversions::readTargetTrajectoriesMsg(msg.planTargetTrajectories);
   performanceIndices = ros_msg_conversions::readPerformanceIndicesMsg(msg.performanceIndices);
+  commandData.mpcTiming_.synchronizedModulesTime = msg.mpcModulesTime;
+  commandData.mpcTiming_.runTime = msg.mpcRunTime;
+  commandData.mpcTiming_.processingTime = msg.mpcProcessingTime;
 
   const size_t N = msg.timeTrajectory.size();
   if (N == 0) {
@@ -195,13 +239,129 @@ void MRT_ROS_Interface::mpcPolicyCallback(const ocs2_msgs::mpc_flattened_control
   std::unique_ptr<PerformanceIndex> performanceIndicesPtr(new PerformanceIndex);
   readPolicyMsg(*msg, *commandPtr, *primalSolutionPtr, *performanceIndicesPtr);
 
+  bufferPolicy(std::move(commandPtr), std::move(primalSolutionPtr), std::move(performanceIndicesPtr));
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MRT_ROS_Interface::mpcCompactPolicyCallback(const ocs2_msgs::mpc_compact_policy::ConstPtr& msg) {
+  // read new policy and command from msg
+  std::unique_ptr<CommandData> commandPtr(new CommandData);
+  std::unique_ptr<PrimalSolution> primalSolutionPtr(new PrimalSolution);
+  std::unique_ptr<PerformanceIndex> performanceIndicesPtr(new PerformanceIndex);
+  if (!compactPolicyDecoder_.decode(msg->buffer, *commandPtr, *primalSolutionPtr, *performanceIndicesPtr)) {
+    ROS_WARN_STREAM_THROTTLE(1.0, "[MRT_ROS_Interface] Dropped a compact policy since its keyframe has not been received.");
+    return;
+  }
+
+  bufferPolicy(std::move(commandPtr), std::move(primalSolutionPtr), std::move(performanceIndicesPtr));
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MRT_ROS_Interface::readSharedMemoryPolicy() {
+  std::unique_ptr<CommandData> commandPtr(new CommandData);
+  std::unique_ptr<PrimalSolution> primalSolutionPtr(new PrimalSolution);
+  std::unique_ptr<PerformanceIndex> performanceIndicesPtr(new PerformanceIndex);
+  if (sharedMemoryPolicyReaderPtr_->read(*commandPtr, *primalSolutionPtr, *performanceIndicesPtr)) {
+    bufferPolicy(std::move(commandPtr), std::move(primalSolutionPtr), std::move(performanceIndicesPtr));
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MRT_ROS_Interface::bufferPolicy(std::unique_ptr<CommandData> commandPtr, std::unique_ptr<PrimalSolution> primalSolutionPtr,
+                                     std::unique_ptr<PerformanceIndex> performanceIndicesPtr) {
   this->moveToBuffer(std::move(commandPtr), std::move(primalSolutionPtr), std::move(performanceIndicesPtr));
+
+  if (metricsPtr_ != nullptr) {
+    // the latency observer has a new sample if the policy is matched to a sent observation
+    const auto latencyStatistics = observationLatencyObserverPtr_->getStatistics();
+    const bool isMatched = latencyStatistics.numSamples > numLatencySamples_;
+    numLatencySamples_ = latencyStatistics.numSamples;
+    metricsPtr_->addPolicy(isMatched ? 1e3 * latencyStatistics.latest : -1.0, this->getNumOverwrittenPolicies());
+    if (metricsPtr_->createMsgIfElapsed(metricsMsg_)) {
+      metricsPublisher_.publish(metricsMsg_);
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MRT_ROS_Interface::enableMetrics(scalar_t windowDuration) {
+  metricsPtr_.reset(new runtime_metrics::MrtMetrics(windowDuration));
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MRT_ROS_Interface::enableLatencyMetrics(scalar_t budget, scalar_t windowDuration) {
+  latencyMetricsPtr_.reset(new runtime_metrics::LatencyMetrics(budget, windowDuration));
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MRT_ROS_Interface::policyActuated() {
+  PolicyLatency latency;
+  if (latencyMetricsPtr_ != nullptr && observationLatencyObserverPtr_->policyActuated(latency)) {
+    latencyMetricsPtr_->addPolicy(latency);
+    if (latencyMetricsPtr_->createMsgIfElapsed(latencyMetricsMsg_)) {
+      latencyMetricsPublisher_.publish(latencyMetricsMsg_);
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MRT_ROS_Interface::enableSharedMemoryPolicy() {
+  sharedMemoryPolicyReaderPtr_.reset(new shared_memory_policy::PolicyReader(shared_memory_policy::getSegmentName(topicPrefix_)));
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MRT_ROS_Interface::enableFallbackMpc(MPC_BASE& fallbackMpc, scalar_t remoteTimeMargin, scalar_t maxConstraintViolationSSE) {
+  fallbackMpcPtr_ = &fallbackMpc;
+  this->setPolicySelector(PolicySelector({remoteTimeMargin, 0.0}, maxConstraintViolationSSE));
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool MRT_ROS_Interface::advanceFallbackMpc() {
+  if (fallbackMpcPtr_ == nullptr) {
+    throw std::runtime_error("[MRT_ROS_Interface::advanceFallbackMpc] The fallback MPC is not set! Use enableFallbackMpc() to set it!");
+  }
+
+  std::lock_guard<std::mutex> fallbackLock(fallbackMpcMutex_);
+
+  // the front slot keeps the latest observation, even if nothing new was set since the last iteration
+  fallbackObservationBuffer_.updateFromBuffer();
+  fallbackMpcObservation_ = fallbackObservationBuffer_.front();
+  if (fallbackMpcObservation_.state.size() == 0) {
+    return false;  // no observation has been set yet
+  }
+
+  if (!fallbackMpcPtr_->run(fallbackMpcObservation_.time, fallbackMpcObservation_.state)) {
+    return false;
+  }
+  this->copySolutionToBuffer(*fallbackMpcPtr_, fallbackMpcObservation_, 1);
+  fallbackMpcPtr_->prepareNextRun(fallbackMpcObservation_.time);
+  return true;
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 void MRT_ROS_Interface::shutdownNodes() {
+  shutdownReceiver();
+
 #ifdef PUBLISH_THREAD
   ROS_INFO_STREAM("Shutting down workers ...");
 
@@ -213,6 +373,7 @@ void MRT_ROS_Interface::shutdownNodes() {
   // clean up callback queue
   mrtCallbackQueue_.clear();
   mpcPolicySubscriber_.shutdown();
+  mpcCompactPolicySubscriber_.shutdown();
 
   // shutdown publishers
   mpcObservationPublisher_.shutdown();
@@ -237,9 +398,53 @@ void MRT_ROS_Interface::shutdownPublisher() {
 /******************************************************************************************************/
 /******************************************************************************************************/
 void MRT_ROS_Interface::spinMRT() {
+  if (receiverThreadRunning_) {
+    return;
+  }
   mrtCallbackQueue_.callOne();
+  if (sharedMemoryPolicyReaderPtr_ != nullptr) {
+    readSharedMemoryPolicy();
+  }
 };
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MRT_ROS_Interface::launchReceiverThread(int priority, const std::vector<int>& cpus) {
+  shutdownReceiver();
+
+  terminateReceiverThread_ = false;
+  receiverThreadRunning_ = true;
+  receiverWorker_ = std::thread(&MRT_ROS_Interface::receiverWorkerThread, this);
+  setThreadPriority(priority, receiverWorker_);
+  setThreadAffinity(cpus, receiverWorker_);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MRT_ROS_Interface::receiverWorkerThread() {
+  // the shared memory segment is polled, hence the wait for ROS messages is kept short
+  const ros::WallDuration timeout(sharedMemoryPolicyReaderPtr_ != nullptr ? 0.0005 : 0.1);
+  while (!terminateReceiverThread_) {
+    mrtCallbackQueue_.callAvailable(timeout);
+    if (sharedMemoryPolicyReaderPtr_ != nullptr) {
+      readSharedMemoryPolicy();
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MRT_ROS_Interface::shutdownReceiver() {
+  terminateReceiverThread_ = true;
+  if (receiverWorker_.joinable()) {
+    receiverWorker_.join();
+  }
+  receiverThreadRunning_ = false;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -263,6 +468,25 @@ void MRT_ROS_Interface::launchNodes(ros::NodeHandle& nodeHandle) {
   ops.transport_hints = mrtTransportHints_;
   mpcPolicySubscriber_ = nodeHandle.subscribe(ops);
 
+  // compact policy subscriber
+  auto compactOps = ros::SubscribeOptions::create<ocs2_msgs::mpc_compact_policy>(
+      topicPrefix_ + "_mpc_compact_policy",                                                      // topic name
+      1,                                                                                         // queue length
+      boost::bind(&MRT_ROS_Interface::mpcCompactPolicyCallback, this, boost::placeholders::_1),  // callback
+      ros::VoidConstPtr(),                                                                       // tracked object
+      &mrtCallbackQueue_                                                                         // pointer to callback queue object
+  );
+  compactOps.transport_hints = mrtTransportHints_;
+  mpcCompactPolicySubscriber_ = nodeHandle.subscribe(compactOps);
+
+  // metrics publisher
+  if (metricsPtr_ != nullptr) {
+    metricsPublisher_ = nodeHandle.advertise<ocs2_msgs::mrt_metrics>(topicPrefix_ + "_mrt_metrics", 1);
+  }
+  if (latencyMetricsPtr_ != nullptr) {
+    latencyMetricsPublisher_ = nodeHandle.advertise<ocs2_msgs::latency_metrics>(topicPrefix_ + "_mrt_latency", 1);
+  }
+
   // MPC reset service client
   mpcResetServiceClient_ = nodeHandle.serviceClient<ocs2_msgs::reset>(topicPrefix_ + "_mpc_reset");
 
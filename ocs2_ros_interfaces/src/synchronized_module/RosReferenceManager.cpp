@@ -63,6 +63,14 @@ void RosReferenceManager::subscribe(ros::NodeHandle& nodeHandle) {
   };
   targetTrajectoriesSubscriber_ =
       nodeHandle.subscribe<ocs2_msgs::mpc_target_trajectories>(topicPrefix_ + "_mpc_target", 1, targetTrajectoriesCallback);
+
+  // TargetTrajectories segments, which are queued since every segment extends the reference
+  auto targetTrajectoriesSegmentCallback = [this](const ocs2_msgs::mpc_target_trajectories::ConstPtr& msg) {
+    const auto targetTrajectoriesSegment = ros_msg_conversions::readTargetTrajectoriesMsg(*msg);
+    referenceManagerPtr_->appendTargetTrajectories(targetTrajectoriesSegment);
+  };
+  targetTrajectoriesSegmentSubscriber_ = nodeHandle.subscribe<ocs2_msgs::mpc_target_trajectories>(topicPrefix_ + "_mpc_target_append", 100,
+                                                                                                 targetTrajectoriesSegmentCallback);
 }
 
 }  // namespace ocs2
@@ -0,0 +1,162 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_ros_interfaces/visualization/AsyncVisualizer.h"
+
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <iostream>
+
+#include <ocs2_core/thread_support/SetThreadPriority.h>
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void decimatePrimalSolution(const PrimalSolution& primalSolution, scalar_t timeStep, PrimalSolution& decimatedPrimalSolution) {
+  const auto& timeTrajectory = primalSolution.timeTrajectory_;
+  const auto& postEventIndices = primalSolution.postEventIndices_;
+  const size_t numNodes = timeTrajectory.size();
+
+  // select the nodes
+  size_array_t nodes;
+  nodes.reserve(numNodes);
+  decimatedPrimalSolution.postEventIndices_.clear();
+  auto postEventIt = postEventIndices.cbegin();
+  for (size_t i = 0; i < numNodes; i++) {
+    while (postEventIt != postEventIndices.cend() && *postEventIt < i) {
+      ++postEventIt;
+    }
+    const bool isPostEvent = postEventIt != postEventIndices.cend() && *postEventIt == i;
+    const bool isPreEvent = postEventIt != postEventIndices.cend() && *postEventIt == i + 1;
+    if (i == 0 || i + 1 == numNodes || isPostEvent || isPreEvent || timeStep <= 0.0 ||
+        timeTrajectory[i] - timeTrajectory[nodes.back()] >= timeStep) {
+      if (isPostEvent) {
+        decimatedPrimalSolution.postEventIndices_.push_back(nodes.size());
+      }
+      nodes.push_back(i);
+    }
+  }
+
+  // copy the selected nodes, the vectors are only reallocated if their size changes
+  const bool hasInputs = primalSolution.inputTrajectory_.size() == numNodes;
+  decimatedPrimalSolution.timeTrajectory_.resize(nodes.size());
+  decimatedPrimalSolution.stateTrajectory_.resize(nodes.size());
+  decimatedPrimalSolution.inputTrajectory_.resize(hasInputs ? nodes.size() : 0);
+  for (size_t k = 0; k < nodes.size(); k++) {
+    decimatedPrimalSolution.timeTrajectory_[k] = timeTrajectory[nodes[k]];
+    decimatedPrimalSolution.stateTrajectory_[k] = primalSolution.stateTrajectory_[nodes[k]];
+    if (hasInputs) {
+      decimatedPrimalSolution.inputTrajectory_[k] = primalSolution.inputTrajectory_[nodes[k]];
+    }
+  }
+  decimatedPrimalSolution.modeSchedule_ = primalSolution.modeSchedule_;
+  decimatedPrimalSolution.controllerPtr_.reset();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+AsyncVisualizer::AsyncVisualizer(Settings settings, std::vector<std::shared_ptr<DummyObserver>> observersPtrArray)
+    : settings_(std::move(settings)), observersPtrArray_(std::move(observersPtrArray)) {
+  worker_ = std::thread(&AsyncVisualizer::workerThread, this);
+  setThreadAffinity(settings_.cpus_, worker_);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+AsyncVisualizer::~AsyncVisualizer() {
+  {
+    std::lock_guard<std::mutex> lock(bufferMutex_);
+    terminateThread_ = true;
+  }
+  bufferCondition_.notify_one();
+  if (worker_.joinable()) {
+    worker_.join();
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void AsyncVisualizer::update(const SystemObservation& observation, const PrimalSolution& primalSolution, const CommandData& command) {
+  const auto now = std::chrono::steady_clock::now();
+  if (settings_.maxUpdateFrequency_ > 0.0 &&
+      std::chrono::duration<scalar_t>(now - lastUpdateTime_).count() < 1.0 / settings_.maxUpdateFrequency_) {
+    return;
+  }
+  lastUpdateTime_ = now;
+
+  {
+    std::lock_guard<std::mutex> lock(bufferMutex_);
+    bufferedObservation_ = observation;
+    decimatePrimalSolution(primalSolution, settings_.trajectoryTimeStep_, bufferedPrimalSolution_);
+    bufferedCommand_ = command;
+    bufferUpdated_ = true;
+  }
+  bufferCondition_.notify_one();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void AsyncVisualizer::workerThread() {
+  if (settings_.niceness_ != 0) {
+    // on Linux the nice value is a per-thread attribute
+    const auto threadId = static_cast<id_t>(syscall(SYS_gettid));
+    if (setpriority(PRIO_PROCESS, threadId, settings_.niceness_) != 0) {
+      std::cerr << "WARNING: Failed to set the nice value of the visualization thread." << std::endl;
+    }
+  }
+
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(bufferMutex_);
+      bufferCondition_.wait(lock, [this] { return bufferUpdated_ || terminateThread_; });
+      if (terminateThread_) {
+        return;
+      }
+      // swapping retains the storage of both buffers
+      swap(activeObservation_, bufferedObservation_);
+      activePrimalSolution_.swap(bufferedPrimalSolution_);
+      swap(activeCommand_.mpcInitObservation_, bufferedCommand_.mpcInitObservation_);
+      swap(activeCommand_.mpcTargetTrajectories_, bufferedCommand_.mpcTargetTrajectories_);
+      bufferUpdated_ = false;
+    }
+
+    for (auto& observer : observersPtrArray_) {
+      observer->update(activeObservation_, activePrimalSolution_, activeCommand_);
+    }
+  }
+}
+
+}  // namespace ocs2
@@ -37,6 +37,7 @@ extern "C" {
 
 #include <ocs2_core/Types.h>
 
+#include "hpipm_catkin/BoxConstraints.h"
 #include "hpipm_catkin/HpipmInterfaceSettings.h"
 #include "hpipm_catkin/OcpSize.h"
 
@@ -45,11 +46,15 @@ namespace ocs2 {
 /**
  * This class implements the interface between Linear Quadratic optimal control problems defined in OCS2 and the HPIPM solver.
  * If the problem dimensions change, resize needs to be called to re-initialize HPIPM.
+ *
+ * With Settings::partialCondensingHorizon, the problem is partially condensed before it is solved and the solution is expanded back to
+ * the full problem. The Riccati quantities of the full problem are then computed on demand by the first of the getRiccati* calls.
  */
 class HpipmInterface {
  public:
   using OcpSize = hpipm_interface::OcpSize;
   using Settings = hpipm_interface::Settings;
+  using BoxConstraints = hpipm_interface::BoxConstraints;
 
   /**
    * Construct the Hpipm interface with given size and settings.
@@ -60,9 +65,18 @@ class HpipmInterface {
   /** Destructor */
   ~HpipmInterface();
 
-  /** Resize the problem */
+  /**
+   * Resize the problem. Memory is allocated for a capacity in which every stage has the largest dimensions seen so far, such that a new
+   * size within the capacity only repacks the HPIPM structures in the existing memory.
+   */
   void resize(OcpSize ocpSize);
 
+  /** Number of times the HPIPM structures were initialized for a new problem size, including the construction */
+  size_t getNumResizes() const;
+
+  /** Number of memory allocations of the HPIPM structures */
+  size_t getNumAllocations() const;
+
   /**
    * Solves a discrete linear quadratic optimal control problem. The interface needs to be resized to a consistent OcpSize before calling
    * this function
@@ -87,6 +101,90 @@ class HpipmInterface {
                      std::vector<ScalarFunctionQuadraticApproximation>& cost, std::vector<VectorFunctionLinearApproximation>* constraints,
                      vector_array_t& stateTrajectory, vector_array_t& inputTrajectory, bool verbose = false);
 
+  /**
+   * Solves a discrete linear quadratic optimal control problem with box constraints on the states and inputs. The box constraints are
+   * mapped to the native state and input bounds of HPIPM (idxbx, idxbu), which are much cheaper than general inequality constraints. The
+   * interface needs to be resized to a consistent OcpSize, see extractSizesFromProblem(), before calling this function.
+   *
+   * @param x0 : Initial state (deviation).
+   * @param dynamics : Linearized approximation of the discrete dynamics.
+   * @param cost : Quadratic approximation of the cost.
+   * @param constraints : Linearized approximation of constraints, all constraints are mapped to inequality constraints in HPIPM.
+   * @param boxConstraints : Box constraints at every node, can be nullptr.
+   * @param [out] stateTrajectory : Solution state (deviation) trajectory.
+   * @param [out] inputTrajectory : Solution input (deviation) trajectory.
+   * @param verbose : Prints the HPIPM iteration statistics if true.
+   * @return HPIPM returned with flag hpipm_status, see above.
+   */
+  hpipm_status solve(const vector_t& x0, std::vector<VectorFunctionLinearApproximation>& dynamics,
+                     std::vector<ScalarFunctionQuadraticApproximation>& cost, std::vector<VectorFunctionLinearApproximation>* constraints,
+                     std::vector<BoxConstraints>* boxConstraints, vector_array_t& stateTrajectory, vector_array_t& inputTrajectory,
+                     bool verbose = false);
+
+  /**
+   * Solves a discrete linear quadratic optimal control problem with box constraints on the states and inputs and with inequality
+   * constraints. The box constraints are mapped to the native state and input bounds of HPIPM (idxbx, idxbu), which are much cheaper than
+   * general inequality constraints. The inequality constraints C*dx + D*du + h >= 0 are stacked below the (equality) constraints at each
+   * node. The interface needs to be resized to a consistent OcpSize, see extractSizesFromProblem(), before calling this function.
+   *
+   * @param x0 : Initial state (deviation).
+   * @param dynamics : Linearized approximation of the discrete dynamics.
+   * @param cost : Quadratic approximation of the cost.
+   * @param constraints : Linearized approximation of constraints, all constraints are mapped to inequality constraints in HPIPM. They are
+   *                      declared as equalities in HPIPM if the OcpSize has been extracted with declareEqualities.
+   * @param boxConstraints : Box constraints at every node, can be nullptr.
+   * @param inequalityConstraints : Linearized approximation of the inequality constraints at every node, can be nullptr.
+   * @param [out] stateTrajectory : Solution state (deviation) trajectory.
+   * @param [out] inputTrajectory : Solution input (deviation) trajectory.
+   * @param verbose : Prints the HPIPM iteration statistics if true.
+   * @return HPIPM returned with flag hpipm_status, see above.
+   */
+  hpipm_status solve(const vector_t& x0, std::vector<VectorFunctionLinearApproximation>& dynamics,
+                     std::vector<ScalarFunctionQuadraticApproximation>& cost, std::vector<VectorFunctionLinearApproximation>* constraints,
+                     std::vector<BoxConstraints>* boxConstraints, std::vector<VectorFunctionLinearApproximation>* inequalityConstraints,
+                     vector_array_t& stateTrajectory, vector_array_t& inputTrajectory, bool verbose = false);
+
+  /**
+   * Sets the initial guess of the interior point method for the next call to solve(), which is used if Settings::warm_start is 1 (primal
+   * variables) or 2 (primal and dual variables). The trajectories have the layout of the solution of solve(). Entries with an inconsistent
+   * size, e.g. empty vectors, are initialized with zeros. The initial guess needs to be set after resize() and is ignored with partial
+   * condensing, in which case the previous solution of the condensed problem is used.
+   *
+   * @param stateTrajectory : Initial guess of the state (deviation) trajectory, the initial state is not a decision variable.
+   * @param inputTrajectory : Initial guess of the input (deviation) trajectory.
+   * @param costateTrajectory : Initial guess of the multipliers of the dynamics, one for every stage.
+   * @param constraintMultipliers : Initial guess of the multipliers of the constraints, see getDualSolution(). The multipliers of the
+   * box constraints are not set.
+   */
+  void setInitialGuess(const vector_array_t& stateTrajectory, const vector_array_t& inputTrajectory,
+                       const vector_array_t& costateTrajectory, const vector_array_t& constraintMultipliers);
+
+  /**
+   * Return the dual solution of the previously solved problem.
+   *
+   * @param [out] costateTrajectory : Multipliers of the dynamics, one for every stage.
+   * @param [out] constraintMultipliers : Multipliers of the constraints at every node, the multipliers of the lower bounds stacked on top
+   * of the multipliers of the upper bounds. The rows of the inequality constraints follow the ones of the (equality) constraints.
+   */
+  void getDualSolution(vector_array_t& costateTrajectory, vector_array_t& constraintMultipliers) const;
+
+  /**
+   * Extracts the Riccati feedback, feedforward and cost-to-go of the previously solved problem in a single pass, such that the
+   * information of the initial stage is computed only once. The outputs are resized in place, their memory is reused between calls.
+   * See getRiccatiFeedback(), getRiccatiFeedforward() and getRiccatiCostToGo() for the individual quantities.
+   *
+   * @param dynamics0 : dynamics at k = 0
+   * @param cost0 : cost at k = 0
+   * @param numFeedbackStages : The feedback and feedforward are only extracted for the first numFeedbackStages stages, the later ones are
+   * left empty. Any negative number is interpreted as all stages.
+   * @param [out] feedbackPtr : Sequence of N feedback matrices, not computed if nullptr.
+   * @param [out] feedforwardPtr : Sequence of N feedforward vectors, not computed if nullptr.
+   * @param [out] costToGoPtr : Sequence of N + 1 quadratic cost-to-go's, not computed if nullptr.
+   */
+  void getRiccatiSolution(const VectorFunctionLinearApproximation& dynamics0, const ScalarFunctionQuadraticApproximation& cost0,
+                          int numFeedbackStages, matrix_array_t* feedbackPtr, vector_array_t* feedforwardPtr,
+                          std::vector<ScalarFunctionQuadraticApproximation>* costToGoPtr);
+
   /**
    * Return the Riccati cost-to-go for the previously solved problem.
    * Extra information about the initial stage is needed to complete calculation.
@@ -51,9 +51,13 @@ struct Settings {
   scalar_t tol_ineq = 1e-8;  // res_d_max
   scalar_t tol_comp = 1e-8;  // res_m_max
   scalar_t reg_prim = 1e-12;
-  int warm_start = 0;
+  int warm_start = 0;  // 0: cold start, 1: primal warm start, 2: primal-dual warm start, see HpipmInterface::setInitialGuess()
   int pred_corr = 1;
   int ric_alg = 0;  // square root ricatti recursion
+
+  // Number of stages of the partially condensed QP that is passed to the solver. Partial condensing is disabled if this is zero, or not
+  // smaller than the number of stages of the problem.
+  int partialCondensingHorizon = 0;
 };
 
 std::ostream& operator<<(std::ostream& stream, const Settings& settings);
@@ -33,6 +33,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/Types.h>
 
+#include "hpipm_catkin/BoxConstraints.h"
+
 namespace ocs2 {
 namespace hpipm_interface {
 
@@ -58,6 +60,7 @@ struct OcpSize {
   std::vector<int> numInputBoxSlack;        // Number of slack variables for input box inequalities
   std::vector<int> numStateBoxSlack;        // Number of slack variables for state box inequalities
   std::vector<int> numIneqSlack;            // Number of slack variables for general inequalities
+  std::vector<int> numIneqEqualities;       // Number of general constraints which are declared as equalities, these are the first ones
 
   /** Constructor for N stages with constant state and inputs and without constraints */
   explicit OcpSize(int N = 0, int nx = 0, int nu = 0)
@@ -69,7 +72,8 @@ struct OcpSize {
         numIneqConstraints(N + 1, 0),
         numInputBoxSlack(N + 1, 0),
         numStateBoxSlack(N + 1, 0),
-        numIneqSlack(N + 1, 0) {
+        numIneqSlack(N + 1, 0),
+        numIneqEqualities(N + 1, 0) {
     numInputs.back() = 0;
   }
 };
@@ -82,11 +86,19 @@ bool operator==(const OcpSize& lhs, const OcpSize& rhs) noexcept;
  * @param dynamics : Linearized approximation of the discrete dynamics.
  * @param cost : Quadratic approximation of the cost.
  * @param constraints : Linearized approximation of constraints, all constraints are mapped to inequality constraints in HPIPM.
+ * @param boxConstraints : Box constraints on the states and inputs, mapped to the state and input bounds of HPIPM.
+ * @param inequalityConstraints : Linearized approximation of the inequality constraints, mapped to the inequality constraints of HPIPM
+ *                                after the rows of the (equality) constraints.
+ * @param declareEqualities : If true, the constraints are declared as equalities in HPIPM, unless the interface condenses the problem
+ *                            partially. Otherwise, they are inequalities with equal lower and upper bounds.
  * @return Derived sizes
  */
 OcpSize extractSizesFromProblem(const std::vector<VectorFunctionLinearApproximation>& dynamics,
                                 const std::vector<ScalarFunctionQuadraticApproximation>& cost,
-                                const std::vector<VectorFunctionLinearApproximation>* constraints);
+                                const std::vector<VectorFunctionLinearApproximation>* constraints,
+                                const std::vector<BoxConstraints>* boxConstraints = nullptr,
+                                const std::vector<VectorFunctionLinearApproximation>* inequalityConstraints = nullptr,
+                                bool declareEqualities = false);
 
 }  // namespace hpipm_interface
 }  // namespace ocs2
\ No newline at end of file
@@ -29,17 +29,31 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "hpipm_catkin/HpipmInterface.h"
 
+#include <algorithm>
+#include <numeric>
+#include <type_traits>
+
 #include <ocs2_core/misc/LinearAlgebra.h>
 
 extern "C" {
+#include <blasfeo_d_aux.h>
 #include <hpipm_d_ocp_qp.h>
 #include <hpipm_d_ocp_qp_dim.h>
 #include <hpipm_d_ocp_qp_ipm.h>
 #include <hpipm_d_ocp_qp_sol.h>
+#include <hpipm_d_part_cond.h>
 #include <hpipm_timing.h>
 }
 
+// The data of ocs2 is handed to the double precision routines of HPIPM without copies.
+static_assert(std::is_same<ocs2::scalar_t, double>::value,
+              "[HpipmInterface] HPIPM requires ocs2 to be built without OCS2_SINGLE_PRECISION.");
+
 namespace {
+// The general constraints of HPIPM have a lower and an upper bound. The inequality constraints get an upper bound at this distance above
+// their lower bound, far enough to never be active.
+constexpr ocs2::scalar_t inequalityUpperBoundDistance = 1e8;
+
 /**
  * Manages a block of memory. Allows reuse of memory blocks if the required size does not exceed the old size.
  */
@@ -53,8 +67,9 @@ class MemoryBlock {
    * Ensure a block of memory of at least the requested size.
    * Does nothing if the requested size is smaller than equal to the current size.
    * @param size : minimum size of the memory block.
+   * @return true if new memory was allocated.
    */
-  void reserve(size_t size) {
+  bool reserve(size_t size) {
     if (size > size_) {
       free(ptr_);
       ptr_ = malloc(size);
@@ -63,7 +78,9 @@ class MemoryBlock {
       } else {
         size_ = size;
       }
+      return true;
     }
+    return false;
   }
 
   /** Get pointer to the memory, might be nullptr */
@@ -85,6 +102,63 @@ class MemoryBlock {
 
 namespace ocs2 {
 
+namespace {
+/** Upper bound on the problem sizes for which the HPIPM memory is allocated, every stage has the same dimensions. */
+struct OcpCapacity {
+  int numStages = -1;
+  int numStates = 0;
+  int numInputs = 0;
+  int numInputBoxConstraints = 0;
+  int numStateBoxConstraints = 0;
+  int numIneqConstraints = 0;
+  int numInputBoxSlack = 0;
+  int numStateBoxSlack = 0;
+  int numIneqSlack = 0;
+  int numIneqEqualities = 0;
+};
+
+bool isWithinCapacity(const hpipm_interface::OcpSize& ocpSize, const OcpCapacity& capacity) {
+  const auto fits = [](const std::vector<int>& sizes, int maxSize) {
+    return std::all_of(sizes.begin(), sizes.end(), [=](int size) { return size <= maxSize; });
+  };
+  return ocpSize.numStages <= capacity.numStages && fits(ocpSize.numStates, capacity.numStates) &&
+         fits(ocpSize.numInputs, capacity.numInputs) && fits(ocpSize.numInputBoxConstraints, capacity.numInputBoxConstraints) &&
+         fits(ocpSize.numStateBoxConstraints, capacity.numStateBoxConstraints) &&
+         fits(ocpSize.numIneqConstraints, capacity.numIneqConstraints) && fits(ocpSize.numInputBoxSlack, capacity.numInputBoxSlack) &&
+         fits(ocpSize.numStateBoxSlack, capacity.numStateBoxSlack) && fits(ocpSize.numIneqSlack, capacity.numIneqSlack) &&
+         fits(ocpSize.numIneqEqualities, capacity.numIneqEqualities);
+}
+
+/** Grows the capacity to the largest dimensions of any stage of the given problem size */
+void growCapacity(const hpipm_interface::OcpSize& ocpSize, OcpCapacity& capacity) {
+  const auto grow = [](const std::vector<int>& sizes, int& maxSize) {
+    maxSize = std::max(maxSize, *std::max_element(sizes.begin(), sizes.end()));
+  };
+  capacity.numStages = std::max(capacity.numStages, ocpSize.numStages);
+  grow(ocpSize.numStates, capacity.numStates);
+  grow(ocpSize.numInputs, capacity.numInputs);
+  grow(ocpSize.numInputBoxConstraints, capacity.numInputBoxConstraints);
+  grow(ocpSize.numStateBoxConstraints, capacity.numStateBoxConstraints);
+  grow(ocpSize.numIneqConstraints, capacity.numIneqConstraints);
+  grow(ocpSize.numInputBoxSlack, capacity.numInputBoxSlack);
+  grow(ocpSize.numStateBoxSlack, capacity.numStateBoxSlack);
+  grow(ocpSize.numIneqSlack, capacity.numIneqSlack);
+  grow(ocpSize.numIneqEqualities, capacity.numIneqEqualities);
+}
+
+hpipm_interface::OcpSize toOcpSize(const OcpCapacity& capacity) {
+  hpipm_interface::OcpSize ocpSize(capacity.numStages, capacity.numStates, capacity.numInputs);
+  std::fill(ocpSize.numInputBoxConstraints.begin(), ocpSize.numInputBoxConstraints.end(), capacity.numInputBoxConstraints);
+  std::fill(ocpSize.numStateBoxConstraints.begin(), ocpSize.numStateBoxConstraints.end(), capacity.numStateBoxConstraints);
+  std::fill(ocpSize.numIneqConstraints.begin(), ocpSize.numIneqConstraints.end(), capacity.numIneqConstraints);
+  std::fill(ocpSize.numInputBoxSlack.begin(), ocpSize.numInputBoxSlack.end(), capacity.numInputBoxSlack);
+  std::fill(ocpSize.numStateBoxSlack.begin(), ocpSize.numStateBoxSlack.end(), capacity.numStateBoxSlack);
+  std::fill(ocpSize.numIneqSlack.begin(), ocpSize.numIneqSlack.end(), capacity.numIneqSlack);
+  std::fill(ocpSize.numIneqEqualities.begin(), ocpSize.numIneqEqualities.end(), capacity.numIneqEqualities);
+  return ocpSize;
+}
+}  // namespace
+
 class HpipmInterface::Impl {
  public:
   Impl(OcpSize ocpSize, Settings settings) : settings_(std::move(settings)) { initializeMemory(std::move(ocpSize), true); }
@@ -93,59 +167,140 @@ class HpipmInterface::Impl {
     // We will remove the initial state from the decision variables before passing the data to HPIPM.
     // This removes the need for adding constraints to enforce x[0] = x_init
     ocpSize.numStates[0] = 0;
+    ocpSize.numStateBoxConstraints[0] = 0;
+
+    // The declared equalities are not passed through the partial condensing, they stay inequalities with equal lower and upper bounds.
+    const int N2 = settings_.partialCondensingHorizon;
+    if (N2 > 0 && N2 < ocpSize.numStages) {
+      std::fill(ocpSize.numIneqEqualities.begin(), ocpSize.numIneqEqualities.end(), 0);
+    }
 
     // Skip memory initialization if problem size didn't change.
     if (!forceInitialization && ocpSize_ == ocpSize) {
       return;
     }
 
+    // The memory is allocated for a capacity in which every stage has the largest dimensions seen so far. Sizes that only move between
+    // the stages, e.g. constraints following the mode schedule, then fit the capacity and the HPIPM structures are repacked in place.
+    if (!isWithinCapacity(ocpSize, capacity_)) {
+      growCapacity(ocpSize, capacity_);
+      auto capacitySize = toOcpSize(capacity_);
+      createStructures(capacitySize);
+    }
+
     ocpSize_ = std::move(ocpSize);
+    createStructures(ocpSize_);
+    ++numResizes_;
+  }
 
-    const int dim_size = d_ocp_qp_dim_memsize(ocpSize_.numStages);
-    dimMem_.reserve(dim_size);
-    d_ocp_qp_dim_create(ocpSize_.numStages, &dim_, dimMem_.get());
-    d_ocp_qp_dim_set_all(ocpSize_.numStates.data(), ocpSize_.numInputs.data(), ocpSize_.numStateBoxConstraints.data(),
-                         ocpSize_.numInputBoxConstraints.data(), ocpSize_.numIneqConstraints.data(), ocpSize_.numStateBoxSlack.data(),
-                         ocpSize_.numInputBoxSlack.data(), ocpSize_.numIneqSlack.data(), &dim_);
+  /** Creates the HPIPM structures for the given size, memory is only allocated if the size exceeds the capacity */
+  void createStructures(OcpSize& ocpSize) {
+    const int dim_size = d_ocp_qp_dim_memsize(ocpSize.numStages);
+    reserve(dimMem_, dim_size);
+    d_ocp_qp_dim_create(ocpSize.numStages, &dim_, dimMem_.get());
+    d_ocp_qp_dim_set_all(ocpSize.numStates.data(), ocpSize.numInputs.data(), ocpSize.numStateBoxConstraints.data(),
+                         ocpSize.numInputBoxConstraints.data(), ocpSize.numIneqConstraints.data(), ocpSize.numStateBoxSlack.data(),
+                         ocpSize.numInputBoxSlack.data(), ocpSize.numIneqSlack.data(), &dim_);
+    for (int k = 0; k < ocpSize.numStages + 1; k++) {
+      d_ocp_qp_dim_set_nge(k, ocpSize.numIneqEqualities[k], &dim_);
+    }
 
     const int qp_size = d_ocp_qp_memsize(&dim_);
-    qpMem_.reserve(qp_size);
+    reserve(qpMem_, qp_size);
     d_ocp_qp_create(&dim_, &qp_, qpMem_.get());
 
     const int qp_sol_size = d_ocp_qp_sol_memsize(&dim_);
-    qpSolMem_.reserve(qp_sol_size);
+    reserve(qpSolMem_, qp_sol_size);
     d_ocp_qp_sol_create(&dim_, &qpSol_, qpSolMem_.get());
 
     const int ipm_arg_size = d_ocp_qp_ipm_arg_memsize(&dim_);
-    ipmArgMem_.reserve(ipm_arg_size);
+    reserve(ipmArgMem_, ipm_arg_size);
     d_ocp_qp_ipm_arg_create(&dim_, &arg_, ipmArgMem_.get());
 
-    applySettings(settings_);
+    applySettings(settings_, arg_);
 
     // Setup workspace after applying the settings
     const int ipm_size = d_ocp_qp_ipm_ws_memsize(&dim_, &arg_);
-    ipmMem_.reserve(ipm_size);
+    reserve(ipmMem_, ipm_size);
     d_ocp_qp_ipm_ws_create(&dim_, &arg_, &workspace_, ipmMem_.get());
+
+    initializePartialCondensingMemory(ocpSize.numStages);
   }
 
-  void applySettings(Settings& settings) {
-    d_ocp_qp_ipm_arg_set_default(settings.hpipmMode, &arg_);
-    d_ocp_qp_ipm_arg_set_iter_max(&settings.iter_max, &arg_);
-    d_ocp_qp_ipm_arg_set_alpha_min(&settings.alpha_min, &arg_);
-    d_ocp_qp_ipm_arg_set_mu0(&settings.mu0, &arg_);
-    d_ocp_qp_ipm_arg_set_tol_stat(&settings.tol_stat, &arg_);
-    d_ocp_qp_ipm_arg_set_tol_eq(&settings.tol_eq, &arg_);
-    d_ocp_qp_ipm_arg_set_tol_ineq(&settings.tol_ineq, &arg_);
-    d_ocp_qp_ipm_arg_set_tol_comp(&settings.tol_comp, &arg_);
-    d_ocp_qp_ipm_arg_set_reg_prim(&settings.reg_prim, &arg_);
-    d_ocp_qp_ipm_arg_set_warm_start(&settings.warm_start, &arg_);
-    d_ocp_qp_ipm_arg_set_pred_corr(&settings.pred_corr, &arg_);
-    d_ocp_qp_ipm_arg_set_ric_alg(&settings.ric_alg, &arg_);
+  size_t getNumResizes() const { return numResizes_; }
+  size_t getNumAllocations() const { return numAllocations_; }
+
+  /**
+   * The partially condensed problem has partialCondensingHorizon stages, each one condensing a block of consecutive stages of the full
+   * problem. The full problem memory is kept, it is the input of the condensing and the output of the solution expansion.
+   */
+  void initializePartialCondensingMemory(int numStages) {
+    const int N2 = settings_.partialCondensingHorizon;
+    usePartialCondensing_ = N2 > 0 && N2 < numStages;
+    if (!usePartialCondensing_) {
+      return;
+    }
+
+    blockSize_.resize(N2 + 1);
+    d_part_cond_qp_compute_block_size(numStages, N2, blockSize_.data());
+
+    const int cond_dim_size = d_ocp_qp_dim_memsize(N2);
+    reserve(condDimMem_, cond_dim_size);
+    d_ocp_qp_dim_create(N2, &condDim_, condDimMem_.get());
+    d_part_cond_qp_compute_dim(&dim_, blockSize_.data(), &condDim_);
+
+    const int part_cond_arg_size = d_part_cond_qp_arg_memsize(N2);
+    reserve(partCondArgMem_, part_cond_arg_size);
+    d_part_cond_qp_arg_create(N2, &partCondArg_, partCondArgMem_.get());
+    d_part_cond_qp_arg_set_default(&partCondArg_);
+    d_part_cond_qp_arg_set_ric_alg(settings_.ric_alg, &partCondArg_);
+
+    const int part_cond_size = d_part_cond_qp_ws_memsize(&dim_, blockSize_.data(), &condDim_, &partCondArg_);
+    reserve(partCondMem_, part_cond_size);
+    d_part_cond_qp_ws_create(&dim_, blockSize_.data(), &condDim_, &partCondArg_, &partCondWorkspace_, partCondMem_.get());
+
+    const int cond_qp_size = d_ocp_qp_memsize(&condDim_);
+    reserve(condQpMem_, cond_qp_size);
+    d_ocp_qp_create(&condDim_, &condQp_, condQpMem_.get());
+
+    const int cond_qp_sol_size = d_ocp_qp_sol_memsize(&condDim_);
+    reserve(condQpSolMem_, cond_qp_sol_size);
+    d_ocp_qp_sol_create(&condDim_, &condQpSol_, condQpSolMem_.get());
+
+    const int cond_ipm_arg_size = d_ocp_qp_ipm_arg_memsize(&condDim_);
+    reserve(condIpmArgMem_, cond_ipm_arg_size);
+    d_ocp_qp_ipm_arg_create(&condDim_, &condArg_, condIpmArgMem_.get());
+
+    applySettings(settings_, condArg_);
+
+    const int cond_ipm_size = d_ocp_qp_ipm_ws_memsize(&condDim_, &condArg_);
+    reserve(condIpmMem_, cond_ipm_size);
+    d_ocp_qp_ipm_ws_create(&condDim_, &condArg_, &condWorkspace_, condIpmMem_.get());
+
+    const int factorization_sol_size = d_ocp_qp_sol_memsize(&dim_);
+    reserve(factorizationSolMem_, factorization_sol_size);
+    d_ocp_qp_sol_create(&dim_, &factorizationSol_, factorizationSolMem_.get());
+  }
+
+  static void applySettings(Settings settings, d_ocp_qp_ipm_arg& arg) {
+    d_ocp_qp_ipm_arg_set_default(settings.hpipmMode, &arg);
+    d_ocp_qp_ipm_arg_set_iter_max(&settings.iter_max, &arg);
+    d_ocp_qp_ipm_arg_set_alpha_min(&settings.alpha_min, &arg);
+    d_ocp_qp_ipm_arg_set_mu0(&settings.mu0, &arg);
+    d_ocp_qp_ipm_arg_set_tol_stat(&settings.tol_stat, &arg);
+    d_ocp_qp_ipm_arg_set_tol_eq(&settings.tol_eq, &arg);
+    d_ocp_qp_ipm_arg_set_tol_ineq(&settings.tol_ineq, &arg);
+    d_ocp_qp_ipm_arg_set_tol_comp(&settings.tol_comp, &arg);
+    d_ocp_qp_ipm_arg_set_reg_prim(&settings.reg_prim, &arg);
+    d_ocp_qp_ipm_arg_set_warm_start(&settings.warm_start, &arg);
+    d_ocp_qp_ipm_arg_set_pred_corr(&settings.pred_corr, &arg);
+    d_ocp_qp_ipm_arg_set_ric_alg(&settings.ric_alg, &arg);
   }
 
   void verifySizes(const vector_t& x0, std::vector<VectorFunctionLinearApproximation>& dynamics,
-                   std::vector<ScalarFunctionQuadraticApproximation>& cost,
-                   std::vector<VectorFunctionLinearApproximation>* constraints) const {
+                   std::vector<ScalarFunctionQuadraticApproximation>& cost, std::vector<VectorFunctionLinearApproximation>* constraints,
+                   std::vector<BoxConstraints>* boxConstraints,
+                   std::vector<VectorFunctionLinearApproximation>* inequalityConstraints) const {
     if (dynamics.size() != ocpSize_.numStages) {
       throw std::runtime_error("[HpipmInterface] Inconsistent size of dynamics: " + std::to_string(dynamics.size()) + " with " +
                                std::to_string(ocpSize_.numStages) + " number of stages.");
@@ -160,20 +315,58 @@ class HpipmInterface::Impl {
                                  std::to_string(ocpSize_.numStages + 1) + " nodes.");
       }
     }
+    if (inequalityConstraints != nullptr) {
+      if (inequalityConstraints->size() != ocpSize_.numStages + 1) {
+        throw std::runtime_error("[HpipmInterface] Inconsistent size of inequality constraints: " +
+                                 std::to_string(inequalityConstraints->size()) + " with " + std::to_string(ocpSize_.numStages + 1) +
+                                 " nodes.");
+      }
+    }
+    for (int k = 0; k < ocpSize_.numStages + 1; k++) {
+      const int numConstraints = ((constraints != nullptr) ? (*constraints)[k].f.size() : 0) +
+                                 ((inequalityConstraints != nullptr) ? (*inequalityConstraints)[k].f.size() : 0);
+      if (numConstraints != ocpSize_.numIneqConstraints[k]) {
+        throw std::runtime_error("[HpipmInterface] Inconsistent number of constraints at node " + std::to_string(k) + ".");
+      }
+      const int numEqualities = (constraints != nullptr) ? (*constraints)[k].f.size() : 0;
+      if (ocpSize_.numIneqEqualities[k] != 0 && ocpSize_.numIneqEqualities[k] != numEqualities) {
+        throw std::runtime_error("[HpipmInterface] Inconsistent number of declared equality constraints at node " + std::to_string(k) +
+                                 ".");
+      }
+    }
+    if (boxConstraints != nullptr) {
+      if (boxConstraints->size() != ocpSize_.numStages + 1) {
+        throw std::runtime_error("[HpipmInterface] Inconsistent size of box constraints: " + std::to_string(boxConstraints->size()) +
+                                 " with " + std::to_string(ocpSize_.numStages + 1) + " nodes.");
+      }
+      for (int k = 0; k < ocpSize_.numStages + 1; k++) {
+        const auto& box = (*boxConstraints)[k];
+        const bool consistentStateBounds = k == 0 || (box.stateIndices.size() == ocpSize_.numStateBoxConstraints[k] &&
+                                                      box.stateLowerBound.size() == ocpSize_.numStateBoxConstraints[k] &&
+                                                      box.stateUpperBound.size() == ocpSize_.numStateBoxConstraints[k]);
+        const bool consistentInputBounds = box.inputIndices.size() == ocpSize_.numInputBoxConstraints[k] &&
+                                           box.inputLowerBound.size() == ocpSize_.numInputBoxConstraints[k] &&
+                                           box.inputUpperBound.size() == ocpSize_.numInputBoxConstraints[k];
+        if (!consistentStateBounds || !consistentInputBounds) {
+          throw std::runtime_error("[HpipmInterface] Inconsistent size of box constraints at node " + std::to_string(k) + ".");
+        }
+      }
+    } else if (std::any_of(ocpSize_.numStateBoxConstraints.begin(), ocpSize_.numStateBoxConstraints.end(), [](int n) { return n > 0; }) ||
+               std::any_of(ocpSize_.numInputBoxConstraints.begin(), ocpSize_.numInputBoxConstraints.end(), [](int n) { return n > 0; })) {
+      throw std::runtime_error("[HpipmInterface] The problem size has box constraints, but none are given.");
+    }
     // TODO: expand with state-input size checks
   }
 
   hpipm_status solve(const vector_t& x0, std::vector<VectorFunctionLinearApproximation>& dynamics,
                      std::vector<ScalarFunctionQuadraticApproximation>& cost, std::vector<VectorFunctionLinearApproximation>* constraints,
+                     std::vector<BoxConstraints>* boxConstraints, std::vector<VectorFunctionLinearApproximation>* inequalityConstraints,
                      vector_array_t& stateTrajectory, vector_array_t& inputTrajectory, bool verbose) {
     const int N = ocpSize_.numStages;
-    verifySizes(x0, dynamics, cost, constraints);
+    verifySizes(x0, dynamics, cost, constraints, boxConstraints, inequalityConstraints);
 
+    // The data is packed stage by stage into the BLASFEO matrices of the QP, without gathering it in HPIPM's input arrays first.
     // === Dynamics ===
-    std::vector<scalar_t*> AA(N, nullptr);
-    std::vector<scalar_t*> BB(N, nullptr);
-    std::vector<scalar_t*> bb(N, nullptr);
-
     // k = 0. Absorb initial state into dynamics
     // The initial state is removed from the decision variables
     // The first dynamics becomes:
@@ -183,105 +376,121 @@ class HpipmInterface::Impl {
     // numState[0] = 0 --> No need to specify A[0] here
     vector_t b0 = dynamics[0].f;
     b0.noalias() += dynamics[0].dfdx * x0;
-    BB[0] = dynamics[0].dfdu.data();
-    bb[0] = b0.data();
+    d_ocp_qp_set_B(0, dynamics[0].dfdu.data(), &qp_);
+    d_ocp_qp_set_b(0, b0.data(), &qp_);
 
     // k = 1 -> N-1
     for (int k = 1; k < N; k++) {
-      AA[k] = dynamics[k].dfdx.data();
-      BB[k] = dynamics[k].dfdu.data();
-      bb[k] = dynamics[k].f.data();
+      d_ocp_qp_set_A(k, dynamics[k].dfdx.data(), &qp_);
+      d_ocp_qp_set_B(k, dynamics[k].dfdu.data(), &qp_);
+      d_ocp_qp_set_b(k, dynamics[k].f.data(), &qp_);
     }
 
     // === Costs ===
-    std::vector<scalar_t*> QQ(N + 1, nullptr);
-    std::vector<scalar_t*> RR(N + 1, nullptr);
-    std::vector<scalar_t*> SS(N + 1, nullptr);
-    std::vector<scalar_t*> qq(N + 1, nullptr);
-    std::vector<scalar_t*> rr(N + 1, nullptr);
-
     // k = 0. Elimination of initial state requires cost adaptation
     // numState[0] = 0 --> No need to specify Q[0], S[0], q[0] here
     vector_t r0 = cost[0].dfdu;
     r0 += cost[0].dfdux * x0;
-    RR[0] = cost[0].dfduu.data();
-    rr[0] = r0.data();
+    d_ocp_qp_set_R(0, cost[0].dfduu.data(), &qp_);
+    d_ocp_qp_set_r(0, r0.data(), &qp_);
 
     // k = 1 -> (N-1)
     for (int k = 1; k < N; k++) {
-      QQ[k] = cost[k].dfdxx.data();
-      RR[k] = cost[k].dfduu.data();
-      SS[k] = cost[k].dfdux.data();
-      qq[k] = cost[k].dfdx.data();
-      rr[k] = cost[k].dfdu.data();
+      d_ocp_qp_set_Q(k, cost[k].dfdxx.data(), &qp_);
+      d_ocp_qp_set_S(k, cost[k].dfdux.data(), &qp_);
+      d_ocp_qp_set_R(k, cost[k].dfduu.data(), &qp_);
+      d_ocp_qp_set_q(k, cost[k].dfdx.data(), &qp_);
+      d_ocp_qp_set_r(k, cost[k].dfdu.data(), &qp_);
     }
 
     // k = N, no inputs
-    QQ[N] = cost[N].dfdxx.data();
-    qq[N] = cost[N].dfdx.data();
+    d_ocp_qp_set_Q(N, cost[N].dfdxx.data(), &qp_);
+    d_ocp_qp_set_q(N, cost[N].dfdx.data(), &qp_);
 
     // === Constraints ===
-    // for ocs2 --> C*dx + D*du + e = 0
+    // for ocs2 --> C*dx + D*du + e = 0 and, stacked below, the inequality constraints C*dx + D*du + h >= 0
     // for hpipm --> ug >= C*dx + D*du >= lg
-    std::vector<scalar_t*> CC(N + 1, nullptr);
-    std::vector<scalar_t*> DD(N + 1, nullptr);
-    std::vector<scalar_t*> llg(N + 1, nullptr);
-    std::vector<scalar_t*> uug(N + 1, nullptr);
-    std::vector<ocs2::vector_t> boundData;  // Declare at this scope to keep the data alive while HPIPM has the pointers
-
-    if (constraints != nullptr) {
-      auto& constr = *constraints;
-      boundData.resize(N + 1);
-
-      // k = 0, eliminate initial state
-      // numState[0] = 0 --> No need to specify C[0] here
-      if (constr[0].f.size() > 0) {
-        boundData[0] = -constr[0].f;
-        boundData[0].noalias() -= constr[0].dfdx * x0;
-        llg[0] = boundData[0].data();
-        uug[0] = boundData[0].data();
-        DD[0] = constr[0].dfdu.data();
+    // The constraint matrices are packed block by block into [D'; C'] of HPIPM, such that the two types are never stacked in a copy.
+    // If declared, the rows of the equality constraints are marked as equalities, which are indexed after the box constraints in HPIPM.
+    vector_t lowerBound;
+    vector_t upperBound;
+    std::vector<int> equalityIndices;
+    for (int k = 0; k < (N + 1); k++) {
+      auto* equality = (constraints != nullptr && (*constraints)[k].f.size() > 0) ? &(*constraints)[k] : nullptr;
+      auto* inequality =
+          (inequalityConstraints != nullptr && (*inequalityConstraints)[k].f.size() > 0) ? &(*inequalityConstraints)[k] : nullptr;
+      if (equality == nullptr && inequality == nullptr) {
+        continue;
       }
 
-      // k = 1 -> (N-1)
-      for (int k = 1; k < N; k++) {
-        if (constr[k].f.size() > 0) {
-          CC[k] = constr[k].dfdx.data();
-          DD[k] = constr[k].dfdu.data();
-          boundData[k] = -constr[k].f;
-          llg[k] = boundData[k].data();
-          uug[k] = boundData[k].data();
+      const int numEqualities = (equality != nullptr) ? equality->f.size() : 0;
+      const int numInequalities = (inequality != nullptr) ? inequality->f.size() : 0;
+      lowerBound.resize(numEqualities + numInequalities);
+
+      int row = 0;
+      for (auto* constraint : {equality, inequality}) {
+        if (constraint == nullptr) {
+          continue;
+        }
+        const int numRows = constraint->f.size();
+        lowerBound.segment(row, numRows) = -constraint->f;
+        if (k == 0) {
+          // k = 0, eliminate initial state
+          // numState[0] = 0 --> No need to specify C[0] here
+          lowerBound.segment(row, numRows).noalias() -= constraint->dfdx * x0;
+        } else {
+          blasfeo_pack_tran_dmat(numRows, ocpSize_.numStates[k], constraint->dfdx.data(), numRows, qp_.DCt + k, ocpSize_.numInputs[k], row);
+        }
+        // k = N, no inputs
+        if (k < N) {
+          blasfeo_pack_tran_dmat(numRows, ocpSize_.numInputs[k], constraint->dfdu.data(), numRows, qp_.DCt + k, 0, row);
         }
+        row += numRows;
+      }
+
+      d_ocp_qp_set_lg(k, lowerBound.data(), &qp_);
+      upperBound = lowerBound;
+      upperBound.tail(numInequalities).array() += inequalityUpperBoundDistance;
+      d_ocp_qp_set_ug(k, upperBound.data(), &qp_);
+
+      if (ocpSize_.numIneqEqualities[k] > 0) {
+        const int numBoxConstraints = ocpSize_.numInputBoxConstraints[k] + ocpSize_.numStateBoxConstraints[k];
+        equalityIndices.resize(ocpSize_.numIneqEqualities[k]);
+        std::iota(equalityIndices.begin(), equalityIndices.end(), numBoxConstraints);
+        d_ocp_qp_set_idxe(k, equalityIndices.data(), &qp_);
       }
+    }
 
-      // k = N, no inputs
-      if (constr[N].f.size() > 0) {
-        CC[N] = constr[N].dfdx.data();
-        boundData[N] = -constr[N].f;
-        llg[N] = boundData[N].data();
-        uug[N] = boundData[N].data();
+    // === Box constraints ===
+    // for hpipm --> ubx >= dx(idxbx) >= lbx and ubu >= du(idxbu) >= lbu, these are not mapped to the general constraints above
+    if (boxConstraints != nullptr) {
+      auto& box = *boxConstraints;
+      for (int k = 0; k < (N + 1); k++) {
+        // k = 0, the initial state is not a decision variable and the state bounds are not used
+        if (ocpSize_.numStateBoxConstraints[k] > 0) {
+          d_ocp_qp_set_idxbx(k, box[k].stateIndices.data(), &qp_);
+          d_ocp_qp_set_lbx(k, box[k].stateLowerBound.data(), &qp_);
+          d_ocp_qp_set_ubx(k, box[k].stateUpperBound.data(), &qp_);
+        }
+        // k = N, no inputs
+        if (ocpSize_.numInputBoxConstraints[k] > 0) {
+          d_ocp_qp_set_idxbu(k, box[k].inputIndices.data(), &qp_);
+          d_ocp_qp_set_lbu(k, box[k].inputLowerBound.data(), &qp_);
+          d_ocp_qp_set_ubu(k, box[k].inputUpperBound.data(), &qp_);
+        }
       }
     }
 
-    // === Unused ===
-    int** hidxbx = nullptr;
-    scalar_t** hlbx = nullptr;
-    scalar_t** hubx = nullptr;
-    int** hidxbu = nullptr;
-    scalar_t** hlbu = nullptr;
-    scalar_t** hubu = nullptr;
-    scalar_t** hZl = nullptr;
-    scalar_t** hZu = nullptr;
-    scalar_t** hzl = nullptr;
-    scalar_t** hzu = nullptr;
-    int** hidxs = nullptr;
-    scalar_t** hlls = nullptr;
-    scalar_t** hlus = nullptr;
-
-    // === Set and solve ===
-    d_ocp_qp_set_all(AA.data(), BB.data(), bb.data(), QQ.data(), SS.data(), RR.data(), qq.data(), rr.data(), hidxbx, hlbx, hubx, hidxbu,
-                     hlbu, hubu, CC.data(), DD.data(), llg.data(), uug.data(), hZl, hZu, hzl, hzu, hidxs, hlls, hlus, &qp_);
-    d_ocp_qp_ipm_solve(&qp_, &qpSol_, &arg_, &workspace_);
+    // === Solve ===
+    if (usePartialCondensing_) {
+      d_part_cond_qp_cond(&qp_, &condQp_, &partCondArg_, &partCondWorkspace_);
+      d_ocp_qp_ipm_solve(&condQp_, &condQpSol_, &condArg_, &condWorkspace_);
+      d_part_cond_qp_expand_sol(&qp_, &condQp_, &condQpSol_, &qpSol_, &partCondArg_, &partCondWorkspace_);
+      isFullProblemFactorized_ = false;
+    } else {
+      d_ocp_qp_ipm_solve(&qp_, &qpSol_, &arg_, &workspace_);
+      isFullProblemFactorized_ = true;
+    }
 
     if (verbose) {
       printStatus();
@@ -296,10 +505,88 @@ class HpipmInterface::Impl {
 
     // Return solver status
     int hpipmStatus = -1;
-    d_ocp_qp_ipm_get_status(&workspace_, &hpipmStatus);
+    d_ocp_qp_ipm_get_status(&solverWorkspace(), &hpipmStatus);
     return hpipm_status(hpipmStatus);
   }
 
+  /**
+   * HPIPM does not expand the Riccati factorization of the partially condensed problem to the full problem. Therefore, the full problem is
+   * factorized on demand with a single IPM iteration warm-started from the expanded primal-dual solution. The tolerances are set to zero
+   * such that this iteration is not skipped for an already converged solution. The iteration runs on a copy of the solution, such that
+   * the primal and dual solutions stay the ones of the solved QP.
+   */
+  void factorizeFullProblem() {
+    if (isFullProblemFactorized_) {
+      return;
+    }
+
+    Settings factorizationSettings = settings_;
+    factorizationSettings.iter_max = 1;
+    factorizationSettings.tol_stat = 0.0;
+    factorizationSettings.tol_eq = 0.0;
+    factorizationSettings.tol_ineq = 0.0;
+    factorizationSettings.tol_comp = 0.0;
+    factorizationSettings.warm_start = 2;  // primal and dual warm start
+    applySettings(factorizationSettings, arg_);
+    d_ocp_qp_sol_copy_all(&qpSol_, &factorizationSol_);
+    d_ocp_qp_ipm_solve(&qp_, &factorizationSol_, &arg_, &workspace_);
+    applySettings(settings_, arg_);
+    isFullProblemFactorized_ = true;
+  }
+
+  void setInitialGuess(const vector_array_t& stateTrajectory, const vector_array_t& inputTrajectory,
+                       const vector_array_t& costateTrajectory, const vector_array_t& constraintMultipliers) {
+    if (usePartialCondensing_) {
+      return;
+    }
+
+    // HPIPM copies the data and does not modify it, but takes non-const pointers
+    vector_t guess;
+    auto getGuess = [&](const vector_array_t& trajectory, int k, int size) -> scalar_t* {
+      if (k < trajectory.size() && trajectory[k].size() == size) {
+        guess = trajectory[k];
+      } else {
+        guess.setZero(size);
+      }
+      return guess.data();
+    };
+
+    const int N = ocpSize_.numStages;
+    for (int k = 1; k < (N + 1); ++k) {
+      d_ocp_qp_sol_set_x(k, getGuess(stateTrajectory, k, ocpSize_.numStates[k]), &qpSol_);
+    }
+    for (int k = 0; k < N; ++k) {
+      d_ocp_qp_sol_set_u(k, getGuess(inputTrajectory, k, ocpSize_.numInputs[k]), &qpSol_);
+      d_ocp_qp_sol_set_pi(k, getGuess(costateTrajectory, k, ocpSize_.numStates[k + 1]), &qpSol_);
+    }
+    for (int k = 0; k < (N + 1); ++k) {
+      const int numConstraints = ocpSize_.numIneqConstraints[k];
+      if (numConstraints > 0) {
+        scalar_t* multipliers = getGuess(constraintMultipliers, k, 2 * numConstraints);
+        d_ocp_qp_sol_set_lam_lg(k, multipliers, &qpSol_);
+        d_ocp_qp_sol_set_lam_ug(k, multipliers + numConstraints, &qpSol_);
+      }
+    }
+  }
+
+  void getDualSolution(vector_array_t& costateTrajectory, vector_array_t& constraintMultipliers) {
+    const int N = ocpSize_.numStages;
+    costateTrajectory.resize(N);
+    for (int k = 0; k < N; ++k) {
+      costateTrajectory[k].resize(ocpSize_.numStates[k + 1]);
+      d_ocp_qp_sol_get_pi(k, &qpSol_, costateTrajectory[k].data());
+    }
+    constraintMultipliers.resize(N + 1);
+    for (int k = 0; k < (N + 1); ++k) {
+      const int numConstraints = ocpSize_.numIneqConstraints[k];
+      constraintMultipliers[k].resize(2 * numConstraints);
+      if (numConstraints > 0) {
+        d_ocp_qp_sol_get_lam_lg(k, &qpSol_, constraintMultipliers[k].data());
+        d_ocp_qp_sol_get_lam_ug(k, &qpSol_, constraintMultipliers[k].data() + numConstraints);
+      }
+    }
+  }
+
   bool getStateSolution(const vector_t& x0, vector_array_t& stateTrajectory) {
     stateTrajectory.resize(ocpSize_.numStages + 1);
     stateTrajectory.front() = x0;
@@ -327,136 +614,116 @@ class HpipmInterface::Impl {
     return true;
   }
 
-  matrix_array_t getRiccatiFeedback(const VectorFunctionLinearApproximation& dynamics0, const ScalarFunctionQuadraticApproximation& cost0) {
+  void getRiccatiSolution(const VectorFunctionLinearApproximation& dynamics0, const ScalarFunctionQuadraticApproximation& cost0,
+                          int numFeedbackStages, matrix_array_t* feedbackPtr, vector_array_t* feedforwardPtr,
+                          std::vector<ScalarFunctionQuadraticApproximation>* costToGoPtr) {
+    /*
+     * Note on notation: HPIPM uses P, p for the cost-to-go, where we use Sm, sv
+     */
+    factorizeFullProblem();
     const int N = ocpSize_.numStages;
-    matrix_array_t RiccatiFeedback(N);
+    numFeedbackStages = (numFeedbackStages < 0) ? N : std::min(numFeedbackStages, N);
 
-    // k = 0, state is not a decision variable. Reconstruct backward pass from k = 1
-    matrix_t P1(ocpSize_.numStates[1], ocpSize_.numStates[1]);
-    d_ocp_qp_ipm_get_ric_P(&qp_, &arg_, &workspace_, 1, P1.data());
-
-    matrix_t Lr(ocpSize_.numInputs[0], ocpSize_.numInputs[0]);
-    d_ocp_qp_ipm_get_ric_Lr(&qp_, &arg_, &workspace_, 0, Lr.data());  // Lr matrix is lower triangular
-    LinearAlgebra::setTriangularMinimumEigenvalues(Lr);
-
-    // RiccatiFeedback[0] = - (inv(Lr)^T * inv(Lr)) * (S0 + B0^T * P1 * A0)
-    RiccatiFeedback[0] = -cost0.dfdux;
-    const matrix_t P1_A0 = P1 * dynamics0.dfdx;
-    RiccatiFeedback[0].noalias() -= dynamics0.dfdu.transpose() * P1_A0;
-    Lr.triangularView<Eigen::Lower>().solveInPlace(RiccatiFeedback[0]);
-    Lr.triangularView<Eigen::Lower>().transpose().solveInPlace(RiccatiFeedback[0]);
-
-    // k > 0
-    matrix_t Ls;
-    for (int k = 1; k < N; ++k) {
-      const auto numInput = ocpSize_.numInputs[k];
-      if (numInput > 0) {
-        // RiccatiFeedback[k] = -(Ls * Lr.inverse()).transpose();
-        Lr.resize(numInput, numInput);
-        d_ocp_qp_ipm_get_ric_Lr(&qp_, &arg_, &workspace_, k, Lr.data());  // Lr matrix is lower triangular
-        LinearAlgebra::setTriangularMinimumEigenvalues(Lr);
-
-        Ls.resize(ocpSize_.numStates[k], numInput);
-        d_ocp_qp_ipm_get_ric_Ls(&qp_, &arg_, &workspace_, k, Ls.data());
-        RiccatiFeedback[k].noalias() = -Lr.triangularView<Eigen::Lower>().transpose().solve(Ls.transpose());
-      }
-    }
-
-    return RiccatiFeedback;
-  }
-
-  vector_array_t getRiccatiFeedforward(const VectorFunctionLinearApproximation& dynamics0,
-                                       const ScalarFunctionQuadraticApproximation& cost0) {
-    const int N = ocpSize_.numStages;
-    vector_array_t RiccatiFeedforward(N);
+    // Shorthand notation
+    const matrix_t& A0 = dynamics0.dfdx;
+    const matrix_t& B0 = dynamics0.dfdu;
+    const vector_t& b0 = dynamics0.f;
 
     // k = 0, state is not a decision variable. Reconstruct backward pass from k = 1
-    matrix_t P1(ocpSize_.numStates[1], ocpSize_.numStates[1]);
-    d_ocp_qp_ipm_get_ric_P(&qp_, &arg_, &workspace_, 1, P1.data());
+    P1_.resize(ocpSize_.numStates[1], ocpSize_.numStates[1]);
+    d_ocp_qp_ipm_get_ric_P(&qp_, &arg_, &workspace_, 1, P1_.data());
+    p1_.resize(ocpSize_.numStates[1]);
+    d_ocp_qp_ipm_get_ric_p(&qp_, &arg_, &workspace_, 1, p1_.data());
+    Lr_.resize(ocpSize_.numInputs[0], ocpSize_.numInputs[0]);
+    d_ocp_qp_ipm_get_ric_Lr(&qp_, &arg_, &workspace_, 0, Lr_.data());  // Lr matrix is lower triangular
+    LinearAlgebra::setTriangularMinimumEigenvalues(Lr_);
 
-    matrix_t Lr(ocpSize_.numInputs[0], ocpSize_.numInputs[0]);
-    d_ocp_qp_ipm_get_ric_Lr(&qp_, &arg_, &workspace_, 0, Lr.data());
-    LinearAlgebra::setTriangularMinimumEigenvalues(Lr);
-
-    vector_t p1(ocpSize_.numStates[1]);
-    d_ocp_qp_ipm_get_ric_p(&qp_, &arg_, &workspace_, 1, p1.data());
+    // Use that inv(Lr0)^T * inv(Lr0) = (R0 + B0.transpose() * P1 * B0).inverse();
+    // LrInvG0_ = inv(Lr0) * (S0 + B0.transpose() * P1 * A0)
+    P1A0_.noalias() = P1_ * A0;
+    LrInvG0_ = cost0.dfdux;
+    LrInvG0_.noalias() += B0.transpose() * P1A0_;
+    Lr_.triangularView<Eigen::Lower>().solveInPlace(LrInvG0_);
+    // LrInvg0_ = inv(Lr0) * (r0 + B0.transpose() * p1 + B0.transpose() * P1 * b0)
+    p1b0_ = p1_;
+    p1b0_.noalias() += P1_ * b0;
+    LrInvg0_ = cost0.dfdu;
+    LrInvg0_.noalias() += B0.transpose() * p1b0_;
+    Lr_.triangularView<Eigen::Lower>().solveInPlace(LrInvg0_);
 
-    // RiccatiFeedforward[0] = -(inv(Lr)^T * inv(Lr)) * (r0 + B0.transpose() * p1 + B0.transpose() * P1 * b0);
-    RiccatiFeedforward[0] = -cost0.dfdu;
-    p1.noalias() += P1 * dynamics0.f;  // p1 + P1 * b0
-    RiccatiFeedforward[0].noalias() -= dynamics0.dfdu.transpose() * p1;
-    Lr.triangularView<Eigen::Lower>().solveInPlace(RiccatiFeedforward[0]);
-    Lr.triangularView<Eigen::Lower>().transpose().solveInPlace(RiccatiFeedforward[0]);
+    // k = 0
+    if (feedbackPtr != nullptr) {
+      // RiccatiFeedback[0] = - (inv(Lr)^T * inv(Lr)) * (S0 + B0^T * P1 * A0)
+      feedbackPtr->resize(N);
+      (*feedbackPtr)[0].noalias() = -Lr_.triangularView<Eigen::Lower>().transpose().solve(LrInvG0_);
+    }
+    if (feedforwardPtr != nullptr) {
+      // RiccatiFeedforward[0] = -(inv(Lr)^T * inv(Lr)) * (r0 + B0.transpose() * p1 + B0.transpose() * P1 * b0);
+      feedforwardPtr->resize(N);
+      (*feedforwardPtr)[0].noalias() = -Lr_.triangularView<Eigen::Lower>().transpose().solve(LrInvg0_);
+    }
 
-    // k > 0
+    // 0 < k < N, the stages beyond numFeedbackStages are left empty
     for (int k = 1; k < N; ++k) {
-      RiccatiFeedforward[k].resize(ocpSize_.numInputs[k]);
-      d_ocp_qp_ipm_get_ric_k(&qp_, &arg_, &workspace_, k, RiccatiFeedforward[k].data());
+      const auto numInput = ocpSize_.numInputs[k];
+      const bool isExtracted = k < numFeedbackStages;
+      if (feedbackPtr != nullptr) {
+        auto& RiccatiFeedback = (*feedbackPtr)[k];
+        if (isExtracted && numInput > 0) {
+          // RiccatiFeedback[k] = -(Ls * Lr.inverse()).transpose();
+          Lr_.resize(numInput, numInput);
+          d_ocp_qp_ipm_get_ric_Lr(&qp_, &arg_, &workspace_, k, Lr_.data());  // Lr matrix is lower triangular
+          LinearAlgebra::setTriangularMinimumEigenvalues(Lr_);
+
+          Ls_.resize(ocpSize_.numStates[k], numInput);
+          d_ocp_qp_ipm_get_ric_Ls(&qp_, &arg_, &workspace_, k, Ls_.data());
+          RiccatiFeedback.noalias() = -Lr_.triangularView<Eigen::Lower>().transpose().solve(Ls_.transpose());
+        } else {
+          RiccatiFeedback.resize(0, 0);
+        }
+      }
+      if (feedforwardPtr != nullptr) {
+        auto& RiccatiFeedforward = (*feedforwardPtr)[k];
+        RiccatiFeedforward.resize(isExtracted ? numInput : 0);
+        if (isExtracted) {
+          d_ocp_qp_ipm_get_ric_k(&qp_, &arg_, &workspace_, k, RiccatiFeedforward.data());
+        }
+      }
     }
 
-    return RiccatiFeedforward;
-  }
+    if (costToGoPtr != nullptr) {
+      auto& RiccatiCostToGo = *costToGoPtr;
+      RiccatiCostToGo.resize(N + 1);
 
-  std::vector<ScalarFunctionQuadraticApproximation> getRiccatiCostToGo(const VectorFunctionLinearApproximation& dynamics0,
-                                                                       const ScalarFunctionQuadraticApproximation& cost0) {
-    /*
-     * Note on notation: HPIPM uses P, p for the cost-to-go, where we use Sm, sv
-     */
-    const int N = ocpSize_.numStages;
-    std::vector<ScalarFunctionQuadraticApproximation> RiccatiCostToGo(N + 1);
+      // k > 0
+      for (int k = 1; k <= N; k++) {
+        RiccatiCostToGo[k].dfdxx.resize(ocpSize_.numStates[k], ocpSize_.numStates[k]);
+        RiccatiCostToGo[k].dfdx.resize(ocpSize_.numStates[k]);
+        d_ocp_qp_ipm_get_ric_P(&qp_, &arg_, &workspace_, k, RiccatiCostToGo[k].dfdxx.data());
+        d_ocp_qp_ipm_get_ric_p(&qp_, &arg_, &workspace_, k, RiccatiCostToGo[k].dfdx.data());
+      }
 
-    // k > 0, this first so we have P[1] ready for P[0].
-    for (int k = 1; k <= N; k++) {
-      RiccatiCostToGo[k].dfdxx.resize(ocpSize_.numStates[k], ocpSize_.numStates[k]);
-      RiccatiCostToGo[k].dfdx.resize(ocpSize_.numStates[k]);
-      d_ocp_qp_ipm_get_ric_P(&qp_, &arg_, &workspace_, k, RiccatiCostToGo[k].dfdxx.data());
-      d_ocp_qp_ipm_get_ric_p(&qp_, &arg_, &workspace_, k, RiccatiCostToGo[k].dfdx.data());
+      // k = 0
+      // RiccatiCostToGo[0].dfdxx = Q0 + A0.transpose() * P1 * A0 -
+      //                              (S0 + B0.transpose() * P1 * A0).transpose() * (R0 + B0.transpose() * P1 * B0).inverse() *
+      //                                  (S0 + B0.transpose() * P1 * A0)
+      RiccatiCostToGo[0].dfdxx = cost0.dfdxx;
+      RiccatiCostToGo[0].dfdxx.noalias() += A0.transpose() * P1A0_;
+      RiccatiCostToGo[0].dfdxx.noalias() -= LrInvG0_.transpose() * LrInvG0_;
+
+      // RiccatiCostToGo[0].dfdx = qk + A0.transpose() * p1 + A0.transpose() * P1 * b0 -
+      //                   (S0.transpose() + A0.transpose() * P1 * B0) * (R0 + B0.transpose() * P1 * B0).inverse() *
+      //                       (r0 + B0.transpose() * p1 + B0.transpose() * P1 * b0);
+      RiccatiCostToGo[0].dfdx = cost0.dfdx;
+      RiccatiCostToGo[0].dfdx.noalias() += A0.transpose() * p1b0_;
+      RiccatiCostToGo[0].dfdx.noalias() -= LrInvG0_.transpose() * LrInvg0_;
     }
-
-    // k = 0
-    matrix_t Lr0(ocpSize_.numInputs[0], ocpSize_.numInputs[0]);
-    d_ocp_qp_ipm_get_ric_Lr(&qp_, &arg_, &workspace_, 0, Lr0.data());
-    LinearAlgebra::setTriangularMinimumEigenvalues(Lr0);
-
-    // Shorthand notation
-    const matrix_t& A0 = dynamics0.dfdx;
-    const matrix_t& B0 = dynamics0.dfdu;
-    const vector_t& b0 = dynamics0.f;
-    const matrix_t& Q0 = cost0.dfdxx;
-    matrix_t tmp1 = cost0.dfdux;
-    const vector_t& q0 = cost0.dfdx;
-    vector_t tmp2 = cost0.dfdu;
-    const matrix_t& P1 = RiccatiCostToGo[1].dfdxx;
-    vector_t tmp3 = RiccatiCostToGo[1].dfdx;
-
-    // Matrix terms
-    // RiccatiCostToGo[0].dfdxx = Q0 + A0.transpose() * P1 * A0 -
-    //                              (S0 + B0.transpose() * P1 * A0).transpose() * (R0 + B0.transpose() * P1 * B0).inverse() *
-    //                                  (S0 + B0.transpose() * P1 * A0)
-    // Use that inv(Lr0)^T * inv(Lr0) = (R0 + B0.transpose() * P1 * B0).inverse();
-    const matrix_t P1_A0 = P1 * A0;
-    tmp1.noalias() += B0.transpose() * P1_A0;
-    Lr0.triangularView<Eigen::Lower>().solveInPlace(tmp1);  // tmp1 = inv(Lr0) * (S0.transpose() + A0.transpose() * P1 * B0)
-    RiccatiCostToGo[0].dfdxx = Q0;
-    RiccatiCostToGo[0].dfdxx.noalias() += A0.transpose() * P1_A0;
-    RiccatiCostToGo[0].dfdxx.noalias() -= tmp1.transpose() * tmp1;
-
-    // Vector terms
-    // RiccatiCostToGo[0].dfdx = qk + A0.transpose() * p1 + A0.transpose() * P1 * b0 -
-    //                   (S0.transpose() + A0.transpose() * P1 * B0) * (R0 + B0.transpose() * P1 * B0).inverse() *
-    //                       (r0 + B0.transpose() * p1 + B0.transpose() * P1 * b0);
-    tmp3.noalias() += P1 * b0;  // tmp3 = p1 + B0.transpose() * P1 * b0
-    tmp2.noalias() += B0.transpose() * tmp3;
-    Lr0.triangularView<Eigen::Lower>().solveInPlace(tmp2);  // tmp2 = inv(Lr0) * (r0 + B0.transpose() * p1 + B0.transpose() * P1 * b0)
-    RiccatiCostToGo[0].dfdx = q0;
-    RiccatiCostToGo[0].dfdx.noalias() += A0.transpose() * tmp3;
-    RiccatiCostToGo[0].dfdx.noalias() -= tmp1.transpose() * tmp2;
-    return RiccatiCostToGo;
   }
 
   void printStatus() {
+    auto& workspace = solverWorkspace();
     int hpipmStatus = -1;
-    d_ocp_qp_ipm_get_status(&workspace_, &hpipmStatus);
+    d_ocp_qp_ipm_get_status(&workspace, &hpipmStatus);
     fprintf(stderr, "\n=== HPIPM ===\n");
     fprintf(stderr, "HPIPM returned with flag %i. -> ", hpipmStatus);
     if (hpipmStatus == hpipm_status::SUCCESS) {
@@ -474,19 +741,22 @@ class HpipmInterface::Impl {
     }
 
     int iter;
-    d_ocp_qp_ipm_get_iter(&workspace_, &iter);
+    d_ocp_qp_ipm_get_iter(&workspace, &iter);
     scalar_t res_stat;
-    d_ocp_qp_ipm_get_max_res_stat(&workspace_, &res_stat);
+    d_ocp_qp_ipm_get_max_res_stat(&workspace, &res_stat);
     scalar_t res_eq;
-    d_ocp_qp_ipm_get_max_res_eq(&workspace_, &res_eq);
+    d_ocp_qp_ipm_get_max_res_eq(&workspace, &res_eq);
     scalar_t res_ineq;
-    d_ocp_qp_ipm_get_max_res_ineq(&workspace_, &res_ineq);
+    d_ocp_qp_ipm_get_max_res_ineq(&workspace, &res_ineq);
     scalar_t res_comp;
-    d_ocp_qp_ipm_get_max_res_comp(&workspace_, &res_comp);
+    d_ocp_qp_ipm_get_max_res_comp(&workspace, &res_comp);
     scalar_t* stat;
-    d_ocp_qp_ipm_get_stat(&workspace_, &stat);
+    d_ocp_qp_ipm_get_stat(&workspace, &stat);
     int stat_m;
-    d_ocp_qp_ipm_get_stat_m(&workspace_, &stat_m);
+    d_ocp_qp_ipm_get_stat_m(&workspace, &stat_m);
+    if (usePartialCondensing_) {
+      fprintf(stderr, "partial condensing from %d to %d stages\n", ocpSize_.numStages, settings_.partialCondensingHorizon);
+    }
     fprintf(stderr, "ipm iter = %d\n", iter);
     fprintf(stderr, "ipm residuals max: res_g = %e, res_b = %e, res_d = %e, res_m = %e\n", res_stat, res_eq, res_ineq, res_comp);
     fprintf(stderr,
@@ -503,8 +773,21 @@ class HpipmInterface::Impl {
   }
 
  private:
+  /** Reserves memory in the given block and counts the allocations */
+  void reserve(MemoryBlock& memory, size_t size) {
+    if (memory.reserve(size)) {
+      ++numAllocations_;
+    }
+  }
+
+  /** Workspace of the IPM that solved the last problem */
+  d_ocp_qp_ipm_ws& solverWorkspace() { return usePartialCondensing_ ? condWorkspace_ : workspace_; }
+
   Settings settings_;
   OcpSize ocpSize_;
+  OcpCapacity capacity_;
+  size_t numResizes_ = 0;
+  size_t numAllocations_ = 0;
 
   MemoryBlock dimMem_;
   d_ocp_qp_dim dim_;
@@ -520,6 +803,48 @@ class HpipmInterface::Impl {
 
   MemoryBlock ipmMem_;
   d_ocp_qp_ipm_ws workspace_;
+
+  // True if the Riccati factorization in workspace_ belongs to the last solution, not the case after a partially condensed solve.
+  bool isFullProblemFactorized_ = false;
+
+  // Work arrays of the Riccati extraction
+  matrix_t P1_;
+  vector_t p1_;
+  matrix_t Lr_;
+  matrix_t Ls_;
+  matrix_t P1A0_;
+  vector_t p1b0_;
+  matrix_t LrInvG0_;
+  vector_t LrInvg0_;
+
+  // Partial condensing
+  bool usePartialCondensing_ = false;
+  std::vector<int> blockSize_;
+
+  MemoryBlock condDimMem_;
+  d_ocp_qp_dim condDim_;
+
+  MemoryBlock partCondArgMem_;
+  d_part_cond_qp_arg partCondArg_;
+
+  MemoryBlock partCondMem_;
+  d_part_cond_qp_ws partCondWorkspace_;
+
+  MemoryBlock condQpMem_;
+  d_ocp_qp condQp_;
+
+  MemoryBlock condQpSolMem_;
+  d_ocp_qp_sol condQpSol_;
+
+  MemoryBlock condIpmArgMem_;
+  d_ocp_qp_ipm_arg condArg_;
+
+  MemoryBlock condIpmMem_;
+  d_ocp_qp_ipm_ws condWorkspace_;
+
+  // Scratch solution of the full problem factorization, see factorizeFullProblem()
+  MemoryBlock factorizationSolMem_;
+  d_ocp_qp_sol factorizationSol_;
 };
 
 HpipmInterface::HpipmInterface(OcpSize ocpSize, const Settings& settings)
@@ -531,24 +856,68 @@ void HpipmInterface::resize(OcpSize ocpSize) {
   pImpl_->initializeMemory(std::move(ocpSize));
 }
 
+size_t HpipmInterface::getNumResizes() const {
+  return pImpl_->getNumResizes();
+}
+
+size_t HpipmInterface::getNumAllocations() const {
+  return pImpl_->getNumAllocations();
+}
+
 hpipm_status HpipmInterface::solve(const vector_t& x0, std::vector<VectorFunctionLinearApproximation>& dynamics,
                                    std::vector<ScalarFunctionQuadraticApproximation>& cost,
                                    std::vector<VectorFunctionLinearApproximation>* constraints, vector_array_t& stateTrajectory,
                                    vector_array_t& inputTrajectory, bool verbose) {
-  return pImpl_->solve(x0, dynamics, cost, constraints, stateTrajectory, inputTrajectory, verbose);
+  return pImpl_->solve(x0, dynamics, cost, constraints, nullptr, nullptr, stateTrajectory, inputTrajectory, verbose);
+}
+
+hpipm_status HpipmInterface::solve(const vector_t& x0, std::vector<VectorFunctionLinearApproximation>& dynamics,
+                                   std::vector<ScalarFunctionQuadraticApproximation>& cost,
+                                   std::vector<VectorFunctionLinearApproximation>* constraints, std::vector<BoxConstraints>* boxConstraints,
+                                   vector_array_t& stateTrajectory, vector_array_t& inputTrajectory, bool verbose) {
+  return pImpl_->solve(x0, dynamics, cost, constraints, boxConstraints, nullptr, stateTrajectory, inputTrajectory, verbose);
+}
+
+hpipm_status HpipmInterface::solve(const vector_t& x0, std::vector<VectorFunctionLinearApproximation>& dynamics,
+                                   std::vector<ScalarFunctionQuadraticApproximation>& cost,
+                                   std::vector<VectorFunctionLinearApproximation>* constraints, std::vector<BoxConstraints>* boxConstraints,
+                                   std::vector<VectorFunctionLinearApproximation>* inequalityConstraints,
+                                   vector_array_t& stateTrajectory, vector_array_t& inputTrajectory, bool verbose) {
+  return pImpl_->solve(x0, dynamics, cost, constraints, boxConstraints, inequalityConstraints, stateTrajectory, inputTrajectory, verbose);
 }
 
+void HpipmInterface::setInitialGuess(const vector_array_t& stateTrajectory, const vector_array_t& inputTrajectory,
+                                     const vector_array_t& costateTrajectory, const vector_array_t& constraintMultipliers) {
+  pImpl_->setInitialGuess(stateTrajectory, inputTrajectory, costateTrajectory, constraintMultipliers);
+}
+
+void HpipmInterface::getDualSolution(vector_array_t& costateTrajectory, vector_array_t& constraintMultipliers) const {
+  pImpl_->getDualSolution(costateTrajectory, constraintMultipliers);
+}
+
+void HpipmInterface::getRiccatiSolution(const VectorFunctionLinearApproximation& dynamics0,
+                                        const ScalarFunctionQuadraticApproximation& cost0, int numFeedbackStages,
+                                        matrix_array_t* feedbackPtr, vector_array_t* feedforwardPtr,
+                                        std::vector<ScalarFunctionQuadraticApproximation>* costToGoPtr) {
+  pImpl_->getRiccatiSolution(dynamics0, cost0, numFeedbackStages, feedbackPtr, feedforwardPtr, costToGoPtr);
+}
 std::vector<ScalarFunctionQuadraticApproximation> HpipmInterface::getRiccatiCostToGo(const VectorFunctionLinearApproximation& dynamics0,
                                                                                      const ScalarFunctionQuadraticApproximation& cost0) {
-  return pImpl_->getRiccatiCostToGo(dynamics0, cost0);
+  std::vector<ScalarFunctionQuadraticApproximation> RiccatiCostToGo;
+  pImpl_->getRiccatiSolution(dynamics0, cost0, 0, nullptr, nullptr, &RiccatiCostToGo);
+  return RiccatiCostToGo;
 }
 matrix_array_t HpipmInterface::getRiccatiFeedback(const VectorFunctionLinearApproximation& dynamics0,
                                                   const ScalarFunctionQuadraticApproximation& cost0) {
-  return pImpl_->getRiccatiFeedback(dynamics0, cost0);
+  matrix_array_t RiccatiFeedback;
+  pImpl_->getRiccatiSolution(dynamics0, cost0, -1, &RiccatiFeedback, nullptr, nullptr);
+  return RiccatiFeedback;
 }
 vector_array_t HpipmInterface::getRiccatiFeedforward(const VectorFunctionLinearApproximation& dynamics0,
                                                      const ScalarFunctionQuadraticApproximation& cost0) {
-  return pImpl_->getRiccatiFeedforward(dynamics0, cost0);
+  vector_array_t RiccatiFeedforward;
+  pImpl_->getRiccatiSolution(dynamics0, cost0, -1, nullptr, &RiccatiFeedforward, nullptr);
+  return RiccatiFeedforward;
 }
 
 }  // namespace ocs2
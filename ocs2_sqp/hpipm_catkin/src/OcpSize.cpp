@@ -43,12 +43,15 @@ bool operator==(const OcpSize& lhs, const OcpSize& rhs) noexcept {
   same = same && (lhs.numInputBoxSlack == rhs.numInputBoxSlack);
   same = same && (lhs.numStateBoxSlack == rhs.numStateBoxSlack);
   same = same && (lhs.numIneqSlack == rhs.numIneqSlack);
+  same = same && (lhs.numIneqEqualities == rhs.numIneqEqualities);
   return same;
 }
 
 OcpSize extractSizesFromProblem(const std::vector<VectorFunctionLinearApproximation>& dynamics,
                                 const std::vector<ScalarFunctionQuadraticApproximation>& cost,
-                                const std::vector<VectorFunctionLinearApproximation>* constraints) {
+                                const std::vector<VectorFunctionLinearApproximation>* constraints,
+                                const std::vector<BoxConstraints>* boxConstraints,
+                                const std::vector<VectorFunctionLinearApproximation>* inequalityConstraints, bool declareEqualities) {
   const int numStages = dynamics.size();
 
   OcpSize problemSize(dynamics.size());
@@ -65,6 +68,20 @@ OcpSize extractSizesFromProblem(const std::vector<VectorFunctionLinearApproximat
   if (constraints != nullptr) {
     for (int k = 0; k < numStages + 1; k++) {
       problemSize.numIneqConstraints[k] = (*constraints)[k].f.size();
+      problemSize.numIneqEqualities[k] = declareEqualities ? problemSize.numIneqConstraints[k] : 0;
+    }
+  }
+  if (inequalityConstraints != nullptr) {
+    for (int k = 0; k < numStages + 1; k++) {
+      problemSize.numIneqConstraints[k] += (*inequalityConstraints)[k].f.size();
+    }
+  }
+
+  // Box constraints, the initial state is not a decision variable
+  if (boxConstraints != nullptr) {
+    for (int k = 0; k < numStages + 1; k++) {
+      problemSize.numStateBoxConstraints[k] = (k > 0) ? (*boxConstraints)[k].stateIndices.size() : 0;
+      problemSize.numInputBoxConstraints[k] = (k < numStages) ? (*boxConstraints)[k].inputIndices.size() : 0;
     }
   }
 
@@ -34,6 +34,134 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/test/testTools.h>
 #include <ocs2_oc/test/testProblemsGeneration.h>
 
+extern "C" {
+#include <hpipm_d_ocp_qp.h>
+#include <hpipm_d_ocp_qp_dim.h>
+#include <hpipm_d_ocp_qp_ipm.h>
+#include <hpipm_d_ocp_qp_sol.h>
+}
+
+namespace {
+
+/**
+ * Solves the problem by setting all stages at once with d_ocp_qp_set_all from the stacked constraint matrices, as HpipmInterface did before
+ * it packed the stages directly. The initial state is eliminated as in HpipmInterface, the inequality constraints are below the equalities.
+ */
+void solveWithSetAll(const ocs2::vector_t& x0, std::vector<ocs2::VectorFunctionLinearApproximation>& dynamics,
+                     std::vector<ocs2::ScalarFunctionQuadraticApproximation>& cost,
+                     const std::vector<ocs2::VectorFunctionLinearApproximation>& constraints,
+                     const std::vector<ocs2::VectorFunctionLinearApproximation>& inequalityConstraints,
+                     std::vector<ocs2::HpipmInterface::BoxConstraints>& boxConstraints, std::vector<ocs2::vector_t>& stateTrajectory,
+                     std::vector<ocs2::vector_t>& inputTrajectory) {
+  const int N = dynamics.size();
+  std::vector<int> nx(N + 1), nu(N + 1, 0), nbx(N + 1), nbu(N + 1, 0), ng(N + 1), ns(N + 1, 0);
+  for (int k = 0; k < N + 1; k++) {
+    nx[k] = (k == 0) ? 0 : cost[k].dfdx.size();
+    nbx[k] = (k == 0) ? 0 : boxConstraints[k].stateIndices.size();
+    ng[k] = constraints[k].f.size() + inequalityConstraints[k].f.size();
+    if (k < N) {
+      nu[k] = cost[k].dfdu.size();
+      nbu[k] = boxConstraints[k].inputIndices.size();
+    }
+  }
+
+  // k = 0 absorbs the initial state
+  ocs2::vector_t b0 = dynamics[0].f + dynamics[0].dfdx * x0;
+  ocs2::vector_t r0 = cost[0].dfdu + cost[0].dfdux * x0;
+
+  std::vector<double*> AA(N), BB(N), bb(N), QQ(N + 1), SS(N + 1), RR(N + 1), qq(N + 1), rr(N + 1);
+  std::vector<double*> CC(N + 1), DD(N + 1), llg(N + 1), uug(N + 1), lbx(N + 1), ubx(N + 1), lbu(N + 1), ubu(N + 1);
+  std::vector<int*> idxbx(N + 1), idxbu(N + 1);
+  std::vector<ocs2::matrix_t> stackedDfdx(N + 1), stackedDfdu(N + 1);
+  std::vector<ocs2::vector_t> lowerBound(N + 1), upperBound(N + 1);
+  for (int k = 0; k < N + 1; k++) {
+    if (k < N) {
+      AA[k] = dynamics[k].dfdx.data();
+      BB[k] = dynamics[k].dfdu.data();
+      bb[k] = (k == 0) ? b0.data() : dynamics[k].f.data();
+      RR[k] = cost[k].dfduu.data();
+      rr[k] = (k == 0) ? r0.data() : cost[k].dfdu.data();
+      idxbu[k] = boxConstraints[k].inputIndices.data();
+      lbu[k] = boxConstraints[k].inputLowerBound.data();
+      ubu[k] = boxConstraints[k].inputUpperBound.data();
+    }
+    QQ[k] = cost[k].dfdxx.data();
+    SS[k] = cost[k].dfdux.data();
+    qq[k] = cost[k].dfdx.data();
+    idxbx[k] = boxConstraints[k].stateIndices.data();
+    lbx[k] = boxConstraints[k].stateLowerBound.data();
+    ubx[k] = boxConstraints[k].stateUpperBound.data();
+
+    const int numEqualities = constraints[k].f.size();
+    const int numInequalities = inequalityConstraints[k].f.size();
+    stackedDfdx[k].resize(ng[k], x0.size());
+    stackedDfdx[k] << constraints[k].dfdx, inequalityConstraints[k].dfdx;
+    stackedDfdu[k].resize(ng[k], nu[k]);
+    if (k < N) {
+      stackedDfdu[k] << constraints[k].dfdu, inequalityConstraints[k].dfdu;
+    }
+    lowerBound[k].resize(ng[k]);
+    lowerBound[k] << -constraints[k].f, -inequalityConstraints[k].f;
+    if (k == 0) {
+      lowerBound[k].noalias() -= stackedDfdx[k] * x0;
+    }
+    upperBound[k] = lowerBound[k];
+    upperBound[k].tail(numInequalities).array() += 1e8;
+    CC[k] = stackedDfdx[k].data();
+    DD[k] = stackedDfdu[k].data();
+    llg[k] = lowerBound[k].data();
+    uug[k] = upperBound[k].data();
+  }
+
+  std::vector<char> dimMem(d_ocp_qp_dim_memsize(N));
+  d_ocp_qp_dim dim;
+  d_ocp_qp_dim_create(N, &dim, dimMem.data());
+  d_ocp_qp_dim_set_all(nx.data(), nu.data(), nbx.data(), nbu.data(), ng.data(), ns.data(), ns.data(), ns.data(), &dim);
+
+  std::vector<char> qpMem(d_ocp_qp_memsize(&dim));
+  d_ocp_qp qp;
+  d_ocp_qp_create(&dim, &qp, qpMem.data());
+  d_ocp_qp_set_all(AA.data(), BB.data(), bb.data(), QQ.data(), SS.data(), RR.data(), qq.data(), rr.data(), idxbx.data(), lbx.data(),
+                   ubx.data(), idxbu.data(), lbu.data(), ubu.data(), CC.data(), DD.data(), llg.data(), uug.data(), nullptr, nullptr,
+                   nullptr, nullptr, nullptr, nullptr, nullptr, &qp);
+
+  std::vector<char> solMem(d_ocp_qp_sol_memsize(&dim));
+  d_ocp_qp_sol sol;
+  d_ocp_qp_sol_create(&dim, &sol, solMem.data());
+
+  std::vector<char> argMem(d_ocp_qp_ipm_arg_memsize(&dim));
+  d_ocp_qp_ipm_arg arg;
+  d_ocp_qp_ipm_arg_create(&dim, &arg, argMem.data());
+  ocs2::hpipm_interface::Settings settings;
+  d_ocp_qp_ipm_arg_set_default(settings.hpipmMode, &arg);
+  d_ocp_qp_ipm_arg_set_iter_max(&settings.iter_max, &arg);
+  d_ocp_qp_ipm_arg_set_alpha_min(&settings.alpha_min, &arg);
+  d_ocp_qp_ipm_arg_set_mu0(&settings.mu0, &arg);
+  d_ocp_qp_ipm_arg_set_tol_stat(&settings.tol_stat, &arg);
+  d_ocp_qp_ipm_arg_set_tol_eq(&settings.tol_eq, &arg);
+  d_ocp_qp_ipm_arg_set_tol_ineq(&settings.tol_ineq, &arg);
+  d_ocp_qp_ipm_arg_set_tol_comp(&settings.tol_comp, &arg);
+  d_ocp_qp_ipm_arg_set_reg_prim(&settings.reg_prim, &arg);
+  d_ocp_qp_ipm_arg_set_warm_start(&settings.warm_start, &arg);
+  d_ocp_qp_ipm_arg_set_pred_corr(&settings.pred_corr, &arg);
+  d_ocp_qp_ipm_arg_set_ric_alg(&settings.ric_alg, &arg);
+
+  std::vector<char> wsMem(d_ocp_qp_ipm_ws_memsize(&dim, &arg));
+  d_ocp_qp_ipm_ws workspace;
+  d_ocp_qp_ipm_ws_create(&dim, &arg, &workspace, wsMem.data());
+  d_ocp_qp_ipm_solve(&qp, &sol, &arg, &workspace);
+
+  stateTrajectory.assign(N + 1, x0);
+  inputTrajectory.resize(N);
+  for (int k = 0; k < N; k++) {
+    inputTrajectory[k].resize(nu[k]);
+    d_ocp_qp_sol_get_u(k, &sol, inputTrajectory[k].data());
+    d_ocp_qp_sol_get_x(k + 1, &sol, stateTrajectory[k + 1].data());
+  }
+}
+
+}  // namespace
+
 TEST(test_hpiphm_interface, solve_and_check_dynamic) {
   int nx = 3;
   int nu = 2;
@@ -338,3 +466,482 @@ TEST(test_hpiphm_interface, retrieveRiccati) {
     ASSERT_TRUE(uSol[k].isApprox(KSol[k] * xSol[k] + kSol[k]));
   }
 }
+
+TEST(test_hpiphm_interface, retrieveRiccatiSinglePass) {
+  int nx = 3;
+  int nu = 2;
+  int N = 8;
+  int numFeedbackStages = 3;
+
+  // Problem setup
+  ocs2::vector_t x0 = ocs2::vector_t::Random(nx);
+  std::vector<ocs2::VectorFunctionLinearApproximation> system;
+  std::vector<ocs2::ScalarFunctionQuadraticApproximation> cost;
+  for (int k = 0; k < N; k++) {
+    system.emplace_back(ocs2::getRandomDynamics(nx, nu));
+    cost.emplace_back(ocs2::getRandomCost(nx, nu));
+  }
+  cost.emplace_back(ocs2::getRandomCost(nx, 0));
+
+  // Interface
+  ocs2::HpipmInterface::OcpSize ocpSize(N, nx, nu);
+  ocs2::HpipmInterface hpipmInterface(ocpSize);
+
+  // Solve!
+  std::vector<ocs2::vector_t> xSol;
+  std::vector<ocs2::vector_t> uSol;
+  const auto status = hpipmInterface.solve(x0, system, cost, nullptr, xSol, uSol, true);
+  ASSERT_EQ(status, hpipm_status::SUCCESS);
+
+  // Separate extraction
+  const auto KSolGiven = hpipmInterface.getRiccatiFeedback(system[0], cost[0]);
+  const auto kSolGiven = hpipmInterface.getRiccatiFeedforward(system[0], cost[0]);
+  const auto CostToGoGiven = hpipmInterface.getRiccatiCostToGo(system[0], cost[0]);
+
+  // Single pass over the whole horizon
+  ocs2::matrix_array_t KSol;
+  ocs2::vector_array_t kSol;
+  std::vector<ocs2::ScalarFunctionQuadraticApproximation> CostToGo;
+  hpipmInterface.getRiccatiSolution(system[0], cost[0], -1, &KSol, &kSol, &CostToGo);
+  ASSERT_TRUE(ocs2::isEqual(KSolGiven, KSol, 1e-9));
+  ASSERT_TRUE(ocs2::isEqual(kSolGiven, kSol, 1e-9));
+  ASSERT_EQ(CostToGo.size(), N + 1);
+  for (int k = 0; k < (N + 1); k++) {
+    ASSERT_TRUE(CostToGo[k].dfdxx.isApprox(CostToGoGiven[k].dfdxx, 1e-9));
+    ASSERT_TRUE(CostToGo[k].dfdx.isApprox(CostToGoGiven[k].dfdx, 1e-9));
+  }
+
+  // Single pass over the first stages only, reusing the outputs
+  hpipmInterface.getRiccatiSolution(system[0], cost[0], numFeedbackStages, &KSol, &kSol, nullptr);
+  ASSERT_EQ(KSol.size(), N);
+  ASSERT_EQ(kSol.size(), N);
+  for (int k = 0; k < N; k++) {
+    if (k < numFeedbackStages) {
+      ASSERT_TRUE(KSol[k].isApprox(KSolGiven[k], 1e-9));
+      ASSERT_TRUE(kSol[k].isApprox(kSolGiven[k], 1e-9));
+    } else {
+      ASSERT_EQ(KSol[k].size(), 0);
+      ASSERT_EQ(kSol[k].size(), 0);
+    }
+  }
+}
+
+TEST(test_hpiphm_interface, partialCondensing) {
+  int nx = 3;
+  int nu = 2;
+  int nc = 1;
+  int N = 10;
+
+  // Problem setup
+  ocs2::vector_t x0 = ocs2::vector_t::Random(nx);
+  std::vector<ocs2::VectorFunctionLinearApproximation> system;
+  std::vector<ocs2::VectorFunctionLinearApproximation> constraints;
+  std::vector<ocs2::ScalarFunctionQuadraticApproximation> cost;
+  for (int k = 0; k < N; k++) {
+    system.emplace_back(ocs2::getRandomDynamics(nx, nu));
+    cost.emplace_back(ocs2::getRandomCost(nx, nu));
+    constraints.emplace_back(ocs2::getRandomConstraints(nx, nu, nc));
+  }
+  cost.emplace_back(ocs2::getRandomCost(nx, 0));
+  constraints.emplace_back(ocs2::getRandomConstraints(nx, 0, nc));
+
+  ocs2::HpipmInterface::OcpSize ocpSize(N, nx, nu);
+  ocs2::HpipmInterface::OcpSize constrainedOcpSize = ocpSize;
+  std::fill(constrainedOcpSize.numIneqConstraints.begin(), constrainedOcpSize.numIneqConstraints.end(), nc);
+
+  ocs2::HpipmInterface::Settings condensingSettings;
+  condensingSettings.partialCondensingHorizon = 3;
+
+  // Full and partially condensed interfaces
+  ocs2::HpipmInterface hpipmInterface(ocpSize);
+  ocs2::HpipmInterface condensingHpipmInterface(ocpSize, condensingSettings);
+
+  // Solve without constraints
+  std::vector<ocs2::vector_t> xSol, xSolCondensed;
+  std::vector<ocs2::vector_t> uSol, uSolCondensed;
+  ASSERT_EQ(hpipmInterface.solve(x0, system, cost, nullptr, xSol, uSol, false), hpipm_status::SUCCESS);
+  ASSERT_EQ(condensingHpipmInterface.solve(x0, system, cost, nullptr, xSolCondensed, uSolCondensed, true), hpipm_status::SUCCESS);
+  ASSERT_TRUE(ocs2::isEqual(xSol, xSolCondensed, 1e-9));
+  ASSERT_TRUE(ocs2::isEqual(uSol, uSolCondensed, 1e-9));
+
+  // Riccati quantities of the full problem
+  ASSERT_TRUE(ocs2::isEqual(hpipmInterface.getRiccatiFeedback(system[0], cost[0]),
+                            condensingHpipmInterface.getRiccatiFeedback(system[0], cost[0]), 1e-9));
+  ASSERT_TRUE(ocs2::isEqual(hpipmInterface.getRiccatiFeedforward(system[0], cost[0]),
+                            condensingHpipmInterface.getRiccatiFeedforward(system[0], cost[0]), 1e-9));
+
+  // Solve with constraints
+  hpipmInterface.resize(constrainedOcpSize);
+  condensingHpipmInterface.resize(constrainedOcpSize);
+  ASSERT_EQ(hpipmInterface.solve(x0, system, cost, &constraints, xSol, uSol, false), hpipm_status::SUCCESS);
+  ASSERT_EQ(condensingHpipmInterface.solve(x0, system, cost, &constraints, xSolCondensed, uSolCondensed, true), hpipm_status::SUCCESS);
+  ASSERT_TRUE(ocs2::isEqual(xSol, xSolCondensed, 1e-6));
+  ASSERT_TRUE(ocs2::isEqual(uSol, uSolCondensed, 1e-6));
+  ocs2::vector_array_t costate, multipliers;
+  condensingHpipmInterface.getDualSolution(costate, multipliers);
+
+  // Feedback is available for all stages of the full problem
+  const auto KSol = condensingHpipmInterface.getRiccatiFeedback(system[0], cost[0]);
+  ASSERT_EQ(KSol.size(), static_cast<size_t>(N));
+  for (const auto& K : KSol) {
+    ASSERT_EQ(K.rows(), nu);
+    ASSERT_EQ(K.cols(), nx);
+  }
+
+  // The factorization of the full problem does not modify the dual solution of the solved QP
+  ocs2::vector_array_t costateAfterFactorization, multipliersAfterFactorization;
+  condensingHpipmInterface.getDualSolution(costateAfterFactorization, multipliersAfterFactorization);
+  ASSERT_TRUE(ocs2::isEqual(costate, costateAfterFactorization, 0.0));
+  ASSERT_TRUE(ocs2::isEqual(multipliers, multipliersAfterFactorization, 0.0));
+}
+
+TEST(test_hpiphm_interface, warmStart) {
+  int nx = 3;
+  int nu = 2;
+  int nc = 1;
+  int N = 5;
+
+  // Problem setup
+  ocs2::vector_t x0 = ocs2::vector_t::Random(nx);
+  std::vector<ocs2::VectorFunctionLinearApproximation> system;
+  std::vector<ocs2::VectorFunctionLinearApproximation> constraints;
+  std::vector<ocs2::ScalarFunctionQuadraticApproximation> cost;
+  for (int k = 0; k < N; k++) {
+    system.emplace_back(ocs2::getRandomDynamics(nx, nu));
+    cost.emplace_back(ocs2::getRandomCost(nx, nu));
+    constraints.emplace_back(ocs2::getRandomConstraints(nx, nu, nc));
+  }
+  cost.emplace_back(ocs2::getRandomCost(nx, 0));
+  constraints.emplace_back(ocs2::getRandomConstraints(nx, 0, nc));
+
+  ocs2::HpipmInterface::OcpSize ocpSize(N, nx, nu);
+  std::fill(ocpSize.numIneqConstraints.begin(), ocpSize.numIneqConstraints.end(), nc);
+
+  ocs2::HpipmInterface::Settings settings;
+  settings.warm_start = 2;
+  ocs2::HpipmInterface hpipmInterface(ocpSize, settings);
+
+  // Cold solve
+  std::vector<ocs2::vector_t> xSol, xSolWarm;
+  std::vector<ocs2::vector_t> uSol, uSolWarm;
+  ASSERT_EQ(hpipmInterface.solve(x0, system, cost, &constraints, xSol, uSol, false), hpipm_status::SUCCESS);
+  ocs2::vector_array_t costate, multipliers;
+  hpipmInterface.getDualSolution(costate, multipliers);
+  ASSERT_EQ(costate.size(), static_cast<size_t>(N));
+  ASSERT_EQ(multipliers.size(), static_cast<size_t>(N + 1));
+  for (const auto& lambda : multipliers) {
+    ASSERT_EQ(lambda.size(), 2 * nc);
+  }
+
+  // Solve again from the solution
+  hpipmInterface.setInitialGuess(xSol, uSol, costate, multipliers);
+  ASSERT_EQ(hpipmInterface.solve(x0, system, cost, &constraints, xSolWarm, uSolWarm, true), hpipm_status::SUCCESS);
+  ASSERT_TRUE(ocs2::isEqual(xSol, xSolWarm, 1e-6));
+  ASSERT_TRUE(ocs2::isEqual(uSol, uSolWarm, 1e-6));
+
+  // An inconsistent initial guess is replaced by zeros
+  hpipmInterface.setInitialGuess({}, {}, {}, {});
+  ASSERT_EQ(hpipmInterface.solve(x0, system, cost, &constraints, xSolWarm, uSolWarm, false), hpipm_status::SUCCESS);
+  ASSERT_TRUE(ocs2::isEqual(xSol, xSolWarm, 1e-6));
+  ASSERT_TRUE(ocs2::isEqual(uSol, uSolWarm, 1e-6));
+}
+
+TEST(test_hpiphm_interface, capacityBasedResize) {
+  int nx = 3;
+  int nu = 2;
+  int N = 5;
+
+  ocs2::HpipmInterface::OcpSize ocpSize(N, nx, nu);
+  ocs2::HpipmInterface hpipmInterface(ocpSize);
+  ASSERT_EQ(hpipmInterface.getNumResizes(), 1u);
+
+  // Same size does not resize
+  hpipmInterface.resize(ocpSize);
+  ASSERT_EQ(hpipmInterface.getNumResizes(), 1u);
+
+  // A constraint that moves over the stages only allocates memory the first time
+  ocpSize.numIneqConstraints[0] = 2;
+  hpipmInterface.resize(ocpSize);
+  const auto numAllocations = hpipmInterface.getNumAllocations();
+  for (int k = 1; k < N + 1; k++) {
+    ocpSize.numIneqConstraints[k - 1] = 0;
+    ocpSize.numIneqConstraints[k] = 2;
+    hpipmInterface.resize(ocpSize);
+  }
+  ASSERT_EQ(hpipmInterface.getNumResizes(), static_cast<size_t>(N + 2));
+  ASSERT_EQ(hpipmInterface.getNumAllocations(), numAllocations);
+
+  // Solve in the repacked memory
+  ocs2::vector_t x0 = ocs2::vector_t::Random(nx);
+  std::vector<ocs2::VectorFunctionLinearApproximation> system;
+  std::vector<ocs2::VectorFunctionLinearApproximation> constraints(N + 1);
+  std::vector<ocs2::ScalarFunctionQuadraticApproximation> cost;
+  for (int k = 0; k < N; k++) {
+    system.emplace_back(ocs2::getRandomDynamics(nx, nu));
+    cost.emplace_back(ocs2::getRandomCost(nx, nu));
+  }
+  cost.emplace_back(ocs2::getRandomCost(nx, 0));
+  constraints[N] = ocs2::getRandomConstraints(nx, 0, 2);
+
+  std::vector<ocs2::vector_t> xSol;
+  std::vector<ocs2::vector_t> uSol;
+  ASSERT_EQ(hpipmInterface.solve(x0, system, cost, &constraints, xSol, uSol, false), hpipm_status::SUCCESS);
+  ASSERT_TRUE(constraints[N].f.isApprox(-constraints[N].dfdx * xSol[N], 1e-9));
+}
+
+TEST(test_hpiphm_interface, boxConstraints) {
+  int nx = 3;
+  int nu = 2;
+  int N = 5;
+
+  // Problem setup
+  ocs2::vector_t x0 = ocs2::vector_t::Random(nx);
+  std::vector<ocs2::VectorFunctionLinearApproximation> system;
+  std::vector<ocs2::ScalarFunctionQuadraticApproximation> cost;
+  for (int k = 0; k < N; k++) {
+    system.emplace_back(ocs2::getRandomDynamics(nx, nu));
+    cost.emplace_back(ocs2::getRandomCost(nx, nu));
+  }
+  cost.emplace_back(ocs2::getRandomCost(nx, 0));
+
+  // Unconstrained solution
+  ocs2::HpipmInterface hpipmInterface(ocs2::HpipmInterface::OcpSize(N, nx, nu));
+  std::vector<ocs2::vector_t> xSolUnconstrained;
+  std::vector<ocs2::vector_t> uSolUnconstrained;
+  ASSERT_EQ(hpipmInterface.solve(x0, system, cost, nullptr, xSolUnconstrained, uSolUnconstrained, false), hpipm_status::SUCCESS);
+
+  // Bound the first input below and the last state entry above their unconstrained values, the initial state bounds are ignored
+  std::vector<ocs2::HpipmInterface::BoxConstraints> boxConstraints(N + 1);
+  for (int k = 0; k < N + 1; k++) {
+    auto& box = boxConstraints[k];
+    box.stateIndices = {nx - 1};
+    box.stateLowerBound = ocs2::vector_t::Constant(1, -1e3);
+    box.stateUpperBound = ocs2::vector_t::Constant(1, xSolUnconstrained[k](nx - 1) - 0.1);
+    if (k < N) {
+      box.inputIndices = {0};
+      box.inputLowerBound = ocs2::vector_t::Constant(1, -1e3);
+      box.inputUpperBound = ocs2::vector_t::Constant(1, uSolUnconstrained[k](0) - 0.1);
+    }
+  }
+  const auto ocpSize = ocs2::hpipm_interface::extractSizesFromProblem(system, cost, nullptr, &boxConstraints);
+  ASSERT_EQ(ocpSize.numStateBoxConstraints[0], 0);
+  ASSERT_EQ(ocpSize.numStateBoxConstraints[N], 1);
+  ASSERT_EQ(ocpSize.numInputBoxConstraints[0], 1);
+  ASSERT_EQ(ocpSize.numInputBoxConstraints[N], 0);
+  ASSERT_EQ(ocpSize.numIneqConstraints[0], 0);
+  hpipmInterface.resize(ocpSize);
+
+  std::vector<ocs2::vector_t> xSol;
+  std::vector<ocs2::vector_t> uSol;
+  ASSERT_EQ(hpipmInterface.solve(x0, system, cost, nullptr, &boxConstraints, xSol, uSol, false), hpipm_status::SUCCESS);
+
+  // Dynamic feasibility and bounds
+  const ocs2::scalar_t tol = 1e-6;
+  for (int k = 0; k < N; k++) {
+    ASSERT_TRUE(xSol[k + 1].isApprox(system[k].dfdx * xSol[k] + system[k].dfdu * uSol[k] + system[k].f, 1e-9));
+    ASSERT_LE(uSol[k](0), boxConstraints[k].inputUpperBound(0) + tol);
+    ASSERT_LE(xSol[k + 1](nx - 1), boxConstraints[k + 1].stateUpperBound(0) + tol);
+  }
+
+  // Equal bounds give the same solution as the corresponding general equality constraints
+  std::vector<ocs2::VectorFunctionLinearApproximation> constraints(N + 1);
+  for (int k = 0; k < N + 1; k++) {
+    auto& box = boxConstraints[k];
+    box.stateIndices.clear();
+    box.stateLowerBound.resize(0);
+    box.stateUpperBound.resize(0);
+    if (k < N) {
+      box.inputLowerBound = box.inputUpperBound;
+      constraints[k] = ocs2::VectorFunctionLinearApproximation::Zero(1, nx, nu);
+      constraints[k].dfdu(0, 0) = 1.0;
+      constraints[k].f = -box.inputUpperBound;
+    }
+  }
+  hpipmInterface.resize(ocs2::hpipm_interface::extractSizesFromProblem(system, cost, nullptr, &boxConstraints));
+  ASSERT_EQ(hpipmInterface.solve(x0, system, cost, nullptr, &boxConstraints, xSol, uSol, false), hpipm_status::SUCCESS);
+
+  std::vector<ocs2::vector_t> xSolEquality;
+  std::vector<ocs2::vector_t> uSolEquality;
+  hpipmInterface.resize(ocs2::hpipm_interface::extractSizesFromProblem(system, cost, &constraints));
+  ASSERT_EQ(hpipmInterface.solve(x0, system, cost, &constraints, xSolEquality, uSolEquality, false), hpipm_status::SUCCESS);
+  for (int k = 0; k < N; k++) {
+    ASSERT_TRUE(uSol[k].isApprox(uSolEquality[k], 1e-6));
+    ASSERT_TRUE(xSol[k + 1].isApprox(xSolEquality[k + 1], 1e-6));
+  }
+}
+
+TEST(test_hpiphm_interface, inequalityConstraints) {
+  int nx = 3;
+  int nu = 2;
+  int N = 5;
+
+  // Problem setup with an equality constraint on the inputs at every stage
+  ocs2::vector_t x0 = ocs2::vector_t::Random(nx);
+  std::vector<ocs2::VectorFunctionLinearApproximation> system;
+  std::vector<ocs2::ScalarFunctionQuadraticApproximation> cost;
+  std::vector<ocs2::VectorFunctionLinearApproximation> constraints;
+  for (int k = 0; k < N; k++) {
+    system.emplace_back(ocs2::getRandomDynamics(nx, nu));
+    cost.emplace_back(ocs2::getRandomCost(nx, nu));
+    constraints.emplace_back(ocs2::getRandomConstraints(nx, nu, 1));
+  }
+  cost.emplace_back(ocs2::getRandomCost(nx, 0));
+  constraints.emplace_back(ocs2::VectorFunctionLinearApproximation::Zero(0, nx));
+
+  ocs2::HpipmInterface hpipmInterface(ocs2::hpipm_interface::extractSizesFromProblem(system, cost, &constraints));
+  std::vector<ocs2::vector_t> xSolEquality;
+  std::vector<ocs2::vector_t> uSolEquality;
+  ASSERT_EQ(hpipmInterface.solve(x0, system, cost, &constraints, xSolEquality, uSolEquality, false), hpipm_status::SUCCESS);
+
+  // Bound the first input from above, once as box constraint and once as general inequality constraint: -du(0) + ub >= 0
+  std::vector<ocs2::HpipmInterface::BoxConstraints> boxConstraints(N + 1);
+  std::vector<ocs2::VectorFunctionLinearApproximation> inequalityConstraints(N + 1);
+  inequalityConstraints[N] = ocs2::VectorFunctionLinearApproximation::Zero(0, nx);
+  for (int k = 0; k < N; k++) {
+    const ocs2::scalar_t upperBound = uSolEquality[k](0) - 0.1;
+    boxConstraints[k].inputIndices = {0};
+    boxConstraints[k].inputLowerBound = ocs2::vector_t::Constant(1, -1e3);
+    boxConstraints[k].inputUpperBound = ocs2::vector_t::Constant(1, upperBound);
+    inequalityConstraints[k] = ocs2::VectorFunctionLinearApproximation::Zero(1, nx, nu);
+    inequalityConstraints[k].dfdu(0, 0) = -1.0;
+    inequalityConstraints[k].f(0) = upperBound;
+  }
+
+  const auto ocpSize = ocs2::hpipm_interface::extractSizesFromProblem(system, cost, &constraints, nullptr, &inequalityConstraints);
+  ASSERT_EQ(ocpSize.numIneqConstraints[0], 2);
+  ASSERT_EQ(ocpSize.numIneqConstraints[N], 0);
+  hpipmInterface.resize(ocpSize);
+  std::vector<ocs2::vector_t> xSol;
+  std::vector<ocs2::vector_t> uSol;
+  ASSERT_EQ(hpipmInterface.solve(x0, system, cost, &constraints, nullptr, &inequalityConstraints, xSol, uSol, false),
+            hpipm_status::SUCCESS);
+
+  hpipmInterface.resize(ocs2::hpipm_interface::extractSizesFromProblem(system, cost, &constraints, &boxConstraints));
+  std::vector<ocs2::vector_t> xSolBox;
+  std::vector<ocs2::vector_t> uSolBox;
+  ASSERT_EQ(hpipmInterface.solve(x0, system, cost, &constraints, &boxConstraints, xSolBox, uSolBox, false), hpipm_status::SUCCESS);
+
+  const ocs2::scalar_t tol = 1e-6;
+  for (int k = 0; k < N; k++) {
+    ASSERT_LE(uSol[k](0), boxConstraints[k].inputUpperBound(0) + tol);
+    ASSERT_NEAR((constraints[k].dfdx * xSol[k] + constraints[k].dfdu * uSol[k] + constraints[k].f).norm(), 0.0, tol);
+    ASSERT_TRUE(uSol[k].isApprox(uSolBox[k], 1e-6));
+    ASSERT_TRUE(xSol[k + 1].isApprox(xSolBox[k + 1], 1e-6));
+  }
+}
+
+TEST(test_hpiphm_interface, declaredEqualityConstraints) {
+  int nx = 4;
+  int nu = 3;
+  int N = 5;
+
+  // Problem setup with equality constraints, input box constraints, and an inequality constraint at every stage
+  ocs2::vector_t x0 = ocs2::vector_t::Random(nx);
+  std::vector<ocs2::VectorFunctionLinearApproximation> system;
+  std::vector<ocs2::ScalarFunctionQuadraticApproximation> cost;
+  std::vector<ocs2::VectorFunctionLinearApproximation> constraints;
+  std::vector<ocs2::HpipmInterface::BoxConstraints> boxConstraints(N + 1);
+  std::vector<ocs2::VectorFunctionLinearApproximation> inequalityConstraints(N + 1);
+  for (int k = 0; k < N; k++) {
+    system.emplace_back(ocs2::getRandomDynamics(nx, nu));
+    cost.emplace_back(ocs2::getRandomCost(nx, nu));
+    constraints.emplace_back(ocs2::getRandomConstraints(nx, nu, 1));
+    boxConstraints[k].inputIndices = {1};
+    boxConstraints[k].inputLowerBound = ocs2::vector_t::Constant(1, -0.1);
+    boxConstraints[k].inputUpperBound = ocs2::vector_t::Constant(1, 0.1);
+    inequalityConstraints[k] = ocs2::VectorFunctionLinearApproximation::Zero(1, nx, nu);
+    inequalityConstraints[k].dfdu(0, 2) = -1.0;
+    inequalityConstraints[k].f(0) = 0.1;
+  }
+  cost.emplace_back(ocs2::getRandomCost(nx, 0));
+  constraints.emplace_back(ocs2::VectorFunctionLinearApproximation::Zero(0, nx));
+  inequalityConstraints[N] = ocs2::VectorFunctionLinearApproximation::Zero(0, nx);
+
+  // Solve with the equality constraints as inequalities with equal bounds
+  ocs2::HpipmInterface hpipmInterface(
+      ocs2::hpipm_interface::extractSizesFromProblem(system, cost, &constraints, &boxConstraints, &inequalityConstraints));
+  std::vector<ocs2::vector_t> xSolBounds;
+  std::vector<ocs2::vector_t> uSolBounds;
+  ASSERT_EQ(hpipmInterface.solve(x0, system, cost, &constraints, &boxConstraints, &inequalityConstraints, xSolBounds, uSolBounds, false),
+            hpipm_status::SUCCESS);
+
+  // Solve with the equality constraints declared as equalities
+  const auto ocpSize =
+      ocs2::hpipm_interface::extractSizesFromProblem(system, cost, &constraints, &boxConstraints, &inequalityConstraints, true);
+  ASSERT_EQ(ocpSize.numIneqConstraints[0], 2);
+  ASSERT_EQ(ocpSize.numIneqEqualities[0], 1);
+  ASSERT_EQ(ocpSize.numIneqEqualities[N], 0);
+  hpipmInterface.resize(ocpSize);
+  std::vector<ocs2::vector_t> xSol;
+  std::vector<ocs2::vector_t> uSol;
+  ASSERT_EQ(hpipmInterface.solve(x0, system, cost, &constraints, &boxConstraints, &inequalityConstraints, xSol, uSol, false),
+            hpipm_status::SUCCESS);
+
+  const ocs2::scalar_t tol = 1e-6;
+  for (int k = 0; k < N; k++) {
+    ASSERT_NEAR((constraints[k].dfdx * xSol[k] + constraints[k].dfdu * uSol[k] + constraints[k].f).norm(), 0.0, tol);
+    ASSERT_LE(std::abs(uSol[k](1)), 0.1 + tol);
+    ASSERT_LE(uSol[k](2), 0.1 + tol);
+    ASSERT_TRUE(uSol[k].isApprox(uSolBounds[k], 1e-6));
+    ASSERT_TRUE(xSol[k + 1].isApprox(xSolBounds[k + 1], 1e-6));
+  }
+
+  // With partial condensing, the declared equalities stay inequalities with equal bounds
+  ocs2::HpipmInterface::Settings condensingSettings;
+  condensingSettings.partialCondensingHorizon = 2;
+  ocs2::HpipmInterface condensingHpipmInterface(ocpSize, condensingSettings);
+  std::vector<ocs2::vector_t> xSolCondensed;
+  std::vector<ocs2::vector_t> uSolCondensed;
+  ASSERT_EQ(condensingHpipmInterface.solve(x0, system, cost, &constraints, &boxConstraints, &inequalityConstraints, xSolCondensed,
+                                           uSolCondensed, false),
+            hpipm_status::SUCCESS);
+  ASSERT_TRUE(ocs2::isEqual(xSol, xSolCondensed, 1e-6));
+  ASSERT_TRUE(ocs2::isEqual(uSol, uSolCondensed, 1e-6));
+}
+
+TEST(test_hpiphm_interface, matchesSetAll) {
+  int nx = 3;
+  int nu = 3;
+  int N = 5;
+
+  // Problem setup with state and input dependent equality and inequality constraints, and box constraints on the inputs and states
+  ocs2::vector_t x0 = ocs2::vector_t::Random(nx);
+  std::vector<ocs2::VectorFunctionLinearApproximation> system;
+  std::vector<ocs2::ScalarFunctionQuadraticApproximation> cost;
+  std::vector<ocs2::VectorFunctionLinearApproximation> constraints;
+  std::vector<ocs2::VectorFunctionLinearApproximation> inequalityConstraints;
+  std::vector<ocs2::HpipmInterface::BoxConstraints> boxConstraints(N + 1);
+  for (int k = 0; k < N; k++) {
+    system.emplace_back(ocs2::getRandomDynamics(nx, nu));
+    cost.emplace_back(ocs2::getRandomCost(nx, nu));
+    constraints.emplace_back(ocs2::getRandomConstraints(nx, nu, 1));
+    inequalityConstraints.emplace_back(ocs2::getRandomConstraints(nx, nu, 2));
+    inequalityConstraints.back().f.array() += 1.0;
+    boxConstraints[k].inputIndices = {2};
+    boxConstraints[k].inputLowerBound = ocs2::vector_t::Constant(1, -0.1);
+    boxConstraints[k].inputUpperBound = ocs2::vector_t::Constant(1, 0.1);
+    boxConstraints[k].stateIndices = {0};
+    boxConstraints[k].stateLowerBound = ocs2::vector_t::Constant(1, -10.0);
+    boxConstraints[k].stateUpperBound = ocs2::vector_t::Constant(1, 10.0);
+  }
+  cost.emplace_back(ocs2::getRandomCost(nx, 0));
+  constraints.emplace_back(ocs2::getRandomConstraints(nx, 0, 1));
+  inequalityConstraints.emplace_back(ocs2::getRandomConstraints(nx, 0, 1));
+  inequalityConstraints.back().f.array() += 1.0;
+
+  ocs2::HpipmInterface hpipmInterface(
+      ocs2::hpipm_interface::extractSizesFromProblem(system, cost, &constraints, &boxConstraints, &inequalityConstraints));
+  std::vector<ocs2::vector_t> xSol;
+  std::vector<ocs2::vector_t> uSol;
+  ASSERT_EQ(hpipmInterface.solve(x0, system, cost, &constraints, &boxConstraints, &inequalityConstraints, xSol, uSol, false),
+            hpipm_status::SUCCESS);
+
+  std::vector<ocs2::vector_t> xSolSetAll;
+  std::vector<ocs2::vector_t> uSolSetAll;
+  solveWithSetAll(x0, system, cost, constraints, inequalityConstraints, boxConstraints, xSolSetAll, uSolSetAll);
+
+  for (int k = 0; k < N; k++) {
+    ASSERT_TRUE(uSol[k].isApprox(uSolSetAll[k], 1e-9));
+    ASSERT_TRUE(xSol[k + 1].isApprox(xSolSetAll[k + 1], 1e-9));
+  }
+}
@@ -0,0 +1,155 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <ocs2_core/constraint/StateConstraint.h>
+#include <ocs2_core/initialization/Initializer.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
+#include <ocs2_oc/oc_problem/OptimalControlProblem.h>
+
+#include "ocs2_sqp/ConsensusAdmmSettings.h"
+#include "ocs2_sqp/ConsensusSynchronizedModule.h"
+#include "ocs2_sqp/MultipleShootingSettings.h"
+#include "ocs2_sqp/MultipleShootingSolver.h"
+
+namespace ocs2 {
+
+/**
+ * Distributed MPC of several agents, e.g. robots carrying a shared object, which are coupled by consensus constraints
+ *
+ *   g_i(x_i(t_k)) = z_k, for every agent i and every node t_k of the consensus grid,
+ *
+ * where g_i is the coupling function of agent i and z the consensus of all agents. Instead of one centralized problem, each agent has
+ * its own MultipleShootingSolver, whose problem only grows with the size of the agent. The consensus is reached with the alternating
+ * direction method of multipliers (ADMM) in its scaled form:
+ *
+ *   1. every agent solves its problem with the consensus term 0.5 * rho * |g_i(x_i) - z + w_i|^2, see ConsensusCost,
+ *   2. the consensus is the average z = mean_i(g_i + w_i),
+ *   3. the scaled multipliers are updated w_i += g_i - z.
+ *
+ * The consensus term is integrated over time, such that every node of the consensus grid has the penalty rho * dt, where dt is the time
+ * step of the grid. The dual residual is computed with this penalty.
+ *
+ * The agents are solved in parallel in step 1, such that the effort of an iteration grows linearly with the number of agents and the
+ * latency stays that of a single agent if there is one thread per agent. The consensus data are exchanged with an agent only through its
+ * ConsensusSynchronizedModule. The consensus and the multipliers of the previous run warm start the next one.
+ */
+class ConsensusAdmm {
+ public:
+  /**
+   * Constructor
+   *
+   * @param [in] settings : The settings of the ADMM.
+   */
+  explicit ConsensusAdmm(consensus_admm::Settings settings);
+
+  /**
+   * Adds an agent. The consensus term is added to the intermediate and final state costs of its problem and its solver is created.
+   *
+   * @param [in] settings : The settings of the solver of the agent.
+   * @param [in] optimalControlProblem : The optimal control problem of the agent.
+   * @param [in] initializer : The initializer of the agent.
+   * @param [in] coupling : The coupling function g(x) of the agent, which has the same size for all agents. It is evaluated without a
+   * precomputation.
+   * @return The index of the agent.
+   */
+  size_t addAgent(multiple_shooting::Settings settings, OptimalControlProblem optimalControlProblem, const Initializer& initializer,
+                  const StateConstraint& coupling);
+
+  /** The number of agents. */
+  size_t getNumAgents() const { return agents_.size(); }
+
+  /** The solver of an agent, e.g. to set its reference manager or to get its solution. */
+  MultipleShootingSolver& getSolver(size_t agentIndex) { return *agents_.at(agentIndex).solverPtr; }
+  const MultipleShootingSolver& getSolver(size_t agentIndex) const { return *agents_.at(agentIndex).solverPtr; }
+
+  /** Resets the solvers of the agents and the consensus. */
+  void reset();
+
+  /**
+   * Runs the ADMM iterations until the consensus is reached or the maximum number of iterations.
+   *
+   * @param [in] initTime : The initial time.
+   * @param [in] initStates : The initial states of the agents.
+   * @param [in] finalTime : The final time.
+   */
+  void run(scalar_t initTime, const vector_array_t& initStates, scalar_t finalTime);
+
+  /** The number of ADMM iterations of the last run. */
+  size_t getNumIterations() const { return numIterations_; }
+
+  /** The primal residual, i.e. the consensus violation, of the last iteration. */
+  scalar_t getPrimalResidual() const { return primalResidual_; }
+
+  /** The dual residual, i.e. the change of the consensus, of the last iteration. */
+  scalar_t getDualResidual() const { return dualResidual_; }
+
+  /** The consensus grid of the last run. */
+  const scalar_array_t& getConsensusTimeTrajectory() const { return timeTrajectory_; }
+
+  /** The consensus z of the last run. */
+  const vector_array_t& getConsensusTrajectory() const { return consensusTrajectory_; }
+
+ private:
+  struct Agent {
+    std::unique_ptr<MultipleShootingSolver> solverPtr;
+    std::shared_ptr<ConsensusSynchronizedModule> modulePtr;
+    vector_array_t couplingTrajectory;
+    vector_array_t scaledMultiplierTrajectory;
+  };
+
+  /** Moves the consensus and the multipliers of the previous run to the consensus grid of the current run. */
+  void shiftConsensus(scalar_array_t timeTrajectory);
+
+  /** Sets the consensus reference of every agent. */
+  void setReferences();
+
+  /** Updates the consensus and the multipliers from the coupling of the agents, and computes the residuals. */
+  void updateConsensus();
+
+  /** The time step of the consensus grid */
+  scalar_t getTimeStep() const { return timeTrajectory_[1] - timeTrajectory_[0]; }
+
+  consensus_admm::Settings settings_;
+  ThreadPool threadPool_;
+  std::vector<Agent> agents_;
+
+  scalar_array_t timeTrajectory_;
+  vector_array_t consensusTrajectory_;  // empty before the first consensus
+
+  size_t numIterations_ = 0;
+  scalar_t primalResidual_ = 0.0;
+  scalar_t dualResidual_ = 0.0;
+};
+
+}  // namespace ocs2
@@ -0,0 +1,67 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <string>
+
+#include <ocs2_core/Types.h>
+
+namespace ocs2 {
+namespace consensus_admm {
+
+struct Settings {
+  // ADMM
+  size_t maxNumIterations = 10;  // Maximum number of ADMM iterations, i.e. solver runs of every agent, per run
+  scalar_t penalty = 1.0;        // The penalty rho per unit time of the augmented Lagrangian of the consensus constraints
+  // Termination condition : the consensus violation (primal residual) and the change of the consensus (dual residual), both summed over
+  // the agents and the consensus grid, are below these values
+  scalar_t primalTolerance = 1e-3;
+  scalar_t dualTolerance = 1e-3;
+
+  // The consensus is imposed on a uniform time grid with this time step [s]
+  scalar_t timeStep = 0.05;
+
+  // Threading: the agents are solved in parallel on this number of threads, including the calling thread
+  size_t nThreads = 1;
+  int threadPriority = 50;
+};
+
+/**
+ * Loads the consensus ADMM settings from a given file.
+ *
+ * @param [in] filename: File name which contains the configuration data.
+ * @param [in] fieldName: Field name which contains the configuration data.
+ * @param [in] verbose: Flag to determine whether to print out the loaded settings or not.
+ * @return The settings
+ */
+Settings loadSettings(const std::string& filename, const std::string& fieldName = "consensus_admm", bool verbose = true);
+
+}  // namespace consensus_admm
+}  // namespace ocs2
@@ -0,0 +1,98 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <memory>
+
+#include <ocs2_core/constraint/StateConstraint.h>
+#include <ocs2_core/cost/StateCost.h>
+
+namespace ocs2 {
+
+/** The consensus data of an agent, see ConsensusAdmm. */
+struct ConsensusReference {
+  scalar_t penalty = 1.0;                // The penalty rho of the consensus constraints
+  scalar_t timeStep = 1.0;               // The time step of the consensus grid
+  scalar_array_t timeTrajectory;         // The consensus grid
+  vector_array_t referenceTrajectory;    // The consensus minus the scaled multipliers of the agent, empty before the first consensus
+};
+
+/**
+ * The augmented Lagrangian term of the consensus constraints g(x(t_k)) = z_k of an agent in the scaled form of ADMM, where g is the
+ * coupling function of the agent and z the consensus of all agents:
+ *
+ *   0.5 * rho * |g(x) - r(t)|^2, with r = z - w, where w are the scaled multipliers of the agent.
+ *
+ * The reference r is linearly interpolated between the nodes of the consensus grid. It is shared by all clones of the term and updated by
+ * ConsensusSynchronizedModule right before the solver runs. The term is not active before the first consensus is available. The Hessian
+ * is the Gauss-Newton approximation rho * dgdx' * dgdx.
+ *
+ * The intermediate term is integrated over time, which weights every interior node of the consensus grid with rho * dt, where dt is the
+ * time step of the grid. The integral only covers half an interval at the last node, so the final term adds the other half with the
+ * penalty rho * 0.5 * dt.
+ */
+class ConsensusCost final : public StateCost {
+ public:
+  /**
+   * Constructor.
+   * @param [in] coupling: The coupling function g(x) of the agent. It is evaluated without a precomputation.
+   * @param [in] referencePtr: The consensus reference of the agent.
+   * @param [in] isFinal: Whether the term is a final cost, whose penalty is scaled by half the time step of the consensus grid.
+   */
+  ConsensusCost(const StateConstraint& coupling, std::shared_ptr<const ConsensusReference> referencePtr, bool isFinal = false);
+
+  ~ConsensusCost() override = default;
+  ConsensusCost* clone() const override { return new ConsensusCost(*this); }
+
+  bool isActive(scalar_t time) const override { return !referencePtr_->referenceTrajectory.empty(); }
+
+  scalar_t getValue(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
+                    const PreComputation& preComp) const override;
+
+  ScalarFunctionQuadraticApproximation getQuadraticApproximation(scalar_t time, const vector_t& state,
+                                                                 const TargetTrajectories& targetTrajectories,
+                                                                 const PreComputation& preComp) const override;
+
+ private:
+  ConsensusCost(const ConsensusCost& other);
+
+  /** The deviation g(x) - r(t) */
+  vector_t getDeviation(scalar_t time, const vector_t& coupling) const;
+
+  /** The penalty of the term, see the class description */
+  scalar_t getPenalty() const { return isFinal_ ? 0.5 * referencePtr_->timeStep * referencePtr_->penalty : referencePtr_->penalty; }
+
+  std::unique_ptr<StateConstraint> couplingPtr_;
+  std::shared_ptr<const ConsensusReference> referencePtr_;
+  bool isFinal_;
+  PreComputation preComputation_;
+};
+
+}  // namespace ocs2
@@ -0,0 +1,89 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+
+#include <ocs2_core/constraint/StateConstraint.h>
+#include <ocs2_oc/synchronized_module/SolverSynchronizedModule.h>
+
+#include "ocs2_sqp/ConsensusCost.h"
+
+namespace ocs2 {
+
+/**
+ * The interface of an agent of ConsensusAdmm to the consensus. The agent receives its consensus reference through setReference(), which
+ * becomes active for the ConsensusCost of the agent right before its solver runs. After the solver has run, the coupling function is
+ * evaluated on the solution at the consensus grid, which is read with getCouplingTrajectory().
+ *
+ * The consensus data are only exchanged through setReference() and getCouplingTrajectory(), which can be called from any thread. The
+ * module can therefore also be fed by a transport to a coordinator in another process.
+ */
+class ConsensusSynchronizedModule final : public SolverSynchronizedModule {
+ public:
+  /**
+   * Constructor.
+   * @param [in] coupling: The coupling function g(x) of the agent. It is evaluated without a precomputation.
+   */
+  explicit ConsensusSynchronizedModule(const StateConstraint& coupling);
+  ~ConsensusSynchronizedModule() override = default;
+
+  /** Creates the consensus term of the agent, which should be added to the intermediate state costs of its optimal control problem. */
+  std::unique_ptr<StateCost> createConsensusCost() const;
+
+  /** Creates the consensus term of the agent, which should be added to the final costs of its optimal control problem. */
+  std::unique_ptr<StateCost> createFinalConsensusCost() const;
+
+  /** Sets the consensus reference for the next solver run. */
+  void setReference(const ConsensusReference& reference);
+
+  /** Gets the coupling function g(x) of the last solution at the consensus grid of its reference. */
+  vector_array_t getCouplingTrajectory() const;
+
+  void preSolverRun(scalar_t initTime, scalar_t finalTime, const vector_t& initState,
+                    const ReferenceManagerInterface& referenceManager) override;
+
+  void postSolverRun(const PrimalSolution& primalSolution) override;
+
+ private:
+  std::unique_ptr<StateConstraint> couplingPtr_;
+  PreComputation preComputation_;
+
+  // The reference read by the consensus terms, which is only written in preSolverRun()
+  std::shared_ptr<ConsensusReference> activeReferencePtr_;
+
+  mutable std::mutex bufferMutex_;
+  ConsensusReference bufferedReference_;
+  bool isBufferUpdated_ = false;
+  vector_array_t couplingTrajectory_;
+};
+
+}  // namespace ocs2
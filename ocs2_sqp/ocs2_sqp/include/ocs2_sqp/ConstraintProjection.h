@@ -59,4 +59,25 @@ VectorFunctionLinearApproximation qrConstraintProjection(const VectorFunctionLin
  */
 VectorFunctionLinearApproximation luConstraintProjection(const VectorFunctionLinearApproximation& constraint);
 
+/**
+ * Same as luConstraintProjection(constraint), writing to the given projection. The storage of the projection and of the decomposition is
+ * reused if the sizes of the constraint do not change.
+ *
+ * @param constraint : C = dfdx, D = dfdu, e = f;
+ * @param [out] projectionTerms : Px = dfdx, Pu = dfdu, Pe = f;
+ */
+void luConstraintProjection(const VectorFunctionLinearApproximation& constraint, VectorFunctionLinearApproximation& projectionTerms);
+
+/**
+ * Same as luConstraintProjection(constraint, projectionTerms), exploiting the constraints which act on a single input, e.g., the zero
+ * contact forces of the swing legs. Such a row d_ij * u_j + C_i * x + e_i = 0 fixes u_j directly, such that the LU decomposition is only
+ * computed for the remaining constraints on the remaining inputs. Without such rows, this is the LU projection. The workspace is kept
+ * per thread and reused if the sizes of the constraint do not change.
+ *
+ * @param constraint : C = dfdx, D = dfdu, e = f;
+ * @param [out] projectionTerms : Px = dfdx, Pu = dfdu, Pe = f;
+ */
+void structuredConstraintProjection(const VectorFunctionLinearApproximation& constraint,
+                                    VectorFunctionLinearApproximation& projectionTerms);
+
 }  // namespace ocs2
\ No newline at end of file
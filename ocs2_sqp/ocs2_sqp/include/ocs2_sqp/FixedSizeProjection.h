@@ -0,0 +1,74 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+
+#pragma once
+
+#include <ocs2_core/Types.h>
+
+namespace ocs2 {
+namespace multiple_shooting {
+
+/**
+ * Eliminates the state-input equality constraints C*dx + D*du + e = 0 of an intermediate node by projection. The projection
+ *  du = Pu * \tilde{du} + Px * dx + Pe
+ * is computed with structuredConstraintProjection(), and the change of input variables is applied in-place to the dynamics and cost.
+ *
+ * @param [in] constraints : Linear approximation of the constraints, C = dfdx, D = dfdu, e = f.
+ * @param [in, out] dynamics : Linear approximation of the discrete dynamics, in terms of \tilde{du} on return.
+ * @param [in, out] cost : Quadratic approximation of the cost, in terms of \tilde{du} on return.
+ * @param [out] projection : Px = dfdx, Pu = dfdu, Pe = f.
+ */
+void projectIntermediateNode(const VectorFunctionLinearApproximation& constraints, VectorFunctionLinearApproximation& dynamics,
+                             ScalarFunctionQuadraticApproximation& cost, VectorFunctionLinearApproximation& projection);
+
+/**
+ * Same as projectIntermediateNode(), for a node with NX states and NU inputs known at compile time. The temporaries have fixed sizes,
+ * or a fixed maximum size for the dimensions that depend on the number of constraints, such that they are allocated on the stack and
+ * Eigen can unroll and vectorize the products of the small matrices. Falls back to the dynamic-size implementation if the dimensions of
+ * the node do not match, e.g., for more constraints than inputs.
+ */
+template <int NX, int NU>
+void projectIntermediateNode(const VectorFunctionLinearApproximation& constraints, VectorFunctionLinearApproximation& dynamics,
+                             ScalarFunctionQuadraticApproximation& cost, VectorFunctionLinearApproximation& projection);
+
+using ProjectionFunction = void (*)(const VectorFunctionLinearApproximation&, VectorFunctionLinearApproximation&,
+                                    ScalarFunctionQuadraticApproximation&, VectorFunctionLinearApproximation&);
+
+/**
+ * Selects the implementation of projectIntermediateNode() for a node of the given dimensions. The fixed-size implementation is used if it
+ * is instantiated for these dimensions in the registry of FixedSizeProjection.cpp, e.g., nx = 12, nu = 4 of the quadrotor or
+ * nx = 24, nu = 24 of the legged robot. Otherwise, the dynamic-size implementation is used.
+ */
+ProjectionFunction selectProjectionFunction(size_t stateDim, size_t inputDim);
+
+}  // namespace multiple_shooting
+}  // namespace ocs2
+
+#include "implementation/FixedSizeProjection.h"
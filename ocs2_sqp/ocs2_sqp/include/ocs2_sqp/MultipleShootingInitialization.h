@@ -30,7 +30,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #pragma once
 
 #include <ocs2_core/Types.h>
+#include <ocs2_core/control/ControllerBase.h>
+#include <ocs2_core/dynamics/SystemDynamicsBase.h>
 #include <ocs2_core/initialization/Initializer.h>
+#include <ocs2_core/integration/SensitivityIntegrator.h>
+#include <ocs2_core/reference/ModeSchedule.h>
 #include <ocs2_oc/oc_data/PrimalSolution.h>
 
 namespace ocs2 {
@@ -62,6 +66,43 @@ inline std::pair<vector_t, vector_t> initializeIntermediateNode(Initializer& ini
  */
 std::pair<vector_t, vector_t> initializeIntermediateNode(PrimalSolution& primalSolution, scalar_t t, scalar_t tNext, const vector_t& x);
 
+/**
+ * Extrapolates a previous solution with its control policy for state-input initialization at a intermediate node
+ *
+ * @param controller : Control policy of the previous solution
+ * @param discretizer : Discretization of the dynamics
+ * @param dynamics : System dynamics
+ * @param t :  Start of the discrete interval
+ * @param tNext : End time of te discrete interval
+ * @param x : Starting state of the discrete interval
+ * @return {u(t), x(tNext)} : input and state transition
+ */
+std::pair<vector_t, vector_t> extrapolateIntermediateNode(ControllerBase& controller, const DynamicsDiscretizer& discretizer,
+                                                          SystemDynamicsBase& dynamics, scalar_t t, scalar_t tNext, const vector_t& x);
+
+/**
+ * Aligns a previous solution, including its controller, with a new mode schedule by trajectory spreading.
+ *
+ * @param newModeSchedule : The mode schedule of the new problem
+ * @param primalSolution : The previous solution to be adjusted
+ */
+void alignWithModeSchedule(const ModeSchedule& newModeSchedule, PrimalSolution& primalSolution);
+
+/**
+ * Shifts the multipliers of a previous QP to a new time discretization, in the same way as the primal warm start: the previous nodes
+ * are aligned with the new mode schedule by trajectory spreading and the multipliers are then linearly interpolated in time. Between
+ * multipliers of different size, e.g. around a mode change, the closest previous node is taken.
+ *
+ * @param oldModeSchedule : Mode schedule of the previous QP
+ * @param newModeSchedule : Mode schedule of the new QP
+ * @param oldTime : Times of the previous multipliers
+ * @param oldMultipliers : Multipliers of the previous QP
+ * @param newTime : Times of the new multipliers
+ * @return The multipliers at newTime
+ */
+vector_array_t shiftMultipliers(const ModeSchedule& oldModeSchedule, const ModeSchedule& newModeSchedule, const scalar_array_t& oldTime,
+                                const vector_array_t& oldMultipliers, const scalar_array_t& newTime);
+
 /**
  * Initialize the state jump at an event node.
  *
@@ -44,11 +44,12 @@ class MultipleShootingMpc final : public MPC_BASE {
    * @param settings : settings for the multiple shooting solver.
    * @param [in] optimalControlProblem: The optimal control problem formulation.
    * @param [in] initializer: This class initializes the state-input for the time steps that no controller is available.
+   * @param [in] threadPoolPtr: A thread pool which is shared with other clients. If nullptr, the solver creates its own pool.
    */
   MultipleShootingMpc(mpc::Settings mpcSettings, multiple_shooting::Settings settings, const OptimalControlProblem& optimalControlProblem,
-                      const Initializer& initializer)
+                      const Initializer& initializer, std::shared_ptr<ThreadPool> threadPoolPtr = nullptr)
       : MPC_BASE(std::move(mpcSettings)) {
-    solverPtr_.reset(new MultipleShootingSolver(std::move(settings), optimalControlProblem, initializer));
+    solverPtr_.reset(new MultipleShootingSolver(std::move(settings), optimalControlProblem, initializer, std::move(threadPoolPtr)));
   };
 
   ~MultipleShootingMpc() override = default;
@@ -56,6 +57,14 @@ class MultipleShootingMpc final : public MPC_BASE {
   MultipleShootingSolver* getSolverPtr() override { return solverPtr_.get(); }
   const MultipleShootingSolver* getSolverPtr() const override { return solverPtr_.get(); }
 
+  /**
+   * Preparation phase of the real-time iteration for the next run at nextTime. Call this after the policy of the current run is used, such
+   * that the next run(nextTime, state) only solves one QP. Does nothing if the real-time iteration is not enabled in the settings.
+   *
+   * @param [in] nextTime: The time of the next run.
+   */
+  void prepare(scalar_t nextTime) override { solverPtr_->prepareRealTimeIteration(nextTime, nextTime + getTimeHorizon()); }
+
  protected:
   void calculateController(scalar_t initTime, const vector_t& initState, scalar_t finalTime) override {
     if (settings().coldStart_) {
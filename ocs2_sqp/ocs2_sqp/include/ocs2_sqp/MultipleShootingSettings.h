@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <vector>
+
 #include <ocs2_core/Types.h>
 #include <ocs2_core/integration/SensitivityIntegrator.h>
 
@@ -43,9 +45,20 @@ struct Settings {
   scalar_t deltaTol = 1e-6;  // Termination condition : RMS update of x(t) and u(t) are both below this value
   scalar_t costTol = 1e-4;   // Termination condition : (cost{i+1} - (cost{i}) < costTol AND constraints{i+1} < g_min
 
+  // Exact Hessian: the curvature of the dynamics, weighted with the costates of the previous QP, is added to the Hessian of the cost. The
+  // dynamics have to implement flowMapWeightedHessian(), e.g. SystemDynamicsBaseAD initialized with createFlowMapHessian. The curvature
+  // of soft constraints is included by creating them with ConstraintOrder::Quadratic. The state-input Hessian of every node is then
+  // regularized to have eigenvalues of at least exactHessianMinEigenvalue.
+  bool exactHessian = false;
+  scalar_t exactHessianMinEigenvalue = 1e-6;
+
+  // Real-time iteration: a single full SQP step per run, split into a preparation and a feedback phase. See prepareRealTimeIteration().
+  bool realTimeIteration = false;
+
   // Linesearch - step size rules
   scalar_t alpha_decay = 0.5;  // multiply the step size by this factor every time a linesearch step is rejected.
   scalar_t alpha_min = 1e-4;   // terminate linesearch if the attempted step size is below this threshold
+  size_t numLinesearchTrials = 1;  // number of step sizes that are evaluated in parallel, the largest accepted one is taken
 
   // Linesearch - step acceptance criteria with c = costs, g = the norm of constraint violation, and w = [x; u]
   scalar_t g_max = 1e6;          // (1): IF g{i+1} > g_max REQUIRE g{i+1} < (1-gamma_c) * g{i}
@@ -53,21 +66,46 @@ struct Settings {
   scalar_t armijoFactor = 1e-4;  // Armijo condition: c{i+1} < c{i} + armijoFactor * dc/dw'{i} * delta_w
   scalar_t gamma_c = 1e-6;       // (3): ELSE REQUIRE c{i+1} < (c{i} - gamma_c * g{i}) OR g{i+1} < (1-gamma_c) * g{i}
 
+  // Warm start: the previous solution is aligned with the current mode schedule by trajectory spreading. Beyond its end, the initializer
+  // is used, or, if this flag is set, the last policy of the previous solution with a rollout of the discretized dynamics.
+  bool extrapolateWithPolicy = false;
+
   // controller type
   bool useFeedbackPolicy = true;     // true to use feedback, false to use feedforward
   bool createValueFunction = false;  // true to store the value function, false to ignore it
+  // The feedback gains are only extracted for the nodes in this time horizon [s] from the initial time, such as the part of the policy
+  // which is used by the MRT until the next MPC update. The policy is feedforward beyond. Any negative number means the whole horizon.
+  scalar_t feedbackPolicyHorizon = -1.0;
 
   // QP subproblem solver settings
   hpipm_interface::Settings hpipmSettings = hpipm_interface::Settings();
+  // If > 0, QPs without constraints, e.g. when using projection, are solved with a Riccati recursion which is parallelized over this
+  // number of partitions of the horizon, instead of with HPIPM. See PartitionedRiccatiSolver.
+  size_t numRiccatiPartitions = 0;
 
   // Discretization method
   scalar_t dt = 0.01;  // user-defined time discretization
+  // Reuse the nodes of the previous solution and let the step grow linearly from dt to dtFinal, see shiftTimeDiscretizationWithEvents()
+  bool shiftTimeDiscretization = false;
+  scalar_t dtFinal = 0.0;  // step at the end of the horizon, a constant step dt is used for values below dt
   SensitivityIntegratorType integratorType = SensitivityIntegratorType::RK2;
+  // Move blocking: the input of the k-th shooting interval is held constant over inputBlocking[k] steps of dt, and the last entry applies
+  // to the remaining intervals, e.g. [1, 1, 1, 1, 2, 2, 4] for a fine input resolution only at the start of the horizon. The dynamics of
+  // an interval are integrated with steps of dt and the cost with a single step. Empty for no blocking. Not used with
+  // shiftTimeDiscretization.
+  std::vector<size_t> inputBlocking;
 
   // Inequality penalty relaxed barrier parameters
   scalar_t inequalityConstraintMu = 0.0;
   scalar_t inequalityConstraintDelta = 1e-6;
   bool projectStateInputEqualityConstraints = true;  // Use a projection method to resolve the state-input constraint Cx+Du+e
+  // Without projection, the state-input equality constraints are passed to HPIPM. If true, they are declared as equalities of HPIPM
+  // (nge, idxe), otherwise or with partial condensing they are general inequalities with equal lower and upper bounds.
+  bool hpipmEqualityConstraints = false;
+
+  // Evaluate the activity of the cost and constraint terms once per interval of the mode schedule. Only valid if the activity of the
+  // terms changes only at the event times.
+  bool cacheTermActivity = false;
 
   // Printing
   bool printSolverStatus = false;      // Print HPIPM status after solving the QP subproblem
@@ -77,6 +115,8 @@ struct Settings {
   // Threading
   size_t nThreads = 4;
   int threadPriority = 50;
+  size_t threadSpinDuration = 0;    // [us] time an idle worker busy-waits for new tasks before it sleeps, zero to sleep immediately
+  std::vector<int> threadAffinity;  // CPUs the worker threads are pinned to, one CPU per worker. Empty to run on any CPU
 };
 
 /**
@@ -29,12 +29,15 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <mutex>
+
 #include <ocs2_core/initialization/Initializer.h>
 #include <ocs2_core/integration/SensitivityIntegrator.h>
 #include <ocs2_core/misc/Benchmark.h>
 #include <ocs2_core/thread_support/ThreadPool.h>
 
 #include <ocs2_oc/oc_problem/OptimalControlProblem.h>
+#include <ocs2_oc/oc_solver/PartitionedRiccatiSolver.h>
 #include <ocs2_oc/oc_solver/SolverBase.h>
 
 #include <hpipm_catkin/HpipmInterface.h>
@@ -55,8 +58,11 @@ class MultipleShootingSolver : public SolverBase {
    * @param settings : settings for the multiple shooting solver.
    * @param [in] optimalControlProblem: The optimal control problem formulation.
    * @param [in] initializer: This class initializes the state-input for the time steps that no controller is available.
+   * @param [in] threadPoolPtr: A thread pool which is shared with other clients. The solver uses at most settings.nThreads of its
+   *                            threads. If nullptr, the solver creates its own pool with settings.nThreads - 1 workers.
    */
-  MultipleShootingSolver(Settings settings, const OptimalControlProblem& optimalControlProblem, const Initializer& initializer);
+  MultipleShootingSolver(Settings settings, const OptimalControlProblem& optimalControlProblem, const Initializer& initializer,
+                         std::shared_ptr<ThreadPool> threadPoolPtr = nullptr);
 
   ~MultipleShootingSolver() override;
 
@@ -66,13 +72,14 @@ class MultipleShootingSolver : public SolverBase {
 
   void getPrimalSolution(scalar_t finalTime, PrimalSolution* primalSolutionPtr) const override { *primalSolutionPtr = primalSolution_; }
 
-  const DualSolution& getDualSolution() const override {
-    throw std::runtime_error("[MultipleShootingSolver] getDualSolution() not available yet.");
-  }
+  /**
+   * The dual solution of the last QP at the time discretization of the primal solution. The multipliers of the state-input equality
+   * constraints are only available if the constraints are not projected, they are stored as a single stateInputEq term.
+   */
+  const DualSolution& getDualSolution() const override { return dualSolution_; }
 
-  const ProblemMetrics& getSolutionMetrics() const override {
-    throw std::runtime_error("[MultipleShootingSolver] getSolutionMetrics() not available yet.");
-  }
+  /** The cost and constraint values at the nodes of the primal solution, as evaluated during the last iteration */
+  const ProblemMetrics& getSolutionMetrics() const override;
 
   size_t getNumIterations() const override { return totalNumIterations_; }
 
@@ -93,9 +100,29 @@ class MultipleShootingSolver : public SolverBase {
   }
 
   MultiplierCollection getIntermediateDualSolution(scalar_t time) const override {
-    throw std::runtime_error("[MultipleShootingSolver] getIntermediateDualSolution() not available yet.");
+    if (dualSolution_.timeTrajectory.empty()) {
+      throw std::runtime_error("[MultipleShootingSolver] Dual solution is empty! Did the solver run?");
+    }
+    return getIntermediateDualSolutionAtTime(dualSolution_, time);
+  }
+
+  void setTracer(std::shared_ptr<benchmark::Tracer> tracerPtr) override {
+    profiler_.setTracer(tracerPtr);
+    SolverBase::setTracer(std::move(tracerPtr));
   }
 
+  const benchmark::Profiler* getProfiler() const override { return &profiler_; }
+
+  /**
+   * Preparation phase of the real-time iteration, see Settings::realTimeIteration. Sets up the QP around the previous solution shifted to
+   * the horizon [initTime, finalTime], before the state at initTime is known. The next run() on the same time discretization then only
+   * solves this QP for the given initial state. Does nothing if there is no previous solution, run() then prepares the QP itself.
+   *
+   * @param [in] initTime: The initial time of the next run.
+   * @param [in] finalTime: The final time of the next run.
+   */
+  void prepareRealTimeIteration(scalar_t initTime, scalar_t finalTime);
+
  private:
   void runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime) override;
 
@@ -117,8 +144,20 @@ class MultipleShootingSolver : public SolverBase {
     runImpl(initTime, initState, finalTime);
   }
 
-  /** Run a task in parallel with settings.nThreads */
-  void runParallel(std::function<void(int)> taskFunction);
+  /** Feedback phase of the real-time iteration: solves the prepared QP for the given initial state and takes the full step */
+  void runRealTimeIteration(scalar_t initTime, const vector_t& initState, scalar_t finalTime);
+
+  /** Sets up the QP of the real-time iteration around the initialized state-input trajectories */
+  void setupRealTimeIteration(std::vector<AnnotatedTime> timeDiscretization, const vector_t& initState);
+
+  /** Time discretization of the horizon [initTime, finalTime], taking into account the event times and the previous solution */
+  std::vector<AnnotatedTime> getTimeDiscretization(scalar_t initTime, scalar_t finalTime) const;
+
+  /** Samples the target trajectories at the evaluation times of the nodes and sets the samples in the OCP definitions */
+  void initializeReferences(const std::vector<AnnotatedTime>& timeDiscretization);
+
+  /** Run taskFunction(workerId, i) for i in [0, N) in parallel with settings.nThreads, workerId is in [0, settings.nThreads - 1] */
+  void parallelFor(int N, std::function<void(int, int)> taskFunction);
 
   /** Get profiling information as a string */
   std::string getBenchmarkingInformation() const;
@@ -131,9 +170,13 @@ class MultipleShootingSolver : public SolverBase {
   PerformanceIndex setupQuadraticSubproblem(const std::vector<AnnotatedTime>& time, const vector_t& initState, const vector_array_t& x,
                                             const vector_array_t& u);
 
-  /** Computes only the performance metrics at the current {t, x(t), u(t)} */
-  PerformanceIndex computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState, const vector_array_t& x,
-                                      const vector_array_t& u);
+  /**
+   * Computes only the performance metrics at several trajectories {t, x[j](t), u[j](t)}, all nodes of all trajectories in parallel.
+   * If metricsPtr is not nullptr, (*metricsPtr)[j][i] is set to the metrics of node i of trajectory j.
+   */
+  std::vector<PerformanceIndex> computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState,
+                                                   const std::vector<vector_array_t>& x, const std::vector<vector_array_t>& u,
+                                                   std::vector<std::vector<MetricsCollection>>* metricsPtr = nullptr);
 
   /** Returns solution of the QP subproblem in delta coordinates: */
   struct OcpSubproblemSolution {
@@ -141,20 +184,47 @@ class MultipleShootingSolver : public SolverBase {
     vector_array_t deltaUSol;      // delta_u(t)
     scalar_t armijoDescentMetric;  // inner product of the cost gradient and decision variable step
   };
-  OcpSubproblemSolution getOCPSolution(const vector_t& delta_x0);
+  OcpSubproblemSolution getOCPSolution(const std::vector<AnnotatedTime>& time, const vector_t& delta_x0);
+
+  /** Whether the QP subproblem is unconstrained and is solved with the partitioned Riccati solver instead of HPIPM */
+  bool usePartitionedRiccati() const;
+
+  /** Sets the initial guess of the QP solver from the dual solution of the previous QP, shifted to the given time discretization */
+  void setQpInitialGuess(const std::vector<AnnotatedTime>& time);
 
-  /** Extract the value function based on the last solved QP */
-  void extractValueFunction(const std::vector<AnnotatedTime>& time, const vector_array_t& x);
+  /** Stores the dual solution of the last solved QP at the given time discretization */
+  void storeQpDualSolution(const std::vector<AnnotatedTime>& time, const vector_array_t& deltaXSol);
+
+  /** Costate of the dynamics of the previous QP at the first node at or after the given time. Empty if not available or of another size */
+  vector_t getPreviousCostate(scalar_t time, size_t stateDim) const;
+
+  /** Extract the feedback gains and the value function of the last solved QP in a single pass, x is the linearization state of the QP */
+  void extractRiccatiSolution(const std::vector<AnnotatedTime>& time, const vector_array_t& x);
+
+  /** Number of stages for which the feedback gains are extracted, see MultipleShootingSettings::feedbackPolicyHorizon */
+  int getNumFeedbackStages(const std::vector<AnnotatedTime>& time) const;
 
   /** Set up the primal solution based on the optimized state and input trajectories */
   void setPrimalSolution(const std::vector<AnnotatedTime>& time, vector_array_t&& x, vector_array_t&& u);
 
+  /** Set up the dual solution from the last QP, after the primal solution is set */
+  void setDualSolution(const std::vector<AnnotatedTime>& time);
+
   /** Compute 2-norm of the trajectory: sqrt(sum_i v[i]^2)  */
   static scalar_t trajectoryNorm(const vector_array_t& v);
 
   /** Compute total constraint violation */
   scalar_t totalConstraintViolation(const PerformanceIndex& performance) const;
 
+  /**
+   * Performance after the full step of a linear-quadratic problem. Its QP is exact, hence the cost is given by the quadratic model of
+   * the QP and the dynamics are satisfied, such that the problem does not have to be evaluated again.
+   */
+  PerformanceIndex getLinearQuadraticPerformance(const PerformanceIndex& baseline, const OcpSubproblemSolution& subproblemSolution) const;
+
+  /** Takes the full step of the QP solution: {x(t), u(t)} <- {x(t) + dx(t), u(t) + du(t)} */
+  static void applyFullStep(const OcpSubproblemSolution& subproblemSolution, vector_array_t& x, vector_array_t& u);
+
   /** Decides on the step to take and overrides given trajectories {x(t), u(t)} <- {x(t) + a*dx(t), u(t) + a*du(t)} */
   multiple_shooting::StepInfo takeStep(const PerformanceIndex& baseline, const std::vector<AnnotatedTime>& timeDiscretization,
                                        const vector_t& initState, const OcpSubproblemSolution& subproblemSolution, vector_array_t& x,
@@ -172,22 +242,60 @@ class MultipleShootingSolver : public SolverBase {
   std::unique_ptr<Initializer> initializerPtr_;
 
   // Threading
-  ThreadPool threadPool_;
+  std::shared_ptr<ThreadPool> threadPoolPtr_;
+
+  // Evaluation times of the nodes at which the target trajectories are sampled, and the sampled copy read by the OCP definitions
+  scalar_array_t referenceSampleTimes_;
+  TargetTrajectories sampledTargetTrajectories_;
 
   // Solution
   PrimalSolution primalSolution_;
+  DualSolution dualSolution_;
+  mutable std::mutex problemMetricsMutex_;
+  mutable ProblemMetrics problemMetrics_;  // computed on demand from the solution at the nodes of its time discretization
+  std::vector<AnnotatedTime> solutionTimeDiscretization_;
 
   // Value function in absolute state coordinates (without the constant value)
   std::vector<ScalarFunctionQuadraticApproximation> valueFunction_;
+  vector_array_t valueFunctionLinearizationState_;  // linearization state of the last QP of the SQP iterations
+
+  // Riccati feedback of the last QP in the QP coordinates, empty beyond the feedback horizon
+  matrix_array_t riccatiFeedback_;
 
-  // Solver interface
+  // Solver interfaces
   HpipmInterface hpipmInterface_;
+  PartitionedRiccatiSolver partitionedRiccatiSolver_;
 
   // LQ approximation
   std::vector<VectorFunctionLinearApproximation> dynamics_;
   std::vector<ScalarFunctionQuadraticApproximation> cost_;
   std::vector<VectorFunctionLinearApproximation> constraints_;
   std::vector<VectorFunctionLinearApproximation> constraintsProjection_;
+  std::vector<hpipm_interface::BoxConstraints> boxConstraints_;  // only filled if there are box constraints
+  bool hasBoxConstraints_ = false;
+  std::vector<VectorFunctionLinearApproximation> inequalityConstraints_;  // only filled if there are inequality constraints
+  bool hasInequalityConstraints_ = false;
+  // The QP of a linear-quadratic problem is exact, it is solved by a single full step without linesearch. See isLinearQuadratic().
+  bool isLinearQuadratic_ = false;
+
+  // Dual solution of the previous QP at its node times, to warm start the QP solver and for the exact Hessian
+  struct QpDualSolution {
+    scalar_array_t time;
+    ModeSchedule modeSchedule;
+    vector_array_t costateTrajectory;
+    vector_array_t constraintMultipliers;
+  };
+  QpDualSolution qpDualSolution_;
+
+  // Real-time iteration: the QP set up by the preparation phase is stored in the LQ approximation above
+  struct RealTimeIterationPreparation {
+    bool isPrepared = false;
+    std::vector<AnnotatedTime> timeDiscretization;
+    vector_array_t x;
+    vector_array_t u;
+    PerformanceIndex performance;
+  };
+  RealTimeIterationPreparation realTimeIteration_;
 
   // Iteration performance log
   std::vector<PerformanceIndex> performanceIndeces_;
@@ -195,11 +303,7 @@ class MultipleShootingSolver : public SolverBase {
   // Benchmarking
   size_t numProblems_{0};
   size_t totalNumIterations_{0};
-  benchmark::RepeatedTimer initializationTimer_;
-  benchmark::RepeatedTimer linearQuadraticApproximationTimer_;
-  benchmark::RepeatedTimer solveQpTimer_;
-  benchmark::RepeatedTimer linesearchTimer_;
-  benchmark::RepeatedTimer computeControllerTimer_;
+  benchmark::Profiler profiler_;
 };
 
 }  // namespace ocs2
@@ -31,6 +31,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/Types.h>
 #include <ocs2_core/integration/SensitivityIntegrator.h>
+#include <ocs2_core/model_data/Metrics.h>
 #include <ocs2_oc/oc_data/PerformanceIndex.h>
 #include <ocs2_oc/oc_problem/OptimalControlProblem.h>
 
@@ -38,14 +39,18 @@ namespace ocs2 {
 namespace multiple_shooting {
 
 /**
- * Results of the transcription at an intermediate node
+ * Results of the transcription at an intermediate node. The metrics hold the cost and the equality constraints evaluated at the start of
+ * the interval, where the cost is not scaled with the interval duration. The inequality constraints are expressed in the projected inputs
+ * if the equality constraints are projected.
  */
 struct Transcription {
   PerformanceIndex performance;
+  MetricsCollection metrics;
   VectorFunctionLinearApproximation dynamics;
   ScalarFunctionQuadraticApproximation cost;
   VectorFunctionLinearApproximation constraints;
   VectorFunctionLinearApproximation constraintsProjection;
+  VectorFunctionLinearApproximation inequalityConstraints;
 };
 
 /**
@@ -59,24 +64,32 @@ struct Transcription {
  * @param x : State at start of the interval
  * @param x_next : State at the end of the interval
  * @param u : Input, taken to be constant across the interval.
+ * @param costate : Multiplier of the dynamics of this interval. If not empty, the curvature of the dynamics weighted with the costate
+ *                  is added to the cost Hessian, i.e. the Hessian of the Lagrangian is used instead of the Hessian of the cost.
+ * @param minHessianEigenvalue : Minimum eigenvalue of the state-input Hessian of the cost, if the curvature of the dynamics is added.
  * @return multiple shooting transcription for this node.
  */
 Transcription setupIntermediateNode(const OptimalControlProblem& optimalControlProblem,
                                     DynamicsSensitivityDiscretizer& sensitivityDiscretizer, bool projectStateInputEqualityConstraints,
-                                    scalar_t t, scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u);
+                                    scalar_t t, scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u,
+                                    const vector_t& costate = vector_t(), scalar_t minHessianEigenvalue = 0.0);
 
 /**
  * Compute only the performance index for a single intermediate node.
  * Corresponds to the performance index returned by "setupIntermediateNode"
+ *
+ * @param metricsPtr : If not nullptr, the metrics of the node are written to it, corresponding to the metrics of "setupIntermediateNode".
  */
 PerformanceIndex computeIntermediatePerformance(const OptimalControlProblem& optimalControlProblem, DynamicsDiscretizer& discretizer,
-                                                scalar_t t, scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u);
+                                                scalar_t t, scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u,
+                                                MetricsCollection* metricsPtr = nullptr);
 
 /**
  * Results of the transcription at a terminal node
  */
 struct TerminalTranscription {
   PerformanceIndex performance;
+  MetricsCollection metrics;
   ScalarFunctionQuadraticApproximation cost;
   VectorFunctionLinearApproximation constraints;
 };
@@ -94,14 +107,18 @@ TerminalTranscription setupTerminalNode(const OptimalControlProblem& optimalCont
 /**
  * Compute only the performance index for the terminal node.
  * Corresponds to the performance index returned by "setTerminalNode"
+ *
+ * @param metricsPtr : If not nullptr, the metrics of the node are written to it, corresponding to the metrics of "setupTerminalNode".
  */
-PerformanceIndex computeTerminalPerformance(const OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x);
+PerformanceIndex computeTerminalPerformance(const OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x,
+                                            MetricsCollection* metricsPtr = nullptr);
 
 /**
  * Results of the transcription at an event
  */
 struct EventTranscription {
   PerformanceIndex performance;
+  MetricsCollection metrics;
   VectorFunctionLinearApproximation dynamics;
   ScalarFunctionQuadraticApproximation cost;
   VectorFunctionLinearApproximation constraints;
@@ -122,9 +139,11 @@ EventTranscription setupEventNode(const OptimalControlProblem& optimalControlPro
 /**
  * Compute only the performance index for the event node.
  * Corresponds to the performance index returned by "setupEventNode"
+ *
+ * @param metricsPtr : If not nullptr, the metrics of the node are written to it, corresponding to the metrics of "setupEventNode".
  */
 PerformanceIndex computeEventPerformance(const OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x,
-                                         const vector_t& x_next);
+                                         const vector_t& x_next, MetricsCollection* metricsPtr = nullptr);
 
 }  // namespace multiple_shooting
 }  // namespace ocs2
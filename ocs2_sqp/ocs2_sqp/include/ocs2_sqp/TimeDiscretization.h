@@ -76,4 +76,43 @@ std::vector<AnnotatedTime> timeDiscretizationWithEvents(scalar_t initTime, scala
                                                         const scalar_array_t& eventTimes,
                                                         scalar_t dt_min = 10.0 * numeric_traits::limitEpsilon<scalar_t>());
 
+/**
+ * Decides on a time discretization with move blocking: the k-th interval spans inputBlocking[k] steps of dt, such that the input is held
+ * constant over these steps, and the last entry applies to all remaining intervals. Event times are part of the discretization as in
+ * timeDiscretizationWithEvents(), where an event shortens the interval in which it occurs.
+ *
+ * @param initTime : start time.
+ * @param finalTime : final time.
+ * @param dt : discretization step of the dynamics.
+ * @param inputBlocking : number of steps dt of each interval, all entries should be positive.
+ * @param eventTimes : Event times where a time discretization must be made.
+ * @param dt_min : minimum discretization step. Smaller intervals will be merged. Needs to be bigger than limitEpsilon to avoid
+ * interpolation problems
+ * @return vector of discrete time points
+ */
+std::vector<AnnotatedTime> blockedTimeDiscretizationWithEvents(scalar_t initTime, scalar_t finalTime, scalar_t dt,
+                                                               const std::vector<size_t>& inputBlocking, const scalar_array_t& eventTimes,
+                                                               scalar_t dt_min = 10.0 * numeric_traits::limitEpsilon<scalar_t>());
+
+/**
+ * Decides on a non-uniform time discretization along the horizon that reuses the nodes of a previous discretization, e.g. the one of
+ * the last MPC iteration, such that solutions stored per node remain valid when the horizon shifts. The desired step grows linearly from
+ * dt at the start to dtFinal at the end of the horizon. A previous node is reused if it lies between 0.5 and 1.5 desired steps after the
+ * last node, previous nodes closer than half of the desired step are dropped, and new nodes are inserted where the previous ones are too
+ * far apart. Event times are part of the discretization as in timeDiscretizationWithEvents().
+ *
+ * @param initTime : start time.
+ * @param finalTime : final time.
+ * @param dt : desired discretization step at the start of the horizon.
+ * @param dtFinal : desired discretization step at the end of the horizon. Values below dt result in a constant step of dt.
+ * @param eventTimes : Event times where a time discretization must be made.
+ * @param previousTimes : Sorted times of the previous discretization, can be empty.
+ * @param dt_min : minimum discretization step. Smaller intervals will be merged. Needs to be bigger than limitEpsilon to avoid
+ * interpolation problems
+ * @return vector of discrete time points
+ */
+std::vector<AnnotatedTime> shiftTimeDiscretizationWithEvents(scalar_t initTime, scalar_t finalTime, scalar_t dt, scalar_t dtFinal,
+                                                             const scalar_array_t& eventTimes, const scalar_array_t& previousTimes,
+                                                             scalar_t dt_min = 10.0 * numeric_traits::limitEpsilon<scalar_t>());
+
 }  // namespace ocs2
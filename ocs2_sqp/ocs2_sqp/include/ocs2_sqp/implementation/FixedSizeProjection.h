@@ -0,0 +1,117 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+
+#include <Eigen/LU>
+
+namespace ocs2 {
+namespace multiple_shooting {
+
+template <int NX, int NU>
+void projectIntermediateNode(const VectorFunctionLinearApproximation& constraints, VectorFunctionLinearApproximation& dynamics,
+                             ScalarFunctionQuadraticApproximation& cost, VectorFunctionLinearApproximation& projection) {
+  // Fixed sizes, and fixed maximum sizes for the dimensions that depend on the number of constraints nc <= NU
+  using state_vector_type = Eigen::Matrix<scalar_t, NX, 1>;
+  using state_matrix_type = Eigen::Matrix<scalar_t, NX, NX>;
+  using input_vector_type = Eigen::Matrix<scalar_t, NU, 1>;
+  using input_matrix_type = Eigen::Matrix<scalar_t, NU, NU>;
+  using input_state_matrix_type = Eigen::Matrix<scalar_t, NU, NX>;
+  using state_input_matrix_type = Eigen::Matrix<scalar_t, NX, NU>;
+  using constraint_input_matrix_type = Eigen::Matrix<scalar_t, Eigen::Dynamic, NU, 0, NU, NU>;
+  using projected_input_vector_type = Eigen::Matrix<scalar_t, Eigen::Dynamic, 1, 0, NU, 1>;
+  using input_projected_input_matrix_type = Eigen::Matrix<scalar_t, NU, Eigen::Dynamic, 0, NU, NU>;
+  using projected_input_matrix_type = Eigen::Matrix<scalar_t, Eigen::Dynamic, Eigen::Dynamic, 0, NU, NU>;
+  using projected_input_state_matrix_type = Eigen::Matrix<scalar_t, Eigen::Dynamic, NX, 0, NU, NX>;
+  using state_projected_input_matrix_type = Eigen::Matrix<scalar_t, NX, Eigen::Dynamic, 0, NX, NU>;
+
+  const bool isFixedSize = constraints.f.rows() <= NU && constraints.dfdx.cols() == NX && constraints.dfdu.cols() == NU &&
+                           dynamics.dfdx.rows() == NX && dynamics.dfdu.cols() == NU && cost.dfdux.rows() == NU && cost.dfduu.rows() == NU;
+  if (!isFixedSize) {
+    projectIntermediateNode(constraints, dynamics, cost, projection);
+    return;
+  }
+
+  // Projection: du = Pu * \tilde{du} + Px * dx + Pe
+  const Eigen::FullPivLU<constraint_input_matrix_type> lu(constraints.dfdu);
+  const input_projected_input_matrix_type Pu = lu.kernel();
+  const input_state_matrix_type Px = -lu.solve(constraints.dfdx);
+  const input_vector_type Pe = -lu.solve(constraints.f);
+
+  // Dynamics: A = A + B*Px, b = b + B*Pe, B = B*Pu
+  {
+    Eigen::Map<state_matrix_type> A(dynamics.dfdx.data());
+    Eigen::Map<state_vector_type> b(dynamics.f.data());
+    const Eigen::Map<const state_input_matrix_type> B(dynamics.dfdu.data());
+    A.noalias() += B * Px;
+    b.noalias() += B * Pe;
+    const state_projected_input_matrix_type BPu = B * Pu;
+    dynamics.dfdu = BPu;
+  }
+
+  // Cost, with the notation dfdxx = Q, dfdux = P, dfduu = R, dfdx = q, dfdu = r, f = c. See changeOfInputVariables().
+  {
+    Eigen::Map<state_matrix_type> Q(cost.dfdxx.data());
+    Eigen::Map<state_vector_type> q(cost.dfdx.data());
+    const Eigen::Map<const input_state_matrix_type> P(cost.dfdux.data());
+    const Eigen::Map<const input_matrix_type> R(cost.dfduu.data());
+    const Eigen::Map<const input_vector_type> r(cost.dfdu.data());
+
+    input_state_matrix_type P_plus_R_Px = P;
+    P_plus_R_Px.noalias() += R * Px;
+    input_vector_type r_plus_R_u0 = r;
+    r_plus_R_u0.noalias() += R * Pe;
+
+    // Q = Q + P'*Px + Px'*(P + R*Px)
+    Q.noalias() += P.transpose() * Px;
+    Q.noalias() += Px.transpose() * P_plus_R_Px;
+
+    // q = q + P'*Pe + Px'*(R*Pe + r)
+    q.noalias() += P.transpose() * Pe;
+    q.noalias() += Px.transpose() * r_plus_R_u0;
+
+    // c = c + 1/2*Pe'*((R*Pe + r) + r)
+    cost.f += 0.5 * Pe.dot(r_plus_R_u0 + r);
+
+    // P = Pu'*(P + R*Px), R = Pu'*R*Pu, r = Pu'*(R*Pe + r). The input dimension changes, so the results are assigned at the end.
+    const projected_input_state_matrix_type projectedP = Pu.transpose() * P_plus_R_Px;
+    const input_projected_input_matrix_type R_Pu = R * Pu;
+    const projected_input_matrix_type projectedR = Pu.transpose() * R_Pu;
+    const projected_input_vector_type projectedr = Pu.transpose() * r_plus_R_u0;
+    cost.dfdux = projectedP;
+    cost.dfduu = projectedR;
+    cost.dfdu = projectedr;
+  }
+
+  projection.dfdx = Px;
+  projection.dfdu = Pu;
+  projection.f = Pe;
+}
+
+}  // namespace multiple_shooting
+}  // namespace ocs2
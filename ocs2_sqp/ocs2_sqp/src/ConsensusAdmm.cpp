@@ -0,0 +1,195 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_sqp/ConsensusAdmm.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <ocs2_core/misc/LinearInterpolation.h>
+
+namespace ocs2 {
+
+ConsensusAdmm::ConsensusAdmm(consensus_admm::Settings settings)
+    : settings_(std::move(settings)), threadPool_(std::max(settings_.nThreads, size_t(1)) - 1, settings_.threadPriority) {
+  if (settings_.timeStep <= 0.0) {
+    throw std::runtime_error("[ConsensusAdmm] The time step of the consensus grid should be positive!");
+  }
+}
+
+size_t ConsensusAdmm::addAgent(multiple_shooting::Settings settings, OptimalControlProblem optimalControlProblem,
+                               const Initializer& initializer, const StateConstraint& coupling) {
+  Agent agent;
+  agent.modulePtr = std::make_shared<ConsensusSynchronizedModule>(coupling);
+  optimalControlProblem.stateCostPtr->add("consensus", agent.modulePtr->createConsensusCost());
+  optimalControlProblem.finalCostPtr->add("consensus", agent.modulePtr->createFinalConsensusCost());
+  agent.solverPtr.reset(new MultipleShootingSolver(std::move(settings), optimalControlProblem, initializer));
+  agent.solverPtr->addSynchronizedModule(agent.modulePtr);
+  agents_.push_back(std::move(agent));
+  return agents_.size() - 1;
+}
+
+void ConsensusAdmm::reset() {
+  for (auto& agent : agents_) {
+    agent.solverPtr->reset();
+    agent.couplingTrajectory.clear();
+    agent.scaledMultiplierTrajectory.clear();
+  }
+  timeTrajectory_.clear();
+  consensusTrajectory_.clear();
+  numIterations_ = 0;
+  primalResidual_ = 0.0;
+  dualResidual_ = 0.0;
+}
+
+void ConsensusAdmm::run(scalar_t initTime, const vector_array_t& initStates, scalar_t finalTime) {
+  if (agents_.empty()) {
+    throw std::runtime_error("[ConsensusAdmm::run] No agents are added!");
+  }
+  if (initStates.size() != agents_.size()) {
+    throw std::runtime_error("[ConsensusAdmm::run] Expected " + std::to_string(agents_.size()) + " initial states, but got " +
+                             std::to_string(initStates.size()) + "!");
+  }
+
+  // uniform consensus grid with a step close to the time step of the settings
+  const auto numIntervals = std::max(static_cast<int>(std::round((finalTime - initTime) / settings_.timeStep)), 1);
+  scalar_array_t timeTrajectory(numIntervals + 1);
+  for (int k = 0; k < numIntervals; k++) {
+    timeTrajectory[k] = initTime + k * (finalTime - initTime) / numIntervals;
+  }
+  timeTrajectory.back() = finalTime;
+  shiftConsensus(std::move(timeTrajectory));
+
+  const auto numAgents = static_cast<int>(agents_.size());
+  auto solveTask = [&](int /*workerIndex*/, int i) { agents_[i].solverPtr->run(initTime, initStates[i], finalTime); };
+
+  numIterations_ = 0;
+  while (numIterations_ < settings_.maxNumIterations) {
+    setReferences();
+    threadPool_.parallelFor(0, numAgents, 1, solveTask);
+    for (auto& agent : agents_) {
+      agent.couplingTrajectory = agent.modulePtr->getCouplingTrajectory();
+    }
+    updateConsensus();
+    ++numIterations_;
+
+    if (primalResidual_ < settings_.primalTolerance && dualResidual_ < settings_.dualTolerance) {
+      break;
+    }
+  }
+}
+
+void ConsensusAdmm::shiftConsensus(scalar_array_t timeTrajectory) {
+  if (!consensusTrajectory_.empty()) {
+    auto shift = [&](vector_array_t& trajectory) {
+      vector_array_t shiftedTrajectory;
+      shiftedTrajectory.reserve(timeTrajectory.size());
+      for (const auto time : timeTrajectory) {
+        shiftedTrajectory.push_back(LinearInterpolation::interpolate(time, timeTrajectory_, trajectory));
+      }
+      trajectory.swap(shiftedTrajectory);
+    };
+    shift(consensusTrajectory_);
+    for (auto& agent : agents_) {
+      shift(agent.scaledMultiplierTrajectory);
+    }
+  }
+  timeTrajectory_.swap(timeTrajectory);
+}
+
+void ConsensusAdmm::setReferences() {
+  ConsensusReference reference;
+  reference.penalty = settings_.penalty;
+  reference.timeStep = getTimeStep();
+  reference.timeTrajectory = timeTrajectory_;
+  for (auto& agent : agents_) {
+    // the consensus term is inactive until the first consensus is available
+    reference.referenceTrajectory.clear();
+    for (size_t k = 0; k < consensusTrajectory_.size(); k++) {
+      reference.referenceTrajectory.push_back(consensusTrajectory_[k] - agent.scaledMultiplierTrajectory[k]);
+    }
+    agent.modulePtr->setReference(reference);
+  }
+}
+
+void ConsensusAdmm::updateConsensus() {
+  const size_t numNodes = timeTrajectory_.size();
+  const auto& firstCoupling = agents_.front().couplingTrajectory;
+  const auto couplingDim = firstCoupling.empty() ? 0 : firstCoupling.front().size();
+  for (size_t i = 0; i < agents_.size(); i++) {
+    const auto& couplingTrajectory = agents_[i].couplingTrajectory;
+    const bool isConsistent = couplingTrajectory.size() == numNodes &&
+                              std::all_of(couplingTrajectory.begin(), couplingTrajectory.end(),
+                                          [&](const vector_t& coupling) { return coupling.size() == couplingDim; });
+    if (!isConsistent) {
+      throw std::runtime_error("[ConsensusAdmm] The coupling of agent " + std::to_string(i) + " is inconsistent with the consensus!");
+    }
+    if (agents_[i].scaledMultiplierTrajectory.empty()) {
+      agents_[i].scaledMultiplierTrajectory.assign(numNodes, vector_t::Zero(couplingDim));
+    }
+  }
+
+  // consensus: z = mean_i(g_i + w_i)
+  vector_array_t consensusTrajectory(numNodes, vector_t::Zero(couplingDim));
+  for (const auto& agent : agents_) {
+    for (size_t k = 0; k < numNodes; k++) {
+      consensusTrajectory[k] += agent.couplingTrajectory[k] + agent.scaledMultiplierTrajectory[k];
+    }
+  }
+  for (auto& consensus : consensusTrajectory) {
+    consensus /= static_cast<scalar_t>(agents_.size());
+  }
+
+  // dual residual: rho * dt * sqrt(numAgents) * |z - z_previous|, with the penalty of a node of the consensus grid
+  if (consensusTrajectory_.empty()) {
+    dualResidual_ = std::numeric_limits<scalar_t>::infinity();
+  } else {
+    scalar_t squaredChange = 0.0;
+    for (size_t k = 0; k < numNodes; k++) {
+      squaredChange += (consensusTrajectory[k] - consensusTrajectory_[k]).squaredNorm();
+    }
+    dualResidual_ = settings_.penalty * getTimeStep() * std::sqrt(agents_.size() * squaredChange);
+  }
+
+  // multipliers: w_i += g_i - z, and primal residual: |g - z|
+  scalar_t squaredViolation = 0.0;
+  for (auto& agent : agents_) {
+    for (size_t k = 0; k < numNodes; k++) {
+      const vector_t violation = agent.couplingTrajectory[k] - consensusTrajectory[k];
+      agent.scaledMultiplierTrajectory[k] += violation;
+      squaredViolation += violation.squaredNorm();
+    }
+  }
+  primalResidual_ = std::sqrt(squaredViolation);
+
+  consensusTrajectory_.swap(consensusTrajectory);
+}
+
+}  // namespace ocs2
@@ -0,0 +1,67 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_sqp/ConsensusCost.h"
+
+#include <ocs2_core/misc/LinearInterpolation.h>
+
+namespace ocs2 {
+
+ConsensusCost::ConsensusCost(const StateConstraint& coupling, std::shared_ptr<const ConsensusReference> referencePtr, bool isFinal)
+    : couplingPtr_(coupling.clone()), referencePtr_(std::move(referencePtr)), isFinal_(isFinal) {}
+
+ConsensusCost::ConsensusCost(const ConsensusCost& other)
+    : StateCost(other), couplingPtr_(other.couplingPtr_->clone()), referencePtr_(other.referencePtr_), isFinal_(other.isFinal_) {}
+
+vector_t ConsensusCost::getDeviation(scalar_t time, const vector_t& coupling) const {
+  const auto& reference = *referencePtr_;
+  return coupling - LinearInterpolation::interpolate(time, reference.timeTrajectory, reference.referenceTrajectory);
+}
+
+scalar_t ConsensusCost::getValue(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
+                                 const PreComputation& preComp) const {
+  const vector_t deviation = getDeviation(time, couplingPtr_->getValue(time, state, preComputation_));
+  return 0.5 * getPenalty() * deviation.squaredNorm();
+}
+
+ScalarFunctionQuadraticApproximation ConsensusCost::getQuadraticApproximation(scalar_t time, const vector_t& state,
+                                                                             const TargetTrajectories& targetTrajectories,
+                                                                             const PreComputation& preComp) const {
+  const scalar_t penalty = getPenalty();
+  const auto coupling = couplingPtr_->getLinearApproximation(time, state, preComputation_);
+  const vector_t deviation = getDeviation(time, coupling.f);
+
+  ScalarFunctionQuadraticApproximation cost;
+  cost.f = 0.5 * penalty * deviation.squaredNorm();
+  cost.dfdx.noalias() = penalty * coupling.dfdx.transpose() * deviation;
+  cost.dfdxx.noalias() = penalty * coupling.dfdx.transpose() * coupling.dfdx;
+  return cost;
+}
+
+}  // namespace ocs2
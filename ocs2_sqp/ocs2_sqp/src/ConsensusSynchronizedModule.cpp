@@ -0,0 +1,83 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_sqp/ConsensusSynchronizedModule.h"
+
+#include <ocs2_core/misc/LinearInterpolation.h>
+
+namespace ocs2 {
+
+ConsensusSynchronizedModule::ConsensusSynchronizedModule(const StateConstraint& coupling)
+    : couplingPtr_(coupling.clone()), activeReferencePtr_(std::make_shared<ConsensusReference>()) {}
+
+std::unique_ptr<StateCost> ConsensusSynchronizedModule::createConsensusCost() const {
+  return std::unique_ptr<StateCost>(new ConsensusCost(*couplingPtr_, activeReferencePtr_));
+}
+
+std::unique_ptr<StateCost> ConsensusSynchronizedModule::createFinalConsensusCost() const {
+  return std::unique_ptr<StateCost>(new ConsensusCost(*couplingPtr_, activeReferencePtr_, true));
+}
+
+void ConsensusSynchronizedModule::setReference(const ConsensusReference& reference) {
+  if (!reference.referenceTrajectory.empty() && reference.referenceTrajectory.size() != reference.timeTrajectory.size()) {
+    throw std::runtime_error("[ConsensusSynchronizedModule::setReference] The reference and the consensus grid have different sizes!");
+  }
+  std::lock_guard<std::mutex> lock(bufferMutex_);
+  bufferedReference_ = reference;
+  isBufferUpdated_ = true;
+}
+
+vector_array_t ConsensusSynchronizedModule::getCouplingTrajectory() const {
+  std::lock_guard<std::mutex> lock(bufferMutex_);
+  return couplingTrajectory_;
+}
+
+void ConsensusSynchronizedModule::preSolverRun(scalar_t initTime, scalar_t finalTime, const vector_t& initState,
+                                               const ReferenceManagerInterface& referenceManager) {
+  std::lock_guard<std::mutex> lock(bufferMutex_);
+  if (isBufferUpdated_) {
+    std::swap(*activeReferencePtr_, bufferedReference_);
+    isBufferUpdated_ = false;
+  }
+}
+
+void ConsensusSynchronizedModule::postSolverRun(const PrimalSolution& primalSolution) {
+  const auto& timeTrajectory = activeReferencePtr_->timeTrajectory;
+  vector_array_t couplingTrajectory;
+  couplingTrajectory.reserve(timeTrajectory.size());
+  for (const auto time : timeTrajectory) {
+    const vector_t state = LinearInterpolation::interpolate(time, primalSolution.timeTrajectory_, primalSolution.stateTrajectory_);
+    couplingTrajectory.push_back(couplingPtr_->getValue(time, state, preComputation_));
+  }
+
+  std::lock_guard<std::mutex> lock(bufferMutex_);
+  couplingTrajectory_.swap(couplingTrajectory);
+}
+
+}  // namespace ocs2
@@ -29,8 +29,39 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_sqp/ConstraintProjection.h"
 
+#include <vector>
+
 namespace ocs2 {
 
+namespace {
+struct StructuredProjectionWorkspace {
+  std::vector<int> selectionRowOfInput;  // row of the constraint which fixes the input, -1 if the input is free
+  std::vector<int> generalRows;          // constraint rows which are not a selection
+  std::vector<int> freeInputs;           // inputs which are not fixed by a selection
+  matrix_t D;                            // general rows of D restricted to the free inputs
+  matrix_t C;                            // general rows of C with the fixed inputs substituted
+  vector_t e;                            // general rows of e with the fixed inputs substituted
+  matrix_t kernel;
+  matrix_t Px;
+  vector_t Pe;
+  Eigen::FullPivLU<matrix_t> lu;
+};
+
+/** Returns the column of the only nonzero entry in the row, or -1 if there are none or several */
+int getSingleNonzeroColumn(const matrix_t& D, int row) {
+  int column = -1;
+  for (int j = 0; j < D.cols(); ++j) {
+    if (D(row, j) != 0.0) {
+      if (column >= 0) {
+        return -1;
+      }
+      column = j;
+    }
+  }
+  return column;
+}
+}  // namespace
+
 VectorFunctionLinearApproximation qrConstraintProjection(const VectorFunctionLinearApproximation& constraint) {
   // Constraint Projectors are based on the QR decomposition
   const auto numConstraints = constraint.dfdu.rows();
@@ -53,15 +84,105 @@ VectorFunctionLinearApproximation qrConstraintProjection(const VectorFunctionLin
 }
 
 VectorFunctionLinearApproximation luConstraintProjection(const VectorFunctionLinearApproximation& constraint) {
-  // Constraint Projectors are based on the LU decomposition
-  const Eigen::FullPivLU<matrix_t> lu(constraint.dfdu);
-
   VectorFunctionLinearApproximation projectionTerms;
+  luConstraintProjection(constraint, projectionTerms);
+  return projectionTerms;
+}
+
+void luConstraintProjection(const VectorFunctionLinearApproximation& constraint, VectorFunctionLinearApproximation& projectionTerms) {
+  // Constraint Projectors are based on the LU decomposition. The decomposition is kept per thread, such that it reuses its memory for
+  // constraints of the same size.
+  thread_local Eigen::FullPivLU<matrix_t> lu;
+  lu.compute(constraint.dfdu);
+
   projectionTerms.dfdu = lu.kernel();
   projectionTerms.dfdx.noalias() = -lu.solve(constraint.dfdx);
   projectionTerms.f.noalias() = -lu.solve(constraint.f);
+}
 
-  return projectionTerms;
+void structuredConstraintProjection(const VectorFunctionLinearApproximation& constraint,
+                                    VectorFunctionLinearApproximation& projectionTerms) {
+  thread_local StructuredProjectionWorkspace ws;
+  const auto& C = constraint.dfdx;
+  const auto& D = constraint.dfdu;
+  const auto& e = constraint.f;
+  const int numConstraints = D.rows();
+  const int numInputs = D.cols();
+  const int numStates = C.cols();
+
+  // Rows with a single nonzero entry fix an input, unless the input is already fixed by another row
+  ws.selectionRowOfInput.assign(numInputs, -1);
+  ws.generalRows.clear();
+  for (int i = 0; i < numConstraints; ++i) {
+    const int j = getSingleNonzeroColumn(D, i);
+    if (j >= 0 && ws.selectionRowOfInput[j] < 0) {
+      ws.selectionRowOfInput[j] = i;
+    } else {
+      ws.generalRows.push_back(i);
+    }
+  }
+  if (ws.generalRows.size() == numConstraints) {
+    luConstraintProjection(constraint, projectionTerms);
+    return;
+  }
+
+  // Fixed inputs: u_j = -(C_i * x + e_i) / d_ij
+  projectionTerms.dfdx.resize(numInputs, numStates);
+  projectionTerms.f.resize(numInputs);
+  ws.freeInputs.clear();
+  for (int j = 0; j < numInputs; ++j) {
+    const int i = ws.selectionRowOfInput[j];
+    if (i >= 0) {
+      const scalar_t invD = -1.0 / D(i, j);
+      projectionTerms.dfdx.row(j) = invD * C.row(i);
+      projectionTerms.f(j) = invD * e(i);
+    } else {
+      ws.freeInputs.push_back(j);
+    }
+  }
+  const int numGeneralRows = ws.generalRows.size();
+  const int numFreeInputs = ws.freeInputs.size();
+
+  // Remaining constraints on the free inputs, with the fixed inputs substituted
+  ws.D.resize(numGeneralRows, numFreeInputs);
+  ws.C.resize(numGeneralRows, numStates);
+  ws.e.resize(numGeneralRows);
+  for (int r = 0; r < numGeneralRows; ++r) {
+    const int i = ws.generalRows[r];
+    for (int k = 0; k < numFreeInputs; ++k) {
+      ws.D(r, k) = D(i, ws.freeInputs[k]);
+    }
+    ws.C.row(r) = C.row(i);
+    ws.e(r) = e(i);
+    for (int j = 0; j < numInputs; ++j) {
+      if (ws.selectionRowOfInput[j] >= 0 && D(i, j) != 0.0) {
+        ws.C.row(r) += D(i, j) * projectionTerms.dfdx.row(j);
+        ws.e(r) += D(i, j) * projectionTerms.f(j);
+      }
+    }
+  }
+
+  // Projection of the free inputs. Like the LU kernel, Pu has a single zero column if there are no degrees of freedom left.
+  if (numFreeInputs == 0) {
+    ws.kernel.setZero(0, 1);
+  } else if (numGeneralRows > 0) {
+    ws.lu.compute(ws.D);
+    ws.kernel = ws.lu.kernel();
+    ws.Px.noalias() = -ws.lu.solve(ws.C);
+    ws.Pe.noalias() = -ws.lu.solve(ws.e);
+  } else {
+    ws.kernel.setIdentity(numFreeInputs, numFreeInputs);
+    ws.Px.setZero(numFreeInputs, numStates);
+    ws.Pe.setZero(numFreeInputs);
+  }
+
+  projectionTerms.dfdu.setZero(numInputs, ws.kernel.cols());
+  for (int k = 0; k < numFreeInputs; ++k) {
+    const int j = ws.freeInputs[k];
+    projectionTerms.dfdu.row(j) = ws.kernel.row(k);
+    projectionTerms.dfdx.row(j) = ws.Px.row(k);
+    projectionTerms.f(j) = ws.Pe(k);
+  }
 }
 
 }  // namespace ocs2
\ No newline at end of file
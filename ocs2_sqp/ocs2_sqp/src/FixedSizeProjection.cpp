@@ -0,0 +1,74 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+
+#include "ocs2_sqp/FixedSizeProjection.h"
+
+#include <ocs2_oc/approximate_model/ChangeOfInputVariables.h>
+
+#include "ocs2_sqp/ConstraintProjection.h"
+
+namespace ocs2 {
+namespace multiple_shooting {
+
+namespace {
+struct RegisteredProjection {
+  size_t stateDim;
+  size_t inputDim;
+  ProjectionFunction projectionFunction;
+};
+
+// Dimensions for which the fixed-size projection is instantiated. Every entry adds compile time, add only dimensions of robots in use.
+const RegisteredProjection projectionRegistry[] = {
+    {10, 3, &projectIntermediateNode<10, 3>},    // ballbot
+    {12, 4, &projectIntermediateNode<12, 4>},    // quadrotor
+    {24, 24, &projectIntermediateNode<24, 24>},  // legged robot
+};
+}  // namespace
+
+void projectIntermediateNode(const VectorFunctionLinearApproximation& constraints, VectorFunctionLinearApproximation& dynamics,
+                             ScalarFunctionQuadraticApproximation& cost, VectorFunctionLinearApproximation& projection) {
+  // See ProjectionBenchmark.cpp of ocs2_benchmarks for the comparison of the projection methods.
+  structuredConstraintProjection(constraints, projection);
+  changeOfInputVariables(dynamics, projection.dfdu, projection.dfdx, projection.f);
+  changeOfInputVariables(cost, projection.dfdu, projection.dfdx, projection.f);
+}
+
+ProjectionFunction selectProjectionFunction(size_t stateDim, size_t inputDim) {
+  for (const auto& registeredProjection : projectionRegistry) {
+    if (registeredProjection.stateDim == stateDim && registeredProjection.inputDim == inputDim) {
+      return registeredProjection.projectionFunction;
+    }
+  }
+  // Cast to select the dynamic-size overload
+  return static_cast<ProjectionFunction>(&projectIntermediateNode);
+}
+
+}  // namespace multiple_shooting
+}  // namespace ocs2
@@ -29,7 +29,14 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_sqp/MultipleShootingInitialization.h"
 
+#include <stdexcept>
+#include <tuple>
+
+#include <ocs2_core/control/FeedforwardController.h>
+#include <ocs2_core/control/LinearController.h>
 #include <ocs2_core/misc/LinearInterpolation.h>
+#include <ocs2_oc/trajectory_adjustment/TrajectorySpreading.h>
+#include <ocs2_oc/trajectory_adjustment/TrajectorySpreadingHelperFunctions.h>
 
 namespace ocs2 {
 namespace multiple_shooting {
@@ -39,5 +46,61 @@ std::pair<vector_t, vector_t> initializeIntermediateNode(PrimalSolution& primalS
           LinearInterpolation::interpolate(tNext, primalSolution.timeTrajectory_, primalSolution.stateTrajectory_)};
 }
 
+std::pair<vector_t, vector_t> extrapolateIntermediateNode(ControllerBase& controller, const DynamicsDiscretizer& discretizer,
+                                                          SystemDynamicsBase& dynamics, scalar_t t, scalar_t tNext, const vector_t& x) {
+  vector_t input = controller.computeInput(t, x);
+  vector_t nextState = discretizer(dynamics, t, x, input, tNext - t);
+  return {std::move(input), std::move(nextState)};
+}
+
+void alignWithModeSchedule(const ModeSchedule& newModeSchedule, PrimalSolution& primalSolution) {
+  const auto& oldModeSchedule = primalSolution.modeSchedule_;
+  if (oldModeSchedule.eventTimes == newModeSchedule.eventTimes && oldModeSchedule.modeSequence == newModeSchedule.modeSequence) {
+    return;
+  }
+
+  // the linear controller shares the time stamps of the solution, a feedforward controller is recreated from the adjusted inputs
+  auto* linearControllerPtr = dynamic_cast<LinearController*>(primalSolution.controllerPtr_.get());
+  if (linearControllerPtr != nullptr) {
+    std::ignore = trajectorySpread(oldModeSchedule, newModeSchedule, *linearControllerPtr);
+  }
+  std::ignore = trajectorySpread(oldModeSchedule, newModeSchedule, primalSolution);
+  if (linearControllerPtr == nullptr && primalSolution.controllerPtr_ != nullptr) {
+    primalSolution.controllerPtr_.reset(new FeedforwardController(primalSolution.timeTrajectory_, primalSolution.inputTrajectory_));
+  }
+}
+
+vector_array_t shiftMultipliers(const ModeSchedule& oldModeSchedule, const ModeSchedule& newModeSchedule, const scalar_array_t& oldTime,
+                                const vector_array_t& oldMultipliers, const scalar_array_t& newTime) {
+  if (oldTime.size() != oldMultipliers.size()) {
+    throw std::runtime_error("[shiftMultipliers] The previous multipliers and their times differ in size.");
+  }
+
+  vector_array_t newMultipliers(newTime.size());
+  if (oldTime.empty()) {
+    return newMultipliers;
+  }
+
+  const auto interpolateAll = [&](const scalar_array_t& time, const vector_array_t& multipliers) {
+    for (size_t i = 0; i < newTime.size() && !multipliers.empty(); ++i) {
+      newMultipliers[i] = LinearInterpolation::interpolate(newTime[i], time, multipliers);
+    }
+  };
+
+  if (oldModeSchedule.eventTimes == newModeSchedule.eventTimes && oldModeSchedule.modeSequence == newModeSchedule.modeSequence) {
+    interpolateAll(oldTime, oldMultipliers);
+  } else {
+    constexpr bool debugPrint = false;
+    TrajectorySpreading trajectorySpreading(debugPrint);
+    std::ignore = trajectorySpreading.set(oldModeSchedule, newModeSchedule, oldTime);
+    scalar_array_t spreadTime = oldTime;
+    vector_array_t spreadMultipliers = oldMultipliers;
+    trajectorySpreading.adjustTimeTrajectory(spreadTime);
+    trajectorySpreading.adjustTrajectory(spreadMultipliers);
+    interpolateAll(spreadTime, spreadMultipliers);
+  }
+  return newMultipliers;
+}
+
 }  // namespace multiple_shooting
 }  // namespace ocs2
\ No newline at end of file
@@ -38,8 +38,8 @@ namespace ocs2 {
 namespace multiple_shooting {
 
 Settings loadSettings(const std::string& filename, const std::string& fieldName, bool verbose) {
-  boost::property_tree::ptree pt;
-  boost::property_tree::read_info(filename, pt);
+  const auto ptPtr = loadData::readInfoFile(filename);
+  const boost::property_tree::ptree& pt = *ptPtr;
 
   Settings settings;
 
@@ -52,25 +52,39 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
   loadData::loadPtreeValue(pt, settings.deltaTol, fieldName + ".deltaTol", verbose);
   loadData::loadPtreeValue(pt, settings.alpha_decay, fieldName + ".alpha_decay", verbose);
   loadData::loadPtreeValue(pt, settings.alpha_min, fieldName + ".alpha_min", verbose);
+  loadData::loadPtreeValue(pt, settings.numLinesearchTrials, fieldName + ".numLinesearchTrials", verbose);
   loadData::loadPtreeValue(pt, settings.gamma_c, fieldName + ".gamma_c", verbose);
   loadData::loadPtreeValue(pt, settings.g_max, fieldName + ".g_max", verbose);
   loadData::loadPtreeValue(pt, settings.g_min, fieldName + ".g_min", verbose);
   loadData::loadPtreeValue(pt, settings.armijoFactor, fieldName + ".armijoFactor", verbose);
   loadData::loadPtreeValue(pt, settings.costTol, fieldName + ".costTol", verbose);
+  loadData::loadPtreeValue(pt, settings.exactHessian, fieldName + ".exactHessian", verbose);
+  loadData::loadPtreeValue(pt, settings.exactHessianMinEigenvalue, fieldName + ".exactHessianMinEigenvalue", verbose);
+  loadData::loadPtreeValue(pt, settings.realTimeIteration, fieldName + ".realTimeIteration", verbose);
   loadData::loadPtreeValue(pt, settings.dt, fieldName + ".dt", verbose);
+  loadData::loadPtreeValue(pt, settings.shiftTimeDiscretization, fieldName + ".shiftTimeDiscretization", verbose);
+  loadData::loadPtreeValue(pt, settings.dtFinal, fieldName + ".dtFinal", verbose);
+  loadData::loadStdVector(filename, fieldName + ".inputBlocking", settings.inputBlocking, verbose);
+  loadData::loadPtreeValue(pt, settings.extrapolateWithPolicy, fieldName + ".extrapolateWithPolicy", verbose);
   loadData::loadPtreeValue(pt, settings.useFeedbackPolicy, fieldName + ".useFeedbackPolicy", verbose);
   loadData::loadPtreeValue(pt, settings.createValueFunction, fieldName + ".createValueFunction", verbose);
+  loadData::loadPtreeValue(pt, settings.feedbackPolicyHorizon, fieldName + ".feedbackPolicyHorizon", verbose);
   auto integratorName = sensitivity_integrator::toString(settings.integratorType);
   loadData::loadPtreeValue(pt, integratorName, fieldName + ".integratorType", verbose);
   settings.integratorType = sensitivity_integrator::fromString(integratorName);
   loadData::loadPtreeValue(pt, settings.inequalityConstraintMu, fieldName + ".inequalityConstraintMu", verbose);
   loadData::loadPtreeValue(pt, settings.inequalityConstraintDelta, fieldName + ".inequalityConstraintDelta", verbose);
   loadData::loadPtreeValue(pt, settings.projectStateInputEqualityConstraints, fieldName + ".projectStateInputEqualityConstraints", verbose);
+  loadData::loadPtreeValue(pt, settings.hpipmEqualityConstraints, fieldName + ".hpipmEqualityConstraints", verbose);
+  loadData::loadPtreeValue(pt, settings.cacheTermActivity, fieldName + ".cacheTermActivity", verbose);
+  loadData::loadPtreeValue(pt, settings.numRiccatiPartitions, fieldName + ".numRiccatiPartitions", verbose);
   loadData::loadPtreeValue(pt, settings.printSolverStatus, fieldName + ".printSolverStatus", verbose);
   loadData::loadPtreeValue(pt, settings.printSolverStatistics, fieldName + ".printSolverStatistics", verbose);
   loadData::loadPtreeValue(pt, settings.printLinesearch, fieldName + ".printLinesearch", verbose);
   loadData::loadPtreeValue(pt, settings.nThreads, fieldName + ".nThreads", verbose);
   loadData::loadPtreeValue(pt, settings.threadPriority, fieldName + ".threadPriority", verbose);
+  loadData::loadPtreeValue(pt, settings.threadSpinDuration, fieldName + ".threadSpinDuration", verbose);
+  loadData::loadStdVector(filename, fieldName + ".threadAffinity", settings.threadAffinity, verbose);
 
   if (verbose) {
     std::cerr << settings.hpipmSettings;
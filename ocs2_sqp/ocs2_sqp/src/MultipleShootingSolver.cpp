@@ -29,24 +29,75 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_sqp/MultipleShootingSolver.h"
 
+#include <algorithm>
+#include <iomanip>
 #include <iostream>
 #include <numeric>
 
 #include <ocs2_core/control/FeedforwardController.h>
 #include <ocs2_core/control/LinearController.h>
 #include <ocs2_core/penalties/penalties/RelaxedBarrierPenalty.h>
+#include <ocs2_oc/oc_problem/OptimalControlProblemHelperFunction.h>
 
 #include "ocs2_sqp/MultipleShootingInitialization.h"
 #include "ocs2_sqp/MultipleShootingTranscription.h"
 
 namespace ocs2 {
 
+namespace {
+bool isSameTimeDiscretization(const std::vector<AnnotatedTime>& lhs, const std::vector<AnnotatedTime>& rhs) {
+  return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin(), [](const AnnotatedTime& l, const AnnotatedTime& r) {
+           return l.event == r.event && std::abs(l.time - r.time) < numeric_traits::weakEpsilon<scalar_t>();
+         });
+}
+
+std::vector<int> getBoundIndices(const std::vector<BoxConstraint::Bound>& bounds) {
+  std::vector<int> indices;
+  indices.reserve(bounds.size());
+  for (const auto& bound : bounds) {
+    indices.push_back(static_cast<int>(bound.index));
+  }
+  return indices;
+}
+
+/** Sets the bounds of the QP variables at a node, the input bounds are only set if an input is given. */
+void setBoxConstraints(const BoxConstraint& boxConstraint, const vector_t& x, const vector_t* u, hpipm_interface::BoxConstraints& box) {
+  box.stateIndices = getBoundIndices(boxConstraint.getStateBounds());
+  boxConstraint.getStateDeviationBounds(x, box.stateLowerBound, box.stateUpperBound);
+  if (u != nullptr) {
+    box.inputIndices = getBoundIndices(boxConstraint.getInputBounds());
+    boxConstraint.getInputDeviationBounds(*u, box.inputLowerBound, box.inputUpperBound);
+  } else {
+    box.inputIndices.clear();
+    box.inputLowerBound.resize(0);
+    box.inputUpperBound.resize(0);
+  }
+}
+
+/**
+ * Squared norm of the box constraint violation at node i, the input bounds are only checked if an input is given. The state bounds are
+ * not imposed on the initial node, so they are not counted there either.
+ */
+scalar_t getBoxViolationSquaredNorm(const BoxConstraint& boxConstraint, int i, const vector_t& x, const vector_t* u) {
+  scalar_t violation = (i > 0) ? boxConstraint.getStateViolationSquaredNorm(x) : 0.0;
+  if (u != nullptr) {
+    violation += boxConstraint.getInputViolationSquaredNorm(*u);
+  }
+  return violation;
+}
+}  // namespace
+
 MultipleShootingSolver::MultipleShootingSolver(Settings settings, const OptimalControlProblem& optimalControlProblem,
-                                               const Initializer& initializer)
+                                               const Initializer& initializer, std::shared_ptr<ThreadPool> threadPoolPtr)
     : SolverBase(),
       settings_(std::move(settings)),
       hpipmInterface_(hpipm_interface::OcpSize(), settings.hpipmSettings),
-      threadPool_(std::max(settings_.nThreads, size_t(1)) - 1, settings_.threadPriority) {
+      partitionedRiccatiSolver_(settings_.numRiccatiPartitions, settings_.nThreads),
+      threadPoolPtr_(threadPoolPtr != nullptr ? threadPoolPtr
+                                              : std::make_shared<ThreadPool>(std::max(settings_.nThreads, size_t(1)) - 1,
+                                                                             settings_.threadPriority,
+                                                                             std::chrono::microseconds(settings_.threadSpinDuration),
+                                                                             settings_.threadAffinity)) {
   Eigen::setNbThreads(1);  // No multithreading within Eigen.
   Eigen::initParallel();
 
@@ -54,9 +105,29 @@ MultipleShootingSolver::MultipleShootingSolver(Settings settings, const OptimalC
   discretizer_ = selectDynamicsDiscretization(settings.integratorType);
   sensitivityDiscretizer_ = selectDynamicsSensitivityDiscretization(settings.integratorType);
 
-  // Clone objects to have one for each worker
-  for (int w = 0; w < settings.nThreads; w++) {
-    ocpDefinitions_.push_back(optimalControlProblem);
+  // With move blocking, an interval spans several steps of dt over which the dynamics are integrated
+  if (!settings_.inputBlocking.empty() && !settings_.shiftTimeDiscretization) {
+    if (std::any_of(settings_.inputBlocking.begin(), settings_.inputBlocking.end(), [](size_t numSteps) { return numSteps < 1; })) {
+      throw std::runtime_error("[MultipleShootingSolver] All entries of inputBlocking must be at least 1!");
+    }
+    discretizer_ = multiStepDynamicsDiscretization(std::move(discretizer_), settings_.dt);
+    sensitivityDiscretizer_ = multiStepDynamicsSensitivityDiscretization(std::move(sensitivityDiscretizer_), settings_.dt);
+  }
+
+  // Clone objects to have one for each worker. With an own thread pool, each worker clones its own object such that its memory is
+  // allocated close to the CPU it runs on. The clones are created one after another since the source object is shared.
+  ocpDefinitions_.resize(settings_.nThreads);
+  std::mutex cloneMutex;
+  auto cloneTask = [&](int workerId) {
+    std::lock_guard<std::mutex> lock(cloneMutex);
+    ocpDefinitions_[workerId] = optimalControlProblem;
+  };
+  if (threadPoolPtr == nullptr) {
+    threadPoolPtr_->runOnEachThread(cloneTask);
+  } else {
+    for (int w = 0; w < settings_.nThreads; w++) {
+      cloneTask(w);
+    }
   }
 
   // Operating points
@@ -65,6 +136,14 @@ MultipleShootingSolver::MultipleShootingSolver(Settings settings, const OptimalC
   if (optimalControlProblem.equalityConstraintPtr->empty()) {
     settings_.projectStateInputEqualityConstraints = false;  // True does not make sense if there are no constraints.
   }
+
+  hasBoxConstraints_ = !optimalControlProblem.boxConstraintPtr->empty();
+  hasInequalityConstraints_ = !optimalControlProblem.inequalityConstraintPtr->empty();
+  isLinearQuadratic_ = isLinearQuadratic(optimalControlProblem);
+  if (settings_.projectStateInputEqualityConstraints && !optimalControlProblem.boxConstraintPtr->getInputBounds().empty()) {
+    throw std::runtime_error(
+        "[MultipleShootingSolver] Input box constraints can not be combined with the projection of the equality constraints!");
+  }
 }
 
 MultipleShootingSolver::~MultipleShootingSolver() {
@@ -76,25 +155,29 @@ MultipleShootingSolver::~MultipleShootingSolver() {
 void MultipleShootingSolver::reset() {
   // Clear solution
   primalSolution_ = PrimalSolution();
+  dualSolution_.clear();
+  problemMetrics_.clear();
+  solutionTimeDiscretization_.clear();
   valueFunction_.clear();
   performanceIndeces_.clear();
+  realTimeIteration_ = RealTimeIterationPreparation();
+  qpDualSolution_ = QpDualSolution();
 
-  // reset timers
+  // reset benchmarking
   numProblems_ = 0;
   totalNumIterations_ = 0;
-  linearQuadraticApproximationTimer_.reset();
-  solveQpTimer_.reset();
-  linesearchTimer_.reset();
-  computeControllerTimer_.reset();
+  profiler_.reset();
 }
 
 std::string MultipleShootingSolver::getBenchmarkingInformation() const {
-  const auto linearQuadraticApproximationTotal = linearQuadraticApproximationTimer_.getTotalInMilliseconds();
-  const auto solveQpTotal = solveQpTimer_.getTotalInMilliseconds();
-  const auto linesearchTotal = linesearchTimer_.getTotalInMilliseconds();
-  const auto computeControllerTotal = computeControllerTimer_.getTotalInMilliseconds();
+  const std::vector<std::string> scopeNames{"LQ Approximation", "Solve QP", "Linesearch", "Compute Controller"};
 
-  const auto benchmarkTotal = linearQuadraticApproximationTotal + solveQpTotal + linesearchTotal + computeControllerTotal;
+  std::vector<benchmark::Profiler::Statistics> statistics;
+  scalar_t benchmarkTotal = 0.0;
+  for (const auto& name : scopeNames) {
+    statistics.push_back(profiler_.getStatistics(name));
+    benchmarkTotal += statistics.back().totalInMilliseconds;
+  }
 
   std::stringstream infoStream;
   if (benchmarkTotal > 0.0) {
@@ -102,14 +185,13 @@ std::string MultipleShootingSolver::getBenchmarkingInformation() const {
     infoStream << "\n########################################################################\n";
     infoStream << "The benchmarking is computed over " << totalNumIterations_ << " iterations. \n";
     infoStream << "SQP Benchmarking\t   :\tAverage time [ms]   (% of total runtime)\n";
-    infoStream << "\tLQ Approximation   :\t" << linearQuadraticApproximationTimer_.getAverageInMilliseconds() << " [ms] \t\t("
-               << linearQuadraticApproximationTotal / benchmarkTotal * inPercent << "%)\n";
-    infoStream << "\tSolve QP           :\t" << solveQpTimer_.getAverageInMilliseconds() << " [ms] \t\t("
-               << solveQpTotal / benchmarkTotal * inPercent << "%)\n";
-    infoStream << "\tLinesearch         :\t" << linesearchTimer_.getAverageInMilliseconds() << " [ms] \t\t("
-               << linesearchTotal / benchmarkTotal * inPercent << "%)\n";
-    infoStream << "\tCompute Controller :\t" << computeControllerTimer_.getAverageInMilliseconds() << " [ms] \t\t("
-               << computeControllerTotal / benchmarkTotal * inPercent << "%)\n";
+    for (size_t i = 0; i < scopeNames.size(); i++) {
+      infoStream << "\t" << std::left << std::setw(19) << scopeNames[i] << std::right << ":\t" << statistics[i].averageInMilliseconds
+                 << " [ms] \t\t(" << statistics[i].totalInMilliseconds / benchmarkTotal * inPercent << "%)\n";
+    }
+    infoStream << "\tQP resizes         :\t" << hpipmInterface_.getNumResizes() << " (" << hpipmInterface_.getNumAllocations()
+               << " memory allocations)\n";
+    infoStream << "\n" << profiler_.getReport();
   }
   return infoStream.str();
 }
@@ -144,6 +226,11 @@ ScalarFunctionQuadraticApproximation MultipleShootingSolver::getValueFunction(sc
 }
 
 void MultipleShootingSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime) {
+  if (settings_.realTimeIteration) {
+    runRealTimeIteration(initTime, initState, finalTime);
+    return;
+  }
+
   if (settings_.printSolverStatus || settings_.printLinesearch) {
     std::cerr << "\n++++++++++++++++++++++++++++++++++++++++++++++++++++++";
     std::cerr << "\n+++++++++++++ SQP solver is initialized ++++++++++++++";
@@ -151,18 +238,14 @@ void MultipleShootingSolver::runImpl(scalar_t initTime, const vector_t& initStat
   }
 
   // Determine time discretization, taking into account event times.
-  const auto& eventTimes = this->getReferenceManager().getModeSchedule().eventTimes;
-  const auto timeDiscretization = timeDiscretizationWithEvents(initTime, finalTime, settings_.dt, eventTimes);
+  const auto timeDiscretization = getTimeDiscretization(initTime, finalTime);
 
   // Initialize the state and input
   vector_array_t x, u;
   initializeStateInputTrajectories(initState, timeDiscretization, x, u);
 
   // Initialize references
-  for (auto& ocpDefinition : ocpDefinitions_) {
-    const auto& targetTrajectories = this->getReferenceManager().getTargetTrajectories();
-    ocpDefinition.targetTrajectoriesPtr = &targetTrajectories;
-  }
+  initializeReferences(timeDiscretization);
 
   // Bookkeeping
   performanceIndeces_.clear();
@@ -174,34 +257,58 @@ void MultipleShootingSolver::runImpl(scalar_t initTime, const vector_t& initStat
       std::cerr << "\nSQP iteration: " << iter << "\n";
     }
     // Make QP approximation
-    linearQuadraticApproximationTimer_.startTimer();
-    const auto baselinePerformance = setupQuadraticSubproblem(timeDiscretization, initState, x, u);
-    linearQuadraticApproximationTimer_.endTimer();
+    PerformanceIndex baselinePerformance;
+    {
+      benchmark::Profiler::Scope lqScope(profiler_, "LQ Approximation");
+      baselinePerformance = setupQuadraticSubproblem(timeDiscretization, initState, x, u);
+    }
 
     // Solve QP
-    solveQpTimer_.startTimer();
-    const vector_t delta_x0 = initState - x[0];
-    const auto deltaSolution = getOCPSolution(delta_x0);
-    extractValueFunction(timeDiscretization, x);
-    solveQpTimer_.endTimer();
+    OcpSubproblemSolution deltaSolution;
+    {
+      benchmark::Profiler::Scope solveQpScope(profiler_, "Solve QP");
+      const vector_t delta_x0 = initState - x[0];
+      deltaSolution = getOCPSolution(timeDiscretization, delta_x0);
+      if (settings_.createValueFunction) {
+        valueFunctionLinearizationState_ = x;  // the Riccati solution is extracted once from the last QP
+      }
+    }
 
-    // Apply step
-    linesearchTimer_.startTimer();
-    const auto stepInfo = takeStep(baselinePerformance, timeDiscretization, initState, deltaSolution, x, u);
-    performanceIndeces_.push_back(stepInfo.performanceAfterStep);
-    linesearchTimer_.endTimer();
+    if (isLinearQuadratic_) {
+      // The QP solution is the optimal solution: take the full step without linesearch and without evaluating the problem again.
+      applyFullStep(deltaSolution, x, u);
+      performanceIndeces_.push_back(getLinearQuadraticPerformance(baselinePerformance, deltaSolution));
+      convergence = multiple_shooting::Convergence::LINEAR_QUADRATIC;
 
-    // Check convergence
-    convergence = checkConvergence(iter, baselinePerformance, stepInfo);
+    } else {
+      // Apply step
+      multiple_shooting::StepInfo stepInfo;
+      {
+        benchmark::Profiler::Scope linesearchScope(profiler_, "Linesearch");
+        stepInfo = takeStep(baselinePerformance, timeDiscretization, initState, deltaSolution, x, u);
+        performanceIndeces_.push_back(stepInfo.performanceAfterStep);
+      }
+
+      // Check convergence
+      convergence = checkConvergence(iter, baselinePerformance, stepInfo);
+      if (convergence == multiple_shooting::Convergence::FALSE && isDeadlineReached()) {
+        // Out of time: stop with the current iterate, which is the best one found so far
+        convergence = multiple_shooting::Convergence::DEADLINE;
+        performanceIndeces_.back().deadlineReached = true;
+      }
+    }
 
     // Next iteration
     ++iter;
     ++totalNumIterations_;
   }
 
-  computeControllerTimer_.startTimer();
-  setPrimalSolution(timeDiscretization, std::move(x), std::move(u));
-  computeControllerTimer_.endTimer();
+  {
+    benchmark::Profiler::Scope computeControllerScope(profiler_, "Compute Controller");
+    extractRiccatiSolution(timeDiscretization, valueFunctionLinearizationState_);
+    setPrimalSolution(timeDiscretization, std::move(x), std::move(u));
+    setDualSolution(timeDiscretization);
+  }
 
   ++numProblems_;
 
@@ -213,8 +320,109 @@ void MultipleShootingSolver::runImpl(scalar_t initTime, const vector_t& initStat
   }
 }
 
-void MultipleShootingSolver::runParallel(std::function<void(int)> taskFunction) {
-  threadPool_.runParallel(std::move(taskFunction), settings_.nThreads);
+void MultipleShootingSolver::prepareRealTimeIteration(scalar_t initTime, scalar_t finalTime) {
+  if (!settings_.realTimeIteration || primalSolution_.timeTrajectory_.empty()) {
+    return;
+  }
+
+  auto timeDiscretization = getTimeDiscretization(initTime, finalTime);
+
+  // The previous solution is the best guess of the initial state, which is not known yet.
+  const vector_t predictedInitState =
+      LinearInterpolation::interpolate(initTime, primalSolution_.timeTrajectory_, primalSolution_.stateTrajectory_);
+  setupRealTimeIteration(std::move(timeDiscretization), predictedInitState);
+}
+
+void MultipleShootingSolver::setupRealTimeIteration(std::vector<AnnotatedTime> timeDiscretization, const vector_t& initState) {
+  auto& preparation = realTimeIteration_;
+  initializeStateInputTrajectories(initState, timeDiscretization, preparation.x, preparation.u);
+
+  initializeReferences(timeDiscretization);
+
+  {
+    benchmark::Profiler::Scope lqScope(profiler_, "LQ Approximation");
+    preparation.performance = setupQuadraticSubproblem(timeDiscretization, preparation.x.front(), preparation.x, preparation.u);
+  }
+
+  preparation.timeDiscretization = std::move(timeDiscretization);
+  preparation.isPrepared = true;
+}
+
+void MultipleShootingSolver::runRealTimeIteration(scalar_t initTime, const vector_t& initState, scalar_t finalTime) {
+  auto timeDiscretization = getTimeDiscretization(initTime, finalTime);
+
+  // Prepare here if the preparation phase did not run on this time discretization, e.g. in the first run or after a mode schedule update.
+  auto& preparation = realTimeIteration_;
+  if (!preparation.isPrepared || !isSameTimeDiscretization(preparation.timeDiscretization, timeDiscretization)) {
+    setupRealTimeIteration(std::move(timeDiscretization), initState);
+  }
+  preparation.isPrepared = false;  // the prepared QP is used up by this iteration
+  const auto& time = preparation.timeDiscretization;
+  auto& x = preparation.x;
+  auto& u = preparation.u;
+
+  // Solve QP
+  const vector_t delta_x0 = initState - x[0];
+  OcpSubproblemSolution deltaSolution;
+  {
+    benchmark::Profiler::Scope solveQpScope(profiler_, "Solve QP");
+    deltaSolution = getOCPSolution(time, delta_x0);
+    extractRiccatiSolution(time, x);
+  }
+
+  // Full step, the linesearch would require to evaluate the problem again.
+  applyFullStep(deltaSolution, x, u);
+
+  // Performance at the linearization point, with the deviation from the actual initial state
+  performanceIndeces_.clear();
+  performanceIndeces_.push_back(preparation.performance);
+  performanceIndeces_.back().dynamicsViolationSSE += delta_x0.squaredNorm();
+  ++totalNumIterations_;
+
+  {
+    benchmark::Profiler::Scope computeControllerScope(profiler_, "Compute Controller");
+    setPrimalSolution(time, std::move(x), std::move(u));
+    setDualSolution(time);
+  }
+
+  ++numProblems_;
+}
+
+std::vector<AnnotatedTime> MultipleShootingSolver::getTimeDiscretization(scalar_t initTime, scalar_t finalTime) const {
+  const auto& eventTimes = this->getReferenceManager().getModeSchedule().eventTimes;
+  if (settings_.shiftTimeDiscretization) {
+    return shiftTimeDiscretizationWithEvents(initTime, finalTime, settings_.dt, settings_.dtFinal, eventTimes,
+                                             primalSolution_.timeTrajectory_);
+  } else if (!settings_.inputBlocking.empty()) {
+    return blockedTimeDiscretizationWithEvents(initTime, finalTime, settings_.dt, settings_.inputBlocking, eventTimes);
+  } else {
+    return timeDiscretizationWithEvents(initTime, finalTime, settings_.dt, eventTimes);
+  }
+}
+
+void MultipleShootingSolver::parallelFor(int N, std::function<void(int, int)> taskFunction) {
+  constexpr int grain = 1;  // nodes are expensive and can differ strongly in cost
+  threadPoolPtr_->parallelFor(0, N, grain, std::move(taskFunction), settings_.nThreads);
+}
+
+void MultipleShootingSolver::initializeReferences(const std::vector<AnnotatedTime>& timeDiscretization) {
+  // the tracking costs of the nodes read the samples of the solver's copy instead of interpolating the target trajectories
+  const auto* targetTrajectoriesPtr = &this->getReferenceManager().getTargetTrajectories();
+  if (!targetTrajectoriesPtr->empty()) {
+    referenceSampleTimes_.clear();
+    for (const auto& annotatedTime : timeDiscretization) {
+      referenceSampleTimes_.push_back(getIntervalStart(annotatedTime));
+    }
+    targetTrajectoriesPtr->sampleOnGrid(referenceSampleTimes_, sampledTargetTrajectories_);
+    targetTrajectoriesPtr = &sampledTargetTrajectories_;
+  }
+
+  for (auto& ocpDefinition : ocpDefinitions_) {
+    ocpDefinition.targetTrajectoriesPtr = targetTrajectoriesPtr;
+    if (settings_.cacheTermActivity) {
+      cacheTermActivity(this->getReferenceManager().getModeSchedule(), ocpDefinition);
+    }
+  }
 }
 
 void MultipleShootingSolver::initializeStateInputTrajectories(const vector_t& initState,
@@ -226,6 +434,13 @@ void MultipleShootingSolver::initializeStateInputTrajectories(const vector_t& in
   inputTrajectory.clear();
   inputTrajectory.reserve(N);
 
+  // Shift the events of the previous solution to the current mode schedule
+  if (!primalSolution_.timeTrajectory_.empty()) {
+    multiple_shooting::alignWithModeSchedule(this->getReferenceManager().getModeSchedule(), primalSolution_);
+  }
+  const bool extrapolateWithPolicy = settings_.extrapolateWithPolicy && primalSolution_.controllerPtr_ != nullptr &&
+                                     !primalSolution_.controllerPtr_->empty();
+
   // Determine till when to use the previous solution
   scalar_t interpolateStateTill = timeDiscretization.front().time;
   scalar_t interpolateInputTill = timeDiscretization.front().time;
@@ -253,7 +468,10 @@ void MultipleShootingSolver::initializeStateInputTrajectories(const vector_t& in
       const scalar_t time = getIntervalStart(timeDiscretization[i]);
       const scalar_t nextTime = getIntervalEnd(timeDiscretization[i + 1]);
       vector_t input, nextState;
-      if (time > interpolateInputTill || nextTime > interpolateStateTill) {  // Using initializer
+      if ((time > interpolateInputTill || nextTime > interpolateStateTill) && extrapolateWithPolicy) {  // Using previous policy
+        std::tie(input, nextState) = multiple_shooting::extrapolateIntermediateNode(
+            *primalSolution_.controllerPtr_, discretizer_, *ocpDefinitions_.front().dynamicsPtr, time, nextTime, stateTrajectory.back());
+      } else if (time > interpolateInputTill || nextTime > interpolateStateTill) {  // Using initializer
         std::tie(input, nextState) =
             multiple_shooting::initializeIntermediateNode(*initializerPtr_, time, nextTime, stateTrajectory.back());
       } else {  // interpolate previous solution
@@ -265,25 +483,41 @@ void MultipleShootingSolver::initializeStateInputTrajectories(const vector_t& in
   }
 }
 
-MultipleShootingSolver::OcpSubproblemSolution MultipleShootingSolver::getOCPSolution(const vector_t& delta_x0) {
+MultipleShootingSolver::OcpSubproblemSolution MultipleShootingSolver::getOCPSolution(const std::vector<AnnotatedTime>& time,
+                                                                                    const vector_t& delta_x0) {
   // Solve the QP
   OcpSubproblemSolution solution;
   auto& deltaXSol = solution.deltaXSol;
   auto& deltaUSol = solution.deltaUSol;
+  const bool warmStart = settings_.hpipmSettings.warm_start > 0;
   hpipm_status status;
   const bool hasStateInputConstraints = !ocpDefinitions_.front().equalityConstraintPtr->empty();
-  if (hasStateInputConstraints && !settings_.projectStateInputEqualityConstraints) {
-    hpipmInterface_.resize(hpipm_interface::extractSizesFromProblem(dynamics_, cost_, &constraints_));
-    status = hpipmInterface_.solve(delta_x0, dynamics_, cost_, &constraints_, deltaXSol, deltaUSol, settings_.printSolverStatus);
-  } else {  // without constraints, or when using projection, we have an unconstrained QP.
-    hpipmInterface_.resize(hpipm_interface::extractSizesFromProblem(dynamics_, cost_, nullptr));
-    status = hpipmInterface_.solve(delta_x0, dynamics_, cost_, nullptr, deltaXSol, deltaUSol, settings_.printSolverStatus);
+  if (usePartitionedRiccati()) {
+    partitionedRiccatiSolver_.solve(delta_x0, dynamics_, cost_, *threadPoolPtr_, deltaXSol, deltaUSol);
+    status = hpipm_status::SUCCESS;
+  } else {
+    // without equality constraints, or when using projection, only the box and inequality constraints remain
+    auto* constraintsPtr = (hasStateInputConstraints && !settings_.projectStateInputEqualityConstraints) ? &constraints_ : nullptr;
+    auto* boxConstraintsPtr = hasBoxConstraints_ ? &boxConstraints_ : nullptr;
+    auto* inequalityConstraintsPtr = hasInequalityConstraints_ ? &inequalityConstraints_ : nullptr;
+    hpipmInterface_.resize(hpipm_interface::extractSizesFromProblem(dynamics_, cost_, constraintsPtr, boxConstraintsPtr,
+                                                                    inequalityConstraintsPtr, settings_.hpipmEqualityConstraints));
+    if (warmStart) {
+      setQpInitialGuess(time);
+    }
+    status = hpipmInterface_.solve(delta_x0, dynamics_, cost_, constraintsPtr, boxConstraintsPtr, inequalityConstraintsPtr, deltaXSol,
+                                   deltaUSol, settings_.printSolverStatus);
   }
 
+  runStatistics().qpStatus = static_cast<int>(status);
   if (status != hpipm_status::SUCCESS) {
     throw std::runtime_error("[MultipleShootingSolver] Failed to solve QP");
   }
 
+  if ((warmStart && !usePartitionedRiccati()) || settings_.exactHessian) {
+    storeQpDualSolution(time, deltaXSol);
+  }
+
   // To determine if the solution is a descent direction for the cost: compute gradient(cost)' * [dx; du]
   solution.armijoDescentMetric = 0.0;
   for (int i = 0; i < cost_.size(); i++) {
@@ -310,9 +544,94 @@ MultipleShootingSolver::OcpSubproblemSolution MultipleShootingSolver::getOCPSolu
   return solution;
 }
 
-void MultipleShootingSolver::extractValueFunction(const std::vector<AnnotatedTime>& time, const vector_array_t& x) {
+bool MultipleShootingSolver::usePartitionedRiccati() const {
+  const bool hasStateInputConstraints = !ocpDefinitions_.front().equalityConstraintPtr->empty();
+  return settings_.numRiccatiPartitions > 0 && !hasBoxConstraints_ && !hasInequalityConstraints_ &&
+         (!hasStateInputConstraints || settings_.projectStateInputEqualityConstraints);
+}
+
+void MultipleShootingSolver::storeQpDualSolution(const std::vector<AnnotatedTime>& time, const vector_array_t& deltaXSol) {
+  qpDualSolution_.time.clear();
+  qpDualSolution_.time.reserve(time.size());
+  for (const auto& annotatedTime : time) {
+    qpDualSolution_.time.push_back(annotatedTime.time);
+  }
+  qpDualSolution_.modeSchedule = this->getReferenceManager().getModeSchedule();
+
+  if (usePartitionedRiccati()) {
+    // The costate is the gradient of the cost-to-go at the next node
+    const auto& costToGo = partitionedRiccatiSolver_.getRiccatiCostToGo();
+    const int N = static_cast<int>(time.size()) - 1;
+    qpDualSolution_.costateTrajectory.resize(N);
+    for (int k = 0; k < N; ++k) {
+      qpDualSolution_.costateTrajectory[k] = costToGo[k + 1].dfdx;
+      qpDualSolution_.costateTrajectory[k].noalias() += costToGo[k + 1].dfdxx * deltaXSol[k + 1];
+    }
+    qpDualSolution_.constraintMultipliers.clear();
+  } else {
+    hpipmInterface_.getDualSolution(qpDualSolution_.costateTrajectory, qpDualSolution_.constraintMultipliers);
+  }
+}
+
+vector_t MultipleShootingSolver::getPreviousCostate(scalar_t time, size_t stateDim) const {
+  const auto& previous = qpDualSolution_;
+  if (previous.costateTrajectory.empty()) {
+    return vector_t();
+  }
+  const auto it = std::lower_bound(previous.time.begin(), previous.time.end(), time);
+  const size_t j = std::min(static_cast<size_t>(std::distance(previous.time.begin(), it)), previous.costateTrajectory.size() - 1);
+  const auto& costate = previous.costateTrajectory[j];
+  return (costate.size() == stateDim) ? costate : vector_t();
+}
+
+void MultipleShootingSolver::setQpInitialGuess(const std::vector<AnnotatedTime>& time) {
+  const int N = static_cast<int>(time.size()) - 1;
+  vector_array_t costateTrajectory(N);
+  vector_array_t constraintMultipliers(N + 1);
+
+  // The multipliers of the previous QP are shifted like the primal warm start: aligned with the current mode schedule and interpolated
+  // in time. Multipliers of a different size than the current QP, e.g. after a mode change, are initialized with zeros by the QP solver.
+  const auto& previous = qpDualSolution_;
+  if (!previous.time.empty()) {
+    const auto& modeSchedule = this->getReferenceManager().getModeSchedule();
+    scalar_array_t nodeTime;
+    nodeTime.reserve(time.size());
+    for (const auto& annotatedTime : time) {
+      nodeTime.push_back(annotatedTime.time);
+    }
+
+    // the costate of interval k is stored at the time of its start node
+    if (!previous.costateTrajectory.empty() && previous.costateTrajectory.size() < previous.time.size()) {
+      const scalar_array_t previousIntervalTime(previous.time.begin(), previous.time.begin() + previous.costateTrajectory.size());
+      const scalar_array_t intervalTime(nodeTime.begin(), nodeTime.end() - 1);
+      costateTrajectory = multiple_shooting::shiftMultipliers(previous.modeSchedule, modeSchedule, previousIntervalTime,
+                                                              previous.costateTrajectory, intervalTime);
+    }
+    if (!previous.constraintMultipliers.empty()) {
+      constraintMultipliers =
+          multiple_shooting::shiftMultipliers(previous.modeSchedule, modeSchedule, previous.time, previous.constraintMultipliers, nodeTime);
+    }
+  }
+
+  // The primal initial guess is zero, the linearization point already is the shifted previous solution.
+  hpipmInterface_.setInitialGuess(vector_array_t(), vector_array_t(), costateTrajectory, constraintMultipliers);
+}
+
+void MultipleShootingSolver::extractRiccatiSolution(const std::vector<AnnotatedTime>& time, const vector_array_t& x) {
+  if (usePartitionedRiccati()) {
+    if (settings_.useFeedbackPolicy) {
+      riccatiFeedback_ = partitionedRiccatiSolver_.getRiccatiFeedback();
+    }
+    if (settings_.createValueFunction) {
+      valueFunction_ = partitionedRiccatiSolver_.getRiccatiCostToGo();
+    }
+  } else if (settings_.useFeedbackPolicy || settings_.createValueFunction) {
+    auto* feedbackPtr = settings_.useFeedbackPolicy ? &riccatiFeedback_ : nullptr;
+    auto* valueFunctionPtr = settings_.createValueFunction ? &valueFunction_ : nullptr;
+    hpipmInterface_.getRiccatiSolution(dynamics_[0], cost_[0], getNumFeedbackStages(time), feedbackPtr, nullptr, valueFunctionPtr);
+  }
+
   if (settings_.createValueFunction) {
-    valueFunction_ = hpipmInterface_.getRiccatiCostToGo(dynamics_[0], cost_[0]);
     // Correct for linearization state
     for (int i = 0; i < time.size(); ++i) {
       valueFunction_[i].dfdx.noalias() -= valueFunction_[i].dfdxx * x[i];
@@ -320,6 +639,20 @@ void MultipleShootingSolver::extractValueFunction(const std::vector<AnnotatedTim
   }
 }
 
+int MultipleShootingSolver::getNumFeedbackStages(const std::vector<AnnotatedTime>& time) const {
+  const int N = static_cast<int>(time.size()) - 1;
+  if (settings_.feedbackPolicyHorizon < 0.0) {
+    return N;
+  }
+  // Include the first node at or after the horizon such that the gains can be interpolated over the whole horizon
+  const scalar_t finalTime = time.front().time + settings_.feedbackPolicyHorizon;
+  int numStages = 1;
+  while (numStages < N && time[numStages - 1].time < finalTime) {
+    ++numStages;
+  }
+  return numStages;
+}
+
 void MultipleShootingSolver::setPrimalSolution(const std::vector<AnnotatedTime>& time, vector_array_t&& x, vector_array_t&& u) {
   // Clear old solution
   primalSolution_.clear();
@@ -338,20 +671,23 @@ void MultipleShootingSolver::setPrimalSolution(const std::vector<AnnotatedTime>&
     // see doc/LQR_full.pdf for detailed derivation for feedback terms
     uff = u;  // Copy and adapt in loop
     controllerGain.reserve(time.size());
-    matrix_array_t KMatrices = hpipmInterface_.getRiccatiFeedback(dynamics_[0], cost_[0]);
+    const int numFeedbackStages = getNumFeedbackStages(time);
     for (int i = 0; (i + 1) < time.size(); i++) {
       if (time[i].event == AnnotatedTime::Event::PreEvent && i > 0) {
         uff[i] = uff[i - 1];
         controllerGain.push_back(controllerGain.back());
+      } else if (i >= numFeedbackStages) {
+        // Beyond the feedback horizon, the policy is feedforward
+        controllerGain.push_back(matrix_t::Zero(uff[i].size(), x[i].size()));
       } else {
         // Linear controller has convention u = uff + K * x;
         // We computed u = u'(t) + K (x - x'(t));
         // >> uff = u'(t) - K x'(t)
         if (constraintsProjection_[i].f.size() > 0) {
           controllerGain.push_back(std::move(constraintsProjection_[i].dfdx));  // Steal! Don't use after this.
-          controllerGain.back().noalias() += constraintsProjection_[i].dfdu * KMatrices[i];
+          controllerGain.back().noalias() += constraintsProjection_[i].dfdu * riccatiFeedback_[i];
         } else {
-          controllerGain.push_back(std::move(KMatrices[i]));
+          controllerGain.push_back(riccatiFeedback_[i]);
         }
         uff[i].noalias() -= controllerGain.back() * x[i];
       }
@@ -374,6 +710,10 @@ void MultipleShootingSolver::setPrimalSolution(const std::vector<AnnotatedTime>&
   }
   primalSolution_.modeSchedule_ = this->getReferenceManager().getModeSchedule();
 
+  // The metrics of the new solution are computed on demand, see getSolutionMetrics()
+  solutionTimeDiscretization_ = time;
+  problemMetrics_.clear();
+
   // Assign controller
   if (settings_.useFeedbackPolicy) {
     primalSolution_.controllerPtr_.reset(new LinearController(primalSolution_.timeTrajectory_, std::move(uff), std::move(controllerGain)));
@@ -382,6 +722,78 @@ void MultipleShootingSolver::setPrimalSolution(const std::vector<AnnotatedTime>&
   }
 }
 
+void MultipleShootingSolver::setDualSolution(const std::vector<AnnotatedTime>& time) {
+  const int N = static_cast<int>(time.size()) - 1;
+  dualSolution_.clear();
+
+  // Multipliers of the state-input equality constraints, lower bound and upper bound multipliers of hpipm are combined into one. The
+  // multipliers of the inequality constraints follow the ones of the equality constraints and are not part of the dual solution.
+  vector_array_t costateTrajectory, constraintMultipliers;
+  const bool hasStateInputConstraints = !ocpDefinitions_.front().equalityConstraintPtr->empty();
+  if (hasStateInputConstraints && !settings_.projectStateInputEqualityConstraints) {
+    hpipmInterface_.getDualSolution(costateTrajectory, constraintMultipliers);
+  }
+
+  dualSolution_.timeTrajectory = primalSolution_.timeTrajectory_;
+  dualSolution_.postEventIndices = primalSolution_.postEventIndices_;
+  dualSolution_.intermediates.reserve(N + 1);
+  for (int i = 0; i < N; i++) {
+    if (time[i].event == AnnotatedTime::Event::PreEvent) {
+      dualSolution_.preJumps.emplace_back();
+      // Repeat the previous intermediate values at the event node, as for the inputs in the primal solution
+      dualSolution_.intermediates.push_back((i > 0) ? dualSolution_.intermediates.back() : MultiplierCollection());
+    } else {
+      MultiplierCollection multipliers;
+      if (i < constraintMultipliers.size() && constraintMultipliers[i].size() > 0) {
+        const auto numConstraints = constraintMultipliers[i].size() / 2;
+        const auto numEqualityConstraints = constraints_[i].f.size();
+        multipliers.stateInputEq.emplace_back(0.0, constraintMultipliers[i].segment(numConstraints, numEqualityConstraints) -
+                                                       constraintMultipliers[i].head(numEqualityConstraints));
+      }
+      dualSolution_.intermediates.push_back(std::move(multipliers));
+    }
+  }
+
+  // Terminal node, repeat the last intermediate values to make equal length vectors
+  dualSolution_.intermediates.push_back(dualSolution_.intermediates.back());
+}
+
+const ProblemMetrics& MultipleShootingSolver::getSolutionMetrics() const {
+  std::lock_guard<std::mutex> lock(problemMetricsMutex_);
+  if (!problemMetrics_.intermediates.empty() || solutionTimeDiscretization_.empty()) {
+    return problemMetrics_;
+  }
+
+  // Evaluate the nodes of the solution sequentially, since the workers belong to run(). The inputs at the event nodes are not used.
+  const auto& ocpDefinition = ocpDefinitions_.front();
+  auto discretizer = discretizer_;
+  const auto& time = solutionTimeDiscretization_;
+  const auto& x = primalSolution_.stateTrajectory_;
+  const auto& u = primalSolution_.inputTrajectory_;
+  const int N = static_cast<int>(time.size()) - 1;
+
+  problemMetrics_.intermediates.reserve(N + 1);
+  for (int i = 0; i < N; i++) {
+    MetricsCollection nodeMetrics;
+    if (time[i].event == AnnotatedTime::Event::PreEvent) {
+      multiple_shooting::computeEventPerformance(ocpDefinition, time[i].time, x[i], x[i + 1], &nodeMetrics);
+      problemMetrics_.preJumps.push_back(std::move(nodeMetrics));
+      // Repeat the previous intermediate values at the event node, as for the inputs in the primal solution
+      problemMetrics_.intermediates.push_back((i > 0) ? problemMetrics_.intermediates.back() : MetricsCollection{});
+    } else {
+      const scalar_t ti = getIntervalStart(time[i]);
+      const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
+      multiple_shooting::computeIntermediatePerformance(ocpDefinition, discretizer, ti, dt, x[i], x[i + 1], u[i], &nodeMetrics);
+      problemMetrics_.intermediates.push_back(std::move(nodeMetrics));
+    }
+  }
+
+  // Terminal node, repeat the last intermediate values to make equal length vectors
+  multiple_shooting::computeTerminalPerformance(ocpDefinition, getIntervalStart(time[N]), x[N], &problemMetrics_.final);
+  problemMetrics_.intermediates.push_back(problemMetrics_.intermediates.back());
+  return problemMetrics_;
+}
+
 PerformanceIndex MultipleShootingSolver::setupQuadraticSubproblem(const std::vector<AnnotatedTime>& time, const vector_t& initState,
                                                                   const vector_array_t& x, const vector_array_t& u) {
   // Problem horizon
@@ -392,52 +804,67 @@ PerformanceIndex MultipleShootingSolver::setupQuadraticSubproblem(const std::vec
   cost_.resize(N + 1);
   constraints_.resize(N + 1);
   constraintsProjection_.resize(N);
+  boxConstraints_.resize(hasBoxConstraints_ ? N + 1 : 0);
+  inequalityConstraints_.resize(hasInequalityConstraints_ ? N + 1 : 0);
+
+  const bool projection = settings_.projectStateInputEqualityConstraints;
+  auto parallelTask = [&](int workerId, int i) {
+    benchmark::Profiler::Scope nodeScope(profiler_, "node", "LQ Approximation");
 
-  std::atomic_int timeIndex{0};
-  auto parallelTask = [&](int workerId) {
     // Get worker specific resources
     OptimalControlProblem& ocpDefinition = ocpDefinitions_[workerId];
-    PerformanceIndex workerPerformance;  // Accumulate performance in local variable
-    const bool projection = settings_.projectStateInputEqualityConstraints;
-
-    int i = timeIndex++;
-    while (i < N) {
-      if (time[i].event == AnnotatedTime::Event::PreEvent) {
-        // Event node
-        auto result = multiple_shooting::setupEventNode(ocpDefinition, time[i].time, x[i], x[i + 1]);
-        workerPerformance += result.performance;
-        dynamics_[i] = std::move(result.dynamics);
-        cost_[i] = std::move(result.cost);
-        constraints_[i] = std::move(result.constraints);
-        constraintsProjection_[i] = VectorFunctionLinearApproximation::Zero(0, x[i].size(), 0);
-      } else {
-        // Normal, intermediate node
-        const scalar_t ti = getIntervalStart(time[i]);
-        const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
-        auto result =
-            multiple_shooting::setupIntermediateNode(ocpDefinition, sensitivityDiscretizer_, projection, ti, dt, x[i], x[i + 1], u[i]);
-        workerPerformance += result.performance;
-        dynamics_[i] = std::move(result.dynamics);
-        cost_[i] = std::move(result.cost);
-        constraints_[i] = std::move(result.constraints);
-        constraintsProjection_[i] = std::move(result.constraintsProjection);
-      }
-
-      i = timeIndex++;
-    }
 
-    if (i == N) {  // Only one worker will execute this
+    if (i == N) {
+      // Terminal node
       const scalar_t tN = getIntervalStart(time[N]);
       auto result = multiple_shooting::setupTerminalNode(ocpDefinition, tN, x[N]);
-      workerPerformance += result.performance;
+      performance[workerId] += result.performance;
       cost_[i] = std::move(result.cost);
       constraints_[i] = std::move(result.constraints);
+      if (hasBoxConstraints_) {
+        setBoxConstraints(*ocpDefinition.boxConstraintPtr, x[N], nullptr, boxConstraints_[i]);
+        performance[workerId].equalityConstraintsSSE += getBoxViolationSquaredNorm(*ocpDefinition.boxConstraintPtr, i, x[N], nullptr);
+      }
+      if (hasInequalityConstraints_) {
+        inequalityConstraints_[i] = VectorFunctionLinearApproximation::Zero(0, x[i].size());
+      }
+    } else if (time[i].event == AnnotatedTime::Event::PreEvent) {
+      // Event node
+      auto result = multiple_shooting::setupEventNode(ocpDefinition, time[i].time, x[i], x[i + 1]);
+      performance[workerId] += result.performance;
+      dynamics_[i] = std::move(result.dynamics);
+      cost_[i] = std::move(result.cost);
+      constraints_[i] = std::move(result.constraints);
+      constraintsProjection_[i] = VectorFunctionLinearApproximation::Zero(0, x[i].size(), 0);
+      if (hasBoxConstraints_) {
+        setBoxConstraints(*ocpDefinition.boxConstraintPtr, x[i], nullptr, boxConstraints_[i]);
+        performance[workerId].equalityConstraintsSSE += getBoxViolationSquaredNorm(*ocpDefinition.boxConstraintPtr, i, x[i], nullptr);
+      }
+      if (hasInequalityConstraints_) {
+        inequalityConstraints_[i] = VectorFunctionLinearApproximation::Zero(0, x[i].size(), 0);
+      }
+    } else {
+      // Normal, intermediate node
+      const scalar_t ti = getIntervalStart(time[i]);
+      const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
+      const vector_t costate = settings_.exactHessian ? getPreviousCostate(time[i].time, x[i + 1].size()) : vector_t();
+      auto result = multiple_shooting::setupIntermediateNode(ocpDefinition, sensitivityDiscretizer_, projection, ti, dt, x[i], x[i + 1],
+                                                             u[i], costate, settings_.exactHessianMinEigenvalue);
+      performance[workerId] += result.performance;
+      dynamics_[i] = std::move(result.dynamics);
+      cost_[i] = std::move(result.cost);
+      constraints_[i] = std::move(result.constraints);
+      constraintsProjection_[i] = std::move(result.constraintsProjection);
+      if (hasBoxConstraints_) {
+        setBoxConstraints(*ocpDefinition.boxConstraintPtr, x[i], &u[i], boxConstraints_[i]);
+        performance[workerId].equalityConstraintsSSE += dt * getBoxViolationSquaredNorm(*ocpDefinition.boxConstraintPtr, i, x[i], &u[i]);
+      }
+      if (hasInequalityConstraints_) {
+        inequalityConstraints_[i] = std::move(result.inequalityConstraints);
+      }
     }
-
-    // Accumulate! Same worker might run multiple tasks
-    performance[workerId] += workerPerformance;
   };
-  runParallel(std::move(parallelTask));
+  parallelFor(N + 1, std::move(parallelTask));
 
   // Account for init state in performance
   performance.front().dynamicsViolationSSE += (initState - x.front()).squaredNorm();
@@ -448,49 +875,71 @@ PerformanceIndex MultipleShootingSolver::setupQuadraticSubproblem(const std::vec
   return totalPerformance;
 }
 
-PerformanceIndex MultipleShootingSolver::computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState,
-                                                            const vector_array_t& x, const vector_array_t& u) {
+std::vector<PerformanceIndex> MultipleShootingSolver::computePerformance(const std::vector<AnnotatedTime>& time,
+                                                                         const vector_t& initState, const std::vector<vector_array_t>& x,
+                                                                         const std::vector<vector_array_t>& u,
+                                                                         std::vector<std::vector<MetricsCollection>>* metricsPtr) {
   // Problem horizon
   const int N = static_cast<int>(time.size()) - 1;
+  const int numTrajectories = static_cast<int>(x.size());
 
-  std::vector<PerformanceIndex> performance(settings_.nThreads, PerformanceIndex());
-  std::atomic_int timeIndex{0};
-  auto parallelTask = [&](int workerId) {
+  if (metricsPtr != nullptr) {
+    metricsPtr->resize(numTrajectories);
+    for (auto& metrics : *metricsPtr) {
+      metrics.resize(N + 1);
+    }
+  }
+
+  // One accumulator per trajectory and thread
+  std::vector<PerformanceIndex> performance(numTrajectories * settings_.nThreads, PerformanceIndex());
+  auto parallelTask = [&](int workerId, int taskId) {
     // Get worker specific resources
     OptimalControlProblem& ocpDefinition = ocpDefinitions_[workerId];
-    PerformanceIndex workerPerformance;  // Accumulate performance in local variable
-
-    int i = timeIndex++;
-    while (i < N) {
-      if (time[i].event == AnnotatedTime::Event::PreEvent) {
-        // Event node
-        workerPerformance += multiple_shooting::computeEventPerformance(ocpDefinition, time[i].time, x[i], x[i + 1]);
-      } else {
-        // Normal, intermediate node
-        const scalar_t ti = getIntervalStart(time[i]);
-        const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
-        workerPerformance += multiple_shooting::computeIntermediatePerformance(ocpDefinition, discretizer_, ti, dt, x[i], x[i + 1], u[i]);
-      }
+    const int j = taskId / (N + 1);
+    const int i = taskId % (N + 1);
+    auto& workerPerformance = performance[j * settings_.nThreads + workerId];
+    MetricsCollection* nodeMetricsPtr = (metricsPtr != nullptr) ? &(*metricsPtr)[j][i] : nullptr;
 
-      i = timeIndex++;
-    }
-
-    if (i == N) {  // Only one worker will execute this
+    if (i == N) {
+      // Terminal node
       const scalar_t tN = getIntervalStart(time[N]);
-      workerPerformance += multiple_shooting::computeTerminalPerformance(ocpDefinition, tN, x[N]);
+      workerPerformance += multiple_shooting::computeTerminalPerformance(ocpDefinition, tN, x[j][N], nodeMetricsPtr);
+      if (hasBoxConstraints_) {
+        workerPerformance.equalityConstraintsSSE += getBoxViolationSquaredNorm(*ocpDefinition.boxConstraintPtr, i, x[j][N], nullptr);
+      }
+    } else if (time[i].event == AnnotatedTime::Event::PreEvent) {
+      // Event node
+      workerPerformance += multiple_shooting::computeEventPerformance(ocpDefinition, time[i].time, x[j][i], x[j][i + 1], nodeMetricsPtr);
+      if (hasBoxConstraints_) {
+        workerPerformance.equalityConstraintsSSE += getBoxViolationSquaredNorm(*ocpDefinition.boxConstraintPtr, i, x[j][i], nullptr);
+      }
+    } else {
+      // Normal, intermediate node
+      const scalar_t ti = getIntervalStart(time[i]);
+      const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
+      workerPerformance += multiple_shooting::computeIntermediatePerformance(ocpDefinition, discretizer_, ti, dt, x[j][i], x[j][i + 1],
+                                                                             u[j][i], nodeMetricsPtr);
+      if (hasBoxConstraints_) {
+        workerPerformance.equalityConstraintsSSE += dt * getBoxViolationSquaredNorm(*ocpDefinition.boxConstraintPtr, i, x[j][i], &u[j][i]);
+      }
     }
-
-    // Accumulate! Same worker might run multiple tasks
-    performance[workerId] += workerPerformance;
   };
-  runParallel(std::move(parallelTask));
+  parallelFor(numTrajectories * (N + 1), std::move(parallelTask));
 
-  // Account for init state in performance
-  performance.front().dynamicsViolationSSE += (initState - x.front()).squaredNorm();
+  std::vector<PerformanceIndex> totalPerformance;
+  totalPerformance.reserve(numTrajectories);
+  for (int j = 0; j < numTrajectories; j++) {
+    const auto first = std::next(performance.begin(), j * settings_.nThreads);
+    const auto last = std::next(first, settings_.nThreads);
 
-  // Sum performance of the threads
-  PerformanceIndex totalPerformance = std::accumulate(std::next(performance.begin()), performance.end(), performance.front());
-  totalPerformance.merit = totalPerformance.cost + totalPerformance.equalityLagrangian + totalPerformance.inequalityLagrangian;
+    // Account for init state in performance
+    first->dynamicsViolationSSE += (initState - x[j].front()).squaredNorm();
+
+    // Sum performance of the threads
+    totalPerformance.push_back(std::accumulate(std::next(first), last, *first));
+    totalPerformance.back().merit =
+        totalPerformance.back().cost + totalPerformance.back().equalityLagrangian + totalPerformance.back().inequalityLagrangian;
+  }
   return totalPerformance;
 }
 
@@ -506,6 +955,40 @@ scalar_t MultipleShootingSolver::totalConstraintViolation(const PerformanceIndex
   return std::sqrt(performance.dynamicsViolationSSE + performance.equalityConstraintsSSE);
 }
 
+PerformanceIndex MultipleShootingSolver::getLinearQuadraticPerformance(const PerformanceIndex& baseline,
+                                                                       const OcpSubproblemSolution& subproblemSolution) const {
+  const auto& deltaXSol = subproblemSolution.deltaXSol;
+  const auto& deltaUSol = subproblemSolution.deltaUSol;
+
+  // change of the cost: gradient' * [dx; du] + 0.5 * [dx; du]' * Hessian * [dx; du]
+  scalar_t costChange = subproblemSolution.armijoDescentMetric;
+  for (int i = 0; i < cost_.size(); i++) {
+    if (cost_[i].dfdxx.size() > 0) {
+      costChange += 0.5 * deltaXSol[i].dot(cost_[i].dfdxx * deltaXSol[i]);
+    }
+    if (cost_[i].dfduu.size() > 0 && deltaUSol[i].size() > 0) {
+      costChange += 0.5 * deltaUSol[i].dot(cost_[i].dfduu * deltaUSol[i]) + deltaUSol[i].dot(cost_[i].dfdux * deltaXSol[i]);
+    }
+  }
+
+  PerformanceIndex performance = baseline;
+  performance.cost += costChange;
+  performance.merit += costChange;
+  performance.dynamicsViolationSSE = 0.0;
+  return performance;
+}
+
+void MultipleShootingSolver::applyFullStep(const OcpSubproblemSolution& subproblemSolution, vector_array_t& x, vector_array_t& u) {
+  for (int i = 0; i < u.size(); i++) {
+    if (subproblemSolution.deltaUSol[i].size() > 0) {  // account for absence of inputs at events.
+      u[i] += subproblemSolution.deltaUSol[i];
+    }
+  }
+  for (int i = 0; i < x.size(); i++) {
+    x[i] += subproblemSolution.deltaXSol[i];
+  }
+}
+
 multiple_shooting::StepInfo MultipleShootingSolver::takeStep(const PerformanceIndex& baseline,
                                                              const std::vector<AnnotatedTime>& timeDiscretization,
                                                              const vector_t& initState, const OcpSubproblemSolution& subproblemSolution,
@@ -535,73 +1018,94 @@ multiple_shooting::StepInfo MultipleShootingSolver::takeStep(const PerformanceIn
   // Prepare step info
   multiple_shooting::StepInfo stepInfo;
 
-  scalar_t alpha = 1.0;
-  vector_array_t xNew(x.size());
-  vector_array_t uNew(u.size());
-  do {
-    // Compute step
-    for (int i = 0; i < u.size(); i++) {
-      if (du[i].size() > 0) {  // account for absence of inputs at events.
-        uNew[i] = u[i] + alpha * du[i];
-      }
+  // Step sizes of the backtracking, which stops at alpha_min or when the primal steps become too small.
+  scalar_array_t stepSizes{1.0};
+  bool isPrimalStepTooSmall = false;
+  for (scalar_t alpha = settings_.alpha_decay; alpha >= settings_.alpha_min; alpha *= settings_.alpha_decay) {
+    if (alpha * deltaXnorm < settings_.deltaTol && alpha * deltaUnorm < settings_.deltaTol) {
+      isPrimalStepTooSmall = true;
+      break;
     }
-    for (int i = 0; i < x.size(); i++) {
-      xNew[i] = x[i] + alpha * dx[i];
+    stepSizes.push_back(alpha);
+  }
+
+  // The step sizes are evaluated in batches of numLinesearchTrials in parallel, and the largest accepted step of a batch is taken.
+  const size_t batchSize = std::max<size_t>(settings_.numLinesearchTrials, 1);
+  std::vector<vector_array_t> xNew;
+  std::vector<vector_array_t> uNew;
+  for (size_t batchStart = 0; batchStart < stepSizes.size(); batchStart += batchSize) {
+    const size_t numTrials = std::min(batchSize, stepSizes.size() - batchStart);
+    runStatistics().numLineSearchTrials += numTrials;
+
+    // Compute steps
+    xNew.resize(numTrials, vector_array_t(x.size()));
+    uNew.resize(numTrials, vector_array_t(u.size()));
+    for (size_t j = 0; j < numTrials; j++) {
+      const scalar_t alpha = stepSizes[batchStart + j];
+      for (int i = 0; i < u.size(); i++) {
+        if (du[i].size() > 0) {  // account for absence of inputs at events.
+          uNew[j][i] = u[i] + alpha * du[i];
+        }
+      }
+      for (int i = 0; i < x.size(); i++) {
+        xNew[j][i] = x[i] + alpha * dx[i];
+      }
     }
 
     // Compute cost and constraints
-    const PerformanceIndex performanceNew = computePerformance(timeDiscretization, initState, xNew, uNew);
-    const scalar_t newConstraintViolation = totalConstraintViolation(performanceNew);
-
-    // Step acceptance and record step type
-    const bool stepAccepted = [&]() {
-      if (newConstraintViolation > settings_.g_max) {
-        // High constraint violation. Only accept decrease in constraints.
-        stepInfo.stepType = StepType::CONSTRAINT;
-        return newConstraintViolation < ((1.0 - settings_.gamma_c) * baselineConstraintViolation);
-      } else if (newConstraintViolation < settings_.g_min && baselineConstraintViolation < settings_.g_min &&
-                 subproblemSolution.armijoDescentMetric < 0.0) {
-        // With low violation and having a descent direction, require the armijo condition.
-        stepInfo.stepType = StepType::COST;
-        return performanceNew.merit < (baseline.merit + settings_.armijoFactor * alpha * subproblemSolution.armijoDescentMetric);
-      } else {
-        // Medium violation: either merit or constraints decrease (with small gamma_c mixing of old constraints)
-        stepInfo.stepType = StepType::DUAL;
-        return performanceNew.merit < (baseline.merit - settings_.gamma_c * baselineConstraintViolation) ||
-               newConstraintViolation < ((1.0 - settings_.gamma_c) * baselineConstraintViolation);
-      }
-    }();
-
-    if (settings_.printLinesearch) {
-      std::cerr << "Step size: " << alpha << ", Step Type: " << toString(stepInfo.stepType)
-                << (stepAccepted ? std::string{" (Accepted)"} : std::string{" (Rejected)"}) << "\n";
-      std::cerr << "|dx| = " << alpha * deltaXnorm << "\t|du| = " << alpha * deltaUnorm << "\n";
-      std::cerr << performanceNew << "\n";
-    }
-
-    if (stepAccepted) {  // Return if step accepted
-      x = std::move(xNew);
-      u = std::move(uNew);
-
-      stepInfo.stepSize = alpha;
-      stepInfo.dx_norm = alpha * deltaXnorm;
-      stepInfo.du_norm = alpha * deltaUnorm;
-      stepInfo.performanceAfterStep = performanceNew;
-      stepInfo.totalConstraintViolationAfterStep = newConstraintViolation;
-      return stepInfo;
-    } else {  // Try smaller step
-      alpha *= settings_.alpha_decay;
-
-      // Detect too small step size during back-tracking to escape early. Prevents going all the way to alpha_min
-      if (alpha * deltaXnorm < settings_.deltaTol && alpha * deltaUnorm < settings_.deltaTol) {
-        if (settings_.printLinesearch) {
-          std::cerr << "Exiting linesearch early due to too small primal steps |dx|: " << alpha * deltaXnorm
-                    << ", and or |du|: " << alpha * deltaUnorm << " are below deltaTol: " << settings_.deltaTol << "\n";
+    const auto performanceTrials = computePerformance(timeDiscretization, initState, xNew, uNew);
+
+    for (size_t j = 0; j < numTrials; j++) {
+      const scalar_t alpha = stepSizes[batchStart + j];
+      const PerformanceIndex& performanceNew = performanceTrials[j];
+      const scalar_t newConstraintViolation = totalConstraintViolation(performanceNew);
+
+      // Step acceptance and record step type
+      const bool stepAccepted = [&]() {
+        if (newConstraintViolation > settings_.g_max) {
+          // High constraint violation. Only accept decrease in constraints.
+          stepInfo.stepType = StepType::CONSTRAINT;
+          return newConstraintViolation < ((1.0 - settings_.gamma_c) * baselineConstraintViolation);
+        } else if (newConstraintViolation < settings_.g_min && baselineConstraintViolation < settings_.g_min &&
+                   subproblemSolution.armijoDescentMetric < 0.0) {
+          // With low violation and having a descent direction, require the armijo condition.
+          stepInfo.stepType = StepType::COST;
+          return performanceNew.merit < (baseline.merit + settings_.armijoFactor * alpha * subproblemSolution.armijoDescentMetric);
+        } else {
+          // Medium violation: either merit or constraints decrease (with small gamma_c mixing of old constraints)
+          stepInfo.stepType = StepType::DUAL;
+          return performanceNew.merit < (baseline.merit - settings_.gamma_c * baselineConstraintViolation) ||
+                 newConstraintViolation < ((1.0 - settings_.gamma_c) * baselineConstraintViolation);
         }
-        break;
+      }();
+
+      if (settings_.printLinesearch) {
+        std::cerr << "Step size: " << alpha << ", Step Type: " << toString(stepInfo.stepType)
+                  << (stepAccepted ? std::string{" (Accepted)"} : std::string{" (Rejected)"}) << "\n";
+        std::cerr << "|dx| = " << alpha * deltaXnorm << "\t|du| = " << alpha * deltaUnorm << "\n";
+        std::cerr << performanceNew << "\n";
+      }
+
+      if (stepAccepted) {  // Return if step accepted
+        x = std::move(xNew[j]);
+        u = std::move(uNew[j]);
+
+        stepInfo.stepSize = alpha;
+        stepInfo.dx_norm = alpha * deltaXnorm;
+        stepInfo.du_norm = alpha * deltaUnorm;
+        stepInfo.performanceAfterStep = performanceNew;
+        stepInfo.totalConstraintViolationAfterStep = newConstraintViolation;
+        return stepInfo;
       }
     }
-  } while (alpha >= settings_.alpha_min);
+  }
+
+  // Detect too small step size during back-tracking to escape early. Prevents going all the way to alpha_min
+  if (isPrimalStepTooSmall && settings_.printLinesearch) {
+    const scalar_t alpha = stepSizes.back() * settings_.alpha_decay;
+    std::cerr << "Exiting linesearch early due to too small primal steps |dx|: " << alpha * deltaXnorm
+              << ", and or |du|: " << alpha * deltaUnorm << " are below deltaTol: " << settings_.deltaTol << "\n";
+  }
 
   // Alpha_min reached -> Don't take a step
   stepInfo.stepSize = 0.0;
@@ -59,6 +59,10 @@ std::string toString(const Convergence& convergence) {
       return "Cost decrease and constraint satisfaction below tolerance";
     case Convergence::PRIMAL:
       return "Primal update below tolerance";
+    case Convergence::DEADLINE:
+      return "Deadline reached";
+    case Convergence::LINEAR_QUADRATIC:
+      return "Linear-quadratic problem solved by a single QP";
     case Convergence::FALSE:
     default:
       return "Not Converged";
@@ -29,24 +29,54 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_sqp/MultipleShootingTranscription.h"
 
-#include <ocs2_oc/approximate_model/ChangeOfInputVariables.h>
+#include <ocs2_core/misc/LinearAlgebra.h>
 #include <ocs2_oc/approximate_model/LinearQuadraticApproximator.h>
 
-#include "ocs2_sqp/ConstraintProjection.h"
+#include "ocs2_sqp/FixedSizeProjection.h"
 
 namespace ocs2 {
 namespace multiple_shooting {
 
+namespace {
+
+/** Adds the second order terms of hessian to the cost and lifts the eigenvalues of the combined state-input Hessian to minEigenvalue */
+void addRegularizedHessian(const ScalarFunctionQuadraticApproximation& hessian, scalar_t minEigenvalue,
+                           ScalarFunctionQuadraticApproximation& cost) {
+  const auto nx = cost.dfdxx.rows();
+  const auto nu = cost.dfduu.rows();
+  matrix_t stateInputHessian(nx + nu, nx + nu);
+  stateInputHessian.topLeftCorner(nx, nx) = cost.dfdxx + hessian.dfdxx;
+  stateInputHessian.bottomLeftCorner(nu, nx) = cost.dfdux + hessian.dfdux;
+  stateInputHessian.topRightCorner(nx, nu) = stateInputHessian.bottomLeftCorner(nu, nx).transpose();
+  stateInputHessian.bottomRightCorner(nu, nu) = cost.dfduu + hessian.dfduu;
+
+  LinearAlgebra::makePsdEigenvalue(stateInputHessian, minEigenvalue);
+
+  cost.dfdxx = stateInputHessian.topLeftCorner(nx, nx);
+  cost.dfdux = stateInputHessian.bottomLeftCorner(nu, nx);
+  cost.dfduu = stateInputHessian.bottomRightCorner(nu, nu);
+}
+
+/** Squared norm of the violation of the inequality constraints h >= 0 */
+scalar_t getInequalityViolationSquaredNorm(const vector_t& h) {
+  return h.cwiseMin(0.0).squaredNorm();
+}
+
+}  // namespace
+
 Transcription setupIntermediateNode(const OptimalControlProblem& optimalControlProblem,
                                     DynamicsSensitivityDiscretizer& sensitivityDiscretizer, bool projectStateInputEqualityConstraints,
-                                    scalar_t t, scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u) {
+                                    scalar_t t, scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u,
+                                    const vector_t& costate, scalar_t minHessianEigenvalue) {
   // Results and short-hand notation
   Transcription transcription;
   auto& dynamics = transcription.dynamics;
   auto& performance = transcription.performance;
+  auto& metrics = transcription.metrics;
   auto& cost = transcription.cost;
   auto& constraints = transcription.constraints;
   auto& projection = transcription.constraintsProjection;
+  auto& inequalityConstraints = transcription.inequalityConstraints;
 
   // Dynamics
   // Discretization returns x_{k+1} = A_{k} * dx_{k} + B_{k} * du_{k} + b_{k}
@@ -60,23 +90,44 @@ Transcription setupIntermediateNode(const OptimalControlProblem& optimalControlP
 
   // Costs: Approximate the integral with forward euler
   cost = approximateCost(optimalControlProblem, t, x, u);
+  metrics.cost = cost.f;
   cost *= dt;
   performance.cost = cost.f;
 
+  // Lagrangian Hessian: curvature of the dynamics, where the discrete dynamics are approximated with x + dt * f(t, x, u)
+  if (costate.size() > 0) {
+    const auto dynamicsHessian = optimalControlProblem.dynamicsPtr->flowMapWeightedHessian(t, x, u, dt * costate);
+    addRegularizedHessian(dynamicsHessian, minHessianEigenvalue, cost);
+  }
+
+  // Inequality constraints, the violation is accounted for as constraint violation
+  if (!optimalControlProblem.inequalityConstraintPtr->empty()) {
+    // C_{k} * dx_{k} + D_{k} * du_{k} + h_{k} >= 0
+    inequalityConstraints =
+        optimalControlProblem.inequalityConstraintPtr->getLinearApproximation(t, x, u, *optimalControlProblem.preComputationPtr);
+    performance.equalityConstraintsSSE += dt * getInequalityViolationSquaredNorm(inequalityConstraints.f);
+  }
+
   // Constraints
   if (!optimalControlProblem.equalityConstraintPtr->empty()) {
     // C_{k} * dx_{k} + D_{k} * du_{k} + e_{k} = 0
     constraints = optimalControlProblem.equalityConstraintPtr->getLinearApproximation(t, x, u, *optimalControlProblem.preComputationPtr);
     if (constraints.f.size() > 0) {
-      performance.equalityConstraintsSSE = dt * constraints.f.squaredNorm();
+      performance.equalityConstraintsSSE += dt * constraints.f.squaredNorm();
+      metrics.stateInputEqConstraint = constraints.f;
       if (projectStateInputEqualityConstraints) {  // Handle equality constraints using projection.
-        // Projection stored instead of constraint, // TODO: benchmark between lu and qr method. LU seems slightly faster.
-        projection = luConstraintProjection(constraints);
+        // Projection stored instead of constraint, dynamics and cost are adapted in-place
+        const auto projectIntermediateNodeImpl = selectProjectionFunction(x.size(), u.size());
+        projectIntermediateNodeImpl(constraints, dynamics, cost, projection);
         constraints = VectorFunctionLinearApproximation();
 
-        // Adapt dynamics and cost
-        changeOfInputVariables(dynamics, projection.dfdu, projection.dfdx, projection.f);
-        changeOfInputVariables(cost, projection.dfdu, projection.dfdx, projection.f);
+        // Substitute du_{k} = Px_{k} * dx_{k} + Pu_{k} * du_tilde_{k} + Pe_{k} in the inequality constraints
+        if (inequalityConstraints.f.size() > 0) {
+          inequalityConstraints.f.noalias() += inequalityConstraints.dfdu * projection.f;
+          inequalityConstraints.dfdx.noalias() += inequalityConstraints.dfdu * projection.dfdx;
+          const matrix_t dfdu = inequalityConstraints.dfdu * projection.dfdu;
+          inequalityConstraints.dfdu = dfdu;
+        }
       }
     }
   }
@@ -85,7 +136,8 @@ Transcription setupIntermediateNode(const OptimalControlProblem& optimalControlP
 }
 
 PerformanceIndex computeIntermediatePerformance(const OptimalControlProblem& optimalControlProblem, DynamicsDiscretizer& discretizer,
-                                                scalar_t t, scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u) {
+                                                scalar_t t, scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u,
+                                                MetricsCollection* metricsPtr) {
   PerformanceIndex performance;
 
   // Dynamics
@@ -98,16 +150,31 @@ PerformanceIndex computeIntermediatePerformance(const OptimalControlProblem& opt
   optimalControlProblem.preComputationPtr->request(request, t, x, u);
 
   // Costs
-  performance.cost = dt * computeCost(optimalControlProblem, t, x, u);
+  const scalar_t cost = computeCost(optimalControlProblem, t, x, u);
+  performance.cost = dt * cost;
+
+  // Inequality constraints
+  if (!optimalControlProblem.inequalityConstraintPtr->empty()) {
+    const vector_t inequalityConstraints =
+        optimalControlProblem.inequalityConstraintPtr->getValue(t, x, u, *optimalControlProblem.preComputationPtr);
+    performance.equalityConstraintsSSE += dt * getInequalityViolationSquaredNorm(inequalityConstraints);
+  }
 
   // Constraints
+  vector_t constraints;
   if (!optimalControlProblem.equalityConstraintPtr->empty()) {
-    const vector_t constraints = optimalControlProblem.equalityConstraintPtr->getValue(t, x, u, *optimalControlProblem.preComputationPtr);
+    constraints = optimalControlProblem.equalityConstraintPtr->getValue(t, x, u, *optimalControlProblem.preComputationPtr);
     if (constraints.size() > 0) {
-      performance.equalityConstraintsSSE = dt * constraints.squaredNorm();
+      performance.equalityConstraintsSSE += dt * constraints.squaredNorm();
     }
   }
 
+  if (metricsPtr != nullptr) {
+    metricsPtr->clear();
+    metricsPtr->cost = cost;
+    metricsPtr->stateInputEqConstraint = std::move(constraints);
+  }
+
   return performance;
 }
 
@@ -115,6 +182,7 @@ TerminalTranscription setupTerminalNode(const OptimalControlProblem& optimalCont
   // Results and short-hand notation
   TerminalTranscription transcription;
   auto& performance = transcription.performance;
+  auto& metrics = transcription.metrics;
   auto& cost = transcription.cost;
   auto& constraints = transcription.constraints;
 
@@ -123,13 +191,15 @@ TerminalTranscription setupTerminalNode(const OptimalControlProblem& optimalCont
 
   cost = approximateFinalCost(optimalControlProblem, t, x);
   performance.cost = cost.f;
+  metrics.cost = cost.f;
 
   constraints = VectorFunctionLinearApproximation::Zero(0, x.size());
 
   return transcription;
 }
 
-PerformanceIndex computeTerminalPerformance(const OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x) {
+PerformanceIndex computeTerminalPerformance(const OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x,
+                                            MetricsCollection* metricsPtr) {
   PerformanceIndex performance;
 
   constexpr auto request = Request::Cost + Request::SoftConstraint;
@@ -137,6 +207,11 @@ PerformanceIndex computeTerminalPerformance(const OptimalControlProblem& optimal
 
   performance.cost = computeFinalCost(optimalControlProblem, t, x);
 
+  if (metricsPtr != nullptr) {
+    metricsPtr->clear();
+    metricsPtr->cost = performance.cost;
+  }
+
   return performance;
 }
 
@@ -145,6 +220,7 @@ EventTranscription setupEventNode(const OptimalControlProblem& optimalControlPro
   // Results and short-hand notation
   EventTranscription transcription;
   auto& performance = transcription.performance;
+  auto& metrics = transcription.metrics;
   auto& dynamics = transcription.dynamics;
   auto& cost = transcription.cost;
   auto& constraints = transcription.constraints;
@@ -161,13 +237,14 @@ EventTranscription setupEventNode(const OptimalControlProblem& optimalControlPro
 
   cost = approximateEventCost(optimalControlProblem, t, x);
   performance.cost = cost.f;
+  metrics.cost = cost.f;
 
   constraints = VectorFunctionLinearApproximation::Zero(0, x.size());
   return transcription;
 }
 
 PerformanceIndex computeEventPerformance(const OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x,
-                                         const vector_t& x_next) {
+                                         const vector_t& x_next, MetricsCollection* metricsPtr) {
   PerformanceIndex performance;
 
   constexpr auto request = Request::Cost + Request::SoftConstraint + Request::Dynamics;
@@ -179,6 +256,11 @@ PerformanceIndex computeEventPerformance(const OptimalControlProblem& optimalCon
 
   performance.cost = computeEventCost(optimalControlProblem, t, x);
 
+  if (metricsPtr != nullptr) {
+    metricsPtr->clear();
+    metricsPtr->cost = performance.cost;
+  }
+
   return performance;
 }
 
@@ -29,10 +29,38 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_sqp/TimeDiscretization.h"
 
+#include <algorithm>
+
 #include <ocs2_core/misc/Lookup.h>
 
 namespace ocs2 {
 
+namespace {
+
+/** Changes an event at the beginning of the horizon to a post event and adds a post event after all other pre events */
+std::vector<AnnotatedTime> addPostEvents(std::vector<AnnotatedTime>& timeDiscretization) {
+  // Skip events at beginning of horizon
+  if (timeDiscretization.front().event == AnnotatedTime::Event::PreEvent) {
+    timeDiscretization.front().event = AnnotatedTime::Event::PostEvent;
+  }
+
+  // Duplicate all preEvents to postEvents
+  std::vector<AnnotatedTime> timeDiscretizationWithDoubleEvents;
+  timeDiscretizationWithDoubleEvents.reserve(2 * timeDiscretization.size());  // upper bound on size
+
+  for (const auto& t : timeDiscretization) {
+    timeDiscretizationWithDoubleEvents.push_back(t);
+    if (t.event == AnnotatedTime::Event::PreEvent) {
+      timeDiscretizationWithDoubleEvents.push_back(t);
+      timeDiscretizationWithDoubleEvents.back().event = AnnotatedTime::Event::PostEvent;
+    }
+  }
+
+  return timeDiscretizationWithDoubleEvents;
+}
+
+}  // namespace
+
 scalar_t getInterpolationTime(const AnnotatedTime& annotatedTime) {
   return annotatedTime.time + numeric_traits::limitEpsilon<scalar_t>();
 }
@@ -93,24 +121,99 @@ std::vector<AnnotatedTime> timeDiscretizationWithEvents(scalar_t initTime, scala
     }
   }
 
-  // Skip events at beginning of horizon
-  if (timeDiscretization.front().event == AnnotatedTime::Event::PreEvent) {
-    timeDiscretization.front().event = AnnotatedTime::Event::PostEvent;
+  return addPostEvents(timeDiscretization);
+}
+
+std::vector<AnnotatedTime> blockedTimeDiscretizationWithEvents(scalar_t initTime, scalar_t finalTime, scalar_t dt,
+                                                               const std::vector<size_t>& inputBlocking, const scalar_array_t& eventTimes,
+                                                               scalar_t dt_min) {
+  assert(dt > 0);
+  assert(finalTime > initTime);
+  assert(!inputBlocking.empty());
+  std::vector<AnnotatedTime> timeDiscretization;
+
+  // Initialize
+  timeDiscretization.emplace_back(initTime, AnnotatedTime::Event::None);
+  size_t nextEventIdx = lookup::findIndexInTimeArray(eventTimes, initTime);
+
+  // Fill iteratively with pre event, post events are added later
+  AnnotatedTime nextNode = timeDiscretization.back();
+  while (timeDiscretization.back().time < finalTime) {
+    const size_t blockIdx = std::min(timeDiscretization.size() - 1, inputBlocking.size() - 1);
+    nextNode.time = nextNode.time + inputBlocking[blockIdx] * dt;
+    nextNode.event = AnnotatedTime::Event::None;
+
+    // Check if an event has passed
+    if (nextEventIdx < eventTimes.size() && nextNode.time >= eventTimes[nextEventIdx]) {
+      nextNode.time = eventTimes[nextEventIdx];
+      nextNode.event = AnnotatedTime::Event::PreEvent;
+      nextEventIdx++;
+    }
+
+    // Check if final time has passed
+    if (nextNode.time >= finalTime) {
+      nextNode.time = finalTime;
+      nextNode.event = AnnotatedTime::Event::None;
+    }
+
+    if (nextNode.time > timeDiscretization.back().time + dt_min) {
+      timeDiscretization.push_back(nextNode);
+    } else {  // Points are close together -> overwrite the old point
+      timeDiscretization.back() = nextNode;
+    }
   }
 
-  // Duplicate all preEvents to postEvents
-  std::vector<AnnotatedTime> timeDiscretizationWithDoubleEvents;
-  timeDiscretizationWithDoubleEvents.reserve(2 * timeDiscretization.size());  // upper bound on size
+  return addPostEvents(timeDiscretization);
+}
 
-  for (const auto& t : timeDiscretization) {
-    timeDiscretizationWithDoubleEvents.push_back(t);
-    if (t.event == AnnotatedTime::Event::PreEvent) {
-      timeDiscretizationWithDoubleEvents.push_back(t);
-      timeDiscretizationWithDoubleEvents.back().event = AnnotatedTime::Event::PostEvent;
+std::vector<AnnotatedTime> shiftTimeDiscretizationWithEvents(scalar_t initTime, scalar_t finalTime, scalar_t dt, scalar_t dtFinal,
+                                                             const scalar_array_t& eventTimes, const scalar_array_t& previousTimes,
+                                                             scalar_t dt_min) {
+  assert(dt > 0);
+  assert(finalTime > initTime);
+  const scalar_t dtGrowthRate = std::max(dtFinal - dt, scalar_t(0.0)) / (finalTime - initTime);
+  std::vector<AnnotatedTime> timeDiscretization;
+
+  // Initialize
+  timeDiscretization.emplace_back(initTime, AnnotatedTime::Event::None);
+  size_t nextEventIdx = lookup::findIndexInTimeArray(eventTimes, initTime);
+  size_t previousIdx = lookup::findIndexInTimeArray(previousTimes, initTime);
+
+  // Fill iteratively with pre event, post events are added later
+  while (timeDiscretization.back().time < finalTime) {
+    const scalar_t currentTime = timeDiscretization.back().time;
+    const scalar_t step = dt + dtGrowthRate * (currentTime - initTime);
+    AnnotatedTime nextNode(currentTime + step, AnnotatedTime::Event::None);
+
+    // Reuse the first previous node that is at least half a step ahead, if it is not further than one and a half steps
+    while (previousIdx < previousTimes.size() && previousTimes[previousIdx] < currentTime + 0.5 * step) {
+      previousIdx++;
+    }
+    if (previousIdx < previousTimes.size() && previousTimes[previousIdx] <= currentTime + 1.5 * step) {
+      nextNode.time = previousTimes[previousIdx];
+    }
+
+    // Check if an event has passed
+    if (nextEventIdx < eventTimes.size() && nextNode.time >= eventTimes[nextEventIdx]) {
+      nextNode.time = eventTimes[nextEventIdx];
+      nextNode.event = AnnotatedTime::Event::PreEvent;
+      nextEventIdx++;
+    }
+
+    // Check if final time has passed
+    if (nextNode.time >= finalTime) {
+      nextNode.time = finalTime;
+      nextNode.event = AnnotatedTime::Event::None;
+    }
+
+    if (nextNode.time > timeDiscretization.back().time + dt_min) {
+      timeDiscretization.push_back(nextNode);
+    } else {  // Points are close together -> overwrite the old point
+      timeDiscretization.back() = nextNode;
     }
   }
 
-  return timeDiscretizationWithDoubleEvents;
+  return addPostEvents(timeDiscretization);
 }
 
 }  // namespace ocs2
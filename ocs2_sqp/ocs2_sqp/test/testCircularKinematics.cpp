@@ -140,4 +140,53 @@ TEST(test_circular_kinematics, solve_EqConstraints_inQPSubproblem) {
     // Feed forward part
     ASSERT_TRUE(u.isApprox(primalSolution.controllerPtr_->computeInput(t, x)));
   }
+
+  // Check dual solution and metrics, which are given at the time discretization of the primal solution
+  const auto& dualSolution = solver.getDualSolution();
+  const auto& metrics = solver.getSolutionMetrics();
+  ASSERT_EQ(dualSolution.timeTrajectory, primalSolution.timeTrajectory_);
+  ASSERT_EQ(dualSolution.intermediates.size(), primalSolution.timeTrajectory_.size());
+  ASSERT_EQ(metrics.intermediates.size(), primalSolution.timeTrajectory_.size());
+  for (int i = 0; i < primalSolution.timeTrajectory_.size(); i++) {
+    ASSERT_EQ(dualSolution.intermediates[i].stateInputEq.size(), 1);
+    ASSERT_EQ(dualSolution.intermediates[i].stateInputEq.front().lagrangian.size(), 1);
+    ASSERT_LT(metrics.intermediates[i].stateInputEqConstraint.norm(), 1e-3);
+  }
+  const auto multipliers = solver.getIntermediateDualSolution(0.5 * (startTime + finalTime));
+  ASSERT_EQ(multipliers.stateInputEq.size(), 1);
+}
+
+TEST(test_circular_kinematics, parallel_linesearch) {
+  ocs2::OptimalControlProblem problem = ocs2::createCircularKinematicsProblem("/tmp/ocs2/sqp_test_generated");
+  ocs2::DefaultInitializer zeroInitializer(2);
+
+  ocs2::multiple_shooting::Settings settings;
+  settings.dt = 0.01;
+  settings.sqpIteration = 20;
+  settings.nThreads = 4;
+  ocs2::multiple_shooting::Settings parallelSettings = settings;
+  parallelSettings.numLinesearchTrials = 3;
+
+  const ocs2::scalar_t startTime = 0.0;
+  const ocs2::scalar_t finalTime = 1.0;
+  const ocs2::vector_t initState = (ocs2::vector_t(2) << 1.0, 0.0).finished();  // radius 1.0
+
+  ocs2::MultipleShootingSolver solver(settings, problem, zeroInitializer);
+  solver.run(startTime, initState, finalTime);
+  ocs2::MultipleShootingSolver parallelSolver(parallelSettings, problem, zeroInitializer);
+  parallelSolver.run(startTime, initState, finalTime);
+
+  // The largest accepted step size of a batch is the one the sequential backtracking accepts first.
+  const auto& iterations = solver.getIterationsLog();
+  const auto& parallelIterations = parallelSolver.getIterationsLog();
+  ASSERT_EQ(iterations.size(), parallelIterations.size());
+  for (int i = 0; i < iterations.size(); i++) {
+    ASSERT_NEAR(iterations[i].merit, parallelIterations[i].merit, 1e-9);
+  }
+  const auto primalSolution = solver.primalSolution(finalTime);
+  const auto parallelPrimalSolution = parallelSolver.primalSolution(finalTime);
+  for (int i = 0; i < primalSolution.timeTrajectory_.size(); i++) {
+    ASSERT_TRUE(primalSolution.stateTrajectory_[i].isApprox(parallelPrimalSolution.stateTrajectory_[i]));
+    ASSERT_TRUE(primalSolution.inputTrajectory_[i].isApprox(parallelPrimalSolution.inputTrajectory_[i]));
+  }
 }
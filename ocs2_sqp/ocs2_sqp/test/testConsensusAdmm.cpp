@@ -0,0 +1,120 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "ocs2_sqp/ConsensusAdmm.h"
+
+#include <ocs2_core/constraint/LinearStateConstraint.h>
+#include <ocs2_core/cost/QuadraticStateCost.h>
+#include <ocs2_core/cost/QuadraticStateInputCost.h>
+#include <ocs2_core/dynamics/LinearSystemDynamics.h>
+#include <ocs2_core/initialization/DefaultInitializer.h>
+#include <ocs2_core/misc/LinearInterpolation.h>
+#include <ocs2_oc/synchronized_module/ReferenceManager.h>
+
+namespace ocs2 {
+namespace {
+
+constexpr int n = 2;
+constexpr int m = 2;
+
+/** A single integrator which tracks its own target. */
+OptimalControlProblem getAgentProblem() {
+  OptimalControlProblem problem;
+  problem.dynamicsPtr.reset(new LinearSystemDynamics(matrix_t::Zero(n, n), matrix_t::Identity(n, m)));
+  problem.costPtr->add("trackingCost", std::unique_ptr<StateInputCost>(new QuadraticStateInputCost(
+                                           matrix_t::Identity(n, n), 0.1 * matrix_t::Identity(m, m))));
+  problem.finalCostPtr->add("finalCost", std::unique_ptr<StateCost>(new QuadraticStateCost(matrix_t::Identity(n, n))));
+  return problem;
+}
+
+}  // namespace
+}  // namespace ocs2
+
+TEST(test_consensus_admm, agentsReachConsensus) {
+  using namespace ocs2;
+
+  consensus_admm::Settings admmSettings;
+  admmSettings.maxNumIterations = 50;
+  admmSettings.penalty = 10.0;
+  admmSettings.primalTolerance = 1e-3;
+  admmSettings.dualTolerance = 1e-3;
+  admmSettings.timeStep = 0.1;
+  admmSettings.nThreads = 2;
+  ConsensusAdmm admm(admmSettings);
+
+  multiple_shooting::Settings sqpSettings;
+  sqpSettings.dt = 0.05;
+  sqpSettings.sqpIteration = 5;
+  sqpSettings.nThreads = 1;
+  sqpSettings.printSolverStatistics = false;
+  sqpSettings.printSolverStatus = false;
+  sqpSettings.printLinesearch = false;
+
+  // the agents track different targets, while their states are coupled by consensus
+  const DefaultInitializer initializer(m);
+  const LinearStateConstraint coupling(vector_t::Zero(n), matrix_t::Identity(n, n));
+  const vector_array_t targets{(vector_t(n) << 1.0, 0.0).finished(), (vector_t(n) << -0.5, 0.5).finished()};
+  for (const auto& target : targets) {
+    const auto agentIndex = admm.addAgent(sqpSettings, getAgentProblem(), initializer, coupling);
+    admm.getSolver(agentIndex).setReferenceManager(
+        std::make_shared<ReferenceManager>(TargetTrajectories({0.0}, {target}, {vector_t::Zero(m)})));
+  }
+  ASSERT_EQ(admm.getNumAgents(), 2);
+
+  const scalar_t initTime = 0.0;
+  const scalar_t finalTime = 1.0;
+  const vector_array_t initStates{vector_t::Zero(n), vector_t::Zero(n)};
+  admm.run(initTime, initStates, finalTime);
+
+  EXPECT_LT(admm.getNumIterations(), admmSettings.maxNumIterations);
+  EXPECT_LT(admm.getPrimalResidual(), admmSettings.primalTolerance);
+  EXPECT_LT(admm.getDualResidual(), admmSettings.dualTolerance);
+
+  // the states of the agents agree with the consensus, which lies between the targets
+  const auto& timeTrajectory = admm.getConsensusTimeTrajectory();
+  const auto& consensusTrajectory = admm.getConsensusTrajectory();
+  ASSERT_EQ(consensusTrajectory.size(), timeTrajectory.size());
+  for (size_t i = 0; i < admm.getNumAgents(); i++) {
+    const auto primalSolution = admm.getSolver(i).primalSolution(finalTime);
+    for (size_t k = 0; k < timeTrajectory.size(); k++) {
+      const vector_t state =
+          LinearInterpolation::interpolate(timeTrajectory[k], primalSolution.timeTrajectory_, primalSolution.stateTrajectory_);
+      EXPECT_TRUE(state.isApprox(consensusTrajectory[k], 1e-2) || (state - consensusTrajectory[k]).norm() < 1e-3);
+    }
+  }
+  const vector_t targetAverage = 0.5 * (targets[0] + targets[1]);
+  EXPECT_GT(consensusTrajectory.back().dot(targetAverage), 0.0);
+
+  // a run of the same problem is warm started with the consensus and the multipliers
+  const auto numIterations = admm.getNumIterations();
+  admm.run(initTime, initStates, finalTime);
+  EXPECT_LT(admm.getNumIterations(), numIterations);
+}
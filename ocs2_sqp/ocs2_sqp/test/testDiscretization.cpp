@@ -127,4 +127,98 @@ TEST(test_discretization, withEvents) {
   ASSERT_EQ(time[12].event, AnnotatedTime::Event::PreEvent);
   ASSERT_EQ(time[13].event, AnnotatedTime::Event::PostEvent);
   ASSERT_EQ(time[14].event, AnnotatedTime::Event::None);
-}
\ No newline at end of file
+}
+
+TEST(test_discretization, blocked_with_events) {
+  const scalar_t initTime = 0.0;
+  const scalar_t finalTime = 1.0;
+  const scalar_t dt = 0.1;
+  const std::vector<size_t> inputBlocking{1, 1, 2, 3};
+  const scalar_array_t eventTimes{0.5};
+
+  // The single step blocking is the uniform discretization
+  const auto uniform = timeDiscretizationWithEvents(initTime, finalTime, dt, eventTimes);
+  const auto unblocked = blockedTimeDiscretizationWithEvents(initTime, finalTime, dt, {1}, eventTimes);
+  ASSERT_EQ(uniform.size(), unblocked.size());
+  for (int i = 0; i < uniform.size(); i++) {
+    ASSERT_EQ(uniform[i].time, unblocked[i].time);
+    ASSERT_EQ(uniform[i].event, unblocked[i].event);
+  }
+
+  // timeDiscretization = {0.0, 0.1, 0.2, 0.4, 0.5, 0.5, 0.8, 1.0}, the event shortens the fourth interval
+  const auto time = blockedTimeDiscretizationWithEvents(initTime, finalTime, dt, inputBlocking, eventTimes);
+  ASSERT_EQ(time.size(), 8);
+  ASSERT_EQ(time[0].time, initTime);
+  ASSERT_DOUBLE_EQ(time[1].time, dt);
+  ASSERT_DOUBLE_EQ(time[2].time, 2.0 * dt);
+  ASSERT_DOUBLE_EQ(time[3].time, 4.0 * dt);
+  ASSERT_EQ(time[4].time, eventTimes[0]);
+  ASSERT_EQ(time[4].event, AnnotatedTime::Event::PreEvent);
+  ASSERT_EQ(time[5].time, eventTimes[0]);
+  ASSERT_EQ(time[5].event, AnnotatedTime::Event::PostEvent);
+  ASSERT_DOUBLE_EQ(time[6].time, eventTimes[0] + 3.0 * dt);
+  ASSERT_EQ(time[7].time, finalTime);
+}
+
+TEST(test_discretization, shift_reuses_previous_nodes) {
+  const scalar_t dt = 0.1;
+  const scalar_t horizon = 1.0;
+  const scalar_array_t eventTimes{};
+
+  const auto previous = timeDiscretizationWithEvents(0.0, horizon, dt, eventTimes);
+  scalar_array_t previousTimes;
+  for (const auto& t : previous) {
+    previousTimes.push_back(t.time);
+  }
+
+  // All previous nodes within the new horizon are reused, apart from the first one if it is too close to the new initial time.
+  for (const scalar_t initTime : {0.03, 0.07}) {
+    const auto time = shiftTimeDiscretizationWithEvents(initTime, initTime + horizon, dt, dt, eventTimes, previousTimes);
+    const int numDropped = (initTime > 0.5 * dt) ? 1 : 0;
+    ASSERT_EQ(time.size(), previous.size() + 1 - numDropped);
+    ASSERT_EQ(time.front().time, initTime);
+    ASSERT_EQ(time.back().time, initTime + horizon);
+    for (int i = 1; i + 1 < time.size(); i++) {
+      ASSERT_EQ(time[i].time, previousTimes[i + numDropped]);
+      ASSERT_EQ(time[i].event, AnnotatedTime::Event::None);
+    }
+  }
+}
+
+TEST(test_discretization, shift_nonuniform_with_events) {
+  const scalar_t initTime = 0.0;
+  const scalar_t finalTime = 1.0;
+  const scalar_t dt = 0.01;
+  const scalar_t dtFinal = 0.05;
+  const scalar_array_t eventTimes{0.5};
+  auto desiredStep = [&](scalar_t t, scalar_t t0) { return dt + (dtFinal - dt) * (t - t0) / (finalTime - initTime); };
+
+  const auto uniform = timeDiscretizationWithEvents(initTime, finalTime, dt, eventTimes);
+  const auto time = shiftTimeDiscretizationWithEvents(initTime, finalTime, dt, dtFinal, eventTimes, scalar_array_t());
+  ASSERT_LT(time.size(), 0.6 * uniform.size());
+  ASSERT_EQ(time.back().time, finalTime);
+
+  // The desired step is taken, apart from the intervals which are cut short by the event and the final time.
+  int numEvents = 0;
+  for (int i = 0; i + 1 < time.size(); i++) {
+    if (time[i].event == AnnotatedTime::Event::PreEvent) {
+      ASSERT_EQ(time[i].time, eventTimes[0]);
+      ASSERT_EQ(time[i + 1].event, AnnotatedTime::Event::PostEvent);
+      ++numEvents;
+    } else if (time[i + 1].event == AnnotatedTime::Event::None && i + 2 < time.size()) {
+      ASSERT_NEAR(time[i + 1].time - time[i].time, desiredStep(time[i].time, initTime), 1e-12);
+    }
+  }
+  ASSERT_EQ(numEvents, 1);
+
+  // Shifting the non-uniform discretization refines the nodes that move to the start of the horizon
+  scalar_array_t previousTimes;
+  for (const auto& t : time) {
+    previousTimes.push_back(t.time);
+  }
+  const scalar_t shiftedInitTime = 0.2;
+  const auto shifted = shiftTimeDiscretizationWithEvents(shiftedInitTime, shiftedInitTime + 1.0, dt, dtFinal, eventTimes, previousTimes);
+  for (int i = 0; i + 1 < shifted.size(); i++) {
+    ASSERT_LE(shifted[i + 1].time - shifted[i].time, 1.5 * desiredStep(shifted[i].time, shiftedInitTime) + 1e-12);
+  }
+}
@@ -0,0 +1,79 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "ocs2_sqp/MultipleShootingInitialization.h"
+
+using namespace ocs2;
+
+TEST(test_initialization, shiftMultipliersInTime) {
+  const ModeSchedule modeSchedule({}, {0});
+  const scalar_array_t oldTime{0.0, 0.1, 0.2, 0.3};
+  vector_array_t oldMultipliers;
+  for (const auto t : oldTime) {
+    oldMultipliers.push_back(t * vector_t::Ones(2));
+  }
+
+  const scalar_array_t newTime{0.05, 0.15, 0.25, 0.35};
+  const auto newMultipliers = multiple_shooting::shiftMultipliers(modeSchedule, modeSchedule, oldTime, oldMultipliers, newTime);
+  ASSERT_EQ(newMultipliers.size(), newTime.size());
+  for (size_t i = 0; i < newTime.size(); ++i) {
+    // interpolated within the previous horizon, zero-order hold beyond it
+    const scalar_t expected = std::min(newTime[i], oldTime.back());
+    EXPECT_TRUE(newMultipliers[i].isApprox(expected * vector_t::Ones(2))) << "at t = " << newTime[i];
+  }
+}
+
+TEST(test_initialization, shiftMultipliersWithModeSchedule) {
+  // One multiplier before the event, two after it
+  const ModeSchedule oldModeSchedule({0.2}, {0, 1});
+  const scalar_array_t oldTime{0.0, 0.1, 0.2, 0.3, 0.4};
+  const vector_array_t oldMultipliers{vector_t::Constant(1, 1.0), vector_t::Constant(1, 1.0), vector_t::Constant(1, 1.0),
+                                      vector_t::Constant(2, 2.0), vector_t::Constant(2, 2.0)};
+
+  // The event is delayed, the nodes before the new event keep the multipliers of the first mode
+  const ModeSchedule newModeSchedule({0.3}, {0, 1});
+  const scalar_array_t newTime{0.1, 0.2, 0.25, 0.3, 0.35, 0.4};
+  const auto newMultipliers = multiple_shooting::shiftMultipliers(oldModeSchedule, newModeSchedule, oldTime, oldMultipliers, newTime);
+  ASSERT_EQ(newMultipliers.size(), newTime.size());
+  for (size_t i = 0; i < newTime.size(); ++i) {
+    const auto expected = (newTime[i] <= 0.3) ? vector_t::Constant(1, 1.0) : vector_t::Constant(2, 2.0);
+    ASSERT_EQ(newMultipliers[i].size(), expected.size()) << "at t = " << newTime[i];
+    EXPECT_TRUE(newMultipliers[i].isApprox(expected)) << "at t = " << newTime[i];
+  }
+}
+
+TEST(test_initialization, shiftMultipliersWithoutPreviousSolution) {
+  const ModeSchedule modeSchedule({}, {0});
+  const auto newMultipliers = multiple_shooting::shiftMultipliers(modeSchedule, modeSchedule, {}, {}, {0.0, 0.1});
+  ASSERT_EQ(newMultipliers.size(), 2);
+  EXPECT_EQ(newMultipliers[0].size(), 0);
+  EXPECT_EQ(newMultipliers[1].size(), 0);
+}
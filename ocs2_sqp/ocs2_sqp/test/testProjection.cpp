@@ -30,6 +30,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <gtest/gtest.h>
 
 #include "ocs2_sqp/ConstraintProjection.h"
+#include "ocs2_sqp/FixedSizeProjection.h"
 
 #include <ocs2_oc/test/testProblemsGeneration.h>
 
@@ -61,4 +62,94 @@ TEST(test_projection, testProjectionLU) {
 
   // D * Pe cancels the e term
   ASSERT_TRUE((constraint.f + constraint.dfdu * projection.f).isZero());
-}
\ No newline at end of file
+}
+TEST(test_projection, testProjectionStructured) {
+  auto constraint = ocs2::getRandomConstraints(30, 20, 10);
+  // Rows which act on a single input
+  constraint.dfdu.topRows(4).setZero();
+  constraint.dfdu(0, 3) = 2.0;
+  constraint.dfdu(1, 7) = -1.0;
+  constraint.dfdu(2, 11) = 0.5;
+  constraint.dfdu(3, 15) = 3.0;
+
+  ocs2::VectorFunctionLinearApproximation projection;
+  ocs2::structuredConstraintProjection(constraint, projection);
+  ASSERT_EQ(projection.dfdu.rows(), 20);
+  ASSERT_EQ(projection.dfdu.cols(), 10);
+
+  // range of Pu is in null-space of D
+  ASSERT_TRUE((constraint.dfdu * projection.dfdu).isZero());
+
+  // D * Px cancels the C term
+  ASSERT_TRUE((constraint.dfdx + constraint.dfdu * projection.dfdx).isZero());
+
+  // D * Pe cancels the e term
+  ASSERT_TRUE((constraint.f + constraint.dfdu * projection.f).isZero());
+
+  // Pu has full column rank
+  ASSERT_EQ(Eigen::FullPivLU<ocs2::matrix_t>(projection.dfdu).rank(), 10);
+}
+
+TEST(test_projection, testProjectionStructuredFallback) {
+  const auto constraint = ocs2::getRandomConstraints(30, 20, 10);
+
+  // Without rows on a single input, this is the LU projection
+  ocs2::VectorFunctionLinearApproximation projection;
+  ocs2::structuredConstraintProjection(constraint, projection);
+  const auto luProjection = ocs2::luConstraintProjection(constraint);
+  ASSERT_TRUE(projection.dfdu.isApprox(luProjection.dfdu));
+  ASSERT_TRUE(projection.dfdx.isApprox(luProjection.dfdx));
+  ASSERT_TRUE(projection.f.isApprox(luProjection.f));
+}
+
+TEST(test_projection, testProjectionStructuredAllInputsFixed) {
+  auto constraint = ocs2::getRandomConstraints(30, 4, 4);
+  constraint.dfdu = 2.0 * ocs2::matrix_t::Identity(4, 4);
+
+  ocs2::VectorFunctionLinearApproximation projection;
+  ocs2::structuredConstraintProjection(constraint, projection);
+  ASSERT_TRUE(projection.dfdu.isZero());
+  ASSERT_TRUE((constraint.dfdx + constraint.dfdu * projection.dfdx).isZero());
+  ASSERT_TRUE((constraint.f + constraint.dfdu * projection.f).isZero());
+}
+
+TEST(test_projection, testFixedSizeProjection) {
+  constexpr int nx = 12;
+  constexpr int nu = 4;
+  constexpr int nc = 2;
+  const auto constraint = ocs2::getRandomConstraints(nx, nu, nc);
+  const auto dynamics = ocs2::getRandomDynamics(nx, nu);
+  const auto cost = ocs2::getRandomCost(nx, nu);
+
+  // The registry selects the fixed-size implementation for these dimensions
+  const ocs2::multiple_shooting::ProjectionFunction fixedSizeProjectionFunction = &ocs2::multiple_shooting::projectIntermediateNode<nx, nu>;
+  ASSERT_EQ(ocs2::multiple_shooting::selectProjectionFunction(nx, nu), fixedSizeProjectionFunction);
+
+  auto dynamicSizeDynamics = dynamics;
+  auto dynamicSizeCost = cost;
+  ocs2::VectorFunctionLinearApproximation dynamicSizeProjection;
+  ocs2::multiple_shooting::projectIntermediateNode(constraint, dynamicSizeDynamics, dynamicSizeCost, dynamicSizeProjection);
+
+  auto fixedSizeDynamics = dynamics;
+  auto fixedSizeCost = cost;
+  ocs2::VectorFunctionLinearApproximation fixedSizeProjection;
+  ocs2::multiple_shooting::projectIntermediateNode<nx, nu>(constraint, fixedSizeDynamics, fixedSizeCost, fixedSizeProjection);
+
+  ASSERT_TRUE(fixedSizeProjection.dfdu.isApprox(dynamicSizeProjection.dfdu));
+  ASSERT_TRUE(fixedSizeProjection.dfdx.isApprox(dynamicSizeProjection.dfdx));
+  ASSERT_TRUE(fixedSizeProjection.f.isApprox(dynamicSizeProjection.f));
+  ASSERT_TRUE(fixedSizeDynamics.dfdx.isApprox(dynamicSizeDynamics.dfdx));
+  ASSERT_TRUE(fixedSizeDynamics.dfdu.isApprox(dynamicSizeDynamics.dfdu));
+  ASSERT_TRUE(fixedSizeDynamics.f.isApprox(dynamicSizeDynamics.f));
+  ASSERT_DOUBLE_EQ(fixedSizeCost.f, dynamicSizeCost.f);
+  ASSERT_TRUE(fixedSizeCost.dfdx.isApprox(dynamicSizeCost.dfdx));
+  ASSERT_TRUE(fixedSizeCost.dfdu.isApprox(dynamicSizeCost.dfdu));
+  ASSERT_TRUE(fixedSizeCost.dfdxx.isApprox(dynamicSizeCost.dfdxx));
+  ASSERT_TRUE(fixedSizeCost.dfdux.isApprox(dynamicSizeCost.dfdux));
+  ASSERT_TRUE(fixedSizeCost.dfduu.isApprox(dynamicSizeCost.dfduu));
+
+  // Dimensions that are not registered use the dynamic-size implementation
+  const auto dynamicSizeProjectionFunction = static_cast<ocs2::multiple_shooting::ProjectionFunction>(
+      &ocs2::multiple_shooting::projectIntermediateNode);
+  ASSERT_EQ(ocs2::multiple_shooting::selectProjectionFunction(nx + 1, nu), dynamicSizeProjectionFunction);
+}
@@ -41,6 +41,11 @@ bool areIdentical(const ocs2::PerformanceIndex& lhs, const ocs2::PerformanceInde
          lhs.equalityConstraintsSSE == rhs.equalityConstraintsSSE && lhs.equalityLagrangian == rhs.equalityLagrangian &&
          lhs.inequalityLagrangian == rhs.inequalityLagrangian;
 }
+
+/** Helper to compare if the cost and equality constraints of two metrics are identical */
+bool areIdentical(const ocs2::MetricsCollection& lhs, const ocs2::MetricsCollection& rhs) {
+  return lhs.cost == rhs.cost && lhs.stateEqConstraint == rhs.stateEqConstraint && lhs.stateInputEqConstraint == rhs.stateInputEqConstraint;
+}
 }  // namespace
 
 using namespace ocs2;
@@ -60,9 +65,13 @@ TEST(test_transcription, intermediate_performance) {
   const vector_t u = (vector_t(2) << 0.1, 1.3).finished();
   const auto transcription = setupIntermediateNode(problem, sensitivityDiscretizer, true, t, dt, x, x_next, u);
 
-  const auto performance = computeIntermediatePerformance(problem, discretizer, t, dt, x, x_next, u);
+  MetricsCollection metrics;
+  const auto performance = computeIntermediatePerformance(problem, discretizer, t, dt, x, x_next, u, &metrics);
 
   ASSERT_TRUE(areIdentical(performance, transcription.performance));
+  ASSERT_TRUE(areIdentical(metrics, transcription.metrics));
+  ASSERT_DOUBLE_EQ(dt * metrics.cost, performance.cost);
+  ASSERT_EQ(metrics.stateInputEqConstraint.size(), 1);
 }
 
 TEST(test_transcription, terminal_performance) {
@@ -80,9 +89,11 @@ TEST(test_transcription, terminal_performance) {
   scalar_t t = 0.5;
   const vector_t x = vector_t::Random(nx);
   const auto transcription = setupTerminalNode(problem, t, x);
-  const auto performance = computeTerminalPerformance(problem, t, x);
+  MetricsCollection metrics;
+  const auto performance = computeTerminalPerformance(problem, t, x, &metrics);
 
   ASSERT_TRUE(areIdentical(performance, transcription.performance));
+  ASSERT_TRUE(areIdentical(metrics, transcription.metrics));
 }
 
 TEST(test_transcription, event_performance) {
@@ -105,7 +116,110 @@ TEST(test_transcription, event_performance) {
   const vector_t x = (vector_t(nx) << 1.0, 0.1).finished();
   const vector_t x_next = (vector_t(nx) << 1.1, 0.2).finished();
   const auto transcription = setupEventNode(problem, t, x, x_next);
-  const auto performance = computeEventPerformance(problem, t, x, x_next);
+  MetricsCollection metrics;
+  const auto performance = computeEventPerformance(problem, t, x, x_next, &metrics);
+
+  ASSERT_TRUE(areIdentical(performance, transcription.performance));
+  ASSERT_TRUE(areIdentical(metrics, transcription.metrics));
+}
+
+TEST(test_transcription, intermediate_exactHessian) {
+  const int nx = 3;
+  const int nu = 2;
+
+  // Linear dynamics with the artificial curvature w' * f = 0.5 * sum(w) * (x' * x + u' * u)
+  class CurvedLinearSystemDynamics final : public LinearSystemDynamics {
+   public:
+    using LinearSystemDynamics::LinearSystemDynamics;
+    CurvedLinearSystemDynamics* clone() const override { return new CurvedLinearSystemDynamics(*this); }
+    ScalarFunctionQuadraticApproximation flowMapWeightedHessian(scalar_t t, const vector_t& x, const vector_t& u, const vector_t& weights,
+                                                                const PreComputation&) override {
+      auto hessian = ScalarFunctionQuadraticApproximation::Zero(x.size(), u.size());
+      hessian.dfdxx.setIdentity();
+      hessian.dfduu.setIdentity();
+      hessian *= weights.sum();
+      return hessian;
+    }
+  };
 
+  OptimalControlProblem problem;
+  const auto dynamics = getRandomDynamics(nx, nu);
+  problem.dynamicsPtr.reset(new CurvedLinearSystemDynamics(dynamics.dfdx, dynamics.dfdu));
+  problem.costPtr->add("intermediateCost", getOcs2Cost(getRandomCost(nx, nu)));
+  const TargetTrajectories targetTrajectories({0.0}, {vector_t::Random(nx)}, {vector_t::Random(nu)});
+  problem.targetTrajectoriesPtr = &targetTrajectories;
+
+  auto sensitivityDiscretizer = selectDynamicsSensitivityDiscretization(SensitivityIntegratorType::RK4);
+  const scalar_t t = 0.5;
+  const scalar_t dt = 0.1;
+  const vector_t x = vector_t::Random(nx);
+  const vector_t x_next = vector_t::Random(nx);
+  const vector_t u = vector_t::Random(nu);
+  const scalar_t minEigenvalue = 1e-3;
+  const auto gaussNewton = setupIntermediateNode(problem, sensitivityDiscretizer, false, t, dt, x, x_next, u);
+
+  // Positive curvature is added as is
+  const vector_t costate = vector_t::Ones(nx);
+  const auto exact = setupIntermediateNode(problem, sensitivityDiscretizer, false, t, dt, x, x_next, u, costate, minEigenvalue);
+  const scalar_t curvature = dt * costate.sum();
+  EXPECT_TRUE(exact.cost.dfdxx.isApprox(gaussNewton.cost.dfdxx + curvature * matrix_t::Identity(nx, nx)));
+  EXPECT_TRUE(exact.cost.dfdux.isApprox(gaussNewton.cost.dfdux));
+  EXPECT_TRUE(exact.cost.dfduu.isApprox(gaussNewton.cost.dfduu + curvature * matrix_t::Identity(nu, nu)));
+  EXPECT_TRUE(exact.cost.dfdx.isApprox(gaussNewton.cost.dfdx));
+  EXPECT_TRUE(exact.dynamics.dfdx.isApprox(gaussNewton.dynamics.dfdx));
+  EXPECT_TRUE(areIdentical(exact.performance, gaussNewton.performance));
+
+  // Negative curvature is regularized
+  const vector_t negativeCostate = -1e3 * vector_t::Ones(nx);
+  const auto regularized =
+      setupIntermediateNode(problem, sensitivityDiscretizer, false, t, dt, x, x_next, u, negativeCostate, minEigenvalue);
+  matrix_t stateInputHessian(nx + nu, nx + nu);
+  stateInputHessian << regularized.cost.dfdxx, regularized.cost.dfdux.transpose(), regularized.cost.dfdux, regularized.cost.dfduu;
+  const vector_t eigenvalues = Eigen::SelfAdjointEigenSolver<matrix_t>(stateInputHessian).eigenvalues();
+  EXPECT_GE(eigenvalues.minCoeff(), minEigenvalue - 1e-9);
+}
+
+TEST(test_transcription, intermediate_inequalityConstraints) {
+  const int nx = 3;
+  const int nu = 2;
+
+  OptimalControlProblem problem;
+  const auto dynamics = getRandomDynamics(nx, nu);
+  problem.dynamicsPtr.reset(new LinearSystemDynamics(dynamics.dfdx, dynamics.dfdu));
+  problem.costPtr->add("intermediateCost", getOcs2Cost(getRandomCost(nx, nu)));
+  problem.equalityConstraintPtr->add("equalityConstraint", getOcs2Constraints(getRandomConstraints(nx, nu, 1)));
+  problem.inequalityConstraintPtr->add("inequalityConstraint", getOcs2Constraints(getRandomConstraints(nx, nu, 2)));
+  const TargetTrajectories targetTrajectories({0.0}, {vector_t::Random(nx)}, {vector_t::Random(nu)});
+  problem.targetTrajectoriesPtr = &targetTrajectories;
+
+  auto discretizer = selectDynamicsDiscretization(SensitivityIntegratorType::RK4);
+  auto sensitivityDiscretizer = selectDynamicsSensitivityDiscretization(SensitivityIntegratorType::RK4);
+  const scalar_t t = 0.5;
+  const scalar_t dt = 0.1;
+  const vector_t x = vector_t::Random(nx);
+  const vector_t x_next = vector_t::Random(nx);
+  const vector_t u = vector_t::Random(nu);
+  const auto transcription = setupIntermediateNode(problem, sensitivityDiscretizer, false, t, dt, x, x_next, u);
+  const auto projected = setupIntermediateNode(problem, sensitivityDiscretizer, true, t, dt, x, x_next, u);
+
+  // The violation of the inequality constraints is part of the performance
+  const auto performance = computeIntermediatePerformance(problem, discretizer, t, dt, x, x_next, u);
   ASSERT_TRUE(areIdentical(performance, transcription.performance));
+  ASSERT_TRUE(areIdentical(performance, projected.performance));
+  const vector_t h = problem.inequalityConstraintPtr->getValue(t, x, u, *problem.preComputationPtr);
+  const vector_t e = problem.equalityConstraintPtr->getValue(t, x, u, *problem.preComputationPtr);
+  ASSERT_NEAR(performance.equalityConstraintsSSE, dt * (h.cwiseMin(0.0).squaredNorm() + e.squaredNorm()), 1e-12);
+
+  // The projected inequality constraints are the inequality constraints evaluated at du = Px * dx + Pu * du_tilde + Pe
+  ASSERT_EQ(transcription.inequalityConstraints.f.size(), 2);
+  ASSERT_EQ(projected.inequalityConstraints.dfdu.cols(), nu - 1);
+  const vector_t dx = vector_t::Random(nx);
+  const vector_t du_tilde = vector_t::Random(nu - 1);
+  const auto& projection = projected.constraintsProjection;
+  const vector_t du = projection.dfdx * dx + projection.dfdu * du_tilde + projection.f;
+  const auto& inequality = transcription.inequalityConstraints;
+  const auto& projectedInequality = projected.inequalityConstraints;
+  const vector_t value = inequality.dfdx * dx + inequality.dfdu * du + inequality.f;
+  const vector_t projectedValue = projectedInequality.dfdx * dx + projectedInequality.dfdu * du_tilde + projectedInequality.f;
+  ASSERT_TRUE(value.isApprox(projectedValue));
 }
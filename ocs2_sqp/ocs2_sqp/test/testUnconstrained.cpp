@@ -160,3 +160,192 @@ TEST(test_unconstrained, noFeedback) {
         withEmptyConstraint.controllerPtr_->computeInput(t, x).isApprox(withNullConstraint.controllerPtr_->computeInput(t, x), tol));
   }
 }
+
+TEST(test_unconstrained, realTimeIteration) {
+  int n = 3;
+  int m = 2;
+  const double tol = 1e-9;
+  const auto dynamics = ocs2::getRandomDynamics(n, m);
+  const auto costs = ocs2::getRandomCost(n, m);
+
+  ocs2::OptimalControlProblem problem;
+  problem.dynamicsPtr = ocs2::getOcs2Dynamics(dynamics);
+  problem.costPtr->add("intermediateCost", ocs2::getOcs2Cost(costs));
+  problem.finalCostPtr->add("finalCost", ocs2::getOcs2StateCost(costs));
+
+  ocs2::TargetTrajectories targetTrajectories({0.0}, {ocs2::vector_t::Ones(n)}, {ocs2::vector_t::Ones(m)});
+  std::shared_ptr<ocs2::ReferenceManager> referenceManagerPtr(new ocs2::ReferenceManager(targetTrajectories));
+  problem.targetTrajectoriesPtr = &referenceManagerPtr->getTargetTrajectories();
+
+  ocs2::DefaultInitializer zeroInitializer(m);
+
+  ocs2::multiple_shooting::Settings settings;
+  settings.dt = 0.05;
+  settings.nThreads = 2;
+  ocs2::multiple_shooting::Settings rtiSettings = settings;
+  rtiSettings.realTimeIteration = true;
+
+  ocs2::MultipleShootingSolver solver(settings, problem, zeroInitializer);
+  solver.setReferenceManager(referenceManagerPtr);
+  ocs2::MultipleShootingSolver rtiSolver(rtiSettings, problem, zeroInitializer);
+  rtiSolver.setReferenceManager(referenceManagerPtr);
+
+  // The QP of a linear quadratic problem is exact: one real-time iteration finds the solution, with or without the preparation phase.
+  const ocs2::scalar_t horizon = 1.0;
+  const ocs2::scalar_array_t initTimes{0.0, 0.1, 0.2};
+  for (const auto initTime : initTimes) {
+    const ocs2::vector_t initState = ocs2::vector_t::Random(n);
+    if (initTime > 0.0) {
+      rtiSolver.prepareRealTimeIteration(initTime, initTime + horizon);
+    }
+    solver.run(initTime, initState, initTime + horizon);
+    rtiSolver.run(initTime, initState, initTime + horizon);
+
+    const auto solution = solver.primalSolution(initTime + horizon);
+    const auto rtiSolution = rtiSolver.primalSolution(initTime + horizon);
+    ASSERT_EQ(solution.timeTrajectory_.size(), rtiSolution.timeTrajectory_.size());
+    for (int i = 0; i < solution.timeTrajectory_.size(); i++) {
+      ASSERT_DOUBLE_EQ(solution.timeTrajectory_[i], rtiSolution.timeTrajectory_[i]);
+      ASSERT_TRUE(solution.stateTrajectory_[i].isApprox(rtiSolution.stateTrajectory_[i], tol));
+      ASSERT_TRUE(solution.inputTrajectory_[i].isApprox(rtiSolution.inputTrajectory_[i], tol));
+    }
+  }
+}
+
+TEST(test_unconstrained, partitionedRiccati) {
+  int n = 3;
+  int m = 2;
+  const double tol = 1e-9;
+  const auto dynamics = ocs2::getRandomDynamics(n, m);
+  const auto costs = ocs2::getRandomCost(n, m);
+
+  ocs2::OptimalControlProblem problem;
+  problem.dynamicsPtr = ocs2::getOcs2Dynamics(dynamics);
+  problem.costPtr->add("intermediateCost", ocs2::getOcs2Cost(costs));
+  problem.finalCostPtr->add("finalCost", ocs2::getOcs2StateCost(costs));
+
+  ocs2::TargetTrajectories targetTrajectories({0.0}, {ocs2::vector_t::Ones(n)}, {ocs2::vector_t::Ones(m)});
+  std::shared_ptr<ocs2::ReferenceManager> referenceManagerPtr(new ocs2::ReferenceManager(targetTrajectories));
+  problem.targetTrajectoriesPtr = &referenceManagerPtr->getTargetTrajectories();
+
+  ocs2::DefaultInitializer zeroInitializer(m);
+
+  ocs2::multiple_shooting::Settings settings;
+  settings.dt = 0.05;
+  settings.nThreads = 3;
+  settings.createValueFunction = true;
+  ocs2::multiple_shooting::Settings partitionedSettings = settings;
+  partitionedSettings.numRiccatiPartitions = 4;
+
+  ocs2::MultipleShootingSolver solver(settings, problem, zeroInitializer);
+  solver.setReferenceManager(referenceManagerPtr);
+  ocs2::MultipleShootingSolver partitionedSolver(partitionedSettings, problem, zeroInitializer);
+  partitionedSolver.setReferenceManager(referenceManagerPtr);
+
+  const ocs2::scalar_t startTime = 0.0;
+  const ocs2::scalar_t finalTime = 1.0;
+  const ocs2::vector_t initState = ocs2::vector_t::Ones(n);
+  solver.run(startTime, initState, finalTime);
+  partitionedSolver.run(startTime, initState, finalTime);
+
+  // The partitioned Riccati recursion and HPIPM solve the same unconstrained QP.
+  const auto solution = solver.primalSolution(finalTime);
+  const auto partitionedSolution = partitionedSolver.primalSolution(finalTime);
+  ASSERT_EQ(solution.timeTrajectory_.size(), partitionedSolution.timeTrajectory_.size());
+  for (int i = 0; i < solution.timeTrajectory_.size(); i++) {
+    const auto t = solution.timeTrajectory_[i];
+    const auto& x = solution.stateTrajectory_[i];
+    ASSERT_TRUE(solution.stateTrajectory_[i].isApprox(partitionedSolution.stateTrajectory_[i], tol));
+    ASSERT_TRUE(solution.inputTrajectory_[i].isApprox(partitionedSolution.inputTrajectory_[i], tol));
+    ASSERT_TRUE(solution.controllerPtr_->computeInput(t, x).isApprox(partitionedSolution.controllerPtr_->computeInput(t, x), tol));
+
+    const auto valueFunction = solver.getValueFunction(t, x);
+    const auto partitionedValueFunction = partitionedSolver.getValueFunction(t, x);
+    ASSERT_TRUE(valueFunction.dfdx.isApprox(partitionedValueFunction.dfdx, tol));
+    ASSERT_TRUE(valueFunction.dfdxx.isApprox(partitionedValueFunction.dfdxx, tol));
+  }
+}
+
+TEST(test_unconstrained, linearQuadraticProblem) {
+  int n = 3;
+  int m = 2;
+  const auto dynamics = ocs2::getRandomDynamics(n, m);
+  const auto costs = ocs2::getRandomCost(n, m);
+  // the empty constraint disables the detection of the linear-quadratic problem
+  const auto solWithEmptyConstraint = ocs2::solveWithFeedbackSetting(true, true, dynamics, costs);
+  const auto solWithNullConstraint = ocs2::solveWithFeedbackSetting(true, false, dynamics, costs);
+
+  // The linear-quadratic problem is solved by a single QP, the predicted performance is the one evaluated after the step
+  ASSERT_EQ(solWithNullConstraint.second.size(), 1);
+  const auto& performance = solWithNullConstraint.second.back();
+  const auto& evaluatedPerformance = solWithEmptyConstraint.second.back();
+  EXPECT_NEAR(performance.cost, evaluatedPerformance.cost, 1e-6 * std::abs(evaluatedPerformance.cost));
+  EXPECT_NEAR(performance.merit, evaluatedPerformance.merit, 1e-6 * std::abs(evaluatedPerformance.merit));
+  EXPECT_EQ(performance.dynamicsViolationSSE, 0.0);
+}
+
+TEST(test_unconstrained, moveBlocking) {
+  int n = 3;
+  int m = 2;
+  const auto dynamics = ocs2::getRandomDynamics(n, m);
+  const auto costs = ocs2::getRandomCost(n, m);
+
+  ocs2::OptimalControlProblem problem;
+  problem.dynamicsPtr = ocs2::getOcs2Dynamics(dynamics);
+  problem.costPtr->add("intermediateCost", ocs2::getOcs2Cost(costs));
+  problem.finalCostPtr->add("finalCost", ocs2::getOcs2StateCost(costs));
+
+  ocs2::TargetTrajectories targetTrajectories({0.0}, {ocs2::vector_t::Ones(n)}, {ocs2::vector_t::Ones(m)});
+  std::shared_ptr<ocs2::ReferenceManager> referenceManagerPtr(new ocs2::ReferenceManager(targetTrajectories));
+  problem.targetTrajectoriesPtr = &referenceManagerPtr->getTargetTrajectories();
+
+  ocs2::DefaultInitializer zeroInitializer(m);
+
+  ocs2::multiple_shooting::Settings settings;
+  settings.dt = 0.05;
+  settings.nThreads = 2;
+  ocs2::multiple_shooting::Settings blockedSettings = settings;
+  blockedSettings.inputBlocking = {1, 1, 2, 4};
+
+  ocs2::MultipleShootingSolver solver(settings, problem, zeroInitializer);
+  solver.setReferenceManager(referenceManagerPtr);
+  ocs2::MultipleShootingSolver blockedSolver(blockedSettings, problem, zeroInitializer);
+  blockedSolver.setReferenceManager(referenceManagerPtr);
+
+  const ocs2::scalar_t startTime = 0.0;
+  const ocs2::scalar_t finalTime = 1.0;
+  const ocs2::vector_t initState = ocs2::vector_t::Ones(n);
+  solver.run(startTime, initState, finalTime);
+  blockedSolver.run(startTime, initState, finalTime);
+
+  // The blocked problem has nodes at {0.0, 0.05, 0.1, 0.2, 0.4, 0.6, 0.8, 1.0} instead of every 0.05
+  const auto solution = solver.primalSolution(finalTime);
+  const auto blockedSolution = blockedSolver.primalSolution(finalTime);
+  ASSERT_EQ(solution.timeTrajectory_.size(), 21);
+  ASSERT_EQ(blockedSolution.timeTrajectory_.size(), 8);
+
+  // The dynamics are integrated with steps of dt over the blocked intervals, with the input of the interval held constant
+  const auto discretizer = ocs2::selectDynamicsDiscretization(settings.integratorType);
+  for (int i = 0; i + 1 < blockedSolution.timeTrajectory_.size(); i++) {
+    const auto t = blockedSolution.timeTrajectory_[i];
+    const auto numSteps = static_cast<int>(std::round((blockedSolution.timeTrajectory_[i + 1] - t) / settings.dt));
+    ocs2::vector_t x = blockedSolution.stateTrajectory_[i];
+    for (int k = 0; k < numSteps; k++) {
+      x = discretizer(*problem.dynamicsPtr, t + k * settings.dt, x, blockedSolution.inputTrajectory_[i], settings.dt);
+    }
+    ASSERT_TRUE(x.isApprox(blockedSolution.stateTrajectory_[i + 1], 1e-6));
+  }
+
+  // Blocking single steps is the same as no blocking
+  ocs2::multiple_shooting::Settings unitBlockedSettings = settings;
+  unitBlockedSettings.inputBlocking = {1};
+  ocs2::MultipleShootingSolver unitBlockedSolver(unitBlockedSettings, problem, zeroInitializer);
+  unitBlockedSolver.setReferenceManager(referenceManagerPtr);
+  unitBlockedSolver.run(startTime, initState, finalTime);
+  const auto unitBlockedSolution = unitBlockedSolver.primalSolution(finalTime);
+  ASSERT_EQ(solution.timeTrajectory_.size(), unitBlockedSolution.timeTrajectory_.size());
+  for (int i = 0; i < solution.timeTrajectory_.size(); i++) {
+    ASSERT_TRUE(solution.stateTrajectory_[i].isApprox(unitBlockedSolution.stateTrajectory_[i]));
+    ASSERT_TRUE(solution.inputTrajectory_[i].isApprox(unitBlockedSolution.inputTrajectory_[i]));
+  }
+}